@@ -0,0 +1,158 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the engines exposed by the fusilli plugin. All engines
+// import a hipDNN graph the same way, they differ in how the fusilli::Graph is
+// compiled (see fusilli::TuningConfig). hipDNN queries the engines applicable
+// to a graph (hipdnnEnginePluginGetApplicableEngineIds) in order of
+// preference, and its autotuner may benchmark all of them to pick the fastest.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_PLUGIN_SRC_ENGINES_H
+#define FUSILLI_PLUGIN_SRC_ENGINES_H
+
+#include <fusilli.h>
+#include <hipdnn_sdk/data_objects/graph_generated.h>
+#include <hipdnn_sdk/plugin/flatbuffer_utilities/GraphWrapper.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "graph_import.h"
+
+namespace fusilli_plugin {
+
+// Engine ids, following FUSILLI_PLUGIN_ENGINE_ID (set by the build).
+//
+// Default: the backend compile flags, or the tuning config registered for the
+// graph (see fusilli::TuningRegistry) if a tuning database was loaded.
+constexpr int64_t kDefaultEngineId = FUSILLI_PLUGIN_ENGINE_ID;
+// Channels-last: converts convolutions to channels-last (NHWC) before
+// dispatch formation, for graphs with channels-first (NCHW) convolutions.
+constexpr int64_t kChannelsLastEngineId = FUSILLI_PLUGIN_ENGINE_ID + 1;
+// Direct: lowers convolutions directly rather than through an implicit GEMM,
+// which may be faster for small channel counts.
+constexpr int64_t kDirectEngineId = FUSILLI_PLUGIN_ENGINE_ID + 2;
+
+// Engine ids in order of preference.
+constexpr std::array<int64_t, 3> kEngineIds = {
+    kDefaultEngineId,
+    kChannelsLastEngineId,
+    kDirectEngineId,
+};
+
+inline bool isEngineId(int64_t engineId) {
+  return std::ranges::find(kEngineIds, engineId) != kEngineIds.end();
+}
+
+// Returns the tuning config graphs are compiled with by `engineId`, or none
+// for the default engine, so that graphs compile with their registered config.
+inline std::optional<fusilli::TuningConfig>
+getEngineTuningConfig(int64_t engineId) {
+  switch (engineId) {
+  case kChannelsLastEngineId:
+    return fusilli::TuningConfig{
+        .flags = {
+            // clang-format off
+            "--iree-preprocessing-pass-pipeline=\"builtin.module(util.func(iree-preprocessing-convert-conv-to-channels-last, iree-preprocessing-sink-transpose-through-pad))\"",
+            // clang-format on
+        }};
+  case kDirectEngineId:
+    return fusilli::TuningConfig{
+        .flags = {"--iree-codegen-llvmgpu-use-igemm=false"}};
+  default:
+    return std::nullopt;
+  }
+}
+
+// Whether fusilli supports a hipDNN tensor: a data type it implements, and
+// positive dims with a stride each, laid out densely in some order of its dims
+// (e.g. channels-last), as buffers are imported in that physical order without
+// copies. Padded strides are not supported. Checked before compiling, so that
+// unsupported graphs are rejected cheaply.
+inline bool
+isSupportedTensor(const hipdnn_sdk::data_objects::TensorAttributes &tensor) {
+  fusilli::ErrorOr<fusilli::DataType> dataType =
+      hipDnnDataTypeToFusilliDataType(tensor.data_type());
+  if (isError(dataType) || *dataType == fusilli::DataType::NotSet)
+    return false;
+  if (!tensor.dims() || !tensor.strides() || tensor.dims()->size() == 0 ||
+      tensor.dims()->size() != tensor.strides()->size())
+    return false;
+  if (!std::ranges::all_of(*tensor.dims(),
+                           [](int64_t dim) { return dim > 0; }))
+    return false;
+  fusilli::TensorAttr tensorAttr;
+  tensorAttr.setDim(*tensor.dims()).setStride(*tensor.strides());
+  return tensorAttr.hasValidPhysicalRepresentation();
+}
+
+// Whether fusilli supports a conv_fprop node: input, filter and output of the
+// same rank, with a padding, stride and dilation per spatial dim.
+inline bool
+isSupportedConv(const hipdnn_plugin::GraphWrapper &opGraphWrapper,
+                const hipdnn_sdk::data_objects::ConvolutionFwdAttributes
+                    &convFwdAttrs) {
+  const auto &tensorMap = opGraphWrapper.getTensorMap();
+  size_t rank = tensorMap.at(convFwdAttrs.x_tensor_uid())->dims()->size();
+  if (rank < 3 ||
+      tensorMap.at(convFwdAttrs.w_tensor_uid())->dims()->size() != rank ||
+      tensorMap.at(convFwdAttrs.y_tensor_uid())->dims()->size() != rank)
+    return false;
+  size_t numSpatialDims = rank - 2;
+  return convFwdAttrs.pre_padding()->size() == numSpatialDims &&
+         convFwdAttrs.post_padding()->size() == numSpatialDims &&
+         convFwdAttrs.stride()->size() == numSpatialDims &&
+         convFwdAttrs.dilation()->size() == numSpatialDims;
+}
+
+// Whether the input of a conv_fprop node is channels-last, i.e. channels have
+// the smallest stride.
+inline bool
+isChannelsLastConv(const hipdnn_plugin::GraphWrapper &opGraphWrapper,
+                   const hipdnn_sdk::data_objects::ConvolutionFwdAttributes
+                       &convFwdAttrs) {
+  const hipdnn_sdk::data_objects::TensorAttributes *x =
+      opGraphWrapper.getTensorMap().at(convFwdAttrs.x_tensor_uid());
+  const auto &strides = *x->strides();
+  for (size_t i = 2; i < strides.size(); ++i) {
+    if (strides[i] < strides[1])
+      return false;
+  }
+  return true;
+}
+
+// Returns the engines applicable to a graph of conv_fprop and supported
+// pointwise nodes (see hipdnnEnginePluginGetApplicableEngineIds) in order of
+// preference: the default engine, then the channels-last engine if a
+// convolution is channels-first, then the direct engine.
+inline std::vector<int64_t>
+getApplicableEngineIds(const hipdnn_plugin::GraphWrapper &opGraphWrapper) {
+  bool hasChannelsFirstConv = false;
+  for (size_t i = 0; i < opGraphWrapper.nodeCount(); ++i) {
+    const hipdnn_sdk::data_objects::Node &node = opGraphWrapper.getNode(i);
+    const auto *convFwdAttrs = node.attributes_as_ConvolutionFwdAttributes();
+    if (convFwdAttrs && !isChannelsLastConv(opGraphWrapper, *convFwdAttrs))
+      hasChannelsFirstConv = true;
+  }
+
+  std::vector<int64_t> engineIds = {kDefaultEngineId};
+  if (hasChannelsFirstConv)
+    engineIds.push_back(kChannelsLastEngineId);
+  engineIds.push_back(kDirectEngineId);
+  return engineIds;
+}
+
+} // namespace fusilli_plugin
+
+#endif // FUSILLI_PLUGIN_SRC_ENGINES_H
@@ -16,13 +16,17 @@
 
 #include <fusilli.h>
 #include <hipdnn_sdk/data_objects/data_types_generated.h>
+#include <hipdnn_sdk/data_objects/pointwise_attributes_generated.h>
 #include <hipdnn_sdk/data_objects/tensor_attributes_generated.h>
 #include <hipdnn_sdk/plugin/PluginApiDataTypes.h>
 #include <hipdnn_sdk/plugin/flatbuffer_utilities/GraphWrapper.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "hipdnn_engine_plugin_execution_context.h"
 
@@ -50,6 +54,28 @@ hipDnnDataTypeToFusilliDataType(hipdnn_sdk::data_objects::DataType hipdnnType) {
   }
 }
 
+// Convert from hipDNN PointwiseMode to fusilli PointwiseAttr::Mode.
+inline fusilli::ErrorOr<fusilli::PointwiseAttr::Mode>
+hipDnnPointwiseModeToFusilliMode(
+    hipdnn_sdk::data_objects::PointwiseMode hipdnnMode) {
+  switch (hipdnnMode) {
+  case hipdnn_sdk::data_objects::PointwiseMode::ADD:
+    return ok(fusilli::PointwiseAttr::Mode::ADD);
+  case hipdnn_sdk::data_objects::PointwiseMode::DIV:
+    return ok(fusilli::PointwiseAttr::Mode::DIV);
+  case hipdnn_sdk::data_objects::PointwiseMode::MUL:
+    return ok(fusilli::PointwiseAttr::Mode::MUL);
+  case hipdnn_sdk::data_objects::PointwiseMode::RELU_FWD:
+    return ok(fusilli::PointwiseAttr::Mode::RELU_FWD);
+  case hipdnn_sdk::data_objects::PointwiseMode::SUB:
+    return ok(fusilli::PointwiseAttr::Mode::SUB);
+  default:
+    return error(fusilli::ErrorCode::NotImplemented,
+                 "Unsupported pointwise mode in hipdnn -> fusilli graph "
+                 "translation.");
+  }
+}
+
 // Graph import is done through importGraph function, this class exists for
 // organization and is used by importGraph.
 //
@@ -59,9 +85,9 @@ hipDnnDataTypeToFusilliDataType(hipdnn_sdk::data_objects::DataType hipdnnType) {
 // functions). Graph nodes are processed in topological order to ensure that
 // outputs of producer nodes are tracked and available for consuming nodes.
 //
-// NOTE: input hipDNN graph .node()s may not be in topological order. There's
-// plans for a topological sort method but that's not available yet. As we're
-// only handling single-node graphs currently, that's not a problem.
+// NOTE: input hipDNN graph .node()s may not be in topological order, so nodes
+// are imported once the producers of all their virtual inputs are (see
+// importNodes).
 class GraphImport {
 private:
   friend fusilli::ErrorOr<HipdnnEnginePluginExecutionContext>
@@ -76,12 +102,18 @@ private:
   // fusilli::TensorAttr.
   //
   // All tensors in this map should be non-virtual boundary tensors---a virtual
-  // tensor is an internal intermediate---internal tensors will be tracked
-  // elsewhere. Currently we only support single node graphs, so there are no
-  // virtual tensors to track.
+  // tensor is an internal intermediate---internal tensors are tracked in
+  // uidToVirtualTensor.
   std::unordered_map<int64_t, std::shared_ptr<fusilli::TensorAttr>>
       uidToIOTensor;
 
+  // Maps hipDNN tensor UIDs of virtual (intermediate) tensors to the
+  // fusilli::TensorAttr output by their producer node, consumed by nodes
+  // farther down the topological order (e.g. the output of a conv_fprop
+  // consumed by a bias add, itself consumed by a relu).
+  std::unordered_map<int64_t, std::shared_ptr<fusilli::TensorAttr>>
+      uidToVirtualTensor;
+
   // Helper class for reading from flatbuffer.
   hipdnn_plugin::GraphWrapper opGraphWrapper;
 
@@ -104,19 +136,69 @@ private:
     return importNodes();
   }
 
-  // Import all graph nodes.
+  // Import all graph nodes in topological order: each pass imports the nodes
+  // whose virtual inputs have all been produced by previously imported nodes.
+  // The nodes of a fusilli::Graph are emitted to a single function, where the
+  // compiler fuses pointwise consumers (e.g. bias and activation) into the
+  // dispatch of their producer.
   fusilli::ErrorObject importNodes() {
-    if (opGraphWrapper.nodeCount() > 1)
-      return fusilli::error(fusilli::ErrorCode::NotImplemented,
-                            "Multi-node graphs not supported currently.");
-    for (size_t i = 0; i < opGraphWrapper.nodeCount(); ++i) {
-      const hipdnn_sdk::data_objects::Node &node = opGraphWrapper.getNode(i);
-      FUSILLI_CHECK_ERROR(importNode(node));
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < opGraphWrapper.nodeCount(); ++i)
+      pending.push_back(i);
+
+    while (!pending.empty()) {
+      std::vector<size_t> blocked;
+      for (size_t i : pending) {
+        const hipdnn_sdk::data_objects::Node &node = opGraphWrapper.getNode(i);
+        if (FUSILLI_TRY(hasUnimportedInputs(node)))
+          blocked.push_back(i);
+        else
+          FUSILLI_CHECK_ERROR(importNode(node));
+      }
+      if (blocked.size() == pending.size())
+        return fusilli::error(fusilli::ErrorCode::InvalidAttribute,
+                              "Graph has a cycle or a virtual tensor without "
+                              "a producer node.");
+      pending = std::move(blocked);
     }
 
     return fusilli::ok();
   }
 
+  // Returns the hipDNN tensor UIDs of the inputs of `node`.
+  fusilli::ErrorOr<std::vector<int64_t>>
+  getNodeInputUids(const hipdnn_sdk::data_objects::Node &node) {
+    switch (node.attributes_type()) {
+    case hipdnn_sdk::data_objects::NodeAttributes::ConvolutionFwdAttributes: {
+      const auto *attr = node.attributes_as_ConvolutionFwdAttributes();
+      return ok(std::vector<int64_t>{attr->x_tensor_uid(),
+                                     attr->w_tensor_uid()});
+    }
+    case hipdnn_sdk::data_objects::NodeAttributes::PointwiseAttributes: {
+      const auto *attr = node.attributes_as_PointwiseAttributes();
+      std::vector<int64_t> uids = {attr->in_0_tensor_uid()};
+      if (attr->in_1_tensor_uid().has_value())
+        uids.push_back(*attr->in_1_tensor_uid());
+      return ok(std::move(uids));
+    }
+    default:
+      return fusilli::error(fusilli::ErrorCode::NotImplemented,
+                            "Unsupported node type.");
+    }
+  }
+
+  // Whether a virtual input of `node` is yet to be produced by an imported
+  // node.
+  fusilli::ErrorOr<bool>
+  hasUnimportedInputs(const hipdnn_sdk::data_objects::Node &node) {
+    for (int64_t uid : FUSILLI_TRY(getNodeInputUids(node))) {
+      if (opGraphWrapper.getTensorMap().at(uid)->virtual_() &&
+          !uidToVirtualTensor.contains(uid)) // C++ 20
+        return ok(true);
+    }
+    return ok(false);
+  }
+
   // Import single graph node.
   fusilli::ErrorObject importNode(const hipdnn_sdk::data_objects::Node &node) {
     switch (node.attributes_type()) {
@@ -124,6 +206,10 @@ private:
       FUSILLI_CHECK_ERROR(
           importConvFPropAttr(node.attributes_as_ConvolutionFwdAttributes()));
       break;
+    case hipdnn_sdk::data_objects::NodeAttributes::PointwiseAttributes:
+      FUSILLI_CHECK_ERROR(
+          importPointwiseAttr(node.attributes_as_PointwiseAttributes()));
+      break;
     default:
       return fusilli::error(fusilli::ErrorCode::NotImplemented,
                             "Unsupported node type.");
@@ -146,13 +232,15 @@ private:
                             *hipDnnConvFwdAttr->post_padding())) // C++ 20
       return fusilli::error(fusilli::ErrorCode::AttributeNotSet,
                             "Conv node with asymmetric padding found.");
-    // Import node.
+    // Import node, named after its output as node names must be unique in
+    // graphs of several conv_fprop nodes.
     auto fusilliConvFwdAttr =
         fusilli::ConvFPropAttr()
             .setPadding(*hipDnnConvFwdAttr->post_padding())
             .setStride(*hipDnnConvFwdAttr->stride())
             .setDilation(*hipDnnConvFwdAttr->dilation())
-            .setName("conv_fprop");
+            .setName(std::format("conv_fprop_{}",
+                                 hipDnnConvFwdAttr->y_tensor_uid()));
     std::shared_ptr<fusilli::TensorAttr> y =
         fusilliGraph.convFProp(x, w, fusilliConvFwdAttr);
 
@@ -163,6 +251,31 @@ private:
     return fusilli::ok();
   }
 
+  fusilli::ErrorObject
+  importPointwiseAttr(const hipdnn_sdk::data_objects::PointwiseAttributes
+                          *hipDnnPointwiseAttr) {
+    auto fusilliPointwiseAttr = fusilli::PointwiseAttr().setMode(FUSILLI_TRY(
+        hipDnnPointwiseModeToFusilliMode(hipDnnPointwiseAttr->operation())));
+
+    // Import node inputs and node.
+    std::shared_ptr<fusilli::TensorAttr> in0 = FUSILLI_TRY(
+        importNodeInput(hipDnnPointwiseAttr->in_0_tensor_uid(), "in0"));
+    std::shared_ptr<fusilli::TensorAttr> out0;
+    if (hipDnnPointwiseAttr->in_1_tensor_uid().has_value()) {
+      std::shared_ptr<fusilli::TensorAttr> in1 = FUSILLI_TRY(
+          importNodeInput(*hipDnnPointwiseAttr->in_1_tensor_uid(), "in1"));
+      out0 = fusilliGraph.pointwise(in0, in1, fusilliPointwiseAttr);
+    } else {
+      out0 = fusilliGraph.pointwise(in0, fusilliPointwiseAttr);
+    }
+
+    // Import node output.
+    FUSILLI_CHECK_ERROR(importNodeOutput(
+        hipDnnPointwiseAttr->out_0_tensor_uid(), "out0", out0));
+
+    return fusilli::ok();
+  }
+
   // Import, and track, node input tensor. Node input tensor is created in the
   // case of a boundary tensor, and read from shared state otherwise.
   fusilli::ErrorOr<std::shared_ptr<fusilli::TensorAttr>>
@@ -172,12 +285,14 @@ private:
     const hipdnn_sdk::data_objects::TensorAttributes *hipDnnTensorAttr =
         opGraphWrapper.getTensorMap().at(uid);
 
-    // A virtual node indicates a non-boundary node.
+    // A virtual node indicates a non-boundary node: the output of a previously
+    // imported node (see importNodes).
     if (hipDnnTensorAttr->virtual_()) {
-      // When multi-op graphs are supported, we would look up the output of a
-      // previously imported node and return it here.
-      return fusilli::error(fusilli::ErrorCode::NotImplemented,
-                            "Virtual inputs currently unsupported.");
+      auto it = uidToVirtualTensor.find(uid);
+      if (it == uidToVirtualTensor.end())
+        return fusilli::error(fusilli::ErrorCode::InvalidAttribute,
+                              "Virtual input without a producer node.");
+      return ok(it->second);
     }
 
     // Import new tensor.
@@ -206,14 +321,11 @@ private:
     nodeOutput->setName(std::format("{}_{}", name, uid)); // C++ 20
     FUSILLI_CHECK_ERROR(importAttrs(*nodeOutput, hipDnnTensorAttr));
 
-    // A virtual node indicates a non-boundary node.
+    // A virtual node indicates a non-boundary node: this tensor is an input
+    // to nodes farther down the topological sort.
     if (hipDnnTensorAttr->virtual_()) {
-      // This tensor is an input to nodes farther down the topological sort.
-      // When multi-op graphs are supported, we would track UID -> node output
-      // tensor in a non-IO tensor map.
-      return fusilli::error(fusilli::ErrorCode::NotImplemented,
-                            "Virtual outputs currently unsupported. An output "
-                            "tensor may have not been marked as an output.");
+      uidToVirtualTensor[uid] = nodeOutput;
+      return fusilli::ok();
     }
 
     // Track boundary node.
@@ -245,9 +357,9 @@ inline fusilli::ErrorOr<HipdnnEnginePluginExecutionContext>
 importGraph(const hipdnnPluginConstData_t *opGraph) {
   auto gc = GraphImport(opGraph);
   FUSILLI_CHECK_ERROR(gc.importGraph());
-  return HipdnnEnginePluginExecutionContext{.graph = std::move(gc.fusilliGraph),
-                                            .uidToFusilliTensorAttr =
-                                                std::move(gc.uidToIOTensor)};
+  return HipdnnEnginePluginExecutionContext{
+      .graph = std::make_shared<fusilli::Graph>(std::move(gc.fusilliGraph)),
+      .uidToFusilliTensorAttr = std::move(gc.uidToIOTensor)};
 }
 
 #endif // FUSILLI_PLUGIN_SRC_GRAPH_IMPORT_H
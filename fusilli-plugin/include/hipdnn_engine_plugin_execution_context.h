@@ -17,7 +17,12 @@
 // (plan in hipDNN parlance) in a hot loop without any overhead. For fusilli
 // plugin, that maps to constructing and storing a fusilli::Graph based on
 // hipDNN graph. When an execution is requested, it should be a simple lookup
-// for UID -> tensor attribute, then a graph execution.
+// for UID -> device buffer in the precomputed binding order of the graph, then
+// a graph execution. As frameworks pass the same device buffers step after
+// step, the buffers imported by the last execution are kept and only imported
+// again for tensors whose device pointer changed. Executions with the buffers
+// of the previous one then neither allocate nor synchronize with the host, so
+// that they can be captured in a HIP graph (e.g. with hipStreamBeginCapture).
 //
 //===----------------------------------------------------------------------===//
 
@@ -25,15 +30,47 @@
 #define FUSILLI_PLUGIN_SRC_HIPDNN_ENGINE_PLUGIN_EXECUTION_CONTEXT_H
 
 #include <fusilli.h>
+#include <iree/hal/buffer_view.h>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 struct HipdnnEnginePluginExecutionContext {
-  // Fusilli graph.
-  fusilli::Graph graph;
+  // Compiled fusilli graph, shared by the execution contexts created for the
+  // same op graph on a plugin handle (see HipdnnEnginePluginHandle).
+  std::shared_ptr<fusilli::Graph> graph;
 
   // Map from hipDNN tensor UID to fusilli::TensorAttrs for graph boundary
   // tensors (inputs and outputs).
   std::unordered_map<int64_t, std::shared_ptr<fusilli::TensorAttr>>
       uidToFusilliTensorAttr;
+
+  // A boundary tensor bound to the graph at a position of its binding plan
+  // (see fusilli::Graph::getBindingPlan), with its buffer imported by the last
+  // execution from the device pointer `importedPtr` (null until imported). The
+  // size of the buffer is fixed by the tensor attribute, so the pointer
+  // identifies the import.
+  struct Binding {
+    int64_t uid;
+    std::shared_ptr<fusilli::TensorAttr> tensorAttr;
+    std::shared_ptr<fusilli::Buffer> buffer;
+    void *importedPtr = nullptr;
+  };
+
+  // Boundary tensors in the order of the binding plan, and the buffer views
+  // of their imported buffers in the same order, as passed to the positional
+  // fusilli::Graph::execute. Set once the graph is validated.
+  std::vector<Binding> bindings;
+  std::vector<iree_hal_buffer_view_t *> bufferViews;
+
+  // Id of the engine that compiled `graph`, to update its profiling counters
+  // (see HipdnnEnginePluginHandle::getEngineCounters).
+  int64_t engineId = 0;
+
+  // Handle the buffers in `bindings` were imported with.
+  const fusilli::Handle *importHandle = nullptr;
 };
 
 #endif // FUSILLI_PLUGIN_SRC_HIPDNN_ENGINE_PLUGIN_EXECUTION_CONTEXT_H
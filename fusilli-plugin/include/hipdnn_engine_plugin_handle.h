@@ -13,9 +13,9 @@
 // order to create something when hipDNN asks for an plugin handle.
 //
 // HipdnnEnginePluginHandle stores any persistent data associated with a
-// particular engine plugin. In fusilli plugin that's the fusilli::Handle, and
-// some temporary buffers that higher level APIs create and destroy at different
-// times.
+// particular engine plugin. In fusilli plugin that's the fusilli::Handle, the
+// graphs compiled on it, and some temporary buffers that higher level APIs
+// create and destroy at different times.
 //
 //===----------------------------------------------------------------------===//
 
@@ -26,16 +26,45 @@
 #include <fusilli.h>
 #include <hip/hip_runtime.h>
 
+#include <chrono>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
+#include <future>
+#include <map>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
+#include "hipdnn_engine_plugin_execution_context.h"
+#include "profiling.h"
+
 struct HipdnnEnginePluginHandle {
 public:
   const int deviceId;
 
-  HipdnnEnginePluginHandle(int deviceId) : deviceId(deviceId) {}
+  // Whether graphs are compiled in the background rather than blocking the
+  // thread creating their execution context, set with the
+  // FUSILLI_PLUGIN_ASYNC_COMPILE environment variable (any value but "" and
+  // "0"). Engines are then only reported applicable to a graph once compiled
+  // (see hipdnnEnginePluginGetApplicableEngineIds), so that hipDNN uses
+  // another engine for it in the meantime.
+  const bool asyncCompile;
+
+  HipdnnEnginePluginHandle(int deviceId)
+      : deviceId(deviceId), asyncCompile(isAsyncCompileEnabled()) {}
+
+  // Wait for background compilations, which use the graphs and fusilli::Handles
+  // of this handle.
+  ~HipdnnEnginePluginHandle() {
+    for (auto &[key, compiledGraph] : _compiledGraphs)
+      compiledGraph.compiled.wait();
+  }
+
+  HipdnnEnginePluginHandle(const HipdnnEnginePluginHandle &) = delete;
+  HipdnnEnginePluginHandle &
+  operator=(const HipdnnEnginePluginHandle &) = delete;
 
   // Take ownership of a flatbuffers::DetachedBuffer and store it associated
   // with its memory address.
@@ -49,31 +78,109 @@ public:
     _engineDetailsBuffers.erase(ptr);
   }
 
-  // Get or create fusilli::Handle just in time. As the engine API may set the
-  // stream (through `hipdnnEnginePluginSetStream`) after initial handle
-  // creation (in `hipdnnEnginePluginCreate`) we defer the fusilli::Handle
-  // creation until we know if a stream has been set.
+  // Get or create the fusilli::Handle of the current stream just in time. As
+  // the engine API may set the stream (through `hipdnnEnginePluginSetStream`)
+  // after initial handle creation (in `hipdnnEnginePluginCreate`) we defer the
+  // fusilli::Handle creation until we know if a stream has been set.
+  //
+  // Frameworks switch streams often, so handles are kept per stream: switching
+  // back to a stream reuses its handle, with its device and the sessions of
+  // the graphs executed on it. Graphs compiled with the handle of a stream
+  // execute on the others, reusing their compiled artifact (see
+  // `fusilli::Graph::execute`).
   fusilli::ErrorOr<std::reference_wrapper<fusilli::Handle>> getFusilliHandle() {
-    if (!_fusilliHandle.has_value())
-      _fusilliHandle = FUSILLI_TRY(
-          fusilli::Handle::create(fusilli::Backend::AMDGPU, deviceId,
-                                  reinterpret_cast<uintptr_t>(_stream)));
-    return fusilli::ok(
-        std::reference_wrapper<fusilli::Handle>(*_fusilliHandle));
+    auto it = _fusilliHandles.find(_stream);
+    if (it == _fusilliHandles.end())
+      it = _fusilliHandles
+               .emplace(_stream, FUSILLI_TRY(fusilli::Handle::create(
+                                     fusilli::Backend::AMDGPU, deviceId,
+                                     reinterpret_cast<uintptr_t>(_stream))))
+               .first;
+    return fusilli::ok(std::reference_wrapper<fusilli::Handle>(it->second));
   }
 
   void setStream(hipStream_t stream) { _stream = stream; }
 
+  // A graph compiled by an engine for a serialized hipDNN op graph on this
+  // handle. Frameworks recreate execution plans for the same graphs (e.g.
+  // after a graph re-capture), contexts copied from `context` share its
+  // compiled fusilli::Graph rather than importing, compiling and loading it
+  // again. `compiled` is ready once the graph has compiled (in the background,
+  // see `fusilli::Graph::compileAsync`) with its status, and its compilation
+  // counted in the engine counters once observed ready.
+  struct CompiledGraph {
+    HipdnnEnginePluginExecutionContext context;
+    std::shared_future<fusilli::ErrorObject> compiled;
+    bool isCompileCounted = false;
+
+    bool isReady() const {
+      return compiled.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+    }
+  };
+
+  // Returns the graph compiled (or compiling) by engine `engineId` for the
+  // serialized hipDNN op graph `opGraph`, or null if its compilation was not
+  // started yet.
+  CompiledGraph *findCompiledGraph(int64_t engineId, std::string_view opGraph) {
+    auto it = _compiledGraphs.find(getCompiledGraphKey(engineId, opGraph));
+    return it == _compiledGraphs.end() ? nullptr : &it->second;
+  }
+
+  // Store the graph compiled (or compiling) by engine `engineId` for the
+  // serialized hipDNN op graph `opGraph`, its context before any execution.
+  CompiledGraph &storeCompiledGraph(int64_t engineId, std::string_view opGraph,
+                                    CompiledGraph &&compiledGraph) {
+    return _compiledGraphs
+        .emplace(getCompiledGraphKey(engineId, opGraph),
+                 std::move(compiledGraph))
+        .first->second;
+  }
+
+  // Number of executions of an engine between the summaries of its profiling
+  // counters, or zero to disable them (see getProfileInterval).
+  const uint64_t profileInterval = fusilli_plugin::getProfileInterval();
+
+  // Returns the profiling counters of engine `engineId` on this handle.
+  fusilli_plugin::EngineCounters &getEngineCounters(int64_t engineId) {
+    return _engineCounters[engineId];
+  }
+
+  const std::map<int64_t, fusilli_plugin::EngineCounters> &
+  getAllEngineCounters() const {
+    return _engineCounters;
+  }
+
 private:
+  static bool isAsyncCompileEnabled() {
+    const char *envVal = std::getenv("FUSILLI_PLUGIN_ASYNC_COMPILE");
+    return envVal && envVal[0] != '\0' && envVal[0] != '0';
+  }
+
+  static std::string getCompiledGraphKey(int64_t engineId,
+                                         std::string_view opGraph) {
+    return std::to_string(engineId) + ":" + std::string(opGraph);
+  }
+
   // Default to creating a handle on the null (default) stream.
   hipStream_t _stream = 0;
 
-  // Fusilli handle, will be created on the first call to `getFusilliHandle`.
-  std::optional<fusilli::Handle> _fusilliHandle;
+  // Fusilli handles by stream, created on the first call to
+  // `getFusilliHandle` for their stream.
+  std::unordered_map<hipStream_t, fusilli::Handle> _fusilliHandles;
 
   // Storage for engine details.
   std::unordered_map<const void *, std::unique_ptr<flatbuffers::DetachedBuffer>>
       _engineDetailsBuffers;
+
+  // Profiling counters by engine id.
+  std::map<int64_t, fusilli_plugin::EngineCounters> _engineCounters;
+
+  // Graphs compiled on `_fusilliHandles`, keyed by their engine id and the
+  // bytes of their serialized op graph. The device (and so its
+  // architecture) is fixed for a handle. Declared after `_fusilliHandles` so
+  // that the graphs are destroyed before them.
+  std::unordered_map<std::string, CompiledGraph> _compiledGraphs;
 };
 
 #endif // FUSILLI_PLUGIN_SRC_HIPDNN_ENGINE_PLUGIN_HANDLE_H
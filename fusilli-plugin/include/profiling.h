@@ -0,0 +1,82 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the profiling counters of the fusilli plugin engines,
+// accumulated per plugin handle and engine (see HipdnnEnginePluginHandle), to
+// tell whether the plugin overhead (graph import and compilation, buffer
+// import, host time of executions) or the kernels dominate. Summaries are
+// logged through the callback set by hipdnnPluginSetLoggingCallback every
+// FUSILLI_PLUGIN_PROFILE_INTERVAL executions of an engine, and when the
+// plugin handle is destroyed.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_PLUGIN_SRC_PROFILING_H
+#define FUSILLI_PLUGIN_SRC_PROFILING_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <string>
+
+namespace fusilli_plugin {
+
+struct EngineCounters {
+  // Graphs imported (and validated) and their total import time.
+  uint64_t numImports = 0;
+  double importUs = 0.0;
+  // Graphs compiled, their total compile time and those whose compilation
+  // reused the artifacts of the fusilli cache.
+  uint64_t numCompiles = 0;
+  double compileUs = 0.0;
+  uint64_t numArtifactCacheHits = 0;
+  // Execution contexts reusing a graph compiled on the plugin handle.
+  uint64_t numCacheHits = 0;
+  // Executions, and their total time importing device buffers and executing
+  // the graph on the host (enqueuing its kernels).
+  uint64_t numExecutions = 0;
+  double bufferImportUs = 0.0;
+  double executeUs = 0.0;
+};
+
+inline double getElapsedUs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Number of executions of an engine between the summaries of its counters,
+// set with the FUSILLI_PLUGIN_PROFILE_INTERVAL environment variable. Zero
+// (the default) disables summaries.
+inline uint64_t getProfileInterval() {
+  const char *envVal = std::getenv("FUSILLI_PLUGIN_PROFILE_INTERVAL");
+  return envVal ? std::strtoull(envVal, nullptr, /*base=*/10) : 0;
+}
+
+inline std::string formatEngineCounters(int64_t engineId,
+                                        const EngineCounters &counters) {
+  auto average = [](double totalUs, uint64_t count) {
+    return count ? totalUs / count : 0.0;
+  };
+  return std::format(
+      "Fusilli engine {}: {} imports ({:.1f} us avg), {} compiles ({:.1f} us "
+      "avg, {} artifact cache hits), {} compiled graph cache hits, {} "
+      "executions (buffer import {:.1f} us avg, execute {:.1f} us avg)",
+      engineId, counters.numImports,
+      average(counters.importUs, counters.numImports), counters.numCompiles,
+      average(counters.compileUs, counters.numCompiles),
+      counters.numArtifactCacheHits, counters.numCacheHits,
+      counters.numExecutions,
+      average(counters.bufferImportUs, counters.numExecutions),
+      average(counters.executeUs, counters.numExecutions));
+}
+
+} // namespace fusilli_plugin
+
+#endif // FUSILLI_PLUGIN_SRC_PROFILING_H
@@ -21,6 +21,7 @@
 #include <hipdnn_sdk/data_objects/data_types_generated.h>
 #include <hipdnn_sdk/data_objects/engine_details_generated.h>
 #include <hipdnn_sdk/data_objects/graph_generated.h>
+#include <hipdnn_sdk/data_objects/pointwise_attributes_generated.h>
 #include <hipdnn_sdk/data_objects/tensor_attributes_generated.h>
 #include <hipdnn_sdk/logging/Logger.hpp>
 #include <hipdnn_sdk/plugin/EnginePluginApi.h>
@@ -33,13 +34,18 @@
 #include <iree/hal/buffer.h>
 #include <iree/hal/buffer_view.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "engines.h"
 #include "graph_import.h"
 #include "hipdnn_engine_plugin_execution_context.h"
 #include "hipdnn_engine_plugin_handle.h"
@@ -57,6 +63,84 @@ thread_local char
     PluginLastErrorManager::s_lastError[HIPDNN_PLUGIN_ERROR_STRING_MAX_LENGTH] =
         "";
 
+// Sets the bindings of the boundary tensors of the validated graph of
+// `context`, in the order of its binding plan.
+static fusilli::ErrorObject
+setBindings(HipdnnEnginePluginExecutionContext &context) {
+  std::vector<std::shared_ptr<fusilli::TensorAttr>> bindingPlan =
+      FUSILLI_TRY(context.graph->getBindingPlan());
+  context.bindings.clear();
+  for (const std::shared_ptr<fusilli::TensorAttr> &tensorAttr : bindingPlan) {
+    auto it = std::ranges::find_if(
+        context.uidToFusilliTensorAttr,
+        [&](const auto &entry) { return entry.second == tensorAttr; });
+    FUSILLI_RETURN_ERROR_IF(it == context.uidToFusilliTensorAttr.end(),
+                            fusilli::ErrorCode::InternalError,
+                            "Graph boundary tensor '" + tensorAttr->getName() +
+                                "' has no hipDNN tensor UID");
+    context.bindings.push_back({.uid = it->first, .tensorAttr = tensorAttr});
+  }
+  context.bufferViews.assign(context.bindings.size(), nullptr);
+  return fusilli::ok();
+}
+
+// Returns the graph compiled by engine `engineId` for the serialized hipDNN op
+// graph `opGraph` on `handle`, importing it and starting its compilation on
+// the fusilli compile pool (see fusilli::Graph::compileAsync) if it was not
+// compiled yet. Compilation errors are reported by its `compiled` future.
+static fusilli::ErrorOr<HipdnnEnginePluginHandle::CompiledGraph *>
+getOrStartCompile(HipdnnEnginePluginHandle &handle, int64_t engineId,
+                  const hipdnnPluginConstData_t *opGraph) {
+  std::string_view opGraphBytes(static_cast<const char *>(opGraph->ptr),
+                                opGraph->size);
+  if (HipdnnEnginePluginHandle::CompiledGraph *compiledGraph =
+          handle.findCompiledGraph(engineId, opGraphBytes))
+    return fusilli::ok(compiledGraph);
+
+  // Import fusilli::Graph and compute UID -> fusilli::TensorAttr map for
+  // graph boundary tensors.
+  auto importStart = std::chrono::steady_clock::now();
+  HipdnnEnginePluginExecutionContext graphImport =
+      FUSILLI_TRY(importGraph(opGraph));
+  graphImport.engineId = engineId;
+
+  // Compile graph, with the compile flags of the engine.
+  FUSILLI_CHECK_ERROR(graphImport.graph->validate());
+  FUSILLI_CHECK_ERROR(setBindings(graphImport));
+  EngineCounters &counters = handle.getEngineCounters(engineId);
+  ++counters.numImports;
+  counters.importUs += getElapsedUs(importStart);
+  if (std::optional<fusilli::TuningConfig> tuningConfig =
+          getEngineTuningConfig(engineId))
+    graphImport.graph->setTuningConfig(*tuningConfig);
+  fusilli::Handle &fusilliHandle = FUSILLI_TRY(handle.getFusilliHandle());
+  std::shared_future<fusilli::ErrorObject> compiled =
+      graphImport.graph->compileAsync(fusilliHandle).share();
+
+  return fusilli::ok(&handle.storeCompiledGraph(
+      engineId, opGraphBytes,
+      HipdnnEnginePluginHandle::CompiledGraph{
+          .context = std::move(graphImport), .compiled = std::move(compiled)}));
+}
+
+// Accounts the compilation of `compiledGraph` in the profiling counters of its
+// engine, once it finished.
+static void
+countCompile(HipdnnEnginePluginHandle &handle,
+             HipdnnEnginePluginHandle::CompiledGraph &compiledGraph) {
+  if (compiledGraph.isCompileCounted || !compiledGraph.isReady())
+    return;
+  compiledGraph.isCompileCounted = true;
+  const fusilli::CompileStats &stats =
+      compiledGraph.context.graph->getCompileStats();
+  EngineCounters &counters =
+      handle.getEngineCounters(compiledGraph.context.engineId);
+  ++counters.numCompiles;
+  counters.compileUs += stats.getTotalUs();
+  if (stats.cacheHit)
+    ++counters.numArtifactCacheHits;
+}
+
 extern "C" {
 
 // ----------------------------------------------------------------------
@@ -131,10 +215,10 @@ hipdnnPluginStatus_t hipdnnEnginePluginGetAllEngineIds(int64_t *engineIds,
   // The backend queries this function twice:
   // - First call: engineIds=NULL, maxEngines=0 to get the count
   // - Second call: engineIds allocated based on numEngines from first pass
-  *numEngines = 1;
+  *numEngines = kEngineIds.size();
 
-  if (maxEngines >= 1) {
-    engineIds[0] = FUSILLI_PLUGIN_ENGINE_ID;
+  for (uint32_t i = 0; i < maxEngines && i < kEngineIds.size(); ++i) {
+    engineIds[i] = kEngineIds[i];
   }
 
   LOG_API_SUCCESS_AUTO("numEngines={}", *numEngines);
@@ -162,6 +246,12 @@ hipdnnEnginePluginDestroy(hipdnnEnginePluginHandle_t handle) {
   LOG_API_ENTRY("handle={:p}", static_cast<void *>(handle));
   FUSILLI_PLUGIN_CHECK_NULL(handle);
 
+  // Log the final profiling counters of the engines used on the handle.
+  if (handle->profileInterval) {
+    for (const auto &[engineId, counters] : handle->getAllEngineCounters()) {
+      HIPDNN_LOG_INFO("{}", formatEngineCounters(engineId, counters));
+    }
+  }
   delete handle;
 
   LOG_API_SUCCESS_AUTO("", "");
@@ -221,42 +311,118 @@ hipdnnPluginStatus_t hipdnnEnginePluginGetApplicableEngineIds(
     return HIPDNN_PLUGIN_STATUS_SUCCESS;
   }
 
-  // Check for single conv_fprop node graph
+  // Check for a graph of conv_fprop nodes, optionally followed by pointwise
+  // nodes (e.g. bias and activation) fused into their dispatch.
   GraphWrapper opGraphWrapper(opGraph->ptr, opGraph->size);
-  if (opGraphWrapper.nodeCount() != 1) {
-    HIPDNN_LOG_INFO("Fusilli plan builder is (currently) only applicable only "
-                    "for single node conv_fprop graphs.",
-                    opGraphWrapper.nodeCount());
-    return HIPDNN_PLUGIN_STATUS_SUCCESS;
-  }
   if (!opGraphWrapper.hasOnlySupportedAttributes(
           std::set<hipdnn_sdk::data_objects::NodeAttributes>{
               hipdnn_sdk::data_objects::NodeAttributes::
-                  ConvolutionFwdAttributes})) {
+                  ConvolutionFwdAttributes,
+              hipdnn_sdk::data_objects::NodeAttributes::
+                  PointwiseAttributes})) {
     HIPDNN_LOG_INFO("Fusilli plan builder is (currently) only applicable only "
-                    "for single node conv_fprop graphs.",
+                    "for conv_fprop graphs with pointwise epilogues.",
                     opGraphWrapper.nodeCount());
     return HIPDNN_PLUGIN_STATUS_SUCCESS;
   }
 
-  // Check single conv_fprop node for symmetric padding
-  const hipdnn_sdk::data_objects::ConvolutionFwdAttributes *convFwdAttrs =
-      opGraphWrapper.getNode(0).attributes_as_ConvolutionFwdAttributes();
-  // pre/post_padding are flatbuffer::vectors (not std::vectors) and don't
-  // override ==, so we use std::ranges::equal for structural vs referential
-  // equality.
-  if (!std::ranges::equal(*convFwdAttrs->pre_padding(),
-                          *convFwdAttrs->post_padding())) { // C++ 20
-    HIPDNN_LOG_INFO("Fusilli plan builder is (currently) requires symmetric "
-                    "padding for conv_fprop nodes.",
+  // Check tensors for data types and shapes supported by fusilli, without
+  // compiling.
+  for (const auto &[uid, tensorAttr] : opGraphWrapper.getTensorMap()) {
+    if (!isSupportedTensor(*tensorAttr)) {
+      HIPDNN_LOG_INFO("Fusilli plan builder is (currently) not applicable "
+                      "for the data type or shape of tensor {}.",
+                      uid);
+      return HIPDNN_PLUGIN_STATUS_SUCCESS;
+    }
+  }
+
+  size_t numConvNodes = 0;
+  for (size_t i = 0; i < opGraphWrapper.nodeCount(); ++i) {
+    const hipdnn_sdk::data_objects::Node &node = opGraphWrapper.getNode(i);
+    if (node.attributes_type() ==
+        hipdnn_sdk::data_objects::NodeAttributes::PointwiseAttributes) {
+      // Check pointwise node for a mode supported by fusilli.
+      if (isError(hipDnnPointwiseModeToFusilliMode(
+              node.attributes_as_PointwiseAttributes()->operation()))) {
+        HIPDNN_LOG_INFO("Fusilli plan builder is (currently) not applicable "
+                        "for the mode of pointwise node {}.",
+                        i);
+        return HIPDNN_PLUGIN_STATUS_SUCCESS;
+      }
+      continue;
+    }
+
+    // Check conv_fprop node for consistent ranks and symmetric padding
+    ++numConvNodes;
+    const hipdnn_sdk::data_objects::ConvolutionFwdAttributes *convFwdAttrs =
+        node.attributes_as_ConvolutionFwdAttributes();
+    if (!isSupportedConv(opGraphWrapper, *convFwdAttrs)) {
+      HIPDNN_LOG_INFO("Fusilli plan builder is (currently) not applicable "
+                      "for the tensor ranks of conv_fprop node {}.",
+                      i);
+      return HIPDNN_PLUGIN_STATUS_SUCCESS;
+    }
+    // pre/post_padding are flatbuffer::vectors (not std::vectors) and don't
+    // override ==, so we use std::ranges::equal for structural vs referential
+    // equality.
+    if (!std::ranges::equal(*convFwdAttrs->pre_padding(),
+                            *convFwdAttrs->post_padding())) { // C++ 20
+      HIPDNN_LOG_INFO("Fusilli plan builder is (currently) requires symmetric "
+                      "padding for conv_fprop nodes.",
+                      opGraphWrapper.nodeCount());
+      return HIPDNN_PLUGIN_STATUS_SUCCESS;
+    }
+  }
+  if (numConvNodes == 0) {
+    HIPDNN_LOG_INFO("Fusilli plan builder is (currently) only applicable only "
+                    "for graphs with a conv_fprop node.",
                     opGraphWrapper.nodeCount());
     return HIPDNN_PLUGIN_STATUS_SUCCESS;
   }
 
-  // We have a single conv_fprop node with symmetric padding, the fusilli engine
-  // is applicable.
-  engineIds[0] = FUSILLI_PLUGIN_ENGINE_ID;
-  *numEngines = 1;
+  // We have conv_fprop nodes with symmetric padding and supported pointwise
+  // nodes, the fusilli engines are applicable. Chains of them (e.g. conv +
+  // bias + relu + conv) are imported into a single fusilli::Graph, intermediate
+  // tensors staying virtual. Engines are returned in order of preference (see
+  // getApplicableEngineIds).
+  //
+  // When compiling in the background (see HipdnnEnginePluginHandle), engines
+  // are only applicable once they compiled the graph, their compilation
+  // starting on the first query. hipDNN uses the engines of other plugins for
+  // the graph until then, and ours on the next query after they're ready.
+  for (int64_t engineId : getApplicableEngineIds(opGraphWrapper)) {
+    if (handle->asyncCompile) {
+      fusilli::ErrorOr<HipdnnEnginePluginHandle::CompiledGraph *>
+          compiledGraph = getOrStartCompile(*handle, engineId, opGraph);
+      if (isError(compiledGraph)) {
+        HIPDNN_LOG_INFO("Fusilli engine {} failed to import graph: {}",
+                        engineId,
+                        fusilli::ErrorObject(compiledGraph).getMessage());
+        continue;
+      }
+      if (!(*compiledGraph)->isReady()) {
+        HIPDNN_LOG_INFO("Fusilli engine {} is compiling graph in the "
+                        "background, not applicable yet.",
+                        engineId);
+        continue;
+      }
+      countCompile(*handle, **compiledGraph);
+      if (isError((*compiledGraph)->compiled.get())) {
+        HIPDNN_LOG_INFO("Fusilli engine {} failed to compile graph: {}",
+                        engineId,
+                        (*compiledGraph)->compiled.get().getMessage());
+        continue;
+      }
+    }
+    if (*numEngines == maxEngines) {
+      HIPDNN_LOG_INFO("Maximum number of engines reached ({}), ignoring "
+                      "additional engines.",
+                      maxEngines);
+      break;
+    }
+    engineIds[(*numEngines)++] = engineId;
+  }
 
   LOG_API_SUCCESS_AUTO("numEngines={}", *numEngines);
   return HIPDNN_PLUGIN_STATUS_SUCCESS;
@@ -305,7 +471,7 @@ hipdnnEnginePluginGetEngineDetails(hipdnnEnginePluginHandle_t handle,
   FUSILLI_PLUGIN_CHECK_NULL(opGraph);
   FUSILLI_PLUGIN_CHECK_NULL(engineDetails);
 
-  if (engineId != FUSILLI_PLUGIN_ENGINE_ID) {
+  if (!isEngineId(engineId)) {
     return hipdnn_plugin::PluginLastErrorManager::setLastError(
         HIPDNN_PLUGIN_STATUS_BAD_PARAM, "unexpected engine id");
   }
@@ -367,10 +533,16 @@ hipdnnEnginePluginGetWorkspaceSize(hipdnnEnginePluginHandle_t handle,
   FUSILLI_PLUGIN_CHECK_NULL(opGraph);
   FUSILLI_PLUGIN_CHECK_NULL(workspaceSize);
 
-  // TODO(#2309): for now we're focusing on kernels that don't require scratch
-  // buffer space. Eventually we will need to teach IREE to report what scratch
-  // buffer space required, and how to use a passed in pre-allocated scratch
-  // space rather than a runtime allocated scratch space.
+  // Transient buffers of executions are allocated by the runtime in stream
+  // order from the workspace pool of the fusilli handle (see
+  // `Handle::trimWorkspacePool`), which reuses them across executions, so no
+  // workspace is required: once the first execution of a graph populated the
+  // pool, executions don't allocate device memory.
+  // TODO(#2309): the size of the transients of a graph is known from its
+  // compile statistics (logged by hipdnnEnginePluginCreateExecutionContext),
+  // but the modules emitted by fusilli don't accept pre-allocated storage for
+  // them. Report it once they do, to execute graphs in the workspace of
+  // hipDNN, as reporting it before would only allocate an unused workspace.
   *workspaceSize = 0;
 
   LOG_API_SUCCESS_AUTO("workspaceSize={}", *workspaceSize);
@@ -398,28 +570,36 @@ hipdnnPluginStatus_t hipdnnEnginePluginCreateExecutionContext(
   // Ensure that config contains expected engine id.
   hipdnn_plugin::EngineConfigWrapper engineConfigWrapper(engineConfig->ptr,
                                                          engineConfig->size);
-  if (engineConfigWrapper.engineId() != FUSILLI_PLUGIN_ENGINE_ID) {
+  int64_t engineId = engineConfigWrapper.engineId();
+  if (!isEngineId(engineId)) {
     return hipdnn_plugin::PluginLastErrorManager::setLastError(
         HIPDNN_PLUGIN_STATUS_BAD_PARAM, "unexpected engine id");
   }
 
-  auto importAndCompile = [&handle](const hipdnnPluginConstData_t *opGraph)
-      -> fusilli::ErrorOr<HipdnnEnginePluginExecutionContext> {
-    // Import fusilli::Graph and compute UID -> fusilli::TensorAttr map for
-    // graph boundary tensors.
-    HipdnnEnginePluginExecutionContext graphImport =
-        FUSILLI_TRY(importGraph(opGraph));
-
-    // Compile graph
-    FUSILLI_CHECK_ERROR(graphImport.graph.validate());
-    FUSILLI_CHECK_ERROR(
-        graphImport.graph.compile(FUSILLI_TRY(handle->getFusilliHandle())));
-
-    return fusilli::ok(std::move(graphImport));
-  };
-
-  *executionContext = new HipdnnEnginePluginExecutionContext(
-      FUSILLI_PLUGIN_TRY(importAndCompile(opGraph)));
+  // Reuse the graph compiled on this handle for the same serialized op graph
+  // and engine if any, otherwise compile it, waiting for its compilation if
+  // it runs in the background (see hipdnnEnginePluginGetApplicableEngineIds).
+  HipdnnEnginePluginHandle::CompiledGraph *compiledGraph =
+      FUSILLI_PLUGIN_TRY(getOrStartCompile(*handle, engineId, opGraph));
+  FUSILLI_PLUGIN_CHECK_ERROR(compiledGraph->compiled.get());
+  if (compiledGraph->isCompileCounted) {
+    ++handle->getEngineCounters(engineId).numCacheHits;
+  } else {
+    countCompile(*handle, *compiledGraph);
+  }
+  *executionContext =
+      new HipdnnEnginePluginExecutionContext(compiledGraph->context);
+
+  // Log the transient memory executions take from the workspace pool (see
+  // hipdnnEnginePluginGetWorkspaceSize), when the statistics were dumped.
+  fusilli::ErrorOr<fusilli::CompileStatistics> statistics =
+      (*executionContext)->graph->getCompileStatistics();
+  if (isOk(statistics)) {
+    HIPDNN_LOG_INFO("Fusilli graph executes {} dispatches with {} bytes of "
+                    "transient memory.",
+                    statistics->dispatchCount,
+                    statistics->transientMemorySize);
+  }
 
   LOG_API_SUCCESS_AUTO("created_execution_context={:p}",
                        static_cast<void *>(*executionContext));
@@ -458,89 +638,75 @@ hipdnnPluginStatus_t hipdnnEnginePluginExecuteOpGraph(
   FUSILLI_PLUGIN_CHECK_NULL(executionContext);
   FUSILLI_PLUGIN_CHECK_NULL(deviceBuffers);
 
-  // Params and allocators hoisted out of loop below.
-  iree_hal_allocator_t *deviceAllocator = iree_hal_device_allocator(
-      FUSILLI_PLUGIN_TRY(handle->getFusilliHandle()).get());
-  iree_allocator_t ireeHostAllocator = iree_allocator_system();
-  iree_hal_buffer_params_t bufferParams = {
-      .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
-      .access = IREE_HAL_MEMORY_ACCESS_READ | IREE_HAL_MEMORY_ACCESS_WRITE,
-      .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
-  };
-
-  // Fill variant pack for graph execution. Fusilli expects a variant pack to
-  // map from fusilli::TensorAttr -> fusilli::Buffer for all boundary tensors.
+  fusilli::Handle &fusilliHandle =
+      FUSILLI_PLUGIN_TRY(handle->getFusilliHandle());
+
+  // Bind buffers for graph execution. Fusilli executes a graph with a buffer
+  // for each boundary tensor, in the order of its binding plan.
   //
   // The execution context (created by hipdnnEnginePluginCreateExecutionContext)
-  // holds a UID -> fusilli::TensorAttr mapping for all boundary tensors
-  // already. To build the mapping we need to:
+  // holds the UID and fusilli::TensorAttr of the boundary tensors in that
+  // order already. To bind a tensor we need to:
   //   1. Find the external HIP-allocated device buffer in `deviceBuffers`
   //      associated with UID.
   //   2. Import buffer from 1) into IREE runtime and create fusilli::Buffer.
+  //      This isn't allocating a buffer, it's making an existing allocation
+  //      available to the IREE runtime.
   //
-  // We may want to cache all of this in the future. As long as the device
-  // pointers + UIDs haven't changed it should be possible to re-use an already
-  // imported buffer + buffer view + the call that fusilli::Graph::execute
-  // builds internally.
-  std::unordered_map<std::shared_ptr<fusilli::TensorAttr>,
-                     std::shared_ptr<fusilli::Buffer>>
-      variantPack;
-  for (auto &[uid, tensorAttr] : executionContext->uidToFusilliTensorAttr) {
+  // The imported buffers are kept in the execution context between
+  // executions, so an import only happens when the device pointer of a UID
+  // changed (or on the first execution). Executions with the same buffers
+  // reuse them as is, without allocating: after a first execution, they can
+  // be captured in a HIP graph on the stream of the handle.
+  if (executionContext->importHandle != &fusilliHandle) {
+    for (HipdnnEnginePluginExecutionContext::Binding &binding :
+         executionContext->bindings) {
+      binding.buffer.reset();
+      binding.importedPtr = nullptr;
+    }
+    executionContext->importHandle = &fusilliHandle;
+  }
+  auto importStart = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < executionContext->bindings.size(); ++i) {
+    HipdnnEnginePluginExecutionContext::Binding &binding =
+        executionContext->bindings[i];
     // 1. Find associated buffer.
     hipdnnPluginDeviceBuffer_t hipMallocedBuffer = FUSILLI_PLUGIN_TRY(
-        findDeviceBuffer(uid, deviceBuffers, numDeviceBuffers));
-
-    // 2.1. Import external buffer into IREE runtime. This isn't allocating a
-    // buffer, it's making an existing allocation available to the IREE runtime.
-    iree_hal_external_buffer_t externalBuffer = {
-        .type = IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION,
-        .flags = 0,
-        .size = static_cast<iree_device_size_t>(sizeof(float) *
-                                                tensorAttr->getVolume()),
-        .handle =
-            {
-                .device_allocation =
-                    {
-                        .ptr = (uint64_t)hipMallocedBuffer.ptr,
-                    },
-            },
-    };
-    iree_hal_buffer_t *importedBuffer = nullptr;
-    FUSILLI_PLUGIN_CHECK_ERROR(iree_hal_allocator_import_buffer(
-        deviceAllocator, bufferParams, &externalBuffer,
-        iree_hal_buffer_release_callback_null(), &importedBuffer));
-
-    // 2.2. Create a buffer view for external buffer.
-    iree_hal_buffer_view_t *outBufferView = nullptr;
-    FUSILLI_PLUGIN_CHECK_ERROR(iree_hal_buffer_view_create(
-        /*buffer=*/importedBuffer, /*shape_rank=*/tensorAttr->getDim().size(),
-        /*shape=*/(const iree_hal_dim_t *)tensorAttr->getDim().data(),
-        /*element_type=*/
-        FUSILLI_PLUGIN_TRY(
-            fusilliDataTypeToIreeHalDataType(tensorAttr->getDataType())),
-        /*encoding_type=*/IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR,
-        /*host_allocator=*/ireeHostAllocator,
-        /*out_buffer_view=*/&outBufferView));
-
-    // Release our reference to buffer. The buffer view holds a reference to
-    // buffer and will handle release + possible destruction when it's
-    // destroyed.
-    iree_hal_buffer_release(importedBuffer);
-
-    // 2.3. Create fusilli::Buffer from buffer view. Buffer::import is a RAII
-    // type that retains the buffer view, incrementing its reference count, on
-    // construction and releases the buffer view on destruction.
-    variantPack[tensorAttr] = std::make_shared<fusilli::Buffer>(
-        FUSILLI_PLUGIN_TRY(fusilli::Buffer::import(outBufferView)));
-
-    // Release our reference to buffer view. The buffer view and buffer will
-    // (now) be tied to fusilli::Buffer's lifetime as it holds the only
-    // reference to the buffer view.
-    iree_hal_buffer_view_release(outBufferView);
+        findDeviceBuffer(binding.uid, deviceBuffers, numDeviceBuffers));
+    if (binding.buffer && binding.importedPtr == hipMallocedBuffer.ptr) {
+      continue;
+    }
+
+    // 2. Import it, in the physical order of its dims (e.g. NHWC for a
+    // channels-last NCHW tensor) as laid out in memory. Its size follows from
+    // them and the element type of the tensor.
+    std::vector<int64_t> dims = binding.tensorAttr->getPhysicalDim();
+    binding.buffer = std::make_shared<fusilli::Buffer>(
+        FUSILLI_PLUGIN_TRY(fusilli::Buffer::importDevicePtr(
+            fusilliHandle, hipMallocedBuffer.ptr,
+            std::vector<iree_hal_dim_t>(dims.begin(), dims.end()),
+            binding.tensorAttr->getDataType())));
+    binding.importedPtr = hipMallocedBuffer.ptr;
+    executionContext->bufferViews[i] = *binding.buffer;
   }
 
-  FUSILLI_PLUGIN_CHECK_ERROR(executionContext->graph.execute(
-      FUSILLI_PLUGIN_TRY(handle->getFusilliHandle()), variantPack));
+  double bufferImportUs = getElapsedUs(importStart);
+
+  auto executeStart = std::chrono::steady_clock::now();
+  FUSILLI_PLUGIN_CHECK_ERROR(
+      executionContext->graph->execute(fusilliHandle,
+                                      executionContext->bufferViews));
+
+  EngineCounters &counters =
+      handle->getEngineCounters(executionContext->engineId);
+  ++counters.numExecutions;
+  counters.bufferImportUs += bufferImportUs;
+  counters.executeUs += getElapsedUs(executeStart);
+  if (handle->profileInterval &&
+      counters.numExecutions % handle->profileInterval == 0) {
+    HIPDNN_LOG_INFO("{}",
+                    formatEngineCounters(executionContext->engineId, counters));
+  }
 
   LOG_API_SUCCESS_AUTO("{}", "executed graph");
   return HIPDNN_PLUGIN_STATUS_SUCCESS;
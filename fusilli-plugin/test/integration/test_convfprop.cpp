@@ -156,6 +156,16 @@ TEST_P(ConvFpropIntegrationTest, Basic1x1Convolution) {
   CpuFpReferenceValidation<float> validator(1e-6f, 1e-6f);
   EXPECT_TRUE(validator.allClose(expectedOutput.memory(), yTensor.memory()));
 
+  // Execute again into a new output buffer, reusing the buffers of the inputs
+  // imported by the first execution.
+  PinnedTensor<float> yTensor2({n, k, h, w});
+  yTensor2.fillWithValue(-100.0f);
+  variantPack[yUID] = yTensor2.memory().deviceData();
+  result = graph->execute(handle, variantPack, nullptr);
+  ASSERT_EQ(result.code, error_code_t::OK) << result.err_msg;
+  yTensor2.memory().markDeviceModified();
+  EXPECT_TRUE(validator.allClose(expectedOutput.memory(), yTensor2.memory()));
+
   // Clean up.
   if (params.shouldSetStream) {
     ASSERT_EQ(hipStreamDestroy(stream), HIPDNN_STATUS_SUCCESS);
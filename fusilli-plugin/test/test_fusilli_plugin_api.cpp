@@ -11,24 +11,30 @@
 #include <hipdnn_sdk/data_objects/data_types_generated.h>
 #include <hipdnn_sdk/data_objects/engine_config_generated.h>
 #include <hipdnn_sdk/data_objects/graph_generated.h>
+#include <hipdnn_sdk/data_objects/pointwise_attributes_generated.h>
 #include <hipdnn_sdk/data_objects/tensor_attributes_generated.h>
 #include <hipdnn_sdk/plugin/EnginePluginApi.h>
 #include <hipdnn_sdk/plugin/PluginApi.h>
 #include <hipdnn_sdk/test_utilities/FlatbufferGraphTestUtils.hpp>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unistd.h>
 #include <vector>
 
+#include "engines.h"
 #include "fusilli/attributes/tensor_attributes.h"
 #include "graph_import.h"
 #include "hipdnn_engine_plugin_execution_context.h"
+#include "hipdnn_engine_plugin_handle.h"
 #include "utils.h"
 
 bool loggingCallbackCalled = false;
@@ -152,15 +158,16 @@ TEST(TestFusilliPluginApi, GetAllEngineIds) {
   uint32_t numEngines = 0;
   EXPECT_EQ(hipdnnEnginePluginGetAllEngineIds(nullptr, 0, &numEngines),
             HIPDNN_PLUGIN_STATUS_SUCCESS);
-  EXPECT_EQ(numEngines, 1);
+  EXPECT_EQ(numEngines, 3);
 
   // Second call to get actual engine IDs
   std::vector<int64_t> engineIds(numEngines);
   EXPECT_EQ(hipdnnEnginePluginGetAllEngineIds(engineIds.data(), numEngines,
                                               &numEngines),
             HIPDNN_PLUGIN_STATUS_SUCCESS);
-  EXPECT_EQ(numEngines, 1);
+  EXPECT_EQ(numEngines, 3);
   EXPECT_EQ(engineIds[0], FUSILLI_PLUGIN_ENGINE_ID);
+  EXPECT_TRUE(std::ranges::equal(engineIds, fusilli_plugin::kEngineIds));
 }
 
 TEST(TestFusilliPluginApi, GetAllEngineIdsNullNumEngines) {
@@ -225,6 +232,155 @@ createValidConvFwdGraph(int64_t xUID = 0, int64_t wUID = 1, int64_t yUID = 2,
   return builder;
 }
 
+// Serialized hipDNN graph of a conv_fprop followed by a bias add and a relu,
+// through virtual tensors. Nodes are listed in reverse topological order.
+flatbuffers::FlatBufferBuilder createValidConvFwdBiasReluGraph(
+    int64_t xUID = 0, int64_t wUID = 1, int64_t bUID = 2, int64_t yUID = 3,
+    hipdnn_sdk::data_objects::DataType dataType =
+        hipdnn_sdk::data_objects::DataType::FLOAT) {
+  const int64_t convUID = 4, biasUID = 5;
+  const std::vector<int64_t> xDims = {4, 4, 4, 4}, xStrides = {64, 16, 4, 1};
+  const std::vector<int64_t> wDims = {4, 4, 1, 1}, wStrides = {4, 1, 1, 1};
+  const std::vector<int64_t> bDims = {1, 4, 1, 1}, bStrides = {4, 1, 1, 1};
+  const std::vector<int64_t> padding = {0, 0}, convStrides = {1, 1},
+                             convDilation = {1, 1};
+
+  flatbuffers::FlatBufferBuilder builder;
+  std::vector<::flatbuffers::Offset<hipdnn_sdk::data_objects::TensorAttributes>>
+      tensorAttributes;
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, xUID, "x", dataType, &xStrides, &xDims));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, wUID, "w", dataType, &wStrides, &wDims));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, bUID, "b", dataType, &bStrides, &bDims));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, convUID, "conv", dataType, &xStrides, &xDims,
+      /*virtual_=*/true));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, biasUID, "bias", dataType, &xStrides, &xDims,
+      /*virtual_=*/true));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, yUID, "y", dataType, &xStrides, &xDims));
+
+  auto createPointwiseAttributes =
+      [&](hipdnn_sdk::data_objects::PointwiseMode mode, int64_t in0UID,
+          std::optional<int64_t> in1UID, int64_t out0UID) {
+        hipdnn_sdk::data_objects::PointwiseAttributesBuilder attrBuilder(
+            builder);
+        attrBuilder.add_operation(mode);
+        attrBuilder.add_in_0_tensor_uid(in0UID);
+        if (in1UID)
+          attrBuilder.add_in_1_tensor_uid(*in1UID);
+        attrBuilder.add_out_0_tensor_uid(out0UID);
+        return attrBuilder.Finish();
+      };
+  auto reluAttributes = createPointwiseAttributes(
+      hipdnn_sdk::data_objects::PointwiseMode::RELU_FWD, biasUID,
+      std::nullopt, yUID);
+  auto biasAttributes = createPointwiseAttributes(
+      hipdnn_sdk::data_objects::PointwiseMode::ADD, convUID, bUID, biasUID);
+  auto convAttributes = CreateConvolutionFwdAttributesDirect(
+      builder,
+      /*x_tensor_uid*/ xUID,
+      /*w_tensor_uid*/ wUID,
+      /*y_tensor_uid*/ convUID, &padding, &padding, &convStrides,
+      &convDilation, hipdnn_sdk::data_objects::ConvMode::CROSS_CORRELATION);
+
+  std::vector<::flatbuffers::Offset<hipdnn_sdk::data_objects::Node>> nodes;
+  nodes.push_back(CreateNodeDirect(
+      builder, "relu",
+      hipdnn_sdk::data_objects::NodeAttributes::PointwiseAttributes,
+      reluAttributes.Union()));
+  nodes.push_back(CreateNodeDirect(
+      builder, "bias",
+      hipdnn_sdk::data_objects::NodeAttributes::PointwiseAttributes,
+      biasAttributes.Union()));
+  nodes.push_back(CreateNodeDirect(
+      builder, "conv_fwd",
+      hipdnn_sdk::data_objects::NodeAttributes::ConvolutionFwdAttributes,
+      convAttributes.Union()));
+
+  auto graphOffset =
+      CreateGraphDirect(builder, "test",
+                        /*compute_type*/ dataType,
+                        /*intermediate_type*/ dataType,
+                        /*io_type=*/dataType, &tensorAttributes, &nodes);
+  builder.Finish(graphOffset);
+  return builder;
+}
+
+// Serialized hipDNN graph of two chained conv_fprops with a relu in between,
+// through virtual tensors.
+flatbuffers::FlatBufferBuilder createValidConvFwdReluConvFwdGraph(
+    int64_t xUID = 0, int64_t w0UID = 1, int64_t w1UID = 2, int64_t yUID = 3,
+    hipdnn_sdk::data_objects::DataType dataType =
+        hipdnn_sdk::data_objects::DataType::FLOAT) {
+  const int64_t conv0UID = 4, reluUID = 5;
+  const std::vector<int64_t> xDims = {4, 4, 4, 4}, xStrides = {64, 16, 4, 1};
+  const std::vector<int64_t> wDims = {4, 4, 1, 1}, wStrides = {4, 1, 1, 1};
+  const std::vector<int64_t> padding = {0, 0}, convStrides = {1, 1},
+                             convDilation = {1, 1};
+
+  flatbuffers::FlatBufferBuilder builder;
+  std::vector<::flatbuffers::Offset<hipdnn_sdk::data_objects::TensorAttributes>>
+      tensorAttributes;
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, xUID, "x", dataType, &xStrides, &xDims));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, w0UID, "w0", dataType, &wStrides, &wDims));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, w1UID, "w1", dataType, &wStrides, &wDims));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, conv0UID, "conv0", dataType, &xStrides, &xDims,
+      /*virtual_=*/true));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, reluUID, "relu", dataType, &xStrides, &xDims,
+      /*virtual_=*/true));
+  tensorAttributes.push_back(CreateTensorAttributesDirect(
+      builder, yUID, "y", dataType, &xStrides, &xDims));
+
+  auto conv0Attributes = CreateConvolutionFwdAttributesDirect(
+      builder,
+      /*x_tensor_uid*/ xUID,
+      /*w_tensor_uid*/ w0UID,
+      /*y_tensor_uid*/ conv0UID, &padding, &padding, &convStrides,
+      &convDilation, hipdnn_sdk::data_objects::ConvMode::CROSS_CORRELATION);
+  hipdnn_sdk::data_objects::PointwiseAttributesBuilder reluBuilder(builder);
+  reluBuilder.add_operation(hipdnn_sdk::data_objects::PointwiseMode::RELU_FWD);
+  reluBuilder.add_in_0_tensor_uid(conv0UID);
+  reluBuilder.add_out_0_tensor_uid(reluUID);
+  auto reluAttributes = reluBuilder.Finish();
+  auto conv1Attributes = CreateConvolutionFwdAttributesDirect(
+      builder,
+      /*x_tensor_uid*/ reluUID,
+      /*w_tensor_uid*/ w1UID,
+      /*y_tensor_uid*/ yUID, &padding, &padding, &convStrides, &convDilation,
+      hipdnn_sdk::data_objects::ConvMode::CROSS_CORRELATION);
+
+  std::vector<::flatbuffers::Offset<hipdnn_sdk::data_objects::Node>> nodes;
+  nodes.push_back(CreateNodeDirect(
+      builder, "conv_fwd0",
+      hipdnn_sdk::data_objects::NodeAttributes::ConvolutionFwdAttributes,
+      conv0Attributes.Union()));
+  nodes.push_back(CreateNodeDirect(
+      builder, "relu",
+      hipdnn_sdk::data_objects::NodeAttributes::PointwiseAttributes,
+      reluAttributes.Union()));
+  nodes.push_back(CreateNodeDirect(
+      builder, "conv_fwd1",
+      hipdnn_sdk::data_objects::NodeAttributes::ConvolutionFwdAttributes,
+      conv1Attributes.Union()));
+
+  auto graphOffset =
+      CreateGraphDirect(builder, "test",
+                        /*compute_type*/ dataType,
+                        /*intermediate_type*/ dataType,
+                        /*io_type=*/dataType, &tensorAttributes, &nodes);
+  builder.Finish(graphOffset);
+  return builder;
+}
+
 TEST(TestFusilliPluginApi, GetApplicableEngineIds) {
   // Create plugin handle.
   hipdnnEnginePluginHandle_t handle = nullptr;
@@ -250,12 +406,66 @@ TEST(TestFusilliPluginApi, GetApplicableEngineIds) {
   opGraph.ptr = builder.GetBufferPointer();
   opGraph.size = builder.GetSize();
 
-  // Fusilli plugin should offer to compile and execute single node conv_fprop.
+  // Fusilli plugin should offer to compile and execute single node conv_fprop,
+  // with all engines in order of preference as the input is channels-first.
+  ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
+                handle, &opGraph, engineIDs.data(), 5, &numEngines),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_EQ(numEngines, 3);
+  ASSERT_EQ(engineIDs[0], FUSILLI_PLUGIN_ENGINE_ID);
+  ASSERT_EQ(engineIDs[1], fusilli_plugin::kChannelsLastEngineId);
+  ASSERT_EQ(engineIDs[2], fusilli_plugin::kDirectEngineId);
+
+  // Only the preferred engines are returned when hipDNN asks for fewer.
+  ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
+                handle, &opGraph, engineIDs.data(), 1, &numEngines),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_EQ(numEngines, 3);
+  ASSERT_EQ(engineIDs[0], FUSILLI_PLUGIN_ENGINE_ID);
+
+  // Create a serialized hipDNN conv_fprop graph with a channels-last input.
+  builder = createValidConvFwdGraph(
+      /*xUID=*/0, /*wUID=*/1, /*yUID=*/2,
+      /*dataType=*/hipdnn_sdk::data_objects::DataType::FLOAT,
+      /*xDims=*/{4, 4, 4, 4}, /*xStrides=*/{64, 1, 16, 4});
+  opGraph.ptr = builder.GetBufferPointer();
+  opGraph.size = builder.GetSize();
+
+  // The channels-last engine is not applicable, it would compile the same.
   ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
                 handle, &opGraph, engineIDs.data(), 5, &numEngines),
             HIPDNN_PLUGIN_STATUS_SUCCESS);
-  ASSERT_EQ(numEngines, 1);
+  ASSERT_EQ(numEngines, 2);
   ASSERT_EQ(engineIDs[0], FUSILLI_PLUGIN_ENGINE_ID);
+  ASSERT_EQ(engineIDs[1], fusilli_plugin::kDirectEngineId);
+
+  // Create a serialized hipDNN conv_fprop graph with a padded input, its rows
+  // strided by more than their width.
+  builder = createValidConvFwdGraph(
+      /*xUID=*/0, /*wUID=*/1, /*yUID=*/2,
+      /*dataType=*/hipdnn_sdk::data_objects::DataType::FLOAT,
+      /*xDims=*/{4, 4, 4, 4}, /*xStrides=*/{128, 32, 8, 1});
+  opGraph.ptr = builder.GetBufferPointer();
+  opGraph.size = builder.GetSize();
+
+  // Fusilli plugin should not offer to compile and execute it.
+  ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
+                handle, &opGraph, engineIDs.data(), 5, &numEngines),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_EQ(numEngines, 0);
+
+  // Create a serialized hipDNN conv_fprop graph without a data type.
+  builder = createValidConvFwdGraph(
+      /*xUID=*/0, /*wUID=*/1, /*yUID=*/2,
+      /*dataType=*/hipdnn_sdk::data_objects::DataType::UNSET);
+  opGraph.ptr = builder.GetBufferPointer();
+  opGraph.size = builder.GetSize();
+
+  // Fusilli plugin should not offer to compile and execute it.
+  ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
+                handle, &opGraph, engineIDs.data(), 5, &numEngines),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_EQ(numEngines, 0);
 
   // Create a serialized hipDNN conv_fprop graph with asymmetric padding.
   builder = createValidConvFwdGraph(
@@ -359,16 +569,173 @@ TEST(TestFusilliPluginApi, CreateExecutionContext) {
   EXPECT_FALSE(yTensor->isVirtual());
 
   // Verify graph properties.
-  EXPECT_EQ(ctx->graph.context.getIODataType(), expectedDataType);
-  EXPECT_EQ(ctx->graph.context.getIntermediateDataType(), expectedDataType);
-  EXPECT_EQ(ctx->graph.context.getComputeDataType(), expectedDataType);
+  EXPECT_EQ(ctx->graph->context.getIODataType(), expectedDataType);
+  EXPECT_EQ(ctx->graph->context.getIntermediateDataType(), expectedDataType);
+  EXPECT_EQ(ctx->graph->context.getComputeDataType(), expectedDataType);
+
+  // A context created again for the same op graph reuses the compiled graph.
+  hipdnnEnginePluginExecutionContext_t cachedExecutionContext = nullptr;
+  ASSERT_EQ(hipdnnEnginePluginCreateExecutionContext(
+                handle, &engineConfigData, &opGraph, &cachedExecutionContext),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  auto *cachedCtx =
+      static_cast<HipdnnEnginePluginExecutionContext *>(cachedExecutionContext);
+  EXPECT_NE(cachedCtx, ctx);
+  EXPECT_EQ(cachedCtx->graph, ctx->graph);
+  EXPECT_EQ(cachedCtx->uidToFusilliTensorAttr, ctx->uidToFusilliTensorAttr);
+
+  // The engine counted a single import and compilation, and a cache hit.
+  const fusilli_plugin::EngineCounters &counters =
+      static_cast<HipdnnEnginePluginHandle *>(handle)->getEngineCounters(
+          FUSILLI_PLUGIN_ENGINE_ID);
+  EXPECT_EQ(counters.numImports, 1);
+  EXPECT_EQ(counters.numCompiles, 1);
+  EXPECT_EQ(counters.numCacheHits, 1);
+  EXPECT_EQ(counters.numExecutions, 0);
 
   // Clean up.
+  EXPECT_EQ(hipdnnEnginePluginDestroyExecutionContext(handle,
+                                                      cachedExecutionContext),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  EXPECT_EQ(hipdnnEnginePluginDestroyExecutionContext(handle, executionContext),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  EXPECT_EQ(hipdnnEnginePluginDestroy(handle), HIPDNN_PLUGIN_STATUS_SUCCESS);
+}
+
+TEST(TestFusilliPluginApi, AsyncCompile) {
+  // Create plugin handle compiling graphs in the background.
+  setenv("FUSILLI_PLUGIN_ASYNC_COMPILE", "1", /*overwrite=*/1);
+  hipdnnEnginePluginHandle_t handle = nullptr;
+  ASSERT_EQ(hipdnnEnginePluginCreate(&handle), HIPDNN_PLUGIN_STATUS_SUCCESS);
+  unsetenv("FUSILLI_PLUGIN_ASYNC_COMPILE");
+  ASSERT_NE(handle, nullptr);
+  EXPECT_TRUE(handle->asyncCompile);
+
+  // Create a serialized hipDNN conv_fprop graph.
+  auto builder = createValidConvFwdGraph();
+  hipdnnPluginConstData_t opGraph;
+  opGraph.ptr = builder.GetBufferPointer();
+  opGraph.size = builder.GetSize();
+
+  // Engines start compiling the graph on the first query, and are not
+  // applicable until they're done.
+  std::array<int64_t, 5> engineIDs;
+  uint32_t numEngines = -1;
+  ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
+                handle, &opGraph, engineIDs.data(), 5, &numEngines),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  EXPECT_EQ(numEngines, 0);
+
+  // Creating an execution context waits for the compilation.
+  flatbuffers::FlatBufferBuilder configBuilder;
+  auto engineConfig = hipdnn_sdk::data_objects::CreateEngineConfig(
+      configBuilder, FUSILLI_PLUGIN_ENGINE_ID);
+  configBuilder.Finish(engineConfig);
+  hipdnnPluginConstData_t engineConfigData;
+  engineConfigData.ptr = configBuilder.GetBufferPointer();
+  engineConfigData.size = configBuilder.GetSize();
+  hipdnnEnginePluginExecutionContext_t executionContext = nullptr;
+  ASSERT_EQ(hipdnnEnginePluginCreateExecutionContext(
+                handle, &engineConfigData, &opGraph, &executionContext),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_NE(executionContext, nullptr);
+
+  // The engine that compiled the graph is now applicable.
+  ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
+                handle, &opGraph, engineIDs.data(), 5, &numEngines),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_GE(numEngines, 1);
+  EXPECT_EQ(engineIDs[0], FUSILLI_PLUGIN_ENGINE_ID);
+
+  // Clean up, waiting for the compilations of the other engines.
   EXPECT_EQ(hipdnnEnginePluginDestroyExecutionContext(handle, executionContext),
             HIPDNN_PLUGIN_STATUS_SUCCESS);
   EXPECT_EQ(hipdnnEnginePluginDestroy(handle), HIPDNN_PLUGIN_STATUS_SUCCESS);
 }
 
+TEST(TestFusilliPluginApi, ConvFwdBiasReluGraph) {
+  // Create plugin handle.
+  hipdnnEnginePluginHandle_t handle = nullptr;
+  ASSERT_EQ(hipdnnEnginePluginCreate(&handle), HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_NE(handle, nullptr);
+
+  // UIDs.
+  int64_t xUID = 1;
+  int64_t wUID = 2;
+  int64_t bUID = 3;
+  int64_t yUID = 4;
+
+  // Create a serialized hipDNN conv_fprop + bias + relu graph.
+  auto builder = createValidConvFwdBiasReluGraph(xUID, wUID, bUID, yUID);
+  hipdnnPluginConstData_t opGraph;
+  opGraph.ptr = builder.GetBufferPointer();
+  opGraph.size = builder.GetSize();
+
+  // Fusilli plugin should offer to compile and execute conv_fprop with
+  // pointwise epilogues.
+  std::array<int64_t, 5> engineIDs;
+  uint32_t numEngines = -1;
+  ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
+                handle, &opGraph, engineIDs.data(), 5, &numEngines),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_EQ(numEngines, 3);
+  ASSERT_EQ(engineIDs[0], FUSILLI_PLUGIN_ENGINE_ID);
+
+  // Nodes are imported in topological order, with only boundary tensors (x,
+  // w, b, y) tracked as IO tensors.
+  HipdnnEnginePluginExecutionContext ctx =
+      FUSILLI_PLUGIN_EXPECT_UNWRAP(importGraph(&opGraph));
+  EXPECT_EQ(ctx.uidToFusilliTensorAttr.size(), 4);
+  for (int64_t uid : {xUID, wUID, bUID, yUID})
+    EXPECT_TRUE(ctx.uidToFusilliTensorAttr.contains(uid)); // C++ 20
+  EXPECT_FALSE(ctx.uidToFusilliTensorAttr[yUID]->isVirtual());
+  EXPECT_TRUE(isOk(ctx.graph->validate()));
+
+  // Clean up.
+  EXPECT_EQ(hipdnnEnginePluginDestroy(handle), HIPDNN_PLUGIN_STATUS_SUCCESS);
+}
+
+TEST(TestFusilliPluginApi, ConvFwdReluConvFwdGraph) {
+  // Create plugin handle.
+  hipdnnEnginePluginHandle_t handle = nullptr;
+  ASSERT_EQ(hipdnnEnginePluginCreate(&handle), HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_NE(handle, nullptr);
+
+  // UIDs.
+  int64_t xUID = 1;
+  int64_t w0UID = 2;
+  int64_t w1UID = 3;
+  int64_t yUID = 4;
+
+  // Create a serialized hipDNN conv_fprop + relu + conv_fprop graph.
+  auto builder = createValidConvFwdReluConvFwdGraph(xUID, w0UID, w1UID, yUID);
+  hipdnnPluginConstData_t opGraph;
+  opGraph.ptr = builder.GetBufferPointer();
+  opGraph.size = builder.GetSize();
+
+  // Fusilli plugin should offer to compile and execute the whole graph as
+  // one engine, rather than one per conv_fprop.
+  std::array<int64_t, 5> engineIDs;
+  uint32_t numEngines = -1;
+  ASSERT_EQ(hipdnnEnginePluginGetApplicableEngineIds(
+                handle, &opGraph, engineIDs.data(), 5, &numEngines),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  ASSERT_EQ(numEngines, 3);
+  ASSERT_EQ(engineIDs[0], FUSILLI_PLUGIN_ENGINE_ID);
+
+  // The intermediate tensors stay virtual, only x, w0, w1 and y are IO
+  // tensors.
+  HipdnnEnginePluginExecutionContext ctx =
+      FUSILLI_PLUGIN_EXPECT_UNWRAP(importGraph(&opGraph));
+  EXPECT_EQ(ctx.uidToFusilliTensorAttr.size(), 4);
+  for (int64_t uid : {xUID, w0UID, w1UID, yUID})
+    EXPECT_TRUE(ctx.uidToFusilliTensorAttr.contains(uid)); // C++ 20
+  EXPECT_TRUE(isOk(ctx.graph->validate()));
+
+  // Clean up.
+  EXPECT_EQ(hipdnnEnginePluginDestroy(handle), HIPDNN_PLUGIN_STATUS_SUCCESS);
+}
+
 TEST(TestFusilliPluginApi, SetStreamSuccess) {
   // Create plugin handle.
   hipdnnEnginePluginHandle_t handle = nullptr;
@@ -378,13 +745,29 @@ TEST(TestFusilliPluginApi, SetStreamSuccess) {
   hipStream_t stream;
   ASSERT_EQ(hipStreamCreate(&stream), hipSuccess);
 
+  // Fusilli handle of the default stream.
+  fusilli::Handle *defaultStreamHandle =
+      &FUSILLI_PLUGIN_EXPECT_UNWRAP(handle->getFusilliHandle()).get();
+
   // Set the stream on the handle.
   EXPECT_EQ(hipdnnEnginePluginSetStream(handle, stream),
             HIPDNN_PLUGIN_STATUS_SUCCESS);
+  fusilli::Handle *streamHandle =
+      &FUSILLI_PLUGIN_EXPECT_UNWRAP(handle->getFusilliHandle()).get();
+  EXPECT_NE(streamHandle, defaultStreamHandle);
+
+  // Switching back to a stream reuses its fusilli handle.
+  handle->setStream(0);
+  EXPECT_EQ(&FUSILLI_PLUGIN_EXPECT_UNWRAP(handle->getFusilliHandle()).get(),
+            defaultStreamHandle);
+  EXPECT_EQ(hipdnnEnginePluginSetStream(handle, stream),
+            HIPDNN_PLUGIN_STATUS_SUCCESS);
+  EXPECT_EQ(&FUSILLI_PLUGIN_EXPECT_UNWRAP(handle->getFusilliHandle()).get(),
+            streamHandle);
 
   // Clean up.
-  EXPECT_EQ(hipStreamDestroy(stream), hipSuccess);
   EXPECT_EQ(hipdnnEnginePluginDestroy(handle), HIPDNN_PLUGIN_STATUS_SUCCESS);
+  EXPECT_EQ(hipStreamDestroy(stream), hipSuccess);
 }
 
 TEST(TestFusilliPluginApi, SetStreamNullHandle) {
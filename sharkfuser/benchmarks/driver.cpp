@@ -10,15 +10,29 @@
 
 #include <CLI/CLI.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 using namespace fusilli;
@@ -31,6 +45,266 @@ const auto kIsPositiveInteger =
 const auto kIsValidConvLayout =
     CLI::IsMember({"NCHW", "NHWC", "NCDHW", "NDHWC"});
 
+// IO data type of benchmarked graphs selected by `--fp16` and `--bf16`,
+// defaulting to fp32.
+static DataType getIODataType(bool fp16, bool bf16) {
+  if (fp16)
+    return DataType::Half;
+  if (bf16)
+    return DataType::BFloat16;
+  return DataType::Float;
+}
+
+// Pointwise modes of the activations fused into benchmarked graphs (see
+// `--activation`).
+static const std::unordered_map<std::string, PointwiseAttr::Mode>
+    kActivationModes = {
+        {"relu", PointwiseAttr::Mode::RELU_FWD},
+        {"gelu", PointwiseAttr::Mode::GELU_FWD},
+        {"gelu_tanh", PointwiseAttr::Mode::GELU_APPROX_TANH_FWD},
+        {"sigmoid", PointwiseAttr::Mode::SIGMOID_FWD},
+        {"swish", PointwiseAttr::Mode::SWISH_FWD},
+        {"tanh", PointwiseAttr::Mode::TANH_FWD},
+};
+
+// When set (by the `bundle` subcommand), benchmarks add their compiled graph
+// to the bundle instead of executing it.
+static CompiledBundle *compiledBundle = nullptr;
+
+// Options of the benchmark command run by the thread: commands of a batch
+// run in parallel on several threads (see `runBatch`).
+//
+// When set (by `--autotune`), benchmarks execute their graph with the fastest
+// of these tuning configs (see `autotune`).
+static thread_local std::vector<TuningConfig> autotuneCandidates;
+
+// Executions before the timed ones (set by `--warmup`), and the file to
+// append the timing of benchmarks to in `timingFormat` (set by
+// `--timing_output` and `--timing_format`).
+static thread_local int64_t warmupIterations = 1;
+static thread_local std::string timingOutputPath;
+static thread_local std::string timingFormat = "json";
+
+// When set (by `--compile_stats`), benchmarks report the times of the phases of
+// their compilation (see `compileGraph`).
+static thread_local bool reportCompileStats = false;
+
+// When set (by `--dump_graph`), benchmarks write the description of their
+// graph (see `Graph::serialize`) to `<dir>/<graph name>.json`, to be replayed
+// by the `graph` subcommand (see `compileGraph`).
+static thread_local std::string dumpGraphDir;
+
+// Serializes the reports of benchmarks run in parallel.
+static std::mutex reportMutex;
+
+// Handle the benchmarks of the thread run with, on device `benchmarkDeviceId`
+// (of AMDGPU), created by the first of them: the commands of a batch reuse it,
+// with its IREE instance and device (see `getBenchmarkHandle`).
+static thread_local std::optional<Handle> benchmarkHandle;
+static thread_local int benchmarkDeviceId = 0;
+
+static ErrorOr<Handle *> getBenchmarkHandle() {
+  if (!benchmarkHandle.has_value()) {
+#ifdef FUSILLI_ENABLE_AMDGPU
+    benchmarkHandle =
+        FUSILLI_TRY(Handle::create(Backend::AMDGPU, benchmarkDeviceId));
+#else
+    benchmarkHandle = FUSILLI_TRY(Handle::create(Backend::CPU));
+#endif
+  }
+  return ok(&*benchmarkHandle);
+}
+
+// Compiles `graph`, removing its artifacts when it goes out of scope. With
+// `--compile_stats`, reports the times of the phases of the compilation (see
+// `Graph::getCompileStats`), cold and then warm: the graph is compiled again,
+// reusing the artifacts of the first compilation. The first compilation also
+// hits the cache when it holds artifacts of another process. The scheduling
+// statistics of the compiled artifact (see `Graph::getCompileStatistics`) are
+// reported with them. With `--dump_graph`, the description of the graph is
+// written first.
+static ErrorObject compileGraph(const Handle &handle, Graph &graph) {
+  if (!dumpGraphDir.empty()) {
+    std::filesystem::path path =
+        std::filesystem::path(dumpGraphDir) / (graph.getName() + ".json");
+    std::ofstream output(path);
+    FUSILLI_RETURN_ERROR_IF(!output.is_open(), ErrorCode::FileSystemFailure,
+                            "Failed to open graph description: " +
+                                path.string());
+    output << FUSILLI_TRY(graph.serialize());
+  }
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/true));
+  if (!reportCompileStats)
+    return ok();
+  CompileStats cold = graph.getCompileStats();
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/true));
+  CompileStats warm = graph.getCompileStats();
+  CompileStatistics statistics = FUSILLI_TRY(graph.getCompileStatistics());
+
+  std::lock_guard<std::mutex> lock(reportMutex);
+  std::cout << graph.getName() << ": cold compile (" << cold << ")\n"
+            << graph.getName() << ": warm compile (" << warm << ")\n"
+            << graph.getName() << ": " << statistics << std::endl;
+  return ok();
+}
+
+// Latency statistics of timed executions, in microseconds.
+struct LatencyStats {
+  double min, max, median, p99, mean, stddev;
+};
+
+// Timing of the last benchmark of the thread, reported by `timeExecutions`
+// and collected by `runBatch`.
+struct BenchmarkTiming {
+  std::string name;
+  LatencyStats stats;
+  double tflops, gbps;
+};
+static thread_local std::optional<BenchmarkTiming> lastTiming;
+
+static LatencyStats computeLatencyStats(std::vector<double> latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  size_t count = latencies.size();
+  // Nearest-rank percentiles.
+  auto percentile = [&](double fraction) {
+    size_t rank = static_cast<size_t>(std::ceil(fraction * count));
+    return latencies[std::clamp<size_t>(rank, 1, count) - 1];
+  };
+  double mean =
+      std::accumulate(latencies.begin(), latencies.end(), 0.0) / count;
+  double variance = 0.0;
+  for (double latency : latencies)
+    variance += (latency - mean) * (latency - mean);
+  return LatencyStats{
+      .min = latencies.front(),
+      .max = latencies.back(),
+      .median = percentile(0.5),
+      .p99 = percentile(0.99),
+      .mean = mean,
+      .stddev = std::sqrt(variance / count),
+  };
+}
+
+// FLOPs of a convolution (forward or backward) with the output (or output
+// gradient) dims `yDims` and filter dims `wDims` (K, C / G, spatial...): a
+// multiply-add per output element and element of a filter.
+static double getConvFlops(const std::vector<int64_t> &yDims,
+                           const std::vector<int64_t> &wDims) {
+  double flops = 2.0;
+  for (int64_t dim : yDims)
+    flops *= dim;
+  for (size_t i = 1; i < wDims.size(); ++i)
+    flops *= wDims[i];
+  return flops;
+}
+
+// Escapes `value` for a JSON string.
+static std::string escapeJson(std::string_view value) {
+  std::string escaped;
+  for (char ch : value) {
+    if (ch == '"' || ch == '\\')
+      escaped += '\\';
+    if (ch == '\n')
+      escaped += "\\n";
+    else
+      escaped += ch;
+  }
+  return escaped;
+}
+
+// Quotes `value` for a CSV field.
+static std::string quoteCsv(std::string_view value) {
+  std::string quoted = "\"";
+  for (char ch : value)
+    quoted += ch == '"' ? std::string("\"\"") : std::string(1, ch);
+  return quoted + "\"";
+}
+
+// Executes `graph` with `variantPack` `warmupIterations` times, and then times
+// `iter` executions, each waiting for the fence signaled once it completes on
+// the device (see `Graph::executeAsync`). Reports the latency statistics, and
+// the throughput of `flops` and of the bytes of the bound buffers (read or
+// written once per execution) at the median latency, appending them to
+// `timingOutputPath` when set.
+static ErrorObject timeExecutions(
+    const Handle &handle, const Graph &graph,
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>> &variantPack,
+    int64_t iter, double flops) {
+  std::vector<iree_hal_buffer_view_t *> buffers;
+  double bytes = 0.0;
+  for (const auto &tensor : FUSILLI_TRY(graph.getBindingPlan())) {
+    buffers.push_back(*variantPack.at(tensor));
+    bytes += iree_hal_buffer_view_byte_length(buffers.back());
+  }
+
+  auto executeAndWait = [&]() -> ErrorObject {
+    IreeHalFenceUniquePtrType done =
+        FUSILLI_TRY(graph.executeAsync(handle, buffers));
+    FUSILLI_CHECK_ERROR(iree_hal_fence_wait(
+        done.get(), iree_infinite_timeout(), IREE_HAL_WAIT_FLAG_DEFAULT));
+    return ok();
+  };
+  for (int64_t i = 0; i < warmupIterations; ++i)
+    FUSILLI_CHECK_ERROR(executeAndWait());
+
+  std::vector<double> latencies;
+  latencies.reserve(iter);
+  for (int64_t i = 0; i < iter; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    FUSILLI_CHECK_ERROR(executeAndWait());
+    latencies.push_back(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+  }
+  LatencyStats stats = computeLatencyStats(std::move(latencies));
+  // FLOPs per microsecond to TFLOPS, and bytes per microsecond to GB/s.
+  double tflops = flops / stats.median / 1e6;
+  double gbps = bytes / stats.median / 1e3;
+  lastTiming = BenchmarkTiming{graph.getName(), stats, tflops, gbps};
+
+  std::lock_guard<std::mutex> lock(reportMutex);
+  std::cout << std::format("{}: median {:.2f} us, min {:.2f} us, p99 {:.2f} "
+                           "us, stddev {:.2f} us, {:.3f} TFLOPS, {:.2f} GB/s",
+                           graph.getName(), stats.median, stats.min, stats.p99,
+                           stats.stddev, tflops, gbps)
+            << std::endl;
+  if (timingOutputPath.empty())
+    return ok();
+
+  // Records are appended (as JSON lines, or CSV rows after a header), so that
+  // a run of several benchmarks collects their timings in a single file. They
+  // are keyed by the device architecture and compiler version, to compare
+  // with baselines (see `run_benchmark.py --compare-baseline`).
+  std::string arch = handle.getTarget().empty() ? "host" : handle.getTarget();
+  std::string compilerVersion = FUSILLI_TRY(getIreeCompilerVersion());
+  bool isNew = !std::filesystem::exists(timingOutputPath) ||
+               std::filesystem::is_empty(timingOutputPath);
+  std::ofstream output(timingOutputPath, std::ios::app);
+  FUSILLI_RETURN_ERROR_IF(!output.is_open(), ErrorCode::FileSystemFailure,
+                          "Failed to open timing output: " + timingOutputPath);
+  if (timingFormat == "csv") {
+    if (isNew)
+      output << "name,iter,warmup,min_us,max_us,median_us,p99_us,mean_us,"
+                "stddev_us,tflops,gbps,arch,compiler_version\n";
+    output << std::format("{},{},{},{},{},{},{},{},{},{},{},{},{}\n",
+                          graph.getName(), iter, warmupIterations, stats.min,
+                          stats.max, stats.median, stats.p99, stats.mean,
+                          stats.stddev, tflops, gbps, arch,
+                          quoteCsv(compilerVersion));
+  } else {
+    output << std::format(
+        "{{\"name\": \"{}\", \"iter\": {}, \"warmup\": {}, \"min_us\": "
+        "{}, \"max_us\": {}, \"median_us\": {}, \"p99_us\": {}, "
+        "\"mean_us\": {}, \"stddev_us\": {}, \"tflops\": {}, \"gbps\": "
+        "{}, \"arch\": \"{}\", \"compiler_version\": \"{}\"}}\n",
+        graph.getName(), iter, warmupIterations, stats.min, stats.max,
+        stats.median, stats.p99, stats.mean, stats.stddev, tflops, gbps, arch,
+        escapeJson(compilerVersion));
+  }
+  return ok();
+}
+
 static ErrorObject
 benchmarkConvFprop(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
                    int64_t g, int64_t k, int64_t z, int64_t y, int64_t x,
@@ -38,12 +312,9 @@ benchmarkConvFprop(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
                    int64_t q, int64_t m, int64_t l, int64_t j,
                    std::string_view imageLayout, std::string_view outputLayout,
                    std::string_view filterLayout, int64_t s, bool bias,
+                   std::string_view activation, bool directChannelsLast,
                    int64_t iter, DataType convIOType) {
-#ifdef FUSILLI_ENABLE_AMDGPU
-  Handle handle = FUSILLI_TRY(Handle::create(Backend::AMDGPU));
-#else
-  Handle handle = FUSILLI_TRY(Handle::create(Backend::CPU));
-#endif
+  Handle &handle = *FUSILLI_TRY(getBenchmarkHandle());
 
   // Calculate filter channels
   auto fc = c / g;
@@ -86,9 +357,10 @@ benchmarkConvFprop(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
   auto graphName =
       std::format("benchmark_conv_fprop_n{}_c{}_d{}_h{}_w{}_g{}_k{"
                   "}_z{}_y{}_x{}_t{}_u{}_v{}_o{}"
-                  "_p{}_q{}_m{}_l{}_j{}_S{}_I{}_O{}_F{}_bias{}",
+                  "_p{}_q{}_m{}_l{}_j{}_S{}_I{}_O{}_F{}_bias{}_act{}_direct{}",
                   n, c, d, h, w, g, k, z, y, x, t, u, v, o, p, q, m, l, j, s,
-                  imageLayout, outputLayout, filterLayout, bias);
+                  imageLayout, outputLayout, filterLayout, bias, activation,
+                  directChannelsLast);
   graph.setName(graphName);
 
   // Types on the graph are kept at fp32 but we explicitly set
@@ -115,6 +387,7 @@ benchmarkConvFprop(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
                       .setStride(convStride)
                       .setPadding(convPadding)
                       .setDilation(convDilation)
+                      .setDirectChannelsLast(directChannelsLast)
                       .setName("conv_fprop");
 
   auto yT = graph.convFProp(xT, wT, convAttr);
@@ -131,18 +404,27 @@ benchmarkConvFprop(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
     yT = graph.pointwise(yT, bT, biasAttr);
     yT->setDataType(convIOType);
   }
+  if (!activation.empty()) {
+    auto activationAttr = PointwiseAttr().setMode(
+        kActivationModes.at(std::string(activation)));
+    yT = graph.pointwise(yT, activationAttr);
+  }
   yT->setOutput(true).setDataType(convIOType);
 
   // Validate, infer missing properties
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/true));
+  FUSILLI_CHECK_ERROR(compileGraph(handle, graph));
+  if (compiledBundle)
+    return compiledBundle->add(handle, graph);
 
   // Allocate input, weight and output buffers.
   auto xBuf = FUSILLI_TRY(allocateBufferOfType(handle, xT, convIOType, 1.0f));
   auto wBuf = FUSILLI_TRY(allocateBufferOfType(handle, wT, convIOType, 1.0f));
-  auto yBuf = FUSILLI_TRY(allocateBufferOfType(handle, yT, convIOType, 0.0f));
+  // Outputs are overwritten by executions: allocate them uninitialized.
+  auto yBuf = std::make_shared<Buffer>(FUSILLI_TRY(Buffer::allocate(
+      handle, castToSizeT(yT->getPhysicalDim()), convIOType)));
 
   // Create variant pack.
   std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
@@ -157,11 +439,13 @@ benchmarkConvFprop(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
     variantPack.insert({bT, bBuf});
   }
 
-  // Execute graph a few times.
-  for (size_t i = 0; i < iter; i++)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack));
+  if (!autotuneCandidates.empty())
+    FUSILLI_CHECK_ERROR(autotune(handle, graph, autotuneCandidates,
+                                 variantPack, iter, /*remove=*/true));
 
-  return ok();
+  // Execute and time the graph.
+  return timeExecutions(handle, graph, variantPack, iter,
+                        getConvFlops(yT->getDim(), wDims));
 }
 
 static ErrorObject
@@ -170,13 +454,9 @@ benchmarkConvWGrad(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
                    int64_t t, int64_t u, int64_t v, int64_t o, int64_t p,
                    int64_t q, int64_t m, int64_t l, int64_t j,
                    std::string_view imageLayout, std::string_view outputLayout,
-                   std::string_view filterLayout, int64_t s, int64_t iter,
-                   DataType convIOType) {
-#ifdef FUSILLI_ENABLE_AMDGPU
-  Handle handle = FUSILLI_TRY(Handle::create(Backend::AMDGPU));
-#else
-  Handle handle = FUSILLI_TRY(Handle::create(Backend::CPU));
-#endif
+                   std::string_view filterLayout, int64_t s,
+                   int64_t splitReduction, int64_t iter, DataType convIOType) {
+  Handle &handle = *FUSILLI_TRY(getBenchmarkHandle());
 
   // Calculate filter channels
   auto fc = c / g;
@@ -220,9 +500,9 @@ benchmarkConvWGrad(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
   auto graphName =
       std::format("benchmark_conv_wgrad_n{}_c{}_d{}_h{}_w{}_g{}_k{"
                   "}_z{}_y{}_x{}_t{}_u{}_v{}_o{}"
-                  "_p{}_q{}_m{}_l{}_j{}_S{}_I{}_O{}_F{}",
+                  "_p{}_q{}_m{}_l{}_j{}_S{}_I{}_O{}_F{}_split{}",
                   n, c, d, h, w, g, k, z, y, x, t, u, v, o, p, q, m, l, j, s,
-                  imageLayout, outputLayout, filterLayout);
+                  imageLayout, outputLayout, filterLayout, splitReduction);
   graph.setName(graphName);
 
   graph.setIODataType(DataType::Float)
@@ -243,6 +523,7 @@ benchmarkConvWGrad(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
                       .setStride(convStride)
                       .setPadding(convPadding)
                       .setDilation(convDilation)
+                      .setSplitReductionFactor(splitReduction)
                       .setName("conv_wgrad");
 
   auto dwT = graph.convWGrad(dyT, xT, convAttr);
@@ -252,12 +533,16 @@ benchmarkConvWGrad(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/true));
+  FUSILLI_CHECK_ERROR(compileGraph(handle, graph));
+  if (compiledBundle)
+    return compiledBundle->add(handle, graph);
 
   // Allocate buffers.
   auto dyBuf = FUSILLI_TRY(allocateBufferOfType(handle, dyT, convIOType, 1.0f));
   auto xBuf = FUSILLI_TRY(allocateBufferOfType(handle, xT, convIOType, 1.0f));
-  auto dwBuf = FUSILLI_TRY(allocateBufferOfType(handle, dwT, convIOType, 0.0f));
+  // Outputs are overwritten by executions: allocate them uninitialized.
+  auto dwBuf = std::make_shared<Buffer>(FUSILLI_TRY(Buffer::allocate(
+      handle, castToSizeT(dwT->getPhysicalDim()), convIOType)));
 
   // Create variant pack.
   std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
@@ -267,11 +552,13 @@ benchmarkConvWGrad(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
           {dwT, dwBuf},
       };
 
-  // Execute graph a few times.
-  for (size_t i = 0; i < iter; i++)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack));
+  if (!autotuneCandidates.empty())
+    FUSILLI_CHECK_ERROR(autotune(handle, graph, autotuneCandidates,
+                                 variantPack, iter, /*remove=*/true));
 
-  return ok();
+  // Execute and time the graph.
+  return timeExecutions(handle, graph, variantPack, iter,
+                        getConvFlops(dyDims, wDims));
 }
 
 static ErrorObject
@@ -282,11 +569,7 @@ benchmarkConvDGrad(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
                    std::string_view imageLayout, std::string_view outputLayout,
                    std::string_view filterLayout, int64_t s, int64_t iter,
                    DataType convIOType) {
-#ifdef FUSILLI_ENABLE_AMDGPU
-  Handle handle = FUSILLI_TRY(Handle::create(Backend::AMDGPU));
-#else
-  Handle handle = FUSILLI_TRY(Handle::create(Backend::CPU));
-#endif
+  Handle &handle = *FUSILLI_TRY(getBenchmarkHandle());
 
   // Calculate filter channels
   auto fc = c / g;
@@ -362,12 +645,16 @@ benchmarkConvDGrad(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/true));
+  FUSILLI_CHECK_ERROR(compileGraph(handle, graph));
+  if (compiledBundle)
+    return compiledBundle->add(handle, graph);
 
   // Allocate buffers.
   auto dyBuf = FUSILLI_TRY(allocateBufferOfType(handle, dyT, convIOType, 1.0f));
   auto wBuf = FUSILLI_TRY(allocateBufferOfType(handle, wT, convIOType, 1.0f));
-  auto dxBuf = FUSILLI_TRY(allocateBufferOfType(handle, dxT, convIOType, 0.0f));
+  // Outputs are overwritten by executions: allocate them uninitialized.
+  auto dxBuf = std::make_shared<Buffer>(FUSILLI_TRY(Buffer::allocate(
+      handle, castToSizeT(dxT->getPhysicalDim()), convIOType)));
 
   // Create variant pack.
   std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
@@ -377,26 +664,484 @@ benchmarkConvDGrad(int64_t n, int64_t c, int64_t d, int64_t h, int64_t w,
           {dxT, dxBuf},
       };
 
-  // Execute graph a few times.
-  for (size_t i = 0; i < iter; i++)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack));
+  if (!autotuneCandidates.empty())
+    FUSILLI_CHECK_ERROR(autotune(handle, graph, autotuneCandidates,
+                                 variantPack, iter, /*remove=*/true));
+
+  // Execute and time the graph.
+  return timeExecutions(handle, graph, variantPack, iter,
+                        getConvFlops(dyDims, wDims));
+}
+
+// Joins `dims` with 'x' (e.g. "16x64"), for graph names.
+static std::string joinDims(const std::vector<int64_t> &dims) {
+  std::string joined;
+  for (int64_t dim : dims)
+    joined += (joined.empty() ? "" : "x") + std::to_string(dim);
+  return joined;
+}
+
+// Strides of a matrix (batched or not) of dims `dims` (B..., R, C), stored
+// as (B..., C, R) when `transposed`.
+static std::vector<int64_t> getMatrixStride(const std::vector<int64_t> &dims,
+                                            bool transposed) {
+  std::vector<size_t> strideOrder = getContiguousStrideOrder(dims.size());
+  if (transposed)
+    std::swap(strideOrder[dims.size() - 2], strideOrder[dims.size() - 1]);
+  return generateStrideFromDim(dims, strideOrder);
+}
+
+// Benchmarks C (batch..., M, N) = A (batch..., M, K) * B (batch..., K, N),
+// with B broadcast over the batch dims when `broadcastB` (as the weights of a
+// linear layer), and A and B stored transposed when `transposeA` and
+// `transposeB`.
+static ErrorObject benchmarkMatmul(const std::vector<int64_t> &batch,
+                                   int64_t m, int64_t n, int64_t k,
+                                   bool transposeA, bool transposeB,
+                                   bool broadcastB, bool bias,
+                                   std::string_view activation, int64_t iter,
+                                   DataType matmulIOType) {
+  Handle &handle = *FUSILLI_TRY(getBenchmarkHandle());
+
+  std::vector<int64_t> aDims = batch;
+  aDims.insert(aDims.end(), {m, k});
+  std::vector<int64_t> bDims = broadcastB ? std::vector<int64_t>{} : batch;
+  bDims.insert(bDims.end(), {k, n});
+
+  Graph graph;
+  // Set unique name to prevent concurrent invocations from polluting cache.
+  graph.setName(std::format("benchmark_matmul_b{}_m{}_n{}_k{}_tA{}_tB{}_bB{}"
+                            "_bias{}_act{}",
+                            joinDims(batch), m, n, k, transposeA, transposeB,
+                            broadcastB, bias, activation));
+  graph.setIODataType(DataType::Float)
+      .setComputeDataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
+
+  auto aT = graph.tensor(TensorAttr()
+                             .setName("a")
+                             .setDim(aDims)
+                             .setStride(getMatrixStride(aDims, transposeA))
+                             .setDataType(matmulIOType));
+  auto bT = graph.tensor(TensorAttr()
+                             .setName("b")
+                             .setDim(bDims)
+                             .setStride(getMatrixStride(bDims, transposeB))
+                             .setDataType(matmulIOType));
+
+  auto matmulAttr = MatmulAttr().setName("matmul");
+  auto cT = graph.matmul(aT, bT, matmulAttr);
+  cT->setDataType(matmulIOType);
+
+  // Bias (1..., 1, N) broadcast over the batches and rows of C.
+  std::shared_ptr<TensorAttr> biasT;
+  if (bias) {
+    std::vector<int64_t> biasDims(aDims.size(), 1);
+    biasDims.back() = n;
+    biasT = graph.tensor(
+        TensorAttr()
+            .setName("bias")
+            .setDim(biasDims)
+            .setStride(generateStrideFromDim(
+                biasDims, getContiguousStrideOrder(biasDims.size())))
+            .setDataType(matmulIOType));
+    auto biasAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::ADD);
+    cT = graph.pointwise(cT, biasT, biasAttr);
+    cT->setDataType(matmulIOType);
+  }
+  if (!activation.empty()) {
+    auto activationAttr = PointwiseAttr().setMode(
+        kActivationModes.at(std::string(activation)));
+    cT = graph.pointwise(cT, activationAttr);
+  }
+  cT->setOutput(true).setDataType(matmulIOType);
+
+  FUSILLI_CHECK_ERROR(graph.validate());
+  FUSILLI_CHECK_ERROR(compileGraph(handle, graph));
+  if (compiledBundle)
+    return compiledBundle->add(handle, graph);
+
+  auto aBuf = FUSILLI_TRY(allocateBufferOfType(handle, aT, matmulIOType, 1.0f));
+  auto bBuf = FUSILLI_TRY(allocateBufferOfType(handle, bT, matmulIOType, 1.0f));
+  // Outputs are overwritten by executions: allocate them uninitialized.
+  auto cBuf = std::make_shared<Buffer>(FUSILLI_TRY(Buffer::allocate(
+      handle, castToSizeT(cT->getPhysicalDim()), matmulIOType)));
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {aT, aBuf},
+          {bT, bBuf},
+          {cT, cBuf},
+      };
+  if (bias)
+    variantPack.insert(
+        {biasT, FUSILLI_TRY(allocateBufferOfType(handle, biasT, matmulIOType,
+                                                 1.0f))});
+
+  if (!autotuneCandidates.empty())
+    FUSILLI_CHECK_ERROR(autotune(handle, graph, autotuneCandidates,
+                                 variantPack, iter, /*remove=*/true));
+
+  // A multiply-add per element of C and of the contraction (K) dim.
+  double flops = 2.0 * m * n * k;
+  for (int64_t dim : batch)
+    flops *= dim;
+  return timeExecutions(handle, graph, variantPack, iter, flops);
+}
+
+// Benchmarks a pointwise node of `mode`, reading inputs of `in0Dims`,
+// `in1Dims` and `in2Dims` (as required by the mode), broadcast to the dims of
+// the output as in PyTorch. Inputs are contiguous.
+static ErrorObject benchmarkPointwise(PointwiseAttr::Mode mode,
+                                      const std::vector<int64_t> &in0Dims,
+                                      const std::vector<int64_t> &in1Dims,
+                                      const std::vector<int64_t> &in2Dims,
+                                      std::optional<float> clampMin,
+                                      std::optional<float> clampMax,
+                                      int64_t iter, DataType pointwiseIOType) {
+  Handle &handle = *FUSILLI_TRY(getBenchmarkHandle());
+
+  const std::string &modeName = PointwiseAttr::kModeToStr.at(mode);
+  int numInputs = PointwiseAttr::kModeToRequiredInputCount.at(mode);
+  std::vector<std::vector<int64_t>> inDims = {in0Dims, in1Dims, in2Dims};
+  inDims.resize(numInputs);
+
+  Graph graph;
+  // Set unique name to prevent concurrent invocations from polluting cache.
+  std::string graphName = "benchmark_pointwise_" + modeName;
+  for (const auto &dims : inDims)
+    graphName += "_" + joinDims(dims);
+  if (clampMin)
+    graphName += std::format("_min{}", *clampMin);
+  if (clampMax)
+    graphName += std::format("_max{}", *clampMax);
+  graph.setName(graphName);
+  graph.setIODataType(DataType::Float)
+      .setComputeDataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
+
+  std::vector<std::shared_ptr<TensorAttr>> inTs;
+  for (int i = 0; i < numInputs; ++i)
+    inTs.push_back(graph.tensor(
+        TensorAttr()
+            .setName(std::format("in{}", i))
+            .setDim(inDims[i])
+            .setStride(generateStrideFromDim(
+                inDims[i], getContiguousStrideOrder(inDims[i].size())))
+            .setDataType(pointwiseIOType)));
+
+  auto pointwiseAttr = PointwiseAttr().setMode(mode).setName("pointwise");
+  if (clampMin)
+    pointwiseAttr.setClampMin(*clampMin);
+  if (clampMax)
+    pointwiseAttr.setClampMax(*clampMax);
+  std::shared_ptr<TensorAttr> outT;
+  if (numInputs == 1)
+    outT = graph.pointwise(inTs[0], pointwiseAttr);
+  else if (numInputs == 2)
+    outT = graph.pointwise(inTs[0], inTs[1], pointwiseAttr);
+  else
+    outT = graph.pointwise(inTs[0], inTs[1], inTs[2], pointwiseAttr);
+  outT->setOutput(true).setDataType(pointwiseIOType);
+
+  FUSILLI_CHECK_ERROR(graph.validate());
+  FUSILLI_CHECK_ERROR(compileGraph(handle, graph));
+  if (compiledBundle)
+    return compiledBundle->add(handle, graph);
+
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack;
+  for (const auto &inT : inTs)
+    variantPack.insert(
+        {inT, FUSILLI_TRY(allocateBufferOfType(handle, inT, pointwiseIOType,
+                                               1.0f))});
+  // Outputs are overwritten by executions: allocate them uninitialized.
+  variantPack.insert(
+      {outT, std::make_shared<Buffer>(FUSILLI_TRY(Buffer::allocate(
+                 handle, castToSizeT(outT->getPhysicalDim()),
+                 pointwiseIOType)))});
+
+  if (!autotuneCandidates.empty())
+    FUSILLI_CHECK_ERROR(autotune(handle, graph, autotuneCandidates,
+                                 variantPack, iter, /*remove=*/true));
+
+  // Counted as an operation per output element (pointwise nodes are bound by
+  // memory, see the GB/s instead).
+  return timeExecutions(handle, graph, variantPack, iter,
+                        static_cast<double>(outT->getVolume()));
+}
+
+// Benchmarks the graph described in the file at `path` (see
+// `Graph::deserialize`), e.g. as written by `--dump_graph`. Tensors of the
+// binding plan are filled with ones of their data type.
+static ErrorObject benchmarkGraph(const std::string &path, int64_t iter) {
+  Handle &handle = *FUSILLI_TRY(getBenchmarkHandle());
+
+  std::ifstream file(path);
+  FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                          "Failed to open graph description: " + path);
+  std::stringstream description;
+  description << file.rdbuf();
+  Graph graph = FUSILLI_TRY(Graph::deserialize(description.str()));
+
+  FUSILLI_CHECK_ERROR(graph.validate());
+  FUSILLI_CHECK_ERROR(compileGraph(handle, graph));
+  if (compiledBundle)
+    return compiledBundle->add(handle, graph);
+
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack;
+  for (const auto &tensor : FUSILLI_TRY(graph.getBindingPlan()))
+    variantPack.insert(
+        {tensor, FUSILLI_TRY(allocateBufferOfType(
+                     handle, tensor, tensor->getDataType(), 1.0f))});
+
+  if (!autotuneCandidates.empty())
+    FUSILLI_CHECK_ERROR(autotune(handle, graph, autotuneCandidates,
+                                 variantPack, iter, /*remove=*/true));
+
+  // Operations of arbitrary graphs are not counted: see the GB/s instead.
+  return timeExecutions(handle, graph, variantPack, iter, /*flops=*/0.0);
+}
+
+// Times `Graph::emitAsm()` (without compiling) over a chain of `nodes`
+// pointwise nodes, alternating RELU and ADD to the graph's input.
+static ErrorObject benchmarkEmitAsm(int64_t nodes, int64_t iter) {
+  Graph graph;
+  graph.setName(std::format("benchmark_emit_asm_nodes{}", nodes));
+  graph.setIODataType(DataType::Float)
+      .setComputeDataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
 
+  auto xT = graph.tensor(TensorAttr()
+                             .setName("input")
+                             .setDim({16, 64, 32, 32})
+                             .setStride({65536, 1024, 32, 1}));
+  auto yT = xT;
+  for (int64_t i = 0; i < nodes; ++i) {
+    auto mode = i % 2 == 0 ? PointwiseAttr::Mode::RELU_FWD
+                           : PointwiseAttr::Mode::ADD;
+    auto attr = PointwiseAttr().setMode(mode);
+    yT = i % 2 == 0 ? graph.pointwise(yT, attr)
+                    : graph.pointwise(yT, xT, attr);
+  }
+  yT->setOutput(true);
+  FUSILLI_CHECK_ERROR(graph.validate());
+
+  size_t asmSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < iter; ++i)
+    asmSize = FUSILLI_TRY(graph.emitAsm()).size();
+  auto elapsed = std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - start);
+
+  std::cout << std::format("emitAsm: {} nodes, {} bytes, {:.1f} us/iter",
+                           nodes, asmSize, elapsed.count() / iter)
+            << std::endl;
   return ok();
 }
 
+// Splits a line of benchmark arguments (as in `test_commands.txt`) on
+// whitespace, removing the quotes around arguments.
+static std::vector<std::string> splitArguments(const std::string &line) {
+  std::vector<std::string> args;
+  std::string arg;
+  bool inArg = false, inQuotes = false;
+  for (char ch : line) {
+    if (ch == '"') {
+      inQuotes = !inQuotes;
+      inArg = true;
+    } else if (std::isspace(static_cast<unsigned char>(ch)) && !inQuotes) {
+      if (inArg)
+        args.push_back(std::move(arg));
+      arg.clear();
+      inArg = false;
+    } else {
+      arg += ch;
+      inArg = true;
+    }
+  }
+  if (inArg)
+    args.push_back(std::move(arg));
+  return args;
+}
+
+static int benchmark(int argc, char **argv);
+
+// Reads the benchmark commands in `commandsPath` (one per line, skipping
+// empty, `#` comment and `[SKIP]` lines) to `commands`, as lines and their
+// arguments. Returns false if the file cannot be opened.
+static bool
+readCommands(const std::string &commandsPath,
+             std::vector<std::pair<std::string, std::vector<std::string>>>
+                 &commands) {
+  std::ifstream file(commandsPath);
+  if (!file.is_open()) {
+    std::cerr << "Failed to open benchmark commands: " << commandsPath
+              << std::endl;
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::vector<std::string> args = splitArguments(line);
+    if (args.empty() || args[0].starts_with("#") || args[0] == "[SKIP]")
+      continue;
+    commands.emplace_back(line, std::move(args));
+  }
+  return true;
+}
+
+// Runs the benchmark command of `args`, as if passed to `program`.
+static int runCommand(const char *program, std::vector<std::string> args) {
+  std::vector<char *> argv = {const_cast<char *>(program)};
+  for (std::string &arg : args)
+    argv.push_back(arg.data());
+  return benchmark(static_cast<int>(argv.size()), argv.data());
+}
+
+// Compiles the graphs of the benchmark commands in `commandsPath` (see
+// `readCommands`) and writes their artifacts to a compiled bundle at
+// `outputPath`.
+static int buildBundle(const char *program, const std::string &commandsPath,
+                       const std::string &outputPath) {
+  std::vector<std::pair<std::string, std::vector<std::string>>> commands;
+  if (!readCommands(commandsPath, commands))
+    return 1;
+
+  CompiledBundle bundle;
+  compiledBundle = &bundle;
+  for (const auto &[line, args] : commands) {
+    int returnCode = runCommand(program, args);
+    if (returnCode) {
+      compiledBundle = nullptr;
+      return returnCode;
+    }
+  }
+  compiledBundle = nullptr;
+
+  ErrorObject status = bundle.write(outputPath);
+  if (isError(status)) {
+    std::cerr << "Fusilli bundle failed: " << status << std::endl;
+    return 1;
+  }
+  std::cout << "Bundled " << bundle.size() << " graphs in " << outputPath
+            << std::endl;
+  return 0;
+}
+
+// Runs the benchmark commands in `commandsPath` (see `readCommands`) in this
+// process, so that the commands run by a thread reuse its handle (see
+// `getBenchmarkHandle`), on `numDevices` devices in parallel: a thread per
+// device takes the commands in turn. Reports the timing of each command at
+// the end, in a table.
+static int runBatch(const char *program, const std::string &commandsPath,
+                    int64_t numDevices) {
+  std::vector<std::pair<std::string, std::vector<std::string>>> commands;
+  if (!readCommands(commandsPath, commands))
+    return 1;
+
+  struct Result {
+    int returnCode = 0;
+    std::optional<BenchmarkTiming> timing;
+  };
+  std::vector<Result> results(commands.size());
+  std::atomic<size_t> nextCommand = 0;
+  auto runCommands = [&](int deviceId) {
+    benchmarkDeviceId = deviceId;
+    for (size_t i = nextCommand++; i < commands.size(); i = nextCommand++) {
+      lastTiming.reset();
+      // Exceptions are caught in the thread running the command, as `main`
+      // catches them for the main thread.
+      try {
+        results[i].returnCode = runCommand(program, commands[i].second);
+      } catch (const std::exception &e) {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+        results[i].returnCode = 1;
+      }
+      results[i].timing = std::move(lastTiming);
+    }
+    // Release the device of the thread before it exits.
+    benchmarkHandle.reset();
+  };
+  std::vector<std::thread> threads;
+  for (int64_t deviceId = 1; deviceId < numDevices; ++deviceId)
+    threads.emplace_back(runCommands, static_cast<int>(deviceId));
+  runCommands(/*deviceId=*/0);
+  for (std::thread &thread : threads)
+    thread.join();
+
+  int returnCode = 0;
+  std::cout << std::format("\n{:>4} {:>7} {:>12} {:>12} {:>10} {:>10}  {}\n",
+                           "#", "status", "median (us)", "p99 (us)",
+                           "TFLOPS", "GB/s", "command");
+  for (size_t i = 0; i < commands.size(); ++i) {
+    const Result &result = results[i];
+    if (result.returnCode)
+      returnCode = 1;
+    std::string status = result.returnCode ? "failed" : "ok";
+    if (result.timing)
+      std::cout << std::format(
+          "{:>4} {:>7} {:>12.2f} {:>12.2f} {:>10.3f} {:>10.2f}  {}\n", i,
+          status, result.timing->stats.median, result.timing->stats.p99,
+          result.timing->tflops, result.timing->gbps, commands[i].first);
+    else
+      std::cout << std::format("{:>4} {:>7} {:>12} {:>12} {:>10} {:>10}  {}\n",
+                               i, status, "-", "-", "-", "-",
+                               commands[i].first);
+  }
+  std::cout << std::flush;
+  return returnCode;
+}
+
 static int benchmark(int argc, char **argv) {
   CLI::App mainApp{"Fusilli Benchmark Driver"};
   mainApp.require_subcommand(1);
 
   int64_t iter;
-  mainApp.add_option("--iter,-i", iter, "Benchmark iterations")
-      ->required()
-      ->check(kIsPositiveInteger);
+  auto *iterOption =
+      mainApp.add_option("--iter,-i", iter, "Benchmark iterations")
+          ->check(kIsPositiveInteger);
+  std::string loadBundlePath;
+  mainApp.add_option("--load_bundle", loadBundlePath,
+                     "Compiled bundle to load before benchmarking")
+      ->check(CLI::ExistingFile);
+  std::string tuningDbPath, autotunePath;
+  mainApp.add_option("--tuning_db", tuningDbPath,
+                     "Tuning database (see TuningRegistry) to load before "
+                     "benchmarking, and to save autotuning results to");
+  mainApp
+      .add_option("--autotune", autotunePath,
+                  "Tuning configs to autotune the benchmarked graph over, "
+                  "one per line (compiler flags)")
+      ->check(CLI::ExistingFile);
+  mainApp
+      .add_option("--warmup", warmupIterations,
+                  "Executions before the timed iterations")
+      ->default_val("1")
+      ->check(kIsNonNegativeInteger);
+  mainApp.add_flag("--compile_stats", reportCompileStats,
+                   "Report the times of the phases of cold and warm "
+                   "compilations of benchmarked graphs");
+  mainApp.add_option("--timing_output", timingOutputPath,
+                     "File to append the latency statistics and throughput "
+                     "of benchmarks to");
+  mainApp
+      .add_option("--timing_format", timingFormat,
+                  "Format of the timing output: json (one object per line) "
+                  "or csv")
+      ->default_val("json")
+      ->check(CLI::IsMember({"json", "csv"}));
+  mainApp
+      .add_option("--dump_graph", dumpGraphDir,
+                  "Directory to write the descriptions of benchmarked graphs "
+                  "to (see the graph subcommand)")
+      ->check(CLI::ExistingDirectory);
 
   // Conv flags are kept in sync with MIOpen's ConvDriver:
   // https://github.com/ROCm/rocm-libraries/blob/db0544fb61f2c7bd5a86dce98d4963420c1c741a/projects/miopen/driver/conv_driver.hpp#L878
   CLI::App *convApp =
       mainApp.add_subcommand("conv", "Fusilli Benchmark Convolution");
+  convApp->needs(iterOption);
 
   // CLI Options:
   int64_t n, c, d, h, w, g, k, z, y, x, t, u, v, o, p, q, m, l, j, s;
@@ -480,17 +1225,223 @@ static int benchmark(int argc, char **argv) {
       ->check(CLI::IsMember({2, 3}));
 
   // CLI Flags:
-  bool fp16{false}, bf16{false}, bias{false};
+  bool fp16{false}, bf16{false}, bias{false}, directChannelsLast{false};
   auto *f1 = convApp->add_flag("--fp16", fp16, "Run fp16 convolution");
   auto *f2 = convApp->add_flag("--bf16", bf16, "Run bf16 convolution");
   // Can't specify both flags.
   f1->excludes(f2);
   convApp->add_flag("--bias,-b", bias, "Run with bias (only for mode=1)");
+  convApp->add_flag("--direct_channels_last", directChannelsLast,
+                    "Emit channels-last 2D convolutions directly as linalg "
+                    "convolutions, without permutes (only for mode=1)");
+  std::vector<std::string> activationNames;
+  for (const auto &[name, activationMode] : kActivationModes)
+    activationNames.push_back(name);
+  std::string convActivation;
+  convApp
+      ->add_option("--activation", convActivation,
+                   "Activation fused after the convolution (and bias), only "
+                   "for mode=1")
+      ->check(CLI::IsMember(activationNames));
+  int64_t splitReduction{1};
+  convApp
+      ->add_option("--split_reduction", splitReduction,
+                   "Number of batch parts whose weight gradients are computed "
+                   "concurrently and summed (only for mode=4)")
+      ->check(kIsPositiveInteger);
+
+  // Batched matrix multiplications, with fused bias and activation.
+  CLI::App *matmulApp =
+      mainApp.add_subcommand("matmul", "Fusilli Benchmark Matmul");
+  matmulApp->needs(iterOption);
+  std::vector<int64_t> matmulBatch;
+  int64_t matmulM, matmulN, matmulK;
+  matmulApp->add_option("--batch", matmulBatch, "Batch dims (none by default)")
+      ->check(kIsPositiveInteger);
+  matmulApp->add_option("-m", matmulM, "Rows of A and C (M)")
+      ->required()
+      ->check(kIsPositiveInteger);
+  matmulApp->add_option("-n", matmulN, "Columns of B and C (N)")
+      ->required()
+      ->check(kIsPositiveInteger);
+  matmulApp->add_option("-k", matmulK, "Contraction dim (K)")
+      ->required()
+      ->check(kIsPositiveInteger);
+  bool matmulFp16{false}, matmulBf16{false}, transposeA{false},
+      transposeB{false}, broadcastB{false}, matmulBias{false};
+  auto *matmulF1 = matmulApp->add_flag("--fp16", matmulFp16, "Run fp16 matmul");
+  auto *matmulF2 = matmulApp->add_flag("--bf16", matmulBf16, "Run bf16 matmul");
+  matmulF1->excludes(matmulF2);
+  matmulApp->add_flag("--transpose_a", transposeA, "Store A as (K, M)");
+  matmulApp->add_flag("--transpose_b", transposeB, "Store B as (N, K)");
+  matmulApp->add_flag("--broadcast_b", broadcastB,
+                      "Broadcast B (K, N) over the batch dims of A");
+  matmulApp->add_flag("--bias", matmulBias, "Run with bias (N)");
+  std::string matmulActivation;
+  matmulApp
+      ->add_option("--activation", matmulActivation,
+                   "Activation fused after the matmul (and bias)")
+      ->check(CLI::IsMember(activationNames));
+
+  // Pointwise nodes of any mode, with inputs broadcast to the output dims.
+  CLI::App *pointwiseApp =
+      mainApp.add_subcommand("pointwise", "Fusilli Benchmark Pointwise");
+  pointwiseApp->needs(iterOption);
+  std::vector<std::string> modeNames;
+  for (const auto &[pointwiseMode, name] : PointwiseAttr::kModeToStr)
+    if (pointwiseMode != PointwiseAttr::Mode::NOT_SET)
+      modeNames.push_back(name);
+  std::string pointwiseModeName;
+  std::vector<int64_t> in0Dims, in1Dims, in2Dims;
+  std::optional<float> clampMin, clampMax;
+  pointwiseApp->add_option("--mode", pointwiseModeName, "Pointwise mode")
+      ->required()
+      ->check(CLI::IsMember(modeNames));
+  pointwiseApp->add_option("--in0_dims", in0Dims, "Dims of input IN_0")
+      ->required()
+      ->check(kIsPositiveInteger);
+  pointwiseApp
+      ->add_option("--in1_dims", in1Dims,
+                   "Dims of input IN_1 (default: those of IN_0)")
+      ->check(kIsPositiveInteger);
+  pointwiseApp
+      ->add_option("--in2_dims", in2Dims,
+                   "Dims of input IN_2 (default: those of IN_0)")
+      ->check(kIsPositiveInteger);
+  pointwiseApp->add_option("--clamp_min", clampMin, "Min of CLAMP mode");
+  pointwiseApp->add_option("--clamp_max", clampMax, "Max of CLAMP mode");
+  bool pointwiseFp16{false}, pointwiseBf16{false};
+  auto *pointwiseF1 =
+      pointwiseApp->add_flag("--fp16", pointwiseFp16, "Run fp16 pointwise");
+  auto *pointwiseF2 =
+      pointwiseApp->add_flag("--bf16", pointwiseBf16, "Run bf16 pointwise");
+  pointwiseF1->excludes(pointwiseF2);
+
+  // Graphs of any nodes, read from their description (see `Graph::serialize`).
+  CLI::App *graphApp = mainApp.add_subcommand(
+      "graph", "Fusilli Benchmark of a serialized graph");
+  graphApp->needs(iterOption);
+  std::string graphPath;
+  graphApp
+      ->add_option("--file", graphPath,
+                   "Graph description (JSON, e.g. written by --dump_graph)")
+      ->required()
+      ->check(CLI::ExistingFile);
+
+  // Times the MLIR assembly emission of a large graph (see `emitAsm`).
+  CLI::App *emitApp =
+      mainApp.add_subcommand("emit", "Fusilli MLIR assembly emission");
+  emitApp->needs(iterOption);
+  int64_t emitNodes;
+  emitApp->add_option("--nodes", emitNodes, "Number of pointwise nodes")
+      ->default_val("500")
+      ->check(kIsPositiveInteger);
+
+  // Reports the usage of the compilation cache (see `CacheManager`).
+  CLI::App *cacheApp =
+      mainApp.add_subcommand("cache", "Fusilli compilation cache stats");
+  bool evict = false;
+  cacheApp->add_flag("--evict", evict,
+                     "Evict least recently used entries past the size limit "
+                     "(FUSILLI_CACHE_MAX_SIZE)");
+
+  // Runs many benchmark commands in this process (see `runBatch`).
+  CLI::App *batchApp = mainApp.add_subcommand(
+      "batch", "Fusilli benchmark commands run in a single process");
+  std::string batchCommandsPath;
+  int64_t numDevices;
+  batchApp
+      ->add_option("--commands", batchCommandsPath,
+                   "Benchmark commands, one per line (as test_commands.txt)")
+      ->required()
+      ->check(CLI::ExistingFile);
+  batchApp
+      ->add_option("--devices", numDevices,
+                   "Number of devices to run commands on in parallel")
+      ->default_val("1")
+      ->check(kIsPositiveInteger);
+
+  // Compiles the graphs of benchmark commands ahead of time in a bundle (see
+  // `CompiledBundle`), to be loaded with `--load_bundle`.
+  CLI::App *bundleApp = mainApp.add_subcommand(
+      "bundle", "Fusilli compiled bundle of benchmark commands");
+  std::string commandsPath, outputPath;
+  bundleApp
+      ->add_option("--commands", commandsPath,
+                   "Benchmark commands, one per line (as test_commands.txt)")
+      ->required()
+      ->check(CLI::ExistingFile);
+  bundleApp->add_option("--output,-o", outputPath, "Compiled bundle path")
+      ->required();
 
   CLI11_PARSE(mainApp, argc, argv);
 
+  if (bundleApp->parsed())
+    return buildBundle(argv[0], commandsPath, outputPath);
+
+  if (batchApp->parsed())
+    return runBatch(argv[0], batchCommandsPath, numDevices);
+
+  if (cacheApp->parsed()) {
+    if (evict) {
+      ErrorObject status = CacheManager::enforceSizeLimit();
+      if (isError(status)) {
+        std::cerr << "Fusilli cache eviction failed: " << status << std::endl;
+        return 1;
+      }
+    }
+    ErrorOr<CacheStats> stats = CacheManager::getStats();
+    if (isError(stats)) {
+      std::cerr << "Fusilli cache stats failed: " << ErrorObject(stats)
+                << std::endl;
+      return 1;
+    }
+    std::cout << *stats << std::endl;
+    return 0;
+  }
+
+  if (!loadBundlePath.empty()) {
+    ErrorOr<size_t> numGraphs = CompiledBundle::load(loadBundlePath);
+    if (isError(numGraphs)) {
+      std::cerr << "Fusilli bundle loading failed: " << ErrorObject(numGraphs)
+                << std::endl;
+      return 1;
+    }
+  }
+
+  if (!tuningDbPath.empty() && std::filesystem::exists(tuningDbPath)) {
+    ErrorOr<size_t> numConfigs = TuningRegistry::load(tuningDbPath);
+    if (isError(numConfigs)) {
+      std::cerr << "Fusilli tuning database loading failed: "
+                << ErrorObject(numConfigs) << std::endl;
+      return 1;
+    }
+  }
+
+  autotuneCandidates.clear();
+  if (!autotunePath.empty()) {
+    std::ifstream configs(autotunePath);
+    std::string line;
+    while (std::getline(configs, line))
+      if (!line.starts_with("#"))
+        autotuneCandidates.push_back(TuningConfig::parse(line));
+    if (autotuneCandidates.empty()) {
+      std::cerr << "No tuning configs to autotune over in: " << autotunePath
+                << std::endl;
+      return 1;
+    }
+  }
+
   std::cout << "Fusilli Benchmark started..." << std::endl;
 
+  if (emitApp->parsed()) {
+    ErrorObject status = benchmarkEmitAsm(emitNodes, iter);
+    if (isError(status)) {
+      std::cerr << "Fusilli Benchmark failed: " << status << std::endl;
+      return 1;
+    }
+  }
+
   if (convApp->parsed()) {
     // Additional validation of convApp options (apart from default CLI checks)
     if (s == 2) {
@@ -535,21 +1486,36 @@ static int benchmark(int argc, char **argv) {
       return 1;
     }
 
-    DataType convIOType;
-    if (fp16)
-      convIOType = DataType::Half;
-    else if (bf16)
-      convIOType = DataType::BFloat16;
-    else
-      // When unspecified, default to fp32 conv.
-      convIOType = DataType::Float;
+    if (!convActivation.empty() && mode != 1) {
+      std::cerr << "Activation option (--activation) is only supported for "
+                   "forward convolution (mode=1)."
+                << std::endl;
+      return 1;
+    }
+
+    if (directChannelsLast && mode != 1) {
+      std::cerr << "Direct channels-last flag (--direct_channels_last) is only "
+                   "supported for forward convolution (mode=1)."
+                << std::endl;
+      return 1;
+    }
+
+    if (splitReduction != 1 && mode != 4) {
+      std::cerr << "Split reduction option (--split_reduction) is only "
+                   "supported for weight gradient convolution (mode=4)."
+                << std::endl;
+      return 1;
+    }
+
+    DataType convIOType = getIODataType(fp16, bf16);
 
     ErrorObject status = ok();
     if (mode == 1) {
       // Forward convolution
       status = benchmarkConvFprop(n, c, d, h, w, g, k, z, y, x, t, u, v, o, p,
                                   q, m, l, j, imageLayout, outputLayout,
-                                  filterLayout, s, bias, iter, convIOType);
+                                  filterLayout, s, bias, convActivation,
+                                  directChannelsLast, iter, convIOType);
     } else if (mode == 2) {
       // Data gradient
       status = benchmarkConvDGrad(n, c, d, h, w, g, k, z, y, x, t, u, v, o, p,
@@ -559,7 +1525,8 @@ static int benchmark(int argc, char **argv) {
       // Weight gradient
       status = benchmarkConvWGrad(n, c, d, h, w, g, k, z, y, x, t, u, v, o, p,
                                   q, m, l, j, imageLayout, outputLayout,
-                                  filterLayout, s, iter, convIOType);
+                                  filterLayout, s, splitReduction, iter,
+                                  convIOType);
     }
 
     if (isError(status)) {
@@ -568,6 +1535,49 @@ static int benchmark(int argc, char **argv) {
     }
   }
 
+  if (matmulApp->parsed()) {
+    ErrorObject status = benchmarkMatmul(
+        matmulBatch, matmulM, matmulN, matmulK, transposeA, transposeB,
+        broadcastB, matmulBias, matmulActivation, iter,
+        getIODataType(matmulFp16, matmulBf16));
+    if (isError(status)) {
+      std::cerr << "Fusilli Benchmark failed: " << status << std::endl;
+      return 1;
+    }
+  }
+
+  if (pointwiseApp->parsed()) {
+    PointwiseAttr::Mode pointwiseMode = PointwiseAttr::Mode::NOT_SET;
+    for (const auto &[candidate, name] : PointwiseAttr::kModeToStr)
+      if (name == pointwiseModeName)
+        pointwiseMode = candidate;
+    ErrorObject status = benchmarkPointwise(
+        pointwiseMode, in0Dims, in1Dims.empty() ? in0Dims : in1Dims,
+        in2Dims.empty() ? in0Dims : in2Dims, clampMin, clampMax, iter,
+        getIODataType(pointwiseFp16, pointwiseBf16));
+    if (isError(status)) {
+      std::cerr << "Fusilli Benchmark failed: " << status << std::endl;
+      return 1;
+    }
+  }
+
+  if (graphApp->parsed()) {
+    ErrorObject status = benchmarkGraph(graphPath, iter);
+    if (isError(status)) {
+      std::cerr << "Fusilli Benchmark failed: " << status << std::endl;
+      return 1;
+    }
+  }
+
+  if (!autotuneCandidates.empty() && !tuningDbPath.empty()) {
+    ErrorObject status = TuningRegistry::save(tuningDbPath);
+    if (isError(status)) {
+      std::cerr << "Fusilli tuning database saving failed: " << status
+                << std::endl;
+      return 1;
+    }
+  }
+
   std::cout << "Fusilli Benchmark complete!" << std::endl;
   return 0;
 }
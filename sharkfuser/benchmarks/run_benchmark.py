@@ -8,6 +8,7 @@
 import argparse
 import csv
 import glob
+import json
 import os
 import shlex
 import statistics
@@ -25,17 +26,36 @@ class TimingStats(NamedTuple):
     stddev: float | str = "N.A."
     iter: int | str = "N.A."
     dispatch_count: int | str = "N.A."
+    # Only timed by the driver (with --driver-timing).
+    median: float | str = "N.A."
+    p99: float | str = "N.A."
+    tflops: float | str = "N.A."
+    gbps: float | str = "N.A."
 
 
 class CommandResult(NamedTuple):
     stats: TimingStats
+    # Keys of baselines (see `compare_baseline`), reported by the driver.
+    arch: str = "N.A."
+    compiler_version: str = "N.A."
     timed_out: bool = False
     failed: bool = False
     skipped: bool = False
     succeeded: bool = False
 
 
-ALL_METRICS = ["min", "max", "mean", "stddev", "iter", "dispatch_count"]
+ALL_METRICS = [
+    "min",
+    "max",
+    "mean",
+    "stddev",
+    "iter",
+    "dispatch_count",
+    "median",
+    "p99",
+    "tflops",
+    "gbps",
+]
 
 
 def parse_rocprof_csv(output_dir: Path, iter_count: int) -> TimingStats:
@@ -119,6 +139,39 @@ def parse_rocprof_csv(output_dir: Path, iter_count: int) -> TimingStats:
     )
 
 
+# Format of baseline files, bumped on incompatible changes.
+BASELINE_FORMAT_VERSION = 1
+
+# Metrics compared with baselines (lower is better).
+BASELINE_METRICS = ["min", "mean", "median", "p99"]
+
+
+def read_driver_record(timing_file: Path) -> dict:
+    # The driver appends a JSON object per benchmark: the command benchmarks
+    # a single graph.
+    if not timing_file.exists():
+        return {}
+    lines = timing_file.read_text().splitlines()
+    return json.loads(lines[-1]) if lines else {}
+
+
+def parse_driver_timing(timing_file: Path) -> TimingStats:
+    record = read_driver_record(timing_file)
+    if not record:
+        return TimingStats()
+    return TimingStats(
+        min=float(record["min_us"]),
+        max=float(record["max_us"]),
+        mean=float(record["mean_us"]),
+        stddev=float(record["stddev_us"]),
+        iter=record["iter"],
+        median=float(record["median_us"]),
+        p99=float(record["p99_us"]),
+        tflops=float(record["tflops"]),
+        gbps=float(record["gbps"]),
+    )
+
+
 def run_profiled_command(
     command: str,
     driver_path: str,
@@ -127,6 +180,7 @@ def run_profiled_command(
     verbose: bool,
     cmd_num: int,
     timeout: int,
+    driver_timing: bool = False,
 ) -> CommandResult:
 
     driver_args = command.split()
@@ -141,8 +195,6 @@ def run_profiled_command(
         if iter_idx + 1 < len(driver_args):
             iter_count = int(driver_args[iter_idx + 1])
 
-    driver_cmd = [driver_path] + driver_args
-
     # Use either temporary directory or persistent directory
     if output_dir is None:
         tmpdir_context = tempfile.TemporaryDirectory()
@@ -153,25 +205,35 @@ def run_profiled_command(
         cmd_output_dir.mkdir(parents=True, exist_ok=True)
 
     try:
-        rocprof_cmd = (
-            [
-                "rocprofv3",
-                "--output-format",
-                "csv",
-                "--output-directory",
-                str(cmd_output_dir),
-            ]
-            + rocprof_args
-            + ["--"]
-            + driver_cmd
-        )
+        # The driver always writes its timing record, which carries the arch
+        # and compiler version keying baselines. Options of the driver precede
+        # its subcommand.
+        timing_file = cmd_output_dir / "timing.json"
+        timing_args = ["--timing_output", str(timing_file), "--timing_format", "json"]
+        if driver_timing:
+            run_cmd = [driver_path] + timing_args + driver_args
+        else:
+            # Warmup executions would be traced as iterations.
+            driver_cmd = [driver_path, "--warmup", "0"] + timing_args + driver_args
+            run_cmd = (
+                [
+                    "rocprofv3",
+                    "--output-format",
+                    "csv",
+                    "--output-directory",
+                    str(cmd_output_dir),
+                ]
+                + rocprof_args
+                + ["--"]
+                + driver_cmd
+            )
 
         if verbose:
-            print(f">>> {shlex.join(rocprof_cmd)}\n")
+            print(f">>> {shlex.join(run_cmd)}\n")
 
         timeout_val = None if timeout == -1 else timeout
         result = subprocess.run(
-            rocprof_cmd,
+            run_cmd,
             check=True,
             capture_output=True,
             text=True,
@@ -181,12 +243,21 @@ def run_profiled_command(
         if verbose and result.stdout:
             print(result.stdout)
 
-        stats = parse_rocprof_csv(cmd_output_dir, iter_count)
+        if driver_timing:
+            stats = parse_driver_timing(timing_file)
+        else:
+            stats = parse_rocprof_csv(cmd_output_dir, iter_count)
         print(
             f">>> Stats: min={stats.min:.2f}(us), max={stats.max:.2f}(us), mean={stats.mean:.2f}(us), iter={stats.iter}, dispatch_count={stats.dispatch_count}"
         )
 
-        return CommandResult(stats, succeeded=True)
+        record = read_driver_record(timing_file)
+        return CommandResult(
+            stats,
+            arch=record.get("arch", "N.A."),
+            compiler_version=record.get("compiler_version", "N.A."),
+            succeeded=True,
+        )
 
     except subprocess.TimeoutExpired:
         if verbose:
@@ -208,6 +279,96 @@ def run_profiled_command(
             tmpdir_context.__exit__(None, None, None)
 
 
+def load_baseline(baseline_file: Path) -> list[dict]:
+    if not baseline_file.exists():
+        return []
+    baseline = json.loads(baseline_file.read_text())
+    if baseline.get("format_version") != BASELINE_FORMAT_VERSION:
+        raise RuntimeError(
+            f"Unsupported baseline format version {baseline.get('format_version')} "
+            f"in {baseline_file} (expected {BASELINE_FORMAT_VERSION})"
+        )
+    return baseline["entries"]
+
+
+def make_baseline_entry(command: str, result: CommandResult) -> dict:
+    entry = {
+        "arch": result.arch,
+        "compiler_version": result.compiler_version,
+        "command": command,
+    }
+    for metric in ALL_METRICS:
+        entry[metric] = getattr(result.stats, metric)
+    return entry
+
+
+def save_baseline(baseline_file: Path, results: list[tuple[str, CommandResult]]):
+    # Entries of other commands, archs and compiler versions are kept, so that
+    # a file collects the baselines of several machines and IREE pins.
+    entries = load_baseline(baseline_file)
+    for command, result in results:
+        if not result.succeeded:
+            continue
+        entry = make_baseline_entry(command, result)
+        key = (entry["arch"], entry["compiler_version"], command)
+        entries = [
+            e
+            for e in entries
+            if (e["arch"], e["compiler_version"], e["command"]) != key
+        ]
+        entries.append(entry)
+    baseline = {"format_version": BASELINE_FORMAT_VERSION, "entries": entries}
+    baseline_file.write_text(json.dumps(baseline, indent=2) + "\n")
+
+
+def compare_baseline(
+    baseline_file: Path,
+    results: list[tuple[str, CommandResult]],
+    metric: str,
+    threshold: float,
+    compiler_version: str | None,
+) -> int:
+    # Returns the number of regressions: results slower than the baseline of
+    # their command on the same arch by more than `threshold` percent. The
+    # baseline is the latest entry saved, or that of `compiler_version`.
+    entries = load_baseline(baseline_file)
+    regressions = 0
+    print(f"\n{'='*80}")
+    print(f"BASELINE COMPARISON ({metric}, threshold {threshold:.1f}%)")
+    print(f"{'='*80}")
+    for command, result in results:
+        if not result.succeeded:
+            continue
+        matches = [
+            e
+            for e in entries
+            if e["arch"] == result.arch
+            and e["command"] == command
+            and compiler_version in [None, e["compiler_version"]]
+        ]
+        value = getattr(result.stats, metric)
+        if (
+            not matches
+            or not isinstance(value, float)
+            or not isinstance(matches[-1].get(metric), (int, float))
+        ):
+            print(f"[NO BASELINE] {command} ({result.arch})")
+            continue
+        baseline = matches[-1]
+        change = (value - baseline[metric]) / baseline[metric] * 100.0
+        is_regression = change > threshold
+        regressions += is_regression
+        status = "REGRESSION" if is_regression else "OK"
+        print(
+            f"[{status}] {command} ({result.arch}): {value:.2f}(us) vs "
+            f"{baseline[metric]:.2f}(us), {change:+.1f}%"
+        )
+        print(f"    baseline compiler: {baseline['compiler_version'].splitlines()[0]}")
+        print(f"    current compiler:  {result.compiler_version.splitlines()[0]}")
+    print(f"Regressions: {regressions}")
+    return regressions
+
+
 def get_parser() -> argparse.ArgumentParser:
     parser = argparse.ArgumentParser(
         description="""
@@ -227,6 +388,17 @@ The script will:
   2. Apply timeout to each command (default: 60 seconds)
   3. Extract timing statistics from rocprof CSV outputs
   4. Aggregate results into a single output CSV
+
+With --driver-timing, the driver times executions itself (without rocprofv3),
+e.g. on production nodes.
+
+Results can be saved to a baseline file (--save-baseline), keyed by the GPU
+arch and IREE compiler version reported by the driver, and compared with one
+(--compare-baseline): commands slower than their baseline on the same arch by
+more than --threshold percent are reported as regressions, and fail the run.
+E.g. to gate an upgrade of the IREE pin:
+  run_benchmark.py -f commands.txt --save-baseline baseline.json   # old pin
+  run_benchmark.py -f commands.txt --compare-baseline baseline.json  # new pin
         """,
         formatter_class=argparse.RawDescriptionHelpFormatter,
     )
@@ -275,6 +447,52 @@ The script will:
         help="Arguments for rocprofv3 (default: --runtime-trace)",
     )
 
+    parser.add_argument(
+        "--driver-timing",
+        action="store_true",
+        help="Time executions in the driver (waiting for device fences) instead of "
+        "with rocprofv3, which reports median and p99 latencies and throughput",
+    )
+
+    parser.add_argument(
+        "--save-baseline",
+        type=str,
+        default=None,
+        help="Baseline file to save results to, replacing previous results of the "
+        "same commands, arch and compiler version",
+    )
+
+    parser.add_argument(
+        "--compare-baseline",
+        type=str,
+        default=None,
+        help="Baseline file to compare results with, failing on regressions",
+    )
+
+    parser.add_argument(
+        "--baseline-compiler-version",
+        type=str,
+        default=None,
+        help="Compiler version of the baseline results to compare with "
+        "(default: the latest saved for each command and arch)",
+    )
+
+    parser.add_argument(
+        "--baseline-metric",
+        type=str,
+        choices=BASELINE_METRICS,
+        default="mean",
+        help="Metric compared with baselines (default: mean)",
+    )
+
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=5.0,
+        help="Slowdown over the baseline, in percent, reported as a regression "
+        "(default: 5)",
+    )
+
     parser.add_argument(
         "--verbose",
         "-v",
@@ -338,8 +556,10 @@ def main():
     csv_file = csv.writer(open(args.csv, "w", newline=""))
     csv_headers = ["command"]
     for metric in ALL_METRICS:
-        if metric in ["min", "max", "mean", "stddev"]:
+        if metric in ["min", "max", "mean", "stddev", "median", "p99"]:
             csv_headers.append(f"{metric} (us)")
+        elif metric == "gbps":
+            csv_headers.append("GB/s")
         else:
             csv_headers.append(metric)
     csv_file.writerow(csv_headers)
@@ -349,6 +569,7 @@ def main():
     failed_count = 0
     skipped_count = 0
     timeout_count = 0
+    results: list[tuple[str, CommandResult]] = []
 
     for command in commands:
         cmd_count += 1
@@ -378,8 +599,10 @@ def main():
                 args.verbose,
                 cmd_count,
                 args.timeout,
+                args.driver_timing,
             )
 
+        results.append((command, result))
         stats = result.stats
         csv_row = [command]
         for metric in ALL_METRICS:
@@ -415,7 +638,20 @@ def main():
         print(f"Rocprof outputs: {output_dir.absolute()}")
     print(f"{'='*80}\n")
 
-    return 0 if (failed_count + timeout_count == 0) else 1
+    regression_count = 0
+    if args.compare_baseline is not None:
+        regression_count = compare_baseline(
+            Path(args.compare_baseline),
+            results,
+            args.baseline_metric,
+            args.threshold,
+            args.baseline_compiler_version,
+        )
+    if args.save_baseline is not None:
+        save_baseline(Path(args.save_baseline), results)
+        print(f"Baseline saved: {args.save_baseline}")
+
+    return 0 if (failed_count + timeout_count + regression_count == 0) else 1
 
 
 if __name__ == "__main__":
@@ -21,29 +21,46 @@
 #include "fusilli/support/cache.h"          // IWYU pragma: export
 #include "fusilli/support/external_tools.h" // IWYU pragma: export
 #include "fusilli/support/extras.h"         // IWYU pragma: export
+#include "fusilli/support/json.h"           // IWYU pragma: export
 #include "fusilli/support/logging.h"        // IWYU pragma: export
+#include "fusilli/support/thread_pool.h"    // IWYU pragma: export
+#include "fusilli/support/tracing.h"        // IWYU pragma: export
 
 // Attributes / Types:
-#include "fusilli/attributes/attributes.h"           // IWYU pragma: export
-#include "fusilli/attributes/conv_attributes.h"      // IWYU pragma: export
-#include "fusilli/attributes/matmul_attributes.h"    // IWYU pragma: export
-#include "fusilli/attributes/pointwise_attributes.h" // IWYU pragma: export
-#include "fusilli/attributes/tensor_attributes.h"    // IWYU pragma: export
-#include "fusilli/attributes/types.h"                // IWYU pragma: export
+#include "fusilli/attributes/attributes.h"               // IWYU pragma: export
+#include "fusilli/attributes/conv_attributes.h"          // IWYU pragma: export
+#include "fusilli/attributes/matmul_attributes.h"        // IWYU pragma: export
+#include "fusilli/attributes/normalization_attributes.h" // IWYU pragma: export
+#include "fusilli/attributes/pointwise_attributes.h"     // IWYU pragma: export
+#include "fusilli/attributes/reduction_attributes.h"     // IWYU pragma: export
+#include "fusilli/attributes/sdpa_attributes.h"          // IWYU pragma: export
+#include "fusilli/attributes/tensor_attributes.h"        // IWYU pragma: export
+#include "fusilli/attributes/types.h"                    // IWYU pragma: export
 
 // Nodes:
-#include "fusilli/node/conv_node.h"      // IWYU pragma: export
-#include "fusilli/node/node.h"           // IWYU pragma: export
-#include "fusilli/node/pointwise_node.h" // IWYU pragma: export
+#include "fusilli/node/conv_node.h"          // IWYU pragma: export
+#include "fusilli/node/matmul_node.h"        // IWYU pragma: export
+#include "fusilli/node/node.h"               // IWYU pragma: export
+#include "fusilli/node/normalization_node.h" // IWYU pragma: export
+#include "fusilli/node/pointwise_node.h"     // IWYU pragma: export
+#include "fusilli/node/reduction_node.h"     // IWYU pragma: export
+#include "fusilli/node/sdpa_node.h"          // IWYU pragma: export
 
 // Backend:
-#include "fusilli/backend/backend.h" // IWYU pragma: export
-#include "fusilli/backend/buffer.h"  // IWYU pragma: export
-#include "fusilli/backend/handle.h"  // IWYU pragma: export
-#include "fusilli/backend/runtime.h" // IWYU pragma: export
+#include "fusilli/backend/backend.h"  // IWYU pragma: export
+#include "fusilli/backend/buffer.h"   // IWYU pragma: export
+#include "fusilli/backend/compiler.h" // IWYU pragma: export
+#include "fusilli/backend/handle.h"   // IWYU pragma: export
+#include "fusilli/backend/runtime.h"  // IWYU pragma: export
+#include "fusilli/backend/tuning.h"   // IWYU pragma: export
 
 // Graph:
-#include "fusilli/graph/context.h" // IWYU pragma: export
-#include "fusilli/graph/graph.h"   // IWYU pragma: export
+#include "fusilli/graph/autotune.h"       // IWYU pragma: export
+#include "fusilli/graph/bundle.h"         // IWYU pragma: export
+#include "fusilli/graph/context.h"        // IWYU pragma: export
+#include "fusilli/graph/execution_plan.h" // IWYU pragma: export
+#include "fusilli/graph/graph.h"          // IWYU pragma: export
+#include "fusilli/graph/passes.h"         // IWYU pragma: export
+#include "fusilli/graph/serialization.h"  // IWYU pragma: export
 
 #endif // FUSILLI_H
@@ -21,9 +21,14 @@
 #include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/attributes/types.h"
 #include "fusilli/graph/context.h"
+#include "fusilli/support/extras.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fusilli {
 
@@ -94,9 +99,85 @@ public:
     }
   }
 
+  // Hashes the name, compute data type, and input and output tensors of the
+  // attributes into `hash` (see `Graph::getFingerprint`). Derived classes
+  // with other attributes hash them in their own `fingerprint`.
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = fnv1aHash(name_ + '\0', hash);
+    hash = fnv1aHashValue(computeDataType, hash);
+    hash = fingerprintTensors(self().inputs, hash);
+    return fingerprintTensors(self().outputs, hash);
+  }
+
+  // Input and output tensors that are set, in the order of their keys (see
+  // `Graph::optimize`).
+  std::vector<std::shared_ptr<TensorAttr>> getInputTensors() const {
+    return getSortedTensors(self().inputs);
+  }
+
+  std::vector<std::shared_ptr<TensorAttr>> getOutputTensors() const {
+    return getSortedTensors(self().outputs);
+  }
+
+  // Replaces the input tensor `from` by `to` wherever it is set.
+  void replaceInputTensor(const std::shared_ptr<TensorAttr> &from,
+                          const std::shared_ptr<TensorAttr> &to) {
+    for (auto &[key, tensor] : self().inputs)
+      if (tensor == from)
+        tensor = to;
+  }
+
+  // Replaces the input and output tensors that are keys of `replacements` by
+  // their values (see `Graph::cloneWithDims`).
+  template <typename MapT> void replaceTensors(const MapT &replacements) {
+    auto replace = [&](auto &tensors) {
+      for (auto &[key, tensor] : tensors) {
+        auto it = replacements.find(tensor);
+        if (it != replacements.end())
+          tensor = it->second;
+      }
+    };
+    replace(self().inputs);
+    replace(self().outputs);
+  }
+
 private:
   DerivedT &self() { return static_cast<DerivedT &>(*this); }
   const DerivedT &self() const { return static_cast<const DerivedT &>(*this); }
+
+  template <typename MapT>
+  static std::vector<std::shared_ptr<TensorAttr>>
+  getSortedTensors(const MapT &tensors) {
+    std::vector<std::pair<typename MapT::key_type, std::shared_ptr<TensorAttr>>>
+        sorted(tensors.begin(), tensors.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    std::vector<std::shared_ptr<TensorAttr>> result;
+    for (const auto &[key, tensor] : sorted)
+      if (tensor)
+        result.push_back(tensor);
+    return result;
+  }
+
+  // Hashes tensors in the order of their keys, as the iteration order of
+  // unordered maps depends on their insertion history.
+  template <typename MapT>
+  static uint64_t fingerprintTensors(const MapT &tensors, uint64_t hash) {
+    std::vector<std::pair<typename MapT::key_type, const TensorAttr *>> sorted;
+    for (const auto &[key, tensor] : tensors)
+      sorted.emplace_back(key, tensor.get());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    hash = fnv1aHashValue(sorted.size(), hash);
+    for (const auto &[key, tensor] : sorted) {
+      hash = fnv1aHashValue(key, hash);
+      hash = fnv1aHashValue(tensor != nullptr, hash);
+      if (tensor)
+        hash = tensor->fingerprint(hash);
+    }
+    return hash;
+  }
+
   std::string name_;
 };
 
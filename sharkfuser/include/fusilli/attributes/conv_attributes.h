@@ -16,6 +16,7 @@
 
 #include "fusilli/attributes/attributes.h"
 #include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/support/extras.h"
 
 #include <cstdint>
 #include <memory>
@@ -24,10 +25,13 @@
 
 namespace fusilli {
 
+// The optional X_SCALE and W_SCALE are single-element per-tensor scales of
+// X and W (e.g. of fp8 data types), the convolution of which is multiplied
+// by them in f32 before being converted to the data type of Y.
 class ConvFPropAttr : public AttributesCRTP<ConvFPropAttr> {
 public:
   // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
-  enum class InputNames : uint8_t { X, W };
+  enum class InputNames : uint8_t { X, W, X_SCALE, W_SCALE };
   enum class OutputNames : uint8_t { Y };
 
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
@@ -36,6 +40,8 @@ public:
   // Setters:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvFPropAttr, InputNames, X)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvFPropAttr, InputNames, W)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvFPropAttr, InputNames, X_SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvFPropAttr, InputNames, W_SCALE)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ConvFPropAttr, OutputNames, Y)
 
   ConvFPropAttr &setPadding(const std::vector<int64_t> &padding) {
@@ -65,19 +71,41 @@ public:
     return *this;
   }
 
+  // Emits the convolution of channels-last X, W and Y (NHWC, KRSC and NHWC)
+  // directly as `linalg.conv_2d_nhwc_fhwc`, rather than permuting them to
+  // and from the NCHW layout of `torch.aten.convolution` and relying on the
+  // compiler to fold the permutes. Only applies to ungrouped 2D convolutions
+  // of statically shaped floating point tensors, others are emitted as usual.
+  ConvFPropAttr &setDirectChannelsLast(bool directChannelsLast) {
+    directChannelsLast_ = directChannelsLast;
+    return *this;
+  }
+
   // Getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, W)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X_SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, W_SCALE)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
 
   const std::vector<int64_t> &getPadding() const { return padding_; }
   const std::vector<int64_t> &getStride() const { return stride_; }
   const std::vector<int64_t> &getDilation() const { return dilation_; }
+  bool getDirectChannelsLast() const { return directChannelsLast_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(padding_, hash);
+    hash = fnv1aHashValue(stride_, hash);
+    hash = fnv1aHashValue(dilation_, hash);
+    return fnv1aHashValue(directChannelsLast_, hash);
+  }
 
 private:
   std::vector<int64_t> padding_;
   std::vector<int64_t> stride_;
   std::vector<int64_t> dilation_;
+  bool directChannelsLast_ = false;
 };
 
 class ConvWGradAttr : public AttributesCRTP<ConvWGradAttr> {
@@ -120,6 +148,17 @@ public:
     return *this;
   }
 
+  // Splits the reduction over the batch of DY and X into
+  // `splitReductionFactor` parts (which must divide the batch size), whose
+  // weight gradients are computed in parallel and then summed. This helps
+  // weight gradients with few channels and large batch and spatial dims,
+  // whose reduction is otherwise poorly parallelized. Defaults to 1 (no
+  // split).
+  ConvWGradAttr &setSplitReductionFactor(int64_t splitReductionFactor) {
+    splitReductionFactor_ = splitReductionFactor;
+    return *this;
+  }
+
   // Getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, DY)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
@@ -128,11 +167,21 @@ public:
   const std::vector<int64_t> &getPadding() const { return padding_; }
   const std::vector<int64_t> &getStride() const { return stride_; }
   const std::vector<int64_t> &getDilation() const { return dilation_; }
+  int64_t getSplitReductionFactor() const { return splitReductionFactor_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(padding_, hash);
+    hash = fnv1aHashValue(stride_, hash);
+    hash = fnv1aHashValue(dilation_, hash);
+    return fnv1aHashValue(splitReductionFactor_, hash);
+  }
 
 private:
   std::vector<int64_t> padding_;
   std::vector<int64_t> stride_;
   std::vector<int64_t> dilation_;
+  int64_t splitReductionFactor_ = 1;
 };
 
 class ConvDGradAttr : public AttributesCRTP<ConvDGradAttr> {
@@ -184,6 +233,13 @@ public:
   const std::vector<int64_t> &getStride() const { return stride_; }
   const std::vector<int64_t> &getDilation() const { return dilation_; }
 
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(padding_, hash);
+    hash = fnv1aHashValue(stride_, hash);
+    return fnv1aHashValue(dilation_, hash);
+  }
+
 private:
   std::vector<int64_t> padding_;
   std::vector<int64_t> stride_;
@@ -23,10 +23,13 @@
 
 namespace fusilli {
 
+// The optional A_SCALE and B_SCALE are single-element per-tensor scales of
+// A and B (e.g. of fp8 data types), the product of which is multiplied by
+// them in f32 before being converted to the data type of C.
 class MatmulAttr : public AttributesCRTP<MatmulAttr> {
 public:
   // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
-  enum class InputNames : uint8_t { A, B };
+  enum class InputNames : uint8_t { A, B, A_SCALE, B_SCALE };
   enum class OutputNames : uint8_t { C };
 
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
@@ -35,11 +38,15 @@ public:
   // Setters:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, A)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, B)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, A_SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, B_SCALE)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(MatmulAttr, OutputNames, C)
 
   // Getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, A)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, B)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, A_SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, B_SCALE)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, C)
 };
 
@@ -0,0 +1,206 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains attributes (compile-time constant metadata) for
+// normalization (batchnorm, layernorm and RMSNorm) nodes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_ATTRIBUTES_NORMALIZATION_ATTRIBUTES_H
+#define FUSILLI_ATTRIBUTES_NORMALIZATION_ATTRIBUTES_H
+
+#include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/support/extras.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace fusilli {
+
+// Forward phase of a normalization node: INFERENCE only computes the
+// normalized output Y, TRAINING also outputs the statistics it was normalized
+// with (for the backward pass).
+enum class NormFwdPhase : uint8_t {
+  NOT_SET,
+  INFERENCE,
+  TRAINING,
+};
+
+inline const std::unordered_map<NormFwdPhase, std::string> kNormFwdPhaseToStr =
+    {
+        {NormFwdPhase::NOT_SET, "NOT_SET"},
+        {NormFwdPhase::INFERENCE, "INFERENCE"},
+        {NormFwdPhase::TRAINING, "TRAINING"},
+};
+
+// Batchnorm over the (N, C, ...) input X, normalizing each channel C with the
+// running MEAN and VAR inputs in INFERENCE, or with the statistics of the
+// batch in TRAINING, which are output as SAVED_MEAN and SAVED_INV_VARIANCE.
+// SCALE, BIAS, MEAN, VAR and the saved statistics have dims (1, C, 1, ...).
+class BatchnormAttr : public AttributesCRTP<BatchnormAttr> {
+public:
+  // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
+  enum class InputNames : uint8_t { X, SCALE, BIAS, MEAN, VAR };
+  enum class OutputNames : uint8_t { Y, SAVED_MEAN, SAVED_INV_VARIANCE };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormAttr, InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormAttr, InputNames, BIAS)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormAttr, InputNames, MEAN)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormAttr, InputNames, VAR)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(BatchnormAttr, OutputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(BatchnormAttr, OutputNames, SAVED_MEAN)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(BatchnormAttr, OutputNames,
+                                       SAVED_INV_VARIANCE)
+
+  BatchnormAttr &setForwardPhase(NormFwdPhase forwardPhase) {
+    forwardPhase_ = forwardPhase;
+    return *this;
+  }
+
+  BatchnormAttr &setEpsilon(float epsilon) {
+    epsilon_ = epsilon;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, BIAS)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, MEAN)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, VAR)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, SAVED_MEAN)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, SAVED_INV_VARIANCE)
+
+  NormFwdPhase getForwardPhase() const { return forwardPhase_; }
+  float getEpsilon() const { return epsilon_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(forwardPhase_, hash);
+    return fnv1aHashValue(epsilon_, hash);
+  }
+
+private:
+  NormFwdPhase forwardPhase_ = NormFwdPhase::NOT_SET;
+  float epsilon_ = 1e-5f;
+};
+
+// Layernorm over the (N, ...) input X, normalizing each sample N over all its
+// other dims. SCALE and BIAS have dims (1, ...) of those normalized dims, and
+// the MEAN and INV_VARIANCE statistics output in TRAINING have dims
+// (N, 1, ...).
+class LayernormAttr : public AttributesCRTP<LayernormAttr> {
+public:
+  // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
+  enum class InputNames : uint8_t { X, SCALE, BIAS };
+  enum class OutputNames : uint8_t { Y, MEAN, INV_VARIANCE };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormAttr, InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormAttr, InputNames, BIAS)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormAttr, OutputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormAttr, OutputNames, MEAN)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormAttr, OutputNames,
+                                       INV_VARIANCE)
+
+  LayernormAttr &setForwardPhase(NormFwdPhase forwardPhase) {
+    forwardPhase_ = forwardPhase;
+    return *this;
+  }
+
+  LayernormAttr &setEpsilon(float epsilon) {
+    epsilon_ = epsilon;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, BIAS)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, MEAN)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, INV_VARIANCE)
+
+  NormFwdPhase getForwardPhase() const { return forwardPhase_; }
+  float getEpsilon() const { return epsilon_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(forwardPhase_, hash);
+    return fnv1aHashValue(epsilon_, hash);
+  }
+
+private:
+  NormFwdPhase forwardPhase_ = NormFwdPhase::NOT_SET;
+  float epsilon_ = 1e-5f;
+};
+
+// RMSNorm over the (N, ...) input X, dividing each sample N by the root mean
+// square of all its other dims. SCALE has dims (1, ...) of those normalized
+// dims, and the INV_RMS statistic output in TRAINING has dims (N, 1, ...).
+class RmsnormAttr : public AttributesCRTP<RmsnormAttr> {
+public:
+  // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
+  enum class InputNames : uint8_t { X, SCALE };
+  enum class OutputNames : uint8_t { Y, INV_RMS };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormAttr, InputNames, SCALE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(RmsnormAttr, OutputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(RmsnormAttr, OutputNames, INV_RMS)
+
+  RmsnormAttr &setForwardPhase(NormFwdPhase forwardPhase) {
+    forwardPhase_ = forwardPhase;
+    return *this;
+  }
+
+  RmsnormAttr &setEpsilon(float epsilon) {
+    epsilon_ = epsilon;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, INV_RMS)
+
+  NormFwdPhase getForwardPhase() const { return forwardPhase_; }
+  float getEpsilon() const { return epsilon_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(forwardPhase_, hash);
+    return fnv1aHashValue(epsilon_, hash);
+  }
+
+private:
+  NormFwdPhase forwardPhase_ = NormFwdPhase::NOT_SET;
+  float epsilon_ = 1e-5f;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_ATTRIBUTES_NORMALIZATION_ATTRIBUTES_H
@@ -16,9 +16,11 @@
 
 #include "fusilli/attributes/attributes.h"
 #include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/support/extras.h"
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -31,13 +33,29 @@ public:
   enum class InputNames : uint8_t { IN_0, IN_1, IN_2 };
   enum class OutputNames : uint8_t { OUT_0 };
 
+  // Backward modes take the gradient of the output (dy) as IN_0, and the
+  // input of the forward mode (x) as IN_1, or its output (y) for SIGMOID_BWD
+  // and TANH_BWD. CLAMP clamps IN_0 to the min and max set by `setClampMin`
+  // and `setClampMax`, and SCALE_SHIFT computes IN_0 * IN_1 + IN_2.
   enum class Mode : uint8_t {
     NOT_SET,
     ADD,
+    CLAMP,
     DIV,
+    GELU_APPROX_TANH_BWD,
+    GELU_APPROX_TANH_FWD,
+    GELU_BWD,
+    GELU_FWD,
     MUL,
+    RELU_BWD,
     RELU_FWD,
+    SCALE_SHIFT,
+    SIGMOID_BWD,
+    SIGMOID_FWD,
     SUB,
+    SWISH_FWD,
+    TANH_BWD,
+    TANH_FWD,
   };
 
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
@@ -54,6 +72,16 @@ public:
     return *this;
   }
 
+  PointwiseAttr &setClampMin(float clampMin) {
+    clampMin_ = clampMin;
+    return *this;
+  }
+
+  PointwiseAttr &setClampMax(float clampMax) {
+    clampMax_ = clampMax;
+    return *this;
+  }
+
   // Getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, IN_0)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, IN_1)
@@ -62,6 +90,19 @@ public:
 
   Mode getMode() const { return mode_; }
 
+  const std::optional<float> &getClampMin() const { return clampMin_; }
+
+  const std::optional<float> &getClampMax() const { return clampMax_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(mode_, hash);
+    hash = fnv1aHashValue(clampMin_.has_value(), hash);
+    hash = fnv1aHashValue(clampMin_.value_or(0.0f), hash);
+    hash = fnv1aHashValue(clampMax_.has_value(), hash);
+    return fnv1aHashValue(clampMax_.value_or(0.0f), hash);
+  }
+
   // Utilities for pointwise modes.
   static const std::unordered_map<Mode, std::string> kModeToStr;
   static const std::unordered_map<PointwiseAttr::Mode, int>
@@ -69,6 +110,8 @@ public:
 
 private:
   Mode mode_ = Mode::NOT_SET;
+  std::optional<float> clampMin_;
+  std::optional<float> clampMax_;
 };
 
 inline const std::unordered_map<PointwiseAttr::Mode, std::string>
@@ -79,6 +122,18 @@ inline const std::unordered_map<PointwiseAttr::Mode, std::string>
         {PointwiseAttr::Mode::DIV, "DIV"},
         {PointwiseAttr::Mode::MUL, "MUL"},
         {PointwiseAttr::Mode::SUB, "SUB"},
+        {PointwiseAttr::Mode::CLAMP, "CLAMP"},
+        {PointwiseAttr::Mode::GELU_APPROX_TANH_BWD, "GELU_APPROX_TANH_BWD"},
+        {PointwiseAttr::Mode::GELU_APPROX_TANH_FWD, "GELU_APPROX_TANH_FWD"},
+        {PointwiseAttr::Mode::GELU_BWD, "GELU_BWD"},
+        {PointwiseAttr::Mode::GELU_FWD, "GELU_FWD"},
+        {PointwiseAttr::Mode::RELU_BWD, "RELU_BWD"},
+        {PointwiseAttr::Mode::SCALE_SHIFT, "SCALE_SHIFT"},
+        {PointwiseAttr::Mode::SIGMOID_BWD, "SIGMOID_BWD"},
+        {PointwiseAttr::Mode::SIGMOID_FWD, "SIGMOID_FWD"},
+        {PointwiseAttr::Mode::SWISH_FWD, "SWISH_FWD"},
+        {PointwiseAttr::Mode::TANH_BWD, "TANH_BWD"},
+        {PointwiseAttr::Mode::TANH_FWD, "TANH_FWD"},
 };
 inline const std::unordered_map<PointwiseAttr::Mode, int>
     PointwiseAttr::kModeToRequiredInputCount = {
@@ -86,7 +141,19 @@ inline const std::unordered_map<PointwiseAttr::Mode, int>
         {PointwiseAttr::Mode::ADD, 2},
         {PointwiseAttr::Mode::DIV, 2},
         {PointwiseAttr::Mode::MUL, 2},
-        {PointwiseAttr::Mode::SUB, 2}};
+        {PointwiseAttr::Mode::SUB, 2},
+        {PointwiseAttr::Mode::CLAMP, 1},
+        {PointwiseAttr::Mode::GELU_APPROX_TANH_BWD, 2},
+        {PointwiseAttr::Mode::GELU_APPROX_TANH_FWD, 1},
+        {PointwiseAttr::Mode::GELU_BWD, 2},
+        {PointwiseAttr::Mode::GELU_FWD, 1},
+        {PointwiseAttr::Mode::RELU_BWD, 2},
+        {PointwiseAttr::Mode::SCALE_SHIFT, 3},
+        {PointwiseAttr::Mode::SIGMOID_BWD, 2},
+        {PointwiseAttr::Mode::SIGMOID_FWD, 1},
+        {PointwiseAttr::Mode::SWISH_FWD, 1},
+        {PointwiseAttr::Mode::TANH_BWD, 2},
+        {PointwiseAttr::Mode::TANH_FWD, 1}};
 
 } // namespace fusilli
 
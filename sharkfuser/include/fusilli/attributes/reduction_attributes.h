@@ -0,0 +1,133 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains attributes (compile-time constant metadata) for
+// reduction and softmax nodes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_ATTRIBUTES_REDUCTION_ATTRIBUTES_H
+#define FUSILLI_ATTRIBUTES_REDUCTION_ATTRIBUTES_H
+
+#include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/support/extras.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fusilli {
+
+// Reduction of the input X over the (logical) dims set by `setAxes`, which
+// are kept as dims of size 1 in the output Y.
+class ReductionAttr : public AttributesCRTP<ReductionAttr> {
+public:
+  // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
+  enum class InputNames : uint8_t { X };
+  enum class OutputNames : uint8_t { Y };
+
+  enum class Mode : uint8_t {
+    NOT_SET,
+    MAX,
+    MEAN,
+    SUM,
+  };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ReductionAttr, InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ReductionAttr, OutputNames, Y)
+
+  ReductionAttr &setMode(Mode mode) {
+    mode_ = mode;
+    return *this;
+  }
+
+  ReductionAttr &setAxes(const std::vector<int64_t> &axes) {
+    axes_ = axes;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  Mode getMode() const { return mode_; }
+
+  const std::vector<int64_t> &getAxes() const { return axes_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(mode_, hash);
+    hash = fnv1aHashValue(axes_.size(), hash);
+    for (int64_t axis : axes_)
+      hash = fnv1aHashValue(axis, hash);
+    return hash;
+  }
+
+  // Utilities for reduction modes.
+  static const std::unordered_map<Mode, std::string> kModeToStr;
+
+private:
+  Mode mode_ = Mode::NOT_SET;
+  std::vector<int64_t> axes_;
+};
+
+inline const std::unordered_map<ReductionAttr::Mode, std::string>
+    ReductionAttr::kModeToStr = {
+        {ReductionAttr::Mode::NOT_SET, "NOT_SET"},
+        {ReductionAttr::Mode::MAX, "MAX"},
+        {ReductionAttr::Mode::MEAN, "MEAN"},
+        {ReductionAttr::Mode::SUM, "SUM"},
+};
+
+// Softmax of the input X along the (logical) dim set by `setAxis`, with the
+// output Y of the dims of X.
+class SoftmaxAttr : public AttributesCRTP<SoftmaxAttr> {
+public:
+  // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
+  enum class InputNames : uint8_t { X };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SoftmaxAttr, InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SoftmaxAttr, OutputNames, Y)
+
+  SoftmaxAttr &setAxis(int64_t axis) {
+    axis_ = axis;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  const std::optional<int64_t> &getAxis() const { return axis_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(axis_.has_value(), hash);
+    return fnv1aHashValue(axis_.value_or(0), hash);
+  }
+
+private:
+  std::optional<int64_t> axis_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_ATTRIBUTES_REDUCTION_ATTRIBUTES_H
@@ -0,0 +1,87 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains attributes (compile-time constant metadata) for
+// scaled dot-product attention (SDPA) nodes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_ATTRIBUTES_SDPA_ATTRIBUTES_H
+#define FUSILLI_ATTRIBUTES_SDPA_ATTRIBUTES_H
+
+#include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/support/extras.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace fusilli {
+
+// Scaled dot-product attention
+//    O = softmax(Q * K^T * scale + MASK) * V
+// of the queries Q (B, H, S_q, D), keys K (B, H, S_kv, D) and values
+// V (B, H, S_kv, D_v), with the output O (B, H, S_q, D_v). The optional MASK
+// is either boolean (where false masks a score out) or added to the scores,
+// and broadcasts to (B, H, S_q, S_kv). The scale defaults to 1 / sqrt(D).
+class SdpaAttr : public AttributesCRTP<SdpaAttr> {
+public:
+  // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
+  enum class InputNames : uint8_t { Q, K, V, MASK };
+  enum class OutputNames : uint8_t { O };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, Q)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, K)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, V)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, MASK)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SdpaAttr, OutputNames, O)
+
+  // Masks out the scores of keys after each query (the upper triangle of
+  // the S_q x S_kv scores), as in autoregressive decoders.
+  SdpaAttr &setCausal(bool isCausal) {
+    isCausal_ = isCausal;
+    return *this;
+  }
+
+  SdpaAttr &setScale(float scale) {
+    scale_ = scale;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, Q)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, K)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, V)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, MASK)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, O)
+
+  bool getCausal() const { return isCausal_; }
+
+  const std::optional<float> &getScale() const { return scale_; }
+
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = AttributesCRTP::fingerprint(hash);
+    hash = fnv1aHashValue(isCausal_, hash);
+    hash = fnv1aHashValue(scale_.has_value(), hash);
+    return fnv1aHashValue(scale_.value_or(0.0f), hash);
+  }
+
+private:
+  bool isCausal_ = false;
+  std::optional<float> scale_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_ATTRIBUTES_SDPA_ATTRIBUTES_H
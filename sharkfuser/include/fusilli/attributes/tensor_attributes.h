@@ -35,6 +35,14 @@
 // Essentially, strides enable arbitrary transpositions and permutations of
 // tensor dimensions while preserving the same logical layout.
 //
+// A note on dynamic dimensions:
+//
+// Dimensions marked dynamic (e.g. the batch size N) are emitted as `?` in the
+// MLIR assembly, so that the compiled graph serves any size of these
+// dimensions, bound at execution from the shapes of the buffers. Their set
+// sizes are only representative ones, used to validate the graph, infer
+// shapes and strides, and compute the physical layout.
+//
 // PyTorch enforces tensors to always conform to the logical channels-first
 // (NCHW) layout, and uses strides as a way to specify the exact physical
 // (in-memory) layout - contiguous (NCHW) or channels-last (NHWC). Not all
@@ -101,6 +109,7 @@
 
 #include "fusilli/attributes/types.h"
 #include "fusilli/graph/context.h"
+#include "fusilli/support/extras.h"
 #include "fusilli/support/logging.h"
 
 #include <algorithm>
@@ -363,6 +372,30 @@ public:
         "Tensor '" + name_ +
             "' is marked as a scalar but does not have a scalar value set");
 
+    FUSILLI_RETURN_ERROR_IF(
+        isScalar_ && isDynamic(), ErrorCode::InvalidAttribute,
+        "Tensor '" + name_ + "' cannot be both a scalar and dynamic");
+
+    if (isConstant()) {
+      FUSILLI_RETURN_ERROR_IF(
+          isVirtual_ || isScalar_ || isDynamic(), ErrorCode::InvalidAttribute,
+          "Tensor '" + name_ +
+              "' cannot be a constant and virtual, a scalar or dynamic");
+      size_t expectedBytes =
+          static_cast<size_t>(getVolume()) * getDataTypeByteSize(dataType_);
+      FUSILLI_RETURN_ERROR_IF(
+          constantData_->size() != expectedBytes, ErrorCode::InvalidAttribute,
+          "Tensor '" + name_ + "' has " +
+              std::to_string(constantData_->size()) +
+              " bytes of constant data, expected " +
+              std::to_string(expectedBytes));
+    }
+
+    FUSILLI_RETURN_ERROR_IF(
+        isDynamic() && dynamicDims_.back() >= dim_.size(),
+        ErrorCode::InvalidAttribute,
+        "Tensor '" + name_ + "' has a dynamic dim out of its rank");
+
     return ok();
   }
 
@@ -416,6 +449,7 @@ public:
   // Setters:
   TensorAttr &setName(const std::string &name) {
     name_ = name;
+    valueNameAsm_.clear();
     return *this;
   }
 
@@ -442,6 +476,15 @@ public:
     return *this;
   }
 
+  // Marks the (logical) dims at indices `dynamicDims` dynamic.
+  TensorAttr &setDynamicDims(const std::vector<size_t> &dynamicDims) {
+    dynamicDims_ = dynamicDims;
+    std::sort(dynamicDims_.begin(), dynamicDims_.end());
+    dynamicDims_.erase(std::unique(dynamicDims_.begin(), dynamicDims_.end()),
+                       dynamicDims_.end());
+    return *this;
+  }
+
   TensorAttr &setIsVirtual(bool isVirtual) {
     isVirtual_ = isVirtual;
     return *this;
@@ -454,6 +497,25 @@ public:
     return *this;
   }
 
+  // Marks the tensor a constant (e.g. the filter of a convolution for
+  // inference) with the contents of its buffer: its elements in physical
+  // order (see `getPhysicalDim`). Constants are embedded in the compiled
+  // module rather than bound at execution, so that the compiler evaluates
+  // what depends on them alone (e.g. their layout conversion) once, at
+  // compile time. The data is shared by copies of the tensor, and hashed
+  // into the fingerprint of graphs.
+  TensorAttr &
+  setConstantData(std::shared_ptr<const std::vector<uint8_t>> constantData) {
+    constantData_ = std::move(constantData);
+    return *this;
+  }
+  template <typename T>
+  TensorAttr &setConstantData(const std::vector<T> &constantData) {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(constantData.data());
+    return setConstantData(std::make_shared<const std::vector<uint8_t>>(
+        bytes, bytes + constantData.size() * sizeof(T)));
+  }
+
   // Getters:
   const std::string &getName() const { return name_; }
 
@@ -463,6 +525,22 @@ public:
 
   const std::vector<int64_t> &getStride() const { return stride_; }
 
+  // Sorted indices of the dynamic (logical) dims.
+  const std::vector<size_t> &getDynamicDims() const { return dynamicDims_; }
+
+  bool isDynamic() const { return !dynamicDims_.empty(); }
+
+  bool isDynamicDim(size_t idx) const {
+    return std::binary_search(dynamicDims_.begin(), dynamicDims_.end(), idx);
+  }
+
+  // Whether the dim at `idx` in physical order (see `getPhysicalDim`) is
+  // dynamic.
+  bool isPhysicalDimDynamic(size_t idx) const {
+    return isDynamicDim(
+        static_cast<size_t>(getLogicalToPhysicalPermuteOrder()[idx]));
+  }
+
   int64_t getVolume() const {
     int64_t volume = 1;
     for (const auto &d : dim_)
@@ -474,6 +552,13 @@ public:
 
   bool isScalar() const { return isScalar_; }
 
+  bool isConstant() const { return constantData_ != nullptr; }
+
+  // Contents of a constant tensor (see `setConstantData`), or null.
+  const std::shared_ptr<const std::vector<uint8_t>> &getConstantData() const {
+    return constantData_;
+  }
+
   bool isContiguous() const {
     std::vector<int64_t> expectedStride =
         generateStrideFromDim(dim_, getContiguousStrideOrder(dim_.size()));
@@ -634,12 +719,44 @@ public:
 
   std::optional<scalar_t> getScalarValue() const { return scalarValue_; }
 
+  // Hashes the properties of the tensor into `hash` (see
+  // `Graph::getFingerprint`).
+  uint64_t fingerprint(uint64_t hash) const {
+    hash = fnv1aHash(name_ + '\0', hash);
+    hash = fnv1aHashValue(dataType_, hash);
+    hash = fnv1aHashValue(dim_, hash);
+    hash = fnv1aHashValue(stride_, hash);
+    hash = fnv1aHashValue(dynamicDims_, hash);
+    hash = fnv1aHashValue(isVirtual_, hash);
+    hash = fnv1aHashValue(isScalar_, hash);
+    hash = fnv1aHashValue(scalarValue_.has_value(), hash);
+    if (scalarValue_.has_value()) {
+      hash = fnv1aHashValue(scalarValue_->index(), hash);
+      hash = std::visit(
+          [hash](const auto &value) { return fnv1aHashValue(value, hash); },
+          *scalarValue_);
+    }
+    hash = fnv1aHashValue(isConstant(), hash);
+    if (isConstant())
+      hash = fnv1aHashValue(*constantData_, hash);
+    return hash;
+  }
+
 private:
   std::string name_;
+
+  // SSA value name of `name_` (see `getValueNameAsm`), interned on first use
+  // since it is emitted for every use of the tensor.
+  mutable std::string valueNameAsm_;
+
   DataType dataType_ = DataType::NotSet;
   std::vector<int64_t> dim_ = {};
   std::vector<int64_t> stride_ = {};
 
+  // Dims whose size is bound at execution (see the note on dynamic
+  // dimensions at the top of this file).
+  std::vector<size_t> dynamicDims_ = {};
+
   // Intermediate tensors that are not inputs/outputs are virtual
   // and not stored/read as they appear internal to the kernel.
   // They also don't need their shapes and sizes specified.
@@ -649,6 +766,9 @@ private:
   // constant folding, or passed in as scalars during execution.
   bool isScalar_ = false;
   std::optional<scalar_t> scalarValue_ = std::nullopt;
+
+  // Contents of constant tensors, embedded in the compiled module.
+  std::shared_ptr<const std::vector<uint8_t>> constantData_ = nullptr;
 };
 
 // Sorting function for deterministic lookups on TensorAttr containers
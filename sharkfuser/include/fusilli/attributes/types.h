@@ -14,6 +14,7 @@
 #define FUSILLI_ATTRIBUTES_TYPES_H
 
 #include "fusilli/external/torch_types.h"
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
@@ -42,7 +43,10 @@ using bf16 = __bf16;
   _(Int32, Int, "si32")                                                        \
   _(Int64, Long, "si64")                                                       \
   _(Boolean, Bool, "i1")                                                       \
-  _(FP8E5M2, Float8_e5m2, "f8E5M2")
+  _(FP8E5M2, Float8_e5m2, "f8E5M2")                                            \
+  _(FP8E4M3FN, Float8_e4m3fn, "f8E4M3FN")                                      \
+  _(FP8E5M2FNUZ, Float8_e5m2fnuz, "f8E5M2FNUZ")                                \
+  _(FP8E4M3FNUZ, Float8_e4m3fnuz, "f8E4M3FNUZ")
 
 enum class DataType : uint8_t {
   NotSet,
@@ -60,6 +64,16 @@ static const std::unordered_map<DataType, std::string> kDataTypeToMlirTypeAsm =
 #undef DEFINE_ENUM
 };
 
+// Map from Fusilli types to their names (e.g. in serialized graphs, see
+// `Graph::serialize`).
+static const std::unordered_map<DataType, std::string> kDataTypeToStr = {
+    {DataType::NotSet, "NotSet"},
+#define DEFINE_ENUM(FUSILLI_TYPE, TORCH_TYPE, MLIR_TYPE)                       \
+  {DataType::FUSILLI_TYPE, #FUSILLI_TYPE},
+    FUSILLI_FORALL_DATA_TYPES(DEFINE_ENUM)
+#undef DEFINE_ENUM
+};
+
 // Map from Fusilli types to Torch types.
 static const std::unordered_map<DataType, torch_upstream::ScalarType>
     kDataTypeToTorchType = {
@@ -69,6 +83,35 @@ static const std::unordered_map<DataType, torch_upstream::ScalarType>
 #undef DEFINE_ENUM
 };
 
+// Whether `type` is an 8-bit floating point type. The FNUZ variants (no
+// negative zero, a single NaN) are the ones natively supported by MI300
+// (gfx942), the others by the OCP fp8 standard.
+inline bool isFP8DataType(DataType type) {
+  return type == DataType::FP8E5M2 || type == DataType::FP8E4M3FN ||
+         type == DataType::FP8E5M2FNUZ || type == DataType::FP8E4M3FNUZ;
+}
+
+// Returns the size in bytes of an element of `type` in a buffer (booleans
+// taking a byte), or 0 if not set.
+inline size_t getDataTypeByteSize(DataType type) {
+  switch (type) {
+  case DataType::Double:
+  case DataType::Int64:
+    return 8;
+  case DataType::Float:
+  case DataType::Int32:
+    return 4;
+  case DataType::Half:
+  case DataType::BFloat16:
+  case DataType::Int16:
+    return 2;
+  case DataType::NotSet:
+    return 0;
+  default:
+    return 1;
+  }
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_ATTRIBUTES_TYPES_H
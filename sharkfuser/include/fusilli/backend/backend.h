@@ -70,15 +70,12 @@ static const std::unordered_map<Backend, std::vector<std::string>>
             },
         },
         {
-            // Specify a HIP target for AMD GPU by extracting the architecture
-            // name for the first device using `rocm_agent_enumerator`.
-            // See this page for a full list of supported architectures:
-            // https://iree.dev/guides/deployment-configurations/gpu-rocm/#choosing-hip-targets
+            // The HIP target is set from the device of the handle (see
+            // `kBackendTargetFlag`).
             Backend::AMDGPU,
             {
                 // clang-format off
                 "--iree-hal-target-backends=rocm",
-                "--iree-hip-target=$(rocm_agent_enumerator | sed -n '1 p')",
                 "--iree-opt-level=O3",
                 "--iree-preprocessing-pass-pipeline=\"builtin.module(util.func(iree-preprocessing-sink-transpose-through-pad))\"",
                 "--iree-dispatch-creation-enable-fuse-padding-into-linalg-consumer-ops",
@@ -87,6 +84,15 @@ static const std::unordered_map<Backend, std::vector<std::string>>
         },
 };
 
+// Map from backend to the compile flag setting the target architecture of the
+// device of a handle (see `Handle::getTarget`), for backends targeting the
+// device rather than the host. See this page for a full list of supported
+// architectures of AMD GPUs:
+// https://iree.dev/guides/deployment-configurations/gpu-rocm/#choosing-hip-targets
+static const std::unordered_map<Backend, std::string> kBackendTargetFlag = {
+    {Backend::AMDGPU, "--iree-hip-target="},
+};
+
 // Set appropriate values on `iree_hal_hip_device_params_t` for fusilli hal
 // hip driver creation.
 inline void
@@ -94,12 +100,23 @@ setDefaultIreeHalHipDeviceParams(iree_hal_hip_device_params_t *params) {
   constexpr iree_device_size_t kMinimalFileTransferBufferSize = 1;
 
   iree_hal_hip_device_params_initialize(params);
-  // As buffers should be handled by users, we don't need to cache allocations.
-  params->async_caching = false;
+  // Transient buffers of executions are allocated in stream order: cache them
+  // in the memory pools of the device, so that repeated executions reuse them
+  // rather than allocating device memory (see `kWorkspacePoolAllocatorSpec`).
+  // Handles with a disabled workspace pool turn it off.
+  params->async_caching = true;
   // Fusilli use cases shouldn't require transfering files.
   params->file_transfer_buffer_size = kMinimalFileTransferBufferSize;
 }
 
+// Allocator spec (see `iree_hal_configure_allocator_from_specs`) the device
+// allocators of handles are configured with, serving as the workspace pool of
+// a handle: buffers released by executions (their transients) or by users are
+// returned to it, and reused by later allocations of the same size rather than
+// allocated again from the device. See `Handle::trimWorkspacePool`, and
+// `WorkspacePoolOptions` for disabling or capping it.
+static constexpr const char *kWorkspacePoolAllocatorSpec = "caching";
+
 // Template specializations to map from primitive types
 // to IREE HAL element type.
 template <typename T> struct IreeHalElementType;
@@ -147,6 +164,26 @@ template <typename T> iree_hal_element_type_t getIreeHalElementTypeForT() {
   return IreeHalElementType<T>::kType;
 }
 
+// Map from Fusilli types to IREE HAL element types, for buffers allocated or
+// imported by type rather than from host data (see `IreeHalElementType`).
+static const std::unordered_map<DataType, iree_hal_element_type_t>
+    kDataTypeToIreeHalElementType = {
+        {DataType::Half, IREE_HAL_ELEMENT_TYPE_FLOAT_16},
+        {DataType::BFloat16, IREE_HAL_ELEMENT_TYPE_BFLOAT_16},
+        {DataType::Float, IREE_HAL_ELEMENT_TYPE_FLOAT_32},
+        {DataType::Double, IREE_HAL_ELEMENT_TYPE_FLOAT_64},
+        {DataType::Uint8, IREE_HAL_ELEMENT_TYPE_UINT_8},
+        {DataType::Int8, IREE_HAL_ELEMENT_TYPE_INT_8},
+        {DataType::Int16, IREE_HAL_ELEMENT_TYPE_INT_16},
+        {DataType::Int32, IREE_HAL_ELEMENT_TYPE_INT_32},
+        {DataType::Int64, IREE_HAL_ELEMENT_TYPE_INT_64},
+        {DataType::Boolean, IREE_HAL_ELEMENT_TYPE_BOOL_8},
+        {DataType::FP8E5M2, IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2},
+        {DataType::FP8E4M3FN, IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FN},
+        {DataType::FP8E5M2FNUZ, IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2_FNUZ},
+        {DataType::FP8E4M3FNUZ, IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FNUZ},
+};
+
 // Custom deleter for IREE runtime instance.
 struct IreeRuntimeInstanceDeleter {
   void operator()(iree_runtime_instance_t *instance) const {
@@ -171,6 +208,14 @@ struct IreeRuntimeSessionDeleter {
   }
 };
 
+// Custom deleter for IREE VM module.
+struct IreeVmModuleDeleter {
+  void operator()(iree_vm_module_t *module) const {
+    if (module)
+      iree_vm_module_release(module);
+  }
+};
+
 // Custom deleter for IREE HAL buffer view.
 struct IreeHalBufferViewDeleter {
   void operator()(iree_hal_buffer_view_t *bufferView) const {
@@ -179,15 +224,57 @@ struct IreeHalBufferViewDeleter {
   }
 };
 
+// Custom deleter for IREE HAL buffer.
+struct IreeHalBufferDeleter {
+  void operator()(iree_hal_buffer_t *buffer) const {
+    if (buffer)
+      iree_hal_buffer_release(buffer);
+  }
+};
+
+// Custom deleter for IREE HAL fence.
+struct IreeHalFenceDeleter {
+  void operator()(iree_hal_fence_t *fence) const {
+    if (fence)
+      iree_hal_fence_release(fence);
+  }
+};
+
+// Custom deleter for IREE HAL semaphore.
+struct IreeHalSemaphoreDeleter {
+  void operator()(iree_hal_semaphore_t *semaphore) const {
+    if (semaphore)
+      iree_hal_semaphore_release(semaphore);
+  }
+};
+
+// Custom deleter for IREE runtime call, deinitialized and freed.
+struct IreeRuntimeCallDeleter {
+  void operator()(iree_runtime_call_t *call) const {
+    if (call) {
+      iree_runtime_call_deinitialize(call);
+      delete call;
+    }
+  }
+};
+
 // Aliases for IREE runtime types with custom deleters.
 using IreeRuntimeInstanceSharedPtrType =
     std::shared_ptr<iree_runtime_instance_t>;
-using IreeHalDeviceUniquePtrType =
-    std::unique_ptr<iree_hal_device_t, IreeHalDeviceDeleter>;
+using IreeHalDeviceSharedPtrType = std::shared_ptr<iree_hal_device_t>;
 using IreeRuntimeSessionUniquePtrType =
     std::unique_ptr<iree_runtime_session_t, IreeRuntimeSessionDeleter>;
+using IreeVmModuleSharedPtrType = std::shared_ptr<iree_vm_module_t>;
 using IreeHalBufferViewUniquePtrType =
     std::unique_ptr<iree_hal_buffer_view_t, IreeHalBufferViewDeleter>;
+using IreeHalBufferUniquePtrType =
+    std::unique_ptr<iree_hal_buffer_t, IreeHalBufferDeleter>;
+using IreeHalFenceUniquePtrType =
+    std::unique_ptr<iree_hal_fence_t, IreeHalFenceDeleter>;
+using IreeHalSemaphoreUniquePtrType =
+    std::unique_ptr<iree_hal_semaphore_t, IreeHalSemaphoreDeleter>;
+using IreeRuntimeCallUniquePtrType =
+    std::unique_ptr<iree_runtime_call_t, IreeRuntimeCallDeleter>;
 
 } // namespace fusilli
 
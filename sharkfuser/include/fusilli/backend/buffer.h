@@ -20,6 +20,9 @@
 
 #include <iree/runtime/api.h>
 
+#include <cstddef>
+#include <span>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -37,15 +40,68 @@ public:
   allocate(const Handle &handle, const std::vector<iree_hal_dim_t> &bufferShape,
            const std::vector<T> &bufferData);
 
+  // Factory: Allocates a new buffer view of `bufferShape` and element `type`
+  // without a host copy, e.g. for outputs overwritten by executions. Its
+  // contents are uninitialized, unless `zeroFill` where the device zeroes it.
+  // Allocations are served by the workspace pool of the handle (see
+  // `kWorkspacePoolAllocatorSpec`), reusing buffers released to it.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer>
+  allocate(const Handle &handle, const std::vector<iree_hal_dim_t> &bufferShape,
+           DataType type, bool zeroFill = false);
+
   // Factory: Imports an existing buffer view and retains ownership.
   // Definition in `fusilli/backend/runtime.h`.
   static ErrorOr<Buffer> import(iree_hal_buffer_view_t *externalBufferView);
 
+  // Factory: Imports the external allocation at `ptr` (e.g. from `hipMalloc`
+  // on AMDGPU, from host memory on CPU) as a buffer of `bufferShape` and
+  // element `type`, without copying. The allocation must outlive the buffer
+  // and its executions. Buffer views are cached by the handle by pointer,
+  // type and shape, so that importing the same tensor on every execution
+  // only retains its view. Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer>
+  importDevicePtr(const Handle &handle, void *ptr,
+                  const std::vector<iree_hal_dim_t> &bufferShape,
+                  DataType type);
+
   // Reads device buffer by initiating a device-to-host transfer then
   // populating `outData`. Definition in `fusilli/backend/runtime.h`.
   template <typename T>
   ErrorObject read(const Handle &handle, std::vector<T> &outData);
 
+  // Reads device buffer into `outData`, which must have the size of the
+  // buffer, without allocating. Definition in `fusilli/backend/runtime.h`.
+  template <typename T>
+  ErrorObject read(const Handle &handle, std::span<T> outData);
+
+  // Writes `data`, which must have the size of the buffer, to the device
+  // buffer in place, e.g. to update the inputs of a graph between executions
+  // without allocating new buffers:
+  //
+  //   FUSILLI_CHECK_ERROR(xBuf->write<half>(handle, nextInput));
+  //
+  // Definition in `fusilli/backend/runtime.h`.
+  template <typename T>
+  ErrorObject write(const Handle &handle, std::span<const T> data);
+
+  // Asynchronous `read` and `write`: enqueue the transfer on the device after
+  // `waitFence` (unless null, e.g. the fence of `Graph::executeAsync`) and
+  // return a fence signaled once it completes, to be polled with
+  // `iree_hal_fence_query` or waited for by later executions. Host memory must
+  // stay alive (and unchanged, when written) until then. It is imported into
+  // the device for the transfer, pinned if pageable: pinned allocations (e.g.
+  // with `hipHostMalloc`) avoid pinning it on every transfer.
+  // Definition in `fusilli/backend/runtime.h`.
+  template <typename T>
+  ErrorOr<IreeHalFenceUniquePtrType>
+  readAsync(const Handle &handle, std::span<T> outData,
+            iree_hal_fence_t *waitFence = nullptr);
+  template <typename T>
+  ErrorOr<IreeHalFenceUniquePtrType>
+  writeAsync(const Handle &handle, std::span<const T> data,
+             iree_hal_fence_t *waitFence = nullptr);
+
   // Automatic (implicit) conversion operator for
   // `Buffer` -> `iree_hal_buffer_view_t *`.
   operator iree_hal_buffer_view_t *() const { return getBufferView(); }
@@ -64,6 +120,24 @@ private:
   // as long as this buffer exists.
   iree_hal_buffer_view_t *getBufferView() const { return bufferView_.get(); }
 
+  // Checks that `byteLength` bytes of host memory match the buffer.
+  ErrorObject checkHostByteLength(size_t byteLength) const {
+    size_t bufferLength = iree_hal_buffer_view_byte_length(getBufferView());
+    FUSILLI_RETURN_ERROR_IF(
+        byteLength != bufferLength, ErrorCode::RuntimeFailure,
+        "Buffer transfer failed: host data size (" +
+            std::to_string(byteLength) +
+            " bytes) does not match buffer size (" +
+            std::to_string(bufferLength) + " bytes)");
+    return ok();
+  }
+
+  // Enqueues a transfer between `hostData` and the buffer, to the buffer if
+  // `toDevice`. Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<IreeHalFenceUniquePtrType>
+  enqueueHostTransfer(const Handle &handle, void *hostData, size_t byteLength,
+                      bool toDevice, iree_hal_fence_t *waitFence);
+
   // Explicit constructor is private. Create `Buffer` using one of the
   // factory methods above - `Buffer::import` or `Buffer::allocate`.
   explicit Buffer(IreeHalBufferViewUniquePtrType bufferView)
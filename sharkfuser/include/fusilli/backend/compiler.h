@@ -0,0 +1,310 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the inline definitions for the code querying the IREE
+// compiler used by Fusilli, and for the wrapper code around the IREE compiler
+// embedding C-API, used to compile graphs in-process instead of spawning
+// `iree-compile` (enabled with `-DFUSILLI_ENABLE_COMPILER_API=ON`).
+//
+// With the C-API, the compiler is initialized once per process, and a `CompileSession` is
+// shared by the handles of a backend (so by all graphs compiled for it),
+// which amortizes the initialization of the compiler (MLIR context, dialect
+// and target registration) over graphs. It holds an IREE compiler session per
+// concurrent compilation (see `Graph::compileAsync`), reused by later ones,
+// and is released when the last handle holding it goes out of scope.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_COMPILER_H
+#define FUSILLI_BACKEND_COMPILER_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/support/external_tools.h"
+#include "fusilli/support/logging.h"
+
+#ifdef FUSILLI_ENABLE_COMPILER_API
+#include <iree/compiler/embedding_api.h>
+#endif
+
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Runs `command` through the shell, returning its output without trailing
+// whitespace.
+inline ErrorOr<std::string> runShellCommand(const std::string &command) {
+  FILE *pipe = popen(command.c_str(), "r");
+  FUSILLI_RETURN_ERROR_IF(!pipe, ErrorCode::CompileFailure,
+                          "Failed to run: " + command);
+  std::string result;
+  std::array<char, 256> buffer;
+  while (fgets(buffer.data(), buffer.size(), pipe))
+    result += buffer.data();
+  int returnCode = pclose(pipe);
+  FUSILLI_RETURN_ERROR_IF(returnCode, ErrorCode::CompileFailure,
+                          "Command failed: " + command);
+  while (!result.empty() && std::isspace(result.back()))
+    result.pop_back();
+  return ok(std::move(result));
+}
+
+// Returns the version of the IREE compiler used to compile graphs (queried
+// once per process), so that artifacts compiled by other versions are not
+// reused from the cache.
+inline ErrorOr<std::string> getIreeCompilerVersion() {
+  static std::mutex versionMutex;
+  static std::string version;
+
+  std::lock_guard<std::mutex> lock(versionMutex);
+  if (version.empty()) {
+#ifdef FUSILLI_ENABLE_COMPILER_API
+    version = std::string("iree-compiler-api ") + ireeCompilerGetRevision();
+#else
+    version = FUSILLI_TRY(
+        runShellCommand(std::string(IREE_COMPILE_PATH) + " --version"));
+#endif
+  }
+  return ok(version);
+}
+
+#ifdef FUSILLI_ENABLE_COMPILER_API
+
+// Custom deleter for IREE compiler session.
+struct IreeCompilerSessionDeleter {
+  void operator()(iree_compiler_session_t *session) const {
+    if (session)
+      ireeCompilerSessionDestroy(session);
+  }
+};
+
+// Custom deleter for IREE compiler invocation.
+struct IreeCompilerInvocationDeleter {
+  void operator()(iree_compiler_invocation_t *invocation) const {
+    if (invocation)
+      ireeCompilerInvocationDestroy(invocation);
+  }
+};
+
+// Custom deleter for IREE compiler source.
+struct IreeCompilerSourceDeleter {
+  void operator()(iree_compiler_source_t *source) const {
+    if (source)
+      ireeCompilerSourceDestroy(source);
+  }
+};
+
+// Custom deleter for IREE compiler output.
+struct IreeCompilerOutputDeleter {
+  void operator()(iree_compiler_output_t *output) const {
+    if (output)
+      ireeCompilerOutputDestroy(output);
+  }
+};
+
+// Aliases for IREE compiler types with custom deleters.
+using IreeCompilerSessionUniquePtrType =
+    std::unique_ptr<iree_compiler_session_t, IreeCompilerSessionDeleter>;
+using IreeCompilerInvocationUniquePtrType =
+    std::unique_ptr<iree_compiler_invocation_t, IreeCompilerInvocationDeleter>;
+using IreeCompilerSourceUniquePtrType =
+    std::unique_ptr<iree_compiler_source_t, IreeCompilerSourceDeleter>;
+using IreeCompilerOutputUniquePtrType =
+    std::unique_ptr<iree_compiler_output_t, IreeCompilerOutputDeleter>;
+
+// Converts an `iree_compiler_error_t` to an `ErrorObject`, taking ownership
+// of (and destroying) the error.
+inline ErrorObject compilerErrorToErrorObject(iree_compiler_error_t *error,
+                                              const std::string &context) {
+  if (!error)
+    return ok();
+  std::string message =
+      context + ": " + std::string(ireeCompilerErrorGetMessage(error));
+  ireeCompilerErrorDestroy(error);
+  return ErrorObject(ErrorCode::CompileFailure, message);
+}
+
+// Converts a backend flag, written for the shell running `iree-compile`, to
+// the argument the shell would pass: command substitutions are evaluated
+// (once per process and flag) and quotes are removed.
+inline ErrorOr<std::string> evaluateShellFlag(const std::string &flag) {
+  static std::mutex cacheMutex;
+  static std::unordered_map<std::string, std::string> cache;
+
+  size_t begin = flag.find("$(");
+  size_t end = flag.rfind(')');
+  std::string evaluated = flag;
+  if (begin != std::string::npos && end != std::string::npos && end > begin) {
+    std::string command = flag.substr(begin + 2, end - begin - 2);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(command);
+    if (it == cache.end())
+      it = cache.emplace(command, FUSILLI_TRY(runShellCommand(command))).first;
+    evaluated = flag.substr(0, begin) + it->second + flag.substr(end + 1);
+  }
+  std::erase(evaluated, '"'); // C++20
+  return ok(std::move(evaluated));
+}
+
+// The IREE compiler sessions used to compile for a backend. A compilation
+// takes an idle session (creating one if none is) and returns it once done,
+// as session flags are set for each compilation and sessions may not be used
+// concurrently.
+class CompileSession {
+public:
+  // Compiles the MLIR assembly at `input` to a VM bytecode module at `output`
+  // with `flags` (as passed to `iree-compile`, excluding input and output).
+  // Compiler diagnostics are returned in the error message on failure.
+  ErrorObject compile(const std::filesystem::path &input,
+                      const std::filesystem::path &output,
+                      const std::vector<std::string> &flags) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compiling in-process with IREE compiler");
+
+    std::vector<std::string> args;
+    args.reserve(flags.size());
+    for (const auto &flag : flags)
+      args.push_back(FUSILLI_TRY(evaluateShellFlag(flag)));
+    std::vector<const char *> argv;
+    argv.reserve(args.size());
+    for (const auto &arg : args)
+      argv.push_back(arg.c_str());
+
+    SessionLease session(*this);
+    FUSILLI_CHECK_ERROR(compilerErrorToErrorObject(
+        ireeCompilerSessionSetFlags(session.get(), argv.size(), argv.data()),
+        "Failed to set IREE compiler flags"));
+
+    IreeCompilerInvocationUniquePtrType invocation(
+        ireeCompilerInvocationCreate(session.get()));
+    std::string diagnostics;
+    ireeCompilerInvocationEnableCallbackDiagnostics(
+        invocation.get(), /*flags=*/0,
+        [](enum iree_compiler_diagnostic_severity_t, const char *message,
+           size_t messageSize, void *userData) {
+          auto &diagnostics = *static_cast<std::string *>(userData);
+          diagnostics.append(message, messageSize);
+          diagnostics += "\n";
+        },
+        &diagnostics);
+
+    iree_compiler_source_t *source = nullptr;
+    FUSILLI_CHECK_ERROR(compilerErrorToErrorObject(
+        ireeCompilerSourceOpenFile(session.get(), input.c_str(), &source),
+        "Failed to open IREE compiler input " + input.string()));
+    IreeCompilerSourceUniquePtrType sourceHandle(source);
+
+    FUSILLI_RETURN_ERROR_IF(
+        !ireeCompilerInvocationParseSource(invocation.get(), source),
+        ErrorCode::CompileFailure,
+        "Failed to parse IREE compiler input:\n" + diagnostics);
+    FUSILLI_RETURN_ERROR_IF(
+        !ireeCompilerInvocationPipeline(invocation.get(),
+                                        IREE_COMPILER_PIPELINE_STD),
+        ErrorCode::CompileFailure, "IREE compilation failed:\n" + diagnostics);
+
+    iree_compiler_output_t *outputPtr = nullptr;
+    FUSILLI_CHECK_ERROR(compilerErrorToErrorObject(
+        ireeCompilerOutputOpenFile(output.c_str(), &outputPtr),
+        "Failed to open IREE compiler output " + output.string()));
+    IreeCompilerOutputUniquePtrType outputHandle(outputPtr);
+    FUSILLI_CHECK_ERROR(compilerErrorToErrorObject(
+        ireeCompilerInvocationOutputVMBytecode(invocation.get(), outputPtr),
+        "Failed to write IREE compiler output"));
+    // Outputs opened on files are deleted on destruction unless kept.
+    ireeCompilerOutputKeep(outputPtr);
+    return ok();
+  }
+
+  // Delete copy/move constructors (handles share the session by pointer).
+  CompileSession(const CompileSession &) = delete;
+  CompileSession &operator=(const CompileSession &) = delete;
+  CompileSession(CompileSession &&) = delete;
+  CompileSession &operator=(CompileSession &&) = delete;
+  ~CompileSession() = default;
+
+  // Allow Handle to create sessions through `createSharedCompileSession`.
+  friend class Handle;
+
+private:
+  // A session taken from the idle sessions for the lifetime of the lease.
+  class SessionLease {
+  public:
+    explicit SessionLease(CompileSession &owner) : owner_(owner) {
+      std::lock_guard<std::mutex> lock(owner_.mutex_);
+      if (owner_.idleSessions_.empty()) {
+        session_.reset(ireeCompilerSessionCreate());
+      } else {
+        session_ = std::move(owner_.idleSessions_.back());
+        owner_.idleSessions_.pop_back();
+      }
+    }
+    ~SessionLease() {
+      std::lock_guard<std::mutex> lock(owner_.mutex_);
+      owner_.idleSessions_.push_back(std::move(session_));
+    }
+    SessionLease(const SessionLease &) = delete;
+    SessionLease &operator=(const SessionLease &) = delete;
+
+    iree_compiler_session_t *get() const { return session_.get(); }
+
+  private:
+    CompileSession &owner_;
+    IreeCompilerSessionUniquePtrType session_;
+  };
+
+  CompileSession() = default;
+
+  std::vector<IreeCompilerSessionUniquePtrType> idleSessions_;
+  std::mutex mutex_;
+};
+
+//===----------------------------------------------------------------------===//
+//
+// Handle Compiler API Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Create IREE compiler session shared across the handles of a backend.
+inline std::shared_ptr<CompileSession>
+Handle::createSharedCompileSession(Backend backend) {
+  // The compiler may only be initialized once per process: it is not shut
+  // down when the last session is released.
+  static std::once_flag initFlag;
+  std::call_once(initFlag, [] { ireeCompilerGlobalInitialize(); });
+
+  // Like the runtime instance, sessions are held weakly so that they are
+  // released with the last handle using them.
+  static std::mutex sessionsMutex;
+  static std::unordered_map<Backend, std::weak_ptr<CompileSession>> sessions;
+
+  std::lock_guard<std::mutex> lock(sessionsMutex);
+  std::shared_ptr<CompileSession> session = sessions[backend].lock();
+  if (!session) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Creating IREE compiler session for backend: "
+                           << backend);
+    session = std::shared_ptr<CompileSession>(new CompileSession());
+    sessions[backend] = session;
+  }
+  return session;
+}
+
+#endif // FUSILLI_ENABLE_COMPILER_API
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_COMPILER_H
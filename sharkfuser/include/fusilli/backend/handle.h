@@ -21,28 +21,90 @@
 
 #include <iree/runtime/api.h>
 
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace fusilli {
 
+#ifdef FUSILLI_ENABLE_COMPILER_API
+// Definition in `fusilli/backend/compiler.h`.
+class CompileSession;
+#endif
+
+// Options of the workspace pool of a handle, set when it is created (see
+// `Handle::create`).
+struct WorkspacePoolOptions {
+  // Whether memory released by executions (their transients) and by users is
+  // cached for reuse by later allocations, by the device allocator and, on
+  // HIP devices, by the memory pools of stream-ordered allocations
+  // (`async_caching`). Disable it for applications managing device memory
+  // themselves, at the cost of allocating transients on every execute.
+  bool enabled = true;
+  // Largest number of bytes the pool of each memory heap of the device keeps
+  // allocated, or 0 for no cap. Past it, released memory is freed rather than
+  // cached.
+  size_t maxCachedBytes = 0;
+
+  auto operator<=>(const WorkspacePoolOptions &) const = default;
+};
+
+// Options of the workers executing graphs on the CPU backend, set when a
+// handle is created (see `Handle::create`). The default options use the
+// default topology of the IREE `local-task` driver. Work is dispatched to the
+// workers, so that `Graph::executeAsync` returns while they execute it.
+struct CPUTopologyOptions {
+  // Largest number of workers, one per physical core, or 0 for one per
+  // physical core of `numaNode`.
+  size_t workerCount = 0;
+  // NUMA node whose cores the workers run on, or -1 for any node.
+  int numaNode = -1;
+  // Whether each worker is pinned to its core. Unpinned workers are
+  // scheduled by the OS, e.g. for processes sharing cores.
+  bool pinWorkers = true;
+
+  auto operator<=>(const CPUTopologyOptions &) const = default;
+};
+
 // An application using Fusilli to run operations on a given device
 // must first initialize a handle on that device by calling
 // `Handle::create()`. This allocates the necessary resources
 // (runtime instance, HAL device) whose lifetimes are managed / owned
 // by the handle(s).
+//
+// Handles created for the same backend, device, stream and options share
+// their HAL device, so that creating a handle for a stream
+// already in use (e.g. to switch back to it) does not create a device, and
+// graphs compiled with a handle execute with any handle sharing its device.
+// Graphs executed with handles on other streams of the device reuse their
+// compiled artifact (see `Graph::execute`).
 class Handle {
 public:
   // Creates a Handle for the specified backend. For AMDGPU backend, created
   // handle will use device 0 with the default (null) stream. Other create
   // overloads offer more specificity when setting device and stream.
   static ErrorOr<Handle> create(Backend backend) {
+    return create(backend, WorkspacePoolOptions());
+  }
+
+  // Creates a Handle for the specified backend, as above, whose workspace
+  // pool is configured by `workspacePool`.
+  static ErrorOr<Handle> create(Backend backend,
+                                const WorkspacePoolOptions &workspacePool) {
     FUSILLI_LOG_LABEL_ENDL("INFO: Creating handle for backend: " << backend);
 
     // Create a shared IREE runtime instance (thread-safe) and use it
     // along with the backend to construct a handle (without initializing
     // the device yet).
-    auto handle = Handle(backend, FUSILLI_TRY(Handle::createSharedInstance()));
+    auto handle = Handle(backend, FUSILLI_TRY(Handle::createSharedInstance()),
+                         workspacePool);
 
     // Lazy create handle-specific IREE HAL device and populate the handle.
     switch (backend) {
@@ -61,6 +123,29 @@ public:
     return ok(std::move(handle));
   }
 
+  // Creates a Handle on the CPU backend whose workers are laid out by
+  // `topology`, for predictable scaling of applications sharing the host
+  // (e.g. one handle per NUMA node), and whose workspace pool is configured by
+  // `workspacePool`.
+  static ErrorOr<Handle>
+  create(Backend backend, const CPUTopologyOptions &topology,
+         const WorkspacePoolOptions &workspacePool = WorkspacePoolOptions()) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Creating handle for backend: "
+                           << backend << " with " << topology.workerCount
+                           << " workers on NUMA node: " << topology.numaNode);
+
+    FUSILLI_RETURN_ERROR_IF(backend != Backend::CPU,
+                            ErrorCode::InvalidArgument,
+                            "CPU topology can only be set on CPU backend");
+
+    auto handle = Handle(backend, FUSILLI_TRY(Handle::createSharedInstance()),
+                         workspacePool);
+    handle.cpuTopology_ = topology;
+    FUSILLI_CHECK_ERROR(handle.createCPUDevice());
+
+    return ok(std::move(handle));
+  }
+
   // Creates a Handle on the specified device. Currently device selection
   // supported only for AMDGPU backend. Created handle will use the default
   // (null) stream on device.
@@ -84,6 +169,13 @@ public:
   // `hipStreamGetDevice(stream, ...)`.
   static ErrorOr<Handle> create(Backend backend, int deviceId,
                                 uintptr_t stream) {
+    return create(backend, deviceId, stream, WorkspacePoolOptions());
+  }
+
+  // Creates a Handle using the specified device and stream, as above, whose
+  // workspace pool is configured by `workspacePool`.
+  static ErrorOr<Handle> create(Backend backend, int deviceId, uintptr_t stream,
+                                const WorkspacePoolOptions &workspacePool) {
     FUSILLI_LOG_LABEL_ENDL("INFO: Creating handle for backend: "
                            << backend << " on device: " << deviceId
                            << " and stream: "
@@ -96,7 +188,8 @@ public:
     // Create a shared IREE runtime instance (thread-safe) and use it
     // along with the backend to construct a handle (without initializing
     // the device yet).
-    auto handle = Handle(backend, FUSILLI_TRY(Handle::createSharedInstance()));
+    auto handle = Handle(backend, FUSILLI_TRY(Handle::createSharedInstance()),
+                         workspacePool);
 
     // Lazy create handle-specific IREE HAL device and populate the handle.
     FUSILLI_CHECK_ERROR(
@@ -105,6 +198,27 @@ public:
     return ok(std::move(handle));
   }
 
+  // Releases the device memory cached by the workspace pool of the handle
+  // (see `WorkspacePoolOptions`) and not in use, e.g. between phases of
+  // an application executing graphs of distinct sizes. Definition in
+  // `fusilli/backend/runtime.h`.
+  ErrorObject trimWorkspacePool() const;
+
+  Backend getBackend() const { return backend_; }
+
+  const WorkspacePoolOptions &getWorkspacePoolOptions() const {
+    return workspacePool_;
+  }
+
+  const CPUTopologyOptions &getCPUTopologyOptions() const {
+    return cpuTopology_;
+  }
+
+  // Returns the architecture the device is compiled for (e.g. `gfx942` on
+  // AMDGPU), queried when the device is created, or an empty string for
+  // backends compiling for the host (see `kBackendTargetFlag`).
+  const std::string &getTarget() const { return target_; }
+
   // Automatic (implicit) conversion operator for
   // `Handle` -> `iree_hal_device_t *`.
   operator iree_hal_device_t *() const { return getDevice(); }
@@ -126,6 +240,13 @@ private:
   // handles/threads. Definition in `fusilli/backend/runtime.h`.
   static ErrorOr<IreeRuntimeInstanceSharedPtrType> createSharedInstance();
 
+#ifdef FUSILLI_ENABLE_COMPILER_API
+  // Creates IREE compiler session shared across handles of `backend`.
+  // Definition in `fusilli/backend/compiler.h`.
+  static std::shared_ptr<CompileSession>
+  createSharedCompileSession(Backend backend);
+#endif
+
   // Creates IREE HAL CPU device for this handle. Definition in
   // `fusilli/backend/runtime.h`.
   ErrorObject createCPUDevice();
@@ -134,11 +255,40 @@ private:
   // Definition in `fusilli/backend/runtime.h`.
   ErrorObject createAMDGPUDevice(int deviceId, uintptr_t stream);
 
-  // Private constructor (use factory `create` method for handle creation).
-  Handle(Backend backend, IreeRuntimeInstanceSharedPtrType instance)
-      : backend_(backend), instance_(std::move(instance)) {}
+  // Wraps the allocator of the device with the workspace pool, unless
+  // disabled. Definition in `fusilli/backend/runtime.h`.
+  ErrorObject createWorkspacePool();
 
-  Backend getBackend() const { return backend_; }
+  // The HAL devices of live handles, by backend, device, stream and options
+  // (see `createCPUDevice` and `createAMDGPUDevice`). Held
+  // weakly, so that devices are released with the last handle using them.
+  struct SharedDevices {
+    std::mutex mutex;
+    std::map<std::tuple<Backend, int, uintptr_t, WorkspacePoolOptions,
+                        CPUTopologyOptions>,
+             std::weak_ptr<iree_hal_device_t>>
+        devices;
+  };
+  std::weak_ptr<iree_hal_device_t> &getSharedDevice(SharedDevices &shared,
+                                                    int deviceId,
+                                                    uintptr_t stream) const {
+    return shared.devices[{backend_, deviceId, stream, workspacePool_,
+                           cpuTopology_}];
+  }
+  static SharedDevices &getSharedDevices() {
+    static SharedDevices devices;
+    return devices;
+  }
+
+  // Private constructor (use factory `create` method for handle creation).
+  Handle(Backend backend, IreeRuntimeInstanceSharedPtrType instance,
+         const WorkspacePoolOptions &workspacePool)
+      : backend_(backend), workspacePool_(workspacePool),
+        instance_(std::move(instance)) {
+#ifdef FUSILLI_ENABLE_COMPILER_API
+    compileSession_ = createSharedCompileSession(backend);
+#endif
+  }
 
   // Returns a raw pointer to the underlying IREE HAL device.
   // WARNING: The returned raw pointer is not safe to store since
@@ -152,11 +302,55 @@ private:
   // valid as long as at least one handle exists.
   iree_runtime_instance_t *getInstance() const { return instance_.get(); }
 
+#ifdef FUSILLI_ENABLE_COMPILER_API
+  // Returns the IREE compiler session shared by handles of this backend.
+  CompileSession &getCompileSession() const { return *compileSession_; }
+#endif
+
   // Order of initialization matters here.
   // `device_` depends on `backend_` and `instance_`.
   Backend backend_;
+  WorkspacePoolOptions workspacePool_;
+  CPUTopologyOptions cpuTopology_;
   IreeRuntimeInstanceSharedPtrType instance_;
-  IreeHalDeviceUniquePtrType device_;
+  IreeHalDeviceSharedPtrType device_;
+  std::string target_;
+
+  // Buffer views of the device pointers imported with
+  // `Buffer::importDevicePtr`, by pointer, element type and shape. Declared
+  // after `device_`, so that they are released first.
+  struct ImportedBufferViews {
+    // Past this number of views, the cache is cleared.
+    static constexpr size_t kMaxSize = 256;
+    std::mutex mutex;
+    std::map<std::tuple<uintptr_t, iree_hal_element_type_t,
+                        std::vector<iree_hal_dim_t>>,
+             IreeHalBufferViewUniquePtrType>
+        views;
+  };
+  std::unique_ptr<ImportedBufferViews> importedBufferViews_ =
+      std::make_unique<ImportedBufferViews>();
+
+  // IREE runtime session shared by the graphs executed with this handle, into
+  // which their modules are appended under their names (see
+  // `Graph::createExecuteCall`), instead of each graph creating a session and
+  // its HAL module. Created by the first graph executed, and held by the
+  // graphs using it, as the modules appended to it are retained until it is
+  // released. The mutex serializes appends and invocations, as sessions are
+  // thread-compatible: concurrent executions from several threads should use
+  // a handle per thread (sharing the device).
+  struct SharedSession {
+    std::mutex mutex;
+    IreeRuntimeSessionUniquePtrType session;
+    // Modules appended to the session, by name. Held so that graphs loading
+    // them again get the same module (see `Graph::getSharedModule`).
+    std::map<std::string, IreeVmModuleSharedPtrType> modules;
+  };
+  std::shared_ptr<SharedSession> sharedSession_ =
+      std::make_shared<SharedSession>();
+#ifdef FUSILLI_ENABLE_COMPILER_API
+  std::shared_ptr<CompileSession> compileSession_;
+#endif
 };
 
 } // namespace fusilli
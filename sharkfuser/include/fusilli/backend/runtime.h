@@ -35,19 +35,34 @@
 #include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/backend/backend.h"
 #include "fusilli/backend/buffer.h"
+#include "fusilli/backend/compiler.h"
 #include "fusilli/backend/handle.h"
 #include "fusilli/graph/graph.h"
 #include "fusilli/support/logging.h"
+#include "fusilli/support/tracing.h"
 
 #include <iree/hal/drivers/hip/api.h>
+#include <iree/hal/drivers/local_task/task_device.h>
+#include <iree/hal/local/loaders/embedded_elf_loader.h>
+#include <iree/hal/utils/allocators.h>
+#include <iree/hal/utils/caching_allocator.h>
+#include <iree/io/file_contents.h>
 #include <iree/modules/hal/types.h>
 #include <iree/runtime/api.h>
+#include <iree/task/api.h>
+#include <iree/vm/bytecode/module.h>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace fusilli {
@@ -103,26 +118,136 @@ Handle::createSharedInstance() {
   return ok(sharedInstance);
 }
 
+// Creates a `local-task` HAL device whose task executor has the workers of
+// `options` (see `CPUTopologyOptions`).
+inline ErrorOr<iree_hal_device_t *>
+createIreeHalTaskDevice(const CPUTopologyOptions &options,
+                        iree_allocator_t hostAllocator) {
+  // One worker per physical core, up to `workerCount`.
+  iree_task_topology_t topology;
+  FUSILLI_CHECK_ERROR(iree_task_topology_initialize_from_physical_cores(
+      options.numaNode < 0 ? IREE_TASK_TOPOLOGY_NODE_ID_ANY
+                           : static_cast<iree_task_topology_node_id_t>(
+                                 options.numaNode),
+      IREE_TASK_TOPOLOGY_PERFORMANCE_LEVEL_ANY,
+      options.workerCount == 0 ? IREE_TASK_EXECUTOR_MAX_WORKER_COUNT
+                               : options.workerCount,
+      &topology));
+  if (!options.pinWorkers) {
+    for (iree_host_size_t i = 0; i < topology.group_count; ++i)
+      iree_thread_affinity_set_any(&topology.groups[i].ideal_thread_affinity);
+  }
+
+  iree_task_executor_options_t executorOptions;
+  iree_task_executor_options_initialize(&executorOptions);
+  iree_task_executor_t *executor = nullptr;
+  iree_status_t status = iree_task_executor_create(
+      executorOptions, &topology, hostAllocator, &executor);
+  iree_task_topology_deinitialize(&topology);
+  FUSILLI_CHECK_ERROR(status);
+
+  // Compiled artifacts for the CPU are embedded ELF libraries, loaded into
+  // host memory allocated by a heap allocator (as with the default device).
+  iree_hal_executable_loader_t *loader = nullptr;
+  iree_hal_allocator_t *deviceAllocator = nullptr;
+  iree_hal_device_t *device = nullptr;
+  status = iree_hal_embedded_elf_loader_create(
+      /*plugin_manager=*/nullptr, hostAllocator, &loader);
+  if (iree_status_is_ok(status))
+    status = iree_hal_allocator_create_heap(
+        iree_make_cstring_view(kHalDriver.at(Backend::CPU)), hostAllocator,
+        hostAllocator, &deviceAllocator);
+  if (iree_status_is_ok(status)) {
+    iree_hal_task_device_params_t params;
+    iree_hal_task_device_params_initialize(&params);
+    status = iree_hal_task_device_create(
+        iree_make_cstring_view(kHalDriver.at(Backend::CPU)), &params,
+        /*queue_count=*/1, &executor, /*loader_count=*/1, &loader,
+        deviceAllocator, hostAllocator, &device);
+  }
+  // The device retains what it uses.
+  iree_hal_allocator_release(deviceAllocator);
+  iree_hal_executable_loader_release(loader);
+  iree_task_executor_release(executor);
+  FUSILLI_CHECK_ERROR(status);
+  return ok(device);
+}
+
 inline ErrorObject Handle::createCPUDevice() {
+  SharedDevices &shared = getSharedDevices();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  std::weak_ptr<iree_hal_device_t> &sharedDevice =
+      getSharedDevice(shared, /*deviceId=*/0, /*stream=*/0);
+  device_ = sharedDevice.lock();
+  if (device_ != nullptr) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Reusing IREE HAL device of live handles");
+    return ok();
+  }
   FUSILLI_LOG_LABEL_ENDL("INFO: Creating per-handle IREE HAL device");
 
   iree_hal_device_t *rawDevice = nullptr;
-  FUSILLI_CHECK_ERROR(iree_runtime_instance_try_create_default_device(
-      instance_.get(), iree_make_cstring_view(kHalDriver.at(backend_)),
-      &rawDevice));
+  if (cpuTopology_ == CPUTopologyOptions()) {
+    FUSILLI_CHECK_ERROR(iree_runtime_instance_try_create_default_device(
+        instance_.get(), iree_make_cstring_view(kHalDriver.at(backend_)),
+        &rawDevice));
+  } else {
+    rawDevice = FUSILLI_TRY(createIreeHalTaskDevice(
+        cpuTopology_, iree_runtime_instance_host_allocator(instance_.get())));
+  }
 
-  // Wrap the raw device ptr with a unique_ptr and custom deleter
+  // Wrap the raw device ptr with a shared_ptr and custom deleter
   // for lifetime management.
-  device_ = IreeHalDeviceUniquePtrType(rawDevice);
+  device_ = IreeHalDeviceSharedPtrType(rawDevice, IreeHalDeviceDeleter());
+  FUSILLI_CHECK_ERROR(createWorkspacePool());
 
+  sharedDevice = device_;
   return ok();
 }
 
+// Returns the architecture of HIP device `deviceId` (e.g. `gfx942`), queried
+// once per process and device. `rocm_agent_enumerator` lists the GPU agents in
+// the order of HIP devices, after the CPU agents (listed as `gfx000`), unless
+// HIP devices are reordered with `HIP_VISIBLE_DEVICES`.
+inline ErrorOr<std::string> getAMDGPUTarget(int deviceId) {
+  static std::mutex targetsMutex;
+  static std::unordered_map<int, std::string> targets;
+
+  std::lock_guard<std::mutex> lock(targetsMutex);
+  auto it = targets.find(deviceId);
+  if (it == targets.end()) {
+    std::string target = FUSILLI_TRY(runShellCommand(
+        "rocm_agent_enumerator | grep -v '^gfx000$' | sed -n '" +
+        std::to_string(deviceId + 1) + " p'"));
+    FUSILLI_RETURN_ERROR_IF(target.empty(), ErrorCode::RuntimeFailure,
+                            "No AMDGPU target found for device " +
+                                std::to_string(deviceId));
+    it = targets.emplace(deviceId, std::move(target)).first;
+  }
+  return ok(it->second);
+}
+
 // Copied from the IREE runtime code.
 #define HIP_DEVICE_ID_TO_IREE_DEVICE_ID(device)                                \
   (iree_hal_device_id_t)((device) + 1)
 
 inline ErrorObject Handle::createAMDGPUDevice(int deviceId, uintptr_t stream) {
+  // Compile for the architecture of this device, so that handles on distinct
+  // GPUs do not share compiled artifacts.
+  target_ = FUSILLI_TRY(getAMDGPUTarget(deviceId));
+  FUSILLI_LOG_LABEL_ENDL("INFO: AMDGPU device target: " << target_);
+
+  // The stream is a parameter of the HAL device: handles on the same stream
+  // share a device.
+  SharedDevices &shared = getSharedDevices();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  std::weak_ptr<iree_hal_device_t> &sharedDevice =
+      getSharedDevice(shared, deviceId, stream);
+  device_ = sharedDevice.lock();
+  if (device_ != nullptr) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Reusing IREE HAL device of live handles");
+    return ok();
+  }
+
   FUSILLI_LOG_LABEL_ENDL("INFO: Creating per-handle IREE HAL device on device: "
                          << deviceId
                          << " stream: " << reinterpret_cast<void *>(stream));
@@ -131,6 +256,7 @@ inline ErrorObject Handle::createAMDGPUDevice(int deviceId, uintptr_t stream) {
   iree_hal_hip_device_params_t params;
   setDefaultIreeHalHipDeviceParams(&params);
   params.external_stream = stream; // set stream to provided stream
+  params.async_caching = workspacePool_.enabled;
 
   // Create driver.
   iree_hal_hip_driver_options_t driverOptions;
@@ -146,139 +272,445 @@ inline ErrorObject Handle::createAMDGPUDevice(int deviceId, uintptr_t stream) {
       driver, HIP_DEVICE_ID_TO_IREE_DEVICE_ID(deviceId), /*param_count=*/0,
       /*params=*/nullptr, iree_allocator_system(), &rawDevice));
 
-  // Wrap the raw device ptr with a unique_ptr and custom deleter
+  // Wrap the raw device ptr with a shared_ptr and custom deleter
   // for lifetime management.
-  device_ = IreeHalDeviceUniquePtrType(rawDevice);
+  device_ = IreeHalDeviceSharedPtrType(rawDevice, IreeHalDeviceDeleter());
+  FUSILLI_CHECK_ERROR(createWorkspacePool());
 
+  sharedDevice = device_;
   return ok();
 }
 
 #undef HIP_DEVICE_ID_TO_IREE_DEVICE_ID
 
+inline ErrorObject Handle::createWorkspacePool() {
+  if (!workspacePool_.enabled) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Workspace pool of handle disabled");
+    return ok();
+  }
+  if (workspacePool_.maxCachedBytes == 0) {
+    iree_string_view_t spec =
+        iree_make_cstring_view(kWorkspacePoolAllocatorSpec);
+    FUSILLI_CHECK_ERROR(iree_hal_configure_allocator_from_specs(
+        /*spec_count=*/1, &spec, device_.get()));
+    return ok();
+  }
+
+  // Capped pools are not expressible as a spec: create a caching allocator
+  // with a pool per memory heap of the device.
+  iree_hal_allocator_t *deviceAllocator =
+      iree_hal_device_allocator(device_.get());
+  std::array<iree_hal_allocator_memory_heap_t, 8> heaps;
+  iree_host_size_t heapCount = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_allocator_query_memory_heaps(
+      deviceAllocator, heaps.size(), heaps.data(), &heapCount));
+  std::vector<iree_hal_caching_allocator_pool_params_t> pools(heapCount);
+  for (iree_host_size_t i = 0; i < heapCount; ++i) {
+    iree_hal_caching_allocator_pool_params_initialize(heaps[i], &pools[i]);
+    pools[i].max_allocation_capacity = workspacePool_.maxCachedBytes;
+  }
+  iree_hal_allocator_t *cachingAllocator = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_caching_allocator_create_with_pools(
+      pools.size(), pools.data(), deviceAllocator, iree_allocator_system(),
+      &cachingAllocator));
+  iree_status_t status =
+      iree_hal_device_replace_allocator(device_.get(), cachingAllocator);
+  iree_hal_allocator_release(cachingAllocator);
+  FUSILLI_CHECK_ERROR(status);
+  return ok();
+}
+
+inline ErrorObject Handle::trimWorkspacePool() const {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Trimming workspace pool of handle");
+  FUSILLI_CHECK_ERROR(
+      iree_hal_allocator_trim(iree_hal_device_allocator(getDevice())));
+  return ok();
+}
+
 //===----------------------------------------------------------------------===//
 //
 // Graph Runtime API Methods
 //
 //===----------------------------------------------------------------------===//
 
-// Create IREE runtime session for this graph and load the compiled artifact.
+// Load the compiled artifact of this graph in an IREE runtime session.
 inline ErrorObject Graph::createPerGraphSession(const Handle &handle,
                                                 const std::string &vmfbPath) {
-  // Create a session even if one was created earlier, since the handle
-  // (hence device) might have changed and we might be re-compiling the graph
-  // for the new device.
-  FUSILLI_LOG_LABEL_ENDL("INFO: Creating per-graph IREE runtime session");
-  iree_runtime_session_options_t opts;
-  iree_runtime_session_options_initialize(&opts);
-
-  iree_runtime_session_t *rawSession = nullptr;
-  FUSILLI_CHECK_ERROR(iree_runtime_session_create_with_device(
-      handle.getInstance(), &opts, handle.getDevice(),
-      iree_runtime_instance_host_allocator(handle.getInstance()), &rawSession));
-
-  // Wrap the raw session ptr with a unique_ptr and custom deleter
-  // for lifetime management.
-  session_ = IreeRuntimeSessionUniquePtrType(rawSession);
+  // Load it even if it was loaded earlier, since the handle (hence device)
+  // might have changed and we might be re-compiling the graph for the new
+  // device.
+  FUSILLI_TRACE_SCOPE("Graph::createPerGraphSession");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Setting up IREE runtime session of graph");
+  executeCall_.reset();
+  {
+    std::lock_guard<std::mutex> lock(otherExecuteCalls_->mutex);
+    otherExecuteCalls_->calls.clear();
+  }
 
-  // Load the vmfb into the session.
+  // Load the vmfb, shared by the sessions of the graph.
   FUSILLI_LOG_LABEL_ENDL("INFO: Loading module in IREE runtime session");
-  FUSILLI_CHECK_ERROR(iree_runtime_session_append_bytecode_module_from_file(
-      session_.get(), vmfbPath.c_str()));
+  module_ = FUSILLI_TRY(getSharedModule(handle, vmfbPath));
+  executeCall_ = FUSILLI_TRY(createExecuteCall(handle));
+  return ok();
+}
+
+inline ErrorOr<std::unique_ptr<Graph::ExecuteCall>>
+Graph::createExecuteCall(const Handle &handle) const {
+  if (!kBackendExecuteAsync.contains(handle.getBackend())) // C++ 20
+    return ErrorObject(ErrorCode::InternalError,
+                       "Graph runtime session got an unknown backend");
+  bool executeAsync = kBackendExecuteAsync.at(handle.getBackend());
+
+  auto executeCall = std::make_unique<ExecuteCall>();
+  executeCall->device = handle.getDevice();
+  executeCall->backend = handle.getBackend();
+  executeCall->target = handle.getTarget();
+
+  iree_string_view_t moduleName = iree_vm_module_name(module_.get());
+  executeCall->moduleName.assign(moduleName.data, moduleName.size);
+
+  auto createSession = [&]() -> ErrorOr<IreeRuntimeSessionUniquePtrType> {
+    iree_runtime_session_options_t opts;
+    iree_runtime_session_options_initialize(&opts);
+
+    iree_runtime_session_t *rawSession = nullptr;
+    FUSILLI_CHECK_ERROR(iree_runtime_session_create_with_device(
+        handle.getInstance(), &opts, handle.getDevice(),
+        iree_runtime_instance_host_allocator(handle.getInstance()),
+        &rawSession));
+
+    // Wrap the raw session ptr with a unique_ptr and custom deleter
+    // for lifetime management.
+    return ok(IreeRuntimeSessionUniquePtrType(rawSession));
+  };
+
+  // Append the module to the shared session of the handle, unless already
+  // appended (by graphs sharing it). Sessions resolve functions by qualified
+  // name, so a graph whose module has the name of another one appended
+  // (e.g. the same graph compiled with another tuning config) gets a session
+  // of its own.
+  {
+    std::shared_ptr<Handle::SharedSession> sharedSession =
+        handle.sharedSession_;
+    std::lock_guard<std::mutex> lock(sharedSession->mutex);
+    if (!sharedSession->session) {
+      FUSILLI_LOG_LABEL_ENDL("INFO: Creating shared IREE runtime session");
+      sharedSession->session = FUSILLI_TRY(createSession());
+    }
+    auto it = sharedSession->modules.find(executeCall->moduleName);
+    if (it == sharedSession->modules.end()) {
+      FUSILLI_CHECK_ERROR(iree_runtime_session_append_module(
+          sharedSession->session.get(), module_.get()));
+      sharedSession->modules.emplace(executeCall->moduleName, module_);
+      executeCall->sharedSession = std::move(sharedSession);
+    } else if (it->second == module_) {
+      executeCall->sharedSession = std::move(sharedSession);
+    }
+  }
+  if (!executeCall->sharedSession) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Creating per-graph IREE runtime session");
+    executeCall->session = FUSILLI_TRY(createSession());
+    FUSILLI_CHECK_ERROR(iree_runtime_session_append_module(
+        executeCall->session.get(), module_.get()));
+  }
 
+  // Set up the call reused by `execute`: of `main` for synchronous execution
+  // and `main$async` for asynchronous execution.
+  std::string function = executeCall->moduleName +
+                         (executeAsync ? ".main$async" : ".main");
+  auto call = std::make_unique<iree_runtime_call_t>();
+  FUSILLI_CHECK_ERROR(iree_runtime_call_initialize_by_name(
+      executeCall->getSession(), iree_make_cstring_view(function.c_str()),
+      call.get()));
+  executeCall->call = IreeRuntimeCallUniquePtrType(call.release());
+
+  // In the asynchronous case, the IREE generated `@main$async` function
+  // expects two additional `hal.fence` arguments. Since we rely on
+  // stream-ordered synchronization, the fences may be dummy just to
+  // align with the function signature without doing anything useful: they
+  // have no timepoints, so they are always completed and reused across calls.
+  if (executeAsync) {
+    constexpr iree_host_size_t kDummyFenceCapacity = 0;
+    // Dummy wait fence (tells generated function that inputs are ready).
+    iree_hal_fence_t *waitFence = nullptr;
+    FUSILLI_CHECK_ERROR(iree_hal_fence_create(
+        kDummyFenceCapacity, iree_allocator_system(), &waitFence));
+    executeCall->waitFence = IreeHalFenceUniquePtrType(waitFence);
+    // Dummy signal fence (tells downstream consumers that kernel has ran).
+    iree_hal_fence_t *signalFence = nullptr;
+    FUSILLI_CHECK_ERROR(iree_hal_fence_create(
+        kDummyFenceCapacity, iree_allocator_system(), &signalFence));
+    executeCall->signalFence = IreeHalFenceUniquePtrType(signalFence);
+  }
+  return ok(std::move(executeCall));
+}
+
+inline ErrorOr<Graph::ExecuteCall *>
+Graph::getExecuteCall(const Handle &handle) const {
+  FUSILLI_RETURN_ERROR_IF(executeCall_ == nullptr, ErrorCode::NotCompiled,
+                          "Graph must be compiled before being executed");
+  if (handle.getDevice() == executeCall_->device)
+    return ok(executeCall_.get());
+
+  // The compiled artifact runs on devices of the same backend and target.
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != executeCall_->backend ||
+                              handle.getTarget() != executeCall_->target,
+                          ErrorCode::InvalidArgument,
+                          "Graph must be compiled with a handle of the same "
+                          "backend and target as the executing one");
+  std::lock_guard<std::mutex> lock(otherExecuteCalls_->mutex);
+  std::unique_ptr<ExecuteCall> &executeCall =
+      otherExecuteCalls_->calls[handle.getDevice()];
+  if (executeCall == nullptr) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Creating IREE runtime session of the graph "
+                           "on the device of another handle");
+    ErrorOr<std::unique_ptr<ExecuteCall>> created = createExecuteCall(handle);
+    if (isError(created)) {
+      otherExecuteCalls_->calls.erase(handle.getDevice());
+      return ErrorObject(created);
+    }
+    executeCall = std::move(*created);
+  }
+  return ok(executeCall.get());
+}
+
+// Returns the bytecode module of the vmfb at `vmfbPath`, memory mapped and
+// shared by graphs of the process loading the same compiled artifact in the
+// same VM instance. Compiled artifacts are cached in directories named after
+// a hash of their contents (see `Graph::getCacheKey`), so their path
+// identifies the module: identical graphs share module memory and skip the
+// reload.
+inline ErrorOr<IreeVmModuleSharedPtrType>
+Graph::getSharedModule(const Handle &handle, const std::string &vmfbPath) {
+  // Like the runtime instance, modules are held weakly so that they are
+  // released with the last session using them. Keys include the VM instance
+  // as modules are created in one, and as a live module retains its instance
+  // the address of a live entry's instance may not be reused.
+  using ModuleKey = std::pair<iree_vm_instance_t *, std::string>;
+  static std::mutex modulesMutex;
+  static std::map<ModuleKey, std::weak_ptr<iree_vm_module_t>> modules;
+
+  iree_vm_instance_t *vmInstance =
+      iree_runtime_instance_vm_instance(handle.getInstance());
+  ModuleKey key(vmInstance, vmfbPath);
+
+  std::lock_guard<std::mutex> lock(modulesMutex);
+  std::erase_if(modules, [](const auto &entry) { // C++20
+    return entry.second.expired();
+  });
+  if (IreeVmModuleSharedPtrType module = modules[key].lock()) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Reusing loaded module " << vmfbPath);
+    return ok(module);
+  }
+
+  iree_allocator_t hostAllocator =
+      iree_runtime_instance_host_allocator(handle.getInstance());
+  iree_io_file_contents_t *contents = nullptr;
+  FUSILLI_CHECK_ERROR(iree_io_file_contents_map(
+      iree_make_cstring_view(vmfbPath.c_str()), IREE_IO_FILE_ACCESS_READ,
+      hostAllocator, &contents));
+
+  // The module only takes ownership of the mapped contents when created
+  // successfully.
+  iree_vm_module_t *rawModule = nullptr;
+  iree_status_t status = iree_vm_bytecode_module_create(
+      vmInstance, contents->const_buffer,
+      iree_io_file_contents_deallocator(contents), hostAllocator, &rawModule);
+  if (!iree_status_is_ok(status)) {
+    iree_io_file_contents_free(contents);
+    return ErrorObject(status);
+  }
+
+  IreeVmModuleSharedPtrType module(rawModule, IreeVmModuleDeleter());
+  modules[key] = module;
+  return ok(module);
+}
+
+// Checks that the shape of `bufferView` matches the physical dims of the
+// dynamic `tensor`, except for its dynamic dims, bound by the buffer. The
+// shapes of buffers of static tensors are checked by the IREE runtime.
+inline ErrorObject checkDynamicBufferShape(const TensorAttr &tensor,
+                                           iree_hal_buffer_view_t *bufferView) {
+  std::vector<int64_t> dims = tensor.getPhysicalDim();
+  bool matches = iree_hal_buffer_view_shape_rank(bufferView) == dims.size();
+  for (size_t i = 0; matches && i < dims.size(); ++i)
+    matches = tensor.isPhysicalDimDynamic(i) ||
+              static_cast<int64_t>(iree_hal_buffer_view_shape_dim(
+                  bufferView, i)) == dims[i];
+  FUSILLI_RETURN_ERROR_IF(!matches, ErrorCode::VariantPackError,
+                          "Buffer shape does not match the dims of tensor '" +
+                              tensor.getName() + "'");
   return ok();
 }
 
 // Executes the graph using IREE runtime. Requires a `variantPack` which is a
 // map from `TensorAttr` to `Buffer` wrapping the `iree_hal_buffer_view_t *`.
+// The sizes of dynamic dims are bound by the shapes of the buffers, which must
+// be consistent (e.g. the batch sizes of the input and output of a conv).
 //
-// TODO(#2232): Memoize `iree_runtime_call_t` initialization and populate buffer
-// views at setup to avoid paying the penalty for every `Graph::execute`
-// invocation. Use `iree_runtime_call_reset` to reset the call inputs/outputs
-// if needed.
+// Buffers are looked up in the order of the binding plan (see
+// `Graph::getBindingPlan`) and executed with the positional `execute`.
 inline ErrorObject Graph::execute(
     const Handle &handle,
     const std::unordered_map<std::shared_ptr<TensorAttr>,
                              std::shared_ptr<Buffer>> &variantPack) const {
-  FUSILLI_LOG_LABEL_ENDL("INFO: Executing Graph");
-  FUSILLI_RETURN_ERROR_IF(session_ == nullptr, ErrorCode::NotCompiled,
+  FUSILLI_RETURN_ERROR_IF(executeCall_ == nullptr, ErrorCode::NotCompiled,
                           "Graph must be compiled before being executed");
+  std::vector<iree_hal_buffer_view_t *> buffers =
+      FUSILLI_TRY(getBindings(variantPack));
+  return execute(handle, buffers);
+}
 
-  if (!kBackendExecuteAsync.contains(handle.getBackend())) // C++ 20
-    return ErrorObject(ErrorCode::InternalError,
-                       "Graph::execute got an unknown backend");
-  bool executeAsync = kBackendExecuteAsync.at(handle.getBackend());
-
-  // Call `module.main` for synchronous execution and `module.main$async` for
-  // asynchronous execution.
-  iree_runtime_call_t call;
-  FUSILLI_CHECK_ERROR(iree_runtime_call_initialize_by_name(
-      session_.get(),
-      iree_make_cstring_view(executeAsync ? "module.main$async"
-                                          : "module.main"),
-      &call));
-
-  // Populate output buffers.
-  for (const auto &output : fullGraphOutputsSorted_) {
-    // Virtual tensors are internal to the function (intermediate outputs) and
-    // aren't exposed in the runtime call's signature.
-    if (output->isVirtual()) {
-      FUSILLI_RETURN_ERROR_IF(variantPack.contains(output),
-                              ErrorCode::VariantPackError,
-                              "Virtual output tensor found in variantPack");
-      continue;
-    }
-    FUSILLI_RETURN_ERROR_IF(!variantPack.contains(output), // C++20
+inline ErrorOr<std::vector<iree_hal_buffer_view_t *>> Graph::getBindings(
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>> &variantPack) const {
+  // Virtual tensors are internal to the function (intermediate outputs) and
+  // aren't exposed in the runtime call's signature.
+  for (const auto &output : fullGraphOutputsSorted_)
+    FUSILLI_RETURN_ERROR_IF(output->isVirtual() && variantPack.contains(output),
                             ErrorCode::VariantPackError,
-                            "Output tensor missing from variantPack");
-    FUSILLI_CHECK_ERROR(iree_runtime_call_inputs_push_back_buffer_view(
-        &call, *(variantPack.at(output))));
-  }
+                            "Virtual output tensor found in variantPack");
 
-  // Populate input buffers.
-  for (const auto &input : fullGraphInputsSorted_) {
-    FUSILLI_RETURN_ERROR_IF(!variantPack.contains(input), // C++20
+  std::vector<iree_hal_buffer_view_t *> buffers;
+  buffers.reserve(bindingPlan_.size());
+  for (const auto &tensor : bindingPlan_) {
+    auto it = variantPack.find(tensor);
+    FUSILLI_RETURN_ERROR_IF(it == variantPack.end(),
                             ErrorCode::VariantPackError,
-                            "Input tensor missing from variantPack");
-    FUSILLI_CHECK_ERROR(iree_runtime_call_inputs_push_back_buffer_view(
-        &call, *(variantPack.at(input))));
+                            "Tensor '" + tensor->getName() +
+                                "' missing from variantPack");
+    buffers.push_back(*it->second);
   }
+  return ok(std::move(buffers));
+}
 
-  // In the asynchronous case, the IREE generated `@main$async` function
-  // expects two additional `hal.fence` arguments. Since we rely on
-  // stream-ordered synchronization, the fences may be dummy just to
-  // align with the function signature without doing anything useful.
-  if (executeAsync) {
-    constexpr iree_host_size_t kDummyFenceCapacity = 0;
-    // Create dummy wait fence (tells generated function that inputs are ready)
-    // that's already completed.
-    {
-      iree_hal_fence_t *waitFence;
-      FUSILLI_CHECK_ERROR(iree_hal_fence_create(
-          kDummyFenceCapacity, iree_allocator_system(), &waitFence));
-
-      iree_vm_ref_t waitFenceRef = iree_hal_fence_retain_ref(waitFence);
-      FUSILLI_CHECK_ERROR(
-          iree_vm_list_push_ref_move(call.inputs, &waitFenceRef));
-      iree_vm_ref_release(&waitFenceRef);
-    }
-    // Create dummy signal fence (tells downstream consumers that kernel has
-    // ran) that's already completed.
-    {
-      iree_hal_fence_t *signalFence;
-      FUSILLI_CHECK_ERROR(iree_hal_fence_create(
-          kDummyFenceCapacity, iree_allocator_system(), &signalFence));
-
-      iree_vm_ref_t signalFenceRef = iree_hal_fence_retain_ref(signalFence);
-      FUSILLI_CHECK_ERROR(
-          iree_vm_list_push_ref_move(call.inputs, &signalFenceRef));
-      iree_vm_ref_release(&signalFenceRef);
+// Executes the graph using IREE runtime, with `buffers` bound to the tensors
+// of the binding plan (see `Graph::getBindingPlan`).
+//
+// The runtime call set up with the session (see `createExecuteCall`) is
+// reset and reused, so that repeated executions only push their buffers.
+inline ErrorObject
+Graph::execute(const Handle &handle,
+               std::span<iree_hal_buffer_view_t *const> buffers) const {
+  FUSILLI_TRACE_SCOPE("Graph::execute");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Executing Graph");
+  ExecuteCall *executeCall = FUSILLI_TRY(getExecuteCall(handle));
+  FUSILLI_CHECK_ERROR(checkBuffers(buffers));
+  return invokeExecuteCall(*executeCall, buffers);
+}
+
+inline ErrorObject Graph::invokeExecuteCall(
+    ExecuteCall &executeCall,
+    std::span<iree_hal_buffer_view_t *const> buffers) const {
+  std::lock_guard<std::mutex> lock(executeCall.mutex);
+  std::unique_lock<std::mutex> sessionLock = executeCall.lockSharedSession();
+  // Pass the dummy fences of asynchronous execution (see
+  // `createExecuteCall`). Kept off the heap, so that repeated executions don't
+  // allocate on the host (e.g. while captured in a HIP graph).
+  std::array<iree_hal_fence_t *, 2> fences = {executeCall.waitFence.get(),
+                                              executeCall.signalFence.get()};
+  return invokeCall(executeCall.call.get(), buffers,
+                    std::span(fences).first(executeCall.waitFence ? 2 : 0));
+}
+
+// Executes the graph with `main$async`, waiting for `waitFence` and
+// signaling the returned fence at the next timepoint of the semaphore of the
+// graph.
+inline ErrorOr<IreeHalFenceUniquePtrType>
+Graph::executeAsync(const Handle &handle,
+                    std::span<iree_hal_buffer_view_t *const> buffers,
+                    iree_hal_fence_t *waitFence) const {
+  FUSILLI_TRACE_SCOPE("Graph::executeAsync");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Executing Graph ordered by fences");
+  ExecuteCall &executeCall = *FUSILLI_TRY(getExecuteCall(handle));
+  FUSILLI_CHECK_ERROR(checkBuffers(buffers));
+
+  std::lock_guard<std::mutex> lock(executeCall.mutex);
+  std::unique_lock<std::mutex> sessionLock = executeCall.lockSharedSession();
+  iree_runtime_call_t *call = executeCall.call.get();
+  if (!kBackendExecuteAsync.at(handle.getBackend())) {
+    // Synchronous backends execute `main` otherwise.
+    if (!executeCall.asyncCall) {
+      std::string function = executeCall.moduleName + ".main$async";
+      auto asyncCall = std::make_unique<iree_runtime_call_t>();
+      FUSILLI_CHECK_ERROR(iree_runtime_call_initialize_by_name(
+          executeCall.getSession(), iree_make_cstring_view(function.c_str()),
+          asyncCall.get()));
+      executeCall.asyncCall =
+          IreeRuntimeCallUniquePtrType(asyncCall.release());
     }
+    call = executeCall.asyncCall.get();
+  }
+  if (!executeCall.semaphore) {
+    iree_hal_semaphore_t *semaphore = nullptr;
+    FUSILLI_CHECK_ERROR(iree_hal_semaphore_create(
+        handle.getDevice(), IREE_HAL_QUEUE_AFFINITY_ANY,
+        /*initial_value=*/0, /*flags=*/IREE_HAL_SEMAPHORE_FLAG_NONE,
+        &semaphore));
+    executeCall.semaphore = IreeHalSemaphoreUniquePtrType(semaphore);
+    executeCall.timepoint = 0;
+  }
+
+  iree_hal_fence_t *signalFence = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_fence_create_at(
+      executeCall.semaphore.get(), executeCall.timepoint + 1,
+      iree_allocator_system(), &signalFence));
+  IreeHalFenceUniquePtrType signalFenceHandle(signalFence);
+  ErrorObject status =
+      invokeCall(call, buffers, std::array{waitFence, signalFence});
+  if (isError(status)) {
+    // The semaphore may have been failed by the invocation: the next
+    // execution creates a new one.
+    executeCall.semaphore.reset();
+    return status;
+  }
+  ++executeCall.timepoint;
+  return ok(std::move(signalFenceHandle));
+}
+
+inline ErrorObject
+Graph::checkBuffers(std::span<iree_hal_buffer_view_t *const> buffers) const {
+  FUSILLI_RETURN_ERROR_IF(buffers.size() != bindingPlan_.size(),
+                          ErrorCode::VariantPackError,
+                          "Expected " + std::to_string(bindingPlan_.size()) +
+                              " buffers, got " +
+                              std::to_string(buffers.size()));
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    const TensorAttr &tensor = *bindingPlan_[i];
+    FUSILLI_RETURN_ERROR_IF(buffers[i] == nullptr, ErrorCode::VariantPackError,
+                            "Buffer of tensor '" + tensor.getName() +
+                                "' is null");
+    if (tensor.isDynamic())
+      FUSILLI_CHECK_ERROR(checkDynamicBufferShape(tensor, buffers[i]));
   }
+  return ok();
+}
+
+inline ErrorObject
+Graph::invokeCall(iree_runtime_call_t *call,
+                  std::span<iree_hal_buffer_view_t *const> buffers,
+                  std::span<iree_hal_fence_t *const> fences) const {
+  iree_runtime_call_reset(call);
 
-  // Invoke call.
-  FUSILLI_CHECK_ERROR(iree_runtime_call_invoke(&call, /*flags=*/0));
+  // Populate output and input buffers.
+  for (iree_hal_buffer_view_t *buffer : buffers)
+    FUSILLI_CHECK_ERROR(
+        iree_runtime_call_inputs_push_back_buffer_view(call, buffer));
 
-  iree_runtime_call_deinitialize(&call);
+  // The IREE generated `@main$async` function expects two additional
+  // `hal.fence` arguments: the fences to wait for and signal.
+  for (iree_hal_fence_t *fence : fences) {
+    iree_vm_ref_t fenceRef = iree_vm_ref_null();
+    if (fence)
+      fenceRef = iree_hal_fence_retain_ref(fence);
+    iree_status_t status = iree_vm_list_push_ref_move(call->inputs, &fenceRef);
+    iree_vm_ref_release(&fenceRef);
+    FUSILLI_CHECK_ERROR(status);
+  }
+
+  // Invoke call, then release the references to the buffers.
+  FUSILLI_CHECK_ERROR(iree_runtime_call_invoke(call, /*flags=*/0));
+  iree_runtime_call_reset(call);
   return ok();
 }
 
@@ -339,6 +771,75 @@ Buffer::allocate(const Handle &handle,
 //
 //===----------------------------------------------------------------------===//
 
+// Factory: Allocates a new buffer view without a host copy.
+inline ErrorOr<Buffer>
+Buffer::allocate(const Handle &handle,
+                 const std::vector<iree_hal_dim_t> &bufferShape, DataType type,
+                 bool zeroFill) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Allocating new device buffer without copy");
+  FUSILLI_RETURN_ERROR_IF(
+      !kDataTypeToIreeHalElementType.contains(type),
+      ErrorCode::RuntimeFailure,
+      "Buffer::allocate failed: unsupported element type");
+  iree_hal_element_type_t elementType = kDataTypeToIreeHalElementType.at(type);
+
+  size_t expectedSize = 1;
+  for (auto dim : bufferShape)
+    expectedSize *= dim;
+  FUSILLI_RETURN_ERROR_IF(
+      expectedSize == 0 || bufferShape.empty(), ErrorCode::RuntimeFailure,
+      "Buffer::allocate failed: cannot allocate a buffer with zero size");
+
+  iree_device_size_t byteLength = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+      bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+
+  iree_hal_device_t *device = handle.getDevice();
+  iree_hal_buffer_t *rawBuffer = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_allocator_allocate_buffer(
+      iree_hal_device_allocator(device),
+      (iree_hal_buffer_params_t){
+          .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
+          .access = IREE_HAL_MEMORY_ACCESS_ALL,
+          .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
+      },
+      byteLength, &rawBuffer));
+  IreeHalBufferUniquePtrType buffer(rawBuffer);
+
+  if (zeroFill) {
+    // Fill on the device, waiting for the fill to complete so that the buffer
+    // is zeroed for any use (including host transfers).
+    iree_hal_semaphore_t *rawSemaphore = nullptr;
+    FUSILLI_CHECK_ERROR(iree_hal_semaphore_create(
+        device, IREE_HAL_QUEUE_AFFINITY_ANY, /*initial_value=*/0,
+        /*flags=*/IREE_HAL_SEMAPHORE_FLAG_NONE, &rawSemaphore));
+    IreeHalSemaphoreUniquePtrType semaphore(rawSemaphore);
+    uint64_t signalValue = 1;
+    iree_hal_semaphore_list_t signalList = {
+        .count = 1,
+        .semaphores = &rawSemaphore,
+        .payload_values = &signalValue,
+    };
+    uint8_t pattern = 0;
+    FUSILLI_CHECK_ERROR(iree_hal_device_queue_fill(
+        device, IREE_HAL_QUEUE_AFFINITY_ANY, iree_hal_semaphore_list_empty(),
+        signalList, buffer.get(), /*target_offset=*/0, /*length=*/byteLength,
+        &pattern, sizeof(pattern), /*flags=*/IREE_HAL_FILL_FLAG_NONE));
+    FUSILLI_CHECK_ERROR(iree_hal_semaphore_wait(semaphore.get(), signalValue,
+                                                iree_infinite_timeout(),
+                                                IREE_HAL_WAIT_FLAG_DEFAULT));
+  }
+
+  iree_hal_buffer_view_t *rawBufferView = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_view_create(
+      buffer.get(), bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, iree_allocator_system(),
+      &rawBufferView));
+
+  return ok(Buffer(IreeHalBufferViewUniquePtrType(rawBufferView)));
+}
+
 // Factory: Imports an existing buffer view and retains ownership.
 inline ErrorOr<Buffer>
 Buffer::import(iree_hal_buffer_view_t *externalBufferView) {
@@ -350,6 +851,71 @@ Buffer::import(iree_hal_buffer_view_t *externalBufferView) {
   return ok(Buffer(IreeHalBufferViewUniquePtrType(externalBufferView)));
 }
 
+// Factory: Imports an external allocation without copying, reusing the view
+// cached by the handle for the same pointer, type and shape.
+inline ErrorOr<Buffer>
+Buffer::importDevicePtr(const Handle &handle, void *ptr,
+                        const std::vector<iree_hal_dim_t> &bufferShape,
+                        DataType type) {
+  FUSILLI_RETURN_ERROR_IF(ptr == nullptr, ErrorCode::RuntimeFailure,
+                          "Buffer::importDevicePtr failed as ptr is NULL");
+  FUSILLI_RETURN_ERROR_IF(
+      !kDataTypeToIreeHalElementType.contains(type),
+      ErrorCode::RuntimeFailure,
+      "Buffer::importDevicePtr failed: unsupported element type");
+  iree_hal_element_type_t elementType = kDataTypeToIreeHalElementType.at(type);
+
+  Handle::ImportedBufferViews &cache = *handle.importedBufferViews_;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto key = std::make_tuple(reinterpret_cast<uintptr_t>(ptr), elementType,
+                             bufferShape);
+  auto it = cache.views.find(key);
+  if (it != cache.views.end())
+    return Buffer::import(it->second.get());
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Importing external allocation " << ptr);
+  iree_device_size_t byteLength = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+      bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+
+  // Backends of host devices import host allocations.
+  iree_hal_external_buffer_t externalBuffer = {};
+  externalBuffer.flags = IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE;
+  externalBuffer.size = byteLength;
+  if (handle.getBackend() == Backend::CPU) {
+    externalBuffer.type = IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION;
+    externalBuffer.handle.host_allocation.ptr = ptr;
+  } else {
+    externalBuffer.type = IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION;
+    externalBuffer.handle.device_allocation.ptr =
+        reinterpret_cast<uint64_t>(ptr);
+  }
+  iree_hal_buffer_t *rawBuffer = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_allocator_import_buffer(
+      iree_hal_device_allocator(handle.getDevice()),
+      (iree_hal_buffer_params_t){
+          .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
+          .access = IREE_HAL_MEMORY_ACCESS_ALL,
+          .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
+      },
+      &externalBuffer, iree_hal_buffer_release_callback_null(), &rawBuffer));
+  IreeHalBufferUniquePtrType buffer(rawBuffer);
+
+  iree_hal_buffer_view_t *rawBufferView = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_view_create(
+      buffer.get(), bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, iree_allocator_system(),
+      &rawBufferView));
+  IreeHalBufferViewUniquePtrType bufferView(rawBufferView);
+
+  if (cache.views.size() >= Handle::ImportedBufferViews::kMaxSize)
+    cache.views.clear();
+  Buffer imported = FUSILLI_TRY(Buffer::import(bufferView.get()));
+  cache.views.emplace(std::move(key), std::move(bufferView));
+  return ok(std::move(imported));
+}
+
 // Reads device buffer by initiating a device-to-host transfer and
 // populating `outData`.
 template <typename T>
@@ -374,6 +940,110 @@ inline ErrorObject Buffer::read(const Handle &handle, std::vector<T> &outData) {
   return ok();
 }
 
+// Reads device buffer by initiating a device-to-host transfer into `outData`.
+template <typename T>
+inline ErrorObject Buffer::read(const Handle &handle, std::span<T> outData) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Reading device buffer through D2H transfer");
+  FUSILLI_CHECK_ERROR(checkHostByteLength(outData.size_bytes()));
+  FUSILLI_CHECK_ERROR(iree_hal_device_transfer_d2h(
+      handle.getDevice(), iree_hal_buffer_view_buffer(getBufferView()), 0,
+      outData.data(), outData.size_bytes(),
+      IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT, iree_infinite_timeout()));
+  return ok();
+}
+
+// Writes device buffer in place by initiating a host-to-device transfer from
+// `data`.
+template <typename T>
+inline ErrorObject Buffer::write(const Handle &handle,
+                                 std::span<const T> data) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Writing device buffer through H2D transfer");
+  FUSILLI_CHECK_ERROR(checkHostByteLength(data.size_bytes()));
+  FUSILLI_CHECK_ERROR(iree_hal_device_transfer_h2d(
+      handle.getDevice(), data.data(),
+      iree_hal_buffer_view_buffer(getBufferView()), 0, data.size_bytes(),
+      IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT, iree_infinite_timeout()));
+  return ok();
+}
+
+template <typename T>
+inline ErrorOr<IreeHalFenceUniquePtrType>
+Buffer::readAsync(const Handle &handle, std::span<T> outData,
+                  iree_hal_fence_t *waitFence) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Enqueuing D2H transfer of device buffer");
+  return enqueueHostTransfer(handle, outData.data(), outData.size_bytes(),
+                             /*toDevice=*/false, waitFence);
+}
+
+template <typename T>
+inline ErrorOr<IreeHalFenceUniquePtrType>
+Buffer::writeAsync(const Handle &handle, std::span<const T> data,
+                   iree_hal_fence_t *waitFence) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Enqueuing H2D transfer of device buffer");
+  // Imported host buffers are not written to by transfers to the device.
+  return enqueueHostTransfer(handle, const_cast<T *>(data.data()),
+                             data.size_bytes(), /*toDevice=*/true, waitFence);
+}
+
+// Imports `hostData` as a HAL buffer and enqueues a copy between it and the
+// buffer, signaling a new semaphore once complete. The queue operation retains
+// both buffers until then.
+inline ErrorOr<IreeHalFenceUniquePtrType>
+Buffer::enqueueHostTransfer(const Handle &handle, void *hostData,
+                            size_t byteLength, bool toDevice,
+                            iree_hal_fence_t *waitFence) {
+  FUSILLI_CHECK_ERROR(checkHostByteLength(byteLength));
+  iree_hal_device_t *device = handle.getDevice();
+
+  iree_hal_external_buffer_t externalBuffer = {};
+  externalBuffer.type = IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION;
+  externalBuffer.flags = IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE;
+  externalBuffer.size = byteLength;
+  externalBuffer.handle.host_allocation.ptr = hostData;
+  iree_hal_buffer_t *rawHostBuffer = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_allocator_import_buffer(
+      iree_hal_device_allocator(device),
+      (iree_hal_buffer_params_t){
+          .usage = IREE_HAL_BUFFER_USAGE_TRANSFER,
+          .access = IREE_HAL_MEMORY_ACCESS_ALL,
+          .type = IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
+                  IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+      },
+      &externalBuffer, iree_hal_buffer_release_callback_null(),
+      &rawHostBuffer));
+  IreeHalBufferUniquePtrType hostBuffer(rawHostBuffer);
+
+  iree_hal_semaphore_t *rawSemaphore = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_semaphore_create(
+      device, IREE_HAL_QUEUE_AFFINITY_ANY, /*initial_value=*/0,
+      /*flags=*/IREE_HAL_SEMAPHORE_FLAG_NONE, &rawSemaphore));
+  IreeHalSemaphoreUniquePtrType semaphore(rawSemaphore);
+  uint64_t signalValue = 1;
+  iree_hal_semaphore_list_t signalList = {
+      .count = 1,
+      .semaphores = &rawSemaphore,
+      .payload_values = &signalValue,
+  };
+  iree_hal_semaphore_list_t waitList =
+      waitFence ? iree_hal_fence_semaphore_list(waitFence)
+                : iree_hal_semaphore_list_empty();
+
+  iree_hal_buffer_t *deviceBuffer =
+      iree_hal_buffer_view_buffer(getBufferView());
+  FUSILLI_CHECK_ERROR(iree_hal_device_queue_copy(
+      device, IREE_HAL_QUEUE_AFFINITY_ANY, waitList, signalList,
+      /*source_buffer=*/toDevice ? hostBuffer.get() : deviceBuffer,
+      /*source_offset=*/0,
+      /*target_buffer=*/toDevice ? deviceBuffer : hostBuffer.get(),
+      /*target_offset=*/0, /*length=*/byteLength,
+      /*flags=*/IREE_HAL_COPY_FLAG_NONE));
+
+  iree_hal_fence_t *fence = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_fence_create_at(
+      semaphore.get(), signalValue, iree_allocator_system(), &fence));
+  return ok(IreeHalFenceUniquePtrType(fence));
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_BACKEND_RUNTIME_H
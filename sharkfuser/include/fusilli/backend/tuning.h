@@ -0,0 +1,218 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the `TuningConfig` of graph compilations, overriding the
+// compiler flags of a backend (`kBackendFlags`) for a graph, and the
+// `TuningRegistry` of the tuning configs of graphs by fingerprint, loaded
+// from tuning databases (as recorded by `autotune`).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_TUNING_H
+#define FUSILLI_BACKEND_TUNING_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/support/extras.h"
+#include "fusilli/support/logging.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Compiler flags appended to the backend flags when compiling a graph (so
+// overriding them), and a transform dialect tuning spec, as produced by
+// sharktuner, selecting the codegen configuration of its dispatches:
+//
+//  graph.setTuningConfig(TuningConfig{
+//      .flags = {"--iree-opt-level=O2"},
+//      .tuningSpecPath = "conv_tuning_spec.mlir",
+//  });
+//
+// Configs are part of the cache key of the compiled artifacts (the tuning
+// spec by its contents), so that graphs compiled with distinct configs do not
+// share them.
+struct TuningConfig {
+  static constexpr std::string_view kTuningSpecFlag =
+      "--iree-codegen-tuning-spec-path=";
+
+  std::vector<std::string> flags;
+  std::filesystem::path tuningSpecPath;
+
+  bool empty() const { return flags.empty() && tuningSpecPath.empty(); }
+
+  bool operator==(const TuningConfig &) const = default;
+
+  // Flags passed to the compiler, after the backend flags.
+  std::vector<std::string> getCompileFlags() const {
+    std::vector<std::string> compileFlags = flags;
+    if (!tuningSpecPath.empty())
+      compileFlags.push_back(std::string(kTuningSpecFlag) +
+                             tuningSpecPath.string());
+    return compileFlags;
+  }
+
+  // `fnv1aHash` of the flags and tuning spec contents, continuing from
+  // `hash`. Empty configs leave `hash` unchanged, so that untuned graphs keep
+  // their cache keys.
+  ErrorOr<uint64_t> hash(uint64_t hash) const {
+    for (const auto &flag : flags)
+      hash = fnv1aHash(flag + '\0', hash);
+    if (!tuningSpecPath.empty()) {
+      std::ifstream spec(tuningSpecPath, std::ios::binary);
+      FUSILLI_RETURN_ERROR_IF(!spec.is_open(), ErrorCode::FileSystemFailure,
+                              "Failed to open tuning spec: " +
+                                  tuningSpecPath.string());
+      std::string contents((std::istreambuf_iterator<char>(spec)),
+                           std::istreambuf_iterator<char>());
+      hash = fnv1aHash(contents + '\0', hash);
+    }
+    return ok(hash);
+  }
+
+  // Parses a config from its flags separated by whitespace (as printed by
+  // `operator<<`), the tuning spec given by its compiler flag.
+  static TuningConfig parse(std::string_view text) {
+    TuningConfig config;
+    std::istringstream iss{std::string(text)};
+    std::string flag;
+    while (iss >> flag) {
+      if (flag.starts_with(kTuningSpecFlag))
+        config.tuningSpecPath = flag.substr(kTuningSpecFlag.size());
+      else
+        config.flags.push_back(std::move(flag));
+    }
+    return config;
+  }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const TuningConfig &config) {
+  std::vector<std::string> flags = config.getCompileFlags();
+  interleave(
+      flags.begin(), flags.end(),
+      // each_fn:
+      [&](const std::string &flag) { os << flag; },
+      // between_fn:
+      [&] { os << " "; });
+  return os;
+}
+
+// The tuning configs of graphs in the process, by backend and fingerprint
+// (see `Graph::getFingerprint`). Graphs without a config of their own (see
+// `Graph::setTuningConfig`) compile with the config registered for their
+// fingerprint, if any:
+//
+//  // Record the fastest config of a graph (e.g. offline):
+//  FUSILLI_TRY(autotune(handle, graph, candidates, variantPack));
+//  FUSILLI_CHECK_ERROR(TuningRegistry::save("tuning.db"));
+//
+//  // At startup:
+//  FUSILLI_CHECK_ERROR(TuningRegistry::load("tuning.db"));
+//
+// Tuning databases have a config per line: the backend, the fingerprint in
+// hex, and the config (see `TuningConfig::parse`). Like compiled bundles,
+// they must be produced with the same version of Fusilli, as fingerprints
+// may change across versions.
+class TuningRegistry {
+public:
+  static void add(Backend backend, uint64_t fingerprint,
+                  const TuningConfig &config) {
+    Configs &configs = getConfigs();
+    std::lock_guard<std::mutex> lock(configs.mutex);
+    configs.configs[{backend, fingerprint}] = config;
+  }
+
+  static std::optional<TuningConfig> find(Backend backend,
+                                          uint64_t fingerprint) {
+    Configs &configs = getConfigs();
+    std::lock_guard<std::mutex> lock(configs.mutex);
+    auto it = configs.configs.find({backend, fingerprint});
+    if (it == configs.configs.end())
+      return std::nullopt;
+    return it->second;
+  }
+
+  static void clear() {
+    Configs &configs = getConfigs();
+    std::lock_guard<std::mutex> lock(configs.mutex);
+    configs.configs.clear();
+  }
+
+  // Writes the registered configs to the tuning database at `path`.
+  static ErrorObject save(const std::filesystem::path &path) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Saving tuning database " << path);
+    std::ofstream file(path);
+    FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                            "Failed to open file: " + path.string());
+    Configs &configs = getConfigs();
+    std::lock_guard<std::mutex> lock(configs.mutex);
+    for (const auto &[key, config] : configs.configs)
+      file << key.first << " " << std::hex << key.second << std::dec << " "
+           << config << "\n";
+    FUSILLI_RETURN_ERROR_IF(!file.good(), ErrorCode::FileSystemFailure,
+                            "Failed to write to file: " + path.string());
+    return ok();
+  }
+
+  // Registers the configs of the tuning database at `path`, replacing those
+  // registered for the same graphs. Returns the number of configs loaded.
+  static ErrorOr<size_t> load(const std::filesystem::path &path) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Loading tuning database " << path);
+    std::ifstream file(path);
+    FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                            "Failed to open file: " + path.string());
+    size_t numConfigs = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+      std::istringstream iss(line);
+      std::string backendName;
+      uint64_t fingerprint = 0;
+      if (!(iss >> backendName))
+        continue; // Empty line.
+      iss >> std::hex >> fingerprint;
+      std::optional<Backend> backend;
+      for (const auto &[b, name] : kBackendToStr)
+        if (name == backendName)
+          backend = b;
+      FUSILLI_RETURN_ERROR_IF(iss.fail() || !backend.has_value(),
+                              ErrorCode::InvalidArgument,
+                              "Invalid tuning database line: " + line);
+      std::string config((std::istreambuf_iterator<char>(iss)),
+                         std::istreambuf_iterator<char>());
+      add(*backend, fingerprint, TuningConfig::parse(config));
+      ++numConfigs;
+    }
+    return ok(numConfigs);
+  }
+
+private:
+  struct Configs {
+    std::mutex mutex;
+    std::map<std::pair<Backend, uint64_t>, TuningConfig> configs;
+  };
+  static Configs &getConfigs() {
+    static Configs configs;
+    return configs;
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_TUNING_H
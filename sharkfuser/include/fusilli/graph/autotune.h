@@ -0,0 +1,113 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains `autotune`, selecting the fastest of candidate tuning
+// configs (see `TuningConfig`) of a graph by compiling and benchmarking it
+// with each.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_AUTOTUNE_H
+#define FUSILLI_GRAPH_AUTOTUNE_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/backend/runtime.h"
+#include "fusilli/backend/tuning.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace fusilli {
+
+// Compiles the validated `graph` with each of the `candidates` and times
+// `iterations` executions of it with `variantPack` (after a warm-up one),
+// returning the index of the fastest candidate. The graph is left compiled
+// with the fastest, which is set as its tuning config and registered for its
+// fingerprint (see `TuningRegistry`), to be saved to a tuning database.
+//
+// Candidates failing to compile or execute (e.g. with flags or tuning specs
+// not applying to the graph) are skipped. Set `remove = true` to remove the
+// compiled artifacts of the candidates, as in `Graph::compile`.
+inline ErrorOr<size_t>
+autotune(const Handle &handle, Graph &graph,
+         const std::vector<TuningConfig> &candidates,
+         const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                  std::shared_ptr<Buffer>> &variantPack,
+         size_t iterations = 10, bool remove = false) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Autotuning Graph over " << candidates.size()
+                                                        << " candidates");
+  FUSILLI_RETURN_ERROR_IF(candidates.empty() || iterations == 0 ||
+                              variantPack.empty(),
+                          ErrorCode::InvalidArgument,
+                          "Autotuning requires candidates, iterations and a "
+                          "variant pack");
+  uint64_t fingerprint = FUSILLI_TRY(graph.getFingerprint());
+
+  // Executions are asynchronous on some backends: reading a buffer waits for
+  // them to complete, as reads are stream ordered.
+  auto synchronize = [&]() -> ErrorObject {
+    if (!kBackendExecuteAsync.at(handle.getBackend()))
+      return ok();
+    std::vector<uint8_t> data;
+    return variantPack.begin()->second->read(handle, data);
+  };
+  auto benchmark = [&](const TuningConfig &config) -> ErrorOr<double> {
+    graph.setTuningConfig(config);
+    FUSILLI_CHECK_ERROR(graph.compile(handle, remove));
+    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack));
+    FUSILLI_CHECK_ERROR(synchronize());
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+      FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack));
+    FUSILLI_CHECK_ERROR(synchronize());
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return ok(elapsed.count() / iterations);
+  };
+
+  std::optional<size_t> best;
+  double bestTime = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    ErrorOr<double> time = benchmark(candidates[i]);
+    if (isError(time)) {
+      FUSILLI_LOG_LABEL_ENDL("INFO: Skipping candidate " << i << " ("
+                                                         << candidates[i]
+                                                         << "): "
+                                                         << ErrorObject(time));
+      continue;
+    }
+    FUSILLI_LOG_LABEL_ENDL("INFO: Candidate " << i << " (" << candidates[i]
+                                              << "): " << *time << " us");
+    if (*time < bestTime) {
+      best = i;
+      bestTime = *time;
+    }
+  }
+  FUSILLI_RETURN_ERROR_IF(!best.has_value(), ErrorCode::CompileFailure,
+                          "No autotuning candidate compiled and executed");
+
+  // Compiling the fastest again reuses its cached artifacts, unless removed.
+  graph.setTuningConfig(candidates[*best]);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, remove));
+  TuningRegistry::add(handle.getBackend(), fingerprint, candidates[*best]);
+  return ok(*best);
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_AUTOTUNE_H
@@ -0,0 +1,221 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the `CompiledBundle` class, packaging the compiled
+// artifacts of graphs known ahead of time in a single file, to be loaded at
+// startup so that these graphs are never compiled.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_BUNDLE_H
+#define FUSILLI_GRAPH_BUNDLE_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/cache.h"
+#include "fusilli/support/logging.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// A bundle of compiled artifacts, indexed by the backend and fingerprint of
+// the graphs they were compiled from (see `Graph::getFingerprint`):
+//
+//  // Ahead of time, compile the known graphs and package them:
+//  CompiledBundle bundle;
+//  for (Graph &graph : graphs) {
+//    FUSILLI_CHECK_ERROR(graph.compile(handle));
+//    FUSILLI_CHECK_ERROR(bundle.add(handle, graph));
+//  }
+//  FUSILLI_CHECK_ERROR(bundle.write("graphs.bundle"));
+//
+//  // At startup:
+//  FUSILLI_CHECK_ERROR(CompiledBundle::load("graphs.bundle"));
+//
+// Loading installs the artifacts in the cache (see `CacheFile`), and maps
+// fingerprints to them, so that compiling graphs of the bundle reuses them
+// without emitting MLIR assembly or running the compiler. The bundle must be
+// produced with the same version of Fusilli: graphs whose fingerprint is not
+// in the bundle are compiled as usual. Graphs bundled for a device target
+// (see `Handle::getTarget`) or with a tuning config (see `TuningConfig`) are
+// only found with the same target and config.
+class CompiledBundle {
+public:
+  // Adds the artifacts of `graph`, compiled for `handle`.
+  ErrorObject add(const Handle &handle, const Graph &graph) {
+    FUSILLI_RETURN_ERROR_IF(!graph.cache_.has_value(), ErrorCode::NotCompiled,
+                            "Graph must be compiled before being bundled");
+    const CachedAssets &cache = *graph.cache_;
+    Entry entry;
+    entry.backend = handle.getBackend();
+    entry.fingerprint = FUSILLI_TRY(graph.getCompileFingerprint(handle));
+    entry.cacheKey = FUSILLI_TRY(readFile(cache.key.path));
+    entry.input = FUSILLI_TRY(readFile(cache.input.path));
+    entry.output = FUSILLI_TRY(readFile(cache.output.path));
+    entry.command = FUSILLI_TRY(readFile(cache.command.path));
+    entry.statistics = FUSILLI_TRY(readFile(cache.statistics.path));
+    entries_.push_back(std::move(entry));
+    return ok();
+  }
+
+  size_t size() const { return entries_.size(); }
+
+  // Writes the bundle to `path`.
+  ErrorObject write(const std::filesystem::path &path) const {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Writing compiled bundle " << path);
+    std::ofstream file(path, std::ios::binary);
+    FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                            "Failed to open file: " + path.string());
+
+    file.write(kMagic.data(), kMagic.size());
+    writeValue(file, kVersion);
+    writeValue(file, static_cast<uint64_t>(entries_.size()));
+    for (const Entry &entry : entries_) {
+      writeValue(file, entry.backend);
+      writeValue(file, entry.fingerprint);
+      for (const std::string *field : entry.fields())
+        writeString(file, *field);
+    }
+    FUSILLI_RETURN_ERROR_IF(!file.good(), ErrorCode::FileSystemFailure,
+                            "Failed to write to file: " + path.string());
+    return ok();
+  }
+
+  // Loads the bundle at `path`, installing its artifacts in the cache (unless
+  // already there). Returns the number of graphs in the bundle.
+  static ErrorOr<size_t> load(const std::filesystem::path &path) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Loading compiled bundle " << path);
+    std::ifstream file(path, std::ios::binary);
+    FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                            "Failed to open file: " + path.string());
+
+    std::string magic(kMagic.size(), '\0');
+    file.read(magic.data(), magic.size());
+    uint32_t version = 0;
+    readValue(file, version);
+    FUSILLI_RETURN_ERROR_IF(!file.good() || magic != kMagic ||
+                                version != kVersion,
+                            ErrorCode::InvalidArgument,
+                            "Not a compiled bundle (or of another version): " +
+                                path.string());
+
+    // Sizes read from the bundle are bounded by its size, so that corrupted
+    // bundles fail to load rather than allocate arbitrary sizes.
+    std::error_code ec;
+    uintmax_t fileSize = std::filesystem::file_size(path, ec);
+    uint64_t numEntries = 0;
+    readValue(file, numEntries);
+    for (uint64_t i = 0; i < numEntries; ++i) {
+      Entry entry;
+      readValue(file, entry.backend);
+      readValue(file, entry.fingerprint);
+      for (std::string *field : entry.fields())
+        readString(file, *field, fileSize);
+      FUSILLI_RETURN_ERROR_IF(!file.good() ||
+                                  !kBackendToStr.contains(entry.backend),
+                              ErrorCode::InvalidArgument,
+                              "Corrupted compiled bundle: " + path.string());
+      FUSILLI_CHECK_ERROR(install(entry));
+    }
+    return ok(static_cast<size_t>(numEntries));
+  }
+
+private:
+  static constexpr std::string_view kMagic = "FUSILLI-BUNDLE";
+  static constexpr uint32_t kVersion = 1;
+
+  struct Entry {
+    Backend backend;
+    uint64_t fingerprint = 0;
+    std::string cacheKey;
+    std::string input;
+    std::string output;
+    std::string command;
+    std::string statistics;
+
+    // Contents serialized after the backend and fingerprint, in order.
+    std::vector<std::string *> fields() {
+      return {&cacheKey, &input, &output, &command, &statistics};
+    }
+    std::vector<const std::string *> fields() const {
+      return {&cacheKey, &input, &output, &command, &statistics};
+    }
+  };
+
+  // Writes the artifacts of `entry` to the cache, the key last (marking them
+  // complete), and maps its fingerprint to them.
+  static ErrorObject install(const Entry &entry) {
+    std::lock_guard<std::mutex> lock(Graph::getCacheKeyMutex(entry.cacheKey));
+    ErrorOr<CacheFile> key = CacheFile::open(
+        /*graphName=*/entry.cacheKey, /*fileName=*/IREE_COMPILE_KEY_FILENAME);
+    if (isError(key) || FUSILLI_TRY(key->read()) != entry.cacheKey) {
+      for (const auto &[fileName, contents] :
+           {std::pair{IREE_COMPILE_INPUT_FILENAME, &entry.input},
+            std::pair{IREE_COMPILE_OUTPUT_FILENAME, &entry.output},
+            std::pair{IREE_COMPILE_COMMAND_FILENAME, &entry.command},
+            std::pair{IREE_COMPILE_STATISTICS_FILENAME, &entry.statistics},
+            std::pair{IREE_COMPILE_KEY_FILENAME, &entry.cacheKey}}) {
+        CacheFile file = FUSILLI_TRY(CacheFile::create(
+            /*graphName=*/entry.cacheKey, /*fileName=*/fileName,
+            /*remove=*/false));
+        FUSILLI_CHECK_ERROR(file.write(*contents));
+      }
+    }
+    Graph::addFingerprintCacheKey(entry.backend, entry.fingerprint,
+                                  entry.cacheKey);
+    return ok();
+  }
+
+  static ErrorOr<std::string> readFile(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                            "Failed to open file: " + path.string());
+    std::string contents((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+    return ok(std::move(contents));
+  }
+
+  template <typename T> static void writeValue(std::ostream &os, T value) {
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  template <typename T> static void readValue(std::istream &is, T &value) {
+    is.read(reinterpret_cast<char *>(&value), sizeof(T));
+  }
+  static void writeString(std::ostream &os, const std::string &value) {
+    writeValue(os, static_cast<uint64_t>(value.size()));
+    os.write(value.data(), value.size());
+  }
+  static void readString(std::istream &is, std::string &value,
+                         uintmax_t maxSize) {
+    uint64_t size = 0;
+    readValue(is, size);
+    if (size > maxSize)
+      is.setstate(std::ios::failbit);
+    if (!is.good())
+      return;
+    value.resize(size);
+    is.read(value.data(), size);
+  }
+
+  std::vector<Entry> entries_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_BUNDLE_H
@@ -0,0 +1,109 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the `ExecutionPlan` class, executing a sequence of
+// compiled graphs with bindings set up once, to reduce the host overhead of
+// graphs executed back-to-back (e.g. a conv, then a bias and activation, then
+// another conv).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_EXECUTION_PLAN_H
+#define FUSILLI_GRAPH_EXECUTION_PLAN_H
+
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/backend/runtime.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// A sequence of compiled graphs and their bindings, executed in order by
+// `execute`:
+//
+//  ExecutionPlan plan;
+//  FUSILLI_CHECK_ERROR(plan.add(conv, {{xT, xBuf}, {wT, wBuf}, {yT, yBuf}}));
+//  FUSILLI_CHECK_ERROR(plan.add(biasRelu, {{yInT, yBuf}, {outT, outBuf}}));
+//  for (size_t i = 0; i < numSteps; ++i)
+//    FUSILLI_CHECK_ERROR(plan.execute(handle));
+//
+// Variant packs are looked up and checked against the binding plans of the
+// graphs (see `Graph::getBindingPlan`) once, by `add`, so that executions
+// only push the buffers of each graph and invoke it. On asynchronous
+// backends, graphs are executed in order on the stream of the handle, the
+// outputs of a graph being visible to the next without synchronization.
+//
+// Graphs must outlive the plan and not be validated again while in it (which
+// may change their binding plans). The plan holds references to the buffers
+// of its steps.
+class ExecutionPlan {
+public:
+  // Appends `graph`, executed with `variantPack` (see `Graph::execute`).
+  ErrorObject
+  add(const Graph &graph,
+      const std::unordered_map<std::shared_ptr<TensorAttr>,
+                               std::shared_ptr<Buffer>> &variantPack) {
+    FUSILLI_RETURN_ERROR_IF(graph.executeCall_ == nullptr,
+                            ErrorCode::NotCompiled,
+                            "Graph must be compiled before being added to an "
+                            "execution plan");
+    Step step{.graph = &graph};
+    step.views = FUSILLI_TRY(graph.getBindings(variantPack));
+    FUSILLI_CHECK_ERROR(graph.checkBuffers(step.views));
+    for (const auto &tensor : graph.bindingPlan_)
+      step.buffers.push_back(variantPack.at(tensor));
+    steps_.push_back(std::move(step));
+    return ok();
+  }
+
+  // Executes the graphs of the plan in order, stopping at the first failing
+  // one.
+  ErrorObject execute(const Handle &handle) const {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Executing plan of " << steps_.size()
+                                                      << " graphs");
+    for (size_t i = 0; i < steps_.size(); ++i) {
+      const Step &step = steps_[i];
+      FUSILLI_RETURN_ERROR_IF(step.graph->executeCall_ == nullptr,
+                              ErrorCode::NotCompiled,
+                              "Graph " + std::to_string(i) +
+                                  " of the execution plan is not compiled");
+      auto *executeCall = FUSILLI_TRY(step.graph->getExecuteCall(handle));
+      FUSILLI_CHECK_ERROR(
+          step.graph->invokeExecuteCall(*executeCall, step.views));
+    }
+    return ok();
+  }
+
+  size_t size() const { return steps_.size(); }
+
+  bool empty() const { return steps_.empty(); }
+
+  void clear() { steps_.clear(); }
+
+private:
+  struct Step {
+    const Graph *graph;
+    // Buffers in the order of the binding plan of the graph, and the views
+    // they wrap, as pushed to its call.
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    std::vector<iree_hal_buffer_view_t *> views;
+  };
+  std::vector<Step> steps_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_EXECUTION_PLAN_H
@@ -15,28 +15,55 @@
 #define FUSILLI_GRAPH_GRAPH_H
 
 #include "fusilli/attributes/conv_attributes.h"
+#include "fusilli/attributes/matmul_attributes.h"
+#include "fusilli/attributes/normalization_attributes.h"
 #include "fusilli/attributes/pointwise_attributes.h"
+#include "fusilli/attributes/reduction_attributes.h"
+#include "fusilli/attributes/sdpa_attributes.h"
 #include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/attributes/types.h"
 #include "fusilli/backend/backend.h"
 #include "fusilli/backend/buffer.h"
+#include "fusilli/backend/compiler.h"
 #include "fusilli/backend/handle.h"
+#include "fusilli/backend/tuning.h"
 #include "fusilli/graph/context.h"
 #include "fusilli/node/conv_node.h"
+#include "fusilli/node/matmul_node.h"
 #include "fusilli/node/node.h"
+#include "fusilli/node/normalization_node.h"
 #include "fusilli/node/pointwise_node.h"
+#include "fusilli/node/reduction_node.h"
+#include "fusilli/node/sdpa_node.h"
 #include "fusilli/support/cache.h"
 #include "fusilli/support/external_tools.h"
 #include "fusilli/support/extras.h"
 #include "fusilli/support/logging.h"
-
+#include "fusilli/support/thread_pool.h"
+#include "fusilli/support/tracing.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <ostream>
 #include <set>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -46,15 +73,126 @@
 #define IREE_COMPILE_OUTPUT_FILENAME "iree-compile-output.vmfb"
 #define IREE_COMPILE_COMMAND_FILENAME "iree-compile-command.txt"
 #define IREE_COMPILE_STATISTICS_FILENAME "iree-compile-statistics.json"
+#define IREE_COMPILE_KEY_FILENAME "iree-compile-key.txt"
 
 namespace fusilli {
 
+class CompiledBundle;
+
+// Returns the thread pool shared by asynchronous graph compilations. Its size
+// is set with the `FUSILLI_COMPILE_THREADS` environment variable, and
+// defaults to the number of hardware threads.
+inline ThreadPool &getCompilePool() {
+  static ThreadPool pool([]() -> size_t {
+    if (const char *numThreads = std::getenv("FUSILLI_COMPILE_THREADS"))
+      return std::strtoul(numThreads, nullptr, 10);
+    return std::thread::hardware_concurrency();
+  }());
+  return pool;
+}
+
+// Wall times (in microseconds) of the phases of a `Graph::compile`, as
+// reported by `Graph::getCompileStats`. Phases it skipped take no time: the
+// emission of the assembly when the graph was compiled before in the process,
+// and `iree-compile` on cache hits.
+struct CompileStats {
+  double emitAsmUs = 0.0;
+  double validateCacheUs = 0.0;
+  double ireeCompileUs = 0.0;
+  double sessionUs = 0.0;
+  // Whether the compiled artifacts were reused from the cache.
+  bool cacheHit = false;
+
+  double getTotalUs() const {
+    return emitAsmUs + validateCacheUs + ireeCompileUs + sessionUs;
+  }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const CompileStats &stats) {
+  return os << (stats.cacheHit ? "cache hit" : "cache miss")
+            << ": emitAsm " << stats.emitAsmUs << " us, cache validation "
+            << stats.validateCacheUs << " us, iree-compile "
+            << stats.ireeCompileUs << " us, session creation "
+            << stats.sessionUs << " us, total " << stats.getTotalUs()
+            << " us";
+}
+
+// Statistics of the scheduling of a compiled graph, parsed from the JSON
+// dumped by `iree-compile` into the cache (see `buildCompileFlags`), as
+// reported by `Graph::getCompileStatistics`. A graph executes as
+// `dispatchCount` kernels (of `executableCount` executables) in
+// `submissionCount` submissions, so that callers can reject or rank the
+// engines lowering to many dispatches.
+struct CompileStatistics {
+  int64_t dispatchCount = 0;
+  int64_t executableCount = 0;
+  int64_t submissionCount = 0;
+  // Size (in bytes) of the transient memory of an execution, allocated from
+  // the workspace pool of the handle.
+  int64_t transientMemorySize = 0;
+  // Size (in bytes) of the constants embedded in the compiled artifact.
+  int64_t constantSize = 0;
+};
+
+// Returns the integer value of the first `"key": <value>` of `json`, which is
+// that of the aggregate statistics of the program in the JSON of
+// `--iree-scheduling-dump-statistics-format=json` (before those of
+// functions), or nullopt if missing.
+inline std::optional<int64_t> findJsonInteger(std::string_view json,
+                                              std::string_view key) {
+  std::string quotedKey = "\"" + std::string(key) + "\"";
+  size_t pos = json.find(quotedKey);
+  if (pos == std::string_view::npos)
+    return std::nullopt;
+  pos = json.find_first_not_of(" \t\n:", pos + quotedKey.size());
+  if (pos == std::string_view::npos)
+    return std::nullopt;
+  int64_t value = 0;
+  std::from_chars_result result =
+      std::from_chars(json.data() + pos, json.data() + json.size(), value);
+  if (result.ec != std::errc())
+    return std::nullopt;
+  return value;
+}
+
+// Parses the scheduling statistics dumped by `iree-compile`. They must have
+// a dispatch count, and the other statistics (which vary with the compiler
+// version) default to 0.
+inline ErrorOr<CompileStatistics>
+parseCompileStatistics(std::string_view json) {
+  std::optional<int64_t> dispatchCount =
+      findJsonInteger(json, "dispatch-count");
+  FUSILLI_RETURN_ERROR_IF(!dispatchCount.has_value(),
+                          ErrorCode::CompileFailure,
+                          "Compile statistics have no dispatch count");
+  CompileStatistics statistics;
+  statistics.dispatchCount = *dispatchCount;
+  statistics.executableCount =
+      findJsonInteger(json, "executable-count").value_or(0);
+  statistics.submissionCount =
+      findJsonInteger(json, "submission-count").value_or(0);
+  statistics.transientMemorySize =
+      findJsonInteger(json, "transient-memory-size").value_or(0);
+  statistics.constantSize = findJsonInteger(json, "constant-size").value_or(0);
+  return ok(statistics);
+}
+
+inline std::ostream &operator<<(std::ostream &os,
+                                const CompileStatistics &statistics) {
+  return os << statistics.dispatchCount << " dispatches, "
+            << statistics.executableCount << " executables, "
+            << statistics.submissionCount << " submissions, "
+            << statistics.transientMemorySize << " transient bytes, "
+            << statistics.constantSize << " constant bytes";
+}
+
 class Graph : public INode {
 public:
   Graph() : INode(Context{}) {}
 
   // Validates the graph for correctness and infers missing properties.
   ErrorObject validate() {
+    FUSILLI_TRACE_SCOPE("Graph::validate");
     FUSILLI_LOG_LABEL_ENDL("INFO: Validating Graph");
     FUSILLI_RETURN_ERROR_IF(getName().empty(), ErrorCode::AttributeNotSet,
                             "Graph name not set");
@@ -62,53 +200,122 @@ public:
     // This infers missing tensor properties such as dims,
     // stride, dtype based on context.
     FUSILLI_CHECK_ERROR(validateSubtree());
-    // Validate inputs:
-    // This has to happen after `validateSubtree` to infer any
-    // missing properties on inputs first.
-    for (const auto &input : fullGraphInputs_) {
-      FUSILLI_CHECK_ERROR(input->validate());
-    }
-    // Validate outputs:
-    // This has to happen after `validateSubtree` to infer any
-    // missing properties on outputs first.
-    for (const auto &output : fullGraphOutputs_) {
-      FUSILLI_CHECK_ERROR(output->validate());
-    }
-    FUSILLI_LOG_LABEL_ENDL("INFO: Graph validation completed successfully");
-    isValidated_ = true;
-    return ok();
+    return validateInputsAndOutputs();
   }
 
+  // Returns a copy of the validated graph with the dims of the tensors named
+  // in `dims` changed (e.g. to the batch size of a request), validated for
+  // them. Rather than adding its tensors and nodes again, the copy reuses the
+  // node structure of the graph and only re-infers shapes: the tensors in
+  // `dims` keep their rank, layout (stride order) and dynamic dims, and the
+  // other node outputs are inferred as if their dims and strides were not
+  // set. Node outputs whose dims are not inferred (e.g. of `convWGrad`) have
+  // to be in `dims`.
+  //
+  // The copy has its own tensors, bound in the same order (see
+  // `getBindingPlan`), and is compiled on its own, reusing the artifacts of
+  // graphs of its fingerprint. Layouts chosen by `optimize()` for
+  // intermediate tensors are re-inferred, so optimize the copy instead.
+  ErrorOr<Graph> cloneWithDims(
+      const std::unordered_map<std::string, std::vector<int64_t>> &dims) const;
+
+  // Runs graph-level passes on the validated graph, so that it emits smaller
+  // MLIR assembly: constant folding of pointwise nodes with scalar inputs,
+  // common subexpression elimination, cancellation of the permutes of
+  // intermediate tensors, and dead node elimination. They rewrite the nodes
+  // and intermediate tensors of the graph in place, leaving its inputs and
+  // outputs (and so its binding plan) unchanged. To be called after
+  // `validate()` and before `compile()`. Definition in
+  // `fusilli/graph/passes.h`.
+  ErrorObject optimize();
+
+  // Returns a JSON description of the graph: its name and data types, its
+  // tensors, and its nodes with their attributes, from which `deserialize`
+  // builds the same graph. Descriptions are deterministic, so that they can
+  // be hashed (e.g. as cache keys) or compared, and reproduce graphs outside
+  // of the program building them (e.g. by `fusilli_benchmark_driver graph`).
+  // The tuning config is not part of the description. Definition in
+  // `fusilli/graph/serialization.h`.
+  ErrorOr<std::string> serialize() const;
+
+  // Builds the graph of `description` (see `serialize`), to be validated
+  // like graphs built by the tensor and node methods. Definition in
+  // `fusilli/graph/serialization.h`.
+  static ErrorOr<Graph> deserialize(std::string_view description);
+
   // Compiles the graph using IREE compiler and sets up the IREE runtime
   // session context for future g->execute calls.
   //
   // Set `remove = true` to remove compilation artifacts (cache files) when
   // this `Graph` instance goes out of scope.
   ErrorObject compile(const Handle &handle, bool remove = false) {
+    FUSILLI_TRACE_SCOPE("Graph::compile");
     FUSILLI_LOG_LABEL_ENDL("INFO: Compiling Graph");
     FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
                             "Graph must be validated before being compiled");
+    compileStats_ = CompileStats{.cacheHit = true};
+
+    // Graphs with the fingerprint (and device target and tuning config) of a
+    // graph compiled before in the process for the backend reuse its cache
+    // key, so that its cached artifacts are reused without emitting MLIR
+    // assembly.
+    std::string vmfbPath;
+    uint64_t compileFingerprint = FUSILLI_TRY(getCompileFingerprint(handle));
+    std::optional<std::string> cacheKey =
+        findFingerprintCacheKey(handle.getBackend(), compileFingerprint);
+    if (cacheKey.has_value()) {
+      std::lock_guard<std::mutex> lock(getCacheKeyMutex(*cacheKey));
+      auto start = std::chrono::steady_clock::now();
+      bool isValid = FUSILLI_TRY(validateCache(*cacheKey, remove));
+      compileStats_.validateCacheUs += getElapsedUs(start);
+      if (isValid)
+        vmfbPath = cache_->output.path;
+    }
 
-    // Generate MLIR assembly for this graph.
-    std::string generatedAsm = FUSILLI_TRY(emitAsm());
-
-    // Compile using IREE compiler or reuse cached artifact.
-    std::string vmfbPath =
-        FUSILLI_TRY(getCompiledArtifact(handle, generatedAsm, remove));
+    if (vmfbPath.empty()) {
+      // Generate MLIR assembly for this graph.
+      auto start = std::chrono::steady_clock::now();
+      std::string generatedAsm = FUSILLI_TRY(emitAsm());
+      compileStats_.emitAsmUs = getElapsedUs(start);
+
+      // Compile using IREE compiler or reuse cached artifact.
+      vmfbPath =
+          FUSILLI_TRY(getCompiledArtifact(handle, generatedAsm, remove));
+      addFingerprintCacheKey(handle.getBackend(), compileFingerprint,
+                             FUSILLI_TRY(getCacheKey(handle, generatedAsm)));
+    }
 
     FUSILLI_LOG_LABEL_ENDL("INFO: Compiled Graph cached at \"" + vmfbPath +
                            "\"");
 
     // Create per-graph IREE runtime session and load the compiled artifact.
+    auto start = std::chrono::steady_clock::now();
     FUSILLI_CHECK_ERROR(createPerGraphSession(handle, vmfbPath));
+    compileStats_.sessionUs = getElapsedUs(start);
 
     return ok();
   }
 
+  // Runs `compile` on the compile pool (see `getCompilePool`), so that
+  // graphs compile concurrently. The graph and handle must outlive the
+  // returned future, and the graph must not be used until it is ready.
+  // Concurrently compiled graphs with the same cache key compile once, the
+  // others reusing the artifacts (see `getCompiledArtifact`).
+  std::future<ErrorObject> compileAsync(const Handle &handle,
+                                        bool remove = false) {
+    return getCompilePool().submit(
+        [this, &handle, remove] { return compile(handle, remove); });
+  }
+
   // Executes the graph using IREE runtime. Requires a `variantPack` which is a
   // map from `TensorAttr` to `Buffer` wrapping the `iree_hal_buffer_view_t *`.
   // Definition in `fusilli/backend/runtime.h`.
   //
+  // The handle may differ from the one the graph was compiled with, as long
+  // as it has the same backend and device target: e.g. handles on the other
+  // streams of the device. A session is created (once) per HAL device of the
+  // handles, from the compiled artifact, without compiling again.
+  //
   // Backend Specific Execution Behavior
   //   For some backends execution will be async. The specifics of how one
   //   should launch a kernel and synchronize work items vary per backend.
@@ -185,6 +392,49 @@ public:
           const std::unordered_map<std::shared_ptr<TensorAttr>,
                                    std::shared_ptr<Buffer>> &variantPack) const;
 
+  // Executes the graph with `buffers` bound by position to the tensors of
+  // `getBindingPlan()`, which avoids looking up a variant pack on every call.
+  // Buffers must outlive the execution, as with `variantPack`.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorObject execute(const Handle &handle,
+                      std::span<iree_hal_buffer_view_t *const> buffers) const;
+
+  // Executes the graph as the positional `execute`, ordered by fences rather
+  // than by the stream: the execution waits for `waitFence` (unless null),
+  // and the returned fence is signaled once it completes. This lets graphs
+  // executed on distinct streams of a device depend on each other, and the
+  // host poll for completion:
+  //
+  //   auto done = FUSILLI_TRY(producer.executeAsync(handle, producerBuffers));
+  //   auto consumerDone = FUSILLI_TRY(
+  //       consumer.executeAsync(otherHandle, consumerBuffers, done.get()));
+  //   // `iree_hal_fence_query` returns `IREE_STATUS_DEFERRED` until complete.
+  //   while (iree_status_is_deferred(iree_hal_fence_query(consumerDone.get())))
+  //     doSomethingElse();
+  //
+  // Fences are signaled on a timeline semaphore of the graph, created with
+  // the first call. Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<IreeHalFenceUniquePtrType>
+  executeAsync(const Handle &handle,
+               std::span<iree_hal_buffer_view_t *const> buffers,
+               iree_hal_fence_t *waitFence = nullptr) const;
+
+  // Returns the tensors bound to the buffers of the positional `execute`, in
+  // order: the outputs (excluding virtual ones) and then the inputs of the
+  // graph, each sorted by name. The plan is set by `validate()`, and meant to
+  // be used to order buffers once for repeated executions:
+  //
+  //   auto plan = FUSILLI_TRY(graph.getBindingPlan()); // {yT, wT, xT}
+  //   std::vector<iree_hal_buffer_view_t *> buffers = {*yBuf, *wBuf, *xBuf};
+  //   for (size_t i = 0; i < numSteps; ++i)
+  //     FUSILLI_CHECK_ERROR(graph.execute(handle, buffers));
+  ErrorOr<std::vector<std::shared_ptr<TensorAttr>>> getBindingPlan() const {
+    FUSILLI_RETURN_ERROR_IF(
+        !isValidated_, ErrorCode::NotValidated,
+        "Graph must be validated before getting its binding plan");
+    return ok(bindingPlan_);
+  }
+
   // Delete copy constructors, keep default move constructor and destructor.
   Graph(const Graph &) = delete;
   Graph &operator=(const Graph &) = delete;
@@ -218,6 +468,36 @@ public:
     return *this;
   }
 
+  // Sets the tuning config the graph is compiled with, taking precedence over
+  // the one registered for its fingerprint (see `TuningRegistry`). It applies
+  // to the next `compile()`.
+  Graph &setTuningConfig(const TuningConfig &config) {
+    tuningConfig_ = config;
+    return *this;
+  }
+
+  // Returns the wall times of the phases of the last `compile()`, to track
+  // cold (and warm) start costs.
+  const CompileStats &getCompileStats() const { return compileStats_; }
+
+  // Returns the scheduling statistics of the compiled artifact of the graph
+  // (dispatch count, transient memory size, ...), parsed from the statistics
+  // dumped into the cache by `iree-compile`.
+  ErrorOr<CompileStatistics> getCompileStatistics() {
+    std::string json =
+        FUSILLI_TRY(readCompilationCacheFile(CachedAssetsType::Statistics));
+    return parseCompileStatistics(json);
+  }
+
+  // Returns the tuning config the graph is compiled with for `backend`: its
+  // own if set, else the one registered for its fingerprint, if any.
+  TuningConfig getTuningConfig(Backend backend) const {
+    if (tuningConfig_.has_value())
+      return *tuningConfig_;
+    return TuningRegistry::find(backend, fingerprint_)
+        .value_or(TuningConfig{});
+  }
+
   // Declarations for tensor and op builder methods go here.
   // Definitions are towards the end of this file below.
   std::shared_ptr<TensorAttr> tensor(const TensorAttr &tensor);
@@ -231,6 +511,9 @@ public:
   std::shared_ptr<TensorAttr> convDGrad(const std::shared_ptr<TensorAttr> &dy,
                                         const std::shared_ptr<TensorAttr> &w,
                                         ConvDGradAttr &attributes);
+  std::shared_ptr<TensorAttr> matmul(const std::shared_ptr<TensorAttr> &a,
+                                     const std::shared_ptr<TensorAttr> &b,
+                                     MatmulAttr &attributes);
   std::shared_ptr<TensorAttr> pointwise(const std::shared_ptr<TensorAttr> &in,
                                         PointwiseAttr &attributes);
 
@@ -238,25 +521,91 @@ public:
                                         const std::shared_ptr<TensorAttr> &in1,
                                         PointwiseAttr &attributes);
 
+  std::shared_ptr<TensorAttr> pointwise(const std::shared_ptr<TensorAttr> &in0,
+                                        const std::shared_ptr<TensorAttr> &in1,
+                                        const std::shared_ptr<TensorAttr> &in2,
+                                        PointwiseAttr &attributes);
+
+  // Batchnorm in TRAINING, returning {Y, SAVED_MEAN, SAVED_INV_VARIANCE}.
+  std::array<std::shared_ptr<TensorAttr>, 3>
+  batchnorm(const std::shared_ptr<TensorAttr> &x,
+            const std::shared_ptr<TensorAttr> &scale,
+            const std::shared_ptr<TensorAttr> &bias, BatchnormAttr &attributes);
+  // Batchnorm in INFERENCE with the running `mean` and `var`, returning Y.
+  std::shared_ptr<TensorAttr>
+  batchnormInference(const std::shared_ptr<TensorAttr> &x,
+                     const std::shared_ptr<TensorAttr> &scale,
+                     const std::shared_ptr<TensorAttr> &bias,
+                     const std::shared_ptr<TensorAttr> &mean,
+                     const std::shared_ptr<TensorAttr> &var,
+                     BatchnormAttr &attributes);
+  // Layernorm returning {Y, MEAN, INV_VARIANCE}, with null statistics unless
+  // the forward phase of `attributes` is TRAINING.
+  std::array<std::shared_ptr<TensorAttr>, 3>
+  layernorm(const std::shared_ptr<TensorAttr> &x,
+            const std::shared_ptr<TensorAttr> &scale,
+            const std::shared_ptr<TensorAttr> &bias, LayernormAttr &attributes);
+  // RMSNorm returning {Y, INV_RMS}, with a null statistic unless the forward
+  // phase of `attributes` is TRAINING.
+  std::array<std::shared_ptr<TensorAttr>, 2>
+  rmsnorm(const std::shared_ptr<TensorAttr> &x,
+          const std::shared_ptr<TensorAttr> &scale, RmsnormAttr &attributes);
+
+  std::shared_ptr<TensorAttr> reduction(const std::shared_ptr<TensorAttr> &x,
+                                        ReductionAttr &attributes);
+  std::shared_ptr<TensorAttr> softmax(const std::shared_ptr<TensorAttr> &x,
+                                      SoftmaxAttr &attributes);
+
+  std::shared_ptr<TensorAttr> sdpa(const std::shared_ptr<TensorAttr> &q,
+                                   const std::shared_ptr<TensorAttr> &k,
+                                   const std::shared_ptr<TensorAttr> &v,
+                                   SdpaAttr &attributes);
+  // SDPA with the (boolean or additive) attention `mask`.
+  std::shared_ptr<TensorAttr> sdpa(const std::shared_ptr<TensorAttr> &q,
+                                   const std::shared_ptr<TensorAttr> &k,
+                                   const std::shared_ptr<TensorAttr> &v,
+                                   const std::shared_ptr<TensorAttr> &mask,
+                                   SdpaAttr &attributes);
+
   // ASM emitter driver method.
   //
   // TODO(#2152): Make this private. It is public for now to aid testing and
   // debuggability, however the intended user facing API is `Graph::compile()`.
+  // Returns the fingerprint of the validated graph: a hash of the nodes and
+  // tensors its MLIR assembly is emitted from (types, names, attributes, and
+  // tensor dims, strides and data types), computed by `validate()`. Graphs
+  // with the same fingerprint emit the same assembly. Like the assembly, it
+  // does not reflect changes made to the graph after validation.
+  ErrorOr<uint64_t> getFingerprint() const {
+    FUSILLI_RETURN_ERROR_IF(
+        !isValidated_, ErrorCode::NotValidated,
+        "Graph must be validated before getting its fingerprint");
+    return ok(fingerprint_);
+  }
+
   ErrorOr<std::string> emitAsm() {
+    FUSILLI_TRACE_SCOPE("Graph::emitAsm");
     FUSILLI_LOG_LABEL_ENDL("INFO: Emitting MLIR assembly for Graph");
     FUSILLI_RETURN_ERROR_IF(
         !isValidated_, ErrorCode::NotValidated,
         "Graph must be validated before emitting MLIR assembly");
-    std::ostringstream oss;
-    emitAsmSubtree(oss);
-    FUSILLI_LOG_ENDL(oss.str());
-    return ok(oss.str());
+    // Nodes append their assembly to a single buffer, preallocated from the
+    // size of the last emission (or an estimate per node for the first one)
+    // so that it is not regrown while emitting large graphs.
+    std::string asm_;
+    asm_.reserve(std::max(lastAsmSize_, getSubtreeSize() * kAsmBytesPerNode));
+    emitAsmSubtree(asm_);
+    lastAsmSize_ = asm_.size();
+    FUSILLI_LOG_ENDL(asm_);
+    return ok(std::move(asm_));
   }
 
-  // Return compiled artifact. The first invocation will always generate
-  // compiled artifact, subsequent invocations may return cached versions
-  // assuming cache invalidation checks pass. Set `remove = true` to remove
-  // cache files when this `Graph` instance goes out of scope.
+  // Return compiled artifact. Artifacts are cached in a directory named after
+  // a hash of what they are compiled from (see `getCacheKey`), so that they
+  // are reused by any graph (or `Graph` instance) with the same generated
+  // assembly, for the same backend and compiler, and are only generated when
+  // no complete artifacts are found there. Set `remove = true` to remove cache
+  // files used by this `Graph` instance when it goes out of scope.
   //
   // `reCompiled` will be set to true if a value is passed and the cache was
   // (re)generated; this parameter is useful for testing.
@@ -266,15 +615,51 @@ public:
   ErrorOr<std::filesystem::path>
   getCompiledArtifact(const Handle &handle, const std::string &generatedAsm,
                       bool remove, std::optional<bool> *reCompiled = nullptr) {
-    // Check for cache hit.
-    if (FUSILLI_TRY(validateCache(handle, generatedAsm))) {
+    std::string cacheKey = FUSILLI_TRY(getCacheKey(handle, generatedAsm));
+
+    // Graphs compiled concurrently with the same key wait for the first,
+    // then reuse its artifacts, within the process and across the processes
+    // sharing the cache (see `CacheLock`). Without the latter (e.g. on file
+    // systems without `flock`), processes compile on their own.
+    std::lock_guard<std::mutex> lock(getCacheKeyMutex(cacheKey));
+    ErrorOr<CacheLock> processLock = CacheLock::acquire(cacheKey);
+    if (isError(processLock))
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Compiling without the cache lock: "
+                             << ErrorObject(processLock));
+
+    // Check for cache hit, locally or in the remote cache (see
+    // `RemoteCache`).
+    auto start = std::chrono::steady_clock::now();
+    bool isValid = FUSILLI_TRY(validateCache(cacheKey, remove));
+    std::shared_ptr<RemoteCache> remoteCache = RemoteCache::get();
+    if (!isValid && remoteCache) {
+      ErrorOr<bool> fetched =
+          remoteCache->fetch(cacheKey, getCacheFileNames());
+      if (isError(fetched))
+        FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to fetch from remote cache: "
+                               << ErrorObject(fetched));
+      else if (*fetched)
+        isValid = FUSILLI_TRY(validateCache(cacheKey, remove));
+    }
+    compileStats_.validateCacheUs += getElapsedUs(start);
+    if (isValid) {
       if (reCompiled)
         *reCompiled = false;
       return ok(cache_->output.path);
     }
     // (Re)generate cache.
-    cache_ =
-        FUSILLI_TRY(generateCompiledArtifact(handle, generatedAsm, remove));
+    start = std::chrono::steady_clock::now();
+    cache_ = FUSILLI_TRY(
+        generateCompiledArtifact(handle, generatedAsm, cacheKey, remove));
+    compileStats_.ireeCompileUs = getElapsedUs(start);
+    compileStats_.cacheHit = false;
+    if (remoteCache) {
+      ErrorObject published =
+          remoteCache->publish(cacheKey, getCacheFileNames());
+      if (isError(published))
+        FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to publish to remote cache: "
+                               << published);
+    }
     if (reCompiled)
       *reCompiled = true;
     return ok(cache_->output.path);
@@ -301,23 +686,184 @@ public:
     }
   }
 
+  // Returns the bytecode module of `vmfbPath` shared across graphs of the
+  // process. It is public to aid testing, as `getCompiledArtifact`.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<IreeVmModuleSharedPtrType>
+  getSharedModule(const Handle &handle, const std::string &vmfbPath);
+
+  // Allow CompiledBundle to read compiled artifacts and add cache keys.
+  friend class CompiledBundle;
+  // Allow ExecutionPlan to check bindings once and invoke graphs with them.
+  friend class ExecutionPlan;
+
 private:
+  // Graph passes of `optimize`, returning the number of nodes they fold or
+  // remove (or of tensors they change the layout of). Definitions in
+  // `fusilli/graph/passes.h`.
+  size_t foldConstants();
+  size_t eliminateCommonSubexpressions();
+  size_t cancelPermutes();
+  size_t eliminateDeadNodes();
+  void replaceTensor(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to);
+  void removeNodes(const std::unordered_set<const INode *> &nodes);
+
+  // Validates the inputs and outputs of the graph once its nodes are (by
+  // `validate` or `cloneWithDims`), and sets up what the validated graph
+  // provides: its fingerprint and binding plan.
+  ErrorObject validateInputsAndOutputs() {
+    // Validate inputs:
+    // This has to happen after `validateSubtree` to infer any
+    // missing properties on inputs first.
+    for (const auto &input : fullGraphInputs_) {
+      FUSILLI_CHECK_ERROR(input->validate());
+    }
+    // Validate outputs:
+    // This has to happen after `validateSubtree` to infer any
+    // missing properties on outputs first.
+    for (const auto &output : fullGraphOutputs_) {
+      FUSILLI_CHECK_ERROR(output->validate());
+    }
+    FUSILLI_LOG_LABEL_ENDL("INFO: Graph validation completed successfully");
+    isValidated_ = true;
+    fingerprint_ = fingerprintSubtree(kFnv1aHashSeed);
+    bindingPlan_.clear();
+    for (const auto &output : fullGraphOutputsSorted_)
+      if (!output->isVirtual())
+        bindingPlan_.push_back(output);
+    // Constants are embedded in the compiled module (see
+    // `TensorAttr::setConstantData`).
+    for (const auto &input : fullGraphInputsSorted_)
+      if (!input->isConstant())
+        bindingPlan_.push_back(input);
+    return ok();
+  }
+
+  // Microseconds elapsed since `start`, for `compileStats_`.
+  static double getElapsedUs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+  // Estimated size of the MLIR assembly of a node (around that of a
+  // convolution with its permutes), to preallocate the `emitAsm` buffer.
+  static constexpr size_t kAsmBytesPerNode = 4096;
+
   // Definition in `fusilli/backend/runtime.h`.
   ErrorObject createPerGraphSession(const Handle &handle,
                                     const std::string &vmfbPath);
 
+  // Flags passed to the compiler, other than input and output.
+  std::vector<std::string> buildCompileFlags(const Handle &handle,
+                                             const CacheFile &statistics) {
+    std::vector<std::string> flags = kBackendFlags.at(handle.getBackend());
+    if (!handle.getTarget().empty())
+      flags.push_back(kBackendTargetFlag.at(handle.getBackend()) +
+                      handle.getTarget());
+    for (auto &flag : getTuningConfig(handle.getBackend()).getCompileFlags())
+      flags.push_back(std::move(flag));
+    // TODO(#2374): Make this conditional (enabled only for testing/debug).
+    flags.push_back("--iree-scheduling-dump-statistics-format=json");
+    flags.push_back("--iree-scheduling-dump-statistics-file=" +
+                    statistics.path.string());
+    return flags;
+  }
+
+  // Returns the key of the compiled artifacts of `generatedAsm`, a hash of
+  // everything they depend on: the assembly, the backend and its compile
+  // flags, the device target, the tuning config, and the compiler version.
+  // Paths of cached assets are left out, as they derive from the key.
+  ErrorOr<std::string> getCacheKey(const Handle &handle,
+                                   const std::string &generatedAsm) {
+    // Fields are terminated so that their boundaries are part of the hash.
+    uint64_t hash = fnv1aHash(generatedAsm);
+    hash = fnv1aHash(std::string_view("\0", 1), hash);
+    std::ostringstream backend;
+    backend << handle.getBackend();
+    hash = fnv1aHash(backend.str() + '\0', hash);
+    for (const auto &flag : kBackendFlags.at(handle.getBackend()))
+      hash = fnv1aHash(flag + '\0', hash);
+    hash = fnv1aHash(handle.getTarget() + '\0', hash);
+    hash = FUSILLI_TRY(getTuningConfig(handle.getBackend()).hash(hash));
+    hash = fnv1aHash(FUSILLI_TRY(getIreeCompilerVersion()), hash);
+
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ok(key.str());
+  }
+
+  // Returns the fingerprint of the graph combined with what its compilation
+  // for `handle` depends on besides the backend: the device target and the
+  // tuning config. It is `fingerprint_` for untuned graphs compiled for the
+  // host.
+  ErrorOr<uint64_t> getCompileFingerprint(const Handle &handle) const {
+    uint64_t hash = fingerprint_;
+    if (!handle.getTarget().empty())
+      hash = fnv1aHash(handle.getTarget() + '\0', hash);
+    return getTuningConfig(handle.getBackend()).hash(hash);
+  }
+
+  // Cache keys of the graphs compiled in the process, by backend and compile
+  // fingerprint (see `getCompileFingerprint`). Keys are the same for a
+  // compile fingerprint within the process (backend flags and the compiler
+  // do not change), so that they are looked up by fingerprint before
+  // emitting MLIR assembly (see `compile`).
+  struct FingerprintCacheKeys {
+    std::mutex mutex;
+    std::map<std::pair<Backend, uint64_t>, std::string> keys;
+  };
+  static FingerprintCacheKeys &getFingerprintCacheKeys() {
+    static FingerprintCacheKeys cacheKeys;
+    return cacheKeys;
+  }
+
+  static std::optional<std::string>
+  findFingerprintCacheKey(Backend backend, uint64_t fingerprint) {
+    FingerprintCacheKeys &cacheKeys = getFingerprintCacheKeys();
+    std::lock_guard<std::mutex> lock(cacheKeys.mutex);
+    auto it = cacheKeys.keys.find({backend, fingerprint});
+    if (it == cacheKeys.keys.end())
+      return std::nullopt;
+    return it->second;
+  }
+
+  static void addFingerprintCacheKey(Backend backend, uint64_t fingerprint,
+                                     const std::string &cacheKey) {
+    FingerprintCacheKeys &cacheKeys = getFingerprintCacheKeys();
+    std::lock_guard<std::mutex> lock(cacheKeys.mutex);
+    cacheKeys.keys[{backend, fingerprint}] = cacheKey;
+  }
+
+  // Names of the files of a cache entry, the key (marking the entry complete)
+  // last.
+  static const std::vector<std::string> &getCacheFileNames() {
+    static const std::vector<std::string> fileNames = {
+        IREE_COMPILE_INPUT_FILENAME, IREE_COMPILE_OUTPUT_FILENAME,
+        IREE_COMPILE_COMMAND_FILENAME, IREE_COMPILE_STATISTICS_FILENAME,
+        IREE_COMPILE_KEY_FILENAME};
+    return fileNames;
+  }
+
+  // Returns the mutex serializing the compilations of `cacheKey` within the
+  // process. Mutexes are striped over keys, so that distinct keys rarely
+  // share one.
+  static std::mutex &getCacheKeyMutex(const std::string &cacheKey) {
+    static std::array<std::mutex, 64> mutexes;
+    return mutexes[std::hash<std::string>{}(cacheKey) % mutexes.size()];
+  }
+
+  // The `iree-compile` command equivalent to the compilation, run when
+  // in-process compilation is not enabled and kept as a reproducer otherwise.
   std::string buildCompileCommand(const Handle &handle, const CacheFile &input,
-                                  const CacheFile &output,
+                                  const std::filesystem::path &outputPath,
                                   const CacheFile &statistics) {
     std::vector<std::string> args = {IREE_COMPILE_PATH, input.path};
-    auto &flags = kBackendFlags.at(handle.getBackend());
+    auto flags = buildCompileFlags(handle, statistics);
     args.insert(args.end(), flags.begin(), flags.end());
-    // TODO(#2374): Make this conditional (enabled only for testing/debug).
-    args.push_back("--iree-scheduling-dump-statistics-format=json");
-    args.push_back("--iree-scheduling-dump-statistics-file=" +
-                   statistics.path.string());
     args.push_back("-o");
-    args.push_back(output.path);
+    args.push_back(outputPath);
     std::ostringstream cmdss;
     interleave(
         args.begin(), args.end(),
@@ -328,128 +874,155 @@ private:
     return cmdss.str() + "\n";
   }
 
-  // Create compiled artifacts from graph writing results to the cache. Set
-  // `remove = true` to remove cache files when returned `CachedAssets` lifetime
-  // ends.
+  // Create compiled artifacts from graph writing results to the cache, in the
+  // directory of `cacheKey`. Set `remove = true` to remove cache files when
+  // returned `CachedAssets` lifetime ends. The compiled artifact is written
+  // atomically (see `getTempCachePath`), and least recently used entries of
+  // the cache are then evicted past its size limit (see `CacheManager`).
   ErrorOr<CachedAssets>
   generateCompiledArtifact(const Handle &handle,
-                           const std::string &generatedAsm, bool remove) {
+                           const std::string &generatedAsm,
+                           const std::string &cacheKey, bool remove) {
+    FUSILLI_TRACE_SCOPE("Graph::generateCompiledArtifact");
     FUSILLI_LOG_LABEL_ENDL("INFO: Generating compiled artifacts");
 
     // Create cache.
     CachedAssets cache = CachedAssets(
         /*in=*/
         FUSILLI_TRY(CacheFile::create(
-            /*graphName=*/getName(),
+            /*graphName=*/cacheKey,
             /*fileName=*/IREE_COMPILE_INPUT_FILENAME,
             /*remove=*/remove)),
         /*out=*/
         FUSILLI_TRY(CacheFile::create(
-            /*graphName=*/getName(),
+            /*graphName=*/cacheKey,
             /*fileName=*/IREE_COMPILE_OUTPUT_FILENAME,
             /*remove=*/remove)),
         /*cmd=*/
         FUSILLI_TRY(CacheFile::create(
-            /*graphName=*/getName(),
+            /*graphName=*/cacheKey,
             /*fileName=*/IREE_COMPILE_COMMAND_FILENAME,
             /*remove=*/remove)),
-        /*stat=*/
+        /*stats=*/
         FUSILLI_TRY(CacheFile::create(
-            /*graphName=*/getName(),
+            /*graphName=*/cacheKey,
             /*fileName=*/IREE_COMPILE_STATISTICS_FILENAME,
+            /*remove=*/remove)),
+        /*key=*/
+        FUSILLI_TRY(CacheFile::create(
+            /*graphName=*/cacheKey,
+            /*fileName=*/IREE_COMPILE_KEY_FILENAME,
             /*remove=*/remove)));
 
     // Write input asm to cache.
     FUSILLI_CHECK_ERROR(cache.input.write(generatedAsm));
 
     // Build + cache + log compile command.
-    std::string cmd = buildCompileCommand(handle, cache.input, cache.output,
-                                          cache.statistics);
+    std::string cmd = buildCompileCommand(handle, cache.input,
+                                          cache.output.path, cache.statistics);
     FUSILLI_CHECK_ERROR(cache.command.write(cmd));
     FUSILLI_LOG_LABEL_ENDL("INFO: iree-compile command");
     FUSILLI_LOG_ENDL(cmd);
 
+    // Compile to a temporary file renamed to the output once complete.
+    std::filesystem::path tempOutputPath = getTempCachePath(cache.output.path);
+#ifdef FUSILLI_ENABLE_COMPILER_API
+    // Compile in-process with the compiler session shared by the handle.
+    ErrorObject compileStatus = handle.getCompileSession().compile(
+        cache.input.path, tempOutputPath,
+        buildCompileFlags(handle, cache.statistics));
+#else
     // Run iree-compile.
     // TODO(#1934): in the error case, std::system will dump to stderr, it would
     // be great to capture this for better logging + reproducer production.
-    int returnCode = std::system(cmd.c_str());
-    FUSILLI_RETURN_ERROR_IF(returnCode, ErrorCode::CompileFailure,
-                            "iree-compile command failed");
+    std::string tempCmd = buildCompileCommand(handle, cache.input,
+                                              tempOutputPath, cache.statistics);
+    ErrorObject compileStatus = ok();
+    if (std::system(tempCmd.c_str()))
+      compileStatus =
+          error(ErrorCode::CompileFailure, "iree-compile command failed");
+#endif
+    std::error_code ec;
+    if (isOk(compileStatus))
+      std::filesystem::rename(tempOutputPath, cache.output.path, ec);
+    if (isError(compileStatus) || ec) {
+      std::error_code removeEc;
+      std::filesystem::remove(tempOutputPath, removeEc);
+    }
+    FUSILLI_CHECK_ERROR(compileStatus);
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to write compiled artifact: " +
+                                cache.output.path.string());
+
+    // Mark the artifacts complete.
+    FUSILLI_CHECK_ERROR(cache.key.write(cacheKey));
+
+    FUSILLI_CHECK_ERROR(
+        CacheManager::enforceSizeLimit(cache.output.path.parent_path()));
 
     return ok(std::move(cache));
   }
 
-  // Check for cache validity. Cache should be invalidated if:
-  //  - Cache has not been generated for this instance yet
-  //  - Graph name (and therefore cache path) has changed
-  //  - Generated assembly differs
-  //  - Compile commands have changed
-  //  - Handle/backend (and therefore compile command) has changed
-  ErrorOr<bool> validateCache(const Handle &handle,
-                              const std::string &generatedAsm) {
+  // Check for cache validity. The cache hits if complete artifacts exist for
+  // `cacheKey`, which were generated by this or another `Graph` instance from
+  // the same assembly, for the same backend and compiler. The cache misses if:
+  //  - No artifacts were generated for the key
+  //  - The artifacts are incomplete (their key file was not written)
+  //
+  // On a hit, the cache of this instance is set to the artifacts if it holds
+  // others, to be removed with this instance if `remove = true`.
+  ErrorOr<bool> validateCache(const std::string &cacheKey, bool remove) {
+    FUSILLI_TRACE_SCOPE("Graph::validateCache");
     FUSILLI_LOG_LABEL_ENDL("INFO: Validating cache");
 
-    // Check for cache miss if cache hasn't been generated.
-    if (!cache_.has_value()) {
-      FUSILLI_LOG_ENDL("Cache not previously populated.");
-      return ok(false);
-    }
-
-    // Check for cache miss if paths don't match (e.g., if graph name changed).
-    if (cache_->input.path != CacheFile::getPath(
-                                  /*graphName=*/getName(),
-                                  /*fileName=*/IREE_COMPILE_INPUT_FILENAME)) {
-      FUSILLI_LOG_ENDL("Cache input paths differ.");
-      return ok(false);
-    }
-    if (cache_->output.path != CacheFile::getPath(
-                                   /*graphName=*/getName(),
-                                   /*fileName=*/IREE_COMPILE_OUTPUT_FILENAME)) {
-      FUSILLI_LOG_ENDL("Cache output paths differ.");
+    // Check for cache miss on the key: unlike a comparison of the generated
+    // assembly with the cached input, this does not read the input back.
+    ErrorOr<CacheFile> key = CacheFile::open(
+        /*graphName=*/cacheKey,
+        /*fileName=*/IREE_COMPILE_KEY_FILENAME);
+    if (isError(key)) {
+      FUSILLI_LOG_ENDL("Cache not populated for key " << cacheKey << ".");
       return ok(false);
     }
-    if (cache_->command.path !=
-        CacheFile::getPath(
-            /*graphName=*/getName(),
-            /*fileName=*/IREE_COMPILE_COMMAND_FILENAME)) {
-      FUSILLI_LOG_ENDL("Cache compile command paths differ.");
-      return ok(false);
-    }
-    if (cache_->statistics.path !=
-        CacheFile::getPath(
-            /*graphName=*/getName(),
-            /*fileName=*/IREE_COMPILE_STATISTICS_FILENAME)) {
-      FUSILLI_LOG_ENDL("Cache compile statistics paths differ.");
+    if (FUSILLI_TRY(key->read()) != cacheKey) {
+      FUSILLI_LOG_ENDL("Cache incomplete for key " << cacheKey << ".");
       return ok(false);
     }
 
-    // Open expected files.
-    CacheFile input = FUSILLI_TRY(CacheFile::open(
-        /*graphName=*/getName(),
-        /*fileName=*/IREE_COMPILE_INPUT_FILENAME));
-    CacheFile output = FUSILLI_TRY(CacheFile::open(
-        /*graphName=*/getName(),
-        /*fileName=*/IREE_COMPILE_OUTPUT_FILENAME));
-    CacheFile command = FUSILLI_TRY(CacheFile::open(
-        /*graphName=*/getName(),
-        /*fileName=*/IREE_COMPILE_COMMAND_FILENAME));
-    CacheFile statistics = FUSILLI_TRY(CacheFile::open(
-        /*graphName=*/getName(),
-        /*fileName=*/IREE_COMPILE_STATISTICS_FILENAME));
-
-    // Check for a cache miss on generated assembly.
-    if (FUSILLI_TRY(input.read()) != generatedAsm) {
-      FUSILLI_LOG_ENDL("Generated assembly does not match");
-      return ok(false);
-    }
+    // Mark the entry used for the eviction of least recently used entries.
+    CacheManager::touch(key->path.parent_path());
 
-    // Check for a cache miss on compile command.
-    std::string cmd = buildCompileCommand(handle, input, output, statistics);
-    if (FUSILLI_TRY(command.read()) != cmd) {
-      FUSILLI_LOG_ENDL("Compile command does not match");
-      return ok(false);
-    }
+    if (cache_.has_value() && cache_->key.path == key->path)
+      return ok(true);
 
+    // Open the artifacts of another instance.
+    FUSILLI_LOG_ENDL("Reusing cache for key " << cacheKey << ".");
+    cache_ = CachedAssets(
+        /*in=*/
+        FUSILLI_TRY(CacheFile::open(
+            /*graphName=*/cacheKey,
+            /*fileName=*/IREE_COMPILE_INPUT_FILENAME,
+            /*remove=*/remove)),
+        /*out=*/
+        FUSILLI_TRY(CacheFile::open(
+            /*graphName=*/cacheKey,
+            /*fileName=*/IREE_COMPILE_OUTPUT_FILENAME,
+            /*remove=*/remove)),
+        /*cmd=*/
+        FUSILLI_TRY(CacheFile::open(
+            /*graphName=*/cacheKey,
+            /*fileName=*/IREE_COMPILE_COMMAND_FILENAME,
+            /*remove=*/remove)),
+        /*stats=*/
+        FUSILLI_TRY(CacheFile::open(
+            /*graphName=*/cacheKey,
+            /*fileName=*/IREE_COMPILE_STATISTICS_FILENAME,
+            /*remove=*/remove)),
+        /*key=*/
+        FUSILLI_TRY(CacheFile::open(
+            /*graphName=*/cacheKey,
+            /*fileName=*/IREE_COMPILE_KEY_FILENAME,
+            /*remove=*/remove)));
     return ok(true);
   }
 
@@ -499,24 +1072,143 @@ private:
 
   ErrorObject postValidateNode() const override final { return ok(); }
 
+  // The graph emits its inputs and outputs (sorted by name).
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    hash = INode::fingerprintNode(hash);
+    for (const auto *tensors :
+         {&fullGraphInputsSorted_, &fullGraphOutputsSorted_}) {
+      hash = fnv1aHashValue(tensors->size(), hash);
+      for (const auto &tensor : *tensors)
+        hash = tensor->fingerprint(hash);
+    }
+    return hash;
+  }
+
   // MLIR assembly emitter helper methods.
   std::string emitNodePreAsm() const override final;
   std::string emitNodePostAsm() const override final;
   std::string getOperandNamesAndTypesAsm() const;
   std::string getResultNamesAndTypesAsm() const;
+  std::string getConstantsAsm() const;
+  std::string getConstantResourcesAsm() const;
 
   // This is set after `validate()` is run at least once successfully.
   bool isValidated_ = false;
 
-  // IREE runtime session lifetime managed by the `Graph` object
-  // (deleted when the `Graph` object goes out of scope).
-  IreeRuntimeSessionUniquePtrType session_;
+  // Set by `validate()` (see `getFingerprint`).
+  uint64_t fingerprint_ = 0;
+
+  // Set by `compile()` (see `getCompileStats`).
+  CompileStats compileStats_;
+
+  // Size of the last assembly emitted by `emitAsm()`, its buffer capacity
+  // when the graph is emitted again (e.g. by `compile()`).
+  size_t lastAsmSize_ = 0;
+
+  // Set by `validate()` (see `getBindingPlan`).
+  std::vector<std::shared_ptr<TensorAttr>> bindingPlan_;
+
+  // Set by `setTuningConfig()` (see `getTuningConfig`).
+  std::optional<TuningConfig> tuningConfig_ = std::nullopt;
+
+  // Bytecode module loaded in the sessions of the graph, shared with other
+  // graphs loading the same compiled artifact (see `getSharedModule`).
+  IreeVmModuleSharedPtrType module_;
+
+  // An IREE runtime session the graph is loaded in on a HAL device, and the
+  // call of its entry function (and the dummy fences it is passed on
+  // asynchronous backends), set up by `createExecuteCall` and reset by every
+  // `execute` call rather than initialized by name. The mutex serializes
+  // concurrent `execute` calls sharing it. The sessions are declared first,
+  // so that they are released last.
+  struct ExecuteCall {
+    // The session shared by the graphs of the handle the call was created
+    // with, or (if it holds another module of the same name) a session of the
+    // graph.
+    std::shared_ptr<Handle::SharedSession> sharedSession;
+    IreeRuntimeSessionUniquePtrType session;
+    // The name of the module of the graph, qualifying its functions.
+    std::string moduleName;
+    // The device of the session (retained by it), and the backend and target
+    // of the handle it was created with.
+    iree_hal_device_t *device = nullptr;
+    Backend backend;
+    std::string target;
+    IreeRuntimeCallUniquePtrType call;
+    IreeHalFenceUniquePtrType waitFence;
+    IreeHalFenceUniquePtrType signalFence;
+    // Set up by the first `executeAsync`: the call of `main$async` on
+    // synchronous backends (`call` is on asynchronous ones), and the timeline
+    // semaphore of the fences it returns, with its last signaled timepoint.
+    IreeRuntimeCallUniquePtrType asyncCall;
+    IreeHalSemaphoreUniquePtrType semaphore;
+    uint64_t timepoint = 0;
+    std::mutex mutex;
+
+    iree_runtime_session_t *getSession() const {
+      return session ? session.get() : sharedSession->session.get();
+    }
+    // Locks the shared session, if the call is in it, for an invocation.
+    std::unique_lock<std::mutex> lockSharedSession() const {
+      if (session)
+        return {};
+      return std::unique_lock<std::mutex>(sharedSession->mutex);
+    }
+  };
+  // The session on the device of the handle compiling the graph, set up by
+  // `createPerGraphSession`.
+  std::unique_ptr<ExecuteCall> executeCall_;
+  // Sessions on the devices of other handles the graph is executed with,
+  // created by `getExecuteCall` and cleared by `createPerGraphSession`.
+  struct OtherExecuteCalls {
+    std::mutex mutex;
+    std::map<const iree_hal_device_t *, std::unique_ptr<ExecuteCall>> calls;
+  };
+  std::unique_ptr<OtherExecuteCalls> otherExecuteCalls_ =
+      std::make_unique<OtherExecuteCalls>();
+
+  // Loads `module_` in the shared session of `handle` (or in a session of the
+  // graph), and creates its call.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<std::unique_ptr<ExecuteCall>>
+  createExecuteCall(const Handle &handle) const;
+
+  // Returns the call executing the graph with `handle`: `executeCall_` for
+  // handles on its device, or (created once) one on the device of `handle`.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<ExecuteCall *> getExecuteCall(const Handle &handle) const;
+
+  // Returns the buffers of `variantPack` in the order of the binding plan.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<std::vector<iree_hal_buffer_view_t *>> getBindings(
+      const std::unordered_map<std::shared_ptr<TensorAttr>,
+                               std::shared_ptr<Buffer>> &variantPack) const;
+
+  // Checks that `buffers` match the tensors of the binding plan: their
+  // number, and the static dims of dynamic tensors. Definition in
+  // `fusilli/backend/runtime.h`.
+  ErrorObject
+  checkBuffers(std::span<iree_hal_buffer_view_t *const> buffers) const;
+
+  // Invokes the call of `executeCall` with checked `buffers` (see
+  // `checkBuffers`), as the positional `execute`. Definition in
+  // `fusilli/backend/runtime.h`.
+  ErrorObject
+  invokeExecuteCall(ExecuteCall &executeCall,
+                    std::span<iree_hal_buffer_view_t *const> buffers) const;
+
+  // Invokes `call` with checked `buffers`, followed by `fences` (null fences
+  // allowed), then resets it. Called with the mutex of its `ExecuteCall` held.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorObject invokeCall(iree_runtime_call_t *call,
+                         std::span<iree_hal_buffer_view_t *const> buffers,
+                         std::span<iree_hal_fence_t *const> fences) const;
 
   // Cache set by `getCompiledArtifact()`.
   //
-  // Note: new instances should always re-generate cache even if the results
-  // could be read from the file system. Old results may have been generated
-  // with a different version of IREE, it would not be safe to use them.
+  // Note: results read from the file system are only reused when their key
+  // matches, the key including the compiler version: results generated with
+  // a different version of IREE would not be safe to use.
   std::optional<CachedAssets> cache_ = std::nullopt;
 
   // This is safe for post-insertion updates of TensorAttr (e.g. setting name
@@ -543,6 +1235,86 @@ inline std::shared_ptr<TensorAttr> Graph::tensor(const TensorAttr &tensor) {
   return tensorPtr;
 }
 
+inline ErrorOr<Graph> Graph::cloneWithDims(
+    const std::unordered_map<std::string, std::vector<int64_t>> &dims) const {
+  FUSILLI_TRACE_SCOPE("Graph::cloneWithDims");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Cloning Graph with new dims");
+  FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
+                          "Graph must be validated before being cloned");
+
+  Graph clone;
+  clone.context = context;
+  clone.tuningConfig_ = tuningConfig_;
+  clone.lastAsmSize_ = lastAsmSize_;
+
+  // Copy the tensors, node outputs first so that they are re-inferred.
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<TensorAttr>>
+      tensors;
+  size_t numChanged = 0;
+  auto copyTensor = [&](const std::shared_ptr<TensorAttr> &tensor,
+                        bool isNodeOutput) -> ErrorObject {
+    auto [it, inserted] = tensors.try_emplace(tensor, nullptr);
+    if (!inserted)
+      return ok();
+    it->second = std::make_shared<TensorAttr>(*tensor);
+    TensorAttr &copy = *it->second;
+    auto dimIt = dims.find(tensor->getName());
+    if (dimIt != dims.end()) {
+      const std::vector<int64_t> &dim = dimIt->second;
+      FUSILLI_RETURN_ERROR_IF(dim.size() != tensor->getDim().size(),
+                              ErrorCode::InvalidAttribute,
+                              "Tensor '" + tensor->getName() +
+                                  "' cannot change rank in a clone");
+      copy.setDim(dim).setStride(generateStrideFromDim(
+          dim, generateStrideOrderPreservingFormat(tensor->getStride(),
+                                                   dim.size())));
+      ++numChanged;
+    } else if (isNodeOutput) {
+      copy.setDim(std::vector<int64_t>{})
+          .setStride(std::vector<int64_t>{})
+          .setDynamicDims({});
+    }
+    return ok();
+  };
+  for (const auto &node : subNodes_)
+    for (const auto &output : node->getOutputTensors())
+      FUSILLI_CHECK_ERROR(copyTensor(output, /*isNodeOutput=*/true));
+  for (const auto &node : subNodes_)
+    for (const auto &input : node->getInputTensors())
+      FUSILLI_CHECK_ERROR(copyTensor(input, /*isNodeOutput=*/false));
+  for (const auto &input : fullGraphInputs_) {
+    FUSILLI_CHECK_ERROR(copyTensor(input, /*isNodeOutput=*/false));
+    clone.fullGraphInputs_.insert(tensors.at(input));
+  }
+  for (const auto &output : fullGraphOutputs_) {
+    FUSILLI_CHECK_ERROR(copyTensor(output, /*isNodeOutput=*/false));
+    clone.fullGraphOutputs_.insert(tensors.at(output));
+  }
+  if (numChanged != dims.size()) {
+    for (const auto &[name, dim] : dims) {
+      bool found = std::ranges::any_of(tensors, [&](const auto &entry) {
+        return entry.first->getName() == name;
+      });
+      FUSILLI_RETURN_ERROR_IF(!found, ErrorCode::InvalidAttribute,
+                              "Graph has no tensor named '" + name + "'");
+    }
+  }
+
+  for (const auto &node : subNodes_) {
+    std::shared_ptr<INode> nodeClone = node->cloneNode(tensors);
+    FUSILLI_RETURN_ERROR_IF(!nodeClone, ErrorCode::NotImplemented,
+                            "Node '" + node->getName() + "' cannot be cloned");
+    clone.subNodes_.push_back(std::move(nodeClone));
+  }
+
+  // Names are those of the validated graph, so only the nodes (whose checks
+  // depend on dims) are validated again.
+  FUSILLI_CHECK_ERROR(clone.inferPropertiesNode());
+  FUSILLI_CHECK_ERROR(clone.validateSubNodes());
+  FUSILLI_CHECK_ERROR(clone.validateInputsAndOutputs());
+  return ok(std::move(clone));
+}
+
 // Create a ConvFPropNode, populate it with the specified attributes, create
 // output tensors and add the node to the graph's sub nodes.
 inline std::shared_ptr<TensorAttr>
@@ -556,6 +1328,10 @@ Graph::convFProp(const std::shared_ptr<TensorAttr> &x,
     x->setName(convAttr.getName() + "_X");
   if (w->getName().empty())
     w->setName(convAttr.getName() + "_W");
+  if (convAttr.getX_SCALE() && convAttr.getX_SCALE()->getName().empty())
+    convAttr.getX_SCALE()->setName(convAttr.getName() + "_X_SCALE");
+  if (convAttr.getW_SCALE() && convAttr.getW_SCALE()->getName().empty())
+    convAttr.getW_SCALE()->setName(convAttr.getName() + "_W_SCALE");
 
   FUSILLI_LOG_LABEL_ENDL("INFO: Adding ConvFPropNode '" << convAttr.getName()
                                                         << "' to Graph");
@@ -636,6 +1412,40 @@ Graph::convDGrad(const std::shared_ptr<TensorAttr> &dy,
   return dx;
 }
 
+// Create a MatmulNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::matmul(const std::shared_ptr<TensorAttr> &a,
+              const std::shared_ptr<TensorAttr> &b, MatmulAttr &matmulAttr) {
+  // Populate names when not set.
+  if (matmulAttr.getName().empty())
+    matmulAttr.setName("matmul_" + std::to_string(subNodes_.size()));
+  if (a->getName().empty())
+    a->setName(matmulAttr.getName() + "_A");
+  if (b->getName().empty())
+    b->setName(matmulAttr.getName() + "_B");
+  if (matmulAttr.getA_SCALE() && matmulAttr.getA_SCALE()->getName().empty())
+    matmulAttr.getA_SCALE()->setName(matmulAttr.getName() + "_A_SCALE");
+  if (matmulAttr.getB_SCALE() && matmulAttr.getB_SCALE()->getName().empty())
+    matmulAttr.getB_SCALE()->setName(matmulAttr.getName() + "_B_SCALE");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding MatmulNode '" << matmulAttr.getName()
+                                                     << "' to Graph");
+
+  // Set inputs.
+  matmulAttr.setA(a).setB(b);
+
+  // Set outputs.
+  auto c = outputTensor(matmulAttr.getName() + "_C");
+  matmulAttr.setC(c);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<MatmulNode>(std::move(matmulAttr), context));
+
+  return c;
+}
+
 // Create a PointwiseNode for single operand cases (e.g. RELU), populate it with
 // the specified attributes, create output tensors and add the node to the
 // graph's sub nodes.
@@ -697,6 +1507,320 @@ Graph::pointwise(const std::shared_ptr<TensorAttr> &in0,
   return out;
 }
 
+// Create a PointwiseNode for cases with three operands (e.g. SCALE_SHIFT),
+// populate it with the specified attributes, create output tensors and add the
+// node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::pointwise(const std::shared_ptr<TensorAttr> &in0,
+                 const std::shared_ptr<TensorAttr> &in1,
+                 const std::shared_ptr<TensorAttr> &in2,
+                 PointwiseAttr &pointwiseAttr) {
+  // Populate names when not set.
+  if (pointwiseAttr.getName().empty())
+    pointwiseAttr.setName("pointwise_" + std::to_string(subNodes_.size()));
+  if (in0->getName().empty())
+    in0->setName(pointwiseAttr.getName() + "_IN_0");
+  if (in1->getName().empty())
+    in1->setName(pointwiseAttr.getName() + "_IN_1");
+  if (in2->getName().empty())
+    in2->setName(pointwiseAttr.getName() + "_IN_2");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding PointwiseNode '"
+                         << pointwiseAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  pointwiseAttr.setIN_0(in0).setIN_1(in1).setIN_2(in2);
+
+  // Set outputs.
+  auto out = outputTensor(pointwiseAttr.getName() + "_OUT_0");
+  pointwiseAttr.setOUT_0(out);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<PointwiseNode>(std::move(pointwiseAttr), context));
+
+  return out;
+}
+
+// Create a BatchnormNode in TRAINING, populate it with the specified
+// attributes, create output tensors and add the node to the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 3>
+Graph::batchnorm(const std::shared_ptr<TensorAttr> &x,
+                 const std::shared_ptr<TensorAttr> &scale,
+                 const std::shared_ptr<TensorAttr> &bias,
+                 BatchnormAttr &batchnormAttr) {
+  // Populate names when not set.
+  if (batchnormAttr.getName().empty())
+    batchnormAttr.setName("batchnorm_" + std::to_string(subNodes_.size()));
+  if (x->getName().empty())
+    x->setName(batchnormAttr.getName() + "_X");
+  if (scale->getName().empty())
+    scale->setName(batchnormAttr.getName() + "_SCALE");
+  if (bias->getName().empty())
+    bias->setName(batchnormAttr.getName() + "_BIAS");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding BatchnormNode '"
+                         << batchnormAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  batchnormAttr.setForwardPhase(NormFwdPhase::TRAINING);
+  batchnormAttr.setX(x).setSCALE(scale).setBIAS(bias);
+
+  // Set outputs.
+  auto y = outputTensor(batchnormAttr.getName() + "_Y");
+  auto savedMean = outputTensor(batchnormAttr.getName() + "_SAVED_MEAN");
+  auto savedInvVariance =
+      outputTensor(batchnormAttr.getName() + "_SAVED_INV_VARIANCE");
+  batchnormAttr.setY(y).setSAVED_MEAN(savedMean).setSAVED_INV_VARIANCE(
+      savedInvVariance);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<BatchnormNode>(std::move(batchnormAttr), context));
+
+  return {y, savedMean, savedInvVariance};
+}
+
+// Create a BatchnormNode in INFERENCE, populate it with the specified
+// attributes, create output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::batchnormInference(const std::shared_ptr<TensorAttr> &x,
+                          const std::shared_ptr<TensorAttr> &scale,
+                          const std::shared_ptr<TensorAttr> &bias,
+                          const std::shared_ptr<TensorAttr> &mean,
+                          const std::shared_ptr<TensorAttr> &var,
+                          BatchnormAttr &batchnormAttr) {
+  // Populate names when not set.
+  if (batchnormAttr.getName().empty())
+    batchnormAttr.setName("batchnorm_" + std::to_string(subNodes_.size()));
+  if (x->getName().empty())
+    x->setName(batchnormAttr.getName() + "_X");
+  if (scale->getName().empty())
+    scale->setName(batchnormAttr.getName() + "_SCALE");
+  if (bias->getName().empty())
+    bias->setName(batchnormAttr.getName() + "_BIAS");
+  if (mean->getName().empty())
+    mean->setName(batchnormAttr.getName() + "_MEAN");
+  if (var->getName().empty())
+    var->setName(batchnormAttr.getName() + "_VAR");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding BatchnormNode '"
+                         << batchnormAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  batchnormAttr.setForwardPhase(NormFwdPhase::INFERENCE);
+  batchnormAttr.setX(x).setSCALE(scale).setBIAS(bias).setMEAN(mean).setVAR(
+      var);
+
+  // Set outputs.
+  auto y = outputTensor(batchnormAttr.getName() + "_Y");
+  batchnormAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<BatchnormNode>(std::move(batchnormAttr), context));
+
+  return y;
+}
+
+// Create a LayernormNode, populate it with the specified attributes, create
+// output tensors (the statistics only in TRAINING) and add the node to the
+// graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 3>
+Graph::layernorm(const std::shared_ptr<TensorAttr> &x,
+                 const std::shared_ptr<TensorAttr> &scale,
+                 const std::shared_ptr<TensorAttr> &bias,
+                 LayernormAttr &layernormAttr) {
+  // Populate names when not set.
+  if (layernormAttr.getName().empty())
+    layernormAttr.setName("layernorm_" + std::to_string(subNodes_.size()));
+  if (x->getName().empty())
+    x->setName(layernormAttr.getName() + "_X");
+  if (scale->getName().empty())
+    scale->setName(layernormAttr.getName() + "_SCALE");
+  if (bias->getName().empty())
+    bias->setName(layernormAttr.getName() + "_BIAS");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding LayernormNode '"
+                         << layernormAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  layernormAttr.setX(x).setSCALE(scale).setBIAS(bias);
+
+  // Set outputs.
+  auto y = outputTensor(layernormAttr.getName() + "_Y");
+  std::shared_ptr<TensorAttr> mean, invVariance;
+  if (layernormAttr.getForwardPhase() == NormFwdPhase::TRAINING) {
+    mean = outputTensor(layernormAttr.getName() + "_MEAN");
+    invVariance = outputTensor(layernormAttr.getName() + "_INV_VARIANCE");
+    layernormAttr.setMEAN(mean).setINV_VARIANCE(invVariance);
+  }
+  layernormAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<LayernormNode>(std::move(layernormAttr), context));
+
+  return {y, mean, invVariance};
+}
+
+// Create a RmsnormNode, populate it with the specified attributes, create
+// output tensors (the statistic only in TRAINING) and add the node to the
+// graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 2>
+Graph::rmsnorm(const std::shared_ptr<TensorAttr> &x,
+               const std::shared_ptr<TensorAttr> &scale,
+               RmsnormAttr &rmsnormAttr) {
+  // Populate names when not set.
+  if (rmsnormAttr.getName().empty())
+    rmsnormAttr.setName("rmsnorm_" + std::to_string(subNodes_.size()));
+  if (x->getName().empty())
+    x->setName(rmsnormAttr.getName() + "_X");
+  if (scale->getName().empty())
+    scale->setName(rmsnormAttr.getName() + "_SCALE");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding RmsnormNode '" << rmsnormAttr.getName()
+                                                      << "' to Graph");
+
+  // Set inputs.
+  rmsnormAttr.setX(x).setSCALE(scale);
+
+  // Set outputs.
+  auto y = outputTensor(rmsnormAttr.getName() + "_Y");
+  std::shared_ptr<TensorAttr> invRms;
+  if (rmsnormAttr.getForwardPhase() == NormFwdPhase::TRAINING) {
+    invRms = outputTensor(rmsnormAttr.getName() + "_INV_RMS");
+    rmsnormAttr.setINV_RMS(invRms);
+  }
+  rmsnormAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<RmsnormNode>(std::move(rmsnormAttr), context));
+
+  return {y, invRms};
+}
+
+// Create a ReductionNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::reduction(const std::shared_ptr<TensorAttr> &x,
+                 ReductionAttr &reductionAttr) {
+  // Populate names when not set.
+  if (reductionAttr.getName().empty())
+    reductionAttr.setName("reduction_" + std::to_string(subNodes_.size()));
+  if (x->getName().empty())
+    x->setName(reductionAttr.getName() + "_X");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding ReductionNode '"
+                         << reductionAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  reductionAttr.setX(x);
+
+  // Set outputs.
+  auto y = outputTensor(reductionAttr.getName() + "_Y");
+  reductionAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<ReductionNode>(std::move(reductionAttr), context));
+
+  return y;
+}
+
+// Create a SoftmaxNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::softmax(const std::shared_ptr<TensorAttr> &x, SoftmaxAttr &softmaxAttr) {
+  // Populate names when not set.
+  if (softmaxAttr.getName().empty())
+    softmaxAttr.setName("softmax_" + std::to_string(subNodes_.size()));
+  if (x->getName().empty())
+    x->setName(softmaxAttr.getName() + "_X");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding SoftmaxNode '" << softmaxAttr.getName()
+                                                      << "' to Graph");
+
+  // Set inputs.
+  softmaxAttr.setX(x);
+
+  // Set outputs.
+  auto y = outputTensor(softmaxAttr.getName() + "_Y");
+  softmaxAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<SoftmaxNode>(std::move(softmaxAttr), context));
+
+  return y;
+}
+
+inline std::shared_ptr<TensorAttr>
+Graph::sdpa(const std::shared_ptr<TensorAttr> &q,
+            const std::shared_ptr<TensorAttr> &k,
+            const std::shared_ptr<TensorAttr> &v, SdpaAttr &sdpaAttr) {
+  return sdpa(q, k, v, nullptr, sdpaAttr);
+}
+
+// Create a SdpaNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes. The `mask` is
+// optional (may be null).
+inline std::shared_ptr<TensorAttr>
+Graph::sdpa(const std::shared_ptr<TensorAttr> &q,
+            const std::shared_ptr<TensorAttr> &k,
+            const std::shared_ptr<TensorAttr> &v,
+            const std::shared_ptr<TensorAttr> &mask, SdpaAttr &sdpaAttr) {
+  // Populate names when not set.
+  if (sdpaAttr.getName().empty())
+    sdpaAttr.setName("sdpa_" + std::to_string(subNodes_.size()));
+  if (q->getName().empty())
+    q->setName(sdpaAttr.getName() + "_Q");
+  if (k->getName().empty())
+    k->setName(sdpaAttr.getName() + "_K");
+  if (v->getName().empty())
+    v->setName(sdpaAttr.getName() + "_V");
+  if (mask && mask->getName().empty())
+    mask->setName(sdpaAttr.getName() + "_MASK");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding SdpaNode '" << sdpaAttr.getName()
+                                                   << "' to Graph");
+
+  // Set inputs.
+  sdpaAttr.setQ(q).setK(k).setV(v);
+  if (mask)
+    sdpaAttr.setMASK(mask);
+
+  // Set outputs.
+  auto o = outputTensor(sdpaAttr.getName() + "_O");
+  sdpaAttr.setO(o);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      std::make_unique<SdpaNode>(std::move(sdpaAttr), context));
+
+  return o;
+}
+
+// Compiles `graphs` concurrently on the compile pool (see
+// `Graph::compileAsync`), returning the first error once all compilations
+// have completed.
+inline ErrorObject compileGraphs(const Handle &handle,
+                                 const std::vector<Graph *> &graphs,
+                                 bool remove = false) {
+  std::vector<std::future<ErrorObject>> results;
+  results.reserve(graphs.size());
+  for (Graph *graph : graphs)
+    results.push_back(graph->compileAsync(handle, remove));
+  ErrorObject firstError = ok();
+  for (auto &result : results) {
+    ErrorObject status = result.get();
+    if (isError(status) && isOk(firstError))
+      firstError = std::move(status);
+  }
+  return firstError;
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_GRAPH_GRAPH_H
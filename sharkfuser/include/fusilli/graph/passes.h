@@ -0,0 +1,289 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the graph-level passes run by `Graph::optimize` on a
+// validated graph, before its MLIR assembly is emitted.
+//
+// Passes rewrite the nodes of the graph in place, rewiring the inputs of
+// nodes from the outputs of removed nodes to the tensors replacing them.
+// They only ever replace or remove virtual tensors (intermediates): the
+// inputs and non-virtual outputs of the graph, and so its bindings, are left
+// unchanged.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_PASSES_H
+#define FUSILLI_GRAPH_PASSES_H
+
+#include "fusilli/attributes/pointwise_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/node/conv_node.h"
+#include "fusilli/node/node.h"
+#include "fusilli/node/pointwise_node.h"
+#include "fusilli/support/extras.h"
+#include "fusilli/support/logging.h"
+#include "fusilli/support/tracing.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+namespace fusilli {
+
+// Value of a scalar constant tensor, or nullopt for other tensors.
+inline std::optional<double> getScalarConstant(const TensorAttr &tensor) {
+  if (!tensor.isScalar() || !tensor.getScalarValue().has_value())
+    return std::nullopt;
+  return std::visit([](auto value) { return static_cast<double>(value); },
+                    *tensor.getScalarValue());
+}
+
+// Scalar constant tensor `name` of `value`, or nullptr when `dataType` is not
+// that of a scalar constant.
+inline std::shared_ptr<TensorAttr>
+makeScalarConstant(const std::string &name, DataType dataType, double value) {
+  std::shared_ptr<TensorAttr> scalar;
+  switch (dataType) {
+  case DataType::Float:
+    scalar = std::make_shared<TensorAttr>(static_cast<float>(value));
+    break;
+  case DataType::Double:
+    scalar = std::make_shared<TensorAttr>(value);
+    break;
+  case DataType::Int32:
+    scalar = std::make_shared<TensorAttr>(static_cast<int32_t>(value));
+    break;
+  case DataType::Int64:
+    scalar = std::make_shared<TensorAttr>(static_cast<int64_t>(value));
+    break;
+  default:
+    return nullptr;
+  }
+  scalar->setName(name);
+  return scalar;
+}
+
+inline ErrorObject Graph::optimize() {
+  FUSILLI_TRACE_SCOPE("Graph::optimize");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Optimizing Graph");
+  FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
+                          "Graph must be validated before being optimized");
+
+  size_t numFolded = foldConstants();
+  size_t numEliminated = eliminateCommonSubexpressions();
+  size_t numRelaidOut = cancelPermutes();
+  size_t numDead = eliminateDeadNodes();
+  FUSILLI_LOG_ENDL("INFO: Graph optimization folded "
+                   << numFolded << " nodes, eliminated " << numEliminated
+                   << " common subexpressions and " << numDead
+                   << " dead nodes, and cancelled the permutes of "
+                   << numRelaidOut << " intermediate tensors");
+
+  // The assembly is now emitted from the optimized graph.
+  fingerprint_ = fingerprintSubtree(kFnv1aHashSeed);
+  return ok();
+}
+
+// Replaces `from` by `to` in the inputs of all nodes, and removes `from` from
+// the outputs of the graph.
+inline void Graph::replaceTensor(const std::shared_ptr<TensorAttr> &from,
+                                 const std::shared_ptr<TensorAttr> &to) {
+  for (const auto &node : subNodes_)
+    node->replaceInputTensor(from, to);
+  fullGraphOutputs_.erase(from);
+  fullGraphOutputsSorted_.erase(from);
+}
+
+inline void Graph::removeNodes(const std::unordered_set<const INode *> &nodes) {
+  for (const auto &node : subNodes_)
+    if (nodes.contains(node.get())) // C++20
+      for (const auto &output : node->getOutputTensors()) {
+        fullGraphOutputs_.erase(output);
+        fullGraphOutputsSorted_.erase(output);
+      }
+  std::erase_if(subNodes_, // C++20
+                [&](const auto &node) { return nodes.contains(node.get()); });
+}
+
+// Folds pointwise nodes with virtual outputs whose inputs are all scalar
+// constants into a scalar constant, and pointwise nodes that are identities
+// on their tensor input (x + 0, x - 0, x * 1 and x / 1, with a scalar
+// constant 0 or 1) into that input.
+inline size_t Graph::foldConstants() {
+  std::unordered_set<const INode *> folded;
+  for (const auto &node : subNodes_) {
+    if (node->getType() != Type::Pointwise)
+      continue;
+    const PointwiseAttr &attr = static_cast<PointwiseNode &>(*node).getAttr();
+    std::shared_ptr<TensorAttr> outT = attr.getOUT_0();
+    if (!outT->isVirtual() || attr.getIN_2())
+      continue;
+    std::shared_ptr<TensorAttr> in0T = attr.getIN_0();
+    std::shared_ptr<TensorAttr> in1T = attr.getIN_1();
+    if (!in1T)
+      continue;
+    std::optional<double> in0 = getScalarConstant(*in0T);
+    std::optional<double> in1 = getScalarConstant(*in1T);
+
+    PointwiseAttr::Mode mode = attr.getMode();
+    if (in0 && in1) {
+      std::optional<double> value;
+      if (mode == PointwiseAttr::Mode::ADD)
+        value = *in0 + *in1;
+      else if (mode == PointwiseAttr::Mode::SUB)
+        value = *in0 - *in1;
+      else if (mode == PointwiseAttr::Mode::MUL)
+        value = *in0 * *in1;
+      // Integer division is left to the compiler (for its rounding).
+      else if (mode == PointwiseAttr::Mode::DIV && *in1 != 0 &&
+               (outT->getDataType() == DataType::Float ||
+                outT->getDataType() == DataType::Double))
+        value = *in0 / *in1;
+      if (!value)
+        continue;
+      std::shared_ptr<TensorAttr> scalar =
+          makeScalarConstant(outT->getName(), outT->getDataType(), *value);
+      if (!scalar)
+        continue;
+      replaceTensor(outT, scalar);
+      folded.insert(node.get());
+      continue;
+    }
+
+    // Identities x op c (or c op x for commutative ops), which must not
+    // broadcast or cast x.
+    bool isCommutative = mode == PointwiseAttr::Mode::ADD ||
+                         mode == PointwiseAttr::Mode::MUL;
+    std::shared_ptr<TensorAttr> xT = in1 ? in0T : in1T;
+    std::optional<double> c = in1 ? in1 : in0;
+    if (!c || xT->isScalar() || (in0 && !isCommutative) ||
+        xT->getDim() != outT->getDim() ||
+        xT->getDataType() != outT->getDataType())
+      continue;
+    double identity = (mode == PointwiseAttr::Mode::ADD ||
+                       mode == PointwiseAttr::Mode::SUB)
+                          ? 0.0
+                          : 1.0;
+    if ((mode != PointwiseAttr::Mode::ADD &&
+         mode != PointwiseAttr::Mode::SUB &&
+         mode != PointwiseAttr::Mode::MUL &&
+         mode != PointwiseAttr::Mode::DIV) ||
+        *c != identity)
+      continue;
+    replaceTensor(outT, xT);
+    folded.insert(node.get());
+  }
+  removeNodes(folded);
+  return folded.size();
+}
+
+// Replaces the outputs of nodes computing the same values from the same
+// inputs as an earlier node (see `INode::fingerprintOperation`) by the
+// outputs of that node, when they are all virtual.
+inline size_t Graph::eliminateCommonSubexpressions() {
+  std::unordered_multimap<uint64_t, const INode *> seen;
+  std::unordered_set<const INode *> eliminated;
+  for (const auto &node : subNodes_) {
+    uint64_t hash = node->fingerprintOperation(kFnv1aHashSeed);
+    std::vector<std::shared_ptr<TensorAttr>> outputs =
+        node->getOutputTensors();
+    bool allVirtual = std::all_of(
+        outputs.begin(), outputs.end(),
+        [](const auto &output) { return output->isVirtual(); });
+
+    const INode *original = nullptr;
+    auto [begin, end] = seen.equal_range(hash);
+    for (auto it = begin; it != end; ++it)
+      if (it->second->getType() == node->getType() &&
+          it->second->getInputTensors() == node->getInputTensors() &&
+          it->second->getOutputTensors().size() == outputs.size())
+        original = it->second;
+    if (!original || !allVirtual) {
+      seen.emplace(hash, node.get());
+      continue;
+    }
+
+    std::vector<std::shared_ptr<TensorAttr>> originalOutputs =
+        original->getOutputTensors();
+    for (size_t i = 0; i < outputs.size(); ++i)
+      replaceTensor(outputs[i], originalOutputs[i]);
+    eliminated.insert(node.get());
+  }
+  removeNodes(eliminated);
+  return eliminated.size();
+}
+
+// Nodes permute their tensor inputs from their layout to their logical dims,
+// and their outputs back from their logical dims to their layout: between
+// adjacent nodes, the permutes of the intermediate (virtual) tensor cancel
+// out. Intermediates are given the contiguous layout of their logical dims,
+// so that these permutes are identities, folded away by the compiler. This
+// excludes the tensors of convolutions emitted directly in the channels-last
+// layout (see `ConvFPropAttr::setDirectChannelsLast`).
+inline size_t Graph::cancelPermutes() {
+  std::unordered_set<std::shared_ptr<TensorAttr>> keepLayout;
+  std::unordered_set<std::shared_ptr<TensorAttr>> intermediates;
+  for (const auto &node : subNodes_) {
+    bool isDirect =
+        node->getType() == Type::Convolution &&
+        static_cast<const ConvFPropNode &>(*node).isDirectChannelsLast();
+    for (const auto &tensors :
+         {node->getInputTensors(), node->getOutputTensors()})
+      for (const auto &tensor : tensors)
+        if (isDirect)
+          keepLayout.insert(tensor);
+    for (const auto &output : node->getOutputTensors())
+      if (output->isVirtual() && !output->isScalar())
+        intermediates.insert(output);
+  }
+
+  size_t numRelaidOut = 0;
+  for (const auto &tensor : intermediates) {
+    if (keepLayout.contains(tensor) || tensor->isContiguous()) // C++20
+      continue;
+    tensor->setStride(generateStrideFromDim(
+        tensor->getDim(), getContiguousStrideOrder(tensor->getDim().size())));
+    ++numRelaidOut;
+  }
+  return numRelaidOut;
+}
+
+// Removes nodes whose outputs are all virtual and read by no other node.
+inline size_t Graph::eliminateDeadNodes() {
+  std::unordered_set<std::shared_ptr<TensorAttr>> live;
+  std::unordered_set<const INode *> dead;
+  for (auto it = subNodes_.rbegin(); it != subNodes_.rend(); ++it) {
+    std::vector<std::shared_ptr<TensorAttr>> outputs =
+        (*it)->getOutputTensors();
+    bool isLive =
+        std::any_of(outputs.begin(), outputs.end(), [&](const auto &output) {
+          return !output->isVirtual() || live.contains(output); // C++20
+        });
+    if (!isLive) {
+      dead.insert(it->get());
+      continue;
+    }
+    for (const auto &input : (*it)->getInputTensors())
+      live.insert(input);
+  }
+  removeNodes(dead);
+  return dead.size();
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_PASSES_H
@@ -0,0 +1,730 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the serialization of graphs to JSON descriptions by
+// `Graph::serialize`, and `Graph::deserialize` building graphs back from
+// them. A description reads:
+//
+//   {
+//     "version": 1,
+//     "name": "conv_bias",
+//     "io_data_type": "Half",
+//     "compute_data_type": "Float",
+//     "tensors": [
+//       {"name": "x", "dim": [16, 128, 64, 64], "stride": [...]},
+//       ...
+//     ],
+//     "inputs": [0, 1, 3],
+//     "outputs": [2, 4],
+//     "nodes": [
+//       {"type": "conv_fprop", "name": "conv", "inputs": {"X": 0, "W": 1},
+//        "outputs": {"Y": 2}, "padding": [0, 0], ...},
+//       ...
+//     ]
+//   }
+//
+// Tensors are referred to by their index in "tensors", and node inputs and
+// outputs by the names of their keys in the attributes (e.g. `InputNames::X`
+// of `ConvFPropAttr`). Tensor properties and data types that are not set are
+// left out, as are the optional attributes of nodes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_SERIALIZATION_H
+#define FUSILLI_GRAPH_SERIALIZATION_H
+
+#include "fusilli/attributes/conv_attributes.h"
+#include "fusilli/attributes/matmul_attributes.h"
+#include "fusilli/attributes/normalization_attributes.h"
+#include "fusilli/attributes/pointwise_attributes.h"
+#include "fusilli/attributes/reduction_attributes.h"
+#include "fusilli/attributes/sdpa_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/node/conv_node.h"
+#include "fusilli/node/matmul_node.h"
+#include "fusilli/node/node.h"
+#include "fusilli/node/normalization_node.h"
+#include "fusilli/node/pointwise_node.h"
+#include "fusilli/node/reduction_node.h"
+#include "fusilli/node/sdpa_node.h"
+#include "fusilli/support/json.h"
+#include "fusilli/support/logging.h"
+#include "fusilli/support/tracing.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace fusilli {
+
+// Version of the description format, bumped on incompatible changes.
+inline constexpr int64_t kGraphDescriptionVersion = 1;
+
+// How nodes of type `NodeT` are described: the name of their type, and the
+// names of their input and output tensors, indexed by their keys.
+template <typename NodeT> struct NodeDescription;
+
+#define FUSILLI_DEFINE_NODE_DESCRIPTION(NODE, TYPE, INPUTS, OUTPUTS)           \
+  template <> struct NodeDescription<NODE> {                                   \
+    static constexpr std::string_view kType = TYPE;                            \
+    static constexpr auto kInputs = std::to_array<std::string_view> INPUTS;    \
+    static constexpr auto kOutputs = std::to_array<std::string_view> OUTPUTS;  \
+  };
+
+FUSILLI_DEFINE_NODE_DESCRIPTION(ConvFPropNode, "conv_fprop",
+                                ({"X", "W", "X_SCALE", "W_SCALE"}), ({"Y"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(ConvWGradNode, "conv_wgrad", ({"DY", "X"}),
+                                ({"DW"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(ConvDGradNode, "conv_dgrad", ({"DY", "W"}),
+                                ({"DX"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(MatmulNode, "matmul",
+                                ({"A", "B", "A_SCALE", "B_SCALE"}), ({"C"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(PointwiseNode, "pointwise",
+                                ({"IN_0", "IN_1", "IN_2"}), ({"OUT_0"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(BatchnormNode, "batchnorm",
+                                ({"X", "SCALE", "BIAS", "MEAN", "VAR"}),
+                                ({"Y", "SAVED_MEAN", "SAVED_INV_VARIANCE"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(LayernormNode, "layernorm",
+                                ({"X", "SCALE", "BIAS"}),
+                                ({"Y", "MEAN", "INV_VARIANCE"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(RmsnormNode, "rmsnorm", ({"X", "SCALE"}),
+                                ({"Y", "INV_RMS"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(ReductionNode, "reduction", ({"X"}), ({"Y"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(SoftmaxNode, "softmax", ({"X"}), ({"Y"}))
+FUSILLI_DEFINE_NODE_DESCRIPTION(SdpaNode, "sdpa", ({"Q", "K", "V", "MASK"}),
+                                ({"O"}))
+
+#undef FUSILLI_DEFINE_NODE_DESCRIPTION
+
+// Names of the alternatives of `TensorAttr::scalar_t`, in their order.
+inline constexpr std::array<std::string_view, 4> kScalarValueTypeNames = {
+    "int64", "int32", "float", "double"};
+
+// Indices of the tensors of a graph in its description.
+using TensorIds = std::unordered_map<std::shared_ptr<TensorAttr>, size_t>;
+
+//===----------------------------------------------------------------------===//
+// Serialization.
+//===----------------------------------------------------------------------===//
+
+// Returns `values` as a JSON array. Floating point values are written in
+// their shortest form that reads back exactly.
+template <typename T>
+inline std::string serializeList(const std::vector<T> &values) {
+  std::string json = "[";
+  for (size_t i = 0; i < values.size(); ++i)
+    json += std::format("{}{}", i == 0 ? "" : ", ", values[i]);
+  return json + "]";
+}
+
+inline std::string serializeTensor(const TensorAttr &tensor) {
+  std::string json = "{\"name\": " + quoteJson(tensor.getName());
+  if (tensor.getDataType() != DataType::NotSet)
+    json += ", \"data_type\": " +
+            quoteJson(kDataTypeToStr.at(tensor.getDataType()));
+  if (!tensor.getDim().empty())
+    json += ", \"dim\": " + serializeList(tensor.getDim());
+  if (!tensor.getStride().empty())
+    json += ", \"stride\": " + serializeList(tensor.getStride());
+  if (tensor.isDynamic())
+    json += ", \"dynamic_dims\": " + serializeList(tensor.getDynamicDims());
+  if (tensor.isVirtual())
+    json += ", \"virtual\": true";
+  if (tensor.isScalar())
+    json += ", \"scalar\": true";
+  if (auto value = tensor.getScalarValue()) {
+    json += std::format(
+        ", \"scalar_value\": {{{}: {}}}",
+        quoteJson(kScalarValueTypeNames[value->index()]),
+        std::visit([](auto v) { return std::format("{}", v); }, *value));
+  }
+  if (tensor.isConstant()) {
+    // Bytes of the data, in hex.
+    json += ", \"constant_data\": \"";
+    for (uint8_t byte : *tensor.getConstantData())
+      json += std::format("{:02x}", byte);
+    json += "\"";
+  }
+  return json + "}";
+}
+
+// Returns the input or output tensors of a node as a JSON object from the
+// names of their keys to their indices, in the order of their keys.
+template <typename MapT, size_t N>
+inline std::string
+serializeNodeTensors(const MapT &tensors,
+                     const std::array<std::string_view, N> &names,
+                     const TensorIds &ids) {
+  std::string json = "{";
+  for (size_t key = 0; key < N; ++key) {
+    auto it = tensors.find(static_cast<typename MapT::key_type>(key));
+    if (it == tensors.end() || !it->second)
+      continue;
+    json += std::format("{}{}: {}", json.size() == 1 ? "" : ", ",
+                        quoteJson(names[key]), ids.at(it->second));
+  }
+  return json + "}";
+}
+
+// Attributes of nodes other than their name, data type and tensors, as
+// members of the JSON object describing them.
+template <typename AttrT>
+inline std::string serializeConvFields(const AttrT &attr) {
+  return std::format(", \"padding\": {}, \"stride\": {}, \"dilation\": {}",
+                     serializeList(attr.getPadding()),
+                     serializeList(attr.getStride()),
+                     serializeList(attr.getDilation()));
+}
+
+template <typename AttrT>
+inline std::string serializeNormFields(const AttrT &attr) {
+  return std::format(", \"forward_phase\": {}, \"epsilon\": {}",
+                     quoteJson(kNormFwdPhaseToStr.at(attr.getForwardPhase())),
+                     attr.getEpsilon());
+}
+
+inline std::string serializeAttrFields(const ConvFPropAttr &attr) {
+  return serializeConvFields(attr) +
+         std::format(", \"direct_channels_last\": {}",
+                     attr.getDirectChannelsLast());
+}
+
+inline std::string serializeAttrFields(const ConvWGradAttr &attr) {
+  return serializeConvFields(attr) +
+         std::format(", \"split_reduction_factor\": {}",
+                     attr.getSplitReductionFactor());
+}
+
+inline std::string serializeAttrFields(const ConvDGradAttr &attr) {
+  return serializeConvFields(attr);
+}
+
+inline std::string serializeAttrFields(const MatmulAttr &attr) { return ""; }
+
+inline std::string serializeAttrFields(const PointwiseAttr &attr) {
+  std::string json =
+      ", \"mode\": " + quoteJson(PointwiseAttr::kModeToStr.at(attr.getMode()));
+  if (attr.getClampMin())
+    json += std::format(", \"clamp_min\": {}", *attr.getClampMin());
+  if (attr.getClampMax())
+    json += std::format(", \"clamp_max\": {}", *attr.getClampMax());
+  return json;
+}
+
+inline std::string serializeAttrFields(const BatchnormAttr &attr) {
+  return serializeNormFields(attr);
+}
+
+inline std::string serializeAttrFields(const LayernormAttr &attr) {
+  return serializeNormFields(attr);
+}
+
+inline std::string serializeAttrFields(const RmsnormAttr &attr) {
+  return serializeNormFields(attr);
+}
+
+inline std::string serializeAttrFields(const ReductionAttr &attr) {
+  return std::format(", \"mode\": {}, \"axes\": {}",
+                     quoteJson(ReductionAttr::kModeToStr.at(attr.getMode())),
+                     serializeList(attr.getAxes()));
+}
+
+inline std::string serializeAttrFields(const SoftmaxAttr &attr) {
+  if (!attr.getAxis())
+    return "";
+  return std::format(", \"axis\": {}", *attr.getAxis());
+}
+
+inline std::string serializeAttrFields(const SdpaAttr &attr) {
+  std::string json = std::format(", \"causal\": {}", attr.getCausal());
+  if (attr.getScale())
+    json += std::format(", \"scale\": {}", *attr.getScale());
+  return json;
+}
+
+template <typename NodeT>
+inline std::string serializeNode(const NodeT &node, const TensorIds &ids) {
+  using Description = NodeDescription<NodeT>;
+  const auto &attr = node.getAttr();
+  std::string json =
+      std::format("{{\"type\": {}, \"name\": {}", quoteJson(Description::kType),
+                  quoteJson(attr.getName()));
+  if (attr.computeDataType != DataType::NotSet)
+    json += ", \"compute_data_type\": " +
+            quoteJson(kDataTypeToStr.at(attr.computeDataType));
+  json += ", \"inputs\": " +
+          serializeNodeTensors(attr.inputs, Description::kInputs, ids);
+  json += ", \"outputs\": " +
+          serializeNodeTensors(attr.outputs, Description::kOutputs, ids);
+  return json + serializeAttrFields(attr) + "}";
+}
+
+inline ErrorOr<std::string> serializeSubNode(const INode &node,
+                                             const TensorIds &ids) {
+  switch (node.getType()) {
+  case INode::Type::Convolution:
+    return ok(serializeNode(static_cast<const ConvFPropNode &>(node), ids));
+  case INode::Type::WGrad:
+    return ok(serializeNode(static_cast<const ConvWGradNode &>(node), ids));
+  case INode::Type::DGrad:
+    return ok(serializeNode(static_cast<const ConvDGradNode &>(node), ids));
+  case INode::Type::Matmul:
+    return ok(serializeNode(static_cast<const MatmulNode &>(node), ids));
+  case INode::Type::Pointwise:
+    return ok(serializeNode(static_cast<const PointwiseNode &>(node), ids));
+  case INode::Type::Batchnorm:
+    return ok(serializeNode(static_cast<const BatchnormNode &>(node), ids));
+  case INode::Type::Layernorm:
+    return ok(serializeNode(static_cast<const LayernormNode &>(node), ids));
+  case INode::Type::Rmsnorm:
+    return ok(serializeNode(static_cast<const RmsnormNode &>(node), ids));
+  case INode::Type::Reduction:
+    return ok(serializeNode(static_cast<const ReductionNode &>(node), ids));
+  case INode::Type::Softmax:
+    return ok(serializeNode(static_cast<const SoftmaxNode &>(node), ids));
+  case INode::Type::Sdpa:
+    return ok(serializeNode(static_cast<const SdpaNode &>(node), ids));
+  default:
+    return error(ErrorCode::NotImplemented,
+                 "Node '" + node.getName() + "' cannot be serialized");
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Deserialization.
+//===----------------------------------------------------------------------===//
+
+// Reads `value` as a `T`: a bool, string, number or list of numbers.
+template <typename T>
+inline ErrorOr<T> deserializeValue(const JsonValue &value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return value.getBool();
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return value.getString();
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    return value.getNumber<T>();
+  } else {
+    FUSILLI_RETURN_ERROR_IF(value.getKind() != JsonValue::Kind::Array,
+                            ErrorCode::InvalidArgument,
+                            "JSON value is not an array");
+    T values;
+    for (const JsonValue &element : value.getArray())
+      values.push_back(
+          FUSILLI_TRY(deserializeValue<typename T::value_type>(element)));
+    return ok(std::move(values));
+  }
+}
+
+// Reads `value` as the enum named by it in `names`.
+template <typename EnumT>
+inline ErrorOr<EnumT>
+deserializeEnum(const JsonValue &value,
+                const std::unordered_map<EnumT, std::string> &names) {
+  std::string name = FUSILLI_TRY(value.getString());
+  for (const auto &[enumValue, enumName] : names)
+    if (enumName == name)
+      return ok(enumValue);
+  return error(ErrorCode::InvalidArgument,
+               "Unknown name '" + name + "' in graph description");
+}
+
+// Reads member `key` of `description` as a `T` and calls `set` with it, if
+// the description has the member.
+template <typename T, typename FnT>
+inline ErrorObject deserializeField(const JsonValue &description,
+                                    std::string_view key, FnT &&set) {
+  const JsonValue *value = description.find(key);
+  if (!value)
+    return ok();
+  set(FUSILLI_TRY(deserializeValue<T>(*value)));
+  return ok();
+}
+
+// As `deserializeField`, for the enum named by member `key` in `names`.
+template <typename EnumT, typename FnT>
+inline ErrorObject
+deserializeEnumField(const JsonValue &description, std::string_view key,
+                     const std::unordered_map<EnumT, std::string> &names,
+                     FnT &&set) {
+  const JsonValue *value = description.find(key);
+  if (!value)
+    return ok();
+  set(FUSILLI_TRY(deserializeEnum(*value, names)));
+  return ok();
+}
+
+inline ErrorOr<std::shared_ptr<TensorAttr>>
+deserializeTensorId(const JsonValue &id,
+                    const std::vector<std::shared_ptr<TensorAttr>> &tensors) {
+  size_t index = FUSILLI_TRY(id.getNumber<size_t>());
+  FUSILLI_RETURN_ERROR_IF(index >= tensors.size(), ErrorCode::InvalidArgument,
+                          std::format("Tensor {} is not in graph description",
+                                      index));
+  return ok(tensors[index]);
+}
+
+inline ErrorOr<std::shared_ptr<TensorAttr>>
+deserializeTensor(const JsonValue &description) {
+  FUSILLI_RETURN_ERROR_IF(description.getKind() != JsonValue::Kind::Object,
+                          ErrorCode::InvalidArgument,
+                          "Tensor description is not a JSON object");
+  auto tensor = std::make_shared<TensorAttr>();
+  if (const JsonValue *value = description.find("scalar_value")) {
+    FUSILLI_RETURN_ERROR_IF(value->getObject().size() != 1,
+                            ErrorCode::InvalidArgument,
+                            "Scalar value is not a JSON object of one member");
+    const auto &[typeName, number] = value->getObject().front();
+    if (typeName == kScalarValueTypeNames[0])
+      tensor = std::make_shared<TensorAttr>(
+          FUSILLI_TRY(number.getNumber<int64_t>()));
+    else if (typeName == kScalarValueTypeNames[1])
+      tensor = std::make_shared<TensorAttr>(
+          FUSILLI_TRY(number.getNumber<int32_t>()));
+    else if (typeName == kScalarValueTypeNames[2])
+      tensor =
+          std::make_shared<TensorAttr>(FUSILLI_TRY(number.getNumber<float>()));
+    else if (typeName == kScalarValueTypeNames[3])
+      tensor =
+          std::make_shared<TensorAttr>(FUSILLI_TRY(number.getNumber<double>()));
+    else
+      return error(ErrorCode::InvalidArgument,
+                   "Unknown scalar type '" + typeName + "'");
+  }
+  FUSILLI_CHECK_ERROR(deserializeField<std::string>(
+      description, "name", [&](const std::string &v) { tensor->setName(v); }));
+  FUSILLI_CHECK_ERROR(deserializeEnumField(
+      description, "data_type", kDataTypeToStr,
+      [&](DataType v) { tensor->setDataType(v); }));
+  FUSILLI_CHECK_ERROR(deserializeField<std::vector<int64_t>>(
+      description, "dim",
+      [&](const std::vector<int64_t> &v) { tensor->setDim(v); }));
+  FUSILLI_CHECK_ERROR(deserializeField<std::vector<int64_t>>(
+      description, "stride",
+      [&](const std::vector<int64_t> &v) { tensor->setStride(v); }));
+  FUSILLI_CHECK_ERROR(deserializeField<std::vector<size_t>>(
+      description, "dynamic_dims",
+      [&](const std::vector<size_t> &v) { tensor->setDynamicDims(v); }));
+  FUSILLI_CHECK_ERROR(deserializeField<bool>(
+      description, "virtual", [&](bool v) { tensor->setIsVirtual(v); }));
+  FUSILLI_CHECK_ERROR(deserializeField<bool>(
+      description, "scalar", [&](bool v) { tensor->setIsScalar(v); }));
+  if (const JsonValue *value = description.find("constant_data")) {
+    std::string hex = FUSILLI_TRY(value->getString());
+    FUSILLI_RETURN_ERROR_IF(hex.size() % 2 != 0, ErrorCode::InvalidArgument,
+                            "Constant data is not hex bytes");
+    auto data = std::make_shared<std::vector<uint8_t>>(hex.size() / 2);
+    for (size_t i = 0; i < data->size(); ++i) {
+      const char *begin = hex.data() + 2 * i;
+      auto [ptr, ec] = std::from_chars(begin, begin + 2, (*data)[i], 16);
+      FUSILLI_RETURN_ERROR_IF(ec != std::errc() || ptr != begin + 2,
+                              ErrorCode::InvalidArgument,
+                              "Constant data is not hex bytes");
+    }
+    tensor->setConstantData(std::move(data));
+  }
+  return ok(std::move(tensor));
+}
+
+// Sets the input or output tensors of a node from the JSON object `tensors`
+// of the names of their keys to their indices.
+template <typename MapT, size_t N>
+inline ErrorObject
+deserializeNodeTensors(const JsonValue *description,
+                       const std::array<std::string_view, N> &names,
+                       const std::vector<std::shared_ptr<TensorAttr>> &tensors,
+                       MapT &result) {
+  if (!description)
+    return ok();
+  for (const auto &[name, id] : description->getObject()) {
+    auto it = std::find(names.begin(), names.end(), name);
+    FUSILLI_RETURN_ERROR_IF(it == names.end(), ErrorCode::InvalidArgument,
+                            "Unknown node tensor '" + name +
+                                "' in graph description");
+    result[static_cast<typename MapT::key_type>(it - names.begin())] =
+        FUSILLI_TRY(deserializeTensorId(id, tensors));
+  }
+  return ok();
+}
+
+template <typename AttrT>
+inline ErrorObject deserializeConvFields(const JsonValue &description,
+                                         AttrT &attr) {
+  using DimsT = std::vector<int64_t>;
+  FUSILLI_CHECK_ERROR(deserializeField<DimsT>(
+      description, "padding", [&](const DimsT &v) { attr.setPadding(v); }));
+  FUSILLI_CHECK_ERROR(deserializeField<DimsT>(
+      description, "stride", [&](const DimsT &v) { attr.setStride(v); }));
+  return deserializeField<DimsT>(
+      description, "dilation", [&](const DimsT &v) { attr.setDilation(v); });
+}
+
+template <typename AttrT>
+inline ErrorObject deserializeNormFields(const JsonValue &description,
+                                         AttrT &attr) {
+  FUSILLI_CHECK_ERROR(deserializeEnumField(
+      description, "forward_phase", kNormFwdPhaseToStr,
+      [&](NormFwdPhase v) { attr.setForwardPhase(v); }));
+  return deserializeField<float>(description, "epsilon",
+                                 [&](float v) { attr.setEpsilon(v); });
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         ConvFPropAttr &attr) {
+  FUSILLI_CHECK_ERROR(deserializeConvFields(description, attr));
+  return deserializeField<bool>(description, "direct_channels_last",
+                                [&](bool v) { attr.setDirectChannelsLast(v); });
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         ConvWGradAttr &attr) {
+  FUSILLI_CHECK_ERROR(deserializeConvFields(description, attr));
+  return deserializeField<int64_t>(
+      description, "split_reduction_factor",
+      [&](int64_t v) { attr.setSplitReductionFactor(v); });
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         ConvDGradAttr &attr) {
+  return deserializeConvFields(description, attr);
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         MatmulAttr &attr) {
+  return ok();
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         PointwiseAttr &attr) {
+  FUSILLI_CHECK_ERROR(deserializeEnumField(
+      description, "mode", PointwiseAttr::kModeToStr,
+      [&](PointwiseAttr::Mode v) { attr.setMode(v); }));
+  FUSILLI_CHECK_ERROR(deserializeField<float>(
+      description, "clamp_min", [&](float v) { attr.setClampMin(v); }));
+  return deserializeField<float>(description, "clamp_max",
+                                 [&](float v) { attr.setClampMax(v); });
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         BatchnormAttr &attr) {
+  return deserializeNormFields(description, attr);
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         LayernormAttr &attr) {
+  return deserializeNormFields(description, attr);
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         RmsnormAttr &attr) {
+  return deserializeNormFields(description, attr);
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         ReductionAttr &attr) {
+  using AxesT = std::vector<int64_t>;
+  FUSILLI_CHECK_ERROR(deserializeEnumField(
+      description, "mode", ReductionAttr::kModeToStr,
+      [&](ReductionAttr::Mode v) { attr.setMode(v); }));
+  return deserializeField<AxesT>(description, "axes",
+                                 [&](const AxesT &v) { attr.setAxes(v); });
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         SoftmaxAttr &attr) {
+  return deserializeField<int64_t>(description, "axis",
+                                   [&](int64_t v) { attr.setAxis(v); });
+}
+
+inline ErrorObject deserializeAttrFields(const JsonValue &description,
+                                         SdpaAttr &attr) {
+  FUSILLI_CHECK_ERROR(deserializeField<bool>(
+      description, "causal", [&](bool v) { attr.setCausal(v); }));
+  return deserializeField<float>(description, "scale",
+                                 [&](float v) { attr.setScale(v); });
+}
+
+template <typename NodeT>
+inline ErrorOr<std::shared_ptr<INode>>
+deserializeNode(const JsonValue &description,
+                const std::vector<std::shared_ptr<TensorAttr>> &tensors,
+                const Context &context) {
+  using Description = NodeDescription<NodeT>;
+  std::decay_t<decltype(std::declval<const NodeT &>().getAttr())> attr;
+  FUSILLI_CHECK_ERROR(deserializeField<std::string>(
+      description, "name", [&](const std::string &v) { attr.setName(v); }));
+  FUSILLI_CHECK_ERROR(deserializeEnumField(
+      description, "compute_data_type", kDataTypeToStr,
+      [&](DataType v) { attr.setComputeDataType(v); }));
+  FUSILLI_CHECK_ERROR(deserializeNodeTensors(description.find("inputs"),
+                                             Description::kInputs, tensors,
+                                             attr.inputs));
+  FUSILLI_CHECK_ERROR(deserializeNodeTensors(description.find("outputs"),
+                                             Description::kOutputs, tensors,
+                                             attr.outputs));
+  FUSILLI_CHECK_ERROR(deserializeAttrFields(description, attr));
+  return ok(std::shared_ptr<INode>(
+      std::make_shared<NodeT>(std::move(attr), context)));
+}
+
+using NodeDeserializer = ErrorOr<std::shared_ptr<INode>> (*)(
+    const JsonValue &, const std::vector<std::shared_ptr<TensorAttr>> &,
+    const Context &);
+
+// Deserializers of nodes, by the names of their types.
+inline const std::unordered_map<std::string_view, NodeDeserializer>
+    kNodeDeserializers = {
+#define FUSILLI_NODE_DESERIALIZER(NODE)                                        \
+  {NodeDescription<NODE>::kType, &deserializeNode<NODE>},
+        FUSILLI_NODE_DESERIALIZER(ConvFPropNode)
+        FUSILLI_NODE_DESERIALIZER(ConvWGradNode)
+        FUSILLI_NODE_DESERIALIZER(ConvDGradNode)
+        FUSILLI_NODE_DESERIALIZER(MatmulNode)
+        FUSILLI_NODE_DESERIALIZER(PointwiseNode)
+        FUSILLI_NODE_DESERIALIZER(BatchnormNode)
+        FUSILLI_NODE_DESERIALIZER(LayernormNode)
+        FUSILLI_NODE_DESERIALIZER(RmsnormNode)
+        FUSILLI_NODE_DESERIALIZER(ReductionNode)
+        FUSILLI_NODE_DESERIALIZER(SoftmaxNode)
+        FUSILLI_NODE_DESERIALIZER(SdpaNode)
+#undef FUSILLI_NODE_DESERIALIZER
+};
+
+//===----------------------------------------------------------------------===//
+// Graph.
+//===----------------------------------------------------------------------===//
+
+inline ErrorOr<std::string> Graph::serialize() const {
+  FUSILLI_TRACE_SCOPE("Graph::serialize");
+
+  // Index the tensors in the order nodes use them, then the inputs and
+  // outputs of the graph that no node uses, by name.
+  std::vector<std::shared_ptr<TensorAttr>> tensors;
+  TensorIds ids;
+  auto addTensor = [&](const std::shared_ptr<TensorAttr> &tensor) {
+    if (ids.try_emplace(tensor, tensors.size()).second)
+      tensors.push_back(tensor);
+  };
+  for (const auto &node : subNodes_) {
+    for (const auto &input : node->getInputTensors())
+      addTensor(input);
+    for (const auto &output : node->getOutputTensors())
+      addTensor(output);
+  }
+  for (const auto *graphTensors : {&fullGraphInputs_, &fullGraphOutputs_}) {
+    std::vector<std::shared_ptr<TensorAttr>> sorted(graphTensors->begin(),
+                                                    graphTensors->end());
+    std::stable_sort(sorted.begin(), sorted.end(), TensorAttrSortByName());
+    for (const auto &tensor : sorted)
+      addTensor(tensor);
+  }
+  auto serializeIds = [&](const auto &graphTensors) {
+    std::vector<size_t> sorted;
+    for (const auto &tensor : graphTensors)
+      sorted.push_back(ids.at(tensor));
+    std::sort(sorted.begin(), sorted.end());
+    return serializeList(sorted);
+  };
+
+  std::string json = std::format("{{\n  \"version\": {},\n  \"name\": {},\n",
+                                 kGraphDescriptionVersion,
+                                 quoteJson(context.getName()));
+  for (const auto &[key, type] :
+       {std::pair{"io_data_type", context.getIODataType()},
+        std::pair{"intermediate_data_type", context.getIntermediateDataType()},
+        std::pair{"compute_data_type", context.getComputeDataType()}}) {
+    if (type != DataType::NotSet)
+      json += std::format("  \"{}\": {},\n", key,
+                          quoteJson(kDataTypeToStr.at(type)));
+  }
+  json += "  \"tensors\": [";
+  for (size_t i = 0; i < tensors.size(); ++i)
+    json += (i == 0 ? "\n    " : ",\n    ") + serializeTensor(*tensors[i]);
+  json += "\n  ],\n  \"inputs\": " + serializeIds(fullGraphInputs_);
+  json += ",\n  \"outputs\": " + serializeIds(fullGraphOutputs_);
+  json += ",\n  \"nodes\": [";
+  for (size_t i = 0; i < subNodes_.size(); ++i)
+    json += (i == 0 ? "\n    " : ",\n    ") +
+            FUSILLI_TRY(serializeSubNode(*subNodes_[i], ids));
+  return ok(json + "\n  ]\n}\n");
+}
+
+inline ErrorOr<Graph> Graph::deserialize(std::string_view description) {
+  FUSILLI_TRACE_SCOPE("Graph::deserialize");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Deserializing Graph");
+  JsonValue json = FUSILLI_TRY(JsonValue::parse(description));
+  const JsonValue *version = json.find("version");
+  FUSILLI_RETURN_ERROR_IF(!version, ErrorCode::InvalidArgument,
+                          "Graph description has no version");
+  int64_t versionNumber = FUSILLI_TRY(version->getNumber<int64_t>());
+  FUSILLI_RETURN_ERROR_IF(versionNumber != kGraphDescriptionVersion,
+                          ErrorCode::InvalidArgument,
+                          std::format("Graph description version {} is not "
+                                      "supported (expected {})",
+                                      versionNumber, kGraphDescriptionVersion));
+
+  Graph graph;
+  FUSILLI_CHECK_ERROR(deserializeField<std::string>(
+      json, "name", [&](const std::string &v) { graph.setName(v); }));
+  FUSILLI_CHECK_ERROR(deserializeEnumField(
+      json, "io_data_type", kDataTypeToStr,
+      [&](DataType v) { graph.setIODataType(v); }));
+  FUSILLI_CHECK_ERROR(deserializeEnumField(
+      json, "intermediate_data_type", kDataTypeToStr,
+      [&](DataType v) { graph.setIntermediateDataType(v); }));
+  FUSILLI_CHECK_ERROR(deserializeEnumField(
+      json, "compute_data_type", kDataTypeToStr,
+      [&](DataType v) { graph.setComputeDataType(v); }));
+
+  std::vector<std::shared_ptr<TensorAttr>> tensors;
+  if (const JsonValue *tensorDescriptions = json.find("tensors"))
+    for (const JsonValue &tensor : tensorDescriptions->getArray())
+      tensors.push_back(FUSILLI_TRY(deserializeTensor(tensor)));
+  for (auto [key, graphTensors] :
+       {std::pair{"inputs", &graph.fullGraphInputs_},
+        std::pair{"outputs", &graph.fullGraphOutputs_}}) {
+    if (const JsonValue *graphIds = json.find(key))
+      for (const JsonValue &id : graphIds->getArray())
+        graphTensors->insert(FUSILLI_TRY(deserializeTensorId(id, tensors)));
+  }
+
+  if (const JsonValue *nodes = json.find("nodes")) {
+    for (const JsonValue &node : nodes->getArray()) {
+      const JsonValue *type = node.find("type");
+      FUSILLI_RETURN_ERROR_IF(!type, ErrorCode::InvalidArgument,
+                              "Node description has no type");
+      std::string typeName = FUSILLI_TRY(type->getString());
+      auto it = kNodeDeserializers.find(typeName);
+      FUSILLI_RETURN_ERROR_IF(it == kNodeDeserializers.end(),
+                              ErrorCode::InvalidArgument,
+                              "Unknown node type '" + typeName +
+                                  "' in graph description");
+      graph.subNodes_.push_back(
+          FUSILLI_TRY(it->second(node, tensors, graph.context)));
+    }
+  }
+  return ok(std::move(graph));
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_SERIALIZATION_H
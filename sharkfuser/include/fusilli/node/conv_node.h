@@ -16,6 +16,7 @@
 
 #include "fusilli/attributes/conv_attributes.h"
 #include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
 #include "fusilli/graph/context.h"
 #include "fusilli/node/node.h"
 #include "fusilli/support/logging.h"
@@ -55,6 +56,20 @@ inline std::vector<int64_t> getConvInferredOutputShape(
   return yDim;
 }
 
+// Checks that only the batch dim (N) of `t` is dynamic, when `allowBatch`,
+// as the channels and spatial dims determine the convolution.
+inline ErrorObject checkConvDynamicDims(const std::shared_ptr<TensorAttr> &t,
+                                        bool allowBatch) {
+  constexpr size_t kBatchIdx = 0;
+  for (size_t idx : t->getDynamicDims())
+    FUSILLI_RETURN_ERROR_IF(!allowBatch || idx != kBatchIdx,
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + t->getName() +
+                                "' has a dynamic dim unsupported by conv (only "
+                                "the batch dim of activations may be dynamic)");
+  return ok();
+}
+
 //===----------------------------------------------------------------------===//
 // Convolution nodes.
 //===----------------------------------------------------------------------===//
@@ -79,11 +94,59 @@ public:
   std::string getPermuteXOpsAsm() const;
   std::string getPermuteWOpsAsm() const;
   std::string getPermuteYOpsAsm() const;
+  std::string getScaleOpsAsm() const;
+  std::string emitDirectChannelsLastAsm() const;
 
   const std::string &getName() const override final {
     return convFPropAttr.getName();
   }
   Type getType() const override final { return Type::Convolution; }
+  const ConvFPropAttr &getAttr() const { return convFPropAttr; }
+  ConvFPropAttr &getAttr() { return convFPropAttr; }
+
+  // The per-tensor scales X_SCALE and W_SCALE that are set.
+  std::vector<std::shared_ptr<TensorAttr>> getScales() const {
+    std::vector<std::shared_ptr<TensorAttr>> scales = {
+        convFPropAttr.getX_SCALE(), convFPropAttr.getW_SCALE()};
+    std::erase(scales, nullptr); // C++20
+    return scales;
+  }
+
+  // Whether the (validated) convolution is emitted directly on its
+  // channels-last tensors, see `ConvFPropAttr::setDirectChannelsLast`.
+  bool isDirectChannelsLast() const {
+    if (!convFPropAttr.getDirectChannelsLast())
+      return false;
+
+    std::shared_ptr<TensorAttr> xT = convFPropAttr.getX();
+    std::shared_ptr<TensorAttr> wT = convFPropAttr.getW();
+    std::shared_ptr<TensorAttr> yT = convFPropAttr.getY();
+    auto isFloat = [](DataType type) {
+      return type == DataType::Float || type == DataType::Half ||
+             type == DataType::BFloat16;
+    };
+    // Unit dims keep their logical position in the physical dims (see
+    // `TensorAttr::getPhysicalDim`), so e.g. the physical dims of a 1x1
+    // filter are not in KRSC order, and it takes the permute path.
+    auto isPhysicalNhwc = [](const std::shared_ptr<TensorAttr> &t) {
+      const std::vector<int64_t> &dim = t->getDim();
+      return t->isChannelsLast() &&
+             t->getPhysicalDim() ==
+                 std::vector<int64_t>{dim[0], dim[2], dim[3], dim[1]};
+    };
+    constexpr size_t channelsIdx = 1;
+    return xT->getDim().size() == 4 && !xT->isDynamic() &&
+           getScales().empty() && isPhysicalNhwc(xT) && isPhysicalNhwc(wT) &&
+           isPhysicalNhwc(yT) &&
+           xT->getDim()[channelsIdx] == wT->getDim()[channelsIdx] &&
+           isFloat(xT->getDataType()) &&
+           wT->getDataType() == xT->getDataType() &&
+           isFloat(yT->getDataType());
+  }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return convFPropAttr.fingerprint(INode::fingerprintNode(hash));
+  }
 
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ConvFPropNode '"
@@ -168,6 +231,22 @@ public:
         outChannels % groupCount != 0, ErrorCode::InvalidAttribute,
         "Conv output channels must be divisible by the group count");
 
+    // Dynamic dim checks on input and weight tensors.
+    FUSILLI_CHECK_ERROR(checkConvDynamicDims(xT, /*allowBatch=*/true));
+    FUSILLI_CHECK_ERROR(checkConvDynamicDims(wT, /*allowBatch=*/false));
+
+    // Per-tensor scale checks.
+    std::shared_ptr<TensorAttr> xScaleT = convFPropAttr.getX_SCALE();
+    std::shared_ptr<TensorAttr> wScaleT = convFPropAttr.getW_SCALE();
+    FUSILLI_RETURN_ERROR_IF(
+        xScaleT && (xScaleT->isDynamic() || xScaleT->getVolume() != 1),
+        ErrorCode::InvalidAttribute,
+        "Conv scale tensor X_SCALE must have a single element");
+    FUSILLI_RETURN_ERROR_IF(
+        wScaleT && (wScaleT->isDynamic() || wScaleT->getVolume() != 1),
+        ErrorCode::InvalidAttribute,
+        "Conv scale tensor W_SCALE must have a single element");
+
     return ok();
   }
 
@@ -198,6 +277,10 @@ public:
       yT->setDim(yDim);
     }
 
+    // The batch dim of the output is dynamic with that of the input.
+    if (!yT->isDynamic())
+      yT->setDynamicDims(xT->getDynamicDims());
+
     // Infer stride of output tensor.
     if (yStride.empty()) {
       // When unspecified, preserve the stride order of xT (input tensor).
@@ -240,6 +323,24 @@ public:
         ErrorCode::InvalidAttribute,
         "Conv output tensor Y dimensions do not match the expected shapes "
         "inferred based on the input and weight dimensions");
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDynamicDims() != xT->getDynamicDims(),
+        ErrorCode::InvalidAttribute,
+        "Conv output tensor Y dynamic dims do not match those of input X");
+
+    // Data type checks: fp8 inputs are convolved (accumulating in f32) into
+    // a wider output, scaled by their per-tensor scales when set.
+    DataType xType = xT->getDataType();
+    DataType wType = wT->getDataType();
+    FUSILLI_RETURN_ERROR_IF(
+        (isFP8DataType(xType) || isFP8DataType(wType)) && xType != wType,
+        ErrorCode::InvalidAttribute,
+        "Conv input tensor X and weight tensor W with fp8 data types must "
+        "have the same data type");
+    FUSILLI_RETURN_ERROR_IF(isFP8DataType(yT->getDataType()),
+                            ErrorCode::NotImplemented,
+                            "Conv output tensor Y with an fp8 data type is "
+                            "unsupported");
 
     // Contiguity check for output tensor.
     // When output strides are not specified, they are inferred and will be
@@ -276,11 +377,18 @@ public:
   std::string getPermuteXOpsAsm() const;
   std::string getPermuteDWOpsAsm() const;
   std::string getPermuteEmptyWOpsAsm() const;
+  std::string getSplitReductionOpsAsm() const;
 
   const std::string &getName() const override final {
     return convWGradAttr.getName();
   }
   Type getType() const override final { return Type::WGrad; }
+  const ConvWGradAttr &getAttr() const { return convWGradAttr; }
+  ConvWGradAttr &getAttr() { return convWGradAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return convWGradAttr.fingerprint(INode::fingerprintNode(hash));
+  }
 
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ConvWGradNode '"
@@ -364,6 +472,27 @@ public:
         outChannels % groupCount != 0, ErrorCode::InvalidAttribute,
         "ConvWGrad output (DY) channels must be divisible by the group count");
 
+    // Dynamic dim checks on input tensors (the weight gradient is static).
+    FUSILLI_CHECK_ERROR(checkConvDynamicDims(dyT, /*allowBatch=*/true));
+    FUSILLI_CHECK_ERROR(checkConvDynamicDims(xT, /*allowBatch=*/true));
+    FUSILLI_CHECK_ERROR(checkConvDynamicDims(dwT, /*allowBatch=*/false));
+    FUSILLI_RETURN_ERROR_IF(
+        dyT->getDynamicDims() != xT->getDynamicDims(),
+        ErrorCode::InvalidAttribute,
+        "ConvWGrad tensors DY and X have different dynamic dims");
+
+    // Split reduction checks (the batch is split in parts of equal size).
+    int64_t splitFactor = convWGradAttr.getSplitReductionFactor();
+    FUSILLI_RETURN_ERROR_IF(splitFactor < 1, ErrorCode::InvalidAttribute,
+                            "ConvWGrad split reduction factor must be at "
+                            "least 1");
+    FUSILLI_RETURN_ERROR_IF(
+        splitFactor > 1 && (xT->isDynamic() ||
+                            xT->getDim()[0] % splitFactor != 0),
+        ErrorCode::InvalidAttribute,
+        "ConvWGrad split reduction factor must divide the (static) batch "
+        "size");
+
     return ok();
   }
 
@@ -457,6 +586,12 @@ public:
     return convDGradAttr.getName();
   }
   Type getType() const override final { return Type::DGrad; }
+  const ConvDGradAttr &getAttr() const { return convDGradAttr; }
+  ConvDGradAttr &getAttr() { return convDGradAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return convDGradAttr.fingerprint(INode::fingerprintNode(hash));
+  }
 
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ConvDGradNode '"
@@ -538,6 +673,10 @@ public:
         outChannels % groupCount != 0, ErrorCode::InvalidAttribute,
         "ConvDGrad output (DY) channels must be divisible by the group count");
 
+    // Dynamic dim checks on input tensors.
+    FUSILLI_CHECK_ERROR(checkConvDynamicDims(dyT, /*allowBatch=*/true));
+    FUSILLI_CHECK_ERROR(checkConvDynamicDims(wT, /*allowBatch=*/false));
+
     return ok();
   }
 
@@ -567,6 +706,10 @@ public:
                     dxDim, getChannelsLastStrideOrder(dxDim.size())));
     }
 
+    // The batch dim of DX is dynamic with that of DY.
+    if (!dxT->isDynamic())
+      dxT->setDynamicDims(dyT->getDynamicDims());
+
     return ok();
   }
 
@@ -594,6 +737,10 @@ public:
         ErrorCode::InvalidAttribute,
         "ConvDGrad DY dimensions do not match the expected shapes inferred "
         "based on DX and W");
+    FUSILLI_RETURN_ERROR_IF(
+        dxT->getDynamicDims() != dyT->getDynamicDims(),
+        ErrorCode::InvalidAttribute,
+        "ConvDGrad tensor DX dynamic dims do not match those of DY");
 
     // Contiguity check for output tensor.
     FUSILLI_RETURN_ERROR_IF(!dxT->isContiguous() && !dxT->isChannelsLast(),
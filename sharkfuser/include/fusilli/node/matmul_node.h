@@ -0,0 +1,250 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the matrix multiplication node
+// `MatmulNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_MATMUL_NODE_H
+#define FUSILLI_NODE_MATMUL_NODE_H
+
+#include "fusilli/attributes/matmul_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+//===----------------------------------------------------------------------===//
+// Helper functions for matmul nodes.
+//===----------------------------------------------------------------------===//
+
+// Infer the output shape of a (batched) matrix multiplication of `aDim`
+// (B..., M, K) and `bDim` (B..., K, N) as (B..., M, N), where the batch dims
+// B... of the inputs are broadcast (right-aligned, as in PyTorch).
+inline ErrorOr<std::vector<int64_t>>
+getMatmulInferredOutputShape(const std::vector<int64_t> &aDim,
+                             const std::vector<int64_t> &bDim) {
+  std::vector<int64_t> aBatch(aDim.begin(), aDim.end() - 2);
+  std::vector<int64_t> bBatch(bDim.begin(), bDim.end() - 2);
+  std::vector<int64_t> cDim;
+  if (!aBatch.empty() || !bBatch.empty())
+    cDim = FUSILLI_TRY(computeBroadcastShape({aBatch, bBatch}));
+  cDim.push_back(aDim[aDim.size() - 2]);
+  cDim.push_back(bDim[bDim.size() - 1]);
+  return ok(std::move(cDim));
+}
+
+// Infer the dynamic dims of the output of a matrix multiplication from those
+// of its input A (B..., M, K): its batch dims (right-aligned in the output
+// dims) and M.
+inline std::vector<size_t>
+getMatmulInferredDynamicDims(const TensorAttr &aT, size_t cRank) {
+  size_t aRank = aT.getDim().size();
+  std::vector<size_t> dynamicDims;
+  for (size_t idx : aT.getDynamicDims())
+    dynamicDims.push_back(cRank - aRank + idx);
+  return dynamicDims;
+}
+
+//===----------------------------------------------------------------------===//
+// Matmul nodes.
+//===----------------------------------------------------------------------===//
+
+// A (batched) matrix multiplication C = A * B of A (B..., M, K) and
+// B (B..., K, N), with broadcast batch dims B... (see
+// `getMatmulInferredOutputShape`). Tensors may have any layout: transposed
+// operands (e.g. B stored as (B..., N, K)) are set by their strides, and
+// permuted to their logical dims in the emitted assembly, like the tensors of
+// pointwise nodes.
+class MatmulNode : public NodeCRTP<MatmulNode> {
+public:
+  MatmulAttr matmulAttr;
+
+  MatmulNode(MatmulAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), matmulAttr(std::move(attr)) {}
+
+  // MLIR assembly emitter helper methods.
+  std::string emitNodePreAsm() const override final;
+  std::string getOperandNamesAsm() const;
+  std::string getOperandTypesAsm() const;
+  std::string getResultNamesAsm() const;
+  std::string getResultTypesAsm() const;
+  std::string getPermuteAOpsAsm() const;
+  std::string getPermuteBOpsAsm() const;
+  std::string getPermuteCOpsAsm() const;
+  std::string getScaleOpsAsm() const;
+
+  const std::string &getName() const override final {
+    return matmulAttr.getName();
+  }
+  Type getType() const override final { return Type::Matmul; }
+  const MatmulAttr &getAttr() const { return matmulAttr; }
+  MatmulAttr &getAttr() { return matmulAttr; }
+
+  // The per-tensor scales A_SCALE and B_SCALE that are set.
+  std::vector<std::shared_ptr<TensorAttr>> getScales() const {
+    std::vector<std::shared_ptr<TensorAttr>> scales = {
+        matmulAttr.getA_SCALE(), matmulAttr.getB_SCALE()};
+    std::erase(scales, nullptr); // C++20
+    return scales;
+  }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return matmulAttr.fingerprint(INode::fingerprintNode(hash));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating MatmulNode '"
+                           << matmulAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
+    std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+    std::shared_ptr<TensorAttr> cT = matmulAttr.getC();
+
+    // Ensure input and output tensors are set.
+    FUSILLI_RETURN_ERROR_IF(!aT, ErrorCode::AttributeNotSet,
+                            "Matmul input tensor A not set");
+    FUSILLI_RETURN_ERROR_IF(!bT, ErrorCode::AttributeNotSet,
+                            "Matmul input tensor B not set");
+    FUSILLI_RETURN_ERROR_IF(!cT, ErrorCode::AttributeNotSet,
+                            "Matmul output tensor C not set");
+
+    const std::vector<int64_t> &aDim = aT->getDim();
+    const std::vector<int64_t> &bDim = bT->getDim();
+
+    // Rank checks on input tensors.
+    FUSILLI_RETURN_ERROR_IF(
+        aDim.size() < 2 || bDim.size() < 2, ErrorCode::InvalidAttribute,
+        "Matmul input tensors A and B must have a rank of at least 2");
+
+    // The contraction (K) dims must match and batch dims be broadcastable.
+    FUSILLI_RETURN_ERROR_IF(aDim[aDim.size() - 1] != bDim[bDim.size() - 2],
+                            ErrorCode::InvalidAttribute,
+                            "Matmul input tensors A and B have different "
+                            "contraction (K) dimensions");
+    FUSILLI_CHECK_ERROR(getMatmulInferredOutputShape(aDim, bDim));
+
+    // Dynamic dim checks on input tensors: the batch dims and M of A may be
+    // dynamic, where B does not have a batch dim other than 1 to broadcast
+    // with.
+    FUSILLI_RETURN_ERROR_IF(bT->isDynamic(), ErrorCode::NotImplemented,
+                            "Tensor '" + bT->getName() +
+                                "' has a dynamic dim unsupported by matmul "
+                                "(only the batch and M dims of A may be "
+                                "dynamic)");
+    size_t kIdx = aDim.size() - 1;
+    size_t mIdx = aDim.size() - 2;
+    for (size_t idx : aT->getDynamicDims()) {
+      // Batch dims of A are broadcast (right-aligned) with those of B.
+      bool broadcastWithB = idx == mIdx || aDim.size() - idx > bDim.size() ||
+                            bDim[bDim.size() - (aDim.size() - idx)] == 1;
+      FUSILLI_RETURN_ERROR_IF(idx == kIdx || !broadcastWithB,
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + aT->getName() +
+                                  "' has a dynamic dim unsupported by matmul "
+                                  "(only the batch and M dims of A may be "
+                                  "dynamic)");
+    }
+
+    // Per-tensor scale checks.
+    std::shared_ptr<TensorAttr> aScaleT = matmulAttr.getA_SCALE();
+    std::shared_ptr<TensorAttr> bScaleT = matmulAttr.getB_SCALE();
+    FUSILLI_RETURN_ERROR_IF(
+        aScaleT && (aScaleT->isDynamic() || aScaleT->getVolume() != 1),
+        ErrorCode::InvalidAttribute,
+        "Matmul scale tensor A_SCALE must have a single element");
+    FUSILLI_RETURN_ERROR_IF(
+        bScaleT && (bScaleT->isDynamic() || bScaleT->getVolume() != 1),
+        ErrorCode::InvalidAttribute,
+        "Matmul scale tensor B_SCALE must have a single element");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for MatmulNode '"
+                           << matmulAttr.getName() << "'");
+
+    matmulAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
+    std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+    std::shared_ptr<TensorAttr> cT = matmulAttr.getC();
+
+    // Infer shape of output tensor.
+    if (cT->getDim().empty())
+      cT->setDim(FUSILLI_TRY(
+          getMatmulInferredOutputShape(aT->getDim(), bT->getDim())));
+
+    // The batch and M dims of the output are dynamic with those of A.
+    if (!cT->isDynamic())
+      cT->setDynamicDims(
+          getMatmulInferredDynamicDims(*aT, cT->getDim().size()));
+
+    // Infer stride of output tensor: contiguous (row-major) when unspecified.
+    if (cT->getStride().empty()) {
+      const std::vector<int64_t> &cDim = cT->getDim();
+      cT->setStride(
+          generateStrideFromDim(cDim, getContiguousStrideOrder(cDim.size())));
+    }
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating MatmulNode '"
+                           << matmulAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
+    std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+    std::shared_ptr<TensorAttr> cT = matmulAttr.getC();
+
+    std::vector<int64_t> cDim =
+        FUSILLI_TRY(getMatmulInferredOutputShape(aT->getDim(), bT->getDim()));
+    FUSILLI_RETURN_ERROR_IF(
+        cT->getDim() != cDim, ErrorCode::InvalidAttribute,
+        "Matmul output tensor C dimensions do not match the expected shapes "
+        "inferred based on the input dimensions");
+    FUSILLI_RETURN_ERROR_IF(
+        cT->getDynamicDims() !=
+            getMatmulInferredDynamicDims(*aT, cT->getDim().size()),
+        ErrorCode::InvalidAttribute,
+        "Matmul output tensor C dynamic dims do not match those of input A");
+
+    // Data type checks: fp8 inputs are multiplied (accumulating in f32) into
+    // a wider output, scaled by their per-tensor scales when set.
+    DataType aType = aT->getDataType();
+    DataType bType = bT->getDataType();
+    FUSILLI_RETURN_ERROR_IF(
+        (isFP8DataType(aType) || isFP8DataType(bType)) && aType != bType,
+        ErrorCode::InvalidAttribute,
+        "Matmul input tensors A and B with fp8 data types must have the same "
+        "data type");
+    FUSILLI_RETURN_ERROR_IF(isFP8DataType(cT->getDataType()),
+                            ErrorCode::NotImplemented,
+                            "Matmul output tensor C with an fp8 data type is "
+                            "unsupported");
+
+    return ok();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_MATMUL_NODE_H
@@ -14,14 +14,18 @@
 #ifndef FUSILLI_NODE_NODE_H
 #define FUSILLI_NODE_NODE_H
 
+#include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/graph/context.h"
+#include "fusilli/support/extras.h"
 #include "fusilli/support/logging.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
-#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace fusilli {
@@ -34,6 +38,13 @@ public:
     Pointwise,
     WGrad,
     DGrad,
+    Matmul,
+    Batchnorm,
+    Layernorm,
+    Rmsnorm,
+    Reduction,
+    Softmax,
+    Sdpa,
   };
 
   explicit INode(const Context &ctx) : context(ctx) {}
@@ -42,6 +53,33 @@ public:
   virtual const std::string &getName() const = 0;
   virtual Type getType() const = 0;
 
+  // Tensors read and written by the node (excluding sub nodes), and the
+  // rewiring of its inputs, for the graph passes of `Graph::optimize`.
+  virtual std::vector<std::shared_ptr<TensorAttr>> getInputTensors() const {
+    return {};
+  }
+  virtual std::vector<std::shared_ptr<TensorAttr>> getOutputTensors() const {
+    return {};
+  }
+  virtual void replaceInputTensor(const std::shared_ptr<TensorAttr> &from,
+                                  const std::shared_ptr<TensorAttr> &to) {}
+
+  // Returns a copy of the node (excluding sub nodes) reading and writing the
+  // tensors that `tensors` maps its own to, for `Graph::cloneWithDims`. Null
+  // for nodes that cannot be copied.
+  virtual std::shared_ptr<INode> cloneNode(
+      const std::unordered_map<std::shared_ptr<TensorAttr>,
+                               std::shared_ptr<TensorAttr>> &tensors) const {
+    return nullptr;
+  }
+
+  // Hashes what the node computes from its inputs into `hash`: like
+  // `fingerprintNode`, but leaving out the names of the node and of its
+  // outputs, so that nodes computing the same values hash the same.
+  virtual uint64_t fingerprintOperation(uint64_t hash) const {
+    return fingerprintNode(hash);
+  }
+
   Context context;
 
 protected:
@@ -64,24 +102,56 @@ protected:
   virtual std::string emitNodePreAsm() const { return ""; };
   virtual std::string emitNodePostAsm() const { return ""; };
 
+  // Hashes what the MLIR assembly of the node (excluding sub nodes) is
+  // emitted from into `hash`, to be overridden by nodes emitting more than
+  // their type.
+  virtual uint64_t fingerprintNode(uint64_t hash) const {
+    return fnv1aHashValue(getType(), hash);
+  }
+
   // Recursively validate the node and its sub nodes.
   ErrorObject validateSubtree() {
     FUSILLI_CHECK_ERROR(preValidateNode());
     FUSILLI_CHECK_ERROR(inferPropertiesNode());
+    FUSILLI_CHECK_ERROR(validateSubNodes());
+    FUSILLI_CHECK_ERROR(postValidateNode());
+    return ok();
+  }
+
+  // Recursively validate the sub nodes of the node.
+  ErrorObject validateSubNodes() {
     for (const auto &subNode : subNodes_)
       FUSILLI_CHECK_ERROR(subNode->validateSubtree());
-    FUSILLI_CHECK_ERROR(postValidateNode());
     return ok();
   }
 
   // Recursively emit MLIR assembly for the node and its sub nodes
   // allowing for composite ops to expand into their own regions
-  // containing sub ops.
-  void emitAsmSubtree(std::ostringstream &oss) {
-    oss << emitNodePreAsm();
+  // containing sub ops. The assembly is appended to the single buffer `asm_`
+  // shared by the whole subtree.
+  void emitAsmSubtree(std::string &asm_) {
+    asm_ += emitNodePreAsm();
+    for (const auto &subNode : subNodes_)
+      subNode->emitAsmSubtree(asm_);
+    asm_ += emitNodePostAsm();
+  }
+
+  // Number of nodes in the subtree (including this node).
+  size_t getSubtreeSize() const {
+    size_t size = 1;
     for (const auto &subNode : subNodes_)
-      subNode->emitAsmSubtree(oss);
-    oss << emitNodePostAsm();
+      size += subNode->getSubtreeSize();
+    return size;
+  }
+
+  // Recursively hash the node and its sub nodes, a cheap stand-in for their
+  // MLIR assembly: nodes with the same fingerprint emit the same assembly.
+  uint64_t fingerprintSubtree(uint64_t hash) const {
+    hash = fingerprintNode(hash);
+    hash = fnv1aHashValue(subNodes_.size(), hash);
+    for (const auto &subNode : subNodes_)
+      hash = subNode->fingerprintSubtree(hash);
+    return hash;
   }
 
   // Recursively check that names of nodes and their sub nodes
@@ -103,7 +173,49 @@ protected:
 
 // It uses the CRTP pattern (aka F-bound polymorphism):
 // https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern
+//
+// Derived classes provide `getAttr()`, returning their attributes.
 template <typename DerivedT> class NodeCRTP : public INode {
+public:
+  std::vector<std::shared_ptr<TensorAttr>>
+  getInputTensors() const override final {
+    return self().getAttr().getInputTensors();
+  }
+
+  std::vector<std::shared_ptr<TensorAttr>>
+  getOutputTensors() const override final {
+    return self().getAttr().getOutputTensors();
+  }
+
+  void
+  replaceInputTensor(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    self().getAttr().replaceInputTensor(from, to);
+  }
+
+  std::shared_ptr<INode> cloneNode(
+      const std::unordered_map<std::shared_ptr<TensorAttr>,
+                               std::shared_ptr<TensorAttr>> &tensors)
+      const override final {
+    auto attr = self().getAttr();
+    attr.replaceTensors(tensors);
+    return std::make_shared<DerivedT>(std::move(attr), context);
+  }
+
+  uint64_t fingerprintOperation(uint64_t hash) const override final {
+    auto attr = self().getAttr();
+    attr.setName("");
+    attr.outputs.clear();
+    hash = attr.fingerprint(fnv1aHashValue(getType(), hash));
+    for (const auto &output : getOutputTensors()) {
+      hash = fnv1aHashValue(output->getDataType(), hash);
+      hash = fnv1aHashValue(output->getDim().size(), hash);
+      for (int64_t dim : output->getDim())
+        hash = fnv1aHashValue(dim, hash);
+    }
+    return hash;
+  }
+
 protected:
   // Allow derived NodeCRTP classes to use the INode constructor
   using INode::INode;
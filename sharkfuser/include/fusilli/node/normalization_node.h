@@ -0,0 +1,485 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the normalization nodes
+// `BatchnormNode`, `LayernormNode` and `RmsnormNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_NORMALIZATION_NODE_H
+#define FUSILLI_NODE_NORMALIZATION_NODE_H
+
+#include "fusilli/attributes/normalization_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+//===----------------------------------------------------------------------===//
+// Helper functions for normalization nodes.
+//===----------------------------------------------------------------------===//
+
+// Dims of the per-channel tensors (scale, bias and statistics) of a batchnorm
+// over `xDim` (N, C, ...): (1, C, 1, ...).
+inline std::vector<int64_t>
+getBatchnormChannelDim(const std::vector<int64_t> &xDim) {
+  std::vector<int64_t> dim(xDim.size(), 1);
+  dim[1] = xDim[1];
+  return dim;
+}
+
+// Dims of the scale (and bias) of a layernorm or RMSNorm over `xDim` (N, ...):
+// (1, ...), i.e. those of a single sample.
+inline std::vector<int64_t>
+getNormSampleParamDim(const std::vector<int64_t> &xDim) {
+  std::vector<int64_t> dim = xDim;
+  dim[0] = 1;
+  return dim;
+}
+
+// Dims of the per-sample statistics of a layernorm or RMSNorm over `xDim`
+// (N, ...): (N, 1, ...).
+inline std::vector<int64_t>
+getNormSampleStatsDim(const std::vector<int64_t> &xDim) {
+  std::vector<int64_t> dim(xDim.size(), 1);
+  dim[0] = xDim[0];
+  return dim;
+}
+
+// Dims a normalization of a rank `rank` input reduces over to compute its
+// statistics: all but `keptDim` (the channel dim 1 for batchnorm, the batch
+// dim 0 for layernorm and RMSNorm).
+inline std::vector<int64_t> getNormReductionDims(size_t rank, size_t keptDim) {
+  std::vector<int64_t> dims;
+  for (size_t i = 0; i < rank; ++i)
+    if (i != keptDim)
+      dims.push_back(static_cast<int64_t>(i));
+  return dims;
+}
+
+// Checks that the tensor `t` of a normalization node, described by `desc`
+// (e.g. "Batchnorm input tensor SCALE") in errors, is set with the static
+// dims `dim`.
+inline ErrorObject checkNormTensor(const std::shared_ptr<TensorAttr> &t,
+                                   const std::vector<int64_t> &dim,
+                                   const std::string &desc) {
+  FUSILLI_RETURN_ERROR_IF(!t, ErrorCode::AttributeNotSet, desc + " not set");
+  FUSILLI_RETURN_ERROR_IF(t->getDim() != dim, ErrorCode::InvalidAttribute,
+                          desc + " dimensions do not match the expected "
+                                 "shape inferred from input tensor X");
+  FUSILLI_RETURN_ERROR_IF(t->isDynamic(), ErrorCode::NotImplemented,
+                          desc + " has a dynamic dim unsupported by "
+                                 "normalization nodes");
+  return ok();
+}
+
+// Checks that the tensor `t` (if set) of a normalization node, described by
+// `desc` in errors, has the data type of its input X.
+inline ErrorObject checkNormTensorDataType(const std::shared_ptr<TensorAttr> &t,
+                                           const TensorAttr &xT,
+                                           const std::string &desc) {
+  FUSILLI_RETURN_ERROR_IF(t && t->getDataType() != xT.getDataType(),
+                          ErrorCode::InvalidAttribute,
+                          desc + " data type does not match that of input "
+                                 "tensor X");
+  return ok();
+}
+
+// Infers the dims (if unset) of the statistics tensor `t` of a normalization
+// node as `dim`, with a contiguous stride, and its data type as that of X,
+// which they are computed in.
+inline void inferNormStatsProperties(const std::shared_ptr<TensorAttr> &t,
+                                     const std::vector<int64_t> &dim,
+                                     const TensorAttr &xT) {
+  if (!t)
+    return;
+  if (t->getDataType() == DataType::NotSet)
+    t->setDataType(xT.getDataType());
+  if (t->getDim().empty())
+    t->setDim(dim);
+  if (t->getStride().empty())
+    t->setStride(generateStrideFromDim(t->getDim(),
+                                       getContiguousStrideOrder(dim.size())));
+}
+
+// Infers the dims and stride (if unset) of the output Y of a normalization
+// node as those of its input X.
+inline void inferNormOutputProperties(const std::shared_ptr<TensorAttr> &yT,
+                                      const TensorAttr &xT) {
+  if (yT->getDim().empty())
+    yT->setDim(xT.getDim());
+  if (yT->getStride().empty())
+    yT->setStride(xT.getStride());
+}
+
+//===----------------------------------------------------------------------===//
+// Normalization nodes.
+//===----------------------------------------------------------------------===//
+
+// Tensors of normalization nodes may have any layout, and are permuted to
+// their logical dims in the emitted assembly, like the tensors of pointwise
+// nodes. The normalizations are emitted as reductions and elementwise ops, so
+// that the elementwise ops of a batchnorm in INFERENCE may be fused with a
+// preceding convolution (or matmul) and a following activation.
+class BatchnormNode : public NodeCRTP<BatchnormNode> {
+public:
+  BatchnormAttr batchnormAttr;
+
+  BatchnormNode(BatchnormAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), batchnormAttr(std::move(attr)) {}
+
+  // MLIR assembly emitter helper methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return batchnormAttr.getName();
+  }
+  Type getType() const override final { return Type::Batchnorm; }
+  const BatchnormAttr &getAttr() const { return batchnormAttr; }
+  BatchnormAttr &getAttr() { return batchnormAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return batchnormAttr.fingerprint(INode::fingerprintNode(hash));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating BatchnormNode '"
+                           << batchnormAttr.getName() << "'");
+
+    NormFwdPhase phase = batchnormAttr.getForwardPhase();
+    FUSILLI_RETURN_ERROR_IF(phase == NormFwdPhase::NOT_SET,
+                            ErrorCode::AttributeNotSet,
+                            "Batchnorm forward phase not set");
+
+    std::shared_ptr<TensorAttr> xT = batchnormAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Batchnorm input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!batchnormAttr.getY(), ErrorCode::AttributeNotSet,
+                            "Batchnorm output tensor Y not set");
+    FUSILLI_RETURN_ERROR_IF(xT->getDim().size() < 2,
+                            ErrorCode::InvalidAttribute,
+                            "Batchnorm input tensor X must have a rank of at "
+                            "least 2");
+    FUSILLI_RETURN_ERROR_IF(xT->isDynamic(), ErrorCode::NotImplemented,
+                            "Batchnorm input tensor X has a dynamic dim "
+                            "unsupported by normalization nodes");
+
+    std::vector<int64_t> channelDim = getBatchnormChannelDim(xT->getDim());
+    FUSILLI_CHECK_ERROR(checkNormTensor(batchnormAttr.getSCALE(), channelDim,
+                                        "Batchnorm input tensor SCALE"));
+    FUSILLI_CHECK_ERROR(checkNormTensor(batchnormAttr.getBIAS(), channelDim,
+                                        "Batchnorm input tensor BIAS"));
+
+    // INFERENCE normalizes with the running statistics, TRAINING with those
+    // of the batch, which it outputs.
+    bool isTraining = phase == NormFwdPhase::TRAINING;
+    if (!isTraining) {
+      FUSILLI_CHECK_ERROR(checkNormTensor(batchnormAttr.getMEAN(), channelDim,
+                                          "Batchnorm input tensor MEAN"));
+      FUSILLI_CHECK_ERROR(checkNormTensor(batchnormAttr.getVAR(), channelDim,
+                                          "Batchnorm input tensor VAR"));
+    }
+    FUSILLI_RETURN_ERROR_IF(
+        isTraining && (batchnormAttr.getMEAN() || batchnormAttr.getVAR()),
+        ErrorCode::InvalidAttribute,
+        "Batchnorm input tensors MEAN and VAR are only used in INFERENCE");
+    FUSILLI_RETURN_ERROR_IF(
+        isTraining != (batchnormAttr.getSAVED_MEAN() != nullptr) ||
+            isTraining != (batchnormAttr.getSAVED_INV_VARIANCE() != nullptr),
+        ErrorCode::InvalidAttribute,
+        "Batchnorm output tensors SAVED_MEAN and SAVED_INV_VARIANCE must be "
+        "set in TRAINING (only)");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for BatchnormNode '"
+                           << batchnormAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = batchnormAttr.getX();
+    xT->fillFromContext(context);
+
+    std::vector<int64_t> channelDim = getBatchnormChannelDim(xT->getDim());
+    inferNormStatsProperties(batchnormAttr.getSAVED_MEAN(), channelDim, *xT);
+    inferNormStatsProperties(batchnormAttr.getSAVED_INV_VARIANCE(), channelDim,
+                             *xT);
+
+    batchnormAttr.fillFromContext(context);
+    inferNormOutputProperties(batchnormAttr.getY(), *xT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating BatchnormNode '"
+                           << batchnormAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = batchnormAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(
+        batchnormAttr.getY()->getDim() != xT->getDim(),
+        ErrorCode::InvalidAttribute,
+        "Batchnorm output tensor Y dimensions do not match those of input "
+        "tensor X");
+
+    std::vector<int64_t> channelDim = getBatchnormChannelDim(xT->getDim());
+    if (batchnormAttr.getForwardPhase() == NormFwdPhase::TRAINING) {
+      FUSILLI_CHECK_ERROR(checkNormTensor(batchnormAttr.getSAVED_MEAN(),
+                                          channelDim,
+                                          "Batchnorm output tensor "
+                                          "SAVED_MEAN"));
+      FUSILLI_CHECK_ERROR(checkNormTensor(batchnormAttr.getSAVED_INV_VARIANCE(),
+                                          channelDim,
+                                          "Batchnorm output tensor "
+                                          "SAVED_INV_VARIANCE"));
+    }
+
+    // Statistics are computed in the data type of X.
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        batchnormAttr.getSCALE(), *xT, "Batchnorm input tensor SCALE"));
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        batchnormAttr.getBIAS(), *xT, "Batchnorm input tensor BIAS"));
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        batchnormAttr.getMEAN(), *xT, "Batchnorm input tensor MEAN"));
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(batchnormAttr.getVAR(), *xT,
+                                                "Batchnorm input tensor VAR"));
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        batchnormAttr.getSAVED_MEAN(), *xT,
+        "Batchnorm output tensor SAVED_MEAN"));
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        batchnormAttr.getSAVED_INV_VARIANCE(), *xT,
+        "Batchnorm output tensor SAVED_INV_VARIANCE"));
+
+    return ok();
+  }
+};
+
+class LayernormNode : public NodeCRTP<LayernormNode> {
+public:
+  LayernormAttr layernormAttr;
+
+  LayernormNode(LayernormAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), layernormAttr(std::move(attr)) {}
+
+  // MLIR assembly emitter helper methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return layernormAttr.getName();
+  }
+  Type getType() const override final { return Type::Layernorm; }
+  const LayernormAttr &getAttr() const { return layernormAttr; }
+  LayernormAttr &getAttr() { return layernormAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return layernormAttr.fingerprint(INode::fingerprintNode(hash));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating LayernormNode '"
+                           << layernormAttr.getName() << "'");
+
+    NormFwdPhase phase = layernormAttr.getForwardPhase();
+    FUSILLI_RETURN_ERROR_IF(phase == NormFwdPhase::NOT_SET,
+                            ErrorCode::AttributeNotSet,
+                            "Layernorm forward phase not set");
+
+    std::shared_ptr<TensorAttr> xT = layernormAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Layernorm input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!layernormAttr.getY(), ErrorCode::AttributeNotSet,
+                            "Layernorm output tensor Y not set");
+    FUSILLI_RETURN_ERROR_IF(xT->getDim().size() < 2,
+                            ErrorCode::InvalidAttribute,
+                            "Layernorm input tensor X must have a rank of at "
+                            "least 2");
+    FUSILLI_RETURN_ERROR_IF(xT->isDynamic(), ErrorCode::NotImplemented,
+                            "Layernorm input tensor X has a dynamic dim "
+                            "unsupported by normalization nodes");
+
+    std::vector<int64_t> paramDim = getNormSampleParamDim(xT->getDim());
+    FUSILLI_CHECK_ERROR(checkNormTensor(layernormAttr.getSCALE(), paramDim,
+                                        "Layernorm input tensor SCALE"));
+    FUSILLI_CHECK_ERROR(checkNormTensor(layernormAttr.getBIAS(), paramDim,
+                                        "Layernorm input tensor BIAS"));
+
+    bool isTraining = phase == NormFwdPhase::TRAINING;
+    FUSILLI_RETURN_ERROR_IF(
+        isTraining != (layernormAttr.getMEAN() != nullptr) ||
+            isTraining != (layernormAttr.getINV_VARIANCE() != nullptr),
+        ErrorCode::InvalidAttribute,
+        "Layernorm output tensors MEAN and INV_VARIANCE must be set in "
+        "TRAINING (only)");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for LayernormNode '"
+                           << layernormAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = layernormAttr.getX();
+    xT->fillFromContext(context);
+
+    std::vector<int64_t> statsDim = getNormSampleStatsDim(xT->getDim());
+    inferNormStatsProperties(layernormAttr.getMEAN(), statsDim, *xT);
+    inferNormStatsProperties(layernormAttr.getINV_VARIANCE(), statsDim, *xT);
+
+    layernormAttr.fillFromContext(context);
+    inferNormOutputProperties(layernormAttr.getY(), *xT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating LayernormNode '"
+                           << layernormAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = layernormAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(
+        layernormAttr.getY()->getDim() != xT->getDim(),
+        ErrorCode::InvalidAttribute,
+        "Layernorm output tensor Y dimensions do not match those of input "
+        "tensor X");
+
+    std::vector<int64_t> statsDim = getNormSampleStatsDim(xT->getDim());
+    if (layernormAttr.getForwardPhase() == NormFwdPhase::TRAINING) {
+      FUSILLI_CHECK_ERROR(checkNormTensor(layernormAttr.getMEAN(), statsDim,
+                                          "Layernorm output tensor MEAN"));
+      FUSILLI_CHECK_ERROR(checkNormTensor(layernormAttr.getINV_VARIANCE(),
+                                          statsDim,
+                                          "Layernorm output tensor "
+                                          "INV_VARIANCE"));
+    }
+
+    // Statistics are computed in the data type of X.
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        layernormAttr.getSCALE(), *xT, "Layernorm input tensor SCALE"));
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        layernormAttr.getBIAS(), *xT, "Layernorm input tensor BIAS"));
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        layernormAttr.getMEAN(), *xT, "Layernorm output tensor MEAN"));
+    FUSILLI_CHECK_ERROR(
+        checkNormTensorDataType(layernormAttr.getINV_VARIANCE(), *xT,
+                                "Layernorm output tensor INV_VARIANCE"));
+
+    return ok();
+  }
+};
+
+class RmsnormNode : public NodeCRTP<RmsnormNode> {
+public:
+  RmsnormAttr rmsnormAttr;
+
+  RmsnormNode(RmsnormAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), rmsnormAttr(std::move(attr)) {}
+
+  // MLIR assembly emitter helper methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return rmsnormAttr.getName();
+  }
+  Type getType() const override final { return Type::Rmsnorm; }
+  const RmsnormAttr &getAttr() const { return rmsnormAttr; }
+  RmsnormAttr &getAttr() { return rmsnormAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return rmsnormAttr.fingerprint(INode::fingerprintNode(hash));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating RmsnormNode '"
+                           << rmsnormAttr.getName() << "'");
+
+    NormFwdPhase phase = rmsnormAttr.getForwardPhase();
+    FUSILLI_RETURN_ERROR_IF(phase == NormFwdPhase::NOT_SET,
+                            ErrorCode::AttributeNotSet,
+                            "RMSNorm forward phase not set");
+
+    std::shared_ptr<TensorAttr> xT = rmsnormAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "RMSNorm input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!rmsnormAttr.getY(), ErrorCode::AttributeNotSet,
+                            "RMSNorm output tensor Y not set");
+    FUSILLI_RETURN_ERROR_IF(xT->getDim().size() < 2,
+                            ErrorCode::InvalidAttribute,
+                            "RMSNorm input tensor X must have a rank of at "
+                            "least 2");
+    FUSILLI_RETURN_ERROR_IF(xT->isDynamic(), ErrorCode::NotImplemented,
+                            "RMSNorm input tensor X has a dynamic dim "
+                            "unsupported by normalization nodes");
+
+    FUSILLI_CHECK_ERROR(checkNormTensor(rmsnormAttr.getSCALE(),
+                                        getNormSampleParamDim(xT->getDim()),
+                                        "RMSNorm input tensor SCALE"));
+
+    bool isTraining = phase == NormFwdPhase::TRAINING;
+    FUSILLI_RETURN_ERROR_IF(isTraining != (rmsnormAttr.getINV_RMS() != nullptr),
+                            ErrorCode::InvalidAttribute,
+                            "RMSNorm output tensor INV_RMS must be set in "
+                            "TRAINING (only)");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for RmsnormNode '"
+                           << rmsnormAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = rmsnormAttr.getX();
+    xT->fillFromContext(context);
+
+    inferNormStatsProperties(rmsnormAttr.getINV_RMS(),
+                             getNormSampleStatsDim(xT->getDim()), *xT);
+
+    rmsnormAttr.fillFromContext(context);
+    inferNormOutputProperties(rmsnormAttr.getY(), *xT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating RmsnormNode '"
+                           << rmsnormAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = rmsnormAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(
+        rmsnormAttr.getY()->getDim() != xT->getDim(),
+        ErrorCode::InvalidAttribute,
+        "RMSNorm output tensor Y dimensions do not match those of input "
+        "tensor X");
+
+    if (rmsnormAttr.getForwardPhase() == NormFwdPhase::TRAINING)
+      FUSILLI_CHECK_ERROR(checkNormTensor(rmsnormAttr.getINV_RMS(),
+                                          getNormSampleStatsDim(xT->getDim()),
+                                          "RMSNorm output tensor INV_RMS"));
+
+    // Statistics are computed in the data type of X.
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(rmsnormAttr.getSCALE(), *xT,
+                                                "RMSNorm input tensor SCALE"));
+    FUSILLI_CHECK_ERROR(checkNormTensorDataType(
+        rmsnormAttr.getINV_RMS(), *xT, "RMSNorm output tensor INV_RMS"));
+
+    return ok();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_NORMALIZATION_NODE_H
@@ -49,6 +49,12 @@ public:
     return pointwiseAttr.getName();
   }
   Type getType() const override final { return Type::Pointwise; }
+  const PointwiseAttr &getAttr() const { return pointwiseAttr; }
+  PointwiseAttr &getAttr() { return pointwiseAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return pointwiseAttr.fingerprint(INode::fingerprintNode(hash));
+  }
 
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating PointwiseNode '"
@@ -82,6 +88,19 @@ public:
       }
     }
 
+    // Validate clamp bounds
+    FUSILLI_RETURN_ERROR_IF(mode == PointwiseAttr::Mode::CLAMP &&
+                                !pointwiseAttr.getClampMin() &&
+                                !pointwiseAttr.getClampMax(),
+                            ErrorCode::AttributeNotSet,
+                            "CLAMP mode requires a min or max");
+    FUSILLI_RETURN_ERROR_IF(mode != PointwiseAttr::Mode::CLAMP &&
+                                (pointwiseAttr.getClampMin() ||
+                                 pointwiseAttr.getClampMax()),
+                            ErrorCode::InvalidAttribute,
+                            PointwiseAttr::kModeToStr.at(mode) +
+                                " mode should not have a clamp min or max set");
+
     // Validate output
     FUSILLI_RETURN_ERROR_IF(!pointwiseAttr.getOUT_0(),
                             ErrorCode::AttributeNotSet,
@@ -108,6 +127,22 @@ public:
       outTensor->setDim(FUSILLI_TRY(computeBroadcastShape(inputShapes)));
     }
 
+    // Output dims are dynamic where those of inputs are (right-aligned as in
+    // broadcasting).
+    if (!outTensor->isDynamic()) {
+      size_t outRank = outTensor->getDim().size();
+      std::vector<size_t> dynamicDims;
+      for (const auto &[_, inTensor] : pointwiseAttr.inputs) {
+        if (!inTensor)
+          continue;
+        size_t inRank = inTensor->getDim().size();
+        for (size_t idx : inTensor->getDynamicDims())
+          if (inRank <= outRank)
+            dynamicDims.push_back(outRank - inRank + idx);
+      }
+      outTensor->setDynamicDims(dynamicDims);
+    }
+
     if (outTensor->getStride().empty()) {
       // Try to set the stride from an input shape that matches the output
       // shape.
@@ -0,0 +1,230 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the reduction nodes `ReductionNode` and
+// `SoftmaxNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_REDUCTION_NODE_H
+#define FUSILLI_NODE_REDUCTION_NODE_H
+
+#include "fusilli/attributes/reduction_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Dims of the output of a reduction of `xDim` over `axes`, which are kept as
+// dims of size 1.
+inline std::vector<int64_t>
+getReductionOutputDim(const std::vector<int64_t> &xDim,
+                      const std::vector<int64_t> &axes) {
+  std::vector<int64_t> dim = xDim;
+  for (int64_t axis : axes)
+    dim[axis] = 1;
+  return dim;
+}
+
+// Tensors of reduction nodes may have any layout, and are permuted to their
+// logical dims in the emitted assembly, like the tensors of pointwise nodes.
+class ReductionNode : public NodeCRTP<ReductionNode> {
+public:
+  ReductionAttr reductionAttr;
+
+  ReductionNode(ReductionAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), reductionAttr(std::move(attr)) {}
+
+  // MLIR assembly emitter helper methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return reductionAttr.getName();
+  }
+  Type getType() const override final { return Type::Reduction; }
+  const ReductionAttr &getAttr() const { return reductionAttr; }
+  ReductionAttr &getAttr() { return reductionAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return reductionAttr.fingerprint(INode::fingerprintNode(hash));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ReductionNode '"
+                           << reductionAttr.getName() << "'");
+
+    FUSILLI_RETURN_ERROR_IF(reductionAttr.getMode() ==
+                                ReductionAttr::Mode::NOT_SET,
+                            ErrorCode::AttributeNotSet,
+                            "Reduction mode not set");
+
+    std::shared_ptr<TensorAttr> xT = reductionAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Reduction input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!reductionAttr.getY(), ErrorCode::AttributeNotSet,
+                            "Reduction output tensor Y not set");
+
+    const std::vector<int64_t> &axes = reductionAttr.getAxes();
+    FUSILLI_RETURN_ERROR_IF(axes.empty(), ErrorCode::AttributeNotSet,
+                            "Reduction axes not set");
+    int64_t rank = static_cast<int64_t>(xT->getDim().size());
+    std::unordered_set<int64_t> seenAxes;
+    for (int64_t axis : axes) {
+      FUSILLI_RETURN_ERROR_IF(axis < 0 || axis >= rank,
+                              ErrorCode::InvalidAttribute,
+                              "Reduction axis " + std::to_string(axis) +
+                                  " out of range of input tensor X");
+      FUSILLI_RETURN_ERROR_IF(!seenAxes.insert(axis).second,
+                              ErrorCode::InvalidAttribute,
+                              "Reduction axis " + std::to_string(axis) +
+                                  " specified more than once");
+      FUSILLI_RETURN_ERROR_IF(xT->isDynamicDim(axis),
+                              ErrorCode::NotImplemented,
+                              "Reduction over a dynamic dim of input tensor X "
+                              "is unsupported");
+    }
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for ReductionNode '"
+                           << reductionAttr.getName() << "'");
+
+    // Fill missing properties from context (including data types)
+    reductionAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> xT = reductionAttr.getX();
+    std::shared_ptr<TensorAttr> yT = reductionAttr.getY();
+    if (yT->getDim().empty())
+      yT->setDim(getReductionOutputDim(xT->getDim(), reductionAttr.getAxes()));
+
+    // Dims that are not reduced stay dynamic.
+    if (!yT->isDynamic())
+      yT->setDynamicDims(xT->getDynamicDims());
+
+    // Preserve the layout of X (e.g. channels-last) in Y.
+    if (yT->getStride().empty())
+      yT->setStride(generateStrideFromDim(
+          yT->getDim(), generateStrideOrderPreservingFormat(
+                            xT->getStride(), yT->getDim().size())));
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating ReductionNode '"
+                           << reductionAttr.getName() << "'");
+
+    FUSILLI_RETURN_ERROR_IF(
+        reductionAttr.getY()->getDim() !=
+            getReductionOutputDim(reductionAttr.getX()->getDim(),
+                                  reductionAttr.getAxes()),
+        ErrorCode::InvalidAttribute,
+        "Reduction output tensor Y dimensions do not match the expected "
+        "shape inferred from input tensor X and the reduction axes");
+
+    return ok();
+  }
+};
+
+// Like pointwise nodes, softmax nodes keep the layout of their input X in
+// their output Y.
+class SoftmaxNode : public NodeCRTP<SoftmaxNode> {
+public:
+  SoftmaxAttr softmaxAttr;
+
+  SoftmaxNode(SoftmaxAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), softmaxAttr(std::move(attr)) {}
+
+  // MLIR assembly emitter helper methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return softmaxAttr.getName();
+  }
+  Type getType() const override final { return Type::Softmax; }
+  const SoftmaxAttr &getAttr() const { return softmaxAttr; }
+  SoftmaxAttr &getAttr() { return softmaxAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return softmaxAttr.fingerprint(INode::fingerprintNode(hash));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating SoftmaxNode '"
+                           << softmaxAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = softmaxAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Softmax input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!softmaxAttr.getY(), ErrorCode::AttributeNotSet,
+                            "Softmax output tensor Y not set");
+
+    FUSILLI_RETURN_ERROR_IF(!softmaxAttr.getAxis().has_value(),
+                            ErrorCode::AttributeNotSet,
+                            "Softmax axis not set");
+    int64_t axis = *softmaxAttr.getAxis();
+    FUSILLI_RETURN_ERROR_IF(
+        axis < 0 || axis >= static_cast<int64_t>(xT->getDim().size()),
+        ErrorCode::InvalidAttribute,
+        "Softmax axis " + std::to_string(axis) +
+            " out of range of input tensor X");
+    FUSILLI_RETURN_ERROR_IF(xT->isDynamicDim(axis), ErrorCode::NotImplemented,
+                            "Softmax along a dynamic dim of input tensor X "
+                            "is unsupported");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for SoftmaxNode '"
+                           << softmaxAttr.getName() << "'");
+
+    // Fill missing properties from context (including data types)
+    softmaxAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> xT = softmaxAttr.getX();
+    std::shared_ptr<TensorAttr> yT = softmaxAttr.getY();
+    if (yT->getDim().empty())
+      yT->setDim(xT->getDim());
+    if (!yT->isDynamic())
+      yT->setDynamicDims(xT->getDynamicDims());
+    if (yT->getStride().empty())
+      yT->setStride(xT->getStride());
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating SoftmaxNode '"
+                           << softmaxAttr.getName() << "'");
+
+    FUSILLI_RETURN_ERROR_IF(
+        softmaxAttr.getY()->getDim() != softmaxAttr.getX()->getDim(),
+        ErrorCode::InvalidAttribute,
+        "Softmax output tensor Y dimensions do not match those of input "
+        "tensor X");
+
+    return ok();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_REDUCTION_NODE_H
@@ -0,0 +1,182 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the scaled dot-product attention node
+// `SdpaNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_SDPA_NODE_H
+#define FUSILLI_NODE_SDPA_NODE_H
+
+#include "fusilli/attributes/sdpa_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Q, K, V and O have the (logical) dims (B, H, S, D), and may have any
+// layout: they are permuted to their logical dims in the emitted assembly,
+// like the tensors of pointwise nodes. The attention is emitted as
+// `torch.aten.scaled_dot_product_attention`, which IREE lowers to its fused
+// (flash) attention op.
+class SdpaNode : public NodeCRTP<SdpaNode> {
+public:
+  SdpaAttr sdpaAttr;
+
+  SdpaNode(SdpaAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), sdpaAttr(std::move(attr)) {}
+
+  // MLIR assembly emitter helper methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return sdpaAttr.getName();
+  }
+  Type getType() const override final { return Type::Sdpa; }
+  const SdpaAttr &getAttr() const { return sdpaAttr; }
+  SdpaAttr &getAttr() { return sdpaAttr; }
+
+  uint64_t fingerprintNode(uint64_t hash) const override final {
+    return sdpaAttr.fingerprint(INode::fingerprintNode(hash));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating SdpaNode '"
+                           << sdpaAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
+    std::shared_ptr<TensorAttr> kT = sdpaAttr.getK();
+    std::shared_ptr<TensorAttr> vT = sdpaAttr.getV();
+    std::shared_ptr<TensorAttr> maskT = sdpaAttr.getMASK();
+
+    FUSILLI_RETURN_ERROR_IF(!qT, ErrorCode::AttributeNotSet,
+                            "SDPA input tensor Q not set");
+    FUSILLI_RETURN_ERROR_IF(!kT, ErrorCode::AttributeNotSet,
+                            "SDPA input tensor K not set");
+    FUSILLI_RETURN_ERROR_IF(!vT, ErrorCode::AttributeNotSet,
+                            "SDPA input tensor V not set");
+    FUSILLI_RETURN_ERROR_IF(!sdpaAttr.getO(), ErrorCode::AttributeNotSet,
+                            "SDPA output tensor O not set");
+
+    // Both masks at once are rejected by PyTorch as well.
+    FUSILLI_RETURN_ERROR_IF(sdpaAttr.getCausal() && maskT,
+                            ErrorCode::InvalidAttribute,
+                            "SDPA input tensor MASK and causal masking are "
+                            "mutually exclusive");
+
+    const std::vector<int64_t> &qDim = qT->getDim();
+    const std::vector<int64_t> &kDim = kT->getDim();
+    const std::vector<int64_t> &vDim = vT->getDim();
+    FUSILLI_RETURN_ERROR_IF(qDim.size() != 4 || kDim.size() != 4 ||
+                                vDim.size() != 4,
+                            ErrorCode::InvalidAttribute,
+                            "SDPA input tensors Q, K and V must have a rank "
+                            "of 4 (B, H, S, D)");
+    FUSILLI_RETURN_ERROR_IF(qT->isDynamic() || kT->isDynamic() ||
+                                vT->isDynamic() ||
+                                (maskT && maskT->isDynamic()),
+                            ErrorCode::NotImplemented,
+                            "SDPA input tensors with dynamic dims are "
+                            "unsupported");
+
+    // Grouped-query attention (fewer heads in K and V than in Q) is not
+    // supported yet.
+    FUSILLI_RETURN_ERROR_IF(kDim[0] != qDim[0] || kDim[1] != qDim[1] ||
+                                vDim[0] != qDim[0] || vDim[1] != qDim[1],
+                            ErrorCode::InvalidAttribute,
+                            "SDPA input tensors K and V must have the batch "
+                            "and head dims of input tensor Q");
+    FUSILLI_RETURN_ERROR_IF(kDim[3] != qDim[3], ErrorCode::InvalidAttribute,
+                            "SDPA input tensor K must have the head size of "
+                            "input tensor Q");
+    FUSILLI_RETURN_ERROR_IF(vDim[2] != kDim[2], ErrorCode::InvalidAttribute,
+                            "SDPA input tensor V must have the sequence "
+                            "length of input tensor K");
+
+    if (maskT) {
+      std::vector<int64_t> scoresDim = getScoresDim();
+      auto broadcastDim = computeBroadcastShape({maskT->getDim(), scoresDim});
+      FUSILLI_RETURN_ERROR_IF(isError(broadcastDim) ||
+                                  *broadcastDim != scoresDim,
+                              ErrorCode::InvalidAttribute,
+                              "SDPA input tensor MASK does not broadcast to "
+                              "the attention scores (B, H, S_q, S_kv)");
+    }
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for SdpaNode '"
+                           << sdpaAttr.getName() << "'");
+
+    // Fill missing properties from context (including data types)
+    sdpaAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
+    std::shared_ptr<TensorAttr> oT = sdpaAttr.getO();
+    if (oT->getDim().empty())
+      oT->setDim(getOutputDim());
+
+    // Preserve the layout of Q (e.g. BSHD) in O.
+    if (oT->getStride().empty())
+      oT->setStride(generateStrideFromDim(
+          oT->getDim(),
+          generateStrideOrderPreservingFormat(qT->getStride(),
+                                              oT->getDim().size())));
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating SdpaNode '"
+                           << sdpaAttr.getName() << "'");
+
+    DataType qType = sdpaAttr.getQ()->getDataType();
+    FUSILLI_RETURN_ERROR_IF(sdpaAttr.getK()->getDataType() != qType ||
+                                sdpaAttr.getV()->getDataType() != qType,
+                            ErrorCode::InvalidAttribute,
+                            "SDPA input tensors Q, K and V must have the same "
+                            "data type");
+    FUSILLI_RETURN_ERROR_IF(sdpaAttr.getO()->getDim() != getOutputDim(),
+                            ErrorCode::InvalidAttribute,
+                            "SDPA output tensor O dimensions do not match the "
+                            "expected shape (B, H, S_q, D_v)");
+
+    return ok();
+  }
+
+private:
+  // Dims (B, H, S_q, S_kv) of the scores Q * K^T.
+  std::vector<int64_t> getScoresDim() const {
+    std::vector<int64_t> dim = sdpaAttr.getQ()->getDim();
+    dim[3] = sdpaAttr.getK()->getDim()[2];
+    return dim;
+  }
+
+  // Dims (B, H, S_q, D_v) of the output O.
+  std::vector<int64_t> getOutputDim() const {
+    std::vector<int64_t> dim = sdpaAttr.getQ()->getDim();
+    dim[3] = sdpaAttr.getV()->getDim()[3];
+    return dim;
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_SDPA_NODE_H
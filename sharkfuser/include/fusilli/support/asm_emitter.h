@@ -33,7 +33,11 @@
 #include "fusilli/external/torch_types.h"
 #include "fusilli/graph/graph.h"
 #include "fusilli/node/conv_node.h"
+#include "fusilli/node/matmul_node.h"
+#include "fusilli/node/normalization_node.h"
 #include "fusilli/node/pointwise_node.h"
+#include "fusilli/node/reduction_node.h"
+#include "fusilli/node/sdpa_node.h"
 #include "fusilli/support/extras.h"
 
 #include <cassert>
@@ -42,13 +46,45 @@
 #include <cstdint>
 #include <format> // C++20
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace fusilli {
 
+// Returns the MLIR assembly for the `torch.prim.ListConstruct` op wrapping
+// the `!torch.int` values `ssaValueNames` into the list `resultName`.
+inline std::string
+getListConstructOpAsm(const std::vector<std::string> &ssaValueNames,
+                      const std::string &resultName) {
+  std::string asm_;
+  // Emit the ListConstruct op.
+  asm_ += resultName;
+  asm_ += " = torch.prim.ListConstruct ";
+  // %val_0, %val_1, ...
+  interleave(
+      ssaValueNames.begin(), ssaValueNames.end(),
+      // each_fn:
+      [&](const std::string &name) { asm_ += name; },
+      // between_fn:
+      [&] { asm_ += ", "; });
+  asm_ += " : (";
+  // !torch.int, !torch.int, ...
+  interleave(
+      ssaValueNames.begin(), ssaValueNames.end(),
+      // each_fn:
+      [&](const std::string &name) { asm_ += "!torch.int"; },
+      // between_fn:
+      [&] { asm_ += ", "; });
+  asm_ += ") -> !torch.list<int>\n";
+
+  return asm_;
+}
+
 // Given a vector of ints, returns the MLIR assembly for the
 // `torch.constant.int` ops for each int value and the
 // `torch.prim.ListConstruct` op wrapping these into a single
@@ -73,37 +109,131 @@ namespace fusilli {
 inline std::string getListOfIntOpsAsm(const std::vector<int64_t> &listOfInts,
                                       const std::string &prefix,
                                       const std::string &suffix) {
-  std::ostringstream oss;
+  std::string asm_;
   std::vector<std::string> ssaValueNames;
+  ssaValueNames.reserve(listOfInts.size());
 
   // Emit `torch.constant.int` ops for each int value.
   for (size_t i = 0; i < listOfInts.size(); ++i) {
     std::string ssaValueName =
         "%" + prefix + "_val_" + std::to_string(i) + "_" + suffix;
-    oss << ssaValueName << " = torch.constant.int " << listOfInts[i]
-        << "\n    ";
+    asm_ += ssaValueName;
+    asm_ += " = torch.constant.int ";
+    asm_ += std::to_string(listOfInts[i]);
+    asm_ += "\n    ";
+    ssaValueNames.push_back(std::move(ssaValueName));
+  }
+
+  asm_ += getListConstructOpAsm(ssaValueNames, "%" + prefix + "_" + suffix);
+  return asm_;
+}
+
+// Like `getListOfIntOpsAsm` on the logical dims of `tensor`, except for its
+// dynamic dims, read from the same (logical) dims of `sizeSource` with
+// `torch.aten.size.int`. For example, with the first dim of `tensor` dynamic:
+//
+//   %empty_DX_idx_0_conv = torch.constant.int 0
+//   %empty_DX_val_0_conv = torch.aten.size.int %dy, %empty_DX_idx_0_conv :
+//          !torch.vtensor<[?,8,8,16],f32>, !torch.int -> !torch.int
+//   %empty_DX_val_1_conv = torch.constant.int 16
+//   ...
+inline std::string getListOfDimOpsAsm(const TensorAttr &tensor,
+                                      const TensorAttr &sizeSource,
+                                      const std::string &prefix,
+                                      const std::string &suffix) {
+  std::ostringstream oss;
+  std::vector<std::string> ssaValueNames;
+
+  // `sizeSource` is a value of its physical type: `physicalIdx[i]` is the
+  // index of its logical dim `i` in physical order.
+  std::vector<int64_t> physicalIdx =
+      sizeSource.getPhysicalToLogicalPermuteOrder();
+  for (size_t i = 0; i < tensor.getDim().size(); ++i) {
+    std::string ssaValueName =
+        "%" + prefix + "_val_" + std::to_string(i) + "_" + suffix;
+    if (tensor.isDynamicDim(i)) {
+      std::string idxName =
+          "%" + prefix + "_idx_" + std::to_string(i) + "_" + suffix;
+      oss << idxName << " = torch.constant.int " << physicalIdx[i]
+          << "\n    ";
+      oss << ssaValueName << " = torch.aten.size.int "
+          << sizeSource.getValueNameAsm() << ", " << idxName << " : "
+          << sizeSource.getTensorTypeAsm() << ", !torch.int -> !torch.int"
+          << "\n    ";
+    } else {
+      oss << ssaValueName << " = torch.constant.int " << tensor.getDim()[i]
+          << "\n    ";
+    }
     ssaValueNames.push_back(ssaValueName);
   }
 
-  // Emit the ListConstruct op.
-  oss << "%" + prefix + "_" + suffix << " = torch.prim.ListConstruct ";
-  // %val_0, %val_1, ...
-  interleave(
-      ssaValueNames.begin(), ssaValueNames.end(),
-      // each_fn:
-      [&](const std::string &name) { oss << name; },
-      // between_fn:
-      [&] { oss << ", "; });
-  oss << " : (";
-  // !torch.int, !torch.int, ...
-  interleave(
-      ssaValueNames.begin(), ssaValueNames.end(),
-      // each_fn:
-      [&](const std::string &name) { oss << "!torch.int"; },
-      // between_fn:
-      [&] { oss << ", "; });
-  oss << ") -> !torch.list<int>\n";
+  oss << getListConstructOpAsm(ssaValueNames, "%" + prefix + "_" + suffix);
+  return oss.str();
+}
 
+// Returns the MLIR assembly multiplying the f32 (logical) result
+// `{resultName}_unscaled_perm` of a node by its single-element per-tensor
+// `scales`, which broadcast to it, and converting the product to the data
+// type of `result` as `{resultName}_perm`. Each op is preceded by a newline,
+// so that it may directly follow the op of the node. For example, for an f16
+// `result` named `%result` of the node `conv` with the scales `%x_scale` and
+// `%w_scale`:
+//
+//   %scaled_0_conv = torch.aten.mul.Tensor %result_unscaled_perm, %x_scale :
+//          !torch.vtensor<[16,256,64,64],f32>, !torch.vtensor<[1],f32> ->
+//              !torch.vtensor<[16,256,64,64],f32>
+//   %scaled_1_conv = torch.aten.mul.Tensor %scaled_0_conv, %w_scale : ...
+//   %dtype_scaled_conv = torch.constant.int 5
+//   %false_scaled_conv = torch.constant.bool false
+//   %none_scaled_conv = torch.constant.none
+//   %result_perm = torch.aten.to.dtype %scaled_1_conv, %dtype_scaled_conv,
+//          %false_scaled_conv, %false_scaled_conv, %none_scaled_conv : ...
+//              -> !torch.vtensor<[16,256,64,64],f16>
+//
+// An f32 `result` is the last product itself.
+inline std::string
+getScaleOpsAsm(const TensorAttr &result,
+               const std::vector<std::shared_ptr<TensorAttr>> &scales,
+               const std::string &suffix) {
+  std::ostringstream oss;
+
+  TensorAttr unscaled = result;
+  unscaled.setDataType(DataType::Float);
+  std::string unscaledType = unscaled.getTensorTypeAsm(/*isValueTensor=*/true,
+                                                       /*useLogicalDims=*/true);
+  std::string resultName = result.getValueNameAsm() + "_perm";
+  bool isFloatResult = result.getDataType() == DataType::Float;
+
+  std::string operand = result.getValueNameAsm() + "_unscaled_perm";
+  for (size_t i = 0; i < scales.size(); ++i) {
+    std::string product = (isFloatResult && i + 1 == scales.size())
+                              ? resultName
+                              : "%scaled_" + std::to_string(i) + "_" + suffix;
+    oss << "\n    " << product << " = torch.aten.mul.Tensor " << operand
+        << ", " << scales[i]->getValueNameAsm() << " : " << unscaledType
+        << ", " << scales[i]->getTensorTypeAsm() << " -> " << unscaledType;
+    operand = product;
+  }
+  if (isFloatResult)
+    return oss.str();
+
+  constexpr std::string_view schema = R"(
+    %dtype_scaled_{0} = torch.constant.int {1}
+    %false_scaled_{0} = torch.constant.bool false
+    %none_scaled_{0} = torch.constant.none
+    {2} = torch.aten.to.dtype {3}, %dtype_scaled_{0}, %false_scaled_{0}, %false_scaled_{0}, %none_scaled_{0} : {4}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {5})";
+
+  torch_upstream::ScalarType dataType =
+      kDataTypeToTorchType.at(result.getDataType());
+  oss << std::format(schema,
+                     suffix,                                     // {0}
+                     std::to_string(static_cast<int>(dataType)), // {1}
+                     resultName,                                 // {2}
+                     operand,                                    // {3}
+                     unscaledType,                               // {4}
+                     result.getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true) // {5}
+  );
   return oss.str();
 }
 
@@ -144,6 +274,13 @@ inline std::string getListOfIntOpsAsm(const std::vector<int64_t> &listOfInts,
 //    t.getTensorTypeAsm(/*isValueTensor=*/false,
 //                       /*useLogicalDims=*/false)
 //        --> "!torch.tensor<[2,4,3],f32>"
+//
+// Dynamic dims are emitted as `?`:
+//
+//    t.setDynamicDims({0});
+//    t.getTensorTypeAsm(/*isValueTensor=*/true,
+//                       /*useLogicalDims=*/false)
+//        --> "!torch.vtensor<[?,4,3],f32>"
 inline std::string TensorAttr::getTensorTypeAsm(bool isValueTensor,
                                                 bool useLogicalDims) const {
   assert(!isScalar() && "TensorAttr::getTensorTypeAsm expects a ranked tensor");
@@ -154,22 +291,21 @@ inline std::string TensorAttr::getTensorTypeAsm(bool isValueTensor,
   assert(getDataType() != DataType::NotSet &&
          "TensorAttr::getTensorTypeAsm expects a valid data type");
 
-  std::ostringstream oss;
-  oss << (isValueTensor ? "!torch.vtensor<[" : "!torch.tensor<[");
+  std::string asm_ = isValueTensor ? "!torch.vtensor<[" : "!torch.tensor<[";
 
   std::vector<int64_t> dims = useLogicalDims ? getDim() : getPhysicalDim();
 
   // Emit dims in logical or physical order.
-  interleave(
-      dims.begin(), dims.end(),
-      // each_fn:
-      [&](int64_t dim) { oss << dim; },
-      // between_fn:
-      [&] { oss << ","; });
-  oss << "],";
-  oss << kDataTypeToMlirTypeAsm.at(getDataType());
-  oss << ">";
-  return oss.str();
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (i > 0)
+      asm_ += ",";
+    bool isDynamic = useLogicalDims ? isDynamicDim(i) : isPhysicalDimDynamic(i);
+    asm_ += isDynamic ? "?" : std::to_string(dims[i]);
+  }
+  asm_ += "],";
+  asm_ += kDataTypeToMlirTypeAsm.at(getDataType());
+  asm_ += ">";
+  return asm_;
 }
 
 // Emits an MLIR SSA value name starting with the `%` sigil based off the
@@ -182,10 +318,15 @@ inline std::string TensorAttr::getValueNameAsm(bool isOutputAliased) const {
   assert(!getName().empty() &&
          "TensorAttr name must not be empty for `getValueNameAsm`");
 
-  std::string filtered = getName();
-  std::erase_if(filtered, // C++20
-                [](unsigned char c) { return !(std::isalnum(c) || c == '_'); });
-  return "%" + filtered + (isOutputAliased ? "_" : "");
+  if (valueNameAsm_.empty()) {
+    std::string filtered = getName();
+    std::erase_if(filtered, // C++20
+                  [](unsigned char c) {
+                    return !(std::isalnum(c) || c == '_');
+                  });
+    valueNameAsm_ = "%" + filtered;
+  }
+  return isOutputAliased ? valueNameAsm_ + "_" : valueNameAsm_;
 }
 
 //===----------------------------------------------------------------------===//
@@ -219,8 +360,9 @@ inline std::string Graph::getOperandNamesAndTypesAsm() const {
       [&](const std::shared_ptr<TensorAttr> &input) {
         // We only use the tensor inputs and not scalar (constants) as those
         // wouldn't be part of the main func.func signature but embedded as
-        // constants in the IR.
-        return input->isScalar();
+        // constants in the IR, as are constant tensors (see
+        // `Graph::getConstantsAsm`).
+        return input->isScalar() || input->isConstant();
       });
   return oss.str();
 }
@@ -261,20 +403,83 @@ inline std::string Graph::getResultNamesAndTypesAsm() const {
 // for template replacements using `std::format`. When modifying the
 // schema, take extra caution about double bracing the curly brackets
 // (refer to the comments at the top of this file for details).
+//
+// The module is named after the fingerprint of the graph, so that the
+// modules of distinct graphs are appended under distinct names to the
+// session shared by a handle (see `Graph::createExecuteCall`).
 inline std::string Graph::emitNodePreAsm() const {
   constexpr std::string_view schema = R"(
-module @module {{
-  func.func @main({0}, {1}) attributes {{torch.assume_strict_symbolic_shapes}} {{
+module @module_{2:016x} {{
+  func.func @main({0}, {1}) attributes {{torch.assume_strict_symbolic_shapes}} {{{3}
   )";
 
   std::string output = std::format(schema,
-                                   getResultNamesAndTypesAsm(), // {0}
-                                   getOperandNamesAndTypesAsm() // {1}
+                                   getResultNamesAndTypesAsm(),  // {0}
+                                   getOperandNamesAndTypesAsm(), // {1}
+                                   fingerprint_,                 // {2}
+                                   getConstantsAsm()             // {3}
   );
 
   return output;
 }
 
+// Name of the resource blob holding the contents of the constant `tensor`.
+inline std::string getConstantResourceNameAsm(const TensorAttr &tensor) {
+  return "fusilli_constant_" + tensor.getValueNameAsm().substr(1);
+}
+
+// Emits the constant tensors among the graph's inputs (see
+// `TensorAttr::setConstantData`) as literals of the resource blobs emitted by
+// `getConstantResourcesAsm`, in physical layout like function arguments:
+//
+//   %filter = torch.vtensor.literal(dense_resource<fusilli_constant_filter>
+//       : tensor<256x128x1x1xf32>) : !torch.vtensor<[256,128,1,1],f32>
+inline std::string Graph::getConstantsAsm() const {
+  std::ostringstream oss;
+  for (const auto &input : fullGraphInputsSorted_) {
+    if (!input->isConstant())
+      continue;
+    // Literals of signed integers are of signless builtin integer types.
+    std::string elementType = kDataTypeToMlirTypeAsm.at(input->getDataType());
+    if (elementType.starts_with("si"))
+      elementType.erase(0, 1);
+    oss << "\n    " << input->getValueNameAsm()
+        << " = torch.vtensor.literal(dense_resource<"
+        << getConstantResourceNameAsm(*input) << "> : tensor<";
+    for (int64_t dim : input->getPhysicalDim())
+      oss << dim << "x";
+    oss << elementType << ">) : " << input->getTensorTypeAsm();
+  }
+  return oss.str();
+}
+
+// Emits the contents of the constant tensors among the graph's inputs as
+// resource blobs, after the module: hex encoded, following their alignment
+// (a little endian 32-bit integer).
+inline std::string Graph::getConstantResourcesAsm() const {
+  constexpr std::string_view kHexDigits = "0123456789ABCDEF";
+  constexpr std::string_view kAlignment = "40000000"; // 64 bytes
+  std::string output;
+  for (const auto &input : fullGraphInputsSorted_) {
+    if (!input->isConstant())
+      continue;
+    const std::vector<uint8_t> &data = *input->getConstantData();
+    output += output.empty() ? "" : ",\n";
+    output += "      " + getConstantResourceNameAsm(*input) + ": \"0x";
+    output += kAlignment;
+    output.reserve(output.size() + 2 * data.size() + 1);
+    for (uint8_t byte : data) {
+      output += kHexDigits[byte >> 4];
+      output += kHexDigits[byte & 0xF];
+    }
+    output += "\"";
+  }
+  if (output.empty())
+    return output;
+  return "{-#\n  dialect_resources: {\n    builtin: {\n" + output +
+         "\n    }\n  }\n#-}\n";
+}
+
 // This gets called by the recursive `emitAsmSubtree()` method to emit
 // the post-assembly for each node (including the main Graph). The schema
 // hard-codes things that are not customizable, and leaves the rest
@@ -309,10 +514,12 @@ inline std::string Graph::emitNodePostAsm() const {
     return
   }}
 }}
+{1}
   )";
 
   std::string output = std::format(schema,
-                                   oss.str() // {0}
+                                   oss.str(),                // {0}
+                                   getConstantResourcesAsm() // {1}
   );
 
   return output;
@@ -488,6 +695,16 @@ inline std::string ConvFPropNode::getPermuteYOpsAsm() const {
   return oss.str() + output;
 }
 
+// Get the ops scaling the convolution by X_SCALE and W_SCALE (when set) in
+// MLIR assembly format, see `getScaleOpsAsm`.
+inline std::string ConvFPropNode::getScaleOpsAsm() const {
+  std::vector<std::shared_ptr<TensorAttr>> scales = getScales();
+  if (scales.empty())
+    return "";
+  return fusilli::getScaleOpsAsm(*convFPropAttr.getY(), scales,
+                                 convFPropAttr.getName());
+}
+
 // This gets called by the recursive `emitAsmSubtree()` method to emit
 // the pre-assembly for each node (including the main Graph). The schema
 // hard-codes things that are not customizable, and leaves the rest
@@ -495,6 +712,9 @@ inline std::string ConvFPropNode::getPermuteYOpsAsm() const {
 // schema, take extra caution about double bracing the curly brackets
 // (refer to the comments at the top of this file for details).
 inline std::string ConvFPropNode::emitNodePreAsm() const {
+  if (isDirectChannelsLast())
+    return emitDirectChannelsLastAsm();
+
   // `torch.aten.convolution` signature from GeneratedTorchOps.td
   // https://github.com/llvm/torch-mlir/blob/main/include/torch-mlir/Dialect/Torch/IR/GeneratedTorchOps.td
   //
@@ -527,7 +747,7 @@ inline std::string ConvFPropNode::emitNodePreAsm() const {
     {4}
     {5}
     {6}
-    {7}_perm = torch.aten.convolution {8}, %bias_{0}, %stride_{0}, %padding_{0}, %dilation_{0}, %transposed_{0}, %output_padding_{0}, %groups_{0} : {9}, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> {10}
+    {7}{12}_perm = torch.aten.convolution {8}, %bias_{0}, %stride_{0}, %padding_{0}, %dilation_{0}, %transposed_{0}, %output_padding_{0}, %groups_{0} : {9}, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> {10}{13}
     {11}
     )";
 
@@ -536,24 +756,123 @@ inline std::string ConvFPropNode::emitNodePreAsm() const {
   // the overall MLIR assembly.
   std::string uniqueSSASuffix = convFPropAttr.getName();
 
-  std::string output = std::format(schema,
-                                   uniqueSSASuffix,      // {0}
-                                   getGroupOpsAsm(),     // {1}
-                                   getStrideOpsAsm(),    // {2}
-                                   getPaddingOpsAsm(),   // {3}
-                                   getDilationOpsAsm(),  // {4}
-                                   getPermuteXOpsAsm(),  // {5}
-                                   getPermuteWOpsAsm(),  // {6}
-                                   getResultNamesAsm(),  // {7}
-                                   getOperandNamesAsm(), // {8}
-                                   getOperandTypesAsm(), // {9}
-                                   getResultTypesAsm(),  // {10}
-                                   getPermuteYOpsAsm()   // {11}
+  // With per-tensor scales, the convolution is scaled in f32 before being
+  // converted to the data type of Y.
+  bool isScaled = !getScales().empty();
+  TensorAttr unscaledY = *convFPropAttr.getY();
+  if (isScaled)
+    unscaledY.setDataType(DataType::Float);
+
+  std::string output =
+      std::format(schema,
+                  uniqueSSASuffix,      // {0}
+                  getGroupOpsAsm(),     // {1}
+                  getStrideOpsAsm(),    // {2}
+                  getPaddingOpsAsm(),   // {3}
+                  getDilationOpsAsm(),  // {4}
+                  getPermuteXOpsAsm(),  // {5}
+                  getPermuteWOpsAsm(),  // {6}
+                  getResultNamesAsm(),  // {7}
+                  getOperandNamesAsm(), // {8}
+                  getOperandTypesAsm(), // {9}
+                  unscaledY.getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true), // {10}
+                  getPermuteYOpsAsm(),         // {11}
+                  isScaled ? "_unscaled" : "", // {12}
+                  getScaleOpsAsm()             // {13}
   );
 
   return output;
 }
 
+// Emits the convolution of channels-last X (NHWC), W (KRSC) and Y (NHWC) as
+// `linalg.conv_2d_nhwc_fhwc` on their physical (builtin) tensors, with no
+// permutes for the compiler to fold. Like the lowering of
+// `torch.aten.convolution`, X is zero padded with `tensor.pad` and the
+// convolution accumulates in f32, truncated to the data type of Y.
+inline std::string ConvFPropNode::emitDirectChannelsLastAsm() const {
+  constexpr std::string_view schema = R"(
+    %x_builtin_{0} = torch_c.to_builtin_tensor {1} : {2} -> {3}
+    %w_builtin_{0} = torch_c.to_builtin_tensor {4} : {5} -> {6}
+    %pad_value_{0} = arith.constant 0.000000e+00 : {7}
+    %x_padded_{0} = tensor.pad %x_builtin_{0} low[0, {8}, {9}, 0] high[0, {8}, {9}, 0] {{
+    ^bb0(%pad_n_{0}: index, %pad_h_{0}: index, %pad_w_{0}: index, %pad_c_{0}: index):
+      tensor.yield %pad_value_{0} : {7}
+    }} : {3} to {10}
+    %acc_zero_{0} = arith.constant 0.000000e+00 : f32
+    %acc_empty_{0} = tensor.empty() : {11}
+    %acc_{0} = linalg.fill ins(%acc_zero_{0} : f32) outs(%acc_empty_{0} : {11}) -> {11}
+    %conv_{0} = linalg.conv_2d_nhwc_fhwc {{dilations = dense<[{12}, {13}]> : tensor<2xi64>, strides = dense<[{14}, {15}]> : tensor<2xi64>}} ins(%x_padded_{0}, %w_builtin_{0} : {10}, {6}) outs(%acc_{0} : {11}) -> {11}{16}
+    {17} = torch_c.from_builtin_tensor {18} : {19} -> {20}
+    )";
+
+  std::string suffix = convFPropAttr.getName();
+  std::shared_ptr<TensorAttr> xT = convFPropAttr.getX();
+  std::shared_ptr<TensorAttr> wT = convFPropAttr.getW();
+  std::shared_ptr<TensorAttr> yT = convFPropAttr.getY();
+  const std::vector<int64_t> &padding = convFPropAttr.getPadding();
+  const std::vector<int64_t> &stride = convFPropAttr.getStride();
+  const std::vector<int64_t> &dilation = convFPropAttr.getDilation();
+
+  auto getBuiltinTypeAsm = [](const std::vector<int64_t> &dims,
+                              const std::string &elementType) {
+    std::ostringstream oss;
+    oss << "tensor<";
+    for (int64_t dim : dims)
+      oss << dim << "x";
+    oss << elementType << ">";
+    return oss.str();
+  };
+  std::string xElementType = kDataTypeToMlirTypeAsm.at(xT->getDataType());
+  std::string yElementType = kDataTypeToMlirTypeAsm.at(yT->getDataType());
+
+  // Physical dims are NHWC for X and Y, and KRSC (FHWC) for W.
+  std::vector<int64_t> xPaddedDim = xT->getPhysicalDim();
+  xPaddedDim[1] += 2 * padding[0];
+  xPaddedDim[2] += 2 * padding[1];
+  std::string yBuiltinType =
+      getBuiltinTypeAsm(yT->getPhysicalDim(), yElementType);
+  std::string accType = getBuiltinTypeAsm(yT->getPhysicalDim(), "f32");
+
+  std::string truncOp = "";
+  std::string result = "%conv_" + suffix;
+  if (yElementType != "f32") {
+    truncOp = std::format("\n    %conv_trunc_{0} = arith.truncf %conv_{0} : "
+                          "{1} to {2}",
+                          suffix, accType, yBuiltinType);
+    result = "%conv_trunc_" + suffix;
+  }
+
+  return std::format(schema,
+                     suffix,                // {0}
+                     xT->getValueNameAsm(), // {1}
+                     xT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/false), // {2}
+                     getBuiltinTypeAsm(xT->getPhysicalDim(),
+                                       xElementType), // {3}
+                     wT->getValueNameAsm(),           // {4}
+                     wT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/false), // {5}
+                     getBuiltinTypeAsm(wT->getPhysicalDim(),
+                                       xElementType),                // {6}
+                     xElementType,                                   // {7}
+                     padding[0],                                     // {8}
+                     padding[1],                                     // {9}
+                     getBuiltinTypeAsm(xPaddedDim, xElementType),    // {10}
+                     accType,                                        // {11}
+                     dilation[0],                                    // {12}
+                     dilation[1],                                    // {13}
+                     stride[0],                                      // {14}
+                     stride[1],                                      // {15}
+                     truncOp,                                        // {16}
+                     yT->getValueNameAsm(),                          // {17}
+                     result,                                         // {18}
+                     yBuiltinType,                                   // {19}
+                     yT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/false) // {20}
+  );
+}
+
 //===----------------------------------------------------------------------===//
 //
 // ConvWGradNode ASM Emitter Methods
@@ -757,7 +1076,115 @@ inline std::string ConvWGradNode::getPermuteEmptyWOpsAsm() const {
   return oss.str() + output;
 }
 
+// Emits the weight gradient with its reduction over the batch split in
+// `S = getSplitReductionFactor()` parts: DY and X are sliced in S parts of
+// their batch, whose weight gradients are computed by independent
+// convolutions (i.e. dispatches that run concurrently) and then summed.
+inline std::string ConvWGradNode::getSplitReductionOpsAsm() const {
+  constexpr std::string_view preSchema = R"(
+    %bias_{0} = torch.constant.none
+    %transposed_{0} = torch.constant.bool false
+    %output_padding_{0} = torch.prim.ListConstruct  : () -> !torch.list<int>
+    {1}
+    {2}
+    {3}
+    {4}
+    {5}
+    {6}
+    {7}
+    %true_{0} = torch.constant.bool true
+    %false_{0} = torch.constant.bool false
+    %output_mask_{0} = torch.prim.ListConstruct %false_{0}, %true_{0}, %false_{0} : (!torch.bool, !torch.bool, !torch.bool) -> !torch.list<bool>
+    %split_dim_{0} = torch.constant.int 0
+    %split_step_{0} = torch.constant.int 1
+    %alpha_{0} = torch.constant.int 1
+    )";
+
+  // Slices and weight gradient of part {1}, from the bounds {1} to {2}.
+  constexpr std::string_view partSchema = R"(
+    %dy_part_{1}_{0} = torch.aten.slice.Tensor {3}_perm, %split_dim_{0}, %split_bound_{1}_{0}, %split_bound_{2}_{0}, %split_step_{0} : {4}, !torch.int, !torch.int, !torch.int, !torch.int -> {5}
+    %x_part_{1}_{0} = torch.aten.slice.Tensor {6}_perm, %split_dim_{0}, %split_bound_{1}_{0}, %split_bound_{2}_{0}, %split_step_{0} : {7}, !torch.int, !torch.int, !torch.int, !torch.int -> {8}
+    %grad_input_{1}_{0}, %dw_part_{1}_{0}, %grad_bias_{1}_{0} = torch.aten.convolution_backward %dy_part_{1}_{0}, %x_part_{1}_{0}, %empty_w_{0}, %bias_{0}, %stride_{0}, %padding_{0}, %dilation_{0}, %transposed_{0}, %output_padding_{0}, %groups_{0}, %output_mask_{0} : {5}, {8}, {9}, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int, !torch.list<bool> -> !torch.none, {9}, !torch.none
+    )";
+
+  // Sum {1} of the weight gradients of the parts, adding part {3} to {2}.
+  constexpr std::string_view sumSchema = R"(
+    {1} = torch.aten.add.Tensor {2}, %dw_part_{3}_{0}, %alpha_{0} : {4}, {4}, !torch.int -> {4}
+    )";
+
+  std::string suffix = convWGradAttr.getName();
+  std::shared_ptr<TensorAttr> dyT = convWGradAttr.getDY();
+  std::shared_ptr<TensorAttr> xT = convWGradAttr.getX();
+  std::shared_ptr<TensorAttr> dwT = convWGradAttr.getDW();
+  int64_t splitFactor = convWGradAttr.getSplitReductionFactor();
+  int64_t partSize = xT->getDim()[0] / splitFactor;
+
+  // Types of (the logical dims of) `t` and of its parts.
+  auto typeAsm = [](const TensorAttr &t) {
+    return t.getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  };
+  auto partTypeAsm = [&](TensorAttr t) {
+    std::vector<int64_t> dim = t.getDim();
+    dim[0] = partSize;
+    t.setDim(dim).setStride(
+        generateStrideFromDim(dim, getContiguousStrideOrder(dim.size())));
+    return typeAsm(t);
+  };
+
+  std::ostringstream oss;
+  oss << std::format(preSchema,
+                     suffix,                   // {0}
+                     getGroupOpsAsm(),         // {1}
+                     getStrideOpsAsm(),        // {2}
+                     getPaddingOpsAsm(),       // {3}
+                     getDilationOpsAsm(),      // {4}
+                     getPermuteDYOpsAsm(),     // {5}
+                     getPermuteXOpsAsm(),      // {6}
+                     getPermuteEmptyWOpsAsm()  // {7}
+  );
+  for (int64_t i = 0; i <= splitFactor; ++i)
+    oss << std::format("%split_bound_{}_{} = torch.constant.int {}\n    ", i,
+                       suffix, i * partSize);
+
+  std::string dwType = typeAsm(*dwT);
+  std::string partialSum = "%dw_part_0_" + suffix;
+  for (int64_t i = 0; i < splitFactor; ++i) {
+    oss << std::format(partSchema,
+                       suffix,                 // {0}
+                       i,                      // {1}
+                       i + 1,                  // {2}
+                       dyT->getValueNameAsm(), // {3}
+                       typeAsm(*dyT),          // {4}
+                       partTypeAsm(*dyT),      // {5}
+                       xT->getValueNameAsm(),  // {6}
+                       typeAsm(*xT),           // {7}
+                       partTypeAsm(*xT),       // {8}
+                       dwType                  // {9}
+    );
+    if (i == 0)
+      continue;
+    // The last sum is the (logical) weight gradient.
+    std::string sum = i + 1 == splitFactor
+                          ? dwT->getValueNameAsm() + "_perm"
+                          : std::format("%dw_sum_{}_{}", i, suffix);
+    oss << std::format(sumSchema,
+                       suffix,     // {0}
+                       sum,        // {1}
+                       partialSum, // {2}
+                       i,          // {3}
+                       dwType      // {4}
+    );
+    partialSum = sum;
+  }
+
+  oss << getPermuteDWOpsAsm();
+  return oss.str();
+}
+
 inline std::string ConvWGradNode::emitNodePreAsm() const {
+  if (convWGradAttr.getSplitReductionFactor() > 1)
+    return getSplitReductionOpsAsm();
+
   constexpr std::string_view schema = R"(
     %bias_{0} = torch.constant.none
     %transposed_{0} = torch.constant.bool false
@@ -966,7 +1393,8 @@ inline std::string ConvDGradNode::getPermuteEmptyXOpsAsm() const {
   std::string suffix = convDGradAttr.getName();
   std::shared_ptr<TensorAttr> dxT = convDGradAttr.getDX();
 
-  oss << getListOfIntOpsAsm(dxT->getDim(), prefix, suffix);
+  // Dynamic dims of DX (its batch dim) are those of DY.
+  oss << getListOfDimOpsAsm(*dxT, *convDGradAttr.getDY(), prefix, suffix);
 
   // Use `torch.aten.empty.memory_format` to create an empty tensor. It is the
   // simplest op to create a new tensor without having a pre-existing one
@@ -1033,6 +1461,201 @@ inline std::string ConvDGradNode::emitNodePreAsm() const {
   return output;
 }
 
+//===----------------------------------------------------------------------===//
+//
+// MatmulNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits MatmulNode's operand names in MLIR assembly format.
+//
+// Its output is used to materialize the contents of {} in
+//      %result = torch.aten.matmul {} : ...
+// with
+//      "%lhs_A_matmul_perm, %rhs_B_matmul_perm"
+//
+// Operands are suffixed with the node name, so that a tensor may be an
+// operand of several nodes (or both operands of one).
+inline std::string MatmulNode::getOperandNamesAsm() const {
+  std::string suffix = matmulAttr.getName();
+  return matmulAttr.getA()->getValueNameAsm() + "_A_" + suffix + "_perm" +
+         ", " + matmulAttr.getB()->getValueNameAsm() + "_B_" + suffix +
+         "_perm";
+}
+
+// Emits MatmulNode's operand types in MLIR assembly format.
+//
+// Its output is used to materialize the contents of {} in
+//      %result = torch.aten.matmul ... : {} -> ...
+// with
+//      "!torch.vtensor<[4,32,64],f32>, !torch.vtensor<[4,64,128],f32>"
+inline std::string MatmulNode::getOperandTypesAsm() const {
+  return matmulAttr.getA()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true) +
+         ", " +
+         matmulAttr.getB()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true);
+}
+
+// Emits MatmulNode's result names in MLIR assembly format.
+//
+// Its output is used to materialize the contents of {} in
+//      {} = torch.aten.matmul ...
+// with
+//      "%result"
+inline std::string MatmulNode::getResultNamesAsm() const {
+  return matmulAttr.getC()->getValueNameAsm();
+}
+
+// Emits MatmulNode's result types in MLIR assembly format.
+//
+// Its output is used to materialize the contents of {} in
+//      %result = torch.aten.matmul ... -> {}
+// with
+//      "!torch.vtensor<[4,32,128],f32>"
+inline std::string MatmulNode::getResultTypesAsm() const {
+  return matmulAttr.getC()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true);
+}
+
+// Get permute ops for input A in MLIR assembly format.
+inline std::string MatmulNode::getPermuteAOpsAsm() const {
+  std::ostringstream oss;
+
+  std::string prefix = "permute_A";
+  std::string suffix = matmulAttr.getName();
+  std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
+
+  // Emit permute dimensions based on layout.
+  oss << getListOfIntOpsAsm(aT->getPhysicalToLogicalPermuteOrder(), prefix,
+                            suffix);
+
+  // Emit the permute op itself.
+  constexpr std::string_view schema = R"(
+    {0}_A_{1}_perm = torch.aten.permute {0}, {2} : {3}, !torch.list<int> -> {4}
+  )";
+
+  std::string output =
+      std::format(schema,
+                  aT->getValueNameAsm(),       // {0}
+                  suffix,                      // {1}
+                  "%" + prefix + "_" + suffix, // {2}
+                  aT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                       /*useLogicalDims=*/false), // {3}
+                  aT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                       /*useLogicalDims=*/true) // {4}
+      );
+
+  return oss.str() + output;
+}
+
+// Get permute ops for input B in MLIR assembly format.
+inline std::string MatmulNode::getPermuteBOpsAsm() const {
+  std::ostringstream oss;
+
+  std::string prefix = "permute_B";
+  std::string suffix = matmulAttr.getName();
+  std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+
+  // Emit permute dimensions based on layout.
+  oss << getListOfIntOpsAsm(bT->getPhysicalToLogicalPermuteOrder(), prefix,
+                            suffix);
+
+  // Emit the permute op itself.
+  constexpr std::string_view schema = R"(
+    {0}_B_{1}_perm = torch.aten.permute {0}, {2} : {3}, !torch.list<int> -> {4}
+  )";
+
+  std::string output =
+      std::format(schema,
+                  bT->getValueNameAsm(),       // {0}
+                  suffix,                      // {1}
+                  "%" + prefix + "_" + suffix, // {2}
+                  bT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                       /*useLogicalDims=*/false), // {3}
+                  bT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                       /*useLogicalDims=*/true) // {4}
+      );
+
+  return oss.str() + output;
+}
+
+// Get permute ops for output C in MLIR assembly format.
+inline std::string MatmulNode::getPermuteCOpsAsm() const {
+  std::ostringstream oss;
+
+  std::string prefix = "permute_C";
+  std::string suffix = matmulAttr.getName();
+  std::shared_ptr<TensorAttr> cT = matmulAttr.getC();
+
+  oss << getListOfIntOpsAsm(cT->getLogicalToPhysicalPermuteOrder(), prefix,
+                            suffix);
+
+  // Emit the permute op itself.
+  constexpr std::string_view schema = R"(
+    {0} = torch.aten.permute {0}_perm, {1} : {2}, !torch.list<int> -> {3}
+  )";
+
+  std::string output =
+      std::format(schema,
+                  cT->getValueNameAsm(),       // {0}
+                  "%" + prefix + "_" + suffix, // {1}
+                  cT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                       /*useLogicalDims=*/true), // {2}
+                  cT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                       /*useLogicalDims=*/false) // {3}
+      );
+
+  return oss.str() + output;
+}
+
+// Get the ops scaling the product by A_SCALE and B_SCALE (when set) in MLIR
+// assembly format, see `getScaleOpsAsm`.
+inline std::string MatmulNode::getScaleOpsAsm() const {
+  std::vector<std::shared_ptr<TensorAttr>> scales = getScales();
+  if (scales.empty())
+    return "";
+  return fusilli::getScaleOpsAsm(*matmulAttr.getC(), scales,
+                                 matmulAttr.getName());
+}
+
+// This gets called by the recursive `emitAsmSubtree()` method to emit
+// the pre-assembly for each node (including the main Graph). The schema
+// hard-codes things that are not customizable, and leaves the rest
+// for template replacements using `std::format`. When modifying the
+// schema, take extra caution about double bracing the curly brackets
+// (refer to the comments at the top of this file for details).
+//
+// Batch dims are broadcast by `torch.aten.matmul`, as in PyTorch.
+inline std::string MatmulNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}{7}_perm = torch.aten.matmul {3} : {4} -> {5}{8}
+    {6}
+    )";
+
+  // With per-tensor scales, the product is scaled in f32 before being
+  // converted to the data type of C.
+  bool isScaled = !getScales().empty();
+  TensorAttr unscaledC = *matmulAttr.getC();
+  if (isScaled)
+    unscaledC.setDataType(DataType::Float);
+
+  return std::format(schema,
+                     getPermuteAOpsAsm(),  // {0}
+                     getPermuteBOpsAsm(),  // {1}
+                     getResultNamesAsm(),  // {2}
+                     getOperandNamesAsm(), // {3}
+                     getOperandTypesAsm(), // {4}
+                     unscaledC.getTensorTypeAsm(/*isValueTensor=*/true,
+                                                /*useLogicalDims=*/true), // {5}
+                     getPermuteCOpsAsm(),         // {6}
+                     isScaled ? "_unscaled" : "", // {7}
+                     getScaleOpsAsm()             // {8}
+  );
+}
+
 //===----------------------------------------------------------------------===//
 //
 // PointwiseNode ASM Emitter Methods
@@ -1240,12 +1863,715 @@ inline std::string PointwiseNode::emitNodePreAsm() const {
                        getPermuteOut0OpsAsm()    // {7}
     );
   }
+  case PointwiseAttr::Mode::RELU_BWD: {
+    constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    %threshold_{2} = torch.constant.float 0.000000e+00
+    {3}_perm = torch.aten.threshold_backward {4}, %threshold_{2} : {5}, !torch.float -> {6}
+    {7}
+    )";
+    std::string uniqueSSASuffix = getName();
+
+    return std::format(schema,
+                       getPermuteInputOpsAsm(0), // {0}
+                       getPermuteInputOpsAsm(1), // {1}
+                       uniqueSSASuffix,          // {2}
+                       getResultNamesAsm(),      // {3}
+                       getOperandNamesAsm(),     // {4}
+                       getOperandTypesAsm(),     // {5}
+                       getResultTypesAsm(),      // {6}
+                       getPermuteOut0OpsAsm()    // {7}
+    );
+  }
+  case PointwiseAttr::Mode::SIGMOID_FWD:
+  case PointwiseAttr::Mode::SWISH_FWD:
+  case PointwiseAttr::Mode::TANH_FWD: {
+    constexpr std::string_view schema = R"(
+    {0}
+    {1}_perm = torch.aten.{2} {3} : {4} -> {5}
+    {6}
+    )";
+    static const std::unordered_map<PointwiseAttr::Mode, std::string>
+        kModeToOp = {
+            {PointwiseAttr::Mode::SIGMOID_FWD, "sigmoid"},
+            {PointwiseAttr::Mode::SWISH_FWD, "silu"},
+            {PointwiseAttr::Mode::TANH_FWD, "tanh"},
+        };
+
+    return std::format(schema,
+                       getPermuteInputOpsAsm(0),              // {0}
+                       getResultNamesAsm(),                   // {1}
+                       kModeToOp.at(pointwiseAttr.getMode()), // {2}
+                       getOperandNamesAsm(),                  // {3}
+                       getOperandTypesAsm(),                  // {4}
+                       getResultTypesAsm(),                   // {5}
+                       getPermuteOut0OpsAsm()                 // {6}
+    );
+  }
+  case PointwiseAttr::Mode::SIGMOID_BWD:
+  case PointwiseAttr::Mode::TANH_BWD: {
+    constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}_perm = torch.aten.{3} {4} : {5} -> {6}
+    {7}
+    )";
+    static const std::unordered_map<PointwiseAttr::Mode, std::string>
+        kModeToOp = {
+            {PointwiseAttr::Mode::SIGMOID_BWD, "sigmoid_backward"},
+            {PointwiseAttr::Mode::TANH_BWD, "tanh_backward"},
+        };
+
+    return std::format(schema,
+                       getPermuteInputOpsAsm(0),              // {0}
+                       getPermuteInputOpsAsm(1),              // {1}
+                       getResultNamesAsm(),                   // {2}
+                       kModeToOp.at(pointwiseAttr.getMode()), // {3}
+                       getOperandNamesAsm(),                  // {4}
+                       getOperandTypesAsm(),                  // {5}
+                       getResultTypesAsm(),                   // {6}
+                       getPermuteOut0OpsAsm()                 // {7}
+    );
+  }
+  case PointwiseAttr::Mode::GELU_FWD:
+  case PointwiseAttr::Mode::GELU_APPROX_TANH_FWD: {
+    constexpr std::string_view schema = R"(
+    {0}
+    %approximate_{1} = torch.constant.str "{2}"
+    {3}_perm = torch.aten.gelu {4}, %approximate_{1} : {5}, !torch.str -> {6}
+    {7}
+    )";
+    std::string uniqueSSASuffix = getName();
+    bool approxTanh =
+        pointwiseAttr.getMode() == PointwiseAttr::Mode::GELU_APPROX_TANH_FWD;
+
+    return std::format(schema,
+                       getPermuteInputOpsAsm(0),     // {0}
+                       uniqueSSASuffix,              // {1}
+                       approxTanh ? "tanh" : "none", // {2}
+                       getResultNamesAsm(),          // {3}
+                       getOperandNamesAsm(),         // {4}
+                       getOperandTypesAsm(),         // {5}
+                       getResultTypesAsm(),          // {6}
+                       getPermuteOut0OpsAsm()        // {7}
+    );
+  }
+  case PointwiseAttr::Mode::GELU_BWD:
+  case PointwiseAttr::Mode::GELU_APPROX_TANH_BWD: {
+    constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    %approximate_{2} = torch.constant.str "{3}"
+    {4}_perm = torch.aten.gelu_backward {5}, %approximate_{2} : {6}, !torch.str -> {7}
+    {8}
+    )";
+    std::string uniqueSSASuffix = getName();
+    bool approxTanh =
+        pointwiseAttr.getMode() == PointwiseAttr::Mode::GELU_APPROX_TANH_BWD;
+
+    return std::format(schema,
+                       getPermuteInputOpsAsm(0),     // {0}
+                       getPermuteInputOpsAsm(1),     // {1}
+                       uniqueSSASuffix,              // {2}
+                       approxTanh ? "tanh" : "none", // {3}
+                       getResultNamesAsm(),          // {4}
+                       getOperandNamesAsm(),         // {5}
+                       getOperandTypesAsm(),         // {6}
+                       getResultTypesAsm(),          // {7}
+                       getPermuteOut0OpsAsm()        // {8}
+    );
+  }
+  case PointwiseAttr::Mode::CLAMP: {
+    constexpr std::string_view schema = R"(
+    {0}
+    %clamp_min_{1} = {2}
+    %clamp_max_{1} = {3}
+    {4}_perm = torch.aten.clamp {5}, %clamp_min_{1}, %clamp_max_{1} : {6}, {7}, {8} -> {9}
+    {10}
+    )";
+    std::string uniqueSSASuffix = getName();
+    // Unset bounds are `None`.
+    auto getBoundAsm = [](const std::optional<float> &bound) {
+      return bound ? std::format("torch.constant.float {:e}", *bound)
+                   : std::string("torch.constant.none");
+    };
+    auto getBoundTypeAsm = [](const std::optional<float> &bound) {
+      return bound ? "!torch.float" : "!torch.none";
+    };
+
+    return std::format(schema,
+                       getPermuteInputOpsAsm(0),                     // {0}
+                       uniqueSSASuffix,                              // {1}
+                       getBoundAsm(pointwiseAttr.getClampMin()),     // {2}
+                       getBoundAsm(pointwiseAttr.getClampMax()),     // {3}
+                       getResultNamesAsm(),                          // {4}
+                       getOperandNamesAsm(),                         // {5}
+                       getOperandTypesAsm(),                         // {6}
+                       getBoundTypeAsm(pointwiseAttr.getClampMin()), // {7}
+                       getBoundTypeAsm(pointwiseAttr.getClampMax()), // {8}
+                       getResultTypesAsm(),                          // {9}
+                       getPermuteOut0OpsAsm()                        // {10}
+    );
+  }
+  case PointwiseAttr::Mode::SCALE_SHIFT: {
+    // IN_0 * IN_1 + IN_2 as `torch.aten.addcmul`, computing
+    // self + value * tensor1 * tensor2 with self = IN_2.
+    constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+    %value_{3} = torch.constant.int 1
+    {4}_perm = torch.aten.addcmul {5}_in2_{3}_perm, {6}_in0_{3}_perm, {7}_in1_{3}_perm, %value_{3} : {8}, {9}, {10}, !torch.int -> {11}
+    {12}
+    )";
+    std::string uniqueSSASuffix = getName();
+    const auto &in0 = pointwiseAttr.getIN_0();
+    const auto &in1 = pointwiseAttr.getIN_1();
+    const auto &in2 = pointwiseAttr.getIN_2();
+
+    return std::format(schema,
+                       getPermuteInputOpsAsm(0), // {0}
+                       getPermuteInputOpsAsm(1), // {1}
+                       getPermuteInputOpsAsm(2), // {2}
+                       uniqueSSASuffix,          // {3}
+                       getResultNamesAsm(),      // {4}
+                       in2->getValueNameAsm(),   // {5}
+                       in0->getValueNameAsm(),   // {6}
+                       in1->getValueNameAsm(),   // {7}
+                       in2->getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true), // {8}
+                       in0->getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true), // {9}
+                       in1->getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true), // {10}
+                       getResultTypesAsm(),   // {11}
+                       getPermuteOut0OpsAsm() // {12}
+    );
+  }
   default:
     assert(false && "Unsupported pointwise mode");
     return "";
   }
 }
 
+//===----------------------------------------------------------------------===//
+//
+// Normalization Node ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Get permute ops for the input `t` (the `operand` of the node `suffix`, e.g.
+// "X") to its logical dims in MLIR assembly format, as the SSA value
+// `{t}_{operand}_{suffix}_perm`. Shared by the normalization, reduction and
+// SDPA nodes.
+inline std::string getNodePermuteInputOpsAsm(const TensorAttr &t,
+                                             const std::string &operand,
+                                             const std::string &suffix) {
+  std::ostringstream oss;
+
+  std::string prefix = "permute_" + operand;
+
+  // Emit permute dimensions based on layout.
+  oss << getListOfIntOpsAsm(t.getPhysicalToLogicalPermuteOrder(), prefix,
+                            suffix);
+
+  // Emit the permute op itself.
+  constexpr std::string_view schema = R"(
+    {0}_{1}_{2}_perm = torch.aten.permute {0}, {3} : {4}, !torch.list<int> -> {5}
+  )";
+
+  std::string output =
+      std::format(schema,
+                  t.getValueNameAsm(),         // {0}
+                  operand,                     // {1}
+                  suffix,                      // {2}
+                  "%" + prefix + "_" + suffix, // {3}
+                  t.getTensorTypeAsm(/*isValueTensor=*/true,
+                                     /*useLogicalDims=*/false), // {4}
+                  t.getTensorTypeAsm(/*isValueTensor=*/true,
+                                     /*useLogicalDims=*/true) // {5}
+      );
+
+  return oss.str() + output;
+}
+
+// Get permute ops for the output `t` (the `operand` of the node `suffix`,
+// e.g. "Y") from its logical dims, computed as the SSA value `source`, in
+// MLIR assembly format. Shared by the normalization, reduction and SDPA
+// nodes.
+inline std::string getNodePermuteOutputOpsAsm(const TensorAttr &t,
+                                              const std::string &operand,
+                                              const std::string &source,
+                                              const std::string &suffix) {
+  std::ostringstream oss;
+
+  std::string prefix = "permute_" + operand;
+
+  oss << getListOfIntOpsAsm(t.getLogicalToPhysicalPermuteOrder(), prefix,
+                            suffix);
+
+  // Emit the permute op itself.
+  constexpr std::string_view schema = R"(
+    {0} = torch.aten.permute {1}, {2} : {3}, !torch.list<int> -> {4}
+  )";
+
+  std::string output =
+      std::format(schema,
+                  t.getValueNameAsm(),         // {0}
+                  source,                      // {1}
+                  "%" + prefix + "_" + suffix, // {2}
+                  t.getTensorTypeAsm(/*isValueTensor=*/true,
+                                     /*useLogicalDims=*/true), // {3}
+                  t.getTensorTypeAsm(/*isValueTensor=*/true,
+                                     /*useLogicalDims=*/false) // {4}
+      );
+
+  return oss.str() + output;
+}
+
+// Emits the logical value tensor type of the statistics of dims `dim` of a
+// normalization of `xT`, which are computed in its data type.
+inline std::string getNormStatsTypeAsm(const std::vector<int64_t> &dim,
+                                       const TensorAttr &xT) {
+  TensorAttr statsT;
+  statsT.setDim(dim)
+      .setStride(
+          generateStrideFromDim(dim, getContiguousStrideOrder(dim.size())))
+      .setDataType(xT.getDataType());
+  return statsT.getTensorTypeAsm(/*isValueTensor=*/true,
+                                 /*useLogicalDims=*/true);
+}
+
+// Emits the ops computing the (biased) variance `%var_{suffix}` and mean
+// `%mean_{suffix}` of the permuted input `x` of the normalization node
+// `suffix` over `reductionDims`, keeping them as dims of size 1.
+inline std::string getNormStatsOpsAsm(const TensorAttr &xT,
+                                      const std::vector<int64_t> &reductionDims,
+                                      const std::string &statsType,
+                                      const std::string &suffix) {
+  constexpr std::string_view schema = R"(
+    {0}
+    %correction_{1} = torch.constant.int 0
+    %keepdim_{1} = torch.constant.bool true
+    %var_{1}, %mean_{1} = torch.aten.var_mean.correction {2}_X_{1}_perm, %reduction_dims_{1}, %correction_{1}, %keepdim_{1} : {3}, !torch.list<int>, !torch.int, !torch.bool -> {4}, {4}
+  )";
+
+  return std::format(schema,
+                     getListOfIntOpsAsm(reductionDims, "reduction_dims",
+                                        suffix), // {0}
+                     suffix,                     // {1}
+                     xT.getValueNameAsm(),       // {2}
+                     xT.getTensorTypeAsm(/*isValueTensor=*/true,
+                                         /*useLogicalDims=*/true), // {3}
+                     statsType                                     // {4}
+  );
+}
+
+// Emits the ops of the normalization node `suffix` computing its output
+//    Y = (X - mean) * rsqrt(var + epsilon) * SCALE + BIAS
+// as `{y}_perm` from its permuted inputs and the statistics `mean` and `var`
+// of type `statsType`, with `%inv_std_{suffix}` the inverse standard
+// deviation.
+inline std::string getNormApplyOpsAsm(const TensorAttr &xT,
+                                      const TensorAttr &scaleT,
+                                      const TensorAttr &biasT,
+                                      const TensorAttr &yT,
+                                      const std::string &mean,
+                                      const std::string &var,
+                                      const std::string &statsType,
+                                      float epsilon,
+                                      const std::string &suffix) {
+  constexpr std::string_view schema = R"(
+    %epsilon_{0} = torch.constant.float {1:e}
+    %alpha_{0} = torch.constant.int 1
+    %var_eps_{0} = torch.aten.add.Scalar {2}, %epsilon_{0}, %alpha_{0} : {3}, !torch.float, !torch.int -> {3}
+    %inv_std_{0} = torch.aten.rsqrt %var_eps_{0} : {3} -> {3}
+    %centered_{0} = torch.aten.sub.Tensor {4}_X_{0}_perm, {5}, %alpha_{0} : {6}, {3}, !torch.int -> {6}
+    %normalized_{0} = torch.aten.mul.Tensor %centered_{0}, %inv_std_{0} : {6}, {3} -> {6}
+    %scaled_{0} = torch.aten.mul.Tensor %normalized_{0}, {7}_SCALE_{0}_perm : {6}, {8} -> {6}
+    {9}_perm = torch.aten.add.Tensor %scaled_{0}, {10}_BIAS_{0}_perm, %alpha_{0} : {6}, {11}, !torch.int -> {12}
+  )";
+
+  return std::format(schema,
+                     suffix,                 // {0}
+                     epsilon,                // {1}
+                     var,                    // {2}
+                     statsType,              // {3}
+                     xT.getValueNameAsm(),   // {4}
+                     mean,                   // {5}
+                     xT.getTensorTypeAsm(/*isValueTensor=*/true,
+                                         /*useLogicalDims=*/true), // {6}
+                     scaleT.getValueNameAsm(),                     // {7}
+                     scaleT.getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true), // {8}
+                     yT.getValueNameAsm(),                             // {9}
+                     biasT.getValueNameAsm(),                          // {10}
+                     biasT.getTensorTypeAsm(/*isValueTensor=*/true,
+                                            /*useLogicalDims=*/true), // {11}
+                     yT.getTensorTypeAsm(/*isValueTensor=*/true,
+                                         /*useLogicalDims=*/true) // {12}
+  );
+}
+
+// This gets called by the recursive `emitAsmSubtree()` method to emit
+// the pre-assembly for each node (including the main Graph). The schema
+// hard-codes things that are not customizable, and leaves the rest
+// for template replacements using `std::format`. When modifying the
+// schema, take extra caution about double bracing the curly brackets
+// (refer to the comments at the top of this file for details).
+//
+// INFERENCE normalizes with the running MEAN and VAR inputs, leaving only
+// elementwise ops to be fused with the producer of X and consumers of Y.
+// TRAINING reduces X over all dims but the channel dim for the statistics
+// of the batch.
+inline std::string BatchnormNode::emitNodePreAsm() const {
+  std::string suffix = getName();
+  std::shared_ptr<TensorAttr> xT = batchnormAttr.getX();
+  std::shared_ptr<TensorAttr> scaleT = batchnormAttr.getSCALE();
+  std::shared_ptr<TensorAttr> biasT = batchnormAttr.getBIAS();
+  std::shared_ptr<TensorAttr> yT = batchnormAttr.getY();
+  std::string statsType =
+      getNormStatsTypeAsm(getBatchnormChannelDim(xT->getDim()), *xT);
+
+  std::ostringstream oss;
+  oss << getNodePermuteInputOpsAsm(*xT, "X", suffix)
+      << getNodePermuteInputOpsAsm(*scaleT, "SCALE", suffix)
+      << getNodePermuteInputOpsAsm(*biasT, "BIAS", suffix);
+
+  if (batchnormAttr.getForwardPhase() == NormFwdPhase::INFERENCE) {
+    std::shared_ptr<TensorAttr> meanT = batchnormAttr.getMEAN();
+    std::shared_ptr<TensorAttr> varT = batchnormAttr.getVAR();
+    oss << getNodePermuteInputOpsAsm(*meanT, "MEAN", suffix)
+        << getNodePermuteInputOpsAsm(*varT, "VAR", suffix)
+        << getNormApplyOpsAsm(
+               *xT, *scaleT, *biasT, *yT,
+               meanT->getValueNameAsm() + "_MEAN_" + suffix + "_perm",
+               varT->getValueNameAsm() + "_VAR_" + suffix + "_perm",
+               statsType, batchnormAttr.getEpsilon(), suffix)
+        << getNodePermuteOutputOpsAsm(*yT, "Y", yT->getValueNameAsm() + "_perm",
+                                      suffix);
+    return oss.str();
+  }
+
+  oss << getNormStatsOpsAsm(*xT,
+                            getNormReductionDims(xT->getDim().size(),
+                                                 /*keptDim=*/1),
+                            statsType, suffix)
+      << getNormApplyOpsAsm(*xT, *scaleT, *biasT, *yT, "%mean_" + suffix,
+                            "%var_" + suffix, statsType,
+                            batchnormAttr.getEpsilon(), suffix)
+      << getNodePermuteOutputOpsAsm(*yT, "Y", yT->getValueNameAsm() + "_perm",
+                                    suffix)
+      << getNodePermuteOutputOpsAsm(*batchnormAttr.getSAVED_MEAN(),
+                                    "SAVED_MEAN", "%mean_" + suffix, suffix)
+      << getNodePermuteOutputOpsAsm(*batchnormAttr.getSAVED_INV_VARIANCE(),
+                                    "SAVED_INV_VARIANCE", "%inv_std_" + suffix,
+                                    suffix);
+  return oss.str();
+}
+
+// This gets called by the recursive `emitAsmSubtree()` method to emit
+// the pre-assembly for each node (including the main Graph). The schema
+// hard-codes things that are not customizable, and leaves the rest
+// for template replacements using `std::format`. When modifying the
+// schema, take extra caution about double bracing the curly brackets
+// (refer to the comments at the top of this file for details).
+//
+// Reduces X over all dims but the batch dim for the statistics of each
+// sample, which are output in TRAINING.
+inline std::string LayernormNode::emitNodePreAsm() const {
+  std::string suffix = getName();
+  std::shared_ptr<TensorAttr> xT = layernormAttr.getX();
+  std::shared_ptr<TensorAttr> scaleT = layernormAttr.getSCALE();
+  std::shared_ptr<TensorAttr> biasT = layernormAttr.getBIAS();
+  std::shared_ptr<TensorAttr> yT = layernormAttr.getY();
+  std::string statsType =
+      getNormStatsTypeAsm(getNormSampleStatsDim(xT->getDim()), *xT);
+
+  std::ostringstream oss;
+  oss << getNodePermuteInputOpsAsm(*xT, "X", suffix)
+      << getNodePermuteInputOpsAsm(*scaleT, "SCALE", suffix)
+      << getNodePermuteInputOpsAsm(*biasT, "BIAS", suffix)
+      << getNormStatsOpsAsm(*xT,
+                            getNormReductionDims(xT->getDim().size(),
+                                                 /*keptDim=*/0),
+                            statsType, suffix)
+      << getNormApplyOpsAsm(*xT, *scaleT, *biasT, *yT, "%mean_" + suffix,
+                            "%var_" + suffix, statsType,
+                            layernormAttr.getEpsilon(), suffix)
+      << getNodePermuteOutputOpsAsm(*yT, "Y", yT->getValueNameAsm() + "_perm",
+                                    suffix);
+
+  if (layernormAttr.getForwardPhase() == NormFwdPhase::TRAINING)
+    oss << getNodePermuteOutputOpsAsm(*layernormAttr.getMEAN(), "MEAN",
+                                      "%mean_" + suffix, suffix)
+        << getNodePermuteOutputOpsAsm(*layernormAttr.getINV_VARIANCE(),
+                                      "INV_VARIANCE", "%inv_std_" + suffix,
+                                      suffix);
+  return oss.str();
+}
+
+// This gets called by the recursive `emitAsmSubtree()` method to emit
+// the pre-assembly for each node (including the main Graph). The schema
+// hard-codes things that are not customizable, and leaves the rest
+// for template replacements using `std::format`. When modifying the
+// schema, take extra caution about double bracing the curly brackets
+// (refer to the comments at the top of this file for details).
+//
+// Computes Y = X * rsqrt(mean(X * X) + epsilon) * SCALE, with the mean over
+// all dims but the batch dim, and outputs the inverse root mean square in
+// TRAINING.
+inline std::string RmsnormNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+    %keepdim_{3} = torch.constant.bool true
+    %none_{3} = torch.constant.none
+    %epsilon_{3} = torch.constant.float {4:e}
+    %alpha_{3} = torch.constant.int 1
+    %squared_{3} = torch.aten.mul.Tensor {5}_X_{3}_perm, {5}_X_{3}_perm : {6}, {6} -> {6}
+    %mean_square_{3} = torch.aten.mean.dim %squared_{3}, %reduction_dims_{3}, %keepdim_{3}, %none_{3} : {6}, !torch.list<int>, !torch.bool, !torch.none -> {7}
+    %mean_square_eps_{3} = torch.aten.add.Scalar %mean_square_{3}, %epsilon_{3}, %alpha_{3} : {7}, !torch.float, !torch.int -> {7}
+    %inv_rms_{3} = torch.aten.rsqrt %mean_square_eps_{3} : {7} -> {7}
+    %normalized_{3} = torch.aten.mul.Tensor {5}_X_{3}_perm, %inv_rms_{3} : {6}, {7} -> {6}
+    {8}_perm = torch.aten.mul.Tensor %normalized_{3}, {9}_SCALE_{3}_perm : {6}, {10} -> {11}
+    {12}
+    )";
+
+  std::string suffix = getName();
+  std::shared_ptr<TensorAttr> xT = rmsnormAttr.getX();
+  std::shared_ptr<TensorAttr> scaleT = rmsnormAttr.getSCALE();
+  std::shared_ptr<TensorAttr> yT = rmsnormAttr.getY();
+
+  std::string reductionDimsOps = getListOfIntOpsAsm(
+      getNormReductionDims(xT->getDim().size(), /*keptDim=*/0),
+      "reduction_dims", suffix);
+  std::string statsType =
+      getNormStatsTypeAsm(getNormSampleStatsDim(xT->getDim()), *xT);
+
+  std::string permuteOutputOps = getNodePermuteOutputOpsAsm(
+      *yT, "Y", yT->getValueNameAsm() + "_perm", suffix);
+  if (rmsnormAttr.getForwardPhase() == NormFwdPhase::TRAINING)
+    permuteOutputOps += getNodePermuteOutputOpsAsm(
+        *rmsnormAttr.getINV_RMS(), "INV_RMS", "%inv_rms_" + suffix, suffix);
+
+  return std::format(schema,
+                     getNodePermuteInputOpsAsm(*xT, "X", suffix), // {0}
+                     getNodePermuteInputOpsAsm(*scaleT, "SCALE",
+                                               suffix), // {1}
+                     reductionDimsOps,                  // {2}
+                     suffix,                            // {3}
+                     rmsnormAttr.getEpsilon(),          // {4}
+                     xT->getValueNameAsm(),             // {5}
+                     xT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {6}
+                     statsType,                                     // {7}
+                     yT->getValueNameAsm(),                         // {8}
+                     scaleT->getValueNameAsm(),                     // {9}
+                     scaleT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                              /*useLogicalDims=*/true), // {10}
+                     yT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {11}
+                     permuteOutputOps                               // {12}
+  );
+}
+
+
+//===----------------------------------------------------------------------===//
+//
+// Reduction Node ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// This gets called by the recursive `emitAsmSubtree()` method to emit
+// the pre-assembly for each node (including the main Graph). The schema
+// hard-codes things that are not customizable, and leaves the rest
+// for template replacements using `std::format`. When modifying the
+// schema, take extra caution about double bracing the curly brackets
+// (refer to the comments at the top of this file for details).
+//
+// The reduced dims are kept (as dims of size 1), so Y has the rank of X.
+inline std::string ReductionNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    %keepdim_{2} = torch.constant.bool true
+    {3}
+    {4}
+    )";
+
+  std::string suffix = getName();
+  std::shared_ptr<TensorAttr> xT = reductionAttr.getX();
+  std::shared_ptr<TensorAttr> yT = reductionAttr.getY();
+
+  std::string xName = xT->getValueNameAsm() + "_X_" + suffix + "_perm";
+  std::string xType = xT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                           /*useLogicalDims=*/true);
+  std::string yType = yT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                           /*useLogicalDims=*/true);
+
+  // `torch.aten.amax` has no dtype operand, unlike the sum and mean ops.
+  std::string reductionOp;
+  switch (reductionAttr.getMode()) {
+  case ReductionAttr::Mode::MAX:
+    reductionOp = std::format(
+        "{0}_perm = torch.aten.amax {1}, %reduction_dims_{2}, %keepdim_{2} : "
+        "{3}, !torch.list<int>, !torch.bool -> {4}",
+        yT->getValueNameAsm(), xName, suffix, xType, yType);
+    break;
+  case ReductionAttr::Mode::MEAN:
+  case ReductionAttr::Mode::SUM:
+    reductionOp = std::format(
+        "%none_{2} = torch.constant.none\n    "
+        "{0}_perm = torch.aten.{5} {1}, %reduction_dims_{2}, %keepdim_{2}, "
+        "%none_{2} : {3}, !torch.list<int>, !torch.bool, !torch.none -> {4}",
+        yT->getValueNameAsm(), xName, suffix, xType, yType,
+        reductionAttr.getMode() == ReductionAttr::Mode::SUM ? "sum.dim_IntList"
+                                                            : "mean.dim");
+    break;
+  default:
+    assert(false && "Unsupported reduction mode");
+  }
+
+  return std::format(schema,
+                     getNodePermuteInputOpsAsm(*xT, "X", suffix), // {0}
+                     getListOfIntOpsAsm(reductionAttr.getAxes(),
+                                        "reduction_dims", suffix), // {1}
+                     suffix,                                       // {2}
+                     reductionOp,                                  // {3}
+                     getNodePermuteOutputOpsAsm(
+                         *yT, "Y", yT->getValueNameAsm() + "_perm",
+                         suffix) // {4}
+  );
+}
+
+// This gets called by the recursive `emitAsmSubtree()` method to emit
+// the pre-assembly for each node (including the main Graph). The schema
+// hard-codes things that are not customizable, and leaves the rest
+// for template replacements using `std::format`. When modifying the
+// schema, take extra caution about double bracing the curly brackets
+// (refer to the comments at the top of this file for details).
+inline std::string SoftmaxNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    %axis_{1} = torch.constant.int {2}
+    %none_{1} = torch.constant.none
+    {3}_perm = torch.aten.softmax.int {4}_X_{1}_perm, %axis_{1}, %none_{1} : {5}, !torch.int, !torch.none -> {6}
+    {7}
+    )";
+
+  std::string suffix = getName();
+  std::shared_ptr<TensorAttr> xT = softmaxAttr.getX();
+  std::shared_ptr<TensorAttr> yT = softmaxAttr.getY();
+
+  return std::format(schema,
+                     getNodePermuteInputOpsAsm(*xT, "X", suffix), // {0}
+                     suffix,                                      // {1}
+                     *softmaxAttr.getAxis(),                      // {2}
+                     yT->getValueNameAsm(),                       // {3}
+                     xT->getValueNameAsm(),                       // {4}
+                     xT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {5}
+                     yT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {6}
+                     getNodePermuteOutputOpsAsm(
+                         *yT, "Y", yT->getValueNameAsm() + "_perm",
+                         suffix) // {7}
+  );
+}
+
+
+//===----------------------------------------------------------------------===//
+//
+// SdpaNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// This gets called by the recursive `emitAsmSubtree()` method to emit
+// the pre-assembly for each node (including the main Graph). The schema
+// hard-codes things that are not customizable, and leaves the rest
+// for template replacements using `std::format`. When modifying the
+// schema, take extra caution about double bracing the curly brackets
+// (refer to the comments at the top of this file for details).
+//
+// Dropout is not supported (its probability is always 0), and a missing
+// MASK or scale is passed as `torch.constant.none`, for which
+// `torch.aten.scaled_dot_product_attention` applies no mask and a scale of
+// 1 / sqrt(D).
+inline std::string SdpaNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+    {3}
+    %dropout_p_{4} = torch.constant.float 0.000000e+00
+    %is_causal_{4} = torch.constant.bool {5}
+    {6}
+    %enable_gqa_{4} = torch.constant.bool false
+    {7}_perm = torch.aten.scaled_dot_product_attention {8}_Q_{4}_perm, {9}_K_{4}_perm, {10}_V_{4}_perm, {11}, %dropout_p_{4}, %is_causal_{4}, %scale_{4}, %enable_gqa_{4} : {12}, {13}, {14}, {15}, !torch.float, !torch.bool, {16}, !torch.bool -> {17}
+    {18}
+    )";
+
+  std::string suffix = getName();
+  std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
+  std::shared_ptr<TensorAttr> kT = sdpaAttr.getK();
+  std::shared_ptr<TensorAttr> vT = sdpaAttr.getV();
+  std::shared_ptr<TensorAttr> maskT = sdpaAttr.getMASK();
+  std::shared_ptr<TensorAttr> oT = sdpaAttr.getO();
+
+  std::string maskOps, maskName, maskType;
+  if (maskT) {
+    maskOps = getNodePermuteInputOpsAsm(*maskT, "MASK", suffix);
+    maskName = maskT->getValueNameAsm() + "_MASK_" + suffix + "_perm";
+    maskType = maskT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                       /*useLogicalDims=*/true);
+  } else {
+    maskOps = "%mask_" + suffix + " = torch.constant.none";
+    maskName = "%mask_" + suffix;
+    maskType = "!torch.none";
+  }
+
+  std::string scaleOp, scaleType;
+  if (sdpaAttr.getScale().has_value()) {
+    scaleOp = std::format("%scale_{} = torch.constant.float {:e}", suffix,
+                          *sdpaAttr.getScale());
+    scaleType = "!torch.float";
+  } else {
+    scaleOp = "%scale_" + suffix + " = torch.constant.none";
+    scaleType = "!torch.none";
+  }
+
+  return std::format(schema,
+                     getNodePermuteInputOpsAsm(*qT, "Q", suffix), // {0}
+                     getNodePermuteInputOpsAsm(*kT, "K", suffix), // {1}
+                     getNodePermuteInputOpsAsm(*vT, "V", suffix), // {2}
+                     maskOps,                                     // {3}
+                     suffix,                                      // {4}
+                     sdpaAttr.getCausal() ? "true" : "false",     // {5}
+                     scaleOp,                                     // {6}
+                     oT->getValueNameAsm(),                       // {7}
+                     qT->getValueNameAsm(),                       // {8}
+                     kT->getValueNameAsm(),                       // {9}
+                     vT->getValueNameAsm(),                       // {10}
+                     maskName,                                    // {11}
+                     qT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {12}
+                     kT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {13}
+                     vT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {14}
+                     maskType,                                      // {15}
+                     scaleType,                                     // {16}
+                     oT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {17}
+                     getNodePermuteOutputOpsAsm(
+                         *oT, "O", oT->getValueNameAsm() + "_perm",
+                         suffix) // {18}
+  );
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_SUPPORT_ASM_EMITTER_H
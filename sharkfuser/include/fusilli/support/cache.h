@@ -6,7 +6,8 @@
 
 //===----------------------------------------------------------------------===//
 //
-// This file contains classes for cache file handling of generated artifacts.
+// This file contains classes for cache file handling of generated artifacts,
+// and for managing the size of the cache directory.
 //
 //===----------------------------------------------------------------------===//
 
@@ -15,21 +16,118 @@
 
 #include "fusilli/support/logging.h"
 
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <ios>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 namespace fusilli {
 
+// Returns the cache directory, holding a sub-directory per cached graph.
+//
+// Defaults to "${HOME}/.cache/fusilli" but having it set via
+// ${FUSILLI_CACHE_DIR} to "/tmp" helps bypass permission issues on
+// the GitHub Actions CI runners as well as for LIT tests that rely
+// on dumping/reading intermediate compilation artifacts to/from disk.
+inline std::filesystem::path getCacheDirectory() {
+  const char *cacheDir = std::getenv("FUSILLI_CACHE_DIR");
+  if (!cacheDir)
+    cacheDir = std::getenv("HOME");
+  return std::filesystem::path(cacheDir) / ".cache" / "fusilli";
+}
+
+// Returns a path next to `path`, unique to this process and call, to write
+// the contents of `path` to before renaming it into place. Renames within a
+// directory are atomic, so that processes sharing the cache never read
+// partially written files.
+inline std::filesystem::path
+getTempCachePath(const std::filesystem::path &path) {
+  static std::atomic<uint64_t> counter = 0;
+  return path.string() + ".tmp" + std::to_string(getpid()) + "_" +
+         std::to_string(counter++);
+}
+
+// An RAII lock on the cache entry of a graph, shared by the processes using
+// the cache directory (e.g. the ranks of a job on a node): processes compiling
+// the same graph wait for the first one, then reuse its artifacts rather than
+// each compiling them. The lock is an advisory `flock` on a file next to the
+// entry, released when this object is destroyed or the process exits.
+class CacheLock {
+public:
+  // Blocks until the lock of `graphName` is acquired.
+  static ErrorOr<CacheLock> acquire(const std::string &graphName) {
+    std::filesystem::path path = getPath(graphName);
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to create cache directory: " +
+                                path.parent_path().string() + " - " +
+                                ec.message());
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    FUSILLI_RETURN_ERROR_IF(fd < 0, ErrorCode::FileSystemFailure,
+                            "Failed to open cache lock: " + path.string());
+    while (::flock(fd, LOCK_EX) != 0) {
+      if (errno != EINTR) {
+        ::close(fd);
+        return error(ErrorCode::FileSystemFailure,
+                     "Failed to lock cache lock: " + path.string());
+      }
+    }
+    return ok(CacheLock(fd));
+  }
+
+  // Path of the lock file of `graphName`. It is not a directory, so it is
+  // not an entry of the cache (see `CacheManager`).
+  static std::filesystem::path getPath(const std::string &graphName) {
+    return getCacheDirectory() / (graphName + ".lock");
+  }
+
+  CacheLock(CacheLock &&other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+  CacheLock &operator=(CacheLock &&other) noexcept {
+    if (this != &other) {
+      release();
+      fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+  }
+  CacheLock(const CacheLock &) = delete;
+  CacheLock &operator=(const CacheLock &) = delete;
+  ~CacheLock() { release(); }
+
+private:
+  explicit CacheLock(int fd) : fd_(fd) {}
+
+  void release() {
+    if (fd_ < 0)
+      return;
+    ::flock(fd_, LOCK_UN);
+    ::close(fd_);
+    fd_ = -1;
+  }
+
+  int fd_;
+};
+
 // An RAII type for creating + destroying cache files in
 // `${HOME}/.cache/fusilli`.
 //
@@ -79,6 +177,10 @@ public:
                                 cacheDir.string() + " - " + ec.message());
 
     // Create file: ${HOME}/.cache/fusilli/<graphName>/<fileName>
+    //
+    // An existing file is replaced rather than truncated, as it may be memory
+    // mapped (e.g. a loaded compiled artifact, see `Graph::getSharedModule`).
+    std::filesystem::remove(path, ec);
     std::ofstream file(path);
     FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
                             "Failed to create file: " + path.string());
@@ -88,9 +190,11 @@ public:
   }
 
   // Factory constructor that opens an existing file and returns ErrorObject if
-  // the file does not exist.
+  // the file does not exist. Set `remove = true` to remove the file when the
+  // returned `CacheFile` lifetime ends.
   static ErrorOr<CacheFile> open(const std::string &graphName,
-                                 const std::string &fileName) {
+                                 const std::string &fileName,
+                                 bool remove = false) {
     std::filesystem::path path = CacheFile::getPath(graphName, fileName);
 
     // Check if the file exists.
@@ -98,13 +202,16 @@ public:
                             ErrorCode::FileSystemFailure,
                             "File does not exist: " + path.string());
 
-    return ok(CacheFile(path, /*remove=*/false));
+    return ok(CacheFile(path, remove));
   }
 
   // Utility method to build the path to cache file given `graphName` and
   // `fileName`.
   //
   // Format: ${HOME}/.cache/fusilli/<sanitized version of graphName>/<fileName>
+  //
+  // Note: `Graph` names its cache files after the key of its compiled
+  // artifacts rather than its name (see `Graph::getCacheKey`).
   static std::filesystem::path getPath(const std::string &graphName,
                                        const std::string &fileName) {
     // Ensure graphName is safe to use as a directory name, we assume fileName
@@ -121,15 +228,7 @@ public:
     if (sanitizedGraphName.empty())
       sanitizedGraphName = "unnamed_graph";
 
-    // Defaults to "${HOME}/.cache/fusilli" but having it set via
-    // ${FUSILLI_CACHE_DIR} to "/tmp" helps bypass permission issues on
-    // the GitHub Actions CI runners as well as for LIT tests that rely
-    // on dumping/reading intermediate compilation artifacts to/from disk.
-    const char *cacheDir = std::getenv("FUSILLI_CACHE_DIR");
-    if (!cacheDir)
-      cacheDir = std::getenv("HOME");
-    return std::filesystem::path(cacheDir) / ".cache" / "fusilli" /
-           sanitizedGraphName / fileName;
+    return getCacheDirectory() / sanitizedGraphName / fileName;
   }
 
   // Move constructors.
@@ -170,16 +269,33 @@ public:
   // Path of file this class wraps.
   std::filesystem::path path;
 
-  // Write to cache file.
+  // Write to cache file. The file is replaced atomically (see
+  // `getTempCachePath`), so that readers see either the previous or the new
+  // contents.
   ErrorObject write(const std::string &content) {
-    std::ofstream file(path);
-    FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
-                            "Failed to open file: " + path.string());
-
-    file << content;
-    FUSILLI_RETURN_ERROR_IF(!file.good(), ErrorCode::FileSystemFailure,
-                            "Failed to write to file: " + path.string());
+    std::filesystem::path tempPath = getTempCachePath(path);
+    {
+      std::ofstream file(tempPath);
+      FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                              "Failed to open file: " + tempPath.string());
+
+      file << content;
+      file.close();
+      if (!file.good()) {
+        std::filesystem::remove(tempPath);
+        return error(ErrorCode::FileSystemFailure,
+                     "Failed to write to file: " + path.string());
+      }
+    }
 
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+      std::filesystem::remove(tempPath);
+      return error(ErrorCode::FileSystemFailure,
+                   "Failed to write to file: " + path.string() + " - " +
+                       ec.message());
+    }
     return ok();
   }
 
@@ -255,21 +371,28 @@ enum class CachedAssetsType : uint8_t {
 
 // Holds cached assets. If `CacheFiles` are set to be removed RAII based removal
 // will be tied to the lifetime of this object.
+//
+// `key` holds the key of the assets (naming their directory), and is written
+// once the other assets are complete: assets whose key file does not match
+// their directory are incomplete (e.g. a compilation failed or was
+// interrupted) and must not be used.
 struct CachedAssets : CleanupCacheDirectory {
   CacheFile input;
   CacheFile output;
   CacheFile command;
   CacheFile statistics;
+  CacheFile key;
 
   CachedAssets(CacheFile &&in, CacheFile &&out, CacheFile &&cmd,
-               CacheFile &&stats)
+               CacheFile &&stats, CacheFile &&key)
       : CleanupCacheDirectory(in.path.parent_path()), input(std::move(in)),
         output(std::move(out)), command(std::move(cmd)),
-        statistics(std::move(stats)) {
+        statistics(std::move(stats)), key(std::move(key)) {
     // sanity checks:
     assert(input.path.parent_path() == output.path.parent_path() &&
            input.path.parent_path() == command.path.parent_path() &&
            input.path.parent_path() == statistics.path.parent_path() &&
+           input.path.parent_path() == this->key.path.parent_path() &&
            "Cached assets should be in the same directory.");
     assert(std::filesystem::is_directory(input.path.parent_path()));
   }
@@ -284,6 +407,313 @@ struct CachedAssets : CleanupCacheDirectory {
   CachedAssets &operator=(const CachedAssets &) = delete;
 };
 
+// Usage of a cache directory, as reported by `CacheManager::getStats`.
+struct CacheStats {
+  std::filesystem::path directory;
+  // Number of cached graphs (sub-directories).
+  size_t numEntries = 0;
+  uintmax_t totalBytes = 0;
+  // Size limit of the cache, 0 if unlimited.
+  uintmax_t maxBytes = 0;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const CacheStats &stats) {
+  os << "Cache directory: " << stats.directory.string() << "\n"
+     << "Entries: " << stats.numEntries << "\n"
+     << "Size: " << stats.totalBytes << " bytes\n"
+     << "Size limit: ";
+  if (stats.maxBytes == 0)
+    os << "unlimited";
+  else
+    os << stats.maxBytes << " bytes";
+  return os;
+}
+
+// Keeps the size of the cache directory (see `getCacheDirectory`) under a
+// limit, by evicting the least recently used entries (the sub-directories
+// holding the cached assets of a graph).
+//
+// The last use of an entry is the last modification time of its directory or
+// files, and `Graph` touches the directories of the entries it reuses. It is
+// used rather than access times, which most file systems do not (or only
+// lazily) update.
+//
+// The limit is read from ${FUSILLI_CACHE_MAX_SIZE}, in bytes with an optional
+// K, M, G or T (binary) suffix, and 0 disables eviction:
+//
+//  FUSILLI_CACHE_MAX_SIZE=512M
+//
+// Entries evicted while in use by another `Graph` (or process) are
+// regenerated by it on its next compilation, and loaded compiled artifacts
+// remain mapped until released.
+class CacheManager {
+public:
+  static constexpr uintmax_t kDefaultMaxBytes = uintmax_t{10} << 30; // 10 GiB
+
+  // Returns the size limit of the cache, 0 if unlimited.
+  static ErrorOr<uintmax_t> getSizeLimit() {
+    const char *limit = std::getenv("FUSILLI_CACHE_MAX_SIZE");
+    if (!limit)
+      return ok(kDefaultMaxBytes);
+
+    std::string value(limit);
+    size_t digits = 0;
+    while (digits < value.size() &&
+           std::isdigit(static_cast<unsigned char>(value[digits])))
+      ++digits;
+    std::string suffix = value.substr(digits);
+    FUSILLI_RETURN_ERROR_IF(digits == 0 || suffix.size() > 1,
+                            ErrorCode::InvalidArgument,
+                            "Invalid FUSILLI_CACHE_MAX_SIZE: " + value);
+    uintmax_t bytes = std::stoull(value.substr(0, digits));
+    if (suffix.empty())
+      return ok(bytes);
+    static const std::string kSuffixes = "KMGT";
+    size_t shift = kSuffixes.find(
+        static_cast<char>(std::toupper(static_cast<unsigned char>(suffix[0]))));
+    FUSILLI_RETURN_ERROR_IF(shift == std::string::npos,
+                            ErrorCode::InvalidArgument,
+                            "Invalid FUSILLI_CACHE_MAX_SIZE: " + value);
+    return ok(bytes << (10 * (shift + 1)));
+  }
+
+  // Returns the usage of the cache in `cacheDir`.
+  static ErrorOr<CacheStats>
+  getStats(const std::filesystem::path &cacheDir = getCacheDirectory()) {
+    CacheStats stats;
+    stats.directory = cacheDir;
+    stats.maxBytes = FUSILLI_TRY(getSizeLimit());
+    for (const Entry &entry : FUSILLI_TRY(listEntries(cacheDir))) {
+      ++stats.numEntries;
+      stats.totalBytes += entry.bytes;
+    }
+    return ok(stats);
+  }
+
+  // Evicts the least recently used entries of `cacheDir` until it holds at
+  // most `maxBytes` (if not 0), except for the entry in `keep` (e.g. the one
+  // just generated). Returns the number of evicted entries.
+  static ErrorOr<size_t>
+  evict(uintmax_t maxBytes, const std::filesystem::path &keep = {},
+        const std::filesystem::path &cacheDir = getCacheDirectory()) {
+    if (maxBytes == 0)
+      return ok(size_t{0});
+
+    std::vector<Entry> entries = FUSILLI_TRY(listEntries(cacheDir));
+    uintmax_t totalBytes = 0;
+    for (const Entry &entry : entries)
+      totalBytes += entry.bytes;
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) {
+                return a.lastUsed < b.lastUsed;
+              });
+
+    size_t numEvicted = 0;
+    for (const Entry &entry : entries) {
+      if (totalBytes <= maxBytes)
+        break;
+      if (!keep.empty() && entry.path == keep)
+        continue;
+      FUSILLI_LOG_LABEL_ENDL("INFO: Evicting cache entry " << entry.path);
+      // Entries may be removed concurrently by other processes.
+      std::error_code ec;
+      std::filesystem::remove_all(entry.path, ec);
+      std::filesystem::remove(entry.path.string() + ".lock", ec);
+      totalBytes -= entry.bytes;
+      ++numEvicted;
+    }
+    return ok(numEvicted);
+  }
+
+  // Evicts entries of the cache past its size limit (see `getSizeLimit`),
+  // except for `keep`.
+  static ErrorObject enforceSizeLimit(const std::filesystem::path &keep = {}) {
+    FUSILLI_CHECK_ERROR(evict(FUSILLI_TRY(getSizeLimit()), keep));
+    return ok();
+  }
+
+  // Marks the entry in `entryDir` used now.
+  static void touch(const std::filesystem::path &entryDir) {
+    std::error_code ec;
+    std::filesystem::last_write_time(
+        entryDir, std::filesystem::file_time_type::clock::now(), ec);
+  }
+
+private:
+  struct Entry {
+    std::filesystem::path path;
+    uintmax_t bytes = 0;
+    std::filesystem::file_time_type lastUsed;
+  };
+
+  static ErrorOr<std::vector<Entry>>
+  listEntries(const std::filesystem::path &cacheDir) {
+    std::vector<Entry> entries;
+    std::error_code ec;
+    if (!std::filesystem::exists(cacheDir, ec))
+      return ok(std::move(entries));
+
+    std::filesystem::directory_iterator it(cacheDir, ec);
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to list cache directory: " +
+                                cacheDir.string() + " - " + ec.message());
+    // Errors on entries are ignored (using the non-throwing overloads), as
+    // other processes may be adding or removing them concurrently.
+    std::filesystem::directory_iterator end;
+    for (; !ec && it != end; it.increment(ec)) {
+      std::error_code entryEc;
+      if (!it->is_directory(entryEc))
+        continue;
+      Entry entry;
+      entry.path = it->path();
+      entry.lastUsed = std::filesystem::last_write_time(entry.path, entryEc);
+      std::filesystem::directory_iterator file(entry.path, entryEc);
+      for (; !entryEc && file != end; file.increment(entryEc)) {
+        std::error_code fileEc;
+        if (!file->is_regular_file(fileEc))
+          continue;
+        uintmax_t size = file->file_size(fileEc);
+        if (!fileEc)
+          entry.bytes += size;
+        auto lastWrite = file->last_write_time(fileEc);
+        if (!fileEc)
+          entry.lastUsed = std::max(entry.lastUsed, lastWrite);
+      }
+      entries.push_back(std::move(entry));
+    }
+    return ok(std::move(entries));
+  }
+};
+
+// A store of cache entries shared beyond the local cache directory, e.g. on a
+// shared file system or in an object store, from which newly provisioned
+// nodes fetch compiled artifacts rather than compiling them. Entries are
+// keyed by their cache key (a hash of what the artifacts are compiled from,
+// see `Graph::getCacheKey`), so that a stored entry never changes.
+//
+// Graphs missing from the local cache fetch their entry from the remote cache
+// of the process (see `RemoteCache::set`) before compiling, and publish the
+// entries they compile to it. Failures of the remote cache are logged and
+// otherwise ignored, the graph being compiled as without one.
+// Implementations must be thread-safe.
+class RemoteCache {
+public:
+  virtual ~RemoteCache() = default;
+
+  // Copies the files `fileNames` of the entry of `cacheKey` to the local
+  // cache (see `CacheFile::getPath`), in order, or returns false if the remote
+  // cache holds no complete entry for the key. The last file marks entries
+  // complete: it is stored last, and entries without it are incomplete.
+  virtual ErrorOr<bool> fetch(const std::string &cacheKey,
+                              const std::vector<std::string> &fileNames) = 0;
+
+  // Stores the files `fileNames` of the local entry of `cacheKey`, in order.
+  virtual ErrorObject publish(const std::string &cacheKey,
+                              const std::vector<std::string> &fileNames) = 0;
+
+  // Sets the remote cache of the process, or none if null. It defaults to a
+  // `DirectoryRemoteCache` in `${FUSILLI_REMOTE_CACHE_DIR}`, if set.
+  static void set(std::shared_ptr<RemoteCache> cache);
+
+  // Returns the remote cache of the process, or null if none.
+  static std::shared_ptr<RemoteCache> get();
+
+private:
+  struct Process {
+    Process();
+    std::mutex mutex;
+    std::shared_ptr<RemoteCache> cache;
+  };
+  static Process &getProcess() {
+    static Process process;
+    return process;
+  }
+};
+
+// A remote cache in a directory of a shared file system (e.g. NFS), holding a
+// sub-directory per entry like the local cache. Files are copied to a
+// temporary file renamed into place, so that nodes sharing the directory
+// never read partially copied files.
+class DirectoryRemoteCache : public RemoteCache {
+public:
+  explicit DirectoryRemoteCache(std::filesystem::path root)
+      : root_(std::move(root)) {}
+
+  const std::filesystem::path &getRoot() const { return root_; }
+
+  ErrorOr<bool> fetch(const std::string &cacheKey,
+                      const std::vector<std::string> &fileNames) override {
+    std::error_code ec;
+    if (fileNames.empty() ||
+        !std::filesystem::exists(getPath(cacheKey, fileNames.back()), ec))
+      return ok(false);
+    FUSILLI_LOG_LABEL_ENDL("INFO: Fetching cache entry " << cacheKey
+                                                         << " from " << root_);
+    for (const std::string &fileName : fileNames)
+      FUSILLI_CHECK_ERROR(copyFile(getPath(cacheKey, fileName),
+                                   CacheFile::getPath(cacheKey, fileName)));
+    return ok(true);
+  }
+
+  ErrorObject publish(const std::string &cacheKey,
+                      const std::vector<std::string> &fileNames) override {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Publishing cache entry " << cacheKey
+                                                           << " to " << root_);
+    for (const std::string &fileName : fileNames)
+      FUSILLI_CHECK_ERROR(copyFile(CacheFile::getPath(cacheKey, fileName),
+                                   getPath(cacheKey, fileName)));
+    return ok();
+  }
+
+  // Path of the file `fileName` of the entry of `cacheKey`, in the directory
+  // named as the local one.
+  std::filesystem::path getPath(const std::string &cacheKey,
+                                const std::string &fileName) const {
+    return root_ /
+           CacheFile::getPath(cacheKey, fileName).parent_path().filename() /
+           fileName;
+  }
+
+private:
+  static ErrorObject copyFile(const std::filesystem::path &from,
+                              const std::filesystem::path &to) {
+    std::error_code ec;
+    std::filesystem::create_directories(to.parent_path(), ec);
+    std::filesystem::path tempPath = getTempCachePath(to);
+    if (!ec)
+      std::filesystem::copy_file(from, tempPath, ec);
+    if (!ec)
+      std::filesystem::rename(tempPath, to, ec);
+    if (ec) {
+      std::error_code removeEc;
+      std::filesystem::remove(tempPath, removeEc);
+    }
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to copy " + from.string() + " to " +
+                                to.string() + " - " + ec.message());
+    return ok();
+  }
+
+  std::filesystem::path root_;
+};
+
+inline RemoteCache::Process::Process() {
+  if (const char *dir = std::getenv("FUSILLI_REMOTE_CACHE_DIR"))
+    cache = std::make_shared<DirectoryRemoteCache>(dir);
+}
+
+inline void RemoteCache::set(std::shared_ptr<RemoteCache> cache) {
+  Process &process = getProcess();
+  std::lock_guard<std::mutex> lock(process.mutex);
+  process.cache = std::move(cache);
+}
+
+inline std::shared_ptr<RemoteCache> RemoteCache::get() {
+  Process &process = getProcess();
+  std::lock_guard<std::mutex> lock(process.mutex);
+  return process.cache;
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_SUPPORT_CACHE_H
@@ -13,6 +13,11 @@
 #ifndef FUSILLI_SUPPORT_EXTRAS_H
 #define FUSILLI_SUPPORT_EXTRAS_H
 
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
 namespace fusilli {
 
 // An STL-style algorithm similar to std::for_each that applies a second
@@ -68,6 +73,41 @@ inline void interleave(ForwardIterator begin, ForwardIterator end,
   }
 }
 
+// 64-bit FNV-1a hash of `data`, continuing from `hash` (to hash a sequence of
+// values). Unlike `std::hash`, results are the same across platforms and
+// builds, so that they may name files persisted on disk.
+inline constexpr uint64_t kFnv1aHashSeed = 14695981039346656037ULL;
+inline uint64_t fnv1aHash(std::string_view data,
+                          uint64_t hash = kFnv1aHashSeed) {
+  for (unsigned char c : data) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// `fnv1aHash` of the bytes of a trivially copyable `value` (e.g. an integer
+// or an enum).
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+inline uint64_t fnv1aHashValue(const T &value, uint64_t hash = kFnv1aHashSeed) {
+  return fnv1aHash(
+      std::string_view(reinterpret_cast<const char *>(&value), sizeof(T)),
+      hash);
+}
+
+// `fnv1aHash` of the size and elements of `values`.
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+inline uint64_t fnv1aHashValue(const std::vector<T> &values,
+                               uint64_t hash = kFnv1aHashSeed) {
+  hash = fnv1aHashValue(values.size(), hash);
+  return fnv1aHash(std::string_view(reinterpret_cast<const char *>(
+                                        values.data()),
+                                    values.size() * sizeof(T)),
+                   hash);
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_SUPPORT_EXTRAS_H
@@ -0,0 +1,263 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains `JsonValue`, a minimal JSON document model and parser
+// for the files Fusilli reads back (e.g. serialized graphs, see
+// `Graph::deserialize`), and `quoteJson` to write JSON strings.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_JSON_H
+#define FUSILLI_SUPPORT_JSON_H
+
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Returns `value` as a quoted JSON string, escaping quotes, backslashes and
+// control characters.
+inline std::string quoteJson(std::string_view value) {
+  std::string quoted = "\"";
+  for (char ch : value) {
+    if (ch == '"' || ch == '\\') {
+      quoted += '\\';
+      quoted += ch;
+    } else if (ch == '\n') {
+      quoted += "\\n";
+    } else if (static_cast<unsigned char>(ch) < 0x20) {
+      quoted += std::format("\\u{:04x}", static_cast<unsigned char>(ch));
+    } else {
+      quoted += ch;
+    }
+  }
+  return quoted + "\"";
+}
+
+// A parsed JSON value. Numbers keep their text, to be parsed as the type they
+// are read as (see `getNumber`), e.g. exactly for 64-bit integers. As an
+// extension of JSON
+// (to round-trip floating point attributes such as clamp bounds), numbers may
+// also be `inf`, `-inf` or `nan`, as written by `std::format`.
+class JsonValue {
+public:
+  enum class Kind : uint8_t { Null, Bool, Number, String, Array, Object };
+
+  // Parses the JSON document `json`.
+  static ErrorOr<JsonValue> parse(std::string_view json) {
+    size_t pos = 0;
+    JsonValue value = FUSILLI_TRY(parseValue(json, pos, /*depth=*/0));
+    skipWhitespace(json, pos);
+    FUSILLI_RETURN_ERROR_IF(pos != json.size(), ErrorCode::InvalidArgument,
+                            std::format("Unexpected JSON at offset {}", pos));
+    return ok(std::move(value));
+  }
+
+  Kind getKind() const { return kind_; }
+
+  // Member `key` of an object, or null if it has none (or is not an object).
+  const JsonValue *find(std::string_view key) const {
+    for (const auto &[memberKey, member] : object_)
+      if (memberKey == key)
+        return &member;
+    return nullptr;
+  }
+
+  // Elements of an array (empty for other kinds).
+  const std::vector<JsonValue> &getArray() const { return array_; }
+
+  // Members of an object in their order (empty for other kinds).
+  const std::vector<std::pair<std::string, JsonValue>> &getObject() const {
+    return object_;
+  }
+
+  ErrorOr<bool> getBool() const {
+    FUSILLI_RETURN_ERROR_IF(kind_ != Kind::Bool, ErrorCode::InvalidArgument,
+                            "JSON value is not a boolean");
+    return ok(bool(bool_));
+  }
+
+  ErrorOr<std::string> getString() const {
+    FUSILLI_RETURN_ERROR_IF(kind_ != Kind::String, ErrorCode::InvalidArgument,
+                            "JSON value is not a string");
+    return ok(std::string(text_));
+  }
+
+  // The number as a `T` (an integer or floating point type), failing if it
+  // is not one (e.g. a fraction read as an integer) or is out of its range.
+  template <typename T> ErrorOr<T> getNumber() const {
+    FUSILLI_RETURN_ERROR_IF(kind_ != Kind::Number, ErrorCode::InvalidArgument,
+                            "JSON value is not a number");
+    T value{};
+    const char *end = text_.data() + text_.size();
+    auto [ptr, ec] = std::from_chars(text_.data(), end, value);
+    FUSILLI_RETURN_ERROR_IF(ec != std::errc() || ptr != end,
+                            ErrorCode::InvalidArgument,
+                            "Invalid JSON number '" + text_ + "'");
+    return ok(std::move(value));
+  }
+
+private:
+  // Documents nest at most this deep, so that parsing does not overflow the
+  // stack.
+  static constexpr size_t kMaxDepth = 64;
+
+  static void skipWhitespace(std::string_view json, size_t &pos) {
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\n' ||
+                                 json[pos] == '\t' || json[pos] == '\r'))
+      ++pos;
+  }
+
+  // Skips `ch` (after whitespace) if it is next, returning whether it was.
+  static bool consume(std::string_view json, size_t &pos, char ch) {
+    skipWhitespace(json, pos);
+    if (pos >= json.size() || json[pos] != ch)
+      return false;
+    ++pos;
+    return true;
+  }
+
+  static ErrorObject expect(std::string_view json, size_t &pos, char ch) {
+    FUSILLI_RETURN_ERROR_IF(!consume(json, pos, ch),
+                            ErrorCode::InvalidArgument,
+                            std::format("Expected '{}' in JSON at offset {}",
+                                        ch, pos));
+    return ok();
+  }
+
+  static ErrorOr<std::string> parseString(std::string_view json, size_t &pos) {
+    FUSILLI_CHECK_ERROR(expect(json, pos, '"'));
+    std::string value;
+    while (pos < json.size() && json[pos] != '"') {
+      char ch = json[pos++];
+      if (ch != '\\') {
+        value += ch;
+        continue;
+      }
+      FUSILLI_RETURN_ERROR_IF(pos >= json.size(), ErrorCode::InvalidArgument,
+                              "Unterminated JSON string");
+      char escaped = json[pos++];
+      switch (escaped) {
+      case 'n':
+        value += '\n';
+        break;
+      case 't':
+        value += '\t';
+        break;
+      case 'r':
+        value += '\r';
+        break;
+      case 'b':
+        value += '\b';
+        break;
+      case 'f':
+        value += '\f';
+        break;
+      case 'u': {
+        // Only code points of a single byte are written (see `quoteJson`).
+        unsigned codePoint = 0;
+        auto [ptr, ec] = std::from_chars(
+            json.data() + pos, json.data() + std::min(pos + 4, json.size()),
+            codePoint, 16);
+        FUSILLI_RETURN_ERROR_IF(ec != std::errc() ||
+                                    ptr != json.data() + pos + 4 ||
+                                    codePoint > 0x7f,
+                                ErrorCode::InvalidArgument,
+                                "Unsupported JSON string escape");
+        value += static_cast<char>(codePoint);
+        pos += 4;
+        break;
+      }
+      default:
+        value += escaped;
+      }
+    }
+    FUSILLI_CHECK_ERROR(expect(json, pos, '"'));
+    return ok(std::move(value));
+  }
+
+  static ErrorOr<JsonValue> parseValue(std::string_view json, size_t &pos,
+                                       size_t depth) {
+    FUSILLI_RETURN_ERROR_IF(depth > kMaxDepth, ErrorCode::InvalidArgument,
+                            "JSON document is nested too deeply");
+    skipWhitespace(json, pos);
+    FUSILLI_RETURN_ERROR_IF(pos >= json.size(), ErrorCode::InvalidArgument,
+                            "Unexpected end of JSON");
+    JsonValue value;
+    char ch = json[pos];
+    if (ch == '"') {
+      value.kind_ = Kind::String;
+      value.text_ = FUSILLI_TRY(parseString(json, pos));
+    } else if (ch == '[') {
+      value.kind_ = Kind::Array;
+      ++pos;
+      if (consume(json, pos, ']'))
+        return ok(std::move(value));
+      while (true) {
+        value.array_.push_back(FUSILLI_TRY(parseValue(json, pos, depth + 1)));
+        if (!consume(json, pos, ','))
+          break;
+      }
+      FUSILLI_CHECK_ERROR(expect(json, pos, ']'));
+    } else if (ch == '{') {
+      value.kind_ = Kind::Object;
+      ++pos;
+      if (consume(json, pos, '}'))
+        return ok(std::move(value));
+      while (true) {
+        std::string key = FUSILLI_TRY(parseString(json, pos));
+        FUSILLI_CHECK_ERROR(expect(json, pos, ':'));
+        value.object_.emplace_back(
+            std::move(key), FUSILLI_TRY(parseValue(json, pos, depth + 1)));
+        if (!consume(json, pos, ','))
+          break;
+      }
+      FUSILLI_CHECK_ERROR(expect(json, pos, '}'));
+    } else {
+      // A literal or number: the token up to the next delimiter.
+      size_t end = json.find_first_of(",]} \t\r\n", pos);
+      std::string_view token =
+          json.substr(pos, end == std::string_view::npos ? end : end - pos);
+      pos += token.size();
+      if (token == "null") {
+        value.kind_ = Kind::Null;
+      } else if (token == "true" || token == "false") {
+        value.kind_ = Kind::Bool;
+        value.bool_ = token == "true";
+      } else {
+        FUSILLI_RETURN_ERROR_IF(token.empty(), ErrorCode::InvalidArgument,
+                                std::format("Unexpected JSON at offset {}",
+                                            pos));
+        value.kind_ = Kind::Number;
+        value.text_ = std::string(token);
+      }
+    }
+    return ok(std::move(value));
+  }
+
+  Kind kind_ = Kind::Null;
+  bool bool_ = false;
+  // Contents of a string, or the text of a number.
+  std::string text_;
+  std::vector<JsonValue> array_;
+  std::vector<std::pair<std::string, JsonValue>> object_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_JSON_H
@@ -379,6 +379,13 @@ inline ConditionalStreamer &getLogger() {
   return logger;
 }
 
+// Returns whether messages are logged, once the logger is initialized (which
+// disables logging without a `FUSILLI_LOG_FILE`, see `getStream`).
+inline bool shouldLog() {
+  getLogger();
+  return isLoggingEnabled();
+}
+
 } // namespace fusilli
 
 // Macros for logging and error handling
@@ -387,19 +394,27 @@ inline ConditionalStreamer &getLogger() {
 #define FUSILLI_COLOR_YELLOW "\033[33m"
 #define FUSILLI_COLOR_RESET "\033[0m"
 
-#define FUSILLI_LOG(X) fusilli::getLogger() << X
-#define FUSILLI_LOG_ENDL(X) fusilli::getLogger() << X << std::endl
+// Messages are only formatted when logged, so that disabled logging costs a
+// check in hot paths (e.g. `Graph::execute`).
+#define FUSILLI_LOG_IF_ENABLED(X)                                              \
+  do {                                                                         \
+    if (fusilli::shouldLog())                                                  \
+      fusilli::getLogger() << X;                                               \
+  } while (false)
+
+#define FUSILLI_LOG(X) FUSILLI_LOG_IF_ENABLED(X)
+#define FUSILLI_LOG_ENDL(X) FUSILLI_LOG_IF_ENABLED(X << std::endl)
 #define FUSILLI_LOG_LABEL_RED(X)                                               \
-  fusilli::getLogger() << FUSILLI_COLOR_RED << "[FUSILLI] " << X               \
-                       << FUSILLI_COLOR_RESET
+  FUSILLI_LOG_IF_ENABLED(FUSILLI_COLOR_RED << "[FUSILLI] " << X                \
+                                           << FUSILLI_COLOR_RESET)
 #define FUSILLI_LOG_LABEL_GREEN(X)                                             \
-  fusilli::getLogger() << FUSILLI_COLOR_GREEN << "[FUSILLI] " << X             \
-                       << FUSILLI_COLOR_RESET
+  FUSILLI_LOG_IF_ENABLED(FUSILLI_COLOR_GREEN << "[FUSILLI] " << X              \
+                                             << FUSILLI_COLOR_RESET)
 #define FUSILLI_LOG_LABEL_YELLOW(X)                                            \
-  fusilli::getLogger() << FUSILLI_COLOR_YELLOW << "[FUSILLI] " << X            \
-                       << FUSILLI_COLOR_RESET
+  FUSILLI_LOG_IF_ENABLED(FUSILLI_COLOR_YELLOW << "[FUSILLI] " << X             \
+                                              << FUSILLI_COLOR_RESET)
 #define FUSILLI_LOG_LABEL_ENDL(X)                                              \
-  fusilli::getLogger() << "[FUSILLI] " << X << std::endl
+  FUSILLI_LOG_IF_ENABLED("[FUSILLI] " << X << std::endl)
 
 #define FUSILLI_RETURN_ERROR_IF(cond, retval, message)                         \
   do {                                                                         \
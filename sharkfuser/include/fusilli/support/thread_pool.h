@@ -0,0 +1,108 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains a fixed size thread pool running tasks in submission
+// order, used to compile graphs concurrently.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_THREAD_POOL_H
+#define FUSILLI_SUPPORT_THREAD_POOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// A pool of `numThreads` worker threads running submitted tasks:
+//
+//  ThreadPool pool(/*numThreads=*/4);
+//  std::future<int> result = pool.submit([] { return 42; });
+//  assert(result.get() == 42);
+//
+// Tasks still queued when the pool is destroyed are run before the workers
+// are joined, so that all returned futures become ready.
+class ThreadPool {
+public:
+  explicit ThreadPool(size_t numThreads) {
+    numThreads = std::max<size_t>(numThreads, 1);
+    workers_.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i)
+      workers_.emplace_back([this] { runWorker(); });
+  }
+
+  // Delete copy/move constructors (workers reference the pool).
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto &worker : workers_)
+      worker.join();
+  }
+
+  size_t size() const { return workers_.size(); }
+
+  // Queues `task` to run on a worker, returning a future of its result.
+  template <typename F>
+  std::future<std::invoke_result_t<std::decay_t<F>>> submit(F &&task) {
+    using ResultType = std::invoke_result_t<std::decay_t<F>>;
+    // `std::function` requires copyable callables, hence the shared task.
+    auto packaged =
+        std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(task));
+    std::future<ResultType> result = packaged->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace([packaged] { (*packaged)(); });
+    }
+    condition_.notify_one();
+    return result;
+  }
+
+private:
+  void runWorker() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty())
+          return;
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stopping_ = false;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_THREAD_POOL_H
@@ -0,0 +1,138 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains utilities for tracing the phases of graphs (validation,
+// optimization, MLIR assembly emission, compilation, session creation and
+// execution) as timed scopes.
+//
+// Trace scopes are compiled in with `FUSILLI_ENABLE_TRACING` (the cmake flag
+// `-DFUSILLI_ENABLE_TRACING=ON`), and expand to nothing otherwise. When
+// compiled in, they are recorded when `FUSILLI_TRACE_FILE` is set, as
+// complete events of the Chrome trace event format, which is loaded by
+// `chrome://tracing` and https://ui.perfetto.dev:
+//
+//   [
+//   {"name": "Graph::compile", "cat": "fusilli", "ph": "X", "ts": 12.5, ...},
+//
+// The closing bracket of the array is optional in this format, so that
+// events are written as they complete, and traces of aborted processes load.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_TRACING_H
+#define FUSILLI_SUPPORT_TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace fusilli {
+
+// Writer of the events of trace scopes to `FUSILLI_TRACE_FILE`, opened on
+// first use: tracing is disabled when it is not set.
+class TraceWriter {
+public:
+  static TraceWriter &get() {
+    static TraceWriter writer;
+    return writer;
+  }
+
+  bool isEnabled() const { return enabled_; }
+
+  // Microseconds since the creation of the writer, the origin of the events.
+  double getTimestampUs() const {
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - origin_)
+        .count();
+  }
+
+  // Records the complete event `name` of `durUs` microseconds from the
+  // timestamp `tsUs`, on the calling thread. `name` must not need escaping
+  // in JSON (trace scopes are named by string literals).
+  void writeEvent(const char *name, double tsUs, double durUs) {
+    std::string event = std::format(
+        "{{\"name\": \"{}\", \"cat\": \"fusilli\", \"ph\": \"X\", \"ts\": "
+        "{:.3f}, \"dur\": {:.3f}, \"pid\": 0, \"tid\": {}}},\n",
+        name, tsUs, durUs, getThreadId());
+    std::lock_guard<std::mutex> lock(mutex_);
+    output_ << event;
+    output_.flush();
+  }
+
+private:
+  TraceWriter() : origin_(std::chrono::steady_clock::now()) {
+    const char *traceFile = std::getenv("FUSILLI_TRACE_FILE");
+    if (!traceFile || !*traceFile)
+      return;
+    output_.open(traceFile, std::ios::out);
+    enabled_ = output_.is_open();
+    if (enabled_)
+      output_ << "[\n";
+  }
+
+  // Small ids of threads, in the order of their first event.
+  static uint64_t getThreadId() {
+    static std::atomic<uint64_t> nextId = 0;
+    thread_local uint64_t id = nextId++;
+    return id;
+  }
+
+  std::chrono::steady_clock::time_point origin_;
+  std::ofstream output_;
+  std::mutex mutex_;
+  bool enabled_ = false;
+};
+
+// RAII scope recording its lifetime as the trace event `name`. Disabled
+// tracing only costs a check of the writer.
+class TraceScope {
+public:
+  explicit TraceScope(const char *name)
+      : name_(TraceWriter::get().isEnabled() ? name : nullptr) {
+    if (name_)
+      startUs_ = TraceWriter::get().getTimestampUs();
+  }
+
+  ~TraceScope() {
+    if (!name_)
+      return;
+    TraceWriter &writer = TraceWriter::get();
+    writer.writeEvent(name_, startUs_, writer.getTimestampUs() - startUs_);
+  }
+
+  // Delete copy and move constructors and assignment operators.
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+  TraceScope(TraceScope &&) = delete;
+  TraceScope &operator=(TraceScope &&) = delete;
+
+private:
+  const char *name_;
+  double startUs_ = 0.0;
+};
+
+} // namespace fusilli
+
+// Traces the enclosing scope as the event `name` (a string literal).
+#ifdef FUSILLI_ENABLE_TRACING
+#define FUSILLI_TRACE_CONCAT_IMPL(a, b) a##b
+#define FUSILLI_TRACE_CONCAT(a, b) FUSILLI_TRACE_CONCAT_IMPL(a, b)
+#define FUSILLI_TRACE_SCOPE(name)                                              \
+  fusilli::TraceScope FUSILLI_TRACE_CONCAT(_traceScope, __LINE__)(name)
+#else
+#define FUSILLI_TRACE_SCOPE(name)                                              \
+  do {                                                                         \
+  } while (false)
+#endif
+
+#endif // FUSILLI_SUPPORT_TRACING_H
@@ -0,0 +1,115 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+Python bindings of Fusilli, with zero-copy interop with torch tensors.
+
+Graphs are built and executed as in C++, with snake_case methods:
+
+    handle = fusilli.handle_for_torch(x.device)
+    graph = fusilli.Graph().set_io_data_type(fusilli.DataType.Half)
+    xT = graph.tensor(fusilli.tensor_attr_from_torch(x, "x"))
+    ...
+    graph.validate()
+    graph.compile(handle)
+    graph.execute(handle, {xT: fusilli.buffer_from_torch(handle, x), ...})
+
+Torch tensors (on the CPU, or on ROCm devices through `torch.cuda`) are
+imported as buffers in place, and handles of ROCm devices execute on the
+current torch stream, so that graphs are ordered with the torch operations
+around them.
+"""
+
+from typing import Dict, Tuple
+
+from ._fusilli import *
+
+_TORCH_DATA_TYPES = {
+    "float16": DataType.Half,
+    "bfloat16": DataType.BFloat16,
+    "float32": DataType.Float,
+    "float64": DataType.Double,
+    "uint8": DataType.Uint8,
+    "int8": DataType.Int8,
+    "int16": DataType.Int16,
+    "int32": DataType.Int32,
+    "int64": DataType.Int64,
+    "bool": DataType.Boolean,
+    "float8_e5m2": DataType.FP8E5M2,
+    "float8_e4m3fn": DataType.FP8E4M3FN,
+    "float8_e5m2fnuz": DataType.FP8E5M2FNUZ,
+    "float8_e4m3fnuz": DataType.FP8E4M3FNUZ,
+}
+
+# Handles created by `handle_for_torch`, by device index (-1 for the CPU) and
+# stream.
+_handles: Dict[Tuple[int, int], Handle] = {}
+
+
+def data_type_from_torch(dtype) -> DataType:
+    """The data type of the torch `dtype`."""
+    name = str(dtype).removeprefix("torch.")
+    if name not in _TORCH_DATA_TYPES:
+        raise ValueError(f"Unsupported torch data type {dtype}")
+    return _TORCH_DATA_TYPES[name]
+
+
+def tensor_attr_from_torch(tensor, name: str) -> TensorAttr:
+    """A tensor named `name` of the dims, strides and data type of `tensor`."""
+    return (
+        TensorAttr()
+        .set_name(name)
+        .set_dim(list(tensor.shape))
+        .set_stride(list(tensor.stride()))
+        .set_data_type(data_type_from_torch(tensor.dtype))
+    )
+
+
+def handle_for_torch(device=None) -> Handle:
+    """The handle executing on torch `device` (the current one if None).
+
+    Handles of ROCm devices execute on the current torch stream of the device,
+    i.e. in order with the torch operations launched on it. They are created
+    once per device and stream.
+    """
+    import torch
+
+    if device is None and not torch.cuda.is_available():
+        device = "cpu"
+    if device is not None and torch.device(device).type == "cpu":
+        if (-1, 0) not in _handles:
+            _handles[(-1, 0)] = Handle.create(Backend.CPU)
+        return _handles[(-1, 0)]
+    stream = torch.cuda.current_stream(device)
+    key = (stream.device.index, stream.cuda_stream)
+    if key not in _handles:
+        _handles[key] = Handle.create(Backend.AMDGPU, *key)
+    return _handles[key]
+
+
+def buffer_from_torch(handle: Handle, tensor) -> Buffer:
+    """Import the memory of `tensor` as a buffer, without copying.
+
+    The tensor must be dense (i.e. without gaps or overlaps, in any dim order,
+    such as `torch.channels_last`). The buffer has the dims of the tensor in
+    physical order, matching the `TensorAttr` of `tensor_attr_from_torch`, and
+    keeps the tensor alive.
+    """
+    expected_stride = 1
+    for i in sorted(range(tensor.dim()), key=tensor.stride):
+        if tensor.shape[i] != 1 and tensor.stride(i) != expected_stride:
+            raise ValueError(
+                f"Tensor of shape {list(tensor.shape)} and strides "
+                f"{list(tensor.stride())} is not dense"
+            )
+        expected_stride *= tensor.shape[i]
+    # Dims in the physical order of the graph's tensor.
+    shape = tensor_attr_from_torch(tensor, "").physical_dim
+    buffer = Buffer.import_device_ptr(
+        handle, tensor.data_ptr(), shape, data_type_from_torch(tensor.dtype)
+    )
+    buffer._tensor = tensor
+    return buffer
@@ -0,0 +1,393 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the nanobind bindings of the `fusilli._fusilli` Python
+// extension: the graph API (`Graph`, `TensorAttr` and node attributes) and
+// the runtime objects (`Handle` and `Buffer`) needed to execute graphs. The
+// torch interop on top of it lives in `fusilli/__init__.py`.
+//
+//===----------------------------------------------------------------------===//
+
+#include <fusilli.h>
+
+#include <nanobind/nanobind.h>
+#include <nanobind/stl/shared_ptr.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/unordered_map.h>
+#include <nanobind/stl/vector.h>
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nb = nanobind;
+
+using namespace fusilli;
+
+namespace {
+
+// Raised (as `fusilli.Error`) for errors returned by the C++ API.
+class FusilliError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+void check(const ErrorObject &status) {
+  if (isOk(status))
+    return;
+  std::ostringstream os;
+  os << status;
+  throw FusilliError(os.str());
+}
+
+template <typename T> T unwrap(ErrorOr<T> &&result) {
+  check(result);
+  return std::move(*result);
+}
+
+using VariantPack =
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>;
+
+// Binds the setters and getters shared by the attributes of nodes.
+template <typename AttrT>
+nb::class_<AttrT> bindAttr(nb::module_ &m, const char *name) {
+  return std::move(
+      nb::class_<AttrT>(m, name)
+          .def(nb::init<>())
+          .def(
+              "set_name",
+              [](AttrT &self, const std::string &name) -> AttrT & {
+                return self.setName(name);
+              },
+              nb::rv_policy::reference_internal)
+          .def(
+              "set_compute_data_type",
+              [](AttrT &self, DataType type) -> AttrT & {
+                return self.setComputeDataType(type);
+              },
+              nb::rv_policy::reference_internal)
+          .def_prop_ro("name", &AttrT::getName)
+          .def_prop_ro("compute_data_type",
+                       [](const AttrT &self) { return self.computeDataType; }));
+}
+
+// Binds the padding, stride and dilation of the convolution attributes.
+template <typename AttrT> void bindConvAttr(nb::module_ &m, const char *name) {
+  using Dims = const std::vector<int64_t> &;
+  bindAttr<AttrT>(m, name)
+      .def(
+          "set_padding",
+          [](AttrT &self, Dims padding) -> AttrT & {
+            return self.setPadding(padding);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_stride",
+          [](AttrT &self, Dims stride) -> AttrT & {
+            return self.setStride(stride);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_dilation",
+          [](AttrT &self, Dims dilation) -> AttrT & {
+            return self.setDilation(dilation);
+          },
+          nb::rv_policy::reference_internal)
+      .def_prop_ro("padding", &AttrT::getPadding)
+      .def_prop_ro("stride", &AttrT::getStride)
+      .def_prop_ro("dilation", &AttrT::getDilation);
+}
+
+void bindTypes(nb::module_ &m) {
+  nb::enum_<Backend>(m, "Backend")
+      .value("CPU", Backend::CPU)
+      .value("AMDGPU", Backend::AMDGPU);
+
+  nb::enum_<DataType> dataType(m, "DataType");
+  dataType.value("NotSet", DataType::NotSet);
+#define DEFINE_ENUM(FUSILLI_TYPE, TORCH_TYPE, MLIR_TYPE)                       \
+  dataType.value(#FUSILLI_TYPE, DataType::FUSILLI_TYPE);
+  FUSILLI_FORALL_DATA_TYPES(DEFINE_ENUM)
+#undef DEFINE_ENUM
+}
+
+void bindTensorAttr(nb::module_ &m) {
+  using Dims = const std::vector<int64_t> &;
+  nb::class_<TensorAttr>(m, "TensorAttr")
+      .def(nb::init<>())
+      .def(
+          "set_name",
+          [](TensorAttr &self, const std::string &name) -> TensorAttr & {
+            return self.setName(name);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_data_type",
+          [](TensorAttr &self, DataType type) -> TensorAttr & {
+            return self.setDataType(type);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_dim",
+          [](TensorAttr &self, Dims dim) -> TensorAttr & {
+            return self.setDim(dim);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_stride",
+          [](TensorAttr &self, Dims stride) -> TensorAttr & {
+            return self.setStride(stride);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_dynamic_dims",
+          [](TensorAttr &self,
+             const std::vector<size_t> &dynamicDims) -> TensorAttr & {
+            return self.setDynamicDims(dynamicDims);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_is_virtual",
+          [](TensorAttr &self, bool isVirtual) -> TensorAttr & {
+            return self.setIsVirtual(isVirtual);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_output",
+          [](TensorAttr &self, bool isOutput) -> TensorAttr & {
+            return self.setOutput(isOutput);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_is_scalar",
+          [](TensorAttr &self, bool isScalar) -> TensorAttr & {
+            return self.setIsScalar(isScalar);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_constant_data",
+          [](TensorAttr &self, nb::bytes data) -> TensorAttr & {
+            const auto *bytes = static_cast<const uint8_t *>(data.data());
+            return self.setConstantData(
+                std::make_shared<const std::vector<uint8_t>>(
+                    bytes, bytes + data.size()));
+          },
+          nb::rv_policy::reference_internal,
+          "Marks the tensor a constant with `data`, its elements in physical "
+          "order.")
+      .def("validate", [](const TensorAttr &self) { check(self.validate()); })
+      .def_prop_ro("name", &TensorAttr::getName)
+      .def_prop_ro("data_type", &TensorAttr::getDataType)
+      .def_prop_ro("dim", &TensorAttr::getDim)
+      .def_prop_ro("stride", &TensorAttr::getStride)
+      .def_prop_ro("physical_dim",
+                   [](const TensorAttr &self) {
+                     if (!self.hasValidPhysicalRepresentation())
+                       throw FusilliError("Tensor " + self.getName() +
+                                          " has no physical layout");
+                     return self.getPhysicalDim();
+                   })
+      .def_prop_ro("dynamic_dims", &TensorAttr::getDynamicDims)
+      .def_prop_ro("is_virtual", &TensorAttr::isVirtual)
+      .def_prop_ro("is_scalar", &TensorAttr::isScalar)
+      .def_prop_ro("is_constant", &TensorAttr::isConstant);
+}
+
+void bindNodeAttrs(nb::module_ &m) {
+  bindConvAttr<ConvFPropAttr>(m, "ConvFPropAttr");
+  bindConvAttr<ConvWGradAttr>(m, "ConvWGradAttr");
+  bindConvAttr<ConvDGradAttr>(m, "ConvDGradAttr");
+  bindAttr<MatmulAttr>(m, "MatmulAttr");
+
+  auto pointwise = bindAttr<PointwiseAttr>(m, "PointwiseAttr");
+  nb::enum_<PointwiseAttr::Mode>(pointwise, "Mode")
+      .value("NOT_SET", PointwiseAttr::Mode::NOT_SET)
+      .value("ADD", PointwiseAttr::Mode::ADD)
+      .value("CLAMP", PointwiseAttr::Mode::CLAMP)
+      .value("DIV", PointwiseAttr::Mode::DIV)
+      .value("GELU_APPROX_TANH_BWD", PointwiseAttr::Mode::GELU_APPROX_TANH_BWD)
+      .value("GELU_APPROX_TANH_FWD", PointwiseAttr::Mode::GELU_APPROX_TANH_FWD)
+      .value("GELU_BWD", PointwiseAttr::Mode::GELU_BWD)
+      .value("GELU_FWD", PointwiseAttr::Mode::GELU_FWD)
+      .value("MUL", PointwiseAttr::Mode::MUL)
+      .value("RELU_BWD", PointwiseAttr::Mode::RELU_BWD)
+      .value("RELU_FWD", PointwiseAttr::Mode::RELU_FWD)
+      .value("SCALE_SHIFT", PointwiseAttr::Mode::SCALE_SHIFT)
+      .value("SIGMOID_BWD", PointwiseAttr::Mode::SIGMOID_BWD)
+      .value("SIGMOID_FWD", PointwiseAttr::Mode::SIGMOID_FWD)
+      .value("SUB", PointwiseAttr::Mode::SUB)
+      .value("SWISH_FWD", PointwiseAttr::Mode::SWISH_FWD)
+      .value("TANH_BWD", PointwiseAttr::Mode::TANH_BWD)
+      .value("TANH_FWD", PointwiseAttr::Mode::TANH_FWD);
+  pointwise
+      .def(
+          "set_mode",
+          [](PointwiseAttr &self, PointwiseAttr::Mode mode) -> PointwiseAttr & {
+            return self.setMode(mode);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_clamp_min",
+          [](PointwiseAttr &self, float clampMin) -> PointwiseAttr & {
+            return self.setClampMin(clampMin);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_clamp_max",
+          [](PointwiseAttr &self, float clampMax) -> PointwiseAttr & {
+            return self.setClampMax(clampMax);
+          },
+          nb::rv_policy::reference_internal)
+      .def_prop_ro("mode", &PointwiseAttr::getMode);
+}
+
+void bindRuntime(nb::module_ &m) {
+  nb::class_<Handle>(m, "Handle")
+      .def_static(
+          "create",
+          [](Backend backend) { return unwrap(Handle::create(backend)); },
+          nb::arg("backend"))
+      .def_static(
+          "create",
+          [](Backend backend, int deviceId, uintptr_t stream) {
+            return unwrap(Handle::create(backend, deviceId, stream));
+          },
+          nb::arg("backend"), nb::arg("device_id"), nb::arg("stream") = 0,
+          "Creates a handle executing in order on the HIP `stream` (a "
+          "`hipStream_t` as an integer) of device `device_id`.")
+      .def_prop_ro("backend", &Handle::getBackend);
+
+  nb::class_<Buffer>(m, "Buffer", nb::dynamic_attr())
+      .def_static(
+          "allocate",
+          [](const Handle &handle, const std::vector<iree_hal_dim_t> &shape,
+             DataType type, bool zeroFill) {
+            return std::make_shared<Buffer>(
+                unwrap(Buffer::allocate(handle, shape, type, zeroFill)));
+          },
+          nb::arg("handle"), nb::arg("shape"), nb::arg("type"),
+          nb::arg("zero_fill") = false)
+      .def_static(
+          "import_device_ptr",
+          [](const Handle &handle, uintptr_t ptr,
+             const std::vector<iree_hal_dim_t> &shape, DataType type) {
+            return std::make_shared<Buffer>(unwrap(Buffer::importDevicePtr(
+                handle, reinterpret_cast<void *>(ptr), shape, type)));
+          },
+          nb::arg("handle"), nb::arg("ptr"), nb::arg("shape"), nb::arg("type"),
+          "Imports the allocation at `ptr` (of `shape` in physical order) "
+          "without copying. The allocation must outlive the buffer and its "
+          "executions.")
+      .def_prop_ro("shape", [](const Buffer &self) {
+        iree_hal_buffer_view_t *view = self;
+        std::vector<iree_hal_dim_t> shape(
+            iree_hal_buffer_view_shape_rank(view));
+        for (size_t i = 0; i < shape.size(); ++i)
+          shape[i] = iree_hal_buffer_view_shape_dim(view, i);
+        return shape;
+      });
+}
+
+void bindGraph(nb::module_ &m) {
+  using Tensor = const std::shared_ptr<TensorAttr> &;
+  nb::class_<Graph>(m, "Graph")
+      .def(nb::init<>())
+      .def(
+          "set_name",
+          [](Graph &self, const std::string &name) -> Graph & {
+            return self.setName(name);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_io_data_type",
+          [](Graph &self, DataType type) -> Graph & {
+            return self.setIODataType(type);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_compute_data_type",
+          [](Graph &self, DataType type) -> Graph & {
+            return self.setComputeDataType(type);
+          },
+          nb::rv_policy::reference_internal)
+      .def(
+          "set_intermediate_data_type",
+          [](Graph &self, DataType type) -> Graph & {
+            return self.setIntermediateDataType(type);
+          },
+          nb::rv_policy::reference_internal)
+      .def_prop_ro("name", &Graph::getName)
+      .def("tensor", &Graph::tensor)
+      .def("conv_fprop", &Graph::convFProp)
+      .def("conv_wgrad", &Graph::convWGrad)
+      .def("conv_dgrad", &Graph::convDGrad)
+      .def("matmul", &Graph::matmul)
+      .def("pointwise",
+           nb::overload_cast<Tensor, PointwiseAttr &>(&Graph::pointwise))
+      .def("pointwise", nb::overload_cast<Tensor, Tensor, PointwiseAttr &>(
+                            &Graph::pointwise))
+      .def("pointwise",
+           nb::overload_cast<Tensor, Tensor, Tensor, PointwiseAttr &>(
+               &Graph::pointwise))
+      .def("validate", [](Graph &self) { check(self.validate()); })
+      .def(
+          "compile",
+          [](Graph &self, const Handle &handle, bool remove) {
+            check(self.compile(handle, remove));
+          },
+          nb::arg("handle"), nb::arg("remove") = false,
+          nb::call_guard<nb::gil_scoped_release>())
+      .def(
+          "execute",
+          [](const Graph &self, const Handle &handle,
+             const VariantPack &variantPack) {
+            check(self.execute(handle, variantPack));
+          },
+          nb::arg("handle"), nb::arg("variant_pack"),
+          nb::call_guard<nb::gil_scoped_release>())
+      .def(
+          "execute",
+          [](const Graph &self, const Handle &handle,
+             const std::vector<std::shared_ptr<Buffer>> &buffers) {
+            std::vector<iree_hal_buffer_view_t *> views;
+            views.reserve(buffers.size());
+            for (const auto &buffer : buffers)
+              views.push_back(*buffer);
+            check(self.execute(handle, views));
+          },
+          nb::arg("handle"), nb::arg("buffers"),
+          nb::call_guard<nb::gil_scoped_release>(),
+          "Executes with `buffers` bound in the order of `binding_plan`.")
+      .def_prop_ro("binding_plan",
+                   [](const Graph &self) {
+                     return unwrap(self.getBindingPlan());
+                   })
+      .def_prop_ro("fingerprint",
+                   [](const Graph &self) {
+                     return unwrap(self.getFingerprint());
+                   })
+      .def("emit_asm", [](Graph &self) { return unwrap(self.emitAsm()); });
+}
+
+} // namespace
+
+NB_MODULE(_fusilli, m) {
+  m.doc() = "Python bindings of the Fusilli graph API";
+  nb::exception<FusilliError>(m, "Error");
+
+  bindTypes(m);
+  bindTensorAttr(m);
+  bindNodeAttrs(m);
+  bindRuntime(m);
+  bindGraph(m);
+}
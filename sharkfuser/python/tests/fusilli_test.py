@@ -0,0 +1,97 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+
+import fusilli
+
+
+def _add_graph(x, y):
+    """An elementwise add of (torch tensors) `x` and `y`, and its tensors."""
+    graph = fusilli.Graph().set_name("python_add")
+    graph.set_io_data_type(fusilli.data_type_from_torch(x.dtype))
+    graph.set_compute_data_type(fusilli.DataType.Float)
+    xT = graph.tensor(fusilli.tensor_attr_from_torch(x, "x"))
+    yT = graph.tensor(fusilli.tensor_attr_from_torch(y, "y"))
+    attr = fusilli.PointwiseAttr().set_mode(fusilli.PointwiseAttr.Mode.ADD)
+    zT = graph.pointwise(xT, yT, attr)
+    zT.set_name("z").set_output(True)
+    graph.validate()
+    return graph, xT, yT, zT
+
+
+def test_graph_construction():
+    graph = fusilli.Graph().set_name("python_conv")
+    graph.set_io_data_type(fusilli.DataType.Half)
+    graph.set_compute_data_type(fusilli.DataType.Float)
+    xT = graph.tensor(
+        fusilli.TensorAttr()
+        .set_name("image")
+        .set_dim([16, 128, 64, 64])
+        .set_stride([128 * 64 * 64, 1, 128 * 64, 128])
+    )
+    wT = graph.tensor(
+        fusilli.TensorAttr()
+        .set_name("filter")
+        .set_dim([256, 128, 1, 1])
+        .set_stride([128, 1, 128, 128])
+    )
+    attr = (
+        fusilli.ConvFPropAttr()
+        .set_name("conv_fprop")
+        .set_padding([0, 0])
+        .set_stride([1, 1])
+        .set_dilation([1, 1])
+    )
+    assert attr.padding == [0, 0]
+    yT = graph.conv_fprop(xT, wT, attr)
+    yT.set_output(True)
+    with pytest.raises(fusilli.Error, match="NOT_VALIDATED"):
+        graph.binding_plan
+    graph.validate()
+
+    assert yT.dim == [16, 256, 64, 64]
+    assert xT.physical_dim == [16, 64, 64, 128]
+    assert [t.name for t in graph.binding_plan] == [yT.name, "filter", "image"]
+    assert "torch.aten.convolution" in graph.emit_asm()
+
+
+def test_invalid_tensor_raises():
+    tensor = fusilli.TensorAttr().set_name("x").set_dim([2, 2])
+    with pytest.raises(fusilli.Error, match="ATTRIBUTE_NOT_SET"):
+        tensor.validate()
+
+
+def test_execute_torch_tensors_in_place():
+    torch = pytest.importorskip("torch")
+    x = torch.arange(6, dtype=torch.float32).reshape(2, 3)
+    y = torch.full((2, 3), 10.0)
+    z = torch.empty((2, 3))
+    graph, xT, yT, zT = _add_graph(x, y)
+    handle = fusilli.handle_for_torch("cpu")
+    assert handle is fusilli.handle_for_torch("cpu")
+    graph.compile(handle)
+
+    buffers = {
+        tensor: fusilli.buffer_from_torch(handle, value)
+        for tensor, value in ((xT, x), (yT, y), (zT, z))
+    }
+    graph.execute(handle, buffers)
+    assert torch.equal(z, x + y)
+
+    # The buffers view the tensors, so updates are seen by later executions.
+    x.mul_(2)
+    graph.execute(handle, [buffers[tensor] for tensor in graph.binding_plan])
+    assert torch.equal(z, x + y)
+
+
+def test_channels_last_tensors_are_imported_in_physical_order():
+    torch = pytest.importorskip("torch")
+    handle = fusilli.handle_for_torch("cpu")
+    x = torch.zeros((2, 3, 4, 5)).to(memory_format=torch.channels_last)
+    assert fusilli.buffer_from_torch(handle, x).shape == [2, 4, 5, 3]
+    with pytest.raises(ValueError, match="not dense"):
+        fusilli.buffer_from_torch(handle, torch.zeros((4, 4))[:, :2])
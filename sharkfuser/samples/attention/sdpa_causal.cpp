@@ -0,0 +1,118 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Causal scaled dot-product attention", "[sdpa][graph]") {
+  const int64_t b = 2, h = 2, s = 8, d = 16;
+
+  // Parameterize sample by backend and create device-specific handles
+  std::shared_ptr<Handle> handlePtr;
+  SECTION("cpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU)));
+  }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::AMDGPU)));
+  }
+#endif
+
+  auto buildNewGraph = [&](const Handle &handle) {
+    // Create graph
+    auto graph = std::make_shared<Graph>();
+    graph->setName("sdpa_causal");
+    graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+    // Q, K and V: contiguous BHSD tensors
+    auto bhsdTensor = [&](const std::string &name) {
+      return graph->tensor(TensorAttr()
+                               .setName(name)
+                               .setDim({b, h, s, d})
+                               .setStride({h * s * d, s * d, d, 1}));
+    };
+    auto qT = bhsdTensor("q");
+    auto kT = bhsdTensor("k");
+    auto vT = bhsdTensor("v");
+
+    // Create SDPA op
+    auto sdpaAttr = SdpaAttr().setName("sdpa").setCausal(true);
+    auto oT = graph->sdpa(qT, kT, vT, sdpaAttr);
+
+    oT->setName("result").setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, qT, kT, vT, oT);
+  };
+
+  Handle &handle = *handlePtr;
+  // Build graph for the given handle (device), validate and compile it.
+  auto [graph, qT, kT, vT, oT] = buildNewGraph(handle);
+
+  // With Q = K = 0 all scores are equal, so the causal attention of each
+  // query is the mean of the values of the keys up to it. Setting the values
+  // of key j to j makes the output of query i the mean of 0, ..., i: i / 2.
+  std::vector<float> vData(static_cast<size_t>(b * h * s * d));
+  std::vector<float> expectedResult(vData.size());
+  for (size_t i = 0; i < vData.size(); ++i) {
+    size_t seqIdx = (i / static_cast<size_t>(d)) % static_cast<size_t>(s);
+    vData[i] = static_cast<float>(seqIdx);
+    expectedResult[i] = static_cast<float>(seqIdx) / 2.0f;
+  }
+
+  // Allocate input buffers and initialize with input data
+  auto qBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, qT, DataType::Float, 0.0f));
+  auto kBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, kT, DataType::Float, 0.0f));
+  auto vBuf = std::make_shared<Buffer>(FUSILLI_REQUIRE_UNWRAP(
+      Buffer::allocate(handle, castToSizeT(vT->getPhysicalDim()), vData)));
+
+  // Allocate output buffer
+  auto resultBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, oT, DataType::Float, 0.0f));
+
+  // Create variant pack
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {qT, qBuf},
+          {kT, kBuf},
+          {vT, vBuf},
+          {oT, resultBuf},
+      };
+
+  // Execute graph
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack));
+
+  // Read output buffer and verify against expected result
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(resultBuf->read(handle, result));
+  REQUIRE(result.size() == expectedResult.size());
+  for (size_t i = 0; i < result.size(); ++i)
+    REQUIRE_THAT(result[i], WithinAbs(expectedResult[i], 1e-5));
+}
@@ -69,6 +69,9 @@ TEST_CASE("Convolution fprop; X (NHWC), W (KRSC); 1x1 conv; no "
     // Compile
     FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
 
+    // The bias and relu epilogues are fused into the dispatch of the conv.
+    REQUIRE(FUSILLI_REQUIRE_UNWRAP(getDispatchCount(*graph)) == 1);
+
     return std::make_tuple(graph, xT, wT, bT, reluResult);
   };
 
@@ -0,0 +1,114 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Convolution fprop; X (NHWC), W (KRSC); 1x1 conv; dynamic batch",
+          "[conv][graph]") {
+  int64_t n = 4, c = 16, h = 8, w = 8, k = 32, r = 1, s = 1;
+
+  // Parameterize sample by backend and create device-specific handles.
+  std::shared_ptr<Handle> handlePtr;
+  SECTION("cpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU)));
+  }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::AMDGPU)));
+  }
+#endif
+  Handle &handle = *handlePtr;
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_fprop_sample_nhwc_krsc_1x1_dynamic_batch");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  // The batch size `n` is representative: the graph serves any batch size.
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("image")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c}) // NHWC
+                              .setDynamicDims({0}));
+
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("filter")
+                              .setDim({k, c, r, s})
+                              .setStride({c * r * s, 1, c * s, c})); // KRSC
+
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({0, 0})
+                      .setStride({1, 1})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+
+  auto yT = graph->convFProp(xT, wT, convAttr);
+  yT->setOutput(true);
+
+  // Validate, infer missing properties
+  FUSILLI_REQUIRE_OK(graph->validate());
+  REQUIRE(yT->isDynamicDim(0));
+
+  // Compile once.
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  auto wBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, wT, DataType::Half, 1.0f));
+
+  // Execute for batch sizes other than the representative one.
+  for (int64_t batch : {int64_t{1}, int64_t{7}}) {
+    auto xBuf = std::make_shared<Buffer>(FUSILLI_REQUIRE_UNWRAP(
+        Buffer::allocate(handle, castToSizeT({batch, h, w, c}),
+                         std::vector<half>(batch * h * w * c, half(1.0f)))));
+    auto yBuf = std::make_shared<Buffer>(FUSILLI_REQUIRE_UNWRAP(
+        Buffer::allocate(handle, castToSizeT({batch, h, w, k}),
+                         std::vector<half>(batch * h * w * k, half(0.0f)))));
+
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>>
+        variantPack = {
+            {xT, xBuf},
+            {wT, wBuf},
+            {yT, yBuf},
+        };
+    FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack));
+
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+    REQUIRE(result.size() == static_cast<size_t>(batch * h * w * k));
+    for (auto val : result)
+      REQUIRE(val == half(16.0f));
+  }
+
+  // Buffers must match the static dims.
+  auto badXBuf = std::make_shared<Buffer>(FUSILLI_REQUIRE_UNWRAP(
+      Buffer::allocate(handle, castToSizeT({n, h, w, c + 1}),
+                       std::vector<half>(n * h * w * (c + 1), half(1.0f)))));
+  auto yBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, yT, DataType::Half, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      badVariantPack = {
+          {xT, badXBuf},
+          {wT, wBuf},
+          {yT, yBuf},
+      };
+  ErrorObject status = graph->execute(handle, badVariantPack);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::VariantPackError);
+}
@@ -0,0 +1,159 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Convolution fprop; X (NHWC), W (KRSC); 1x1 conv; no "
+          "padding; batchnorm (inference); relu",
+          "[conv][graph]") {
+  constexpr int64_t n = 4, c = 16, h = 16, w = 16, k = 32, r = 1, s = 1;
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("conv_fprop_sample_nhwc_krsc_1x1_nopad_batchnorm_relu");
+    graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+    auto xT = graph->tensor(TensorAttr()
+                                .setName("image")
+                                .setDim({n, c, h, w})
+                                .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+    auto wT = graph->tensor(TensorAttr()
+                                .setName("filter")
+                                .setDim({k, c, r, s})
+                                .setStride({c * r * s, 1, c * s, c})); // KRSC
+
+    auto convAttr = ConvFPropAttr()
+                        .setStride({1, 1})
+                        .setPadding({0, 0})
+                        .setDilation({1, 1})
+                        .setName("conv_fprop");
+
+    auto convResult = graph->convFProp(xT, wT, convAttr);
+    convResult->setName("conv_result").setDataType(DataType::Half);
+
+    auto channelTensor = [&](const std::string &name) {
+      return graph->tensor(TensorAttr()
+                               .setName(name)
+                               .setDim({1, k, 1, 1})
+                               .setStride({k, 1, 1, 1}));
+    };
+    auto scaleT = channelTensor("scale");
+    auto biasT = channelTensor("bias");
+    auto meanT = channelTensor("mean");
+    auto varT = channelTensor("var");
+
+    auto batchnormAttr = BatchnormAttr().setName("batchnorm");
+    auto bnResult = graph->batchnormInference(convResult, scaleT, biasT, meanT,
+                                              varT, batchnormAttr);
+    bnResult->setName("bn_result").setDataType(DataType::Half);
+
+    auto reluAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD);
+    auto reluResult = graph->pointwise(bnResult, reluAttr);
+    reluResult->setName("result").setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    // The batchnorm (with the running statistics) and relu epilogues are
+    // fused into the dispatch of the conv.
+    REQUIRE(FUSILLI_REQUIRE_UNWRAP(getDispatchCount(*graph)) == 1);
+
+    return std::make_tuple(graph, xT, wT, scaleT, biasT, meanT, varT,
+                           reluResult);
+  };
+
+  // Parameterize sample by backend and create device-specific handles.
+  std::shared_ptr<Handle> handlePtr;
+  SECTION("cpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU)));
+  }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::AMDGPU)));
+  }
+#endif
+  Handle &handle = *handlePtr;
+
+  // Build graph for the given handle (device), validate and compile it.
+  auto [graph, xT, wT, scaleT, biasT, meanT, varT, yT] = buildNewGraph(handle);
+
+  // Allocate input, weights and batchnorm buffers.
+  constexpr float inputScalar = 1.0f;
+  constexpr float scale = 2.0f, bias = -1.0f, mean = 8.0f, var = 4.0f;
+  auto xBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, xT, DataType::Half, inputScalar));
+  auto wBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, wT, DataType::Half, inputScalar));
+  auto scaleBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, scaleT, DataType::Half, scale));
+  auto biasBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, biasT, DataType::Half, bias));
+  auto meanBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, meanT, DataType::Half, mean));
+  auto varBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, varT, DataType::Half, var));
+  // Allocate output buffer.
+  auto yBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, yT, DataType::Half, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},       {wT, wBuf},       {scaleT, scaleBuf},
+          {biasT, biasBuf}, {meanT, meanBuf}, {varT, varBuf},
+          {yT, yBuf},
+      };
+
+  // Execute graph once.
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack));
+
+  // Calculate expected output value: relu((16 - 8) / sqrt(4) * 2 - 1) = 7,
+  // up to the (default) epsilon and half precision.
+  constexpr float convResult =
+      static_cast<float>(c * r * s) * inputScalar * inputScalar;
+  const float expected = (convResult - mean) / std::sqrt(var) * scale + bias;
+  constexpr double tolerance = 1e-2;
+
+  // Read output buffers.
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE_THAT(static_cast<float>(val), WithinAbs(expected, tolerance));
+
+  // Execute graph a few times.
+  constexpr size_t numIters = 1;
+  for (size_t i = 0; i < numIters; i++)
+    FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack));
+
+  // Repeat output buffer checks.
+  result.clear();
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE_THAT(static_cast<float>(val), WithinAbs(expected, tolerance));
+}
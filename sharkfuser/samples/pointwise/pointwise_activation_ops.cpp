@@ -0,0 +1,273 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <numbers>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+using Catch::Matchers::WithinAbs;
+
+// Tolerance of the results of transcendental functions, which the compiler
+// may approximate.
+static constexpr double kTolerance = 1e-4;
+
+static const std::vector<int64_t> kDim = {2, 16, 8, 8};
+
+static std::shared_ptr<TensorAttr> createInputTensor(Graph &graph,
+                                                     const std::string &name) {
+  return graph.tensor(TensorAttr().setName(name).setDim(kDim).setStride(
+      generateStrideFromDim(kDim, getContiguousStrideOrder(kDim.size()))));
+}
+
+static std::shared_ptr<Handle> createHandle(Backend backend) {
+  return std::make_shared<Handle>(
+      FUSILLI_REQUIRE_UNWRAP(Handle::create(backend)));
+}
+
+// Reference gaussian CDF and PDF for GELU.
+static double gaussianCdf(double x) {
+  return 0.5 * (1.0 + std::erf(x / std::numbers::sqrt2));
+}
+static double gaussianPdf(double x) {
+  return std::exp(-0.5 * x * x) / std::sqrt(2.0 * std::numbers::pi);
+}
+
+// Inner term `u` of the tanh approximation of GELU, 0.5 * x * (1 + tanh(u)).
+static double geluTanhInner(double x) {
+  return std::sqrt(2.0 / std::numbers::pi) * (x + 0.044715 * x * x * x);
+}
+
+TEST_CASE("Pointwise activation ops", "[pointwise][graph]") {
+  const auto mode = GENERATE(
+      PointwiseAttr::Mode::CLAMP, PointwiseAttr::Mode::GELU_APPROX_TANH_FWD,
+      PointwiseAttr::Mode::GELU_FWD, PointwiseAttr::Mode::SIGMOID_FWD,
+      PointwiseAttr::Mode::SWISH_FWD, PointwiseAttr::Mode::TANH_FWD);
+  const float x = GENERATE(-1.5f, 0.5f, 7.0f);
+
+  // Parameterize sample by backend and create device-specific handles.
+  std::shared_ptr<Handle> handlePtr;
+  SECTION("cpu backend") { handlePtr = createHandle(Backend::CPU); }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") { handlePtr = createHandle(Backend::AMDGPU); }
+#endif
+  Handle &handle = *handlePtr;
+
+  // Create graph.
+  auto graph = std::make_shared<Graph>();
+  graph->setName(std::format("pointwise_{}_activation",
+                             PointwiseAttr::kModeToStr.at(mode)));
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = createInputTensor(*graph, "in0");
+  auto pointwiseAttr = PointwiseAttr().setMode(mode);
+  if (mode == PointwiseAttr::Mode::CLAMP)
+    pointwiseAttr.setClampMin(0.0f).setClampMax(6.0f);
+  auto yT = graph->pointwise(xT, pointwiseAttr);
+  yT->setName("result").setOutput(true);
+
+  // Validate, infer missing properties and compile.
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  // Allocate buffers and execute graph.
+  auto xBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, xT, DataType::Float, x));
+  auto yBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {yT, yBuf},
+      };
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack));
+
+  // Calculate reference value.
+  double y = 0.0;
+  switch (mode) {
+  case PointwiseAttr::Mode::CLAMP:
+    y = std::clamp(x, 0.0f, 6.0f);
+    break;
+  case PointwiseAttr::Mode::GELU_APPROX_TANH_FWD:
+    y = 0.5 * x * (1.0 + std::tanh(geluTanhInner(x)));
+    break;
+  case PointwiseAttr::Mode::GELU_FWD:
+    y = x * gaussianCdf(x);
+    break;
+  case PointwiseAttr::Mode::SIGMOID_FWD:
+    y = 1.0 / (1.0 + std::exp(-x));
+    break;
+  case PointwiseAttr::Mode::SWISH_FWD:
+    y = x / (1.0 + std::exp(-x));
+    break;
+  case PointwiseAttr::Mode::TANH_FWD:
+    y = std::tanh(x);
+    break;
+  default:
+    FAIL("Unsupported pointwise mode: " << PointwiseAttr::kModeToStr.at(mode));
+  }
+
+  // Read output buffer.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE_THAT(val, WithinAbs(y, kTolerance));
+}
+
+TEST_CASE("Pointwise activation backward ops", "[pointwise][graph]") {
+  const auto mode = GENERATE(
+      PointwiseAttr::Mode::GELU_APPROX_TANH_BWD, PointwiseAttr::Mode::GELU_BWD,
+      PointwiseAttr::Mode::RELU_BWD, PointwiseAttr::Mode::SIGMOID_BWD,
+      PointwiseAttr::Mode::TANH_BWD);
+  // Gradient of the output, and input (or output for SIGMOID_BWD and
+  // TANH_BWD) of the forward activation.
+  const float dy = 0.5f;
+  const float x = GENERATE(-1.5f, 0.25f);
+
+  // Parameterize sample by backend and create device-specific handles.
+  std::shared_ptr<Handle> handlePtr;
+  SECTION("cpu backend") { handlePtr = createHandle(Backend::CPU); }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") { handlePtr = createHandle(Backend::AMDGPU); }
+#endif
+  Handle &handle = *handlePtr;
+
+  // Create graph.
+  auto graph = std::make_shared<Graph>();
+  graph->setName(std::format("pointwise_{}_activation",
+                             PointwiseAttr::kModeToStr.at(mode)));
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto dyT = createInputTensor(*graph, "in0_dy");
+  auto xT = createInputTensor(*graph, "in1_x");
+  auto pointwiseAttr = PointwiseAttr().setMode(mode);
+  auto dxT = graph->pointwise(dyT, xT, pointwiseAttr);
+  dxT->setName("result").setOutput(true);
+
+  // Validate, infer missing properties and compile.
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  // Allocate buffers and execute graph.
+  auto dyBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, dyT, DataType::Float, dy));
+  auto xBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, xT, DataType::Float, x));
+  auto dxBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, dxT, DataType::Float, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {dyT, dyBuf},
+          {xT, xBuf},
+          {dxT, dxBuf},
+      };
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack));
+
+  // Calculate reference value.
+  double dx = 0.0;
+  switch (mode) {
+  case PointwiseAttr::Mode::GELU_APPROX_TANH_BWD: {
+    double t = std::tanh(geluTanhInner(x));
+    double du =
+        std::sqrt(2.0 / std::numbers::pi) * (1.0 + 3 * 0.044715 * x * x);
+    dx = dy * (0.5 * (1.0 + t) + 0.5 * x * (1.0 - t * t) * du);
+    break;
+  }
+  case PointwiseAttr::Mode::GELU_BWD:
+    dx = dy * (gaussianCdf(x) + x * gaussianPdf(x));
+    break;
+  case PointwiseAttr::Mode::RELU_BWD:
+    dx = x > 0.0f ? dy : 0.0;
+    break;
+  case PointwiseAttr::Mode::SIGMOID_BWD:
+    dx = dy * x * (1.0 - x);
+    break;
+  case PointwiseAttr::Mode::TANH_BWD:
+    dx = dy * (1.0 - x * x);
+    break;
+  default:
+    FAIL("Unsupported pointwise mode: " << PointwiseAttr::kModeToStr.at(mode));
+  }
+
+  // Read output buffer.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(dxBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE_THAT(val, WithinAbs(dx, kTolerance));
+}
+
+TEST_CASE("Pointwise scale and shift", "[pointwise][graph]") {
+  const std::vector<int64_t> channelDim = {1, kDim[1], 1, 1};
+
+  // Parameterize sample by backend and create device-specific handles.
+  std::shared_ptr<Handle> handlePtr;
+  SECTION("cpu backend") { handlePtr = createHandle(Backend::CPU); }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") { handlePtr = createHandle(Backend::AMDGPU); }
+#endif
+  Handle &handle = *handlePtr;
+
+  // Create graph, with per-channel scale and shift.
+  auto graph = std::make_shared<Graph>();
+  graph->setName("pointwise_scale_shift");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = createInputTensor(*graph, "in0");
+  auto scaleT = graph->tensor(
+      TensorAttr().setName("in1_scale").setDim(channelDim).setStride(
+          generateStrideFromDim(channelDim,
+                                getContiguousStrideOrder(channelDim.size()))));
+  auto shiftT = graph->tensor(
+      TensorAttr().setName("in2_shift").setDim(channelDim).setStride(
+          generateStrideFromDim(channelDim,
+                                getContiguousStrideOrder(channelDim.size()))));
+  auto pointwiseAttr =
+      PointwiseAttr().setMode(PointwiseAttr::Mode::SCALE_SHIFT);
+  auto yT = graph->pointwise(xT, scaleT, shiftT, pointwiseAttr);
+  yT->setName("result").setOutput(true);
+
+  // Validate, infer missing properties and compile.
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  // Allocate buffers and execute graph.
+  auto xBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, xT, DataType::Float, 1.5f));
+  auto scaleBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, scaleT, DataType::Float, 2.0f));
+  auto shiftBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, shiftT, DataType::Float, 0.25f));
+  auto yBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {scaleT, scaleBuf},
+          {shiftT, shiftBuf},
+          {yT, yBuf},
+      };
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack));
+
+  // Read output buffer and verify against 1.5 * 2.0 + 0.25.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == 3.25f);
+}
@@ -0,0 +1,138 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} stats | FileCheck %s --check-prefix=%{BACKEND}-STATS-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[2,8,8,16],f32>, %bias: !torch.vtensor<[1,16,1,1],f32>, %mean: !torch.vtensor<[1,16,1,1],f32>, %scale: !torch.vtensor<[1,16,1,1],f32>, %var: !torch.vtensor<[1,16,1,1],f32>, %x: !torch.vtensor<[2,8,8,16],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %permute_X_val_0_batchnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_X_val_1_batchnorm = torch.constant.int 3
+// TORCH-CHECK:       %permute_X_val_2_batchnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_X_val_3_batchnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_X_batchnorm = torch.prim.ListConstruct %permute_X_val_0_batchnorm, %permute_X_val_1_batchnorm, %permute_X_val_2_batchnorm, %permute_X_val_3_batchnorm : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %x_X_batchnorm_perm = torch.aten.permute %x, %permute_X_batchnorm : !torch.vtensor<[2,8,8,16],f32>, !torch.list<int> -> !torch.vtensor<[2,16,8,8],f32>
+// TORCH-CHECK:       %permute_SCALE_val_0_batchnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_SCALE_val_1_batchnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_SCALE_val_2_batchnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_SCALE_val_3_batchnorm = torch.constant.int 3
+// TORCH-CHECK:       %permute_SCALE_batchnorm = torch.prim.ListConstruct %permute_SCALE_val_0_batchnorm, %permute_SCALE_val_1_batchnorm, %permute_SCALE_val_2_batchnorm, %permute_SCALE_val_3_batchnorm : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %scale_SCALE_batchnorm_perm = torch.aten.permute %scale, %permute_SCALE_batchnorm : !torch.vtensor<[1,16,1,1],f32>, !torch.list<int> -> !torch.vtensor<[1,16,1,1],f32>
+// TORCH-CHECK:       %permute_BIAS_val_0_batchnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_BIAS_val_1_batchnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_BIAS_val_2_batchnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_BIAS_val_3_batchnorm = torch.constant.int 3
+// TORCH-CHECK:       %permute_BIAS_batchnorm = torch.prim.ListConstruct %permute_BIAS_val_0_batchnorm, %permute_BIAS_val_1_batchnorm, %permute_BIAS_val_2_batchnorm, %permute_BIAS_val_3_batchnorm : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %bias_BIAS_batchnorm_perm = torch.aten.permute %bias, %permute_BIAS_batchnorm : !torch.vtensor<[1,16,1,1],f32>, !torch.list<int> -> !torch.vtensor<[1,16,1,1],f32>
+// TORCH-CHECK:       %permute_MEAN_val_0_batchnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_MEAN_val_1_batchnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_MEAN_val_2_batchnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_MEAN_val_3_batchnorm = torch.constant.int 3
+// TORCH-CHECK:       %permute_MEAN_batchnorm = torch.prim.ListConstruct %permute_MEAN_val_0_batchnorm, %permute_MEAN_val_1_batchnorm, %permute_MEAN_val_2_batchnorm, %permute_MEAN_val_3_batchnorm : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %mean_MEAN_batchnorm_perm = torch.aten.permute %mean, %permute_MEAN_batchnorm : !torch.vtensor<[1,16,1,1],f32>, !torch.list<int> -> !torch.vtensor<[1,16,1,1],f32>
+// TORCH-CHECK:       %permute_VAR_val_0_batchnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_VAR_val_1_batchnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_VAR_val_2_batchnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_VAR_val_3_batchnorm = torch.constant.int 3
+// TORCH-CHECK:       %permute_VAR_batchnorm = torch.prim.ListConstruct %permute_VAR_val_0_batchnorm, %permute_VAR_val_1_batchnorm, %permute_VAR_val_2_batchnorm, %permute_VAR_val_3_batchnorm : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %var_VAR_batchnorm_perm = torch.aten.permute %var, %permute_VAR_batchnorm : !torch.vtensor<[1,16,1,1],f32>, !torch.list<int> -> !torch.vtensor<[1,16,1,1],f32>
+// TORCH-CHECK:       %epsilon_batchnorm = torch.constant.float 1.000000e-03
+// TORCH-CHECK:       %alpha_batchnorm = torch.constant.int 1
+// TORCH-CHECK:       %var_eps_batchnorm = torch.aten.add.Scalar %var_VAR_batchnorm_perm, %epsilon_batchnorm, %alpha_batchnorm : !torch.vtensor<[1,16,1,1],f32>, !torch.float, !torch.int -> !torch.vtensor<[1,16,1,1],f32>
+// TORCH-CHECK:       %inv_std_batchnorm = torch.aten.rsqrt %var_eps_batchnorm : !torch.vtensor<[1,16,1,1],f32> -> !torch.vtensor<[1,16,1,1],f32>
+// TORCH-CHECK:       %centered_batchnorm = torch.aten.sub.Tensor %x_X_batchnorm_perm, %mean_MEAN_batchnorm_perm, %alpha_batchnorm : !torch.vtensor<[2,16,8,8],f32>, !torch.vtensor<[1,16,1,1],f32>, !torch.int -> !torch.vtensor<[2,16,8,8],f32>
+// TORCH-CHECK:       %normalized_batchnorm = torch.aten.mul.Tensor %centered_batchnorm, %inv_std_batchnorm : !torch.vtensor<[2,16,8,8],f32>, !torch.vtensor<[1,16,1,1],f32> -> !torch.vtensor<[2,16,8,8],f32>
+// TORCH-CHECK:       %scaled_batchnorm = torch.aten.mul.Tensor %normalized_batchnorm, %scale_SCALE_batchnorm_perm : !torch.vtensor<[2,16,8,8],f32>, !torch.vtensor<[1,16,1,1],f32> -> !torch.vtensor<[2,16,8,8],f32>
+// TORCH-CHECK:       %result_perm = torch.aten.add.Tensor %scaled_batchnorm, %bias_BIAS_batchnorm_perm, %alpha_batchnorm : !torch.vtensor<[2,16,8,8],f32>, !torch.vtensor<[1,16,1,1],f32>, !torch.int -> !torch.vtensor<[2,16,8,8],f32>
+// TORCH-CHECK:       %permute_Y_val_0_batchnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_Y_val_1_batchnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_Y_val_2_batchnorm = torch.constant.int 3
+// TORCH-CHECK:       %permute_Y_val_3_batchnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_Y_batchnorm = torch.prim.ListConstruct %permute_Y_val_0_batchnorm, %permute_Y_val_1_batchnorm, %permute_Y_val_2_batchnorm, %permute_Y_val_3_batchnorm : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_Y_batchnorm : !torch.vtensor<[2,16,8,8],f32>, !torch.list<int> -> !torch.vtensor<[2,8,8,16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[2,8,8,16],f32>, !torch.tensor<[2,8,8,16],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// AMDGPU-STATS-CHECK: "dispatch-count": 1
+// CPU-STATS-CHECK: "dispatch-count": 1
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject
+testBatchnormAsmEmitterInferenceNhwc(const std::string &mode) {
+  int64_t n = 2, c = 16, h = 8, w = 8;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("batchnorm_asm_emitter_inference_nhwc");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+  auto channelTensor = [&](const std::string &name) {
+    return graph->tensor(TensorAttr()
+                             .setName(name)
+                             .setDim({1, c, 1, 1})
+                             .setStride({c, 1, 1, 1}));
+  };
+  auto scaleT = channelTensor("scale");
+  auto biasT = channelTensor("bias");
+  auto meanT = channelTensor("mean");
+  auto varT = channelTensor("var");
+
+  auto batchnormAttr = BatchnormAttr().setName("batchnorm").setEpsilon(1e-3f);
+
+  auto yT = graph->batchnormInference(xT, scaleT, biasT, meanT, varT,
+                                      batchnormAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+  }
+
+  if (mode == "stats") {
+#ifdef FUSILLI_ENABLE_AMDGPU
+    Handle handle = FUSILLI_TRY(Handle::create(Backend::AMDGPU));
+#else
+    Handle handle = FUSILLI_TRY(Handle::create(Backend::CPU));
+#endif
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/true));
+    std::cout << FUSILLI_TRY(graph->readCompilationCacheFile(
+                     CachedAssetsType::Statistics))
+              << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testBatchnormAsmEmitterInferenceNhwc(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,86 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input | \
+// RUN:             FileCheck %s --check-prefix=LINALG-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[1,2,4,4],f32>, %arg0_image: !torch.vtensor<[1,2,4,4],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg1_filter = torch.vtensor.literal(dense_resource<fusilli_constant_arg1_filter> : tensor<2x1x1x2xf32>) : !torch.vtensor<[2,1,1,2],f32>
+// TORCH-CHECK:       %arg1_filter_perm = torch.aten.permute %arg1_filter, %permute_W_conv_fprop : !torch.vtensor<[2,1,1,2],f32>, !torch.list<int> -> !torch.vtensor<[2,2,1,1],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[1,2,4,4],f32>, !torch.tensor<[1,2,4,4],f32>
+// TORCH-CHECK:   {-#
+// TORCH-CHECK:     dialect_resources: {
+// TORCH-CHECK:       builtin: {
+// TORCH-CHECK:         fusilli_constant_arg1_filter: "0x400000000000803F000000400000404000008040"
+// TORCH-CHECK:       }
+// TORCH-CHECK:     }
+// TORCH-CHECK:   #-}
+//
+// The filter is embedded rather than an argument.
+// LINALG-CHECK:    util.func public @main$async(%[[ARG0:.+]]: !hal.buffer_view, %[[ARG1:.+]]: !hal.buffer_view, %{{[^:]+}}: !hal.fence
+// LINALG-CHECK:      linalg.conv_2d_nchw_fchw
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testConvAsmEmitterConstantFilter() {
+  int64_t n = 1, c = 2, h = 4, w = 4, k = 2, r = 1, s = 1;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_asm_emitter_constant_filter");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_image")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+  // KRSC filter, embedded as a constant in physical order.
+  auto wT = graph->tensor(
+      TensorAttr()
+          .setName("arg1_filter")
+          .setDim({k, c, r, s})
+          .setStride({c * r * s, 1, c * s, c}) // KRSC
+          .setConstantData(std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f}));
+
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({0, 0})
+                      .setStride({1, 1})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+
+  auto yT = graph->convFProp(xT, wT, convAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testConvAsmEmitterConstantFilter();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -12,7 +12,7 @@
 
 // clang-format off
 //
-// TORCH-CHECK:   module @module {
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
 // TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[16,256,64,32],f32>, %arg0_image: !torch.vtensor<[16,128,64,32],f32>, %arg1_filter: !torch.vtensor<[256,128,1,1],f32>) attributes {torch.assume_strict_symbolic_shapes} {
 // TORCH-CHECK:       %bias_conv_fprop = torch.constant.none
 // TORCH-CHECK:       %transposed_conv_fprop = torch.constant.bool false
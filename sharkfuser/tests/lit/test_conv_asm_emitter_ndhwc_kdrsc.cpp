@@ -12,7 +12,7 @@
 
 // clang-format off
 //
-// TORCH-CHECK:   module @module {
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
 // TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[16,64,1,32,256],f32>, %arg0_image: !torch.vtensor<[16,2,64,32,128],f32>, %arg1_filter: !torch.vtensor<[256,2,128,1,1],f32>) attributes {torch.assume_strict_symbolic_shapes} {
 // TORCH-CHECK:       %bias_conv_fprop = torch.constant.none
 // TORCH-CHECK:       %transposed_conv_fprop = torch.constant.bool false
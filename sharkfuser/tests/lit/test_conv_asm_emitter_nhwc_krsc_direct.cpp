@@ -0,0 +1,115 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input | \
+// RUN:             FileCheck %s --check-prefix=LINALG-CHECK
+// RUN: %{TEST_EXE} stats | FileCheck %s --check-prefix=%{BACKEND}-STATS-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[16,64,32,256],f32>, %arg0_image: !torch.vtensor<[16,64,32,128],f32>, %arg1_filter: !torch.vtensor<[256,3,3,128],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %x_builtin_conv_fprop = torch_c.to_builtin_tensor %arg0_image : !torch.vtensor<[16,64,32,128],f32> -> tensor<16x64x32x128xf32>
+// TORCH-CHECK:       %w_builtin_conv_fprop = torch_c.to_builtin_tensor %arg1_filter : !torch.vtensor<[256,3,3,128],f32> -> tensor<256x3x3x128xf32>
+// TORCH-CHECK:       %pad_value_conv_fprop = arith.constant 0.000000e+00 : f32
+// TORCH-CHECK:       %x_padded_conv_fprop = tensor.pad %x_builtin_conv_fprop low[0, 1, 1, 0] high[0, 1, 1, 0] {
+// TORCH-CHECK:       ^bb0(%pad_n_conv_fprop: index, %pad_h_conv_fprop: index, %pad_w_conv_fprop: index, %pad_c_conv_fprop: index):
+// TORCH-CHECK:       tensor.yield %pad_value_conv_fprop : f32
+// TORCH-CHECK:       } : tensor<16x64x32x128xf32> to tensor<16x66x34x128xf32>
+// TORCH-CHECK:       %acc_zero_conv_fprop = arith.constant 0.000000e+00 : f32
+// TORCH-CHECK:       %acc_empty_conv_fprop = tensor.empty() : tensor<16x64x32x256xf32>
+// TORCH-CHECK:       %acc_conv_fprop = linalg.fill ins(%acc_zero_conv_fprop : f32) outs(%acc_empty_conv_fprop : tensor<16x64x32x256xf32>) -> tensor<16x64x32x256xf32>
+// TORCH-CHECK:       %conv_conv_fprop = linalg.conv_2d_nhwc_fhwc {dilations = dense<[1, 1]> : tensor<2xi64>, strides = dense<[1, 1]> : tensor<2xi64>} ins(%x_padded_conv_fprop, %w_builtin_conv_fprop : tensor<16x66x34x128xf32>, tensor<256x3x3x128xf32>) outs(%acc_conv_fprop : tensor<16x64x32x256xf32>) -> tensor<16x64x32x256xf32>
+// TORCH-CHECK:       %result = torch_c.from_builtin_tensor %conv_conv_fprop : tensor<16x64x32x256xf32> -> !torch.vtensor<[16,64,32,256],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[16,64,32,256],f32>, !torch.tensor<[16,64,32,256],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// LINALG-CHECK:     util.func public @main$async(%[[ARG0:.+]]: !hal.buffer_view, %[[ARG1:.+]]: !hal.buffer_view, %[[ARG2:.+]]: !hal.buffer_view, {{.+}}
+// LINALG-CHECK:       %[[BUF1:.+]] = hal.tensor.import wait(%{{.+}}) => %arg1 : !hal.buffer_view -> tensor<16x64x32x128xf32>
+// LINALG-CHECK:       %[[BUF2:.+]] = hal.tensor.import wait(%{{.+}}) => %arg2 : !hal.buffer_view -> tensor<256x3x3x128xf32>
+// LINALG-CHECK-NOT:   linalg.transpose
+// LINALG-CHECK:       %[[BUF1P:.+]] = tensor.pad %[[BUF1]] low[0, 1, 1, 0] high[0, 1, 1, 0] {
+// LINALG-CHECK:       %[[OUT:.+]] = linalg.conv_2d_nhwc_fhwc {dilations = dense<1> : tensor<2xi64>, strides = dense<1> : tensor<2xi64>} ins(%[[BUF1P]], %[[BUF2]] : tensor<16x66x34x128xf32>, tensor<256x3x3x128xf32>) outs(%{{.+}} : tensor<16x64x32x256xf32>) -> tensor<16x64x32x256xf32>
+// LINALG-CHECK-NOT:   linalg.transpose
+// LINALG-CHECK:       %{{.+}} = hal.tensor.alias wait(%{{.+}}) => %[[OUT]] : tensor<16x64x32x256xf32> to %[[ARG0]] : !hal.buffer_view
+//
+// AMDGPU-STATS-CHECK: "dispatch-count": 1
+// CPU-STATS-CHECK: "dispatch-count": 1
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject
+testConvAsmEmitterXNhwcWKrscDirect(const std::string &mode) {
+  int64_t n = 16, c = 128, h = 64, w = 32, k = 256, r = 3, s = 3;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_asm_emitter_x_nhwc_w_krsc_direct");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_image")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("arg1_filter")
+                              .setDim({k, c, r, s})
+                              .setStride({c * r * s, 1, c * s, c})); // KRSC
+
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({1, 1})
+                      .setStride({1, 1})
+                      .setDilation({1, 1})
+                      .setDirectChannelsLast(true)
+                      .setName("conv_fprop");
+
+  auto yT = graph->convFProp(xT, wT, convAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+  }
+
+  if (mode == "stats") {
+#ifdef FUSILLI_ENABLE_AMDGPU
+    Handle handle = FUSILLI_TRY(Handle::create(Backend::AMDGPU));
+#else
+    Handle handle = FUSILLI_TRY(Handle::create(Backend::CPU));
+#endif
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/true));
+    std::cout << FUSILLI_TRY(graph->readCompilationCacheFile(
+                     CachedAssetsType::Statistics))
+              << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testConvAsmEmitterXNhwcWKrscDirect(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,117 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input -o /dev/null
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[?,64,32,128],f32>, %arg0_dy: !torch.vtensor<[?,64,32,256],f32>, %arg1_w: !torch.vtensor<[256,128,1,1],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %bias_conv_dgrad = torch.constant.none
+// TORCH-CHECK:       %transposed_conv_dgrad = torch.constant.bool false
+// TORCH-CHECK:       %output_padding_conv_dgrad = torch.prim.ListConstruct  : () -> !torch.list<int>
+// TORCH-CHECK:       %groups_conv_dgrad = torch.constant.int 1
+// TORCH-CHECK:       %stride_val_0_conv_dgrad = torch.constant.int 1
+// TORCH-CHECK:       %stride_val_1_conv_dgrad = torch.constant.int 1
+// TORCH-CHECK:       %stride_conv_dgrad = torch.prim.ListConstruct %stride_val_0_conv_dgrad, %stride_val_1_conv_dgrad : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %padding_val_0_conv_dgrad = torch.constant.int 0
+// TORCH-CHECK:       %padding_val_1_conv_dgrad = torch.constant.int 0
+// TORCH-CHECK:       %padding_conv_dgrad = torch.prim.ListConstruct %padding_val_0_conv_dgrad, %padding_val_1_conv_dgrad : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %dilation_val_0_conv_dgrad = torch.constant.int 1
+// TORCH-CHECK:       %dilation_val_1_conv_dgrad = torch.constant.int 1
+// TORCH-CHECK:       %dilation_conv_dgrad = torch.prim.ListConstruct %dilation_val_0_conv_dgrad, %dilation_val_1_conv_dgrad : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %permute_DY_val_0_conv_dgrad = torch.constant.int 0
+// TORCH-CHECK:       %permute_DY_val_1_conv_dgrad = torch.constant.int 3
+// TORCH-CHECK:       %permute_DY_val_2_conv_dgrad = torch.constant.int 1
+// TORCH-CHECK:       %permute_DY_val_3_conv_dgrad = torch.constant.int 2
+// TORCH-CHECK:       %permute_DY_conv_dgrad = torch.prim.ListConstruct %permute_DY_val_0_conv_dgrad, %permute_DY_val_1_conv_dgrad, %permute_DY_val_2_conv_dgrad, %permute_DY_val_3_conv_dgrad : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %arg0_dy_perm = torch.aten.permute %arg0_dy, %permute_DY_conv_dgrad : !torch.vtensor<[?,64,32,256],f32>, !torch.list<int> -> !torch.vtensor<[?,256,64,32],f32>
+// TORCH-CHECK:       %permute_W_val_0_conv_dgrad = torch.constant.int 0
+// TORCH-CHECK:       %permute_W_val_1_conv_dgrad = torch.constant.int 1
+// TORCH-CHECK:       %permute_W_val_2_conv_dgrad = torch.constant.int 2
+// TORCH-CHECK:       %permute_W_val_3_conv_dgrad = torch.constant.int 3
+// TORCH-CHECK:       %permute_W_conv_dgrad = torch.prim.ListConstruct %permute_W_val_0_conv_dgrad, %permute_W_val_1_conv_dgrad, %permute_W_val_2_conv_dgrad, %permute_W_val_3_conv_dgrad : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %arg1_w_perm = torch.aten.permute %arg1_w, %permute_W_conv_dgrad : !torch.vtensor<[256,128,1,1],f32>, !torch.list<int> -> !torch.vtensor<[256,128,1,1],f32>
+// TORCH-CHECK:       %empty_DX_idx_0_conv_dgrad = torch.constant.int 0
+// TORCH-CHECK:       %empty_DX_val_0_conv_dgrad = torch.aten.size.int %arg0_dy, %empty_DX_idx_0_conv_dgrad : !torch.vtensor<[?,64,32,256],f32>, !torch.int -> !torch.int
+// TORCH-CHECK:       %empty_DX_val_1_conv_dgrad = torch.constant.int 128
+// TORCH-CHECK:       %empty_DX_val_2_conv_dgrad = torch.constant.int 64
+// TORCH-CHECK:       %empty_DX_val_3_conv_dgrad = torch.constant.int 32
+// TORCH-CHECK:       %empty_DX_conv_dgrad = torch.prim.ListConstruct %empty_DX_val_0_conv_dgrad, %empty_DX_val_1_conv_dgrad, %empty_DX_val_2_conv_dgrad, %empty_DX_val_3_conv_dgrad : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %none_DX_conv_dgrad = torch.constant.none
+// TORCH-CHECK:       %dtype_DX_conv_dgrad = torch.constant.int 6
+// TORCH-CHECK:       %empty_x_conv_dgrad = torch.aten.empty.memory_format %empty_DX_conv_dgrad, %dtype_DX_conv_dgrad, %none_DX_conv_dgrad, %none_DX_conv_dgrad, %none_DX_conv_dgrad, %none_DX_conv_dgrad : !torch.list<int>, !torch.int, !torch.none, !torch.none, !torch.none, !torch.none -> !torch.vtensor<[?,128,64,32],f32>
+// TORCH-CHECK:       %true_conv_dgrad = torch.constant.bool true
+// TORCH-CHECK:       %false_conv_dgrad = torch.constant.bool false
+// TORCH-CHECK:       %output_mask_conv_dgrad = torch.prim.ListConstruct %true_conv_dgrad, %false_conv_dgrad, %false_conv_dgrad : (!torch.bool, !torch.bool, !torch.bool) -> !torch.list<bool>
+// TORCH-CHECK:       %result_perm, %grad_weight_conv_dgrad, %grad_bias_conv_dgrad = torch.aten.convolution_backward %arg0_dy_perm, %empty_x_conv_dgrad, %arg1_w_perm, %bias_conv_dgrad, %stride_conv_dgrad, %padding_conv_dgrad, %dilation_conv_dgrad, %transposed_conv_dgrad, %output_padding_conv_dgrad, %groups_conv_dgrad, %output_mask_conv_dgrad : !torch.vtensor<[?,256,64,32],f32>, !torch.vtensor<[?,128,64,32],f32>, !torch.vtensor<[256,128,1,1],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int, !torch.list<bool> -> !torch.vtensor<[?,128,64,32],f32>, !torch.none, !torch.none
+// TORCH-CHECK:       %permute_DX_val_0_conv_dgrad = torch.constant.int 0
+// TORCH-CHECK:       %permute_DX_val_1_conv_dgrad = torch.constant.int 2
+// TORCH-CHECK:       %permute_DX_val_2_conv_dgrad = torch.constant.int 3
+// TORCH-CHECK:       %permute_DX_val_3_conv_dgrad = torch.constant.int 1
+// TORCH-CHECK:       %permute_DX_conv_dgrad = torch.prim.ListConstruct %permute_DX_val_0_conv_dgrad, %permute_DX_val_1_conv_dgrad, %permute_DX_val_2_conv_dgrad, %permute_DX_val_3_conv_dgrad : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_DX_conv_dgrad : !torch.vtensor<[?,128,64,32],f32>, !torch.list<int> -> !torch.vtensor<[?,64,32,128],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[?,64,32,128],f32>, !torch.tensor<[?,64,32,128],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testConvDgradAsmEmitterDyNhwcDxNhwcDynamicBatch() {
+  int64_t n = 16, c = 128, h = 64, w = 32, k = 256, r = 1, s = 1;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_dgrad_asm_emitter_dy_nhwc_w_kcrs_dynamic_batch");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto dyT = graph->tensor(TensorAttr()
+                               .setName("arg0_dy")
+                               .setDim({n, k, h, w})
+                               .setStride({k * h * w, 1, k * w, k}) // NHWC
+                               .setDynamicDims({0})); // Dynamic N
+
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("arg1_w")
+                              .setDim({k, c, r, s})
+                              .setStride({c * r * s, r * s, s, 1})); // KCRS
+
+  auto convDGradAttr = ConvDGradAttr()
+                           .setPadding({0, 0})
+                           .setStride({1, 1})
+                           .setDilation({1, 1})
+                           .setName("conv_dgrad");
+
+  auto dxT = graph->convDGrad(dyT, wT, convDGradAttr);
+
+  dxT->setName("result").setOutput(true).setDim({n, c, h, w});
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  // The batch dim of DX is inferred dynamic, and read from DY.
+  std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testConvDgradAsmEmitterDyNhwcDxNhwcDynamicBatch();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,100 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input | \
+// RUN:             FileCheck %s --check-prefix=LINALG-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[8,4,1,1],f32>, %arg0_dy: !torch.vtensor<[16,8,8,8],f32>, %arg1_x: !torch.vtensor<[16,8,8,4],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_dy_perm = torch.aten.permute %arg0_dy, %permute_DY_conv_wgrad : !torch.vtensor<[16,8,8,8],f32>, !torch.list<int> -> !torch.vtensor<[16,8,8,8],f32>
+// TORCH-CHECK:       %arg1_x_perm = torch.aten.permute %arg1_x, %permute_X_conv_wgrad : !torch.vtensor<[16,8,8,4],f32>, !torch.list<int> -> !torch.vtensor<[16,4,8,8],f32>
+// TORCH-CHECK:       %empty_w_conv_wgrad = torch.aten.empty.memory_format %empty_DW_conv_wgrad, %dtype_DW_conv_wgrad, %none_DW_conv_wgrad, %none_DW_conv_wgrad, %none_DW_conv_wgrad, %none_DW_conv_wgrad : !torch.list<int>, !torch.int, !torch.none, !torch.none, !torch.none, !torch.none -> !torch.vtensor<[8,4,1,1],f32>
+// TORCH-CHECK:       %output_mask_conv_wgrad = torch.prim.ListConstruct %false_conv_wgrad, %true_conv_wgrad, %false_conv_wgrad : (!torch.bool, !torch.bool, !torch.bool) -> !torch.list<bool>
+// TORCH-CHECK:       %split_dim_conv_wgrad = torch.constant.int 0
+// TORCH-CHECK:       %split_step_conv_wgrad = torch.constant.int 1
+// TORCH-CHECK:       %alpha_conv_wgrad = torch.constant.int 1
+// TORCH-CHECK:       %split_bound_0_conv_wgrad = torch.constant.int 0
+// TORCH-CHECK:       %split_bound_1_conv_wgrad = torch.constant.int 8
+// TORCH-CHECK:       %split_bound_2_conv_wgrad = torch.constant.int 16
+// TORCH-CHECK:       %dy_part_0_conv_wgrad = torch.aten.slice.Tensor %arg0_dy_perm, %split_dim_conv_wgrad, %split_bound_0_conv_wgrad, %split_bound_1_conv_wgrad, %split_step_conv_wgrad : !torch.vtensor<[16,8,8,8],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[8,8,8,8],f32>
+// TORCH-CHECK:       %x_part_0_conv_wgrad = torch.aten.slice.Tensor %arg1_x_perm, %split_dim_conv_wgrad, %split_bound_0_conv_wgrad, %split_bound_1_conv_wgrad, %split_step_conv_wgrad : !torch.vtensor<[16,4,8,8],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[8,4,8,8],f32>
+// TORCH-CHECK:       %grad_input_0_conv_wgrad, %dw_part_0_conv_wgrad, %grad_bias_0_conv_wgrad = torch.aten.convolution_backward %dy_part_0_conv_wgrad, %x_part_0_conv_wgrad, %empty_w_conv_wgrad, %bias_conv_wgrad, %stride_conv_wgrad, %padding_conv_wgrad, %dilation_conv_wgrad, %transposed_conv_wgrad, %output_padding_conv_wgrad, %groups_conv_wgrad, %output_mask_conv_wgrad : !torch.vtensor<[8,8,8,8],f32>, !torch.vtensor<[8,4,8,8],f32>, !torch.vtensor<[8,4,1,1],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int, !torch.list<bool> -> !torch.none, !torch.vtensor<[8,4,1,1],f32>, !torch.none
+// TORCH-CHECK:       %dy_part_1_conv_wgrad = torch.aten.slice.Tensor %arg0_dy_perm, %split_dim_conv_wgrad, %split_bound_1_conv_wgrad, %split_bound_2_conv_wgrad, %split_step_conv_wgrad : !torch.vtensor<[16,8,8,8],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[8,8,8,8],f32>
+// TORCH-CHECK:       %x_part_1_conv_wgrad = torch.aten.slice.Tensor %arg1_x_perm, %split_dim_conv_wgrad, %split_bound_1_conv_wgrad, %split_bound_2_conv_wgrad, %split_step_conv_wgrad : !torch.vtensor<[16,4,8,8],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[8,4,8,8],f32>
+// TORCH-CHECK:       %grad_input_1_conv_wgrad, %dw_part_1_conv_wgrad, %grad_bias_1_conv_wgrad = torch.aten.convolution_backward %dy_part_1_conv_wgrad, %x_part_1_conv_wgrad, %empty_w_conv_wgrad, {{.+}} -> !torch.none, !torch.vtensor<[8,4,1,1],f32>, !torch.none
+// TORCH-CHECK:       %result_perm = torch.aten.add.Tensor %dw_part_0_conv_wgrad, %dw_part_1_conv_wgrad, %alpha_conv_wgrad : !torch.vtensor<[8,4,1,1],f32>, !torch.vtensor<[8,4,1,1],f32>, !torch.int -> !torch.vtensor<[8,4,1,1],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_DW_conv_wgrad : !torch.vtensor<[8,4,1,1],f32>, !torch.list<int> -> !torch.vtensor<[8,4,1,1],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[8,4,1,1],f32>, !torch.tensor<[8,4,1,1],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// LINALG-CHECK:    util.func public @main$async(
+// LINALG-CHECK-COUNT-2: linalg.conv_2d_nchw_fchw {{.+}} -> tensor<4x8x1x1xf32>
+// LINALG-CHECK:      hal.tensor.alias
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject
+testConvWgradAsmEmitterSplitReduction(const std::string &mode) {
+  int64_t n = 16, c = 4, h = 8, w = 8, k = 8, r = 1, s = 1;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_wgrad_asm_emitter_split_reduction");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto dyT = graph->tensor(TensorAttr()
+                               .setName("arg0_dy")
+                               .setDim({n, k, h, w})
+                               .setStride({k * h * w, 1, k * w, k})); // NHWC
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg1_x")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+  auto convWGradAttr = ConvWGradAttr()
+                           .setPadding({0, 0})
+                           .setStride({1, 1})
+                           .setDilation({1, 1})
+                           .setSplitReductionFactor(2)
+                           .setName("conv_wgrad");
+
+  auto dwT = graph->convWGrad(dyT, xT, convWGradAttr);
+
+  dwT->setName("result").setOutput(true).setDim({k, c, r, s});
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testConvWgradAsmEmitterSplitReduction(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,120 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input -o /dev/null
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%inv_variance_: !torch.tensor<[4,1,1],f32>, %mean_: !torch.tensor<[4,1,1],f32>, %result_: !torch.tensor<[4,16,64],f32>, %bias: !torch.vtensor<[1,16,64],f32>, %scale: !torch.vtensor<[1,16,64],f32>, %x: !torch.vtensor<[4,16,64],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %permute_X_val_0_layernorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_X_val_1_layernorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_X_val_2_layernorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_X_layernorm = torch.prim.ListConstruct %permute_X_val_0_layernorm, %permute_X_val_1_layernorm, %permute_X_val_2_layernorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %x_X_layernorm_perm = torch.aten.permute %x, %permute_X_layernorm : !torch.vtensor<[4,16,64],f32>, !torch.list<int> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %permute_SCALE_val_0_layernorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_SCALE_val_1_layernorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_SCALE_val_2_layernorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_SCALE_layernorm = torch.prim.ListConstruct %permute_SCALE_val_0_layernorm, %permute_SCALE_val_1_layernorm, %permute_SCALE_val_2_layernorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %scale_SCALE_layernorm_perm = torch.aten.permute %scale, %permute_SCALE_layernorm : !torch.vtensor<[1,16,64],f32>, !torch.list<int> -> !torch.vtensor<[1,16,64],f32>
+// TORCH-CHECK:       %permute_BIAS_val_0_layernorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_BIAS_val_1_layernorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_BIAS_val_2_layernorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_BIAS_layernorm = torch.prim.ListConstruct %permute_BIAS_val_0_layernorm, %permute_BIAS_val_1_layernorm, %permute_BIAS_val_2_layernorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %bias_BIAS_layernorm_perm = torch.aten.permute %bias, %permute_BIAS_layernorm : !torch.vtensor<[1,16,64],f32>, !torch.list<int> -> !torch.vtensor<[1,16,64],f32>
+// TORCH-CHECK:       %reduction_dims_val_0_layernorm = torch.constant.int 1
+// TORCH-CHECK:       %reduction_dims_val_1_layernorm = torch.constant.int 2
+// TORCH-CHECK:       %reduction_dims_layernorm = torch.prim.ListConstruct %reduction_dims_val_0_layernorm, %reduction_dims_val_1_layernorm : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %correction_layernorm = torch.constant.int 0
+// TORCH-CHECK:       %keepdim_layernorm = torch.constant.bool true
+// TORCH-CHECK:       %var_layernorm, %mean_layernorm = torch.aten.var_mean.correction %x_X_layernorm_perm, %reduction_dims_layernorm, %correction_layernorm, %keepdim_layernorm : !torch.vtensor<[4,16,64],f32>, !torch.list<int>, !torch.int, !torch.bool -> !torch.vtensor<[4,1,1],f32>, !torch.vtensor<[4,1,1],f32>
+// TORCH-CHECK:       %epsilon_layernorm = torch.constant.float 1.000000e-05
+// TORCH-CHECK:       %alpha_layernorm = torch.constant.int 1
+// TORCH-CHECK:       %var_eps_layernorm = torch.aten.add.Scalar %var_layernorm, %epsilon_layernorm, %alpha_layernorm : !torch.vtensor<[4,1,1],f32>, !torch.float, !torch.int -> !torch.vtensor<[4,1,1],f32>
+// TORCH-CHECK:       %inv_std_layernorm = torch.aten.rsqrt %var_eps_layernorm : !torch.vtensor<[4,1,1],f32> -> !torch.vtensor<[4,1,1],f32>
+// TORCH-CHECK:       %centered_layernorm = torch.aten.sub.Tensor %x_X_layernorm_perm, %mean_layernorm, %alpha_layernorm : !torch.vtensor<[4,16,64],f32>, !torch.vtensor<[4,1,1],f32>, !torch.int -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %normalized_layernorm = torch.aten.mul.Tensor %centered_layernorm, %inv_std_layernorm : !torch.vtensor<[4,16,64],f32>, !torch.vtensor<[4,1,1],f32> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %scaled_layernorm = torch.aten.mul.Tensor %normalized_layernorm, %scale_SCALE_layernorm_perm : !torch.vtensor<[4,16,64],f32>, !torch.vtensor<[1,16,64],f32> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %result_perm = torch.aten.add.Tensor %scaled_layernorm, %bias_BIAS_layernorm_perm, %alpha_layernorm : !torch.vtensor<[4,16,64],f32>, !torch.vtensor<[1,16,64],f32>, !torch.int -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %permute_Y_val_0_layernorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_Y_val_1_layernorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_Y_val_2_layernorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_Y_layernorm = torch.prim.ListConstruct %permute_Y_val_0_layernorm, %permute_Y_val_1_layernorm, %permute_Y_val_2_layernorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_Y_layernorm : !torch.vtensor<[4,16,64],f32>, !torch.list<int> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %permute_MEAN_val_0_layernorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_MEAN_val_1_layernorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_MEAN_val_2_layernorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_MEAN_layernorm = torch.prim.ListConstruct %permute_MEAN_val_0_layernorm, %permute_MEAN_val_1_layernorm, %permute_MEAN_val_2_layernorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %mean = torch.aten.permute %mean_layernorm, %permute_MEAN_layernorm : !torch.vtensor<[4,1,1],f32>, !torch.list<int> -> !torch.vtensor<[4,1,1],f32>
+// TORCH-CHECK:       %permute_INV_VARIANCE_val_0_layernorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_INV_VARIANCE_val_1_layernorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_INV_VARIANCE_val_2_layernorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_INV_VARIANCE_layernorm = torch.prim.ListConstruct %permute_INV_VARIANCE_val_0_layernorm, %permute_INV_VARIANCE_val_1_layernorm, %permute_INV_VARIANCE_val_2_layernorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %inv_variance = torch.aten.permute %inv_std_layernorm, %permute_INV_VARIANCE_layernorm : !torch.vtensor<[4,1,1],f32>, !torch.list<int> -> !torch.vtensor<[4,1,1],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %inv_variance overwrites %inv_variance_ : !torch.vtensor<[4,1,1],f32>, !torch.tensor<[4,1,1],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %mean overwrites %mean_ : !torch.vtensor<[4,1,1],f32>, !torch.tensor<[4,1,1],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[4,16,64],f32>, !torch.tensor<[4,16,64],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testLayernormAsmEmitterTraining() {
+  int64_t n = 4, s = 16, d = 64;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("layernorm_asm_emitter_training");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({n, s, d})
+                              .setStride({s * d, d, 1}));
+  auto scaleT = graph->tensor(TensorAttr()
+                                  .setName("scale")
+                                  .setDim({1, s, d})
+                                  .setStride({s * d, d, 1}));
+  auto biasT = graph->tensor(TensorAttr()
+                                 .setName("bias")
+                                 .setDim({1, s, d})
+                                 .setStride({s * d, d, 1}));
+
+  auto layernormAttr = LayernormAttr().setName("layernorm").setForwardPhase(
+      NormFwdPhase::TRAINING);
+
+  auto [yT, meanT, invVarianceT] =
+      graph->layernorm(xT, scaleT, biasT, layernormAttr);
+
+  yT->setName("result").setOutput(true);
+  meanT->setName("mean").setOutput(true);
+  invVarianceT->setName("inv_variance").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testLayernormAsmEmitterTraining();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,120 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} stats | FileCheck %s --check-prefix=%{BACKEND}-STATS-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[32,128],bf16>, %lhs: !torch.vtensor<[32,64],f8E4M3FNUZ>, %lhs_scale: !torch.vtensor<[1],f32>, %rhs_scale: !torch.vtensor<[1],f32>, %rhs_transposed: !torch.vtensor<[128,64],f8E4M3FNUZ>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %permute_A_val_0_matmul = torch.constant.int 0
+// TORCH-CHECK:       %permute_A_val_1_matmul = torch.constant.int 1
+// TORCH-CHECK:       %permute_A_matmul = torch.prim.ListConstruct %permute_A_val_0_matmul, %permute_A_val_1_matmul : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %lhs_A_matmul_perm = torch.aten.permute %lhs, %permute_A_matmul : !torch.vtensor<[32,64],f8E4M3FNUZ>, !torch.list<int> -> !torch.vtensor<[32,64],f8E4M3FNUZ>
+// TORCH-CHECK:       %permute_B_val_0_matmul = torch.constant.int 1
+// TORCH-CHECK:       %permute_B_val_1_matmul = torch.constant.int 0
+// TORCH-CHECK:       %permute_B_matmul = torch.prim.ListConstruct %permute_B_val_0_matmul, %permute_B_val_1_matmul : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %rhs_transposed_B_matmul_perm = torch.aten.permute %rhs_transposed, %permute_B_matmul : !torch.vtensor<[128,64],f8E4M3FNUZ>, !torch.list<int> -> !torch.vtensor<[64,128],f8E4M3FNUZ>
+// TORCH-CHECK:       %result_unscaled_perm = torch.aten.matmul %lhs_A_matmul_perm, %rhs_transposed_B_matmul_perm : !torch.vtensor<[32,64],f8E4M3FNUZ>, !torch.vtensor<[64,128],f8E4M3FNUZ> -> !torch.vtensor<[32,128],f32>
+// TORCH-CHECK:       %scaled_0_matmul = torch.aten.mul.Tensor %result_unscaled_perm, %lhs_scale : !torch.vtensor<[32,128],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[32,128],f32>
+// TORCH-CHECK:       %scaled_1_matmul = torch.aten.mul.Tensor %scaled_0_matmul, %rhs_scale : !torch.vtensor<[32,128],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[32,128],f32>
+// TORCH-CHECK:       %dtype_scaled_matmul = torch.constant.int 15
+// TORCH-CHECK:       %false_scaled_matmul = torch.constant.bool false
+// TORCH-CHECK:       %none_scaled_matmul = torch.constant.none
+// TORCH-CHECK:       %result_perm = torch.aten.to.dtype %scaled_1_matmul, %dtype_scaled_matmul, %false_scaled_matmul, %false_scaled_matmul, %none_scaled_matmul : !torch.vtensor<[32,128],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[32,128],bf16>
+// TORCH-CHECK:       %permute_C_val_0_matmul = torch.constant.int 0
+// TORCH-CHECK:       %permute_C_val_1_matmul = torch.constant.int 1
+// TORCH-CHECK:       %permute_C_matmul = torch.prim.ListConstruct %permute_C_val_0_matmul, %permute_C_val_1_matmul : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_C_matmul : !torch.vtensor<[32,128],bf16>, !torch.list<int> -> !torch.vtensor<[32,128],bf16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[32,128],bf16>, !torch.tensor<[32,128],bf16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// AMDGPU-STATS-CHECK: "dispatch-count": 1
+// CPU-STATS-CHECK: "dispatch-count": 1
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterFp8Scaled(const std::string &mode) {
+  int64_t m = 32, k = 64, n = 128;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_fp8_scaled");
+  graph->setIODataType(DataType::BFloat16).setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(TensorAttr()
+                              .setName("lhs")
+                              .setDim({m, k})
+                              .setStride({k, 1}) // Contiguous
+                              .setDataType(DataType::FP8E4M3FNUZ));
+
+  auto bT = graph->tensor(TensorAttr()
+                              .setName("rhs_transposed")
+                              .setDim({k, n})
+                              .setStride({1, k}) // Transposed
+                              .setDataType(DataType::FP8E4M3FNUZ));
+
+  // Per-tensor scales.
+  auto aScaleT = graph->tensor(TensorAttr()
+                                   .setName("lhs_scale")
+                                   .setDim({1})
+                                   .setStride({1})
+                                   .setDataType(DataType::Float));
+  auto bScaleT = graph->tensor(TensorAttr()
+                                   .setName("rhs_scale")
+                                   .setDim({1})
+                                   .setStride({1})
+                                   .setDataType(DataType::Float));
+
+  auto matmulAttr =
+      MatmulAttr().setA_SCALE(aScaleT).setB_SCALE(bScaleT).setName("matmul");
+
+  auto cT = graph->matmul(aT, bT, matmulAttr);
+
+  cT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+  }
+
+  if (mode == "stats") {
+#ifdef FUSILLI_ENABLE_AMDGPU
+    Handle handle = FUSILLI_TRY(Handle::create(Backend::AMDGPU));
+#else
+    Handle handle = FUSILLI_TRY(Handle::create(Backend::CPU));
+#endif
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/true));
+    std::cout << FUSILLI_TRY(graph->readCompilationCacheFile(
+                     CachedAssetsType::Statistics))
+              << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testMatmulAsmEmitterFp8Scaled(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -10,7 +10,7 @@
 
 // clang-format off
 //
-// TORCH-CHECK:   module @module {
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
 // TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[2,3,224,224],f32>, %arg0_input: !torch.vtensor<[2,3,224,224],f32>, %arg1_div: !torch.vtensor<[1,3,1,1],f32>) attributes {torch.assume_strict_symbolic_shapes} {
 // TORCH-CHECK:       %permute_IN_0_val_0_pointwise_div = torch.constant.int 0
 // TORCH-CHECK:       %permute_IN_0_val_1_pointwise_div = torch.constant.int 1
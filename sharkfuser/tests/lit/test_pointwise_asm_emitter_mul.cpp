@@ -10,7 +10,7 @@
 
 // clang-format off
 //
-// TORCH-CHECK:   module @module {
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
 // TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[2,3,128,128],f32>, %arg0_input: !torch.vtensor<[2,3,128,128],f32>, %arg1_mul: !torch.vtensor<[128],f32>) attributes {torch.assume_strict_symbolic_shapes} {
 // TORCH-CHECK:       %permute_IN_0_val_0_pointwise_mul = torch.constant.int 0
 // TORCH-CHECK:       %permute_IN_0_val_1_pointwise_mul = torch.constant.int 1
@@ -0,0 +1,103 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} stats | FileCheck %s --check-prefix=%{BACKEND}-STATS-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[2,16,1,1],f32>, %x: !torch.vtensor<[2,8,8,16],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %permute_X_val_0_reduction = torch.constant.int 0
+// TORCH-CHECK:       %permute_X_val_1_reduction = torch.constant.int 3
+// TORCH-CHECK:       %permute_X_val_2_reduction = torch.constant.int 1
+// TORCH-CHECK:       %permute_X_val_3_reduction = torch.constant.int 2
+// TORCH-CHECK:       %permute_X_reduction = torch.prim.ListConstruct %permute_X_val_0_reduction, %permute_X_val_1_reduction, %permute_X_val_2_reduction, %permute_X_val_3_reduction : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %x_X_reduction_perm = torch.aten.permute %x, %permute_X_reduction : !torch.vtensor<[2,8,8,16],f32>, !torch.list<int> -> !torch.vtensor<[2,16,8,8],f32>
+// TORCH-CHECK:       %reduction_dims_val_0_reduction = torch.constant.int 2
+// TORCH-CHECK:       %reduction_dims_val_1_reduction = torch.constant.int 3
+// TORCH-CHECK:       %reduction_dims_reduction = torch.prim.ListConstruct %reduction_dims_val_0_reduction, %reduction_dims_val_1_reduction : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %keepdim_reduction = torch.constant.bool true
+// TORCH-CHECK:       %none_reduction = torch.constant.none
+// TORCH-CHECK:       %result_perm = torch.aten.mean.dim %x_X_reduction_perm, %reduction_dims_reduction, %keepdim_reduction, %none_reduction : !torch.vtensor<[2,16,8,8],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[2,16,1,1],f32>
+// TORCH-CHECK:       %permute_Y_val_0_reduction = torch.constant.int 0
+// TORCH-CHECK:       %permute_Y_val_1_reduction = torch.constant.int 1
+// TORCH-CHECK:       %permute_Y_val_2_reduction = torch.constant.int 2
+// TORCH-CHECK:       %permute_Y_val_3_reduction = torch.constant.int 3
+// TORCH-CHECK:       %permute_Y_reduction = torch.prim.ListConstruct %permute_Y_val_0_reduction, %permute_Y_val_1_reduction, %permute_Y_val_2_reduction, %permute_Y_val_3_reduction : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_Y_reduction : !torch.vtensor<[2,16,1,1],f32>, !torch.list<int> -> !torch.vtensor<[2,16,1,1],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[2,16,1,1],f32>, !torch.tensor<[2,16,1,1],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// AMDGPU-STATS-CHECK: "dispatch-count": 1
+// CPU-STATS-CHECK: "dispatch-count": 1
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+// Global average pooling: the mean over the spatial dims of an NHWC tensor.
+static ErrorObject testReductionAsmEmitterMeanNhwc(const std::string &mode) {
+  int64_t n = 2, c = 16, h = 8, w = 8;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("reduction_asm_emitter_mean_nhwc");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+  auto reductionAttr = ReductionAttr()
+                           .setName("reduction")
+                           .setMode(ReductionAttr::Mode::MEAN)
+                           .setAxes({2, 3});
+
+  auto yT = graph->reduction(xT, reductionAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+  }
+
+  if (mode == "stats") {
+#ifdef FUSILLI_ENABLE_AMDGPU
+    Handle handle = FUSILLI_TRY(Handle::create(Backend::AMDGPU));
+#else
+    Handle handle = FUSILLI_TRY(Handle::create(Backend::CPU));
+#endif
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/true));
+    std::cout << FUSILLI_TRY(graph->readCompilationCacheFile(
+                     CachedAssetsType::Statistics))
+              << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testReductionAsmEmitterMeanNhwc(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,98 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input -o /dev/null
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[4,16,64],f32>, %scale: !torch.vtensor<[1,16,64],f32>, %x: !torch.vtensor<[4,16,64],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %permute_X_val_0_rmsnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_X_val_1_rmsnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_X_val_2_rmsnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_X_rmsnorm = torch.prim.ListConstruct %permute_X_val_0_rmsnorm, %permute_X_val_1_rmsnorm, %permute_X_val_2_rmsnorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %x_X_rmsnorm_perm = torch.aten.permute %x, %permute_X_rmsnorm : !torch.vtensor<[4,16,64],f32>, !torch.list<int> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %permute_SCALE_val_0_rmsnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_SCALE_val_1_rmsnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_SCALE_val_2_rmsnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_SCALE_rmsnorm = torch.prim.ListConstruct %permute_SCALE_val_0_rmsnorm, %permute_SCALE_val_1_rmsnorm, %permute_SCALE_val_2_rmsnorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %scale_SCALE_rmsnorm_perm = torch.aten.permute %scale, %permute_SCALE_rmsnorm : !torch.vtensor<[1,16,64],f32>, !torch.list<int> -> !torch.vtensor<[1,16,64],f32>
+// TORCH-CHECK:       %reduction_dims_val_0_rmsnorm = torch.constant.int 1
+// TORCH-CHECK:       %reduction_dims_val_1_rmsnorm = torch.constant.int 2
+// TORCH-CHECK:       %reduction_dims_rmsnorm = torch.prim.ListConstruct %reduction_dims_val_0_rmsnorm, %reduction_dims_val_1_rmsnorm : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %keepdim_rmsnorm = torch.constant.bool true
+// TORCH-CHECK:       %none_rmsnorm = torch.constant.none
+// TORCH-CHECK:       %epsilon_rmsnorm = torch.constant.float 1.000000e-06
+// TORCH-CHECK:       %alpha_rmsnorm = torch.constant.int 1
+// TORCH-CHECK:       %squared_rmsnorm = torch.aten.mul.Tensor %x_X_rmsnorm_perm, %x_X_rmsnorm_perm : !torch.vtensor<[4,16,64],f32>, !torch.vtensor<[4,16,64],f32> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %mean_square_rmsnorm = torch.aten.mean.dim %squared_rmsnorm, %reduction_dims_rmsnorm, %keepdim_rmsnorm, %none_rmsnorm : !torch.vtensor<[4,16,64],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[4,1,1],f32>
+// TORCH-CHECK:       %mean_square_eps_rmsnorm = torch.aten.add.Scalar %mean_square_rmsnorm, %epsilon_rmsnorm, %alpha_rmsnorm : !torch.vtensor<[4,1,1],f32>, !torch.float, !torch.int -> !torch.vtensor<[4,1,1],f32>
+// TORCH-CHECK:       %inv_rms_rmsnorm = torch.aten.rsqrt %mean_square_eps_rmsnorm : !torch.vtensor<[4,1,1],f32> -> !torch.vtensor<[4,1,1],f32>
+// TORCH-CHECK:       %normalized_rmsnorm = torch.aten.mul.Tensor %x_X_rmsnorm_perm, %inv_rms_rmsnorm : !torch.vtensor<[4,16,64],f32>, !torch.vtensor<[4,1,1],f32> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %result_perm = torch.aten.mul.Tensor %normalized_rmsnorm, %scale_SCALE_rmsnorm_perm : !torch.vtensor<[4,16,64],f32>, !torch.vtensor<[1,16,64],f32> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       %permute_Y_val_0_rmsnorm = torch.constant.int 0
+// TORCH-CHECK:       %permute_Y_val_1_rmsnorm = torch.constant.int 1
+// TORCH-CHECK:       %permute_Y_val_2_rmsnorm = torch.constant.int 2
+// TORCH-CHECK:       %permute_Y_rmsnorm = torch.prim.ListConstruct %permute_Y_val_0_rmsnorm, %permute_Y_val_1_rmsnorm, %permute_Y_val_2_rmsnorm : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_Y_rmsnorm : !torch.vtensor<[4,16,64],f32>, !torch.list<int> -> !torch.vtensor<[4,16,64],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[4,16,64],f32>, !torch.tensor<[4,16,64],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testRmsnormAsmEmitterInference() {
+  int64_t n = 4, s = 16, d = 64;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("rmsnorm_asm_emitter_inference");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({n, s, d})
+                              .setStride({s * d, d, 1}));
+  auto scaleT = graph->tensor(TensorAttr()
+                                  .setName("scale")
+                                  .setDim({1, s, d})
+                                  .setStride({s * d, d, 1}));
+
+  auto rmsnormAttr = RmsnormAttr()
+                         .setName("rmsnorm")
+                         .setForwardPhase(NormFwdPhase::INFERENCE)
+                         .setEpsilon(1e-6f);
+
+  // The INV_RMS statistic is only output in TRAINING.
+  auto yT = graph->rmsnorm(xT, scaleT, rmsnormAttr)[0];
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testRmsnormAsmEmitterInference();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,111 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input -o - | FileCheck %s --check-prefix=LINALG-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[2,4,64,32],f16>, %k: !torch.vtensor<[2,4,128,32],f16>, %mask: !torch.vtensor<[1,1,64,128],i1>, %q: !torch.vtensor<[2,4,64,32],f16>, %v: !torch.vtensor<[2,4,128,32],f16>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %permute_Q_val_0_sdpa = torch.constant.int 0
+// TORCH-CHECK:       %permute_Q_val_1_sdpa = torch.constant.int 1
+// TORCH-CHECK:       %permute_Q_val_2_sdpa = torch.constant.int 2
+// TORCH-CHECK:       %permute_Q_val_3_sdpa = torch.constant.int 3
+// TORCH-CHECK:       %permute_Q_sdpa = torch.prim.ListConstruct %permute_Q_val_0_sdpa, %permute_Q_val_1_sdpa, %permute_Q_val_2_sdpa, %permute_Q_val_3_sdpa : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %q_Q_sdpa_perm = torch.aten.permute %q, %permute_Q_sdpa : !torch.vtensor<[2,4,64,32],f16>, !torch.list<int> -> !torch.vtensor<[2,4,64,32],f16>
+// TORCH-CHECK:       %permute_K_val_0_sdpa = torch.constant.int 0
+// TORCH-CHECK:       %permute_K_val_1_sdpa = torch.constant.int 1
+// TORCH-CHECK:       %permute_K_val_2_sdpa = torch.constant.int 2
+// TORCH-CHECK:       %permute_K_val_3_sdpa = torch.constant.int 3
+// TORCH-CHECK:       %permute_K_sdpa = torch.prim.ListConstruct %permute_K_val_0_sdpa, %permute_K_val_1_sdpa, %permute_K_val_2_sdpa, %permute_K_val_3_sdpa : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %k_K_sdpa_perm = torch.aten.permute %k, %permute_K_sdpa : !torch.vtensor<[2,4,128,32],f16>, !torch.list<int> -> !torch.vtensor<[2,4,128,32],f16>
+// TORCH-CHECK:       %permute_V_val_0_sdpa = torch.constant.int 0
+// TORCH-CHECK:       %permute_V_val_1_sdpa = torch.constant.int 1
+// TORCH-CHECK:       %permute_V_val_2_sdpa = torch.constant.int 2
+// TORCH-CHECK:       %permute_V_val_3_sdpa = torch.constant.int 3
+// TORCH-CHECK:       %permute_V_sdpa = torch.prim.ListConstruct %permute_V_val_0_sdpa, %permute_V_val_1_sdpa, %permute_V_val_2_sdpa, %permute_V_val_3_sdpa : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %v_V_sdpa_perm = torch.aten.permute %v, %permute_V_sdpa : !torch.vtensor<[2,4,128,32],f16>, !torch.list<int> -> !torch.vtensor<[2,4,128,32],f16>
+// TORCH-CHECK:       %permute_MASK_val_0_sdpa = torch.constant.int 0
+// TORCH-CHECK:       %permute_MASK_val_1_sdpa = torch.constant.int 1
+// TORCH-CHECK:       %permute_MASK_val_2_sdpa = torch.constant.int 2
+// TORCH-CHECK:       %permute_MASK_val_3_sdpa = torch.constant.int 3
+// TORCH-CHECK:       %permute_MASK_sdpa = torch.prim.ListConstruct %permute_MASK_val_0_sdpa, %permute_MASK_val_1_sdpa, %permute_MASK_val_2_sdpa, %permute_MASK_val_3_sdpa : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %mask_MASK_sdpa_perm = torch.aten.permute %mask, %permute_MASK_sdpa : !torch.vtensor<[1,1,64,128],i1>, !torch.list<int> -> !torch.vtensor<[1,1,64,128],i1>
+// TORCH-CHECK:       %dropout_p_sdpa = torch.constant.float 0.000000e+00
+// TORCH-CHECK:       %is_causal_sdpa = torch.constant.bool false
+// TORCH-CHECK:       %scale_sdpa = torch.constant.float 1.250000e-01
+// TORCH-CHECK:       %enable_gqa_sdpa = torch.constant.bool false
+// TORCH-CHECK:       %result_perm = torch.aten.scaled_dot_product_attention %q_Q_sdpa_perm, %k_K_sdpa_perm, %v_V_sdpa_perm, %mask_MASK_sdpa_perm, %dropout_p_sdpa, %is_causal_sdpa, %scale_sdpa, %enable_gqa_sdpa : !torch.vtensor<[2,4,64,32],f16>, !torch.vtensor<[2,4,128,32],f16>, !torch.vtensor<[2,4,128,32],f16>, !torch.vtensor<[1,1,64,128],i1>, !torch.float, !torch.bool, !torch.float, !torch.bool -> !torch.vtensor<[2,4,64,32],f16>
+// TORCH-CHECK:       %permute_O_val_0_sdpa = torch.constant.int 0
+// TORCH-CHECK:       %permute_O_val_1_sdpa = torch.constant.int 1
+// TORCH-CHECK:       %permute_O_val_2_sdpa = torch.constant.int 2
+// TORCH-CHECK:       %permute_O_val_3_sdpa = torch.constant.int 3
+// TORCH-CHECK:       %permute_O_sdpa = torch.prim.ListConstruct %permute_O_val_0_sdpa, %permute_O_val_1_sdpa, %permute_O_val_2_sdpa, %permute_O_val_3_sdpa : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_O_sdpa : !torch.vtensor<[2,4,64,32],f16>, !torch.list<int> -> !torch.vtensor<[2,4,64,32],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[2,4,64,32],f16>, !torch.tensor<[2,4,64,32],f16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// LINALG-CHECK: iree_linalg_ext.attention
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+// Cross-attention (of 64 queries to 128 keys) with a boolean mask broadcast
+// over the batch and heads, and an explicit scale.
+static ErrorObject testSdpaAsmEmitterMask() {
+  int64_t b = 2, h = 4, sQ = 64, sKv = 128, d = 32;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("sdpa_asm_emitter_mask");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto bhsdTensor = [&](const std::string &name, int64_t seqLen) {
+    return graph->tensor(TensorAttr()
+                             .setName(name)
+                             .setDim({b, h, seqLen, d})
+                             .setStride({h * seqLen * d, seqLen * d, d, 1}));
+  };
+  auto qT = bhsdTensor("q", sQ);
+  auto kT = bhsdTensor("k", sKv);
+  auto vT = bhsdTensor("v", sKv);
+  auto maskT = graph->tensor(TensorAttr()
+                                 .setName("mask")
+                                 .setDim({1, 1, sQ, sKv})
+                                 .setStride({sQ * sKv, sQ * sKv, sKv, 1})
+                                 .setDataType(DataType::Boolean));
+
+  auto sdpaAttr = SdpaAttr().setName("sdpa").setScale(0.125f);
+
+  auto oT = graph->sdpa(qT, kT, vT, maskT, sdpaAttr);
+
+  oT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testSdpaAsmEmitterMask();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input -o /dev/null
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module_{{[0-9a-f]+}} {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[2,4,16,32],f32>, %x: !torch.vtensor<[2,4,16,32],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %permute_X_val_0_softmax = torch.constant.int 0
+// TORCH-CHECK:       %permute_X_val_1_softmax = torch.constant.int 1
+// TORCH-CHECK:       %permute_X_val_2_softmax = torch.constant.int 2
+// TORCH-CHECK:       %permute_X_val_3_softmax = torch.constant.int 3
+// TORCH-CHECK:       %permute_X_softmax = torch.prim.ListConstruct %permute_X_val_0_softmax, %permute_X_val_1_softmax, %permute_X_val_2_softmax, %permute_X_val_3_softmax : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %x_X_softmax_perm = torch.aten.permute %x, %permute_X_softmax : !torch.vtensor<[2,4,16,32],f32>, !torch.list<int> -> !torch.vtensor<[2,4,16,32],f32>
+// TORCH-CHECK:       %axis_softmax = torch.constant.int 3
+// TORCH-CHECK:       %none_softmax = torch.constant.none
+// TORCH-CHECK:       %result_perm = torch.aten.softmax.int %x_X_softmax_perm, %axis_softmax, %none_softmax : !torch.vtensor<[2,4,16,32],f32>, !torch.int, !torch.none -> !torch.vtensor<[2,4,16,32],f32>
+// TORCH-CHECK:       %permute_Y_val_0_softmax = torch.constant.int 0
+// TORCH-CHECK:       %permute_Y_val_1_softmax = torch.constant.int 1
+// TORCH-CHECK:       %permute_Y_val_2_softmax = torch.constant.int 2
+// TORCH-CHECK:       %permute_Y_val_3_softmax = torch.constant.int 3
+// TORCH-CHECK:       %permute_Y_softmax = torch.prim.ListConstruct %permute_Y_val_0_softmax, %permute_Y_val_1_softmax, %permute_Y_val_2_softmax, %permute_Y_val_3_softmax : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_perm, %permute_Y_softmax : !torch.vtensor<[2,4,16,32],f32>, !torch.list<int> -> !torch.vtensor<[2,4,16,32],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[2,4,16,32],f32>, !torch.tensor<[2,4,16,32],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+// Softmax over the last dim of attention scores (batch, heads, queries, keys).
+static ErrorObject testSoftmaxAsmEmitter() {
+  int64_t b = 2, h = 4, q = 16, k = 32;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("softmax_asm_emitter");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({b, h, q, k})
+                              .setStride({h * q * k, q * k, k, 1}));
+
+  auto softmaxAttr = SoftmaxAttr().setName("softmax").setAxis(3);
+
+  auto yT = graph->softmax(xT, softmaxAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  std::cout << FUSILLI_TRY(graph->emitAsm()) << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testSoftmaxAsmEmitter();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -12,6 +12,7 @@
 #include <iree/runtime/api.h>
 
 #include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -110,6 +111,104 @@ TEST_CASE("Buffer import and lifetimes", "[buffer]") {
     REQUIRE(val == 1.0f);
 }
 
+TEST_CASE("Buffer write, allocation without copy and asynchronous transfers",
+          "[buffer]") {
+  // Parameterize by backend and create device-specific handles.
+  std::shared_ptr<Handle> handlePtr;
+  SECTION("cpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU)));
+  }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::AMDGPU)));
+  }
+#endif
+  Handle &handle = *handlePtr;
+
+  Buffer buf = FUSILLI_REQUIRE_UNWRAP(Buffer::allocate(
+      handle, castToSizeT({2, 3}), std::vector<float>(6, 0.0f)));
+
+  // Buffers are updated in place, and read without allocating.
+  std::vector<float> update = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  FUSILLI_REQUIRE_OK(buf.write<float>(handle, update));
+  std::vector<float> result(6, 0.0f);
+  FUSILLI_REQUIRE_OK(buf.read(handle, std::span<float>(result)));
+  REQUIRE(result == update);
+
+  // The read is ordered after the write by its fence.
+  std::vector<float> asyncUpdate(6, 7.0f);
+  std::vector<float> asyncResult(6, 0.0f);
+  IreeHalFenceUniquePtrType written =
+      FUSILLI_REQUIRE_UNWRAP(buf.writeAsync<float>(handle, asyncUpdate));
+  IreeHalFenceUniquePtrType read = FUSILLI_REQUIRE_UNWRAP(
+      buf.readAsync<float>(handle, asyncResult, written.get()));
+  iree_status_t status;
+  while (iree_status_is_deferred(status = iree_hal_fence_query(read.get())))
+    ;
+  REQUIRE(iree_status_is_ok(status));
+  REQUIRE(asyncResult == asyncUpdate);
+
+  // Buffers are allocated without host data, zeroed on request.
+  Buffer zeroed = FUSILLI_REQUIRE_UNWRAP(Buffer::allocate(
+      handle, castToSizeT({3, 5}), DataType::Half, /*zeroFill=*/true));
+  std::vector<half> zeroedResult;
+  FUSILLI_REQUIRE_OK(zeroed.read(handle, zeroedResult));
+  REQUIRE(zeroedResult == std::vector<half>(15, half(0.0f)));
+  Buffer uninitialized = FUSILLI_REQUIRE_UNWRAP(
+      Buffer::allocate(handle, castToSizeT({2, 3}), DataType::Float));
+  FUSILLI_REQUIRE_OK(uninitialized.write<float>(handle, update));
+  result.assign(6, 0.0f);
+  FUSILLI_REQUIRE_OK(uninitialized.read(handle, std::span<float>(result)));
+  REQUIRE(result == update);
+  REQUIRE(isError(
+      Buffer::allocate(handle, castToSizeT({2, 3}), DataType::NotSet)));
+  REQUIRE(isError(Buffer::allocate(handle, castToSizeT({2, 0}),
+                                   DataType::Float)));
+
+  // Host data must match the size of the buffer.
+  std::vector<float> tooLittleData(4, 1.0f);
+  ErrorObject writeStatus = buf.write<float>(handle, tooLittleData);
+  REQUIRE(isError(writeStatus));
+  REQUIRE(writeStatus.getCode() == ErrorCode::RuntimeFailure);
+  REQUIRE(writeStatus.getMessage() ==
+          "Buffer transfer failed: host data size (16 bytes) does not match "
+          "buffer size (24 bytes)");
+  REQUIRE(isError(buf.readAsync<float>(handle, tooLittleData)));
+}
+
+TEST_CASE("Buffer import of external allocations", "[buffer]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+
+  // CPU devices import host allocations, without copying.
+  alignas(64) float data[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Buffer buf = FUSILLI_REQUIRE_UNWRAP(Buffer::importDevicePtr(
+      handle, data, castToSizeT({2, 3}), DataType::Float));
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(buf.read(handle, result));
+  REQUIRE(result == std::vector<float>(data, data + 6));
+  std::vector<float> update(6, 7.0f);
+  FUSILLI_REQUIRE_OK(buf.write<float>(handle, update));
+  REQUIRE(data[0] == 7.0f);
+
+  // Imports of the same pointer, type and shape share their buffer view.
+  Buffer again = FUSILLI_REQUIRE_UNWRAP(Buffer::importDevicePtr(
+      handle, data, castToSizeT({2, 3}), DataType::Float));
+  REQUIRE(static_cast<iree_hal_buffer_view_t *>(again) ==
+          static_cast<iree_hal_buffer_view_t *>(buf));
+  Buffer reshaped = FUSILLI_REQUIRE_UNWRAP(Buffer::importDevicePtr(
+      handle, data, castToSizeT({3, 2}), DataType::Float));
+  REQUIRE(static_cast<iree_hal_buffer_view_t *>(reshaped) !=
+          static_cast<iree_hal_buffer_view_t *>(buf));
+
+  ErrorObject status = Buffer::importDevicePtr(
+      handle, nullptr, castToSizeT({2, 3}), DataType::Float);
+  REQUIRE(isError(status));
+  REQUIRE(status.getMessage() ==
+          "Buffer::importDevicePtr failed as ptr is NULL");
+}
+
 TEST_CASE("Buffer errors", "[buffer]") {
   SECTION("Import NULL buffer") {
     // Importing a NULL buffer view should fail.
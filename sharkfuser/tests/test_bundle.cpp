@@ -0,0 +1,100 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+using namespace fusilli;
+
+// Helper function to create graph for testing.
+static Graph testGraph() {
+  Graph g;
+  g.setName("bundled_graph");
+  g.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  int64_t n = 2, c = 8, h = 8, w = 8, k = 16;
+  auto xT = g.tensor(TensorAttr()
+                         .setName("image")
+                         .setDim({n, c, h, w})
+                         .setStride({c * h * w, h * w, w, 1}));
+  auto wT = g.tensor(TensorAttr()
+                         .setName("filter")
+                         .setDim({k, c, 1, 1})
+                         .setStride({c, 1, 1, 1}));
+  auto conv = ConvFPropAttr()
+                  .setPadding({0, 0})
+                  .setStride({1, 1})
+                  .setDilation({1, 1})
+                  .setName("conv_fprop");
+  auto yT = g.convFProp(xT, wT, conv);
+  yT->setOutput(true);
+  FUSILLI_REQUIRE_OK(g.validate());
+  return g;
+}
+
+TEST_CASE("CompiledBundle write and load", "[bundle]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  std::filesystem::path bundlePath =
+      std::filesystem::temp_directory_path() / "fusilli_test_bundle.bin";
+
+  {
+    CompiledBundle bundle;
+    Graph g = testGraph();
+    REQUIRE(isError(bundle.add(handle, g)));
+
+    FUSILLI_REQUIRE_OK(g.compile(handle, /*remove=*/true));
+    FUSILLI_REQUIRE_OK(bundle.add(handle, g));
+    REQUIRE(bundle.size() == 1);
+    FUSILLI_REQUIRE_OK(bundle.write(bundlePath));
+  }
+
+  // The artifacts of the compiled graph are removed with it, and installed
+  // back in the cache by loading the bundle.
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(CompiledBundle::load(bundlePath)) == 1);
+  std::filesystem::remove(bundlePath);
+
+  Graph g = testGraph();
+  std::string generatedAsm = FUSILLI_REQUIRE_UNWRAP(g.emitAsm());
+  std::optional<bool> reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(handle, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(reCompiled.has_value());
+  REQUIRE(!reCompiled.value());
+
+  // Graphs of the bundle compile from the cached artifacts.
+  Graph same = testGraph();
+  FUSILLI_REQUIRE_OK(same.compile(handle, /*remove=*/true));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(same.readCompilationCacheFile(
+              CachedAssetsType::Input)) == generatedAsm);
+}
+
+TEST_CASE("CompiledBundle load errors", "[bundle]") {
+  std::filesystem::path bundlePath =
+      std::filesystem::temp_directory_path() / "fusilli_test_bad_bundle.bin";
+
+  SECTION("missing file") {
+    ErrorOr<size_t> numGraphs = CompiledBundle::load(bundlePath);
+    REQUIRE(isError(numGraphs));
+    REQUIRE(ErrorObject(numGraphs).getCode() == ErrorCode::FileSystemFailure);
+  }
+
+  SECTION("not a bundle") {
+    std::ofstream(bundlePath) << "not a compiled bundle";
+    ErrorOr<size_t> numGraphs = CompiledBundle::load(bundlePath);
+    std::filesystem::remove(bundlePath);
+    REQUIRE(isError(numGraphs));
+    REQUIRE(ErrorObject(numGraphs).getCode() == ErrorCode::InvalidArgument);
+  }
+}
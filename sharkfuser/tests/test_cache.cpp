@@ -12,8 +12,18 @@
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace fusilli;
 
@@ -192,3 +202,196 @@ TEST_CASE("CacheFile directory sanitization", "[CacheFile]") {
   // Remote test artifacts.
   std::filesystem::remove_all(cacheFile.path.parent_path());
 }
+
+TEST_CASE("CacheFile::open remove = true", "[CacheFile]") {
+  std::filesystem::path cacheFilePath;
+  {
+    CacheFile created = FUSILLI_REQUIRE_UNWRAP(CacheFile::create(
+        /*graphName=*/"graph", /*filename=*/"test_open_file",
+        /*remove=*/false));
+    cacheFilePath = created.path;
+  }
+  REQUIRE(std::filesystem::exists(cacheFilePath));
+
+  // Opened files are kept by default.
+  {
+    CacheFile opened = FUSILLI_REQUIRE_UNWRAP(CacheFile::open(
+        /*graphName=*/"graph", /*filename=*/"test_open_file"));
+  }
+  REQUIRE(std::filesystem::exists(cacheFilePath));
+
+  // Opened files set to be removed are removed with the `CacheFile`.
+  {
+    CacheFile opened = FUSILLI_REQUIRE_UNWRAP(CacheFile::open(
+        /*graphName=*/"graph", /*filename=*/"test_open_file",
+        /*remove=*/true));
+  }
+  REQUIRE(!std::filesystem::exists(cacheFilePath));
+
+  // Remove test artifacts.
+  std::filesystem::remove_all(cacheFilePath.parent_path());
+}
+
+TEST_CASE("CacheFile::write replaces files atomically", "[CacheFile]") {
+  CacheFile cf = FUSILLI_REQUIRE_UNWRAP(CacheFile::create(
+      /*graphName=*/"graph", /*filename=*/"test_atomic_file",
+      /*remove=*/true));
+  FUSILLI_REQUIRE_OK(cf.write("first"));
+  FUSILLI_REQUIRE_OK(cf.write("second"));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(cf.read()) == "second");
+
+  // No temporary files are left behind.
+  size_t numFiles = 0;
+  for (const auto &file :
+       std::filesystem::directory_iterator(cf.path.parent_path()))
+    numFiles += file.path().filename().string().starts_with("test_atomic_file");
+  REQUIRE(numFiles == 1);
+}
+
+TEST_CASE("CacheLock excludes other lockers of the key", "[CacheFile]") {
+  std::filesystem::path path = CacheLock::getPath("test_cache_lock");
+  // Each open file description locks on its own, as in another process.
+  auto isLocked = [&] {
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    REQUIRE(fd >= 0);
+    bool locked = flock(fd, LOCK_EX | LOCK_NB) != 0;
+    close(fd);
+    return locked;
+  };
+  {
+    CacheLock lock =
+        FUSILLI_REQUIRE_UNWRAP(CacheLock::acquire("test_cache_lock"));
+    REQUIRE(std::filesystem::is_regular_file(path));
+    REQUIRE(isLocked());
+    CacheLock moved = std::move(lock);
+    REQUIRE(isLocked());
+  }
+  REQUIRE(!isLocked());
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("DirectoryRemoteCache publishes and fetches entries",
+          "[RemoteCache]") {
+  std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "fusilli_remote_cache_test";
+  std::filesystem::remove_all(root);
+  DirectoryRemoteCache remote(root);
+  std::vector<std::string> fileNames = {"test_remote_data", "test_remote_key"};
+
+  REQUIRE_FALSE(
+      FUSILLI_REQUIRE_UNWRAP(remote.fetch("remote_graph", fileNames)));
+  {
+    CacheFile data = FUSILLI_REQUIRE_UNWRAP(CacheFile::create(
+        /*graphName=*/"remote_graph", /*filename=*/"test_remote_data",
+        /*remove=*/true));
+    CacheFile key = FUSILLI_REQUIRE_UNWRAP(CacheFile::create(
+        /*graphName=*/"remote_graph", /*filename=*/"test_remote_key",
+        /*remove=*/true));
+    FUSILLI_REQUIRE_OK(data.write("data"));
+    FUSILLI_REQUIRE_OK(key.write("key"));
+    FUSILLI_REQUIRE_OK(remote.publish("remote_graph", fileNames));
+  }
+  REQUIRE(std::filesystem::exists(
+      remote.getPath("remote_graph", "test_remote_key")));
+
+  // The local files were removed: fetching brings them back.
+  REQUIRE(isError(CacheFile::open("remote_graph", "test_remote_data")));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(remote.fetch("remote_graph", fileNames)));
+  CacheFile data = FUSILLI_REQUIRE_UNWRAP(CacheFile::open(
+      "remote_graph", "test_remote_data", /*remove=*/true));
+  CacheFile key = FUSILLI_REQUIRE_UNWRAP(
+      CacheFile::open("remote_graph", "test_remote_key", /*remove=*/true));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(data.read()) == "data");
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(key.read()) == "key");
+
+  // Entries without their last file are incomplete.
+  std::filesystem::remove(remote.getPath("remote_graph", "test_remote_key"));
+  REQUIRE_FALSE(
+      FUSILLI_REQUIRE_UNWRAP(remote.fetch("remote_graph", fileNames)));
+  std::filesystem::remove_all(root);
+}
+
+// Creates an entry of `bytes` bytes in `cacheDir`, last used `age` ago.
+static void createCacheEntry(const std::filesystem::path &cacheDir,
+                             const std::string &name, size_t bytes,
+                             std::chrono::hours age) {
+  std::filesystem::path entryDir = cacheDir / name;
+  std::filesystem::create_directories(entryDir);
+  std::filesystem::path file = entryDir / "iree-compile-output.vmfb";
+  std::ofstream(file) << std::string(bytes, 'x');
+  auto lastUsed = std::filesystem::file_time_type::clock::now() - age;
+  std::filesystem::last_write_time(file, lastUsed);
+  std::filesystem::last_write_time(entryDir, lastUsed);
+}
+
+TEST_CASE("CacheManager stats and LRU eviction", "[CacheManager]") {
+  // Use a separate directory, as eviction could otherwise remove the cache
+  // entries of concurrently running tests.
+  std::filesystem::path cacheDir =
+      std::filesystem::temp_directory_path() / "fusilli_cache_manager_test";
+  std::filesystem::remove_all(cacheDir);
+
+  createCacheEntry(cacheDir, "oldest", 100, std::chrono::hours(3));
+  createCacheEntry(cacheDir, "older", 100, std::chrono::hours(2));
+  createCacheEntry(cacheDir, "newest", 100, std::chrono::hours(1));
+
+  CacheStats stats = FUSILLI_REQUIRE_UNWRAP(CacheManager::getStats(cacheDir));
+  REQUIRE(stats.directory == cacheDir);
+  REQUIRE(stats.numEntries == 3);
+  REQUIRE(stats.totalBytes == 300);
+  std::ostringstream os;
+  os << stats;
+  REQUIRE_THAT(os.str(), Catch::Matchers::ContainsSubstring("Entries: 3"));
+
+  SECTION("unlimited size") {
+    REQUIRE(FUSILLI_REQUIRE_UNWRAP(CacheManager::evict(
+                /*maxBytes=*/0, /*keep=*/{}, cacheDir)) == 0);
+    REQUIRE(std::filesystem::exists(cacheDir / "oldest"));
+  }
+
+  SECTION("least recently used entries are evicted first") {
+    REQUIRE(FUSILLI_REQUIRE_UNWRAP(CacheManager::evict(
+                /*maxBytes=*/250, /*keep=*/{}, cacheDir)) == 1);
+    REQUIRE(!std::filesystem::exists(cacheDir / "oldest"));
+    REQUIRE(std::filesystem::exists(cacheDir / "older"));
+  }
+
+  SECTION("touched entries are kept") {
+    CacheManager::touch(cacheDir / "oldest");
+    REQUIRE(FUSILLI_REQUIRE_UNWRAP(CacheManager::evict(
+                /*maxBytes=*/250, /*keep=*/{}, cacheDir)) == 1);
+    REQUIRE(std::filesystem::exists(cacheDir / "oldest"));
+    REQUIRE(!std::filesystem::exists(cacheDir / "older"));
+  }
+
+  SECTION("kept entry is not evicted") {
+    REQUIRE(FUSILLI_REQUIRE_UNWRAP(CacheManager::evict(
+                /*maxBytes=*/50, /*keep=*/cacheDir / "oldest", cacheDir)) ==
+            2);
+    REQUIRE(std::filesystem::exists(cacheDir / "oldest"));
+    REQUIRE(!std::filesystem::exists(cacheDir / "newest"));
+  }
+
+  std::filesystem::remove_all(cacheDir);
+}
+
+TEST_CASE("CacheManager size limit", "[CacheManager]") {
+  unsetenv("FUSILLI_CACHE_MAX_SIZE");
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(CacheManager::getSizeLimit()) ==
+          CacheManager::kDefaultMaxBytes);
+
+  setenv("FUSILLI_CACHE_MAX_SIZE", "1024", /*overwrite=*/1);
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(CacheManager::getSizeLimit()) == 1024);
+  setenv("FUSILLI_CACHE_MAX_SIZE", "2M", /*overwrite=*/1);
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(CacheManager::getSizeLimit()) == 2 << 20);
+  setenv("FUSILLI_CACHE_MAX_SIZE", "0", /*overwrite=*/1);
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(CacheManager::getSizeLimit()) == 0);
+
+  for (const char *invalid : {"", "M", "12Q", "1GB"}) {
+    setenv("FUSILLI_CACHE_MAX_SIZE", invalid, /*overwrite=*/1);
+    ErrorOr<uintmax_t> limit = CacheManager::getSizeLimit();
+    REQUIRE(isError(limit));
+    REQUIRE(ErrorObject(limit).getCode() == ErrorCode::InvalidArgument);
+  }
+  unsetenv("FUSILLI_CACHE_MAX_SIZE");
+}
@@ -19,6 +19,7 @@ TEST_CASE("ConvFPropAttr default constructor", "[conv_fprop_attr]") {
   REQUIRE(attr.getStride().empty());
   REQUIRE(attr.getPadding().empty());
   REQUIRE(attr.getDilation().empty());
+  REQUIRE(attr.getDirectChannelsLast() == false);
 }
 
 TEST_CASE("ConvFPropAttr setters and getters", "[conv_fprop_attr]") {
@@ -33,6 +34,9 @@ TEST_CASE("ConvFPropAttr setters and getters", "[conv_fprop_attr]") {
   REQUIRE(attr.getPadding() == padding);
   REQUIRE(attr.getDilation() == dilation);
 
+  attr.setDirectChannelsLast(true);
+  REQUIRE(attr.getDirectChannelsLast() == true);
+
   REQUIRE(attr.inputs.empty());
   REQUIRE(attr.outputs.empty());
 
@@ -70,6 +74,21 @@ TEST_CASE("ConvFPropAttr setters and getters", "[conv_fprop_attr]") {
   REQUIRE(attr.getY()->isVirtual() == false);
 }
 
+TEST_CASE("ConvFPropAttr with per-tensor scales", "[conv_fprop_attr]") {
+  ConvFPropAttr attr;
+
+  auto xScale = std::make_shared<TensorAttr>(0.5f);
+  auto wScale = std::make_shared<TensorAttr>(0.25f);
+
+  attr.setX_SCALE(xScale).setW_SCALE(wScale);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getX_SCALE() == xScale);
+  REQUIRE(attr.getW_SCALE() == wScale);
+  REQUIRE(attr.getX() == nullptr);
+  REQUIRE(attr.getW() == nullptr);
+}
+
 TEST_CASE("ConvFPropAttr setter templated overrides", "[conv_fprop_attr]") {
   ConvFPropAttr attr;
   std::vector<int64_t> strideVec = {1, 2};
@@ -94,6 +113,7 @@ TEST_CASE("ConvWGradAttr default constructor", "[conv_wgrad_attr]") {
   REQUIRE(attr.getStride().empty());
   REQUIRE(attr.getPadding().empty());
   REQUIRE(attr.getDilation().empty());
+  REQUIRE(attr.getSplitReductionFactor() == 1);
 }
 
 TEST_CASE("ConvWGradAttr setters and getters", "[conv_wgrad_attr]") {
@@ -103,10 +123,12 @@ TEST_CASE("ConvWGradAttr setters and getters", "[conv_wgrad_attr]") {
   std::vector<int64_t> dilation = {1, 1};
 
   attr.setStride(stride).setPadding(padding).setDilation(dilation);
+  attr.setSplitReductionFactor(4);
 
   REQUIRE(attr.getStride() == stride);
   REQUIRE(attr.getPadding() == padding);
   REQUIRE(attr.getDilation() == dilation);
+  REQUIRE(attr.getSplitReductionFactor() == 4);
 
   REQUIRE(attr.inputs.empty());
   REQUIRE(attr.outputs.empty());
@@ -9,6 +9,7 @@
 #include "utils.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -178,6 +179,60 @@ TEST_CASE("ConvFPropNode inferPropertiesNode (4D) when Y is under specified",
   REQUIRE(yT->getStride() == std::vector<int64_t>({k * h * w, h * w, w, 1}));
 }
 
+TEST_CASE("ConvFPropNode dynamic batch dim", "[conv_node]") {
+  Context ctx;
+  ConvFPropAttr attr;
+
+  int64_t n = 16, c = 128, h = 64, w = 64, k = 256, r = 1, s = 1;
+
+  attr.setPadding({0, 0}).setStride({1, 1}).setDilation({1, 1});
+
+  auto xT =
+      std::make_shared<TensorAttr>(TensorAttr()
+                                       .setDim({n, c, h, w})
+                                       .setStride({c * h * w, h * w, w, 1})
+                                       .setDynamicDims({0})
+                                       .setName("X_dynamic"));
+
+  auto wT =
+      std::make_shared<TensorAttr>(TensorAttr()
+                                       .setDim({k, c, r, s})
+                                       .setStride({c * r * s, r * s, s, 1})
+                                       .setName("W"));
+
+  attr.setX(xT).setW(wT).setY(std::make_shared<TensorAttr>());
+
+  ConvFPropNode node(std::move(attr), ctx);
+
+  SECTION("Y batch dim is inferred dynamic") {
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.convFPropAttr.getY()->getDynamicDims() ==
+            std::vector<size_t>{0});
+  }
+
+  SECTION("Only the batch dim may be dynamic") {
+    xT->setDynamicDims({0, 2});
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'X_dynamic' has a dynamic dim unsupported by conv (only "
+            "the batch dim of activations may be dynamic)");
+  }
+
+  SECTION("Weights may not be dynamic") {
+    wT->setDynamicDims({0});
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'W' has a dynamic dim unsupported by conv (only the "
+            "batch dim of activations may be dynamic)");
+  }
+}
+
 TEST_CASE("ConvFPropNode preValidate checks on input stride validity",
           "[conv_node]") {
   Context ctx;
@@ -540,6 +595,142 @@ TEST_CASE("ConvFPropNode group count checks", "[conv_node]") {
   }
 }
 
+TEST_CASE("ConvFPropNode direct channels-last emission eligibility",
+          "[conv_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+  ConvFPropAttr attr;
+
+  int64_t n = 16, c = 128, h = 64, w = 32, k = 256, r = 3, s = 3;
+
+  attr.setPadding({1, 1}).setStride({1, 1}).setDilation({1, 1});
+
+  auto xT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({n, c, h, w}).setStride({c * h * w, 1, c * w, c}));
+
+  SECTION("Eligible when opted in with NHWC and KRSC tensors") {
+    auto wT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({k, c, r, s}).setStride({c * r * s, 1, c * s, c}));
+    attr.setDirectChannelsLast(true).setX(xT).setW(wT).setY(
+        std::make_shared<TensorAttr>());
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.isDirectChannelsLast());
+  }
+
+  SECTION("Not eligible unless opted in") {
+    auto wT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({k, c, r, s}).setStride({c * r * s, 1, c * s, c}));
+    attr.setX(xT).setW(wT).setY(std::make_shared<TensorAttr>());
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    REQUIRE(!node.isDirectChannelsLast());
+  }
+
+  SECTION("Not eligible with a KCRS filter") {
+    auto wT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({k, c, r, s}).setStride({c * r * s, r * s, s, 1}));
+    attr.setDirectChannelsLast(true).setX(xT).setW(wT).setY(
+        std::make_shared<TensorAttr>());
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    REQUIRE(!node.isDirectChannelsLast());
+  }
+
+  SECTION("Not eligible with a 1x1 filter, whose physical dims are KCRS") {
+    auto wT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({k, c, 1, 1}).setStride({c, 1, c, c}));
+    attr.setPadding({0, 0}).setDirectChannelsLast(true).setX(xT).setW(wT).setY(
+        std::make_shared<TensorAttr>());
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    REQUIRE(!node.isDirectChannelsLast());
+  }
+}
+
+TEST_CASE("ConvFPropNode fp8 data type and scale checks", "[conv_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+  ConvFPropAttr attr;
+
+  int64_t n = 16, c = 128, h = 64, w = 32, k = 256, r = 3, s = 3;
+
+  attr.setPadding({1, 1}).setStride({1, 1}).setDilation({1, 1});
+
+  auto xT =
+      std::make_shared<TensorAttr>(TensorAttr()
+                                       .setDim({n, c, h, w})
+                                       .setStride({c * h * w, h * w, w, 1})
+                                       .setDataType(DataType::FP8E4M3FNUZ));
+  auto wT =
+      std::make_shared<TensorAttr>(TensorAttr()
+                                       .setDim({k, c, r, s})
+                                       .setStride({c * r * s, r * s, s, 1})
+                                       .setDataType(DataType::FP8E4M3FNUZ));
+  auto scaleT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({1}).setStride({1}).setDataType(DataType::Float));
+
+  SECTION("Scaled fp8 inputs with an f16 output") {
+    attr.setX(xT).setW(wT).setX_SCALE(scaleT).setW_SCALE(scaleT).setY(
+        std::make_shared<TensorAttr>());
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.getScales().size() == 2);
+    REQUIRE(node.convFPropAttr.getY()->getDataType() == DataType::Half);
+  }
+
+  SECTION("Scale with more than one element") {
+    attr.setX(xT).setW(wT).setY(std::make_shared<TensorAttr>());
+    attr.setW_SCALE(std::make_shared<TensorAttr>(
+        TensorAttr().setDim({k}).setStride({1}).setDataType(DataType::Float)));
+
+    ConvFPropNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Conv scale tensor W_SCALE must have a single element");
+  }
+
+  SECTION("Different fp8 data types of X and W") {
+    wT->setDataType(DataType::FP8E5M2FNUZ);
+    attr.setX(xT).setW(wT).setY(std::make_shared<TensorAttr>());
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Conv input tensor X and weight tensor W with fp8 data types must "
+            "have the same data type");
+  }
+
+  SECTION("fp8 output") {
+    attr.setX(xT).setW(wT).setY(std::make_shared<TensorAttr>(
+        TensorAttr().setDataType(DataType::FP8E4M3FNUZ)));
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Conv output tensor Y with an fp8 data type is unsupported");
+  }
+}
+
 TEST_CASE("ConvWGradNode preValidateNode detects missing attributes",
           "[conv_wgrad_node]") {
   Context ctx;
@@ -965,6 +1156,70 @@ TEST_CASE("ConvWGradNode group count checks", "[conv_wgrad_node]") {
   }
 }
 
+TEST_CASE("ConvWGradNode split reduction checks", "[conv_wgrad_node]") {
+  Context ctx;
+  ConvWGradAttr attr;
+
+  int64_t n = 8, c = 4, h = 16, w = 16, k = 8, r = 1, s = 1;
+  attr.setPadding({0, 0}).setStride({1, 1}).setDilation({1, 1});
+
+  auto dyT =
+      std::make_shared<TensorAttr>(TensorAttr()
+                                       .setDim({n, k, h, w})
+                                       .setStride({k * h * w, 1, k * w, k})
+                                       .setName("DY"));
+  auto xT =
+      std::make_shared<TensorAttr>(TensorAttr()
+                                       .setDim({n, c, h, w})
+                                       .setStride({c * h * w, 1, c * w, c})
+                                       .setName("X"));
+  auto dwT =
+      std::make_shared<TensorAttr>(TensorAttr()
+                                       .setDim({k, c, r, s})
+                                       .setStride({c * r * s, r * s, s, 1})
+                                       .setName("DW"));
+  attr.setDY(dyT).setX(xT).setDW(dwT);
+
+  SECTION("Factor dividing the batch size") {
+    attr.setSplitReductionFactor(4);
+    ConvWGradNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+
+  SECTION("Factor less than 1") {
+    attr.setSplitReductionFactor(0);
+    ConvWGradNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "ConvWGrad split reduction factor must be at least 1");
+  }
+
+  SECTION("Factor not dividing the batch size") {
+    attr.setSplitReductionFactor(3);
+    ConvWGradNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "ConvWGrad split reduction factor must "
+                                   "divide the (static) batch size");
+  }
+
+  SECTION("Dynamic batch size") {
+    dyT->setDynamicDims({0});
+    xT->setDynamicDims({0});
+    attr.setSplitReductionFactor(2);
+    ConvWGradNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+}
+
 TEST_CASE("ConvDGradNode preValidateNode detects missing attributes",
           "[conv_dgrad_node]") {
   Context ctx;
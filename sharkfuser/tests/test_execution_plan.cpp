@@ -0,0 +1,112 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+// Helper function to create a compiled 1x1 conv graph of `c` to `k`
+// channels.
+static std::tuple<std::shared_ptr<Graph>, std::shared_ptr<TensorAttr>,
+                  std::shared_ptr<TensorAttr>, std::shared_ptr<TensorAttr>>
+testConvGraph(const Handle &handle, const std::string &name, int64_t c,
+              int64_t k) {
+  int64_t n = 2, h = 8, w = 8;
+  auto graph = std::make_shared<Graph>();
+  graph->setName(name);
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("image")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1}));
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("filter")
+                              .setDim({k, c, 1, 1})
+                              .setStride({c, 1, 1, 1}));
+  auto conv = ConvFPropAttr()
+                  .setPadding({0, 0})
+                  .setStride({1, 1})
+                  .setDilation({1, 1})
+                  .setName("conv_fprop");
+  auto yT = graph->convFProp(xT, wT, conv);
+  yT->setDim({n, k, h, w}).setStride({k * h * w, h * w, w, 1});
+  yT->setOutput(true);
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+  return {graph, xT, wT, yT};
+}
+
+TEST_CASE("ExecutionPlan executes graphs in order", "[graph]") {
+  Backend backend = Backend::CPU;
+  SECTION("cpu backend") { backend = Backend::CPU; }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") { backend = Backend::AMDGPU; }
+#endif
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(backend));
+
+  // The output of the first conv is the image of the second.
+  auto [first, x1, w1, y1] = testConvGraph(handle, "plan_first", 8, 16);
+  auto [second, x2, w2, y2] = testConvGraph(handle, "plan_second", 16, 4);
+
+  auto xBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, x1, DataType::Half, 1.0f));
+  auto w1Buf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, w1, DataType::Half, 1.0f));
+  auto yBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, y1, DataType::Half, 0.0f));
+  auto w2Buf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, w2, DataType::Half, 1.0f));
+  auto outBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, y2, DataType::Half, 0.0f));
+
+  ExecutionPlan plan;
+  REQUIRE(plan.empty());
+  FUSILLI_REQUIRE_OK(plan.add(*first, {{x1, xBuf}, {w1, w1Buf}, {y1, yBuf}}));
+  FUSILLI_REQUIRE_OK(
+      plan.add(*second, {{x2, yBuf}, {w2, w2Buf}, {y2, outBuf}}));
+  REQUIRE(plan.size() == 2);
+
+  // Plans are executed repeatedly with the bindings set up by `add`.
+  for (int i = 0; i < 3; ++i)
+    FUSILLI_REQUIRE_OK(plan.execute(handle));
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(outBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == half(128.0f));
+
+  // Variant packs are checked when added, leaving the plan unchanged.
+  ErrorObject status = plan.add(*second, {{x2, yBuf}, {y2, outBuf}});
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::VariantPackError);
+  REQUIRE(plan.size() == 2);
+
+  // Graphs must be compiled.
+  Graph uncompiled;
+  status = plan.add(uncompiled, {});
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::NotCompiled);
+
+  // Graphs compiled with a handle execute with any handle of the same backend
+  // and target.
+  Handle other = FUSILLI_REQUIRE_UNWRAP(Handle::create(backend));
+  FUSILLI_REQUIRE_OK(plan.execute(other));
+
+  plan.clear();
+  REQUIRE(plan.empty());
+  FUSILLI_REQUIRE_OK(plan.execute(handle));
+}
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <memory>
 #include <optional>
@@ -148,6 +149,267 @@ TEST_CASE("Graph asm_emitter requires validation to be run first", "[graph]") {
   FUSILLI_REQUIRE_OK(g.emitAsm());
 }
 
+TEST_CASE("Graph `getFingerprint`", "[graph]") {
+  Graph unvalidated = testGraph(/*validate=*/false);
+  REQUIRE(isError(unvalidated.getFingerprint()));
+
+  Graph g = testGraph(/*validate=*/true);
+  uint64_t fingerprint = FUSILLI_REQUIRE_UNWRAP(g.getFingerprint());
+
+  // Identical graphs have the same fingerprint, regardless of their name
+  // (which is not part of the emitted assembly).
+  Graph same = testGraph(/*validate=*/true);
+  same.setName("other_graph_name");
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(same.getFingerprint()) == fingerprint);
+
+  // Graphs emitting other assembly have other fingerprints.
+  Graph other;
+  other.setName("validated_graph");
+  other.setIODataType(DataType::Half)
+      .setComputeDataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
+  int64_t n = 16, c = 128, h = 64, w = 64, k = 256, r = 1, s = 1;
+  auto xT = other.tensor(TensorAttr()
+                             .setName("image")
+                             .setDim({n, c, h, w})
+                             .setStride({c * h * w, h * w, w, 1}));
+  auto wT = other.tensor(TensorAttr()
+                             .setName("filter")
+                             .setDim({k, c, r, s})
+                             .setStride({c * r * s, r * s, s, 1}));
+  auto conv = ConvFPropAttr()
+                  .setPadding({1, 1})
+                  .setStride({1, 1})
+                  .setDilation({1, 1})
+                  .setName("conv_fprop");
+  auto yT = other.convFProp(xT, wT, conv);
+  yT->setDim({n, k, h + 2, w + 2})
+      .setStride({k * (h + 2) * (w + 2), (h + 2) * (w + 2), w + 2, 1});
+  yT->setOutput(true);
+  FUSILLI_REQUIRE_OK(other.validate());
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(other.getFingerprint()) != fingerprint);
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(other.emitAsm()) !=
+          FUSILLI_REQUIRE_UNWRAP(g.emitAsm()));
+}
+
+TEST_CASE("Graph constant tensors are not bound", "[graph]") {
+  int64_t n = 1, c = 2, h = 4, w = 4, k = 2;
+  Graph g;
+  g.setName("constant_filter_graph").setIODataType(DataType::Float);
+  auto xT = g.tensor(TensorAttr()
+                         .setName("image")
+                         .setDim({n, c, h, w})
+                         .setStride({c * h * w, h * w, w, 1}));
+  auto wT = g.tensor(TensorAttr()
+                         .setName("filter")
+                         .setDim({k, c, 1, 1})
+                         .setStride({c, 1, 1, 1})
+                         .setConstantData(std::vector<float>(k * c, 1.0f)));
+  auto conv =
+      ConvFPropAttr().setPadding({0, 0}).setStride({1, 1}).setDilation({1, 1});
+  auto yT = g.convFProp(xT, wT, conv);
+  yT->setOutput(true);
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  auto plan = FUSILLI_REQUIRE_UNWRAP(g.getBindingPlan());
+  REQUIRE(plan == std::vector<std::shared_ptr<TensorAttr>>{yT, xT});
+  std::string generatedAsm = FUSILLI_REQUIRE_UNWRAP(g.emitAsm());
+  REQUIRE(generatedAsm.find("%filter: ") == std::string::npos);
+  REQUIRE(generatedAsm.find("%filter = torch.vtensor.literal(") !=
+          std::string::npos);
+  REQUIRE(generatedAsm.find("fusilli_constant_filter: \"0x40000000") !=
+          std::string::npos);
+}
+
+TEST_CASE("Graph `cloneWithDims`", "[graph]") {
+  Graph unvalidated = testGraph(/*validate=*/false);
+  REQUIRE(isError(unvalidated.cloneWithDims({})));
+
+  Graph g = testGraph(/*validate=*/true);
+  int64_t n = 16, c = 128, h = 64, w = 64, k = 256;
+  Graph clone =
+      FUSILLI_REQUIRE_UNWRAP(g.cloneWithDims({{"image", {4, c, 32, 32}}}));
+
+  // The clone binds its own tensors in the same order, with the output shape
+  // re-inferred.
+  auto plan = FUSILLI_REQUIRE_UNWRAP(g.getBindingPlan());
+  auto clonePlan = FUSILLI_REQUIRE_UNWRAP(clone.getBindingPlan());
+  REQUIRE(clonePlan.size() == plan.size());
+  for (size_t i = 0; i < plan.size(); ++i) {
+    REQUIRE(clonePlan[i] != plan[i]);
+    REQUIRE(clonePlan[i]->getName() == plan[i]->getName());
+  }
+  REQUIRE(clonePlan[0]->getDim() == std::vector<int64_t>({4, k, 32, 32}));
+  REQUIRE(clonePlan[0]->getStride() ==
+          std::vector<int64_t>({k * 32 * 32, 32 * 32, 32, 1}));
+  REQUIRE(plan[0]->getDim() == std::vector<int64_t>({n, k, h, w}));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(clone.getFingerprint()) !=
+          FUSILLI_REQUIRE_UNWRAP(g.getFingerprint()));
+
+  // Cloning back to the original dims gives the original graph.
+  Graph back =
+      FUSILLI_REQUIRE_UNWRAP(clone.cloneWithDims({{"image", {n, c, h, w}}}));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(back.getFingerprint()) ==
+          FUSILLI_REQUIRE_UNWRAP(g.getFingerprint()));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(back.emitAsm()) ==
+          FUSILLI_REQUIRE_UNWRAP(g.emitAsm()));
+
+  // The layout of changed tensors is kept.
+  Graph nhwc;
+  nhwc.setName("nhwc_graph").setIODataType(DataType::Half);
+  auto xT = nhwc.tensor(TensorAttr()
+                            .setName("image")
+                            .setDim({n, c, h, w})
+                            .setStride({c * h * w, 1, c * w, c}));
+  auto wT = nhwc.tensor(TensorAttr()
+                            .setName("filter")
+                            .setDim({k, c, 1, 1})
+                            .setStride({c, 1, c, c}));
+  auto conv =
+      ConvFPropAttr().setPadding({0, 0}).setStride({1, 1}).setDilation({1, 1});
+  nhwc.convFProp(xT, wT, conv)->setOutput(true);
+  FUSILLI_REQUIRE_OK(nhwc.validate());
+  Graph nhwcClone =
+      FUSILLI_REQUIRE_UNWRAP(nhwc.cloneWithDims({{"image", {2, c, 8, 8}}}));
+  auto nhwcPlan = FUSILLI_REQUIRE_UNWRAP(nhwcClone.getBindingPlan());
+  REQUIRE(nhwcPlan[0]->isChannelsLast());
+  REQUIRE(nhwcPlan[2]->getStride() ==
+          std::vector<int64_t>({c * 8 * 8, 1, c * 8, c}));
+
+  // Clones must keep ranks, name tensors of the graph, and validate.
+  ErrorObject status = g.cloneWithDims({{"image", {n, c, h}}});
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  status = g.cloneWithDims({{"no_such_tensor", {1}}});
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  REQUIRE(isError(g.cloneWithDims({{"image", {n, c / 2, h, w}}})));
+}
+
+TEST_CASE("Graph `compile` reuses artifacts of graphs with the same "
+          "fingerprint",
+          "[graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+
+  Graph g1 = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_OK(g1.compile(handle, /*remove=*/true));
+  std::string command = FUSILLI_REQUIRE_UNWRAP(
+      g1.readCompilationCacheFile(CachedAssetsType::Command));
+
+  // The warm start finds the artifacts of `g1` from the fingerprint.
+  Graph g2 = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_OK(g2.compile(handle, /*remove=*/false));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(g2.readCompilationCacheFile(
+              CachedAssetsType::Command)) == command);
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(g2.readCompilationCacheFile(
+              CachedAssetsType::Input)) ==
+          FUSILLI_REQUIRE_UNWRAP(g2.emitAsm()));
+}
+
+TEST_CASE("Graph compilation fetches artifacts from the remote cache",
+          "[graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "fusilli_remote_graph_test";
+  std::filesystem::remove_all(root);
+  RemoteCache::set(std::make_shared<DirectoryRemoteCache>(root));
+
+  Graph g = testGraph(/*validate=*/false);
+  g.setName("remote_cache_graph");
+  FUSILLI_REQUIRE_OK(g.validate());
+  std::string generatedAsm = FUSILLI_REQUIRE_UNWRAP(g.emitAsm());
+  std::optional<bool> reCompiled = std::nullopt;
+  {
+    // Compiled artifacts are published, then removed from the local cache.
+    Graph cold = testGraph(/*validate=*/false);
+    cold.setName("remote_cache_graph");
+    FUSILLI_REQUIRE_OK(cold.validate());
+    FUSILLI_REQUIRE_OK(cold.getCompiledArtifact(
+        handle, generatedAsm, /*remove=*/true, &reCompiled));
+    REQUIRE(reCompiled.value());
+  }
+
+  // The warm start fetches them rather than compiling.
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(handle, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE_FALSE(reCompiled.value());
+  RemoteCache::set(nullptr);
+  std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Graph `getCompileStats` times the phases of `compile`",
+          "[graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+
+  Graph g = testGraph(/*validate=*/false);
+  g.setName("compile_stats_graph");
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  // The cold start emits and compiles the assembly.
+  FUSILLI_REQUIRE_OK(g.compile(handle, /*remove=*/true));
+  CompileStats cold = g.getCompileStats();
+  REQUIRE_FALSE(cold.cacheHit);
+  REQUIRE(cold.emitAsmUs > 0.0);
+  REQUIRE(cold.ireeCompileUs > 0.0);
+  REQUIRE(cold.sessionUs > 0.0);
+  REQUIRE(cold.getTotalUs() >= cold.ireeCompileUs);
+
+  // The warm start finds the artifacts from the fingerprint, without
+  // emitting the assembly.
+  FUSILLI_REQUIRE_OK(g.compile(handle, /*remove=*/true));
+  CompileStats warm = g.getCompileStats();
+  REQUIRE(warm.cacheHit);
+  REQUIRE(warm.emitAsmUs == 0.0);
+  REQUIRE(warm.ireeCompileUs == 0.0);
+  REQUIRE(warm.validateCacheUs > 0.0);
+  REQUIRE(warm.sessionUs > 0.0);
+}
+
+TEST_CASE("`parseCompileStatistics` parses the aggregate statistics",
+          "[graph]") {
+  std::string json = R"({
+  "stream-aggregate": {
+    "execution": {
+      "submission-count": 2,
+      "transient-memory-size": 4096,
+      "dispatch-count": 3
+    },
+    "executables": {
+      "executable-count": 1
+    }
+  },
+  "stream-function": {
+    "dispatch-count": 7
+  }
+})";
+  CompileStatistics statistics =
+      FUSILLI_REQUIRE_UNWRAP(parseCompileStatistics(json));
+  REQUIRE(statistics.dispatchCount == 3);
+  REQUIRE(statistics.executableCount == 1);
+  REQUIRE(statistics.submissionCount == 2);
+  REQUIRE(statistics.transientMemorySize == 4096);
+  // Missing statistics default to 0.
+  REQUIRE(statistics.constantSize == 0);
+
+  ErrorObject status = parseCompileStatistics(R"({"executable-count": 1})");
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::CompileFailure);
+  REQUIRE(status.getMessage() == "Compile statistics have no dispatch count");
+}
+
+TEST_CASE("Graph `getCompileStatistics` of the compiled artifact", "[graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+
+  Graph g = testGraph(/*validate=*/true);
+  REQUIRE(isError(g.getCompileStatistics()));
+
+  FUSILLI_REQUIRE_OK(g.compile(handle, /*remove=*/true));
+  CompileStatistics statistics =
+      FUSILLI_REQUIRE_UNWRAP(g.getCompileStatistics());
+  REQUIRE(statistics.dispatchCount >= 1);
+  REQUIRE(statistics.executableCount >= 1);
+}
+
 TEST_CASE("Graph `getCompiledArtifact` cache generation and invalidation",
           "[graph]") {
   Handle cpuHandle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
@@ -203,16 +465,25 @@ TEST_CASE("Graph `getCompiledArtifact` cache generation and invalidation",
   REQUIRE(reCompiled.has_value());
   REQUIRE(!reCompiled.value());
 
-  // Cache should miss because graph name change.
+  // Cache should hit despite a graph name change, as the compiled artifacts
+  // only depend on the generated asm, backend and compiler.
   g.setName("new_graph_name");
   reCompiled = std::nullopt;
   FUSILLI_REQUIRE_OK(g.getCompiledArtifact(cpuHandle, generatedAsm + " ",
                                            /*remove=*/true, &reCompiled));
   REQUIRE(reCompiled.has_value());
-  REQUIRE(reCompiled.value());
+  REQUIRE(!reCompiled.value());
+
+  // Cache should hit when returning to previously compiled asm, as artifacts
+  // of distinct asm do not share a cache directory.
+  reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(cpuHandle, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(reCompiled.has_value());
+  REQUIRE(!reCompiled.value());
 }
 
-TEST_CASE("Graph `getCompiledArtifact` should not read cached items from "
+TEST_CASE("Graph `getCompiledArtifact` reuses cached items of "
           "other/previous Graph instances",
           "[graph]") {
   Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
@@ -238,18 +509,38 @@ TEST_CASE("Graph `getCompiledArtifact` should not read cached items from "
     REQUIRE(!reCompiled.value());
   }
 
+  // A new instance, even named differently, should reuse the cache for the
+  // same generated asm.
   Graph g = testGraph(/*validate=*/true);
+  g.setName("other_graph_name");
+  std::optional<bool> reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(handle, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(reCompiled.has_value());
+  REQUIRE(!reCompiled.value());
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(g.readCompilationCacheFile(
+              CachedAssetsType::Input)) == generatedAsm);
+}
 
-  // Check that the generated asm matches the cache.
-  CacheFile asmCache = FUSILLI_REQUIRE_UNWRAP(
-      CacheFile::open(g.getName(), IREE_COMPILE_INPUT_FILENAME));
-  REQUIRE(FUSILLI_REQUIRE_UNWRAP(asmCache.read()) == generatedAsm);
+TEST_CASE("Graph `getCompiledArtifact` does not reuse incomplete cached items",
+          "[graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  Graph g = testGraph(/*validate=*/true);
+  std::string generatedAsm = FUSILLI_REQUIRE_UNWRAP(g.emitAsm());
 
-  // Nonetheless a new instance should regenerate cache.
   std::optional<bool> reCompiled = std::nullopt;
   FUSILLI_REQUIRE_OK(g.getCompiledArtifact(handle, generatedAsm,
                                            /*remove=*/true, &reCompiled));
-  REQUIRE(reCompiled.has_value());
+  REQUIRE(reCompiled.value());
+
+  // Artifacts whose key file was not written (e.g. an interrupted
+  // compilation) should be regenerated.
+  std::filesystem::path outputPath = FUSILLI_REQUIRE_UNWRAP(
+      g.getCompiledArtifact(handle, generatedAsm, /*remove=*/true));
+  std::ofstream(outputPath.parent_path() / IREE_COMPILE_KEY_FILENAME).close();
+  reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(handle, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
   REQUIRE(reCompiled.value());
 }
 
@@ -263,13 +554,79 @@ TEST_CASE("Graph `getCompiledArtifact` invalid input IR", "[graph]") {
         g.getCompiledArtifact(handle, "invalid mlir", /*remove=*/true);
     REQUIRE(isError(err));
     REQUIRE(err.getCode() == ErrorCode::CompileFailure);
+#ifdef FUSILLI_ENABLE_COMPILER_API
+    // Compiler diagnostics are captured in the error message.
+    REQUIRE(err.getMessage().starts_with(
+        "Failed to parse IREE compiler input:\n"));
+    REQUIRE(err.getMessage().size() >
+            std::string("Failed to parse IREE compiler input:\n").size());
+#else
     REQUIRE(err.getMessage() == "iree-compile command failed");
+#endif
   }
   // Cache created with "remove", ensure it is removed after the test.
   REQUIRE(!std::filesystem::exists(
       CacheFile::getPath(graphName, "test").parent_path()));
 }
 
+#ifdef FUSILLI_ENABLE_COMPILER_API
+TEST_CASE("Graph in-process compilation flags", "[graph]") {
+  std::string flag = FUSILLI_REQUIRE_UNWRAP(
+      evaluateShellFlag("--iree-hal-target-backends=llvm-cpu"));
+  REQUIRE(flag == "--iree-hal-target-backends=llvm-cpu");
+
+  // Command substitutions are evaluated, with trailing whitespace removed.
+  flag = FUSILLI_REQUIRE_UNWRAP(
+      evaluateShellFlag("--iree-hip-target=$(echo gfx942)"));
+  REQUIRE(flag == "--iree-hip-target=gfx942");
+
+  // Shell quotes are removed.
+  flag = FUSILLI_REQUIRE_UNWRAP(
+      evaluateShellFlag("--pipeline=\"builtin.module()\""));
+  REQUIRE(flag == "--pipeline=builtin.module()");
+}
+
+TEST_CASE("Graph in-process compilation across graphs", "[graph]") {
+  // Graphs compiled with handles of a backend share a compiler session.
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  Handle otherHandle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  for (const char *name : {"in_process_a", "in_process_b"}) {
+    Graph g = testGraph(/*validate=*/true);
+    g.setName(name);
+    FUSILLI_REQUIRE_OK(g.compile(handle, /*remove=*/true));
+    Graph other = testGraph(/*validate=*/true);
+    other.setName(std::string(name) + "_other");
+    FUSILLI_REQUIRE_OK(other.compile(otherHandle, /*remove=*/true));
+  }
+}
+#endif
+
+TEST_CASE("Graph `compileAsync` and `compileGraphs`", "[graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+
+  std::vector<Graph> graphs;
+  for (int i = 0; i < 4; ++i) {
+    graphs.push_back(testGraph(/*validate=*/true));
+    graphs.back().setName("compile_async_" + std::to_string(i));
+  }
+
+  std::future<ErrorObject> result =
+      graphs[0].compileAsync(handle, /*remove=*/true);
+  FUSILLI_REQUIRE_OK(result.get());
+
+  std::vector<Graph *> batch;
+  for (Graph &g : graphs)
+    batch.push_back(&g);
+  FUSILLI_REQUIRE_OK(compileGraphs(handle, batch, /*remove=*/true));
+
+  // The first error is returned once all graphs have compiled.
+  Graph invalid = testGraph(/*validate=*/false);
+  batch.push_back(&invalid);
+  ErrorObject status = compileGraphs(handle, batch, /*remove=*/true);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::NotValidated);
+}
+
 TEST_CASE("Graph `compile` method fails without validation", "[graph]") {
   Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
 
@@ -289,40 +646,67 @@ TEST_CASE("Graph `compile` recompilations with changed handle", "[graph]") {
   // for the new handle/backend.
   Graph g = testGraph(/*validate=*/true);
 
-  // Path to compile command cache file.
-  const char *cacheDir = std::getenv("FUSILLI_CACHE_DIR");
-  if (!cacheDir)
-    cacheDir = std::getenv("HOME");
-  std::filesystem::path cmdPath = std::filesystem::path(cacheDir) / ".cache" /
-                                  "fusilli" / g.getName() /
-                                  "iree-compile-command.txt";
-
   Handle cpuHandle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
   FUSILLI_REQUIRE_OK(g.compile(cpuHandle, /*remove=*/true));
 
-  std::string cpuCmd;
-  REQUIRE(std::filesystem::exists(cmdPath));
-  std::ifstream cpuCmdFile(cmdPath);
-  REQUIRE(cpuCmdFile.is_open());
-  std::getline(cpuCmdFile, cpuCmd);
+  std::string cpuCmd = FUSILLI_REQUIRE_UNWRAP(
+      g.readCompilationCacheFile(CachedAssetsType::Command));
   REQUIRE(!cpuCmd.empty());
 
 #ifdef FUSILLI_ENABLE_AMDGPU
   Handle gpuHandle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::AMDGPU));
   FUSILLI_REQUIRE_OK(g.compile(gpuHandle, /*remove=*/true));
 
-  std::string gpuCmd;
-  REQUIRE(std::filesystem::exists(cmdPath));
-  std::ifstream gpuCmdFile(cmdPath);
-  REQUIRE(gpuCmdFile.is_open());
-  std::getline(gpuCmdFile, gpuCmd);
+  std::string gpuCmd = FUSILLI_REQUIRE_UNWRAP(
+      g.readCompilationCacheFile(CachedAssetsType::Command));
   REQUIRE(!gpuCmd.empty());
 
   // The compile commands should be different for CPU and GPU handles.
   REQUIRE(cpuCmd != gpuCmd);
+
+  // GPU graphs are compiled for the architecture of the device of the handle.
+  REQUIRE(gpuCmd.find("--iree-hip-target=gfx") != std::string::npos);
+  REQUIRE(gpuCmd.find("rocm_agent_enumerator") == std::string::npos);
 #endif
 }
 
+TEST_CASE("Graph `getSharedModule` shares modules across graphs",
+          "[graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+
+  Graph g1 = testGraph(/*validate=*/true);
+  std::string generatedAsm = FUSILLI_REQUIRE_UNWRAP(g1.emitAsm());
+  std::filesystem::path vmfbPath = FUSILLI_REQUIRE_UNWRAP(
+      g1.getCompiledArtifact(handle, generatedAsm, /*remove=*/true));
+
+  IreeVmModuleSharedPtrType module;
+  {
+    // Identical graphs load the same module while it is in use.
+    Graph g2 = testGraph(/*validate=*/true);
+    FUSILLI_REQUIRE_OK(g2.compile(handle, /*remove=*/false));
+    module = FUSILLI_REQUIRE_UNWRAP(
+        Graph::getSharedModule(handle, vmfbPath.string()));
+    REQUIRE(module != nullptr);
+    // Modules are named after the fingerprint of their graph, to be appended
+    // under distinct names to the shared session of a handle.
+    iree_string_view_t name = iree_vm_module_name(module.get());
+    REQUIRE(std::string(name.data, name.size) ==
+            std::format("module_{:016x}",
+                        FUSILLI_REQUIRE_UNWRAP(g2.getFingerprint())));
+    IreeVmModuleSharedPtrType other = FUSILLI_REQUIRE_UNWRAP(
+        Graph::getSharedModule(handle, vmfbPath.string()));
+    REQUIRE(module == other);
+  }
+  // The module outlives the graphs as long as it is referenced.
+  IreeVmModuleSharedPtrType reloaded = FUSILLI_REQUIRE_UNWRAP(
+      Graph::getSharedModule(handle, vmfbPath.string()));
+  REQUIRE(module == reloaded);
+
+  // Missing artifacts fail to load.
+  auto missing = Graph::getSharedModule(handle, "/nonexistent/module.vmfb");
+  REQUIRE(isError(missing));
+}
+
 TEST_CASE("Graph `execute`", "[graph]") {
   int64_t n = 16, c = 128, h = 64, w = 64, k = 256, r = 1, s = 1;
 
@@ -432,4 +816,78 @@ TEST_CASE("Graph `execute`", "[graph]") {
   FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
   for (auto val : result)
     REQUIRE(val == half(128.0f));
+
+  // The runtime call is reused across executions, each binding the buffers
+  // of its variant pack.
+  auto otherYBuf = std::make_shared<Buffer>(
+      FUSILLI_REQUIRE_UNWRAP(Buffer::allocate(
+          handle,
+          /*bufferShape=*/castToSizeT({n, k, h, w}),
+          /*bufferData=*/std::vector<half>(n * k * h * w, half(0.0f)))));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      otherVariantPack = {
+          {X, xBuf},
+          {W, wBuf},
+          {Y, otherYBuf},
+      };
+  for (int i = 0; i < 3; ++i)
+    FUSILLI_REQUIRE_OK(graph->execute(handle, otherVariantPack));
+  std::vector<half> otherResult;
+  FUSILLI_REQUIRE_OK(otherYBuf->read(handle, otherResult));
+  for (auto val : otherResult)
+    REQUIRE(val == half(128.0f));
+
+  // A variant pack missing a tensor fails without invoking the call, which
+  // remains usable.
+  ErrorObject status = graph->execute(handle, {{X, xBuf}, {Y, yBuf}});
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::VariantPackError);
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack));
+
+  // Buffers are bound by position to the tensors of the binding plan: the
+  // outputs then the inputs, sorted by name.
+  auto plan = FUSILLI_REQUIRE_UNWRAP(graph->getBindingPlan());
+  REQUIRE(plan == std::vector<std::shared_ptr<TensorAttr>>{Y, W, X});
+  auto positionalYBuf = std::make_shared<Buffer>(
+      FUSILLI_REQUIRE_UNWRAP(Buffer::allocate(
+          handle,
+          /*bufferShape=*/castToSizeT({n, k, h, w}),
+          /*bufferData=*/std::vector<half>(n * k * h * w, half(0.0f)))));
+  std::vector<iree_hal_buffer_view_t *> buffers = {*positionalYBuf, *wBuf,
+                                                   *xBuf};
+  FUSILLI_REQUIRE_OK(graph->execute(handle, buffers));
+  std::vector<half> positionalResult;
+  FUSILLI_REQUIRE_OK(positionalYBuf->read(handle, positionalResult));
+  for (auto val : positionalResult)
+    REQUIRE(val == half(128.0f));
+
+  // Executions ordered by fences: the second waits for the first, and the
+  // host polls for the completion of the second.
+  auto asyncYBuf = std::make_shared<Buffer>(
+      FUSILLI_REQUIRE_UNWRAP(Buffer::allocate(
+          handle,
+          /*bufferShape=*/castToSizeT({n, k, h, w}),
+          /*bufferData=*/std::vector<half>(n * k * h * w, half(0.0f)))));
+  std::vector<iree_hal_buffer_view_t *> asyncBuffers = {*asyncYBuf, *wBuf,
+                                                        *xBuf};
+  IreeHalFenceUniquePtrType first =
+      FUSILLI_REQUIRE_UNWRAP(graph->executeAsync(handle, asyncBuffers));
+  IreeHalFenceUniquePtrType second = FUSILLI_REQUIRE_UNWRAP(
+      graph->executeAsync(handle, asyncBuffers, first.get()));
+  iree_status_t fenceStatus;
+  while (iree_status_is_deferred(fenceStatus =
+                                     iree_hal_fence_query(second.get())))
+    ;
+  REQUIRE(iree_status_is_ok(fenceStatus));
+  REQUIRE(iree_status_is_ok(iree_hal_fence_query(first.get())));
+  std::vector<half> asyncResult;
+  FUSILLI_REQUIRE_OK(asyncYBuf->read(handle, asyncResult));
+  for (auto val : asyncResult)
+    REQUIRE(val == half(128.0f));
+
+  buffers.pop_back();
+  status = graph->execute(handle, buffers);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::VariantPackError);
+  REQUIRE(isError(graph->executeAsync(handle, buffers)));
 }
@@ -0,0 +1,185 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+// Number of occurrences of `op` in `asm_`.
+static size_t countOps(const std::string &asm_, const std::string &op) {
+  size_t count = 0;
+  for (size_t pos = asm_.find(op); pos != std::string::npos;
+       pos = asm_.find(op, pos + op.size()))
+    ++count;
+  return count;
+}
+
+// Graph reading the NCHW input `x` of dims (2, 4, 8, 8).
+static std::shared_ptr<TensorAttr> addInput(Graph &graph,
+                                            const std::string &name) {
+  graph.setName("graph_passes").setIODataType(DataType::Float);
+  graph.setComputeDataType(DataType::Float);
+  graph.setIntermediateDataType(DataType::Float);
+  return graph.tensor(TensorAttr()
+                          .setName(name)
+                          .setDim({2, 4, 8, 8})
+                          .setStride({256, 64, 8, 1}));
+}
+
+static std::shared_ptr<TensorAttr>
+addPointwise(Graph &graph, PointwiseAttr::Mode mode,
+             const std::shared_ptr<TensorAttr> &in0,
+             const std::shared_ptr<TensorAttr> &in1 = nullptr) {
+  auto attr = PointwiseAttr().setMode(mode);
+  return in1 ? graph.pointwise(in0, in1, attr) : graph.pointwise(in0, attr);
+}
+
+TEST_CASE("Graph `optimize` requires validation", "[graph][passes]") {
+  Graph graph;
+  auto xT = addInput(graph, "x");
+  addPointwise(graph, PointwiseAttr::Mode::RELU_FWD, xT)->setOutput(true);
+
+  ErrorObject status = graph.optimize();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::NotValidated);
+  REQUIRE(status.getMessage() ==
+          "Graph must be validated before being optimized");
+}
+
+TEST_CASE("Graph `optimize` eliminates dead nodes", "[graph][passes]") {
+  Graph graph;
+  auto xT = addInput(graph, "x");
+  // Only read by a dead node, itself dead.
+  auto deadT = addPointwise(graph, PointwiseAttr::Mode::TANH_FWD, xT);
+  addPointwise(graph, PointwiseAttr::Mode::SIGMOID_FWD, deadT);
+  addPointwise(graph, PointwiseAttr::Mode::RELU_FWD, xT)->setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  uint64_t fingerprint = FUSILLI_REQUIRE_UNWRAP(graph.getFingerprint());
+  auto bindingPlan = FUSILLI_REQUIRE_UNWRAP(graph.getBindingPlan());
+
+  FUSILLI_REQUIRE_OK(graph.optimize());
+  std::string asm_ = FUSILLI_REQUIRE_UNWRAP(graph.emitAsm());
+  REQUIRE(countOps(asm_, "torch.aten.tanh") == 0);
+  REQUIRE(countOps(asm_, "torch.aten.sigmoid") == 0);
+  REQUIRE(countOps(asm_, "torch.aten.relu") == 1);
+
+  // The assembly changed, and the bindings did not.
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(graph.getFingerprint()) != fingerprint);
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(graph.getBindingPlan()) == bindingPlan);
+}
+
+TEST_CASE("Graph `optimize` eliminates common subexpressions",
+          "[graph][passes]") {
+  Graph graph;
+  auto xT = addInput(graph, "x");
+  auto y0T = addPointwise(graph, PointwiseAttr::Mode::RELU_FWD, xT);
+  auto y1T = addPointwise(graph, PointwiseAttr::Mode::RELU_FWD, xT);
+  // Not a common subexpression: another mode.
+  auto y2T = addPointwise(graph, PointwiseAttr::Mode::TANH_FWD, xT);
+  auto sumT = addPointwise(graph, PointwiseAttr::Mode::ADD, y0T, y1T);
+  auto outT = addPointwise(graph, PointwiseAttr::Mode::MUL, sumT, y2T);
+  outT->setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+
+  FUSILLI_REQUIRE_OK(graph.optimize());
+  std::string asm_ = FUSILLI_REQUIRE_UNWRAP(graph.emitAsm());
+  REQUIRE(countOps(asm_, "torch.aten.relu") == 1);
+  REQUIRE(countOps(asm_, "torch.aten.tanh") == 1);
+  // Both inputs of the ADD are now the output of the first RELU.
+  REQUIRE(countOps(asm_, y0T->getValueNameAsm() + "_in0_") > 0);
+  REQUIRE(countOps(asm_, y0T->getValueNameAsm() + "_in1_") > 0);
+  REQUIRE(countOps(asm_, y1T->getValueNameAsm()) == 0);
+}
+
+TEST_CASE("Graph `optimize` does not eliminate graph outputs",
+          "[graph][passes]") {
+  Graph graph;
+  auto xT = addInput(graph, "x");
+  addPointwise(graph, PointwiseAttr::Mode::RELU_FWD, xT)->setOutput(true);
+  addPointwise(graph, PointwiseAttr::Mode::RELU_FWD, xT)->setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+
+  FUSILLI_REQUIRE_OK(graph.optimize());
+  std::string asm_ = FUSILLI_REQUIRE_UNWRAP(graph.emitAsm());
+  REQUIRE(countOps(asm_, "torch.aten.relu") == 2);
+}
+
+TEST_CASE("Graph `optimize` folds pointwise nodes with scalar inputs",
+          "[graph][passes]") {
+  Graph graph;
+  auto xT = addInput(graph, "x");
+  auto twoT = graph.tensor(TensorAttr(2.0f).setName("two"));
+  auto oneT = graph.tensor(TensorAttr(1.0f).setName("one"));
+  // (x * (2 - 1)) + 0 is x.
+  auto diffT = addPointwise(graph, PointwiseAttr::Mode::SUB, twoT, oneT);
+  auto mulT = addPointwise(graph, PointwiseAttr::Mode::MUL, xT, diffT);
+  auto zeroT = graph.tensor(TensorAttr(0.0f).setName("zero"));
+  auto addT = addPointwise(graph, PointwiseAttr::Mode::ADD, zeroT, mulT);
+  auto outT = addPointwise(graph, PointwiseAttr::Mode::RELU_FWD, addT);
+  outT->setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+
+  FUSILLI_REQUIRE_OK(graph.optimize());
+  std::string asm_ = FUSILLI_REQUIRE_UNWRAP(graph.emitAsm());
+  REQUIRE(countOps(asm_, "torch.aten.sub") == 0);
+  REQUIRE(countOps(asm_, "torch.aten.mul") == 0);
+  REQUIRE(countOps(asm_, "torch.aten.add") == 0);
+  // The RELU reads x.
+  REQUIRE(countOps(asm_, "%x_in0_") > 0);
+}
+
+TEST_CASE("Graph `optimize` keeps non-identity pointwise nodes",
+          "[graph][passes]") {
+  Graph graph;
+  auto xT = addInput(graph, "x");
+  auto yT = addInput(graph, "y");
+  auto oneT = graph.tensor(TensorAttr(1.0f).setName("one"));
+  // 1 - x is not x, and x + y reads no scalar.
+  auto subT = addPointwise(graph, PointwiseAttr::Mode::SUB, oneT, xT);
+  auto outT = addPointwise(graph, PointwiseAttr::Mode::ADD, subT, yT);
+  outT->setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  uint64_t fingerprint = FUSILLI_REQUIRE_UNWRAP(graph.getFingerprint());
+
+  // The graph is left unchanged.
+  FUSILLI_REQUIRE_OK(graph.optimize());
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(graph.getFingerprint()) == fingerprint);
+}
+
+TEST_CASE("Graph `optimize` cancels permutes of intermediate tensors",
+          "[graph][passes]") {
+  Graph graph;
+  graph.setName("graph_passes").setIODataType(DataType::Float);
+  graph.setComputeDataType(DataType::Float);
+  graph.setIntermediateDataType(DataType::Float);
+  // Channels-last input: the output of the RELU inherits its layout.
+  auto xT = graph.tensor(TensorAttr()
+                             .setName("x")
+                             .setDim({2, 4, 8, 8})
+                             .setStride({256, 1, 32, 4}));
+  auto reluT = addPointwise(graph, PointwiseAttr::Mode::RELU_FWD, xT);
+  auto outT = addPointwise(graph, PointwiseAttr::Mode::TANH_FWD, reluT);
+  outT->setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  REQUIRE(reluT->isChannelsLast());
+
+  FUSILLI_REQUIRE_OK(graph.optimize());
+  // The intermediate is contiguous, the input and output keep their layout.
+  REQUIRE(reluT->isContiguous());
+  REQUIRE(xT->isChannelsLast());
+  REQUIRE(outT->isChannelsLast());
+  FUSILLI_REQUIRE_OK(graph.emitAsm());
+}
@@ -0,0 +1,141 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+// Conv of the NHWC input `x` with a bias add and a relu, validated.
+static Graph buildConvBiasRelu() {
+  Graph graph;
+  graph.setName("serialized_conv_bias_relu").setIODataType(DataType::Half);
+  graph.setComputeDataType(DataType::Float);
+  graph.setIntermediateDataType(DataType::Float);
+  auto xT = graph.tensor(TensorAttr()
+                             .setName("x")
+                             .setDim({4, 16, 8, 8})
+                             .setStride({1024, 1, 128, 16}));
+  auto wT = graph.tensor(TensorAttr()
+                             .setName("w")
+                             .setDim({32, 16, 3, 3})
+                             .setStride({144, 1, 48, 16}));
+  auto bT = graph.tensor(TensorAttr()
+                             .setName("b")
+                             .setDim({1, 32, 1, 1})
+                             .setStride({32, 1, 32, 32}));
+  auto convAttr = ConvFPropAttr()
+                      .setName("conv")
+                      .setPadding({1, 1})
+                      .setStride({1, 1})
+                      .setDilation({1, 1});
+  auto convT = graph.convFProp(xT, wT, convAttr);
+  auto biasAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::ADD);
+  auto biasT = graph.pointwise(convT, bT, biasAttr);
+  auto reluAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD);
+  graph.pointwise(biasT, reluAttr)->setName("y").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  return graph;
+}
+
+TEST_CASE("Graph `deserialize` builds the serialized graph",
+          "[graph][serialization]") {
+  Graph graph = buildConvBiasRelu();
+  std::string description = FUSILLI_REQUIRE_UNWRAP(graph.serialize());
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(graph.serialize()) == description);
+
+  Graph copy = FUSILLI_REQUIRE_UNWRAP(Graph::deserialize(description));
+  FUSILLI_REQUIRE_OK(copy.validate());
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(copy.serialize()) == description);
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(copy.getFingerprint()) ==
+          FUSILLI_REQUIRE_UNWRAP(graph.getFingerprint()));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(copy.emitAsm()) ==
+          FUSILLI_REQUIRE_UNWRAP(graph.emitAsm()));
+
+  std::vector<std::string> names, copyNames;
+  for (const auto &tensor : FUSILLI_REQUIRE_UNWRAP(graph.getBindingPlan()))
+    names.push_back(tensor->getName());
+  for (const auto &tensor : FUSILLI_REQUIRE_UNWRAP(copy.getBindingPlan()))
+    copyNames.push_back(tensor->getName());
+  REQUIRE(copyNames == names);
+}
+
+TEST_CASE("Graph `serialize` keeps node attributes and tensor properties",
+          "[graph][serialization]") {
+  Graph graph;
+  graph.setName("serialized_attributes").setIODataType(DataType::Float);
+  graph.setComputeDataType(DataType::Float);
+  auto qT = graph.tensor(TensorAttr()
+                             .setName("q")
+                             .setDim({1, 2, 8, 16})
+                             .setStride({256, 128, 16, 1}));
+  auto sdpaAttr = SdpaAttr().setName("sdpa").setCausal(true).setScale(0.25f);
+  auto oT = graph.sdpa(qT, qT, qT, sdpaAttr);
+  auto clampAttr = PointwiseAttr()
+                       .setName("clamp")
+                       .setMode(PointwiseAttr::Mode::CLAMP)
+                       .setClampMin(-1.5f)
+                       .setClampMax(6.0f);
+  auto clampT = graph.pointwise(oT, clampAttr);
+  auto halfT = graph.tensor(TensorAttr(0.5f).setName("half"));
+  auto mulAttr =
+      PointwiseAttr().setName("mul").setMode(PointwiseAttr::Mode::MUL);
+  auto mulT = graph.pointwise(clampT, halfT, mulAttr);
+  auto softmaxAttr = SoftmaxAttr().setName("softmax").setAxis(3);
+  graph.softmax(mulT, softmaxAttr)->setName("y").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+
+  std::string description = FUSILLI_REQUIRE_UNWRAP(graph.serialize());
+  REQUIRE(description.find(R"("causal": true, "scale": 0.25)") !=
+          std::string::npos);
+  REQUIRE(description.find(R"("clamp_min": -1.5, "clamp_max": 6)") !=
+          std::string::npos);
+  REQUIRE(description.find(R"("scalar_value": {"float": 0.5})") !=
+          std::string::npos);
+  REQUIRE(description.find(R"("axis": 3)") != std::string::npos);
+
+  Graph copy = FUSILLI_REQUIRE_UNWRAP(Graph::deserialize(description));
+  FUSILLI_REQUIRE_OK(copy.validate());
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(copy.serialize()) == description);
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(copy.getFingerprint()) ==
+          FUSILLI_REQUIRE_UNWRAP(graph.getFingerprint()));
+}
+
+TEST_CASE("Graph `deserialize` reports invalid descriptions",
+          "[graph][serialization]") {
+  auto requireError = [](const std::string &description,
+                         const std::string &message) {
+    ErrorOr<Graph> graph = Graph::deserialize(description);
+    REQUIRE(isError(graph));
+    ErrorObject status = graph;
+    REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+    REQUIRE(status.getMessage() == message);
+  };
+
+  requireError(R"({"name": "g"})", "Graph description has no version");
+  requireError(R"({"version": 2})",
+               "Graph description version 2 is not supported (expected 1)");
+  requireError(R"({"version": 1, "nodes": [{"type": "conv"}]})",
+               "Unknown node type 'conv' in graph description");
+  requireError(R"({"version": 1, "tensors": [{}], "outputs": [1]})",
+               "Tensor 1 is not in graph description");
+  requireError(R"({"version": 1, "tensors": [{"data_type": "f16"}]})",
+               "Unknown name 'f16' in graph description");
+  requireError(R"({"version": 1, "tensors": [{}],
+                   "nodes": [{"type": "matmul", "inputs": {"X": 0}}]})",
+               "Unknown node tensor 'X' in graph description");
+  requireError(R"({"version": 1, "tensors": [{"dim": [1, 2.5]}]})",
+               "Invalid JSON number '2.5'");
+  requireError(R"({"version": 1)", "Expected '}' in JSON at offset 13");
+}
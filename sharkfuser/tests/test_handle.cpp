@@ -12,6 +12,7 @@
 #include <barrier>
 #include <catch2/catch_test_macros.hpp>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
@@ -37,6 +38,95 @@ TEST_CASE("Single Handle creation", "[handle]") {
 #endif
 }
 
+TEST_CASE("Handle workspace pool reuses released buffers", "[handle]") {
+  std::shared_ptr<Handle> handlePtr;
+  SECTION("cpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU)));
+  }
+#ifdef FUSILLI_ENABLE_AMDGPU
+  SECTION("amdgpu backend") {
+    handlePtr = std::make_shared<Handle>(
+        FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::AMDGPU)));
+  }
+#endif
+  Handle &handle = *handlePtr;
+
+  // Buffers released to the pool are reused by allocations of the same size,
+  // until trimmed.
+  for (int i = 0; i < 3; ++i) {
+    Buffer buffer = FUSILLI_REQUIRE_UNWRAP(Buffer::allocate(
+        handle, /*bufferShape=*/{16, 16},
+        /*bufferData=*/std::vector<float>(16 * 16, float(i))));
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(buffer.read(handle, result));
+    for (auto val : result)
+      REQUIRE(val == float(i));
+  }
+  FUSILLI_REQUIRE_OK(handle.trimWorkspacePool());
+}
+
+TEST_CASE("Handle workspace pool options", "[handle]") {
+  WorkspacePoolOptions capped;
+  capped.maxCachedBytes = 4096;
+  WorkspacePoolOptions disabled;
+  disabled.enabled = false;
+
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  Handle cappedHandle =
+      FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU, capped));
+  Handle disabledHandle =
+      FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU, disabled));
+  REQUIRE(cappedHandle.getWorkspacePoolOptions().maxCachedBytes == 4096);
+  REQUIRE_FALSE(disabledHandle.getWorkspacePoolOptions().enabled);
+
+  // Handles with distinct workspace pools do not share their device.
+  REQUIRE(static_cast<iree_hal_device_t *>(handle) !=
+          static_cast<iree_hal_device_t *>(cappedHandle));
+  REQUIRE(static_cast<iree_hal_device_t *>(handle) !=
+          static_cast<iree_hal_device_t *>(disabledHandle));
+
+  // Buffers larger than the cap are still allocated, then freed on release.
+  for (Handle *h : {&cappedHandle, &disabledHandle}) {
+    for (int i = 0; i < 2; ++i) {
+      Buffer buffer = FUSILLI_REQUIRE_UNWRAP(Buffer::allocate(
+          *h, /*bufferShape=*/{64, 64},
+          /*bufferData=*/std::vector<float>(64 * 64, float(i))));
+      std::vector<float> result;
+      FUSILLI_REQUIRE_OK(buffer.read(*h, result));
+      REQUIRE(result[0] == float(i));
+    }
+    FUSILLI_REQUIRE_OK(h->trimWorkspacePool());
+  }
+}
+
+TEST_CASE("Handle CPU topology options", "[handle]") {
+  CPUTopologyOptions topology;
+  topology.workerCount = 2;
+  topology.pinWorkers = false;
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  Handle topologyHandle =
+      FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU, topology));
+  REQUIRE(topologyHandle.getCPUTopologyOptions() == topology);
+  REQUIRE(static_cast<iree_hal_device_t *>(handle) !=
+          static_cast<iree_hal_device_t *>(topologyHandle));
+  Handle otherHandle =
+      FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU, topology));
+  REQUIRE(static_cast<iree_hal_device_t *>(otherHandle) ==
+          static_cast<iree_hal_device_t *>(topologyHandle));
+
+  Buffer buffer = FUSILLI_REQUIRE_UNWRAP(
+      Buffer::allocate(topologyHandle, /*bufferShape=*/{4, 4},
+                       /*bufferData=*/std::vector<float>(4 * 4, 1.0f)));
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(buffer.read(topologyHandle, result));
+  REQUIRE(result == std::vector<float>(4 * 4, 1.0f));
+
+  ErrorObject status = Handle::create(Backend::AMDGPU, topology);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+}
+
 TEST_CASE("Multiple Handle creation", "[handle]") {
   Handle handle1 = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
 #ifdef FUSILLI_ENABLE_AMDGPU
@@ -44,6 +134,19 @@ TEST_CASE("Multiple Handle creation", "[handle]") {
 #endif
 }
 
+TEST_CASE("Handles of the same device share it", "[handle]") {
+  Handle handle1 = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  Handle handle2 = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  REQUIRE(static_cast<iree_hal_device_t *>(handle1) ==
+          static_cast<iree_hal_device_t *>(handle2));
+#ifdef FUSILLI_ENABLE_AMDGPU
+  Handle handle3 = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::AMDGPU, 0));
+  Handle handle4 = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::AMDGPU, 0));
+  REQUIRE(static_cast<iree_hal_device_t *>(handle3) ==
+          static_cast<iree_hal_device_t *>(handle4));
+#endif
+}
+
 TEST_CASE("Multi-threaded Handle creation", "[handle][thread]") {
   constexpr int kNumThreads = 32;
 
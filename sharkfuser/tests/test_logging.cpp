@@ -16,10 +16,12 @@
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <ostream>
 #include <sstream>
 #include <stdlib.h>
+#include <string>
 #include <utility>
 
 using namespace fusilli;
@@ -54,6 +56,19 @@ TEST_CASE("ConditionalStreamer conditioned on isLoggingEnabled", "[logging]") {
   REQUIRE(!isLoggingEnabled());
 }
 
+TEST_CASE("Logging macros only format logged messages", "[logging]") {
+  int numFormatted = 0;
+  auto format = [&numFormatted]() {
+    ++numFormatted;
+    return "Hello World";
+  };
+
+  isLoggingEnabled() = false;
+  FUSILLI_LOG_LABEL_ENDL("INFO: " << format());
+  FUSILLI_LOG_ENDL(format());
+  REQUIRE(numFormatted == 0);
+}
+
 // This test is disabled because getStream() statically initializes
 // the stream ref picking the first snapshot of FUSILLI_LOG_FILE
 // env variable. So subsequent tests that change the env variable (in
@@ -385,3 +400,24 @@ TEST_CASE("ErrorObject -> ErrorOr error propagation", "[logging][erroror]") {
     REQUIRE(err.getMessage() == "not implemented");
   }
 }
+
+// TraceWriter reads FUSILLI_TRACE_FILE once, on first use: no other test of
+// this target records trace scopes.
+TEST_CASE("TraceScope records Chrome trace events", "[logging][tracing]") {
+  const char *traceFile = "/tmp/test_fusilli_trace.json";
+  setenv("FUSILLI_TRACE_FILE", traceFile, 1);
+  REQUIRE(TraceWriter::get().isEnabled());
+  { TraceScope scope("testScope"); }
+
+  std::ifstream input(traceFile);
+  std::string trace((std::istreambuf_iterator<char>(input)),
+                    std::istreambuf_iterator<char>());
+  REQUIRE(trace.starts_with("[\n")); // C++20
+  REQUIRE(trace.find("\"name\": \"testScope\", \"cat\": \"fusilli\", "
+                     "\"ph\": \"X\"") != std::string::npos);
+  REQUIRE(trace.ends_with("},\n")); // C++20
+
+  // Cleanup.
+  unsetenv("FUSILLI_TRACE_FILE");
+  std::remove(traceFile);
+}
@@ -104,3 +104,18 @@ TEST_CASE("MatmulAttr with batched tensors", "[matmul_attr]") {
   REQUIRE(attr.getB()->getDim() == std::vector<int64_t>{batch, k, n});
   REQUIRE(attr.getC()->getDim() == std::vector<int64_t>{batch, m, n});
 }
+
+TEST_CASE("MatmulAttr with per-tensor scales", "[matmul_attr]") {
+  MatmulAttr attr;
+
+  auto aScale = std::make_shared<TensorAttr>(0.5f);
+  auto bScale = std::make_shared<TensorAttr>(0.25f);
+
+  attr.setA_SCALE(aScale).setB_SCALE(bScale);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getA_SCALE() == aScale);
+  REQUIRE(attr.getB_SCALE() == bScale);
+  REQUIRE(attr.getA() == nullptr);
+  REQUIRE(attr.getB() == nullptr);
+}
@@ -0,0 +1,323 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("MatmulNode getName correctly propagates the attribute name",
+          "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+  attr.setName("foo_matmul");
+
+  MatmulNode node(std::move(attr), ctx);
+  REQUIRE(node.getName() == "foo_matmul");
+}
+
+TEST_CASE("MatmulNode getType returns correct type", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  MatmulNode node(std::move(attr), ctx);
+  REQUIRE(node.getType() == INode::Type::Matmul);
+}
+
+TEST_CASE("MatmulNode preValidateNode detects invalid attributes",
+          "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  SECTION("Input A missing") {
+    MatmulNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Matmul input tensor A not set");
+  }
+
+  attr.setA(std::make_shared<TensorAttr>(
+      TensorAttr().setName("a").setDim({16, 32}).setStride({32, 1})));
+
+  SECTION("Input B missing") {
+    MatmulNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Matmul input tensor B not set");
+  }
+
+  SECTION("Output C missing") {
+    attr.setB(std::make_shared<TensorAttr>(
+        TensorAttr().setName("b").setDim({32, 8}).setStride({8, 1})));
+    MatmulNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Matmul output tensor C not set");
+  }
+
+  attr.setC(std::make_shared<TensorAttr>());
+
+  SECTION("Input of rank 1") {
+    attr.setB(std::make_shared<TensorAttr>(
+        TensorAttr().setName("b").setDim({32}).setStride({1})));
+    MatmulNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul input tensors A and B must have a rank of at least 2");
+  }
+
+  SECTION("Mismatched contraction dims") {
+    attr.setB(std::make_shared<TensorAttr>(
+        TensorAttr().setName("b").setDim({16, 8}).setStride({8, 1})));
+    MatmulNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Matmul input tensors A and B have "
+                                   "different contraction (K) dimensions");
+  }
+
+  SECTION("Non-broadcastable batch dims") {
+    attr.setA(std::make_shared<TensorAttr>(TensorAttr()
+                                               .setName("a")
+                                               .setDim({2, 16, 32})
+                                               .setStride({512, 32, 1})));
+    attr.setB(std::make_shared<TensorAttr>(TensorAttr()
+                                               .setName("b")
+                                               .setDim({3, 32, 8})
+                                               .setStride({256, 8, 1})));
+    MatmulNode node(std::move(attr), ctx);
+
+    REQUIRE(isError(node.preValidateNode()));
+  }
+
+  SECTION("Dynamic contraction dim") {
+    attr.getA()->setDynamicDims({1});
+    attr.setB(std::make_shared<TensorAttr>(
+        TensorAttr().setName("b").setDim({32, 8}).setStride({8, 1})));
+    MatmulNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+  }
+
+  SECTION("Dynamic dim of B") {
+    attr.setB(std::make_shared<TensorAttr>(TensorAttr()
+                                               .setName("b")
+                                               .setDim({32, 8})
+                                               .setStride({8, 1})
+                                               .setDynamicDims({1})));
+    MatmulNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+  }
+
+  SECTION("Valid attributes") {
+    attr.setB(std::make_shared<TensorAttr>(
+        TensorAttr().setName("b").setDim({32, 8}).setStride({8, 1})));
+    MatmulNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+}
+
+TEST_CASE("MatmulNode inferPropertiesNode infers output shape and stride",
+          "[matmul_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float);
+  int64_t b = 4, m = 16, k = 32, n = 8;
+
+  MatmulAttr attr;
+  attr.setA(std::make_shared<TensorAttr>(TensorAttr()
+                                             .setName("a")
+                                             .setDim({b, m, k})
+                                             .setStride({m * k, k, 1})));
+  // Transposed B: stored as (b, n, k).
+  attr.setB(std::make_shared<TensorAttr>(TensorAttr()
+                                             .setName("b")
+                                             .setDim({b, k, n})
+                                             .setStride({k * n, 1, k})));
+  attr.setC(std::make_shared<TensorAttr>());
+
+  MatmulNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  auto cT = node.matmulAttr.getC();
+  REQUIRE(cT->getDim() == std::vector<int64_t>{b, m, n});
+  REQUIRE(cT->getStride() == std::vector<int64_t>{m * n, n, 1});
+  REQUIRE(cT->getDataType() == DataType::Float);
+  REQUIRE(!cT->isDynamic());
+}
+
+TEST_CASE("MatmulNode inferPropertiesNode broadcasts batch dims",
+          "[matmul_node]") {
+  Context ctx;
+  int64_t m = 16, k = 32, n = 8;
+
+  MatmulAttr attr;
+  attr.setA(std::make_shared<TensorAttr>(
+      TensorAttr().setName("a").setDim({2, 1, m, k}).setStride(
+          {m * k, m * k, k, 1})));
+  attr.setB(std::make_shared<TensorAttr>(TensorAttr()
+                                             .setName("b")
+                                             .setDim({3, k, n})
+                                             .setStride({k * n, n, 1})));
+  attr.setC(std::make_shared<TensorAttr>());
+
+  MatmulNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  REQUIRE(node.matmulAttr.getC()->getDim() ==
+          std::vector<int64_t>{2, 3, m, n});
+}
+
+TEST_CASE("MatmulNode inferPropertiesNode infers dynamic dims",
+          "[matmul_node]") {
+  Context ctx;
+  int64_t b = 4, m = 16, k = 32, n = 8;
+
+  MatmulAttr attr;
+  attr.setA(std::make_shared<TensorAttr>(TensorAttr()
+                                             .setName("a")
+                                             .setDim({b, m, k})
+                                             .setStride({m * k, k, 1})
+                                             .setDynamicDims({0, 1})));
+  attr.setB(std::make_shared<TensorAttr>(
+      TensorAttr().setName("b").setDim({k, n}).setStride({n, 1})));
+  attr.setC(std::make_shared<TensorAttr>());
+
+  MatmulNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  auto cT = node.matmulAttr.getC();
+  REQUIRE(cT->getDim() == std::vector<int64_t>{b, m, n});
+  REQUIRE(cT->getDynamicDims() == std::vector<size_t>{0, 1});
+}
+
+TEST_CASE("MatmulNode postValidateNode detects mismatched output dims",
+          "[matmul_node]") {
+  Context ctx;
+
+  MatmulAttr attr;
+  attr.setA(std::make_shared<TensorAttr>(
+      TensorAttr().setName("a").setDim({16, 32}).setStride({32, 1})));
+  attr.setB(std::make_shared<TensorAttr>(
+      TensorAttr().setName("b").setDim({32, 8}).setStride({8, 1})));
+  attr.setC(std::make_shared<TensorAttr>(
+      TensorAttr().setName("c").setDim({16, 16}).setStride({16, 1})));
+
+  MatmulNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+
+  auto status = node.postValidateNode();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  REQUIRE(status.getMessage() ==
+          "Matmul output tensor C dimensions do not match the expected shapes "
+          "inferred based on the input dimensions");
+}
+
+TEST_CASE("MatmulNode fp8 data type and scale checks", "[matmul_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::BFloat16).setComputeDataType(DataType::Float);
+
+  MatmulAttr attr;
+  auto aT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setName("a")
+                                             .setDim({16, 32})
+                                             .setStride({32, 1})
+                                             .setDataType(DataType::FP8E4M3FN));
+  auto bT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setName("b")
+                                             .setDim({32, 8})
+                                             .setStride({1, 32})
+                                             .setDataType(DataType::FP8E4M3FN));
+  auto scaleT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({1}).setStride({1}).setDataType(DataType::Float));
+
+  SECTION("Scaled fp8 inputs with a bf16 output") {
+    attr.setA(aT).setB(bT).setA_SCALE(scaleT).setC(
+        std::make_shared<TensorAttr>());
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.getScales().size() == 1);
+    REQUIRE(node.matmulAttr.getC()->getDataType() == DataType::BFloat16);
+  }
+
+  SECTION("Scale with more than one element") {
+    attr.setA(aT).setB(bT).setC(std::make_shared<TensorAttr>());
+    attr.setA_SCALE(std::make_shared<TensorAttr>(
+        TensorAttr().setDim({16}).setStride({1}).setDataType(DataType::Float)));
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul scale tensor A_SCALE must have a single element");
+  }
+
+  SECTION("fp8 input A with a bf16 input B") {
+    bT->setDataType(DataType::BFloat16);
+    attr.setA(aT).setB(bT).setC(std::make_shared<TensorAttr>());
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul input tensors A and B with fp8 data types must have the "
+            "same data type");
+  }
+
+  SECTION("fp8 output") {
+    attr.setA(aT).setB(bT).setC(std::make_shared<TensorAttr>(
+        TensorAttr().setDataType(DataType::FP8E4M3FN)));
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Matmul output tensor C with an fp8 data type is unsupported");
+  }
+}
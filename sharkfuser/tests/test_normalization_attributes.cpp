@@ -0,0 +1,113 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+using namespace fusilli;
+
+TEST_CASE("BatchnormAttr default constructor", "[normalization_attr]") {
+  BatchnormAttr attr;
+  REQUIRE(attr.inputs.empty());
+  REQUIRE(attr.outputs.empty());
+  REQUIRE(attr.getForwardPhase() == NormFwdPhase::NOT_SET);
+  REQUIRE(attr.getEpsilon() == 1e-5f);
+}
+
+TEST_CASE("BatchnormAttr setters and getters", "[normalization_attr]") {
+  BatchnormAttr attr;
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto scale = std::make_shared<TensorAttr>(2.0f);
+  auto bias = std::make_shared<TensorAttr>(3.0f);
+  auto mean = std::make_shared<TensorAttr>(4.0f);
+  auto var = std::make_shared<TensorAttr>(5.0f);
+  auto y = std::make_shared<TensorAttr>(6.0f);
+
+  attr.setX(x).setSCALE(scale).setBIAS(bias).setMEAN(mean).setVAR(var).setY(
+      y);
+  attr.setForwardPhase(NormFwdPhase::INFERENCE).setEpsilon(1e-3f);
+
+  REQUIRE(attr.inputs.size() == 5);
+  REQUIRE(attr.outputs.size() == 1);
+
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getSCALE() == scale);
+  REQUIRE(attr.getBIAS() == bias);
+  REQUIRE(attr.getMEAN() == mean);
+  REQUIRE(attr.getVAR() == var);
+  REQUIRE(attr.getY() == y);
+  REQUIRE(attr.getSAVED_MEAN() == nullptr);
+  REQUIRE(attr.getSAVED_INV_VARIANCE() == nullptr);
+
+  REQUIRE(attr.getForwardPhase() == NormFwdPhase::INFERENCE);
+  REQUIRE(attr.getEpsilon() == 1e-3f);
+}
+
+TEST_CASE("LayernormAttr setters and getters", "[normalization_attr]") {
+  LayernormAttr attr;
+  REQUIRE(attr.getForwardPhase() == NormFwdPhase::NOT_SET);
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto scale = std::make_shared<TensorAttr>(2.0f);
+  auto bias = std::make_shared<TensorAttr>(3.0f);
+  auto y = std::make_shared<TensorAttr>(4.0f);
+  auto mean = std::make_shared<TensorAttr>(5.0f);
+  auto invVariance = std::make_shared<TensorAttr>(6.0f);
+
+  attr.setX(x).setSCALE(scale).setBIAS(bias).setY(y).setMEAN(mean);
+  attr.setINV_VARIANCE(invVariance).setForwardPhase(NormFwdPhase::TRAINING);
+
+  REQUIRE(attr.inputs.size() == 3);
+  REQUIRE(attr.outputs.size() == 3);
+
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getSCALE() == scale);
+  REQUIRE(attr.getBIAS() == bias);
+  REQUIRE(attr.getY() == y);
+  REQUIRE(attr.getMEAN() == mean);
+  REQUIRE(attr.getINV_VARIANCE() == invVariance);
+  REQUIRE(attr.getForwardPhase() == NormFwdPhase::TRAINING);
+}
+
+TEST_CASE("RmsnormAttr setters and getters", "[normalization_attr]") {
+  RmsnormAttr attr;
+  REQUIRE(attr.getForwardPhase() == NormFwdPhase::NOT_SET);
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto scale = std::make_shared<TensorAttr>(2.0f);
+  auto y = std::make_shared<TensorAttr>(3.0f);
+  auto invRms = std::make_shared<TensorAttr>(4.0f);
+
+  attr.setX(x).setSCALE(scale).setY(y).setINV_RMS(invRms);
+  attr.setForwardPhase(NormFwdPhase::TRAINING).setEpsilon(1e-6f);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.outputs.size() == 2);
+
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getSCALE() == scale);
+  REQUIRE(attr.getY() == y);
+  REQUIRE(attr.getINV_RMS() == invRms);
+  REQUIRE(attr.getForwardPhase() == NormFwdPhase::TRAINING);
+  REQUIRE(attr.getEpsilon() == 1e-6f);
+}
+
+TEST_CASE("Normalization attributes fingerprint their epsilon and phase",
+          "[normalization_attr]") {
+  BatchnormAttr a, b;
+  a.setForwardPhase(NormFwdPhase::INFERENCE);
+  b.setForwardPhase(NormFwdPhase::INFERENCE);
+  REQUIRE(a.fingerprint(0) == b.fingerprint(0));
+
+  b.setEpsilon(1e-3f);
+  REQUIRE(a.fingerprint(0) != b.fingerprint(0));
+
+  b.setEpsilon(1e-5f).setForwardPhase(NormFwdPhase::TRAINING);
+  REQUIRE(a.fingerprint(0) != b.fingerprint(0));
+}
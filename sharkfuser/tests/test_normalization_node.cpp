@@ -0,0 +1,311 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+static std::shared_ptr<TensorAttr> makeTensor(const std::string &name,
+                                              const std::vector<int64_t> &dim) {
+  return std::make_shared<TensorAttr>(
+      TensorAttr().setName(name).setDim(dim).setStride(
+          generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+}
+
+TEST_CASE("Normalization nodes getName and getType", "[normalization_node]") {
+  Context ctx;
+
+  BatchnormAttr bnAttr;
+  bnAttr.setName("foo_bn");
+  BatchnormNode bnNode(std::move(bnAttr), ctx);
+  REQUIRE(bnNode.getName() == "foo_bn");
+  REQUIRE(bnNode.getType() == INode::Type::Batchnorm);
+
+  LayernormAttr lnAttr;
+  lnAttr.setName("foo_ln");
+  LayernormNode lnNode(std::move(lnAttr), ctx);
+  REQUIRE(lnNode.getName() == "foo_ln");
+  REQUIRE(lnNode.getType() == INode::Type::Layernorm);
+
+  RmsnormAttr rmsAttr;
+  rmsAttr.setName("foo_rms");
+  RmsnormNode rmsNode(std::move(rmsAttr), ctx);
+  REQUIRE(rmsNode.getName() == "foo_rms");
+  REQUIRE(rmsNode.getType() == INode::Type::Rmsnorm);
+}
+
+TEST_CASE("BatchnormNode preValidateNode detects invalid attributes",
+          "[normalization_node]") {
+  Context ctx;
+  int64_t n = 2, c = 8, h = 4, w = 4;
+  BatchnormAttr attr;
+
+  SECTION("Forward phase not set") {
+    BatchnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Batchnorm forward phase not set");
+  }
+
+  attr.setForwardPhase(NormFwdPhase::INFERENCE);
+
+  SECTION("Input X missing") {
+    BatchnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Batchnorm input tensor X not set");
+  }
+
+  attr.setX(makeTensor("x", {n, c, h, w})).setY(std::make_shared<TensorAttr>());
+  attr.setSCALE(makeTensor("scale", {1, c, 1, 1}));
+  attr.setBIAS(makeTensor("bias", {1, c, 1, 1}));
+
+  SECTION("Running statistics missing in INFERENCE") {
+    BatchnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Batchnorm input tensor MEAN not set");
+  }
+
+  SECTION("Scale of mismatched dims") {
+    attr.setSCALE(makeTensor("scale", {1, c, h, w}));
+    attr.setMEAN(makeTensor("mean", {1, c, 1, 1}));
+    attr.setVAR(makeTensor("var", {1, c, 1, 1}));
+    BatchnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Batchnorm input tensor SCALE dimensions do not match the "
+            "expected shape inferred from input tensor X");
+  }
+
+  SECTION("Dynamic input") {
+    attr.getX()->setDynamicDims({0});
+    BatchnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+  }
+
+  SECTION("Running statistics set in TRAINING") {
+    attr.setForwardPhase(NormFwdPhase::TRAINING);
+    attr.setMEAN(makeTensor("mean", {1, c, 1, 1}));
+    BatchnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Batchnorm input tensors MEAN and VAR are only used in INFERENCE");
+  }
+
+  SECTION("Saved statistics missing in TRAINING") {
+    attr.setForwardPhase(NormFwdPhase::TRAINING);
+    BatchnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  SECTION("Valid attributes") {
+    attr.setMEAN(makeTensor("mean", {1, c, 1, 1}));
+    attr.setVAR(makeTensor("var", {1, c, 1, 1}));
+    BatchnormNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+}
+
+TEST_CASE("BatchnormNode inferPropertiesNode in TRAINING",
+          "[normalization_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float).setIntermediateDataType(DataType::Half);
+  int64_t n = 2, c = 8, h = 4, w = 4;
+
+  // Channels-last input.
+  BatchnormAttr attr;
+  attr.setForwardPhase(NormFwdPhase::TRAINING);
+  attr.setX(std::make_shared<TensorAttr>(
+      TensorAttr().setName("x").setDim({n, c, h, w}).setStride(
+          {c * h * w, 1, c * w, c})));
+  attr.setSCALE(makeTensor("scale", {1, c, 1, 1}));
+  attr.setBIAS(makeTensor("bias", {1, c, 1, 1}));
+  attr.setY(std::make_shared<TensorAttr>());
+  attr.setSAVED_MEAN(
+      std::make_shared<TensorAttr>(TensorAttr().setIsVirtual(true)));
+  attr.setSAVED_INV_VARIANCE(std::make_shared<TensorAttr>());
+
+  BatchnormNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  auto yT = node.batchnormAttr.getY();
+  REQUIRE(yT->getDim() == std::vector<int64_t>{n, c, h, w});
+  REQUIRE(yT->getStride() == std::vector<int64_t>{c * h * w, 1, c * w, c});
+
+  // Statistics are computed in the data type of X, even when virtual.
+  for (const auto &statsT : {node.batchnormAttr.getSAVED_MEAN(),
+                             node.batchnormAttr.getSAVED_INV_VARIANCE()}) {
+    REQUIRE(statsT->getDim() == std::vector<int64_t>{1, c, 1, 1});
+    REQUIRE(statsT->getStride() == std::vector<int64_t>{c, 1, 1, 1});
+    REQUIRE(statsT->getDataType() == DataType::Float);
+  }
+}
+
+TEST_CASE("BatchnormNode postValidateNode detects mismatched data types",
+          "[normalization_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float);
+  int64_t n = 2, c = 8;
+
+  BatchnormAttr attr;
+  attr.setForwardPhase(NormFwdPhase::INFERENCE);
+  attr.setX(makeTensor("x", {n, c}));
+  attr.setSCALE(makeTensor("scale", {1, c}));
+  attr.getSCALE()->setDataType(DataType::Half);
+  attr.setBIAS(makeTensor("bias", {1, c}));
+  attr.setMEAN(makeTensor("mean", {1, c}));
+  attr.setVAR(makeTensor("var", {1, c}));
+  attr.setY(std::make_shared<TensorAttr>());
+
+  BatchnormNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+
+  auto status = node.postValidateNode();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  REQUIRE(status.getMessage() == "Batchnorm input tensor SCALE data type does "
+                                 "not match that of input tensor X");
+}
+
+TEST_CASE("LayernormNode validates and infers properties",
+          "[normalization_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float);
+  int64_t n = 4, s = 16, d = 64;
+
+  LayernormAttr attr;
+  attr.setForwardPhase(NormFwdPhase::TRAINING);
+  attr.setX(makeTensor("x", {n, s, d}));
+  attr.setY(std::make_shared<TensorAttr>());
+
+  SECTION("Scale of mismatched dims") {
+    attr.setSCALE(makeTensor("scale", {1, 1, d}));
+    attr.setBIAS(makeTensor("bias", {1, s, d}));
+    LayernormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  attr.setSCALE(makeTensor("scale", {1, s, d}));
+  attr.setBIAS(makeTensor("bias", {1, s, d}));
+
+  SECTION("Statistics missing in TRAINING") {
+    LayernormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Layernorm output tensors MEAN and INV_VARIANCE must be set in "
+            "TRAINING (only)");
+  }
+
+  SECTION("Statistics set in INFERENCE") {
+    attr.setForwardPhase(NormFwdPhase::INFERENCE);
+    attr.setMEAN(std::make_shared<TensorAttr>());
+    LayernormNode node(std::move(attr), ctx);
+
+    REQUIRE(isError(node.preValidateNode()));
+  }
+
+  SECTION("Valid attributes in TRAINING") {
+    attr.setMEAN(std::make_shared<TensorAttr>());
+    attr.setINV_VARIANCE(std::make_shared<TensorAttr>());
+    LayernormNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.layernormAttr.getY()->getDim() ==
+            std::vector<int64_t>{n, s, d});
+    REQUIRE(node.layernormAttr.getMEAN()->getDim() ==
+            std::vector<int64_t>{n, 1, 1});
+    REQUIRE(node.layernormAttr.getINV_VARIANCE()->getStride() ==
+            std::vector<int64_t>{1, 1, 1});
+  }
+}
+
+TEST_CASE("RmsnormNode validates and infers properties",
+          "[normalization_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float);
+  int64_t n = 4, d = 64;
+
+  RmsnormAttr attr;
+  attr.setX(makeTensor("x", {n, d}));
+  attr.setSCALE(makeTensor("scale", {1, d}));
+  attr.setY(std::make_shared<TensorAttr>());
+
+  SECTION("Forward phase not set") {
+    RmsnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "RMSNorm forward phase not set");
+  }
+
+  SECTION("Statistic set in INFERENCE") {
+    attr.setForwardPhase(NormFwdPhase::INFERENCE);
+    attr.setINV_RMS(std::make_shared<TensorAttr>());
+    RmsnormNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "RMSNorm output tensor INV_RMS must be set in TRAINING (only)");
+  }
+
+  SECTION("Valid attributes in TRAINING") {
+    attr.setForwardPhase(NormFwdPhase::TRAINING);
+    attr.setINV_RMS(std::make_shared<TensorAttr>());
+    RmsnormNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.rmsnormAttr.getY()->getDim() == std::vector<int64_t>{n, d});
+    REQUIRE(node.rmsnormAttr.getINV_RMS()->getDim() ==
+            std::vector<int64_t>{n, 1});
+    REQUIRE(node.rmsnormAttr.getINV_RMS()->getDataType() == DataType::Float);
+  }
+}
@@ -64,3 +64,24 @@ TEST_CASE("PointwiseAttr setters and getters", "[pointwise_attr]") {
   REQUIRE(attr.getIN_1()->isVirtual() == false);
   REQUIRE(attr.getOUT_0()->isVirtual() == false);
 }
+
+TEST_CASE("PointwiseAttr clamp bounds", "[pointwise_attr]") {
+  PointwiseAttr attr;
+  REQUIRE(!attr.getClampMin().has_value());
+  REQUIRE(!attr.getClampMax().has_value());
+
+  uint64_t unclamped = attr.fingerprint(0);
+  attr.setMode(PointwiseAttr::Mode::CLAMP).setClampMin(0.0f);
+  REQUIRE(attr.getClampMin() == 0.0f);
+  REQUIRE(!attr.getClampMax().has_value());
+
+  // Bounds are part of the fingerprint (a max of 0 differs from a min of 0).
+  PointwiseAttr other;
+  other.setMode(PointwiseAttr::Mode::CLAMP).setClampMax(0.0f);
+  REQUIRE(attr.fingerprint(0) != other.fingerprint(0));
+  REQUIRE(attr.fingerprint(0) != unclamped);
+
+  other.setClampMin(0.0f).setClampMax(6.0f);
+  REQUIRE(other.getClampMin() == 0.0f);
+  REQUIRE(other.getClampMax() == 6.0f);
+}
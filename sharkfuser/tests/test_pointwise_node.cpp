@@ -9,7 +9,9 @@
 #include "utils.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -105,6 +107,90 @@ TEST_CASE("PointwiseNode preValidateNode detects missing mode",
   }
 }
 
+TEST_CASE("PointwiseNode preValidateNode checks activation modes",
+          "[pointwise_node]") {
+  Context ctx;
+  auto in0 = std::make_shared<TensorAttr>(1.0f);
+  auto in1 = std::make_shared<TensorAttr>(2.0f);
+  auto in2 = std::make_shared<TensorAttr>(3.0f);
+  auto out = std::make_shared<TensorAttr>();
+
+  SECTION("Backward modes require the gradient and forward input") {
+    const auto mode = GENERATE(PointwiseAttr::Mode::GELU_APPROX_TANH_BWD,
+                               PointwiseAttr::Mode::GELU_BWD,
+                               PointwiseAttr::Mode::RELU_BWD,
+                               PointwiseAttr::Mode::SIGMOID_BWD,
+                               PointwiseAttr::Mode::TANH_BWD);
+    PointwiseAttr attr;
+    attr.setMode(mode).setIN_0(in0).setOUT_0(out);
+    PointwiseNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            PointwiseAttr::kModeToStr.at(mode) + " mode requires IN_1 input");
+  }
+
+  SECTION("Forward activation modes take one input") {
+    const auto mode = GENERATE(PointwiseAttr::Mode::GELU_APPROX_TANH_FWD,
+                               PointwiseAttr::Mode::GELU_FWD,
+                               PointwiseAttr::Mode::SIGMOID_FWD,
+                               PointwiseAttr::Mode::SWISH_FWD,
+                               PointwiseAttr::Mode::TANH_FWD);
+    PointwiseAttr attr;
+    attr.setMode(mode).setIN_0(in0).setOUT_0(out);
+    PointwiseNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+
+  SECTION("SCALE_SHIFT mode requires three inputs") {
+    PointwiseAttr attr;
+    attr.setMode(PointwiseAttr::Mode::SCALE_SHIFT)
+        .setIN_0(in0)
+        .setIN_1(in1)
+        .setOUT_0(out);
+    PointwiseNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "SCALE_SHIFT mode requires IN_2 input");
+
+    node.pointwiseAttr.setIN_2(in2);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+
+  SECTION("CLAMP mode requires a bound") {
+    PointwiseAttr attr;
+    attr.setMode(PointwiseAttr::Mode::CLAMP).setIN_0(in0).setOUT_0(out);
+    PointwiseNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "CLAMP mode requires a min or max");
+
+    node.pointwiseAttr.setClampMax(6.0f);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+
+  SECTION("Clamp bounds are only valid in CLAMP mode") {
+    PointwiseAttr attr;
+    attr.setMode(PointwiseAttr::Mode::RELU_FWD)
+        .setClampMin(0.0f)
+        .setIN_0(in0)
+        .setOUT_0(out);
+    PointwiseNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "RELU_FWD mode should not have a clamp min or max set");
+  }
+}
+
 TEST_CASE("PointwiseNode with tensor attributes", "[pointwise_node]") {
   Context ctx;
   PointwiseAttr attr;
@@ -189,6 +275,30 @@ TEST_CASE("PointwiseNode with ADD mode broadcast", "[pointwise_node]") {
   REQUIRE(out->getStride() == in0->getStride());
 }
 
+TEST_CASE("PointwiseNode with ADD mode dynamic dims", "[pointwise_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float);
+  PointwiseAttr attr;
+  attr.setMode(PointwiseAttr::Mode::ADD);
+
+  auto in0 = std::make_shared<TensorAttr>();
+  in0->setDim({16, 32, 64}).setStride({32 * 64, 64, 1}).setDynamicDims({0});
+  auto in1 = std::make_shared<TensorAttr>();
+  in1->setDim({32, 64}).setStride({64, 1}).setDynamicDims({1});
+  auto out = std::make_shared<TensorAttr>();
+
+  attr.setIN_0(in0).setIN_1(in1).setOUT_0(out);
+
+  PointwiseNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+
+  // Dynamic dims of inputs are right-aligned, as in broadcasting.
+  out = node.pointwiseAttr.getOUT_0();
+  REQUIRE(out->getDim() == in0->getDim());
+  REQUIRE(out->getDynamicDims() == std::vector<size_t>{0, 2});
+}
+
 TEST_CASE("PointwiseNode with ADD mode invalid broadcast", "[pointwise_node]") {
   Context ctx;
   ctx.setIODataType(DataType::Float);
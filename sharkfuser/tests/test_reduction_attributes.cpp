@@ -0,0 +1,78 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("ReductionAttr default constructor", "[reduction_attr]") {
+  ReductionAttr attr;
+  REQUIRE(attr.inputs.empty());
+  REQUIRE(attr.outputs.empty());
+  REQUIRE(attr.getMode() == ReductionAttr::Mode::NOT_SET);
+  REQUIRE(attr.getAxes().empty());
+}
+
+TEST_CASE("ReductionAttr setters and getters", "[reduction_attr]") {
+  ReductionAttr attr;
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto y = std::make_shared<TensorAttr>(2.0f);
+
+  attr.setX(x).setY(y).setMode(ReductionAttr::Mode::SUM).setAxes({2, 3});
+
+  REQUIRE(attr.inputs.size() == 1);
+  REQUIRE(attr.outputs.size() == 1);
+
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getY() == y);
+  REQUIRE(attr.getMode() == ReductionAttr::Mode::SUM);
+  REQUIRE(attr.getAxes() == std::vector<int64_t>{2, 3});
+  REQUIRE(ReductionAttr::kModeToStr.at(attr.getMode()) == "SUM");
+}
+
+TEST_CASE("SoftmaxAttr setters and getters", "[reduction_attr]") {
+  SoftmaxAttr attr;
+  REQUIRE(attr.inputs.empty());
+  REQUIRE(attr.outputs.empty());
+  REQUIRE(!attr.getAxis().has_value());
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto y = std::make_shared<TensorAttr>(2.0f);
+
+  attr.setX(x).setY(y).setAxis(3);
+
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getY() == y);
+  REQUIRE(attr.getAxis() == 3);
+}
+
+TEST_CASE("Reduction attributes fingerprint their mode and axes",
+          "[reduction_attr]") {
+  ReductionAttr a, b;
+  a.setMode(ReductionAttr::Mode::SUM).setAxes({1});
+  b.setMode(ReductionAttr::Mode::SUM).setAxes({1});
+  REQUIRE(a.fingerprint(0) == b.fingerprint(0));
+
+  b.setMode(ReductionAttr::Mode::MAX);
+  REQUIRE(a.fingerprint(0) != b.fingerprint(0));
+
+  b.setMode(ReductionAttr::Mode::SUM).setAxes({1, 2});
+  REQUIRE(a.fingerprint(0) != b.fingerprint(0));
+
+  SoftmaxAttr c, d;
+  c.setAxis(1);
+  d.setAxis(1);
+  REQUIRE(c.fingerprint(0) == d.fingerprint(0));
+
+  d.setAxis(2);
+  REQUIRE(c.fingerprint(0) != d.fingerprint(0));
+}
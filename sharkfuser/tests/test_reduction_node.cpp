@@ -0,0 +1,176 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+static std::shared_ptr<TensorAttr>
+makeTensor(const std::string &name, const std::vector<int64_t> &dim,
+           const std::vector<size_t> &strideOrder) {
+  return std::make_shared<TensorAttr>(
+      TensorAttr().setName(name).setDim(dim).setStride(
+          generateStrideFromDim(dim, strideOrder)));
+}
+
+TEST_CASE("Reduction nodes getName and getType", "[reduction_node]") {
+  Context ctx;
+
+  ReductionAttr reductionAttr;
+  reductionAttr.setName("foo_reduction");
+  ReductionNode reductionNode(std::move(reductionAttr), ctx);
+  REQUIRE(reductionNode.getName() == "foo_reduction");
+  REQUIRE(reductionNode.getType() == INode::Type::Reduction);
+
+  SoftmaxAttr softmaxAttr;
+  softmaxAttr.setName("foo_softmax");
+  SoftmaxNode softmaxNode(std::move(softmaxAttr), ctx);
+  REQUIRE(softmaxNode.getName() == "foo_softmax");
+  REQUIRE(softmaxNode.getType() == INode::Type::Softmax);
+}
+
+TEST_CASE("ReductionNode preValidateNode detects invalid attributes",
+          "[reduction_node]") {
+  Context ctx;
+  ReductionAttr attr;
+
+  SECTION("Mode not set") {
+    ReductionNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Reduction mode not set");
+  }
+
+  attr.setMode(ReductionAttr::Mode::MEAN);
+  attr.setX(makeTensor("x", {2, 8, 4}, getContiguousStrideOrder(3)))
+      .setY(std::make_shared<TensorAttr>());
+
+  SECTION("Axes not set") {
+    ReductionNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Reduction axes not set");
+  }
+
+  SECTION("Axis out of range") {
+    attr.setAxes({3});
+    ReductionNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Reduction axis 3 out of range of input tensor X");
+  }
+
+  SECTION("Repeated axis") {
+    attr.setAxes({1, 1});
+    ReductionNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Reduction axis 1 specified more than once");
+  }
+
+  SECTION("Valid attributes") {
+    attr.setAxes({1, 2});
+    ReductionNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+}
+
+TEST_CASE("ReductionNode inferPropertiesNode keeps reduced dims",
+          "[reduction_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setIntermediateDataType(DataType::Float);
+  int64_t n = 2, c = 16, h = 8, w = 8;
+
+  ReductionAttr attr;
+  attr.setMode(ReductionAttr::Mode::SUM).setAxes({2, 3});
+  attr.setX(makeTensor("x", {n, c, h, w}, getChannelsLastStrideOrder(4)))
+      .setY(std::make_shared<TensorAttr>());
+  ReductionNode node(std::move(attr), ctx);
+
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  auto yT = node.reductionAttr.getY();
+  REQUIRE(yT->getDim() == std::vector<int64_t>{n, c, 1, 1});
+  REQUIRE(yT->getStride().size() == 4);
+
+  SECTION("Output of mismatched dims") {
+    yT->setDim({n, c, h, 1});
+
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Reduction output tensor Y dimensions do not match the expected "
+            "shape inferred from input tensor X and the reduction axes");
+  }
+}
+
+TEST_CASE("SoftmaxNode validates and infers properties", "[reduction_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float).setIntermediateDataType(DataType::Float);
+  int64_t b = 4, s = 16, d = 32;
+
+  SoftmaxAttr attr;
+  attr.setX(makeTensor("x", {b, s, d}, getContiguousStrideOrder(3)))
+      .setY(std::make_shared<TensorAttr>());
+
+  SECTION("Axis not set") {
+    SoftmaxNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Softmax axis not set");
+  }
+
+  SECTION("Axis out of range") {
+    attr.setAxis(-1);
+    SoftmaxNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Softmax axis -1 out of range of input tensor X");
+  }
+
+  SECTION("Valid attributes") {
+    attr.setAxis(2);
+    SoftmaxNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    auto xT = node.softmaxAttr.getX();
+    auto yT = node.softmaxAttr.getY();
+    REQUIRE(yT->getDim() == xT->getDim());
+    REQUIRE(yT->getStride() == xT->getStride());
+  }
+}
@@ -0,0 +1,55 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+using namespace fusilli;
+
+TEST_CASE("SdpaAttr default constructor", "[sdpa_attr]") {
+  SdpaAttr attr;
+  REQUIRE(attr.inputs.empty());
+  REQUIRE(attr.outputs.empty());
+  REQUIRE(!attr.getCausal());
+  REQUIRE(!attr.getScale().has_value());
+}
+
+TEST_CASE("SdpaAttr setters and getters", "[sdpa_attr]") {
+  SdpaAttr attr;
+
+  auto q = std::make_shared<TensorAttr>(1.0f);
+  auto k = std::make_shared<TensorAttr>(2.0f);
+  auto v = std::make_shared<TensorAttr>(3.0f);
+  auto mask = std::make_shared<TensorAttr>(4.0f);
+  auto o = std::make_shared<TensorAttr>(5.0f);
+
+  attr.setQ(q).setK(k).setV(v).setMASK(mask).setO(o);
+  attr.setCausal(true).setScale(0.125f);
+
+  REQUIRE(attr.inputs.size() == 4);
+  REQUIRE(attr.outputs.size() == 1);
+
+  REQUIRE(attr.getQ() == q);
+  REQUIRE(attr.getK() == k);
+  REQUIRE(attr.getV() == v);
+  REQUIRE(attr.getMASK() == mask);
+  REQUIRE(attr.getO() == o);
+  REQUIRE(attr.getCausal());
+  REQUIRE(attr.getScale() == 0.125f);
+}
+
+TEST_CASE("SdpaAttr fingerprints its causal flag and scale", "[sdpa_attr]") {
+  SdpaAttr a, b;
+  REQUIRE(a.fingerprint(0) == b.fingerprint(0));
+
+  b.setCausal(true);
+  REQUIRE(a.fingerprint(0) != b.fingerprint(0));
+
+  b.setCausal(false).setScale(0.125f);
+  REQUIRE(a.fingerprint(0) != b.fingerprint(0));
+}
@@ -0,0 +1,156 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+static std::shared_ptr<TensorAttr> makeTensor(const std::string &name,
+                                              const std::vector<int64_t> &dim) {
+  return std::make_shared<TensorAttr>(
+      TensorAttr().setName(name).setDim(dim).setStride(
+          generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+}
+
+TEST_CASE("SdpaNode getName and getType", "[sdpa_node]") {
+  Context ctx;
+  SdpaAttr attr;
+  attr.setName("foo_sdpa");
+  SdpaNode node(std::move(attr), ctx);
+
+  REQUIRE(node.getName() == "foo_sdpa");
+  REQUIRE(node.getType() == INode::Type::Sdpa);
+}
+
+TEST_CASE("SdpaNode preValidateNode detects invalid attributes",
+          "[sdpa_node]") {
+  Context ctx;
+  int64_t b = 2, h = 4, sQ = 16, sKv = 32, d = 8;
+  SdpaAttr attr;
+
+  SECTION("Input Q missing") {
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "SDPA input tensor Q not set");
+  }
+
+  attr.setQ(makeTensor("q", {b, h, sQ, d}));
+  attr.setK(makeTensor("k", {b, h, sKv, d}));
+  attr.setO(std::make_shared<TensorAttr>());
+
+  SECTION("Input V missing") {
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "SDPA input tensor V not set");
+  }
+
+  SECTION("Mismatched sequence lengths of K and V") {
+    attr.setV(makeTensor("v", {b, h, sQ, d}));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "SDPA input tensor V must have the "
+                                   "sequence length of input tensor K");
+  }
+
+  attr.setV(makeTensor("v", {b, h, sKv, d}));
+
+  SECTION("Grouped-query attention") {
+    attr.setK(makeTensor("k", {b, 1, sKv, d}));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "SDPA input tensors K and V must have the "
+                                   "batch and head dims of input tensor Q");
+  }
+
+  SECTION("Mask with causal masking") {
+    attr.setMASK(makeTensor("mask", {1, 1, sQ, sKv})).setCausal(true);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "SDPA input tensor MASK and causal "
+                                   "masking are mutually exclusive");
+  }
+
+  SECTION("Mask not broadcasting to the scores") {
+    attr.setMASK(makeTensor("mask", {1, 1, sKv, sQ}));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA input tensor MASK does not broadcast to the attention "
+            "scores (B, H, S_q, S_kv)");
+  }
+
+  SECTION("Valid attributes with a broadcast mask") {
+    attr.setMASK(makeTensor("mask", {sQ, sKv}));
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+}
+
+TEST_CASE("SdpaNode inferPropertiesNode", "[sdpa_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half);
+  int64_t b = 2, h = 4, sQ = 16, sKv = 32, d = 8, dV = 16;
+
+  SdpaAttr attr;
+  // Q stored as BSHD.
+  attr.setQ(std::make_shared<TensorAttr>(
+      TensorAttr()
+          .setName("q")
+          .setDim({b, h, sQ, d})
+          .setStride({sQ * h * d, d, h * d, 1})));
+  attr.setK(makeTensor("k", {b, h, sKv, d}));
+  attr.setV(makeTensor("v", {b, h, sKv, dV}));
+  attr.setO(std::make_shared<TensorAttr>());
+  SdpaNode node(std::move(attr), ctx);
+
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  auto oT = node.sdpaAttr.getO();
+  REQUIRE(oT->getDim() == std::vector<int64_t>{b, h, sQ, dV});
+  REQUIRE(oT->getStride() == std::vector<int64_t>{sQ * h * dV, dV, h * dV, 1});
+  REQUIRE(oT->getDataType() == DataType::Half);
+
+  SECTION("Mismatched data types") {
+    node.sdpaAttr.getV()->setDataType(DataType::Float);
+
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA input tensors Q, K and V must have the same data type");
+  }
+}
@@ -248,6 +248,26 @@ TEST_CASE("TensorAttr output vs virtual", "[TensorAttr]") {
   REQUIRE(t.isVirtual());
 }
 
+TEST_CASE("TensorAttr getValueNameAsm", "[TensorAttr]") {
+  TensorAttr t;
+  t.setName("foo_Bar::X0");
+  REQUIRE(t.getValueNameAsm() == "%foo_BarX0");
+  REQUIRE(t.getValueNameAsm(/*isOutputAliased=*/true) == "%foo_BarX0_");
+  // The interned name is reused until the tensor is renamed.
+  REQUIRE(t.getValueNameAsm() == "%foo_BarX0");
+
+  t.setName("baz-1");
+  REQUIRE(t.getValueNameAsm() == "%baz1");
+  REQUIRE(t.getValueNameAsm(/*isOutputAliased=*/true) == "%baz1_");
+
+  // Copies keep the interned name of the original.
+  TensorAttr copy = t;
+  REQUIRE(copy.getValueNameAsm() == "%baz1");
+  copy.setName("qux");
+  REQUIRE(copy.getValueNameAsm() == "%qux");
+  REQUIRE(t.getValueNameAsm() == "%baz1");
+}
+
 TEST_CASE("TensorAttr isContiguous and isChannelsLast checks", "[TensorAttr]") {
   TensorAttr t1;
   t1.setName("contiguous_tensor")
@@ -311,6 +331,50 @@ TEST_CASE("TensorAttr getPhysicalDim", "[TensorAttr]") {
   REQUIRE(t.getPhysicalDim() == std::vector<int64_t>{30, 20, 10});
 }
 
+TEST_CASE("TensorAttr dynamic dims", "[TensorAttr]") {
+  TensorAttr t;
+  t.setName("t").setDataType(DataType::Float);
+  REQUIRE(!t.isDynamic());
+
+  // Channels-last (NHWC) layout with dynamic N and C.
+  t.setDim({2, 3, 4, 5}).setStride({60, 1, 15, 3}).setDynamicDims({1, 0, 1});
+  FUSILLI_REQUIRE_OK(t.validate());
+  REQUIRE(t.isDynamic());
+  REQUIRE(t.getDynamicDims() == std::vector<size_t>{0, 1});
+  REQUIRE(t.isDynamicDim(0));
+  REQUIRE(t.isDynamicDim(1));
+  REQUIRE(!t.isDynamicDim(2));
+  REQUIRE(t.isPhysicalDimDynamic(0));
+  REQUIRE(!t.isPhysicalDimDynamic(1));
+  REQUIRE(!t.isPhysicalDimDynamic(2));
+  REQUIRE(t.isPhysicalDimDynamic(3));
+
+  // Dynamic dims are part of the fingerprint.
+  TensorAttr other = t;
+  REQUIRE(other.fingerprint(kFnv1aHashSeed) == t.fingerprint(kFnv1aHashSeed));
+  other.setDynamicDims({0});
+  REQUIRE(other.fingerprint(kFnv1aHashSeed) != t.fingerprint(kFnv1aHashSeed));
+
+  SECTION("Dynamic dim out of rank") {
+    t.setDynamicDims({4});
+    ErrorObject status = t.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 't' has a dynamic dim out of its rank");
+  }
+
+  SECTION("Dynamic scalar") {
+    TensorAttr scalar(1.0f);
+    scalar.setName("scalar").setDynamicDims({0});
+    ErrorObject status = scalar.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'scalar' cannot be both a scalar and dynamic");
+  }
+}
+
 TEST_CASE("getLogicalToPhysicalPermuteOrder", "[TensorAttr]") {
   TensorAttr t;
 
@@ -427,6 +491,33 @@ TEST_CASE("getPhysicalToLogicalPermuteOrder", "[TensorAttr]") {
           std::vector<int64_t>{0, 1, 2, 3});
 }
 
+TEST_CASE("TensorAttr constant data", "[TensorAttr]") {
+  TensorAttr t;
+  t.setName("filter").setDataType(DataType::Float).setDim({2, 2}).setStride(
+      {2, 1});
+  REQUIRE(!t.isConstant());
+  uint64_t hash = t.fingerprint(kFnv1aHashSeed);
+
+  t.setConstantData(std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f});
+  REQUIRE(t.isConstant());
+  REQUIRE(t.getConstantData()->size() == 4 * sizeof(float));
+  FUSILLI_REQUIRE_OK(t.validate());
+  REQUIRE(t.fingerprint(kFnv1aHashSeed) != hash);
+
+  // The contents are part of the fingerprint.
+  TensorAttr other = t;
+  other.setConstantData(std::vector<float>{1.0f, 2.0f, 3.0f, 5.0f});
+  REQUIRE(other.fingerprint(kFnv1aHashSeed) != t.fingerprint(kFnv1aHashSeed));
+
+  // The contents must fill the tensor, which cannot be virtual or dynamic.
+  other.setConstantData(std::vector<float>{1.0f, 2.0f});
+  ErrorObject status = other.validate();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  REQUIRE(isError(TensorAttr(t).setIsVirtual(true).validate()));
+  REQUIRE(isError(TensorAttr(t).setDynamicDims({0}).validate()));
+}
+
 TEST_CASE("TensorAttr hasValidPhysicalRepresentation", "[TensorAttr]") {
   TensorAttr t;
 
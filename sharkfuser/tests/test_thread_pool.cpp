@@ -0,0 +1,60 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <future>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("ThreadPool runs submitted tasks", "[ThreadPool]") {
+  ThreadPool pool(/*numThreads=*/4);
+  REQUIRE(pool.size() == 4);
+
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 64; ++i)
+    results.push_back(pool.submit([i] { return i * i; }));
+  for (int i = 0; i < 64; ++i)
+    REQUIRE(results[i].get() == i * i);
+}
+
+TEST_CASE("ThreadPool runs tasks concurrently", "[ThreadPool]") {
+  ThreadPool pool(/*numThreads=*/2);
+
+  // Each task waits for the other to start, so they only complete if run on
+  // distinct workers.
+  std::atomic<int> started = 0;
+  auto task = [&started] {
+    ++started;
+    while (started < 2)
+      std::this_thread::yield();
+    return std::this_thread::get_id();
+  };
+  auto first = pool.submit(task);
+  auto second = pool.submit(task);
+  REQUIRE(first.get() != second.get());
+}
+
+TEST_CASE("ThreadPool completes queued tasks on destruction", "[ThreadPool]") {
+  std::atomic<int> completed = 0;
+  std::vector<std::future<void>> results;
+  {
+    // Zero threads is rounded up to a single worker.
+    ThreadPool pool(/*numThreads=*/0);
+    REQUIRE(pool.size() == 1);
+    for (int i = 0; i < 16; ++i)
+      results.push_back(pool.submit([&completed] { ++completed; }));
+  }
+  REQUIRE(completed == 16);
+  for (auto &result : results)
+    result.get();
+}
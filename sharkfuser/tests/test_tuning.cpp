@@ -0,0 +1,186 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+// Helper function to create graph for testing.
+static std::tuple<Graph, std::shared_ptr<TensorAttr>,
+                  std::shared_ptr<TensorAttr>, std::shared_ptr<TensorAttr>>
+testGraph() {
+  Graph g;
+  g.setName("tuned_graph");
+  g.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  int64_t n = 2, c = 8, h = 8, w = 8, k = 16;
+  auto xT = g.tensor(TensorAttr()
+                         .setName("image")
+                         .setDim({n, c, h, w})
+                         .setStride({c * h * w, h * w, w, 1}));
+  auto wT = g.tensor(TensorAttr()
+                         .setName("filter")
+                         .setDim({k, c, 1, 1})
+                         .setStride({c, 1, 1, 1}));
+  auto conv = ConvFPropAttr()
+                  .setPadding({0, 0})
+                  .setStride({1, 1})
+                  .setDilation({1, 1})
+                  .setName("conv_fprop");
+  auto yT = g.convFProp(xT, wT, conv);
+  yT->setOutput(true);
+  FUSILLI_REQUIRE_OK(g.validate());
+  return {std::move(g), xT, wT, yT};
+}
+
+TEST_CASE("TuningConfig parse and print", "[tuning]") {
+  TuningConfig config = TuningConfig::parse(
+      "--iree-opt-level=O2 --iree-codegen-tuning-spec-path=spec.mlir");
+  REQUIRE(config.flags == std::vector<std::string>{"--iree-opt-level=O2"});
+  REQUIRE(config.tuningSpecPath == "spec.mlir");
+  REQUIRE(config.getCompileFlags() ==
+          std::vector<std::string>{
+              "--iree-opt-level=O2",
+              "--iree-codegen-tuning-spec-path=spec.mlir",
+          });
+
+  std::ostringstream oss;
+  oss << config;
+  REQUIRE(TuningConfig::parse(oss.str()) == config);
+  REQUIRE(TuningConfig::parse("  ").empty());
+}
+
+TEST_CASE("TuningConfig hash", "[tuning]") {
+  // Empty configs leave the hash unchanged.
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(TuningConfig{}.hash(42)) == 42);
+
+  TuningConfig config{.flags = {"--iree-opt-level=O2"}};
+  uint64_t flagsHash = FUSILLI_REQUIRE_UNWRAP(config.hash(42));
+  REQUIRE(flagsHash != 42);
+
+  // Tuning specs are hashed by their contents.
+  std::filesystem::path specPath =
+      std::filesystem::temp_directory_path() / "fusilli_test_spec.mlir";
+  config.tuningSpecPath = specPath;
+  REQUIRE(isError(config.hash(42)));
+
+  std::ofstream(specPath) << "module {}";
+  uint64_t specHash = FUSILLI_REQUIRE_UNWRAP(config.hash(42));
+  std::ofstream(specPath) << "module attributes {} {}";
+  uint64_t otherSpecHash = FUSILLI_REQUIRE_UNWRAP(config.hash(42));
+  std::filesystem::remove(specPath);
+  REQUIRE(specHash != flagsHash);
+  REQUIRE(specHash != otherSpecHash);
+}
+
+TEST_CASE("TuningRegistry save and load", "[tuning]") {
+  std::filesystem::path dbPath =
+      std::filesystem::temp_directory_path() / "fusilli_test_tuning.db";
+  TuningConfig config = TuningConfig::parse(
+      "--iree-opt-level=O2 --iree-codegen-tuning-spec-path=spec.mlir");
+
+  TuningRegistry::add(Backend::CPU, 0xabc, config);
+  TuningRegistry::add(Backend::AMDGPU, 0xabc, TuningConfig{});
+  FUSILLI_REQUIRE_OK(TuningRegistry::save(dbPath));
+  TuningRegistry::clear();
+  REQUIRE(!TuningRegistry::find(Backend::CPU, 0xabc).has_value());
+
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(TuningRegistry::load(dbPath)) == 2);
+  REQUIRE(TuningRegistry::find(Backend::CPU, 0xabc) == config);
+  REQUIRE(TuningRegistry::find(Backend::AMDGPU, 0xabc) == TuningConfig{});
+  REQUIRE(!TuningRegistry::find(Backend::CPU, 0xdef).has_value());
+  TuningRegistry::clear();
+
+  std::ofstream(dbPath) << "NOT_A_BACKEND abc --iree-opt-level=O2\n";
+  ErrorOr<size_t> numConfigs = TuningRegistry::load(dbPath);
+  std::filesystem::remove(dbPath);
+  REQUIRE(isError(numConfigs));
+  REQUIRE(ErrorObject(numConfigs).getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("Graph compiles with its tuning config", "[tuning][graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  TuningConfig config{.flags = {"--iree-opt-level=O1"}};
+
+  auto [untuned, ux, uw, uy] = testGraph();
+  FUSILLI_REQUIRE_OK(untuned.compile(handle, /*remove=*/true));
+  std::string untunedCommand = FUSILLI_REQUIRE_UNWRAP(
+      untuned.readCompilationCacheFile(CachedAssetsType::Command));
+  REQUIRE(untunedCommand.find("--iree-opt-level=O1") == std::string::npos);
+
+  // Tuning configs are part of the cache key: tuned graphs do not reuse the
+  // artifacts of untuned ones.
+  auto [tuned, tx, tw, ty] = testGraph();
+  tuned.setTuningConfig(config);
+  FUSILLI_REQUIRE_OK(tuned.compile(handle, /*remove=*/true));
+  std::string tunedCommand = FUSILLI_REQUIRE_UNWRAP(
+      tuned.readCompilationCacheFile(CachedAssetsType::Command));
+  REQUIRE(tunedCommand.find("--iree-opt-level=O1") != std::string::npos);
+
+  // Graphs without a config of their own use the registered one.
+  TuningRegistry::add(Backend::CPU,
+                      FUSILLI_REQUIRE_UNWRAP(untuned.getFingerprint()), config);
+  auto [registered, rx, rw, ry] = testGraph();
+  REQUIRE(registered.getTuningConfig(Backend::CPU) == config);
+  FUSILLI_REQUIRE_OK(registered.compile(handle, /*remove=*/true));
+  REQUIRE(FUSILLI_REQUIRE_UNWRAP(registered.readCompilationCacheFile(
+              CachedAssetsType::Command)) == tunedCommand);
+  TuningRegistry::clear();
+}
+
+TEST_CASE("autotune selects a candidate that compiles", "[tuning][graph]") {
+  Handle handle = FUSILLI_REQUIRE_UNWRAP(Handle::create(Backend::CPU));
+  auto [graph, xT, wT, yT] = testGraph();
+
+  auto xBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, xT, DataType::Half, 1.0f));
+  auto wBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, wT, DataType::Half, 1.0f));
+  auto yBuf = FUSILLI_REQUIRE_UNWRAP(
+      allocateBufferOfType(handle, yT, DataType::Half, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {wT, wBuf},
+          {yT, yBuf},
+      };
+
+  SECTION("no candidates") {
+    REQUIRE(isError(autotune(handle, graph, /*candidates=*/{}, variantPack)));
+  }
+
+  SECTION("failing candidates are skipped") {
+    std::vector<TuningConfig> candidates = {
+        TuningConfig{.flags = {"--not-a-compiler-flag"}},
+        TuningConfig{},
+        TuningConfig{.flags = {"--iree-opt-level=O1"}},
+    };
+    size_t best = FUSILLI_REQUIRE_UNWRAP(autotune(
+        handle, graph, candidates, variantPack, /*iterations=*/2,
+        /*remove=*/true));
+    REQUIRE(best != 0);
+    REQUIRE(graph.getTuningConfig(Backend::CPU) == candidates[best]);
+    uint64_t fingerprint = FUSILLI_REQUIRE_UNWRAP(graph.getFingerprint());
+    REQUIRE(TuningRegistry::find(Backend::CPU, fingerprint) ==
+            candidates[best]);
+    FUSILLI_REQUIRE_OK(graph.execute(handle, variantPack));
+    TuningRegistry::clear();
+  }
+}
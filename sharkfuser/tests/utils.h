@@ -20,6 +20,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
+#include <string_view>
 #include <utility> // IWYU pragma: export
 #include <vector>
 
@@ -106,6 +108,20 @@ allocateBufferOfType(Handle &handle, const std::shared_ptr<TensorAttr> &tensor,
   }
 }
 
+// Reads the number of dispatches `graph` was compiled to from the statistics
+// dumped by the compiler (`--iree-scheduling-dump-statistics-file`), e.g. to
+// check that pointwise epilogues are fused into the dispatch of a conv.
+inline ErrorOr<int64_t> getDispatchCount(Graph &graph) {
+  std::string statistics =
+      FUSILLI_TRY(graph.readCompilationCacheFile(CachedAssetsType::Statistics));
+  constexpr std::string_view key = "\"dispatch-count\":";
+  size_t pos = statistics.find(key);
+  FUSILLI_RETURN_ERROR_IF(pos == std::string::npos, ErrorCode::RuntimeFailure,
+                          "Compilation statistics have no dispatch count");
+  return ok(static_cast<int64_t>(
+      std::stoll(statistics.substr(pos + key.size()))));
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_TESTS_UTILS_H
@@ -0,0 +1,283 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Sweeps batch, reduction size and k for each topk ukernel, reporting the
+// time per run and the effective bandwidth (bytes read and written by the
+// kernels) against the device peak. Run from the build directory, next to
+// compiled_kernels/. See topk_iree_benchmark.sh for the default
+// IREE-generated topk on the same shapes.
+
+#include "../tests/utils.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <hip/hip_runtime.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+constexpr uint32_t recordRuns = 100u;
+constexpr int blockSize = 64; // workgroup_size of the specs
+
+static std::vector<char> readFileIntoVector(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    std::cerr << "Unable to open file: " << filename << std::endl;
+    return std::vector<char>();
+  }
+  std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  std::vector<char> buffer(size);
+  file.read(buffer.data(), size);
+  file.close();
+  return buffer;
+}
+
+// Kernel arguments, in the order of the kernel ABI (bindings, then
+// constants).
+class KernelArgs {
+public:
+  KernelArgs &ptr(void *value) {
+    values.push_back(reinterpret_cast<uint64_t>(value));
+    return *this;
+  }
+  KernelArgs &i32(int32_t value) {
+    values.push_back(static_cast<uint32_t>(value));
+    return *this;
+  }
+  void **data() {
+    params.clear();
+    for (uint64_t &value : values)
+      params.push_back(&value);
+    return params.data();
+  }
+
+private:
+  std::vector<uint64_t> values;
+  std::vector<void *> params;
+};
+
+// A ukernel: its per-row kernel, the phase 1 kernel of its split-row variant
+// (if benchmarking that) and whether it takes k as a constant.
+struct KernelConfig {
+  std::string name;
+  std::string tilesName;
+  bool runtimeK;
+};
+
+static std::vector<KernelConfig> getKernels(const std::string &prefix, int k) {
+  std::vector<KernelConfig> kernels;
+  if (k == 8) {
+    kernels.push_back({prefix, "", false});
+    kernels.push_back({prefix + "_shuffle", "", false});
+  }
+  if (k == 16 || k == 32 || k == 64) {
+    std::string name = prefix + "_k" + std::to_string(k);
+    kernels.push_back({name, "", false});
+    kernels.push_back({name, name + "_tiles", false});
+  }
+  kernels.push_back({prefix + "_radix", "", true});
+  kernels.push_back({prefix + "_radix", prefix + "_radix_tiles", true});
+  return kernels;
+}
+
+// The number of tiles per row of the split-row kernels, as picked by the
+// specs.
+static int getNumTiles(int batchSize, int reductionSize, int k) {
+  int maxTilesPerRow = (256 + batchSize - 1) / batchSize;
+  int tilesPerRow = reductionSize / std::max(k, 4096);
+  return std::max(1, std::min(maxTilesPerRow, tilesPerRow));
+}
+
+static hipFunction_t getFunction(hipModule_t module, const std::string &name) {
+  hipFunction_t kernel;
+  if (hipModuleGetFunction(&kernel, module, name.c_str()) != hipSuccess) {
+    std::cerr << "Failed to get function " << name << "!" << std::endl;
+    exit(1);
+  }
+  return kernel;
+}
+
+static void launch(hipFunction_t kernel, int gridX, int gridY,
+                   KernelArgs &args) {
+  CHECK_HIP_ERROR(hipModuleLaunchKernel(kernel, gridX, gridY, 1, blockSize, 1,
+                                        1, 0, nullptr, args.data(), nullptr));
+}
+
+// Benchmarks one kernel on one shape and prints a row of the report.
+static void benchmarkKernel(hipModule_t module, const KernelConfig &config,
+                            const char *dtype, size_t elementSize,
+                            int batchSize, int reductionSize, int k,
+                            double peakGBps) {
+  size_t numInputs = (size_t)batchSize * reductionSize;
+  size_t numOutputs = (size_t)batchSize * k;
+  int numTiles = config.tilesName.empty()
+                     ? 1
+                     : getNumTiles(batchSize, reductionSize, k);
+  size_t numPartials = (size_t)batchSize * numTiles * k;
+
+  // Random values, with the largest of each row at a known index.
+  std::vector<float> values(numInputs);
+  std::vector<int32_t> indices(numInputs);
+  for (size_t i = 0; i < numInputs; ++i) {
+    values[i] = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    indices[i] = i % reductionSize;
+  }
+  const int argmax = reductionSize / 3;
+  for (int b = 0; b < batchSize; ++b)
+    values[(size_t)b * reductionSize + argmax] = 2.0f;
+  std::vector<char> hostInput(numInputs * elementSize);
+  for (size_t i = 0; i < numInputs; ++i) {
+    if (elementSize == sizeof(float16_t)) {
+      float16_t value = float2half(values[i], FP16_EXP_BITS);
+      memcpy(hostInput.data() + i * elementSize, &value, elementSize);
+    } else {
+      memcpy(hostInput.data() + i * elementSize, &values[i], elementSize);
+    }
+  }
+
+  void *d_input, *d_indices, *d_outputValues, *d_outputIndices;
+  void *d_partialValues = nullptr, *d_partialIndices = nullptr;
+  CHECK_HIP_ERROR(hipMalloc(&d_input, numInputs * elementSize));
+  CHECK_HIP_ERROR(hipMalloc(&d_indices, numInputs * sizeof(int32_t)));
+  CHECK_HIP_ERROR(hipMalloc(&d_outputValues, numOutputs * elementSize));
+  CHECK_HIP_ERROR(hipMalloc(&d_outputIndices, numOutputs * sizeof(int32_t)));
+  CHECK_HIP_ERROR(hipMemcpy(d_input, hostInput.data(), numInputs * elementSize,
+                            hipMemcpyHostToDevice));
+  CHECK_HIP_ERROR(hipMemcpy(d_indices, indices.data(),
+                            numInputs * sizeof(int32_t),
+                            hipMemcpyHostToDevice));
+
+  hipFunction_t kernel = getFunction(module, config.name);
+  hipFunction_t tilesKernel = nullptr;
+  KernelArgs args, tilesArgs;
+  if (config.tilesName.empty()) {
+    args.ptr(d_input).ptr(d_indices).ptr(d_outputValues).ptr(d_outputIndices);
+    args.i32(reductionSize);
+  } else {
+    CHECK_HIP_ERROR(hipMalloc(&d_partialValues, numPartials * elementSize));
+    CHECK_HIP_ERROR(
+        hipMalloc(&d_partialIndices, numPartials * sizeof(int32_t)));
+    tilesKernel = getFunction(module, config.tilesName);
+    tilesArgs.ptr(d_input).ptr(d_indices).ptr(d_partialValues);
+    tilesArgs.ptr(d_partialIndices).i32(reductionSize);
+    if (config.runtimeK)
+      tilesArgs.i32(k);
+    tilesArgs.i32(numTiles);
+    args.ptr(d_partialValues).ptr(d_partialIndices).ptr(d_outputValues);
+    args.ptr(d_outputIndices).i32(numTiles * k);
+  }
+  if (config.runtimeK)
+    args.i32(k);
+
+  auto run = [&]() {
+    if (tilesKernel)
+      launch(tilesKernel, numTiles, batchSize, tilesArgs);
+    launch(kernel, batchSize, 1, args);
+  };
+
+  // Warm up, then time.
+  run();
+  CHECK_HIP_ERROR(hipDeviceSynchronize());
+  hipEvent_t startEvent, stopEvent;
+  CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+  CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+  CHECK_HIP_ERROR(hipEventRecord(startEvent));
+  for (uint32_t i = 0; i < recordRuns; ++i)
+    run();
+  CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+  CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+  float elapsedTimeMs = 0.0f;
+  CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+  CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+  CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+  // Check the top-1 of each row.
+  std::vector<int32_t> outputIndices(numOutputs);
+  CHECK_HIP_ERROR(hipMemcpy(outputIndices.data(), d_outputIndices,
+                            numOutputs * sizeof(int32_t),
+                            hipMemcpyDeviceToHost));
+  bool valid = true;
+  for (int b = 0; b < batchSize; ++b)
+    valid &= outputIndices[(size_t)b * k] == argmax;
+
+  // Bytes read and written: values and indices of the inputs, the outputs
+  // and (twice) the partial results.
+  double bytes = (numInputs + numOutputs) * (elementSize + sizeof(int32_t));
+  if (tilesKernel)
+    bytes += 2.0 * numPartials * (elementSize + sizeof(int32_t));
+  double timeUs = elapsedTimeMs * 1000.0 / recordRuns;
+  double gbps = bytes / (timeUs * 1000.0);
+  std::string name =
+      config.name + (tilesKernel ? " (" + std::to_string(numTiles) +
+                                       " tiles)"
+                                 : "");
+  printf("%s,%d,%d,%d,%s,%.2f,%.1f,%.1f%s\n", dtype, batchSize, reductionSize,
+         k, name.c_str(), timeUs, gbps, 100.0 * gbps / peakGBps,
+         valid ? "" : ",INVALID");
+
+  CHECK_HIP_ERROR(hipFree(d_input));
+  CHECK_HIP_ERROR(hipFree(d_indices));
+  CHECK_HIP_ERROR(hipFree(d_outputValues));
+  CHECK_HIP_ERROR(hipFree(d_outputIndices));
+  if (d_partialValues) {
+    CHECK_HIP_ERROR(hipFree(d_partialValues));
+    CHECK_HIP_ERROR(hipFree(d_partialIndices));
+  }
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 2) {
+    std::cout << "Usage: " << argv[0] << " [peakGBps]" << std::endl;
+    std::cout << "  peakGBps: device memory bandwidth (default: from the "
+              << "memory clock and bus width)" << std::endl;
+    return 1;
+  }
+
+  hipDeviceProp_t props;
+  CHECK_HIP_ERROR(hipGetDeviceProperties(&props, 0));
+  // memoryClockRate is in kHz, memoryBusWidth in bits, at double data rate.
+  double peakGBps = argc == 2 ? atof(argv[1])
+                              : 2.0 * props.memoryClockRate * 1e3 *
+                                    (props.memoryBusWidth / 8) / 1e9;
+  std::cout << "# " << props.name << ", peak " << peakGBps << " GB/s"
+            << std::endl;
+  std::cout << "dtype,batch,reduction,k,kernel,us,GB/s,%peak" << std::endl;
+
+  struct {
+    const char *dtype;
+    const char *kernelFile;
+    const char *prefix;
+    size_t elementSize;
+  } dtypes[] = {
+      {"f16", "topk_fp16_ukernel.c", "topk_F16I32", sizeof(float16_t)},
+      {"f32", "topk_fp32_ukernel.c", "topk_F32I32", sizeof(float)},
+  };
+  for (const auto &dtype : dtypes) {
+    hipModule_t module;
+    std::vector<char> hsacoVec =
+        readFileIntoVector(getHsacoPath(dtype.kernelFile));
+    if (hipModuleLoadDataEx(&module, hsacoVec.data(), 0, nullptr, nullptr) !=
+        hipSuccess) {
+      std::cerr << "Failed to load module " << dtype.kernelFile << "!"
+                << std::endl;
+      return 1;
+    }
+    for (int batchSize : {1, 8, 64}) {
+      for (int reductionSize : {4096, 32768, 262144}) {
+        for (int k : {8, 16, 32, 64, 128}) {
+          for (const KernelConfig &config : getKernels(dtype.prefix, k)) {
+            benchmarkKernel(module, config, dtype.dtype, dtype.elementSize,
+                            batchSize, reductionSize, k, peakGBps);
+          }
+        }
+      }
+    }
+    CHECK_HIP_ERROR(hipModuleUnload(module));
+  }
+  return 0;
+}
@@ -0,0 +1,97 @@
+#!/bin/bash
+# Benchmarks iree_linalg_ext.topk on the shapes of topk_benchmark, compiled
+# by IREE with and without the topk specs, so the ukernels can be compared
+# with the default IREE-generated topk. Run from the build directory, with
+# iree-compile and iree-benchmark-module on the PATH:
+#   topk_iree_benchmark.sh [peakGBps]
+# The effective bandwidth counts the same bytes as topk_benchmark.
+set -euo pipefail
+
+TARGET_ARCH="${TARGET_ARCH:-gfx942}"
+PEAK_GBPS="${1:-}"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "${WORK_DIR}"' EXIT
+
+# Writes the topk of a BATCHxREDUCTION tensor of DTYPE to FILE.
+write_topk_module() {
+  local dtype="$1" batch="$2" reduction="$3" k="$4" file="$5"
+  local lowest="0xFC00"
+  if [ "${dtype}" = "f32" ]; then
+    lowest="0xFF800000"
+  fi
+  cat > "${file}" <<MLIR
+module @module {
+  util.func public @topk(%arg0: tensor<${batch}x${reduction}x${dtype}>) -> (tensor<${batch}x${k}x${dtype}>, tensor<${batch}x${k}xi32>) {
+    %c0_i32 = arith.constant 0 : i32
+    %cst = arith.constant ${lowest} : ${dtype}
+    %0 = tensor.empty() : tensor<${batch}x${reduction}xi32>
+    %1 = tensor.empty() : tensor<${batch}x${k}x${dtype}>
+    %2 = tensor.empty() : tensor<${batch}x${k}xi32>
+    %3 = linalg.fill ins(%cst : ${dtype}) outs(%1 : tensor<${batch}x${k}x${dtype}>) -> tensor<${batch}x${k}x${dtype}>
+    %4 = linalg.fill ins(%c0_i32 : i32) outs(%2 : tensor<${batch}x${k}xi32>) -> tensor<${batch}x${k}xi32>
+    %5 = linalg.generic {indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>], iterator_types = ["parallel", "parallel"]} outs(%0 : tensor<${batch}x${reduction}xi32>) {
+    ^bb0(%out: i32):
+      %7 = linalg.index 1 : index
+      %8 = arith.index_cast %7 : index to i32
+      linalg.yield %8 : i32
+    } -> tensor<${batch}x${reduction}xi32>
+    %6:2 = iree_linalg_ext.topk dimension(1) ins(%arg0, %5 : tensor<${batch}x${reduction}x${dtype}>, tensor<${batch}x${reduction}xi32>) outs(%3, %4 : tensor<${batch}x${k}x${dtype}>, tensor<${batch}x${k}xi32>) {
+    ^bb0(%arg1: ${dtype}, %arg2: ${dtype}):
+      %7 = arith.cmpf ogt, %arg1, %arg2 : ${dtype}
+      iree_linalg_ext.yield %7 : i1
+    } -> tensor<${batch}x${k}x${dtype}>, tensor<${batch}x${k}xi32>
+    util.return %6#0, %6#1 : tensor<${batch}x${k}x${dtype}>, tensor<${batch}x${k}xi32>
+  }
+}
+MLIR
+}
+
+# Prints the mean real time of @topk in microseconds.
+benchmark_vmfb() {
+  local vmfb="$1" dtype="$2" batch="$3" reduction="$4"
+  iree-benchmark-module --device=hip --module="${vmfb}" --function=topk \
+    --input="${batch}x${reduction}x${dtype}" --benchmark_repetitions=5 \
+    --benchmark_format=csv 2>/dev/null |
+    awk -F, '$1 ~ /_mean"?$/ {
+      scale = ($5 ~ /ms/) ? 1000 : (($5 ~ /ns/) ? 0.001 : 1)
+      print $3 * scale
+    }'
+}
+
+echo "dtype,batch,reduction,k,kernel,us,GB/s,%peak"
+for dtype in f16 f32; do
+  element_size=2
+  if [ "${dtype}" = "f32" ]; then
+    element_size=4
+  fi
+  for batch in 1 8 64; do
+    for reduction in 4096 32768 262144; do
+      for k in 8 16 32 64 128; do
+        module="${WORK_DIR}/topk.mlir"
+        write_topk_module "${dtype}" "${batch}" "${reduction}" "${k}" \
+          "${module}"
+        for variant in iree ukernel; do
+          flags=()
+          if [ "${variant}" = "ukernel" ]; then
+            flags+=("--iree-preprocessing-transform-spec-filename=specs/topk_${dtype}_spec.mlir")
+          fi
+          vmfb="${WORK_DIR}/topk_${variant}.vmfb"
+          iree-compile "${module}" --iree-hal-target-device=hip \
+            --iree-hip-target="${TARGET_ARCH}" "${flags[@]}" -o "${vmfb}"
+          time_us=$(benchmark_vmfb "${vmfb}" "${dtype}" "${batch}" \
+            "${reduction}")
+          awk -v dtype="${dtype}" -v batch="${batch}" \
+            -v reduction="${reduction}" -v k="${k}" -v variant="${variant}" \
+            -v us="${time_us}" -v size="${element_size}" \
+            -v peak="${PEAK_GBPS}" 'BEGIN {
+              bytes = (batch * reduction + batch * k) * (size + 4)
+              gbps = bytes / (us * 1000)
+              pct = peak != "" ? sprintf("%.1f", 100 * gbps / peak) : ""
+              printf "%s,%d,%d,%d,%s,%.2f,%.1f,%s\n", dtype, batch, reduction,
+                k, variant, us, gbps, pct
+            }'
+        done
+      done
+    done
+  done
+done
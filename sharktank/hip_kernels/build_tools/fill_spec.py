@@ -0,0 +1,74 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""Fills the {{HIP_ARCH}} and {{BUILD}} placeholders of a spec template.
+
+The `#rocm_target` executable target alias, and each
+`#rocm_target ordinal(0) = [...]` object list of the dispatches, are repeated
+once per architecture (as `#rocm_target_<arch>`), so that IREE links the
+objects built for the target it compiles for.
+"""
+
+import argparse
+import re
+
+TARGET_ALIAS = re.compile(r"^#rocm_target = ")
+OBJECTS_BEGIN = re.compile(r"^(\s*)#rocm_target ordinal\(0\) = \[\s*$")
+
+
+def fill_spec(template: str, archs: list[str], build: str) -> str:
+    lines = template.replace("{{BUILD}}", build).splitlines(keepends=True)
+    output = []
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        begin = OBJECTS_BEGIN.match(line)
+        if TARGET_ALIAS.match(line):
+            block = [line]
+            i += 1
+        elif begin:
+            # The object list ends at the `]` with the indentation of its
+            # first line.
+            end = i + 1
+            while end < len(lines) and lines[end].rstrip() != begin.group(1) + "]":
+                end += 1
+            block = lines[i : end + 1]
+            i = end + 1
+        else:
+            output.append(line)
+            i += 1
+            continue
+        for index, arch in enumerate(archs):
+            arch_block = [
+                block_line.replace("#rocm_target", f"#rocm_target_{arch}")
+                for block_line in block
+            ]
+            arch_block = [line.replace("{{HIP_ARCH}}", arch) for line in arch_block]
+            # Object lists are entries of the `objects` dictionary.
+            if begin and index + 1 < len(archs):
+                arch_block[-1] = arch_block[-1].rstrip("\n") + ",\n"
+            output.extend(arch_block)
+    return "".join(output)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("template", help="spec template")
+    parser.add_argument("-o", "--output", required=True, help="filled spec")
+    parser.add_argument(
+        "--archs", required=True, help="semicolon-separated architectures"
+    )
+    parser.add_argument("--build", required=True, help="build directory")
+    args = parser.parse_args()
+    archs = [arch for arch in args.archs.split(";") if arch]
+    with open(args.template) as f:
+        template = f.read()
+    with open(args.output, "w") as f:
+        f.write(fill_spec(template, archs, args.build))
+
+
+if __name__ == "__main__":
+    main()
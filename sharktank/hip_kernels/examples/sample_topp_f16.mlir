@@ -0,0 +1,54 @@
+// Decode step tail returning sampled token ids rather than logits: the top-k
+// is matched by specs/topk_f16_spec.mlir, and the sampling kernel is
+// dispatched directly, with the float parameters passed as their bits. Fill
+// the {{HIP_ARCH}} and {{BUILD}} placeholders with build_tools/fill_spec.py,
+// as the build does for specs.
+
+#rocm_target = #hal.executable.target<"rocm", "rocm-hsaco-fb", {target_arch = "{{HIP_ARCH}}", ukernels = "none"}>
+
+module @module {
+  util.func public @sample_topp_k16(%arg0: tensor<4x32000xf16>, %temperature: f32, %topP: f32, %seed: i32) -> tensor<4xi32> {
+    %c0_i32 = arith.constant 0 : i32
+    %c16_i32 = arith.constant 16 : i32
+    %cst = arith.constant 0xFC00 : f16
+    %0 = tensor.empty() : tensor<4x32000xi32>
+    %1 = tensor.empty() : tensor<4x16xf16>
+    %2 = tensor.empty() : tensor<4x16xi32>
+    %3 = linalg.fill ins(%cst : f16) outs(%1 : tensor<4x16xf16>) -> tensor<4x16xf16>
+    %4 = linalg.fill ins(%c0_i32 : i32) outs(%2 : tensor<4x16xi32>) -> tensor<4x16xi32>
+    %5 = linalg.generic {indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>], iterator_types = ["parallel", "parallel"]} outs(%0 : tensor<4x32000xi32>) {
+    ^bb0(%out: i32):
+      %7 = linalg.index 1 : index
+      %8 = arith.index_cast %7 : index to i32
+      linalg.yield %8 : i32
+    } -> tensor<4x32000xi32>
+    %6:2 = iree_linalg_ext.topk dimension(1) ins(%arg0, %5 : tensor<4x32000xf16>, tensor<4x32000xi32>) outs(%3, %4 : tensor<4x16xf16>, tensor<4x16xi32>) {
+    ^bb0(%arg1: f16, %arg2: f16):
+      %7 = arith.cmpf ogt, %arg1, %arg2 : f16
+      iree_linalg_ext.yield %7 : i1
+    } -> tensor<4x16xf16>, tensor<4x16xi32>
+
+    %c4 = arith.constant 4 : index
+    %temperature_i32 = arith.bitcast %temperature : f32 to i32
+    %topP_i32 = arith.bitcast %topP : f32 to i32
+    %tokens = hal.dispatch.extern "sample_topp_F16I32"[%c4](%c16_i32, %temperature_i32, %topP_i32, %seed, %6#0, %6#1) : (i32, i32, i32, i32, tensor<4x16xf16>, tensor<4x16xi32>) -> tensor<4xi32>
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 4, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/sampling_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %tokens : tensor<4xi32>
+  }
+}
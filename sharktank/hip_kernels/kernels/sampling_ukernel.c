@@ -0,0 +1,121 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+#include <math.h>
+#include <stdint.h>
+
+#define SAMPLING_MAX_K 1024 // Candidates kept in shared memory
+
+/*
+Fused softmax + top-p (nucleus) sampling over top-k candidates:
+- One workgroup per row (e.g., for candidates [B, K], grid.x = B), reading
+  the K candidate logits and token ids written by the topk kernels (sorted
+  descending, padded with index -1)
+- The workgroup computes the temperature-scaled softmax numerators of the
+  candidates, relative to the first (largest) one, in shared memory
+- Lane 0 keeps the smallest prefix of candidates holding at least topP of
+  the probability mass, and draws one of them with a uniform number hashed
+  from the seed and the row
+- A temperature of 0 (or less) picks the first candidate (greedy decoding)
+The row's token id is written to `tokens`. Callers change the seed between
+decode steps.
+*/
+
+// Uniform value in [0, 1) for `row`, from a 32-bit integer hash (lowbias32)
+// of the seed and the row.
+static __device__ __forceinline__ float samplingUniform(uint32_t seed,
+                                                        uint32_t row) {
+  uint32_t x = seed ^ (row * 0x9e3779b9u);
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return (float)(x >> 8) * (1.0f / 16777216.0f);
+}
+
+template <typename T>
+static __device__ __forceinline__ void
+sampleTopP(const T *__restrict__ candidateValues,
+           const int32_t *__restrict__ candidateIndices,
+           int32_t *__restrict__ tokens, int k, float temperature, float topP,
+           int seed) {
+  int row = blockIdx.x;
+  int threadCount = blockDim.x;
+  int laneID = threadIdx.x;
+
+  const T *rowValues = candidateValues + (int64_t)row * k;
+  const int32_t *rowIndices = candidateIndices + (int64_t)row * k;
+
+  if (temperature <= 0.0f || k == 1) {
+    if (laneID == 0)
+      tokens[row] = rowIndices[0];
+    return;
+  }
+
+  // Candidates past SAMPLING_MAX_K carry a negligible part of the mass.
+  int numCandidates = k < SAMPLING_MAX_K ? k : SAMPLING_MAX_K;
+  __shared__ float probs[SAMPLING_MAX_K];
+  float maxVal = (float)rowValues[0];
+  float invTemperature = 1.0f / temperature;
+  for (int i = laneID; i < numCandidates; i += threadCount) {
+    probs[i] = rowIndices[i] < 0
+                   ? 0.0f
+                   : expf(((float)rowValues[i] - maxVal) * invTemperature);
+  }
+  __syncthreads();
+
+  if (laneID != 0)
+    return;
+
+  float total = 0.0f;
+  for (int i = 0; i < numCandidates; ++i)
+    total += probs[i];
+
+  // Nucleus: the smallest prefix with at least topP of the mass.
+  float cutoff = topP * total;
+  float mass = 0.0f;
+  int numNucleus = numCandidates;
+  for (int i = 0; i < numCandidates; ++i) {
+    mass += probs[i];
+    if (mass >= cutoff) {
+      numNucleus = i + 1;
+      break;
+    }
+  }
+
+  float threshold = samplingUniform((uint32_t)seed, (uint32_t)row) * mass;
+  int choice = numNucleus - 1;
+  float cumulative = 0.0f;
+  for (int i = 0; i < numNucleus; ++i) {
+    cumulative += probs[i];
+    if (threshold < cumulative) {
+      choice = i;
+      break;
+    }
+  }
+  tokens[row] = rowIndices[choice];
+}
+
+extern "C" __global__ void
+sample_topp_F16I32(const _Float16 *__restrict__ candidateValues,
+                   const int32_t *__restrict__ candidateIndices,
+                   int32_t *__restrict__ tokens, int k, float temperature,
+                   float topP, int seed) {
+  sampleTopP<_Float16>(candidateValues, candidateIndices, tokens, k,
+                       temperature, topP, seed);
+}
+
+extern "C" __global__ void
+sample_topp_F32I32(const float *__restrict__ candidateValues,
+                   const int32_t *__restrict__ candidateIndices,
+                   int32_t *__restrict__ tokens, int k, float temperature,
+                   float topP, int seed) {
+  sampleTopP<float>(candidateValues, candidateIndices, tokens, k, temperature,
+                    topP, seed);
+}
@@ -8,6 +8,8 @@
 #include <hip/hip_fp16.h>
 #include <hip/hip_runtime.h>
 
+#include "topk_ukernel.h"
+
 #define MAX_K 8 // Upper limit for K, safe for stack on GPU
 
 /*
@@ -126,3 +128,115 @@ extern "C" __global__ void topk_F32I32(const float *__restrict__ inputValues,
     }
   }
 }
+
+// Register-resident TopK kernels (same ABI as topk_F32I32, with K outputs per
+// row), their split-row `_tiles` variants and their `_iota` variants without
+// input indices: see topkShuffle and topkGetTile in topk_ukernel.h.
+#define TOPK_SHUFFLE_KERNEL(name, K)                                           \
+  extern "C" __global__ void name(                                             \
+      const float *__restrict__ inputValues,                                   \
+      const int32_t *__restrict__ inputIndices,                                \
+      float *__restrict__ outputValues, int32_t *__restrict__ outputIndices,   \
+      int reductionSize) {                                                     \
+    TopkTile tile = topkGetTile(blockIdx.x, 0, 1, reductionSize, K);           \
+    topkShuffle<float, K>(inputValues + tile.inputOffset,                      \
+                          inputIndices + tile.inputOffset, tile.begin,         \
+                          tile.length,                                         \
+                          outputValues + tile.outputOffset,                    \
+                          outputIndices + tile.outputOffset);                  \
+  }                                                                            \
+  extern "C" __global__ void name##_tiles(                                     \
+      const float *__restrict__ inputValues,                                   \
+      const int32_t *__restrict__ inputIndices,                                \
+      float *__restrict__ partialValues, int32_t *__restrict__ partialIndices, \
+      int reductionSize, int numTiles) {                                       \
+    TopkTile tile =                                                            \
+        topkGetTile(blockIdx.y, blockIdx.x, numTiles, reductionSize, K);       \
+    topkShuffle<float, K>(inputValues + tile.inputOffset,                      \
+                          inputIndices + tile.inputOffset, tile.begin,         \
+                          tile.length,                                         \
+                          partialValues + tile.outputOffset,                   \
+                          partialIndices + tile.outputOffset);                 \
+  }                                                                            \
+  extern "C" __global__ void name##_iota(                                      \
+      const float *__restrict__ inputValues,                                   \
+      float *__restrict__ outputValues, int32_t *__restrict__ outputIndices,   \
+      int reductionSize) {                                                     \
+    TopkTile tile = topkGetTile(blockIdx.x, 0, 1, reductionSize, K);           \
+    topkShuffle<float, K>(inputValues + tile.inputOffset,                      \
+                          nullptr, tile.begin,                                 \
+                          tile.length,                                         \
+                          outputValues + tile.outputOffset,                    \
+                          outputIndices + tile.outputOffset);                  \
+  }                                                                            \
+  extern "C" __global__ void name##_tiles_iota(                                \
+      const float *__restrict__ inputValues,                                   \
+      float *__restrict__ partialValues, int32_t *__restrict__ partialIndices, \
+      int reductionSize, int numTiles) {                                       \
+    TopkTile tile =                                                            \
+        topkGetTile(blockIdx.y, blockIdx.x, numTiles, reductionSize, K);       \
+    topkShuffle<float, K>(inputValues + tile.inputOffset,                      \
+                          nullptr, tile.begin,                                 \
+                          tile.length,                                         \
+                          partialValues + tile.outputOffset,                   \
+                          partialIndices + tile.outputOffset);                 \
+  }
+
+TOPK_SHUFFLE_KERNEL(topk_F32I32_shuffle, 8)
+TOPK_SHUFFLE_KERNEL(topk_F32I32_k16, 16)
+TOPK_SHUFFLE_KERNEL(topk_F32I32_k32, 32)
+TOPK_SHUFFLE_KERNEL(topk_F32I32_k64, 64)
+
+// Radix-select TopK kernels, with k outputs per row, and the same variants:
+// see topkRadix in topk_ukernel.h.
+#define TOPK_RADIX_KERNEL(name)                                                \
+  extern "C" __global__ void name(                                             \
+      const float *__restrict__ inputValues,                                   \
+      const int32_t *__restrict__ inputIndices,                                \
+      float *__restrict__ outputValues, int32_t *__restrict__ outputIndices,   \
+      int reductionSize, int k) {                                              \
+    TopkTile tile = topkGetTile(blockIdx.x, 0, 1, reductionSize, k);           \
+    topkRadix<float>(inputValues + tile.inputOffset,                           \
+                     inputIndices + tile.inputOffset, tile.begin,              \
+                     tile.length, k,                                           \
+                     outputValues + tile.outputOffset,                         \
+                     outputIndices + tile.outputOffset);                       \
+  }                                                                            \
+  extern "C" __global__ void name##_tiles(                                     \
+      const float *__restrict__ inputValues,                                   \
+      const int32_t *__restrict__ inputIndices,                                \
+      float *__restrict__ partialValues, int32_t *__restrict__ partialIndices, \
+      int reductionSize, int k, int numTiles) {                                \
+    TopkTile tile =                                                            \
+        topkGetTile(blockIdx.y, blockIdx.x, numTiles, reductionSize, k);       \
+    topkRadix<float>(inputValues + tile.inputOffset,                           \
+                     inputIndices + tile.inputOffset, tile.begin,              \
+                     tile.length, k,                                           \
+                     partialValues + tile.outputOffset,                        \
+                     partialIndices + tile.outputOffset);                      \
+  }                                                                            \
+  extern "C" __global__ void name##_iota(                                      \
+      const float *__restrict__ inputValues,                                   \
+      float *__restrict__ outputValues, int32_t *__restrict__ outputIndices,   \
+      int reductionSize, int k) {                                              \
+    TopkTile tile = topkGetTile(blockIdx.x, 0, 1, reductionSize, k);           \
+    topkRadix<float>(inputValues + tile.inputOffset,                           \
+                     nullptr, tile.begin,                                      \
+                     tile.length, k,                                           \
+                     outputValues + tile.outputOffset,                         \
+                     outputIndices + tile.outputOffset);                       \
+  }                                                                            \
+  extern "C" __global__ void name##_tiles_iota(                                \
+      const float *__restrict__ inputValues,                                   \
+      float *__restrict__ partialValues, int32_t *__restrict__ partialIndices, \
+      int reductionSize, int k, int numTiles) {                                \
+    TopkTile tile =                                                            \
+        topkGetTile(blockIdx.y, blockIdx.x, numTiles, reductionSize, k);       \
+    topkRadix<float>(inputValues + tile.inputOffset,                           \
+                     nullptr, tile.begin,                                      \
+                     tile.length, k,                                           \
+                     partialValues + tile.outputOffset,                        \
+                     partialIndices + tile.outputOffset);                      \
+  }
+
+TOPK_RADIX_KERNEL(topk_F32I32_radix)
@@ -0,0 +1,444 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// TopK kernel bodies shared by the fp16 and fp32 ukernels, templated on the
+// element type. The extern "C" entry points selected by specs/*.mlir are
+// defined in topk_fp16_ukernel.c and topk_fp32_ukernel.c.
+
+#pragma once
+
+#include <float.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+#include <stdint.h>
+
+// Element type traits: the lowest value (identity of the max reduction), a
+// warp shuffle, and a bijection to unsigned keys ordered as the values, for
+// the radix select.
+template <typename T> struct TopkTraits;
+
+template <> struct TopkTraits<_Float16> {
+  using Key = uint16_t;
+  static constexpr int kKeyBits = 16;
+  static __device__ __forceinline__ _Float16 lowest() {
+    return (_Float16)(-65504.0f);
+  }
+  static __device__ __forceinline__ _Float16 shuffleXor(_Float16 val,
+                                                        int laneMask) {
+    return (_Float16)__shfl_xor((float)val, laneMask);
+  }
+  static __device__ __forceinline__ uint32_t toKey(_Float16 val) {
+    uint16_t bits = __builtin_bit_cast(uint16_t, val);
+    return (bits & 0x8000u) ? (uint16_t)~bits : (uint16_t)(bits | 0x8000u);
+  }
+  static __device__ __forceinline__ _Float16 fromKey(uint32_t key) {
+    uint16_t bits = (key & 0x8000u) ? (uint16_t)(key & 0x7fffu)
+                                    : (uint16_t)~key;
+    return __builtin_bit_cast(_Float16, bits);
+  }
+};
+
+template <> struct TopkTraits<float> {
+  using Key = uint32_t;
+  static constexpr int kKeyBits = 32;
+  static __device__ __forceinline__ float lowest() { return -FLT_MAX; }
+  static __device__ __forceinline__ float shuffleXor(float val, int laneMask) {
+    return __shfl_xor(val, laneMask);
+  }
+  static __device__ __forceinline__ uint32_t toKey(float val) {
+    uint32_t bits = __builtin_bit_cast(uint32_t, val);
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  }
+  static __device__ __forceinline__ float fromKey(uint32_t key) {
+    uint32_t bits = (key & 0x80000000u) ? (key & 0x7fffffffu) : ~key;
+    return __builtin_bit_cast(float, bits);
+  }
+};
+
+/*
+Register-resident TopK (K a power of two, up to 64):
+- Each lane keeps its top-K candidates sorted in registers
+- Lanes of a warp merge their candidates with a butterfly of warp shuffles,
+  each step keeping the top-K of two sorted lists with a bitonic merge
+- Warps of the workgroup (if more than one) are merged through shared memory
+  by lane 0, with the same register merge
+The workgroup size must be a power of two.
+*/
+
+// Inserts `val` into the descending `vals`, dropping the smallest entry.
+template <typename T, int K>
+static __device__ __forceinline__ void topkInsert(T vals[K], int32_t inds[K],
+                                                  T val, int32_t ind) {
+#pragma unroll
+  for (int j = 0; j < K; ++j) {
+    bool swap = val > vals[j];
+    T currVal = vals[j];
+    int32_t currInd = inds[j];
+    vals[j] = swap ? val : currVal;
+    inds[j] = swap ? ind : currInd;
+    val = swap ? currVal : val;
+    ind = swap ? currInd : ind;
+  }
+}
+
+// Merges the descending `otherVals` into the descending `vals`, keeping the
+// top-K of both: the pairwise max of `vals` and reversed `otherVals` is a
+// bitonic sequence of the top-K, sorted by a bitonic merge.
+template <typename T, int K>
+static __device__ __forceinline__ void topkMerge(T vals[K], int32_t inds[K],
+                                                 const T otherVals[K],
+                                                 const int32_t otherInds[K]) {
+  static_assert((K & (K - 1)) == 0, "K must be a power of two");
+#pragma unroll
+  for (int j = 0; j < K; ++j) {
+    bool swap = otherVals[K - 1 - j] > vals[j];
+    vals[j] = swap ? otherVals[K - 1 - j] : vals[j];
+    inds[j] = swap ? otherInds[K - 1 - j] : inds[j];
+  }
+#pragma unroll
+  for (int dist = K / 2; dist > 0; dist /= 2) {
+#pragma unroll
+    for (int j = 0; j < K; ++j) {
+      if ((j & dist) == 0) {
+        bool swap = vals[j + dist] > vals[j];
+        T val = vals[j];
+        int32_t ind = inds[j];
+        vals[j] = swap ? vals[j + dist] : val;
+        inds[j] = swap ? inds[j + dist] : ind;
+        vals[j + dist] = swap ? val : vals[j + dist];
+        inds[j + dist] = swap ? ind : inds[j + dist];
+      }
+    }
+  }
+}
+
+// Calls `fn(value, index)` for the values of the row assigned to the lane:
+// 16-byte vector loads of the aligned middle of the row, and scalar loads of
+// its ends. Without `rowIndices` (implicit iota indices), the index of value i
+// is `indexBase + i`, and no indices are read.
+template <typename T, typename Fn>
+static __device__ __forceinline__ void
+topkForEachValue(const T *__restrict__ rowValues,
+                 const int32_t *__restrict__ rowIndices, int32_t indexBase,
+                 int length, Fn fn) {
+  constexpr int kVecLength = 16 / sizeof(T);
+  struct alignas(16) ValueVec {
+    T vals[kVecLength];
+  };
+  struct alignas(16) IndexVec {
+    int32_t inds[kVecLength];
+  };
+  int threadCount = blockDim.x;
+  int laneID = threadIdx.x;
+
+  int head = (int)(((16 - ((uintptr_t)rowValues & 15)) & 15) / sizeof(T));
+  head = head < length ? head : length;
+  int numVecs = (length - head) / kVecLength;
+  int tail = head + numVecs * kVecLength;
+
+  for (int i = laneID; i < head; i += threadCount)
+    fn(rowValues[i], rowIndices ? rowIndices[i] : indexBase + i);
+
+  const ValueVec *valueVecs = (const ValueVec *)(rowValues + head);
+  bool indicesAligned =
+      rowIndices && ((uintptr_t)(rowIndices + head) & 15) == 0;
+  for (int v = laneID; v < numVecs; v += threadCount) {
+    ValueVec vals = valueVecs[v];
+    int first = head + v * kVecLength;
+    if (indicesAligned) {
+      IndexVec inds = ((const IndexVec *)(rowIndices + head))[v];
+#pragma unroll
+      for (int j = 0; j < kVecLength; ++j)
+        fn(vals.vals[j], inds.inds[j]);
+    } else {
+#pragma unroll
+      for (int j = 0; j < kVecLength; ++j)
+        fn(vals.vals[j],
+           rowIndices ? rowIndices[first + j] : indexBase + first + j);
+    }
+  }
+
+  for (int i = tail + laneID; i < length; i += threadCount)
+    fn(rowValues[i], rowIndices ? rowIndices[i] : indexBase + i);
+}
+
+// Writes the top-K of the `length` values of `rowValues` and their indices
+// (sorted, padded with the lowest value and index -1) to `outputValues` and
+// `outputIndices`. Indices are read from `rowIndices`, or without it are
+// `indexBase` + the position in the row.
+template <typename T, int K>
+static __device__ __forceinline__ void
+topkShuffle(const T *__restrict__ rowValues,
+            const int32_t *__restrict__ rowIndices, int32_t indexBase,
+            int length, T *__restrict__ outputValues,
+            int32_t *__restrict__ outputIndices) {
+  int threadCount = blockDim.x;
+  int laneID = threadIdx.x;
+
+  T vals[K];
+  int32_t inds[K];
+#pragma unroll
+  for (int j = 0; j < K; ++j) {
+    vals[j] = TopkTraits<T>::lowest();
+    inds[j] = -1;
+  }
+
+  topkForEachValue<T>(rowValues, rowIndices, indexBase, length,
+                      [&](T val, int32_t ind) {
+                        topkInsert<T, K>(vals, inds, val, ind);
+                      });
+
+  // Butterfly merge within the warp: every lane ends with the top-K of it.
+  int warpLanes = threadCount < warpSize ? threadCount : warpSize;
+  for (int offset = 1; offset < warpLanes; offset *= 2) {
+    T otherVals[K];
+    int32_t otherInds[K];
+#pragma unroll
+    for (int j = 0; j < K; ++j) {
+      otherVals[j] = TopkTraits<T>::shuffleXor(vals[j], offset);
+      otherInds[j] = __shfl_xor(inds[j], offset);
+    }
+    topkMerge<T, K>(vals, inds, otherVals, otherInds);
+  }
+
+  // Merge the top-K of each warp in lane 0.
+  __shared__ T warpTopkVals[1024 / 32 * K];
+  __shared__ int32_t warpTopkInds[1024 / 32 * K];
+  int numWarps = threadCount / warpLanes;
+  if (numWarps > 1) {
+    int warpID = laneID / warpSize;
+    if (laneID % warpSize == 0) {
+#pragma unroll
+      for (int j = 0; j < K; ++j) {
+        warpTopkVals[warpID * K + j] = vals[j];
+        warpTopkInds[warpID * K + j] = inds[j];
+      }
+    }
+    __syncthreads();
+    if (laneID == 0) {
+      for (int w = 1; w < numWarps; ++w) {
+        T otherVals[K];
+        int32_t otherInds[K];
+#pragma unroll
+        for (int j = 0; j < K; ++j) {
+          otherVals[j] = warpTopkVals[w * K + j];
+          otherInds[j] = warpTopkInds[w * K + j];
+        }
+        topkMerge<T, K>(vals, inds, otherVals, otherInds);
+      }
+    }
+  }
+
+  if (laneID == 0) {
+#pragma unroll
+    for (int j = 0; j < K; ++j) {
+      outputValues[j] = vals[j];
+      outputIndices[j] = inds[j];
+    }
+  }
+}
+
+/*
+Radix-select TopK (runtime k, for k too large to keep in registers):
+- The workgroup finds the key of the k-th largest value, 8 bits at a time: a
+  shared histogram of the keys matching the bits selected so far picks the
+  bin holding the k-th largest, one pass over the row per byte of the key
+- A last pass gathers the values above it, and as many equal to it as needed
+- The k selected values are sorted in shared memory with a bitonic sort (or,
+  for k above TOPK_RADIX_MAX_K, in the output by lane 0)
+Rows shorter than k are padded with the lowest value and index -1.
+*/
+
+#define TOPK_RADIX_MAX_K 1024
+#define TOPK_RADIX_BINS 256
+
+// Writes the top-k of the `length` values of `rowValues` and their indices
+// (sorted) to `outputValues` and `outputIndices`, with indices as for
+// topkShuffle.
+template <typename T>
+static __device__ __forceinline__ void
+topkRadix(const T *__restrict__ rowValues,
+          const int32_t *__restrict__ rowIndices, int32_t indexBase,
+          int length, int k, T *__restrict__ outputValues,
+          int32_t *__restrict__ outputIndices) {
+  using Traits = TopkTraits<T>;
+  int threadCount = blockDim.x;
+  int laneID = threadIdx.x;
+
+  __shared__ uint32_t histogram[TOPK_RADIX_BINS];
+  __shared__ uint32_t prefix;
+  __shared__ uint32_t prefixMask;
+  __shared__ int remaining;
+  if (laneID == 0) {
+    prefix = 0;
+    prefixMask = 0;
+    remaining = k;
+  }
+
+  // Select the key of the k-th largest value, from the most significant
+  // byte: `remaining` values equal to it are part of the top-k. All values
+  // are selected from rows of at most k values.
+  bool selectAll = length <= k;
+  for (int shift = Traits::kKeyBits - 8; shift >= 0 && !selectAll;
+       shift -= 8) {
+    for (int b = laneID; b < TOPK_RADIX_BINS; b += threadCount)
+      histogram[b] = 0;
+    __syncthreads();
+    topkForEachValue<T>(rowValues, nullptr, 0, length, [&](T val, int32_t) {
+      uint32_t key = Traits::toKey(val);
+      if ((key & prefixMask) == prefix)
+        atomicAdd(&histogram[(key >> shift) & 0xffu], 1u);
+    });
+    __syncthreads();
+    if (laneID == 0) {
+      int count = 0;
+      for (int b = TOPK_RADIX_BINS - 1; b >= 0; --b) {
+        if (count + (int)histogram[b] >= remaining || b == 0) {
+          prefix |= (uint32_t)b << shift;
+          prefixMask |= 0xffu << shift;
+          remaining -= count;
+          break;
+        }
+        count += histogram[b];
+      }
+    }
+    __syncthreads();
+  }
+
+  // Gather the values above the k-th largest, then the values equal to it
+  // after them, in shared memory (or directly in the output for large k).
+  __shared__ uint32_t selectedKeys[TOPK_RADIX_MAX_K];
+  __shared__ int32_t selectedInds[TOPK_RADIX_MAX_K];
+  __shared__ int numAbove;
+  __shared__ int numEqual;
+  bool inShared = k <= TOPK_RADIX_MAX_K;
+  if (laneID == 0) {
+    numAbove = 0;
+    numEqual = 0;
+  }
+  // Pad the selection with the lowest value, and (to a power of two for the
+  // bitonic sort) with the lowest key, which sorts after it.
+  int paddedK = 1;
+  while (paddedK < k)
+    paddedK *= 2;
+  if (inShared) {
+    for (int i = laneID; i < paddedK; i += threadCount) {
+      selectedKeys[i] = i < k ? Traits::toKey(Traits::lowest()) : 0;
+      selectedInds[i] = -1;
+    }
+  } else {
+    for (int i = laneID; i < k; i += threadCount) {
+      outputValues[i] = Traits::lowest();
+      outputIndices[i] = -1;
+    }
+  }
+  __syncthreads();
+  uint32_t threshold = prefix;
+  int numAboveTotal = k - remaining;
+  topkForEachValue<T>(
+      rowValues, rowIndices, indexBase, length, [&](T val, int32_t ind) {
+        uint32_t key = Traits::toKey(val);
+        int pos = -1;
+        if (selectAll || key > threshold) {
+          pos = atomicAdd(&numAbove, 1);
+        } else if (key == threshold) {
+          int equalPos = atomicAdd(&numEqual, 1);
+          if (equalPos < remaining)
+            pos = numAboveTotal + equalPos;
+        }
+        if (pos < 0)
+          return;
+        if (inShared) {
+          selectedKeys[pos] = key;
+          selectedInds[pos] = ind;
+        } else {
+          outputValues[pos] = val;
+          outputIndices[pos] = ind;
+        }
+      });
+  __syncthreads();
+
+  if (!inShared) {
+    // Insertion sort of the output by lane 0, for unusually large k.
+    if (laneID == 0) {
+      for (int i = 1; i < k; ++i) {
+        T val = outputValues[i];
+        int32_t ind = outputIndices[i];
+        int j = i - 1;
+        for (; j >= 0 && outputValues[j] < val; --j) {
+          outputValues[j + 1] = outputValues[j];
+          outputIndices[j + 1] = outputIndices[j];
+        }
+        outputValues[j + 1] = val;
+        outputIndices[j + 1] = ind;
+      }
+    }
+    return;
+  }
+
+  // Bitonic sort (descending) of the selected keys.
+  for (int size = 2; size <= paddedK; size *= 2) {
+    for (int stride = size / 2; stride > 0; stride /= 2) {
+      for (int i = laneID; i < paddedK; i += threadCount) {
+        int j = i ^ stride;
+        if (j <= i)
+          continue;
+        bool descending = (i & size) == 0;
+        if ((selectedKeys[i] < selectedKeys[j]) == descending) {
+          uint32_t key = selectedKeys[i];
+          int32_t ind = selectedInds[i];
+          selectedKeys[i] = selectedKeys[j];
+          selectedInds[i] = selectedInds[j];
+          selectedKeys[j] = key;
+          selectedInds[j] = ind;
+        }
+      }
+      __syncthreads();
+    }
+  }
+
+  for (int i = laneID; i < k; i += threadCount) {
+    outputValues[i] = Traits::fromKey(selectedKeys[i]);
+    outputIndices[i] = selectedInds[i];
+  }
+}
+
+/*
+Split-row TopK (for long rows and small batches, which would otherwise run
+one workgroup per row on a mostly idle GPU):
+- Phase 1 (the `_tiles` kernels): a grid of numTiles x rows workgroups, each
+  writing the top-k of its tile of the row to a partial result of
+  rows x (numTiles * k) values and indices
+- Phase 2: the per-row kernel over the partial results
+The spec picks numTiles (numTiles = 1 is the per-row kernel). The `_iota`
+kernels take no input indices: the index of a value is its position in the
+row (the topk op without indices operand).
+*/
+
+struct TopkTile {
+  int64_t inputOffset;
+  int begin;
+  int length;
+  int64_t outputOffset;
+};
+
+// Returns the values of `tile` (of `numTiles` tiles of equal length) of
+// `row`, and where its top-k goes.
+static __device__ __forceinline__ TopkTile topkGetTile(int row, int tile,
+                                                       int numTiles,
+                                                       int reductionSize,
+                                                       int k) {
+  int tileLength = (reductionSize + numTiles - 1) / numTiles;
+  int begin = tile * tileLength;
+  int length = reductionSize - begin;
+  length = length < 0 ? 0 : (length < tileLength ? length : tileLength);
+  TopkTile result;
+  result.inputOffset = (int64_t)row * reductionSize + begin;
+  result.begin = begin;
+  result.length = length;
+  result.outputOffset = ((int64_t)row * numTiles + tile) * k;
+  return result;
+}
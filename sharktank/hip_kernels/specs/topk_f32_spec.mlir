@@ -19,6 +19,9 @@ module attributes {transform.with_named_sequence} {
     %dim3 = tensor.dim %arg1, %c1 : tensor<?x?xi32>
 
     %dim1_i32 = arith.index_cast %dim1 : index to i32
+    // `topk_F32I32_shuffle` in the same object has the same ABI: it keeps the
+    // candidates of each lane in registers and merges them with warp shuffles,
+    // which is faster for large reduction sizes.
     %4:2 = hal.dispatch.extern "topk_F32I32"[%dim0](%dim1_i32, %arg0, %arg1) : (i32, tensor<?x?xf32>{%dim0, %dim1}, tensor<?x?xi32>{%dim2, %dim3}) -> tensor<?x8xf32>{%dim0}, tensor<?x8xi32>{%dim0}
       count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
         %c1_0 = arith.constant 1 : index
@@ -33,7 +36,7 @@ module attributes {transform.with_named_sequence} {
       objects({
         #rocm_target ordinal(0) = [
           #hal.executable.object<{
-            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.hsaco"
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
           }>
         ]
       })
@@ -41,6 +44,553 @@ module attributes {transform.with_named_sequence} {
     util.return %4#0, %4#1 : tensor<?x8xf32>, tensor<?x8xi32>
   }
 
+  // Kernels for larger k: register-resident ones for k = 16, 32 and 64, and
+  // a radix select for other k (taken from the shape of the output operand),
+  // matched in that order after the k = 8 kernel. They split long rows of
+  // small batches across workgroups in two phases.
+  util.func private @topk_3d_f32_k16_entry_point(%arg0: tensor<?x?xf32>, %arg1: tensor<?x?xi32>) -> (tensor<?x16xf32>, tensor<?x16xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim2 = tensor.dim %arg1, %c0 : tensor<?x?xi32>
+    %dim3 = tensor.dim %arg1, %c1 : tensor<?x?xi32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    %k = arith.constant 16 : index
+
+    // Split each row into numTiles tiles of at least max(4096, k) values, for
+    // up to about 256 workgroups in total: phase 1 writes the top-k of each
+    // tile, phase 2 the top-k of the numTiles * k partial results per row.
+    // Large batches (or short rows) take numTiles = 1, where phase 2 only
+    // copies the k results.
+    %c256 = arith.constant 256 : index
+    %c4096 = arith.constant 4096 : index
+    %batch = arith.maxui %dim0, %c1 : index
+    %maxTilesPerRow = arith.ceildivui %c256, %batch : index
+    %minTileLength = arith.maxui %k, %c4096 : index
+    %tilesPerRow = arith.divui %dim1, %minTileLength : index
+    %numTiles0 = arith.minui %maxTilesPerRow, %tilesPerRow : index
+    %numTiles = arith.maxui %numTiles0, %c1 : index
+    %numTiles_i32 = arith.index_cast %numTiles : index to i32
+    %partialSize = arith.muli %numTiles, %k : index
+    %partialSize_i32 = arith.index_cast %partialSize : index to i32
+    %partial:2 = hal.dispatch.extern "topk_F32I32_k16_tiles"[%numTiles, %dim0](%dim1_i32, %numTiles_i32, %arg0, %arg1) : (i32, i32, tensor<?x?xf32>{%dim0, %dim1}, tensor<?x?xi32>{%dim2, %dim3}) -> tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}
+      count(%device: !hal.device, %tileCount: index, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %tileCount, %batchSize, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 2, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    %4:2 = hal.dispatch.extern "topk_F32I32_k16"[%dim0](%partialSize_i32, %partial#0, %partial#1) : (i32, tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}) -> tensor<?x16xf32>{%dim0}, tensor<?x16xi32>{%dim0}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 1, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x16xf32>, tensor<?x16xi32>
+  }
+
+  util.func private @topk_3d_f32_k32_entry_point(%arg0: tensor<?x?xf32>, %arg1: tensor<?x?xi32>) -> (tensor<?x32xf32>, tensor<?x32xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim2 = tensor.dim %arg1, %c0 : tensor<?x?xi32>
+    %dim3 = tensor.dim %arg1, %c1 : tensor<?x?xi32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    %k = arith.constant 32 : index
+
+    // Two phases, as in @topk_3d_f32_k16_entry_point.
+    %c256 = arith.constant 256 : index
+    %c4096 = arith.constant 4096 : index
+    %batch = arith.maxui %dim0, %c1 : index
+    %maxTilesPerRow = arith.ceildivui %c256, %batch : index
+    %minTileLength = arith.maxui %k, %c4096 : index
+    %tilesPerRow = arith.divui %dim1, %minTileLength : index
+    %numTiles0 = arith.minui %maxTilesPerRow, %tilesPerRow : index
+    %numTiles = arith.maxui %numTiles0, %c1 : index
+    %numTiles_i32 = arith.index_cast %numTiles : index to i32
+    %partialSize = arith.muli %numTiles, %k : index
+    %partialSize_i32 = arith.index_cast %partialSize : index to i32
+    %partial:2 = hal.dispatch.extern "topk_F32I32_k32_tiles"[%numTiles, %dim0](%dim1_i32, %numTiles_i32, %arg0, %arg1) : (i32, i32, tensor<?x?xf32>{%dim0, %dim1}, tensor<?x?xi32>{%dim2, %dim3}) -> tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}
+      count(%device: !hal.device, %tileCount: index, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %tileCount, %batchSize, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 2, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    %4:2 = hal.dispatch.extern "topk_F32I32_k32"[%dim0](%partialSize_i32, %partial#0, %partial#1) : (i32, tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}) -> tensor<?x32xf32>{%dim0}, tensor<?x32xi32>{%dim0}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 1, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x32xf32>, tensor<?x32xi32>
+  }
+
+  util.func private @topk_3d_f32_k64_entry_point(%arg0: tensor<?x?xf32>, %arg1: tensor<?x?xi32>) -> (tensor<?x64xf32>, tensor<?x64xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim2 = tensor.dim %arg1, %c0 : tensor<?x?xi32>
+    %dim3 = tensor.dim %arg1, %c1 : tensor<?x?xi32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    %k = arith.constant 64 : index
+
+    // Two phases, as in @topk_3d_f32_k16_entry_point.
+    %c256 = arith.constant 256 : index
+    %c4096 = arith.constant 4096 : index
+    %batch = arith.maxui %dim0, %c1 : index
+    %maxTilesPerRow = arith.ceildivui %c256, %batch : index
+    %minTileLength = arith.maxui %k, %c4096 : index
+    %tilesPerRow = arith.divui %dim1, %minTileLength : index
+    %numTiles0 = arith.minui %maxTilesPerRow, %tilesPerRow : index
+    %numTiles = arith.maxui %numTiles0, %c1 : index
+    %numTiles_i32 = arith.index_cast %numTiles : index to i32
+    %partialSize = arith.muli %numTiles, %k : index
+    %partialSize_i32 = arith.index_cast %partialSize : index to i32
+    %partial:2 = hal.dispatch.extern "topk_F32I32_k64_tiles"[%numTiles, %dim0](%dim1_i32, %numTiles_i32, %arg0, %arg1) : (i32, i32, tensor<?x?xf32>{%dim0, %dim1}, tensor<?x?xi32>{%dim2, %dim3}) -> tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}
+      count(%device: !hal.device, %tileCount: index, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %tileCount, %batchSize, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 2, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    %4:2 = hal.dispatch.extern "topk_F32I32_k64"[%dim0](%partialSize_i32, %partial#0, %partial#1) : (i32, tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}) -> tensor<?x64xf32>{%dim0}, tensor<?x64xi32>{%dim0}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 1, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x64xf32>, tensor<?x64xi32>
+  }
+
+  util.func private @topk_3d_f32_radix_entry_point(%arg0: tensor<?x?xf32>, %arg1: tensor<?x?xi32>, %arg2: tensor<?x?xf32>) -> (tensor<?x?xf32>, tensor<?x?xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim2 = tensor.dim %arg1, %c0 : tensor<?x?xi32>
+    %dim3 = tensor.dim %arg1, %c1 : tensor<?x?xi32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    // The number of outputs k, from the shape of the output operand.
+    %k = tensor.dim %arg2, %c1 : tensor<?x?xf32>
+    %k_i32 = arith.index_cast %k : index to i32
+
+    // Two phases, as in @topk_3d_f32_k16_entry_point.
+    %c256 = arith.constant 256 : index
+    %c4096 = arith.constant 4096 : index
+    %batch = arith.maxui %dim0, %c1 : index
+    %maxTilesPerRow = arith.ceildivui %c256, %batch : index
+    %minTileLength = arith.maxui %k, %c4096 : index
+    %tilesPerRow = arith.divui %dim1, %minTileLength : index
+    %numTiles0 = arith.minui %maxTilesPerRow, %tilesPerRow : index
+    %numTiles = arith.maxui %numTiles0, %c1 : index
+    %numTiles_i32 = arith.index_cast %numTiles : index to i32
+    %partialSize = arith.muli %numTiles, %k : index
+    %partialSize_i32 = arith.index_cast %partialSize : index to i32
+    %partial:2 = hal.dispatch.extern "topk_F32I32_radix_tiles"[%numTiles, %dim0](%dim1_i32, %k_i32, %numTiles_i32, %arg0, %arg1) : (i32, i32, i32, tensor<?x?xf32>{%dim0, %dim1}, tensor<?x?xi32>{%dim2, %dim3}) -> tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}
+      count(%device: !hal.device, %tileCount: index, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %tileCount, %batchSize, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 3, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    %4:2 = hal.dispatch.extern "topk_F32I32_radix"[%dim0](%partialSize_i32, %k_i32, %partial#0, %partial#1) : (i32, i32, tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}) -> tensor<?x?xf32>{%dim0, %k}, tensor<?x?xi32>{%dim0, %k}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 2, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x?xf32>, tensor<?x?xi32>
+  }
+
+  // Entry points for the topk op without indices operand (implicit iota
+  // indices): the `_iota` kernels compute the indices instead of reading
+  // them, halving the memory traffic. k = 8 uses the register-resident
+  // kernel.
+  util.func private @topk_3d_f32_k8_iota_entry_point(%arg0: tensor<?x?xf32>) -> (tensor<?x8xf32>, tensor<?x8xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    %4:2 = hal.dispatch.extern "topk_F32I32_shuffle_iota"[%dim0](%dim1_i32, %arg0) : (i32, tensor<?x?xf32>{%dim0, %dim1}) -> tensor<?x8xf32>{%dim0}, tensor<?x8xi32>{%dim0}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 1, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x8xf32>, tensor<?x8xi32>
+  }
+
+  util.func private @topk_3d_f32_k16_iota_entry_point(%arg0: tensor<?x?xf32>) -> (tensor<?x16xf32>, tensor<?x16xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    %k = arith.constant 16 : index
+
+    // Two phases, as in @topk_3d_f32_k16_entry_point.
+    %c256 = arith.constant 256 : index
+    %c4096 = arith.constant 4096 : index
+    %batch = arith.maxui %dim0, %c1 : index
+    %maxTilesPerRow = arith.ceildivui %c256, %batch : index
+    %minTileLength = arith.maxui %k, %c4096 : index
+    %tilesPerRow = arith.divui %dim1, %minTileLength : index
+    %numTiles0 = arith.minui %maxTilesPerRow, %tilesPerRow : index
+    %numTiles = arith.maxui %numTiles0, %c1 : index
+    %numTiles_i32 = arith.index_cast %numTiles : index to i32
+    %partialSize = arith.muli %numTiles, %k : index
+    %partialSize_i32 = arith.index_cast %partialSize : index to i32
+    %partial:2 = hal.dispatch.extern "topk_F32I32_k16_tiles_iota"[%numTiles, %dim0](%dim1_i32, %numTiles_i32, %arg0) : (i32, i32, tensor<?x?xf32>{%dim0, %dim1}) -> tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}
+      count(%device: !hal.device, %tileCount: index, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %tileCount, %batchSize, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 2, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    %4:2 = hal.dispatch.extern "topk_F32I32_k16"[%dim0](%partialSize_i32, %partial#0, %partial#1) : (i32, tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}) -> tensor<?x16xf32>{%dim0}, tensor<?x16xi32>{%dim0}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 1, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x16xf32>, tensor<?x16xi32>
+  }
+
+  util.func private @topk_3d_f32_k32_iota_entry_point(%arg0: tensor<?x?xf32>) -> (tensor<?x32xf32>, tensor<?x32xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    %k = arith.constant 32 : index
+
+    // Two phases, as in @topk_3d_f32_k16_entry_point.
+    %c256 = arith.constant 256 : index
+    %c4096 = arith.constant 4096 : index
+    %batch = arith.maxui %dim0, %c1 : index
+    %maxTilesPerRow = arith.ceildivui %c256, %batch : index
+    %minTileLength = arith.maxui %k, %c4096 : index
+    %tilesPerRow = arith.divui %dim1, %minTileLength : index
+    %numTiles0 = arith.minui %maxTilesPerRow, %tilesPerRow : index
+    %numTiles = arith.maxui %numTiles0, %c1 : index
+    %numTiles_i32 = arith.index_cast %numTiles : index to i32
+    %partialSize = arith.muli %numTiles, %k : index
+    %partialSize_i32 = arith.index_cast %partialSize : index to i32
+    %partial:2 = hal.dispatch.extern "topk_F32I32_k32_tiles_iota"[%numTiles, %dim0](%dim1_i32, %numTiles_i32, %arg0) : (i32, i32, tensor<?x?xf32>{%dim0, %dim1}) -> tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}
+      count(%device: !hal.device, %tileCount: index, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %tileCount, %batchSize, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 2, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    %4:2 = hal.dispatch.extern "topk_F32I32_k32"[%dim0](%partialSize_i32, %partial#0, %partial#1) : (i32, tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}) -> tensor<?x32xf32>{%dim0}, tensor<?x32xi32>{%dim0}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 1, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x32xf32>, tensor<?x32xi32>
+  }
+
+  util.func private @topk_3d_f32_k64_iota_entry_point(%arg0: tensor<?x?xf32>) -> (tensor<?x64xf32>, tensor<?x64xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    %k = arith.constant 64 : index
+
+    // Two phases, as in @topk_3d_f32_k16_entry_point.
+    %c256 = arith.constant 256 : index
+    %c4096 = arith.constant 4096 : index
+    %batch = arith.maxui %dim0, %c1 : index
+    %maxTilesPerRow = arith.ceildivui %c256, %batch : index
+    %minTileLength = arith.maxui %k, %c4096 : index
+    %tilesPerRow = arith.divui %dim1, %minTileLength : index
+    %numTiles0 = arith.minui %maxTilesPerRow, %tilesPerRow : index
+    %numTiles = arith.maxui %numTiles0, %c1 : index
+    %numTiles_i32 = arith.index_cast %numTiles : index to i32
+    %partialSize = arith.muli %numTiles, %k : index
+    %partialSize_i32 = arith.index_cast %partialSize : index to i32
+    %partial:2 = hal.dispatch.extern "topk_F32I32_k64_tiles_iota"[%numTiles, %dim0](%dim1_i32, %numTiles_i32, %arg0) : (i32, i32, tensor<?x?xf32>{%dim0, %dim1}) -> tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}
+      count(%device: !hal.device, %tileCount: index, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %tileCount, %batchSize, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 2, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    %4:2 = hal.dispatch.extern "topk_F32I32_k64"[%dim0](%partialSize_i32, %partial#0, %partial#1) : (i32, tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}) -> tensor<?x64xf32>{%dim0}, tensor<?x64xi32>{%dim0}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 1, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x64xf32>, tensor<?x64xi32>
+  }
+
+  util.func private @topk_3d_f32_radix_iota_entry_point(%arg0: tensor<?x?xf32>, %arg1: tensor<?x?xf32>) -> (tensor<?x?xf32>, tensor<?x?xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+    %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+
+    %dim1_i32 = arith.index_cast %dim1 : index to i32
+    %k = tensor.dim %arg1, %c1 : tensor<?x?xf32>
+    %k_i32 = arith.index_cast %k : index to i32
+
+    // Two phases, as in @topk_3d_f32_k16_entry_point.
+    %c256 = arith.constant 256 : index
+    %c4096 = arith.constant 4096 : index
+    %batch = arith.maxui %dim0, %c1 : index
+    %maxTilesPerRow = arith.ceildivui %c256, %batch : index
+    %minTileLength = arith.maxui %k, %c4096 : index
+    %tilesPerRow = arith.divui %dim1, %minTileLength : index
+    %numTiles0 = arith.minui %maxTilesPerRow, %tilesPerRow : index
+    %numTiles = arith.maxui %numTiles0, %c1 : index
+    %numTiles_i32 = arith.index_cast %numTiles : index to i32
+    %partialSize = arith.muli %numTiles, %k : index
+    %partialSize_i32 = arith.index_cast %partialSize : index to i32
+    %partial:2 = hal.dispatch.extern "topk_F32I32_radix_tiles_iota"[%numTiles, %dim0](%dim1_i32, %k_i32, %numTiles_i32, %arg0) : (i32, i32, i32, tensor<?x?xf32>{%dim0, %dim1}) -> tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}
+      count(%device: !hal.device, %tileCount: index, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %tileCount, %batchSize, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 3, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    %4:2 = hal.dispatch.extern "topk_F32I32_radix"[%dim0](%partialSize_i32, %k_i32, %partial#0, %partial#1) : (i32, i32, tensor<?x?xf32>{%dim0, %partialSize}, tensor<?x?xi32>{%dim0, %partialSize}) -> tensor<?x?xf32>{%dim0, %k}, tensor<?x?xi32>{%dim0, %k}
+      count(%device: !hal.device, %batchSize: index) -> (index, index, index) {
+        %c1_0 = arith.constant 1 : index
+        hal.return %batchSize, %c1_0, %c1_0 : index, index, index
+      }
+      layout(#hal.pipeline.layout<constants = 2, bindings = [
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer, ReadOnly>,
+        #hal.pipeline.binding<storage_buffer>,
+        #hal.pipeline.binding<storage_buffer>
+      ]>)
+      objects({
+        #rocm_target ordinal(0) = [
+          #hal.executable.object<{
+            path = "{{BUILD}}/compiled_kernels/topk_fp32_ukernel.c.{{HIP_ARCH}}.hsaco"
+          }>
+        ]
+      })
+      attributes {subgroupSize = 64, workgroup_size = [64 : index, 1 : index, 1 : index]}
+    util.return %4#0, %4#1 : tensor<?x?xf32>, tensor<?x?xi32>
+  }
+
   transform.named_sequence @match_topk(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
     transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
     %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
@@ -56,6 +606,123 @@ module attributes {transform.with_named_sequence} {
     transform.yield %linalg : !transform.any_op
   }
 
+  transform.named_sequence @match_topk_k16(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in0[1], 64 : !transform.any_value
+    %in1 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in1 = tensor<?x?xi32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in1[1], 64 : !transform.any_value
+    %out0 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x16xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[3] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x16xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
+  transform.named_sequence @match_topk_k32(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in0[1], 64 : !transform.any_value
+    %in1 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in1 = tensor<?x?xi32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in1[1], 64 : !transform.any_value
+    %out0 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x32xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[3] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x32xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
+  transform.named_sequence @match_topk_k64(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in0[1], 64 : !transform.any_value
+    %in1 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in1 = tensor<?x?xi32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in1[1], 64 : !transform.any_value
+    %out0 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x64xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[3] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x64xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
+  transform.named_sequence @match_topk_radix(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    %in1 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in1 = tensor<?x?xi32> : !transform.any_value
+    %out0 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x?xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[3] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x?xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
+  transform.named_sequence @match_topk_k8_iota(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in0[1], 64 : !transform.any_value
+    %out0 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x8xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x8xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
+  transform.named_sequence @match_topk_k16_iota(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in0[1], 64 : !transform.any_value
+    %out0 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x16xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x16xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
+  transform.named_sequence @match_topk_k32_iota(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in0[1], 64 : !transform.any_value
+    %out0 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x32xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x32xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
+  transform.named_sequence @match_topk_k64_iota(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    transform.iree.match.dim_is_multiple_of %in0[1], 64 : !transform.any_value
+    %out0 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x64xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x64xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
+  transform.named_sequence @match_topk_radix_iota(%linalg: !transform.any_op {transform.readonly}) -> (!transform.any_op) {
+    transform.match.operation_name %linalg ["iree_linalg_ext.topk"] : !transform.any_op
+    %in0 = transform.get_operand %linalg[0] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %in0 = tensor<?x?xf32> : !transform.any_value
+    %out0 = transform.get_operand %linalg[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out0 = tensor<?x?xf32> : !transform.any_value
+    %out1 = transform.get_operand %linalg[2] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %out1 = tensor<?x?xi32> : !transform.any_value
+    transform.yield %linalg : !transform.any_op
+  }
+
   transform.named_sequence @cast_and_call_topk(%topk: !transform.any_op {transform.readonly}) {
     %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
     %func = transform.util.import_symbol @topk_3d_f32_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
@@ -67,12 +734,120 @@ module attributes {transform.with_named_sequence} {
     transform.yield
   }
 
+  transform.named_sequence @cast_and_call_topk_k16(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_k16_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0,1] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
+  transform.named_sequence @cast_and_call_topk_k32(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_k32_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0,1] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
+  transform.named_sequence @cast_and_call_topk_k64(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_k64_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0,1] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
+  transform.named_sequence @cast_and_call_topk_radix(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_radix_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0,1,2] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
+  transform.named_sequence @cast_and_call_topk_k8_iota(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_k8_iota_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
+  transform.named_sequence @cast_and_call_topk_k16_iota(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_k16_iota_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
+  transform.named_sequence @cast_and_call_topk_k32_iota(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_k32_iota_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
+  transform.named_sequence @cast_and_call_topk_k64_iota(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_k64_iota_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
+  transform.named_sequence @cast_and_call_topk_radix_iota(%topk: !transform.any_op {transform.readonly}) {
+    %module = transform.util.get_nearest_symbol_table %topk : (!transform.any_op) -> !transform.any_op
+    %func = transform.util.import_symbol @topk_3d_f32_radix_iota_entry_point into %module if undefined : (!transform.any_op) -> !transform.any_op
+    %ins = transform.get_operand %topk[0,1] : (!transform.any_op) -> !transform.any_value
+    %outs = transform.get_result %topk[all] : (!transform.any_op) -> !transform.any_value
+    transform.util.cast_and_call %func(%ins) -> %outs before %topk {
+      transform.type_conversion.tensor.cast_shape_dynamic_dims
+    } : (!transform.any_op, !transform.any_value, !transform.any_value, !transform.any_op) -> !transform.any_op
+    transform.yield
+  }
+
   transform.named_sequence @__transform_main(%module: !transform.any_op) {
     %funcs = transform.structured.match ops{["util.func"]} in %module : (!transform.any_op) -> !transform.any_op
     transform.foreach %funcs : !transform.any_op {
       ^bb1(%func: !transform.any_op):
         transform.foreach_match in %func
-            @match_topk -> @cast_and_call_topk
+            @match_topk -> @cast_and_call_topk,
+            @match_topk_k16 -> @cast_and_call_topk_k16,
+            @match_topk_k32 -> @cast_and_call_topk_k32,
+            @match_topk_k64 -> @cast_and_call_topk_k64,
+            @match_topk_radix -> @cast_and_call_topk_radix,
+            @match_topk_k8_iota -> @cast_and_call_topk_k8_iota,
+            @match_topk_k16_iota -> @cast_and_call_topk_k16_iota,
+            @match_topk_k32_iota -> @cast_and_call_topk_k32_iota,
+            @match_topk_k64_iota -> @cast_and_call_topk_k64_iota,
+            @match_topk_radix_iota -> @cast_and_call_topk_radix_iota
           : (!transform.any_op) -> (!transform.any_op)
     }
     transform.apply_dce to %module : !transform.any_op
@@ -0,0 +1,187 @@
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <hip/hip_runtime.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define IREE_HAL_ROCM_MAX_KERNEL_ARG 128
+
+constexpr int batchSize = 4;
+constexpr int k = 16;
+constexpr int TOKEN_OFFSET = 100; // Token id of the largest candidate
+
+std::vector<char> readFileIntoVector(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    std::cerr << "Unable to open file: " << filename << std::endl;
+    return std::vector<char>();
+  }
+  std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  std::vector<char> buffer(size);
+  file.read(buffer.data(), size);
+  file.close();
+  return buffer;
+}
+
+// Candidates sorted descending, as written by the topk kernels: logits
+// 8, 7, 6, ... for tokens TOKEN_OFFSET, TOKEN_OFFSET + 1, ...
+static float candidateLogit(int j) { return 8.0f - j; }
+
+// Number of candidates in the nucleus of `topP` at `temperature`.
+static int nucleusSize(float temperature, float topP) {
+  std::vector<float> probs(k);
+  float total = 0.0f;
+  for (int j = 0; j < k; ++j) {
+    probs[j] = std::exp((candidateLogit(j) - candidateLogit(0)) / temperature);
+    total += probs[j];
+  }
+  float mass = 0.0f;
+  for (int j = 0; j < k; ++j) {
+    mass += probs[j];
+    if (mass >= topP * total)
+      return j + 1;
+  }
+  return k;
+}
+
+static std::vector<int32_t> sample(hipFunction_t kernel, void *d_values,
+                                   int32_t *d_indices, int32_t *d_tokens,
+                                   float temperature, float topP, int seed) {
+  void **kernelParam =
+      (void **)malloc(IREE_HAL_ROCM_MAX_KERNEL_ARG * sizeof(void *));
+  hipDeviceptr_t *device_ptrs = (hipDeviceptr_t *)malloc(
+      IREE_HAL_ROCM_MAX_KERNEL_ARG * sizeof(hipDeviceptr_t));
+  for (size_t i = 0; i < IREE_HAL_ROCM_MAX_KERNEL_ARG; i++) {
+    kernelParam[i] = &device_ptrs[i];
+  }
+
+  *((hipDeviceptr_t *)kernelParam[0]) = d_values;
+  *((hipDeviceptr_t *)kernelParam[1]) = d_indices;
+  *((hipDeviceptr_t *)kernelParam[2]) = d_tokens;
+  *((int32_t *)kernelParam[3]) = k;
+  *((float *)kernelParam[4]) = temperature;
+  *((float *)kernelParam[5]) = topP;
+  *((int32_t *)kernelParam[6]) = seed;
+
+  CHECK_HIP_ERROR(hipModuleLaunchKernel(kernel, batchSize, 1, 1, 64, 1, 1, 0,
+                                        nullptr, kernelParam, nullptr));
+  CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+  std::vector<int32_t> tokens(batchSize);
+  CHECK_HIP_ERROR(hipMemcpy(tokens.data(), d_tokens,
+                            tokens.size() * sizeof(int32_t),
+                            hipMemcpyDeviceToHost));
+  free(kernelParam);
+  free(device_ptrs);
+  return tokens;
+}
+
+static void expectInNucleus(const std::vector<int32_t> &tokens,
+                            int numNucleus, const char *what) {
+  for (int32_t token : tokens) {
+    if (token < TOKEN_OFFSET || token >= TOKEN_OFFSET + numNucleus) {
+      std::cerr << "Validation failed (" << what << ")! Token " << token
+                << " outside of the " << numNucleus << " nucleus candidates"
+                << std::endl;
+      exit(1);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 2) {
+    std::cout << "Usage: " << argv[0] << " [kernelName]" << std::endl;
+    std::cout << "  kernelName: sample_topp_F16I32 (default) or "
+              << "sample_topp_F32I32" << std::endl;
+    return 1;
+  }
+  std::string kernelName = argc == 2 ? argv[1] : "sample_topp_F16I32";
+  bool isF16 = kernelName == "sample_topp_F16I32";
+
+  std::vector<float16_t> valuesF16(batchSize * k);
+  std::vector<float> valuesF32(batchSize * k);
+  std::vector<int32_t> indices(batchSize * k);
+  for (int i = 0; i < batchSize; ++i) {
+    for (int j = 0; j < k; ++j) {
+      valuesF16[i * k + j] = float2half(candidateLogit(j), FP16_EXP_BITS);
+      valuesF32[i * k + j] = candidateLogit(j);
+      indices[i * k + j] = TOKEN_OFFSET + j;
+    }
+  }
+
+  void *d_values;
+  int32_t *d_indices;
+  int32_t *d_tokens;
+  size_t bytesValues = isF16 ? valuesF16.size() * sizeof(float16_t)
+                             : valuesF32.size() * sizeof(float);
+  CHECK_HIP_ERROR(hipMalloc(&d_values, bytesValues));
+  CHECK_HIP_ERROR(hipMalloc(&d_indices, indices.size() * sizeof(int32_t)));
+  CHECK_HIP_ERROR(hipMalloc(&d_tokens, batchSize * sizeof(int32_t)));
+  CHECK_HIP_ERROR(hipMemcpy(d_values,
+                            isF16 ? (void *)valuesF16.data()
+                                  : (void *)valuesF32.data(),
+                            bytesValues, hipMemcpyHostToDevice));
+  CHECK_HIP_ERROR(hipMemcpy(d_indices, indices.data(),
+                            indices.size() * sizeof(int32_t),
+                            hipMemcpyHostToDevice));
+
+  hipModule_t module;
+  hipFunction_t kernel;
+  std::vector<char> hsacoVec =
+      readFileIntoVector(getHsacoPath("sampling_ukernel.c"));
+  if (hipModuleLoadDataEx(&module, hsacoVec.data(), 0, nullptr, nullptr) !=
+      hipSuccess) {
+    std::cerr << "Failed to load module!" << std::endl;
+    return 1;
+  }
+  if (hipModuleGetFunction(&kernel, module, kernelName.c_str()) !=
+      hipSuccess) {
+    std::cerr << "Failed to get function!" << std::endl;
+    return 1;
+  }
+
+  // Greedy decoding, and a nucleus of the largest candidate only.
+  expectInNucleus(sample(kernel, d_values, d_indices, d_tokens, 0.0f, 0.9f, 1),
+                  1, "greedy");
+  expectInNucleus(
+      sample(kernel, d_values, d_indices, d_tokens, 1.0f, 0.01f, 1), 1,
+      "top-p 0.01");
+
+  // Samples from a wider nucleus stay in it, are reproducible for a seed, and
+  // vary with it.
+  float temperature = 2.0f;
+  float topP = 0.9f;
+  int numNucleus = nucleusSize(temperature, topP);
+  std::vector<int32_t> first;
+  bool varied = false;
+  for (int seed = 0; seed < 64; ++seed) {
+    std::vector<int32_t> tokens = sample(kernel, d_values, d_indices, d_tokens,
+                                         temperature, topP, seed);
+    expectInNucleus(tokens, numNucleus, "top-p 0.9");
+    if (tokens != sample(kernel, d_values, d_indices, d_tokens, temperature,
+                         topP, seed)) {
+      std::cerr << "Validation failed! Seed " << seed << " not reproducible"
+                << std::endl;
+      exit(1);
+    }
+    if (first.empty())
+      first = tokens;
+    varied |= tokens != first;
+  }
+  if (!varied) {
+    std::cerr << "Validation failed! Samples do not vary with the seed"
+              << std::endl;
+    exit(1);
+  }
+
+  std::cout << "Sampling kernel validated successfully!" << std::endl;
+
+  CHECK_HIP_ERROR(hipFree(d_values));
+  CHECK_HIP_ERROR(hipFree(d_indices));
+  CHECK_HIP_ERROR(hipFree(d_tokens));
+  return 0;
+}
@@ -12,7 +12,8 @@
 
 constexpr uint32_t recordRuns = 100u;
 constexpr int ARGMAX_LABEL = 7; // Will still be top-1 here
-constexpr int k = 8;
+// Number of outputs per row: 8, or that of the `_k<N>` and `_radix` kernels.
+static int k = 8;
 
 template <typename DataT>
 static inline void fillValues(DataT *mat, uint32_t m, uint32_t n, int k) {
@@ -52,7 +53,7 @@ std::vector<char> readFileIntoVector(const std::string &filename) {
   return buffer;
 }
 
-void benchmark_module(size_t reductionSize) {
+void benchmark_module(size_t reductionSize, const char *kernelName) {
   int batchSize = 1;
 
   std::vector<INPUT_TY> inputValues(batchSize * reductionSize);
@@ -87,13 +88,13 @@ void benchmark_module(size_t reductionSize) {
   hipModule_t module;
   hipFunction_t kernel;
   std::vector<char> hsacoVec =
-      readFileIntoVector("compiled_kernels/topk_fp32_ukernel.c.hsaco");
+      readFileIntoVector(getHsacoPath("topk_fp32_ukernel.c"));
   if (hipModuleLoadDataEx(&module, hsacoVec.data(), 0, nullptr, nullptr) !=
       hipSuccess) {
     std::cerr << "Failed to load module!" << std::endl;
     return;
   }
-  if (hipModuleGetFunction(&kernel, module, "topk_F32I32") != hipSuccess) {
+  if (hipModuleGetFunction(&kernel, module, kernelName) != hipSuccess) {
     std::cerr << "Failed to get function!" << std::endl;
     return;
   }
@@ -174,13 +175,17 @@ void benchmark_module(size_t reductionSize) {
 }
 
 int main(int argc, char *argv[]) {
-  if (argc != 2) {
-    std::cout << "Usage: " << argv[0] << " reductionSize" << std::endl;
-    // std::cout << "Usage: " << argv[1] << " K" << std::endl;
+  if (argc < 2 || argc > 4) {
+    std::cout << "Usage: " << argv[0] << " reductionSize [kernelName [k]]"
+              << std::endl;
+    std::cout << "  kernelName: topk_F32I32 (default), topk_F32I32_shuffle, "
+              << "topk_F32I32_k<16|32|64> or topk_F32I32_radix" << std::endl;
     return 1;
   }
   size_t reductionSize = atoi(argv[1]);
-  // int k = atoi(argv[2]);
-  benchmark_module(reductionSize);
+  const char *kernelName = argc >= 3 ? argv[2] : "topk_F32I32";
+  if (argc == 4)
+    k = atoi(argv[3]);
+  benchmark_module(reductionSize, kernelName);
   return 0;
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <hip/hip_runtime.h>
 #include <numeric>
+#include <string>
 
 #define FP16_EXP_BITS (5)
 
@@ -142,6 +144,16 @@ static inline uint16_t float2half(float value, int exp_bits) {
   return f16_value;
 }
 
+// Returns the path of `kernelFile` (e.g. topk_fp16_ukernel.c) built for the
+// architecture of device 0, relative to the build directory.
+static inline std::string getHsacoPath(const std::string &kernelFile) {
+  hipDeviceProp_t props;
+  CHECK_HIP_ERROR(hipGetDeviceProperties(&props, 0));
+  std::string arch = props.gcnArchName;
+  arch = arch.substr(0, arch.find(':'));
+  return "compiled_kernels/" + kernelFile + "." + arch + ".hsaco";
+}
+
 using float16_t = uint16_t;
 using float32_t = float;
 template <typename DataT>
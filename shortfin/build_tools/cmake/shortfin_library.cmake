@@ -187,6 +187,29 @@ function(shortfin_gtest_test)
   )
 endfunction()
 
+# Adds a google-benchmark executable, built with SHORTFIN_BUILD_BENCHMARKS.
+# Benchmarks are not registered as tests: they are run directly, i.e.
+#   shortfin_local_benchmark --benchmark_filter=BM_CallThreadsafe
+function(shortfin_benchmark)
+  cmake_parse_arguments(
+    _RULE
+    ""
+    "NAME"
+    "SRCS;DEPS"
+    ${ARGN}
+  )
+
+  if(NOT SHORTFIN_BUILD_BENCHMARKS)
+    return()
+  endif()
+
+  add_executable(${_RULE_NAME} ${_RULE_SRCS})
+  target_link_libraries(${_RULE_NAME} PRIVATE
+    ${_RULE_DEPS}
+    ${SHORTFIN_LINK_LIBRARY_NAME}
+    benchmark::benchmark_main
+  )
+endfunction()
 
 # Make changes to the global compile flags and properties before including
 # bundled deps. This configures various options aimed at making the bundled
@@ -0,0 +1,94 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+r"""Measures the throughput of host array ops run from several Python threads.
+
+Host ops over large arrays release the GIL, so they should scale with threads
+(up to the core count) rather than run one at a time. Each thread works on its
+own arrays; the total over all threads is reported per thread count::
+
+  python examples/python/host_ops_threads_benchmark.py --threads 1 2 4 8
+
+"""
+
+import argparse
+import threading
+import time
+
+import shortfin as sf
+import shortfin.array as sfnp
+
+
+def make_ops(device, rows: int, cols: int):
+    """Returns the benchmarked ops, each as a closure over its own arrays."""
+    logits = sfnp.device_array.for_host(device, [rows, cols], sfnp.float32)
+    sfnp.fill_randn(logits)
+    probs = sfnp.device_array.for_host(device, [rows, cols], sfnp.float32)
+    half = sfnp.device_array.for_host(device, [rows, cols], sfnp.float16)
+    noise = sfnp.device_array.for_host(device, [rows, cols], sfnp.float32)
+    generator = sfnp.RandomGenerator()
+    return {
+        "softmax": lambda: sfnp.softmax(logits, out=probs),
+        "argmax": lambda: sfnp.argmax(logits),
+        "convert": lambda: sfnp.convert(logits, out=half),
+        "fill_randn": lambda: sfnp.fill_randn(noise, generator=generator),
+        "map": lambda: logits.map(read=True).close(),
+    }
+
+
+def run(device, op: str, num_threads: int, rows: int, cols: int, seconds: float):
+    ops = [make_ops(device, rows, cols)[op] for _ in range(num_threads)]
+    counts = [0] * num_threads
+    start = threading.Barrier(num_threads + 1)
+    stop = threading.Event()
+
+    def worker(i: int):
+        start.wait()
+        while not stop.is_set():
+            ops[i]()
+            counts[i] += 1
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(num_threads)]
+    for t in threads:
+        t.start()
+    start.wait()
+    begin = time.perf_counter()
+    time.sleep(seconds)
+    stop.set()
+    for t in threads:
+        t.join()
+    return sum(counts) / (time.perf_counter() - begin)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--threads", type=int, nargs="+", default=[1, 2, 4, 8])
+    parser.add_argument(
+        "--ops",
+        nargs="+",
+        default=["softmax", "argmax", "convert", "fill_randn", "map"],
+    )
+    parser.add_argument("--rows", type=int, default=8)
+    parser.add_argument("--cols", type=int, default=32000)
+    parser.add_argument("--seconds", type=float, default=1.0)
+    args = parser.parse_args()
+
+    ls = sf.host.CPUSystemBuilder().create_system()
+    try:
+        device = ls.create_fiber().device(0)
+        print("op,threads,ops/s,speedup")
+        for op in args.ops:
+            base = None
+            for num_threads in args.threads:
+                rate = run(device, op, num_threads, args.rows, args.cols, args.seconds)
+                base = base or rate
+                print(f"{op},{num_threads},{rate:.0f},{rate / base:.2f}")
+    finally:
+        ls.shutdown()
+
+
+if __name__ == "__main__":
+    main()
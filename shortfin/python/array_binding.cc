@@ -4,6 +4,8 @@
 // See https://llvm.org/LICENSE.txt for license information.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include <nanobind/ndarray.h>
+
 #include "./lib_ext.h"
 #include "./utils.h"
 #include "shortfin/array/api.h"
@@ -17,13 +19,39 @@ namespace {
 static const char DOCSTRING_ARRAY_COPY_FROM[] =
     R"(Copy contents from a source array to this array.
 
-Equivalent to `dest_array.storage.copy_from(source_array.storage)`.
+Equivalent to `dest_array.storage.copy_from(source_array.storage)` for dense
+arrays. If either array is a strided view, both must have the same shape and
+dtype and only the viewed elements are copied.
 )";
 
 static const char DOCSTRING_ARRAY_COPY_TO[] =
     R"(Copy contents this array to a destination array.
 
-Equivalent to `dest_array.storage.copy_from(source_array.storage)`.
+Equivalent to `dest_array.storage.copy_from(source_array.storage)` for dense
+arrays. Strided views are handled as in `copy_from`.
+)";
+
+static const char DOCSTRING_ARRAY_COPY_ROWS_FROM[] =
+    R"(Copy rows of a source array to rows of this array in one transfer.
+
+Row `source_rows[i]` (an index along the leading dim) of `source_array` is
+copied to row `target_rows[i]` of this array, for each `i`. All of the copies
+are recorded into a single command buffer, making this much cheaper than a
+`copy_from` per row when copying many pages of a KV cache page table. As with
+`copy_from`, the copy is asynchronous.
+
+Both arrays must be dense, with the same dtype and shape past the leading dim.
+The copies are unordered with respect to each other: no row may be written
+twice, nor (for copies within one array) be both read and written.
+)";
+
+static const char DOCSTRING_ARRAY_CONTIGUOUS[] =
+    R"(Returns a dense copy of a strided view.
+
+Dense arrays are returned as is. Otherwise a new array of the same shape is
+allocated (on the host if this array is host mappable, on the device otherwise)
+and the viewed elements are copied into it on the device's queue. As with
+`copy_from`, the copy is asynchronous.
 )";
 
 static const char DOCSTRING_ARRAY_FILL[] = R"(Fill an array with a value.
@@ -60,12 +88,45 @@ See also `storage.map()` which functions similarly but does not allow access
 to dtype specific functionality.
 )";
 
+static const char DOCSTRING_ARRAY_MAP_ASYNC[] =
+    R"(Asynchronously create a typed mapping of the buffer contents.
+
+Takes the same kwargs as `map()` and returns an awaitable `MappingFuture`
+resolving to the mapping once prior device work on the array has reached its
+barrier. See `storage.map_async()`.
+)";
+
+static const char DOCSTRING_ARRAY_DLPACK[] =
+    R"(Exports the array via the DLPack protocol without copying.
+
+Consumers such as `numpy.from_dlpack` and `torch.from_dlpack` alias the array's
+host memory, which stays alive for as long as they reference it. Strided views
+export with their strides. The storage
+must be host mappable (device arrays can be staged with `for_transfer()`).
+As with `map()`, pending device work on the array must have been awaited
+first.
+)";
+
+static const char DOCSTRING_ARRAY_FROM_DLPACK[] =
+    R"(Imports a host tensor supporting the DLPack protocol without copying.
+
+The tensor must be C-contiguous in host memory. The returned array aliases its
+memory and keeps the producer's tensor alive until the buffer is released by
+shortfin, including by any device work still using it.
+)";
+
 static const char DOCSTRING_ARRAY_VIEW[] =
     R"(Create a view of an array.
 
 Either integer indices or slices can be passed to the view() method to create
 an aliased device_array that shares a subset of the storage. Only view()
-organizations that result in a row-major, dense array are currently supported.
+organizations that result in a row-major, dense array produce a dense array.
+Others, such as slicing a non-leading dim or using a slice step, produce a
+strided view without copying.
+
+Strided views can be copied to and from (see `copy_from`), viewed further and
+exported via DLPack, but must be made dense with `contiguous()` before being
+passed to a program, mapped or used with host ops.
 )";
 
 static const char DOCSTRING_MAPPING_FILL[] =
@@ -100,6 +161,97 @@ This operation executes asynchronously and the effect will only be visible
 once the execution fiber has been synced to the point of mutation.
 )";
 
+static const char DOCSTRING_STORAGE_ENABLE_SUBRANGE_TRACKING[] =
+    R"(Opts the underlying allocation into subrange scheduling.
+
+By default, a storage (and all subspans of it) is scheduled as a single unit:
+any write waits on all prior reads and writes. Once subrange tracking is
+enabled, transfers and program invocations are tracked per byte range, so
+operations on disjoint subspans of the same allocation do not wait on each
+other. This cannot be disabled once enabled.
+)";
+
+static const char DOCSTRING_STORAGE_EXPORT_SHARED[] =
+    R"(Exports this storage for import by a different fiber.
+
+The result may be passed to a fiber on another worker, which calls
+`storage.import_shared(device, exported)` to get a storage whose operations
+wait device-side for the current contents of this storage, without a host
+sync. This storage continues to own the allocation: before releasing or
+mutating it, hand the importer's uses back with
+`importer.export_barrier(include_uses=True)` and
+`self.import_barrier(barrier, write=False)`.
+)";
+
+static const char DOCSTRING_STORAGE_EXPORT_IPC_HANDLE[] =
+    R"(Exports this storage for import by other processes on the same host.
+
+Returns bytes which another process passes to
+`storage.import_ipc_handle(device, handle)` on the same physical device to
+get read only storage backed by the same memory (i.e. the weights of a
+program served by several processes). This process must keep the storage
+alive and unchanged while others use it, and must have awaited the writing of
+its contents before sending the handle. Only devices which support it (AMD
+GPUs, for buffers not allocated asynchronously) can export memory.
+)";
+
+static const char DOCSTRING_STORAGE_IMPORT_IPC_HANDLE[] =
+    R"(Imports storage exported by another process with `export_ipc_handle()`.
+
+The returned storage is read only.
+)";
+
+static const char DOCSTRING_STORAGE_EXPORT_BARRIER[] =
+    R"(Snapshots the barrier another fiber must wait on to access this storage.
+
+By default, this is the barrier for reading (the last mutation). With
+`include_uses=True`, it is the barrier for writing (all pending uses).
+)";
+
+static const char DOCSTRING_STORAGE_IMPORT_BARRIER[] =
+    R"(Orders subsequent operations on this storage after another fiber's access.
+
+The barrier is one exported by another fiber for its access to the same
+buffer. If `write`, all subsequent operations wait on it; otherwise, only
+subsequent writes (and deallocation) do.
+)";
+
+static const char DOCSTRING_STORAGE_ALLOCATE_STAGING[] =
+    R"(Allocates host storage for staging transfers to or from a device.
+
+Storage is drawn from the device's staging ring (configured with
+`Fiber.set_staging_ring`) and returns to it when released, to be reused once
+the device has completed its last transfer. This is what
+`device_array.for_transfer()` uses.
+)";
+
+static const char DOCSTRING_STORAGE_ALLOCATE_UNIFIED[] =
+    R"(Allocates device local storage that the host can map in place.
+
+For devices sharing their memory with the host (i.e. APUs), this avoids
+staging copies: `device_array.for_transfer()` of an array on unified storage
+returns the array itself. All device allocations are unified when the device
+is in unified memory mode (see `Device.unified_memory`).
+)";
+
+static const char DOCSTRING_MEMORY_POOL_SCOPE[] =
+    R"(Names the memory pool of storage allocated on this thread in a with block.
+
+In tracing builds with allocation tracking, storage allocations are reported
+as Tracy memory events of named pools: "shortfin.device", "shortfin.host" and
+"shortfin.staging" by default. Allocating in a scope reports device and host
+storage to its pool instead, i.e.::
+
+  with sfnp.memory_pool_scope("kvcache"):
+    page_table = sfnp.device_array.for_device(device, shape, dtype)
+)";
+
+static const char DOCSTRING_STORAGE_SUBSPAN[] =
+    R"(Creates a view of a byte range of this storage.
+
+The returned storage shares the underlying allocation and scheduling state.
+)";
+
 static const char DOCSTRING_STORAGE_FILL[] = R"(Fill a storage with a value.
 
 Takes as argument any value that can be interpreted as a buffer with the Python
@@ -131,10 +283,25 @@ See also `device_array.map()` which functions similarly but allows some
 additional dtype specific accessors.
 )";
 
+static const char DOCSTRING_STORAGE_MAP_ASYNC[] =
+    R"(Asynchronously create a mapping of the buffer contents in host memory.
+
+Takes the same kwargs as `map()` but returns an awaitable `MappingFuture`
+which resolves to the mapping once prior device work has reached the
+storage's barrier (all writes for read access, all uses for write access).
+The worker is not blocked while waiting, so the host can process the results
+of one step while the device executes the next:
+
+  mapping = await storage.map_async(read=True)
+
+Unlike `map()`, no prior `await device` is required.
+)";
+
 device_array PyDeviceArrayView(device_array &array, py::args keys) {
   size_t rank = array.shape().size();
   Dims c_offsets(rank, 0);
   Dims c_sizes(array.shape_container());
+  Dims c_steps(rank, 1);
 
   if (keys.size() > rank) {
     throw std::invalid_argument(
@@ -146,11 +313,12 @@ device_array PyDeviceArrayView(device_array &array, py::args keys) {
       // Slice key.
       auto slice = py::cast<py::slice>(key);
       auto [start, stop, step, length] = slice.compute(c_sizes[idx]);
-      if (step != 1) {
-        throw std::logic_error("view does not support strided slices");
+      if (step <= 0) {
+        throw std::logic_error("view does not support negative slice steps");
       }
       c_offsets[idx] = start;
       c_sizes[idx] = length;
+      c_steps[idx] = step;
     } else if (py::isinstance<iree_device_size_t>(key)) {
       // Integer key.
       c_offsets[idx] = py::cast<iree_device_size_t>(key);
@@ -162,7 +330,7 @@ device_array PyDeviceArrayView(device_array &array, py::args keys) {
     idx += 1;
   }
 
-  return array.view(c_offsets, c_sizes);
+  return array.view(c_offsets, c_sizes, c_steps);
 }
 
 class Refs {
@@ -205,6 +373,7 @@ class Refs {
     add_type(DType::bfloat16(), "H", sizeof(unsigned short));
     add_type(DType::float8_e4m3fnuz(), "B", sizeof(unsigned char));
     add_type(DType::float8_e4m3fn(), "B", sizeof(unsigned char));
+    add_type(DType::float8_e5m2(), "B", sizeof(unsigned char));
     add_type(DType::float16(), "H", sizeof(unsigned short));
     add_type(DType::float32(), "f", sizeof(float));
     add_type(DType::float64(), "d", sizeof(double));
@@ -262,6 +431,7 @@ class PyMapping {
     }
 
     // Specialize by fundamental sizes for fast-path implementations.
+    ScopedGilRelease release(mapping().size());
     if (py_view.len == 1) {
       std::memset(mapping().data(), *static_cast<char *>(py_view.buf),
                   mapping().size());
@@ -336,6 +506,7 @@ class PyMapping {
           fmt::format("Cannot write {} bytes into buffer of {} bytes",
                       src_info.view().len, mapping().size()));
     }
+    ScopedGilRelease release(src_info.view().len);
     std::memcpy(mapping().data(), src_info.view().buf, src_info.view().len);
   }
 
@@ -355,6 +526,43 @@ py::object CreateMappingObject(PyMapping **out_cpp_mapping) {
   return py_mapping;
 }
 
+// Future returned from `map_async`, carrying the dtype (if any) to attach to
+// the mapping when it resolves.
+class PyMappingFuture : public local::TypedFuture<mapping> {
+ public:
+  PyMappingFuture(local::TypedFuture<mapping> future,
+                  std::optional<DType> dtype = {})
+      : local::TypedFuture<mapping>(std::move(future)), dtype_(dtype) {}
+
+  py::object PyResult() {
+    class mapping &m = result();
+    if (!m) {
+      throw std::logic_error("Mapping future result has already been taken");
+    }
+    PyMapping *cpp_mapping = nullptr;
+    py::object py_mapping = CreateMappingObject(&cpp_mapping);
+    if (dtype_) cpp_mapping->set_dtype(*dtype_);
+    // Like ProgramInvocationFuture, this is read-once: the mapping is moved
+    // out to the Python object.
+    cpp_mapping->mapping() = std::move(m);
+    return py_mapping;
+  }
+
+ private:
+  std::optional<DType> dtype_;
+};
+
+iree_hal_memory_access_t PyMapAccess(bool read, bool write, bool discard) {
+  int access = 0;
+  if (read) access |= IREE_HAL_MEMORY_ACCESS_READ;
+  if (write || discard) access |= IREE_HAL_MEMORY_ACCESS_WRITE;
+  if (discard) access |= IREE_HAL_MEMORY_ACCESS_DISCARD;
+  if (!access) {
+    throw std::invalid_argument("One of the access flags must be set");
+  }
+  return static_cast<iree_hal_memory_access_bits_t>(access);
+}
+
 // Wraps a delegate argument with ProgramResourceBarrier::READ.
 class PyReadBarrier {
  public:
@@ -406,6 +614,144 @@ class PyDisableBarrier {
   py::object delegate_;
 };
 
+// Context manager entering a memory_pool_scope.
+class PyMemoryPoolScope {
+ public:
+  explicit PyMemoryPoolScope(std::string name) : name_(std::move(name)) {}
+  void Enter() {
+    if (scope_) throw std::logic_error("memory_pool_scope is already entered");
+    scope_.emplace(name_);
+  }
+  void Exit() { scope_.reset(); }
+  const std::string &name() const { return name_; }
+
+ private:
+  std::string name_;
+  std::optional<memory_pool_scope> scope_;
+};
+
+// DLPack element type correspondence. Lookups take the first match in either
+// direction, so signed integers import as sint* and signless int* export as
+// DLPack Int. Types without an equivalent (opaque, sub-byte, float8) are not
+// exchangeable.
+using DLPackCorrespondence = std::pair<DType, py::dlpack::dtype>;
+std::span<const DLPackCorrespondence> DLPackDTypes() {
+  auto dl = [](py::dlpack::dtype_code code, uint8_t bits) {
+    return py::dlpack::dtype{static_cast<uint8_t>(code), bits, 1};
+  };
+  using code = py::dlpack::dtype_code;
+  static const DLPackCorrespondence table[] = {
+      {DType::bool8(), dl(code::Bool, 8)},
+      {DType::sint8(), dl(code::Int, 8)},
+      {DType::sint16(), dl(code::Int, 16)},
+      {DType::sint32(), dl(code::Int, 32)},
+      {DType::sint64(), dl(code::Int, 64)},
+      {DType::int8(), dl(code::Int, 8)},
+      {DType::int16(), dl(code::Int, 16)},
+      {DType::int32(), dl(code::Int, 32)},
+      {DType::int64(), dl(code::Int, 64)},
+      {DType::uint8(), dl(code::UInt, 8)},
+      {DType::uint16(), dl(code::UInt, 16)},
+      {DType::uint32(), dl(code::UInt, 32)},
+      {DType::uint64(), dl(code::UInt, 64)},
+      {DType::float16(), dl(code::Float, 16)},
+      {DType::float32(), dl(code::Float, 32)},
+      {DType::float64(), dl(code::Float, 64)},
+      {DType::bfloat16(), dl(code::Bfloat, 16)},
+      {DType::complex64(), dl(code::Complex, 64)},
+      {DType::complex128(), dl(code::Complex, 128)},
+  };
+  return table;
+}
+
+// Exports a host mappable array as a nanobind ndarray aliasing its memory.
+// The ndarray's owner holds the mapping together with a copy of the storage,
+// so the buffer stays alive for as long as any DLPack consumer references it.
+// Like `map()`, this does not wait on device work: the caller must have
+// synchronized (i.e. awaited the device or `map_async()`).
+py::object PyExportDLPack(device_array &self) {
+  const DLPackCorrespondence *entry = nullptr;
+  for (auto &candidate : DLPackDTypes()) {
+    if (candidate.first == self.dtype()) {
+      entry = &candidate;
+      break;
+    }
+  }
+  if (!entry) {
+    throw std::invalid_argument(fmt::format(
+        "dtype {} has no DLPack equivalent", self.dtype().name()));
+  }
+  class storage &storage = self.storage();
+  if (!storage.is_mappable_for_read()) {
+    throw std::invalid_argument(
+        "DLPack export requires host mappable storage: stage device arrays "
+        "with for_transfer()");
+  }
+
+  struct Exported {
+    class storage storage;
+    class mapping mapping;
+  };
+  auto exported = std::make_unique<Exported>(Exported{storage, {}});
+  exported->storage.map_explicit(
+      exported->mapping,
+      storage.is_mappable_for_read_write()
+          ? IREE_HAL_MEMORY_ACCESS_READ | IREE_HAL_MEMORY_ACCESS_WRITE
+          : IREE_HAL_MEMORY_ACCESS_READ);
+  void *data = exported->mapping.data();
+  py::capsule owner(exported.release(), [](void *p) noexcept {
+    delete static_cast<Exported *>(p);
+  });
+  std::span<const size_t> shape = self.shape();
+  std::vector<int64_t> strides;
+  if (!self.is_dense()) {
+    for (auto stride : self.strides()) strides.push_back(stride);
+  }
+  return py::cast(py::ndarray<>(data, shape.size(), shape.data(), owner,
+                                strides.empty() ? nullptr : strides.data(),
+                                entry->second, py::device::cpu::value));
+}
+
+// Imports a host DLPack tensor as a device_array without copying. The
+// producer's tensor is kept alive until the device releases the buffer.
+py::object PyImportDLPack(
+    local::ScopedDevice &device,
+    py::ndarray<py::device::cpu, py::c_contig> tensor) {
+  using Tensor = decltype(tensor);
+  const DLPackCorrespondence *entry = nullptr;
+  for (auto &candidate : DLPackDTypes()) {
+    if (candidate.second == tensor.dtype()) {
+      entry = &candidate;
+      break;
+    }
+  }
+  if (!entry) {
+    throw std::invalid_argument(
+        fmt::format("Unsupported DLPack dtype (code={}, bits={}, lanes={})",
+                    tensor.dtype().code, tensor.dtype().bits,
+                    tensor.dtype().lanes));
+  }
+  std::vector<size_t> shape(tensor.ndim());
+  for (size_t i = 0; i < shape.size(); ++i) shape[i] = tensor.shape(i);
+
+  auto retained = std::make_unique<Tensor>(tensor);
+  iree_hal_buffer_release_callback_t release_callback = {
+      .fn =
+          +[](void *user_data, iree_hal_buffer_t *buffer) {
+            // The last buffer reference may be dropped from any thread.
+            py::gil_scoped_acquire g;
+            delete static_cast<Tensor *>(user_data);
+          },
+      .user_data = retained.get(),
+  };
+  class storage storage = storage::import_host_allocation(
+      device, tensor.data(), tensor.nbytes(), release_callback);
+  retained.release();
+  return custom_new_keep_alive<device_array>(
+      py::type<device_array>(), /*keep_alive=*/device.fiber(),
+      device_array(std::move(storage), shape, entry->first));
+}
+
 }  // namespace
 
 void BindArray(py::module_ &m) {
@@ -429,6 +775,27 @@ void BindArray(py::module_ &m) {
 #include "shortfin/array/dtypes.inl"
 #undef SHORTFIN_DTYPE_HANDLE
 
+  // exported_storage
+  py::class_<exported_storage>(m, "exported_storage")
+      .def_prop_ro("barrier", &exported_storage::barrier)
+      .def("__repr__", &exported_storage::to_s);
+
+  py::class_<PyMemoryPoolScope>(m, "memory_pool_scope",
+                                DOCSTRING_MEMORY_POOL_SCOPE)
+      .def(py::init<std::string>(), py::arg("name"))
+      .def_prop_ro("name", &PyMemoryPoolScope::name)
+      .def("__enter__",
+           [](py::object self_obj) {
+             py::cast<PyMemoryPoolScope &>(self_obj).Enter();
+             return self_obj;
+           })
+      .def(
+          "__exit__",
+          [](PyMemoryPoolScope &self, py::handle exc_type, py::handle exc_value,
+             py::handle exc_tb) { self.Exit(); },
+          py::arg("exc_type").none(), py::arg("exc_value").none(),
+          py::arg("exc_tb").none());
+
   // storage
   py::class_<storage>(m, "storage")
       .def("__sfinv_marshal__",
@@ -451,6 +818,13 @@ void BindArray(py::module_ &m) {
             return storage::allocate_device(device, allocation_size);
           },
           py::arg("device"), py::arg("allocation_size"), py::keep_alive<0, 1>())
+      .def_static("allocate_staging", &storage::allocate_staging,
+                  py::arg("device"), py::arg("allocation_size"),
+                  py::keep_alive<0, 1>(), DOCSTRING_STORAGE_ALLOCATE_STAGING)
+      .def_static("allocate_unified", &storage::allocate_unified,
+                  py::arg("device"), py::arg("allocation_size"),
+                  py::keep_alive<0, 1>(), DOCSTRING_STORAGE_ALLOCATE_UNIFIED)
+      .def_prop_ro("unified", &storage::is_unified)
       .def(
           "fill",
           [](storage &self, py::handle buffer) {
@@ -466,6 +840,36 @@ void BindArray(py::module_ &m) {
       .def(
           "copy_from", [](storage &self, storage &src) { self.copy_from(src); },
           py::arg("source_storage"), DOCSTRING_STORAGE_COPY_FROM)
+      .def("subspan", &storage::subspan, py::arg("byte_offset"),
+           py::arg("byte_length"), py::keep_alive<0, 1>(),
+           DOCSTRING_STORAGE_SUBSPAN)
+      .def("enable_subrange_tracking", &storage::enable_subrange_tracking,
+           DOCSTRING_STORAGE_ENABLE_SUBRANGE_TRACKING)
+      .def_prop_ro("subrange_tracking", &storage::subrange_tracking)
+      .def("export_shared", &storage::export_shared,
+           DOCSTRING_STORAGE_EXPORT_SHARED)
+      .def_static("import_shared", &storage::import_shared, py::arg("device"),
+                  py::arg("exported"), py::keep_alive<0, 1>())
+      .def(
+          "export_ipc_handle",
+          [](storage &self) {
+            std::string bytes = self.export_ipc_handle().Serialize();
+            return py::bytes(bytes.data(), bytes.size());
+          },
+          DOCSTRING_STORAGE_EXPORT_IPC_HANDLE)
+      .def_static(
+          "import_ipc_handle",
+          [](local::ScopedDevice &device, py::bytes handle) {
+            return storage::import_ipc_handle(
+                device, local::IpcMemoryHandle::Parse(std::string_view(
+                            handle.c_str(), handle.size())));
+          },
+          py::arg("device"), py::arg("handle"), py::keep_alive<0, 1>(),
+          DOCSTRING_STORAGE_IMPORT_IPC_HANDLE)
+      .def("export_barrier", &storage::export_barrier,
+           py::arg("include_uses") = false, DOCSTRING_STORAGE_EXPORT_BARRIER)
+      .def("import_barrier", &storage::import_barrier, py::arg("barrier"),
+           py::arg("write") = false, DOCSTRING_STORAGE_IMPORT_BARRIER)
       .def(
           "map",
           [](storage &self, bool read, bool write, bool discard) {
@@ -480,17 +884,32 @@ void BindArray(py::module_ &m) {
             }
             PyMapping *cpp_mapping = nullptr;
             py::object py_mapping = CreateMappingObject(&cpp_mapping);
-            self.map_explicit(
-                cpp_mapping->mapping(),
-                static_cast<iree_hal_memory_access_bits_t>(access));
+            {
+              ScopedGilRelease release(self.byte_length());
+              self.map_explicit(
+                  cpp_mapping->mapping(),
+                  static_cast<iree_hal_memory_access_bits_t>(access));
+            }
             return py_mapping;
           },
           py::kw_only(), py::arg("read") = false, py::arg("write") = false,
           py::arg("discard") = false, DOCSTRING_STORAGE_MAP)
+      .def(
+          "map_async",
+          [](storage &self, bool read, bool write, bool discard) {
+            SHORTFIN_TRACE_SCOPE_NAMED("PyStorage::map_async");
+            return PyMappingFuture(
+                self.map_async(PyMapAccess(read, write, discard)));
+          },
+          py::kw_only(), py::arg("read") = false, py::arg("write") = false,
+          py::arg("discard") = false, DOCSTRING_STORAGE_MAP_ASYNC)
       .def(py::self == py::self)
       .def("__len__", &storage::byte_length)
       .def("__repr__", &storage::to_s);
 
+  py::class_<PyMappingFuture, local::Future>(m, "MappingFuture")
+      .def("result", &PyMappingFuture::PyResult);
+
   // mapping
   auto mapping_class = py::class_<PyMapping>(m, "mapping");
   mapping_class.def("close", [](PyMapping &self) { self.mapping().reset(); })
@@ -555,7 +974,13 @@ void BindArray(py::module_ &m) {
   // base_array and subclasses
   py::class_<base_array>(m, "base_array")
       .def_prop_ro("dtype", &base_array::dtype)
-      .def_prop_ro("shape", &base_array::shape);
+      .def_prop_ro("shape", &base_array::shape)
+      .def_prop_ro("is_dense", &base_array::is_dense)
+      .def_prop_ro("strides", [](base_array &self) {
+        std::vector<size_t> strides;
+        for (auto stride : self.strides()) strides.push_back(stride);
+        return strides;
+      });
 
   py::class_<device_array, base_array>(m, "device_array")
       .def("__init__", [](py::args, py::kwargs) {})
@@ -611,6 +1036,18 @@ void BindArray(py::module_ &m) {
                  py::type<device_array>(),
                  /*keep_alive=*/self.device().fiber(), self.for_transfer());
            })
+      .def_static("from_dlpack", PyImportDLPack, py::arg("device"),
+                  py::arg("tensor").noconvert(), DOCSTRING_ARRAY_FROM_DLPACK)
+      .def(
+          "__dlpack__",
+          [](device_array &self, py::kwargs) {
+            return PyExportDLPack(self).attr("__dlpack__")();
+          },
+          DOCSTRING_ARRAY_DLPACK)
+      .def("__dlpack_device__",
+           [](device_array &self) {
+             return py::make_tuple(py::device::cpu::value, 0);
+           })
       .def_prop_ro("device", &device_array::device,
                    py::rv_policy::reference_internal)
       .def_prop_ro("storage", &device_array::storage,
@@ -618,6 +1055,7 @@ void BindArray(py::module_ &m) {
       .def(
           "fill",
           [](py::handle_t<device_array> self, py::handle buffer) {
+            py::cast<device_array &>(self).AssertDense("fill");
             self.attr("storage").attr("fill")(buffer);
           },
           py::arg("pattern"), DOCSTRING_ARRAY_FILL)
@@ -625,11 +1063,29 @@ void BindArray(py::module_ &m) {
            DOCSTRING_ARRAY_COPY_FROM)
       .def("copy_to", &device_array::copy_to, py::arg("dest_array"),
            DOCSTRING_ARRAY_COPY_TO)
+      .def(
+          "copy_rows_from",
+          [](device_array &self, device_array &source_array,
+             std::vector<Dims::value_type> source_rows,
+             std::vector<Dims::value_type> target_rows) {
+            self.copy_rows_from(source_array, source_rows, target_rows);
+          },
+          py::arg("source_array"), py::arg("source_rows"),
+          py::arg("target_rows"), DOCSTRING_ARRAY_COPY_ROWS_FROM)
       .def("view", PyDeviceArrayView, DOCSTRING_ARRAY_VIEW)
+      .def(
+          "contiguous",
+          [](device_array &self) {
+            return custom_new_keep_alive<device_array>(
+                py::type<device_array>(),
+                /*keep_alive=*/self.device().fiber(), self.contiguous());
+          },
+          DOCSTRING_ARRAY_CONTIGUOUS)
       .def(
           "map",
           [](device_array &self, bool read, bool write, bool discard) {
             SHORTFIN_TRACE_SCOPE_NAMED("PyArray::map");
+            self.AssertDense("map");
             int access = 0;
             if (read) access |= IREE_HAL_MEMORY_ACCESS_READ;
             if (write || discard) access |= IREE_HAL_MEMORY_ACCESS_WRITE;
@@ -641,17 +1097,32 @@ void BindArray(py::module_ &m) {
             PyMapping *cpp_mapping = nullptr;
             py::object py_mapping = CreateMappingObject(&cpp_mapping);
             cpp_mapping->set_dtype(self.dtype());
-            self.storage().map_explicit(
-                cpp_mapping->mapping(),
-                static_cast<iree_hal_memory_access_bits_t>(access));
+            {
+              ScopedGilRelease release(self.storage().byte_length());
+              self.storage().map_explicit(
+                  cpp_mapping->mapping(),
+                  static_cast<iree_hal_memory_access_bits_t>(access));
+            }
             return py_mapping;
           },
           py::kw_only(), py::arg("read") = false, py::arg("write") = false,
           py::arg("discard") = false, DOCSTRING_ARRAY_MAP)
+      .def(
+          "map_async",
+          [](device_array &self, bool read, bool write, bool discard) {
+            SHORTFIN_TRACE_SCOPE_NAMED("PyArray::map_async");
+            self.AssertDense("map_async");
+            return PyMappingFuture(
+                self.storage().map_async(PyMapAccess(read, write, discard)),
+                self.dtype());
+          },
+          py::kw_only(), py::arg("read") = false, py::arg("write") = false,
+          py::arg("discard") = false, DOCSTRING_ARRAY_MAP_ASYNC)
       .def_prop_rw(
           "items",
           [refs](device_array &self) {
             SHORTFIN_TRACE_SCOPE_NAMED("PyArray::items");
+            self.AssertDense("items");
             PyMapping *mapping;
             py::object mapping_obj = CreateMappingObject(&mapping);
             mapping->set_dtype(self.dtype());
@@ -661,6 +1132,7 @@ void BindArray(py::module_ &m) {
             return mapping->GetItems(mapping_obj, refs.get());
           },
           [refs](device_array &self, py::handle initializer) {
+            self.AssertDense("items");
             PyMapping mapping;
             mapping.set_dtype(self.dtype());
             self.storage().map_explicit(
@@ -673,6 +1145,7 @@ void BindArray(py::module_ &m) {
           "__array_interface__",
           [refs](device_array &self) {
             SHORTFIN_TRACE_SCOPE_NAMED("PyArray::__array_interface__");
+            self.AssertDense("__array_interface__");
             py::dict interface;
             interface["version"] = 3;
             interface["strides"] = py::none();
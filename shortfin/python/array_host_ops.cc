@@ -5,14 +5,23 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include "./lib_ext.h"
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
 #include "./utils.h"
+#include "fmt/ranges.h"
 #include "iree/base/internal/math.h"
 #include "shortfin/array/api.h"
+#include "shortfin/array/host_kernels.h"
+#include "shortfin/local/system.h"
 #include "shortfin/support/logging.h"
 #include "xtensor/xmath.hpp"
 #include "xtensor/xrandom.hpp"
 #include "xtensor/xreducer.hpp"
 #include "xtensor/xsort.hpp"
+#include "xtensor/xtensor.hpp"
 #include "xtl/xhalf_float.hpp"
 
 #ifndef FP8_HPP
@@ -341,8 +350,9 @@ Args:
     numpy default is into the flattened array, which we do not support).
   keepdims: Whether to preserve the sort axis. If true, this will become a unit
     dim. If false, it will be removed.
-  out: Array to write into. If specified, it must have an expected shape and
-    int64 dtype.
+  out: Array to write into. If specified, it must have int64 dtype and the
+    reduced shape or, with `keepdims`, either the reduced or the keepdims
+    shape. Reusing `out` avoids allocating a result on each call.
   device_visible: Whether to make the result array visible to devices. Defaults to
     False.
 
@@ -464,8 +474,8 @@ type between 8 and 32 bits.
 Args:
   input: An input array of a floating point dtype.
   dtype: If given, then this is the explicit output dtype.
-  out: If given, then the results are written to this array. This implies the
-    output dtype.
+  out: If given, then the results are written to this array, which must have
+    the same shape as `input`. This implies the output dtype.
   device_visible: Whether to make the result array visible to devices. Defaults to
     False.
 
@@ -473,6 +483,22 @@ Returns:
   A device_array of the requested dtype, or the input dtype if not specified.
 )";
 
+static const char DOCSTRING_CONVERT_INTO[] =
+    R"(Converts `input` elementwise into the preallocated array `out`.
+
+Equivalent to `convert(input, out=out)`. Conversions between float32, float16,
+bfloat16 and the 8 bit float dtypes use vectorized kernels, making this suited
+to repeatedly dequantizing fp8 slices into a reused buffer.
+
+Args:
+  input: An input array.
+  out: The output array, of the same shape as `input`. Its dtype is the
+    conversion target.
+
+Returns:
+  `out`.
+)";
+
 static const char DOCSTRING_FILL_RANDN[] =
     R"(Fills an array with numbers sampled from the standard ormal distribution.
 
@@ -498,6 +524,20 @@ static const char DOCSTRING_RANDOM_GENERATOR[] =
       fixed number.
   )";
 
+static const char DOCSTRING_SET_PARALLEL_HOST_OPS[] =
+    R"(Enables or disables splitting host ops across the host thread pool.
+
+When enabled, the vectorized paths of `argmax`, `softmax`, `log_softmax`,
+`exp` and the elementwise arithmetic ops split their work along the batch
+(leading) axes across the system's host thread pool, separate from the worker
+loops. Arrays with fewer than `min_elements` elements always run on the
+calling thread. Disabled by default.
+
+Args:
+  enabled: Whether to split large host ops across the pool.
+  min_elements: Minimum element count of an op's input before it is split.
+)";
+
 static const char DOCSTRING_TRANSPOSE[] =
     R"(Transposes axes of an array according to a permutation vector.
 
@@ -505,7 +545,8 @@ Args:
   input: Array to transpose.
   permutation: New sequence of axes. Must have same number of elements as the
     rank of input.
-  out: If given, then the results are written to this array.
+  out: If given, then the results are written to this array, which must have
+    the permuted shape and the dtype of `input`.
   device_visible: Whether to make the result array visible to devices. Defaults
     to False.
 )";
@@ -514,6 +555,12 @@ Args:
   case DType::dtype_name():                          \
     return compute.template operator()<cpp_type>()
 
+// Same as SF_UNARY_FUNCTION_CASE for a compute taking the rank of `array` as
+// a second template parameter (see DispatchRank()).
+#define SF_RANKED_FUNCTION_CASE(dtype_name, cpp_type, array) \
+  case DType::dtype_name():                                  \
+    return DispatchRank<cpp_type>(array.shape().size(), compute)
+
 #define SF_UNARY_THUNK_CASE(dtype_name, cpp_type) \
   case DType::dtype_name():                       \
     compute.template operator()<cpp_type>();      \
@@ -538,6 +585,63 @@ Args:
           "4, 8");                                                       \
   }
 
+// Rank passed by DispatchRank() for arrays whose rank is not fixed at compile
+// time.
+inline constexpr size_t kDynamicRank = 0;
+
+// Invokes `compute.template operator()<EltTy, Rank>()` with `rank` as a
+// compile time constant for ranks 1 to 4, which covers the [bs, vocab],
+// [bs, seq, vocab] and image shapes of the serving paths, and kDynamicRank
+// otherwise. The ranked maps below then have std::array shapes and strides,
+// letting xtensor unroll its index arithmetic instead of looping over the
+// rank for every element.
+template <typename EltTy, typename Compute>
+auto DispatchRank(size_t rank, Compute &compute) {
+  switch (rank) {
+    case 1:
+      return compute.template operator()<EltTy, 1>();
+    case 2:
+      return compute.template operator()<EltTy, 2>();
+    case 3:
+      return compute.template operator()<EltTy, 3>();
+    case 4:
+      return compute.template operator()<EltTy, 4>();
+    default:
+      return compute.template operator()<EltTy, kDynamicRank>();
+  }
+}
+
+// Maps `array` as an xtensor of the DispatchRank() rank.
+template <typename EltTy, size_t Rank>
+auto MapRanked(device_array &array) {
+  if constexpr (Rank == kDynamicRank) {
+    return array.map_xtensor<EltTy>();
+  } else {
+    return array.map_xtensor_fixed<EltTy, Rank>();
+  }
+}
+template <typename EltTy, size_t Rank>
+auto MapRankedRw(device_array &array) {
+  if constexpr (Rank == kDynamicRank) {
+    return array.map_xtensor_rw<EltTy>();
+  } else {
+    return array.map_xtensor_fixed_rw<EltTy, Rank>();
+  }
+}
+template <typename EltTy, size_t Rank>
+auto MapRankedW(device_array &array) {
+  if constexpr (Rank == kDynamicRank) {
+    return array.map_xtensor_w<EltTy>();
+  } else {
+    return array.map_xtensor_fixed_w<EltTy, Rank>();
+  }
+}
+
+// Owning tensor for the intermediates of an op of the DispatchRank() rank.
+template <typename EltTy, size_t Rank>
+using RankedTensor = std::conditional_t<Rank == kDynamicRank, xt::xarray<EltTy>,
+                                        xt::xtensor<EltTy, Rank>>;
+
 struct PyRandomGenerator {
  public:
   using SeedType = xt::random::default_engine_type::result_type;
@@ -553,11 +657,90 @@ struct PyRandomGenerator {
   void SetSeed(SeedType seed) { engine().seed(seed); }
 
   xt::random::default_engine_type &engine() { return engine_; }
+  // Held while drawing from the engine, which fill_randn does without the
+  // GIL.
+  std::mutex &mutex() { return mutex_; }
 
  private:
   xt::random::default_engine_type engine_;
+  std::mutex mutex_;
 };
 
+bool SameShape(std::span<const Dims::value_type> a,
+               std::span<const Dims::value_type> b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end());
+}
+
+size_t ElementCount(std::span<const Dims::value_type> shape) {
+  size_t count = 1;
+  for (auto dim : shape) count *= dim;
+  return count;
+}
+
+// Bytes of `array`'s elements, which sizes the GIL release of the ops reading
+// it.
+size_t ByteCount(device_array &array) {
+  return ElementCount(array.shape()) * array.dtype().dense_byte_count();
+}
+
+// Opt-in splitting of the kernel fast paths across the system's host thread
+// pool (see set_parallel_host_ops).
+std::atomic<bool> parallel_host_ops_enabled{false};
+std::atomic<size_t> parallel_host_ops_min_elements{1 << 18};
+// Smallest slice handed to a single pool thread.
+constexpr size_t kParallelMinChunkElements = 1 << 14;
+
+// Runs `fn` over [0, item_count) in contiguous ranges, where each item spans
+// `item_elements` elements. The range is split across the host thread pool of
+// `like`'s system when parallel host ops are enabled and the total work meets
+// the size threshold; otherwise it runs inline.
+void ForEachItemRange(device_array &like, size_t item_count,
+                      size_t item_elements,
+                      const HostThreadPool::ChunkFunction &fn) {
+  if (!parallel_host_ops_enabled.load(std::memory_order_relaxed) ||
+      item_count < 2 ||
+      item_count * item_elements <
+          parallel_host_ops_min_elements.load(std::memory_order_relaxed)) {
+    fn(0, item_count);
+    return;
+  }
+  size_t min_chunk =
+      (kParallelMinChunkElements + item_elements - 1) / item_elements;
+  like.device().fiber().system().host_thread_pool().ParallelFor(
+      item_count, min_chunk, fn);
+}
+
+// Validates a caller provided `out` against the shape and dtype of an op's
+// result, so that a mismatch is reported up front rather than as an xtensor
+// broadcast error (or not at all).
+void CheckOutArray(const char *op_name, device_array &out,
+                   std::span<const Dims::value_type> shape, DType dtype) {
+  if (out.dtype() != dtype) {
+    throw std::invalid_argument(
+        fmt::format("{}: out array must have dtype={} but got {}", op_name,
+                    dtype.name(), out.dtype().name()));
+  }
+  if (!SameShape(out.shape(), shape)) {
+    throw std::invalid_argument(fmt::format(
+        "{}: out array must have shape [{}] but got [{}]", op_name,
+        fmt::join(shape, ", "), fmt::join(out.shape(), ", ")));
+  }
+  out.AssertDense(op_name);
+}
+
+// Numpy broadcast of two shapes, or nullopt if they are incompatible.
+std::optional<Dims> BroadcastShape(std::span<const Dims::value_type> a,
+                                   std::span<const Dims::value_type> b) {
+  Dims result(std::max(a.size(), b.size()));
+  for (size_t i = 0; i < result.size(); ++i) {
+    auto a_dim = i < a.size() ? a[a.size() - 1 - i] : 1;
+    auto b_dim = i < b.size() ? b[b.size() - 1 - i] : 1;
+    if (a_dim != b_dim && a_dim != 1 && b_dim != 1) return std::nullopt;
+    result[result.size() - 1 - i] = a_dim == 1 ? b_dim : a_dim;
+  }
+  return result;
+}
+
 // Generic conversion templates, split into a bindable template and functors
 // that operate on pre-allocated outputs.
 template <typename ConvertFunc>
@@ -577,16 +760,45 @@ device_array GenericElementwiseConvert(device_array &input,
   if (!out) {
     out.emplace(device_array::for_host(input.device(), input.shape(), *dtype,
                                        device_visible));
+  } else {
+    CheckOutArray("convert", *out, input.shape(), *dtype);
   }
 
+  ScopedGilRelease release(ByteCount(input));
   ConvertFunc::Invoke(input, *dtype, *out);
   return *out;
 }
 
 // Generic elementwise conversion functor
 struct ConvertFunctor {
+  // Floating point conversions between same-shape arrays run on the
+  // vectorized host kernels.
+  static bool TryKernelConvert(device_array &input, DType dtype,
+                               device_array &out) {
+    auto from = host_kernels::ConvertFormatForDType(input.dtype());
+    auto to = host_kernels::ConvertFormatForDType(dtype);
+    if (!from || !to || !input.is_dense() || !out.is_dense() ||
+        !SameShape(input.shape(), out.shape())) {
+      return false;
+    }
+    size_t count = ElementCount(input.shape());
+    if (count == 0) return true;
+    size_t in_size = input.dtype().dense_byte_count();
+    size_t out_size = dtype.dense_byte_count();
+    auto input_m = input.data();
+    auto out_m = out.data_w();
+    const uint8_t *input_data = input_m.data();
+    uint8_t *out_data = out_m.data();
+    ForEachItemRange(input, count, 1, [&](size_t begin, size_t end) {
+      host_kernels::Convert(*from, *to, input_data + begin * in_size,
+                            out_data + begin * out_size, end - begin);
+    });
+    return true;
+  }
+
   static void Invoke(device_array &input, DType dtype, device_array &out) {
     SHORTFIN_TRACE_SCOPE_NAMED("PyHostOp::convert");
+    if (TryKernelConvert(input, dtype, out)) return;
     auto compute = [&]<typename EltTy>() -> void {
       auto input_t = input.map_xtensor<EltTy>();
       // Casted output.
@@ -964,6 +1176,8 @@ f8e4m3fn_t ConvertPyToEltTy(py::handle py_value, f8e4m3fn_t zero) {
 }
 
 struct AddFunctor {
+  static constexpr host_kernels::BinaryOp kHostKernelOp =
+      host_kernels::BinaryOp::ADD;
   template <typename Lhs, typename Rhs>
   static auto Invoke(Lhs &&lhs, Rhs &&rhs) {
     return lhs + rhs;
@@ -971,6 +1185,8 @@ struct AddFunctor {
 };
 
 struct DivideFunctor {
+  static constexpr host_kernels::BinaryOp kHostKernelOp =
+      host_kernels::BinaryOp::DIVIDE;
   template <typename Lhs, typename Rhs>
   static auto Invoke(Lhs &&lhs, Rhs &&rhs) {
     return lhs / rhs;
@@ -978,6 +1194,8 @@ struct DivideFunctor {
 };
 
 struct MultiplyFunctor {
+  static constexpr host_kernels::BinaryOp kHostKernelOp =
+      host_kernels::BinaryOp::MULTIPLY;
   template <typename Lhs, typename Rhs>
   static auto Invoke(Lhs &&lhs, Rhs &&rhs) {
     return lhs * rhs;
@@ -985,12 +1203,120 @@ struct MultiplyFunctor {
 };
 
 struct SubtractFunctor {
+  static constexpr host_kernels::BinaryOp kHostKernelOp =
+      host_kernels::BinaryOp::SUBTRACT;
   template <typename Lhs, typename Rhs>
   static auto Invoke(Lhs &&lhs, Rhs &&rhs) {
     return lhs - rhs;
   }
 };
 
+// Fast paths onto the vectorized host kernels. These cover dense fp32/fp16/
+// bf16 arrays in the common inference shapes (reductions over the last axis
+// and same-shape or scalar elementwise ops). Each returns std::nullopt when
+// the operands do not qualify, in which case the caller falls back to
+// xtensor.
+
+// Returns the kernel format for a dense, non-empty array of a supported dtype.
+std::optional<host_kernels::Format> KernelFormat(device_array &array) {
+  if (!array.is_dense() || ElementCount(array.shape()) == 0) {
+    return std::nullopt;
+  }
+  return host_kernels::FormatForDType(array.dtype());
+}
+
+// Allocates `out` with the given shape if it was not provided. Returns false
+// if a provided `out` does not match.
+bool PrepareKernelOut(std::optional<device_array> &out,
+                      local::ScopedDevice &device,
+                      std::span<const Dims::value_type> shape, DType dtype,
+                      bool device_visible) {
+  if (out) {
+    return out->is_dense() && out->dtype() == dtype &&
+           SameShape(out->shape(), shape);
+  }
+  out.emplace(device_array::for_host(device, shape, dtype, device_visible));
+  return true;
+}
+
+std::optional<device_array> TryKernelArgmax(device_array &input, int axis,
+                                            std::optional<device_array> &out,
+                                            bool device_visible) {
+  auto format = KernelFormat(input);
+  auto shape = input.shape();
+  if (!format || static_cast<size_t>(axis) != shape.size() - 1) {
+    return std::nullopt;
+  }
+  auto out_shape = shape.first(shape.size() - 1);
+  if (!PrepareKernelOut(out, input.device(), out_shape, DType::int64(),
+                        device_visible)) {
+    return std::nullopt;
+  }
+  size_t n = shape[axis];
+  size_t row_bytes = n * input.dtype().dense_byte_count();
+  auto input_m = input.data();
+  auto out_m = out->data_w();
+  const uint8_t *input_data = input_m.data();
+  int64_t *out_data = reinterpret_cast<int64_t *>(out_m.data());
+  ForEachItemRange(input, ElementCount(out_shape), n,
+                   [&](size_t begin, size_t end) {
+                     host_kernels::ArgmaxRows(*format,
+                                              input_data + begin * row_bytes,
+                                              end - begin, n, out_data + begin);
+                   });
+  return *out;
+}
+
+std::optional<device_array> TryKernelSoftmax(device_array &input, int axis,
+                                             std::optional<device_array> &out,
+                                             bool log, bool device_visible) {
+  auto format = KernelFormat(input);
+  auto shape = input.shape();
+  if (!format || static_cast<size_t>(axis) != shape.size() - 1) {
+    return std::nullopt;
+  }
+  if (!PrepareKernelOut(out, input.device(), shape, input.dtype(),
+                        device_visible)) {
+    return std::nullopt;
+  }
+  size_t n = shape[axis];
+  size_t row_bytes = n * input.dtype().dense_byte_count();
+  auto input_m = input.data();
+  auto out_m = out->data_w();
+  const uint8_t *input_data = input_m.data();
+  uint8_t *out_data = out_m.data();
+  ForEachItemRange(input, ElementCount(shape.first(shape.size() - 1)), n,
+                   [&](size_t begin, size_t end) {
+                     host_kernels::SoftmaxRows(
+                         *format, input_data + begin * row_bytes,
+                         out_data + begin * row_bytes, end - begin, n, log);
+                   });
+  return *out;
+}
+
+std::optional<device_array> TryKernelExp(device_array &input,
+                                         std::optional<device_array> &out,
+                                         bool device_visible) {
+  auto format = KernelFormat(input);
+  if (!format || !PrepareKernelOut(out, input.device(), input.shape(),
+                                   input.dtype(), device_visible)) {
+    return std::nullopt;
+  }
+  size_t element_bytes = input.dtype().dense_byte_count();
+  auto input_m = input.data();
+  auto out_m = out->data_w();
+  const uint8_t *input_data = input_m.data();
+  uint8_t *out_data = out_m.data();
+  ForEachItemRange(input, ElementCount(input.shape()), 1,
+                   [&](size_t begin, size_t end) {
+                     host_kernels::Exp(*format,
+                                       input_data + begin * element_bytes,
+                                       out_data + begin * element_bytes,
+                                       end - begin);
+                   });
+  return *out;
+}
+
 template <typename ElementwiseFunctor>
 device_array ElementwiseOperation(py::handle lhs, py::handle rhs,
                                   std::optional<device_array> out,
@@ -1017,6 +1343,66 @@ device_array ElementwiseOperation(py::handle lhs, py::handle rhs,
     rhs_array.emplace(std::move(converted));
   }
 
+  device_array &like = lhs_array ? *lhs_array : *rhs_array;
+  if (out) {
+    using Shape = std::span<const Dims::value_type>;
+    auto result_shape =
+        BroadcastShape(lhs_array ? lhs_array->shape() : Shape(),
+                       rhs_array ? rhs_array->shape() : Shape());
+    // Incompatible operand shapes are reported by xtensor.
+    if (result_shape) {
+      CheckOutArray("elementwise op", *out, result_shape->span(), dtype);
+    }
+  }
+  if (auto format = KernelFormat(like)) {
+    // Scalars are first rounded to the element type, matching the xtensor
+    // path.
+    auto scalar_value = [&](py::handle py_value) -> float {
+      switch (*format) {
+        case host_kernels::Format::F16:
+          return ConvertPyToEltTy(py_value, half_float::half());
+        case host_kernels::Format::BF16:
+          return ConvertPyToEltTy(py_value, bfloat16_t());
+        default:
+          return ConvertPyToEltTy(py_value, float());
+      }
+    };
+    bool same_shape =
+        !lhs_array || !rhs_array ||
+        (lhs_array->is_dense() && rhs_array->is_dense() &&
+         SameShape(lhs_array->shape(), rhs_array->shape()));
+    if (same_shape && PrepareKernelOut(out, like.device(), like.shape(), dtype,
+                                       device_visible)) {
+      size_t count = ElementCount(like.shape());
+      size_t element_bytes = dtype.dense_byte_count();
+      if (lhs_array && rhs_array) {
+        ScopedGilRelease release(count * element_bytes);
+        auto lhs_m = lhs_array->data();
+        auto rhs_m = rhs_array->data();
+        auto out_m = out->data_w();
+        ForEachItemRange(like, count, 1, [&](size_t begin, size_t end) {
+          size_t offset = begin * element_bytes;
+          host_kernels::Binary(ElementwiseFunctor::kHostKernelOp, *format,
+                               lhs_m.data() + offset, rhs_m.data() + offset,
+                               out_m.data() + offset, end - begin);
+        });
+      } else {
+        float scalar = scalar_value(lhs_array ? rhs : lhs);
+        ScopedGilRelease release(count * element_bytes);
+        auto array_m = like.data();
+        auto out_m = out->data_w();
+        ForEachItemRange(like, count, 1, [&](size_t begin, size_t end) {
+          size_t offset = begin * element_bytes;
+          host_kernels::BinaryScalar(
+              ElementwiseFunctor::kHostKernelOp, *format,
+              array_m.data() + offset, scalar,
+              /*scalar_lhs=*/!lhs_array, out_m.data() + offset, end - begin);
+        });
+      }
+      return *out;
+    }
+  }
+
   auto compute = [&]<typename EltTy>() -> device_array {
     auto handle_result = [&]<typename D, typename A>(
                              D &&device, A &&result) -> device_array {
@@ -1029,16 +1415,20 @@ device_array ElementwiseOperation(py::handle lhs, py::handle rhs,
       return *out;
     };
     if (!rhs_array) {
-      auto lhs_t = lhs_array->map_xtensor<EltTy>();
       xt::xarray<EltTy> rhs_scalar = ConvertPyToEltTy(rhs, EltTy());
+      ScopedGilRelease release(ByteCount(*lhs_array));
+      auto lhs_t = lhs_array->map_xtensor<EltTy>();
       return handle_result(lhs_array->device(),
                            ElementwiseFunctor::Invoke(*lhs_t, rhs_scalar));
     } else if (!lhs_array) {
       xt::xarray<EltTy> lhs_scalar = ConvertPyToEltTy(lhs, EltTy());
+      ScopedGilRelease release(ByteCount(*rhs_array));
       auto rhs_t = rhs_array->map_xtensor<EltTy>();
       return handle_result(rhs_array->device(),
                            ElementwiseFunctor::Invoke(lhs_scalar, *rhs_t));
     } else {
+      ScopedGilRelease release(
+          std::max(ByteCount(*lhs_array), ByteCount(*rhs_array)));
       auto lhs_t = lhs_array->map_xtensor<EltTy>();
       auto rhs_t = rhs_array->map_xtensor<EltTy>();
       return handle_result(lhs_array->device(),
@@ -1077,17 +1467,42 @@ void BindArrayHostOps(py::module_ &m) {
       [](device_array &input, int axis, std::optional<device_array> out,
          bool keepdims, bool device_visible) {
         SHORTFIN_TRACE_SCOPE_NAMED("PyHostOp::argmax");
+        ScopedGilRelease release(ByteCount(input));
         if (axis < 0) axis += input.shape().size();
         if (axis < 0 || axis >= input.shape().size()) {
           throw std::invalid_argument(
               fmt::format("Axis out of range: Must be [0, {}) but got {}",
                           input.shape().size(), axis));
         }
-        if (out && (out->dtype() != DType::int64())) {
-          throw std::invalid_argument("out array must have dtype=int64");
+        // With keepdims, `out` may have either the reduced or the keepdims
+        // shape. The latter is computed through a reduced alias of its storage.
+        Dims reduced_shape(input.shape().size() - 1);
+        for (size_t i = 0, j = 0; i < input.shape().size(); ++i) {
+          if (i != static_cast<size_t>(axis)) {
+            reduced_shape[j++] = input.shape()[i];
+          }
         }
-        auto compute = [&]<typename EltTy>() {
-          auto input_t = input.map_xtensor<EltTy>();
+        std::optional<device_array> keepdims_out;
+        if (out && keepdims && out->shape().size() == input.shape().size()) {
+          Dims keepdims_shape(input.shape_container());
+          keepdims_shape[axis] = 1;
+          CheckOutArray("argmax", *out, keepdims_shape.span(), DType::int64());
+          keepdims_out = out;
+          out.emplace(device_array(keepdims_out->storage(),
+                                   reduced_shape.span(), DType::int64()));
+        } else if (out) {
+          CheckOutArray("argmax", *out, reduced_shape.span(), DType::int64());
+        }
+        auto finish = [&](device_array result) {
+          if (keepdims_out) return *keepdims_out;
+          if (keepdims) result.expand_dims(axis);
+          return result;
+        };
+        if (auto result = TryKernelArgmax(input, axis, out, device_visible)) {
+          return finish(*result);
+        }
+        auto compute = [&]<typename EltTy, size_t Rank>() {
+          auto input_t = MapRanked<EltTy, Rank>(input);
           auto result = xt::argmax(*input_t, axis);
           if (!out) {
             out.emplace(device_array::for_host(input.device(), result.shape(),
@@ -1095,17 +1510,14 @@ void BindArrayHostOps(py::module_ &m) {
           }
           auto out_t = out->map_xtensor_w<int64_t>();
           *out_t = result;
-          if (keepdims) {
-            out->expand_dims(axis);
-          }
-          return *out;
+          return finish(*out);
         };
         switch (input.dtype()) {
-          SF_UNARY_FUNCTION_CASE(float8_e4m3fnuz, f8e4m3fnuz_t);
-          SF_UNARY_FUNCTION_CASE(float8_e4m3fn, f8e4m3fn_t);
-          SF_UNARY_FUNCTION_CASE(float16, half_float::half);
-          SF_UNARY_FUNCTION_CASE(bfloat16, bfloat16_t);
-          SF_UNARY_FUNCTION_CASE(float32, float);
+          SF_RANKED_FUNCTION_CASE(float8_e4m3fnuz, f8e4m3fnuz_t, input);
+          SF_RANKED_FUNCTION_CASE(float8_e4m3fn, f8e4m3fn_t, input);
+          SF_RANKED_FUNCTION_CASE(float16, half_float::half, input);
+          SF_RANKED_FUNCTION_CASE(bfloat16, bfloat16_t, input);
+          SF_RANKED_FUNCTION_CASE(float32, float, input);
           default:
             throw std::invalid_argument(
                 fmt::format("Unsupported dtype({}) for operator argmax",
@@ -1121,6 +1533,7 @@ void BindArrayHostOps(py::module_ &m) {
       [](device_array &input, int k, int axis, std::optional<device_array> out,
          bool device_visible) {
         SHORTFIN_TRACE_SCOPE_NAMED("PyHostOp::argpartition");
+        ScopedGilRelease release(ByteCount(input));
         if (axis < 0) axis += input.shape().size();
         if (axis < 0 || axis >= input.shape().size()) {
           throw std::invalid_argument(
@@ -1134,11 +1547,11 @@ void BindArrayHostOps(py::module_ &m) {
               fmt::format("K out of range: Must be [-{}, {}) but got {}",
                           input.shape()[axis], input.shape()[axis], k));
         }
-        if (out && (out->dtype() != DType::int64())) {
-          throw std::invalid_argument("out array must have dtype=int64");
+        if (out) {
+          CheckOutArray("argpartition", *out, input.shape(), DType::int64());
         }
-        auto compute = [&]<typename EltTy>() {
-          auto input_t = input.map_xtensor<EltTy>();
+        auto compute = [&]<typename EltTy, size_t Rank>() {
+          auto input_t = MapRanked<EltTy, Rank>(input);
           auto result = xt::argpartition(*input_t, k, /*axis=*/axis);
           if (!out) {
             out.emplace(device_array::for_host(input.device(), result.shape(),
@@ -1150,11 +1563,11 @@ void BindArrayHostOps(py::module_ &m) {
         };
 
         switch (input.dtype()) {
-          SF_UNARY_FUNCTION_CASE(float8_e4m3fnuz, f8e4m3fnuz_t);
-          SF_UNARY_FUNCTION_CASE(float8_e4m3fn, f8e4m3fn_t);
-          SF_UNARY_FUNCTION_CASE(float16, half_float::half);
-          SF_UNARY_FUNCTION_CASE(bfloat16, bfloat16_t);
-          SF_UNARY_FUNCTION_CASE(float32, float);
+          SF_RANKED_FUNCTION_CASE(float8_e4m3fnuz, f8e4m3fnuz_t, input);
+          SF_RANKED_FUNCTION_CASE(float8_e4m3fn, f8e4m3fn_t, input);
+          SF_RANKED_FUNCTION_CASE(float16, half_float::half, input);
+          SF_RANKED_FUNCTION_CASE(bfloat16, bfloat16_t, input);
+          SF_RANKED_FUNCTION_CASE(float32, float, input);
           default:
             throw std::invalid_argument(
                 fmt::format("Unsupported dtype({}) for operator argpartition",
@@ -1170,13 +1583,15 @@ void BindArrayHostOps(py::module_ &m) {
       [](device_array &input, std::optional<device_array> out,
          bool device_visible) {
         SHORTFIN_TRACE_SCOPE_NAMED("PyHostOp::log");
-        if (out && (out->dtype() != input.dtype())) {
-          throw std::invalid_argument(
-              fmt::format("out array must have dtype={} but got {}",
-                          input.dtype().name(), out->dtype().name()));
+        ScopedGilRelease release(ByteCount(input));
+        if (out) {
+          CheckOutArray("exp", *out, input.shape(), input.dtype());
         }
-        auto compute = [&]<typename EltTy>() {
-          auto input_t = input.map_xtensor<EltTy>();
+        if (auto result = TryKernelExp(input, out, device_visible)) {
+          return *result;
+        }
+        auto compute = [&]<typename EltTy, size_t Rank>() {
+          auto input_t = MapRanked<EltTy, Rank>(input);
           auto result = xt::exp(*input_t);
 
           if (!out) {
@@ -1184,18 +1599,18 @@ void BindArrayHostOps(py::module_ &m) {
                                                input.dtype(), device_visible));
           }
 
-          auto out_t = out->map_xtensor_w<EltTy>();
+          auto out_t = MapRankedW<EltTy, Rank>(*out);
           *out_t = result;
 
           return *out;
         };
 
         switch (input.dtype()) {
-          SF_UNARY_FUNCTION_CASE(float8_e4m3fnuz, f8e4m3fnuz_t);
-          SF_UNARY_FUNCTION_CASE(float8_e4m3fn, f8e4m3fn_t);
-          SF_UNARY_FUNCTION_CASE(float16, half_float::half);
-          SF_UNARY_FUNCTION_CASE(bfloat16, bfloat16_t);
-          SF_UNARY_FUNCTION_CASE(float32, float);
+          SF_RANKED_FUNCTION_CASE(float8_e4m3fnuz, f8e4m3fnuz_t, input);
+          SF_RANKED_FUNCTION_CASE(float8_e4m3fn, f8e4m3fn_t, input);
+          SF_RANKED_FUNCTION_CASE(float16, half_float::half, input);
+          SF_RANKED_FUNCTION_CASE(bfloat16, bfloat16_t, input);
+          SF_RANKED_FUNCTION_CASE(float32, float, input);
           default:
             throw std::invalid_argument(
                 fmt::format("Unsupported dtype({}) for operator exp",
@@ -1210,13 +1625,12 @@ void BindArrayHostOps(py::module_ &m) {
       [](device_array &input, std::optional<device_array> out,
          bool device_visible) {
         SHORTFIN_TRACE_SCOPE_NAMED("PyHostOp::log");
-        if (out && (out->dtype() != input.dtype())) {
-          throw std::invalid_argument(
-              fmt::format("out array must have dtype={} but got {}",
-                          input.dtype().name(), out->dtype().name()));
+        ScopedGilRelease release(ByteCount(input));
+        if (out) {
+          CheckOutArray("log", *out, input.shape(), input.dtype());
         }
-        auto compute = [&]<typename EltTy>() {
-          auto input_t = input.map_xtensor<EltTy>();
+        auto compute = [&]<typename EltTy, size_t Rank>() {
+          auto input_t = MapRanked<EltTy, Rank>(input);
           auto result = xt::log(*input_t);
 
           if (!out) {
@@ -1224,18 +1638,18 @@ void BindArrayHostOps(py::module_ &m) {
                                                input.dtype(), device_visible));
           }
 
-          auto out_t = out->map_xtensor_w<EltTy>();
+          auto out_t = MapRankedW<EltTy, Rank>(*out);
           *out_t = result;
 
           return *out;
         };
 
         switch (input.dtype()) {
-          SF_UNARY_FUNCTION_CASE(float8_e4m3fnuz, f8e4m3fnuz_t);
-          SF_UNARY_FUNCTION_CASE(float8_e4m3fn, f8e4m3fn_t);
-          SF_UNARY_FUNCTION_CASE(float16, half_float::half);
-          SF_UNARY_FUNCTION_CASE(bfloat16, bfloat16_t);
-          SF_UNARY_FUNCTION_CASE(float32, float);
+          SF_RANKED_FUNCTION_CASE(float8_e4m3fnuz, f8e4m3fnuz_t, input);
+          SF_RANKED_FUNCTION_CASE(float8_e4m3fn, f8e4m3fn_t, input);
+          SF_RANKED_FUNCTION_CASE(float16, half_float::half, input);
+          SF_RANKED_FUNCTION_CASE(bfloat16, bfloat16_t, input);
+          SF_RANKED_FUNCTION_CASE(float32, float, input);
           default:
             throw std::invalid_argument(
                 fmt::format("Unsupported dtype({}) for operator log",
@@ -1250,45 +1664,49 @@ void BindArrayHostOps(py::module_ &m) {
       [](device_array &input, int axis, std::optional<device_array> out,
          bool device_visible) {
         SHORTFIN_TRACE_SCOPE_NAMED("PyHostOp::log_softmax");
+        ScopedGilRelease release(ByteCount(input));
         if (axis < 0) axis += input.shape().size();
         if (axis < 0 || axis >= input.shape().size()) {
           throw std::invalid_argument(
               fmt::format("Axis out of range: Must be [0, {}) but got {}",
                           input.shape().size(), axis));
         }
-        if (out && (out->dtype() != input.dtype())) {
-          throw std::invalid_argument(
-              fmt::format("out array must have dtype={} but got {}",
-                          input.dtype().name(), out->dtype().name()));
+        if (out) {
+          CheckOutArray("log_softmax", *out, input.shape(), input.dtype());
         }
-        auto compute = [&]<typename EltTy>() {
-          auto input_t = input.map_xtensor_rw<EltTy>();
+        if (auto result = TryKernelSoftmax(input, axis, out, /*log=*/true,
+                                           device_visible)) {
+          return *result;
+        }
+        auto compute = [&]<typename EltTy, size_t Rank>() {
+          auto input_t = MapRankedRw<EltTy, Rank>(input);
 
           auto max_vals = xt::amax(*input_t, {axis});
-          xt::xarray<EltTy> max_vals_keep_dim = xt::expand_dims(max_vals, axis);
+          RankedTensor<EltTy, Rank> max_vals_keep_dim =
+              xt::expand_dims(max_vals, axis);
 
-          xt::xarray<EltTy> input_stable = *input_t - max_vals_keep_dim;
+          RankedTensor<EltTy, Rank> input_stable = *input_t - max_vals_keep_dim;
 
           auto sum_exp = xt::sum(xt::exp(input_stable), {axis});
           auto sum_exp_expanded = xt::expand_dims(sum_exp, axis);
-          xt::xarray<EltTy> log_sum_exp = xt::log(sum_exp_expanded);
+          RankedTensor<EltTy, Rank> log_sum_exp = xt::log(sum_exp_expanded);
 
-          xt::xarray<EltTy> result = input_stable - log_sum_exp;
+          RankedTensor<EltTy, Rank> result = input_stable - log_sum_exp;
 
           if (!out) {
             out.emplace(device_array::for_host(input.device(), result.shape(),
                                                input.dtype(), device_visible));
           }
 
-          auto out_t = out->map_xtensor_w<EltTy>();
+          auto out_t = MapRankedW<EltTy, Rank>(*out);
           *out_t = result;
 
           return *out;
         };
 
         switch (input.dtype()) {
-          SF_UNARY_FUNCTION_CASE(float16, half_float::half);
-          SF_UNARY_FUNCTION_CASE(float32, float);
+          SF_RANKED_FUNCTION_CASE(float16, half_float::half, input);
+          SF_RANKED_FUNCTION_CASE(float32, float, input);
           default:
             throw std::invalid_argument(
                 fmt::format("Unsupported dtype({}) for operator log_softmax",
@@ -1303,45 +1721,50 @@ void BindArrayHostOps(py::module_ &m) {
       [](device_array &input, int axis, std::optional<device_array> out,
          bool device_visible) {
         SHORTFIN_TRACE_SCOPE_NAMED("PyHostOp::softmax");
+        ScopedGilRelease release(ByteCount(input));
         if (axis < 0) axis += input.shape().size();
         if (axis < 0 || axis >= input.shape().size()) {
           throw std::invalid_argument(
               fmt::format("Axis out of range: Must be [0, {}) but got {}",
                           input.shape().size(), axis));
         }
-        if (out && (out->dtype() != input.dtype())) {
-          throw std::invalid_argument(
-              fmt::format("out array must have dtype={} but got {}",
-                          input.dtype().name(), out->dtype().name()));
+        if (out) {
+          CheckOutArray("softmax", *out, input.shape(), input.dtype());
         }
-        auto compute = [&]<typename EltTy>() {
-          auto input_t = input.map_xtensor<EltTy>();
+        if (auto result = TryKernelSoftmax(input, axis, out, /*log=*/false,
+                                           device_visible)) {
+          return *result;
+        }
+        auto compute = [&]<typename EltTy, size_t Rank>() {
+          auto input_t = MapRanked<EltTy, Rank>(input);
 
           auto max_vals = xt::amax(*input_t, {axis});
-          xt::xarray<EltTy> max_vals_keep_dim = xt::expand_dims(max_vals, axis);
+          RankedTensor<EltTy, Rank> max_vals_keep_dim =
+              xt::expand_dims(max_vals, axis);
 
-          xt::xarray<EltTy> input_stable = *input_t - max_vals_keep_dim;
+          RankedTensor<EltTy, Rank> input_stable = *input_t - max_vals_keep_dim;
 
-          xt::xarray<EltTy> exp_input = xt::exp(input_stable);
+          RankedTensor<EltTy, Rank> exp_input = xt::exp(input_stable);
           auto sum_exp = xt::sum(exp_input, {axis});
-          xt::xarray<EltTy> sum_exp_expanded = xt::expand_dims(sum_exp, axis);
+          RankedTensor<EltTy, Rank> sum_exp_expanded =
+              xt::expand_dims(sum_exp, axis);
 
-          xt::xarray<EltTy> result = exp_input / sum_exp_expanded;
+          RankedTensor<EltTy, Rank> result = exp_input / sum_exp_expanded;
 
           if (!out) {
             out.emplace(device_array::for_host(input.device(), result.shape(),
                                                input.dtype(), device_visible));
           }
 
-          auto out_t = out->map_xtensor_w<EltTy>();
+          auto out_t = MapRankedW<EltTy, Rank>(*out);
           *out_t = result;
 
           return *out;
         };
 
         switch (input.dtype()) {
-          SF_UNARY_FUNCTION_CASE(float16, half_float::half);
-          SF_UNARY_FUNCTION_CASE(float32, float);
+          SF_RANKED_FUNCTION_CASE(float16, half_float::half, input);
+          SF_RANKED_FUNCTION_CASE(float32, float, input);
           default:
             throw std::invalid_argument(
                 fmt::format("Unsupported dtype({}) for operator softmax",
@@ -1351,6 +1774,16 @@ void BindArrayHostOps(py::module_ &m) {
       py::arg("input"), py::arg("axis") = -1, py::arg("out") = py::none(),
       py::arg("device_visible") = false, DOCSTRING_SOFTMAX);
 
+  m.def(
+      "set_parallel_host_ops",
+      [](bool enabled, size_t min_elements) {
+        parallel_host_ops_min_elements.store(min_elements);
+        parallel_host_ops_enabled.store(enabled);
+      },
+      py::arg("enabled"), py::kw_only(),
+      py::arg("min_elements") = size_t(1) << 18,
+      DOCSTRING_SET_PARALLEL_HOST_OPS);
+
   // Random number generation.
   py::class_<PyRandomGenerator>(m, "RandomGenerator")
       .def(py::init<std::optional<PyRandomGenerator::SeedType>>(),
@@ -1360,6 +1793,8 @@ void BindArrayHostOps(py::module_ &m) {
       [](device_array out, std::optional<PyRandomGenerator *> gen) {
         SHORTFIN_TRACE_SCOPE_NAMED("PyHostOp::fill_randn");
         if (!gen) gen = &PyRandomGenerator::get_default();
+        ScopedGilRelease release(ByteCount(out));
+        std::lock_guard<std::mutex> lock((*gen)->mutex());
         auto compute = [&]<typename EltTy>() {
           auto result = xt::random::randn(out.shape_container(), /*mean=*/0.0,
                                           /*std_dev=*/1.0, (*gen)->engine());
@@ -1391,12 +1826,32 @@ void BindArrayHostOps(py::module_ &m) {
   SF_DEF_CONVERT("floor", GenericElementwiseConvert<ConvertFloorFunctor>);
   SF_DEF_CONVERT("round", GenericElementwiseConvert<ConvertRoundFunctor>);
   SF_DEF_CONVERT("trunc", GenericElementwiseConvert<ConvertTruncFunctor>);
+  m.def(
+      "convert_into",
+      [](device_array &input, device_array &out) {
+        return GenericElementwiseConvert<ConvertFunctor>(input, out.dtype(),
+                                                         out, false);
+      },
+      py::arg("input"), py::arg("out"), DOCSTRING_CONVERT_INTO);
 
   // Transpose.
   m.def(
       "transpose",
       [](device_array input, std::vector<size_t> permutation,
          std::optional<device_array> out, bool device_visible) {
+        ScopedGilRelease release(ByteCount(input));
+        // An invalid permutation is reported by xtensor.
+        if (out && permutation.size() == input.shape().size() &&
+            std::ranges::all_of(permutation, [&](size_t axis) {
+              return axis < permutation.size();
+            })) {
+          Dims permuted_shape(permutation.size());
+          for (size_t i = 0; i < permutation.size(); ++i) {
+            permuted_shape[i] = input.shape()[permutation[i]];
+          }
+          CheckOutArray("transpose", *out, permuted_shape.span(),
+                        input.dtype());
+        }
         auto compute = [&]<typename EltTy>() -> device_array {
           auto input_t = input.map_xtensor<EltTy>();
           auto permuted_t =
@@ -8,16 +8,26 @@
 
 #include <nanobind/ndarray.h>
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+
 #include "./utils.h"
 #include "shortfin/array/array.h"
 #include "shortfin/array/storage.h"
+#include "shortfin/components/diffusion/denoise_loop.h"
+#include "shortfin/components/llm/batch_scheduler.h"
+#include "shortfin/components/llm/beam_search.h"
 #include "shortfin/components/llm/data.h"
+#include "shortfin/components/llm/logits_processors.h"
+#include "shortfin/components/llm/page_cache.h"
 #include "shortfin/components/llm/selectors.h"
 #include "shortfin/local/async.h"
 #include "shortfin/local/fiber.h"
 #include "shortfin/local/messaging.h"
 #include "shortfin/local/process.h"
 #include "shortfin/local/program.h"
+#include "shortfin/local/shared_queue.h"
 #include "shortfin/local/system.h"
 
 #if defined(SHORTFIN_HAVE_AMDGPU)
@@ -26,6 +36,7 @@
 #include "shortfin/local/systems/host.h"
 #include "shortfin/support/globals.h"
 #include "shortfin/support/logging.h"
+#include "shortfin/support/metrics.h"
 
 namespace shortfin::python {
 
@@ -65,6 +76,43 @@ Args:
   **kwargs: Key/value arguments for controlling setup of the system.
 )";
 
+static const char DOCSTRING_SYSTEM_BUILDER_PROCESS_SETTINGS[] =
+    R"(Process limits and kernel settings found by the last `create_system()`.
+
+Before creating devices, the builder reads the process's soft and hard limits
+on open files, threads and locked memory (needed for pinned host staging
+buffers) and the transparent huge page modes of the kernel, logging a warning
+with a recommendation for each setting likely to hurt performance. This is
+a dict of them (limits of -1 are unlimited, 0 unknown) with the list of
+`recommendations`, or None if no system has been created or tuning is
+disabled.
+
+Controlled by the keywords:
+
+  * "sysconfig_tune": Whether to inspect the settings (default true).
+  * "sysconfig_raise_limits": Raise the soft thread and locked memory limits
+    to the hard limits (default false).
+  * "sysconfig_min_memlock_mb": Locked memory limit below which raising it is
+    recommended (default 1024).
+)";
+
+static const char DOCSTRING_SYSTEM_TELEMETRY[] =
+    R"(The most recent sample of device health and throughput counters.
+
+A dict with the `time` of the sample (in seconds of the monotonic clock used
+by IREE) and the `devices` which report counters, mapping device name to a
+`DeviceTelemetry` (utilization, current and maximum clocks, temperature and
+power, with -1 for unknown counters). Empty if no sample has been taken.
+
+Samples are taken by a background thread when enabled with the keywords:
+
+  * "telemetry_interval_ms": Time between samples (default 0 = disabled).
+  * "telemetry_history": Number of samples to keep (default 600).
+
+so that latency outliers can be attributed to throttling after the fact (see
+`telemetry_history`). `sample_telemetry()` takes a sample on demand.
+)";
+
 static const char DOCSTRING_HOSTCPU_SYSTEM_BUILDER_CTOR[] =
     R"(Constructs a system with CPU based devices.
 
@@ -107,6 +155,34 @@ Similarly, it is available on a `SHORTFIN_` prefixed env variable if environment
 lookup is not disabled.
 )";
 
+static const char DOCSTRING_HOSTCPU_SYSTEM_BUILDER_NUMA_HOST_ALLOCATIONS[] =
+    R"(Whether to bind host allocations of each device to its NUMA node.
+
+When enabled, host buffers allocated for a device (i.e. by
+`storage.allocate_host` and staging transfers) prefer the NUMA node that the
+device is attached to, which is reported as `host_numa_node` in the device's
+repr. This also applies to the GPU devices of derived builders. Defaults to
+false.
+
+This can be set via a keyword of `numa_host_allocations` or on a `SHORTFIN_`
+prefixed env variable if environment lookup is not disabled.
+)";
+
+static const char DOCSTRING_HOSTCPU_SYSTEM_BUILDER_HOST_HUGE_PAGES[] =
+    R"(Page backing of large host allocations of each device.
+
+One of "none" (default), "thp" (transparent huge pages), "2mb" or "1gb"
+(huge pages reserved in /sys/kernel/mm/hugepages). Host buffers of a device
+spanning at least one huge page (i.e. staging buffers for large transfers)
+use them, which reduces TLB misses during copies. When no reserved huge
+pages are free, regular pages are used (with a warning). This is reported as
+`host_huge_pages` in the device's repr and also applies to the GPU devices of
+derived builders.
+
+This can be set via a keyword of `host_huge_pages` or on a `SHORTFIN_`
+prefixed env variable if environment lookup is not disabled.
+)";
+
 static const char DOCSTRING_PROGRAM_FUNCTION_INVOCATION[] =
     R"(Creates an invocation object targeting the function.
 
@@ -114,6 +190,280 @@ This is a low-level interface for performing an invocation, and it should be
 used when precise, non-default control is needed.
 )";
 
+static const char DOCSTRING_PROGRAM_INVOCATION_INVOKE_WITH[] =
+    R"(Adds a tuple of arguments and invokes.
+
+Equivalent to `add_arg` for each of `args` followed by `invoke()`, in a single
+call: arrays and storage are added without going through their Python
+marshaling method, and the GIL is released while the invocation is scheduled.
+)";
+
+static const char DOCSTRING_FIBER_BEGIN_CAPTURE[] =
+    R"(Begins capturing transfer commands scheduled on a device.
+
+Until `end_capture()`, fills and copies scheduled for `device` are recorded
+into a reusable command buffer instead of being submitted. Up to
+`binding_capacity` distinct storages may be referenced. Other queue operations
+(allocations, invocations) on the device are errors while capturing.
+)";
+
+static const char DOCSTRING_FIBER_SET_BUFFER_CACHE[] =
+    R"(Configures caching of device allocations made by the fiber.
+
+When `max_bytes` is non-zero, buffers released by `storage.allocate_device`
+allocations are retained (up to `max_bytes` per device queue) and reused by
+later allocations of the same size class, ordered after their previous uses on
+the device rather than round tripping through the allocator. Sizes are rounded
+up to a size class of at least `min_block_size` bytes. Setting `max_bytes` to
+0 disables caching and releases anything cached.
+)";
+
+static const char DOCSTRING_FIBER_REPLAY[] =
+    R"(Replays a captured command sequence against a list of storages.
+
+The list must contain one storage per slot of the capture, in the order the
+captured storages were first referenced. Each storage is scheduled as if the
+captured commands had been issued against it again.
+)";
+
+static const char DOCSTRING_SHARED_QUEUE_CREATE[] =
+    R"(Creates a queue of token id messages in new shared memory.
+
+Other processes open it with `SharedQueue.open(memory_fd, event_fd)`, passing
+the file descriptors of this queue (i.e. with `pass_fds` of a subprocess or
+over a unix socket). Any number of writers in any process may write to it, and
+a single reader consumes it. Up to `capacity` messages of at most `max_tokens`
+tokens can be in flight.
+)";
+
+static const char DOCSTRING_SHARED_QUEUE_TRY_WRITE[] =
+    R"(Writes `tokens` as a message tagged with `tag` (i.e. a request id).
+
+Returns False if every slot of the queue holds a message that the reader has
+not released yet.
+)";
+
+static const char DOCSTRING_SHARED_QUEUE_MESSAGE_TOKENS[] =
+    R"(The int32 tokens of the message, viewing the shared memory in place.
+
+The slot is returned to writers once the message and any views of its tokens
+are released, so copy the tokens to hold on to them.
+)";
+
+static const char DOCSTRING_LLM_SAMPLE_TOKENS[] =
+    R"(Samples one token per row of `logits` in a single fused host op.
+
+Args:
+  logits: float32 array of shape [..., vocab_size]. Every leading index is a
+    row to sample from.
+  config: DecodeConfig providing `temperature`, `top_k`, `top_p` and
+    `logits_normalization`. A `top_k` of 1 or a non-positive temperature
+    selects the argmax.
+  seed: Seed for the sampling generator. Defaults to a random seed.
+
+Returns:
+  A `(tokens, scores)` tuple of lists with one entry per row. Scores follow
+  `config.logits_normalization`, taken over the unrestricted
+  temperature-scaled distribution.
+)";
+
+static const char DOCSTRING_LLM_SELECT_TOKENS_BATCH[] =
+    R"(Selects tokens for every row of a decode batch in one call.
+
+Args:
+  logits: float32, float16 or bfloat16 array of shape [batch, vocab_size]
+    with unit stride along the vocabulary (i.e. a numpy array or a mapped
+    host `device_array`). It is read in place, without copying.
+  configs: A DecodeConfig for all rows or a list with one per row. Rows with
+    `use_beam_search` select their `num_beams` highest scoring tokens in
+    descending order, other rows their argmax.
+  selected_tokens: Preallocated int32 array of shape [batch, width].
+  selected_scores: Preallocated float32 array of shape [batch, width].
+  rng_states: uint64 array of shape [batch] with the random state of each
+    request, which is advanced in place. Required if any row samples (see
+    `uses_sampling`): keep one per request across decode steps, seeded as
+    desired, for reproducible sampling.
+
+Each row writes at most `width` selections, filling unused slots with a token
+of -1 and a score of -inf. Scores are the logits, except for sampled rows,
+whose scores follow `logits_normalization` as with `sample_tokens`.
+)";
+
+static const char DOCSTRING_LLM_VERIFY_DRAFT_TOKENS[] =
+    R"(Verifies speculatively decoded draft tokens for a batch of requests.
+
+Args:
+  target_logits: float32, float16 or bfloat16 array of shape
+    [batch * (draft_len + 1), vocab_size]: for each request, the target logits
+    at each of its draft positions plus one past the last.
+  draft_tokens: int32 array of shape [batch, draft_len].
+  configs: A DecodeConfig for all requests or a list with one per request.
+  draft_logits: Array of shape [batch * draft_len, vocab_size] of the draft
+    logits the draft tokens were sampled from. Required if any request
+    samples (see `uses_sampling`).
+  rng_states: uint64 array of shape [batch], advanced in place. Required if
+    any request samples.
+
+Requests which do not sample accept draft tokens while they match the argmax
+of the target. Sampled requests accept each draft token `d` with probability
+`min(1, p(d) / q(d))` under the target and draft distributions (restricted by
+the config as for sampling) and resample the first rejection from
+`max(0, p - q)`, which preserves the target distribution.
+
+Returns:
+  An `(accepted_counts, next_tokens)` tuple of lists with the number of
+  accepted draft tokens of each request and the token that follows them.
+)";
+
+static const char DOCSTRING_LLM_PAGE_POOL[] =
+    R"(Free list and reference counts of the pages of a paged KV cache.
+
+Pages are identified by their index in [0, page_count). Acquired pages start
+with a reference count of 1 and are freed when it drops to 0. Releasing a
+free page is a no-op.
+)";
+
+static const char DOCSTRING_LLM_PREFIX_TRIE[] =
+    R"(Prefix index of the pages of a paged KV cache.
+
+A trie of blocks of up to `tokens_per_page` tokens, where each node holds the
+page caching its block, looked up by the chained hash of the blocks. Nodes
+are int handles which stay unique after eviction (operations on evicted
+nodes are no-ops). `ROOT` has no page. Leaves without references are evicted
+by `eviction_policy`: least recently matched first (LRU), or least frequently
+matched first, by power of two buckets of the match count, then least
+recently (LFU), in O(1) per node. `stats()` counts lookups, block hits and
+evictions. `match_length(tokens)` counts the cached blocks of a prefix without
+marking them as matched.
+)";
+
+static const char DOCSTRING_LLM_PREFIX_TRIE_EVICT_NODES[] =
+    R"(Evicts up to `max_pages` nodes like `evict`, returning them in detail.
+
+Returns a list of `(page, hash, parent_hash, block)` tuples, from which a node
+can be re-attached with `create_child` below the node whose `hash` is
+`parent_hash`. `hash` is `hash_block(parent_hash, block)`.
+)";
+
+static const char DOCSTRING_LLM_BATCH_SCHEDULER[] =
+    R"(Batch formation of one batcher lane.
+
+Jobs (int ids of one invocation's work for a request, i.e. a prefill chunk or
+a decode step) are admitted with `submit(job, rid, token_count)` and formed
+into batches of up to `ideal_batch_size` jobs and `token_budget` tokens (0 for
+no limit) by `schedule(strobe)`, which returns the batches as lists of job ids.
+Requests are int `rid`s.
+
+`reserve(rid, count)` reserves batch slots for a request (0 drops them), which
+places it in a workgroup whose jobs only launch together, once all of its
+reserved jobs are ready. Unreserved jobs fill the space left, form ideal
+batches, or wait for the next strobe.
+
+With `sequential_jobs` (chunked prefill), a request has one job ready at a
+time: `complete(rid)` admits its next one and returns False, or returns True
+once it has none left.
+)";
+
+static const char DOCSTRING_LLM_LOGITS_PROCESSOR_CHAIN[] =
+    R"(Logits processors of one request, applied in place before selection.
+
+Processors apply in the order they are added (each `add_*` method returns the
+chain): `add_repetition_penalty(penalty)` divides the positive logits of
+tokens that occurred by `penalty` and multiplies the negative ones,
+`add_presence_penalty(presence, frequency=0.0)` subtracts `presence` plus
+`frequency` times the occurrence count, `add_logit_bias(bias)` adds a
+{token: bias} dict and `add_token_mask()` sets the logits of tokens not
+allowed to -inf.
+
+Occurrences are counted by `accept_tokens(tokens)` (i.e. with the tokens
+selected at each step) until `reset_tokens()`. The allowed tokens are set at
+each step (i.e. by a grammar) with `set_allowed_tokens(mask)`, a uint32 bitmask
+in which token `t` is bit `t % 32` of word `t // 32`, and tokens past its end
+are not allowed. All tokens are allowed until set or after
+`clear_allowed_tokens()`.
+
+`apply(logits, row=0)` processes one row of writable [rows, vocab_size]
+float32, float16 or bfloat16 logits.
+)";
+
+static const char DOCSTRING_LLM_APPLY_LOGITS_PROCESSORS[] =
+    R"(Applies `chains[r]` to row `r` of writable [rows, vocab_size] logits.
+
+There must be one chain per row, or None to leave a row as is. The GIL is
+released while the chains apply.
+)";
+
+static const char DOCSTRING_LLM_BEAM_SEARCH[] =
+    R"(Beam search state of one request.
+
+Each `step(logits)` takes the [live_beam_count, vocab_size] logits of the live
+beams (float32, float16 or bfloat16, read in place, with optional int32
+`indices` of the token id of each logit) and extends them by the `num_beams`
+most likely (beam, token) pairs under their cumulative log probabilities.
+Extensions ending in `eos_token_id` complete. After a step, `tokens`,
+`scores` and `parents` describe the new live beams (`parents` indexing the
+beams that were live before the step) and `results()` the best hypotheses as
+(tokens, score) tuples.
+
+Given the `position` of the first generated token and `tokens_per_page` of
+the KV cache, each step also plans the pages of the new beams: beams listed in
+`copy_last_page` must write to a copy of their parent's partially filled last
+page (which an earlier beam continues in place), and the pages of beams listed
+in `released` are no longer needed.
+)";
+
+static const char DOCSTRING_LLM_USES_SAMPLING[] =
+    R"(Whether `select_tokens_batch` samples rows with the DecodeConfig.
+
+True unless it is beam search, the temperature is not positive, or neither a
+`top_k` above 1 nor a `top_p` in (0, 1) restricts the distribution (in which
+case rows are selected greedily).
+)";
+
+static const char DOCSTRING_DIFFUSION_DENOISE_LOOP[] =
+    R"(Scheduler step loop of a diffusion model, chained on the device.
+
+Runs the optional `initialize` function over `initialize_args`, then for each
+step, the `stages` in order. The arguments of each stage are `DenoiseArg`s:
+`input(i)` (`inputs[i]` on every step), `step_input(i)` (row `step` of
+`inputs[i]`, i.e. the step index), `init_result(i)`, `stage_result(stage, i)`
+(of an earlier stage of the same step) or `latents()` (`latents` on the first
+step, then result 0 of the last stage of the previous step).
+
+`run(inputs, num_steps, fiber=)` returns a ProgramInvocationFuture of the
+invocation of the last stage of the last step, whose result 0 is the denoised
+latents. Invocations are issued back to back from C++, passing results on as
+refs, without waiting on the device or returning to Python between them.
+)";
+
+static const char DOCSTRING_METRICS_HISTOGRAM[] =
+    R"(Distribution of values in HDR-style log-linear buckets.
+
+Values are recorded lock-free, as integers in the units of the histogram:
+`record(value)` takes them as is and `observe(value)` scales a value in the
+exported unit (i.e. seconds) by `1 / unit`. Buckets bound their values within
+about 3% (1 / 32) of their magnitude. `quantile(q)` returns the upper bound of
+the bucket holding quantile `q`, in the exported unit.
+)";
+
+static const char DOCSTRING_METRICS_HISTOGRAM_FN[] =
+    R"(Returns the histogram of `name` and `labels` in the process registry.
+
+Metrics are created on first use and live as long as the process, for
+recording sites to keep. `labels` are formatted Prometheus labels (i.e.
+`lane="prefill"`) distinguishing the metrics of a name. `unit` scales recorded
+values to the exported unit: a histogram of microseconds exported in seconds
+has a unit of 1e-6. Raises ValueError if `name` is invalid or registered with
+another type or unit. `counter` and `gauge` are alike.
+)";
+
+static const char DOCSTRING_METRICS_EXPORT_PROMETHEUS[] =
+    R"(Exports the metrics of the process in the Prometheus text format.
+
+Histograms export cumulative buckets at each power of two of the recorded
+values, up to the highest one holding values.
+)";
+
 class Refs {
  public:
   py::object asyncio_create_task =
@@ -294,6 +644,33 @@ class PyProcess : public local::detail::BaseProcess {
   std::shared_ptr<Refs> refs_;
 };
 
+sysconfig::HugePages ParseHugePages(std::string_view value) {
+  auto pages = sysconfig::ParseHugePages(value);
+  if (!pages) {
+    throw std::invalid_argument(fmt::format(
+        "Illegal huge pages '{}' (expected one of none, thp, 2mb, 1gb)",
+        value));
+  }
+  return *pages;
+}
+
+local::StaticProgramParameters::LoadOptions MakeParameterLoadOptions(
+    std::string_view format, bool readable, bool writable, bool mmap,
+    bool lazy, bool direct_io, size_t direct_io_chunk_size,
+    int direct_io_queue_depth, std::string_view huge_pages = "none") {
+  local::StaticProgramParameters::LoadOptions options;
+  options.format = format;
+  options.readable = readable;
+  options.writable = writable;
+  options.mmap = mmap;
+  options.lazy = lazy;
+  options.direct_io = direct_io;
+  options.direct_io_chunk_size = direct_io_chunk_size;
+  options.direct_io_queue_depth = direct_io_queue_depth;
+  options.huge_pages = ParseHugePages(huge_pages);
+  return options;
+}
+
 void PyAddProgramInvocationArg(py::capsule &inv_capsule, py::handle arg) {
   // See if the object implements our marshaling protocol. If it does, then
   // We invoke the marshaling method with the Invocation wrapped as a capsule
@@ -310,17 +687,44 @@ void PyAddProgramInvocationArg(py::capsule &inv_capsule, py::handle arg) {
                   py::cast<std::string>(py::repr(arg.type()))));
 }
 
-local::ProgramInvocation::Future PyFunctionCall(
-    local::ProgramFunction &self, py::args args, local::Fiber &fiber,
-    std::optional<local::ProgramIsolation> isolation) {
-  auto inv = self.CreateInvocation(fiber.shared_from_this(), isolation);
-  py::capsule inv_capsule(inv.get());
+// Adds each of `args` to `inv`. Arrays and storage are added directly as
+// native arguments, skipping the lookup and call of `__sfinv_marshal__`,
+// which other objects still go through.
+void PyAddProgramInvocationArgs(local::ProgramInvocation &inv,
+                                py::handle args) {
+  py::capsule inv_capsule;
   for (py::handle arg : args) {
+    local::ProgramInvocationMarshalable *marshalable = nullptr;
+    if (py::isinstance<array::device_array>(arg)) {
+      marshalable = py::inst_ptr<array::device_array>(arg);
+    } else if (py::isinstance<array::storage>(arg)) {
+      marshalable = py::inst_ptr<array::storage>(arg);
+    }
+    if (marshalable) {
+      marshalable->AddAsInvocationArgument(
+          &inv, local::ProgramResourceBarrier::DEFAULT);
+      continue;
+    }
+    if (!inv_capsule.is_valid()) inv_capsule = py::capsule(&inv);
     PyAddProgramInvocationArg(inv_capsule, arg);
   }
+}
+
+// Schedules `inv` with the GIL released: on the current worker, this runs
+// the function up to its first wait.
+local::ProgramInvocation::Future PyInvoke(local::ProgramInvocation::Ptr inv) {
+  py::gil_scoped_release release;
   return local::ProgramInvocation::Invoke(std::move(inv));
 }
 
+local::ProgramInvocation::Future PyFunctionCall(
+    local::ProgramFunction &self, py::args args, local::Fiber &fiber,
+    std::optional<local::ProgramIsolation> isolation) {
+  auto inv = self.CreateInvocation(fiber.shared_from_this(), isolation);
+  PyAddProgramInvocationArgs(*inv, args);
+  return PyInvoke(std::move(inv));
+}
+
 // Wraps a ProgramInvocation::Ptr representing a completed (awaited) invocation.
 // Holds some additional accounting for marshaling results back to Python.
 class PyProgramInvocation {
@@ -330,6 +734,7 @@ class PyProgramInvocation {
   PyProgramInvocation(const PyProgramInvocation &) = delete;
   PyProgramInvocation(PyProgramInvocation &&other)
       : inv_(std::move(other.inv_)),
+        output_args_(std::move(other.output_args_)),
         cached_results_(std::move(other.cached_results_)),
         results_failure_(other.results_failure_) {}
 
@@ -342,6 +747,31 @@ class PyProgramInvocation {
   }
   local::ProgramInvocation::Ptr &inv() { return inv_; }
 
+  void Reset() {
+    CheckValid();
+    inv_->Reset();
+    output_args_.clear();
+    cached_results_ = py::object();
+    results_failure_ = false;
+  }
+
+  // Adds a preallocated output, which is returned as the result it is
+  // donated to.
+  void AddOutputArg(py::handle arg) {
+    CheckValid();
+    py::object marshaler = py::getattr(arg, "__sfinv_marshal__", py::none());
+    if (marshaler.is_none()) {
+      throw std::invalid_argument(
+          fmt::format("Unsupported output argument type {}",
+                      py::cast<std::string>(py::repr(arg.type()))));
+    }
+    iree_host_size_t arg_index = inv_->args_size();
+    marshaler(py::capsule(inv_.get()),
+              static_cast<int>(local::ProgramResourceBarrier::WRITE));
+    inv_->MarkOutputArg(arg_index);
+    output_args_.emplace_back(arg_index, py::borrow(arg));
+  }
+
   py::object results() {
     if (results_failure_) {
       throw std::logic_error("Prior attempt to marshal IREE results failed");
@@ -364,6 +794,11 @@ class PyProgramInvocation {
     size_t size = inv_->results_size();
     py::object tp = py::steal(PyTuple_New(size));
     for (size_t i = 0; i < size; ++i) {
+      if (auto arg_index = inv_->donated_output_for_result(i)) {
+        py::object item = DonatedOutput(*arg_index);
+        PyTuple_SET_ITEM(tp.ptr(), i, item.release().ptr());
+        continue;
+      }
       iree::vm_opaque_ref ref = inv_->result_ref(i);
       if (!ref) {
         throw new std::logic_error("Program returned unsupported Python type");
@@ -407,7 +842,16 @@ class PyProgramInvocation {
                     to_string_view(iree_vm_ref_type_name(type))));
   }
 
+  py::object DonatedOutput(iree_host_size_t arg_index) {
+    for (auto &[output_arg_index, output] : output_args_) {
+      if (output_arg_index == arg_index) return output;
+    }
+    throw std::logic_error("Donated output was not added from Python");
+  }
+
   local::ProgramInvocation::Ptr inv_;
+  // Arg index and object of each donated output.
+  std::vector<std::pair<iree_host_size_t, py::object>> output_args_;
   py::object cached_results_;
   bool results_failure_ = false;
 };
@@ -495,6 +939,68 @@ ConfigOptions CreateConfigOptions(std::optional<std::string> &env_prefix,
   return options;
 }
 
+// Casts a message to Python, which takes over its lifetime. Messages from a
+// MessagePool are recycled by the pool and cannot be handed over.
+py::object CastMessage(local::Message::Ref &message) {
+  if (message->is_pooled()) {
+    throw std::logic_error(
+        "Messages allocated from a MessagePool cannot be passed to Python");
+  }
+  return py::cast(message.get());
+}
+
+py::dict TelemetrySampleToDict(const local::TelemetrySample &sample) {
+  py::dict d;
+  if (!sample.time_ns) return d;
+  py::dict devices;
+  for (auto &[device, telemetry] : sample.devices) {
+    devices[py::cast(device->name())] = py::cast(telemetry);
+  }
+  d["time"] = sample.time_ns / 1e9;
+  d["devices"] = devices;
+  return d;
+}
+
+using LogitsArray = py::ndarray<py::ro, py::ndim<2>, py::device::cpu>;
+using MutableLogitsArray = py::ndarray<py::ndim<2>, py::device::cpu>;
+
+// Views a 2D float32, float16 or bfloat16 array of logits in place, as a
+// LogitsView or MutableLogitsView.
+template <typename View, typename Array>
+View ViewLogits(Array &logits) {
+  View view;
+  if (logits.dtype() == py::dtype<float>()) {
+    view.dtype = llm::LogitsDType::FLOAT32;
+  } else if (logits.dtype() ==
+             py::dlpack::dtype{
+                 static_cast<uint8_t>(py::dlpack::dtype_code::Float), 16, 1}) {
+    view.dtype = llm::LogitsDType::FLOAT16;
+  } else if (logits.dtype() ==
+             py::dlpack::dtype{
+                 static_cast<uint8_t>(py::dlpack::dtype_code::Bfloat), 16, 1}) {
+    view.dtype = llm::LogitsDType::BFLOAT16;
+  } else {
+    throw std::invalid_argument("logits must be float32, float16 or bfloat16");
+  }
+  if (logits.shape(1) > 1 && logits.stride(1) != 1) {
+    throw std::invalid_argument(
+        "logits must have unit stride along the vocabulary");
+  }
+  view.data = logits.data();
+  view.rows = logits.shape(0);
+  view.vocab_size = logits.shape(1);
+  view.row_stride = logits.stride(0);
+  return view;
+}
+
+llm::LogitsView MakeLogitsView(LogitsArray &logits) {
+  return ViewLogits<llm::LogitsView>(logits);
+}
+
+llm::MutableLogitsView MakeMutableLogitsView(MutableLogitsArray &logits) {
+  return ViewLogits<llm::MutableLogitsView>(logits);
+}
+
 }  // namespace
 
 NB_MODULE(lib, m) {
@@ -541,6 +1047,14 @@ NB_MODULE(lib, m) {
   m.def("log_info", [](std::string_view sv) { logging::info("{}", sv); });
   m.def("log_warn", [](std::string_view sv) { logging::warn("{}", sv); });
   m.def("log_error", [](std::string_view sv) { logging::error("{}", sv); });
+  m.def("log_flush", []() {
+    py::gil_scoped_release release;
+    logging::Flush();
+  });
+  m.def(
+      "log_enable_async",
+      [](size_t capacity) { logging::EnableAsync(capacity); },
+      py::arg("capacity") = 8192);
 
   auto local_m = m.def_submodule("local");
   BindLocal(local_m);
@@ -552,8 +1066,14 @@ NB_MODULE(lib, m) {
   auto array_m = m.def_submodule("array");
   BindArray(array_m);
 
+  auto diffusion_m = m.def_submodule("diffusion");
+  BindDiffusion(diffusion_m);
+
   auto llm_m = m.def_submodule("llm");
   BindLLM(llm_m);
+
+  auto metrics_m = m.def_submodule("metrics");
+  BindMetrics(metrics_m);
 }
 
 void BindLocal(py::module_ &m) {
@@ -583,6 +1103,24 @@ void BindLocal(py::module_ &m) {
       .value("PER_CALL", local::ProgramIsolation::PER_CALL)
       .export_values();
 
+  py::enum_<local::detail::TransactionMode>(m, "TransactionMode")
+      .value("EAGER", local::detail::TransactionMode::EAGER)
+      .value("EXPLICIT", local::detail::TransactionMode::EXPLICIT)
+      .value("BATCHED", local::detail::TransactionMode::BATCHED)
+      .export_values();
+
+  py::enum_<local::detail::AccountPlacement>(m, "AccountPlacement")
+      .value("LOWEST_QUEUE", local::detail::AccountPlacement::LOWEST_QUEUE)
+      .value("ROUND_ROBIN", local::detail::AccountPlacement::ROUND_ROBIN)
+      .value("LEAST_OUTSTANDING",
+             local::detail::AccountPlacement::LEAST_OUTSTANDING)
+      .export_values();
+
+  py::enum_<local::detail::TransactionPriority>(m, "TransactionPriority")
+      .value("THROUGHPUT", local::detail::TransactionPriority::THROUGHPUT)
+      .value("LATENCY", local::detail::TransactionPriority::LATENCY)
+      .export_values();
+
   py::class_<local::SystemBuilder>(m, "SystemBuilder")
       .def("__init__", [](py::args, py::kwargs) {})
       .def_static(
@@ -622,6 +1160,29 @@ void BindLocal(py::module_ &m) {
           [refs](py::handle /*unused*/, std::optional<std::string> st) {
             refs->set_default_system_type(std::move(st));
           })
+      .def_prop_ro(
+          "process_settings",
+          [](local::SystemBuilder &self) -> std::optional<py::dict> {
+            auto &settings = self.process_settings();
+            if (!settings) return std::nullopt;
+            auto limit = [](uint64_t value) -> int64_t {
+              return value == sysconfig::ProcessSettings::kUnlimited
+                         ? -1
+                         : static_cast<int64_t>(value);
+            };
+            py::dict d;
+            d["file_limit"] = limit(settings->file_limit);
+            d["file_limit_max"] = limit(settings->file_limit_max);
+            d["thread_limit"] = limit(settings->thread_limit);
+            d["thread_limit_max"] = limit(settings->thread_limit_max);
+            d["memlock_limit"] = limit(settings->memlock_limit);
+            d["memlock_limit_max"] = limit(settings->memlock_limit_max);
+            d["thp_enabled"] = settings->thp_enabled;
+            d["thp_defrag"] = settings->thp_defrag;
+            d["recommendations"] = settings->recommendations;
+            return d;
+          },
+          DOCSTRING_SYSTEM_BUILDER_PROCESS_SETTINGS)
       .def("create_system", [live_system_refs,
                              worker_initializer](local::SystemBuilder &self) {
         auto system_ptr = self.CreateSystem();
@@ -689,15 +1250,18 @@ void BindLocal(py::module_ &m) {
           py::rv_policy::reference_internal)
       .def(
           "create_queue",
-          [](local::System &self,
-             std::optional<std::string> name) -> std::shared_ptr<local::Queue> {
+          [](local::System &self, std::optional<std::string> name,
+             size_t capacity, bool lock_free) -> std::shared_ptr<local::Queue> {
             local::Queue::Options options;
             if (name) {
               options.name = std::move(*name);
             }
+            options.capacity = capacity;
+            options.lock_free = lock_free;
             return self.CreateQueue(std::move(options));
           },
-          py::arg("name") = py::none(), py::rv_policy::reference_internal)
+          py::arg("name") = py::none(), py::kw_only(), py::arg("capacity") = 0,
+          py::arg("lock_free") = false, py::rv_policy::reference_internal)
       .def("named_queue", &local::System::named_queue, py::arg("name"),
            py::rv_policy::reference_internal)
       .def(
@@ -728,14 +1292,76 @@ void BindLocal(py::module_ &m) {
           py::arg("devices") = py::none())
       .def(
           "create_worker",
-          [refs](local::System &self, std::string name) -> local::Worker & {
+          [refs](local::System &self, std::string name,
+                 std::optional<double> quantum, double busy_poll,
+                 bool adaptive_quantum, double min_quantum,
+                 std::optional<std::vector<int>> cpus,
+                 std::optional<int> numa_node) -> local::Worker & {
             local::Worker::Options options(self.host_allocator(),
                                            std::move(name));
+            if (quantum) {
+              options.quantum = iree_make_timeout_ns(
+                  static_cast<iree_duration_t>(*quantum * 1e9));
+            }
+            options.busy_poll_ns = static_cast<iree_duration_t>(busy_poll * 1e9);
+            options.adaptive_quantum = adaptive_quantum;
+            options.min_quantum_ns =
+                static_cast<iree_duration_t>(min_quantum * 1e9);
+            if (cpus) options.cpus = std::move(*cpus);
+            if (numa_node) options.numa_node = *numa_node;
             return self.CreateWorker(options);
           },
-          py::arg("name"), py::rv_policy::reference_internal)
+          py::arg("name"), py::kw_only(), py::arg("quantum") = py::none(),
+          py::arg("busy_poll") = 0.0, py::arg("adaptive_quantum") = false,
+          py::arg("min_quantum") = 0.001, py::arg("cpus") = py::none(),
+          py::arg("numa_node") = py::none(), py::rv_policy::reference_internal)
+      .def(
+          "create_worker_group",
+          [](local::System &self, std::string name,
+             size_t worker_count) -> local::WorkerGroup & {
+            return self.CreateWorkerGroup(std::move(name), worker_count);
+          },
+          py::arg("name"), py::arg("worker_count"),
+          py::rv_policy::reference_internal)
       .def_prop_ro("init_worker", &local::System::init_worker,
                    py::rv_policy::reference_internal)
+      .def_prop_ro("telemetry",
+                   [](local::System &self) {
+                     return TelemetrySampleToDict(self.telemetry().latest());
+                   },
+                   DOCSTRING_SYSTEM_TELEMETRY)
+      .def_prop_ro("telemetry_history",
+                   [](local::System &self) {
+                     py::list samples;
+                     for (auto &sample : self.telemetry().history()) {
+                       samples.append(TelemetrySampleToDict(sample));
+                     }
+                     return samples;
+                   })
+      .def("sample_telemetry",
+           [](local::System &self) {
+             local::TelemetrySample sample;
+             {
+               py::gil_scoped_release release;
+               sample = self.telemetry().SampleNow();
+             }
+             return TelemetrySampleToDict(sample);
+           })
+      .def_prop_ro("blocking_executor_metrics",
+                   [](local::System &self) {
+                     auto m = self.blocking_executor().metrics();
+                     py::dict d;
+                     d["live_threads"] = m.live_threads;
+                     d["active_threads"] = m.active_threads;
+                     d["free_threads"] = m.free_threads;
+                     d["queued_tasks"] = m.queued_tasks;
+                     d["completed_tasks"] = m.completed_tasks;
+                     d["rejected_tasks"] = m.rejected_tasks;
+                     d["reaped_threads"] = m.reaped_threads;
+                     d["p50_task_latency"] = m.p50_task_latency_ns / 1e9;
+                     d["p99_task_latency"] = m.p99_task_latency_ns / 1e9;
+                     return d;
+                   })
       .def(
           "run",
           [refs](local::System &self, py::object coro) {
@@ -745,7 +1371,15 @@ void BindLocal(py::module_ &m) {
       // Methods not on System but on child objects, taking System as an arg.
       // Emitted here for convenience.
       .def("load_module", &local::ProgramModule::Load, py::arg("path"),
-           py::arg("mmap") = false);
+           py::arg("mmap") = false)
+      .def(
+          "load_modules",
+          [](local::System &self, std::vector<std::filesystem::path> paths,
+             bool mmap) {
+            py::gil_scoped_release release;
+            return local::ProgramModule::LoadAll(self, paths, mmap);
+          },
+          py::arg("paths"), py::arg("mmap") = false);
 
   // Support classes.
   py::class_<local::Node>(m, "Node")
@@ -753,9 +1387,45 @@ void BindLocal(py::module_ &m) {
       .def("__repr__", [](local::Node &self) {
         return fmt::format("local::Node({})", self.node_num());
       });
+  py::class_<local::DeviceMemoryStats>(m, "DeviceMemoryStats")
+      .def_ro("allocator_statistics",
+              &local::DeviceMemoryStats::allocator_statistics)
+      .def_ro("device_bytes_allocated",
+              &local::DeviceMemoryStats::device_bytes_allocated)
+      .def_ro("device_bytes_peak", &local::DeviceMemoryStats::device_bytes_peak)
+      .def_ro("host_bytes_allocated",
+              &local::DeviceMemoryStats::host_bytes_allocated)
+      .def_ro("host_bytes_peak", &local::DeviceMemoryStats::host_bytes_peak)
+      .def_ro("cached_bytes", &local::DeviceMemoryStats::cached_bytes)
+      .def_ro("staging_bytes", &local::DeviceMemoryStats::staging_bytes)
+      .def_ro("total_bytes", &local::DeviceMemoryStats::total_bytes)
+      .def_ro("used_bytes", &local::DeviceMemoryStats::used_bytes)
+      .def_prop_ro("free_bytes", &local::DeviceMemoryStats::free_bytes)
+      .def("__repr__", &local::DeviceMemoryStats::to_s);
+  py::class_<local::DeviceTelemetry>(m, "DeviceTelemetry")
+      .def_ro("busy_percent", &local::DeviceTelemetry::busy_percent)
+      .def_ro("memory_busy_percent",
+              &local::DeviceTelemetry::memory_busy_percent)
+      .def_ro("shader_clock_mhz", &local::DeviceTelemetry::shader_clock_mhz)
+      .def_ro("max_shader_clock_mhz",
+              &local::DeviceTelemetry::max_shader_clock_mhz)
+      .def_ro("memory_clock_mhz", &local::DeviceTelemetry::memory_clock_mhz)
+      .def_ro("max_memory_clock_mhz",
+              &local::DeviceTelemetry::max_memory_clock_mhz)
+      .def_ro("temperature_mc", &local::DeviceTelemetry::temperature_mc)
+      .def_ro("power_uw", &local::DeviceTelemetry::power_uw)
+      .def("__repr__", &local::DeviceTelemetry::to_s);
   py::class_<local::Device>(m, "Device")
       .def_prop_ro("name", &local::Device::name)
       .def_prop_ro("node_affinity", &local::Device::node_affinity)
+      .def_prop_ro("host_numa_node", &local::Device::host_numa_node)
+      .def_prop_ro("host_huge_pages",
+                   [](local::Device &self) {
+                     return sysconfig::to_string_view(self.host_huge_pages());
+                   })
+      .def_prop_ro("unified_memory", &local::Device::unified_memory)
+      .def("can_access_peer", &local::Device::CanAccessPeer, py::arg("other"))
+      .def_prop_ro("memory_stats", &local::Device::QueryMemoryStats)
       .def(py::self == py::self)
       .def("__repr__", &local::Device::to_s);
   py::class_<local::DeviceAffinity>(m, "DeviceAffinity")
@@ -770,18 +1440,59 @@ void BindLocal(py::module_ &m) {
       .def(
           py::new_([](std::span<const local::ProgramModule> modules,
                       std::vector<const local::Device *> devices,
-                      bool trace_execution, local::ProgramIsolation isolation) {
+                      bool trace_execution, local::ProgramIsolation isolation,
+                      bool profile_invocations) {
             local::Program::Options options;
             options.devices = devices;
             options.trace_execution = trace_execution;
             options.isolation = isolation;
+            options.profile_invocations = profile_invocations;
             return local::Program::Load(modules, std::move(options));
           }),
           py::arg("modules"), py::kw_only(), py::arg("devices"),
           py::arg("trace_execution") = false,
-          py::arg("isolation") = local::ProgramIsolation::PER_FIBER)
+          py::arg("isolation") = local::ProgramIsolation::PER_FIBER,
+          py::arg("profile_invocations") = false)
       .def_prop_ro("exports", &local::Program::exports)
       .def_prop_ro("isolation", &local::Program::isolation)
+      .def(
+          "prepare_isolates",
+          [](local::Program &self, std::vector<local::Fiber *> fibers,
+             size_t contexts_per_fiber) {
+            self.PrepareIsolates(fibers, contexts_per_fiber);
+          },
+          py::arg("fibers"), py::arg("contexts_per_fiber") = 1,
+          "Forks and caches the isolated contexts of the program for each "
+          "fiber so that first invocations do not pay for it")
+      .def_prop_ro(
+          "invocation_profile",
+          [](local::Program &self) -> py::object {
+            auto *profile = self.invocation_profile();
+            if (!profile) return py::none();
+            auto phase_times = [](py::dict &d, const char *name,
+                                  const auto &phase) {
+              d[fmt::format("{}_time", name).c_str()] = phase.total_ns / 1e9;
+              d[fmt::format("max_{}_time", name).c_str()] = phase.max_ns / 1e9;
+            };
+            py::dict functions;
+            for (auto &[name, stats] : profile->Snapshot()) {
+              py::dict d;
+              d["count"] = stats.count;
+              d["failed_count"] = stats.failed_count;
+              phase_times(d, "enqueue", stats.enqueue);
+              phase_times(d, "execute", stats.execute);
+              phase_times(d, "wait", stats.wait);
+              phase_times(d, "signal", stats.signal);
+              functions[name.c_str()] = d;
+            }
+            return functions;
+          },
+          "Per function totals and maxima (in seconds) of invocation phases, "
+          "or None if the program was not loaded with profile_invocations")
+      .def("reset_invocation_profile",
+           [](local::Program &self) {
+             if (auto *profile = self.invocation_profile()) profile->Reset();
+           })
       .def("lookup_function", &local::Program::LookupRequiredFunction)
       .def("__getitem__", &local::Program::LookupRequiredFunction);
   py::class_<local::ProgramFunction>(m, "ProgramFunction")
@@ -802,6 +1513,12 @@ void BindLocal(py::module_ &m) {
       .def("__repr__", &local::ProgramFunction::to_s);
   py::class_<local::ProgramModule>(m, "ProgramModule")
       .def_prop_ro("exports", &local::ProgramModule::exports)
+      .def_prop_ro(
+          "load_duration",
+          [](local::ProgramModule &self) {
+            return self.load_duration_ns() / 1e9;
+          },
+          "Seconds taken to load the module (0 if not loaded from a file)")
       .def("__repr__", &local::ProgramModule::to_s)
       .def_static("load", &local::ProgramModule::Load, py::arg("system"),
                   py::arg("path"), py::arg("mmap") = false)
@@ -826,14 +1543,50 @@ void BindLocal(py::module_ &m) {
       .def("invoke",
            [](PyProgramInvocation &self) {
              self.CheckValid();
-             return local::ProgramInvocation::Invoke(std::move(self.inv()));
+             return PyInvoke(std::move(self.inv()));
            })
+      .def(
+          "invoke_with",
+          [](PyProgramInvocation &self, py::tuple args) {
+            self.CheckValid();
+            PyAddProgramInvocationArgs(*self.inv(), args);
+            return PyInvoke(std::move(self.inv()));
+          },
+          py::arg("args"), DOCSTRING_PROGRAM_INVOCATION_INVOKE_WITH)
+      .def("reset", &PyProgramInvocation::Reset,
+           "Clears the arguments and results of a completed invocation so "
+           "that it can be rebound with add_arg and invoked again")
       .def("add_arg",
            [](PyProgramInvocation &self, py::handle arg) {
              self.CheckValid();
-             py::capsule inv_capsule(&self.inv());
+             py::capsule inv_capsule(self.inv().get());
              PyAddProgramInvocationArg(inv_capsule, arg);
            })
+      .def("add_output_arg", &PyProgramInvocation::AddOutputArg,
+           py::arg("output"),
+           "Adds a preallocated output for a function that writes a result "
+           "into an argument. The result is returned as this same object.")
+      .def(
+          "wait_after",
+          [](PyProgramInvocation &self, PyProgramInvocation &producer) {
+            self.CheckValid();
+            producer.CheckValid();
+            self.inv()->WaitAfter(*producer.inv());
+          },
+          py::arg("producer"),
+          "Orders the device work of this invocation after that of a completed "
+          "invocation, without waiting on the host")
+      .def(
+          "add_result_arg",
+          [](PyProgramInvocation &self, PyProgramInvocation &producer,
+             iree_host_size_t i) {
+            self.CheckValid();
+            producer.CheckValid();
+            self.inv()->AddResultArg(*producer.inv(), i);
+          },
+          py::arg("producer"), py::arg("index"),
+          "Adds the i'th result of a completed invocation as the next "
+          "argument, chained on the device")
       .def("__iter__",
            [](PyProgramInvocation &self) {
              return self.results().attr("__iter__")();
@@ -869,17 +1622,83 @@ void BindLocal(py::module_ &m) {
           "load",
           [](local::StaticProgramParameters &self,
              std::filesystem::path file_path, std::string_view format,
-             bool readable, bool writable, bool mmap) {
-            local::StaticProgramParameters::LoadOptions options;
-            options.format = format;
-            options.readable = readable;
-            options.writable = writable;
-            options.mmap = mmap;
+             bool readable, bool writable, bool mmap, bool lazy,
+             bool direct_io, size_t direct_io_chunk_size,
+             int direct_io_queue_depth, int shard_index,
+             std::optional<std::filesystem::path> index_cache_path,
+             std::string_view huge_pages) {
+            auto options = MakeParameterLoadOptions(
+                format, readable, writable, mmap, lazy, direct_io,
+                direct_io_chunk_size, direct_io_queue_depth, huge_pages);
+            options.shard_index = shard_index;
+            if (index_cache_path) options.index_cache_path = *index_cache_path;
+            py::gil_scoped_release release;
             self.Load(file_path, options);
           },
           py::arg("file_path"), py::arg("format") = std::string_view(),
           py::arg("readable") = true, py::arg("writable") = false,
-          py::arg("mmap") = false);
+          py::arg("mmap") = false, py::arg("lazy") = false,
+          py::arg("direct_io") = false,
+          py::arg("direct_io_chunk_size") = 8 * 1024 * 1024,
+          py::arg("direct_io_queue_depth") = 4, py::arg("shard_index") = -1,
+          py::arg("index_cache_path") = py::none(),
+          py::arg("huge_pages") = "none")
+      .def(
+          "prefetch",
+          [](local::StaticProgramParameters &self,
+             std::vector<std::string> names) {
+            std::vector<std::string_view> name_views(names.begin(),
+                                                     names.end());
+            return self.Prefetch(name_views);
+          },
+          py::arg("names"),
+          "Begins paging in the named parameters, returning the number of "
+          "bytes hinted");
+  py::class_<local::ShardedProgramParameters>(m, "ShardedProgramParameters")
+      .def(py::init<local::System &, std::string_view,
+                    std::vector<local::Device *>, iree_host_size_t>(),
+           py::arg("system"), py::arg("parameter_scope"), py::arg("devices"),
+           py::arg("max_concurrent_operations") =
+               IREE_IO_PARAMETER_INDEX_PROVIDER_DEFAULT_MAX_CONCURRENT_OPERATIONS)
+      .def(
+          "load",
+          [](local::ShardedProgramParameters &self,
+             std::filesystem::path file_path, std::string_view format,
+             bool mmap, bool lazy,
+             std::optional<std::filesystem::path> index_cache_path) {
+            auto options = MakeParameterLoadOptions(
+                format, /*readable=*/true, /*writable=*/false, mmap, lazy,
+                /*direct_io=*/false, /*direct_io_chunk_size=*/0,
+                /*direct_io_queue_depth=*/0);
+            if (index_cache_path) options.index_cache_path = *index_cache_path;
+            py::gil_scoped_release release;
+            self.Load(file_path, options);
+          },
+          py::arg("file_path"), py::arg("format") = std::string_view(),
+          py::arg("mmap") = false, py::arg("lazy") = false,
+          py::arg("index_cache_path") = py::none(),
+          "Loads a file containing all shards, splitting it across devices")
+      .def(
+          "load_shard",
+          [](local::ShardedProgramParameters &self, size_t shard_index,
+             std::filesystem::path file_path, std::string_view format,
+             bool mmap, bool lazy, bool direct_io) {
+            auto options = MakeParameterLoadOptions(
+                format, /*readable=*/true, /*writable=*/false, mmap, lazy,
+                direct_io, /*direct_io_chunk_size=*/8 * 1024 * 1024,
+                /*direct_io_queue_depth=*/4);
+            py::gil_scoped_release release;
+            self.LoadShard(shard_index, file_path, options);
+          },
+          py::arg("shard_index"), py::arg("file_path"),
+          py::arg("format") = std::string_view(), py::arg("mmap") = false,
+          py::arg("lazy") = false, py::arg("direct_io") = false,
+          "Loads a file holding the parameters of one shard")
+      .def("for_device", &local::ShardedProgramParameters::for_device,
+           py::arg("device"), py::rv_policy::reference_internal)
+      .def("__getitem__", &local::ShardedProgramParameters::shard,
+           py::rv_policy::reference_internal)
+      .def("__len__", &local::ShardedProgramParameters::size);
 
   struct DevicesSet {
     DevicesSet(py::object fiber_obj, std::optional<size_t> index = {})
@@ -894,8 +1713,206 @@ void BindLocal(py::module_ &m) {
     py::object fiber_obj;
     std::optional<size_t> index;
   };
+  py::class_<local::detail::TimelineResourcePoolStats>(
+      m, "TimelineResourcePoolStats")
+      .def_ro("allocations",
+              &local::detail::TimelineResourcePoolStats::allocations)
+      .def_ro("reuses", &local::detail::TimelineResourcePoolStats::reuses)
+      .def_ro("recycles", &local::detail::TimelineResourcePoolStats::recycles)
+      .def_ro("discards", &local::detail::TimelineResourcePoolStats::discards)
+      .def_ro("pooled", &local::detail::TimelineResourcePoolStats::pooled)
+      .def("__repr__", &local::detail::TimelineResourcePoolStats::to_s);
+  py::enum_<local::detail::FlushReason>(m, "FlushReason")
+      .value("EAGER", local::detail::FlushReason::EAGER)
+      .value("BATCH_WINDOW", local::detail::FlushReason::BATCH_WINDOW)
+      .value("TX_TYPE_CHANGE", local::detail::FlushReason::TX_TYPE_CHANGE)
+      .value("TIMEPOINT_ACQUIRE",
+             local::detail::FlushReason::TIMEPOINT_ACQUIRE)
+      .value("SYNC", local::detail::FlushReason::SYNC)
+      .value("MODE_CHANGE", local::detail::FlushReason::MODE_CHANGE)
+      .value("EXPLICIT", local::detail::FlushReason::EXPLICIT)
+      .value("PRIORITY", local::detail::FlushReason::PRIORITY);
+  py::class_<local::detail::SchedulerStats>(m, "SchedulerStats")
+      .def_ro("submissions", &local::detail::SchedulerStats::submissions)
+      .def_ro("transactions", &local::detail::SchedulerStats::transactions)
+      .def_ro("pending_ns_total",
+              &local::detail::SchedulerStats::pending_ns_total)
+      .def_ro("pending_ns_max", &local::detail::SchedulerStats::pending_ns_max)
+      .def_ro("replays", &local::detail::SchedulerStats::replays)
+      .def_ro("deallocas", &local::detail::SchedulerStats::deallocas)
+      .def_ro("dealloca_batches",
+              &local::detail::SchedulerStats::dealloca_batches)
+      .def_ro("cache_hits", &local::detail::SchedulerStats::cache_hits)
+      .def_ro("cache_misses", &local::detail::SchedulerStats::cache_misses)
+      .def_ro("cache_returns", &local::detail::SchedulerStats::cache_returns)
+      .def_ro("cache_evictions",
+              &local::detail::SchedulerStats::cache_evictions)
+      .def_ro("staging_hits", &local::detail::SchedulerStats::staging_hits)
+      .def_ro("staging_misses", &local::detail::SchedulerStats::staging_misses)
+      .def_prop_ro("flushes",
+                   [](local::detail::SchedulerStats &self) {
+                     py::dict d;
+                     for (size_t i = 0; i < self.flushes.size(); ++i) {
+                       d[py::cast(static_cast<local::detail::FlushReason>(
+                           i))] = self.flushes[i];
+                     }
+                     return d;
+                   })
+      .def_prop_ro(
+          "deps_histogram",
+          [](local::detail::SchedulerStats &self) {
+            return std::vector<uint64_t>(self.deps_histogram.begin(),
+                                         self.deps_histogram.end());
+          })
+      .def_prop_ro_static(
+          "deps_bucket_bounds",
+          [](py::handle) {
+            auto &bounds = local::detail::SchedulerStats::kDepsBucketBounds;
+            return std::vector<uint32_t>(bounds.begin(), bounds.end());
+          })
+      .def("__repr__", &local::detail::SchedulerStats::to_s);
+  py::class_<local::detail::ExportedBarrier>(m, "ExportedBarrier")
+      .def("__len__", &local::detail::ExportedBarrier::size)
+      .def("__repr__", &local::detail::ExportedBarrier::to_s);
+  py::class_<local::detail::CommandCapture>(m, "CommandCapture")
+      .def_prop_ro("slot_count", &local::detail::CommandCapture::slot_count)
+      .def_prop_ro("transaction_count",
+                   &local::detail::CommandCapture::transaction_count)
+      .def_prop_ro("finalized", &local::detail::CommandCapture::finalized)
+      .def("slot_writable", &local::detail::CommandCapture::slot_writable,
+           py::arg("slot"))
+      .def("__repr__", &local::detail::CommandCapture::to_s);
   py::class_<local::Fiber>(m, "Fiber")
       .def("__repr__", &local::Fiber::to_s)
+      .def(
+          "begin_capture",
+          [](local::Fiber &self, local::ScopedDevice &device,
+             iree_host_size_t binding_capacity) {
+            self.scheduler().BeginCapture(device, binding_capacity);
+          },
+          py::arg("device"), py::arg("binding_capacity") = 64,
+          DOCSTRING_FIBER_BEGIN_CAPTURE)
+      .def(
+          "end_capture",
+          [](local::Fiber &self) { return self.scheduler().EndCapture(); },
+          py::keep_alive<0, 1>())
+      .def_prop_ro("capturing",
+                   [](local::Fiber &self) {
+                     return self.scheduler().capturing();
+                   })
+      .def(
+          "replay",
+          [](local::Fiber &self, local::detail::CommandCapture &capture,
+             std::vector<array::storage *> storages) {
+            std::vector<local::detail::CaptureBinding> bindings;
+            bindings.reserve(storages.size());
+            for (array::storage *s : storages) {
+              bindings.push_back(s->capture_binding());
+            }
+            self.scheduler().Replay(capture, bindings);
+          },
+          py::arg("capture"), py::arg("storages"), DOCSTRING_FIBER_REPLAY)
+      .def_prop_ro("scheduler_stats",
+                   [](local::Fiber &self) { return self.scheduler().stats(); })
+      .def_prop_ro("account_stats",
+                   [](local::Fiber &self) {
+                     py::dict d;
+                     for (auto &it : self.scheduler().account_stats()) {
+                       d[py::cast(it.first)] = py::cast(it.second);
+                     }
+                     return d;
+                   })
+      .def("reset_scheduler_stats",
+           [](local::Fiber &self) { self.scheduler().ResetStats(); })
+      .def_prop_ro("isolate_stats",
+                   [](local::Fiber &self) {
+                     auto stats = self.isolate_stats();
+                     py::dict d;
+                     d["fork_count"] = stats.fork_count;
+                     d["total_fork_time"] = stats.total_fork_ns / 1e9;
+                     d["max_fork_time"] = stats.max_fork_ns / 1e9;
+                     return d;
+                   })
+      .def_prop_ro("timeline_resource_pool_stats",
+                   [](local::Fiber &self) {
+                     return self.scheduler().timeline_resource_pool_stats();
+                   })
+      .def_prop_rw(
+          "timeline_resource_pool_capacity",
+          [](local::Fiber &self) {
+            return self.scheduler().timeline_resource_pool_capacity();
+          },
+          [](local::Fiber &self, size_t capacity) {
+            self.scheduler().set_timeline_resource_pool_capacity(capacity);
+          })
+      .def_prop_rw(
+          "transaction_mode",
+          [](local::Fiber &self) { return self.scheduler().transaction_mode(); },
+          [](local::Fiber &self, local::detail::TransactionMode mode) {
+            self.scheduler().set_transaction_mode(mode);
+          })
+      .def(
+          "set_batch_window",
+          [](local::Fiber &self, uint32_t max_ops, uint64_t max_latency_us) {
+            self.scheduler().set_batch_window(
+                {.max_ops = max_ops, .max_latency_us = max_latency_us});
+          },
+          py::arg("max_ops") = 64, py::arg("max_latency_us") = 100)
+      .def(
+          "set_dealloca_batch",
+          [](local::Fiber &self, uint32_t max_buffers, uint64_t max_latency_us) {
+            self.scheduler().set_dealloca_batch(
+                {.max_buffers = max_buffers, .max_latency_us = max_latency_us});
+          },
+          py::arg("max_buffers") = 64, py::arg("max_latency_us") = 1000)
+      .def(
+          "set_buffer_cache",
+          [](local::Fiber &self, iree_device_size_t max_bytes,
+             iree_device_size_t min_block_size) {
+            self.scheduler().set_buffer_cache(
+                {.max_bytes = max_bytes, .min_block_size = min_block_size});
+          },
+          py::arg("max_bytes"), py::arg("min_block_size") = 256,
+          DOCSTRING_FIBER_SET_BUFFER_CACHE)
+      .def("trim_buffer_cache",
+           [](local::Fiber &self) { self.scheduler().TrimBufferCaches(); })
+      .def_prop_ro("buffer_cache_bytes",
+                   [](local::Fiber &self) {
+                     return self.scheduler().buffer_cache_bytes();
+                   })
+      .def(
+          "set_staging_ring",
+          [](local::Fiber &self, uint32_t max_buffers,
+             iree_device_size_t max_bytes, iree_device_size_t min_block_size) {
+            self.scheduler().set_staging_ring(
+                {.max_buffers = max_buffers,
+                 .max_bytes = max_bytes,
+                 .min_block_size = min_block_size});
+          },
+          py::arg("max_buffers") = 16, py::arg("max_bytes") = 64 * 1024 * 1024,
+          py::arg("min_block_size") = 4096)
+      .def_prop_ro("staging_ring_bytes",
+                   [](local::Fiber &self) {
+                     return self.scheduler().staging_ring_bytes();
+                   })
+      .def("flush",
+           [](local::Fiber &self) {
+             self.scheduler().Flush(local::detail::FlushReason::EXPLICIT);
+           })
+      .def_prop_rw(
+          "account_placement",
+          [](local::Fiber &self) {
+            return self.scheduler().account_placement();
+          },
+          [](local::Fiber &self, local::detail::AccountPlacement placement) {
+            self.scheduler().set_account_placement(placement);
+          })
+      .def_prop_rw(
+          "priority",
+          [](local::Fiber &self) { return self.scheduler().priority(); },
+          [](local::Fiber &self, local::detail::TransactionPriority priority) {
+            self.scheduler().set_priority(priority);
+          })
       .def_prop_ro(
           "raw_devices",
           [](local::Fiber &self) {
@@ -995,7 +2012,11 @@ void BindLocal(py::module_ &m) {
                      }
                      return ext->loop();
                    })
-      .def("call_threadsafe", &local::Worker::CallThreadsafe)
+      .def("call_threadsafe",
+           [](local::Worker &self, std::function<void()> callback) {
+             self.CallThreadsafe(std::move(callback));
+           })
+      .def_prop_ro("thunk_count", &local::Worker::thunk_count)
       .def("call",
            [](local::Worker &self, py::handle callable) {
              callable.inc_ref();  // Stolen within the callback.
@@ -1047,6 +2068,46 @@ void BindLocal(py::module_ &m) {
       .def("_now", [](local::Worker &self) { return self.now(); })
       .def("__repr__", &local::Worker::to_s);
 
+  py::class_<local::WorkerGroup>(m, "WorkerGroup")
+      .def_prop_ro("name", &local::WorkerGroup::name)
+      .def_prop_ro("workers",
+                   [](local::WorkerGroup &self) {
+                     py::list workers;
+                     for (local::Worker *worker : self.workers()) {
+                       workers.append(
+                           py::cast(worker, py::rv_policy::reference));
+                     }
+                     return workers;
+                   })
+      .def_prop_ro("steal_count", &local::WorkerGroup::steal_count)
+      .def(
+          "submit",
+          [](local::WorkerGroup &self, py::handle callable) {
+            // Resolved on the calling worker once the callable has run on
+            // whichever worker of the group picked it up.
+            local::VoidFuture future;
+            callable.inc_ref();  // Stolen within the thunk.
+            try {
+              self.Submit([callable_ptr = callable.ptr(), future]() mutable {
+                SHORTFIN_TRACE_SCOPE_NAMED("PyWorkerGroup::Thunk");
+                py::gil_scoped_acquire g;
+                py::object user_callable = py::steal(callable_ptr);
+                try {
+                  user_callable();
+                  future.set_success();
+                } catch (std::exception &e) {
+                  future.set_failure(iree::exception_to_status(e));
+                }
+              });
+            } catch (...) {
+              callable.dec_ref();
+              throw;
+            }
+            return future;
+          },
+          py::arg("callable"))
+      .def("__repr__", &local::WorkerGroup::to_s);
+
   py::class_<PyProcess>(m, "Process")
       .def(
           "__init__",
@@ -1190,8 +2251,13 @@ void BindLocal(py::module_ &m) {
                  /*keep_alive=*/self, /*queue=*/self);
            })
       .def_prop_ro("closed", &local::Queue::is_closed)
-      .def("write_nodelay", [](local::Queue &self, local::Message &message) {
-        self.WriteNoDelay(local::Message::Ref(message));
+      .def("write_nodelay",
+           [](local::Queue &self, local::Message &message) {
+             self.WriteNoDelay(local::Message::Ref(message));
+           })
+      .def("try_write", [](local::Queue &self, local::Message &message) {
+        local::Message::Ref ref(message);
+        return self.TryWrite(ref);
       });
   py::class_<local::QueueWriter>(m, "QueueWriter")
       .def("__call__",
@@ -1200,7 +2266,86 @@ void BindLocal(py::module_ &m) {
            })
       .def("close", &local::QueueWriter::Close);
   py::class_<local::QueueReader>(m, "QueueReader")
-      .def("__call__", [](local::QueueReader &self) { return self.Read(); });
+      .def("__call__", [](local::QueueReader &self) { return self.Read(); })
+      .def(
+          "read_batch",
+          [](local::QueueReader &self, size_t max_count,
+             std::optional<double> timeout) {
+            iree_timeout_t iree_timeout =
+                timeout ? iree_make_timeout_ns(
+                              static_cast<iree_duration_t>(*timeout * 1e9))
+                        : iree_infinite_timeout();
+            return self.ReadBatch(max_count, iree_timeout);
+          },
+          py::arg("max_count"), py::arg("timeout") = py::none());
+
+  py::class_<local::SharedQueue>(m, "SharedQueue")
+      .def_static(
+          "create",
+          [](size_t capacity, size_t max_tokens) {
+            local::SharedQueue::Options options;
+            options.capacity = capacity;
+            options.max_tokens = max_tokens;
+            return local::SharedQueue::Create(options);
+          },
+          py::kw_only(), py::arg("capacity") = 1024,
+          py::arg("max_tokens") = 8192, DOCSTRING_SHARED_QUEUE_CREATE)
+      .def_static("open", &local::SharedQueue::Open, py::arg("memory_fd"),
+                  py::arg("event_fd"))
+      .def("__repr__", &local::SharedQueue::to_s)
+      .def_prop_ro("memory_fd", &local::SharedQueue::memory_fd)
+      .def_prop_ro("event_fd", &local::SharedQueue::event_fd)
+      .def_prop_ro("capacity", &local::SharedQueue::capacity)
+      .def_prop_ro("max_tokens", &local::SharedQueue::max_tokens)
+      .def_prop_ro("closed", &local::SharedQueue::is_closed)
+      .def("close", &local::SharedQueue::Close)
+      .def("writer",
+           [](local::SharedQueue &self) {
+             return custom_new_keep_alive<local::SharedQueueWriter>(
+                 py::type<local::SharedQueueWriter>(),
+                 /*keep_alive=*/self, /*queue=*/self);
+           })
+      .def("reader", [](local::SharedQueue &self) {
+        return custom_new_keep_alive<local::SharedQueueReader>(
+            py::type<local::SharedQueueReader>(),
+            /*keep_alive=*/self, /*queue=*/self);
+      });
+  py::class_<local::SharedQueueWriter>(m, "SharedQueueWriter")
+      .def(
+          "try_write",
+          [](local::SharedQueueWriter &self, uint64_t tag,
+             py::ndarray<const int32_t, py::ndim<1>, py::c_contig,
+                         py::device::cpu>
+                 tokens) {
+            return self.TryWrite(
+                tag, std::span<const int32_t>(tokens.data(), tokens.size()));
+          },
+          py::arg("tag"), py::arg("tokens"), DOCSTRING_SHARED_QUEUE_TRY_WRITE)
+      .def(
+          "try_write",
+          [](local::SharedQueueWriter &self, uint64_t tag,
+             std::vector<int32_t> tokens) {
+            return self.TryWrite(tag, tokens);
+          },
+          py::arg("tag"), py::arg("tokens"))
+      .def("close", &local::SharedQueueWriter::Close);
+  py::class_<local::SharedQueueReader>(m, "SharedQueueReader")
+      .def("__call__",
+           [](local::SharedQueueReader &self) { return self.Read(); });
+  py::class_<local::SharedQueueMessage, local::Message>(m,
+                                                        "SharedQueueMessage")
+      .def_prop_ro("tag", &local::SharedQueueMessage::tag)
+      .def_prop_ro(
+          "tokens",
+          [](py::handle self_obj) {
+            auto &self = py::cast<local::SharedQueueMessage &>(self_obj);
+            std::span<const int32_t> tokens = self.tokens();
+            // Views the slot in place, keeping the message (and so the slot)
+            // alive.
+            return py::ndarray<py::numpy, const int32_t, py::ndim<1>>(
+                tokens.data(), {tokens.size()}, self_obj);
+          },
+          DOCSTRING_SHARED_QUEUE_MESSAGE_TOKENS);
 
   // ------------------------------------------------------------------------ //
   // Futures
@@ -1277,7 +2422,15 @@ void BindLocal(py::module_ &m) {
         // to a py::object, it will get a new reference.
         local::Message::Ref &result = self.result();
         if (!result) return py::none();
-        return py::cast(result.get());
+        return CastMessage(result);
+      });
+  py::class_<local::MessageBatchFuture, local::Future>(m, "MessageBatchFuture")
+      .def("result", [](local::MessageBatchFuture &self) {
+        py::list messages;
+        for (local::Message::Ref &result : self.result()) {
+          messages.append(CastMessage(result));
+        }
+        return messages;
       });
 }
 
@@ -1313,7 +2466,26 @@ void BindHostSystem(py::module_ &global_m) {
              std::vector<std::string> specs) {
             self.hostcpu_allocator_specs() = std::move(specs);
           },
-          DOCSTRING_HOSTCPU_SYSTEM_BUILDER_HOSTCPU_ALLOCATOR_SPECS);
+          DOCSTRING_HOSTCPU_SYSTEM_BUILDER_HOSTCPU_ALLOCATOR_SPECS)
+      .def_prop_rw(
+          "numa_host_allocations",
+          [](local::systems::HostCPUSystemBuilder &self) -> bool {
+            return self.numa_host_allocations();
+          },
+          [](local::systems::HostCPUSystemBuilder &self, bool value) {
+            self.numa_host_allocations() = value;
+          },
+          DOCSTRING_HOSTCPU_SYSTEM_BUILDER_NUMA_HOST_ALLOCATIONS)
+      .def_prop_rw(
+          "host_huge_pages",
+          [](local::systems::HostCPUSystemBuilder &self) {
+            return sysconfig::to_string_view(self.host_huge_pages());
+          },
+          [](local::systems::HostCPUSystemBuilder &self,
+             std::string_view value) {
+            self.host_huge_pages() = ParseHugePages(value);
+          },
+          DOCSTRING_HOSTCPU_SYSTEM_BUILDER_HOST_HUGE_PAGES);
   py::class_<local::systems::HostCPUDevice, local::Device>(m, "HostCPUDevice");
 }
 
@@ -1449,6 +2621,100 @@ construction). Multiples can be separated by a semicolon.
 
 }  // namespace
 
+static const char DOCSTRING_AMDGPU_SYSTEM_BUILDER_PEER_ACCESS[] =
+    R"(Whether to enable peer access between devices connected by XGMI.
+
+When enabled (the default), devices linked by XGMI can directly access each
+other's memory once the system is created. Failure to enable it is logged and
+otherwise ignored.
+
+This can be set via a keyword of "amdgpu_peer_access" or the environment
+variable "SHORTFIN_AMDGPU_PEER_ACCESS" (if `env_prefix` was not changed at
+construction).
+)";
+
+static const char DOCSTRING_AMDGPU_SYSTEM_BUILDER_PARALLEL_DEVICE_CREATION[] =
+    R"(Whether to create the devices of each physical GPU concurrently.
+
+Device creation dominates startup time on multi GPU machines, so by default
+(true) physical devices are initialized in parallel.
+
+This can be set via a keyword of "amdgpu_parallel_device_creation" or the
+environment variable "SHORTFIN_AMDGPU_PARALLEL_DEVICE_CREATION" (if
+`env_prefix` was not changed at construction).
+)";
+
+static const char DOCSTRING_AMDGPU_SYSTEM_BUILDER_UNIFIED_MEMORY[] =
+    R"(Whether device allocations are in memory shared with the host.
+
+For APUs (i.e. MI300A) whose host and device share memory. When enabled,
+device arrays are host visible device local memory that the host maps in
+place: `device_array.for_transfer()` returns the array itself and copies
+between the two are no-ops, so that no staging copies are made. Defaults to
+false.
+
+This can be set via a keyword of "amdgpu_unified_memory" or the environment
+variable "SHORTFIN_AMDGPU_UNIFIED_MEMORY" (if `env_prefix` was not changed at
+construction).
+)";
+
+static const char DOCSTRING_AMDGPU_SYSTEM_BUILDER_QUEUE_PRIORITIES[] =
+    R"(Priority of each logical device of a physical device.
+
+A list of `QueuePriority` by logical index, with one entry per logical device
+(see `logical_devices_per_physical_device`), or empty (the default) for all
+`NORMAL`. Each logical device submits on its own stream, so latency sensitive
+fibers (i.e. decode) can be bound to the devices whose `queue_priority` is
+`HIGH` while throughput work goes to the others. Combine with
+`hw_queue_count` so that the streams do not share hardware queues.
+
+This can be set via a keyword of "amdgpu_queue_priorities" or the environment
+variable "SHORTFIN_AMDGPU_QUEUE_PRIORITIES" (if `env_prefix` was not changed at
+construction) as a comma separated list of "low", "normal" and "high".
+)";
+
+static const char DOCSTRING_AMDGPU_SYSTEM_BUILDER_HW_QUEUE_COUNT[] =
+    R"(Number of hardware queues the HIP runtime uses per device.
+
+0 (the default) leaves the runtime default. Otherwise sets GPU_MAX_HW_QUEUES
+for the HIP runtime, which only takes effect if it is set before devices are
+first enumerated in the process and if the environment does not already set
+it (which is reported with a warning).
+
+This can be set via a keyword of "amdgpu_hw_queues" or the environment
+variable "SHORTFIN_AMDGPU_HW_QUEUES" (if `env_prefix` was not changed at
+construction).
+)";
+
+static const char DOCSTRING_AMDGPU_SYSTEM_BUILDER_STARTUP_TIMINGS[] =
+    R"(Wall time in seconds of each phase of the last `create_system()`.
+
+A dict (in phase order) with keys "enumerate", "topology", "create_devices",
+"peer_access" (if enabled), "hostcpu" (if CPU devices are enabled) and
+"finish".
+)";
+
+static const char DOCSTRING_AMDGPU_DEVICE_CLOSEST_PEERS[] =
+    R"(Other AMDGPU devices among `devices`, closest first.
+
+Devices are ordered by the weight of their link to this device, as reported
+by the driver topology. Devices without a discovered link are last.
+)";
+
+static const char DOCSTRING_AMDGPU_SELECT_CLOSEST_DEVICES[] =
+    R"(Selects the `count` most tightly connected AMDGPU devices.
+
+Args:
+  devices: Candidate devices (typically `System.devices`). Non AMDGPU devices
+    are ignored.
+  count: Number of devices to select.
+
+Returns:
+  The selected devices, in the order of `devices`, such that the total link
+  weight between them is minimized. Suitable for creating a multi device
+  fiber. Raises ValueError if there are fewer than `count` AMDGPU devices.
+)";
+
 void BindAMDGPUSystem(py::module_ &global_m) {
   auto m = global_m.def_submodule("amdgpu", "AMDGPU system config");
   py::class_<local::systems::AMDGPUSystemBuilder,
@@ -1531,6 +2797,66 @@ void BindAMDGPUSystem(py::module_ &global_m) {
             self.logical_devices_per_physical_device() = value;
           },
           DOCSTRING_AMDGPU_SYSTEM_BUILDER_LOGICAL_DEVICES_PER_PHYSICAL_DEVICE)
+      .def_prop_rw(
+          "peer_access",
+          [](local::systems::AMDGPUSystemBuilder &self) -> bool {
+            return self.peer_access();
+          },
+          [](local::systems::AMDGPUSystemBuilder &self, bool value) {
+            self.peer_access() = value;
+          },
+          DOCSTRING_AMDGPU_SYSTEM_BUILDER_PEER_ACCESS)
+      .def_prop_rw(
+          "parallel_device_creation",
+          [](local::systems::AMDGPUSystemBuilder &self) -> bool {
+            return self.parallel_device_creation();
+          },
+          [](local::systems::AMDGPUSystemBuilder &self, bool value) {
+            self.parallel_device_creation() = value;
+          },
+          DOCSTRING_AMDGPU_SYSTEM_BUILDER_PARALLEL_DEVICE_CREATION)
+      .def_prop_rw(
+          "unified_memory",
+          [](local::systems::AMDGPUSystemBuilder &self) -> bool {
+            return self.unified_memory();
+          },
+          [](local::systems::AMDGPUSystemBuilder &self, bool value) {
+            self.unified_memory() = value;
+          },
+          DOCSTRING_AMDGPU_SYSTEM_BUILDER_UNIFIED_MEMORY)
+      .def_prop_rw(
+          "queue_priorities",
+          [](local::systems::AMDGPUSystemBuilder &self)
+              -> std::vector<local::systems::AMDGPUQueuePriority> {
+            return self.queue_priorities();
+          },
+          [](local::systems::AMDGPUSystemBuilder &self,
+             std::vector<local::systems::AMDGPUQueuePriority> value) {
+            self.queue_priorities() = std::move(value);
+          },
+          DOCSTRING_AMDGPU_SYSTEM_BUILDER_QUEUE_PRIORITIES)
+      .def_prop_rw(
+          "hw_queue_count",
+          [](local::systems::AMDGPUSystemBuilder &self) -> int {
+            return self.hw_queue_count();
+          },
+          [](local::systems::AMDGPUSystemBuilder &self, int value) {
+            if (value < 0) {
+              throw std::invalid_argument("hw_queue_count must be >= 0");
+            }
+            self.hw_queue_count() = value;
+          },
+          DOCSTRING_AMDGPU_SYSTEM_BUILDER_HW_QUEUE_COUNT)
+      .def_prop_ro(
+          "startup_timings",
+          [](local::systems::AMDGPUSystemBuilder &self) {
+            py::dict timings;
+            for (auto &[name, duration_ns] : self.startup_timings()) {
+              timings[py::cast(name)] = duration_ns / 1e9;
+            }
+            return timings;
+          },
+          DOCSTRING_AMDGPU_SYSTEM_BUILDER_STARTUP_TIMINGS)
       .def_prop_rw(
           "visible_devices",
           [](local::systems::AMDGPUSystemBuilder &self)
@@ -1543,10 +2869,100 @@ void BindAMDGPUSystem(py::module_ &global_m) {
           },
           DOCSTRING_AMDGPU_SYSTEM_BUILDER_VISIBLE_DEVICES);
 
-  py::class_<local::systems::AMDGPUDevice, local::Device>(m, "AMDGPUDevice");
+  py::enum_<local::systems::AMDGPULinkType>(m, "LinkType")
+      .value("NONE", local::systems::AMDGPULinkType::NONE)
+      .value("SELF", local::systems::AMDGPULinkType::SELF)
+      .value("PCIE", local::systems::AMDGPULinkType::PCIE)
+      .value("XGMI", local::systems::AMDGPULinkType::XGMI)
+      .export_values();
+
+  py::enum_<local::systems::AMDGPUQueuePriority>(m, "QueuePriority")
+      .value("LOW", local::systems::AMDGPUQueuePriority::LOW)
+      .value("NORMAL", local::systems::AMDGPUQueuePriority::NORMAL)
+      .value("HIGH", local::systems::AMDGPUQueuePriority::HIGH);
+
+  py::class_<local::systems::AMDGPUDevice, local::Device>(m, "AMDGPUDevice")
+      .def("link_type", &local::systems::AMDGPUDevice::link_type,
+           py::arg("other"))
+      .def("link_weight", &local::systems::AMDGPUDevice::link_weight,
+           py::arg("other"))
+      .def_prop_ro("queue_priority",
+                   &local::systems::AMDGPUDevice::queue_priority)
+      .def(
+          "closest_peers",
+          [](local::systems::AMDGPUDevice &self,
+             std::vector<local::Device *> devices) {
+            return self.ClosestPeers(devices);
+          },
+          py::arg("devices"), py::rv_policy::reference,
+          DOCSTRING_AMDGPU_DEVICE_CLOSEST_PEERS);
+
+  m.def(
+      "select_closest_devices",
+      [](std::vector<local::Device *> devices, size_t count) {
+        return local::systems::SelectClosestAMDGPUDevices(devices, count);
+      },
+      py::arg("devices"), py::arg("count"), py::rv_policy::reference,
+      DOCSTRING_AMDGPU_SELECT_CLOSEST_DEVICES);
 }
 #endif  // SHORTFIN_HAVE_AMDGPU
 
+void BindDiffusion(py::module_ &m) {
+  py::class_<diffusion::DenoiseArg>(m, "DenoiseArg")
+      .def_static("input", &diffusion::DenoiseArg::Input, py::arg("index"))
+      .def_static("step_input", &diffusion::DenoiseArg::StepInput,
+                  py::arg("index"))
+      .def_static("init_result", &diffusion::DenoiseArg::InitResult,
+                  py::arg("index"))
+      .def_static("stage_result", &diffusion::DenoiseArg::StageResult,
+                  py::arg("stage"), py::arg("index"))
+      .def_static("latents", &diffusion::DenoiseArg::Latents);
+
+  py::class_<diffusion::DenoiseStage>(m, "DenoiseStage")
+      .def(
+          "__init__",
+          [](diffusion::DenoiseStage *self, local::ProgramFunction function,
+             std::vector<diffusion::DenoiseArg> args) {
+            new (self) diffusion::DenoiseStage{
+                .function = std::move(function),
+                .args = std::move(args),
+            };
+          },
+          py::arg("function"), py::arg("args"));
+
+  py::class_<diffusion::DenoiseLoop>(m, "DenoiseLoop")
+      .def(
+          "__init__",
+          [](diffusion::DenoiseLoop *self,
+             std::vector<diffusion::DenoiseStage> stages,
+             diffusion::DenoiseArg latents,
+             std::optional<local::ProgramFunction> initialize,
+             std::vector<diffusion::DenoiseArg> initialize_args) {
+            new (self) diffusion::DenoiseLoop(diffusion::DenoiseLoop::Options{
+                .initialize = std::move(initialize),
+                .initialize_args = std::move(initialize_args),
+                .stages = std::move(stages),
+                .latents = latents,
+            });
+          },
+          py::arg("stages"), py::kw_only(),
+          py::arg("latents") = diffusion::DenoiseArg::Input(0),
+          py::arg("initialize") = py::none(),
+          py::arg("initialize_args") = std::vector<diffusion::DenoiseArg>(),
+          DOCSTRING_DIFFUSION_DENOISE_LOOP)
+      .def(
+          "run",
+          [](diffusion::DenoiseLoop &self,
+             std::vector<array::device_array> inputs, size_t num_steps,
+             local::Fiber &fiber,
+             std::optional<local::ProgramIsolation> isolation) {
+            return self.Run(fiber.shared_from_this(), std::move(inputs),
+                            num_steps, isolation);
+          },
+          py::arg("inputs"), py::arg("num_steps"), py::kw_only(),
+          py::arg("fiber"), py::arg("isolation") = py::none());
+}
+
 void BindLLM(py::module_ &m) {
   // Bind LogitsNormalization enum
   py::enum_<llm::LogitsNormalization>(m, "LogitsNormalization")
@@ -1586,6 +3002,445 @@ void BindLLM(py::module_ &m) {
                               std::move(selected_scores));
       },
       py::arg("scores"), py::arg("config"));
+  m.def(
+      "sample_tokens",
+      [](py::ndarray<py::numpy, const float, py::c_contig> logits,
+         const llm::DecodeConfig &config,
+         std::optional<uint64_t> seed) -> py::tuple {
+        if (logits.ndim() == 0) {
+          throw std::invalid_argument("logits must have at least one dim");
+        }
+        size_t vocab_size = logits.shape(logits.ndim() - 1);
+        size_t rows = vocab_size ? logits.size() / vocab_size : 0;
+        if (!seed) seed = std::random_device()();
+        std::vector<int> selected_tokens;
+        std::vector<float> selected_scores;
+        {
+          py::gil_scoped_release release;
+          llm::SampleTokens(logits.data(), rows, vocab_size, config, *seed,
+                            selected_tokens, selected_scores);
+        }
+        return py::make_tuple(std::move(selected_tokens),
+                              std::move(selected_scores));
+      },
+      py::arg("logits"), py::arg("config"), py::arg("seed") = py::none(),
+      DOCSTRING_LLM_SAMPLE_TOKENS);
+  m.def(
+      "select_tokens_batch",
+      [](LogitsArray logits, py::handle configs,
+         py::ndarray<int32_t, py::ndim<2>, py::c_contig, py::device::cpu>
+             selected_tokens,
+         py::ndarray<float, py::ndim<2>, py::c_contig, py::device::cpu>
+             selected_scores,
+         std::optional<py::ndarray<uint64_t, py::ndim<1>, py::c_contig,
+                                   py::device::cpu>>
+             rng_states) {
+        llm::LogitsView view = MakeLogitsView(logits);
+        if (selected_tokens.shape(0) != view.rows ||
+            selected_scores.shape(0) != view.rows ||
+            selected_tokens.shape(1) != selected_scores.shape(1)) {
+          throw std::invalid_argument(fmt::format(
+              "Selection outputs must both have shape [{}, width]",
+              view.rows));
+        }
+        std::vector<llm::DecodeConfig> config_list;
+        if (py::isinstance<llm::DecodeConfig>(configs)) {
+          config_list.push_back(py::cast<llm::DecodeConfig>(configs));
+        } else {
+          config_list = py::cast<std::vector<llm::DecodeConfig>>(configs);
+        }
+        std::span<uint64_t> states;
+        if (rng_states) states = {rng_states->data(), rng_states->size()};
+        py::gil_scoped_release release;
+        llm::SelectTokensBatch(
+            view, config_list,
+            {selected_tokens.data(), selected_tokens.size()},
+            {selected_scores.data(), selected_scores.size()}, states);
+      },
+      py::arg("logits"), py::arg("configs"), py::arg("selected_tokens"),
+      py::arg("selected_scores"), py::arg("rng_states") = py::none(),
+      DOCSTRING_LLM_SELECT_TOKENS_BATCH);
+  m.def("uses_sampling", &llm::UsesSampling, py::arg("config"),
+        DOCSTRING_LLM_USES_SAMPLING);
+  m.def(
+      "verify_draft_tokens",
+      [](LogitsArray target_logits,
+         py::ndarray<py::ro, int32_t, py::ndim<2>, py::c_contig,
+                     py::device::cpu>
+             draft_tokens,
+         py::handle configs, std::optional<LogitsArray> draft_logits,
+         std::optional<py::ndarray<uint64_t, py::ndim<1>, py::c_contig,
+                                   py::device::cpu>>
+             rng_states) {
+        llm::LogitsView target_view = MakeLogitsView(target_logits);
+        llm::LogitsView draft_view;
+        if (draft_logits) draft_view = MakeLogitsView(*draft_logits);
+        std::vector<llm::DecodeConfig> config_list;
+        if (py::isinstance<llm::DecodeConfig>(configs)) {
+          config_list.push_back(py::cast<llm::DecodeConfig>(configs));
+        } else {
+          config_list = py::cast<std::vector<llm::DecodeConfig>>(configs);
+        }
+        std::span<uint64_t> states;
+        if (rng_states) states = {rng_states->data(), rng_states->size()};
+        size_t batch = draft_tokens.shape(0);
+        std::vector<int> accepted_counts(batch);
+        std::vector<int> next_tokens(batch);
+        {
+          py::gil_scoped_release release;
+          llm::VerifyDraftTokens(
+              target_view, draft_view,
+              {draft_tokens.data(), draft_tokens.size()}, config_list,
+              accepted_counts, next_tokens, states);
+        }
+        return py::make_tuple(std::move(accepted_counts),
+                              std::move(next_tokens));
+      },
+      py::arg("target_logits"), py::arg("draft_tokens"), py::arg("configs"),
+      py::arg("draft_logits") = py::none(), py::arg("rng_states") = py::none(),
+      DOCSTRING_LLM_VERIFY_DRAFT_TOKENS);
+
+  py::class_<llm::PagePool>(m, "PagePool")
+      .def(py::init<size_t>(), py::arg("page_count"), DOCSTRING_LLM_PAGE_POOL)
+      .def_prop_ro("page_count", &llm::PagePool::page_count)
+      .def_prop_ro("available_count", &llm::PagePool::available_count)
+      .def_prop_ro("available_pages", &llm::PagePool::available_pages)
+      .def("ref_count", &llm::PagePool::ref_count, py::arg("page"))
+      .def(
+          "acquire",
+          [](llm::PagePool &self, size_t count) -> std::optional<py::list> {
+            std::vector<int> pages;
+            if (!self.Acquire(count, pages)) return {};
+            return py::cast(pages);
+          },
+          py::arg("count"))
+      .def(
+          "retain",
+          [](llm::PagePool &self, std::vector<int> pages) {
+            self.Retain(pages);
+          },
+          py::arg("pages"))
+      .def(
+          "release",
+          [](llm::PagePool &self, std::vector<int> pages) {
+            self.Release(pages);
+          },
+          py::arg("pages"));
+
+  py::class_<llm::PrefixTrie> prefix_trie(m, "PrefixTrie");
+  py::enum_<llm::PrefixTrie::EvictionPolicy>(prefix_trie, "EvictionPolicy")
+      .value("LRU", llm::PrefixTrie::EvictionPolicy::LRU)
+      .value("LFU", llm::PrefixTrie::EvictionPolicy::LFU)
+      .export_values();
+  py::class_<llm::PrefixTrie::Stats>(prefix_trie, "Stats")
+      .def_ro("lookups", &llm::PrefixTrie::Stats::lookups)
+      .def_ro("lookup_blocks", &llm::PrefixTrie::Stats::lookup_blocks)
+      .def_ro("hit_blocks", &llm::PrefixTrie::Stats::hit_blocks)
+      .def_ro("evictions", &llm::PrefixTrie::Stats::evictions)
+      .def_prop_ro("duration",
+                   [](const llm::PrefixTrie::Stats &self) {
+                     return self.duration_ns / 1e9;
+                   })
+      .def_prop_ro("hit_rate", &llm::PrefixTrie::Stats::hit_rate)
+      .def_prop_ro("evictions_per_second",
+                   &llm::PrefixTrie::Stats::evictions_per_second)
+      .def("__repr__", [](const llm::PrefixTrie::Stats &self) {
+        return fmt::format(
+            "PrefixTrie.Stats(lookups={}, hit_rate={:.3f}, evictions={}, "
+            "evictions_per_second={:.3f})",
+            self.lookups, self.hit_rate(), self.evictions,
+            self.evictions_per_second());
+      });
+  prefix_trie
+      .def(py::init<size_t, llm::PrefixTrie::EvictionPolicy>(),
+           py::arg("tokens_per_page"),
+           py::arg("eviction_policy") = llm::PrefixTrie::EvictionPolicy::LRU,
+           DOCSTRING_LLM_PREFIX_TRIE)
+      .def_prop_ro("eviction_policy", &llm::PrefixTrie::eviction_policy)
+      .def_prop_ro("evictable_count", &llm::PrefixTrie::evictable_count)
+      .def("stats", &llm::PrefixTrie::stats)
+      .def("reset_stats", &llm::PrefixTrie::ResetStats)
+      .def_prop_ro_static(
+          "ROOT", [](py::handle) { return llm::PrefixTrie::kRoot; })
+      .def_prop_ro("tokens_per_page", &llm::PrefixTrie::tokens_per_page)
+      .def_prop_ro("node_count", &llm::PrefixTrie::node_count)
+      .def_prop_ro("leaf_count", &llm::PrefixTrie::leaf_count)
+      .def("contains", &llm::PrefixTrie::contains, py::arg("node"))
+      .def("page", &llm::PrefixTrie::page, py::arg("node"))
+      .def("ref_count", &llm::PrefixTrie::ref_count, py::arg("node"))
+      .def("hash", &llm::PrefixTrie::hash, py::arg("node"))
+      .def_static(
+          "hash_block",
+          [](uint64_t parent_hash, std::vector<int> block) {
+            return llm::PrefixTrie::HashBlock(parent_hash, block);
+          },
+          py::arg("parent_hash"), py::arg("block"))
+      .def(
+          "match",
+          [](llm::PrefixTrie &self, std::vector<int> tokens,
+             bool record_stats) {
+            std::vector<int> pages;
+            llm::PrefixTrie::Node node;
+            {
+              py::gil_scoped_release release;
+              node = self.Match(tokens, pages, record_stats);
+            }
+            return py::make_tuple(node, std::move(pages));
+          },
+          py::arg("tokens"), py::arg("record_stats") = true)
+      .def(
+          "match_length",
+          [](llm::PrefixTrie &self, std::vector<int> tokens) {
+            py::gil_scoped_release release;
+            return self.MatchLength(tokens);
+          },
+          py::arg("tokens"))
+      .def(
+          "create_child",
+          [](llm::PrefixTrie &self, llm::PrefixTrie::Node parent,
+             std::vector<int> block, int page) {
+            return self.CreateChild(parent, block, page);
+          },
+          py::arg("parent"), py::arg("block"), py::arg("page"))
+      .def("retain", &llm::PrefixTrie::Retain, py::arg("node"))
+      .def("release", &llm::PrefixTrie::Release, py::arg("node"))
+      .def(
+          "evict",
+          [](llm::PrefixTrie &self, size_t max_pages) {
+            std::vector<int> pages;
+            self.Evict(max_pages, pages);
+            return pages;
+          },
+          py::arg("max_pages"))
+      .def(
+          "evict_nodes",
+          [](llm::PrefixTrie &self, size_t max_pages) {
+            std::vector<int> pages;
+            std::vector<llm::PrefixTrie::EvictedNode> nodes;
+            self.Evict(max_pages, pages, &nodes);
+            py::list results;
+            for (auto &node : nodes) {
+              results.append(py::make_tuple(node.page, node.hash,
+                                            node.parent_hash, node.block));
+            }
+            return results;
+          },
+          py::arg("max_pages"), DOCSTRING_LLM_PREFIX_TRIE_EVICT_NODES);
+
+  py::class_<llm::BeamSearch>(m, "BeamSearch")
+      .def(
+          "__init__",
+          [](llm::BeamSearch *self, const llm::DecodeConfig &config,
+             size_t position, size_t tokens_per_page) {
+            new (self) llm::BeamSearch(llm::BeamSearch::Options{
+                .config = config,
+                .position = position,
+                .tokens_per_page = tokens_per_page,
+            });
+          },
+          py::arg("config"), py::kw_only(), py::arg("position") = 0,
+          py::arg("tokens_per_page") = 0, DOCSTRING_LLM_BEAM_SEARCH)
+      .def(
+          "step",
+          [](llm::BeamSearch &self, LogitsArray logits,
+             std::optional<py::ndarray<int32_t, py::ndim<2>, py::c_contig,
+                                       py::device::cpu>>
+                 indices) {
+            llm::LogitsView view = MakeLogitsView(logits);
+            const int32_t *index_data = nullptr;
+            if (indices) {
+              if (indices->shape(0) != view.rows ||
+                  indices->shape(1) != view.vocab_size) {
+                throw std::invalid_argument(
+                    "indices must have the shape of the logits");
+              }
+              index_data = indices->data();
+            }
+            py::gil_scoped_release release;
+            self.Step(view, index_data);
+          },
+          py::arg("logits"), py::arg("indices") = py::none())
+      .def_prop_ro("done", &llm::BeamSearch::done)
+      .def_prop_ro("step_count", &llm::BeamSearch::step_count)
+      .def_prop_ro("live_beam_count", &llm::BeamSearch::live_beam_count)
+      .def_prop_ro("tokens",
+                   [](llm::BeamSearch &self) {
+                     auto s = self.tokens();
+                     return std::vector<int>(s.begin(), s.end());
+                   })
+      .def_prop_ro("scores",
+                   [](llm::BeamSearch &self) {
+                     auto s = self.scores();
+                     return std::vector<float>(s.begin(), s.end());
+                   })
+      .def_prop_ro("parents",
+                   [](llm::BeamSearch &self) {
+                     auto s = self.parents();
+                     return std::vector<int>(s.begin(), s.end());
+                   })
+      .def_prop_ro("copy_last_page",
+                   [](llm::BeamSearch &self) {
+                     auto s = self.copy_last_page();
+                     return std::vector<int>(s.begin(), s.end());
+                   })
+      .def_prop_ro("released",
+                   [](llm::BeamSearch &self) {
+                     auto s = self.released();
+                     return std::vector<int>(s.begin(), s.end());
+                   })
+      .def("results", [](llm::BeamSearch &self) {
+        py::list results;
+        for (auto &hypothesis : self.Results()) {
+          results.append(py::make_tuple(hypothesis.tokens, hypothesis.score));
+        }
+        return results;
+      });
+
+  py::class_<llm::BatchScheduler>(m, "BatchScheduler")
+      .def(
+          "__init__",
+          [](llm::BatchScheduler *self, size_t ideal_batch_size,
+             size_t token_budget, bool sequential_jobs) {
+            new (self) llm::BatchScheduler(llm::BatchScheduler::Options{
+                .ideal_batch_size = ideal_batch_size,
+                .token_budget = token_budget,
+                .sequential_jobs = sequential_jobs,
+            });
+          },
+          py::arg("ideal_batch_size"), py::kw_only(),
+          py::arg("token_budget") = 0, py::arg("sequential_jobs") = false,
+          DOCSTRING_LLM_BATCH_SCHEDULER)
+      .def_prop_ro("ideal_batch_size",
+                   [](llm::BatchScheduler &self) {
+                     return self.options().ideal_batch_size;
+                   })
+      .def_prop_ro("token_budget",
+                   [](llm::BatchScheduler &self) {
+                     return self.options().token_budget;
+                   })
+      .def_prop_ro("ready_count", &llm::BatchScheduler::ready_count)
+      .def_prop_ro("workgroup_count", &llm::BatchScheduler::workgroup_count)
+      .def("has_request", &llm::BatchScheduler::has_request, py::arg("rid"))
+      .def("submit", &llm::BatchScheduler::Submit, py::arg("job"),
+           py::arg("rid"), py::arg("token_count"))
+      .def("reserve", &llm::BatchScheduler::Reserve, py::arg("rid"),
+           py::arg("count"))
+      .def("schedule", &llm::BatchScheduler::Schedule, py::arg("strobe"))
+      .def("complete", &llm::BatchScheduler::Complete, py::arg("rid"))
+      .def("cancel", &llm::BatchScheduler::Cancel, py::arg("rid"));
+
+  py::class_<llm::LogitsProcessorChain>(m, "LogitsProcessorChain")
+      .def(py::init<>(), DOCSTRING_LLM_LOGITS_PROCESSOR_CHAIN)
+      .def("__len__", &llm::LogitsProcessorChain::size)
+      .def("add_repetition_penalty",
+           &llm::LogitsProcessorChain::AddRepetitionPenalty,
+           py::arg("penalty"), py::rv_policy::reference)
+      .def("add_presence_penalty",
+           &llm::LogitsProcessorChain::AddPresencePenalty,
+           py::arg("presence_penalty"), py::arg("frequency_penalty") = 0.f,
+           py::rv_policy::reference)
+      .def(
+          "add_logit_bias",
+          [](llm::LogitsProcessorChain &self,
+             const std::unordered_map<int32_t, float> &bias)
+              -> llm::LogitsProcessorChain & {
+            return self.AddLogitBias({bias.begin(), bias.end()});
+          },
+          py::arg("bias"), py::rv_policy::reference)
+      .def("add_token_mask", &llm::LogitsProcessorChain::AddTokenMask,
+           py::rv_policy::reference)
+      .def(
+          "accept_tokens",
+          [](llm::LogitsProcessorChain &self,
+             const std::vector<int32_t> &tokens) { self.AcceptTokens(tokens); },
+          py::arg("tokens"))
+      .def("reset_tokens", &llm::LogitsProcessorChain::ResetTokens)
+      .def(
+          "set_allowed_tokens",
+          [](llm::LogitsProcessorChain &self,
+             py::ndarray<uint32_t, py::ndim<1>, py::c_contig, py::device::cpu>
+                 mask) { self.SetAllowedTokens({mask.data(), mask.size()}); },
+          py::arg("mask"))
+      .def("clear_allowed_tokens",
+           &llm::LogitsProcessorChain::ClearAllowedTokens)
+      .def(
+          "apply",
+          [](llm::LogitsProcessorChain &self, MutableLogitsArray logits,
+             size_t row) {
+            llm::MutableLogitsView view = MakeMutableLogitsView(logits);
+            py::gil_scoped_release release;
+            self.Apply(view, row);
+          },
+          py::arg("logits"), py::arg("row") = 0);
+  m.def(
+      "apply_logits_processors",
+      [](MutableLogitsArray logits,
+         std::vector<llm::LogitsProcessorChain *> chains) {
+        llm::MutableLogitsView view = MakeMutableLogitsView(logits);
+        py::gil_scoped_release release;
+        llm::ApplyLogitsProcessors(view, chains);
+      },
+      py::arg("logits"), py::arg("chains"),
+      DOCSTRING_LLM_APPLY_LOGITS_PROCESSORS);
+}
+
+void BindMetrics(py::module_ &m) {
+  py::class_<MetricCounter>(m, "Counter")
+      .def("increment", &MetricCounter::Increment, py::arg("n") = 1)
+      .def_prop_ro("value", &MetricCounter::value);
+  py::class_<MetricGauge>(m, "Gauge")
+      .def("set", &MetricGauge::Set, py::arg("value"))
+      .def("add", &MetricGauge::Add, py::arg("n"))
+      .def_prop_ro("value", &MetricGauge::value);
+  py::class_<MetricHistogram>(m, "Histogram", DOCSTRING_METRICS_HISTOGRAM)
+      .def_prop_ro("unit", &MetricHistogram::unit)
+      .def("record", &MetricHistogram::Record, py::arg("value"))
+      .def(
+          "observe",
+          [](MetricHistogram &self, double value) {
+            self.Record(
+                static_cast<uint64_t>(std::llround(std::max(value, 0.0) /
+                                                   self.unit())));
+          },
+          py::arg("value"))
+      .def_prop_ro("count",
+                   [](MetricHistogram &self) { return self.snapshot().count; })
+      .def(
+          "quantile",
+          [](MetricHistogram &self, double q) {
+            return self.snapshot().Quantile(q) * self.unit();
+          },
+          py::arg("q"));
+
+  m.def(
+      "counter",
+      [](std::string_view name, std::string_view help,
+         std::string_view labels) -> MetricCounter & {
+        return MetricsRegistry::global().counter(name, help, labels);
+      },
+      py::arg("name"), py::arg("help") = "", py::arg("labels") = "",
+      py::rv_policy::reference);
+  m.def(
+      "gauge",
+      [](std::string_view name, std::string_view help,
+         std::string_view labels) -> MetricGauge & {
+        return MetricsRegistry::global().gauge(name, help, labels);
+      },
+      py::arg("name"), py::arg("help") = "", py::arg("labels") = "",
+      py::rv_policy::reference);
+  m.def(
+      "histogram",
+      [](std::string_view name, std::string_view help, std::string_view labels,
+         double unit) -> MetricHistogram & {
+        return MetricsRegistry::global().histogram(name, help, labels, unit);
+      },
+      py::arg("name"), py::arg("help") = "", py::arg("labels") = "",
+      py::arg("unit") = 1.0, py::rv_policy::reference,
+      DOCSTRING_METRICS_HISTOGRAM_FN);
+  m.def(
+      "export_prometheus",
+      []() { return MetricsRegistry::global().ExportPrometheus(); },
+      DOCSTRING_METRICS_EXPORT_PROMETHEUS);
 }
 
 }  // namespace shortfin::python
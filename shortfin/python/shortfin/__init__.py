@@ -12,8 +12,10 @@ import shortfin.support.logging_setup as _logging_setup
 # Most classes from the native "local" namespace are aliased to the top
 # level of the public API.
 BaseProgramParameters = _sfl.local.BaseProgramParameters
+CommandCapture = _sfl.local.CommandCapture
 CompletionEvent = _sfl.local.CompletionEvent
 Device = _sfl.local.Device
+ExportedBarrier = _sfl.local.ExportedBarrier
 Fiber = _sfl.local.Fiber
 Message = _sfl.local.Message
 Node = _sfl.local.Node
@@ -28,11 +30,21 @@ Queue = _sfl.local.Queue
 QueueReader = _sfl.local.QueueReader
 QueueWriter = _sfl.local.QueueWriter
 ScopedDevice = _sfl.local.ScopedDevice
+ShardedProgramParameters = _sfl.local.ShardedProgramParameters
+SharedQueue = _sfl.local.SharedQueue
+SharedQueueMessage = _sfl.local.SharedQueueMessage
+SharedQueueReader = _sfl.local.SharedQueueReader
+SharedQueueWriter = _sfl.local.SharedQueueWriter
 StaticProgramParameters = _sfl.local.StaticProgramParameters
 System = _sfl.local.System
+TransactionMode = _sfl.local.TransactionMode
+AccountPlacement = _sfl.local.AccountPlacement
+TransactionPriority = _sfl.local.TransactionPriority
+FlushReason = _sfl.local.FlushReason
 SystemBuilder = _sfl.local.SystemBuilder
 VoidFuture = _sfl.local.VoidFuture
 Worker = _sfl.local.Worker
+WorkerGroup = _sfl.local.WorkerGroup
 
 # Array is auto-imported.
 from . import array
@@ -57,11 +69,17 @@ __all__ = [
     "QueueReader",
     "QueueWriter",
     "ScopedDevice",
+    "ShardedProgramParameters",
+    "SharedQueue",
+    "SharedQueueMessage",
+    "SharedQueueReader",
+    "SharedQueueWriter",
     "StaticProgramParameters",
     "System",
     "SystemBuilder",
     "VoidFuture",
     "Worker",
+    "WorkerGroup",
     # System namespaces.
     "amdgpu",
     "host",
@@ -31,6 +31,7 @@ sint64 = _sfl.array.sint64
 uint64 = _sfl.array.uint64
 float8_e4m3fnuz = _sfl.array.float8_e4m3fnuz
 float8_e4m3fn = _sfl.array.float8_e4m3fn
+float8_e5m2 = _sfl.array.float8_e5m2
 float16 = _sfl.array.float16
 float32 = _sfl.array.float32
 float64 = _sfl.array.float64
@@ -45,6 +46,9 @@ read_barrier = _sfl.array.read_barrier
 write_barrier = _sfl.array.write_barrier
 disable_barrier = _sfl.array.disable_barrier
 storage = _sfl.array.storage
+exported_storage = _sfl.array.exported_storage
+memory_pool_scope = _sfl.array.memory_pool_scope
+MappingFuture = _sfl.array.MappingFuture
 DType = _sfl.array.DType
 
 # Ops.
@@ -53,6 +57,7 @@ argpartition = _sfl.array.argpartition
 add = _sfl.array.add
 ceil = _sfl.array.ceil
 convert = _sfl.array.convert
+convert_into = _sfl.array.convert_into
 divide = _sfl.array.divide
 exp = _sfl.array.exp
 fill_randn = _sfl.array.fill_randn
@@ -62,6 +67,7 @@ log_softmax = _sfl.array.log_softmax
 softmax = _sfl.array.softmax
 multiply = _sfl.array.multiply
 round = _sfl.array.round
+set_parallel_host_ops = _sfl.array.set_parallel_host_ops
 subtract = _sfl.array.subtract
 transpose = _sfl.array.transpose
 trunc = _sfl.array.trunc
@@ -102,6 +108,9 @@ __all__ = [
     "write_barrier",
     "disable_barrier",
     "storage",
+    "exported_storage",
+    "memory_pool_scope",
+    "MappingFuture",
     "DType",
     # Ops.
     "add",
@@ -109,6 +118,7 @@ __all__ = [
     "argpartition",
     "ceil",
     "convert",
+    "convert_into",
     "divide",
     "exp",
     "fill_randn",
@@ -117,6 +127,7 @@ __all__ = [
     "log_softmax",
     "multiply",
     "round",
+    "set_parallel_host_ops",
     "softmax",
     "subtract",
     "transpose",
@@ -4,6 +4,7 @@
 # See https://llvm.org/LICENSE.txt for license information.
 # SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+import atexit
 import logging
 import os
 import sys
@@ -45,6 +46,10 @@ native_handler.setFormatter(NativeFormatter())
 logger.setLevel(SHORTFIN_APPS_LOG_LEVEL)
 logger.addHandler(native_handler)
 
+# Native logging may be asynchronous (SHORTFIN_LOG_ASYNC): write out what is
+# still queued at exit.
+atexit.register(_sfl.log_flush)
+
 
 def configure_main_logger(module_suffix: str = "__main__") -> logging.Logger:
     """Configures logging from a main entrypoint.
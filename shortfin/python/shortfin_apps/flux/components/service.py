@@ -9,15 +9,16 @@ import logging
 import math
 import torch
 import numpy as np
-from tqdm.auto import tqdm
 from pathlib import Path
-from typing import Callable
+from typing import Callable, Optional
 from PIL import Image
 
 import shortfin as sf
+from _shortfin import lib as _sfl
 import shortfin.array as sfnp
 
 from ...utils import GenerateService, BatcherProcess
+from ...utilities.device_ops import DeviceOps
 
 from .config_struct import ModelParams
 from .manager import FluxSystemManager
@@ -75,9 +76,12 @@ class FluxGenerateService(GenerateService):
         prog_isolation: str = "per_fiber",
         show_progress: bool = False,
         trace_execution: bool = False,
+        device_ops: Optional[DeviceOps] = None,
     ):
         super().__init__(sysman, fibers_per_device, workers_per_device)
         self.name = name
+        # Converts latents and images on the device, if set.
+        self.device_ops = device_ops
         self.clip_tokenizers = clip_tokenizers
         self.t5xxl_tokenizers = t5xxl_tokenizers
         self.model_params = model_params
@@ -177,10 +181,12 @@ class FluxGenerateService(GenerateService):
             # Initialize denoise functions
             self.inference_functions[worker_idx]["denoise"] = {}
             for bs in self.model_params.sampler_batch_sizes:
+                sampler = self.inference_programs[worker_idx]["sampler"][bs][
+                    f"{self.model_params.sampler_module_name}.{self.model_params.sampler_fn_name}"
+                ]
                 self.inference_functions[worker_idx]["denoise"][bs] = {
-                    "sampler": self.inference_programs[worker_idx]["sampler"][bs][
-                        f"{self.model_params.sampler_module_name}.{self.model_params.sampler_fn_name}"
-                    ],
+                    "sampler": sampler,
+                    "loop": create_denoise_loop(sampler),
                 }
             # Initialize decode functions
             self.inference_functions[worker_idx]["decode"] = {}
@@ -192,6 +198,21 @@ class FluxGenerateService(GenerateService):
                 ]
 
 
+def create_denoise_loop(sampler):
+    """Creates the native step loop over a sampler function.
+
+    Its inputs are the denoise inputs of InferenceExecutorProcess, in order:
+    img, txt, vec, steps (0..N, sliced per step), timesteps and guidance_scale.
+    Each step's sampler result is the img of the next.
+    """
+    Arg = _sfl.diffusion.DenoiseArg
+    args = [Arg.latents(), Arg.input(1), Arg.input(2), Arg.step_input(3)]
+    args += [Arg.input(4), Arg.input(5)]
+    return _sfl.diffusion.DenoiseLoop(
+        [_sfl.diffusion.DenoiseStage(sampler, args)], latents=Arg.input(0)
+    )
+
+
 ########################################################################################
 # Batcher
 ########################################################################################
@@ -505,7 +526,7 @@ class InferenceExecutorProcess(sf.Process):
             "vec": sfnp.device_array.for_device(
                 device, vec_shape, self.service.model_params.sampler_dtype
             ),
-            "step": sfnp.device_array.for_device(device, [1], sfnp.int64),
+            "steps": sfnp.device_array.for_device(device, [100], sfnp.int64),
             "timesteps": sfnp.device_array.for_device(
                 device, [100], self.service.model_params.sampler_dtype
             ),
@@ -607,28 +628,27 @@ class InferenceExecutorProcess(sf.Process):
         denoise_inputs["timesteps"].copy_from(ts_host)
         await device
 
-        for i, t in tqdm(
-            enumerate(range(step_count)),
-            disable=(not self.service.show_progress),
-            desc=f"DENOISE (bs{req_bs})",
-        ):
-            s_host = denoise_inputs["step"].for_transfer()
-            with s_host.map(write=True) as m:
-                s_host.items = [i]
-            denoise_inputs["step"].copy_from(s_host)
-
-            logger.info(
-                "INVOKE %r",
-                fns["sampler"],
-            )
-            await device
-            (noise_pred,) = await fns["sampler"](
-                *denoise_inputs.values(), fiber=self.fiber
-            )
-            await device
-            denoise_inputs["img"].copy_from(noise_pred)
+        s_host = denoise_inputs["steps"].for_transfer()
+        s_host.items = list(range(denoise_inputs["steps"].shape[0]))
+        denoise_inputs["steps"].copy_from(s_host)
+
+        logger.info(
+            "INVOKE %r (%d steps)",
+            fns["sampler"],
+            step_count,
+        )
+        (denoise_inputs["img"],) = await fns["loop"].run(
+            list(denoise_inputs.values()), step_count, fiber=self.fiber
+        )
 
         for idx, req in enumerate(requests):
+            if self.service.device_ops:
+                req.denoised_latents = await self.service.device_ops.convert(
+                    self.fiber,
+                    denoise_inputs["img"].view(idx * cfg_mult),
+                    self.service.model_params.vae_dtype,
+                )
+                continue
             req.denoised_latents = sfnp.device_array.for_device(
                 device, img_shape, self.service.model_params.vae_dtype
             )
@@ -692,6 +712,17 @@ class InferenceExecutorProcess(sf.Process):
         )
         await device
         (image,) = await fn(latents, fiber=self.fiber)
+        if self.service.device_ops:
+            # Only the uint8 pixels are downloaded.
+            pixels = await self.service.device_ops.to_image(
+                self.fiber, image, scale=127.5, bias=127.5
+            )
+            pixels_host = pixels.for_transfer()
+            pixels_host.copy_from(pixels)
+            await device
+            for idx, req in enumerate(requests):
+                req.image_array = pixels_host.view(idx)
+            return
         await device
         images_shape = [
             req_bs,
@@ -711,6 +742,14 @@ class InferenceExecutorProcess(sf.Process):
     async def _postprocess(self, device, requests):
         # Process output images
         for req in requests:
+            if self.service.device_ops:
+                # Pixels [1, height, width, 3], converted on the device.
+                req.response_image = Image.frombytes(
+                    mode="RGB",
+                    size=(req.width, req.height),
+                    data=bytes(req.image_array.map(read=True)),
+                )
+                continue
             image_shape = [
                 3,
                 req.height,
@@ -28,6 +28,7 @@ from .components.io_struct import GenerateReqInput
 from .components.manager import FluxSystemManager
 from .components.service import FluxGenerateService
 from .components.tokenizer import Tokenizer
+from ..utilities.device_ops import DeviceOps
 
 
 logger = logging.getLogger("shortfin-flux")
@@ -134,6 +135,17 @@ def configure_service(args, sysman, model_config, flagfile, tuning_spec):
 
     model_params = ModelParams.load_json(model_config)
     vmfbs, params = get_modules(args, model_config, flagfile, tuning_spec)
+    device_ops = None
+    if args.device_ops:
+        device_ops = DeviceOps(
+            sysman.ls,
+            [
+                f"--iree-hal-target-device={args.device}",
+                f"--iree-hip-target={args.target}",
+            ]
+            + args.compile_flags,
+            cache_dir=Path(args.artifacts_dir) / "device_ops",
+        )
 
     sm = FluxGenerateService(
         name="flux",
@@ -146,6 +158,7 @@ def configure_service(args, sysman, model_config, flagfile, tuning_spec):
         prog_isolation=args.isolation,
         show_progress=args.show_progress,
         trace_execution=args.trace_execution,
+        device_ops=device_ops,
     )
     for key, vmfblist in vmfbs.items():
         for vmfb in vmfblist:
@@ -352,6 +365,11 @@ def main(argv, log_config=UVICORN_LOG_CONFIG):
         action="store_true",
         help="Enable tracing of program modules.",
     )
+    parser.add_argument(
+        "--device_ops",
+        action="store_true",
+        help="Convert latents and postprocess images with device programs.",
+    )
     parser.add_argument(
         "--amdgpu_async_allocations",
         action="store_true",
@@ -35,3 +35,16 @@ class BatchConfig:
     decode_functions: dict[int, sf.ProgramFunction]  # type: ignore
     prog_isolation: sf.ProgramIsolation  # type: ignore
     chunk_block_size: Optional[int] = None
+    # Form batches with the native scheduler, limiting prefill batches to
+    # `prefill_token_budget` tokens if positive.
+    native_scheduler: bool = False
+    prefill_token_budget: int = 0
+    # Functions selecting the top-k logits of a batch on device, by batch size,
+    # if sampling on device.
+    sample_functions: Optional[dict[int, sf.ProgramFunction]] = None  # type: ignore
+    # Functions running `model_params.decode_steps` greedy decode steps, by
+    # batch size, if decoding several steps per invocation.
+    decode_steps_functions: Optional[dict[int, sf.ProgramFunction]] = None  # type: ignore
+    # Prefill functions of static sequence lengths, by batch size and sequence
+    # length, to bucket prefills into besides `prefill_functions`.
+    prefill_seq_len_functions: Optional[dict[tuple[int, int], sf.ProgramFunction]] = None  # type: ignore
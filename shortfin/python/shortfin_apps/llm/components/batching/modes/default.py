@@ -17,6 +17,7 @@ from shortfin import Fiber
 from ..batching_trait import BatchingTrait
 from ..config import BatchConfig
 
+from ...buckets import BucketSelector
 from ...config_struct import ModelParams
 from ...device_array_cache import DeviceArrayCache
 from ...invocation import (
@@ -26,12 +27,19 @@ from ...invocation import (
     LlmTask,
     LlmTaskInput,
     LlmTaskResponder,
+    MultiStepDecodeTask,
 )
+from ... import metrics
 from ...kvcache.base_attention_cache import (
     BasePagedAttentionCache,
 )
 from ...messages import InferencePhase, LlmInferenceExecRequest
-from ...scheduler import AbstractScheduler, ChunkScheduler, Scheduler
+from ...scheduler import (
+    AbstractScheduler,
+    ChunkScheduler,
+    NativeScheduler,
+    Scheduler,
+)
 
 from .....utils import BatcherProcess
 
@@ -115,8 +123,13 @@ class DecodeTaskResponder(LlmTaskResponder):
         indices: Optional[sfnp.device_array],
     ) -> None:
         exec_requests = self._get_requests_from_task(llm_task)
+        # A multi-step decode returns the tokens of its steps, [bs, steps].
+        multi_step = isinstance(llm_task, MultiStepDecodeTask)
         for i in range(len(exec_requests)):
             req = exec_requests[i]
+            if multi_step:
+                req.result_tokens = [int(t) for t in logits.view(i).items.tolist()]
+                continue
             logits_item = logits.view(i, 0)
 
             index_item = None
@@ -168,12 +181,18 @@ class LlmBatcherProcess(BatcherProcess):
         program_isolation: str,
         scheduler: AbstractScheduler,
         llm_task_responder: LlmTaskResponder,
+        sample_functions: Optional[dict[int, sf.ProgramFunction]] = None,
+        seq_len_functions: Optional[dict[tuple[int, int], sf.ProgramFunction]] = None,
     ):
         super().__init__(fiber=fiber)
         self.name = name
         self.page_cache: BasePagedAttentionCache = page_cache
         self.model_params = model_params
         self.functions = functions
+        self.sample_functions = sample_functions
+        self.bucket_selector = BucketSelector.from_functions(
+            functions or {}, seq_len_functions
+        )
         self.pending: set[LlmTaskInput] = set()
         # TODO: There is no "ideal" batch size. Use prefill/decode dynamic
         # batching in the scheduling algo.
@@ -186,8 +205,16 @@ class LlmBatcherProcess(BatcherProcess):
         self.scheduler = scheduler
         self._llm_task_responder = llm_task_responder
 
+        # Arrival time of each request waiting for its first batch.
+        self._arrival_times: dict[str, float] = {}
+        self._queue_time = metrics.queue_time(name)
+
     def handle_inference_request(self, request: LlmInferenceExecRequest):
         """Handle an inference request."""
+        if request.cancelled:
+            self._llm_task_responder.set_cancelled(request)
+            return
+        self._arrival_times[request.instance_id] = metrics.now()
         self._llm_task_responder.add_request(request)
         task_inputs = self.make_task_inputs(request)
         for task_input in task_inputs:
@@ -255,6 +282,37 @@ class LlmBatcherProcess(BatcherProcess):
         """
         ...
 
+    def drop_cancelled(self, to_schedule: List[LlmTaskInput]) -> List[LlmTaskInput]:
+        """Drop the tasks of cancelled requests from a batch about to launch,
+        along with their tasks still in the scheduler, and complete the
+        requests without results.
+
+        Returns the tasks left to launch.
+        """
+        responder = self._llm_task_responder
+        cancelled_rids = set()
+        kept = []
+        for task_input in to_schedule:
+            if task_input is None:
+                continue
+            if task_input.rid not in cancelled_rids:
+                request = responder.get_request(task_input.instance_id)
+                if request is None or not request.cancelled:
+                    kept.append(task_input)
+                    continue
+                cancelled_rids.add(task_input.rid)
+                dropped = [task_input] + self.scheduler.cancel(task_input.rid)
+            else:
+                dropped = [task_input]
+            for dropped_input in dropped:
+                self._arrival_times.pop(dropped_input.instance_id, None)
+                request = responder.get_request(dropped_input.instance_id)
+                if request is not None:
+                    responder.set_cancelled(request)
+        if cancelled_rids:
+            logger.debug("Dropped cancelled requests: %r", cancelled_rids)
+        return kept
+
     def board(
         self,
         page_cache: BasePagedAttentionCache,
@@ -272,11 +330,17 @@ class LlmBatcherProcess(BatcherProcess):
         assert len(to_schedule) > 0
         assert len(to_schedule) <= self.ideal_batch_size
 
-        task_inputs = []
-        for request in to_schedule:
-            # Can flight this request.
-            if request is not None:
-                task_inputs.append(request)
+        # Cancelled requests stop here, at the step boundary.
+        task_inputs = self.drop_cancelled(to_schedule)
+        if not task_inputs:
+            return
+
+        now = metrics.now()
+        for request in task_inputs:
+            # Only the first chunk of a chunked prefill waited on arrival.
+            arrival = self._arrival_times.pop(request.instance_id, None)
+            if arrival is not None:
+                self._queue_time.observe(now - arrival)
 
         exec_process = self.make_invoker(page_cache, fiber, task_inputs)
 
@@ -303,9 +367,21 @@ class PrefillBatcherProcess(LlmBatcherProcess):
         prefill_functions: dict[int, sf.ProgramFunction],
         program_isolation: str,
         chunk_block_size: Optional[int],
+        native_scheduler: bool = False,
+        token_budget: int = 0,
+        sample_functions: Optional[dict[int, sf.ProgramFunction]] = None,
+        prefill_seq_len_functions: Optional[
+            dict[tuple[int, int], sf.ProgramFunction]
+        ] = None,
     ):
         ideal_batch_size = max(model_params.prefill_batch_sizes)
-        if chunk_block_size is not None:
+        if native_scheduler:
+            scheduler = NativeScheduler(
+                ideal_batch_size=ideal_batch_size,
+                token_budget=token_budget,
+                chunked=chunk_block_size is not None,
+            )
+        elif chunk_block_size is not None:
             scheduler = ChunkScheduler(ideal_batch_size=ideal_batch_size)
         else:
             scheduler = Scheduler(ideal_batch_size=ideal_batch_size)
@@ -321,6 +397,8 @@ class PrefillBatcherProcess(LlmBatcherProcess):
             program_isolation=program_isolation,
             scheduler=scheduler,
             llm_task_responder=llm_task_responder,
+            sample_functions=sample_functions,
+            seq_len_functions=prefill_seq_len_functions,
         )
 
         self._chunk_block_size = chunk_block_size
@@ -391,7 +469,7 @@ class PrefillBatcherProcess(LlmBatcherProcess):
         return PrefillTask(
             task_inputs=task_inputs,
             array_cache=self.array_cache,
-            page_tables=page_cache.page_pool.page_tables,
+            page_tables=page_cache.page_pool.tables,
             seq_stride=self.page_seq_stride,
             has_prefill_position=self.model_params.has_prefill_position,
             chunk_block_size=self._chunk_block_size,
@@ -420,6 +498,8 @@ class PrefillBatcherProcess(LlmBatcherProcess):
             functions=self.functions,
             program_isolation=self.program_isolation,
             responder=self._llm_task_responder,
+            sample_functions=self.sample_functions,
+            bucket_selector=self.bucket_selector,
         )
 
 
@@ -439,9 +519,19 @@ class DecodeBatcherProcess(LlmBatcherProcess):
         model_params: ModelParams,
         decode_functions: dict[int, sf.ProgramFunction],
         program_isolation: str,
+        native_scheduler: bool = False,
+        sample_functions: Optional[dict[int, sf.ProgramFunction]] = None,
+        decode_steps_functions: Optional[dict[int, sf.ProgramFunction]] = None,
     ):
+        self.decode_steps_functions = decode_steps_functions
+        self.decode_steps_bucket_selector = BucketSelector.from_functions(
+            decode_steps_functions or {}
+        )
         ideal_batch_size = max(model_params.decode_batch_sizes)
-        scheduler = Scheduler(ideal_batch_size=ideal_batch_size)
+        if native_scheduler:
+            scheduler = NativeScheduler(ideal_batch_size=ideal_batch_size)
+        else:
+            scheduler = Scheduler(ideal_batch_size=ideal_batch_size)
         super().__init__(
             name="decode",
             fiber=fiber,
@@ -452,6 +542,7 @@ class DecodeBatcherProcess(LlmBatcherProcess):
             program_isolation=program_isolation,
             scheduler=scheduler,
             llm_task_responder=DecodeTaskResponder(scheduler=scheduler),
+            sample_functions=sample_functions,
         )
 
     def make_task_inputs(
@@ -466,18 +557,42 @@ class DecodeBatcherProcess(LlmBatcherProcess):
                 input_tokens=tuple(exec_request.input_token_ids),
                 page_ids=tuple(exec_request.page_ids),
                 start_position=exec_request.start_position,
+                decode_steps=exec_request.decode_steps,
             )
         ]
 
+    def board(
+        self,
+        page_cache: BasePagedAttentionCache,
+        fiber: Fiber,
+        to_schedule: List[LlmTaskInput],
+    ):
+        """Boards single and multi-step decodes of a batch as separate flights,
+        as they invoke different functions."""
+        single_step = [t for t in to_schedule if t.decode_steps == 1]
+        multi_step = [t for t in to_schedule if t.decode_steps > 1]
+        for flight in (single_step, multi_step):
+            if flight:
+                super().board(page_cache, fiber, flight)
+
     def make_task(
         self,
         task_inputs: List[LlmTaskInput],
         page_cache: BasePagedAttentionCache,
     ) -> LlmTask:
+        decode_steps = task_inputs[0].decode_steps
+        if decode_steps > 1:
+            return MultiStepDecodeTask(
+                task_inputs=task_inputs,
+                array_cache=self.array_cache,
+                page_tables=page_cache.page_pool.tables,
+                seq_stride=self.page_seq_stride,
+                decode_steps=decode_steps,
+            )
         return DecodeTask(
             task_inputs=task_inputs,
             array_cache=self.array_cache,
-            page_tables=page_cache.page_pool.page_tables,
+            page_tables=page_cache.page_pool.tables,
             seq_stride=self.page_seq_stride,
         )
 
@@ -500,13 +615,27 @@ class DecodeBatcherProcess(LlmBatcherProcess):
         Returns:
             LlmInvoker: Process to handle execution of VMFB for decode requests.
         """
+        llm_task = self.make_task(task_inputs, page_cache)
+        if isinstance(llm_task, MultiStepDecodeTask):
+            # Tokens are selected on device, by the steps themselves.
+            return LlmInvocationProcess(
+                name="decode_steps_invocation",
+                fiber=fiber,
+                llm_task=llm_task,
+                functions=self.decode_steps_functions,
+                program_isolation=self.program_isolation,
+                responder=self._llm_task_responder,
+                bucket_selector=self.decode_steps_bucket_selector,
+            )
         return LlmInvocationProcess(
             name="decode_invocation",
             fiber=fiber,
-            llm_task=self.make_task(task_inputs, page_cache),
+            llm_task=llm_task,
             functions=self.functions,
             program_isolation=self.program_isolation,
             responder=self._llm_task_responder,
+            sample_functions=self.sample_functions,
+            bucket_selector=self.bucket_selector,
         )
 
 
@@ -556,6 +685,10 @@ class DefaultBatchingEngine(BatchingTrait):
             prefill_functions=batch_cfg.prefill_functions,
             program_isolation=batch_cfg.prog_isolation,
             chunk_block_size=batch_cfg.chunk_block_size,
+            native_scheduler=batch_cfg.native_scheduler,
+            token_budget=batch_cfg.prefill_token_budget,
+            sample_functions=batch_cfg.sample_functions,
+            prefill_seq_len_functions=batch_cfg.prefill_seq_len_functions,
         )
         decode_batcher = DecodeBatcherProcess(
             fiber=decode_fiber,
@@ -563,6 +696,9 @@ class DefaultBatchingEngine(BatchingTrait):
             model_params=batch_cfg.model_params,
             decode_functions=batch_cfg.decode_functions,
             program_isolation=batch_cfg.prog_isolation,
+            native_scheduler=batch_cfg.native_scheduler,
+            sample_functions=batch_cfg.sample_functions,
+            decode_steps_functions=batch_cfg.decode_steps_functions,
         )
 
         return DefaultBatchingEngine(
@@ -0,0 +1,117 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""Selection of the compiled shape variant (bucket) invoked for a batch.
+
+A model is compiled for a few batch sizes, and optionally a few static
+sequence lengths of prefill besides its dynamic ones. A batch is padded to the
+shape of the bucket it is invoked with, so the selector picks the fitting
+bucket of the lowest expected latency, from the latencies measured of earlier
+invocations, rather than the first that fits.
+"""
+
+import logging
+
+import shortfin as sf
+
+from dataclasses import dataclass, field
+from typing import Optional
+
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass(frozen=True)
+class ShapeBucket:
+    batch_size: int
+    # Static sequence length of the function, or None if it is dynamic.
+    seq_len: Optional[int]
+    function: sf.ProgramFunction = field(compare=False)  # type: ignore
+
+    def fits(self, req_count: int, seq_len: int) -> bool:
+        return req_count <= self.batch_size and (
+            self.seq_len is None or seq_len <= self.seq_len
+        )
+
+    def padded_tokens(self, seq_len: int) -> int:
+        """Number of tokens of a batch of `seq_len` padded to the bucket."""
+        return self.batch_size * (seq_len if self.seq_len is None else self.seq_len)
+
+
+class BucketSelector:
+    """Selects the bucket of the lowest expected latency fitting a batch.
+
+    The latency of a bucket is expected to be proportional to the padded
+    tokens of the batch, at the rate (in seconds per token) measured of the
+    bucket, smoothed exponentially over its invocations. Buckets that were not
+    invoked yet are expected to run at the mean rate of those that were, so
+    that, until anything is measured, the bucket of the fewest padded tokens
+    is selected.
+    """
+
+    def __init__(self, buckets: list[ShapeBucket], smoothing: float = 0.25):
+        # Ties go to the smaller batch size, then to static sequence lengths
+        # over the dynamic function.
+        self._buckets = sorted(
+            buckets,
+            key=lambda b: (b.batch_size, b.seq_len is None, b.seq_len or 0),
+        )
+        self._smoothing = smoothing
+        self._rates: dict[ShapeBucket, float] = {}
+
+    @staticmethod
+    def from_functions(
+        functions: dict[int, sf.ProgramFunction],  # type: ignore
+        seq_len_functions: Optional[
+            dict[tuple[int, int], sf.ProgramFunction]  # type: ignore
+        ] = None,
+    ) -> "BucketSelector":
+        """Selector of the dynamic `functions` by batch size, and the static
+        `seq_len_functions` by batch size and sequence length."""
+        buckets = [ShapeBucket(bs, None, fn) for bs, fn in functions.items()]
+        for (bs, seq_len), fn in (seq_len_functions or {}).items():
+            buckets.append(ShapeBucket(bs, seq_len, fn))
+        return BucketSelector(buckets)
+
+    @property
+    def buckets(self) -> list[ShapeBucket]:
+        return self._buckets
+
+    def expected_latency(self, bucket: ShapeBucket, seq_len: int) -> float:
+        rate = self._rates.get(bucket)
+        if rate is None:
+            rates = self._rates.values()
+            rate = sum(rates) / len(rates) if rates else 1.0
+        return rate * bucket.padded_tokens(seq_len)
+
+    def select(self, req_count: int, seq_len: int) -> ShapeBucket:
+        """The bucket of the lowest expected latency for `req_count` requests
+        of up to `seq_len` tokens.
+
+        Raises:
+            RuntimeError: No bucket fits the batch.
+        """
+        fitting = [b for b in self._buckets if b.fits(req_count, seq_len)]
+        if not fitting:
+            raise RuntimeError(
+                f"No available entry point for bs {req_count}, seq_len {seq_len}"
+            )
+        return min(fitting, key=lambda b: self.expected_latency(b, seq_len))
+
+    def record(self, bucket: ShapeBucket, seq_len: int, latency: float):
+        """Record the `latency` (in seconds) of invoking `bucket` for a batch
+        of `seq_len` tokens."""
+        rate = latency / max(bucket.padded_tokens(seq_len), 1)
+        previous = self._rates.get(bucket)
+        if previous is not None:
+            rate = previous + self._smoothing * (rate - previous)
+        self._rates[bucket] = rate
+        logger.debug(
+            "Bucket bs=%d, seq_len=%s: %.3g s/token",
+            bucket.batch_size,
+            bucket.seq_len,
+            rate,
+        )
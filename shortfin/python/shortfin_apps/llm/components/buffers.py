@@ -2,7 +2,6 @@ import logging
 
 from typing import List, Optional, Sequence, Tuple
 
-import shortfin as sf
 import shortfin.array as sfnp
 
 from .device_array_cache import Allocation
@@ -11,7 +10,7 @@ from .device_array_cache import Allocation
 logger = logging.getLogger(__name__)
 
 
-def create_argument_buffers(
+async def create_argument_buffers(
     buffers: List[Allocation],
     data: Sequence[List[int | float] | List[List[int | float]]],
     defaults: List[Optional[int | float]],
@@ -20,6 +19,12 @@ def create_argument_buffers(
 
     `buffers`, `data`, and `defaults` are parallel lists.
 
+    The buffers may have been released by an invocation still in flight (see
+    `LlmTask.process_results`), so their host staging is written once the
+    device has completed its uploads from it, without blocking the worker.
+    The uploads themselves are ordered after the uses of the device buffers
+    by the fiber's timeline.
+
     Args:
         buffers (List[Allocation]): Buffers to passed to VMFB.
         data (Sequence[List[int | float] | List[List[int | float]]]): Data to fill the buffers with.
@@ -38,7 +43,7 @@ def create_argument_buffers(
     for index, buffer in enumerate(buffers):
         buffer_data = data[index]
         default = defaults[index]
-        with buffer.host.map(discard=True) as host_buffer:
+        with await buffer.host.map_async(discard=True) as host_buffer:
             if default is not None:
                 host_buffer.fill(default)
             host_buffer.items = buffer_data
@@ -51,13 +56,16 @@ def create_argument_buffers(
 
 async def copy_buffers_to_host(
     buffers: Tuple[Optional[sfnp.device_array]],
-    device: sf.ScopedDevice,
 ) -> List[sfnp.device_array]:
     """Copy device buffers to host buffers.
 
     This function takes a list of device arrays and copies each one to a host buffer.
     If a buffer is `None`, it appends `None` to the new buffers list.
 
+    Only the copies are waited on, rather than the device, so that work
+    enqueued after them (e.g. the invocation of the next batch) keeps the
+    device busy while the results are downloaded and processed.
+
     Args:
         buffers (List[Optional[sfnp.device_array]]): List of device arrays to copy to host.
 
@@ -74,5 +82,7 @@ async def copy_buffers_to_host(
         host_buffer.copy_from(buffer)
         new_buffers.append(host_buffer)
 
-    await device
+    for host_buffer in new_buffers:
+        if host_buffer is not None:
+            (await host_buffer.map_async(read=True)).close()
     return new_buffers
@@ -0,0 +1,172 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""Planning of chunked prefill steps under a budget of KV cache pages.
+
+Acquiring the pages of a chunked prefill greedily, request by request, can
+start more prefills than the pool holds pages for: they then run out of pages
+partway through, and must be retried. The planner instead starts a request
+only once the pages of all of its remaining chunks can be reserved, and among
+the requests that can start, chooses the ones processing the most tokens in
+the step.
+"""
+
+import itertools
+
+from dataclasses import dataclass
+from typing import Dict, List, Sequence, Tuple
+
+from .invocation import LlmTaskInput
+
+
+@dataclass
+class _PlannedRequest:
+    chunk_tokens: List[int]
+    chunk_pages: List[int]
+    # Index of the next chunk to run, and whether one is running.
+    next_chunk: int = 0
+    running: bool = False
+
+    @property
+    def started(self) -> bool:
+        return self.next_chunk > 0 or self.running
+
+    @property
+    def remaining_pages(self) -> int:
+        """Pages of the chunks not yet run (a running chunk holds its pages)."""
+        return sum(self.chunk_pages[self.next_chunk + int(self.running) :])
+
+
+def chunk_costs(task_inputs: Sequence[LlmTaskInput]) -> Tuple[List[int], List[int]]:
+    """Returns the input tokens and the pages newly used by each chunk of a
+    chunked prefill (i.e. of `PrefillBatcherProcess._make_chunked_task_inputs`).
+    """
+    tokens = [len(task.input_tokens) for task in task_inputs]
+    block_counts = [0] + [task.block_count for task in task_inputs]
+    pages = [b - a for a, b in zip(block_counts, block_counts[1:])]
+    return tokens, pages
+
+
+class ChunkPlanner:
+    """Plans the chunks of queued prefills to run at each step.
+
+    Each step runs at most one chunk per request, and at most `max_batch_size`
+    chunks of `token_budget` tokens in total (if positive). The pages of a
+    chunk are acquired when it runs. Requests that have started come first,
+    in arrival order, as the pages of their remaining chunks are reserved.
+    Requests that have not started are considered in
+    arrival order, `lookahead` at a time: the subset of them fitting in what
+    remains of the batch, the token budget and the page budget, and processing
+    the most tokens (the earliest requests on ties), starts. Requests beyond
+    the lookahead may not start before earlier ones, which bounds how long a
+    large request may be passed over.
+
+    Not thread safe.
+    """
+
+    def __init__(
+        self, *, max_batch_size: int, token_budget: int = 0, lookahead: int = 8
+    ):
+        if max_batch_size <= 0:
+            raise ValueError(f"max_batch_size must be > 0 (got {max_batch_size})")
+        if lookahead <= 0:
+            raise ValueError(f"lookahead must be > 0 (got {lookahead})")
+        self._max_batch_size = max_batch_size
+        self._token_budget = token_budget
+        self._lookahead = lookahead
+        # In arrival order.
+        self._requests: Dict[str, _PlannedRequest] = {}
+
+    @property
+    def reserved_pages(self) -> int:
+        """Pages of the remaining chunks of started requests."""
+        return sum(
+            request.remaining_pages
+            for request in self._requests.values()
+            if request.started
+        )
+
+    def has_request(self, rid: str) -> bool:
+        return rid in self._requests
+
+    def add_request(
+        self, rid: str, chunk_tokens: Sequence[int], chunk_pages: Sequence[int]
+    ):
+        """Queues the prefill of `rid`, whose chunks process `chunk_tokens[i]`
+        tokens using `chunk_pages[i]` pages not used by earlier chunks."""
+        if rid in self._requests:
+            raise ValueError(f"Request {rid} is already planned")
+        if not chunk_tokens or len(chunk_tokens) != len(chunk_pages):
+            raise ValueError(
+                f"Expected the same number of tokens and pages for at least one "
+                f"chunk (got {len(chunk_tokens)} and {len(chunk_pages)})"
+            )
+        self._requests[rid] = _PlannedRequest(list(chunk_tokens), list(chunk_pages))
+
+    def remove_request(self, rid: str):
+        """Drops `rid` (i.e. if cancelled), releasing its reserved pages."""
+        self._requests.pop(rid, None)
+
+    def plan(self, available_pages: int) -> List[Tuple[str, int]]:
+        """Returns the (rid, chunk index) of the chunks to run in the next
+        step, given the free pages of the pool (including the reserved pages).
+        The chunks are marked running until `complete`."""
+        free_pages = available_pages - self.reserved_pages
+        planned = []
+        tokens = 0
+        waiting = []
+        for rid, request in self._requests.items():
+            if request.running:
+                continue
+            if not request.started:
+                if len(waiting) < self._lookahead:
+                    waiting.append(rid)
+                continue
+            chunk_tokens = request.chunk_tokens[request.next_chunk]
+            if len(planned) < self._max_batch_size and self._fits(
+                tokens + chunk_tokens, len(planned) + 1
+            ):
+                planned.append(rid)
+                tokens += chunk_tokens
+
+        best: Tuple[int, ...] = ()
+        best_tokens = 0
+        slots = self._max_batch_size - len(planned)
+        for size in range(1, min(slots, len(waiting)) + 1):
+            for subset in itertools.combinations(range(len(waiting)), size):
+                requests = [self._requests[waiting[i]] for i in subset]
+                subset_tokens = sum(r.chunk_tokens[0] for r in requests)
+                # Combinations are generated in lexicographic order, so that
+                # the first with the most tokens favors the earliest requests.
+                if subset_tokens <= best_tokens:
+                    continue
+                if sum(r.remaining_pages for r in requests) > free_pages:
+                    continue
+                if not self._fits(tokens + subset_tokens, len(planned) + size):
+                    continue
+                best, best_tokens = subset, subset_tokens
+
+        planned.extend(waiting[i] for i in best)
+        for rid in planned:
+            self._requests[rid].running = True
+        return [(rid, self._requests[rid].next_chunk) for rid in planned]
+
+    def complete(self, rid: str) -> bool:
+        """Notes that the running chunk of `rid` completed. Returns whether it
+        was the last, the request then leaving the planner."""
+        request = self._requests.get(rid)
+        if request is None or not request.running:
+            raise ValueError(f"Request {rid} has no running chunk")
+        request.running = False
+        request.next_chunk += 1
+        if request.next_chunk == len(request.chunk_tokens):
+            del self._requests[rid]
+            return True
+        return False
+
+    def _fits(self, tokens: int, chunks: int) -> bool:
+        # A step may always run a single chunk, however large.
+        return self._token_budget <= 0 or tokens <= self._token_budget or chunks == 1
@@ -36,6 +36,14 @@ def _decode_dtype(name: str) -> sfnp.DType:
 
 dataclasses_json.cfg.global_config.encoders[sfnp.DType] = lambda dt: dt.name
 dataclasses_json.cfg.global_config.decoders[sfnp.DType] = _decode_dtype
+# Overrides are looked up by the annotation of the field, so optional dtypes
+# need their own entries.
+dataclasses_json.cfg.global_config.encoders[Optional[sfnp.DType]] = lambda dt: (
+    None if dt is None else dt.name
+)
+dataclasses_json.cfg.global_config.decoders[Optional[sfnp.DType]] = lambda name: (
+    None if name is None else _decode_dtype(name)
+)
 
 
 @dataclass_json(undefined=Undefined.EXCLUDE)
@@ -108,6 +116,15 @@ class PagedKVCacheParams:
     # Number of blocks per device for kvcache
     paged_kv_block_size_elements_per_device: list[int] | None = None
 
+    # Element type of the per-page scales of a quantized (fp8 or int8)
+    # `kv_cache_dtype`, or None if the cache holds unscaled values. The scale
+    # tables are passed to the model after the page tables.
+    kv_cache_scale_dtype: Optional[sfnp.DType] = None
+
+    # Number of scales of each page per device. Defaults to one for each of k
+    # and v of each transformer block, split evenly across devices.
+    paged_kv_scales_per_device: list[int] | None = None
+
 
 @dataclass_json(undefined=Undefined.RAISE)
 @dataclass
@@ -139,6 +156,14 @@ class ModelParams:
     # Similarly, batch sizes that the decode stage is compiled for.
     decode_batch_sizes: list[int]
 
+    # Static sequence lengths that prefill is also compiled for, in ascending
+    # order. These are expected to be functions exported with suffixes of
+    # "_bs{batch_size}_sl{seq_len}" for each of the prefill batch sizes, possibly
+    # from separate modules. Each prefill is invoked with the variant (or the
+    # dynamic function) of the lowest measured latency that fits it, to pad
+    # partially full batches less.
+    prefill_seq_lens: list[int] | None = None
+
     # Whether the model was exported with `start_positions` for prefill.
     has_prefill_position: bool = False
 
@@ -159,10 +184,34 @@ class ModelParams:
     # If `top_k` > 1, logits/indices from `top_k` are returned.
     top_k: int | None = None
 
+    # The `top_k` of the `sample_bs{N}` functions of the module, if it exports
+    # them. Each selects the top k of the `[bs, seq_len, vocab]` logits of a
+    # prefill/decode on device (i.e. with the sharktank hip top-k kernel), and
+    # returns logits/indices as a model exported with `top_k` does.
+    sampling_top_k: int | None = None
+
+    # The number of steps of the `decode_steps_bs{N}` functions of the module,
+    # if it exports them. Each takes the arguments of `decode_bs{N}`, with page
+    # ids covering all of the steps, runs that many greedy decode steps on
+    # device, feeding the argmax token of each step to the next, and returns
+    # the `[bs, decode_steps]` int64 tokens selected by the steps.
+    decode_steps: int | None = None
+
     # Cache parameters.
     paged_kv_cache: PagedKVCacheParams | None = None
 
     def __post_init__(self):
+        if self.sampling_top_k is not None and self.sampling_top_k < 1:
+            raise ValueError(f"Currently, only `sampling_top_k >= 1` is supported.")
+
+        if self.decode_steps is not None and self.decode_steps < 1:
+            raise ValueError(f"Currently, only `decode_steps >= 1` is supported.")
+
+        if self.prefill_seq_lens is not None and self.prefill_seq_lens != sorted(
+            self.prefill_seq_lens
+        ):
+            raise ValueError("`prefill_seq_lens` must be in ascending order.")
+
         if self.top_k is None or self.top_k >= 1:
             return
 
@@ -210,6 +259,17 @@ class ModelParams:
         size *= self.attn_head_dim
         return size
 
+    def paged_kv_scales_per_page(self, device_count: int) -> list[int] | None:
+        """Number of scales of each page on each of `device_count` devices of a
+        quantized cache, or None if the cache is not quantized.
+        """
+        assert self.has_paged_kv_cache
+        if self.paged_kv_cache.kv_cache_scale_dtype is None:
+            return None
+        if self.paged_kv_cache.paged_kv_scales_per_device is not None:
+            return self.paged_kv_cache.paged_kv_scales_per_device
+        return [2 * self.transformer_block_count // device_count] * device_count
+
     @property
     def paged_kv_block_size_elements(self) -> int:
         """Size in elements of each attention block of {block_position_stride}
@@ -237,7 +297,10 @@ class ServerParams:
     """
 
     # KV cache configuration
-    prefix_sharing_algorithm: str = "none"  # none or trie
+    prefix_sharing_algorithm: str = "none"  # none, trie or native_trie
+    prefix_cache_eviction: str = "lru"  # lru or lfu, for native_trie
+    # Pages of the host memory tier of the native_trie prefix cache (0 for none)
+    prefix_cache_host_pages: int = 0
 
     # Program isolation configuration
     program_isolation: str = "per_call"
@@ -248,6 +311,23 @@ class ServerParams:
 
     chunk_block_size: Optional[int] = None
 
+    # Batch formation with the native scheduler, and the maximum number of
+    # tokens of a prefill batch (0 for no limit).
+    native_scheduler: bool = False
+    prefill_token_budget: int = 0
+
+    # Where the top-k logits of each step are selected: "host", from the full
+    # logits, or "device", with the `sample_bs{N}` functions of the module, so
+    # that only the top-k logits and indices are downloaded.
+    sampling_device: str = "host"
+
+    # Decode greedy requests `decode_steps` tokens per invocation, with the
+    # `decode_steps_bs{N}` functions of the module (see ModelParams), so that
+    # the host only waits for and downloads the tokens of every N steps.
+    # Requests with beam search, sampling or logits processors still decode
+    # one token per invocation.
+    multi_step_decode: bool = False
+
     # Device configuration
     device_ids: list[str] = field(default_factory=list)
     amdgpu_async_allocations: bool = False
@@ -50,6 +50,16 @@ class DecodeConfig:
     # Use `top_p` sampling strategy in decode loop
     top_p: int | None = None
 
+    # Penalize tokens already generated, dividing positive logits (and
+    # multiplying negative ones) by `repetition_penalty`, and subtracting
+    # `presence_penalty` plus `frequency_penalty` times their count
+    repetition_penalty: float = 1.0
+    presence_penalty: float = 0.0
+    frequency_penalty: float = 0.0
+
+    # Bias added to the logits of tokens, by token id
+    logit_bias: dict[int, float] | None = None
+
     def update_from_sampling_params(self, sampling_params):
         for field in fields(sampling_params):
             if getattr(sampling_params, field.name) == NOT_PROVIDED:
@@ -67,4 +77,8 @@ class DecodeConfig:
             temperature=self.temperature,
             top_k=self.top_k,
             top_p=self.top_p,
+            repetition_penalty=self.repetition_penalty,
+            presence_penalty=self.presence_penalty,
+            frequency_penalty=self.frequency_penalty,
+            logit_bias=self.logit_bias,
         )
@@ -8,12 +8,12 @@ import asyncio
 import itertools
 import logging
 import numpy as np
-import threading
 
 from typing import Callable, Dict, List, Optional, Tuple, Union
 
 from _shortfin import lib as _sfl
 
+from shortfin_apps.llm.components import metrics
 from shortfin_apps.llm.components.batching.facade import BatchingFacade
 from shortfin_apps.llm.components.decode_config import (
     DecodeConfig,
@@ -30,6 +30,7 @@ from shortfin_apps.llm.components.messages import (
     InferencePhase,
 )
 from shortfin_apps.llm.components.prefill_config import PrefillConfig
+from shortfin_apps.utils import CancellationToken
 
 logger = logging.getLogger(__name__)
 
@@ -55,6 +56,28 @@ def _convert_to_cpp_decode_config(py_config: DecodeConfig):
     return cpp_config
 
 
+def make_logits_processor(
+    config: DecodeConfig,
+) -> Optional[_sfl.llm.LogitsProcessorChain]:
+    """Builds the native logits processors of `config`, if it has any.
+
+    Processors only apply without beam search, as they track the tokens
+    generated by one sequence.
+    """
+    if config.num_beams > 1:
+        return None
+    chain = _sfl.llm.LogitsProcessorChain()
+    if config.repetition_penalty != 1.0:
+        chain.add_repetition_penalty(config.repetition_penalty)
+    if config.presence_penalty or config.frequency_penalty:
+        chain.add_presence_penalty(config.presence_penalty, config.frequency_penalty)
+    if config.logit_bias:
+        chain.add_logit_bias(
+            {int(token): float(bias) for token, bias in config.logit_bias.items()}
+        )
+    return chain if len(chain) else None
+
+
 def combine_scores_null(
     step: np.ndarray, old_score: np.ndarray, norm: float, config: DecodeConfig
 ):
@@ -213,6 +236,8 @@ class PageManager:
         allocated_cache_recs: Dict[str, CacheInfo],
     ):
         used = set()
+        copy_src_pages = []
+        copy_dst_pages = []
         for i, beam in enumerate(beam_page_ids):
             if len(beam) > 0:
                 if beam[-1] in used:
@@ -229,7 +254,8 @@ class PageManager:
                         decode_reqs[i].instance_id
                     ] = allocated_cache_recs.get(req.instance_id, None)
                     if beam[-1] != new_page:
-                        self._page_pool.copy_page_index(beam[-1], new_page)
+                        copy_src_pages.append(beam[-1])
+                        copy_dst_pages.append(new_page)
                         beam[-1] = new_page
                 else:
                     decode_allocated_cache_info = allocated_cache_recs.get(
@@ -245,6 +271,10 @@ class PageManager:
 
                 used.add(beam[-1])
 
+        # Fork the shared pages in one transfer rather than one per beam.
+        if copy_src_pages:
+            self._page_pool.copy_page_indices(copy_src_pages, copy_dst_pages)
+
     def update_decode_reqs(
         self,
         select: List[int],
@@ -289,13 +319,47 @@ class PageManager:
             decode_reqs[i].page_ids = self._shared_pages + new_beam_page_ids[i]
         return decode_reqs[: len(tokens)]
 
+    def reserve_positions(
+        self,
+        req: LlmInferenceExecRequest,
+        allocated_cache_recs: Dict[str, CacheInfo],
+        count: int,
+    ) -> List[int]:
+        """Allocates the pages starting within the `count` positions after the
+        current one, ahead of the update_decode_reqs calls that hand them out.
+
+        Multi-step decode writes the cache of these positions on device, before
+        their tokens are known. Returns the page ids, in order.
+        """
+        page_count = sum(
+            1
+            for p in range(self._position, self._position + count)
+            if p % self._tokens_per_page == 0
+        )
+        if page_count > len(self._free_pages):
+            req_allocated_cache_info = allocated_cache_recs.get(req.instance_id, None)
+            if not req_allocated_cache_info:
+                raise CacheAllocationFailure("No allocated cache info found for request.")
+            acquired_cache_info = self._page_cache.allocate(
+                [],
+                req_allocated_cache_info,
+                max(page_count - len(self._free_pages), self._allocation_block_size),
+            )
+            acquired = acquired_cache_info.pages[len(req_allocated_cache_info.pages) :]
+            self._free_pages.extend([p.index for p in acquired])
+        return self._free_pages[:page_count]
+
     def release_pages(self):
         self._page_cache.free_allocated_pages(self._free_pages)
         self._free_pages = []
 
 
 class TokenSelector:
-    def __init__(self, decode_config: DecodeConfig):
+    def __init__(
+        self,
+        decode_config: DecodeConfig,
+        logits_processor: Optional[_sfl.llm.LogitsProcessorChain] = None,
+    ):
         self._selected_tokens: List[List[int]] = []
         self._selected_beams: List[List[int]] = []
         self._scores: List[float] = [0.0]
@@ -311,12 +375,27 @@ class TokenSelector:
         )
 
         self._score_function = _score_functions[decode_config.logits_normalization]
+        self._logits_processor = logits_processor
+
+    def _process(self, logits: np.ndarray) -> np.ndarray:
+        # Processes a copy of the logits, as they may be a read only view.
+        logits = np.array(logits, dtype=np.float32)
+        rows = logits.reshape(-1, logits.shape[-1])
+        _sfl.llm.apply_logits_processors(
+            rows, [self._logits_processor] * rows.shape[0]
+        )
+        return logits
 
     def _select(self, logits: List[np.ndarray], indices: List[Optional[np.ndarray]]):
         # Setup next steps:
         step = len(self._selected_beams)
         max_score = max(self._scores)
 
+        # Processors index logits by token id, which model side top-k breaks.
+        processor = self._logits_processor if indices[0] is None else None
+        if processor is not None:
+            logits = [self._process(l) for l in logits]
+
         logits = [
             self._score_function(np.asarray(l), s, max_score, self._decode_config)
             for l, s in zip(logits, self._scores)
@@ -344,6 +423,9 @@ class TokenSelector:
             (beam, step) for token, beam in zip(tokens, beams) if token == eos
         ]
 
+        if processor is not None:
+            processor.accept_tokens([int(token) for token in next_tokens])
+
         self._completed.extend(next_completed)
         self._selected_beams.append(next_beams)
         self._selected_tokens.append(next_tokens)
@@ -356,6 +438,22 @@ class TokenSelector:
 
         return beams, tokens
 
+    def step_tokens(self, tokens: List[int]):
+        """Records the tokens of steps selected on device for a single beam, up
+        to the first eos. Returns the beams and tokens of the last step, as
+        step() does."""
+        for token in tokens:
+            step = len(self._selected_beams)
+            if token == self._eos_token_id:
+                self._completed.append((0, step))
+                self._selected_beams.append([])
+                self._selected_tokens.append([])
+                self._scores = []
+                return [], []
+            self._selected_beams.append([0])
+            self._selected_tokens.append([token])
+        return [0], [tokens[-1]]
+
     def done(self):
         return len(self._completed) >= self._hypothesis
 
@@ -397,6 +495,7 @@ class LlmDecoder:
         results_callback: Callable[[Union[int, List[int]]], None],
         rid,
         use_native_impls: bool = False,
+        decode_steps: int = 1,
     ):
         self._prefill_config = prefill_config
         self._decode_config = decode_config
@@ -408,12 +507,19 @@ class LlmDecoder:
         self._page_pool = self._page_cache.page_pool
         self._results_callback = results_callback
         self._rid = rid
-        self._lock = threading.Lock()
-        self._cancelled = False
+        # Shared with the exec requests, which the batchers drop once it is
+        # cancelled.
+        self._cancellation = CancellationToken()
         self._allocated_cach_recs: Dict[str, CacheInfo] = {}
+        self._use_native_impls = use_native_impls
+        self._decode_steps = decode_steps
 
         if use_native_impls:
             self._select_function = self._native_select
+            # Sampling state of this request, advanced on every step.
+            self._rng_state = np.array(
+                [np.random.randint(0, 2**63, dtype=np.int64)], dtype=np.uint64
+            )
         else:
             self._select_function = (
                 select_topk if self._decode_config.num_beams > 1 else select_greedy
@@ -424,15 +530,40 @@ class LlmDecoder:
         ]
 
     def _native_select(self, logits, decode_config):
-        tokens, scores = _sfl.llm.select_tokens(
-            logits.flatten(), self._cpp_decode_config
+        # Selection is over all beams at once, as one row.
+        logits = np.ascontiguousarray(logits).reshape(1, -1)
+        config = self._cpp_decode_config
+        width = config.num_beams if config.use_beam_search else 1
+        tokens = np.empty((1, width), dtype=np.int32)
+        scores = np.empty((1, width), dtype=np.float32)
+        _sfl.llm.select_tokens_batch(
+            logits, config, tokens, scores, rng_states=self._rng_state
+        )
+        selected = tokens[0] >= 0
+        return tokens[0][selected], scores[0][selected]
+
+    def _multi_step(self) -> bool:
+        """Whether to decode `decode_steps` tokens per invocation: the steps
+        select greedily on device, which only matches a single beam selected
+        from unprocessed logits."""
+        config = self._decode_config
+        return (
+            self._decode_steps > 1
+            and config.num_beams == 1
+            and make_logits_processor(config) is None
+            and (
+                not self._use_native_impls
+                or (config.top_k in (None, 1) and config.top_p is None)
+            )
         )
-        return np.array(tokens), np.array(scores)
 
     def cancel(self):
-        """Cancel inproceess work."""
-        with self._lock:
-            self._cancelled = True
+        """Cancel inproceess work.
+
+        The requests in flight are dropped by the batchers at their next batch,
+        and `run` returns early, releasing the request's cache pages.
+        """
+        self._cancellation.cancel()
 
     def release(self):
         """Release any remain resources held by the decoder"""
@@ -450,6 +581,8 @@ class LlmDecoder:
             )
             for _ in range(num_beams)
         ]
+        for req in decode_reqs:
+            req.cancellation = self._cancellation
 
         for req in decode_reqs:
             req.start_position = len(prefill_req.input_token_ids)
@@ -463,6 +596,7 @@ class LlmDecoder:
         prefill_req = LlmInferenceExecRequest(
             phase=InferencePhase.PREFILL, input_token_ids=input_ids, rid=self._rid
         )
+        prefill_req.cancellation = self._cancellation
 
         cached_allocation = self._page_cache.lookup(input_ids[: -self._tokens_per_page])
         if self._prefill_config.has_prefill_position:
@@ -499,14 +633,22 @@ class LlmDecoder:
         self._allocated_cach_recs[req.instance_id] = None
 
     async def run(self, input_ids):
+        metrics.REQUESTS.increment()
+        start_time = metrics.now()
         input_length = len(input_ids)
         prefill_req = self.create_prefill_req(input_ids)
         # Run Prefill:
         self._unified_batcher.submit(prefill_req)
         await prefill_req.done
+        if self._cancellation.cancelled:
+            self.free_req_cache(prefill_req)
+            return
         self.publish_request(prefill_req, publish_incomplete_page=False)
 
-        token_selector = TokenSelector(self._decode_config)
+        token_selector = TokenSelector(
+            self._decode_config,
+            logits_processor=make_logits_processor(self._decode_config),
+        )
         prefill_req_cache_info = self._allocated_cach_recs.get(
             prefill_req.instance_id, None
         )
@@ -529,13 +671,18 @@ class LlmDecoder:
         beams, tokens = token_selector.step(
             [prefill_req.result_logits], [prefill_req.result_indices]
         )
+        token_time = metrics.now()
+        metrics.TIME_TO_FIRST_TOKEN.observe(token_time - start_time)
+        metrics.GENERATED_TOKENS.increment(len(tokens))
 
         # Setup decode requests:
         decode_reqs = self.create_decode_reqs(prefill_req)
+        decode_steps = self._decode_steps if self._multi_step() else 1
 
         # Run Decoder:
-        for _ in range(self._decode_config.max_completion_tokens - 1):
-            if token_selector.done() or self._cancelled or len(beams) == 0:
+        remaining = self._decode_config.max_completion_tokens - 1
+        while remaining > 0:
+            if token_selector.done() or self._cancellation.cancelled or len(beams) == 0:
                 break
 
             # Update the reqs:
@@ -545,21 +692,63 @@ class LlmDecoder:
 
             input_length = input_length + 1
 
+            if decode_steps > 1:
+                # The steps after the first write the cache on device.
+                req = to_run[0]
+                req.page_ids = req.page_ids + page_manager.reserve_positions(
+                    req, self._allocated_cach_recs, decode_steps - 1
+                )
+
             self._unified_batcher.reserve_workload(
                 rid=prefill_req.orig_instance_id, count=len(to_run)
             )
 
             for req in to_run:
                 req.reset(InferencePhase.DECODE)
+                req.decode_steps = decode_steps
                 self._unified_batcher.submit(req)
 
             gathered = asyncio.gather(*[req.done for req in to_run])
             await gathered
+            # Dropped requests have no results.
+            if self._cancellation.cancelled:
+                break
 
-            beams, tokens = token_selector.step(
-                [req.result_logits for req in to_run],
-                [req.result_indices for req in to_run],
-            )
+            if decode_steps > 1:
+                if to_run[0].result_tokens is None:
+                    break
+                step_tokens = to_run[0].result_tokens[:remaining]
+                if self._eos_token in step_tokens:
+                    step_tokens = step_tokens[: step_tokens.index(self._eos_token) + 1]
+                beams, tokens = token_selector.step_tokens(step_tokens)
+                generated = step_tokens if beams else step_tokens[:-1]
+                # Record the tokens that the steps fed back to the model, all but
+                # the last one unless generation stopped, in the pages reserved
+                # for them.
+                fed = generated[:-1] if beams else generated
+                for token in fed:
+                    page_manager.update_decode_reqs(
+                        [0],
+                        decode_reqs,
+                        self._allocated_cach_recs,
+                        [token],
+                        input_length,
+                    )
+                    input_length = input_length + 1
+                step_count = len(step_tokens)
+            else:
+                beams, tokens = token_selector.step(
+                    [req.result_logits for req in to_run],
+                    [req.result_indices for req in to_run],
+                )
+                generated = tokens
+                step_count = 1
+            remaining -= step_count
+            now = metrics.now()
+            for _ in range(step_count):
+                metrics.INTER_TOKEN_LATENCY.observe((now - token_time) / step_count)
+            metrics.GENERATED_TOKENS.increment(len(generated))
+            token_time = now
 
         # Remove the reservation:
         self._unified_batcher.reserve_workload(
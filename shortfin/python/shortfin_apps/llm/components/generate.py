@@ -49,6 +49,7 @@ class GenerateItemProcess(sf.Process):
         decode_config: DecodeConfig,
         fiber: sf.Fiber,
         use_native_impls: bool = False,
+        decode_steps: int = 1,
     ):
         super().__init__(fiber=fiber)
         self.rid = rid
@@ -65,6 +66,7 @@ class GenerateItemProcess(sf.Process):
             results_callback=self.results_callback,
             rid=self.rid,
             use_native_impls=use_native_impls,
+            decode_steps=decode_steps,
         )
 
     def cancel(self):
@@ -227,6 +229,7 @@ class ClientGenerateBatchProcess(sf.Process):
                     decode_config=decode_config,
                     fiber=fiber,
                     use_native_impls=self.service.server_params.use_native_impls,
+                    decode_steps=self.service.decode_steps,
                 )
 
                 gen_processes.append(gen_process)
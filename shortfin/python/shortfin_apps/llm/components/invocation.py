@@ -9,6 +9,8 @@ from dataclasses import dataclass, field
 from itertools import chain
 from typing import List, Optional, Tuple, Union
 
+from . import metrics
+from .buckets import BucketSelector
 from .buffers import copy_buffers_to_host, create_argument_buffers
 from .device_array_cache import Allocation, DeviceArrayCache, WrappedAllocation
 from .messages import LlmInferenceExecRequest
@@ -26,6 +28,7 @@ class LlmTaskInput:
     input_tokens: Tuple[int, ...] = field(default_factory=tuple)
     page_ids: Tuple[int, ...] = field(default_factory=tuple)
     start_position: Optional[int] = None
+    decode_steps: int = 1
 
 
 class LlmTaskResponder(ABC):
@@ -48,6 +51,18 @@ class LlmTaskResponder(ABC):
     def add_request(self, exec_request: LlmInferenceExecRequest):
         self._exec_requests[exec_request.instance_id] = exec_request
 
+    def get_request(self, instance_id: str) -> Optional[LlmInferenceExecRequest]:
+        return self._exec_requests.get(instance_id)
+
+    def set_cancelled(self, exec_request: LlmInferenceExecRequest):
+        """Complete a cancelled request without results. Its cache pages are
+        released by the owner of the request once it sees the cancellation."""
+        exec_request.result_logits = None
+        exec_request.result_indices = None
+        exec_request.result_tokens = None
+        exec_request.done.set_success()
+        self._remove_request(exec_request.instance_id)
+
     def _remove_request(self, instance_id: str):
         if instance_id in self._exec_requests:
             del self._exec_requests[instance_id]
@@ -82,6 +97,11 @@ class LlmTask:
     def task_inputs(self):
         return self._task_inputs
 
+    @property
+    def batch_seq_len(self) -> int:
+        """Sequence length of the batch, padded to the seq_stride."""
+        return self._get_batch_seq_len(self._task_inputs)
+
     def _get_batch_seq_len(self, task_inputs: List[LlmTaskInput]) -> int:
         max_bsl = 0
         seq_stride = self._seq_stride
@@ -94,11 +114,14 @@ class LlmTask:
     async def prepare_args(
         self,
         batch_size: int,
+        seq_len: Optional[int] = None,
     ) -> List[sfnp.device_array]:
         """Prepare the arguments for invocation.
 
         Args:
             batch_size (int): Batch size of the invocation function.
+            seq_len (Optional[int]): Static sequence length of the invocation
+                function, if it has one.
 
         Returns:
             List[sfnp.device_array]: A list of arguments for the invocation.
@@ -130,12 +153,15 @@ class LlmTask:
                 - First item is logits
                 - Seconds items is optional indices
         """
-        buffers = (logits, indices)
-        logits, indices = await copy_buffers_to_host(buffers, device0)
-
-        # Release arg allocations
+        # Release arg allocations before waiting on the results. The invocation
+        # reading them is on the fiber's timeline, which orders the uploads of
+        # the next batch to them after it, so that batch stages its inputs
+        # while this one computes.
         [arg.release() for arg in args]
 
+        buffers = (logits, indices)
+        logits, indices = await copy_buffers_to_host(buffers)
+
         return logits, indices
 
 
@@ -189,6 +215,7 @@ class PrefillTask(LlmTask):
     async def prepare_args(
         self,
         batch_size: int,
+        seq_len: Optional[int] = None,
     ) -> List[sfnp.device_array]:
         """Get the arguments for the prefill invocation.
 
@@ -200,6 +227,8 @@ class PrefillTask(LlmTask):
 
         Args:
             batch_size (int): Size of the invocation function batch.
+            seq_len (Optional[int]): Static sequence length of the invocation
+                function, which the tokens are padded to, if it has one.
 
         Returns:
             List[sfnp.device_array]: A list of arguments for the invocation.
@@ -210,7 +239,12 @@ class PrefillTask(LlmTask):
         page_ids = [list(task_input.page_ids) for task_input in task_inputs]
 
         batch_seq_len = self._get_batch_seq_len(task_inputs)
+        if seq_len is not None:
+            batch_seq_len = seq_len
         block_count = self._get_block_count(batch_seq_len, task_inputs)
+        if seq_len is not None:
+            # The page ids of a static sequence length cover all of it.
+            block_count = max(block_count, seq_len // self._seq_stride)
 
         # Compute block sequence length as maximum sequence length, rounded
         # up to the seq_stride.
@@ -272,7 +306,7 @@ class PrefillTask(LlmTask):
         data.extend([seq_lens_data, seq_block_ids_data])
         defaults.extend([1, 0])
 
-        args = create_argument_buffers(
+        args = await create_argument_buffers(
             buffers=buffers,
             data=data,
             defaults=defaults,
@@ -359,7 +393,7 @@ class DecodeTask(LlmTask):
             chain.from_iterable(_pad_list(pages, block_count) for pages in page_ids)
         )
 
-        args = create_argument_buffers(
+        args = await create_argument_buffers(
             buffers=[
                 tokens_allocation,
                 seq_lens_allocation,
@@ -381,6 +415,32 @@ class DecodeTask(LlmTask):
         return args
 
 
+class MultiStepDecodeTask(DecodeTask):
+    """Decode task of the `decode_steps_bs{N}` functions, which run
+    `decode_steps` greedy decode steps on device.
+
+    The arguments are those of a decode, with the page ids of each input
+    covering the positions of all of the steps. The result is the `[bs,
+    decode_steps]` tokens selected by the steps, in place of the logits.
+    """
+
+    def __init__(
+        self,
+        task_inputs: List[LlmTaskInput],
+        array_cache: DeviceArrayCache,
+        page_tables: List[sfnp.device_array],
+        seq_stride: int,
+        decode_steps: int,
+    ):
+        self.decode_steps = decode_steps
+        super().__init__(
+            task_inputs=task_inputs,
+            array_cache=array_cache,
+            page_tables=page_tables,
+            seq_stride=seq_stride,
+        )
+
+
 class LlmInvocationProcess(sf.Process):
     """Executes the invocation of LLM for a batch of requests."""
 
@@ -392,10 +452,16 @@ class LlmInvocationProcess(sf.Process):
         functions: dict[int, sf.ProgramFunction],
         program_isolation: sf.ProgramIsolation,
         responder: LlmTaskResponder,
+        sample_functions: Optional[dict[int, sf.ProgramFunction]] = None,
+        bucket_selector: Optional[BucketSelector] = None,
     ):
         super().__init__(fiber=fiber)
         self._name = name
         self._functions = functions
+        # Shared by the invocations of a batcher, to select buckets from the
+        # latencies measured of all of them.
+        self._bucket_selector = bucket_selector
+        self._sample_functions = sample_functions
         self._program_isolation = program_isolation
 
         self._device0 = fiber.device(0)
@@ -410,32 +476,44 @@ class LlmInvocationProcess(sf.Process):
         """
         try:
             req_count = self._llm_task.req_count
+            seq_len = self._llm_task.batch_seq_len
 
             # Select an entrypoint for the batch.
-            entrypoints = self._functions
-            for bs, fn in entrypoints.items():
-                if bs >= req_count:
-                    break
+            selector = self._bucket_selector
+            if selector is None:
+                selector = BucketSelector.from_functions(self._functions)
+            bucket = selector.select(req_count, seq_len)
+            bs = bucket.batch_size
+
+            if bucket.seq_len is None:
+                args = await self._llm_task.prepare_args(bs)
             else:
-                raise RuntimeError(f"No available entry point for bs {req_count}")
-
-            args = await self._llm_task.prepare_args(bs)
+                args = await self._llm_task.prepare_args(bs, seq_len=bucket.seq_len)
             args_device = [arg.device for arg in args]
 
             # Invoke VMFB. Logits are of shape [bs, bsl, d].
-            results = await fn(*args_device, fiber=self.fiber)
+            start = metrics.now()
+            results = await bucket.function(*args_device, fiber=self.fiber)
 
             indices = None
             logits = results[0]
             if len(results) > 1:
                 indices = results[1]
 
+            # Select the top-k logits on device, so that only they are
+            # downloaded rather than the logits of the whole vocabulary.
+            if indices is None and self._sample_functions is not None:
+                logits, indices = await self._sample_functions[bs](
+                    logits, fiber=self.fiber
+                )
+
             logits, indices = await self._llm_task.process_results(
                 args,
                 logits,
                 indices,
                 self._device0,
             )
+            selector.record(bucket, seq_len, metrics.now() - start)
 
             self._responder.set_success(self._llm_task, logits, indices)
 
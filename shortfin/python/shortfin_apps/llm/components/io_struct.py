@@ -12,7 +12,7 @@ sglang: Copyright 2023-2024 SGLang Team, Licensed under the Apache License, Vers
 """
 
 from dataclasses import dataclass, field
-from typing import List, Optional, Union
+from typing import Dict, List, Optional, Union
 import uuid
 
 # TODO: Should max, min, and default change based on the model being ran?
@@ -55,6 +55,12 @@ class SamplingParams:
     top_p: float = NOT_PROVIDED
     # Number of beams to use during generation
     num_beams: int = NOT_PROVIDED
+    # Penalties of tokens already generated during token selection process
+    repetition_penalty: float = NOT_PROVIDED
+    presence_penalty: float = NOT_PROVIDED
+    frequency_penalty: float = NOT_PROVIDED
+    # Bias added to the logits of tokens, by token id
+    logit_bias: Dict[int, float] = NOT_PROVIDED
 
     def __post_init__(self):
         # Ensure temperature is within acceptable range
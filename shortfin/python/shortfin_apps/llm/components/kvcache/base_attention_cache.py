@@ -77,6 +77,11 @@ class BasePagedAttentionCache:
             last_cached_node=None,
         )
 
+    def cached_prefix_length(self, tokens: List[int]) -> int:
+        """Number of leading `tokens` that a lookup would find cached, without
+        the side effects of a lookup (i.e. for routing a request)."""
+        return 0
+
     def get_allocated_pages(self, page_ids: List[int]) -> List[PageInfo]:
         pages = []
         for page in self._allocated_pages:
@@ -103,7 +108,7 @@ class BasePagedAttentionCache:
         if pages is None:
             msg = (
                 f"FATAL CacheAllocationFailure: Failed to allocate {pages_needed} pages from `PagePool`.\n"
-                f"Required pages: {pages_needed}, Available pages: {len(self.page_pool.available_pages)}, Total pages: {self.page_pool.config.alloc_page_count}\n"
+                f"Required pages: {pages_needed}, Available pages: {self.page_pool.available_page_count()}, Total pages: {self.page_pool.config.alloc_page_count}\n"
                 f"Consider re-exporting the model with a higher `--device-block-count` value."
             )
             logger.error(msg)
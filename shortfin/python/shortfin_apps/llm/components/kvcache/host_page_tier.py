@@ -0,0 +1,143 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+Host memory tier for KV cache pages evicted from the prefix cache.
+
+Pages evicted from the device are copied to a host page table instead of being
+dropped, keyed by the chained hash of their prefix, and copied back when a
+later lookup reaches them. Long shared prefixes (i.e. system prompts) thus
+survive device memory pressure without being recomputed.
+
+Copies are enqueued on the fiber of the page tables like any other page copy
+(see `PagePool.copy_page_index`), so they are ordered before later work that
+reuses the device page or reads the swapped in page, without waiting on them.
+"""
+
+from collections import OrderedDict
+from dataclasses import dataclass
+import logging
+from typing import List, Optional, Tuple
+
+import shortfin as sf
+from _shortfin import lib as _sfl
+
+from .page_pool import PagePool, human_size
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass
+class HostPage:
+    """A page offloaded to a host page table slot."""
+
+    slot: int
+    hash: int
+    parent_hash: int
+    block: Tuple[int, ...]
+
+
+class HostPageTier:
+    """Bounded host copy of the pages evicted from a prefix cache.
+
+    One host page table is allocated per device of `page_pool` (with one host
+    scale table per device if the pool is quantized), in host memory that the
+    device can access directly. When full, the least recently offloaded pages
+    are dropped.
+    """
+
+    def __init__(self, page_pool: PagePool, page_count: int):
+        if page_count <= 0:
+            raise ValueError("page_count must be positive")
+        self.page_pool = page_pool
+        self.page_count = page_count
+        self.host_tables: list[sf.array.device_array] = []
+        # The scale tables of a quantized pool follow the page tables, also in
+        # device order.
+        devices = page_pool.devices * (2 if page_pool.config.quantized else 1)
+        for device, table in zip(devices, page_pool.tables):
+            shape = [page_count, table.shape[1]]
+            logger.info(
+                "Allocating host page table (shape=%r, size=%s) on %r",
+                shape,
+                human_size(table.dtype.compute_dense_nd_size(shape)),
+                device,
+            )
+            self.host_tables.append(
+                sf.array.device_array.for_host(device, shape, table.dtype)
+            )
+        self._slots = _sfl.llm.PagePool(page_count)
+        # Offloaded pages by hash, least recently offloaded first.
+        self._pages: OrderedDict[int, HostPage] = OrderedDict()
+        self.swap_out_count = 0
+        self.swap_in_count = 0
+        self.drop_count = 0
+
+    def __len__(self):
+        return len(self._pages)
+
+    def swap_out(
+        self, page_index: int, hash: int, parent_hash: int, block: List[int]
+    ) -> bool:
+        """Copy device page `page_index` caching `block` to the host tier.
+
+        Returns False (counting the page as dropped) if every slot holds a page
+        taken for swapping in.
+        """
+        if hash in self._pages:
+            self._pages.move_to_end(hash)
+            return True
+        slots = self._slots.acquire(1)
+        if slots is None:
+            if not self._pages:
+                self.drop_count += 1
+                return False
+            _, dropped = self._pages.popitem(last=False)
+            self._slots.release([dropped.slot])
+            self.drop_count += 1
+            slots = self._slots.acquire(1)
+        slot = slots[0]
+        for table, host_table in zip(self.page_pool.tables, self.host_tables):
+            host_table.view(slot).copy_from(table.view(page_index))
+        self._pages[hash] = HostPage(
+            slot=slot, hash=hash, parent_hash=parent_hash, block=tuple(block)
+        )
+        self.swap_out_count += 1
+        return True
+
+    def take(self, parent_hash: int, block: List[int]) -> Optional[HostPage]:
+        """Remove and return the offloaded page caching `block` after the
+        prefix hashed as `parent_hash`, if any.
+
+        The page must then be passed to `swap_in` or `put_back`.
+        """
+        hash = _sfl.llm.PrefixTrie.hash_block(parent_hash, block)
+        page = self._pages.get(hash)
+        if (
+            page is None
+            or page.parent_hash != parent_hash
+            or page.block != tuple(block)
+        ):
+            return None
+        del self._pages[hash]
+        return page
+
+    def put_back(self, page: HostPage):
+        self._pages[page.hash] = page
+
+    def swap_in(self, page: HostPage, page_index: int):
+        """Copy a page taken from the tier to device page `page_index`."""
+        for table, host_table in zip(self.page_pool.tables, self.host_tables):
+            table.view(page_index).copy_from(host_table.view(page.slot))
+        self._slots.release([page.slot])
+        self.swap_in_count += 1
+
+    def __repr__(self):
+        return (
+            f"HostPageTier({len(self._pages)}/{self.page_count} pages, "
+            f"{self.swap_out_count} swapped out, {self.swap_in_count} swapped in, "
+            f"{self.drop_count} dropped)"
+        )
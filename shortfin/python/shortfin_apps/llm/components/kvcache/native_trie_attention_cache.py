@@ -0,0 +1,345 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+Trie prefix cache backed by the native `PrefixTrie`.
+
+Drop-in replacement for `TriePagedAttentionCache`: the trie, its reference
+counts and the LRU / LFU eviction live in C++, keyed by hashed token blocks, so that
+prefix matching of long prompts does not build per-token tuples or walk Python
+objects and runs without holding the GIL.
+"""
+
+import math
+import logging
+from threading import Lock
+from typing import List, Optional
+
+from _shortfin import lib as _sfl
+
+from .host_page_tier import HostPageTier
+from .page_pool import PagePool, PageInfo
+from .base_attention_cache import BasePagedAttentionCache, CacheAllocationFailure
+from .trie_attention_cache import TrieCacheInfo
+
+logger = logging.getLogger(__name__)
+
+
+class NativeTriePagedAttentionCache(BasePagedAttentionCache):
+    """Trie-based paged attention cache with a native prefix index.
+
+    Behaves as `TriePagedAttentionCache`, except that the `last_cached_node`
+    of its `TrieCacheInfo`s is a node handle of `trie` (an `int`) rather than
+    a `TrieNode`.
+
+    Evictable pages are chosen by the native LRU or LFU eviction lists in O(1)
+    rather than by sorting the candidate leaves. With a `host_tier`, evicted
+    full pages are offloaded to host memory and swapped back in when a lookup
+    reaches them.
+
+    Attributes:
+        trie: Native prefix index of the published pages
+        page_pool: Pool providing page allocations
+        tokens_per_page: Number of tokens that fit in each page
+    """
+
+    def __init__(
+        self,
+        page_pool: PagePool,
+        tokens_per_page: int,
+        eviction_policy: str = "lru",
+        host_tier: Optional[HostPageTier] = None,
+    ):
+        """Initialize the trie cache.
+
+        Args:
+            page_pool: Pool to allocate pages from
+            tokens_per_page: Number of tokens per page
+            eviction_policy: "lru" or "lfu"
+            host_tier: Host tier to offload evicted pages to, if any
+
+        Raises:
+            ValueError: If tokens_per_page <= 0 or the eviction policy is unknown
+        """
+        if tokens_per_page <= 0:
+            raise ValueError("tokens_per_page must be positive")
+        policies = {
+            "lru": _sfl.llm.PrefixTrie.EvictionPolicy.LRU,
+            "lfu": _sfl.llm.PrefixTrie.EvictionPolicy.LFU,
+        }
+        if eviction_policy not in policies:
+            raise ValueError(f"Unknown eviction policy {eviction_policy!r}")
+
+        super().__init__(page_pool, tokens_per_page)
+        self.trie = _sfl.llm.PrefixTrie(
+            tokens_per_page, eviction_policy=policies[eviction_policy]
+        )
+        self.host_tier = host_tier
+        self._lock: Lock = Lock()
+        # Pages duplicating pages already in the trie, which are freed by
+        # release_pages.
+        self._duplicated_pages: List[PageInfo] = []
+
+    def _pages(self, indices: List[int]) -> List[PageInfo]:
+        entries = self.page_pool.attn_page_entries
+        return [entries[i] for i in indices]
+
+    def lookup(self, tokens: List[int]) -> TrieCacheInfo:
+        """Lookup the cache for the given token sequence. It only returns fully matched pages."""
+        with self._lock:
+            node, page_indices = self.trie.match(tokens)
+            if self.host_tier is not None and len(self.host_tier):
+                node = self._swap_in(node, tokens, page_indices)
+            num_matched_tokens = len(page_indices) * self.tokens_per_page
+            return TrieCacheInfo(
+                num_tokens=num_matched_tokens,
+                tokens=tokens[:num_matched_tokens],
+                pages=self._pages(page_indices),
+                last_cached_node=node,
+                number_of_published_pages=len(page_indices),
+                pool=self.page_pool,
+            )
+
+    def cached_prefix_length(self, tokens: List[int]) -> int:
+        # Pages in the host tier are not counted, as they must be swapped in.
+        return self.trie.match_length(tokens) * self.tokens_per_page
+
+    def _swap_in(self, node: int, tokens: List[int], page_indices: List[int]) -> int:
+        """Extend the match of `tokens` ending in `node` with pages swapped in
+        from the host tier, appending them to `page_indices`.
+
+        Returns the last matched node.
+        """
+        tokens_per_page = self.tokens_per_page
+        # Take the whole run of offloaded pages first, so that offloading the
+        # pages evicted to make room for them cannot drop them.
+        host_pages = []
+        parent_hash = self.trie.hash(node)
+        for start in range(
+            len(page_indices) * tokens_per_page,
+            len(tokens) - tokens_per_page + 1,
+            tokens_per_page,
+        ):
+            host_page = self.host_tier.take(
+                parent_hash, tokens[start : start + tokens_per_page]
+            )
+            if host_page is None:
+                break
+            host_pages.append(host_page)
+            parent_hash = host_page.hash
+
+        # Keep the match from being evicted to make room for the pages.
+        self.trie.retain(node)
+        try:
+            for i, host_page in enumerate(host_pages):
+                pages = self.page_pool.acquire_free_pages(1)
+                if pages is None:
+                    self.evict_pages(1)
+                    pages = self.page_pool.acquire_free_pages(1)
+                if pages is None:
+                    for unused in host_pages[i:]:
+                        self.host_tier.put_back(unused)
+                    break
+                self.host_tier.swap_in(host_page, pages[0].index)
+                child = self.trie.create_child(
+                    node, list(host_page.block), pages[0].index
+                )
+                if self.trie.page(child) != pages[0].index:
+                    self.page_pool.free_pages(pages)
+                self.trie.retain(child)
+                self.trie.release(node)
+                node = child
+                page_indices.append(self.trie.page(child))
+        finally:
+            self.trie.release(node)
+        return node
+
+    def evict_pages(self, max_pages: int, offload: bool = True) -> int:
+        """Evict up to max_pages pages from unreferenced leaves, by eviction policy.
+
+        Full pages are offloaded to the host tier, if any, unless `offload` is False.
+        """
+        if self.host_tier is None or not offload:
+            evicted = self.trie.evict(max_pages)
+        else:
+            evicted = []
+            for page, hash, parent_hash, block in self.trie.evict_nodes(max_pages):
+                if len(block) == self.tokens_per_page:
+                    self.host_tier.swap_out(page, hash, parent_hash, block)
+                evicted.append(page)
+        if evicted:
+            self.page_pool.free_pages(self._pages(evicted))
+        return len(evicted)
+
+    def allocate(
+        self,
+        tokens: List[int],
+        cache_info: TrieCacheInfo = None,
+        allocation_block_size: int = 0,
+        evict: bool = True,
+    ) -> TrieCacheInfo:
+        """Acquire pages for the uncached suffix `tokens` of `cache_info`.
+
+        Raises:
+            CacheAllocationFailure: If unable to allocate required pages
+        """
+        with self._lock:
+            if not cache_info:
+                raise ValueError("cache_info cannot be None")
+            cur_node = cache_info.last_cached_node
+
+            n_empty_pages = math.ceil(len(tokens) / self.tokens_per_page)
+            if allocation_block_size > 0:
+                n_empty_pages = max(n_empty_pages, allocation_block_size)
+
+            new_pages = self.page_pool.acquire_free_pages(n_empty_pages)
+            if new_pages is None and evict:
+                self.evict_pages(
+                    n_empty_pages - self.page_pool.available_page_count()
+                )
+                new_pages = self.page_pool.acquire_free_pages(n_empty_pages)
+                if new_pages is None:
+                    raise CacheAllocationFailure(
+                        "Failed to acquire pages even after attempting eviction"
+                    )
+            if new_pages is None:
+                raise CacheAllocationFailure(
+                    "Failed to acquire pages and eviction is disabled"
+                )
+
+            # New pages extend cur_node, unless this extends an allocation
+            # along the same branch which already registered with it.
+            if new_pages and (
+                not cache_info.pages
+                or self.trie.page(cur_node) == cache_info.pages[-1].index
+            ):
+                self.trie.retain(cur_node)
+
+            self._allocated_pages.extend(new_pages)
+            return TrieCacheInfo(
+                num_tokens=len(tokens) + cache_info.num_tokens,
+                tokens=cache_info.tokens + list(tokens),
+                pages=cache_info.pages + new_pages,
+                last_cached_node=cur_node,
+                number_of_published_pages=cache_info.number_of_published_pages,
+                pool=self.page_pool,
+            )
+
+    def publish_pages_for_tokens(
+        self, cache_info: TrieCacheInfo, publish_incomplete_page: bool = False
+    ) -> TrieCacheInfo:
+        """Make the pages of `cache_info` available in the cache for its tokens.
+
+        Args:
+            cache_info: TrieCacheInfo object containing allocation metadata
+            publish_incomplete_page: Whether to publish the last page even if it is not full
+        """
+        with self._lock:
+            if not cache_info:
+                raise ValueError("cache_info cannot be None")
+            tokens = list(cache_info.tokens)
+            tokens_per_page = self.tokens_per_page
+            matched_node, matched_indices = self.trie.match(
+                tokens, record_stats=False
+            )
+
+            duplicated = {page.index for page in self._duplicated_pages}
+            for i, index in enumerate(matched_indices):
+                if index != cache_info.pages[i].index and index not in duplicated:
+                    self._duplicated_pages.append(cache_info.pages[i])
+
+            start_page = max(
+                cache_info.number_of_published_pages, len(matched_indices)
+            )
+            unpublished_blocks = [
+                tokens[i : i + tokens_per_page]
+                for i in range(
+                    start_page * tokens_per_page, len(tokens), tokens_per_page
+                )
+            ]
+            unpublished_pages = cache_info.pages[
+                start_page : start_page + len(unpublished_blocks)
+            ]
+
+            pages = self._pages(matched_indices)
+            number_of_published_pages = start_page
+            last_cached_node = cache_info.last_cached_node
+            cur_node = matched_node
+            for block, page in zip(unpublished_blocks, unpublished_pages):
+                if not publish_incomplete_page and len(block) < tokens_per_page:
+                    break
+                cur_node = self.trie.create_child(cur_node, block, page.index)
+                cached_index = self.trie.page(cur_node)
+                if cached_index != page.index:
+                    if page not in self._duplicated_pages:
+                        self._duplicated_pages.append(page)
+                    page = self.page_pool.attn_page_entries[cached_index]
+                pages.append(page)
+                # Only full pages count as published.
+                if len(block) == tokens_per_page:
+                    number_of_published_pages += 1
+                    last_cached_node = cur_node
+
+            if unpublished_blocks:
+                # The allocation now extends the last published node.
+                self.trie.release(cache_info.last_cached_node)
+                self.trie.retain(last_cached_node)
+
+            published = {page.index for page in pages}
+            self._allocated_pages = [
+                page for page in self._allocated_pages if page.index not in published
+            ]
+            if not publish_incomplete_page and len(pages) < len(cache_info.pages):
+                pages = pages + cache_info.pages[len(pages) :]
+
+            return TrieCacheInfo(
+                num_tokens=len(tokens),
+                tokens=tokens,
+                pages=pages,
+                last_cached_node=last_cached_node,
+                number_of_published_pages=number_of_published_pages,
+                pool=self.page_pool,
+            )
+
+    def free_cache_pages(self):
+        """Free all pages that have zero references."""
+        self.evict_pages(self.page_pool.total_page_count(), offload=False)
+        self.page_pool.free_pages(self._allocated_pages)
+        self._allocated_pages = []
+
+    def free_allocated_pages(self, page_ids: List[int]):
+        page_id_set = set(page_ids)
+        pages = [page for page in self._allocated_pages if page.index in page_id_set]
+        self._allocated_pages = [
+            page for page in self._allocated_pages if page.index not in page_id_set
+        ]
+        self.page_pool.free_pages(pages)
+
+    def release_pages(self, cache_info: TrieCacheInfo):
+        """Release the allocation's reference to its last cached node.
+
+        Once unreferenced, the node becomes eligible for eviction.
+        """
+        if cache_info is None:
+            return
+        self.trie.release(cache_info.last_cached_node)
+        self.page_pool.free_pages(self._duplicated_pages)
+        self._duplicated_pages = []
+
+    def stats(self):
+        """Lookup, hit rate and eviction counters of the prefix index."""
+        return self.trie.stats()
+
+    def shutdown(self):
+        logger.info("Prefix cache: %r", self.trie.stats())
+        if self.host_tier is not None:
+            logger.info("Prefix cache host tier: %r", self.host_tier)
+        self.free_cache_pages()
+
+        available = self.page_pool.available_page_count()
+        total = self.page_pool.total_page_count()
+        if available != total:
+            raise ValueError(f"Pages lost: {total - available} of {total} unfreed")
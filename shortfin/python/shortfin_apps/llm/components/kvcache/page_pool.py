@@ -1,9 +1,9 @@
 from __future__ import annotations
 from typing import List, Tuple, Optional, Sequence
-import threading
 import logging
 import shortfin as sf
 import shortfin.array as sfnp
+from _shortfin import lib as _sfl
 from dataclasses import dataclass
 from .attention_cache_abstract import CacheStoreAbstract
 
@@ -49,6 +49,31 @@ class PagePoolConfig:
     # (e.g. [524288, 524288] for 2 devices assuming an even split in number of transformer blocks)
     paged_kv_block_size_elements_per_device: List[int]
 
+    # Element type of the scales of a quantized (i.e. fp8 or int8) KV cache, or
+    # None if the pages hold unscaled values.
+    #
+    # Each page then has `scales_per_page_per_device[i]` scales on device i
+    # (e.g. one for each of k and v of each transformer block on the device),
+    # kept in a scale table next to the page table and indexed by the same page
+    # index. The model dequantizes a page as `page * scale` of its block.
+    scale_dtype: Optional[sf.dtype] = None
+    scales_per_page_per_device: Optional[List[int]] = None
+
+    def __post_init__(self):
+        if self.scale_dtype is None:
+            return
+        if self.scales_per_page_per_device is None or len(
+            self.scales_per_page_per_device
+        ) != len(self.paged_kv_block_size_elements_per_device):
+            raise ValueError(
+                "A quantized page pool needs `scales_per_page_per_device` for "
+                "each device"
+            )
+
+    @property
+    def quantized(self) -> bool:
+        return self.scale_dtype is not None
+
 
 class PagePool(CacheStoreAbstract):
     """Page table based attention cache.
@@ -74,10 +99,11 @@ class PagePool(CacheStoreAbstract):
     """
 
     def __init__(self, *, devices: Sequence[sf.ScopedDevice], config: PagePoolConfig):
-        self._lock = threading.Lock()
         self.devices = list(devices)
         self.config = config
         self.page_tables: list[sf.array.device_array] = []
+        # Per-page scales of a quantized cache, one table per device.
+        self.scale_tables: list[sf.array.device_array] = []
 
         # Setup accounting structs.
         self.attn_page_entries = [
@@ -88,7 +114,9 @@ class PagePool(CacheStoreAbstract):
             for i in range(self.config.alloc_page_count)
         ]
 
-        self.available_pages = list(self.attn_page_entries)
+        # Free list and reference counts of the pages, kept natively so that
+        # acquiring and freeing pages is O(1) per page.
+        self.page_refs = _sfl.llm.PagePool(self.config.alloc_page_count)
 
         # Initialize a page table on each device.
         for device, paged_kv_block_size_elements in zip(
@@ -105,41 +133,79 @@ class PagePool(CacheStoreAbstract):
                 human_size(self.config.dtype.compute_dense_nd_size(page_table_shape)),
                 device,
             )
-            page_table = sf.array.device_array.for_device(
-                device, page_table_shape, self.config.dtype
-            )
+            with sfnp.memory_pool_scope("kvcache"):
+                page_table = sf.array.device_array.for_device(
+                    device, page_table_shape, self.config.dtype
+                )
             page_table_host = page_table.for_transfer()
             with page_table_host.map(discard=True) as m:
                 m.fill(0)
             page_table_host.copy_to(page_table)
             self.page_tables.append(page_table)
 
+        if self.config.quantized:
+            for device, scales_per_page in zip(
+                devices, self.config.scales_per_page_per_device
+            ):
+                self.scale_tables.append(
+                    self._allocate_scale_table(device, scales_per_page)
+                )
+
+    def _allocate_scale_table(
+        self, device: sf.ScopedDevice, scales_per_page: int
+    ) -> sf.array.device_array:
+        shape = [self.config.alloc_page_count, scales_per_page]
+        logging.info(
+            "Allocating scale table (shape=%r, dtype=%r, size=%s) on %r",
+            shape,
+            self.config.scale_dtype,
+            human_size(self.config.scale_dtype.compute_dense_nd_size(shape)),
+            device,
+        )
+        with sfnp.memory_pool_scope("kvcache"):
+            scale_table = sf.array.device_array.for_device(
+                device, shape, self.config.scale_dtype
+            )
+        # Unit scales, so that untouched pages read as zeros like unquantized
+        # ones.
+        scale_table_host = scale_table.for_transfer()
+        with scale_table_host.map(discard=True) as m:
+            m.fill(1.0)
+        scale_table_host.copy_to(scale_table)
+        return scale_table
+
+    @property
+    def tables(self) -> list[sf.array.device_array]:
+        """The page tables, then the scale tables of a quantized cache.
+
+        All are indexed by page and are passed to the model in this order.
+        Copies of pages copy the rows of each of them.
+        """
+        return self.page_tables + self.scale_tables
+
+    @property
+    def available_pages(self) -> list[PageInfo]:
+        return [self.attn_page_entries[i] for i in self.page_refs.available_pages]
+
     def available_page_count(self):
-        with self._lock:
-            return len(self.available_pages)
+        return self.page_refs.available_count
 
     def total_page_count(self):
-        with self._lock:
-            return len(self.attn_page_entries)
+        return len(self.attn_page_entries)
 
     def acquire_free_pages(self, count: int) -> list[PageInfo] | None:
-        with self._lock:
-            available = len(self.available_pages)
-            if count > available:
-                return None
-            return [self.available_pages.pop() for _ in range(count)]
+        indices = self.page_refs.acquire(count)
+        if indices is None:
+            return None
+        return [self.attn_page_entries[i] for i in indices]
 
     def free_pages(self, pages: list[PageInfo]):
-        with self._lock:
-            available_page_indicies = [p.index for p in self.available_pages]
-            for p in pages:
-                if p.index not in available_page_indicies:
-                    self.available_pages.append(p)
-                    available_page_indicies.append(p.index)
+        # Freeing a page which is already free is a no-op.
+        self.page_refs.release([p.index for p in pages])
 
     def copy_page_index(self, src_page: int, dst_page: int):
-        # Copy the data on each device
-        for page_table in self.page_tables:
+        # Copy the data (and scales) on each device
+        for page_table in self.tables:
             # View of source and destination pages
             src_view = page_table.view(src_page)
             dst_view = page_table.view(dst_page)
@@ -147,6 +213,34 @@ class PagePool(CacheStoreAbstract):
             # Copy the data
             dst_view.copy_from(src_view)
 
+    def copy_page_indices(self, src_pages: list[int], dst_pages: list[int]):
+        """Copy each page of `src_pages` to the page at the same position of
+        `dst_pages`, in one transfer per device.
+
+        No page may be both copied to and from, nor copied to twice.
+        """
+        for table in self.tables:
+            table.copy_rows_from(table, src_pages, dst_pages)
+
+    def copy_pages(self, src_pages: list[PageInfo]) -> list[PageInfo] | None:
+        """
+        Copy the contents of pages to new pages, in one transfer per device.
+
+        Args:
+            src_pages: Source pages to copy from
+
+        Returns:
+            New PageInfos containing the copied data, in the order of
+            `src_pages`, or None if there are not enough free pages
+        """
+        dst_pages = self.acquire_free_pages(len(src_pages))
+        if dst_pages is None:
+            return None
+        self.copy_page_indices(
+            [page.index for page in src_pages], [page.index for page in dst_pages]
+        )
+        return dst_pages
+
     def copy_page(self, src_page: PageInfo) -> PageInfo:
         """
         Copy a page's contents to a new page.
@@ -170,8 +264,7 @@ class PagePool(CacheStoreAbstract):
         return dst_page
 
     def __repr__(self):
-        # No need to lock for repr (list is internally synchronized).
-        free_pages = len(self.available_pages)
+        free_pages = self.page_refs.available_count
         total_pages = len(self.attn_page_entries)
         return (
             f"PagePool({total_pages - free_pages}/{total_pages} pages in use: "
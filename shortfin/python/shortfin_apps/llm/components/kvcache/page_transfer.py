@@ -0,0 +1,247 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+Transfer of the KV cache pages of a request between hosts, for disaggregated
+prefill and decode.
+
+A prefill host sends the pages of a request with `PageSender.send`, and a
+decode host receives them into free pages of its own pool with
+`PageReceiver.receive`. The transfer is over TCP:
+
+    header:  magic, version, table count, page count, request id length
+    request id (utf-8)
+    row bytes of each table of the pool (see `PagePool.tables`)
+    rows:    for each chunk of up to `chunk_pages` pages, for each table, the
+             rows of the chunk's pages
+
+Rows are staged through two host buffers per table that the device copies to
+and from directly, and the sockets read and write those buffers in place, so
+the host does not copy page data. Socket I/O runs on an executor thread: one
+staging buffer is on the wire while the device fills or drains the other, and
+the worker of the fiber keeps running other processes meanwhile.
+
+Both ends must have pools of the same tables (page dtype, size and scales).
+"""
+
+import asyncio
+from concurrent.futures import ThreadPoolExecutor
+import logging
+import socket
+import struct
+from typing import List, Sequence, Tuple
+
+import shortfin as sf
+
+from .page_pool import PageInfo, PagePool
+
+logger = logging.getLogger(__name__)
+
+MAGIC = b"SFKV"
+VERSION = 1
+
+# magic, version, table count, page count, request id length
+_HEADER = struct.Struct("<4sHHII")
+_ROW_BYTES = struct.Struct("<Q")
+
+
+class PageTransferError(Exception):
+    """A page transfer was malformed or does not fit the receiving pool."""
+
+
+def connect(host: str, port: int) -> socket.socket:
+    """Connect to a decode host listening with `PageTransferListener`."""
+    sock = socket.create_connection((host, port))
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    return sock
+
+
+def _row_bytes(table: sf.array.device_array) -> int:
+    return table.dtype.compute_dense_nd_size([table.shape[1]])
+
+
+def _recv_into(sock: socket.socket, view: memoryview):
+    while view:
+        received = sock.recv_into(view)
+        if received == 0:
+            raise PageTransferError("Connection closed during a page transfer")
+        view = view[received:]
+
+
+def _recv_exactly(sock: socket.socket, size: int) -> bytes:
+    data = bytearray(size)
+    _recv_into(sock, memoryview(data))
+    return bytes(data)
+
+
+class _PageTransfer:
+    """Staging buffers and I/O of one end of page transfers of a pool.
+
+    Transfers of one instance must not overlap; use one per concurrent
+    transfer. Its I/O runs on a single thread, in the order it is issued, which
+    keeps the stream in order without waiting on each send.
+    """
+
+    def __init__(self, page_pool: PagePool, *, chunk_pages: int = 16):
+        if chunk_pages <= 0:
+            raise ValueError("chunk_pages must be positive")
+        self.page_pool = page_pool
+        self.chunk_pages = chunk_pages
+        self._executor = ThreadPoolExecutor(
+            max_workers=1, thread_name_prefix="page-transfer"
+        )
+        self._tables = page_pool.tables
+        self._row_bytes = [_row_bytes(table) for table in self._tables]
+        # The scale tables of a quantized pool follow the page tables, also in
+        # device order.
+        devices = page_pool.devices * (2 if page_pool.config.quantized else 1)
+        self._staging = [
+            [
+                sf.array.device_array.for_host(
+                    device, [chunk_pages, table.shape[1]], table.dtype
+                )
+                for device, table in zip(devices, self._tables)
+            ]
+            for _ in range(2)
+        ]
+
+    def _io(self, fn, *args) -> asyncio.Future:
+        return asyncio.wrap_future(self._executor.submit(fn, *args))
+
+    async def _synchronize(self):
+        for device in self.page_pool.devices:
+            await device
+
+    def _chunks(self, pages: Sequence[int]):
+        """Yields the staging slot and pages of each chunk of `pages`."""
+        for i, start in enumerate(range(0, len(pages), self.chunk_pages)):
+            yield i % 2, pages[start : start + self.chunk_pages]
+
+    def close(self):
+        self._executor.shutdown(wait=False)
+
+
+class PageSender(_PageTransfer):
+    """Sends pages of a prefill host's pool."""
+
+    async def send(self, sock: socket.socket, request_id: str, pages: List[int]):
+        """Send the pages at indices `pages`, in order, to a `PageReceiver`.
+
+        The pages must hold the request's KV cache, i.e. the prefill that wrote
+        them must have been enqueued on the device, and must not be released
+        until this returns.
+        """
+        rid = request_id.encode()
+        header = _HEADER.pack(
+            MAGIC, VERSION, len(self._tables), len(pages), len(rid)
+        ) + rid
+        header += b"".join(_ROW_BYTES.pack(size) for size in self._row_bytes)
+        sends = [self._io(sock.sendall, header), None]
+        for slot, chunk in self._chunks(pages):
+            # The staging buffers of the slot may still be on the wire.
+            if sends[slot] is not None:
+                await sends[slot]
+            for table, staging in zip(self._tables, self._staging[slot]):
+                for row, page in enumerate(chunk):
+                    staging.view(row).copy_from(table.view(page))
+            await self._synchronize()
+            sends[slot] = self._io(self._send_rows, sock, slot, len(chunk))
+        for pending in sends:
+            if pending is not None:
+                await pending
+
+    def _send_rows(self, sock: socket.socket, slot: int, count: int):
+        for staging, row_bytes in zip(self._staging[slot], self._row_bytes):
+            with staging.map(read=True) as m:
+                sock.sendall(memoryview(m)[: count * row_bytes])
+
+
+class PageReceiver(_PageTransfer):
+    """Receives pages into a decode host's pool."""
+
+    async def receive(self, sock: socket.socket) -> Tuple[str, List[PageInfo]]:
+        """Receive the pages of a request sent by a `PageSender`.
+
+        Returns the request id and the pages holding the received contents, in
+        the order sent. The pages are acquired from the pool and are owned by
+        the caller. Raises PageTransferError if the pool does not have enough
+        free pages or does not match the sender's.
+        """
+        magic, version, table_count, page_count, rid_length = _HEADER.unpack(
+            await self._io(_recv_exactly, sock, _HEADER.size)
+        )
+        if magic != MAGIC or version != VERSION:
+            raise PageTransferError(
+                f"Not a page transfer (magic {magic!r}, version {version})"
+            )
+        rest = await self._io(
+            _recv_exactly, sock, rid_length + table_count * _ROW_BYTES.size
+        )
+        request_id = rest[:rid_length].decode()
+        row_bytes = [size for (size,) in _ROW_BYTES.iter_unpack(rest[rid_length:])]
+        if row_bytes != self._row_bytes:
+            raise PageTransferError(
+                f"Pages of {request_id} have rows of {row_bytes} bytes, but the "
+                f"pool has rows of {self._row_bytes} bytes"
+            )
+
+        pages = self.page_pool.acquire_free_pages(page_count)
+        if pages is None:
+            raise PageTransferError(
+                f"No room for the {page_count} pages of {request_id}"
+            )
+        try:
+            await self._receive_pages(sock, [page.index for page in pages])
+        except BaseException:
+            self.page_pool.free_pages(pages)
+            raise
+        return request_id, pages
+
+    async def _receive_pages(self, sock: socket.socket, pages: List[int]):
+        copying = [False, False]
+        for slot, chunk in self._chunks(pages):
+            # The device may still be copying out of the staging buffers.
+            if copying[slot]:
+                await self._synchronize()
+                copying = [False, False]
+            await self._io(self._recv_rows, sock, slot, len(chunk))
+            for table, staging in zip(self._tables, self._staging[slot]):
+                for row, page in enumerate(chunk):
+                    table.view(page).copy_from(staging.view(row))
+            copying[slot] = True
+        await self._synchronize()
+
+    def _recv_rows(self, sock: socket.socket, slot: int, count: int):
+        for staging, row_bytes in zip(self._staging[slot], self._row_bytes):
+            with staging.map(discard=True) as m:
+                _recv_into(sock, memoryview(m)[: count * row_bytes])
+
+
+class PageTransferListener:
+    """Listening socket of a decode host for page transfers."""
+
+    def __init__(self, host: str, port: int, *, backlog: int = 64):
+        self._sock = socket.create_server((host, port), backlog=backlog)
+        self._executor = ThreadPoolExecutor(
+            max_workers=1, thread_name_prefix="page-transfer-accept"
+        )
+
+    @property
+    def port(self) -> int:
+        return self._sock.getsockname()[1]
+
+    async def accept(self) -> socket.socket:
+        """Wait for the next connection of a prefill host."""
+        sock, address = await asyncio.wrap_future(
+            self._executor.submit(self._sock.accept)
+        )
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        logger.debug("Accepted page transfer connection from %s", address)
+        return sock
+
+    def close(self):
+        self._sock.close()
+        self._executor.shutdown(wait=False)
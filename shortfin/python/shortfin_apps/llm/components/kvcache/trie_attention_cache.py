@@ -204,6 +204,20 @@ class TriePagedAttentionCache(BasePagedAttentionCache):
                 pool=self.page_pool,
             )
 
+    def cached_prefix_length(self, tokens: List[int]) -> int:
+        with self._lock:
+            cur = self.root
+            num_tokens = 0
+            for i in range(0, len(tokens), self.tokens_per_page):
+                token_block = tuple(tokens[i : i + self.tokens_per_page])
+                if len(token_block) < self.tokens_per_page:
+                    break
+                cur = cur.children.get(token_block)
+                if cur is None:
+                    break
+                num_tokens += self.tokens_per_page
+            return num_tokens
+
     def evict_pages(self, max_pages: int) -> int:
         """Evict up to max_pages pages using LRU strategy.
 
@@ -295,7 +309,7 @@ class TriePagedAttentionCache(BasePagedAttentionCache):
             if new_pages is None and evict:
                 # Try eviction
                 number_evicted_pages = self.evict_pages(
-                    n_empty_pages - len(self.page_pool.available_pages)
+                    n_empty_pages - self.page_pool.available_page_count()
                 )
                 new_pages = self.page_pool.acquire_free_pages(n_empty_pages)
 
@@ -21,6 +21,7 @@ from contextlib import asynccontextmanager
 from .config_struct import ModelParams, ServerParams
 from .decode_config import DecodeConfig
 from .manager import LlmSystemManager
+from .prefix_router import PrefixRouter
 from .service import LlmGenerateService
 from .tokenizer import Tokenizer
 from typing import TYPE_CHECKING
@@ -108,10 +109,15 @@ class ShortfinLlmLifecycleManager:
             server_params=server_params,
             program_isolation=server_params.program_isolation,
         )
-        service.load_inference_module(args.vmfb)
+        for vmfb in args.vmfb:
+            service.load_inference_module(vmfb)
         service.load_inference_parameters(*args.parameters, parameter_scope="model")
         self.sysman = sysman
         self.services = {"default": service}
+        # Routes requests across the services, which are replicas of the model.
+        self.router = PrefixRouter(
+            [service.page_cache for service in self.services.values()]
+        )
 
     def __enter__(self):
         self.sysman.start()
@@ -144,9 +150,12 @@ class ShortfinLlmLifecycleManager:
             )
 
         prefix_sharing_algorithm = server_params.prefix_sharing_algorithm
-        if prefix_sharing_algorithm == "trie" and not has_prefill_position:
+        if (
+            prefix_sharing_algorithm in ("trie", "native_trie")
+            and not has_prefill_position
+        ):
             logger.warning(
-                "Prefix sharing algorithm 'trie' is enabled, but the model was not exported with `--has-prefill-position`.\n"
+                f"Prefix sharing algorithm '{prefix_sharing_algorithm}' is enabled, but the model was not exported with `--has-prefill-position`.\n"
                 "Computational benefits of `trie` prefix sharing will not be realized.\n"
                 "Export from `sharktank` with `--has-prefill-position` for full trie prefix sharing benefits."
             )
@@ -166,4 +175,5 @@ class ShortfinLlmLifecycleManager:
         """
         with self:
             app.state.services = self.services
+            app.state.router = self.router
             yield
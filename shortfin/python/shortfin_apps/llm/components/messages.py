@@ -55,6 +55,11 @@ class LlmInferenceExecRequest(InferenceExecRequest):
         self.result_logits: sfnp.device_array | None = None
         self.result_indices: sfnp.device_array | None = None
 
+        # Decode steps run by one invocation. A multi-step decode returns the
+        # tokens selected on device, one per step, rather than logits.
+        self.decode_steps: int = 1
+        self.result_tokens: list[int] | None = None
+
         # Current running score of the decode req
         self.score: float = 0.0
 
@@ -74,6 +79,7 @@ class LlmInferenceExecRequest(InferenceExecRequest):
         self.done = sf.VoidFuture()
         self.return_host_array = True
         self.result_logits = None
+        self.result_tokens = None
 
     def cache_page_indices(self, max_len: int) -> list[int]:
         if self.page_ids:
@@ -0,0 +1,57 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""Latency and throughput metrics of the LLM components.
+
+Metrics live in the native registry of the process, which records them
+lock-free, and are exported in the Prometheus text format by the server's
+`/metrics` route. Latencies are recorded in microseconds and exported in
+seconds.
+"""
+
+import time
+
+from _shortfin import lib as _sfl
+
+_MICROSECONDS = 1e-6
+
+
+def _latency(name: str, help: str, labels: str = ""):
+    return _sfl.metrics.histogram(name, help, labels, unit=_MICROSECONDS)
+
+
+REQUESTS = _sfl.metrics.counter(
+    "shortfin_llm_requests_total", "Generation requests decoded."
+)
+GENERATED_TOKENS = _sfl.metrics.counter(
+    "shortfin_llm_generated_tokens_total", "Tokens selected by decoders."
+)
+TIME_TO_FIRST_TOKEN = _latency(
+    "shortfin_llm_time_to_first_token_seconds",
+    "Time from a tokenized request reaching its decoder to its first token.",
+)
+INTER_TOKEN_LATENCY = _latency(
+    "shortfin_llm_inter_token_latency_seconds",
+    "Time between the tokens of a request.",
+)
+
+
+def queue_time(lane: str):
+    """Histogram of the time that requests wait in the batcher `lane`."""
+    return _latency(
+        "shortfin_llm_queue_seconds",
+        "Time from a request reaching a batcher to it being batched.",
+        f'lane="{lane}"',
+    )
+
+
+def now() -> float:
+    """Time in seconds for measuring latencies."""
+    return time.monotonic()
+
+
+def export_prometheus() -> str:
+    return _sfl.metrics.export_prometheus()
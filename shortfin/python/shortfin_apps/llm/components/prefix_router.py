@@ -0,0 +1,86 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""Prefix-aware routing of requests across replicas with their own KV cache.
+
+Fibers of one service share its page cache, so that which fiber runs a
+request does not change its prefix hits. Replicas of a model (i.e. services
+on distinct devices) each have their own, and a request prefilled on the
+replica already caching its prefix (a shared system prompt, or an earlier
+turn of a conversation) skips recomputing it.
+"""
+
+import logging
+
+from threading import Lock
+from typing import List, Sequence
+
+from .kvcache.base_attention_cache import BasePagedAttentionCache
+
+logger = logging.getLogger(__name__)
+
+
+class PrefixRouter:
+    """Routes requests to the replica caching the longest prefix of their
+    tokens, among the replicas whose load is within `balance_threshold`
+    requests of the least loaded one. Ties go to the least loaded replica.
+
+    The threshold bounds the imbalance that prefix affinity may cause: with 0,
+    requests always go to a least loaded replica (preferring its cached
+    prefixes), and with a large threshold, always to the longest prefix.
+    """
+
+    def __init__(
+        self,
+        page_caches: Sequence[BasePagedAttentionCache],
+        balance_threshold: int = 4,
+    ):
+        if not page_caches:
+            raise ValueError("PrefixRouter requires at least one replica")
+        if balance_threshold < 0:
+            raise ValueError(
+                f"balance_threshold must be >= 0 (got {balance_threshold})"
+            )
+        self._page_caches = list(page_caches)
+        self._balance_threshold = balance_threshold
+        self._loads = [0] * len(self._page_caches)
+        self._lock = Lock()
+
+    @property
+    def loads(self) -> List[int]:
+        """Requests routed to each replica and not yet released."""
+        with self._lock:
+            return list(self._loads)
+
+    def route(self, tokens: List[int]) -> int:
+        """Returns the index of the replica to run `tokens` on, counting the
+        request towards its load until `release`."""
+        with self._lock:
+            max_load = min(self._loads) + self._balance_threshold
+            best = None
+            best_key = None
+            for index, load in enumerate(self._loads):
+                if load > max_load:
+                    continue
+                cached = self._page_caches[index].cached_prefix_length(tokens)
+                key = (cached, -load)
+                if best_key is None or key > best_key:
+                    best, best_key = index, key
+            self._loads[best] += 1
+            logger.debug(
+                "Routed %d tokens to replica %d (%d cached)",
+                len(tokens),
+                best,
+                best_key[0],
+            )
+            return best
+
+    def release(self, index: int):
+        """Notes that a request routed to replica `index` completed."""
+        with self._lock:
+            if self._loads[index] <= 0:
+                raise ValueError(f"No request routed to replica {index}")
+            self._loads[index] -= 1
@@ -9,6 +9,7 @@ import itertools
 import logging
 from typing import Dict, List
 import shortfin as sf
+from _shortfin import lib as _sfl
 
 from .invocation import LlmTaskInput
 
@@ -157,6 +158,12 @@ class AbstractScheduler(ABC):
     def handle_completed(self, rid: str) -> bool:
         pass
 
+    @abstractmethod
+    def cancel(self, rid: str) -> List[LlmTaskInput]:
+        """Drop all state of a cancelled request, returning its tasks that were
+        not yet launched. Tasks already launched are not affected."""
+        pass
+
     def _group_jobs(
         self, rid_map: Dict[str, List[LlmTaskInput]], strobe
     ) -> WorkloadBuilder:
@@ -321,6 +328,12 @@ class Scheduler(AbstractScheduler):
     def handle_completed(self, rid: str) -> bool:
         return True
 
+    def cancel(self, rid: str) -> List[LlmTaskInput]:
+        dropped = [task for task in self._ready if task.rid == rid]
+        self._ready = [task for task in self._ready if task.rid != rid]
+        self._remove(rid=rid)
+        return dropped
+
 
 class ChunkScheduler(AbstractScheduler):
     def __init__(self, *, ideal_batch_size):
@@ -371,10 +384,90 @@ class ChunkScheduler(AbstractScheduler):
         batcher.submit(UpdateWorkload(count=count, rid=rid))
 
     def handle_completed(self, rid: str) -> bool:
-        if len(self._pending[rid]) == 0:
-            del self._pending[rid]
+        # A cancelled request has no pending chunks left.
+        if len(self._pending.get(rid, [])) == 0:
+            self._pending.pop(rid, None)
             return True
 
         next_chunk = self._pending[rid].pop(0)
         self._ready.append(next_chunk)
         return False
+
+    def cancel(self, rid: str) -> List[LlmTaskInput]:
+        dropped = [task for task in self._ready if task.rid == rid]
+        self._ready = [task for task in self._ready if task.rid != rid]
+        dropped.extend(self._pending.pop(rid, []))
+        self._remove(rid=rid)
+        return dropped
+
+
+class NativeScheduler(AbstractScheduler):
+    """Scheduler whose batch formation runs in the native `llm.BatchScheduler`.
+
+    Forms the same batches as `Scheduler` (or `ChunkScheduler` if `chunked`)
+    with the tasks mapped to integer jobs, so that scheduling a step costs no
+    Python work per pending task. Batches are additionally limited to
+    `token_budget` input tokens, if positive.
+    """
+
+    def __init__(self, *, ideal_batch_size, token_budget: int = 0, chunked=False):
+        super().__init__(ideal_batch_size=ideal_batch_size)
+        self._native = _sfl.llm.BatchScheduler(
+            ideal_batch_size, token_budget=token_budget, sequential_jobs=chunked
+        )
+        self._tasks: Dict[int, LlmTaskInput] = {}
+        self._next_job = 0
+        # Native ids of the requests that the native scheduler keeps state of.
+        self._rids: Dict[str, int] = {}
+        self._next_rid = 0
+
+    def _native_rid(self, rid: str) -> int:
+        native_rid = self._rids.get(rid)
+        if native_rid is None:
+            native_rid = self._next_rid
+            self._next_rid += 1
+            self._rids[rid] = native_rid
+        return native_rid
+
+    def _release_rid(self, rid: str):
+        native_rid = self._rids.get(rid)
+        if native_rid is not None and not self._native.has_request(native_rid):
+            del self._rids[rid]
+
+    def schedule_job(self, task: LlmTaskInput):
+        job = self._next_job
+        self._next_job += 1
+        self._tasks[job] = task
+        self._native.submit(job, self._native_rid(task.rid), len(task.input_tokens))
+
+    def should_execute(self, strobe) -> List[List[LlmTaskInput]]:
+        tasks = self._tasks
+        return [
+            [tasks.pop(job) for job in batch]
+            for batch in self._native.schedule(strobe)
+        ]
+
+    def handle_scheduler(self, msg) -> bool:
+        if isinstance(msg, UpdateWorkload):
+            self._native.reserve(self._native_rid(msg.rid), msg.count)
+            self._release_rid(msg.rid)
+            return True
+
+        return False
+
+    def reserve_workload(self, *, batcher, count, rid):
+        batcher.submit(UpdateWorkload(count=count, rid=rid))
+
+    def handle_completed(self, rid: str) -> bool:
+        native_rid = self._rids.get(rid)
+        if native_rid is None:
+            return True
+        done = self._native.complete(native_rid)
+        self._release_rid(rid)
+        return done
+
+    def cancel(self, rid: str) -> List[LlmTaskInput]:
+        native_rid = self._rids.pop(rid, None)
+        if native_rid is None:
+            return []
+        return [self._tasks.pop(job) for job in self._native.cancel(native_rid)]
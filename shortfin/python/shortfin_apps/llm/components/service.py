@@ -4,6 +4,7 @@
 # See https://llvm.org/LICENSE.txt for license information.
 # SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+import dataclasses
 import logging
 import shortfin as sf
 
@@ -15,6 +16,8 @@ from .kvcache.base_attention_cache import (
     BasePagedAttentionCache,
 )
 from .kvcache.trie_attention_cache import TriePagedAttentionCache
+from .kvcache.native_trie_attention_cache import NativeTriePagedAttentionCache
+from .kvcache.host_page_tier import HostPageTier
 from .kvcache.page_pool import PagePoolConfig, PagePool
 from .manager import LlmSystemManager
 from .tokenizer import Tokenizer
@@ -32,6 +35,9 @@ class LlmGenerateService(GenerateService):
     inference_program: sf.Program
     prefill_functions: dict[int, sf.ProgramFunction]
     decode_functions: dict[int, sf.ProgramFunction]
+    sample_functions: dict[int, sf.ProgramFunction] | None
+    decode_steps_functions: dict[int, sf.ProgramFunction] | None
+    prefill_seq_len_functions: dict[tuple[int, int], sf.ProgramFunction] | None
 
     def __init__(
         self,
@@ -49,6 +55,8 @@ class LlmGenerateService(GenerateService):
 
         self.model_params = model_params
         self.server_params = server_params
+        self._initialize_sampling_device()
+        self._initialize_decode_steps()
 
         self.set_isolation(program_isolation)
         self._initialize_worker_and_fiber()
@@ -59,6 +67,47 @@ class LlmGenerateService(GenerateService):
             self.sysman, self.queue_manager.get_max_queue_size(), resizable=True
         )
 
+    def _initialize_sampling_device(self):
+        """Validates the sampling device. Device sampling runs the `sample_bs{N}`
+        functions of the module after prefill/decode, which then behave as if
+        exported with their `top_k`."""
+        self._device_sampling = False
+        sampling_device = self.server_params.sampling_device
+        if sampling_device == "host":
+            return
+        if sampling_device != "device":
+            raise ValueError(
+                f"Unknown sampling_device {sampling_device}. Currently only "
+                "supporting 'host' and 'device'."
+            )
+        if self.model_params.top_k is not None:
+            logger.info(
+                "Model exported with top_k=%d already selects on device",
+                self.model_params.top_k,
+            )
+            return
+        if self.model_params.sampling_top_k is None:
+            raise ValueError(
+                "sampling_device 'device' requires a model exported with "
+                "`top_k` or `sampling_top_k`"
+            )
+        self._device_sampling = True
+        self.model_params = dataclasses.replace(
+            self.model_params, top_k=self.model_params.sampling_top_k
+        )
+
+    def _initialize_decode_steps(self):
+        """Validates multi-step decode. `decode_steps` is the number of tokens
+        that a greedy request decodes per invocation, 1 unless multi-step."""
+        self.decode_steps = 1
+        if not self.server_params.multi_step_decode:
+            return
+        if self.model_params.decode_steps is None:
+            raise ValueError(
+                "multi_step_decode requires a model exported with `decode_steps`"
+            )
+        self.decode_steps = self.model_params.decode_steps
+
     def _initialize_worker_and_fiber(self):
         self.main_worker = self.sysman.ls.create_worker(f"{self.name}-inference-main-0")
         self.main_fiber = self.sysman.ls.create_fiber(self.main_worker)
@@ -93,6 +142,10 @@ class LlmGenerateService(GenerateService):
             dtype=self.model_params.paged_kv_cache.kv_cache_dtype,
             alloc_page_count=self.model_params.paged_kv_cache.device_block_count,
             paged_kv_block_size_elements_per_device=paged_kv_block_size_elements_per_device,
+            scale_dtype=self.model_params.paged_kv_cache.kv_cache_scale_dtype,
+            scales_per_page_per_device=self.model_params.paged_kv_scales_per_page(
+                len(self.devices)
+            ),
         )
         page_pool = PagePool(devices=self.devices, config=page_pool_config)
 
@@ -101,6 +154,18 @@ class LlmGenerateService(GenerateService):
                 page_pool=page_pool,
                 tokens_per_page=self.model_params.paged_kv_cache.block_seq_stride,
             )
+        elif self.server_params.prefix_sharing_algorithm == "native_trie":
+            host_tier = None
+            if self.server_params.prefix_cache_host_pages > 0:
+                host_tier = HostPageTier(
+                    page_pool, self.server_params.prefix_cache_host_pages
+                )
+            self.page_cache = NativeTriePagedAttentionCache(
+                page_pool=page_pool,
+                tokens_per_page=self.model_params.paged_kv_cache.block_seq_stride,
+                eviction_policy=self.server_params.prefix_cache_eviction,
+                host_tier=host_tier,
+            )
         elif self.server_params.prefix_sharing_algorithm == "none":
             self.page_cache = BasePagedAttentionCache(
                 page_pool=page_pool,
@@ -108,7 +173,7 @@ class LlmGenerateService(GenerateService):
             )
         else:
             raise ValueError(
-                f"Unknown prefix_sharing_algorithm {self.server_params.prefix_sharing_algorithm}. Currently only supporting 'trie' and 'none'."
+                f"Unknown prefix_sharing_algorithm {self.server_params.prefix_sharing_algorithm}. Currently only supporting 'trie', 'native_trie' and 'none'."
             )
 
     def start(self):
@@ -124,6 +189,11 @@ class LlmGenerateService(GenerateService):
             self.decode_functions,
             self.prog_isolation,
             self.server_params.chunk_block_size,
+            native_scheduler=self.server_params.native_scheduler,
+            prefill_token_budget=self.server_params.prefill_token_budget,
+            sample_functions=self.sample_functions,
+            decode_steps_functions=self.decode_steps_functions,
+            prefill_seq_len_functions=self.prefill_seq_len_functions,
         )
         self.unified_batcher = BatchingFacade.build_batcher(
             batch_cfg, self.page_cache, self.prefill_fiber, self.decode_fiber
@@ -141,12 +211,40 @@ class LlmGenerateService(GenerateService):
             self.prefill_functions[bs] = self.inference_program[
                 f"{self.model_params.module_name}.prefill_bs{bs}"
             ]
+        # Resolve prefill entrypoints of static sequence lengths.
+        self.prefill_seq_len_functions = None
+        if self.model_params.prefill_seq_lens:
+            self.prefill_seq_len_functions = {}
+            for bs in self.model_params.prefill_batch_sizes:
+                for sl in self.model_params.prefill_seq_lens:
+                    self.prefill_seq_len_functions[(bs, sl)] = self.inference_program[
+                        f"{self.model_params.module_name}.prefill_bs{bs}_sl{sl}"
+                    ]
         # Resolve decode entrypoints.
         self.decode_functions = {}
         for bs in self.model_params.decode_batch_sizes:
             self.decode_functions[bs] = self.inference_program[
                 f"{self.model_params.module_name}.decode_bs{bs}"
             ]
+        # Resolve device sampling entrypoints for the batch sizes of both.
+        self.sample_functions = None
+        if self._device_sampling:
+            self.sample_functions = {}
+            batch_sizes = set(self.model_params.prefill_batch_sizes) | set(
+                self.model_params.decode_batch_sizes
+            )
+            for bs in sorted(batch_sizes):
+                self.sample_functions[bs] = self.inference_program[
+                    f"{self.model_params.module_name}.sample_bs{bs}"
+                ]
+        # Resolve multi-step decode entrypoints.
+        self.decode_steps_functions = None
+        if self.decode_steps > 1:
+            self.decode_steps_functions = {}
+            for bs in self.model_params.decode_batch_sizes:
+                self.decode_steps_functions[bs] = self.inference_program[
+                    f"{self.model_params.module_name}.decode_steps_bs{bs}"
+                ]
 
     def __repr__(self):
         return (
@@ -0,0 +1,435 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""Open-loop load generator for the LLM server.
+
+Unlike `benchmark_client.py`, which sends closed batches of identical
+requests, requests arrive as a Poisson process at a given offered load
+(requests per second) regardless of how fast the server answers them, with
+prompt and output lengths drawn from configurable distributions and a
+configurable share of the prompts drawn from common prefixes (to exercise the
+prefix cache). Each offered load is reported as percentiles of the time to
+first token (TTFT), inter-token latency (ITL), time per output token (TPOT)
+and end-to-end latency, the achieved throughput and the fraction of requests
+meeting the latency SLOs (goodput):
+
+    python -m shortfin_apps.llm.load_generator --endpoint http://localhost:8080 \
+        --request-rates 1 2 4 8 --num-requests 200 \
+        --input-lengths normal:1024:256 --output-lengths uniform:32:128 \
+        --prefix-ratio 0.5 --num-prefixes 4 --slo-ttft 1.0 --slo-tpot 0.05
+
+Prompts are sent as token ids, so that their lengths are exact.
+"""
+
+import argparse
+import asyncio
+import csv
+import json
+import math
+import os
+import random
+import time
+
+from dataclasses import asdict, dataclass, field
+from typing import Any, Dict, List, Optional
+
+import numpy as np
+
+PERCENTILES = (50, 90, 99)
+
+
+@dataclass
+class LengthDistribution:
+    """Distribution of token lengths, parsed from `kind:args`:
+
+    * `fixed:N`
+    * `uniform:MIN:MAX` (inclusive)
+    * `normal:MEAN:STDDEV`
+
+    Samples are clamped to at least 1.
+    """
+
+    kind: str
+    args: List[float]
+
+    @staticmethod
+    def parse(spec: str) -> "LengthDistribution":
+        kind, *args = spec.split(":")
+        arity = {"fixed": 1, "uniform": 2, "normal": 2}
+        if kind not in arity or len(args) != arity[kind]:
+            raise ValueError(
+                f"Invalid length distribution '{spec}': expected fixed:N, "
+                "uniform:MIN:MAX or normal:MEAN:STDDEV"
+            )
+        return LengthDistribution(kind, [float(arg) for arg in args])
+
+    def sample(self, rng: random.Random) -> int:
+        if self.kind == "fixed":
+            value = self.args[0]
+        elif self.kind == "uniform":
+            value = rng.randint(int(self.args[0]), int(self.args[1]))
+        else:
+            value = rng.gauss(self.args[0], self.args[1])
+        return max(1, int(round(value)))
+
+
+@dataclass
+class WorkloadRequest:
+    # Seconds from the start of the run at which the request is sent.
+    arrival_time: float
+    input_ids: List[int]
+    max_completion_tokens: int
+    # Index of the shared prefix the prompt starts with, or None.
+    prefix_index: Optional[int] = None
+
+
+def generate_workload(
+    num_requests: int,
+    request_rate: float,
+    input_lengths: LengthDistribution,
+    output_lengths: LengthDistribution,
+    prefix_ratio: float = 0.0,
+    num_prefixes: int = 1,
+    vocab_size: int = 32000,
+    seed: int = 0,
+) -> List[WorkloadRequest]:
+    """Generates the requests of a run, in order of arrival.
+
+    Inter-arrival times are exponential with a mean of `1 / request_rate`
+    (all requests arrive at once for an infinite rate). The first
+    `prefix_ratio` of the tokens of each prompt are those of one of
+    `num_prefixes` shared prefixes, which are as long as the longest prompt
+    needs. The other tokens are random.
+    """
+    if not 0.0 <= prefix_ratio <= 1.0:
+        raise ValueError(f"Prefix ratio {prefix_ratio} is not in [0, 1]")
+    if request_rate <= 0:
+        raise ValueError(f"Request rate {request_rate} is not positive")
+    rng = random.Random(seed)
+    # Token 0 is left out, as it is commonly a special token.
+    random_token = lambda: rng.randrange(1, vocab_size)
+
+    lengths = [
+        (input_lengths.sample(rng), output_lengths.sample(rng))
+        for _ in range(num_requests)
+    ]
+    max_prefix = max(
+        (int(prefix_ratio * input_length) for input_length, _ in lengths), default=0
+    )
+    prefixes = [
+        [random_token() for _ in range(max_prefix)] for _ in range(num_prefixes)
+    ]
+
+    requests = []
+    arrival_time = 0.0
+    for input_length, output_length in lengths:
+        prefix_length = int(prefix_ratio * input_length)
+        prefix_index = rng.randrange(num_prefixes) if prefix_length else None
+        input_ids = prefixes[prefix_index][:prefix_length] if prefix_length else []
+        input_ids += [random_token() for _ in range(input_length - prefix_length)]
+        requests.append(
+            WorkloadRequest(arrival_time, input_ids, output_length, prefix_index)
+        )
+        if not math.isinf(request_rate):
+            arrival_time += rng.expovariate(request_rate)
+    return requests
+
+
+@dataclass
+class RequestResult:
+    # Times in seconds from the start of the run.
+    arrival_time: float
+    input_length: int
+    end_time: float = 0.0
+    token_times: List[float] = field(default_factory=list)
+    error: Optional[str] = None
+
+    @property
+    def ttft(self) -> float:
+        return self.token_times[0] - self.arrival_time
+
+    @property
+    def latency(self) -> float:
+        return self.end_time - self.arrival_time
+
+    @property
+    def inter_token_latencies(self) -> List[float]:
+        return np.diff(self.token_times).tolist()
+
+    @property
+    def tpot(self) -> Optional[float]:
+        """Mean time per output token after the first, if there are two."""
+        if len(self.token_times) < 2:
+            return None
+        return (self.token_times[-1] - self.token_times[0]) / (
+            len(self.token_times) - 1
+        )
+
+
+def percentiles(values: List[float]) -> Dict[str, float]:
+    if not values:
+        return {f"p{p}": float("nan") for p in PERCENTILES} | {"mean": float("nan")}
+    result = {f"p{p}": float(np.percentile(values, p)) for p in PERCENTILES}
+    result["mean"] = float(np.mean(values))
+    return result
+
+
+def summarize_run(
+    results: List[RequestResult],
+    request_rate: float,
+    duration: float,
+    slo_ttft: Optional[float] = None,
+    slo_tpot: Optional[float] = None,
+) -> Dict[str, Any]:
+    """Summarizes the results of a run of `duration` seconds.
+
+    Requests meet the SLOs if they succeeded and their TTFT and TPOT are
+    within `slo_ttft` and `slo_tpot` (when given): goodput is the rate of
+    such requests.
+    """
+    completed = [r for r in results if r.error is None and r.token_times]
+    tpots = [r.tpot for r in completed if r.tpot is not None]
+    itls = [itl for r in completed for itl in r.inter_token_latencies]
+
+    def meets_slo(result: RequestResult) -> bool:
+        if slo_ttft is not None and result.ttft > slo_ttft:
+            return False
+        tpot = result.tpot
+        return slo_tpot is None or tpot is None or tpot <= slo_tpot
+
+    num_good = sum(1 for r in completed if meets_slo(r))
+    num_output_tokens = sum(len(r.token_times) for r in completed)
+    summary = {
+        "request_rate": request_rate,
+        "num_requests": len(results),
+        "num_completed": len(completed),
+        "num_errors": sum(1 for r in results if r.error is not None),
+        "duration": duration,
+        "request_throughput": len(completed) / duration if duration else 0.0,
+        "input_token_throughput": (
+            sum(r.input_length for r in completed) / duration if duration else 0.0
+        ),
+        "output_token_throughput": num_output_tokens / duration if duration else 0.0,
+        "goodput": num_good / duration if duration else 0.0,
+        "slo_attainment": num_good / len(results) if results else 0.0,
+    }
+    for name, values in (
+        ("ttft", [r.ttft for r in completed]),
+        ("itl", itls),
+        ("tpot", tpots),
+        ("latency", [r.latency for r in completed]),
+    ):
+        for stat, value in percentiles(values).items():
+            summary[f"{name}_{stat}"] = value
+    return summary
+
+
+async def send_request(
+    session,
+    endpoint: str,
+    request: WorkloadRequest,
+    sampling_params: Dict[str, Any],
+    start_time: float,
+) -> RequestResult:
+    """Sends `request` at its arrival time as a streaming generation request,
+    recording the time of each streamed token."""
+    delay = start_time + request.arrival_time - time.perf_counter()
+    await asyncio.sleep(max(0.0, delay))
+    result = RequestResult(request.arrival_time, len(request.input_ids))
+    data = {
+        "input_ids": request.input_ids,
+        "sampling_params": {
+            **sampling_params,
+            "max_completion_tokens": request.max_completion_tokens,
+        },
+        "stream": True,
+    }
+    try:
+        async with session.post(f"{endpoint}/generate", json=data) as response:
+            if response.status != 200:
+                result.error = f"HTTP {response.status}: {await response.text()}"
+                return result
+            async for line in response.content:
+                if line.startswith(b"data"):
+                    result.token_times.append(time.perf_counter() - start_time)
+    except Exception as e:
+        result.error = str(e)
+    result.end_time = time.perf_counter() - start_time
+    return result
+
+
+async def run_load(
+    endpoint: str,
+    requests: List[WorkloadRequest],
+    sampling_params: Dict[str, Any],
+    timeout: float = 3600,
+) -> tuple[List[RequestResult], float]:
+    """Sends `requests` open-loop, returning their results and the duration
+    of the run."""
+    import aiohttp
+
+    connector = aiohttp.TCPConnector(limit=0)
+    client_timeout = aiohttp.ClientTimeout(total=timeout)
+    async with aiohttp.ClientSession(
+        connector=connector, timeout=client_timeout
+    ) as session:
+        start_time = time.perf_counter()
+        results = await asyncio.gather(
+            *(
+                send_request(session, endpoint, request, sampling_params, start_time)
+                for request in requests
+            )
+        )
+        duration = time.perf_counter() - start_time
+    return results, duration
+
+
+def print_summary(summary: Dict[str, Any]):
+    print(
+        f"\nOffered load: {summary['request_rate']} req/s, "
+        f"{summary['num_completed']}/{summary['num_requests']} completed "
+        f"({summary['num_errors']} errors) in {summary['duration']:.2f}s"
+    )
+    print(
+        f"Throughput: {summary['request_throughput']:.2f} req/s, "
+        f"{summary['output_token_throughput']:.1f} output tok/s, "
+        f"goodput {summary['goodput']:.2f} req/s "
+        f"(SLO attainment {100 * summary['slo_attainment']:.1f}%)"
+    )
+    for name, label in (
+        ("ttft", "TTFT"),
+        ("itl", "ITL"),
+        ("tpot", "TPOT"),
+        ("latency", "E2E latency"),
+    ):
+        stats = ", ".join(
+            f"{stat} {1000 * summary[f'{name}_{stat}']:.1f}ms"
+            for stat in ["mean"] + [f"p{p}" for p in PERCENTILES]
+        )
+        print(f"{label}: {stats}")
+
+
+def write_results(results_dir: str, summaries: List[Dict[str, Any]], config: Dict):
+    os.makedirs(results_dir, exist_ok=True)
+    csv_filename = os.path.join(results_dir, "load_results.csv")
+    with open(csv_filename, "w", newline="") as csvfile:
+        writer = csv.DictWriter(csvfile, fieldnames=summaries[0].keys())
+        writer.writeheader()
+        writer.writerows(summaries)
+    json_filename = os.path.join(results_dir, "load_results.json")
+    with open(json_filename, "w") as f:
+        json.dump({"config": config, "results": summaries}, f, indent=2)
+    print(f"\nResults saved to {csv_filename} and {json_filename}")
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(
+        description="Open-loop load generator reporting latency percentiles "
+        "and SLO attainment versus offered load"
+    )
+    parser.add_argument(
+        "--endpoint",
+        type=str,
+        default="http://localhost:8080",
+        help="LLM server endpoint URL",
+    )
+    parser.add_argument(
+        "--request-rates",
+        type=float,
+        nargs="+",
+        default=[1.0],
+        help="Offered loads to sweep, in requests per second (inf sends all "
+        "requests at once)",
+    )
+    parser.add_argument(
+        "--num-requests",
+        type=int,
+        default=100,
+        help="Number of requests per offered load",
+    )
+    parser.add_argument(
+        "--input-lengths",
+        type=LengthDistribution.parse,
+        default=LengthDistribution.parse("fixed:1024"),
+        help="Distribution of prompt lengths (fixed:N, uniform:MIN:MAX or "
+        "normal:MEAN:STDDEV)",
+    )
+    parser.add_argument(
+        "--output-lengths",
+        type=LengthDistribution.parse,
+        default=LengthDistribution.parse("fixed:64"),
+        help="Distribution of max completion tokens, in the same format",
+    )
+    parser.add_argument(
+        "--prefix-ratio",
+        type=float,
+        default=0.0,
+        help="Share of each prompt taken from a shared prefix, in [0, 1]",
+    )
+    parser.add_argument(
+        "--num-prefixes",
+        type=int,
+        default=1,
+        help="Number of distinct shared prefixes",
+    )
+    parser.add_argument(
+        "--vocab-size",
+        type=int,
+        default=32000,
+        help="Prompt tokens are drawn from [1, vocab size)",
+    )
+    parser.add_argument("--seed", type=int, default=0, help="Workload seed")
+    parser.add_argument(
+        "--slo-ttft", type=float, help="TTFT SLO in seconds, for goodput"
+    )
+    parser.add_argument(
+        "--slo-tpot", type=float, help="TPOT SLO in seconds, for goodput"
+    )
+    parser.add_argument(
+        "--sampling-params",
+        type=json.loads,
+        default={},
+        help="Sampling params of all requests, as JSON "
+        '(i.e. \'{"temperature": 0.7}\')',
+    )
+    parser.add_argument(
+        "--results-dir",
+        type=str,
+        help="Directory to save the results to, as CSV and JSON",
+    )
+    args = parser.parse_args(argv)
+
+    summaries = []
+    for request_rate in args.request_rates:
+        requests = generate_workload(
+            num_requests=args.num_requests,
+            request_rate=request_rate,
+            input_lengths=args.input_lengths,
+            output_lengths=args.output_lengths,
+            prefix_ratio=args.prefix_ratio,
+            num_prefixes=args.num_prefixes,
+            vocab_size=args.vocab_size,
+            seed=args.seed,
+        )
+        results, duration = asyncio.run(
+            run_load(args.endpoint, requests, args.sampling_params)
+        )
+        summary = summarize_run(
+            results, request_rate, duration, args.slo_ttft, args.slo_tpot
+        )
+        print_summary(summary)
+        summaries.append(summary)
+
+    if args.results_dir:
+        config = vars(args) | {
+            "input_lengths": asdict(args.input_lengths),
+            "output_lengths": asdict(args.output_lengths),
+        }
+        write_results(args.results_dir, summaries, config)
+
+
+if __name__ == "__main__":
+    main()
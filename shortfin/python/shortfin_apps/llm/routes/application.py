@@ -6,9 +6,19 @@
 
 from fastapi import APIRouter, Response
 
+from ..components import metrics
+
 application_router = APIRouter()
 
 
 @application_router.get("/health")
 async def health() -> Response:
     return Response(status_code=200)
+
+
+@application_router.get("/metrics")
+async def prometheus_metrics() -> Response:
+    return Response(
+        content=metrics.export_prometheus(),
+        media_type="text/plain; version=0.0.4",
+    )
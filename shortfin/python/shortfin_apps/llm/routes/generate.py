@@ -20,14 +20,32 @@ generation_router = APIRouter()
 async def generate_request(gen_req: GenerateReqInput, request: Request):
     # app.state.services is populated by the ShortfinLlmLifecycleManager
     # see shortfin/python/shortfin_apps/llm/components/lifecycle.py
-    service: GenerateService = request.app.state.services["default"]
+    services = request.app.state.services
+    router = getattr(request.app.state, "router", None)
     gen_req.post_init()
+    replica = None
+    if router is not None and len(services) > 1 and gen_req.is_single:
+        replicas = list(services.values())
+        replica = router.route(_prompt_tokens(replicas[0], gen_req))
+        service: GenerateService = replicas[replica]
+    else:
+        service: GenerateService = services["default"]
     tracker = RequestStatusTracker(request)
     responder = FastAPIResponder(request)
     process = ClientGenerateBatchProcess(
         service, gen_req, responder, fiber=service.main_fiber
     ).launch()
     tracker.add_cancellable(process)
-    response = await responder.response
+    try:
+        response = await responder.response
+    finally:
+        if replica is not None:
+            router.release(replica)
     responder.close()
     return response
+
+
+def _prompt_tokens(service: GenerateService, gen_req: GenerateReqInput) -> list[int]:
+    if gen_req.input_ids is not None:
+        return gen_req.input_ids
+    return service.tokenizer.encode([gen_req.text])[0].ids
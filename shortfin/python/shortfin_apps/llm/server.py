@@ -73,8 +73,9 @@ def add_service_args(parser: argparse.ArgumentParser):
     parser.add_argument(
         "--vmfb",
         type=Path,
+        nargs="+",
         required=True,
-        help="Model VMFB to load",
+        help="Model VMFBs to load, e.g. modules of several compiled shape variants",
     )
     parser.add_argument(
         "--parameters",
@@ -98,9 +99,21 @@ def add_service_args(parser: argparse.ArgumentParser):
     parser.add_argument(
         "--prefix_sharing_algorithm",
         type=str,
-        choices=["none", "trie"],
+        choices=["none", "trie", "native_trie"],
         help="Algorithm to use for prefix sharing in KV cache",
     )
+    parser.add_argument(
+        "--prefix_cache_eviction",
+        type=str,
+        choices=["lru", "lfu"],
+        help="Eviction policy of the `native_trie` prefix cache",
+    )
+    parser.add_argument(
+        "--prefix_cache_host_pages",
+        type=int,
+        help="Number of pages of host memory to offload pages evicted from the "
+        "`native_trie` prefix cache to, instead of dropping them",
+    )
     parser.add_argument(
         "--num_beams",
         type=int,
@@ -119,6 +132,32 @@ def add_service_args(parser: argparse.ArgumentParser):
         default=None,
         help="*Block-aligned* Chunk size to use for chunked prefill.",
     )
+    parser.add_argument(
+        "--native_scheduler",
+        action="store_true",
+        default=None,
+        help="Form batches with the native batch scheduler.",
+    )
+    parser.add_argument(
+        "--prefill_token_budget",
+        type=int,
+        help="Maximum number of tokens of a prefill batch of the native batch "
+        "scheduler (0 for no limit).",
+    )
+    parser.add_argument(
+        "--sampling_device",
+        type=str,
+        choices=["host", "device"],
+        help="Select the top-k logits of each step on the host, or on the device "
+        "with the `sample_bs{N}` functions of the module.",
+    )
+    parser.add_argument(
+        "--multi_step_decode",
+        action="store_true",
+        default=None,
+        help="Run greedy decode several steps per invocation with the "
+        "`decode_steps_bs{N}` functions of the module.",
+    )
 
 
 def parse_args(argv):
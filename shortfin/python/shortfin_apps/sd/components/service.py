@@ -9,7 +9,6 @@ import logging
 import time
 import numpy as np
 import re
-from tqdm.auto import tqdm
 from pathlib import Path
 from PIL import Image
 from collections import namedtuple
@@ -17,6 +16,7 @@ import base64
 import gc
 
 import shortfin as sf
+from _shortfin import lib as _sfl
 import shortfin.array as sfnp
 
 from ...utils import GenerateService, BatcherProcess
@@ -55,6 +55,7 @@ class SDXLGenerateService(GenerateService):
         self.inference_parameters: dict[str, list[sf.BaseProgramParameters]] = {}
         self.inference_modules: dict[str, dict[int, sf.ProgramModule]] = {}
         self.inference_functions: dict[str, dict[str, sf.ProgramFunction]] = {}
+        self.denoise_loops: dict[int, dict[int, _sfl.diffusion.DenoiseLoop]] = {}
         self.inference_programs: dict[int, dict[str, sf.Program]] = {}
         self.trace_execution = trace_execution
         self.show_progress = show_progress
@@ -198,6 +199,10 @@ class SDXLGenerateService(GenerateService):
                         fn_dest[fn] = self.inference_programs[worker_idx][submodel][bs][
                             ".".join([module_name, fn])
                         ]
+            self.denoise_loops[worker_idx] = {
+                bs: create_denoise_loop(fns, self.model_params.use_scheduled_unet)
+                for bs, fns in self.inference_functions[worker_idx]["denoise"].items()
+            }
 
 
 ########################################################################################
@@ -389,73 +394,24 @@ class InferenceExecutorProcess(sf.Process):
 
     async def _denoise(self, device):
         req_bs = self.exec_request.batch_size
-        entrypoints = self.service.inference_functions[self.worker_index]["denoise"]
-        assert req_bs in list(entrypoints.keys())
-        for bs, fns in entrypoints.items():
-            if bs == req_bs:
-                break
-
+        loops = self.service.denoise_loops[self.worker_index]
+        assert req_bs in loops
+        loop = loops[req_bs]
         cb = self.exec_request.command_buffer
 
-        logger.debug(
-            "INVOKE %r",
-            fns["run_initialize"],
+        logger.debug("INVOKE denoise loop (%d steps)", self.exec_request.steps)
+        (cb.latents,) = await loop.run(
+            [
+                cb.sample,
+                cb.num_steps,
+                cb.prompt_embeds,
+                cb.text_embeds,
+                cb.guidance_scale,
+                cb.steps_arr,
+            ],
+            self.exec_request.steps,
+            fiber=self.fiber,
         )
-        (cb.latents, cb.time_ids, cb.timesteps, cb.sigmas,) = await fns[
-            "run_initialize"
-        ](cb.sample, cb.num_steps, fiber=self.fiber)
-
-        for i, t in tqdm(
-            enumerate(range(self.exec_request.steps)),
-            disable=(not self.service.show_progress),
-            desc=f"DENOISE (bs{req_bs})",
-        ):
-            start = time.time()
-            step = cb.steps_arr.view(i)
-            if self.service.model_params.use_scheduled_unet:
-                logger.debug(
-                    "INVOKE %r",
-                    fns["run_forward"],
-                )
-                (cb.latents,) = await fns["run_forward"](
-                    cb.latents,
-                    cb.prompt_embeds,
-                    cb.text_embeds,
-                    cb.time_ids,
-                    cb.guidance_scale,
-                    step,
-                    cb.timesteps,
-                    cb.sigmas,
-                    fiber=self.fiber,
-                )
-            else:
-                logger.debug(
-                    "INVOKE %r",
-                    fns["run_scale"],
-                )
-                (cb.latent_model_input, cb.t, cb.sigma, cb.next_sigma,) = await fns[
-                    "run_scale"
-                ](cb.latents, step, cb.timesteps, cb.sigmas, fiber=self.fiber)
-                logger.debug(
-                    "INVOKE %r",
-                    fns["main"],
-                )
-                (cb.noise_pred,) = await fns["main"](
-                    cb.latent_model_input,
-                    cb.t,
-                    cb.prompt_embeds,
-                    cb.text_embeds,
-                    cb.time_ids,
-                    cb.guidance_scale,
-                    fiber=self.fiber,
-                )
-                logger.debug(
-                    "INVOKE %r",
-                    fns["run_step"],
-                )
-                (cb.latents,) = await fns["run_step"](
-                    cb.noise_pred, cb.latents, cb.sigma, cb.next_sigma, fiber=self.fiber
-                )
         return
 
     async def _decode(self, device):
@@ -534,6 +490,68 @@ def check_host_array(host_array):
     return
 
 
+def create_denoise_loop(fns, use_scheduled_unet: bool):
+    """Creates the native step loop over the denoise functions of a batch size.
+
+    The loop runs run_initialize, whose results are the initial latents,
+    time_ids, timesteps and sigmas, then each step on the device. Its inputs
+    are, in order: sample, num_steps, prompt_embeds, text_embeds,
+    guidance_scale and steps_arr.
+    """
+    Arg = _sfl.diffusion.DenoiseArg
+    Stage = _sfl.diffusion.DenoiseStage
+    prompt_embeds, text_embeds = Arg.input(2), Arg.input(3)
+    guidance_scale, step = Arg.input(4), Arg.step_input(5)
+    time_ids, timesteps, sigmas = (Arg.init_result(i) for i in range(1, 4))
+    if use_scheduled_unet:
+        stages = [
+            Stage(
+                fns["run_forward"],
+                [
+                    Arg.latents(),
+                    prompt_embeds,
+                    text_embeds,
+                    time_ids,
+                    guidance_scale,
+                    step,
+                    timesteps,
+                    sigmas,
+                ],
+            )
+        ]
+    else:
+        # run_scale returns latent_model_input, t, sigma and next_sigma.
+        stages = [
+            Stage(fns["run_scale"], [Arg.latents(), step, timesteps, sigmas]),
+            Stage(
+                fns["main"],
+                [
+                    Arg.stage_result(0, 0),
+                    Arg.stage_result(0, 1),
+                    prompt_embeds,
+                    text_embeds,
+                    time_ids,
+                    guidance_scale,
+                ],
+            ),
+            Stage(
+                fns["run_step"],
+                [
+                    Arg.stage_result(1, 0),
+                    Arg.latents(),
+                    Arg.stage_result(0, 2),
+                    Arg.stage_result(0, 3),
+                ],
+            ),
+        ]
+    return _sfl.diffusion.DenoiseLoop(
+        stages,
+        latents=Arg.init_result(0),
+        initialize=fns["run_initialize"],
+        initialize_args=[Arg.input(0), Arg.input(1)],
+    )
+
+
 def initialize_command_buffer(fiber, model_params: ModelParams, bs: int = 1):
     device = fiber.device(0)
     h = model_params.dims[0][0]
@@ -0,0 +1,323 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""Elementwise device ops on the latents and images of diffusion pipelines.
+
+Guidance combines, scheduler updates, dtype conversions and the final image
+conversion are compiled on first use into small programs for the serving
+devices, so that the arrays they apply to never leave the device. A program
+is generated per op, dtypes and rank (dimensions are dynamic), compiled with
+the target flags of the models (i.e. `--iree-hal-target-device=hip` and
+`--iree-hip-target=gfx942`), and cached on disk and per device.
+"""
+
+import hashlib
+import logging
+import tempfile
+import threading
+from pathlib import Path
+from typing import Callable, Optional
+
+import shortfin as sf
+import shortfin.array as sfnp
+
+logger = logging.getLogger(__name__)
+
+MODULE_NAME = "sf_device_ops"
+
+_MLIR_TYPES = {
+    "float16": "f16",
+    "bfloat16": "bf16",
+    "float32": "f32",
+    "uint8": "i8",
+}
+
+
+def _mlir_type(dtype: sfnp.DType) -> str:
+    try:
+        return _MLIR_TYPES[dtype.name]
+    except KeyError:
+        raise ValueError(f"Unsupported device op dtype {dtype.name}")
+
+
+def _tensor(rank: int, ty: str) -> str:
+    return f"tensor<{'?x' * rank}{ty}>"
+
+
+def _affine_map(rank: int, results: list[str]) -> str:
+    dims = ", ".join(f"d{i}" for i in range(rank))
+    return f"affine_map<({dims}) -> ({', '.join(results)})>"
+
+
+class _Body:
+    """The f32 computation in the region of a linalg.generic."""
+
+    def __init__(self):
+        self.lines: list[str] = []
+
+    def emit(self, op: str) -> str:
+        name = f"%t{len(self.lines)}"
+        self.lines.append(f"{name} = {op}")
+        return name
+
+    def const(self, value: float) -> str:
+        return self.emit(f"arith.constant {value:e} : f32")
+
+    def to_f32(self, value: str, ty: str) -> str:
+        if ty == "f32":
+            return value
+        if ty == "i8":
+            return self.emit(f"arith.uitofp {value} : i8 to f32")
+        return self.emit(f"arith.extf {value} : {ty} to f32")
+
+    def from_f32(self, value: str, ty: str) -> str:
+        if ty == "f32":
+            return value
+        if ty == "i8":
+            # Rounded and saturated to [0, 255].
+            value = self.emit(f"arith.maximumf {value}, {self.const(0)} : f32")
+            value = self.emit(f"arith.minimumf {value}, {self.const(255)} : f32")
+            value = self.emit(f"math.roundeven {value} : f32")
+            return self.emit(f"arith.fptoui {value} : f32 to i8")
+        return self.emit(f"arith.truncf {value} : f32 to {ty}")
+
+
+def elementwise_mlir(
+    name: str,
+    rank: int,
+    in_types: list[str],
+    num_scalars: int,
+    out_type: str,
+    compute: Callable[[_Body, list[str], list[str]], str],
+    permutation: Optional[list[int]] = None,
+) -> str:
+    """Generates a module with a function `name` applying `compute` elementwise.
+
+    The function takes `len(in_types)` tensors of rank `rank` and the same
+    shape, then `num_scalars` tensor<1xf32> scalars, and returns a tensor of
+    `out_type`. `compute(body, xs, scalars)` emits the f32 computation of an
+    element from the f32 values of the inputs and scalars, returning its
+    result. With a `permutation`, dim `i` of the inputs is dim
+    `permutation[i]` of the result (i.e. a transpose).
+    """
+    permutation = permutation or list(range(rank))
+    in_results = [f"d{permutation[i]}" for i in range(rank)]
+    num_inputs = len(in_types)
+    in_tys = [_tensor(rank, ty) for ty in in_types]
+    in_tys += ["tensor<1xf32>"] * num_scalars
+    out_tensor = _tensor(rank, out_type)
+    maps = [_affine_map(rank, in_results)] * num_inputs
+    maps += [_affine_map(rank, ["0"])] * num_scalars
+    maps.append(_affine_map(rank, [f"d{i}" for i in range(rank)]))
+
+    args = [f"%in{i}" for i in range(num_inputs)]
+    args += [f"%scalar{i}" for i in range(num_scalars)]
+    block_args = [f"%v{i}: {ty}" for i, ty in enumerate(in_types)]
+    block_args += [f"%s{i}: f32" for i in range(num_scalars)]
+    block_args.append(f"%out: {out_type}")
+
+    body = _Body()
+    xs = [body.to_f32(f"%v{i}", ty) for i, ty in enumerate(in_types)]
+    result = body.from_f32(
+        compute(body, xs, [f"%s{i}" for i in range(num_scalars)]), out_type
+    )
+
+    # Dim j of the result is dim i of the inputs, for permutation[i] == j.
+    lines = [f"%c{i} = arith.constant {i} : index" for i in range(rank)]
+    lines += [
+        f"%d{permutation[i]} = tensor.dim %in0, %c{i} : {in_tys[0]}"
+        for i in range(rank)
+    ]
+    dims = ", ".join(f"%d{i}" for i in range(rank))
+    iterators = ", ".join(['"parallel"'] * rank)
+    lines.append(f"%empty = tensor.empty({dims}) : {out_tensor}")
+    lines.append(
+        f"%result = linalg.generic {{indexing_maps = [{', '.join(maps)}], "
+        f"iterator_types = [{iterators}]}} "
+        f"ins({', '.join(args)} : {', '.join(in_tys)}) "
+        f"outs(%empty : {out_tensor}) {{"
+    )
+    lines.append(f"^bb0({', '.join(block_args)}):")
+    lines += [f"  {line}" for line in body.lines]
+    lines.append(f"  linalg.yield {result} : {out_type}")
+    lines.append(f"}} -> {out_tensor}")
+    lines.append(f"util.return %result : {out_tensor}")
+
+    signature = ", ".join(f"{arg}: {ty}" for arg, ty in zip(args, in_tys))
+    func_lines = "\n".join(f"    {line}" for line in lines)
+    return (
+        f"module @{MODULE_NAME} {{\n"
+        f"  util.func public @{name}({signature}) -> {out_tensor} {{\n"
+        f"{func_lines}\n"
+        "  }\n"
+        "}\n"
+    )
+
+
+class DeviceOps:
+    """Compiles and runs elementwise ops on device arrays.
+
+    `compile_flags` are the iree-compile flags selecting the target of the
+    devices. Compiled modules are cached in `cache_dir` (a temporary directory
+    by default), and programs per op and set of devices. Thread safe: ops can
+    be run from the fibers of all workers.
+    """
+
+    def __init__(
+        self,
+        system: sf.System,
+        compile_flags: list[str],
+        cache_dir: Optional[Path] = None,
+    ):
+        self.system = system
+        self.compile_flags = list(compile_flags)
+        if "--iree-execution-model=async-external" not in self.compile_flags:
+            # Coarse-fences functions, which are ordered on the device.
+            self.compile_flags.append("--iree-execution-model=async-external")
+        if cache_dir is None:
+            cache_dir = Path(tempfile.gettempdir()) / "shortfin_device_ops"
+        self.cache_dir = Path(cache_dir)
+        self._lock = threading.Lock()
+        self._modules: dict[str, sf.ProgramModule] = {}
+        self._programs: dict[tuple, sf.Program] = {}
+
+    def function(self, fiber: sf.Fiber, name: str, mlir: str) -> sf.ProgramFunction:
+        """Gets function `name` of `mlir` for the devices of `fiber`."""
+        key = hashlib.sha256(
+            "\0".join([mlir, *self.compile_flags]).encode()
+        ).hexdigest()[:32]
+        devices = fiber.raw_devices
+        program_key = (key, tuple(str(d) for d in devices))
+        with self._lock:
+            program = self._programs.get(program_key)
+            if program is None:
+                module = self._modules.get(key)
+                if module is None:
+                    module = self._load_module(name, key, mlir)
+                    self._modules[key] = module
+                program = sf.Program(modules=[module], devices=devices)
+                self._programs[program_key] = program
+        return program[f"{MODULE_NAME}.{name}"]
+
+    def _load_module(self, name: str, key: str, mlir: str) -> sf.ProgramModule:
+        vmfb_path = self.cache_dir / f"{name}_{key}.vmfb"
+        if not vmfb_path.exists():
+            from iree.compiler import compile_str
+
+            logger.info("Compiling device op %s", name)
+            self.cache_dir.mkdir(parents=True, exist_ok=True)
+            vmfb = compile_str(mlir, extra_args=self.compile_flags)
+            tmp_path = vmfb_path.with_suffix(".tmp")
+            tmp_path.write_bytes(vmfb)
+            tmp_path.replace(vmfb_path)
+        return sf.ProgramModule.load(self.system, vmfb_path)
+
+    @staticmethod
+    def _scalar(fiber: sf.Fiber, value: float) -> sfnp.device_array:
+        device = fiber.device(0)
+        scalar = sfnp.device_array.for_device(device, [1], sfnp.float32)
+        host = scalar.for_transfer()
+        host.items = [value]
+        scalar.copy_from(host)
+        return scalar
+
+    async def _run(self, fiber, name, mlir, *args) -> sfnp.device_array:
+        fn = self.function(fiber, name, mlir)
+        (result,) = await fn(*args, fiber=fiber)
+        return result
+
+    async def convert(
+        self, fiber: sf.Fiber, x: sfnp.device_array, dtype: sfnp.DType
+    ) -> sfnp.device_array:
+        """Returns `x` converted to `dtype`."""
+        rank, in_ty, out_ty = len(x.shape), _mlir_type(x.dtype), _mlir_type(dtype)
+        name = f"convert_{rank}d_{in_ty}_{out_ty}"
+        mlir = elementwise_mlir(name, rank, [in_ty], 0, out_ty, lambda b, x, s: x[0])
+        return await self._run(fiber, name, mlir, x)
+
+    async def axpby(
+        self,
+        fiber: sf.Fiber,
+        a: float,
+        x: sfnp.device_array,
+        b: float,
+        y: sfnp.device_array,
+    ) -> sfnp.device_array:
+        """Returns `a * x + b * y` (i.e. a scheduler step), in the dtype of x."""
+        rank, ty = len(x.shape), _mlir_type(x.dtype)
+        name = f"axpby_{rank}d_{ty}_{_mlir_type(y.dtype)}"
+
+        def compute(body, xs, scalars):
+            ax = body.emit(f"arith.mulf {scalars[0]}, {xs[0]} : f32")
+            by = body.emit(f"arith.mulf {scalars[1]}, {xs[1]} : f32")
+            return body.emit(f"arith.addf {ax}, {by} : f32")
+
+        mlir = elementwise_mlir(
+            name, rank, [ty, _mlir_type(y.dtype)], 2, ty, compute
+        )
+        return await self._run(
+            fiber, name, mlir, x, y, self._scalar(fiber, a), self._scalar(fiber, b)
+        )
+
+    async def guidance(
+        self,
+        fiber: sf.Fiber,
+        uncond: sfnp.device_array,
+        cond: sfnp.device_array,
+        scale: float,
+    ) -> sfnp.device_array:
+        """Returns the classifier-free guidance combine of two predictions.
+
+        That is `uncond + scale * (cond - uncond)`, in the dtype of uncond.
+        """
+        rank, ty = len(uncond.shape), _mlir_type(uncond.dtype)
+        name = f"guidance_{rank}d_{ty}_{_mlir_type(cond.dtype)}"
+
+        def compute(body, xs, scalars):
+            diff = body.emit(f"arith.subf {xs[1]}, {xs[0]} : f32")
+            scaled = body.emit(f"arith.mulf {scalars[0]}, {diff} : f32")
+            return body.emit(f"arith.addf {xs[0]}, {scaled} : f32")
+
+        mlir = elementwise_mlir(
+            name, rank, [ty, _mlir_type(cond.dtype)], 1, ty, compute
+        )
+        return await self._run(
+            fiber, name, mlir, uncond, cond, self._scalar(fiber, scale)
+        )
+
+    async def to_image(
+        self,
+        fiber: sf.Fiber,
+        x: sfnp.device_array,
+        scale: float,
+        bias: float,
+    ) -> sfnp.device_array:
+        """Returns planar images [..., C, H, W] as interleaved uint8 pixels.
+
+        Pixels [..., H, W, C] are `x * scale + bias`, rounded and saturated
+        to [0, 255] (i.e. scale 127.5 and bias 127.5 for images in [-1, 1]).
+        """
+        rank, ty = len(x.shape), _mlir_type(x.dtype)
+        if rank < 3:
+            raise ValueError(f"Images must be [..., C, H, W], got {x.shape}")
+        name = f"to_image_{rank}d_{ty}"
+        permutation = list(range(rank - 3)) + [rank - 1, rank - 3, rank - 2]
+
+        def compute(body, xs, scalars):
+            scaled = body.emit(f"arith.mulf {xs[0]}, {scalars[0]} : f32")
+            return body.emit(f"arith.addf {scaled}, {scalars[1]} : f32")
+
+        mlir = elementwise_mlir(
+            name, rank, [ty], 2, "i8", compute, permutation=permutation
+        )
+        return await self._run(
+            fiber,
+            name,
+            mlir,
+            x,
+            self._scalar(fiber, scale),
+            self._scalar(fiber, bias),
+        )
@@ -358,9 +358,36 @@ prog_isolations = {
 }
 
 
+class CancellationToken:
+    """Cooperative cancellation of the work of a request.
+
+    The token is shared by everything executing on the request's behalf.
+    `cancel` may be called from any thread, and the work stops at its next step
+    boundary (i.e. when a batcher next forms a batch) rather than immediately.
+    """
+
+    __slots__ = ["_cancelled"]
+
+    def __init__(self):
+        self._cancelled = False
+
+    @property
+    def cancelled(self) -> bool:
+        return self._cancelled
+
+    def cancel(self):
+        self._cancelled = True
+
+
 class InferenceExecRequest(sf.Message):
     def __init__(self):
         super().__init__()
+        # Cancellation of the request that this execution is part of, if any.
+        self.cancellation: Optional[CancellationToken] = None
+
+    @property
+    def cancelled(self) -> bool:
+        return self.cancellation is not None and self.cancellation.cancelled
 
 
 class StrobeMessage(sf.Message):
@@ -592,10 +619,17 @@ class BatcherProcess(sf.Process):
 
     STROBE_SHORT_DELAY = 0.5
     STROBE_LONG_DELAY = 1.0
+    # Submissions are written without delay and are never rejected, but while
+    # under this many pending messages they avoid the queue lock.
+    INFEED_CAPACITY = 1024
+    # Maximum number of infeed messages handled per batching turn.
+    INFEED_READ_BATCH = 256
 
     def __init__(self, fiber, name="batcher"):
         super().__init__(fiber=fiber)
-        self.batcher_infeed = self.system.create_queue()
+        self.batcher_infeed = self.system.create_queue(
+            capacity=self.INFEED_CAPACITY, lock_free=True
+        )
         self.strobe_enabled = True
         self.strobes = 0
         self.pending_requests = set()
@@ -628,14 +662,17 @@ class BatcherProcess(sf.Process):
         """Main run loop for the batcher process."""
         strober_task = asyncio.create_task(self._background_strober())
         reader = self.batcher_infeed.reader()
-        while item := await reader():
+        # Everything that arrived since the last turn is handled before
+        # forming batches. An empty read means the infeed was closed.
+        while items := await reader.read_batch(self.INFEED_READ_BATCH):
             self.strobe_enabled = False
-            if isinstance(item, InferenceExecRequest):
-                self.handle_inference_request(item)
-            elif isinstance(item, StrobeMessage):
-                self.strobes += 1
-            else:
-                self.custom_message(item)
+            for item in items:
+                if isinstance(item, InferenceExecRequest):
+                    self.handle_inference_request(item)
+                elif isinstance(item, StrobeMessage):
+                    self.strobes += 1
+                else:
+                    self.custom_message(item)
             await self.process_batches()
 
             self.strobe_enabled = True
@@ -6,6 +6,8 @@
 
 #include <fmt/core.h>
 
+#include <optional>
+
 #include "./lib_ext.h"
 #include "shortfin/local/device.h"
 #include "shortfin/local/fiber.h"
@@ -39,6 +41,26 @@ inline local::ScopedDevice CastDeviceAffinity(local::Fiber& fiber,
                                           py::repr(object).c_str()));
 }
 
+// Size of the host work (in bytes touched) from which bindings release the
+// GIL around it: below this, handing the GIL to another thread and taking it
+// back costs more than the work itself.
+inline constexpr size_t kReleaseGilMinBytes = 64 * 1024;
+
+// Releases the GIL for its scope if `byte_count` is at least
+// kReleaseGilMinBytes. Nothing in the scope may touch Python objects, and
+// scopes must not nest.
+class ScopedGilRelease {
+ public:
+  explicit ScopedGilRelease(size_t byte_count) {
+    if (byte_count >= kReleaseGilMinBytes) release_.emplace();
+  }
+  ScopedGilRelease(const ScopedGilRelease&) = delete;
+  void operator=(const ScopedGilRelease&) = delete;
+
+ private:
+  std::optional<py::gil_scoped_release> release_;
+};
+
 // For a bound class, binds the buffer protocol. This will result in a call
 // to handler like:
 //   HandlerFunctor(self, Py_buffer *view, int flags)
@@ -10,6 +10,7 @@
 #include "shortfin/array/array.h"
 #include "shortfin/array/dims.h"
 #include "shortfin/array/dtype.h"
+#include "shortfin/array/host_kernels.h"
 #include "shortfin/array/storage.h"
 #include "shortfin/array/xtensor_bridge.h"
 
@@ -7,6 +7,7 @@
 #include "shortfin/array/array.h"
 
 #include <sstream>
+#include <vector>
 
 #include "fmt/core.h"
 #include "fmt/ranges.h"
@@ -18,10 +19,118 @@ namespace shortfin::array {
 
 template class InlinedDims<iree_hal_dim_t>;
 
+namespace {
+
+bool HasDenseLayout(std::span<const Dims::value_type> shape,
+                    std::span<const Dims::value_type> strides) {
+  Dims::value_type accum = 1;
+  bool dense = true;
+  for (size_t i = shape.size(); i-- > 0;) {
+    // Empty arrays have no layout and the strides of unit dims never affect
+    // addressing.
+    if (shape[i] == 0) return true;
+    if (shape[i] != 1 && strides[i] != accum) dense = false;
+    accum *= shape[i];
+  }
+  return dense;
+}
+
+// Bytes spanned from the first to one past the last element of a strided
+// layout.
+iree_device_size_t StridedByteExtent(std::span<const Dims::value_type> shape,
+                                     std::span<const Dims::value_type> strides,
+                                     size_t element_size) {
+  iree_device_size_t last = 0;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (shape[i] == 0) return 0;
+    last += (shape[i] - 1) * strides[i];
+  }
+  return (last + 1) * element_size;
+}
+
+// Byte regions copying each element of a source layout to the same element of
+// a target layout of the same shape. Trailing dims that are contiguous in both
+// are folded into a single region per outer index.
+std::vector<storage::copy_region> StridedCopyRegions(
+    std::span<const Dims::value_type> shape, const Dims &source_strides,
+    const Dims &target_strides, size_t element_size) {
+  std::vector<storage::copy_region> regions;
+  size_t outer_rank = shape.size();
+  Dims::value_type block = 1;
+  for (; outer_rank > 0; --outer_rank) {
+    size_t i = outer_rank - 1;
+    if (shape[i] == 0) return regions;
+    if (shape[i] != 1 &&
+        (source_strides[i] != block || target_strides[i] != block)) {
+      break;
+    }
+    block *= shape[i];
+  }
+  size_t outer_count = 1;
+  for (size_t i = 0; i < outer_rank; ++i) {
+    if (shape[i] == 0) return regions;
+    outer_count *= shape[i];
+  }
+  regions.reserve(outer_count);
+  Dims index(outer_rank, 0);
+  for (size_t n = 0; n < outer_count; ++n) {
+    iree_device_size_t source_offset = 0, target_offset = 0;
+    for (size_t i = 0; i < outer_rank; ++i) {
+      source_offset += index[i] * source_strides[i];
+      target_offset += index[i] * target_strides[i];
+    }
+    regions.push_back(storage::copy_region{
+        .source_offset = source_offset * element_size,
+        .target_offset = target_offset * element_size,
+        .length = block * element_size});
+    for (size_t i = outer_rank; i-- > 0;) {
+      if (++index[i] < shape[i]) break;
+      index[i] = 0;
+    }
+  }
+  return regions;
+}
+
+}  // namespace
+
 // -------------------------------------------------------------------------- //
 // base_array
 // -------------------------------------------------------------------------- //
 
+void base_array::set_shape(std::span<const Dims::value_type> shape) {
+  if (!is_dense()) {
+    throw std::invalid_argument(
+        "Cannot reshape a strided array: compact it with contiguous() first");
+  }
+  shape_.set(shape);
+}
+
+Dims base_array::strides() const {
+  if (!is_dense()) return strides_;
+  auto shape = this->shape();
+  Dims strides(shape.size());
+  Dims::value_type accum = 1;
+  for (size_t i = shape.size(); i-- > 0;) {
+    strides[i] = accum;
+    accum *= shape[i];
+  }
+  return strides;
+}
+
+void base_array::set_strides(std::span<const Dims::value_type> strides) {
+  auto shape = this->shape();
+  if (strides.size() != shape.size()) {
+    throw std::invalid_argument(
+        fmt::format("Expected {} strides for an array of rank {} but got {}",
+                    shape.size(), shape.size(), strides.size()));
+  }
+  if (HasDenseLayout(shape, strides)) {
+    strides_.clear();
+  } else {
+    strides_.set(strides);
+  }
+}
+
 void base_array::expand_dims(Dims::value_type axis) {
   auto shape = this->shape();
   if (axis > shape.size()) {
@@ -38,7 +147,22 @@ void base_array::expand_dims(Dims::value_type axis) {
   for (size_t i = axis; i < shape.size(); ++i) {
     new_dims[j++] = shape[i];
   }
-  set_shape(new_dims.span());
+  if (is_dense()) {
+    set_shape(new_dims.span());
+    return;
+  }
+  // The stride of a unit dim is arbitrary.
+  Dims new_strides(shape.size() + 1);
+  j = 0;
+  for (size_t i = 0; i < axis; ++i) {
+    new_strides[j++] = strides_[i];
+  }
+  new_strides[j++] = axis < shape.size() ? strides_[axis] * shape[axis] : 1;
+  for (size_t i = axis; i < shape.size(); ++i) {
+    new_strides[j++] = strides_[i];
+  }
+  shape_.set(new_dims.span());
+  strides_.set(new_strides.span());
 }
 
 // -------------------------------------------------------------------------- //
@@ -56,6 +180,137 @@ device_array::device_array(class storage storage,
   }
 }
 
+device_array::device_array(class storage storage,
+                           std::span<const Dims::value_type> shape,
+                           std::span<const Dims::value_type> strides,
+                           DType dtype)
+    : base_array(shape, dtype), storage_(std::move(storage)) {
+  set_strides(strides);
+  iree_device_size_t needed_size;
+  if (is_dense()) {
+    needed_size = this->dtype().compute_dense_nd_size(this->shape());
+  } else {
+    if (!this->dtype().is_byte_aligned()) {
+      throw std::invalid_argument(fmt::format(
+          "Strided arrays require a byte aligned dtype but got {}",
+          this->dtype().name()));
+    }
+    needed_size = StridedByteExtent(this->shape(), strides,
+                                    this->dtype().dense_byte_count());
+  }
+  if (storage_.byte_length() < needed_size) {
+    throw std::invalid_argument(
+        fmt::format("Array storage requires at least {} bytes but has only {}",
+                    needed_size, storage_.byte_length()));
+  }
+}
+
+void device_array::AssertDense(const char *operation) const {
+  if (is_dense()) return;
+  throw std::invalid_argument(
+      fmt::format("{} requires a dense array but got a strided view (strides "
+                  "[{}]): compact it with contiguous() first",
+                  operation, fmt::join(strides(), ", ")));
+}
+
+void device_array::AssertRank(const char *operation, size_t rank) const {
+  if (shape().size() == rank) return;
+  throw std::invalid_argument(
+      fmt::format("{} requires an array of rank {} but got shape [{}]",
+                  operation, rank, fmt::join(shape(), ", ")));
+}
+
+void device_array::copy_from(device_array &source_array) {
+  if (is_dense() && source_array.is_dense()) {
+    storage_.copy_from(source_array.storage_);
+    return;
+  }
+  if (dtype() != source_array.dtype() ||
+      !std::ranges::equal(shape(), source_array.shape())) {
+    throw std::invalid_argument(fmt::format(
+        "Copies involving strided arrays require matching shapes and dtypes "
+        "(copying [{}] {} into [{}] {})",
+        fmt::join(source_array.shape(), ", "), source_array.dtype().name(),
+        fmt::join(shape(), ", "), dtype().name()));
+  }
+  auto regions =
+      StridedCopyRegions(shape(), source_array.strides(), strides(),
+                         dtype().dense_byte_count());
+  if (regions.empty()) return;
+  storage_.copy_from(source_array.storage_, regions);
+}
+
+void device_array::copy_rows_from(
+    device_array &source_array, std::span<const Dims::value_type> source_rows,
+    std::span<const Dims::value_type> target_rows) {
+  AssertDense("copy_rows_from");
+  source_array.AssertDense("copy_rows_from");
+  if (source_rows.size() != target_rows.size()) {
+    throw std::invalid_argument(fmt::format(
+        "copy_rows_from requires as many source as target rows (got {} and "
+        "{})",
+        source_rows.size(), target_rows.size()));
+  }
+  auto row_shape = shape();
+  auto source_row_shape = source_array.shape();
+  if (row_shape.empty() || source_row_shape.empty() ||
+      dtype() != source_array.dtype() ||
+      !std::ranges::equal(row_shape.subspan(1), source_row_shape.subspan(1))) {
+    throw std::invalid_argument(fmt::format(
+        "copy_rows_from requires arrays of matching rows (copying [{}] {} "
+        "into [{}] {})",
+        fmt::join(source_row_shape, ", "), source_array.dtype().name(),
+        fmt::join(row_shape, ", "), dtype().name()));
+  }
+  if (source_rows.empty()) return;
+
+  iree_device_size_t row_length = dtype().dense_byte_count();
+  for (auto dim : row_shape.subspan(1)) row_length *= dim;
+  auto check_row = [](Dims::value_type row, Dims::value_type row_count) {
+    if (row >= row_count) {
+      throw std::invalid_argument(fmt::format(
+          "copy_rows_from row {} out of range of dim size {}", row,
+          row_count));
+    }
+  };
+  bool same_storage = storage_ == source_array.storage_;
+  std::vector<bool> written(row_shape[0], false);
+  std::vector<storage::copy_region> regions;
+  regions.reserve(target_rows.size());
+  for (size_t i = 0; i < target_rows.size(); ++i) {
+    check_row(source_rows[i], source_row_shape[0]);
+    check_row(target_rows[i], row_shape[0]);
+    if (written[target_rows[i]]) {
+      throw std::invalid_argument(fmt::format(
+          "copy_rows_from writes row {} more than once", target_rows[i]));
+    }
+    written[target_rows[i]] = true;
+    regions.push_back(
+        storage::copy_region{.source_offset = source_rows[i] * row_length,
+                             .target_offset = target_rows[i] * row_length,
+                             .length = row_length});
+  }
+  if (same_storage) {
+    for (auto row : source_rows) {
+      if (written[row]) {
+        throw std::invalid_argument(fmt::format(
+            "copy_rows_from both reads and writes row {}", row));
+      }
+    }
+  }
+  storage_.copy_from(source_array.storage_, regions);
+}
+
+device_array device_array::contiguous() {
+  if (is_dense()) return *this;
+  // Keep host views on the host so that the result remains mappable.
+  device_array compacted = storage_.is_mappable_for_read()
+                               ? for_host(device(), shape(), dtype())
+                               : for_device(device(), shape(), dtype());
+  compacted.copy_from(*this);
+  return compacted;
+}
+
 const mapping device_array::data() const { return storage_.map_read(); }
 
 mapping device_array::data() { return storage_.map_read(); }
@@ -66,7 +321,9 @@ mapping device_array::data_w() { return storage_.map_write_discard(); }
 
 std::optional<mapping> device_array::map_memory_for_xtensor() {
   SHORTFIN_TRACE_SCOPE_NAMED("PyDeviceArray::map_memory_for_xtensor");
-  if (storage_.is_mappable_for_read_write()) {
+  if (!is_dense()) {
+    return {};
+  } else if (storage_.is_mappable_for_read_write()) {
     return storage_.map_read_write();
   } else if (storage_.is_mappable_for_read()) {
     return storage_.map_read();
@@ -79,6 +336,9 @@ std::string device_array::to_s() const {
   const char *contents_prefix = " ";
   if (!storage_.is_mappable_for_read()) {
     contents = "<unmappable for host read>";
+  } else if (!is_dense()) {
+    contents = fmt::format("<strided view: strides [{}]>",
+                           fmt::join(strides(), ", "));
   } else {
     auto maybe_contents = contents_to_s();
     if (maybe_contents) {
@@ -100,6 +360,7 @@ std::string device_array::to_s() const {
 void device_array::AddAsInvocationArgument(
     local::ProgramInvocation *inv, local::ProgramResourceBarrier barrier) {
   SHORTFIN_TRACE_SCOPE_NAMED("PyDeviceArray::AddAsInvocationArgument");
+  AssertDense("Passing an array to a program");
   auto dims_span = shape();
   iree_hal_buffer_view_t *buffer_view;
   SHORTFIN_THROW_IF_ERROR(iree_hal_buffer_view_create(
@@ -109,7 +370,9 @@ void device_array::AddAsInvocationArgument(
 
   iree::vm_opaque_ref ref;
   *(&ref) = iree_hal_buffer_view_move_ref(buffer_view);
-  inv->AddArg(std::move(ref), storage().timeline_resource_.get());
+  inv->AddArg(std::move(ref), storage().timeline_resource_.get(),
+              storage().resource_range(),
+              /*write=*/barrier == local::ProgramResourceBarrier::WRITE);
 
   storage().AddInvocationArgBarrier(inv, barrier);
 }
@@ -139,59 +402,61 @@ device_array device_array::CreateFromInvocationResultRef(
 }
 
 device_array device_array::view(Dims &offsets, Dims &sizes) {
+  Dims steps(offsets.size(), 1);
+  return view(offsets, sizes, steps);
+}
+
+device_array device_array::view(Dims &offsets, Dims &sizes, Dims &steps) {
   auto rank = shape().size();
-  if (offsets.size() != sizes.size() || offsets.empty() ||
-      offsets.size() > rank) {
+  if (offsets.size() != sizes.size() || offsets.size() != steps.size() ||
+      offsets.empty() || offsets.size() > rank) {
     throw std::invalid_argument(
-        "view offsets and sizes must be of equal size and be of a rank "
+        "view offsets, sizes and steps must be of equal size and be of a rank "
         "<= the array rank");
   }
   if (rank == 0) {
     throw std::invalid_argument("view cannot operate on rank 0 arrays");
   }
-  // Compute row strides.
-  Dims row_stride_bytes(shape().size());
-  iree_device_size_t accum = dtype().dense_byte_count();
-  for (int i = rank - 1; i >= 0; --i) {
-    row_stride_bytes[i] = accum;
-    accum *= shape()[i];
-  }
 
+  // Each sliced dim advances the start by its offset and scales its stride by
+  // the step. The result is dense unless the slices leave gaps.
+  Dims strides = this->strides();
   Dims new_dims(shape_container());
-  bool has_stride = false;
+  Dims new_strides(strides);
   iree_device_size_t start_offset = 0;
-  iree_device_size_t span_size = storage().byte_length();
   for (size_t i = 0; i < offsets.size(); ++i) {
-    auto row_stride = row_stride_bytes[i];
     auto dim_size = shape()[i];
     auto slice_offset = offsets[i];
     auto slice_size = sizes[i];
-    if (slice_offset >= dim_size || (slice_offset + slice_size) > dim_size) {
+    auto slice_step = steps[i];
+    if (slice_step == 0) {
       throw std::invalid_argument(
-          fmt::format("Cannot index ({}:{}) into dim size {} at position {}",
-                      slice_offset, slice_size, dim_size, i));
+          fmt::format("view step must be positive at position {}", i));
     }
-    if (has_stride && (slice_offset > 0 || slice_size != dim_size)) {
+    if (slice_offset >= dim_size ||
+        (slice_size > 0 &&
+         slice_offset + (slice_size - 1) * slice_step >= dim_size)) {
       throw std::invalid_argument(
-          fmt::format("Cannot create a view with dimensions following a "
-                      "spanning dim (at position {})",
-                      i));
+          fmt::format("Cannot index ({}:{}:{}) into dim size {} at position {}",
+                      slice_offset, slice_size, slice_step, dim_size, i));
     }
-    if (slice_size > 1) {
-      has_stride = true;
-    }
-
-    // Since we are only narrowing a dense, row major slice, as we traverse
-    // the dims, we are narrowing the memory view at each step by advancing
-    // the beginning based on the requested offset and pulling the end in
-    // by the difference in size.
-    start_offset += row_stride * slice_offset;
-    span_size -= row_stride * (new_dims[i] - slice_size);
+    start_offset += strides[i] * slice_offset;
     new_dims[i] = slice_size;
+    new_strides[i] = strides[i] * slice_step;
   }
 
-  return device_array(storage().subspan(start_offset, span_size),
-                      new_dims.span(), dtype());
+  auto element_size = dtype().dense_byte_count();
+  if (HasDenseLayout(new_dims.span(), new_strides.span())) {
+    return device_array(
+        storage().subspan(start_offset * element_size,
+                          dtype().compute_dense_nd_size(new_dims.span())),
+        new_dims.span(), dtype());
+  }
+  return device_array(
+      storage().subspan(start_offset * element_size,
+                        StridedByteExtent(new_dims.span(), new_strides.span(),
+                                          element_size)),
+      new_dims.span(), new_strides.span(), dtype());
 }
 
 }  // namespace shortfin::array
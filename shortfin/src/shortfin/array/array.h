@@ -24,12 +24,13 @@ namespace shortfin::array {
 // Wraps an owned mapping and an adapted xtensor together, ensuring that the
 // mapping remains live for the duration of the tensor. This presents as a
 // smart pointer or iterator in that you dereference the tensor via `*` or
-// `->`.
-template <typename EltTy>
+// `->`. The tensor is of dynamic rank unless ShapeTy is a std::array, in
+// which case its shape and strides are fixed size (see map_xtensor_fixed()).
+template <typename EltTy, typename ShapeTy = Dims>
 struct mapped_xtensor_holder {
  public:
   using xtensor_type =
-      decltype(xt::adapt(static_cast<EltTy *>(nullptr), Dims()));
+      decltype(xt::adapt(static_cast<EltTy *>(nullptr), ShapeTy()));
   mapped_xtensor_holder(class mapping mapping, xtensor_type t)
       : mapping(std::move(mapping)), t(std::move(t)) {}
 
@@ -51,16 +52,20 @@ class SHORTFIN_API base_array {
   // Need to explicitly define copy/move constructors even though this is
   // a value type because the Dims union is otherwise not copy/movable.
   base_array(const base_array &other)
-      : base_array(other.shape(), other.dtype()) {}
+      : base_array(other.shape(), other.dtype()) {
+    strides_.set(other.strides_.span());
+  }
   base_array(base_array &&other)
-      : dtype_(other.dtype_), shape_(std::move(other.shape_)) {}
+      : dtype_(other.dtype_),
+        shape_(std::move(other.shape_)),
+        strides_(std::move(other.strides_)) {}
   virtual ~base_array() = default;
   virtual std::string to_s() const = 0;
 
   DType dtype() const { return dtype_; }
 
-  // Access shape.
-  void set_shape(std::span<const Dims::value_type> shape) { shape_.set(shape); }
+  // Access shape. Strided arrays cannot be reshaped.
+  void set_shape(std::span<const Dims::value_type> shape);
   std::span<const Dims::value_type> shape() const { return shape_.span(); }
   std::span<Dims::value_type> mutable_shape() { return shape_.span(); }
 
@@ -72,9 +77,20 @@ class SHORTFIN_API base_array {
   // Inserts a unit dim at axis, which must be <= rank.
   void expand_dims(Dims::value_type axis);
 
+  // Arrays are dense and row-major unless they are a strided view, in which
+  // case they carry an element stride per dim (the element offset is applied
+  // by the view's storage).
+  bool is_dense() const { return strides_.empty(); }
+  // Element strides of each dim, computed for dense arrays.
+  Dims strides() const;
+  // Sets explicit element strides, one per dim. Strides that describe the
+  // dense layout are dropped, making the array dense.
+  void set_strides(std::span<const Dims::value_type> strides);
+
  private:
   DType dtype_;
   Dims shape_;
+  Dims strides_;
 };
 
 class SHORTFIN_API device_array
@@ -84,6 +100,9 @@ class SHORTFIN_API device_array
  public:
   device_array(class storage storage, std::span<const Dims::value_type> shape,
                DType dtype);
+  // Creates a strided array. The storage begins at the first element.
+  device_array(class storage storage, std::span<const Dims::value_type> shape,
+               std::span<const Dims::value_type> strides, DType dtype);
 
   class storage &storage() { return storage_; }
   local::ScopedDevice &device() { return storage_.device(); }
@@ -108,27 +127,46 @@ class SHORTFIN_API device_array
         shape, dtype);
   }
 
-  // Allocates a host array for transfer to/from this array.
+  // Allocates a host array for transfer to/from this array, drawing from the
+  // device's staging ring. A dense array in unified memory is returned as is,
+  // and copies between the two are no-ops.
   device_array for_transfer() {
-    return for_host(storage().device(), shape(), dtype());
+    if (is_dense() && storage_.is_unified()) return *this;
+    return device_array(
+        storage::allocate_staging(storage().device(),
+                                  dtype().compute_dense_nd_size(shape())),
+        shape(), dtype());
   }
 
   // Enqueues a fill of the storage with an arbitrary pattern of the given
   // size. The pattern size must be 1, 2, or 4. Equivalent to calling the same
   // on the backing storage.
   void fill(const void *pattern, iree_host_size_t pattern_length) {
+    AssertDense("fill");
     storage_.fill(pattern, pattern_length);
   }
 
   // Performs either a d2h, h2d or d2d transfer from a source storage to this
-  // storage. Equivalent to calling the same on the backing storage.
-  void copy_from(device_array &source_array) {
-    storage_.copy_from(source_array.storage_);
-  }
+  // storage. For dense arrays, this is equivalent to calling the same on the
+  // backing storage. If either array is strided, both must have the same
+  // shape and dtype and the elements are transferred with one copy command
+  // per run of contiguous elements.
+  void copy_from(device_array &source_array);
   // Inverse of copy_from.
-  void copy_to(device_array &dest_array) {
-    dest_array.storage_.copy_from(storage_);
-  }
+  void copy_to(device_array &dest_array) { dest_array.copy_from(*this); }
+  // Copies row source_rows[i] (index along the leading dim) of a source array
+  // to row target_rows[i] of this array, for each i, recording one copy
+  // command per row into a single transfer. Both arrays must be dense with
+  // the same dtype and shape past the leading dim. No row may be written
+  // twice, nor (when copying within an array) both read and written, as the
+  // copies are unordered.
+  void copy_rows_from(device_array &source_array,
+                      std::span<const Dims::value_type> source_rows,
+                      std::span<const Dims::value_type> target_rows);
+
+  // Returns this array if it is dense. Otherwise enqueues a device side
+  // compaction of the strided view into a new dense device array.
+  device_array contiguous();
 
   // Untyped access to the backing data. The array must be mappable. Specific
   // access modes:
@@ -175,6 +213,7 @@ class SHORTFIN_API device_array
   template <typename EltTy>
   auto map_xtensor() {
     dtype().AssertCompatibleSize<EltTy>();
+    AssertDense("map_xtensor");
     auto m = data();
     auto *data = static_cast<EltTy *>(static_cast<void *>((m.data())));
     return mapped_xtensor_holder<EltTy>(
@@ -185,6 +224,7 @@ class SHORTFIN_API device_array
   template <typename EltTy>
   auto map_xtensor_rw() {
     dtype().AssertCompatibleSize<EltTy>();
+    AssertDense("map_xtensor");
     auto m = data_rw();
     auto *data = static_cast<EltTy *>(static_cast<void *>((m.data())));
     return mapped_xtensor_holder<EltTy>(
@@ -195,16 +235,48 @@ class SHORTFIN_API device_array
   template <typename EltTy>
   auto map_xtensor_w() {
     dtype().AssertCompatibleSize<EltTy>();
+    AssertDense("map_xtensor");
     auto m = data_w();
     auto *data = static_cast<EltTy *>(static_cast<void *>((m.data())));
     return mapped_xtensor_holder<EltTy>(
         std::move(m), xt::adapt(static_cast<EltTy *>(data), shape_container()));
   }
 
-  // Creates a device array which aliases the backing storage by slicing. Only
-  // slice shapes that produce a dense view without strides are supported by
-  // this mechanism.
+  // Same as `map_xtensor()` but with the rank fixed at compile time: the
+  // xtensor has std::array shape and strides, so that expressions over it
+  // index and iterate without looping over a runtime rank (i.e. for the
+  // [bs, vocab] logits of host side sampling). Throws std::invalid_argument
+  // if the array is not of rank `Rank`.
+  template <typename EltTy, size_t Rank>
+  auto map_xtensor_fixed() {
+    return MapFixedXtensor<EltTy, Rank>(data());
+  }
+
+  // Same as `map_xtensor_fixed()` but maps read-write.
+  template <typename EltTy, size_t Rank>
+  auto map_xtensor_fixed_rw() {
+    return MapFixedXtensor<EltTy, Rank>(data_rw());
+  }
+
+  // Same as `map_xtensor_fixed()` but maps write-only.
+  template <typename EltTy, size_t Rank>
+  auto map_xtensor_fixed_w() {
+    return MapFixedXtensor<EltTy, Rank>(data_w());
+  }
+
+  // Creates a device array which aliases the backing storage by slicing.
+  // Slices that do not produce a dense, row-major view (i.e. a non-leading
+  // slice or a step other than 1) produce a strided view. Strided views must
+  // be compacted (see contiguous()) before being passed to a program or
+  // mapped as a tensor.
   device_array view(Dims &indices, Dims &sizes);
+  device_array view(Dims &indices, Dims &sizes, Dims &steps);
+
+  // Throws if the array is not dense, naming `operation` in the message.
+  void AssertDense(const char *operation) const;
+  // Throws if the array is not of rank `rank`, naming `operation` in the
+  // message.
+  void AssertRank(const char *operation, size_t rank) const;
 
   std::string to_s() const override;
 
@@ -221,6 +293,18 @@ class SHORTFIN_API device_array
       iree::vm_opaque_ref ref);
   static iree_vm_ref_type_t invocation_marshalable_type();
   friend class shortfin::local::ProgramInvocationMarshalableFactory;
+
+  template <typename EltTy, size_t Rank>
+  auto MapFixedXtensor(class mapping m) {
+    dtype().AssertCompatibleSize<EltTy>();
+    AssertDense("map_xtensor_fixed");
+    AssertRank("map_xtensor_fixed", Rank);
+    std::array<Dims::value_type, Rank> fixed_shape;
+    std::copy_n(shape().begin(), Rank, fixed_shape.begin());
+    auto *data = static_cast<EltTy *>(static_cast<void *>(m.data()));
+    return mapped_xtensor_holder<EltTy, std::array<Dims::value_type, Rank>>(
+        std::move(m), xt::adapt(data, fixed_shape));
+  }
 };
 
 }  // namespace shortfin::array
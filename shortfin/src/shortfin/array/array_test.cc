@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <array>
+#include <type_traits>
 
 #include "shortfin/array/api.h"
 #include "shortfin/local/systems/host.h"
@@ -59,4 +60,73 @@ TEST_F(DeviceArrayTest, contents_to_s_invalid) {
   ASSERT_FALSE(contents);
 }
 
+TEST_F(DeviceArrayTest, view_strided) {
+  device_array ary1 = device_array::for_host(
+      device, std::to_array<size_t>({2, 3, 4}), DType::float32());
+  // Leading slices stay dense.
+  Dims leading_offsets(1, 1), leading_sizes(1, 1);
+  EXPECT_TRUE(ary1.view(leading_offsets, leading_sizes).is_dense());
+
+  // Selecting one entry of the middle dim leaves gaps between rows.
+  Dims offsets(2, 0), sizes(2, 1);
+  offsets[1] = 1;
+  sizes[0] = 2;
+  device_array view = ary1.view(offsets, sizes);
+  EXPECT_FALSE(view.is_dense());
+  EXPECT_THAT(view.shape(), testing::ElementsAre(2, 1, 4));
+  EXPECT_THAT(view.strides(), testing::ElementsAre(12, 4, 1));
+  EXPECT_EQ(view.storage().byte_length(), (12 + 4) * sizeof(float));
+  EXPECT_THROW(view.map_xtensor<float>(), std::invalid_argument);
+  EXPECT_FALSE(view.contents_to_s());
+
+  // Views compose, with steps scaling the strides.
+  Dims inner_offsets(3, 0), inner_sizes(view.shape_container()),
+      inner_steps(3, 1);
+  inner_sizes[2] = 2;
+  inner_steps[2] = 2;
+  device_array stepped = view.view(inner_offsets, inner_sizes, inner_steps);
+  EXPECT_THAT(stepped.strides(), testing::ElementsAre(12, 4, 2));
+}
+
+TEST_F(DeviceArrayTest, map_xtensor_fixed) {
+  device_array ary1 = device_array::for_host(
+      device, std::to_array<size_t>({2, 3}), DType::float32());
+  {
+    auto t = ary1.map_xtensor_fixed_w<float, 2>();
+    static_assert(
+        std::is_same_v<std::decay_t<decltype((*t).shape())>,
+                       std::array<Dims::value_type, 2>>);
+    for (size_t i = 0; i < 2; ++i) {
+      for (size_t j = 0; j < 3; ++j) (*t)(i, j) = i * 3 + j;
+    }
+  }
+  auto dynamic_t = ary1.map_xtensor<float>();
+  auto fixed_t = ary1.map_xtensor_fixed<float, 2>();
+  EXPECT_THAT((*fixed_t).shape(), testing::ElementsAre(2, 3));
+  EXPECT_EQ(*dynamic_t, *fixed_t);
+  EXPECT_EQ((*fixed_t)(1, 2), 5.0f);
+
+  // The rank must match.
+  EXPECT_THROW((ary1.map_xtensor_fixed<float, 3>()), std::invalid_argument);
+}
+
+TEST_F(DeviceArrayTest, memory_pool_scope) {
+  EXPECT_EQ(memory_pool_scope::current(), nullptr);
+  {
+    memory_pool_scope kvcache("kvcache");
+    const char *name = memory_pool_scope::current();
+    EXPECT_STREQ(name, "kvcache");
+    {
+      memory_pool_scope inner("other");
+      EXPECT_STREQ(memory_pool_scope::current(), "other");
+      storage::allocate_device(device, 64);
+    }
+    // Names are interned.
+    memory_pool_scope again("kvcache");
+    EXPECT_EQ(memory_pool_scope::current(), name);
+    storage::allocate_host(device, 64);
+  }
+  EXPECT_EQ(memory_pool_scope::current(), nullptr);
+}
+
 }  // namespace
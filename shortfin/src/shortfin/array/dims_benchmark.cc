@@ -0,0 +1,58 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "shortfin/array/dims.h"
+
+namespace shortfin::array {
+namespace {
+
+// Ranks up to Dims::MAX_INLINE_RANK are stored inline, larger ones on the
+// heap: the rank argument covers both sides of the boundary.
+void BM_DimsConstruct(benchmark::State &state) {
+  size_t rank = state.range(0);
+  for (auto _ : state) {
+    Dims dims(rank, 42);
+    benchmark::DoNotOptimize(dims.data());
+  }
+}
+BENCHMARK(BM_DimsConstruct)->Arg(4)->Arg(Dims::MAX_INLINE_RANK)->Arg(8);
+
+void BM_DimsCopy(benchmark::State &state) {
+  Dims dims(state.range(0), 42);
+  for (auto _ : state) {
+    Dims copy(dims);
+    benchmark::DoNotOptimize(copy.data());
+  }
+}
+BENCHMARK(BM_DimsCopy)->Arg(4)->Arg(Dims::MAX_INLINE_RANK)->Arg(8);
+
+void BM_DimsSet(benchmark::State &state) {
+  std::vector<Dims::value_type> values(state.range(0), 42);
+  Dims dims;
+  for (auto _ : state) {
+    dims.set(values);
+    benchmark::DoNotOptimize(dims.data());
+  }
+}
+BENCHMARK(BM_DimsSet)->Arg(4)->Arg(Dims::MAX_INLINE_RANK)->Arg(8);
+
+// The element count of a shape, as computed on every array view.
+void BM_DimsProduct(benchmark::State &state) {
+  Dims dims(state.range(0), 3);
+  for (auto _ : state) {
+    Dims::value_type count = 1;
+    for (auto dim : dims) count *= dim;
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_DimsProduct)->Arg(4)->Arg(8);
+
+}  // namespace
+}  // namespace shortfin::array
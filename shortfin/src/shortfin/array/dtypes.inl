@@ -28,6 +28,7 @@ SHORTFIN_DTYPE_HANDLE(IREE_HAL_ELEMENT_TYPE_SINT_64, sint64)
 SHORTFIN_DTYPE_HANDLE(IREE_HAL_ELEMENT_TYPE_UINT_64, uint64)
 SHORTFIN_DTYPE_HANDLE(IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FNUZ, float8_e4m3fnuz)
 SHORTFIN_DTYPE_HANDLE(IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FN, float8_e4m3fn)
+SHORTFIN_DTYPE_HANDLE(IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2, float8_e5m2)
 SHORTFIN_DTYPE_HANDLE(IREE_HAL_ELEMENT_TYPE_FLOAT_16, float16)
 SHORTFIN_DTYPE_HANDLE(IREE_HAL_ELEMENT_TYPE_FLOAT_32, float32)
 SHORTFIN_DTYPE_HANDLE(IREE_HAL_ELEMENT_TYPE_FLOAT_64, float64)
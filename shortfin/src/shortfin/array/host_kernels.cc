@@ -0,0 +1,264 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/array/host_kernels.h"
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+#include "shortfin/array/host_kernels_impl.h"
+
+namespace shortfin::array::host_kernels {
+
+namespace detail {
+namespace {
+
+// Portable fallback: one lane, computing the same approximations as the
+// vector instruction sets.
+struct ScalarOps {
+  using V = float;
+  using M = bool;
+  static constexpr size_t kWidth = 1;
+
+  template <Format F>
+  static V load(const typename FormatTraits<F>::Storage *p) {
+    return FormatTraits<F>::ToFloat(*p);
+  }
+  template <Format F>
+  static void store(typename FormatTraits<F>::Storage *p, V v) {
+    *p = FormatTraits<F>::FromFloat(v);
+  }
+  static V load_f32(const float *p) { return *p; }
+  static void store_f32(float *p, V v) { *p = v; }
+
+  static V set1(float v) { return v; }
+  static V add(V a, V b) { return a + b; }
+  static V sub(V a, V b) { return a - b; }
+  static V mul(V a, V b) { return a * b; }
+  static V div(V a, V b) { return a / b; }
+  static V min(V a, V b) { return a < b ? a : b; }
+  static V max(V a, V b) { return a > b ? a : b; }
+  static V fmadd(V a, V b, V c) { return a * b + c; }
+  static V round(V v) { return nearbyintf(v); }
+  static V pow2n(V n) {
+    return std::bit_cast<float>(
+        static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23);
+  }
+  static M gt(V a, V b) { return a > b; }
+  static M lt(V a, V b) { return a < b; }
+  static V select(M m, V a, V b) { return m ? a : b; }
+  static float hmax(V v) { return v; }
+  static float hsum(V v) { return v; }
+  static V load_lut(const float *table, const uint8_t *p) { return table[*p]; }
+  static void store_lut(uint8_t *p, const uint16_t *table, V v) {
+    *p = EncodeFp8(table, v);
+  }
+};
+
+constexpr KernelTable kScalarTable =
+    Kernels<ScalarOps>::MakeTable(Isa::SCALAR);
+
+bool CpuSupports(Isa isa) {
+  switch (isa) {
+    case Isa::SCALAR:
+      return true;
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    case Isa::AVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+             __builtin_cpu_supports("f16c");
+    case Isa::AVX512:
+      return __builtin_cpu_supports("avx512f");
+#endif
+#if defined(__aarch64__)
+    case Isa::NEON:
+      // Mandatory on AArch64.
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+const KernelTable *CompiledTable(Isa isa) {
+  switch (isa) {
+    case Isa::SCALAR:
+      return GetScalarKernelTable();
+    case Isa::AVX2:
+      return GetAvx2KernelTable();
+    case Isa::AVX512:
+      return GetAvx512KernelTable();
+    case Isa::NEON:
+      return GetNeonKernelTable();
+  }
+  return nullptr;
+}
+
+struct Fp8Tables {
+  float decode[256];
+  uint16_t encode[65536 + 1];
+
+  Fp8Tables(float (*to_f32)(uint8_t), uint8_t (*from_f32)(float)) {
+    for (int code = 0; code < 256; ++code) {
+      decode[code] = to_f32(static_cast<uint8_t>(code));
+    }
+    for (uint32_t upper = 0; upper < 65536; ++upper) {
+      uint8_t exact = from_f32(std::bit_cast<float>(upper << 16));
+      uint8_t inexact = from_f32(std::bit_cast<float>((upper << 16) | 0xFFFF));
+      encode[upper] = static_cast<uint16_t>(exact | (inexact << 8));
+    }
+    encode[65536] = 0;
+  }
+};
+
+const Fp8Tables &GetFp8Tables(ConvertFormat format) {
+  switch (format) {
+    case ConvertFormat::F8E4M3FNUZ: {
+      static const Fp8Tables tables(&iree_math_f8e4m3fnuz_to_f32,
+                                    &iree_math_f32_to_f8e4m3fnuz);
+      return tables;
+    }
+    case ConvertFormat::F8E4M3FN: {
+      static const Fp8Tables tables(&iree_math_f8e4m3fn_to_f32,
+                                    &iree_math_f32_to_f8e4m3fn);
+      return tables;
+    }
+    default: {
+      static const Fp8Tables tables(&iree_math_f8e5m2_to_f32,
+                                    &iree_math_f32_to_f8e5m2);
+      return tables;
+    }
+  }
+}
+
+size_t ConvertFormatSize(ConvertFormat format) {
+  switch (format) {
+    case ConvertFormat::F32:
+      return 4;
+    case ConvertFormat::F16:
+    case ConvertFormat::BF16:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+std::atomic<const KernelTable *> active_table{nullptr};
+
+const KernelTable &Active() {
+  const KernelTable *table = active_table.load(std::memory_order_acquire);
+  if (table) [[likely]] {
+    return *table;
+  }
+  // Benign race: every thread elects the same table.
+  for (Isa isa : {Isa::AVX512, Isa::AVX2, Isa::NEON, Isa::SCALAR}) {
+    if (IsaSupported(isa)) {
+      table = CompiledTable(isa);
+      break;
+    }
+  }
+  active_table.store(table, std::memory_order_release);
+  return *table;
+}
+
+}  // namespace
+
+const KernelTable *GetScalarKernelTable() { return &kScalarTable; }
+
+const float *Fp8DecodeTable(ConvertFormat format) {
+  return GetFp8Tables(format).decode;
+}
+
+const uint16_t *Fp8EncodeTable(ConvertFormat format) {
+  return GetFp8Tables(format).encode;
+}
+
+}  // namespace detail
+
+std::optional<Format> FormatForDType(DType dtype) {
+  if (dtype == DType::float32()) return Format::F32;
+  if (dtype == DType::float16()) return Format::F16;
+  if (dtype == DType::bfloat16()) return Format::BF16;
+  return std::nullopt;
+}
+
+std::optional<ConvertFormat> ConvertFormatForDType(DType dtype) {
+  if (dtype == DType::float32()) return ConvertFormat::F32;
+  if (dtype == DType::float16()) return ConvertFormat::F16;
+  if (dtype == DType::bfloat16()) return ConvertFormat::BF16;
+  if (dtype == DType::float8_e4m3fnuz()) return ConvertFormat::F8E4M3FNUZ;
+  if (dtype == DType::float8_e4m3fn()) return ConvertFormat::F8E4M3FN;
+  if (dtype == DType::float8_e5m2()) return ConvertFormat::F8E5M2;
+  return std::nullopt;
+}
+
+std::string_view IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::SCALAR:
+      return "scalar";
+    case Isa::AVX2:
+      return "avx2";
+    case Isa::AVX512:
+      return "avx512";
+    case Isa::NEON:
+      return "neon";
+  }
+  return "unknown";
+}
+
+bool IsaSupported(Isa isa) {
+  return detail::CompiledTable(isa) && detail::CpuSupports(isa);
+}
+
+Isa ActiveIsa() { return detail::Active().isa; }
+
+bool SetActiveIsa(Isa isa) {
+  if (!IsaSupported(isa)) return false;
+  detail::active_table.store(detail::CompiledTable(isa),
+                             std::memory_order_release);
+  return true;
+}
+
+void ArgmaxRows(Format format, const void *input, size_t rows, size_t n,
+                int64_t *out) {
+  detail::Active().argmax_rows(format, input, rows, n, n, out);
+}
+
+void ArgmaxRows(Format format, const void *input, size_t rows, size_t n,
+                size_t row_stride, int64_t *out) {
+  detail::Active().argmax_rows(format, input, rows, n, row_stride, out);
+}
+
+void SoftmaxRows(Format format, const void *input, void *out, size_t rows,
+                 size_t n, bool log) {
+  detail::Active().softmax_rows(format, input, out, rows, n, log);
+}
+
+void Exp(Format format, const void *input, void *out, size_t count) {
+  detail::Active().exp(format, input, out, count);
+}
+
+void Binary(BinaryOp op, Format format, const void *lhs, const void *rhs,
+            void *out, size_t count) {
+  detail::Active().binary(op, format, lhs, rhs, out, count);
+}
+
+void BinaryScalar(BinaryOp op, Format format, const void *array, float scalar,
+                  bool scalar_lhs, void *out, size_t count) {
+  detail::Active().binary_scalar(op, format, array, scalar, scalar_lhs, out,
+                                 count);
+}
+
+void Convert(ConvertFormat from, ConvertFormat to, const void *input,
+             void *out, size_t count) {
+  if (from == to) {
+    std::memmove(out, input, count * detail::ConvertFormatSize(from));
+    return;
+  }
+  detail::Active().convert(from, to, input, out, count);
+}
+
+}  // namespace shortfin::array::host_kernels
@@ -0,0 +1,114 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_ARRAY_HOST_KERNELS_H
+#define SHORTFIN_ARRAY_HOST_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "shortfin/array/dtype.h"
+#include "shortfin/support/api.h"
+
+// Vectorized host kernels for the hot paths of the array host ops (sampling
+// over large vocabularies being the motivating case). Kernels operate on dense
+// memory: row-wise kernels take `rows` contiguous rows of `n` elements (i.e.
+// reduce over the last axis).
+//
+// Arithmetic is always carried out in fp32 registers. fp16/bf16 data is
+// converted as it is loaded and stored, so it is never upcast into a
+// temporary buffer.
+//
+// The instruction set is selected at runtime from what the CPU supports
+// (AVX-512 > AVX2 on x86-64, NEON on AArch64) with a portable scalar fallback
+// that computes identical approximations.
+namespace shortfin::array::host_kernels {
+
+// Element storage formats with vectorized kernels.
+enum class Format {
+  F32,
+  F16,
+  BF16,
+};
+
+// Returns the kernel format for |dtype| or nullopt if it has no kernels.
+SHORTFIN_API std::optional<Format> FormatForDType(DType dtype);
+
+// Storage formats accepted by Convert: the formats above plus the 8 bit float
+// formats, which are only supported as conversion sources and targets.
+enum class ConvertFormat {
+  F32,
+  F16,
+  BF16,
+  F8E4M3FNUZ,
+  F8E4M3FN,
+  F8E5M2,
+};
+
+// Returns the conversion format for |dtype| or nullopt if it has none.
+SHORTFIN_API std::optional<ConvertFormat> ConvertFormatForDType(DType dtype);
+
+enum class Isa {
+  SCALAR,
+  AVX2,
+  AVX512,
+  NEON,
+};
+
+SHORTFIN_API std::string_view IsaName(Isa isa);
+// Whether the kernels for |isa| are compiled in and supported by the CPU.
+SHORTFIN_API bool IsaSupported(Isa isa);
+// The instruction set that kernels currently dispatch to.
+SHORTFIN_API Isa ActiveIsa();
+// Overrides the dispatch (for testing and benchmarking). Returns false and
+// leaves the selection unchanged if |isa| is not supported.
+SHORTFIN_API bool SetActiveIsa(Isa isa);
+
+enum class BinaryOp {
+  ADD,
+  SUBTRACT,
+  MULTIPLY,
+  DIVIDE,
+};
+
+// out[r] = index of the first maximum of row r. NaNs are ignored.
+SHORTFIN_API void ArgmaxRows(Format format, const void *input, size_t rows,
+                             size_t n, int64_t *out);
+// As above, with the first element of each row |row_stride| elements after
+// the previous one (i.e. rows of a padded or sliced array).
+SHORTFIN_API void ArgmaxRows(Format format, const void *input, size_t rows,
+                             size_t n, size_t row_stride, int64_t *out);
+
+// Numerically stable softmax (or log_softmax if |log|) of each row. |out| may
+// alias |input|.
+SHORTFIN_API void SoftmaxRows(Format format, const void *input, void *out,
+                              size_t rows, size_t n, bool log);
+
+// out[i] = exp(input[i]). |out| may alias |input|.
+SHORTFIN_API void Exp(Format format, const void *input, void *out,
+                      size_t count);
+
+// out[i] = lhs[i] <op> rhs[i]. |out| may alias either operand.
+SHORTFIN_API void Binary(BinaryOp op, Format format, const void *lhs,
+                         const void *rhs, void *out, size_t count);
+
+// out[i] = array[i] <op> scalar (or scalar <op> array[i] if |scalar_lhs|).
+SHORTFIN_API void BinaryScalar(BinaryOp op, Format format, const void *array,
+                               float scalar, bool scalar_lhs, void *out,
+                               size_t count);
+
+// out[i] = input[i] converted between formats, rounding to nearest even and
+// following the saturation and NaN behavior of the IREE conversion functions.
+// 8 bit floats are decoded and encoded through exact lookup tables. |out| may
+// only alias |input| if both formats have the same width.
+SHORTFIN_API void Convert(ConvertFormat from, ConvertFormat to,
+                          const void *input, void *out, size_t count);
+
+}  // namespace shortfin::array::host_kernels
+
+#endif  // SHORTFIN_ARRAY_HOST_KERNELS_H
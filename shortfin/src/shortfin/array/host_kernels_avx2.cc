@@ -0,0 +1,139 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// AVX2 (+FMA, F16C) host kernels. This file is compiled with the matching
+// target flags on x86-64 and is only dispatched to after a CPU check.
+
+#include "shortfin/array/host_kernels_impl.h"
+
+#if defined(__AVX2__) && defined(__FMA__) && defined(__F16C__)
+#include <immintrin.h>
+
+namespace shortfin::array::host_kernels::detail {
+namespace {
+
+struct Avx2Ops {
+  using V = __m256;
+  using M = __m256;
+  static constexpr size_t kWidth = 8;
+
+  template <Format F>
+  static V load(const typename FormatTraits<F>::Storage *p) {
+    if constexpr (F == Format::F32) {
+      return _mm256_loadu_ps(p);
+    } else if constexpr (F == Format::F16) {
+      return _mm256_cvtph_ps(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+    } else {
+      __m256i widened = _mm256_cvtepu16_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+      return _mm256_castsi256_ps(_mm256_slli_epi32(widened, 16));
+    }
+  }
+  template <Format F>
+  static void store(typename FormatTraits<F>::Storage *p, V v) {
+    if constexpr (F == Format::F32) {
+      _mm256_storeu_ps(p, v);
+    } else if constexpr (F == Format::F16) {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(p),
+                       _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+    } else {
+      // Round to nearest even, keeping NaNs quiet.
+      __m256i bits = _mm256_castps_si256(v);
+      __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16),
+                                     _mm256_set1_epi32(1));
+      bits = _mm256_add_epi32(
+          bits, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7FFF)));
+      bits = _mm256_srli_epi32(bits, 16);
+      __m256 nan = _mm256_cmp_ps(v, v, _CMP_UNORD_Q);
+      bits = _mm256_blendv_epi8(bits, _mm256_set1_epi32(0x7FC0),
+                                _mm256_castps_si256(nan));
+      // Narrow the 32 bit lanes (each < 2^16) to 16 bits.
+      __m256i packed = _mm256_permute4x64_epi64(
+          _mm256_packus_epi32(bits, bits), 0xD8);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(p),
+                       _mm256_castsi256_si128(packed));
+    }
+  }
+  static V load_f32(const float *p) { return _mm256_loadu_ps(p); }
+  static void store_f32(float *p, V v) { _mm256_storeu_ps(p, v); }
+
+  static V set1(float v) { return _mm256_set1_ps(v); }
+  static V add(V a, V b) { return _mm256_add_ps(a, b); }
+  static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+  static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+  static V div(V a, V b) { return _mm256_div_ps(a, b); }
+  static V min(V a, V b) { return _mm256_min_ps(a, b); }
+  static V max(V a, V b) { return _mm256_max_ps(a, b); }
+  static V fmadd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+  static V round(V v) {
+    return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+  static V pow2n(V n) {
+    __m256i biased =
+        _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(biased, 23));
+  }
+  static M gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+  static M lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static V select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+  static float hmax(V v) {
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(v),
+                          _mm256_extractf128_ps(v, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+  }
+  static float hsum(V v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v),
+                          _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+  }
+  static V load_lut(const float *table, const uint8_t *p) {
+    __m256i idx = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+    return _mm256_i32gather_ps(table, idx, 4);
+  }
+  static void store_lut(uint8_t *p, const uint16_t *table, V v) {
+    __m256i bits = _mm256_castps_si256(v);
+    // 32 bit gathers of 16 bit entries: the entry is in the low half.
+    __m256i entry =
+        _mm256_i32gather_epi32(reinterpret_cast<const int *>(table),
+                               _mm256_srli_epi32(bits, 16), 2);
+    __m256i mask = _mm256_set1_epi32(0xFF);
+    __m256i exact = _mm256_cmpeq_epi32(
+        _mm256_and_si256(bits, _mm256_set1_epi32(0xFFFF)),
+        _mm256_setzero_si256());
+    __m256i code =
+        _mm256_blendv_epi8(_mm256_and_si256(_mm256_srli_epi32(entry, 8), mask),
+                           _mm256_and_si256(entry, mask), exact);
+    // Narrow to bytes. The packs work within 128 bit lanes, leaving lanes
+    // 0-3 and 4-7 in the low dword of each half.
+    __m256i packed = _mm256_packus_epi32(code, code);
+    packed = _mm256_packus_epi16(packed, packed);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(p),
+                     _mm_unpacklo_epi32(_mm256_castsi256_si128(packed),
+                                        _mm256_extracti128_si256(packed, 1)));
+  }
+};
+
+constexpr KernelTable kAvx2Table = Kernels<Avx2Ops>::MakeTable(Isa::AVX2);
+
+}  // namespace
+
+const KernelTable *GetAvx2KernelTable() { return &kAvx2Table; }
+
+}  // namespace shortfin::array::host_kernels::detail
+
+#else
+
+namespace shortfin::array::host_kernels::detail {
+const KernelTable *GetAvx2KernelTable() { return nullptr; }
+}  // namespace shortfin::array::host_kernels::detail
+
+#endif
@@ -0,0 +1,125 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// AVX-512F host kernels. This file is compiled with the matching target flags
+// on x86-64 and is only dispatched to after a CPU check.
+
+#include "shortfin/array/host_kernels_impl.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+// GCC 12 reports the deliberately undefined passthrough operands inside the
+// AVX-512 intrinsics (_mm512_undefined_ps) as uninitialized at their inlining
+// sites.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace shortfin::array::host_kernels::detail {
+namespace {
+
+struct Avx512Ops {
+  using V = __m512;
+  using M = __mmask16;
+  static constexpr size_t kWidth = 16;
+
+  template <Format F>
+  static V load(const typename FormatTraits<F>::Storage *p) {
+    if constexpr (F == Format::F32) {
+      return _mm512_loadu_ps(p);
+    } else if constexpr (F == Format::F16) {
+      return _mm512_cvtph_ps(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+    } else {
+      __m512i widened = _mm512_cvtepu16_epi32(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+      return _mm512_castsi512_ps(_mm512_slli_epi32(widened, 16));
+    }
+  }
+  template <Format F>
+  static void store(typename FormatTraits<F>::Storage *p, V v) {
+    if constexpr (F == Format::F32) {
+      _mm512_storeu_ps(p, v);
+    } else if constexpr (F == Format::F16) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(p),
+                          _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+    } else {
+      // Round to nearest even, keeping NaNs quiet.
+      __m512i bits = _mm512_castps_si512(v);
+      __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(bits, 16),
+                                     _mm512_set1_epi32(1));
+      bits = _mm512_add_epi32(
+          bits, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7FFF)));
+      bits = _mm512_srli_epi32(bits, 16);
+      __mmask16 nan = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+      bits = _mm512_mask_blend_epi32(nan, bits, _mm512_set1_epi32(0x7FC0));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(p),
+                          _mm512_cvtepi32_epi16(bits));
+    }
+  }
+  static V load_f32(const float *p) { return _mm512_loadu_ps(p); }
+  static void store_f32(float *p, V v) { _mm512_storeu_ps(p, v); }
+
+  static V set1(float v) { return _mm512_set1_ps(v); }
+  static V add(V a, V b) { return _mm512_add_ps(a, b); }
+  static V sub(V a, V b) { return _mm512_sub_ps(a, b); }
+  static V mul(V a, V b) { return _mm512_mul_ps(a, b); }
+  static V div(V a, V b) { return _mm512_div_ps(a, b); }
+  static V min(V a, V b) { return _mm512_min_ps(a, b); }
+  static V max(V a, V b) { return _mm512_max_ps(a, b); }
+  static V fmadd(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+  static V round(V v) {
+    return _mm512_roundscale_ps(v,
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+  static V pow2n(V n) {
+    __m512i biased =
+        _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(biased, 23));
+  }
+  static M gt(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+  static M lt(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+  static V select(M m, V a, V b) { return _mm512_mask_blend_ps(m, b, a); }
+  static float hmax(V v) { return _mm512_reduce_max_ps(v); }
+  static float hsum(V v) { return _mm512_reduce_add_ps(v); }
+  static V load_lut(const float *table, const uint8_t *p) {
+    __m512i idx = _mm512_cvtepu8_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+    return _mm512_i32gather_ps(idx, table, 4);
+  }
+  static void store_lut(uint8_t *p, const uint16_t *table, V v) {
+    __m512i bits = _mm512_castps_si512(v);
+    // 32 bit gathers of 16 bit entries: the entry is in the low half.
+    __m512i entry =
+        _mm512_i32gather_epi32(_mm512_srli_epi32(bits, 16), table, 2);
+    __mmask16 exact =
+        _mm512_testn_epi32_mask(bits, _mm512_set1_epi32(0xFFFF));
+    __m512i code =
+        _mm512_mask_blend_epi32(exact, _mm512_srli_epi32(entry, 8), entry);
+    // Truncating narrow keeps the selected low byte.
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p),
+                     _mm512_cvtepi32_epi8(code));
+  }
+};
+
+constexpr KernelTable kAvx512Table =
+    Kernels<Avx512Ops>::MakeTable(Isa::AVX512);
+
+}  // namespace
+
+const KernelTable *GetAvx512KernelTable() { return &kAvx512Table; }
+
+}  // namespace shortfin::array::host_kernels::detail
+
+#else
+
+namespace shortfin::array::host_kernels::detail {
+const KernelTable *GetAvx512KernelTable() { return nullptr; }
+}  // namespace shortfin::array::host_kernels::detail
+
+#endif
@@ -0,0 +1,577 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Internal to the host kernels: shared kernel templates, instantiated once per
+// instruction set from a translation unit compiled for that instruction set.
+//
+// Each instruction set provides an `Ops` traits struct:
+//   V, M: vector of fp32 lanes and the matching comparison mask.
+//   kWidth: number of lanes.
+//   load<Format>(ptr), store<Format>(ptr, v): full-width converting access.
+//   load_f32(ptr), store_f32(ptr, v): plain fp32 access (for partial tails).
+//   set1, add, sub, mul, div, min, max, fmadd (a * b + c), round (to nearest
+//   even), pow2n (2^n for integral n in [-126, 127]), gt, lt,
+//   select (m ? a : b), hmax, hsum.
+//   load_lut(table, ptr): looks up kWidth 8 bit codes in a 256 entry fp32
+//   table.
+//   store_lut(ptr, table, v): encodes kWidth lanes to 8 bit codes through an
+//   Fp8EncodeTable (see EncodeFp8).
+// min/max follow the x86 convention of returning the second operand if either
+// is NaN.
+//
+// Everything except the table type lives in an anonymous namespace: the
+// instantiations in each translation unit are compiled with different target
+// flags and must never be merged by the linker. For the same reason, these
+// templates avoid calling into the standard library.
+
+#ifndef SHORTFIN_ARRAY_HOST_KERNELS_IMPL_H
+#define SHORTFIN_ARRAY_HOST_KERNELS_IMPL_H
+
+#include <math.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "iree/base/internal/math.h"
+#include "shortfin/array/host_kernels.h"
+
+namespace shortfin::array::host_kernels::detail {
+
+struct KernelTable {
+  Isa isa;
+  void (*argmax_rows)(Format format, const void *input, size_t rows, size_t n,
+                      size_t row_stride, int64_t *out);
+  void (*softmax_rows)(Format format, const void *input, void *out,
+                       size_t rows, size_t n, bool log);
+  void (*exp)(Format format, const void *input, void *out, size_t count);
+  void (*binary)(BinaryOp op, Format format, const void *lhs, const void *rhs,
+                 void *out, size_t count);
+  void (*binary_scalar)(BinaryOp op, Format format, const void *array,
+                        float scalar, bool scalar_lhs, void *out,
+                        size_t count);
+  void (*convert)(ConvertFormat from, ConvertFormat to, const void *input,
+                  void *out, size_t count);
+};
+
+// Lookup tables for an 8 bit float |format|, built on first use.
+// Exact fp8 -> fp32 decoding, indexed by the 8 bit code.
+const float *Fp8DecodeTable(ConvertFormat format);
+// fp32 -> fp8 encoding, indexed by the upper 16 bits of the fp32. The low
+// byte of each entry is the result when the lower 16 bits are zero and the
+// high byte the result when they are not. Every rounding tie of the 8 bit
+// formats has zero lower bits, so this is exact. A trailing padding entry
+// keeps 32 bit gathers of the last entry in bounds.
+const uint16_t *Fp8EncodeTable(ConvertFormat format);
+
+// Per instruction set tables. Each returns nullptr if the instruction set was
+// not compiled in.
+const KernelTable *GetScalarKernelTable();
+const KernelTable *GetAvx2KernelTable();
+const KernelTable *GetAvx512KernelTable();
+const KernelTable *GetNeonKernelTable();
+
+namespace {
+
+template <Format F>
+struct FormatTraits;
+template <>
+struct FormatTraits<Format::F32> {
+  using Storage = float;
+  static float ToFloat(Storage v) { return v; }
+  static Storage FromFloat(float v) { return v; }
+};
+template <>
+struct FormatTraits<Format::F16> {
+  using Storage = uint16_t;
+  static float ToFloat(Storage v) { return iree_math_f16_to_f32(v); }
+  static Storage FromFloat(float v) { return iree_math_f32_to_f16(v); }
+};
+template <>
+struct FormatTraits<Format::BF16> {
+  using Storage = uint16_t;
+  static float ToFloat(Storage v) { return iree_math_bf16_to_f32(v); }
+  static Storage FromFloat(float v) { return iree_math_f32_to_bf16(v); }
+};
+
+template <Format F>
+const typename FormatTraits<F>::Storage *At(const void *base, size_t index) {
+  return static_cast<const typename FormatTraits<F>::Storage *>(base) + index;
+}
+template <Format F>
+typename FormatTraits<F>::Storage *At(void *base, size_t index) {
+  return static_cast<typename FormatTraits<F>::Storage *>(base) + index;
+}
+
+// Loads |count| < kWidth elements, filling the remaining lanes with |fill|.
+template <typename Ops, Format F>
+typename Ops::V LoadPartial(const typename FormatTraits<F>::Storage *p,
+                            size_t count, float fill) {
+  alignas(64) float lanes[Ops::kWidth];
+  for (size_t i = 0; i < Ops::kWidth; ++i) {
+    lanes[i] = i < count ? FormatTraits<F>::ToFloat(p[i]) : fill;
+  }
+  return Ops::load_f32(lanes);
+}
+
+template <typename Ops, Format F>
+void StorePartial(typename FormatTraits<F>::Storage *p, size_t count,
+                  typename Ops::V v) {
+  alignas(64) float lanes[Ops::kWidth];
+  Ops::store_f32(lanes, v);
+  for (size_t i = 0; i < count; ++i) {
+    p[i] = FormatTraits<F>::FromFloat(lanes[i]);
+  }
+}
+
+inline uint8_t EncodeFp8(const uint16_t *table, float v) {
+  uint32_t bits;
+  __builtin_memcpy(&bits, &v, sizeof(bits));
+  uint16_t entry = table[bits >> 16];
+  return static_cast<uint8_t>((bits & 0xFFFF) ? entry >> 8 : entry);
+}
+
+// Cephes style expf: range reduction to r in [-ln2/2, ln2/2] and a degree 5
+// polynomial, accurate to a few ulp. Inputs below the smallest normal result
+// flush to zero (so masked -inf logits are exactly zero) and inputs past the
+// largest finite result go to +inf.
+template <typename Ops>
+typename Ops::V VExp(typename Ops::V x) {
+  using V = typename Ops::V;
+  const V lo = Ops::set1(-87.3365478515625f);
+  const V hi = Ops::set1(88.0f);
+  // Operand order propagates NaN inputs.
+  V clamped = Ops::min(hi, Ops::max(lo, x));
+  V n = Ops::round(Ops::mul(clamped, Ops::set1(1.44269504088896341f)));
+  V r = Ops::fmadd(n, Ops::set1(-0.693359375f), clamped);
+  r = Ops::fmadd(n, Ops::set1(2.12194440e-4f), r);
+  V p = Ops::set1(1.9875691500e-4f);
+  p = Ops::fmadd(p, r, Ops::set1(1.3981999507e-3f));
+  p = Ops::fmadd(p, r, Ops::set1(8.3334519073e-3f));
+  p = Ops::fmadd(p, r, Ops::set1(4.1665795894e-2f));
+  p = Ops::fmadd(p, r, Ops::set1(1.6666665459e-1f));
+  p = Ops::fmadd(p, r, Ops::set1(5.0000001201e-1f));
+  V y = Ops::fmadd(Ops::mul(p, r), r, Ops::add(r, Ops::set1(1.f)));
+  y = Ops::mul(y, Ops::pow2n(n));
+  y = Ops::select(Ops::lt(x, lo), Ops::set1(0.f), y);
+  return Ops::select(Ops::gt(x, Ops::set1(88.72283935546875f)),
+                     Ops::set1(std::numeric_limits<float>::infinity()), y);
+}
+
+template <typename Ops, Format F>
+void ArgmaxRowsImpl(const void *input, size_t rows, size_t n,
+                    size_t row_stride, int64_t *out) {
+  using V = typename Ops::V;
+  using M = typename Ops::M;
+  constexpr size_t W = Ops::kWidth;
+  constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+  // Lane indices are tracked in fp32, which is exact up to 2^24, so long rows
+  // are reduced in blocks.
+  constexpr size_t kBlock = size_t(1) << 24;
+  alignas(64) float iota_lanes[W];
+  for (size_t i = 0; i < W; ++i) iota_lanes[i] = static_cast<float>(i);
+  const V iota = Ops::load_f32(iota_lanes);
+  const V step = Ops::set1(static_cast<float>(W));
+
+  for (size_t r = 0; r < rows; ++r) {
+    const auto *row = At<F>(input, r * row_stride);
+    float best_value = kNegInf;
+    size_t best_index = 0;
+    for (size_t block = 0; block < n; block += kBlock) {
+      size_t block_n = n - block < kBlock ? n - block : kBlock;
+      const auto *p = row + block;
+      V best = Ops::set1(kNegInf);
+      V best_idx = Ops::set1(0.f);
+      V idx = iota;
+      size_t i = 0;
+      for (; i + W <= block_n; i += W) {
+        V v = Ops::template load<F>(p + i);
+        M m = Ops::gt(v, best);
+        best = Ops::select(m, v, best);
+        best_idx = Ops::select(m, idx, best_idx);
+        idx = Ops::add(idx, step);
+      }
+      if (i < block_n) {
+        V v = LoadPartial<Ops, F>(p + i, block_n - i, kNegInf);
+        M m = Ops::gt(v, best);
+        best = Ops::select(m, v, best);
+        best_idx = Ops::select(m, idx, best_idx);
+      }
+      // Each lane holds its first maximum: take the greatest value, breaking
+      // ties by the lowest index.
+      alignas(64) float values[W];
+      alignas(64) float indices[W];
+      Ops::store_f32(values, best);
+      Ops::store_f32(indices, best_idx);
+      for (size_t lane = 0; lane < W; ++lane) {
+        size_t index = block + static_cast<size_t>(indices[lane]);
+        if (values[lane] > best_value ||
+            (values[lane] == best_value && values[lane] != kNegInf &&
+             index < best_index)) {
+          best_value = values[lane];
+          best_index = index;
+        }
+      }
+    }
+    out[r] = static_cast<int64_t>(best_index);
+  }
+}
+
+template <typename Ops, Format F>
+float RowMax(const typename FormatTraits<F>::Storage *p, size_t n) {
+  using V = typename Ops::V;
+  constexpr size_t W = Ops::kWidth;
+  constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+  V acc = Ops::set1(kNegInf);
+  size_t i = 0;
+  for (; i + W <= n; i += W) acc = Ops::max(acc, Ops::template load<F>(p + i));
+  if (i < n) acc = Ops::max(acc, LoadPartial<Ops, F>(p + i, n - i, kNegInf));
+  return Ops::hmax(acc);
+}
+
+template <typename Ops, Format F>
+void SoftmaxRowsImpl(const void *input, void *out, size_t rows, size_t n,
+                     bool log) {
+  using V = typename Ops::V;
+  constexpr size_t W = Ops::kWidth;
+  constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+  for (size_t r = 0; r < rows; ++r) {
+    const auto *in_row = At<F>(input, r * n);
+    auto *out_row = At<F>(out, r * n);
+    const V row_max = Ops::set1(RowMax<Ops, F>(in_row, n));
+
+    // Sum of exponentials. For softmax, the exponentials are written out and
+    // normalized in place by the final pass.
+    V acc = Ops::set1(0.f);
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+      V e = VExp<Ops>(Ops::sub(Ops::template load<F>(in_row + i), row_max));
+      acc = Ops::add(acc, e);
+      if (!log) Ops::template store<F>(out_row + i, e);
+    }
+    if (i < n) {
+      V e = VExp<Ops>(
+          Ops::sub(LoadPartial<Ops, F>(in_row + i, n - i, kNegInf), row_max));
+      acc = Ops::add(acc, e);
+      if (!log) StorePartial<Ops, F>(out_row + i, n - i, e);
+    }
+    float sum = Ops::hsum(acc);
+
+    if (log) {
+      // log_softmax(x) = (x - max) - log(sum(exp(x - max))).
+      const V offset = Ops::add(row_max, Ops::set1(logf(sum)));
+      for (i = 0; i + W <= n; i += W) {
+        Ops::template store<F>(
+            out_row + i, Ops::sub(Ops::template load<F>(in_row + i), offset));
+      }
+      if (i < n) {
+        StorePartial<Ops, F>(
+            out_row + i, n - i,
+            Ops::sub(LoadPartial<Ops, F>(in_row + i, n - i, 0.f), offset));
+      }
+    } else {
+      const V scale = Ops::div(Ops::set1(1.f), Ops::set1(sum));
+      for (i = 0; i + W <= n; i += W) {
+        Ops::template store<F>(
+            out_row + i, Ops::mul(Ops::template load<F>(out_row + i), scale));
+      }
+      if (i < n) {
+        StorePartial<Ops, F>(
+            out_row + i, n - i,
+            Ops::mul(LoadPartial<Ops, F>(out_row + i, n - i, 0.f), scale));
+      }
+    }
+  }
+}
+
+template <typename Ops, Format F>
+void ExpImpl(const void *input, void *out, size_t count) {
+  constexpr size_t W = Ops::kWidth;
+  const auto *in = At<F>(input, 0);
+  auto *o = At<F>(out, 0);
+  size_t i = 0;
+  for (; i + W <= count; i += W) {
+    Ops::template store<F>(o + i, VExp<Ops>(Ops::template load<F>(in + i)));
+  }
+  if (i < count) {
+    StorePartial<Ops, F>(
+        o + i, count - i,
+        VExp<Ops>(LoadPartial<Ops, F>(in + i, count - i, 0.f)));
+  }
+}
+
+template <typename Ops>
+typename Ops::V ApplyBinary(BinaryOp op, typename Ops::V lhs,
+                            typename Ops::V rhs) {
+  switch (op) {
+    case BinaryOp::ADD:
+      return Ops::add(lhs, rhs);
+    case BinaryOp::SUBTRACT:
+      return Ops::sub(lhs, rhs);
+    case BinaryOp::MULTIPLY:
+      return Ops::mul(lhs, rhs);
+    case BinaryOp::DIVIDE:
+      return Ops::div(lhs, rhs);
+  }
+  return lhs;
+}
+
+template <typename Ops, Format F, BinaryOp Op>
+void BinaryLoop(const void *lhs, const void *rhs, void *out, size_t count) {
+  constexpr size_t W = Ops::kWidth;
+  const auto *a = At<F>(lhs, 0);
+  const auto *b = At<F>(rhs, 0);
+  auto *o = At<F>(out, 0);
+  size_t i = 0;
+  for (; i + W <= count; i += W) {
+    Ops::template store<F>(
+        o + i, ApplyBinary<Ops>(Op, Ops::template load<F>(a + i),
+                                Ops::template load<F>(b + i)));
+  }
+  if (i < count) {
+    // Pad with ones so that division of the padding lanes stays finite.
+    StorePartial<Ops, F>(
+        o + i, count - i,
+        ApplyBinary<Ops>(Op, LoadPartial<Ops, F>(a + i, count - i, 1.f),
+                         LoadPartial<Ops, F>(b + i, count - i, 1.f)));
+  }
+}
+
+template <typename Ops, Format F, BinaryOp Op>
+void BinaryScalarLoop(const void *array, float scalar, bool scalar_lhs,
+                      void *out, size_t count) {
+  using V = typename Ops::V;
+  constexpr size_t W = Ops::kWidth;
+  const auto *a = At<F>(array, 0);
+  auto *o = At<F>(out, 0);
+  const V s = Ops::set1(scalar);
+  auto apply = [&](V v) {
+    return scalar_lhs ? ApplyBinary<Ops>(Op, s, v) : ApplyBinary<Ops>(Op, v, s);
+  };
+  size_t i = 0;
+  for (; i + W <= count; i += W) {
+    Ops::template store<F>(o + i, apply(Ops::template load<F>(a + i)));
+  }
+  if (i < count) {
+    StorePartial<Ops, F>(o + i, count - i,
+                         apply(LoadPartial<Ops, F>(a + i, count - i, 1.f)));
+  }
+}
+
+template <typename Ops, Format From, Format To>
+void ConvertFloatLoop(const void *input, void *out, size_t count) {
+  constexpr size_t W = Ops::kWidth;
+  const auto *in = At<From>(input, 0);
+  auto *o = At<To>(out, 0);
+  size_t i = 0;
+  for (; i + W <= count; i += W) {
+    Ops::template store<To>(o + i, Ops::template load<From>(in + i));
+  }
+  if (i < count) {
+    StorePartial<Ops, To>(o + i, count - i,
+                          LoadPartial<Ops, From>(in + i, count - i, 0.f));
+  }
+}
+
+template <typename Ops, Format To>
+void DecodeFp8Loop(const float *table, const void *input, void *out,
+                   size_t count) {
+  constexpr size_t W = Ops::kWidth;
+  const auto *in = static_cast<const uint8_t *>(input);
+  auto *o = At<To>(out, 0);
+  size_t i = 0;
+  for (; i + W <= count; i += W) {
+    Ops::template store<To>(o + i, Ops::load_lut(table, in + i));
+  }
+  for (; i < count; ++i) o[i] = FormatTraits<To>::FromFloat(table[in[i]]);
+}
+
+template <typename Ops, Format From>
+void EncodeFp8Loop(const uint16_t *table, const void *input, void *out,
+                   size_t count) {
+  constexpr size_t W = Ops::kWidth;
+  const auto *in = At<From>(input, 0);
+  auto *o = static_cast<uint8_t *>(out);
+  size_t i = 0;
+  for (; i + W <= count; i += W) {
+    Ops::store_lut(o + i, table, Ops::template load<From>(in + i));
+  }
+  for (; i < count; ++i) {
+    o[i] = EncodeFp8(table, FormatTraits<From>::ToFloat(in[i]));
+  }
+}
+
+template <typename Ops>
+void TranscodeFp8Loop(const float *decode, const uint16_t *encode,
+                      const void *input, void *out, size_t count) {
+  constexpr size_t W = Ops::kWidth;
+  const auto *in = static_cast<const uint8_t *>(input);
+  auto *o = static_cast<uint8_t *>(out);
+  size_t i = 0;
+  for (; i + W <= count; i += W) {
+    Ops::store_lut(o + i, encode, Ops::load_lut(decode, in + i));
+  }
+  for (; i < count; ++i) o[i] = EncodeFp8(encode, decode[in[i]]);
+}
+
+inline bool IsFp8(ConvertFormat format) {
+  return format == ConvertFormat::F8E4M3FNUZ ||
+         format == ConvertFormat::F8E4M3FN || format == ConvertFormat::F8E5M2;
+}
+
+// Only valid for the non-fp8 conversion formats.
+inline Format AsFormat(ConvertFormat format) {
+  switch (format) {
+    case ConvertFormat::F16:
+      return Format::F16;
+    case ConvertFormat::BF16:
+      return Format::BF16;
+    default:
+      return Format::F32;
+  }
+}
+
+// Expands a runtime format (and op) to the template instantiation.
+#define SHORTFIN_KERNEL_FORMAT_SWITCH(format, body)      \
+  switch (format) {                                      \
+    case Format::F32: {                                  \
+      constexpr Format kFormat = Format::F32;            \
+      body;                                              \
+      break;                                             \
+    }                                                    \
+    case Format::F16: {                                  \
+      constexpr Format kFormat = Format::F16;            \
+      body;                                              \
+      break;                                             \
+    }                                                    \
+    case Format::BF16: {                                 \
+      constexpr Format kFormat = Format::BF16;           \
+      body;                                              \
+      break;                                             \
+    }                                                    \
+  }
+
+#define SHORTFIN_KERNEL_FORMAT_SWITCH2(format, body) \
+  switch (format) {                                 \
+    case Format::F32: {                             \
+      constexpr Format kFormat2 = Format::F32;      \
+      body;                                         \
+      break;                                        \
+    }                                               \
+    case Format::F16: {                             \
+      constexpr Format kFormat2 = Format::F16;      \
+      body;                                         \
+      break;                                        \
+    }                                               \
+    case Format::BF16: {                            \
+      constexpr Format kFormat2 = Format::BF16;     \
+      body;                                         \
+      break;                                        \
+    }                                               \
+  }
+
+#define SHORTFIN_KERNEL_OP_SWITCH(op, body)              \
+  switch (op) {                                          \
+    case BinaryOp::ADD: {                                \
+      constexpr BinaryOp kOp = BinaryOp::ADD;            \
+      body;                                              \
+      break;                                             \
+    }                                                    \
+    case BinaryOp::SUBTRACT: {                           \
+      constexpr BinaryOp kOp = BinaryOp::SUBTRACT;       \
+      body;                                              \
+      break;                                             \
+    }                                                    \
+    case BinaryOp::MULTIPLY: {                           \
+      constexpr BinaryOp kOp = BinaryOp::MULTIPLY;       \
+      body;                                              \
+      break;                                             \
+    }                                                    \
+    case BinaryOp::DIVIDE: {                             \
+      constexpr BinaryOp kOp = BinaryOp::DIVIDE;         \
+      body;                                              \
+      break;                                             \
+    }                                                    \
+  }
+
+template <typename Ops>
+struct Kernels {
+  static void ArgmaxRows(Format format, const void *input, size_t rows,
+                         size_t n, size_t row_stride, int64_t *out) {
+    SHORTFIN_KERNEL_FORMAT_SWITCH(
+        format,
+        (ArgmaxRowsImpl<Ops, kFormat>(input, rows, n, row_stride, out)));
+  }
+  static void SoftmaxRows(Format format, const void *input, void *out,
+                          size_t rows, size_t n, bool log) {
+    SHORTFIN_KERNEL_FORMAT_SWITCH(
+        format, (SoftmaxRowsImpl<Ops, kFormat>(input, out, rows, n, log)));
+  }
+  static void Exp(Format format, const void *input, void *out, size_t count) {
+    SHORTFIN_KERNEL_FORMAT_SWITCH(format,
+                                  (ExpImpl<Ops, kFormat>(input, out, count)));
+  }
+  static void Binary(BinaryOp op, Format format, const void *lhs,
+                     const void *rhs, void *out, size_t count) {
+    SHORTFIN_KERNEL_FORMAT_SWITCH(
+        format, SHORTFIN_KERNEL_OP_SWITCH(
+                    op, (BinaryLoop<Ops, kFormat, kOp>(lhs, rhs, out, count))));
+  }
+  static void BinaryScalar(BinaryOp op, Format format, const void *array,
+                           float scalar, bool scalar_lhs, void *out,
+                           size_t count) {
+    SHORTFIN_KERNEL_FORMAT_SWITCH(
+        format, SHORTFIN_KERNEL_OP_SWITCH(
+                    op, (BinaryScalarLoop<Ops, kFormat, kOp>(
+                            array, scalar, scalar_lhs, out, count))));
+  }
+
+  static void Convert(ConvertFormat from, ConvertFormat to, const void *input,
+                      void *out, size_t count) {
+    if (IsFp8(from) && IsFp8(to)) {
+      TranscodeFp8Loop<Ops>(Fp8DecodeTable(from), Fp8EncodeTable(to), input,
+                            out, count);
+    } else if (IsFp8(from)) {
+      const float *table = Fp8DecodeTable(from);
+      SHORTFIN_KERNEL_FORMAT_SWITCH(
+          AsFormat(to),
+          (DecodeFp8Loop<Ops, kFormat>(table, input, out, count)));
+    } else if (IsFp8(to)) {
+      const uint16_t *table = Fp8EncodeTable(to);
+      SHORTFIN_KERNEL_FORMAT_SWITCH(
+          AsFormat(from),
+          (EncodeFp8Loop<Ops, kFormat>(table, input, out, count)));
+    } else {
+      SHORTFIN_KERNEL_FORMAT_SWITCH(
+          AsFormat(from),
+          SHORTFIN_KERNEL_FORMAT_SWITCH2(
+              AsFormat(to), (ConvertFloatLoop<Ops, kFormat, kFormat2>(
+                                input, out, count))));
+    }
+  }
+
+  static constexpr KernelTable MakeTable(Isa isa) {
+    return KernelTable{
+        .isa = isa,
+        .argmax_rows = &ArgmaxRows,
+        .softmax_rows = &SoftmaxRows,
+        .exp = &Exp,
+        .binary = &Binary,
+        .binary_scalar = &BinaryScalar,
+        .convert = &Convert,
+    };
+  }
+};
+
+#undef SHORTFIN_KERNEL_FORMAT_SWITCH
+#undef SHORTFIN_KERNEL_FORMAT_SWITCH2
+#undef SHORTFIN_KERNEL_OP_SWITCH
+
+}  // namespace
+
+}  // namespace shortfin::array::host_kernels::detail
+
+#endif  // SHORTFIN_ARRAY_HOST_KERNELS_IMPL_H
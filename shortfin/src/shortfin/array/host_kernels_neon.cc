@@ -0,0 +1,97 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// NEON host kernels. NEON (with fp16 conversions) is part of the AArch64
+// baseline, so no special target flags or CPU checks are needed.
+
+#include "shortfin/array/host_kernels_impl.h"
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+namespace shortfin::array::host_kernels::detail {
+namespace {
+
+struct NeonOps {
+  using V = float32x4_t;
+  using M = uint32x4_t;
+  static constexpr size_t kWidth = 4;
+
+  template <Format F>
+  static V load(const typename FormatTraits<F>::Storage *p) {
+    if constexpr (F == Format::F32) {
+      return vld1q_f32(p);
+    } else if constexpr (F == Format::F16) {
+      return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(p)));
+    } else {
+      return vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(p), 16));
+    }
+  }
+  template <Format F>
+  static void store(typename FormatTraits<F>::Storage *p, V v) {
+    if constexpr (F == Format::F32) {
+      vst1q_f32(p, v);
+    } else if constexpr (F == Format::F16) {
+      vst1_u16(p, vreinterpret_u16_f16(vcvt_f16_f32(v)));
+    } else {
+      // Round to nearest even, keeping NaNs quiet.
+      uint32x4_t bits = vreinterpretq_u32_f32(v);
+      uint32x4_t lsb = vandq_u32(vshrq_n_u32(bits, 16), vdupq_n_u32(1));
+      bits = vaddq_u32(bits, vaddq_u32(lsb, vdupq_n_u32(0x7FFF)));
+      bits = vbslq_u32(vceqq_f32(v, v), bits, vdupq_n_u32(0x7FC00000));
+      vst1_u16(p, vshrn_n_u32(bits, 16));
+    }
+  }
+  static V load_f32(const float *p) { return vld1q_f32(p); }
+  static void store_f32(float *p, V v) { vst1q_f32(p, v); }
+
+  static V set1(float v) { return vdupq_n_f32(v); }
+  static V add(V a, V b) { return vaddq_f32(a, b); }
+  static V sub(V a, V b) { return vsubq_f32(a, b); }
+  static V mul(V a, V b) { return vmulq_f32(a, b); }
+  static V div(V a, V b) { return vdivq_f32(a, b); }
+  // vminq/vmaxq propagate NaN from either operand rather than following the
+  // x86 convention, which is equivalent for how the kernels use them.
+  static V min(V a, V b) { return vminq_f32(a, b); }
+  static V max(V a, V b) { return vmaxq_f32(a, b); }
+  static V fmadd(V a, V b, V c) { return vfmaq_f32(c, a, b); }
+  static V round(V v) { return vrndnq_f32(v); }
+  static V pow2n(V n) {
+    int32x4_t biased = vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127));
+    return vreinterpretq_f32_s32(vshlq_n_s32(biased, 23));
+  }
+  static M gt(V a, V b) { return vcgtq_f32(a, b); }
+  static M lt(V a, V b) { return vcltq_f32(a, b); }
+  static V select(M m, V a, V b) { return vbslq_f32(m, a, b); }
+  static float hmax(V v) { return vmaxvq_f32(v); }
+  static float hsum(V v) { return vaddvq_f32(v); }
+  // No gather: the 8 bit float tables are looked up a lane at a time.
+  static V load_lut(const float *table, const uint8_t *p) {
+    float lanes[4] = {table[p[0]], table[p[1]], table[p[2]], table[p[3]]};
+    return vld1q_f32(lanes);
+  }
+  static void store_lut(uint8_t *p, const uint16_t *table, V v) {
+    float lanes[4];
+    vst1q_f32(lanes, v);
+    for (int i = 0; i < 4; ++i) p[i] = EncodeFp8(table, lanes[i]);
+  }
+};
+
+constexpr KernelTable kNeonTable = Kernels<NeonOps>::MakeTable(Isa::NEON);
+
+}  // namespace
+
+const KernelTable *GetNeonKernelTable() { return &kNeonTable; }
+
+}  // namespace shortfin::array::host_kernels::detail
+
+#else
+
+namespace shortfin::array::host_kernels::detail {
+const KernelTable *GetNeonKernelTable() { return nullptr; }
+}  // namespace shortfin::array::host_kernels::detail
+
+#endif
@@ -0,0 +1,311 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/array/host_kernels.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "iree/base/internal/math.h"
+
+namespace shortfin::array::host_kernels {
+
+namespace {
+
+// Runs each test against every instruction set supported on this machine.
+class HostKernelsTest : public testing::TestWithParam<Isa> {
+ protected:
+  void SetUp() override {
+    saved_isa_ = ActiveIsa();
+    if (!SetActiveIsa(GetParam())) {
+      GTEST_SKIP() << IsaName(GetParam()) << " is not supported";
+    }
+  }
+  void TearDown() override { SetActiveIsa(saved_isa_); }
+
+  static std::vector<float> RandomValues(size_t count, float lo, float hi) {
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<float> dist(lo, hi);
+    std::vector<float> values(count);
+    for (auto &v : values) v = dist(engine);
+    return values;
+  }
+
+  Isa saved_isa_;
+};
+
+constexpr float kInf = std::numeric_limits<float>::infinity();
+
+TEST_P(HostKernelsTest, ExpF32) {
+  // An odd count exercises the partial tail.
+  std::vector<float> input = RandomValues(1001, -80.f, 80.f);
+  input.push_back(-kInf);
+  input.push_back(kInf);
+  input.push_back(-100.f);
+  input.push_back(0.f);
+  std::vector<float> out(input.size());
+  Exp(Format::F32, input.data(), out.data(), input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    float expected = std::exp(input[i]);
+    if (expected < std::numeric_limits<float>::min()) {
+      EXPECT_EQ(out[i], 0.f) << "exp(" << input[i] << ")";
+    } else if (std::isinf(expected)) {
+      EXPECT_EQ(out[i], kInf) << "exp(" << input[i] << ")";
+    } else {
+      EXPECT_NEAR(out[i], expected, 2e-6f * expected)
+          << "exp(" << input[i] << ")";
+    }
+  }
+}
+
+TEST_P(HostKernelsTest, SoftmaxF32) {
+  for (size_t n : {1, 7, 37, 1000}) {
+    size_t rows = 3;
+    std::vector<float> input = RandomValues(rows * n, -20.f, 20.f);
+    if (n > 1) input[0] = -kInf;  // A masked logit.
+    std::vector<float> out(input.size());
+    std::vector<float> log_out(input.size());
+    SoftmaxRows(Format::F32, input.data(), out.data(), rows, n, /*log=*/false);
+    SoftmaxRows(Format::F32, input.data(), log_out.data(), rows, n,
+                /*log=*/true);
+    for (size_t r = 0; r < rows; ++r) {
+      const float *row = input.data() + r * n;
+      double max = -kInf;
+      for (size_t i = 0; i < n; ++i) max = std::max<double>(max, row[i]);
+      double sum = 0.0;
+      for (size_t i = 0; i < n; ++i) sum += std::exp(row[i] - max);
+      for (size_t i = 0; i < n; ++i) {
+        double expected = std::exp(row[i] - max) / sum;
+        EXPECT_NEAR(out[r * n + i], expected, 1e-5 * expected + 1e-30)
+            << "n=" << n << " row=" << r << " i=" << i;
+        if (!std::isinf(row[i])) {
+          EXPECT_NEAR(log_out[r * n + i], std::log(expected), 1e-4)
+              << "n=" << n << " row=" << r << " i=" << i;
+        }
+      }
+    }
+  }
+}
+
+TEST_P(HostKernelsTest, SoftmaxInPlaceF16) {
+  size_t n = 50;
+  std::vector<uint16_t> data(n);
+  for (size_t i = 0; i < n; ++i) {
+    data[i] = iree_math_f32_to_f16(static_cast<float>(i) / 10.f);
+  }
+  SoftmaxRows(Format::F16, data.data(), data.data(), 1, n, /*log=*/false);
+  float sum = 0.f;
+  for (size_t i = 0; i < n; ++i) sum += iree_math_f16_to_f32(data[i]);
+  EXPECT_NEAR(sum, 1.f, 1e-2f);
+  EXPECT_GT(iree_math_f16_to_f32(data[n - 1]), iree_math_f16_to_f32(data[0]));
+}
+
+TEST_P(HostKernelsTest, ArgmaxF32) {
+  size_t n = 131;
+  std::vector<float> input = RandomValues(3 * n, -1.f, 1.f);
+  // Row 0: a duplicated maximum resolves to its first occurrence.
+  input[17] = 5.f;
+  input[100] = 5.f;
+  // Row 1: maximum in the partial tail, with NaNs ignored.
+  input[n + 3] = std::numeric_limits<float>::quiet_NaN();
+  input[n + 130] = 7.f;
+  // Row 2: entirely masked.
+  for (size_t i = 0; i < n; ++i) input[2 * n + i] = -kInf;
+  int64_t out[3];
+  ArgmaxRows(Format::F32, input.data(), 3, n, out);
+  EXPECT_EQ(out[0], 17);
+  EXPECT_EQ(out[1], 130);
+  EXPECT_EQ(out[2], 0);
+}
+
+TEST_P(HostKernelsTest, ArgmaxBF16) {
+  size_t n = 40;
+  std::vector<uint16_t> input(n, iree_math_f32_to_bf16(-1.f));
+  input[33] = iree_math_f32_to_bf16(3.f);
+  int64_t out;
+  ArgmaxRows(Format::BF16, input.data(), 1, n, &out);
+  EXPECT_EQ(out, 33);
+}
+
+TEST_P(HostKernelsTest, ArgmaxF16Strided) {
+  size_t n = 37;
+  size_t row_stride = 48;
+  std::vector<uint16_t> input(3 * row_stride, iree_math_f32_to_f16(-2.f));
+  input[5] = iree_math_f32_to_f16(1.f);
+  // Padding past the end of a row is never read as part of it.
+  input[n + 1] = iree_math_f32_to_f16(9.f);
+  input[row_stride + 36] = iree_math_f32_to_f16(0.5f);
+  input[2 * row_stride + 20] = iree_math_f32_to_f16(4.f);
+  input[2 * row_stride + 21] = iree_math_f32_to_f16(4.f);
+  int64_t out[3];
+  ArgmaxRows(Format::F16, input.data(), 3, n, row_stride, out);
+  EXPECT_EQ(out[0], 5);
+  EXPECT_EQ(out[1], 36);
+  EXPECT_EQ(out[2], 20);
+}
+
+// A single arithmetic op rounds once, so the converting kernels must match a
+// scalar reference bit for bit.
+TEST_P(HostKernelsTest, BinaryRoundsLikeScalar) {
+  size_t count = 77;
+  std::vector<float> lhs_f = RandomValues(count, -100.f, 100.f);
+  std::vector<float> rhs_f = RandomValues(count, 0.5f, 3.f);
+  struct FormatCase {
+    Format format;
+    uint16_t (*from_float)(float);
+    float (*to_float)(uint16_t);
+  };
+  for (FormatCase fc :
+       {FormatCase{Format::F16, &iree_math_f32_to_f16, &iree_math_f16_to_f32},
+        FormatCase{Format::BF16, &iree_math_f32_to_bf16,
+                   &iree_math_bf16_to_f32}}) {
+    std::vector<uint16_t> lhs(count), rhs(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+      lhs[i] = fc.from_float(lhs_f[i]);
+      rhs[i] = fc.from_float(rhs_f[i]);
+    }
+    Binary(BinaryOp::DIVIDE, fc.format, lhs.data(), rhs.data(), out.data(),
+           count);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(out[i],
+                fc.from_float(fc.to_float(lhs[i]) / fc.to_float(rhs[i])))
+          << "i=" << i;
+    }
+    BinaryScalar(BinaryOp::SUBTRACT, fc.format, rhs.data(), 2.f,
+                 /*scalar_lhs=*/true, out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(out[i], fc.from_float(2.f - fc.to_float(rhs[i])))
+          << "i=" << i;
+    }
+  }
+}
+
+struct Fp8Case {
+  ConvertFormat format;
+  float (*to_float)(uint8_t);
+  uint8_t (*from_float)(float);
+};
+
+std::vector<Fp8Case> Fp8Cases() {
+  return {
+      {ConvertFormat::F8E4M3FNUZ, &iree_math_f8e4m3fnuz_to_f32,
+       &iree_math_f32_to_f8e4m3fnuz},
+      {ConvertFormat::F8E4M3FN, &iree_math_f8e4m3fn_to_f32,
+       &iree_math_f32_to_f8e4m3fn},
+      {ConvertFormat::F8E5M2, &iree_math_f8e5m2_to_f32,
+       &iree_math_f32_to_f8e5m2},
+  };
+}
+
+TEST_P(HostKernelsTest, ConvertFp8DecodesExactly) {
+  std::vector<uint8_t> codes(256);
+  for (size_t i = 0; i < codes.size(); ++i) codes[i] = static_cast<uint8_t>(i);
+  for (const Fp8Case &fc : Fp8Cases()) {
+    std::vector<float> out(codes.size());
+    Convert(fc.format, ConvertFormat::F32, codes.data(), out.data(),
+            codes.size());
+    std::vector<uint16_t> out_bf16(codes.size());
+    Convert(fc.format, ConvertFormat::BF16, codes.data(), out_bf16.data(),
+            codes.size());
+    for (size_t i = 0; i < codes.size(); ++i) {
+      float expected = fc.to_float(codes[i]);
+      if (std::isnan(expected)) {
+        EXPECT_TRUE(std::isnan(out[i])) << "code=" << i;
+        continue;
+      }
+      EXPECT_EQ(out[i], expected) << "code=" << i;
+      EXPECT_EQ(out_bf16[i], iree_math_f32_to_bf16(expected)) << "code=" << i;
+    }
+  }
+}
+
+TEST_P(HostKernelsTest, ConvertFp8EncodesLikeScalar) {
+  for (const Fp8Case &fc : Fp8Cases()) {
+    std::vector<float> input = RandomValues(301, -600.f, 600.f);
+    std::vector<float> small = RandomValues(301, -0.02f, 0.02f);
+    input.insert(input.end(), small.begin(), small.end());
+    // Exact halfway points between neighboring codes, and the values just
+    // either side of them: the ties must round to even.
+    for (int code = 0; code < 127; ++code) {
+      float lo = fc.to_float(code), hi = fc.to_float(code + 1);
+      if (!std::isfinite(lo) || !std::isfinite(hi)) continue;
+      float mid = lo + (hi - lo) / 2;
+      input.push_back(mid);
+      input.push_back(-mid);
+      input.push_back(std::nextafter(mid, kInf));
+      input.push_back(std::nextafter(mid, -kInf));
+    }
+    input.push_back(kInf);
+    input.push_back(-kInf);
+    input.push_back(std::numeric_limits<float>::quiet_NaN());
+    input.push_back(1e30f);
+    input.push_back(-0.f);
+    std::vector<uint8_t> out(input.size());
+    Convert(ConvertFormat::F32, fc.format, input.data(), out.data(),
+            input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+      EXPECT_EQ(out[i], fc.from_float(input[i])) << "value=" << input[i];
+    }
+    // Through fp16 and between 8 bit formats.
+    std::vector<uint16_t> half(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+      half[i] = iree_math_f32_to_f16(input[i]);
+    }
+    Convert(ConvertFormat::F16, fc.format, half.data(), out.data(),
+            half.size());
+    for (size_t i = 0; i < half.size(); ++i) {
+      EXPECT_EQ(out[i], fc.from_float(iree_math_f16_to_f32(half[i])))
+          << "half=" << half[i];
+    }
+    std::vector<uint8_t> transcoded(out.size());
+    Convert(fc.format, ConvertFormat::F8E5M2, out.data(), transcoded.data(),
+            out.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+      EXPECT_EQ(transcoded[i],
+                iree_math_f32_to_f8e5m2(fc.to_float(out[i])))
+          << "code=" << static_cast<int>(out[i]);
+    }
+  }
+}
+
+TEST_P(HostKernelsTest, ConvertFloatFormats) {
+  std::vector<float> input = RandomValues(77, -1000.f, 1000.f);
+  std::vector<uint16_t> bf16(input.size()), f16(input.size());
+  Convert(ConvertFormat::F32, ConvertFormat::BF16, input.data(), bf16.data(),
+          input.size());
+  Convert(ConvertFormat::BF16, ConvertFormat::F16, bf16.data(), f16.data(),
+          bf16.size());
+  std::vector<float> back(input.size());
+  Convert(ConvertFormat::F16, ConvertFormat::F32, f16.data(), back.data(),
+          f16.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(bf16[i], iree_math_f32_to_bf16(input[i])) << "i=" << i;
+    uint16_t expected_f16 = iree_math_f32_to_f16(iree_math_bf16_to_f32(bf16[i]));
+    EXPECT_EQ(f16[i], expected_f16) << "i=" << i;
+    EXPECT_EQ(back[i], iree_math_f16_to_f32(expected_f16)) << "i=" << i;
+  }
+  // Same format is a copy.
+  std::vector<float> copy(input.size());
+  Convert(ConvertFormat::F32, ConvertFormat::F32, input.data(), copy.data(),
+          input.size());
+  EXPECT_EQ(copy, input);
+}
+
+INSTANTIATE_TEST_SUITE_P(host_kernels, HostKernelsTest,
+                         testing::Values(Isa::SCALAR, Isa::AVX2, Isa::AVX512,
+                                         Isa::NEON),
+                         [](const testing::TestParamInfo<Isa> &info) {
+                           return std::string(IsaName(info.param));
+                         });
+
+}  // namespace
+
+}  // namespace shortfin::array::host_kernels
@@ -6,8 +6,16 @@
 
 #include "shortfin/array/storage.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
 #include "fmt/core.h"
+#include "shortfin/support/iree_concurrency.h"
 #include "shortfin/support/logging.h"
+#include "shortfin/support/sysconfig.h"
 
 namespace shortfin::array {
 
@@ -26,6 +34,181 @@ void ThrowIllegalDeviceAffinity(Device *first, Device *second) {
 }
 }  // namespace detail
 
+namespace {
+
+thread_local const char *current_memory_pool = nullptr;
+
+// Reports the allocation of the |size| bytes of |block| to |pool| (see
+// memory_pool_scope), returning |dtor| extended to report its release. This
+// is a no-op unless allocation tracking is compiled in.
+TimelineResourceDestructor TraceAllocation(const char *pool,
+                                           iree_hal_buffer_t *block,
+                                           iree_device_size_t size,
+                                           TimelineResourceDestructor dtor) {
+#if SHORTFIN_TRACE_ALLOCATIONS
+  SHORTFIN_TRACE_ALLOC_NAMED(pool, block, size);
+  return [pool, block, dtor = std::move(dtor)](TimelineResource &resource) {
+    SHORTFIN_TRACE_FREE_NAMED(pool, block);
+    if (dtor) dtor(resource);
+  };
+#else
+  return dtor;
+#endif
+}
+
+const char *CurrentMemoryPoolOr(const char *default_pool) {
+  return current_memory_pool ? current_memory_pool : default_pool;
+}
+
+// Returns a view of the first |byte_length| bytes of a cached allocation
+// block, or the block itself if it is exactly that size.
+iree::hal_buffer_ptr SubspanBlock(iree::hal_buffer_ptr &block,
+                                  iree_device_size_t byte_length,
+                                  iree_allocator_t host_allocator) {
+  if (iree_hal_buffer_byte_length(block) == byte_length) return block;
+  iree::hal_buffer_ptr view;
+  SHORTFIN_THROW_IF_ERROR(iree_hal_buffer_subspan(
+      block, /*byte_offset=*/0, byte_length, host_allocator, view.for_output()));
+  return view;
+}
+
+// Maps host memory backed by explicit huge pages and imports it into the
+// allocator of the device. Returns null if there are not enough free huge
+// pages or the device cannot import host allocations.
+iree::hal_buffer_ptr AllocateHugePageHostBuffer(
+    ScopedDevice &device, iree_hal_buffer_params_t params,
+    iree_device_size_t allocation_size, sysconfig::HugePages pages) {
+  void *data = sysconfig::MapHugePageMemory(allocation_size, pages);
+  if (!data) return {};
+  // Pages are only populated when first touched, so they can all be bound.
+  int numa_node = device.raw_device()->host_numa_node();
+  if (numa_node >= 0) {
+    sysconfig::PreferNumaNodeForMemory(data, allocation_size, numa_node);
+  }
+
+  struct HugePageMapping {
+    void *data;
+    size_t length;
+    sysconfig::HugePages pages;
+  };
+  auto mapping = std::make_unique<HugePageMapping>(
+      HugePageMapping{data, static_cast<size_t>(allocation_size), pages});
+  iree_hal_buffer_release_callback_t release_callback = {
+      .fn =
+          +[](void *user_data, iree_hal_buffer_t *buffer) {
+            std::unique_ptr<HugePageMapping> mapping(
+                static_cast<HugePageMapping *>(user_data));
+            sysconfig::UnmapHugePageMemory(mapping->data, mapping->length,
+                                           mapping->pages);
+          },
+      .user_data = mapping.get(),
+  };
+  params.type = IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
+                (params.type & IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE);
+  iree_hal_external_buffer_t external_buffer = {
+      .type = IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION,
+      .flags = IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE,
+      .size = allocation_size,
+  };
+  external_buffer.handle.host_allocation.ptr = data;
+  iree::hal_buffer_ptr buffer;
+  iree_status_t status = iree_hal_allocator_import_buffer(
+      iree_hal_device_allocator(device.raw_device()->hal_device()), params,
+      &external_buffer, release_callback, buffer.for_output());
+  if (!iree_status_is_ok(status)) {
+    SHORTFIN_LOG_DEBUG("Could not import huge page host memory into {}",
+                       device.raw_device()->name());
+    iree_status_ignore(status);
+    sysconfig::UnmapHugePageMemory(data, allocation_size, pages);
+    return {};
+  }
+  mapping.release();
+  return buffer;
+}
+
+iree::hal_buffer_ptr AllocateHostBuffer(ScopedDevice &device,
+                                        iree_device_size_t allocation_size,
+                                        bool device_visible) {
+  auto allocator = iree_hal_device_allocator(device.raw_device()->hal_device());
+  iree::hal_buffer_ptr buffer;
+  iree_hal_buffer_params_t params = {
+      .usage = IREE_HAL_BUFFER_USAGE_MAPPING,
+      .access = IREE_HAL_MEMORY_ACCESS_ALL,
+      .type = IREE_HAL_MEMORY_TYPE_OPTIMAL_FOR_HOST,
+      .queue_affinity = device.affinity().queue_affinity(),
+  };
+  if (device_visible) {
+    params.type |= IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE;
+    if (device.affinity().queue_affinity() != 0) {
+      params.usage |= IREE_HAL_BUFFER_USAGE_TRANSFER;
+    }
+  }
+
+  // Only allocations spanning a huge page are worth backing with them.
+  sysconfig::HugePages huge_pages = device.raw_device()->host_huge_pages();
+  size_t huge_page_size = sysconfig::GetHugePageSize(huge_pages);
+  if (huge_page_size && allocation_size >= huge_page_size) {
+    buffer = AllocateHugePageHostBuffer(device, params, allocation_size,
+                                        huge_pages);
+    if (buffer) return buffer;
+    static std::atomic<bool> warned = false;
+    if (!warned.exchange(true)) {
+      logging::warn(
+          "No free {} huge pages for host allocations of {}: Using regular "
+          "pages (reserve them in /sys/kernel/mm/hugepages)",
+          sysconfig::to_string_view(huge_pages), device.raw_device()->name());
+    }
+  }
+  bool advise_huge_pages =
+      huge_pages == sysconfig::HugePages::kTransparent &&
+      allocation_size >=
+          sysconfig::GetHugePageSize(sysconfig::HugePages::k2MB);
+
+  // Pages which the allocator populates (i.e. by pinning them) follow the
+  // thread's policy during the call, and the rest are bound when first
+  // touched.
+  int numa_node = device.raw_device()->host_numa_node();
+  {
+    sysconfig::ScopedPreferredNumaNode numa_scope(numa_node);
+    SHORTFIN_THROW_IF_ERROR(iree_hal_allocator_allocate_buffer(
+        allocator, params, allocation_size, buffer.for_output()));
+  }
+  if (numa_node >= 0 || advise_huge_pages) {
+    iree_hal_buffer_mapping_t mapping;
+    iree_status_t status = iree_hal_buffer_map_range(
+        buffer, IREE_HAL_MAPPING_MODE_SCOPED, IREE_HAL_MEMORY_ACCESS_READ,
+        /*byte_offset=*/0, IREE_HAL_WHOLE_BUFFER, &mapping);
+    if (iree_status_is_ok(status)) {
+      if (numa_node >= 0) {
+        sysconfig::PreferNumaNodeForMemory(
+            mapping.contents.data, mapping.contents.data_length, numa_node);
+      }
+      if (advise_huge_pages) {
+        sysconfig::AdviseMemory(mapping.contents.data,
+                                mapping.contents.data_length,
+                                sysconfig::AccessHint::kHugePages);
+      }
+      status = iree_hal_buffer_unmap_range(&mapping);
+    }
+    iree_status_ignore(status);
+  }
+  return buffer;
+}
+
+}  // namespace
+
+memory_pool_scope::memory_pool_scope(std::string_view name)
+    : previous_(current_memory_pool) {
+  static iree::slim_mutex lock;
+  static std::unordered_set<std::string> names;
+  iree::slim_mutex_lock_guard guard(lock);
+  current_memory_pool = names.emplace(name).first->c_str();
+}
+
+memory_pool_scope::~memory_pool_scope() { current_memory_pool = previous_; }
+
+const char *memory_pool_scope::current() { return current_memory_pool; }
+
 storage::storage(local::ScopedDevice device, iree::hal_buffer_ptr buffer,
                  local::detail::TimelineResource::Ref timeline_resource)
     : timeline_resource_(std::move(timeline_resource)),
@@ -49,14 +232,51 @@ storage storage::allocate_device(ScopedDevice &device,
   if (!device.raw_device()) {
     throw std::invalid_argument("Cannot allocate with a null device affinity");
   }
+  if (device.raw_device()->unified_memory()) {
+    return allocate_unified(device, allocation_size);
+  }
+  Scheduler &scheduler = device.fiber().scheduler();
+  Account &account = scheduler.GetDefaultAccount(device);
+  iree_hal_queue_affinity_t queue_affinity = device.affinity().queue_affinity();
+  bool cacheable = scheduler.buffer_cache().max_bytes != 0;
+  iree_device_size_t block_size =
+      cacheable ? scheduler.BufferCacheSizeClass(allocation_size)
+                : allocation_size;
+
+  // Reuse a cached buffer if possible, ordering after its last use.
   iree::hal_buffer_ptr buffer;
+  iree::hal_semaphore_ptr ready_sem;
+  uint64_t ready_timepoint = 0;
+  if (cacheable && account.TakeCachedBuffer(queue_affinity, block_size, buffer,
+                                            ready_sem, ready_timepoint)) {
+    SHORTFIN_SCHED_LOG(
+        "storage::allocate_device(affinity={:x}):[cached, Ready:{}@{}] -> "
+        "buffer={}",
+        queue_affinity, static_cast<void *>(ready_sem.get()), ready_timepoint,
+        static_cast<void *>(buffer.get()));
+    TimelineResourceDestructor dtor = TraceAllocation(
+        CurrentMemoryPoolOr("shortfin.device"), buffer.get(), block_size,
+        TimelineResource::CreateAsyncBufferDestructor(device, buffer,
+                                                      /*cacheable=*/true));
+    auto resource = device.fiber().NewTimelineResource(std::move(dtor));
+    if (ready_sem) {
+      iree_hal_semaphore_t *sem = ready_sem.get();
+      resource->ImportBarrier(
+          iree_hal_semaphore_list_t{
+              .count = 1, .semaphores = &sem, .payload_values = &ready_timepoint},
+          /*write=*/true);
+    }
+    auto view =
+        SubspanBlock(buffer, allocation_size, resource->host_allocator());
+    return storage(device, std::move(view), std::move(resource));
+  }
+
   iree_hal_buffer_params_t params = {
       .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
       .access = IREE_HAL_MEMORY_ACCESS_ALL,
       .type = IREE_HAL_MEMORY_TYPE_OPTIMAL_FOR_DEVICE,
-      .queue_affinity = device.affinity().queue_affinity(),
+      .queue_affinity = queue_affinity,
   };
-  Account &account = device.fiber().scheduler().GetDefaultAccount(device);
   iree_hal_semaphore_t *timeline_sem = account.timeline_sem();
   uint64_t current_timepoint = account.timeline_idle_timepoint();
   uint64_t signal_timepoint = account.timeline_acquire_timepoint();
@@ -71,27 +291,66 @@ storage storage::allocate_device(ScopedDevice &device,
       .payload_values = &signal_timepoint,
   };
   // Async allocate.
-  SHORTFIN_THROW_IF_ERROR(iree_hal_device_queue_alloca(
-      device.raw_device()->hal_device(), device.affinity().queue_affinity(),
-      wait_semaphore_list, signal_semaphore_list,
-      IREE_HAL_ALLOCATOR_POOL_DEFAULT, params, allocation_size,
-      IREE_HAL_ALLOCA_FLAG_NONE, buffer.for_output()));
+  auto alloca = [&]() {
+    return iree_hal_device_queue_alloca(
+        device.raw_device()->hal_device(), queue_affinity, wait_semaphore_list,
+        signal_semaphore_list, IREE_HAL_ALLOCATOR_POOL_DEFAULT, params,
+        block_size, IREE_HAL_ALLOCA_FLAG_NONE, buffer.for_output());
+  };
+  iree_status_t status = alloca();
+  if (cacheable && iree_status_is_resource_exhausted(status)) {
+    // Under memory pressure, give back everything cached and retry.
+    iree_status_ignore(status);
+    SHORTFIN_SCHED_LOG("storage::allocate_device: trim cache and retry");
+    scheduler.TrimBufferCaches();
+    scheduler.Flush(FlushReason::SYNC);
+    status = alloca();
+  }
+  SHORTFIN_THROW_IF_ERROR(status);
   SHORTFIN_SCHED_LOG(
       "storage::allocate_device(device={}, affinity={:x}):[{}, Wait@{}->"
       "Signal:@{}] -> buffer={}",
-      static_cast<void *>(device.raw_device()->hal_device()),
-      device.affinity().queue_affinity(), static_cast<void *>(timeline_sem),
-      current_timepoint, signal_timepoint, static_cast<void *>(buffer.get()));
+      static_cast<void *>(device.raw_device()->hal_device()), queue_affinity,
+      static_cast<void *>(timeline_sem), current_timepoint, signal_timepoint,
+      static_cast<void *>(buffer.get()));
 
   // Device allocations are always async.
-  TimelineResourceDestructor dtor =
-      TimelineResource::CreateAsyncBufferDestructor(device, buffer);
+  TimelineResourceDestructor dtor = TraceAllocation(
+      CurrentMemoryPoolOr("shortfin.device"), buffer.get(), block_size,
+      TimelineResource::CreateAsyncBufferDestructor(device, buffer, cacheable));
   auto resource = device.fiber().NewTimelineResource(std::move(dtor));
   resource->set_mutation_barrier(timeline_sem, signal_timepoint);
   resource->use_barrier_insert(timeline_sem, signal_timepoint);
+  if (cacheable) {
+    buffer = SubspanBlock(buffer, allocation_size, resource->host_allocator());
+  }
   return storage(device, std::move(buffer), std::move(resource));
 }
 
+storage storage::allocate_unified(ScopedDevice &device,
+                                  iree_device_size_t allocation_size) {
+  SHORTFIN_TRACE_SCOPE_NAMED("storage::allocate_unified");
+  if (!device.raw_device()) {
+    throw std::invalid_argument("Cannot allocate with a null device affinity");
+  }
+  auto allocator = iree_hal_device_allocator(device.raw_device()->hal_device());
+  iree_hal_buffer_params_t params = {
+      .usage = IREE_HAL_BUFFER_USAGE_DEFAULT | IREE_HAL_BUFFER_USAGE_MAPPING,
+      .access = IREE_HAL_MEMORY_ACCESS_ALL,
+      .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL |
+              IREE_HAL_MEMORY_TYPE_HOST_VISIBLE,
+      .queue_affinity = device.affinity().queue_affinity(),
+  };
+  iree::hal_buffer_ptr buffer;
+  SHORTFIN_THROW_IF_ERROR(iree_hal_allocator_allocate_buffer(
+      allocator, params, allocation_size, buffer.for_output()));
+  TimelineResourceDestructor dtor =
+      TraceAllocation(CurrentMemoryPoolOr("shortfin.device"), buffer.get(),
+                      allocation_size, nullptr);
+  return storage(device, std::move(buffer),
+                 device.fiber().NewTimelineResource(std::move(dtor)));
+}
+
 storage storage::allocate_host(ScopedDevice &device,
                                iree_device_size_t allocation_size,
                                bool device_visible) {
@@ -99,26 +358,85 @@ storage storage::allocate_host(ScopedDevice &device,
   if (!device.raw_device()) {
     throw std::invalid_argument("Cannot allocate with a null device affinity");
   }
+  iree::hal_buffer_ptr buffer =
+      AllocateHostBuffer(device, allocation_size, device_visible);
+  TimelineResourceDestructor dtor =
+      TraceAllocation(CurrentMemoryPoolOr("shortfin.host"), buffer.get(),
+                      allocation_size, nullptr);
+  return storage(device, std::move(buffer),
+                 device.fiber().NewTimelineResource(std::move(dtor)));
+}
+
+storage storage::import_host_allocation(
+    ScopedDevice &device, void *host_ptr, iree_device_size_t byte_length,
+    iree_hal_buffer_release_callback_t release_callback) {
+  SHORTFIN_TRACE_SCOPE_NAMED("storage::import_host_allocation");
+  if (!device.raw_device()) {
+    throw std::invalid_argument("Cannot import with a null device affinity");
+  }
   auto allocator = iree_hal_device_allocator(device.raw_device()->hal_device());
-  iree::hal_buffer_ptr buffer;
   iree_hal_buffer_params_t params = {
-      .usage = IREE_HAL_BUFFER_USAGE_MAPPING,
+      .usage = IREE_HAL_BUFFER_USAGE_DEFAULT | IREE_HAL_BUFFER_USAGE_MAPPING,
       .access = IREE_HAL_MEMORY_ACCESS_ALL,
-      .type = IREE_HAL_MEMORY_TYPE_OPTIMAL_FOR_HOST,
+      .type = IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
+              IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
       .queue_affinity = device.affinity().queue_affinity(),
   };
-  if (device_visible) {
-    params.type |= IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE;
-    if (device.affinity().queue_affinity() != 0) {
-      params.usage |= IREE_HAL_BUFFER_USAGE_TRANSFER;
-    }
+  iree_hal_external_buffer_t external_buffer = {
+      .type = IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION,
+      .flags = IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE,
+      .size = byte_length,
+  };
+  external_buffer.handle.host_allocation.ptr = host_ptr;
+  iree::hal_buffer_ptr buffer;
+  SHORTFIN_THROW_IF_ERROR(iree_hal_allocator_import_buffer(
+      allocator, params, &external_buffer, release_callback,
+      buffer.for_output()));
+  return storage(device, std::move(buffer),
+                 device.fiber().NewTimelineResource());
+}
+
+storage storage::import_ipc_handle(ScopedDevice &device,
+                                   const local::IpcMemoryHandle &handle) {
+  SHORTFIN_TRACE_SCOPE_NAMED("storage::import_ipc_handle");
+  if (!device.raw_device()) {
+    throw std::invalid_argument("Cannot import with a null device affinity");
   }
-  SHORTFIN_THROW_IF_ERROR(iree_hal_allocator_allocate_buffer(
-      allocator, params, allocation_size, buffer.for_output()));
+  iree::hal_buffer_ptr buffer = device.raw_device()->ImportIpcMemory(handle);
   return storage(device, std::move(buffer),
                  device.fiber().NewTimelineResource());
 }
 
+local::IpcMemoryHandle storage::export_ipc_handle() const {
+  if (!device_.raw_device()) {
+    throw std::invalid_argument("Cannot export storage without a device");
+  }
+  return device_.raw_device()->ExportIpcMemory(buffer_.get());
+}
+
+storage storage::allocate_staging(ScopedDevice &device,
+                                  iree_device_size_t allocation_size) {
+  SHORTFIN_TRACE_SCOPE_NAMED("storage::allocate_staging");
+  auto &ring = device.fiber().scheduler().staging_ring();
+  if (ring.max_buffers == 0 || !device.raw_device()) {
+    return allocate_host(device, allocation_size);
+  }
+  Account &account = device.fiber().scheduler().GetDefaultAccount(device);
+  iree_device_size_t size_class =
+      RoundToSizeClass(allocation_size, ring.min_block_size);
+  iree::hal_buffer_ptr block;
+  if (!account.TakeStagingBuffer(device.affinity().queue_affinity(),
+                                 size_class, block)) {
+    block = AllocateHostBuffer(device, size_class, /*device_visible=*/true);
+  }
+  TimelineResourceDestructor dtor = TraceAllocation(
+      "shortfin.staging", block.get(), size_class,
+      TimelineResource::CreateStagingBufferDestructor(device, block));
+  auto resource = device.fiber().NewTimelineResource(std::move(dtor));
+  auto view = SubspanBlock(block, allocation_size, resource->host_allocator());
+  return storage(device, std::move(view), std::move(resource));
+}
+
 storage storage::subspan(iree_device_size_t byte_offset,
                          iree_device_size_t byte_length) {
   storage new_storage(device_, {}, timeline_resource_);
@@ -128,62 +446,203 @@ storage storage::subspan(iree_device_size_t byte_offset,
   return new_storage;
 }
 
+exported_storage storage::export_shared() {
+  exported_storage exported;
+  exported.buffer_ =
+      iree::hal_buffer_ptr::borrow_reference(buffer_.get());
+  exported.barrier_ = export_barrier();
+  return exported;
+}
+
+storage storage::import_shared(ScopedDevice &device,
+                               const exported_storage &exported) {
+  SHORTFIN_TRACE_SCOPE_NAMED("storage::import_shared");
+  if (!device.raw_device()) {
+    throw std::invalid_argument("Cannot import with a null device affinity");
+  }
+  // The allocation remains owned by the exporter, so the imported resource
+  // has no destructor and simply drops its buffer reference.
+  auto resource = device.fiber().NewTimelineResource();
+  resource->ImportBarrier(exported.barrier_.semaphore_list(), /*write=*/true);
+  return storage(device, exported.buffer_, std::move(resource));
+}
+
+local::detail::ExportedBarrier storage::export_barrier(bool include_uses) {
+  if (timeline_resource_->range_tracking()) {
+    return local::detail::ExportedBarrier(
+        timeline_resource_->range_barrier(resource_range(), include_uses));
+  }
+  return timeline_resource_->ExportBarrier(include_uses);
+}
+
+void storage::import_barrier(const local::detail::ExportedBarrier &barrier,
+                             bool write) {
+  timeline_resource_->ImportBarrier(barrier.semaphore_list(), write);
+}
+
+std::string exported_storage::to_s() const {
+  return fmt::format("exported_storage(buffer={}, barrier={})",
+                     static_cast<void *>(buffer_.get()), barrier_.to_s());
+}
+
 void storage::fill(const void *pattern, iree_host_size_t pattern_length) {
   device_.fiber().scheduler().AppendCommandBuffer(
       device_, TransactionType::TRANSFER, [&](Account &account) {
         // Must depend on all of this buffer's use dependencies to avoid
         // write-after-read hazard (which implicitly includes
         // write-after-write).
-        account.active_deps_extend(timeline_resource_->use_barrier());
+        bool range_tracking = timeline_resource_->range_tracking();
+        account.active_deps_extend(
+            range_tracking ? timeline_resource_->range_barrier(
+                                 resource_range(), /*write=*/true)
+                           : timeline_resource_->use_barrier());
 
         SHORTFIN_SCHED_LOG("  : FillBuffer({})",
                            static_cast<void *>(buffer_.get()));
         SHORTFIN_THROW_IF_ERROR(iree_hal_command_buffer_fill_buffer(
             account.active_command_buffer(),
-            iree_hal_make_buffer_ref(
+            account.record_buffer_ref(
                 buffer_, /*offset=*/0,
-                /*length=*/iree_hal_buffer_byte_length(buffer_)),
+                /*length=*/iree_hal_buffer_byte_length(buffer_),
+                /*write=*/true),
             pattern, pattern_length, IREE_HAL_FILL_FLAG_NONE));
 
         // And move our own use and mutation barrier to the current pending
         // timeline value.
-        timeline_resource_->set_mutation_barrier(
-            account.timeline_sem(), account.timeline_idle_timepoint());
-        timeline_resource_->use_barrier_insert(
-            account.timeline_sem(), account.timeline_idle_timepoint());
+        if (range_tracking) {
+          timeline_resource_->range_insert(resource_range(), /*write=*/true,
+                                           account.timeline_sem(),
+                                           account.timeline_idle_timepoint());
+        } else {
+          timeline_resource_->set_mutation_barrier(
+              account.timeline_sem(), account.timeline_idle_timepoint());
+          timeline_resource_->use_barrier_insert(
+              account.timeline_sem(), account.timeline_idle_timepoint());
+        }
       });
 }
 
 void storage::copy_from(storage &source_storage) {
+  copy_region region{
+      .source_offset = 0, .target_offset = 0, .length = byte_length()};
+  copy_from(source_storage, std::span<const copy_region>(&region, 1));
+}
+
+void storage::copy_from(storage &source_storage,
+                        std::span<const copy_region> regions) {
+  // Copies of memory onto itself (i.e. between a unified array and its
+  // transfer alias) have nothing to do.
+  iree_hal_buffer_t *source_buffer = source_storage.buffer_.get();
+  iree_hal_buffer_t *target_buffer = buffer_.get();
+  if (iree_hal_buffer_allocated_buffer(source_buffer) ==
+          iree_hal_buffer_allocated_buffer(target_buffer) &&
+      std::ranges::all_of(regions, [&](const copy_region &region) {
+        return iree_hal_buffer_byte_offset(source_buffer) +
+                   region.source_offset ==
+               iree_hal_buffer_byte_offset(target_buffer) +
+                   region.target_offset;
+      })) {
+    return;
+  }
+  if (!RequiresStagedCopyFrom(source_storage)) {
+    CopyFromDirect(source_storage, regions);
+    return;
+  }
+
+  // Pack the regions into a host staging buffer on the source's device, and
+  // copy from there. Host staging memory is accessible to every device, and
+  // the second copy waits on the first through the staging buffer's barrier.
+  SHORTFIN_TRACE_SCOPE_NAMED("storage::copy_from[staged]");
+  iree_device_size_t staging_length = 0;
+  for (const copy_region &region : regions) staging_length += region.length;
+  if (staging_length == 0) return;
+  std::vector<copy_region> to_staging;
+  std::vector<copy_region> from_staging;
+  to_staging.reserve(regions.size());
+  from_staging.reserve(regions.size());
+  iree_device_size_t staging_offset = 0;
+  for (const copy_region &region : regions) {
+    to_staging.push_back(copy_region{.source_offset = region.source_offset,
+                                     .target_offset = staging_offset,
+                                     .length = region.length});
+    from_staging.push_back(copy_region{.source_offset = staging_offset,
+                                       .target_offset = region.target_offset,
+                                       .length = region.length});
+    staging_offset += region.length;
+  }
+  storage staging = allocate_staging(source_storage.device(), staging_length);
+  staging.CopyFromDirect(source_storage, to_staging);
+  CopyFromDirect(staging, from_staging);
+}
+
+bool storage::RequiresStagedCopyFrom(storage &source_storage) {
+  Device *device = device_.raw_device();
+  Device *source_device = source_storage.device_.raw_device();
+  if (!device || !source_device || device->CanAccessPeer(*source_device)) {
+    return false;
+  }
+  // Host memory is visible to all devices.
+  return !(source_storage.memory_type() & IREE_HAL_MEMORY_TYPE_HOST_LOCAL);
+}
+
+void storage::CopyFromDirect(storage &source_storage,
+                             std::span<const copy_region> regions) {
   device_.fiber().scheduler().AppendCommandBuffer(
       device_, TransactionType::TRANSFER, [&](Account &account) {
+        TimelineResource *source_resource =
+            source_storage.timeline_resource_.get();
+        TimelineResource *target_resource = timeline_resource_.get();
         // Must depend on the source's mutation dependencies to avoid
         // read-before-write hazard.
         account.active_deps_extend(
-            source_storage.timeline_resource_->mutation_barrier());
+            source_resource->range_tracking()
+                ? source_resource->range_barrier(
+                      source_storage.resource_range(), /*write=*/false)
+                : source_resource->mutation_barrier());
         // And depend on our own use and mutations dependencies.
-        account.active_deps_extend(timeline_resource_->use_barrier());
+        account.active_deps_extend(
+            target_resource->range_tracking()
+                ? target_resource->range_barrier(resource_range(),
+                                                 /*write=*/true)
+                : target_resource->use_barrier());
 
-        SHORTFIN_SCHED_LOG("  : CopyBuffer({} -> {})",
+        SHORTFIN_SCHED_LOG("  : CopyBuffer({} -> {}, regions={})",
                            static_cast<void *>(source_storage.buffer_.get()),
-                           static_cast<void *>(buffer_.get()));
-        SHORTFIN_THROW_IF_ERROR(iree_hal_command_buffer_copy_buffer(
-            account.active_command_buffer(),
-            /*source_ref=*/
-            iree_hal_make_buffer_ref(source_storage.buffer_, 0, byte_length()),
-            /*target_ref=*/
-            iree_hal_make_buffer_ref(buffer_, 0, byte_length()),
-            IREE_HAL_COPY_FLAG_NONE));
+                           static_cast<void *>(buffer_.get()), regions.size());
+        for (const copy_region &region : regions) {
+          SHORTFIN_THROW_IF_ERROR(iree_hal_command_buffer_copy_buffer(
+              account.active_command_buffer(),
+              /*source_ref=*/
+              account.record_buffer_ref(source_storage.buffer_,
+                                        region.source_offset, region.length,
+                                        /*write=*/false),
+              /*target_ref=*/
+              account.record_buffer_ref(buffer_, region.target_offset,
+                                        region.length, /*write=*/true),
+              IREE_HAL_COPY_FLAG_NONE));
+        }
 
         // Move our own use and mutation barrier to the current pending timeline
         // value.
-        timeline_resource_->set_mutation_barrier(
-            account.timeline_sem(), account.timeline_idle_timepoint());
-        timeline_resource_->use_barrier_insert(
-            account.timeline_sem(), account.timeline_idle_timepoint());
+        if (target_resource->range_tracking()) {
+          target_resource->range_insert(resource_range(), /*write=*/true,
+                                        account.timeline_sem(),
+                                        account.timeline_idle_timepoint());
+        } else {
+          target_resource->set_mutation_barrier(
+              account.timeline_sem(), account.timeline_idle_timepoint());
+          target_resource->use_barrier_insert(
+              account.timeline_sem(), account.timeline_idle_timepoint());
+        }
         // And extend the source use barrier.
-        source_storage.timeline_resource_->use_barrier_insert(
-            account.timeline_sem(), account.timeline_idle_timepoint());
+        if (source_resource->range_tracking()) {
+          source_resource->range_insert(
+              source_storage.resource_range(), /*write=*/false,
+              account.timeline_sem(), account.timeline_idle_timepoint());
+        } else {
+          source_resource->use_barrier_insert(
+              account.timeline_sem(), account.timeline_idle_timepoint());
+        }
       });
 }
 
@@ -194,6 +653,14 @@ bool storage::is_mappable_for_read() const {
           IREE_HAL_MEMORY_ACCESS_READ);
 }
 
+bool storage::is_unified() const {
+  return iree_all_bits_set(memory_type(),
+                           IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL |
+                               IREE_HAL_MEMORY_TYPE_HOST_VISIBLE) &&
+         iree_all_bits_set(buffer_usage(),
+                           IREE_HAL_BUFFER_USAGE_MAPPING_SCOPED);
+}
+
 bool storage::is_mappable_for_read_write() const {
   return (iree_hal_buffer_allowed_usage(buffer_) &
           IREE_HAL_MEMORY_TYPE_HOST_VISIBLE) &&
@@ -201,14 +668,54 @@ bool storage::is_mappable_for_read_write() const {
           (IREE_HAL_MEMORY_ACCESS_READ | IREE_HAL_MEMORY_ACCESS_WRITE));
 }
 
-void storage::map_explicit(mapping &mapping, iree_hal_memory_access_t access) {
-  assert(access != IREE_HAL_MEMORY_ACCESS_NONE);
+iree_status_t storage::MapRange(mapping &mapping,
+                                iree_hal_memory_access_t access) noexcept {
   mapping.reset();
-  SHORTFIN_THROW_IF_ERROR(iree_hal_buffer_map_range(
+  IREE_RETURN_IF_ERROR(iree_hal_buffer_map_range(
       buffer_, IREE_HAL_MAPPING_MODE_SCOPED, access,
       /*byte_offset=*/0, byte_length(), &mapping.mapping_));
   mapping.access_ = access;
   mapping.timeline_resource_ = timeline_resource_;
+  return iree_ok_status();
+}
+
+void storage::map_explicit(mapping &mapping, iree_hal_memory_access_t access) {
+  assert(access != IREE_HAL_MEMORY_ACCESS_NONE);
+  SHORTFIN_THROW_IF_ERROR(MapRange(mapping, access));
+}
+
+local::TypedFuture<mapping> storage::map_async(
+    iree_hal_memory_access_t access) {
+  SHORTFIN_TRACE_SCOPE_NAMED("storage::map_async");
+  assert(access != IREE_HAL_MEMORY_ACCESS_NONE);
+  bool write = access & IREE_HAL_MEMORY_ACCESS_WRITE;
+  iree_hal_semaphore_list_t barrier =
+      timeline_resource_->range_tracking()
+          ? timeline_resource_->range_barrier(resource_range(), write)
+          : (write ? timeline_resource_->use_barrier()
+                   : timeline_resource_->mutation_barrier());
+  local::VoidFuture ready = fiber().scheduler().OnBarrier(barrier);
+
+  local::TypedFuture<mapping> result;
+  // The callback runs on this fiber's worker and holds a copy of the storage
+  // so that the buffer outlives the wait.
+  ready.AddCallback([self = *this, access,
+                     result](local::Future &ready) mutable {
+    try {
+      ready.ThrowFailure();
+    } catch (iree::error &e) {
+      result.set_failure(iree_make_status(e.code(), "%s", e.what()));
+      return;
+    }
+    mapping m;
+    iree_status_t status = self.MapRange(m, access);
+    if (iree_status_is_ok(status)) {
+      result.set_result(std::move(m));
+    } else {
+      result.set_failure(status);
+    }
+  });
+  return result;
 }
 
 iree_hal_memory_type_t storage::memory_type() const {
@@ -245,7 +752,8 @@ void storage::AddAsInvocationArgument(local::ProgramInvocation *inv,
   SHORTFIN_TRACE_SCOPE_NAMED("storage::AddAsInvocationArgument");
   iree::vm_opaque_ref ref;
   *(&ref) = iree_hal_buffer_retain_ref(buffer_);
-  inv->AddArg(std::move(ref), timeline_resource_.get());
+  inv->AddArg(std::move(ref), timeline_resource_.get(), resource_range(),
+              /*write=*/barrier == ProgramResourceBarrier::WRITE);
 
   AddInvocationArgBarrier(inv, barrier);
 }
@@ -298,6 +806,14 @@ storage storage::ImportInvocationResultStorage(
 void storage::AddInvocationArgBarrier(local::ProgramInvocation *inv,
                                       local::ProgramResourceBarrier barrier) {
   SHORTFIN_TRACE_SCOPE_NAMED("storage::AddInvocationArgBarrier");
+  if (timeline_resource_->range_tracking() &&
+      barrier != ProgramResourceBarrier::NONE) {
+    inv->wait_insert(timeline_resource_->range_barrier(
+        resource_range(),
+        /*write=*/barrier == ProgramResourceBarrier::WRITE));
+    inv->DeviceSelect(device_.affinity());
+    return;
+  }
   switch (barrier) {
     case ProgramResourceBarrier::DEFAULT:
     case ProgramResourceBarrier::READ:
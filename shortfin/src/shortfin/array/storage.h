@@ -7,6 +7,7 @@
 #ifndef SHORTFIN_ARRAY_STORAGE_H
 #define SHORTFIN_ARRAY_STORAGE_H
 
+#include <span>
 #include <string_view>
 
 #include "shortfin/local/fiber.h"
@@ -70,6 +71,21 @@ class SHORTFIN_API mapping {
   friend class storage;
 };
 
+// A storage exported for import by a different fiber (possibly on another
+// worker thread). Holds a retained reference to the buffer and the barrier
+// at which its contents are available. See storage::export_shared().
+class SHORTFIN_API exported_storage {
+ public:
+  iree_hal_buffer_t *buffer() const { return buffer_.get(); }
+  const local::detail::ExportedBarrier &barrier() const { return barrier_; }
+  std::string to_s() const;
+
+ private:
+  iree::hal_buffer_ptr buffer_;
+  local::detail::ExportedBarrier barrier_;
+  friend class storage;
+};
+
 // Array storage backed by an IREE buffer of some form.
 class SHORTFIN_API storage : public local::ProgramInvocationMarshalable {
  public:
@@ -80,10 +96,19 @@ class SHORTFIN_API storage : public local::ProgramInvocationMarshalable {
   local::Fiber &fiber() const { return device_.fiber(); }
 
   // Allocates device storage, compatible with the given device affinity.
-  // By default, this will be IREE_HAL_MEMORY_TYPE_OPTIMAL_FOR_DEVICE.
+  // By default, this will be IREE_HAL_MEMORY_TYPE_OPTIMAL_FOR_DEVICE. On
+  // devices in unified memory mode (see Device::unified_memory()), this is
+  // allocate_unified().
   static storage allocate_device(local::ScopedDevice &device,
                                  iree_device_size_t allocation_size);
 
+  // Allocates device local storage that the host can map in place, for
+  // devices sharing their memory with the host (i.e. APUs). Transfers for the
+  // host (device_array::for_transfer) alias the storage instead of staging a
+  // copy. Allocation is synchronous and does not use the buffer cache.
+  static storage allocate_unified(local::ScopedDevice &device,
+                                  iree_device_size_t allocation_size);
+
   // Allocates host storage, compatible with the given device affinity.
   // By default, if there are any affinity bits set in the device, then
   // the storage will be device visible and have permitted usage for
@@ -94,6 +119,36 @@ class SHORTFIN_API storage : public local::ProgramInvocationMarshalable {
                                iree_device_size_t allocation_size,
                                bool device_visible = true);
 
+  // Allocates device visible host storage for staging transfers, drawn from
+  // the device's staging ring (see local::detail::Scheduler::StagingRing)
+  // when enabled. The buffer returns to the ring when the storage is
+  // released and is reused once its last transfer has completed.
+  static storage allocate_staging(local::ScopedDevice &device,
+                                  iree_device_size_t allocation_size);
+
+  // Wraps externally owned host memory as storage without copying. The
+  // memory must stay valid until |release_callback| is invoked, which happens
+  // when the last reference to the buffer (including any held by in-flight
+  // device work) is dropped. Fails if the device cannot import host
+  // allocations.
+  static storage import_host_allocation(
+      local::ScopedDevice &device, void *host_ptr,
+      iree_device_size_t byte_length,
+      iree_hal_buffer_release_callback_t release_callback);
+
+  // Imports device memory exported by another process on the same host (see
+  // export_ipc_handle()) as read only storage, so that processes serving
+  // replicas of a program can share one copy of its weights. Throws
+  // std::invalid_argument if the device cannot import the handle.
+  static storage import_ipc_handle(local::ScopedDevice &device,
+                                   const local::IpcMemoryHandle &handle);
+
+  // Exports this storage for import by other processes. The storage must stay
+  // alive, with its contents unchanged, while other processes use it. Since
+  // they cannot wait on this process's timeline, its contents must be
+  // complete (i.e. the device has been awaited) before the handle is sent.
+  local::IpcMemoryHandle export_ipc_handle() const;
+
   // Creates a subspan view of the current storage given a byte offset and
   // length. The returned storage shares the underlying allocation and
   // scheduling control block.
@@ -105,9 +160,49 @@ class SHORTFIN_API storage : public local::ProgramInvocationMarshalable {
   void fill(const void *pattern, iree_host_size_t pattern_length);
 
   // Performs either a d2h, h2d or d2d transfer from a source storage to this
-  // storage.
+  // storage. The transfer is issued on this storage's device. When the source
+  // is device local memory of a different physical device, it is read
+  // directly if this device can access it as a peer (see
+  // Device::CanAccessPeer). Otherwise it is first copied on the source's
+  // device into a staging buffer, which this device then copies from. Either
+  // way, the copy waits device-side on the source's barrier.
   void copy_from(storage &source_storage);
 
+  // A byte range for copy_from(source_storage, regions). Offsets are relative
+  // to the start of the source and target storage respectively.
+  struct copy_region {
+    iree_device_size_t source_offset;
+    iree_device_size_t target_offset;
+    iree_device_size_t length;
+  };
+  // Same as copy_from(source_storage) but only transfers the given regions,
+  // recording one copy command per region into a single transfer.
+  void copy_from(storage &source_storage,
+                 std::span<const copy_region> regions);
+
+  // Cross fiber sharing without a host synchronization. export_shared()
+  // captures the buffer along with the barrier at which its current contents
+  // are available. The result may be passed to another fiber, which calls
+  // import_shared() with a device on the same physical device to get a
+  // storage whose accesses wait device-side on that barrier.
+  // The exporting storage continues to own the allocation: before it is
+  // released or mutated again, the importer must hand its uses back via
+  // export_barrier(/*include_uses=*/true) on its storage and
+  // import_barrier(..., /*write=*/false) on the exporter (or by any other
+  // means ensure that it has finished with the buffer).
+  exported_storage export_shared();
+  static storage import_shared(local::ScopedDevice &device,
+                               const exported_storage &exported);
+
+  // Snapshots the barrier that another fiber must wait on before reading (or,
+  // if |include_uses|, writing) this storage.
+  local::detail::ExportedBarrier export_barrier(bool include_uses = false);
+  // Orders subsequent accesses to this storage after an access made by
+  // another fiber, completing at |barrier|. See
+  // TimelineResource::ImportBarrier.
+  void import_barrier(const local::detail::ExportedBarrier &barrier,
+                      bool write);
+
   iree_device_size_t byte_length() const {
     return iree_hal_buffer_byte_length(buffer_.get());
   }
@@ -125,6 +220,9 @@ class SHORTFIN_API storage : public local::ProgramInvocationMarshalable {
   // Whether the buffer supports host mappable memory.
   bool is_mappable_for_read() const;
   bool is_mappable_for_read_write() const;
+  // Whether the buffer is device local memory that the host can map in place
+  // (see allocate_unified).
+  bool is_unified() const;
 
   // Maps the memory for access from a host pointer using a scoped mapping.
   void map_explicit(mapping &mapping, iree_hal_memory_access_t access);
@@ -157,6 +255,14 @@ class SHORTFIN_API storage : public local::ProgramInvocationMarshalable {
     return m;
   }
 
+  // Maps the memory without blocking the worker. The returned future resolves
+  // to the mapping once prior device work has reached the storage's barrier:
+  // the mutation barrier for reads and the use barrier for writes (so that
+  // host writes do not race in-flight device reads). Unlike map_explicit(),
+  // which assumes the caller has already synchronized, this lets the host
+  // consume the results of one step while the device runs the next.
+  local::TypedFuture<mapping> map_async(iree_hal_memory_access_t access);
+
   std::string to_s() const;
 
   bool operator==(const storage &other) const {
@@ -172,10 +278,42 @@ class SHORTFIN_API storage : public local::ProgramInvocationMarshalable {
     return timeline_resource_->host_allocator();
   }
 
+  // Opts the underlying allocation (shared by all subspans) into subrange
+  // scheduling: transfers and invocations touching disjoint byte ranges of
+  // the allocation are not ordered against each other. See
+  // TimelineResource::enable_range_tracking().
+  void enable_subrange_tracking() {
+    timeline_resource_->enable_range_tracking();
+  }
+  bool subrange_tracking() { return timeline_resource_->range_tracking(); }
+
+  // The byte range of this storage within its root allocation.
+  local::detail::TimelineResourceRange resource_range() const {
+    return local::detail::TimelineResourceRange{
+        .offset = iree_hal_buffer_byte_offset(buffer_.get()),
+        .length = byte_length()};
+  }
+
+  // Binds this storage to a slot when replaying a command capture.
+  local::detail::CaptureBinding capture_binding() {
+    return local::detail::CaptureBinding{
+        .buffer = buffer_.get(),
+        .resource = timeline_resource_.get(),
+        .range = resource_range()};
+  }
+
  private:
   storage(local::ScopedDevice device, iree::hal_buffer_ptr buffer,
           local::detail::TimelineResource::Ref timeline_resource);
   void AsyncDeallocate();
+  // Records the copy commands of copy_from() on this storage's device, which
+  // must be able to access the source buffer.
+  void CopyFromDirect(storage &source_storage,
+                      std::span<const copy_region> regions);
+  // Whether this storage's device must stage reads of the source's memory.
+  bool RequiresStagedCopyFrom(storage &source_storage);
+  iree_status_t MapRange(mapping &mapping,
+                         iree_hal_memory_access_t access) noexcept;
   // ProgramInvocationMarshalable implementation.
   void AddAsInvocationArgument(local::ProgramInvocation *inv,
                                local::ProgramResourceBarrier barrier) override;
@@ -205,6 +343,29 @@ class SHORTFIN_API storage : public local::ProgramInvocationMarshalable {
   friend class device_array;
 };
 
+// Names the memory pool that storage allocated on this thread is reported
+// to while in scope (i.e. "kvcache"), for allocate_device and allocate_host.
+// Scopes nest. In builds with IREE allocation tracking (Tracy), each
+// allocation of storage is reported as an alloc event of its pool, from
+// allocation until its last reference is released (and device memory is
+// deallocated or returned to the buffer cache). Outside of any scope,
+// allocations are reported to "shortfin.device" and "shortfin.host", and
+// staging buffers always to "shortfin.staging".
+class SHORTFIN_API memory_pool_scope {
+ public:
+  explicit memory_pool_scope(std::string_view name);
+  memory_pool_scope(const memory_pool_scope &) = delete;
+  memory_pool_scope &operator=(const memory_pool_scope &) = delete;
+  ~memory_pool_scope();
+
+  // The name of the innermost scope of this thread, or nullptr. Names are
+  // interned for the life of the process, as traces reference them.
+  static const char *current();
+
+ private:
+  const char *previous_;
+};
+
 // Wraps an untyped mapping, providing typed access.
 template <typename EltTy>
 class typed_mapping {
@@ -0,0 +1,82 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+
+#include "shortfin/array/storage.h"
+#include "shortfin/local/benchmark_helpers.h"
+
+namespace shortfin::array {
+namespace {
+
+using local::BenchmarkSystem;
+
+// Waits for the device work queued by the timed loop (i.e. the deallocation
+// of released storage), outside of the timings.
+void SyncDevice(benchmark::State &state, BenchmarkSystem &sys) {
+  state.PauseTiming();
+  sys.RunAsyncOnWorker([&sys](std::function<void()> done) {
+    sys.device().OnSync().AddCallback(
+        [done](local::Future &) { done(); });
+  });
+  state.ResumeTiming();
+}
+
+// Device allocations are queue-ordered and, once released, recycled by the
+// scheduler's buffer cache: this is the steady state of a serving loop.
+void BM_AllocateDevice(benchmark::State &state) {
+  BenchmarkSystem sys;
+  iree_device_size_t size = state.range(0);
+  sys.RunOnWorker([&]() {
+    local::ScopedDevice device = sys.device();
+    for (auto _ : state) {
+      storage s = storage::allocate_device(device, size);
+      benchmark::DoNotOptimize(s);
+    }
+  });
+  SyncDevice(state, sys);
+}
+BENCHMARK(BM_AllocateDevice)->Arg(4 << 10)->Arg(16 << 20)->UseRealTime();
+
+void BM_AllocateHost(benchmark::State &state) {
+  BenchmarkSystem sys;
+  iree_device_size_t size = state.range(0);
+  bool device_visible = state.range(1);
+  sys.RunOnWorker([&]() {
+    local::ScopedDevice device = sys.device();
+    for (auto _ : state) {
+      storage s = storage::allocate_host(device, size, device_visible);
+      benchmark::DoNotOptimize(s);
+    }
+  });
+  SyncDevice(state, sys);
+}
+BENCHMARK(BM_AllocateHost)
+    ->ArgsProduct({{4 << 10, 16 << 20}, {0, 1}})
+    ->UseRealTime();
+
+// A host to device transfer, waited on per iteration.
+void BM_CopyToDevice(benchmark::State &state) {
+  BenchmarkSystem sys;
+  iree_device_size_t size = state.range(0);
+  for (auto _ : state) {
+    sys.RunAsyncOnWorker([&](std::function<void()> done) {
+      local::ScopedDevice device = sys.device();
+      storage host = storage::allocate_host(device, size);
+      storage dst = storage::allocate_device(device, size);
+      dst.copy_from(host);
+      device.OnSync().AddCallback(
+          [done](local::Future &) { done(); });
+    });
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_CopyToDevice)->Arg(4 << 10)->Arg(16 << 20)->UseRealTime();
+
+}  // namespace
+}  // namespace shortfin::array
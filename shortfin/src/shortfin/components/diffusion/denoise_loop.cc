@@ -0,0 +1,256 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/components/diffusion/denoise_loop.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "fmt/core.h"
+#include "shortfin/support/logging.h"
+
+namespace shortfin::diffusion {
+
+using local::ProgramInvocation;
+
+// State of one Run(), owned by the callbacks of its pending invocation. All
+// of it is accessed on the fiber's worker.
+class DenoiseLoop::RunState : public std::enable_shared_from_this<RunState> {
+ public:
+  RunState(Options options, std::shared_ptr<local::Fiber> fiber,
+           std::vector<array::device_array> inputs, size_t num_steps,
+           std::optional<local::ProgramIsolation> isolation)
+      : options_(std::move(options)),
+        fiber_(std::move(fiber)),
+        inputs_(std::move(inputs)),
+        num_steps_(num_steps),
+        isolation_(isolation),
+        current_(options_.stages.size()),
+        spare_(options_.stages.size()) {}
+
+  ProgramInvocation::Future &result() { return result_; }
+
+  void Start() {
+    if (!options_.initialize) {
+      InvokeStage();
+      return;
+    }
+    auto inv = options_.initialize->CreateInvocation(fiber_, isolation_);
+    for (const DenoiseArg &arg : options_.initialize_args) AddArg(*inv, arg);
+    Invoke(std::move(inv));
+  }
+
+ private:
+  void Invoke(ProgramInvocation::Ptr inv) {
+    ProgramInvocation::Invoke(std::move(inv))
+        .AddCallback([self = shared_from_this()](local::Future &future) {
+          self->OnComplete(static_cast<ProgramInvocation::Future &>(future));
+        });
+  }
+
+  void InvokeStage() {
+    SHORTFIN_TRACE_SCOPE_NAMED("DenoiseLoop::InvokeStage");
+    DenoiseStage &stage = options_.stages[stage_];
+    ProgramInvocation::Ptr inv = std::move(spare_[stage_]);
+    if (!inv) inv = stage.function.CreateInvocation(fiber_, isolation_);
+    for (const DenoiseArg &arg : stage.args) AddArg(*inv, arg);
+    Invoke(std::move(inv));
+  }
+
+  void AddArg(ProgramInvocation &inv, const DenoiseArg &arg) {
+    switch (arg.source) {
+      case DenoiseArg::Source::INPUT:
+        AddArrayArg(inv, inputs_[arg.index]);
+        break;
+      case DenoiseArg::Source::STEP_INPUT: {
+        array::device_array &input = inputs_[arg.index];
+        array::Dims offsets(input.shape().size(), 0);
+        array::Dims sizes(input.shape_container());
+        offsets[0] = step_;
+        sizes[0] = 1;
+        array::device_array row = input.view(offsets, sizes);
+        AddArrayArg(inv, row);
+        break;
+      }
+      case DenoiseArg::Source::INIT_RESULT:
+        inv.AddResultArg(*init_, arg.index);
+        break;
+      case DenoiseArg::Source::STAGE_RESULT:
+        inv.AddResultArg(*current_[arg.stage], arg.index);
+        break;
+      case DenoiseArg::Source::LATENTS:
+        if (previous_) {
+          inv.AddResultArg(*previous_, 0);
+        } else {
+          AddArg(inv, options_.latents);
+        }
+        break;
+    }
+  }
+
+  static void AddArrayArg(ProgramInvocation &inv, array::device_array &array) {
+    static_cast<local::ProgramInvocationMarshalable &>(array)
+        .AddAsInvocationArgument(&inv, local::ProgramResourceBarrier::DEFAULT);
+  }
+
+  // Returns a completed invocation of `stage` to be reused on the next step,
+  // once the invocations consuming its results have been created.
+  void Recycle(ProgramInvocation::Ptr inv, size_t stage) {
+    if (!inv || spare_[stage]) return;
+    inv->Reset();
+    spare_[stage] = std::move(inv);
+  }
+
+  void OnComplete(ProgramInvocation::Future &future) {
+    SHORTFIN_TRACE_SCOPE_NAMED("DenoiseLoop::OnComplete");
+    try {
+      ProgramInvocation::Ptr inv = std::move(future.result());
+      if (options_.initialize && !init_) {
+        init_ = std::move(inv);
+        InvokeStage();
+        return;
+      }
+
+      current_[stage_] = std::move(inv);
+      if (++stage_ < options_.stages.size()) {
+        InvokeStage();
+        return;
+      }
+
+      // The step is done: all of its consumers have been created.
+      size_t last = options_.stages.size() - 1;
+      Recycle(std::move(previous_), last);
+      for (size_t i = 0; i < last; ++i) Recycle(std::move(current_[i]), i);
+      previous_ = std::move(current_[last]);
+      stage_ = 0;
+      if (++step_ < num_steps_) {
+        InvokeStage();
+        return;
+      }
+      ProgramInvocation::Ptr latents = std::move(previous_);
+      Release();
+      result_.set_result(std::move(latents));
+    } catch (iree::error &e) {
+      Fail(iree_make_status(e.code(), "%s", e.what()));
+    } catch (std::exception &e) {
+      Fail(iree_make_status(IREE_STATUS_INVALID_ARGUMENT, "%s", e.what()));
+    }
+  }
+
+  void Fail(iree_status_t status) {
+    Release();
+    result_.set_failure(status);
+  }
+
+  // Drops the invocations and inputs as soon as the run is done.
+  void Release() {
+    init_ = nullptr;
+    previous_ = nullptr;
+    current_.clear();
+    spare_.clear();
+    inputs_.clear();
+  }
+
+  Options options_;
+  std::shared_ptr<local::Fiber> fiber_;
+  std::vector<array::device_array> inputs_;
+  size_t num_steps_;
+  std::optional<local::ProgramIsolation> isolation_;
+  ProgramInvocation::Future result_;
+
+  size_t step_ = 0;
+  size_t stage_ = 0;
+  // Completed invocations whose results are still to be consumed: of the
+  // initialize function, of the stages of this step so far and of the last
+  // stage of the previous step (the latents).
+  ProgramInvocation::Ptr init_;
+  std::vector<ProgramInvocation::Ptr> current_;
+  ProgramInvocation::Ptr previous_;
+  // Reset invocations of each stage.
+  std::vector<ProgramInvocation::Ptr> spare_;
+};
+
+DenoiseLoop::DenoiseLoop(Options options) : options_(std::move(options)) {
+  if (options_.stages.empty()) {
+    throw std::invalid_argument("A denoise loop needs at least one stage");
+  }
+  for (const DenoiseArg &arg : options_.initialize_args) {
+    if (arg.source != DenoiseArg::Source::INPUT) {
+      throw std::invalid_argument(
+          "Arguments of the initialize function must be inputs");
+    }
+  }
+  if (!options_.initialize && !options_.initialize_args.empty()) {
+    throw std::invalid_argument(
+        "Initialize arguments given without an initialize function");
+  }
+
+  auto check_init_result = [&](const DenoiseArg &arg) {
+    if (arg.source == DenoiseArg::Source::INIT_RESULT &&
+        !options_.initialize) {
+      throw std::invalid_argument(
+          "Initialize results used without an initialize function");
+    }
+  };
+  if (options_.latents.source != DenoiseArg::Source::INPUT &&
+      options_.latents.source != DenoiseArg::Source::INIT_RESULT) {
+    throw std::invalid_argument(
+        "The initial latents must be an input or an initialize result");
+  }
+  check_init_result(options_.latents);
+  for (size_t i = 0; i < options_.stages.size(); ++i) {
+    for (const DenoiseArg &arg : options_.stages[i].args) {
+      check_init_result(arg);
+      if (arg.source == DenoiseArg::Source::STAGE_RESULT && arg.stage >= i) {
+        throw std::invalid_argument(fmt::format(
+            "Stage {} uses a result of stage {}, which is not an earlier stage",
+            i, arg.stage));
+      }
+    }
+  }
+}
+
+local::ProgramInvocation::Future DenoiseLoop::Run(
+    std::shared_ptr<local::Fiber> fiber,
+    std::vector<array::device_array> inputs, size_t num_steps,
+    std::optional<local::ProgramIsolation> isolation) const {
+  SHORTFIN_TRACE_SCOPE_NAMED("DenoiseLoop::Run");
+  if (num_steps == 0) {
+    throw std::invalid_argument("A denoise loop needs at least one step");
+  }
+  auto check_input = [&](const DenoiseArg &arg) {
+    if (arg.source != DenoiseArg::Source::INPUT &&
+        arg.source != DenoiseArg::Source::STEP_INPUT) {
+      return;
+    }
+    if (arg.index >= inputs.size()) {
+      throw std::invalid_argument(
+          fmt::format("Input {} out of range ({} inputs)", arg.index,
+                      inputs.size()));
+    }
+    if (arg.source == DenoiseArg::Source::STEP_INPUT) {
+      auto shape = inputs[arg.index].shape();
+      if (shape.empty() || shape[0] < num_steps) {
+        throw std::invalid_argument(fmt::format(
+            "Step input {} needs a leading dimension of at least {} steps",
+            arg.index, num_steps));
+      }
+    }
+  };
+  for (const DenoiseArg &arg : options_.initialize_args) check_input(arg);
+  check_input(options_.latents);
+  for (const DenoiseStage &stage : options_.stages) {
+    for (const DenoiseArg &arg : stage.args) check_input(arg);
+  }
+
+  auto state = std::make_shared<RunState>(options_, std::move(fiber),
+                                          std::move(inputs), num_steps,
+                                          isolation);
+  state->Start();
+  return state->result();
+}
+
+}  // namespace shortfin::diffusion
@@ -0,0 +1,113 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_COMPONENTS_DIFFUSION_DENOISE_LOOP_H
+#define SHORTFIN_COMPONENTS_DIFFUSION_DENOISE_LOOP_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "shortfin/array/array.h"
+#include "shortfin/local/fiber.h"
+#include "shortfin/local/program.h"
+#include "shortfin/support/api.h"
+
+namespace shortfin::diffusion {
+
+// Where an argument of a denoising stage comes from.
+struct SHORTFIN_API DenoiseArg {
+  enum class Source {
+    // inputs[index], the same array on every step (i.e. the prompt
+    // embeddings or the guidance scale).
+    INPUT,
+    // Row `step` of inputs[index], sliced on its leading dimension (i.e. the
+    // step index, from an array of 0..num_steps).
+    STEP_INPUT,
+    // Result `index` of the initialize function (i.e. its timestep table).
+    INIT_RESULT,
+    // Result `index` of stage `stage` of the same step, which must be an
+    // earlier stage.
+    STAGE_RESULT,
+    // The latents carried from step to step: Options::latents on the first
+    // step, then result 0 of the last stage of the previous step.
+    LATENTS,
+  };
+
+  Source source;
+  size_t index = 0;
+  size_t stage = 0;
+
+  static DenoiseArg Input(size_t index) { return {Source::INPUT, index}; }
+  static DenoiseArg StepInput(size_t index) {
+    return {Source::STEP_INPUT, index};
+  }
+  static DenoiseArg InitResult(size_t index) {
+    return {Source::INIT_RESULT, index};
+  }
+  static DenoiseArg StageResult(size_t stage, size_t index) {
+    return {Source::STAGE_RESULT, index, stage};
+  }
+  static DenoiseArg Latents() { return {Source::LATENTS}; }
+};
+
+// An invocation of each step, in order (i.e. `run_scale`, the unet and
+// `run_step` of a scheduler, or a single scheduled unet).
+struct SHORTFIN_API DenoiseStage {
+  local::ProgramFunction function;
+  std::vector<DenoiseArg> args;
+};
+
+// Runs the scheduler step loop of a diffusion model for one image batch: an
+// optional initialize function (i.e. computing the initial latents and the
+// timestep table), then `num_steps` times each of the stages, whose programs
+// do the guidance combine and latent updates.
+//
+// Invocations are chained on the device: results are passed on as refs with
+// ProgramInvocation::AddResultArg, and each invocation is issued as soon as
+// the host side of the previous one returns, without waiting on the device
+// or marshaling results in between. The invocation of each stage is Reset()
+// and reused from step to step. Run() returns a future resolving to the
+// completed invocation of the last stage of the last step, whose result 0
+// is the denoised latents.
+//
+// Functions must use the coarse-fences invocation model. A loop is
+// immutable and can be Run() concurrently, i.e. from several fibers.
+class SHORTFIN_API DenoiseLoop {
+ public:
+  struct Options {
+    std::optional<local::ProgramFunction> initialize;
+    // Arguments of `initialize`, which may only be INPUTs.
+    std::vector<DenoiseArg> initialize_args;
+    // At least one, the last of which returns the next latents as result 0.
+    std::vector<DenoiseStage> stages;
+    // The latents of the first step, an INPUT or INIT_RESULT.
+    DenoiseArg latents = DenoiseArg::Input(0);
+  };
+
+  // Throws std::invalid_argument if the arguments of the stages are
+  // inconsistent.
+  explicit DenoiseLoop(Options options);
+
+  const Options &options() const { return options_; }
+
+  // Starts the loop on `fiber` (whose worker must be the current one) over
+  // `inputs` for `num_steps` steps, all invocations being created with
+  // `isolation`.
+  local::ProgramInvocation::Future Run(
+      std::shared_ptr<local::Fiber> fiber,
+      std::vector<array::device_array> inputs, size_t num_steps,
+      std::optional<local::ProgramIsolation> isolation = std::nullopt) const;
+
+ private:
+  class RunState;
+  Options options_;
+};
+
+}  // namespace shortfin::diffusion
+
+#endif  // SHORTFIN_COMPONENTS_DIFFUSION_DENOISE_LOOP_H
@@ -0,0 +1,309 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/components/llm/batch_scheduler.h"
+
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace shortfin::llm {
+
+namespace {
+
+// Batches under construction, as indices of ready jobs.
+class BatchBuilder {
+ public:
+  BatchBuilder(const BatchScheduler::Options &options,
+               std::span<const size_t> token_counts)
+      : options_(options), token_counts_(token_counts) {}
+
+  // Free job slots in the batches formed so far.
+  size_t available() const {
+    return batches_.size() * options_.ideal_batch_size - occupancy_;
+  }
+
+  // Adds `jobs` to the batches, keeping them together: they fill the space
+  // left in the existing batches if all of them fit there, else new batches
+  // are formed for them.
+  void Add(std::span<const size_t> jobs) {
+    while (!jobs.empty()) {
+      if (jobs.size() <= options_.ideal_batch_size && AddToExisting(jobs)) {
+        return;
+      }
+      Batch &batch = batches_.emplace_back();
+      size_t count = 0;
+      while (count < jobs.size() && Fits(batch, jobs[count])) {
+        Place(batch, jobs[count++]);
+      }
+      jobs = jobs.subspan(count);
+    }
+  }
+
+  // Places jobs from the front of `jobs` in the existing batches for as long
+  // as they fit, returning their number.
+  size_t Fill(std::span<const size_t> jobs) {
+    size_t count = 0;
+    for (; count < jobs.size(); ++count) {
+      auto it = std::ranges::find_if(batches_, [&](const Batch &batch) {
+        return Fits(batch, jobs[count]);
+      });
+      if (it == batches_.end()) break;
+      Place(*it, jobs[count]);
+    }
+    return count;
+  }
+
+  std::vector<std::vector<size_t>> Take() {
+    std::vector<std::vector<size_t>> jobs;
+    jobs.reserve(batches_.size());
+    for (Batch &batch : batches_) jobs.push_back(std::move(batch.jobs));
+    return jobs;
+  }
+
+ private:
+  struct Batch {
+    std::vector<size_t> jobs;
+    size_t token_count = 0;
+  };
+
+  bool Fits(const Batch &batch, size_t job) const {
+    if (batch.jobs.size() >= options_.ideal_batch_size) return false;
+    // A batch admits its first job regardless of the budget.
+    return options_.token_budget == 0 || batch.jobs.empty() ||
+           batch.token_count + token_counts_[job] <= options_.token_budget;
+  }
+
+  void Place(Batch &batch, size_t job) {
+    batch.jobs.push_back(job);
+    batch.token_count += token_counts_[job];
+    ++occupancy_;
+  }
+
+  // Places each of `jobs` in the first existing batch with room for it, if
+  // there is one for every job.
+  bool AddToExisting(std::span<const size_t> jobs) {
+    if (jobs.size() > available()) return false;
+    std::vector<Batch *> placement;
+    placement.reserve(jobs.size());
+    // Sizes and token counts of the batches with the jobs placed so far.
+    std::vector<Batch> trial(batches_.size());
+    for (size_t i = 0; i < batches_.size(); ++i) {
+      trial[i].jobs.resize(batches_[i].jobs.size());
+      trial[i].token_count = batches_[i].token_count;
+    }
+    for (size_t job : jobs) {
+      auto it = std::ranges::find_if(
+          trial, [&](const Batch &batch) { return Fits(batch, job); });
+      if (it == trial.end()) return false;
+      it->jobs.push_back(job);
+      it->token_count += token_counts_[job];
+      placement.push_back(&batches_[it - trial.begin()]);
+    }
+    for (size_t i = 0; i < jobs.size(); ++i) Place(*placement[i], jobs[i]);
+    return true;
+  }
+
+  const BatchScheduler::Options &options_;
+  std::span<const size_t> token_counts_;
+  std::vector<Batch> batches_;
+  size_t occupancy_ = 0;
+};
+
+}  // namespace
+
+BatchScheduler::BatchScheduler(Options options) : options_(options) {
+  if (options_.ideal_batch_size == 0) {
+    throw std::invalid_argument("ideal_batch_size must be positive");
+  }
+}
+
+bool BatchScheduler::has_request(int64_t rid) const {
+  return ready_counts_.contains(rid) || waiting_.contains(rid) ||
+         placement_.contains(rid);
+}
+
+void BatchScheduler::Ready(const Job &job) {
+  ready_.push_back(job);
+  ++ready_counts_[job.rid];
+}
+
+void BatchScheduler::Submit(uint64_t job, int64_t rid, size_t token_count) {
+  Job entry{.id = job, .rid = rid, .token_count = token_count};
+  if (options_.sequential_jobs) {
+    auto [it, first] = waiting_.try_emplace(rid);
+    if (!first) {
+      it->second.push_back(entry);
+      return;
+    }
+  }
+  Ready(entry);
+}
+
+bool BatchScheduler::Complete(int64_t rid) {
+  auto it = waiting_.find(rid);
+  if (it == waiting_.end()) return true;
+  if (it->second.empty()) {
+    waiting_.erase(it);
+    return true;
+  }
+  Ready(it->second.front());
+  it->second.pop_front();
+  return false;
+}
+
+std::vector<uint64_t> BatchScheduler::Cancel(int64_t rid) {
+  std::vector<uint64_t> dropped;
+  if (ready_counts_.erase(rid)) {
+    size_t kept = 0;
+    for (const Job &job : ready_) {
+      if (job.rid == rid) {
+        dropped.push_back(job.id);
+      } else {
+        ready_[kept++] = job;
+      }
+    }
+    ready_.resize(kept);
+  }
+  if (auto it = waiting_.find(rid); it != waiting_.end()) {
+    for (const Job &job : it->second) dropped.push_back(job.id);
+    waiting_.erase(it);
+  }
+  RemoveReservation(rid);
+  return dropped;
+}
+
+void BatchScheduler::Resize(Workgroup &workgroup, int64_t rid, size_t count) {
+  size_t &member_count = workgroup.members[rid];
+  workgroup.size += count - member_count;
+  member_count = count;
+}
+
+void BatchScheduler::RemoveReservation(int64_t rid) {
+  auto it = placement_.find(rid);
+  if (it == placement_.end()) return;
+  auto workgroup_it = workgroups_.find(it->second);
+  Workgroup &workgroup = workgroup_it->second;
+  auto member_it = workgroup.members.find(rid);
+  workgroup.size -= member_it->second;
+  workgroup.members.erase(member_it);
+  if (workgroup.members.empty()) workgroups_.erase(workgroup_it);
+  placement_.erase(it);
+}
+
+void BatchScheduler::Reserve(int64_t rid, size_t count) {
+  if (count == 0) {
+    RemoveReservation(rid);
+    return;
+  }
+  size_t max_size = options_.ideal_batch_size;
+  if (auto it = placement_.find(rid); it != placement_.end()) {
+    // Resize in place if the workgroup has room, else move the reservation.
+    Workgroup &workgroup = workgroups_.at(it->second);
+    if (workgroup.size - workgroup.members.at(rid) + count <= max_size) {
+      Resize(workgroup, rid, count);
+      return;
+    }
+    RemoveReservation(rid);
+  }
+
+  // Place the reservation in the oldest workgroup with room for it.
+  auto workgroup_it =
+      std::ranges::find_if(workgroups_, [&](const auto &entry) {
+        return entry.second.size + count <= max_size;
+      });
+  if (workgroup_it == workgroups_.end()) {
+    workgroup_it = workgroups_.try_emplace(++next_workgroup_).first;
+  }
+  Resize(workgroup_it->second, rid, count);
+  placement_[rid] = workgroup_it->first;
+}
+
+std::vector<std::vector<uint64_t>> BatchScheduler::Schedule(int64_t strobe) {
+  if (ready_.empty()) return {};
+
+  // Keep the jobs of each request together, in the order that the requests
+  // became ready.
+  std::vector<size_t> token_counts;
+  token_counts.reserve(ready_.size());
+  std::unordered_map<int64_t, size_t> request_order;
+  std::vector<std::pair<size_t, size_t>> order;
+  order.reserve(ready_.size());
+  for (size_t i = 0; i < ready_.size(); ++i) {
+    token_counts.push_back(ready_[i].token_count);
+    auto rank = request_order.try_emplace(ready_[i].rid, request_order.size());
+    order.emplace_back(rank.first->second, i);
+  }
+  std::ranges::sort(order);
+  std::unordered_map<int, std::vector<size_t>> reserved;
+  std::vector<size_t> unreserved;
+  for (auto [rank, i] : order) {
+    if (auto it = placement_.find(ready_[i].rid); it != placement_.end()) {
+      reserved[it->second].push_back(i);
+    } else {
+      unreserved.push_back(i);
+    }
+  }
+  BatchBuilder builder(options_, token_counts);
+
+  // Launch each workgroup once all of its reserved jobs are ready.
+  for (auto &[id, workgroup] : workgroups_) {
+    auto it = reserved.find(id);
+    if (it != reserved.end() && it->second.size() >= workgroup.size) {
+      builder.Add(it->second);
+    }
+  }
+
+  // Unreserved jobs fill the space left, then form ideal batches. Any left
+  // over wait for a strobe, in case more jobs arrive.
+  std::span<const size_t> remaining(unreserved);
+  if (!remaining.empty() && builder.available() > 0) {
+    size_t count = std::min(builder.available(), remaining.size());
+    builder.Add(remaining.first(count));
+    remaining = remaining.subspan(count);
+  }
+  while (remaining.size() >= options_.ideal_batch_size) {
+    builder.Add(remaining.first(options_.ideal_batch_size));
+    remaining = remaining.subspan(options_.ideal_batch_size);
+    unreserved_strobe_.reset();
+  }
+  // Under a token budget, the ideal batches may leave room for more.
+  if (options_.token_budget > 0 && !remaining.empty()) {
+    remaining = remaining.subspan(builder.Fill(remaining));
+  }
+  if (!remaining.empty()) {
+    if (!unreserved_strobe_) {
+      unreserved_strobe_ = strobe;
+    } else if (strobe - *unreserved_strobe_ > 1) {
+      unreserved_strobe_.reset();
+      builder.Add(remaining);
+    }
+  }
+
+  // Hand out the batches and keep the unscheduled jobs.
+  std::vector<bool> scheduled(ready_.size(), false);
+  std::vector<std::vector<uint64_t>> batches;
+  for (const auto &batch : builder.Take()) {
+    auto &ids = batches.emplace_back();
+    ids.reserve(batch.size());
+    for (size_t i : batch) {
+      ids.push_back(ready_[i].id);
+      scheduled[i] = true;
+      if (--ready_counts_[ready_[i].rid] == 0) {
+        ready_counts_.erase(ready_[i].rid);
+      }
+    }
+  }
+  size_t kept = 0;
+  for (size_t i = 0; i < ready_.size(); ++i) {
+    if (!scheduled[i]) ready_[kept++] = ready_[i];
+  }
+  ready_.resize(kept);
+  return batches;
+}
+
+}  // namespace shortfin::llm
@@ -0,0 +1,113 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_COMPONENTS_LLM_BATCH_SCHEDULER_H
+#define SHORTFIN_COMPONENTS_LLM_BATCH_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "shortfin/support/api.h"
+
+namespace shortfin::llm {
+
+// Batch formation for one batcher lane: admits jobs (one invocation's worth of
+// work for a request, i.e. a prefill chunk or a decode step), and forms them
+// into batches of up to `ideal_batch_size` jobs and `token_budget` tokens
+// each time the batcher strobes.
+//
+// Requests identified by `rid` may reserve a number of batch slots (i.e. the
+// beams of a decode), which places them in a workgroup: the jobs of a
+// workgroup are only launched together, once all of its reserved jobs are
+// ready. Unreserved jobs fill the space left in the batches, and are otherwise
+// held until an ideal batch accumulates or for a strobe.
+//
+// With `sequential_jobs` (chunked prefill), only one job of a request is ready
+// at a time: the next is admitted when Complete() is called for the previous,
+// so that the chunks of long prompts interleave with other requests' work.
+//
+// Jobs and requests are opaque integers to the scheduler, so that the cost of
+// a step is independent of the objects that the caller maps them to. Not
+// thread safe: a scheduler belongs to the fiber of its batcher.
+class SHORTFIN_API BatchScheduler {
+ public:
+  struct Options {
+    size_t ideal_batch_size;
+    // Maximum total tokens of the jobs in a batch, or 0 for no limit. A job
+    // over the budget is batched on its own.
+    size_t token_budget = 0;
+    bool sequential_jobs = false;
+  };
+
+  explicit BatchScheduler(Options options);
+  BatchScheduler(const BatchScheduler &) = delete;
+
+  const Options &options() const { return options_; }
+  // Number of jobs ready to schedule.
+  size_t ready_count() const { return ready_.size(); }
+  size_t workgroup_count() const { return workgroups_.size(); }
+  // Whether any state is kept for `rid`, i.e. unscheduled or sequential jobs,
+  // or a reservation.
+  bool has_request(int64_t rid) const;
+
+  // Admits `job` of `token_count` tokens for request `rid`.
+  void Submit(uint64_t job, int64_t rid, size_t token_count);
+
+  // Reserves `count` batch slots for `rid`, or drops its reservation if 0.
+  void Reserve(int64_t rid, size_t count);
+
+  // Forms the batches to launch at `strobe` (a counter of the batcher's
+  // strobes since it last launched), removing their jobs from the ready ones.
+  std::vector<std::vector<uint64_t>> Schedule(int64_t strobe);
+
+  // Notes that the launched job of `rid` completed. Returns whether the
+  // request has no more sequential jobs, admitting the next one otherwise
+  // (always true without `sequential_jobs`).
+  bool Complete(int64_t rid);
+
+  // Drops all state of `rid` (i.e. a cancelled request): its unscheduled and
+  // sequential jobs and its reservation. Returns the dropped jobs, which are
+  // never scheduled. Jobs of `rid` already launched are not affected.
+  std::vector<uint64_t> Cancel(int64_t rid);
+
+ private:
+  struct Job {
+    uint64_t id;
+    int64_t rid;
+    size_t token_count;
+  };
+  struct Workgroup {
+    std::unordered_map<int64_t, size_t> members;
+    size_t size = 0;
+  };
+
+  void Ready(const Job &job);
+  void Resize(Workgroup &workgroup, int64_t rid, size_t count);
+  void RemoveReservation(int64_t rid);
+
+  Options options_;
+  std::vector<Job> ready_;
+  // Unscheduled jobs of each request, among ready_.
+  std::unordered_map<int64_t, size_t> ready_counts_;
+  // Jobs waiting on the completion of a previous job of their request, for
+  // each request with a job in flight (sequential_jobs only).
+  std::unordered_map<int64_t, std::deque<Job>> waiting_;
+  // Workgroups by id, oldest first, and the workgroup of each reservation.
+  std::map<int, Workgroup> workgroups_;
+  std::unordered_map<int64_t, int> placement_;
+  int next_workgroup_ = 0;
+  // Strobe at which unreserved jobs started waiting for a batch.
+  std::optional<int64_t> unreserved_strobe_;
+};
+
+}  // namespace shortfin::llm
+
+#endif
@@ -0,0 +1,231 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/components/llm/beam_search.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "fmt/core.h"
+#include "iree/base/internal/math.h"
+
+namespace shortfin::llm {
+
+namespace {
+
+constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+
+}  // namespace
+
+BeamSearch::BeamSearch(Options options)
+    : options_(std::move(options)),
+      num_beams_(std::max(options_.config.num_beams, 1)) {
+  // The prompt is the single live beam, with an empty hypothesis.
+  live_nodes_.push_back(-1);
+  live_tokens_.push_back(-1);
+  live_scores_.push_back(0.f);
+  live_parents_.push_back(-1);
+  candidates_.reserve(num_beams_);
+}
+
+bool BeamSearch::done() const {
+  return completed_.size() >= num_beams_ || live_nodes_.empty() ||
+         (options_.config.max_completion_tokens > 0 &&
+          step_count_ >=
+              static_cast<size_t>(options_.config.max_completion_tokens));
+}
+
+template <typename Storage, typename ToFloat>
+void BeamSearch::SelectCandidates(const LogitsView &logits,
+                                  ToFloat to_float) {
+  constexpr size_t kBlockSize = 64;
+  const DecodeConfig &config = options_.config;
+  LogitsNormalization normalization = config.logits_normalization;
+  float inv_temperature =
+      config.temperature > 0.f ? 1.f / config.temperature : 1.f;
+  // Maps a logit to its log probability, less a per row offset.
+  auto log_prob = [&](Storage v) {
+    float f = to_float(v);
+    switch (normalization) {
+      case LogitsNormalization::NONE:
+        return f * inv_temperature;
+      case LogitsNormalization::SOFTMAX:
+        return std::log(f);
+      case LogitsNormalization::LOG_SOFTMAX:
+        break;
+    }
+    return f;
+  };
+  auto more_likely = [](const Candidate &a, const Candidate &b) {
+    return a.score > b.score ||
+           (a.score == b.score &&
+            (a.beam < b.beam || (a.beam == b.beam && a.token < b.token)));
+  };
+
+  const Storage *data = static_cast<const Storage *>(logits.data);
+  size_t vocab_size = logits.vocab_size;
+  candidates_.clear();
+  for (size_t r = 0; r < logits.rows; ++r) {
+    const Storage *row = data + r * logits.row_stride;
+    // Candidates score the cumulative log probability of their beam plus
+    // their own, so rows are offset by the former (and by the log partition
+    // function of unnormalized logits).
+    float offset = live_scores_[r];
+    if (normalization == LogitsNormalization::NONE) {
+      float max = kNegInf;
+      double sum = 0.0;
+      for (size_t i = 0; i < vocab_size; ++i) {
+        float v = log_prob(row[i]);
+        if (std::isnan(v)) continue;
+        if (v > max) {
+          sum = sum * std::exp(static_cast<double>(max - v)) + 1.0;
+          max = v;
+        } else if (max != kNegInf) {
+          sum += std::exp(v - max);
+        }
+      }
+      if (max == kNegInf) continue;
+      offset -= max + static_cast<float>(std::log(sum));
+    }
+
+    // Streams the row into a min-heap of the num_beams best candidates over
+    // all rows. Candidates arrive in (beam, token) order, so once the heap is
+    // full only strictly better ones can enter, which lets whole blocks be
+    // skipped by a vectorizable scan.
+    for (size_t begin = 0; begin < vocab_size; begin += kBlockSize) {
+      size_t end = std::min(begin + kBlockSize, vocab_size);
+      if (candidates_.size() == num_beams_) {
+        // Slack keeps the filter conservative under the rounding of
+        // log_prob + offset.
+        float worst = candidates_.front().score;
+        float threshold = worst - offset -
+                          1e-6f * (std::abs(worst) + std::abs(offset) + 1.f);
+        int above = 0;
+        for (size_t i = begin; i < end; ++i) {
+          above += log_prob(row[i]) > threshold;
+        }
+        if (!above) continue;
+      }
+      for (size_t i = begin; i < end; ++i) {
+        float score = log_prob(row[i]) + offset;
+        if (std::isnan(score) || score == kNegInf) continue;
+        Candidate c{score, static_cast<int>(r), static_cast<int>(i)};
+        if (candidates_.size() < num_beams_) {
+          candidates_.push_back(c);
+          std::push_heap(candidates_.begin(), candidates_.end(), more_likely);
+        } else if (score > candidates_.front().score) {
+          std::pop_heap(candidates_.begin(), candidates_.end(), more_likely);
+          candidates_.back() = c;
+          std::push_heap(candidates_.begin(), candidates_.end(), more_likely);
+        }
+      }
+    }
+  }
+  std::sort_heap(candidates_.begin(), candidates_.end(), more_likely);
+}
+
+void BeamSearch::Step(const LogitsView &logits, const int32_t *indices) {
+  if (done()) {
+    throw std::logic_error("Beam search is done");
+  }
+  if (logits.rows != live_nodes_.size()) {
+    throw std::invalid_argument(
+        fmt::format("Expected logits for {} live beams but got {} rows",
+                    live_nodes_.size(), logits.rows));
+  }
+  if (logits.rows > 1 && logits.row_stride < logits.vocab_size) {
+    throw std::invalid_argument(
+        fmt::format("Logits row stride {} is less than the vocab size {}",
+                    logits.row_stride, logits.vocab_size));
+  }
+
+  switch (logits.dtype) {
+    case LogitsDType::FLOAT32:
+      SelectCandidates<float>(logits, [](float v) { return v; });
+      break;
+    case LogitsDType::FLOAT16:
+      SelectCandidates<uint16_t>(
+          logits, [](uint16_t v) { return iree_math_f16_to_f32(v); });
+      break;
+    case LogitsDType::BFLOAT16:
+      SelectCandidates<uint16_t>(
+          logits, [](uint16_t v) { return iree_math_bf16_to_f32(v); });
+      break;
+  }
+
+  // Extends the hypothesis tree, retiring candidates which end in EOS.
+  size_t previous_count = live_nodes_.size();
+  std::vector<int> previous_nodes;
+  previous_nodes.swap(live_nodes_);
+  live_tokens_.clear();
+  live_scores_.clear();
+  live_parents_.clear();
+  for (const Candidate &c : candidates_) {
+    int token = indices ? indices[c.beam * logits.vocab_size + c.token]
+                        : c.token;
+    int node = static_cast<int>(node_tokens_.size());
+    node_tokens_.push_back(token);
+    node_parents_.push_back(previous_nodes[c.beam]);
+    if (token == options_.config.eos_token_id) {
+      completed_.emplace_back(node, c.score);
+      continue;
+    }
+    live_nodes_.push_back(node);
+    live_tokens_.push_back(token);
+    live_scores_.push_back(c.score);
+    live_parents_.push_back(c.beam);
+  }
+
+  // Page plan. The tokens of this step are written at position + step.
+  copy_last_page_.clear();
+  released_.clear();
+  bool new_page = options_.tokens_per_page == 0 ||
+                  (options_.position + step_count_) %
+                          options_.tokens_per_page ==
+                      0;
+  std::vector<bool> continued(previous_count, false);
+  for (size_t i = 0; i < live_parents_.size(); ++i) {
+    int parent = live_parents_[i];
+    if (continued[parent] && !new_page) {
+      copy_last_page_.push_back(static_cast<int>(i));
+    }
+    continued[parent] = true;
+  }
+  for (size_t b = 0; b < previous_count; ++b) {
+    if (!continued[b]) released_.push_back(static_cast<int>(b));
+  }
+  step_count_ += 1;
+}
+
+std::vector<int> BeamSearch::Tokens(int node) const {
+  std::vector<int> tokens;
+  for (; node >= 0; node = node_parents_[node]) {
+    tokens.push_back(node_tokens_[node]);
+  }
+  std::reverse(tokens.begin(), tokens.end());
+  return tokens;
+}
+
+std::vector<BeamSearch::Hypothesis> BeamSearch::Results() const {
+  std::vector<Hypothesis> results;
+  for (auto &[node, score] : completed_) {
+    if (results.size() == num_beams_) break;
+    results.push_back({Tokens(node), score});
+  }
+  // Live beams are kept from most to least likely.
+  for (size_t i = 0; i < live_nodes_.size() && results.size() < num_beams_;
+       ++i) {
+    if (live_nodes_[i] < 0) break;
+    results.push_back({Tokens(live_nodes_[i]), live_scores_[i]});
+  }
+  return results;
+}
+
+}  // namespace shortfin::llm
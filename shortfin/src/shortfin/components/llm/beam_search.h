@@ -0,0 +1,118 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_COMPONENTS_LLM_BEAM_SEARCH_H
+#define SHORTFIN_COMPONENTS_LLM_BEAM_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "shortfin/components/llm/data.h"
+#include "shortfin/components/llm/selectors.h"
+
+namespace shortfin::llm {
+
+// State of a beam search over one request. Each Step() consumes the logits of
+// the live beams, extends them by the `num_beams` most likely (beam, token)
+// pairs under their cumulative log probabilities and retires the extensions
+// which end in `eos_token_id`. The search is done once `num_beams` hypotheses
+// have completed, no beam is live or `max_completion_tokens` steps were taken.
+//
+// Hypotheses are kept as back-pointers in flat arrays (one token and parent
+// per node), so a step costs a pass over the logits plus O(num_beams) work
+// regardless of the length of the hypotheses.
+//
+// Each step also emits the plan for the KV cache pages of the new live beams
+// (see parents(), copy_last_page() and released()), given the position of
+// the first generated token and the number of tokens per page. Beams share
+// all full pages with their ancestors: only a partially filled last page
+// which is continued by more than one beam needs to be copied.
+class SHORTFIN_API BeamSearch {
+ public:
+  struct Options {
+    DecodeConfig config;
+    // Position of the first generated token and the number of tokens per KV
+    // cache page. 0 tokens per page disables the page plan.
+    size_t position = 0;
+    size_t tokens_per_page = 0;
+  };
+
+  explicit BeamSearch(Options options);
+
+  // Consumes the `[live_beam_count(), vocab_size]` logits of the live beams.
+  // If given, `indices` is the row-major `[live_beam_count(), vocab_size]`
+  // token id of each logit (i.e. when the model returns its own top-k), else
+  // the column is the token id. The logits are interpreted according to
+  // `config.logits_normalization`: NONE logits are log-softmax normalized
+  // after scaling by the temperature, SOFTMAX ones are probabilities.
+  //
+  // Throws std::invalid_argument if the shape does not match the live beams
+  // and std::logic_error if the search is done.
+  void Step(const LogitsView &logits, const int32_t *indices = nullptr);
+
+  bool done() const;
+  size_t step_count() const { return step_count_; }
+  size_t live_beam_count() const { return live_nodes_.size(); }
+
+  // For each live beam after the last step: the token it was extended with,
+  // its cumulative log probability and the index of the beam (among those
+  // live before the step) which it continues.
+  std::span<const int> tokens() const { return live_tokens_; }
+  std::span<const float> scores() const { return live_scores_; }
+  std::span<const int> parents() const { return live_parents_; }
+
+  // KV cache page plan of the last step. Live beams listed in copy_last_page
+  // continue a partially filled last page which an earlier live beam also
+  // continues, so they must write to a copy of it. Beams live before the step
+  // which are listed in released are not continued and their pages (beyond
+  // those shared with continued beams) can be released.
+  std::span<const int> copy_last_page() const { return copy_last_page_; }
+  std::span<const int> released() const { return released_; }
+
+  // Up to `num_beams` hypotheses: the completed ones in completion order
+  // (ending in eos_token_id), followed by the most likely live ones.
+  struct Hypothesis {
+    std::vector<int> tokens;
+    float score;
+  };
+  std::vector<Hypothesis> Results() const;
+
+ private:
+  struct Candidate {
+    float score;
+    int beam;
+    int token;
+  };
+  template <typename Storage, typename ToFloat>
+  void SelectCandidates(const LogitsView &logits, ToFloat to_float);
+  std::vector<int> Tokens(int node) const;
+
+  Options options_;
+  size_t num_beams_;
+  size_t step_count_ = 0;
+  // Hypothesis tree: the token and parent node of each node.
+  std::vector<int> node_tokens_;
+  std::vector<int> node_parents_;
+  // Live beams.
+  std::vector<int> live_nodes_;
+  std::vector<int> live_tokens_;
+  std::vector<float> live_scores_;
+  std::vector<int> live_parents_;
+  // Completed hypotheses (node ending in EOS and score).
+  std::vector<std::pair<int, float>> completed_;
+  // Page plan of the last step.
+  std::vector<int> copy_last_page_;
+  std::vector<int> released_;
+  // Scratch.
+  std::vector<Candidate> candidates_;
+};
+
+}  // namespace shortfin::llm
+
+#endif
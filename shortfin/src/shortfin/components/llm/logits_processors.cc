@@ -0,0 +1,168 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/components/llm/logits_processors.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "fmt/core.h"
+#include "iree/base/internal/math.h"
+
+namespace shortfin::llm {
+
+namespace {
+
+// Reads and writes logits of one storage type as float.
+struct F32Access {
+  using T = float;
+  static float Load(T v) { return v; }
+  static T Store(float v) { return v; }
+  static T NegInf() { return -std::numeric_limits<float>::infinity(); }
+};
+struct F16Access {
+  using T = uint16_t;
+  static float Load(T v) { return iree_math_f16_to_f32(v); }
+  static T Store(float v) { return iree_math_f32_to_f16(v); }
+  static T NegInf() { return 0xFC00; }
+};
+struct BF16Access {
+  using T = uint16_t;
+  static float Load(T v) { return iree_math_bf16_to_f32(v); }
+  static T Store(float v) { return iree_math_f32_to_bf16(v); }
+  static T NegInf() { return 0xFF80; }
+};
+
+bool InVocab(int32_t token, size_t vocab_size) {
+  return token >= 0 && static_cast<size_t>(token) < vocab_size;
+}
+
+}  // namespace
+
+LogitsProcessorChain &LogitsProcessorChain::AddRepetitionPenalty(
+    float penalty) {
+  if (!(penalty > 0.f)) {
+    throw std::invalid_argument(
+        fmt::format("Repetition penalty must be > 0 (got {})", penalty));
+  }
+  steps_.push_back(Step{.kind = Kind::REPETITION_PENALTY, .penalty = penalty});
+  return *this;
+}
+
+LogitsProcessorChain &LogitsProcessorChain::AddPresencePenalty(
+    float presence_penalty, float frequency_penalty) {
+  steps_.push_back(Step{.kind = Kind::PRESENCE_PENALTY,
+                        .penalty = presence_penalty,
+                        .frequency_penalty = frequency_penalty});
+  return *this;
+}
+
+LogitsProcessorChain &LogitsProcessorChain::AddLogitBias(
+    std::vector<std::pair<int32_t, float>> bias) {
+  steps_.push_back(Step{.kind = Kind::LOGIT_BIAS, .bias = std::move(bias)});
+  return *this;
+}
+
+LogitsProcessorChain &LogitsProcessorChain::AddTokenMask() {
+  steps_.push_back(Step{.kind = Kind::TOKEN_MASK});
+  return *this;
+}
+
+void LogitsProcessorChain::AcceptTokens(std::span<const int32_t> tokens) {
+  for (int32_t token : tokens) {
+    if (token >= 0) ++token_counts_[token];
+  }
+}
+
+void LogitsProcessorChain::SetAllowedTokens(std::span<const uint32_t> mask) {
+  allowed_tokens_.assign(mask.begin(), mask.end());
+  mask_set_ = true;
+}
+
+void LogitsProcessorChain::ClearAllowedTokens() {
+  allowed_tokens_.clear();
+  mask_set_ = false;
+}
+
+void LogitsProcessorChain::Apply(const MutableLogitsView &logits,
+                                 size_t row) const {
+  if (row >= logits.rows) {
+    throw std::invalid_argument(fmt::format(
+        "Logits row {} out of range ({} rows)", row, logits.rows));
+  }
+  auto apply = [&]<typename A>(A) {
+    using T = typename A::T;
+    T *data = static_cast<T *>(logits.data) + row * logits.row_stride;
+    const size_t vocab_size = logits.vocab_size;
+    for (const Step &step : steps_) {
+      switch (step.kind) {
+        case Kind::REPETITION_PENALTY:
+          for (auto [token, count] : token_counts_) {
+            if (!InVocab(token, vocab_size)) continue;
+            float v = A::Load(data[token]);
+            data[token] =
+                A::Store(v > 0.f ? v / step.penalty : v * step.penalty);
+          }
+          break;
+        case Kind::PRESENCE_PENALTY:
+          for (auto [token, count] : token_counts_) {
+            if (!InVocab(token, vocab_size)) continue;
+            float penalty = step.penalty + step.frequency_penalty * count;
+            data[token] = A::Store(A::Load(data[token]) - penalty);
+          }
+          break;
+        case Kind::LOGIT_BIAS:
+          for (auto [token, bias] : step.bias) {
+            if (!InVocab(token, vocab_size)) continue;
+            data[token] = A::Store(A::Load(data[token]) + bias);
+          }
+          break;
+        case Kind::TOKEN_MASK: {
+          if (!mask_set_) break;
+          const T neg_inf = A::NegInf();
+          for (size_t word = 0; word * 32 < vocab_size; ++word) {
+            uint32_t bits =
+                word < allowed_tokens_.size() ? allowed_tokens_[word] : 0;
+            if (bits == ~uint32_t{0}) continue;
+            size_t end = std::min(vocab_size, word * 32 + 32);
+            for (size_t t = word * 32; t < end; ++t) {
+              if (!(bits & (uint32_t{1} << (t % 32)))) data[t] = neg_inf;
+            }
+          }
+          break;
+        }
+      }
+    }
+  };
+  switch (logits.dtype) {
+    case LogitsDType::FLOAT32:
+      apply(F32Access{});
+      break;
+    case LogitsDType::FLOAT16:
+      apply(F16Access{});
+      break;
+    case LogitsDType::BFLOAT16:
+      apply(BF16Access{});
+      break;
+  }
+}
+
+void ApplyLogitsProcessors(
+    const MutableLogitsView &logits,
+    std::span<const LogitsProcessorChain *const> chains) {
+  if (chains.size() != logits.rows) {
+    throw std::invalid_argument(
+        fmt::format("Expected one logits processor chain per row ({} rows, "
+                    "got {} chains)",
+                    logits.rows, chains.size()));
+  }
+  for (size_t r = 0; r < chains.size(); ++r) {
+    if (chains[r]) chains[r]->Apply(logits, r);
+  }
+}
+
+}  // namespace shortfin::llm
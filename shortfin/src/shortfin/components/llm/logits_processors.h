@@ -0,0 +1,106 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_COMPONENTS_LLM_LOGITS_PROCESSORS_H
+#define SHORTFIN_COMPONENTS_LLM_LOGITS_PROCESSORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "shortfin/components/llm/selectors.h"
+
+namespace shortfin::llm {
+
+// A LogitsView whose logits may be modified in place.
+struct SHORTFIN_API MutableLogitsView {
+  void *data = nullptr;
+  LogitsDType dtype = LogitsDType::FLOAT32;
+  size_t rows = 0;
+  size_t vocab_size = 0;
+  size_t row_stride = 0;
+
+  operator LogitsView() const {
+    return LogitsView{.data = data,
+                      .dtype = dtype,
+                      .rows = rows,
+                      .vocab_size = vocab_size,
+                      .row_stride = vocab_size ? row_stride : 0};
+  }
+};
+
+// Logits processors of one request, applied in the order they were added to
+// its row of logits, in place, before token selection (SelectTokensBatch).
+//
+// The chain keeps the state that the processors depend on: the number of
+// occurrences of each token (see AcceptTokens()), for the penalties, and the
+// allowed tokens (see SetAllowedTokens()), i.e. as computed by a grammar at
+// each step, for the token mask. Each processor only visits the tokens it
+// affects, except for the token mask which visits the masked out words once
+// per row. Tokens outside of the vocabulary are ignored.
+class SHORTFIN_API LogitsProcessorChain {
+ public:
+  // Divides the positive logits of the tokens which occurred by `penalty`,
+  // and multiplies the negative ones (> 1 discourages repetition).
+  LogitsProcessorChain &AddRepetitionPenalty(float penalty);
+  // Subtracts `presence_penalty` from the logits of the tokens which occurred,
+  // plus `frequency_penalty` times their number of occurrences.
+  LogitsProcessorChain &AddPresencePenalty(float presence_penalty,
+                                           float frequency_penalty = 0.f);
+  // Adds `bias[i].second` to the logit of token `bias[i].first`.
+  LogitsProcessorChain &AddLogitBias(
+      std::vector<std::pair<int32_t, float>> bias);
+  // Sets the logits of the tokens which are not allowed to -inf.
+  LogitsProcessorChain &AddTokenMask();
+
+  size_t size() const { return steps_.size(); }
+
+  // Counts the occurrence of each of `tokens` (i.e. the tokens selected at a
+  // step).
+  void AcceptTokens(std::span<const int32_t> tokens);
+  void ResetTokens() { token_counts_.clear(); }
+  // Allows the tokens set in the bitmask `mask` (token `t` is bit `t % 32` of
+  // word `t / 32`); tokens past its end are not allowed. Until set, or after
+  // ClearAllowedTokens(), all tokens are allowed.
+  void SetAllowedTokens(std::span<const uint32_t> mask);
+  void ClearAllowedTokens();
+
+  // Applies the chain to row `row` of `logits`.
+  void Apply(const MutableLogitsView &logits, size_t row) const;
+
+ private:
+  enum class Kind {
+    REPETITION_PENALTY,
+    PRESENCE_PENALTY,
+    LOGIT_BIAS,
+    TOKEN_MASK,
+  };
+  struct Step {
+    Kind kind;
+    float penalty = 0.f;
+    float frequency_penalty = 0.f;
+    std::vector<std::pair<int32_t, float>> bias;
+  };
+
+  std::vector<Step> steps_;
+  std::unordered_map<int32_t, uint32_t> token_counts_;
+  bool mask_set_ = false;
+  std::vector<uint32_t> allowed_tokens_;
+};
+
+// Applies `chains[r]` to row `r` of `logits` for each row, skipping rows whose
+// chain is null. Throws std::invalid_argument if there is not one chain per
+// row.
+SHORTFIN_API void ApplyLogitsProcessors(
+    const MutableLogitsView &logits,
+    std::span<const LogitsProcessorChain *const> chains);
+
+}  // namespace shortfin::llm
+
+#endif
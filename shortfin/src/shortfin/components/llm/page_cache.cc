@@ -0,0 +1,403 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/components/llm/page_cache.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "fmt/core.h"
+
+namespace shortfin::llm {
+
+// -------------------------------------------------------------------------- //
+// PagePool
+// -------------------------------------------------------------------------- //
+
+PagePool::PagePool(size_t page_count) : ref_counts_(page_count, 0) {
+  if (page_count > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    throw std::invalid_argument(
+        fmt::format("Page count {} is too large", page_count));
+  }
+  // The last page is acquired first.
+  free_.reserve(page_count);
+  for (size_t i = 0; i < page_count; ++i) {
+    free_.push_back(static_cast<int>(i));
+  }
+}
+
+void PagePool::CheckPage(int page) const {
+  if (page < 0 || static_cast<size_t>(page) >= ref_counts_.size()) {
+    throw std::invalid_argument(fmt::format(
+        "Page {} is outside of the pool of {} pages", page,
+        ref_counts_.size()));
+  }
+}
+
+size_t PagePool::available_count() {
+  iree::slim_mutex_lock_guard g(mu_);
+  return free_.size();
+}
+
+std::vector<int> PagePool::available_pages() {
+  iree::slim_mutex_lock_guard g(mu_);
+  return std::vector<int>(free_.rbegin(), free_.rend());
+}
+
+int PagePool::ref_count(int page) {
+  CheckPage(page);
+  iree::slim_mutex_lock_guard g(mu_);
+  return ref_counts_[page];
+}
+
+bool PagePool::Acquire(size_t count, std::vector<int> &pages) {
+  iree::slim_mutex_lock_guard g(mu_);
+  if (count > free_.size()) return false;
+  pages.reserve(pages.size() + count);
+  for (size_t i = 0; i < count; ++i) {
+    int page = free_.back();
+    free_.pop_back();
+    ref_counts_[page] = 1;
+    pages.push_back(page);
+  }
+  return true;
+}
+
+void PagePool::Retain(std::span<const int> pages) {
+  for (int page : pages) CheckPage(page);
+  iree::slim_mutex_lock_guard g(mu_);
+  for (int page : pages) {
+    if (ref_counts_[page] == 0) {
+      throw std::logic_error(
+          fmt::format("Cannot retain page {}, which is free", page));
+    }
+  }
+  for (int page : pages) ++ref_counts_[page];
+}
+
+void PagePool::Release(std::span<const int> pages) {
+  for (int page : pages) CheckPage(page);
+  iree::slim_mutex_lock_guard g(mu_);
+  for (int page : pages) {
+    if (ref_counts_[page] == 0) continue;
+    if (--ref_counts_[page] == 0) free_.push_back(page);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+// PrefixTrie
+// -------------------------------------------------------------------------- //
+
+PrefixTrie::PrefixTrie(size_t tokens_per_page, EvictionPolicy eviction_policy)
+    : tokens_per_page_(tokens_per_page),
+      eviction_policy_(eviction_policy),
+      stats_since_ns_(iree_time_now()) {
+  if (tokens_per_page == 0) {
+    throw std::invalid_argument("tokens_per_page must be positive");
+  }
+  NodeState &root = nodes_.emplace_back();
+  root.live = true;
+}
+
+uint64_t PrefixTrie::HashBlock(uint64_t parent_hash,
+                               std::span<const int> block) {
+  // 64-bit FNV-1a over the parent hash, the block length and the tokens,
+  // finished with a murmur3 mix so that the low bits used to bucket are well
+  // distributed.
+  uint64_t h = 0xcbf29ce484222325ull;
+  auto mix_in = [&](uint64_t v) {
+    h ^= v;
+    h *= 0x100000001b3ull;
+  };
+  mix_in(parent_hash);
+  mix_in(block.size());
+  for (int token : block) mix_in(static_cast<uint32_t>(token));
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+int PrefixTrie::Resolve(Node node) {
+  uint32_t index = static_cast<uint32_t>(node);
+  uint32_t generation = static_cast<uint32_t>(node >> 32);
+  if (index >= nodes_.size()) return -1;
+  NodeState &state = nodes_[index];
+  if (!state.live || state.generation != generation) return -1;
+  return static_cast<int>(index);
+}
+
+int PrefixTrie::FindChild(int parent, uint64_t hash,
+                          std::span<const int> block) {
+  auto [begin, end] = index_.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    NodeState &child = nodes_[it->second];
+    if (child.parent == parent &&
+        std::equal(block.begin(), block.end(), child.block.begin(),
+                   child.block.end())) {
+      return it->second;
+    }
+  }
+  return -1;
+}
+
+void PrefixTrie::List(int index, bool least_recent) {
+  NodeState &state = nodes_[index];
+  if (state.bucket >= 0 || !Evictable(state)) return;
+  int bucket_index = 0;
+  if (eviction_policy_ == EvictionPolicy::LFU) {
+    bucket_index = std::min<int>(std::bit_width(state.use_count),
+                                 kBucketCount - 1);
+  }
+  Bucket &bucket = buckets_[bucket_index];
+  state.bucket = bucket_index;
+  if (least_recent) {
+    state.prev = -1;
+    state.next = bucket.head;
+    if (bucket.head >= 0) nodes_[bucket.head].prev = index;
+    bucket.head = index;
+    if (bucket.tail < 0) bucket.tail = index;
+  } else {
+    state.prev = bucket.tail;
+    state.next = -1;
+    if (bucket.tail >= 0) nodes_[bucket.tail].next = index;
+    bucket.tail = index;
+    if (bucket.head < 0) bucket.head = index;
+  }
+  nonempty_buckets_ |= uint64_t{1} << bucket_index;
+  ++evictable_count_;
+}
+
+void PrefixTrie::Delist(int index) {
+  NodeState &state = nodes_[index];
+  if (state.bucket < 0) return;
+  Bucket &bucket = buckets_[state.bucket];
+  if (state.prev >= 0) {
+    nodes_[state.prev].next = state.next;
+  } else {
+    bucket.head = state.next;
+  }
+  if (state.next >= 0) {
+    nodes_[state.next].prev = state.prev;
+  } else {
+    bucket.tail = state.prev;
+  }
+  if (bucket.head < 0) nonempty_buckets_ &= ~(uint64_t{1} << state.bucket);
+  state.bucket = state.prev = state.next = -1;
+  --evictable_count_;
+}
+
+size_t PrefixTrie::node_count() {
+  iree::slim_mutex_lock_guard g(mu_);
+  return nodes_.size() - 1 - free_nodes_.size();
+}
+
+size_t PrefixTrie::leaf_count() {
+  iree::slim_mutex_lock_guard g(mu_);
+  return leaf_count_;
+}
+
+size_t PrefixTrie::evictable_count() {
+  iree::slim_mutex_lock_guard g(mu_);
+  return evictable_count_;
+}
+
+bool PrefixTrie::contains(Node node) {
+  iree::slim_mutex_lock_guard g(mu_);
+  return Resolve(node) >= 0;
+}
+
+int PrefixTrie::page(Node node) {
+  iree::slim_mutex_lock_guard g(mu_);
+  int index = Resolve(node);
+  return index < 0 ? -1 : nodes_[index].page;
+}
+
+int PrefixTrie::ref_count(Node node) {
+  iree::slim_mutex_lock_guard g(mu_);
+  int index = Resolve(node);
+  return index < 0 ? 0 : nodes_[index].ref_count;
+}
+
+uint64_t PrefixTrie::hash(Node node) {
+  iree::slim_mutex_lock_guard g(mu_);
+  int index = Resolve(node);
+  return index < 0 ? 0 : nodes_[index].hash;
+}
+
+PrefixTrie::Node PrefixTrie::Match(std::span<const int> tokens,
+                                   std::vector<int> &pages,
+                                   bool record_stats) {
+  iree::slim_mutex_lock_guard g(mu_);
+  size_t pages_before = pages.size();
+  int current = 0;
+  for (size_t begin = 0; begin + tokens_per_page_ <= tokens.size();
+       begin += tokens_per_page_) {
+    auto block = tokens.subspan(begin, tokens_per_page_);
+    int child =
+        FindChild(current, HashBlock(nodes_[current].hash, block), block);
+    if (child < 0) break;
+    current = child;
+    // Only leaves are listed: re-list them as most recently used.
+    NodeState &state = nodes_[current];
+    ++state.use_count;
+    if (state.bucket >= 0) {
+      Delist(current);
+      List(current);
+    }
+    pages.push_back(state.page);
+  }
+  if (record_stats) {
+    ++stats_.lookups;
+    stats_.lookup_blocks += tokens.size() / tokens_per_page_;
+    stats_.hit_blocks += pages.size() - pages_before;
+  }
+  return MakeHandle(current, nodes_[current].generation);
+}
+
+size_t PrefixTrie::MatchLength(std::span<const int> tokens) {
+  iree::slim_mutex_lock_guard g(mu_);
+  size_t blocks = 0;
+  int current = 0;
+  for (size_t begin = 0; begin + tokens_per_page_ <= tokens.size();
+       begin += tokens_per_page_) {
+    auto block = tokens.subspan(begin, tokens_per_page_);
+    current =
+        FindChild(current, HashBlock(nodes_[current].hash, block), block);
+    if (current < 0) break;
+    ++blocks;
+  }
+  return blocks;
+}
+
+PrefixTrie::Node PrefixTrie::CreateChild(Node parent,
+                                         std::span<const int> block,
+                                         int page) {
+  if (block.empty() || block.size() > tokens_per_page_) {
+    throw std::invalid_argument(
+        fmt::format("Block of {} tokens does not fit a page of {} tokens",
+                    block.size(), tokens_per_page_));
+  }
+  iree::slim_mutex_lock_guard g(mu_);
+  int parent_index = Resolve(parent);
+  if (parent_index < 0) {
+    throw std::invalid_argument("Parent node is no longer in the trie");
+  }
+  uint64_t hash = HashBlock(nodes_[parent_index].hash, block);
+  int index = FindChild(parent_index, hash, block);
+  if (index >= 0) {
+    return MakeHandle(index, nodes_[index].generation);
+  }
+
+  if (!free_nodes_.empty()) {
+    index = free_nodes_.back();
+    free_nodes_.pop_back();
+  } else {
+    index = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+  }
+  NodeState &parent_state = nodes_[parent_index];
+  if (parent_index != 0 && parent_state.child_count == 0) --leaf_count_;
+  ++parent_state.child_count;
+  ++leaf_count_;
+  Delist(parent_index);
+
+  NodeState &state = nodes_[index];
+  state.hash = hash;
+  state.live = true;
+  state.parent = parent_index;
+  state.page = page;
+  state.child_count = 0;
+  state.ref_count = 0;
+  state.use_count = 0;
+  state.block.assign(block.begin(), block.end());
+  index_.emplace(hash, index);
+  List(index);
+  return MakeHandle(index, state.generation);
+}
+
+void PrefixTrie::Retain(Node node) {
+  iree::slim_mutex_lock_guard g(mu_);
+  int index = Resolve(node);
+  if (index <= 0) return;
+  ++nodes_[index].ref_count;
+  Delist(index);
+}
+
+void PrefixTrie::Release(Node node) {
+  iree::slim_mutex_lock_guard g(mu_);
+  int index = Resolve(node);
+  if (index <= 0 || nodes_[index].ref_count == 0) return;
+  if (--nodes_[index].ref_count == 0) List(index);
+}
+
+void PrefixTrie::Unlink(int index) {
+  Delist(index);
+  NodeState &state = nodes_[index];
+  auto [begin, end] = index_.equal_range(state.hash);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second == index) {
+      index_.erase(it);
+      break;
+    }
+  }
+  NodeState &parent = nodes_[state.parent];
+  --parent.child_count;
+  --leaf_count_;
+  if (state.parent != 0 && parent.child_count == 0) ++leaf_count_;
+
+  state.live = false;
+  ++state.generation;
+  state.parent = -1;
+  state.page = -1;
+  state.block.clear();
+  free_nodes_.push_back(index);
+}
+
+size_t PrefixTrie::Evict(size_t max_pages, std::vector<int> &pages,
+                         std::vector<EvictedNode> *evicted_nodes) {
+  iree::slim_mutex_lock_guard g(mu_);
+  size_t evicted = 0;
+  while (evicted < max_pages && nonempty_buckets_) {
+    int index = buckets_[std::countr_zero(nonempty_buckets_)].head;
+    NodeState &state = nodes_[index];
+    int parent = state.parent;
+    pages.push_back(state.page);
+    if (evicted_nodes) {
+      evicted_nodes->push_back(EvictedNode{
+          .page = state.page,
+          .hash = state.hash,
+          .parent_hash = nodes_[parent].hash,
+          .block = std::move(state.block),
+      });
+    }
+    Unlink(index);
+    ++evicted;
+    List(parent, /*least_recent=*/true);
+  }
+  stats_.evictions += evicted;
+  return evicted;
+}
+
+PrefixTrie::Stats PrefixTrie::stats() {
+  iree::slim_mutex_lock_guard g(mu_);
+  Stats stats = stats_;
+  stats.duration_ns = iree_time_now() - stats_since_ns_;
+  return stats;
+}
+
+void PrefixTrie::ResetStats() {
+  iree::slim_mutex_lock_guard g(mu_);
+  stats_ = Stats();
+  stats_since_ns_ = iree_time_now();
+}
+
+}  // namespace shortfin::llm
@@ -0,0 +1,239 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_COMPONENTS_LLM_PAGE_CACHE_H
+#define SHORTFIN_COMPONENTS_LLM_PAGE_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "shortfin/support/api.h"
+#include "shortfin/support/iree_concurrency.h"
+
+namespace shortfin::llm {
+
+// Free list and reference counts of the pages of a paged KV cache, which are
+// identified by their index in [0, page_count). Only the bookkeeping lives
+// here: the page tables themselves are device arrays owned by the caller.
+//
+// Acquired pages start with a reference count of 1 and return to the free
+// list when it drops to 0. Pages are handed out last freed first, so that
+// recently used (and likely still resident) pages are reused. Thread safe.
+class SHORTFIN_API PagePool {
+ public:
+  explicit PagePool(size_t page_count);
+  PagePool(const PagePool &) = delete;
+
+  size_t page_count() const { return ref_counts_.size(); }
+  size_t available_count();
+  // Indices of the free pages, in the order they would be acquired.
+  std::vector<int> available_pages();
+  int ref_count(int page);
+
+  // Acquires `count` free pages, appending them to `pages`. Acquires nothing
+  // and returns false if fewer than `count` pages are free.
+  bool Acquire(size_t count, std::vector<int> &pages);
+  // Adds a reference to each of `pages`, which must be in use.
+  void Retain(std::span<const int> pages);
+  // Drops a reference to each of `pages`, freeing those with no references
+  // left. Releasing a free page is a no-op, so that pages can be released
+  // more than once.
+  void Release(std::span<const int> pages);
+
+ private:
+  void CheckPage(int page) const;
+
+  iree::slim_mutex mu_;
+  std::vector<uint32_t> ref_counts_ SHORTFIN_GUARDED_BY(mu_);
+  // Stack of free pages: the next one acquired is at the back.
+  std::vector<int> free_ SHORTFIN_GUARDED_BY(mu_);
+};
+
+// Prefix index over the pages of a paged KV cache: a trie whose edges are
+// blocks of up to `tokens_per_page` tokens and whose nodes each hold the page
+// caching their block, so that requests with a common prompt prefix share its
+// pages.
+//
+// Nodes are found by the hash of the block chained with the hash of its
+// parent (which identifies the whole prefix), through a single hash table,
+// so a lookup costs one hash of each block's tokens and one probe per block.
+// Blocks are compared on a hash match, so collisions cannot alias prefixes.
+//
+// Nodes are referred to by handles which stay unique after the node is
+// evicted: operations on a stale handle are no-ops (or fail lookups), as with
+// a detached node. Each node has a reference count of the allocations which
+// extend it. Leaves without references are evictable, as their pages are
+// needed, according to the EvictionPolicy. Handle 0 is the root, which has no
+// page. Thread safe.
+//
+// Evictable leaves are kept in intrusive lists, one per frequency bucket (the
+// bit width of the node's match count, a single bucket for LRU), each from
+// least to most recently used, with a bitmask of the non-empty buckets. A
+// leaf enters its list as the most recently used when it becomes evictable,
+// except for a parent exposed by evicting its last child, which is as old as
+// that child and so enters as the least recently used. Matching, eviction and
+// reference count changes are thus O(1) per node.
+class SHORTFIN_API PrefixTrie {
+ public:
+  using Node = uint64_t;
+  static constexpr Node kRoot = 0;
+
+  enum class EvictionPolicy {
+    // Least recently matched first.
+    LRU,
+    // Least frequently matched first (in power of two buckets of the number
+    // of matches), least recently matched first within a bucket.
+    LFU,
+  };
+
+  // Counters since construction or the last ResetStats().
+  struct Stats {
+    // Calls to Match(), the full blocks they looked up and those found.
+    uint64_t lookups = 0;
+    uint64_t lookup_blocks = 0;
+    uint64_t hit_blocks = 0;
+    // Evicted nodes.
+    uint64_t evictions = 0;
+    // Time over which the counters were collected.
+    iree_duration_t duration_ns = 0;
+
+    double hit_rate() const {
+      return lookup_blocks ? static_cast<double>(hit_blocks) / lookup_blocks
+                           : 0.0;
+    }
+    double evictions_per_second() const {
+      return duration_ns > 0 ? evictions * 1e9 / duration_ns : 0.0;
+    }
+  };
+
+  // A node removed by Evict(), identified by its hash(), which is enough to
+  // re-attach it below its parent (e.g. after swapping its page out to host
+  // memory and back in).
+  struct EvictedNode {
+    int page;
+    uint64_t hash;
+    uint64_t parent_hash;
+    std::vector<int> block;
+  };
+
+  explicit PrefixTrie(size_t tokens_per_page,
+                      EvictionPolicy eviction_policy = EvictionPolicy::LRU);
+  PrefixTrie(const PrefixTrie &) = delete;
+
+  size_t tokens_per_page() const { return tokens_per_page_; }
+  EvictionPolicy eviction_policy() const { return eviction_policy_; }
+  // Number of nodes other than the root.
+  size_t node_count();
+  size_t leaf_count();
+
+  // Whether `node` is (still) in the trie.
+  bool contains(Node node);
+  // The page of `node`, or -1 for the root or a stale handle.
+  int page(Node node);
+  int ref_count(Node node);
+  // Chained hash of the prefix ending in `node` (0 for the root or a stale
+  // handle). The hash of its child for `block` is HashBlock(hash, block).
+  uint64_t hash(Node node);
+  static uint64_t HashBlock(uint64_t parent_hash, std::span<const int> block);
+
+  // Follows the full blocks of `tokens` (any trailing partial block is
+  // ignored) from the root as far as they are cached, appending the page of
+  // each matched node to `pages` and marking it as used. Returns the last
+  // matched node (the root if none). Counts towards the lookup stats if
+  // `record_stats`.
+  Node Match(std::span<const int> tokens, std::vector<int> &pages,
+             bool record_stats = true);
+  // Number of full blocks of `tokens` cached from the root, without marking
+  // the nodes as used or counting towards the stats (i.e. to compare caches
+  // before choosing one).
+  size_t MatchLength(std::span<const int> tokens);
+
+  // Returns the child of `parent` for `block`, adding it with `page` if there
+  // is none. Otherwise the existing child and its page are kept (compare
+  // page() to see whether `page` was used). Throws std::invalid_argument if
+  // `parent` is stale or the block is empty or longer than a page.
+  Node CreateChild(Node parent, std::span<const int> block, int page);
+
+  // Adds or drops a reference to an allocation extending `node`. Dropping the
+  // last reference makes the node evictable once it is a leaf. Dropping a
+  // reference of a node without any is a no-op.
+  void Retain(Node node);
+  void Release(Node node);
+
+  // Evicts up to `max_pages` unreferenced leaves in the order of the
+  // eviction policy, along with the ancestors which become unreferenced
+  // leaves in the process. Appends the pages of the evicted nodes to `pages`
+  // and returns their number. Also appends the evicted nodes to
+  // `evicted_nodes` if given.
+  size_t Evict(size_t max_pages, std::vector<int> &pages,
+               std::vector<EvictedNode> *evicted_nodes = nullptr);
+  // Number of nodes which are currently evictable.
+  size_t evictable_count();
+
+  Stats stats();
+  void ResetStats();
+
+ private:
+  struct NodeState {
+    // Chained hash of the prefix ending in this node.
+    uint64_t hash = 0;
+    uint32_t generation = 0;
+    bool live = false;
+    int parent = -1;
+    int page = -1;
+    uint32_t child_count = 0;
+    uint32_t ref_count = 0;
+    uint64_t use_count = 0;
+    // Position in the evictable lists (bucket -1 if not evictable).
+    int bucket = -1;
+    int prev = -1;
+    int next = -1;
+    std::vector<int> block;
+  };
+  struct Bucket {
+    int head = -1;  // Least recently used.
+    int tail = -1;
+  };
+  static constexpr int kBucketCount = 64;
+
+  static Node MakeHandle(int index, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) |
+           static_cast<uint32_t>(index);
+  }
+  int Resolve(Node node) SHORTFIN_REQUIRES_LOCK(mu_);
+  int FindChild(int parent, uint64_t hash, std::span<const int> block)
+      SHORTFIN_REQUIRES_LOCK(mu_);
+  void Unlink(int index) SHORTFIN_REQUIRES_LOCK(mu_);
+  bool Evictable(const NodeState &state) const {
+    return state.live && state.parent >= 0 && state.child_count == 0 &&
+           state.ref_count == 0;
+  }
+  // Adds `index` to its evictable list (if it is evictable and not already
+  // listed) as the most or least recently used, or removes it.
+  void List(int index, bool least_recent = false) SHORTFIN_REQUIRES_LOCK(mu_);
+  void Delist(int index) SHORTFIN_REQUIRES_LOCK(mu_);
+
+  size_t tokens_per_page_;
+  EvictionPolicy eviction_policy_;
+  iree::slim_mutex mu_;
+  std::vector<NodeState> nodes_ SHORTFIN_GUARDED_BY(mu_);
+  std::vector<int> free_nodes_ SHORTFIN_GUARDED_BY(mu_);
+  std::unordered_multimap<uint64_t, int> index_ SHORTFIN_GUARDED_BY(mu_);
+  size_t leaf_count_ SHORTFIN_GUARDED_BY(mu_) = 0;
+  std::array<Bucket, kBucketCount> buckets_ SHORTFIN_GUARDED_BY(mu_);
+  uint64_t nonempty_buckets_ SHORTFIN_GUARDED_BY(mu_) = 0;
+  size_t evictable_count_ SHORTFIN_GUARDED_BY(mu_) = 0;
+  Stats stats_ SHORTFIN_GUARDED_BY(mu_);
+  iree_time_t stats_since_ns_ SHORTFIN_GUARDED_BY(mu_);
+};
+
+}  // namespace shortfin::llm
+
+#endif
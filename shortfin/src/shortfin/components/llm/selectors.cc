@@ -7,11 +7,533 @@
 #include "shortfin/components/llm/selectors.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "fmt/core.h"
+#include "iree/base/internal/math.h"
+#include "shortfin/array/host_kernels.h"
+
 namespace shortfin::llm {
 
+namespace {
+
+namespace host_kernels = array::host_kernels;
+
+struct SampleCandidate {
+  float value;  // Temperature-scaled logit.
+  int token;
+};
+
+// Orders candidates from most to least likely, breaking ties by token id.
+bool MoreLikely(const SampleCandidate &a, const SampleCandidate &b) {
+  return a.value > b.value || (a.value == b.value && a.token < b.token);
+}
+
+// Streams `values` into `heap`, a min-heap (under MoreLikely) of the `k` most
+// likely candidates, skipping NaNs. Values stream in token order, so once the
+// heap is full only values strictly above its least likely candidate can
+// enter. Blocks of values without any are skipped by a branch free scan that
+// the compiler vectorizes, which is nearly all blocks for realistic logits
+// and small k.
+template <typename Storage, typename ToFloat>
+void StreamTopK(const Storage *values, size_t count, size_t k,
+                ToFloat to_float, std::vector<SampleCandidate> &heap) {
+  constexpr size_t kBlockSize = 64;
+  heap.clear();
+  if (k == 0) return;
+  for (size_t begin = 0; begin < count; begin += kBlockSize) {
+    size_t end = std::min(begin + kBlockSize, count);
+    if (heap.size() == k) {
+      float threshold = heap.front().value;
+      // Counting (rather than or-ing flags) is what vectorizes.
+      int above = 0;
+      for (size_t i = begin; i < end; ++i) {
+        above += to_float(values[i]) > threshold;
+      }
+      if (!above) continue;
+    }
+    for (size_t i = begin; i < end; ++i) {
+      float v = to_float(values[i]);
+      if (std::isnan(v)) continue;
+      if (heap.size() < k) {
+        heap.push_back({v, static_cast<int>(i)});
+        std::push_heap(heap.begin(), heap.end(), MoreLikely);
+      } else if (v > heap.front().value) {
+        std::pop_heap(heap.begin(), heap.end(), MoreLikely);
+        heap.back() = {v, static_cast<int>(i)};
+        std::push_heap(heap.begin(), heap.end(), MoreLikely);
+      }
+    }
+  }
+  // Most likely first.
+  std::sort_heap(heap.begin(), heap.end(), MoreLikely);
+}
+
+// Selects from one row of logits stored as `Storage`, read through `to_float`.
+template <typename Storage, typename ToFloat>
+void SelectRow(const Storage *row, size_t vocab_size,
+               const DecodeConfig &config, ToFloat to_float,
+               std::vector<SampleCandidate> &candidates, std::span<int> tokens,
+               std::span<float> scores) {
+  size_t width = tokens.size();
+  size_t num_select = config.use_beam_search
+                          ? std::max<size_t>(config.num_beams, 1)
+                          : 1;
+  num_select = std::min({num_select, width, vocab_size});
+  StreamTopK(row, vocab_size, num_select, to_float, candidates);
+  for (size_t j = 0; j < width; ++j) {
+    if (j < candidates.size()) {
+      tokens[j] = candidates[j].token;
+      scores[j] = candidates[j].value;
+    } else {
+      tokens[j] = -1;
+      scores[j] = -std::numeric_limits<float>::infinity();
+    }
+  }
+}
+
+// Sampling parameters derived from a DecodeConfig for a vocabulary size.
+struct SamplingParams {
+  SamplingParams(const DecodeConfig &config, size_t vocab_size)
+      : greedy(config.temperature <= 0.f || config.top_k == 1),
+        inv_temperature(config.temperature > 0.f ? 1.f / config.temperature
+                                                 : 1.f),
+        top_k(!greedy && config.top_k > 0
+                  ? std::min<size_t>(config.top_k, vocab_size)
+                  : 0),
+        use_top_p(!greedy && config.top_p > 0.f && config.top_p < 1.f),
+        top_p(config.top_p),
+        logits_normalization(config.logits_normalization) {}
+
+  bool greedy;
+  float inv_temperature;
+  size_t top_k;
+  bool use_top_p;
+  float top_p;
+  LogitsNormalization logits_normalization;
+};
+
+// Samples one token from a row of logits stored as `Storage`, returning it
+// with its score. `next_uniform` draws from [0, 1). `candidates` and
+// `weights` are scratch, bounded by top_k or by the nucleus bound below when
+// only top_p is set.
+template <typename Storage, typename ToFloat, typename NextUniform>
+std::pair<int, float> SampleRow(const Storage *row, size_t vocab_size,
+                                const SamplingParams &params,
+                                ToFloat to_float, NextUniform &&next_uniform,
+                                std::vector<SampleCandidate> &candidates,
+                                std::vector<double> &weights) {
+  constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+  candidates.clear();
+
+  // Pass 1: running max and partition sum (rescaled whenever the max
+  // moves), plus a min-heap of the top_k candidates.
+  float max = kNegInf;
+  double sum = 0.0;
+  int argmax = 0;
+  for (size_t i = 0; i < vocab_size; ++i) {
+    float v = to_float(row[i]) * params.inv_temperature;
+    if (std::isnan(v)) continue;
+    if (v > max) {
+      sum = sum * std::exp(static_cast<double>(max - v)) + 1.0;
+      max = v;
+      argmax = static_cast<int>(i);
+    } else if (max != kNegInf) {
+      sum += std::exp(v - max);
+    }
+    if (params.top_k > 0) {
+      SampleCandidate c{v, static_cast<int>(i)};
+      if (candidates.size() < params.top_k) {
+        candidates.push_back(c);
+        std::push_heap(candidates.begin(), candidates.end(), MoreLikely);
+      } else if (MoreLikely(c, candidates.front())) {
+        std::pop_heap(candidates.begin(), candidates.end(), MoreLikely);
+        candidates.back() = c;
+        std::push_heap(candidates.begin(), candidates.end(), MoreLikely);
+      }
+    }
+  }
+
+  int token = argmax;
+  float value = max;
+  if (params.greedy || max == kNegInf) {
+    // Argmax already found.
+  } else if (params.top_k > 0 || params.use_top_p) {
+    if (params.top_k == 0) {
+      // Pass 2: gather the nucleus. A token with probability below
+      // (1 - top_p) / vocab_size can never be part of it, since every
+      // token after it in sorted order is at most as likely, leaving less
+      // than 1 - top_p of mass for the tail.
+      float threshold = max + static_cast<float>(std::log(
+                                  sum * (1.0 - params.top_p) / vocab_size));
+      for (size_t i = 0; i < vocab_size; ++i) {
+        float v = to_float(row[i]) * params.inv_temperature;
+        if (v >= threshold) {
+          candidates.push_back({v, static_cast<int>(i)});
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end(), MoreLikely);
+
+    weights.resize(candidates.size());
+    double mass = 0.0;
+    for (size_t j = 0; j < candidates.size(); ++j) {
+      weights[j] = std::exp(candidates[j].value - max);
+      mass += weights[j];
+    }
+    size_t keep = candidates.size();
+    if (params.use_top_p) {
+      // The nucleus is taken over the top_k-renormalized distribution.
+      double target = params.top_p * (params.top_k > 0 ? mass : sum);
+      double cumulative = 0.0;
+      for (keep = 0; keep < candidates.size();) {
+        cumulative += weights[keep++];
+        if (cumulative >= target) break;
+      }
+      mass = cumulative;
+    }
+
+    double target = next_uniform() * mass;
+    double cumulative = 0.0;
+    size_t selected = keep - 1;
+    for (size_t j = 0; j < keep; ++j) {
+      cumulative += weights[j];
+      if (cumulative > target) {
+        selected = j;
+        break;
+      }
+    }
+    token = candidates[selected].token;
+    value = candidates[selected].value;
+  } else {
+    // Pass 2: inverse CDF over the unrestricted distribution.
+    double target = next_uniform() * sum;
+    double cumulative = 0.0;
+    for (size_t i = 0; i < vocab_size; ++i) {
+      float v = to_float(row[i]) * params.inv_temperature;
+      if (std::isnan(v)) continue;
+      cumulative += std::exp(v - max);
+      if (cumulative > target) {
+        token = static_cast<int>(i);
+        value = v;
+        break;
+      }
+    }
+  }
+
+  float score = value;
+  if (max != kNegInf) {
+    switch (params.logits_normalization) {
+      case LogitsNormalization::NONE:
+        break;
+      case LogitsNormalization::SOFTMAX:
+        score = static_cast<float>(std::exp(value - max) / sum);
+        break;
+      case LogitsNormalization::LOG_SOFTMAX:
+        score = value - max - static_cast<float>(std::log(sum));
+        break;
+    }
+  }
+  return {token, score};
+}
+
+// Advances a splitmix64 state, returning a uniform double in [0, 1). This is
+// small enough to keep one state per request.
+double NextUniform(uint64_t &state) {
+  uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  z ^= z >> 31;
+  return (z >> 11) * 0x1.0p-53;
+}
+
+// Whether SelectRow selects only the argmax of a row with `config`.
+bool SelectsArgmax(const DecodeConfig &config, size_t width) {
+  return !UsesSampling(config) &&
+         (!config.use_beam_search || config.num_beams <= 1 || width == 1);
+}
+
+host_kernels::Format KernelFormat(LogitsDType dtype) {
+  switch (dtype) {
+    case LogitsDType::FLOAT16:
+      return host_kernels::Format::F16;
+    case LogitsDType::BFLOAT16:
+      return host_kernels::Format::BF16;
+    default:
+      return host_kernels::Format::F32;
+  }
+}
+
+template <typename Storage, typename ToFloat>
+void SelectRows(const LogitsView &logits, const Storage *data,
+                ToFloat to_float, std::span<const DecodeConfig> configs,
+                size_t width, std::span<int> selected_tokens,
+                std::span<float> selected_scores,
+                std::span<uint64_t> rng_states) {
+  constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+  std::vector<SampleCandidate> candidates;
+  std::vector<double> weights;
+  std::vector<int64_t> argmax;
+  candidates.reserve(width);
+  auto config_of = [&](size_t r) -> const DecodeConfig & {
+    return configs[configs.size() == 1 ? 0 : r];
+  };
+  for (size_t r = 0; r < logits.rows;) {
+    // Runs of rows selecting their argmax are reduced by the vectorized host
+    // kernel, directly on the fp16 / bf16 storage.
+    size_t run_end = r;
+    while (logits.vocab_size > 0 && run_end < logits.rows &&
+           SelectsArgmax(config_of(run_end), width)) {
+      ++run_end;
+    }
+    if (run_end > r) {
+      argmax.resize(run_end - r);
+      host_kernels::ArgmaxRows(KernelFormat(logits.dtype),
+                               data + r * logits.row_stride, run_end - r,
+                               logits.vocab_size, logits.row_stride,
+                               argmax.data());
+      for (size_t run_start = r; r < run_end; ++r) {
+        const Storage *row = data + r * logits.row_stride;
+        auto tokens = selected_tokens.subspan(r * width, width);
+        auto scores = selected_scores.subspan(r * width, width);
+        int64_t token = argmax[r - run_start];
+        float score = to_float(row[token]);
+        if (std::isnan(score)) {
+          // The kernel ignores NaNs, but returns 0 for rows of only NaNs or
+          // masked values, which SelectRow tells apart.
+          SelectRow(row, logits.vocab_size, config_of(r), to_float,
+                    candidates, tokens, scores);
+          continue;
+        }
+        tokens[0] = static_cast<int>(token);
+        scores[0] = score;
+        std::fill(tokens.begin() + 1, tokens.end(), -1);
+        std::fill(scores.begin() + 1, scores.end(), kNegInf);
+      }
+      continue;
+    }
+
+    const Storage *row = data + r * logits.row_stride;
+    const DecodeConfig &config = config_of(r);
+    auto tokens = selected_tokens.subspan(r * width, width);
+    auto scores = selected_scores.subspan(r * width, width);
+    if (!UsesSampling(config) || logits.vocab_size == 0) {
+      SelectRow(row, logits.vocab_size, config, to_float, candidates, tokens,
+                scores);
+    } else {
+      SamplingParams params(config, logits.vocab_size);
+      std::tie(tokens[0], scores[0]) = SampleRow(
+          row, logits.vocab_size, params, to_float,
+          [&]() { return NextUniform(rng_states[r]); }, candidates, weights);
+      std::fill(tokens.begin() + 1, tokens.end(), -1);
+      std::fill(scores.begin() + 1, scores.end(), kNegInf);
+    }
+    ++r;
+  }
+}
+
+// Calls `f(data, to_float)` with the logits data typed by its storage and the
+// conversion of that storage to float.
+template <typename F>
+void VisitLogits(const LogitsView &logits, F &&f) {
+  switch (logits.dtype) {
+    case LogitsDType::FLOAT32:
+      f(static_cast<const float *>(logits.data), [](float v) { return v; });
+      break;
+    case LogitsDType::FLOAT16:
+      f(static_cast<const uint16_t *>(logits.data),
+        [](uint16_t v) { return iree_math_f16_to_f32(v); });
+      break;
+    case LogitsDType::BFLOAT16:
+      f(static_cast<const uint16_t *>(logits.data),
+        [](uint16_t v) { return iree_math_bf16_to_f32(v); });
+      break;
+  }
+}
+
+// The temperature-scaled softmax of a row restricted to its top_k / top_p
+// candidates, evaluated lazily so that nothing vocabulary-sized is
+// materialized: tokens at least as likely (under MoreLikely) as the least
+// likely kept candidate have probability `exp(v - max) / mass`, others 0.
+struct RowDistribution {
+  float inv_temperature = 1.f;
+  float max = -std::numeric_limits<float>::infinity();
+  double mass = 0.0;
+  SampleCandidate cutoff{-std::numeric_limits<float>::infinity(),
+                         std::numeric_limits<int>::max()};
+
+  double Probability(float logit, int token) const {
+    float v = logit * inv_temperature;
+    if (mass <= 0.0 || !(v > cutoff.value ||
+                         (v == cutoff.value && token <= cutoff.token))) {
+      return 0.0;
+    }
+    return std::exp(static_cast<double>(v - max)) / mass;
+  }
+};
+
+template <typename Storage, typename ToFloat>
+RowDistribution ComputeDistribution(const Storage *row, size_t vocab_size,
+                                    const SamplingParams &params,
+                                    ToFloat to_float,
+                                    std::vector<SampleCandidate> &candidates) {
+  RowDistribution dist;
+  dist.inv_temperature = params.inv_temperature;
+  auto scaled = [&](Storage v) { return to_float(v) * params.inv_temperature; };
+  double sum = 0.0;
+  for (size_t i = 0; i < vocab_size; ++i) {
+    float v = scaled(row[i]);
+    if (std::isnan(v)) continue;
+    if (v > dist.max) {
+      sum = sum * std::exp(static_cast<double>(dist.max - v)) + 1.0;
+      dist.max = v;
+    } else if (dist.max != -std::numeric_limits<float>::infinity()) {
+      sum += std::exp(v - dist.max);
+    }
+  }
+  dist.mass = sum;
+  if (dist.max == -std::numeric_limits<float>::infinity() ||
+      (params.top_k == 0 && !params.use_top_p)) {
+    return dist;
+  }
+
+  if (params.top_k > 0) {
+    StreamTopK(row, vocab_size, params.top_k, scaled, candidates);
+  } else {
+    // Same nucleus bound as SampleRow.
+    float threshold = dist.max + static_cast<float>(std::log(
+                                     sum * (1.0 - params.top_p) / vocab_size));
+    candidates.clear();
+    for (size_t i = 0; i < vocab_size; ++i) {
+      float v = scaled(row[i]);
+      if (v >= threshold) candidates.push_back({v, static_cast<int>(i)});
+    }
+    std::sort(candidates.begin(), candidates.end(), MoreLikely);
+  }
+  double total = 0.0;
+  for (auto &c : candidates) total += std::exp(c.value - dist.max);
+  double target = params.use_top_p
+                      ? params.top_p * (params.top_k > 0 ? total : sum)
+                      : std::numeric_limits<double>::infinity();
+  double mass = 0.0;
+  size_t keep = 0;
+  while (keep < candidates.size()) {
+    mass += std::exp(candidates[keep++].value - dist.max);
+    if (mass >= target) break;
+  }
+  dist.mass = mass;
+  if (keep > 0) dist.cutoff = candidates[keep - 1];
+  return dist;
+}
+
+// Samples a token in [0, vocab_size) with probability proportional to
+// `weight(i)` by inverse CDF, given a uniform draw `u` in [0, 1). Returns -1
+// if all weights are 0.
+template <typename Weight>
+int SampleWeighted(size_t vocab_size, Weight weight, double u) {
+  double total = 0.0;
+  for (size_t i = 0; i < vocab_size; ++i) total += weight(i);
+  if (!(total > 0.0)) return -1;
+  double target = u * total;
+  double cumulative = 0.0;
+  int last = -1;
+  for (size_t i = 0; i < vocab_size; ++i) {
+    double w = weight(i);
+    if (w <= 0.0) continue;
+    last = static_cast<int>(i);
+    cumulative += w;
+    if (cumulative > target) break;
+  }
+  return last;
+}
+
+template <typename Storage, typename ToFloat>
+int ArgmaxRow(const Storage *row, size_t vocab_size, ToFloat to_float,
+              std::vector<SampleCandidate> &candidates) {
+  StreamTopK(row, vocab_size, 1, to_float, candidates);
+  return candidates.empty() ? 0 : candidates.front().token;
+}
+
+// Verifies the draft tokens of one request, returning the number accepted and
+// the token which follows them.
+template <typename TargetStorage, typename TargetToFloat,
+          typename DraftStorage, typename DraftToFloat>
+std::pair<int, int> VerifyRequest(
+    const TargetStorage *target, size_t target_stride,
+    TargetToFloat target_to_float, const DraftStorage *draft,
+    size_t draft_stride, DraftToFloat draft_to_float, size_t vocab_size,
+    std::span<const int> draft_tokens, const DecodeConfig &config,
+    uint64_t *rng_state, std::vector<SampleCandidate> &candidates,
+    std::vector<double> &weights) {
+  size_t draft_len = draft_tokens.size();
+  if (!UsesSampling(config)) {
+    for (size_t i = 0; i < draft_len; ++i) {
+      int token = ArgmaxRow(target + i * target_stride, vocab_size,
+                            target_to_float, candidates);
+      if (token != draft_tokens[i]) return {static_cast<int>(i), token};
+    }
+    return {static_cast<int>(draft_len),
+            ArgmaxRow(target + draft_len * target_stride, vocab_size,
+                      target_to_float, candidates)};
+  }
+
+  SamplingParams params(config, vocab_size);
+  for (size_t i = 0; i < draft_len; ++i) {
+    const TargetStorage *p_row = target + i * target_stride;
+    const DraftStorage *q_row = draft + i * draft_stride;
+    RowDistribution p = ComputeDistribution(p_row, vocab_size, params,
+                                            target_to_float, candidates);
+    RowDistribution q = ComputeDistribution(q_row, vocab_size, params,
+                                            draft_to_float, candidates);
+    int d = draft_tokens[i];
+    double p_d = p.Probability(target_to_float(p_row[d]), d);
+    double q_d = q.Probability(draft_to_float(q_row[d]), d);
+    // Accept with probability min(1, p_d / q_d).
+    if (NextUniform(*rng_state) * q_d < p_d) continue;
+
+    // Rejected: resample from the residual max(0, p - q), which is only
+    // degenerate if p == q (and then the draft token is always accepted
+    // barring rounding), in which case p itself is sampled.
+    double u = NextUniform(*rng_state);
+    int token = SampleWeighted(
+        vocab_size,
+        [&](size_t j) {
+          int t = static_cast<int>(j);
+          return std::max(p.Probability(target_to_float(p_row[j]), t) -
+                              q.Probability(draft_to_float(q_row[j]), t),
+                          0.0);
+        },
+        u);
+    if (token < 0) {
+      token = SampleWeighted(
+          vocab_size,
+          [&](size_t j) {
+            return p.Probability(target_to_float(p_row[j]),
+                                 static_cast<int>(j));
+          },
+          u);
+    }
+    return {static_cast<int>(i), std::max(token, 0)};
+  }
+
+  // All accepted: sample the bonus token from the last target row.
+  int token = SampleRow(
+                  target + draft_len * target_stride, vocab_size, params,
+                  target_to_float, [&]() { return NextUniform(*rng_state); },
+                  candidates, weights)
+                  .first;
+  return {static_cast<int>(draft_len), token};
+}
+
+}  // namespace
+
 void SelectTokensTopK(const std::vector<float> &scores,
                       const DecodeConfig &config,
                       std::vector<int> &selected_tokens,
@@ -29,22 +551,19 @@ void SelectTokensTopK(const std::vector<float> &scores,
     std::iota(selected_tokens.begin(), selected_tokens.end(), 0);
     selected_scores = scores;
   } else {
-    // Create indices and sort by scores in descending order
-    std::vector<int> indices(vocab_size);
-    std::iota(indices.begin(), indices.end(), 0);
+    // Scratch is reused across steps (and calls from the same thread), so
+    // that steady state beam search does not allocate.
+    thread_local std::vector<SampleCandidate> candidates;
+    StreamTopK(
+        scores.data(), scores.size(), std::max(num_select, 0),
+        [](float v) { return v; }, candidates);
 
-    // Get top k elements
-    std::partial_sort(
-        indices.begin(), indices.begin() + num_select, indices.end(),
-        [&scores](int i, int j) { return scores[i] > scores[j]; });
-
-    // Extract top k tokens and scores
-    selected_tokens.resize(num_select);
-    selected_scores.resize(num_select);
-
-    for (int i = 0; i < num_select; ++i) {
-      selected_tokens[i] = indices[i];
-      selected_scores[i] = scores[indices[i]];
+    // NaNs are never selected, so there may be fewer than num_select.
+    selected_tokens.resize(candidates.size());
+    selected_scores.resize(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      selected_tokens[i] = candidates[i].token;
+      selected_scores[i] = candidates[i].value;
     }
   }
 }
@@ -75,4 +594,162 @@ void SelectTokens(const std::vector<float> &scores, const DecodeConfig &config,
   }
 }
 
+bool UsesSampling(const DecodeConfig &config) {
+  return !config.use_beam_search && config.temperature > 0.f &&
+         (config.top_k > 1 || (config.top_p > 0.f && config.top_p < 1.f));
+}
+
+void SelectTokensBatch(const LogitsView &logits,
+                       std::span<const DecodeConfig> configs,
+                       std::span<int> selected_tokens,
+                       std::span<float> selected_scores,
+                       std::span<uint64_t> rng_states) {
+  if (logits.rows == 0) return;
+  if (configs.size() != 1 && configs.size() != logits.rows) {
+    throw std::invalid_argument(
+        fmt::format("Expected 1 or {} decode configs but got {}", logits.rows,
+                    configs.size()));
+  }
+  size_t width = selected_tokens.size() / logits.rows;
+  if (width == 0 || selected_tokens.size() != width * logits.rows ||
+      selected_scores.size() != selected_tokens.size()) {
+    throw std::invalid_argument(fmt::format(
+        "Selection outputs of size {} and {} do not hold a whole number of "
+        "selections for each of {} rows",
+        selected_tokens.size(), selected_scores.size(), logits.rows));
+  }
+  if (rng_states.size() != logits.rows &&
+      std::any_of(configs.begin(), configs.end(), UsesSampling)) {
+    throw std::invalid_argument(
+        fmt::format("Sampling {} rows requires one RNG state per row (got {})",
+                    logits.rows, rng_states.size()));
+  }
+  if (logits.rows > 1 && logits.row_stride < logits.vocab_size) {
+    throw std::invalid_argument(
+        fmt::format("Logits row stride {} is less than the vocab size {}",
+                    logits.row_stride, logits.vocab_size));
+  }
+
+  VisitLogits(logits, [&](auto data, auto to_float) {
+    SelectRows(logits, data, to_float, configs, width, selected_tokens,
+               selected_scores, rng_states);
+  });
+}
+
+void SampleTokens(const float *logits, size_t rows, size_t vocab_size,
+                  const DecodeConfig &config, uint64_t seed,
+                  std::vector<int> &selected_tokens,
+                  std::vector<float> &selected_scores) noexcept {
+  selected_tokens.clear();
+  selected_scores.clear();
+  if (vocab_size == 0) return;
+  selected_tokens.reserve(rows);
+  selected_scores.reserve(rows);
+
+  SamplingParams params(config, vocab_size);
+  std::mt19937_64 engine(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  // Scratch reused across rows.
+  std::vector<SampleCandidate> candidates;
+  std::vector<double> weights;
+  candidates.reserve(params.top_k);
+
+  for (size_t r = 0; r < rows; ++r) {
+    auto [token, score] = SampleRow(
+        logits + r * vocab_size, vocab_size, params, [](float v) { return v; },
+        [&]() { return uniform(engine); }, candidates, weights);
+    selected_tokens.push_back(token);
+    selected_scores.push_back(score);
+  }
+}
+
+void VerifyDraftTokens(const LogitsView &target_logits,
+                       const LogitsView &draft_logits,
+                       std::span<const int> draft_tokens,
+                       std::span<const DecodeConfig> configs,
+                       std::span<int> accepted_counts,
+                       std::span<int> next_tokens,
+                       std::span<uint64_t> rng_states) {
+  size_t batch = accepted_counts.size();
+  if (batch == 0) return;
+  if (next_tokens.size() != batch) {
+    throw std::invalid_argument(
+        fmt::format("Expected {} next tokens but got {}", batch,
+                    next_tokens.size()));
+  }
+  if (configs.size() != 1 && configs.size() != batch) {
+    throw std::invalid_argument(fmt::format(
+        "Expected 1 or {} decode configs but got {}", batch, configs.size()));
+  }
+  size_t draft_len = draft_tokens.size() / batch;
+  if (draft_tokens.size() != draft_len * batch) {
+    throw std::invalid_argument(fmt::format(
+        "{} draft tokens are not a whole number for each of {} requests",
+        draft_tokens.size(), batch));
+  }
+  if (target_logits.rows != batch * (draft_len + 1)) {
+    throw std::invalid_argument(fmt::format(
+        "Expected {} target logits rows for {} requests of {} draft tokens "
+        "but got {}",
+        batch * (draft_len + 1), batch, draft_len, target_logits.rows));
+  }
+  for (auto &config : configs) {
+    if (config.use_beam_search) {
+      throw std::invalid_argument(
+          "Draft tokens cannot be verified for beam search");
+    }
+  }
+  bool sampling = std::any_of(configs.begin(), configs.end(), UsesSampling);
+  if (sampling) {
+    if (draft_logits.rows != batch * draft_len ||
+        draft_logits.vocab_size != target_logits.vocab_size) {
+      throw std::invalid_argument(fmt::format(
+          "Sampled verification requires [{}, {}] draft logits but got "
+          "[{}, {}]",
+          batch * draft_len, target_logits.vocab_size, draft_logits.rows,
+          draft_logits.vocab_size));
+    }
+    if (rng_states.size() != batch) {
+      throw std::invalid_argument(fmt::format(
+          "Sampling {} requests requires one RNG state per request (got {})",
+          batch, rng_states.size()));
+    }
+  }
+  for (const LogitsView *logits : {&target_logits, &draft_logits}) {
+    if (logits->rows > 1 && logits->row_stride < logits->vocab_size) {
+      throw std::invalid_argument(
+          fmt::format("Logits row stride {} is less than the vocab size {}",
+                      logits->row_stride, logits->vocab_size));
+    }
+  }
+  size_t vocab_size = target_logits.vocab_size;
+  for (int token : draft_tokens) {
+    if (token < 0 || static_cast<size_t>(token) >= vocab_size) {
+      throw std::invalid_argument(fmt::format(
+          "Draft token {} is outside of the vocabulary of {}", token,
+          vocab_size));
+    }
+  }
+
+  // Without sampling the draft logits are never read, and may be absent.
+  LogitsView draft_view = draft_logits;
+  if (!draft_view.data) draft_view = target_logits;
+  VisitLogits(target_logits, [&](auto target, auto target_to_float) {
+    VisitLogits(draft_view, [&](auto draft, auto draft_to_float) {
+      std::vector<SampleCandidate> candidates;
+      std::vector<double> weights;
+      for (size_t b = 0; b < batch; ++b) {
+        std::tie(accepted_counts[b], next_tokens[b]) = VerifyRequest(
+            target + b * (draft_len + 1) * target_logits.row_stride,
+            target_logits.row_stride, target_to_float,
+            draft + (sampling ? b * draft_len * draft_view.row_stride : 0),
+            draft_view.row_stride, draft_to_float, vocab_size,
+            draft_tokens.subspan(b * draft_len, draft_len),
+            configs[configs.size() == 1 ? 0 : b],
+            sampling ? &rng_states[b] : nullptr, candidates, weights);
+      }
+    });
+  });
+}
+
 }  // namespace shortfin::llm
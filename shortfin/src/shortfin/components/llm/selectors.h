@@ -7,6 +7,9 @@
 #ifndef SHORTFIN_COMPONENTS_LLM_SELECTORS_H
 #define SHORTFIN_COMPONENTS_LLM_SELECTORS_H
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 #include "shortfin/components/llm/data.h"
@@ -18,6 +21,109 @@ SHORTFIN_API void SelectTokens(const std::vector<float> &scores,
                                std::vector<int> &selected_tokens,
                                std::vector<float> &selected_scores) noexcept;
 
+// Samples one token per row of the row-major `[rows, vocab_size]` `logits`.
+// Each row is scaled by `config.temperature`, restricted to the `config.top_k`
+// most likely tokens and then to the `config.top_p` nucleus, and sampled with
+// a generator seeded by `seed`. A top_k of 1 or a non-positive temperature
+// selects the argmax.
+//
+// Normalization, top-k and the partition sum are fused into a single pass over
+// each row. A second pass is only needed to gather the nucleus when top_p is
+// set without top_k, or to sample from the unrestricted distribution. No
+// vocabulary-sized temporaries are materialized.
+//
+// The score of each selected token follows `config.logits_normalization`:
+// the temperature-scaled logit for NONE, or its (log) probability under the
+// unrestricted temperature-scaled distribution for (LOG_)SOFTMAX.
+SHORTFIN_API void SampleTokens(const float *logits, size_t rows,
+                               size_t vocab_size, const DecodeConfig &config,
+                               uint64_t seed, std::vector<int> &selected_tokens,
+                               std::vector<float> &selected_scores) noexcept;
+
+enum class LogitsDType {
+  FLOAT32,
+  FLOAT16,
+  BFLOAT16,
+};
+
+// A `[rows, vocab_size]` view of logits (i.e. of a mapped device_array), with
+// the first element of each row `row_stride` elements after the previous one.
+struct SHORTFIN_API LogitsView {
+  const void *data = nullptr;
+  LogitsDType dtype = LogitsDType::FLOAT32;
+  size_t rows = 0;
+  size_t vocab_size = 0;
+  size_t row_stride = 0;
+};
+
+// Whether SelectTokensBatch samples rows with `config`, which is if it is not
+// beam search, has a positive temperature and restricts the distribution with
+// a top_k above 1 or a top_p in (0, 1). Other rows are selected greedily, as
+// with SelectTokens.
+SHORTFIN_API bool UsesSampling(const DecodeConfig &config);
+
+// Batched SelectTokens over all rows of `logits`, without copying them. Row
+// `r` is selected with `configs[r]` (or `configs[0]` for all rows if there is
+// one config): the `num_beams` highest scoring tokens in descending order for
+// beam search, a token sampled as with SampleTokens if UsesSampling(), or
+// else the argmax. Selections are written to the row-major `[rows, width]`
+// outputs, where `width = selected_tokens.size() / rows` bounds the number of
+// selections per row. Unused slots are -1 (with a score of -inf). Scores are
+// the logits, converted to float, except for sampled rows whose score follows
+// `logits_normalization` as with SampleTokens. Consecutive greedy rows are
+// reduced together by the vectorized argmax host kernel, on the fp16 / bf16
+// storage without converting it.
+//
+// Sampled rows draw from `rng_states[r]`, which is advanced in place. Keeping
+// one state per request (seeded as the request likes) across decode steps
+// makes each request's sampling reproducible regardless of how requests are
+// batched. It may be empty if no row samples.
+//
+// Throws std::invalid_argument if the outputs, configs or RNG states do not
+// match the number of rows.
+SHORTFIN_API void SelectTokensBatch(const LogitsView &logits,
+                                    std::span<const DecodeConfig> configs,
+                                    std::span<int> selected_tokens,
+                                    std::span<float> selected_scores,
+                                    std::span<uint64_t> rng_states = {});
+
+// Verifies speculatively decoded draft tokens against the target model for a
+// batch of `batch = accepted_counts.size()` requests, each with
+// `draft_len = draft_tokens.size() / batch` draft tokens (row-major
+// `[batch, draft_len]`). Request `b` owns rows `[b * (draft_len + 1),
+// (b + 1) * (draft_len + 1))` of `target_logits`: the target logits at each
+// draft position plus one past the last. It is verified with `configs[b]`
+// (or `configs[0]` for all requests if there is one config).
+//
+// Requests which do not sample (see UsesSampling()) accept draft tokens while
+// they match the argmax of the target. Sampled requests run the standard
+// speculative sampling acceptance: with p and q the temperature-scaled,
+// top_k / top_p restricted target and draft distributions at a position,
+// draft token d is accepted with probability min(1, p(d) / q(d)) and the
+// first rejection is resampled from the normalized max(0, p - q). This
+// reproduces the target distribution exactly. Sampled requests need the
+// draft logits the draft tokens were sampled from (rows
+// `[b * draft_len, (b + 1) * draft_len)` of `draft_logits`, possibly of
+// another dtype) and draw from `rng_states[b]`, advanced in place.
+// `draft_logits` may be empty if no request samples.
+//
+// Writes the number of accepted draft tokens to `accepted_counts[b]` and the
+// token which follows them (the correction of the first rejected one, or a
+// bonus token from the last target row if all are accepted) to
+// `next_tokens[b]`. Logits are read in place and each row is visited a
+// bounded number of times (once when selecting greedily).
+//
+// Throws std::invalid_argument if the shapes, configs or RNG states do not
+// match the batch, a draft token is outside of the vocabulary or a config
+// uses beam search.
+SHORTFIN_API void VerifyDraftTokens(const LogitsView &target_logits,
+                                    const LogitsView &draft_logits,
+                                    std::span<const int> draft_tokens,
+                                    std::span<const DecodeConfig> configs,
+                                    std::span<int> accepted_counts,
+                                    std::span<int> next_tokens,
+                                    std::span<uint64_t> rng_states = {});
+
 }  // namespace shortfin::llm
 
 #endif
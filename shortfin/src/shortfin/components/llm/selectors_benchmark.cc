@@ -0,0 +1,111 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "shortfin/components/llm/selectors.h"
+
+namespace shortfin::llm {
+namespace {
+
+// Logits of the vocabulary size of common tokenizers.
+constexpr size_t kVocabSize = 32000;
+
+std::vector<float> RandomLogits(size_t count) {
+  std::mt19937 generator(0);
+  std::normal_distribution<float> distribution(0.0f, 4.0f);
+  std::vector<float> logits(count);
+  for (float &logit : logits) logit = distribution(generator);
+  return logits;
+}
+
+void BenchmarkSelectTokens(benchmark::State &state,
+                           const DecodeConfig &config) {
+  std::vector<float> logits = RandomLogits(kVocabSize);
+  std::vector<int> selected_tokens;
+  std::vector<float> selected_scores;
+  for (auto _ : state) {
+    selected_tokens.clear();
+    selected_scores.clear();
+    SelectTokens(logits, config, selected_tokens, selected_scores);
+    benchmark::DoNotOptimize(selected_tokens.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kVocabSize);
+}
+
+void BM_SelectTokensGreedy(benchmark::State &state) {
+  BenchmarkSelectTokens(state, DecodeConfig());
+}
+BENCHMARK(BM_SelectTokensGreedy);
+
+// The `num_beams` highest scoring tokens of beam search.
+void BM_SelectTokensBeams(benchmark::State &state) {
+  DecodeConfig config;
+  config.use_beam_search = true;
+  config.num_beams = state.range(0);
+  BenchmarkSelectTokens(state, config);
+}
+BENCHMARK(BM_SelectTokensBeams)->Arg(4)->Arg(16);
+
+void BenchmarkSampleTokens(benchmark::State &state,
+                           const DecodeConfig &config) {
+  size_t rows = state.range(0);
+  std::vector<float> logits = RandomLogits(rows * kVocabSize);
+  std::vector<int> selected_tokens;
+  std::vector<float> selected_scores;
+  uint64_t seed = 0;
+  for (auto _ : state) {
+    selected_tokens.clear();
+    selected_scores.clear();
+    SampleTokens(logits.data(), rows, kVocabSize, config, seed++,
+                 selected_tokens, selected_scores);
+    benchmark::DoNotOptimize(selected_tokens.data());
+  }
+  state.SetItemsProcessed(state.iterations() * rows * kVocabSize);
+}
+
+void BM_SampleTokensTopK(benchmark::State &state) {
+  DecodeConfig config;
+  config.top_k = 50;
+  BenchmarkSampleTokens(state, config);
+}
+BENCHMARK(BM_SampleTokensTopK)->Arg(1)->Arg(32);
+
+// Top-p without top-k gathers the nucleus in a second pass.
+void BM_SampleTokensTopP(benchmark::State &state) {
+  DecodeConfig config;
+  config.top_p = 0.9f;
+  BenchmarkSampleTokens(state, config);
+}
+BENCHMARK(BM_SampleTokensTopP)->Arg(1)->Arg(32);
+
+// Greedy rows of a batch, reduced together by the argmax host kernel.
+void BM_SelectTokensBatchGreedy(benchmark::State &state) {
+  size_t rows = state.range(0);
+  std::vector<float> logits = RandomLogits(rows * kVocabSize);
+  LogitsView view{.data = logits.data(),
+                  .rows = rows,
+                  .vocab_size = kVocabSize,
+                  .row_stride = kVocabSize};
+  DecodeConfig config;
+  std::vector<int> selected_tokens(rows);
+  std::vector<float> selected_scores(rows);
+  for (auto _ : state) {
+    SelectTokensBatch(view, std::span<const DecodeConfig>(&config, 1),
+                      selected_tokens, selected_scores);
+    benchmark::DoNotOptimize(selected_tokens.data());
+  }
+  state.SetItemsProcessed(state.iterations() * rows * kVocabSize);
+}
+BENCHMARK(BM_SelectTokensBatchGreedy)->Arg(1)->Arg(32);
+
+}  // namespace
+}  // namespace shortfin::llm
@@ -0,0 +1,166 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/components/tokenizers/detokenizer.h"
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+#include "fmt/core.h"
+#include "shortfin/support/logging.h"
+
+namespace shortfin::tokenizers {
+
+// -------------------------------------------------------------------------- //
+// StopSequenceMatcher
+// -------------------------------------------------------------------------- //
+
+StopSequenceMatcher::StopSequenceMatcher(
+    std::vector<std::string> stop_sequences)
+    : stop_sequences_(std::move(stop_sequences)) {
+  // The trie of the stop sequences, with 0 as the missing transition (the
+  // root has no incoming transitions).
+  nodes_.emplace_back();
+  std::fill(std::begin(nodes_[0].next), std::end(nodes_[0].next), 0);
+  for (size_t i = 0; i < stop_sequences_.size(); ++i) {
+    const std::string &stop = stop_sequences_[i];
+    if (stop.empty()) {
+      throw std::invalid_argument("Stop sequences must not be empty");
+    }
+    uint32_t node = 0;
+    for (unsigned char c : stop) {
+      if (!nodes_[node].next[c]) {
+        nodes_[node].next[c] = nodes_.size();
+        Node child;
+        std::fill(std::begin(child.next), std::end(child.next), 0);
+        child.depth = nodes_[node].depth + 1;
+        nodes_.push_back(child);
+      }
+      node = nodes_[node].next[c];
+    }
+    if (nodes_[node].match < 0) nodes_[node].match = i;
+  }
+
+  // Completes the transitions breadth first through the failure links (the
+  // longest proper suffix of a node that is also a node), which are already
+  // complete for shallower nodes.
+  std::vector<uint32_t> fail(nodes_.size(), 0);
+  std::deque<uint32_t> queue;
+  for (uint32_t child : nodes_[0].next) {
+    if (child) queue.push_back(child);
+  }
+  while (!queue.empty()) {
+    uint32_t node = queue.front();
+    queue.pop_front();
+    if (nodes_[node].match < 0) nodes_[node].match = nodes_[fail[node]].match;
+    for (int c = 0; c < 256; ++c) {
+      uint32_t child = nodes_[node].next[c];
+      uint32_t fallback = nodes_[fail[node]].next[c];
+      if (child) {
+        fail[child] = fallback;
+        queue.push_back(child);
+      } else {
+        nodes_[node].next[c] = fallback;
+      }
+    }
+  }
+}
+
+StopSequenceMatcher::Match StopSequenceMatcher::Feed(
+    uint32_t &node, std::string_view text) const {
+  for (size_t i = 0; i < text.size(); ++i) {
+    node = nodes_[node].next[static_cast<unsigned char>(text[i])];
+    if (nodes_[node].match >= 0) {
+      return Match{.index = nodes_[node].match, .end = i + 1};
+    }
+  }
+  return Match{};
+}
+
+// -------------------------------------------------------------------------- //
+// StreamingDetokenizer
+// -------------------------------------------------------------------------- //
+
+StreamingDetokenizer::StreamingDetokenizer(Tokenizer &tokenizer)
+    : tokenizer_(tokenizer) {}
+
+void StreamingDetokenizer::Open(
+    int64_t stream, std::span<const int32_t> context,
+    std::shared_ptr<const StopSequenceMatcher> stop_sequences) {
+  auto [it, inserted] = streams_.try_emplace(
+      stream, Stream{.decoder = DecodeStream(tokenizer_, context),
+                     .stop_sequences = std::move(stop_sequences)});
+  if (!inserted) {
+    throw std::invalid_argument(
+        fmt::format("Stream {} is already open", stream));
+  }
+}
+
+StreamingDetokenizer::Stream &StreamingDetokenizer::GetStream(int64_t stream) {
+  auto it = streams_.find(stream);
+  if (it == streams_.end()) {
+    throw std::invalid_argument(fmt::format("Stream {} is not open", stream));
+  }
+  return it->second;
+}
+
+void StreamingDetokenizer::Release(Stream &stream, std::string_view text,
+                                   StreamOutput &output) {
+  if (!stream.stop_sequences) {
+    output.text.append(text);
+    return;
+  }
+  const StopSequenceMatcher &matcher = *stream.stop_sequences;
+  auto match = matcher.Feed(stream.node, text);
+  bool stopped = match.index >= 0;
+  stream.held.append(text.substr(0, stopped ? match.end : text.size()));
+  // The stop sequence is dropped, else the text that may start one is held.
+  size_t keep = stopped ? matcher.stop_sequences()[match.index].size()
+                        : matcher.depth(stream.node);
+  output.text.append(stream.held, 0, stream.held.size() - keep);
+  stream.held.erase(0, stream.held.size() - keep);
+  if (stopped) {
+    stream.stopped = true;
+    stream.held.clear();
+    output.stopped = true;
+    output.stop_index = match.index;
+  }
+}
+
+void StreamingDetokenizer::Step(std::span<const int64_t> streams,
+                                std::span<const int32_t> ids,
+                                std::vector<StreamOutput> &outputs) {
+  SHORTFIN_TRACE_SCOPE_NAMED("StreamingDetokenizer::Step");
+  if (streams.size() != ids.size()) {
+    throw std::invalid_argument(
+        fmt::format("Expected one id per stream ({} streams, got {} ids)",
+                    streams.size(), ids.size()));
+  }
+  outputs.resize(streams.size());
+  for (size_t i = 0; i < streams.size(); ++i) {
+    StreamOutput &output = outputs[i];
+    output.text.clear();
+    output.stopped = false;
+    output.stop_index = -1;
+    Stream &stream = GetStream(streams[i]);
+    if (stream.stopped) continue;
+    Release(stream, stream.decoder.Step(ids.subspan(i, 1)), output);
+  }
+}
+
+StreamOutput StreamingDetokenizer::Close(int64_t stream) {
+  Stream &state = GetStream(stream);
+  StreamOutput output;
+  if (!state.stopped) {
+    Release(state, state.decoder.Flush(), output);
+    output.text.append(state.held);
+  }
+  streams_.erase(stream);
+  return output;
+}
+
+}  // namespace shortfin::tokenizers
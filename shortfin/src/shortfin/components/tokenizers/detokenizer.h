@@ -0,0 +1,130 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_COMPONENTS_TOKENIZERS_DETOKENIZER_H
+#define SHORTFIN_COMPONENTS_TOKENIZERS_DETOKENIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "shortfin/components/tokenizers/tokenizers.h"
+#include "shortfin/support/api.h"
+
+namespace shortfin::tokenizers {
+
+// Aho-Corasick automaton over the bytes of a set of stop sequences, which
+// finds the first of them to occur in a stream of text fed piecewise, in time
+// linear in the text regardless of the number of stop sequences.
+//
+// The state of a stream is a node of the automaton. The depth of a node is
+// the length of the longest suffix of the stream that is a prefix of a stop
+// sequence: the text that must be held back, as it may be the start of a stop
+// sequence completed by later text. As stop sequences start on a character
+// boundary, so does held back text.
+class SHORTFIN_API StopSequenceMatcher {
+ public:
+  struct Match {
+    // Index of the stop sequence, and offset of its end in the fed text.
+    int index = -1;
+    size_t end = 0;
+  };
+
+  explicit StopSequenceMatcher(std::vector<std::string> stop_sequences);
+
+  const std::vector<std::string> &stop_sequences() const {
+    return stop_sequences_;
+  }
+  size_t depth(uint32_t node) const { return nodes_[node].depth; }
+
+  // Feeds `text` to a stream at `node` (0 at its start), advancing it. Returns
+  // the stop sequence ending first in the stream, preferring the longest of
+  // those that end at the same byte, with `node` then left after its end.
+  // Otherwise returns a match of index -1.
+  Match Feed(uint32_t &node, std::string_view text) const;
+
+ private:
+  struct Node {
+    // Transitions of each byte, filled for all bytes.
+    uint32_t next[256];
+    size_t depth = 0;
+    // Longest stop sequence that is a suffix of the node, or -1.
+    int match = -1;
+  };
+
+  std::vector<std::string> stop_sequences_;
+  std::vector<Node> nodes_;
+};
+
+// The text of a step of a stream of a StreamingDetokenizer.
+struct SHORTFIN_API StreamOutput {
+  std::string text;
+  // Whether a stop sequence ended the stream on this step. The text stops
+  // before it, and later steps of the stream output nothing.
+  bool stopped = false;
+  // Index of the stop sequence if stopped.
+  int stop_index = -1;
+};
+
+// Incremental detokenization of a batch of streams (i.e. the sequences being
+// generated by concurrent requests), each with an optional set of stop
+// sequences, for streamed responses. A step decodes the new id of each stream
+// of the batch with its DecodeStream, and holds back the text that may start
+// one of its stop sequences until later text rules it out, so that no stop
+// sequence is output, even partially.
+//
+// Streams are opaque integers to the detokenizer, identified by the caller
+// (i.e. by request). Not thread safe.
+class SHORTFIN_API StreamingDetokenizer {
+ public:
+  explicit StreamingDetokenizer(Tokenizer &tokenizer);
+
+  size_t stream_count() const { return streams_.size(); }
+  bool has_stream(int64_t stream) const { return streams_.contains(stream); }
+
+  // Opens `stream`, whose first ids are decoded after `context` (see
+  // DecodeStream). `stop_sequences` may be shared between streams, or null.
+  void Open(int64_t stream, std::span<const int32_t> context = {},
+            std::shared_ptr<const StopSequenceMatcher> stop_sequences = {});
+
+  // Appends `ids[i]` to `streams[i]` for each i, writing the text to output
+  // for each to `outputs[i]`. `outputs` is resized to the batch and its
+  // strings are overwritten, keeping their capacity, so that it can be reused
+  // across steps.
+  void Step(std::span<const int64_t> streams, std::span<const int32_t> ids,
+            std::vector<StreamOutput> &outputs);
+
+  // Closes `stream`, returning the text left (i.e. text held back, which no
+  // longer can start a stop sequence, and a trailing partial character).
+  StreamOutput Close(int64_t stream);
+
+ private:
+  struct Stream {
+    DecodeStream decoder;
+    std::shared_ptr<const StopSequenceMatcher> stop_sequences;
+    uint32_t node = 0;
+    // Text held back as it may start a stop sequence.
+    std::string held;
+    bool stopped = false;
+  };
+
+  Stream &GetStream(int64_t stream);
+  // Appends the text that `text` releases from `stream` to `output`.
+  static void Release(Stream &stream, std::string_view text,
+                      StreamOutput &output);
+
+  Tokenizer &tokenizer_;
+  std::unordered_map<int64_t, Stream> streams_;
+};
+
+}  // namespace shortfin::tokenizers
+
+#endif  // SHORTFIN_COMPONENTS_TOKENIZERS_DETOKENIZER_H
@@ -0,0 +1,96 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/components/tokenizers/detokenizer.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace shortfin::tokenizers;
+
+namespace {
+
+std::string ReadFile(std::filesystem::path path) {
+  std::ifstream in(path);
+  std::ostringstream out;
+  out << in.rdbuf();
+  return out.str();
+}
+
+// Feeds `pieces` to a matcher one at a time, returning the index of the
+// piece in which a stop sequence ends and the match, or -1.
+std::pair<int, StopSequenceMatcher::Match> FeedPieces(
+    const StopSequenceMatcher &matcher, std::vector<std::string> pieces) {
+  uint32_t node = 0;
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    auto match = matcher.Feed(node, pieces[i]);
+    if (match.index >= 0) return {i, match};
+  }
+  return {-1, {}};
+}
+
+}  // namespace
+
+TEST(DetokenizerTest, StopSequenceMatcher) {
+  StopSequenceMatcher matcher({"he", "she", "hers", "</s>"});
+  auto [piece, match] = FeedPieces(matcher, {"us", "hers"});
+  // "she" and "he" both end at the same byte, and the longest wins.
+  EXPECT_EQ(piece, 1);
+  EXPECT_EQ(match.index, 1);
+  EXPECT_EQ(match.end, 2);
+
+  std::tie(piece, match) = FeedPieces(matcher, {"a <", "/", "s> b"});
+  EXPECT_EQ(piece, 2);
+  EXPECT_EQ(match.index, 3);
+  EXPECT_EQ(match.end, 2);
+
+  // The depth is the text to hold back, as it may start a stop sequence.
+  uint32_t node = 0;
+  EXPECT_EQ(matcher.Feed(node, "x </").index, -1);
+  EXPECT_EQ(matcher.depth(node), 2);
+  EXPECT_EQ(matcher.Feed(node, "x").index, -1);
+  EXPECT_EQ(matcher.depth(node), 0);
+
+  EXPECT_THROW(StopSequenceMatcher({""}), std::invalid_argument);
+}
+
+TEST(DetokenizerTest, StreamingDetokenizer) {
+  auto tok = Tokenizer::FromBlobJSON(
+      ReadFile("src/shortfin/components/tokenizers/tokenizer.json"));
+  auto ids = tok.Encode("hello world, streaming decodes");
+  StreamingDetokenizer detokenizer(tok);
+  detokenizer.Open(0);
+  auto stop_sequences = std::make_shared<StopSequenceMatcher>(
+      std::vector<std::string>{"world", "stream"});
+  detokenizer.Open(1, {}, stop_sequences);
+  EXPECT_EQ(detokenizer.stream_count(), 2);
+  EXPECT_THROW(detokenizer.Open(0), std::invalid_argument);
+
+  std::vector<StreamOutput> outputs;
+  std::string texts[2];
+  bool stopped = false;
+  for (int32_t id : ids) {
+    int32_t step_ids[] = {id, id};
+    int64_t streams[] = {0, 1};
+    detokenizer.Step(streams, step_ids, outputs);
+    ASSERT_EQ(outputs.size(), 2);
+    EXPECT_FALSE(outputs[0].stopped);
+    for (int i = 0; i < 2; ++i) texts[i] += outputs[i].text;
+    if (outputs[1].stopped) {
+      EXPECT_EQ(outputs[1].stop_index, 0);
+      stopped = true;
+    }
+  }
+  texts[0] += detokenizer.Close(0).text;
+  EXPECT_TRUE(detokenizer.Close(1).text.empty());
+  EXPECT_EQ(texts[0], tok.Decode(ids));
+  EXPECT_TRUE(stopped);
+  EXPECT_EQ(texts[1], "hello ");
+  EXPECT_FALSE(detokenizer.has_stream(0));
+}
@@ -6,8 +6,14 @@
 
 #include "shortfin/components/tokenizers/tokenizers.h"
 
+#include <algorithm>
 #include <exception>
+#include <list>
+#include <string_view>
+#include <unordered_map>
 
+#include "shortfin/support/iree_concurrency.h"
+#include "shortfin/support/iree_helpers.h"
 #include "shortfin/support/logging.h"
 #include "tokenizers_cpp.h"
 
@@ -30,34 +36,239 @@ class AccessibleTokenizer : public Tokenizer {
 
 }  // namespace
 
-Tokenizer::~Tokenizer() { delete Get(this); }
+// LRU cache of encoded texts. The map keys view the texts of the entries.
+struct Tokenizer::EncodeCache {
+  struct Entry {
+    std::string text;
+    std::vector<int32_t> ids;
+  };
+
+  explicit EncodeCache(size_t capacity) : capacity(capacity) {}
+
+  // Copies the ids of `text` to `ids` and marks them as most recently used,
+  // if cached.
+  bool Lookup(const std::string &text, std::vector<int32_t> &ids) {
+    iree::slim_mutex_lock_guard guard(mu);
+    auto it = index.find(text);
+    if (it == index.end()) {
+      ++stats.misses;
+      return false;
+    }
+    ++stats.hits;
+    entries.splice(entries.end(), entries, it->second);
+    ids.insert(ids.end(), it->second->ids.begin(), it->second->ids.end());
+    return true;
+  }
+
+  void Insert(const std::string &text, const std::vector<int32_t> &ids) {
+    iree::slim_mutex_lock_guard guard(mu);
+    // Another thread may have encoded the same text meanwhile.
+    if (index.contains(text)) return;
+    if (entries.size() == capacity) {
+      index.erase(entries.front().text);
+      entries.pop_front();
+      ++stats.evictions;
+    }
+    entries.push_back(Entry{text, ids});
+    index.emplace(entries.back().text, std::prev(entries.end()));
+  }
+
+  const size_t capacity;
+  iree::slim_mutex mu;
+  // Least recently used first.
+  std::list<Entry> entries SHORTFIN_GUARDED_BY(mu);
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index
+      SHORTFIN_GUARDED_BY(mu);
+  EncodeCacheStats stats SHORTFIN_GUARDED_BY(mu);
+};
+
+struct Tokenizer::VendorLock {
+  iree::slim_mutex mu;
+};
+
+Tokenizer::Tokenizer(void *vendor_tokenizer)
+    : vendor_lock_(std::make_unique<VendorLock>()),
+      vendor_tokenizer_(vendor_tokenizer) {}
+
+Tokenizer::Tokenizer(Tokenizer &&other)
+    : encode_cache_(std::move(other.encode_cache_)),
+      vendor_lock_(std::move(other.vendor_lock_)),
+      vendor_tokenizer_(other.vendor_tokenizer_) {
+  other.vendor_tokenizer_ = nullptr;
+}
+
+Tokenizer::~Tokenizer() {
+  delete static_cast<::tokenizers::Tokenizer *>(vendor_tokenizer_);
+}
 
 Tokenizer Tokenizer::FromBlobJSON(const std::string &json_blob) {
   SHORTFIN_TRACE_SCOPE_NAMED("Tokenizer::FromBlobJSON");
   return Tokenizer(::tokenizers::Tokenizer::FromBlobJSON(json_blob).release());
 }
 
-std::vector<int32_t> Tokenizer::Encode(const std::string &text) {
+Tokenizer Tokenizer::FromFileJSON(const std::filesystem::path &path) {
+  SHORTFIN_TRACE_SCOPE_NAMED("Tokenizer::FromFileJSON");
+  std::string path_string = path.string();
+  iree::file_contents_ptr contents;
+  SHORTFIN_THROW_IF_ERROR(iree_io_file_contents_map(
+      iree_make_string_view(path_string.c_str(), path_string.size()),
+      IREE_IO_FILE_ACCESS_READ, iree_allocator_system(),
+      contents.for_output()));
+  iree_const_byte_span_t buffer = contents.const_buffer();
+  return FromBlobJSON(std::string(reinterpret_cast<const char *>(buffer.data),
+                                  buffer.data_length));
+}
+
+std::shared_ptr<Tokenizer> Tokenizer::Shared(
+    const std::filesystem::path &path) {
+  static iree::slim_mutex mu;
+  static auto &instances =
+      *new std::unordered_map<std::string, std::weak_ptr<Tokenizer>>();
+  // Distinct spellings of a path share an instance.
+  std::string key = std::filesystem::weakly_canonical(path).string();
+  iree::slim_mutex_lock_guard guard(mu);
+  std::erase_if(instances,
+                [](const auto &entry) { return entry.second.expired(); });
+  if (auto instance = instances[key].lock()) return instance;
+  auto instance = std::make_shared<Tokenizer>(FromFileJSON(path));
+  instances[key] = instance;
+  return instance;
+}
+
+void Tokenizer::EnableEncodeCache(size_t capacity) {
+  encode_cache_ = capacity ? std::make_unique<EncodeCache>(capacity) : nullptr;
+}
+
+Tokenizer::EncodeCacheStats Tokenizer::encode_cache_stats() {
+  if (!encode_cache_) return {};
+  iree::slim_mutex_lock_guard guard(encode_cache_->mu);
+  EncodeCacheStats stats = encode_cache_->stats;
+  stats.entries = encode_cache_->entries.size();
+  return stats;
+}
+
+std::vector<int32_t> Tokenizer::EncodeUncached(const std::string &text) {
   SHORTFIN_TRACE_SCOPE_NAMED("Tokenizer::Encode");
+  iree::slim_mutex_lock_guard guard(vendor_lock_->mu);
   return Get(this)->Encode(text);
 }
 
+std::vector<int32_t> Tokenizer::Encode(const std::string &text) {
+  if (!encode_cache_) return EncodeUncached(text);
+  std::vector<int32_t> ids;
+  EncodeSegments(std::span<const std::string>(&text, 1), ids);
+  return ids;
+}
+
+void Tokenizer::EncodeSegments(std::span<const std::string> segments,
+                               std::vector<int32_t> &ids) {
+  for (const std::string &segment : segments) {
+    if (encode_cache_ && encode_cache_->Lookup(segment, ids)) continue;
+    auto segment_ids = EncodeUncached(segment);
+    if (encode_cache_) encode_cache_->Insert(segment, segment_ids);
+    ids.insert(ids.end(), segment_ids.begin(), segment_ids.end());
+  }
+}
+
 std::vector<std::vector<int32_t>> Tokenizer::EncodeBatch(
     const std::vector<std::string> &texts) {
   SHORTFIN_TRACE_SCOPE_NAMED("Tokenizer::EncodeBatch");
+  iree::slim_mutex_lock_guard guard(vendor_lock_->mu);
   return Get(this)->EncodeBatch(texts);
 }
 
+void Tokenizer::EncodeBatch(const std::vector<std::string> &texts,
+                            std::vector<int32_t> &ids,
+                            std::vector<size_t> &offsets) {
+  SHORTFIN_TRACE_SCOPE_NAMED("Tokenizer::EncodeBatch[flat]");
+  auto encoded = EncodeBatch(texts);
+  offsets.resize(encoded.size() + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    offsets[i + 1] = offsets[i] + encoded[i].size();
+  }
+  ids.resize(offsets.back());
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    std::copy(encoded[i].begin(), encoded[i].end(), ids.begin() + offsets[i]);
+  }
+}
+
 std::string Tokenizer::Decode(const std::vector<int32_t> &ids) {
   SHORTFIN_TRACE_SCOPE_NAMED("Tokenizer::Decode");
+  iree::slim_mutex_lock_guard guard(vendor_lock_->mu);
   return Get(this)->Decode(ids);
 }
-size_t Tokenizer::GetVocabSize() { return Get(this)->GetVocabSize(); }
+size_t Tokenizer::GetVocabSize() {
+  iree::slim_mutex_lock_guard guard(vendor_lock_->mu);
+  return Get(this)->GetVocabSize();
+}
 std::string Tokenizer::IdToToken(int32_t token_id) {
+  iree::slim_mutex_lock_guard guard(vendor_lock_->mu);
   return Get(this)->IdToToken(token_id);
 }
 int32_t Tokenizer::TokenToId(const std::string &token) {
+  iree::slim_mutex_lock_guard guard(vendor_lock_->mu);
   return Get(this)->TokenToId(token);
 }
 
+// -------------------------------------------------------------------------- //
+// DecodeStream
+// -------------------------------------------------------------------------- //
+
+namespace {
+
+// Whether `text` ends in an incomplete UTF-8 sequence, or in the replacement
+// character that tokenizers decode incomplete byte tokens to.
+bool EndsInPartialCharacter(std::string_view text) {
+  constexpr std::string_view kReplacement = "\xEF\xBF\xBD";
+  if (text.ends_with(kReplacement)) return true;
+  // Find the lead byte of the last sequence, past up to 3 continuation bytes.
+  size_t continuation = 0;
+  size_t i = text.size();
+  while (i > 0 && continuation < 4) {
+    unsigned char c = text[--i];
+    if ((c & 0xC0) != 0x80) {
+      size_t length = c < 0x80 ? 1 : c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : 2;
+      return continuation + 1 < length;
+    }
+    ++continuation;
+  }
+  return false;
+}
+
+}  // namespace
+
+DecodeStream::DecodeStream(Tokenizer &tokenizer,
+                           std::span<const int32_t> context)
+    : tokenizer_(tokenizer),
+      ids_(context.begin(), context.end()),
+      read_offset_(context.size()) {}
+
+std::string DecodeStream::Step(std::span<const int32_t> ids) {
+  SHORTFIN_TRACE_SCOPE_NAMED("DecodeStream::Step");
+  ids_.insert(ids_.end(), ids.begin(), ids.end());
+  return Emit(/*force=*/false);
+}
+
+std::string DecodeStream::Flush() { return Emit(/*force=*/true); }
+
+std::string DecodeStream::Emit(bool force) {
+  if (read_offset_ == ids_.size()) return {};
+  std::string prefix_text;
+  if (read_offset_ > 0) {
+    prefix_text = tokenizer_.Decode(
+        std::vector<int32_t>(ids_.begin(), ids_.begin() + read_offset_));
+  }
+  std::string text = tokenizer_.Decode(ids_);
+  if (!force &&
+      (text.size() <= prefix_text.size() || EndsInPartialCharacter(text))) {
+    return {};
+  }
+  // The emitted ids become the context of the next ones.
+  ids_.erase(ids_.begin(), ids_.begin() + read_offset_);
+  read_offset_ = ids_.size();
+  if (text.size() <= prefix_text.size()) return {};
+  return text.substr(prefix_text.size());
+}
+
 }  // namespace shortfin::tokenizers
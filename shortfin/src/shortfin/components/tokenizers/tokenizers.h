@@ -7,6 +7,11 @@
 #ifndef SHORTFIN_COMPONENTS_TOKENIZERS_TOKENIZERS_H
 #define SHORTFIN_COMPONENTS_TOKENIZERS_TOKENIZERS_H
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -20,33 +25,111 @@ namespace shortfin::tokenizers {
 // The current vendor tokenizer is based on mlc-ai/tokenizers-cpp. The API
 // is fairly close to that implementation.
 // See: https://github.com/mlc-ai/tokenizers-cpp
+//
+// Calls into the vendor tokenizer, which keeps the results of a call in its
+// own state, are serialized. A Tokenizer can therefore be used by many threads
+// at once (i.e. one instance shared by all workers, see Shared()).
 class SHORTFIN_API Tokenizer {
  public:
   Tokenizer(const Tokenizer &) = delete;
   Tokenizer &operator=(const Tokenizer &) = delete;
-  Tokenizer(Tokenizer &&other) : vendor_tokenizer_(other.vendor_tokenizer_) {
-    vendor_tokenizer_ = nullptr;
-  }
+  Tokenizer(Tokenizer &&other);
   ~Tokenizer();
 
   // Factory functions.
   static Tokenizer FromBlobJSON(const std::string &json_blob);
+  // Loads the tokenizer JSON file at `path`, memory mapped rather than read
+  // through a stream, so that its contents are copied once, into the string
+  // that the vendor tokenizer parses.
+  static Tokenizer FromFileJSON(const std::filesystem::path &path);
+  // Returns the tokenizer of the JSON file at `path` shared by the process. It
+  // is loaded on first use and lives while references to it remain, so that
+  // the workers of a process loading the same file share one instance.
+  static std::shared_ptr<Tokenizer> Shared(const std::filesystem::path &path);
+
+  // Counters of the encode cache since it was enabled.
+  struct EncodeCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+  };
+
+  // Caches the ids of up to `capacity` texts passed to Encode() or
+  // EncodeSegments(), keyed by their exact text, evicting the least recently
+  // used. Repeated texts (i.e. system prompts and chat template pieces) are
+  // then only tokenized once. A capacity of 0 disables and clears the cache.
+  // The cache is thread safe, but must not be enabled while encoding.
+  void EnableEncodeCache(size_t capacity);
+  EncodeCacheStats encode_cache_stats();
 
   std::vector<int32_t> Encode(const std::string &text);
+  // Encodes each of `segments` on its own (through the encode cache) and
+  // appends their ids to `ids`. Segments must be split where tokenization
+  // does not cross them (i.e. at the special tokens of a chat template), for
+  // the result to match encoding their concatenation.
+  void EncodeSegments(std::span<const std::string> segments,
+                      std::vector<int32_t> &ids);
   std::vector<std::vector<int32_t>> EncodeBatch(
       const std::vector<std::string> &texts);
+  // Encodes a batch into a single flat buffer, as is needed to fill a host
+  // array: the ids of texts[i] are ids[offsets[i]:offsets[i + 1]]. `ids` and
+  // `offsets` are overwritten (keeping their capacity, so that they can be
+  // reused across batches). The vendor tokenizer encodes the batch in
+  // parallel, without holding the calling thread to one text at a time.
+  void EncodeBatch(const std::vector<std::string> &texts,
+                   std::vector<int32_t> &ids, std::vector<size_t> &offsets);
   std::string Decode(const std::vector<int32_t> &ids);
   size_t GetVocabSize();
   std::string IdToToken(int32_t token_id);
   int32_t TokenToId(const std::string &token);
 
  private:
-  Tokenizer(void *vendor_tokenizer) : vendor_tokenizer_(vendor_tokenizer) {}
+  struct EncodeCache;
+  struct VendorLock;
+  Tokenizer(void *vendor_tokenizer);
+  std::vector<int32_t> EncodeUncached(const std::string &text);
+
+  std::unique_ptr<EncodeCache> encode_cache_;
+  std::unique_ptr<VendorLock> vendor_lock_;
 
  protected:
   void *vendor_tokenizer_;
 };
 
+// Incremental decoder of a sequence of token ids, as streamed (i.e. from a
+// generation loop), which only decodes a window of the most recent ids per
+// step rather than the whole sequence.
+//
+// Decoding is not compositional: a token may decode differently after other
+// tokens (i.e. a word piece joining the previous word, or the leading space
+// that some tokenizers strip at the start of a sequence), and byte level
+// tokens may split a UTF-8 character. Each step therefore decodes the window
+// with and without the new ids and emits the difference, once it does not end
+// in a partial character. The window then restarts at the first new id.
+class SHORTFIN_API DecodeStream {
+ public:
+  // `context` ids (i.e. the last few prompt ids) precede the stream, to
+  // decode its first ids in context, but are not emitted.
+  explicit DecodeStream(Tokenizer &tokenizer,
+                        std::span<const int32_t> context = {});
+
+  // Appends `ids` to the stream and returns the text that they complete,
+  // which may be empty while a character is incomplete.
+  std::string Step(std::span<const int32_t> ids);
+  // Returns the text of the ids not emitted yet (i.e. a trailing partial
+  // character) and resets the window to them.
+  std::string Flush();
+
+ private:
+  std::string Emit(bool force);
+
+  Tokenizer &tokenizer_;
+  // Window of ids: the context of the unemitted ids, then those.
+  std::vector<int32_t> ids_;
+  size_t read_offset_;
+};
+
 }  // namespace shortfin::tokenizers
 
 #endif  // SHORTFIN_COMPONENTS_TOKENIZERS_TOKENIZERS_H
@@ -11,6 +11,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <thread>
 
 using namespace shortfin::tokenizers;
 
@@ -54,3 +55,94 @@ TEST(TokenizersTest, BasicTokenizerJson) {
   auto decoded = tok.Decode(encoded);
   EXPECT_EQ(decoded, "hello world");
 }
+
+TEST(TokenizersTest, EncodeBatchFlat) {
+  auto tok = Tokenizer::FromBlobJSON(
+      ReadFile("src/shortfin/components/tokenizers/tokenizer.json"));
+  std::vector<int32_t> ids = {-1, -1, -1, -1, -1, -1};
+  std::vector<size_t> offsets;
+  tok.EncodeBatch({"hello", "", "hello world"}, ids, offsets);
+  EXPECT_THAT(offsets, ::testing::ElementsAre(0, 1, 1, 3));
+  EXPECT_THAT(ids, ::testing::ElementsAre(19082, 19082, 1362));
+}
+
+TEST(TokenizersTest, DecodeStream) {
+  auto tok = Tokenizer::FromBlobJSON(
+      ReadFile("src/shortfin/components/tokenizers/tokenizer.json"));
+  auto ids = tok.Encode("hello world, streaming decodes");
+  DecodeStream stream(tok);
+  std::string streamed;
+  for (int32_t id : ids) {
+    streamed += stream.Step(std::span<const int32_t>(&id, 1));
+  }
+  streamed += stream.Flush();
+  EXPECT_EQ(streamed, tok.Decode(ids));
+
+  // Context ids are decoded with, but not emitted.
+  std::vector<int32_t> context = {19082};
+  DecodeStream continued(tok, context);
+  std::vector<int32_t> world = {1362};
+  EXPECT_EQ(continued.Step(world), " world");
+  EXPECT_EQ(continued.Flush(), "");
+}
+
+TEST(TokenizersTest, EncodeCache) {
+  auto tok = Tokenizer::FromBlobJSON(
+      ReadFile("src/shortfin/components/tokenizers/tokenizer.json"));
+  tok.EnableEncodeCache(2);
+  EXPECT_THAT(tok.Encode("hello world"), ::testing::ElementsAre(19082, 1362));
+  EXPECT_THAT(tok.Encode("hello world"), ::testing::ElementsAre(19082, 1362));
+  std::vector<int32_t> ids;
+  tok.EncodeSegments(std::vector<std::string>{"hello", "world"}, ids);
+  EXPECT_THAT(ids, ::testing::ElementsAre(19082, 1362));
+  auto stats = tok.encode_cache_stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.entries, 2);
+
+  tok.EnableEncodeCache(0);
+  EXPECT_EQ(tok.encode_cache_stats().entries, 0);
+}
+
+TEST(TokenizersTest, FromFileJSON) {
+  auto tok = Tokenizer::FromFileJSON(
+      "src/shortfin/components/tokenizers/tokenizer.json");
+  EXPECT_THAT(tok.Encode("hello world"), ::testing::ElementsAre(19082, 1362));
+  EXPECT_THROW(Tokenizer::FromFileJSON("does/not/exist.json"), std::exception);
+}
+
+TEST(TokenizersTest, Shared) {
+  std::filesystem::path tokenizer_path(
+      "src/shortfin/components/tokenizers/tokenizer.json");
+  auto tok = Tokenizer::Shared(tokenizer_path);
+  EXPECT_EQ(Tokenizer::Shared(tokenizer_path), tok);
+  EXPECT_EQ(Tokenizer::Shared("./" / tokenizer_path), tok);
+
+  // Once released, the next use loads the file again.
+  std::weak_ptr<Tokenizer> released = tok;
+  tok.reset();
+  EXPECT_TRUE(released.expired());
+  EXPECT_THAT(Tokenizer::Shared(tokenizer_path)->Encode("hello"),
+              ::testing::ElementsAre(19082));
+}
+
+TEST(TokenizersTest, ConcurrentEncode) {
+  auto tok =
+      Tokenizer::Shared("src/shortfin/components/tokenizers/tokenizer.json");
+  std::vector<std::thread> threads;
+  std::vector<bool> matched(8);
+  for (size_t i = 0; i < matched.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      bool all_matched = true;
+      for (int j = 0; j < 100; ++j) {
+        all_matched &= tok->Encode("hello world") ==
+                       std::vector<int32_t>{19082, 1362};
+        all_matched &= tok->Decode({19082}) == "hello";
+      }
+      matched[i] = all_matched;
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_THAT(matched, ::testing::Each(true));
+}
@@ -0,0 +1,86 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Helpers shared by the runtime microbenchmarks (*_benchmark.cc, built with
+// SHORTFIN_BUILD_BENCHMARKS). This header is not installed.
+
+#ifndef SHORTFIN_LOCAL_BENCHMARK_HELPERS_H
+#define SHORTFIN_LOCAL_BENCHMARK_HELPERS_H
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+
+#include "shortfin/local/fiber.h"
+#include "shortfin/local/system.h"
+#include "shortfin/local/systems/host.h"
+#include "shortfin/local/worker.h"
+
+namespace shortfin::local {
+
+// A host CPU system with a worker on its own thread and a fiber on that
+// worker. Futures, queue reads and device transfers must be issued from a
+// worker, so benchmarks post them with RunOnWorker / RunAsyncOnWorker and the
+// benchmark thread blocks until they are done. Construct it outside of the
+// timed loop. `busy_poll_ns` is passed to the worker (see Worker::Options).
+class BenchmarkSystem {
+ public:
+  explicit BenchmarkSystem(iree_duration_t busy_poll_ns = 0) {
+    system_ = systems::HostCPUSystemBuilder().CreateSystem();
+    Worker::Options options(system_->host_allocator(), "benchmark");
+    options.busy_poll_ns = busy_poll_ns;
+    worker_ = &system_->CreateWorker(std::move(options));
+    fiber_ = system_->CreateFiber(*worker_, system_->devices());
+  }
+  ~BenchmarkSystem() {
+    fiber_.reset();
+    system_->Shutdown();
+  }
+  BenchmarkSystem(const BenchmarkSystem &) = delete;
+  BenchmarkSystem &operator=(const BenchmarkSystem &) = delete;
+
+  System &system() { return *system_; }
+  Worker &worker() { return *worker_; }
+  std::shared_ptr<Fiber> &fiber() { return fiber_; }
+  ScopedDevice device() {
+    return fiber_->device(system_->devices().front());
+  }
+
+  // Runs `fn` on the worker and blocks until it returns, rethrowing its
+  // exception if it raised.
+  void RunOnWorker(std::function<void()> fn) {
+    RunAsyncOnWorker([&fn](std::function<void()> done) {
+      fn();
+      done();
+    });
+  }
+
+  // Runs `fn` on the worker and blocks until it calls the `done` callback it
+  // is passed (from the worker, i.e. in a future callback), rethrowing the
+  // exception of `fn` if it raised.
+  void RunAsyncOnWorker(std::function<void(std::function<void()> done)> fn) {
+    std::promise<void> completed;
+    worker_->CallThreadsafe([&fn, &completed]() {
+      try {
+        fn([&completed]() { completed.set_value(); });
+      } catch (...) {
+        completed.set_exception(std::current_exception());
+      }
+    });
+    completed.get_future().get();
+  }
+
+ private:
+  SystemPtr system_;
+  Worker *worker_ = nullptr;
+  std::shared_ptr<Fiber> fiber_;
+};
+
+}  // namespace shortfin::local
+
+#endif  // SHORTFIN_LOCAL_BENCHMARK_HELPERS_H
@@ -0,0 +1,95 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/local/coro.h"
+
+#include "shortfin/support/logging.h"
+
+namespace shortfin::local {
+
+// -------------------------------------------------------------------------- //
+// Awaiters
+// -------------------------------------------------------------------------- //
+
+Worker &detail::LoopAwaiter::GetRequiredWorker() {
+  Worker *current = Worker::GetCurrent();
+  if (!current) {
+    throw std::logic_error("Coroutines can only be suspended on a worker");
+  }
+  return *current;
+}
+
+iree_status_t detail::LoopAwaiter::Resume(void *self_vp, iree_loop_t loop,
+                                          iree_status_t status) noexcept {
+  auto *self = static_cast<LoopAwaiter *>(self_vp);
+  // Deadline exceeded is how a completed sleep is reported.
+  if (iree_status_is_deadline_exceeded(status)) {
+    iree_status_ignore(status);
+    status = iree_ok_status();
+  }
+  self->status_ = status;
+  // Errors are raised in the coroutine, not into the loop.
+  self->handle_.resume();
+  return iree_ok_status();
+}
+
+void detail::CompletionEventAwaiter::await_suspend(
+    std::coroutine_handle<> handle) {
+  handle_ = handle;
+  SHORTFIN_THROW_IF_ERROR(GetRequiredWorker().WaitOneLowLevel(
+      event_, iree_infinite_timeout(), &LoopAwaiter::Resume, this));
+}
+
+void detail::YieldAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  handle_ = handle;
+  SHORTFIN_THROW_IF_ERROR(
+      GetRequiredWorker().CallLowLevel(&LoopAwaiter::Resume, this));
+}
+
+void detail::SleepAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  handle_ = handle;
+  SHORTFIN_THROW_IF_ERROR(GetRequiredWorker().WaitUntilLowLevel(
+      timeout_, &LoopAwaiter::Resume, this));
+}
+
+// -------------------------------------------------------------------------- //
+// CoroutineProcess
+// -------------------------------------------------------------------------- //
+
+void CoroutineProcess::ScheduleOnWorker() {
+  Worker &worker = fiber()->worker();
+  if (Worker::GetCurrent() == &worker) {
+    StartOnWorker();
+  } else {
+    worker.CallThreadsafe([this]() { StartOnWorker(); });
+  }
+}
+
+void CoroutineProcess::StartOnWorker() {
+  try {
+    task_ = Run();
+  } catch (std::exception &e) {
+    logging::error("Exception starting coroutine process {}: {}", to_s(),
+                   e.what());
+    Terminate();
+    return;
+  }
+  task_.Start([this](std::exception_ptr failure) {
+    if (failure) {
+      try {
+        std::rethrow_exception(failure);
+      } catch (std::exception &e) {
+        logging::error("Unhandled exception in coroutine process {}: {}",
+                       to_s(), e.what());
+      } catch (...) {
+        logging::error("Unhandled exception in coroutine process {}", to_s());
+      }
+    }
+    Terminate();
+  });
+}
+
+}  // namespace shortfin::local
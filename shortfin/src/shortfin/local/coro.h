@@ -0,0 +1,318 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_LOCAL_CORO_H
+#define SHORTFIN_LOCAL_CORO_H
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "shortfin/local/async.h"
+#include "shortfin/local/process.h"
+#include "shortfin/local/worker.h"
+#include "shortfin/support/api.h"
+#include "shortfin/support/iree_helpers.h"
+
+// C++20 coroutine support for writing processes directly in C++, as the
+// Python bindings do with asyncio. Coroutines run on the event loop of a
+// worker and may co_await:
+//   * A VoidFuture or TypedFuture<T> (i.e. MessageFuture or
+//     ProgramInvocation::Future), resuming with its result (or rethrowing
+//     its failure) once it is done.
+//   * A CompletionEvent, resuming once it is ready.
+//   * Another Task<T>, resuming with its result.
+//   * Yield() and Sleep(), to give the loop to other callbacks.
+// Awaiting suspends the coroutine without blocking the worker: it is resumed
+// from a callback on the loop of the worker it is running on.
+//
+// Example:
+//   class Echo : public CoroutineProcess {
+//    public:
+//     using CoroutineProcess::CoroutineProcess;
+//     Task<> Run() override {
+//       auto reader = Queue::Reader(queue);
+//       while (Message::Ref message = co_await reader.Read()) { ... }
+//     }
+//   };
+
+namespace shortfin::local {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+// State common to Task promises.
+class TaskPromiseBase {
+ public:
+  // Once the coroutine finishes, resumes the awaiting coroutine (if any) or
+  // else calls the done callback of a started task.
+  struct FinalAwaiter {
+    bool await_ready() noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<Promise> handle) noexcept {
+      TaskPromiseBase &promise = handle.promise();
+      if (promise.continuation_) return promise.continuation_;
+      if (promise.on_done_) {
+        // This may destroy the coroutine, so it must be the last use of it.
+        auto on_done = std::move(promise.on_done_);
+        on_done(promise.exception_);
+      }
+      return std::noop_coroutine();
+    }
+    void await_resume() noexcept {}
+  };
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+  FinalAwaiter final_suspend() noexcept { return {}; }
+  void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+ protected:
+  void RethrowIfFailed() {
+    if (exception_) std::rethrow_exception(exception_);
+  }
+
+ private:
+  template <typename T>
+  friend class shortfin::local::Task;
+  std::coroutine_handle<> continuation_;
+  std::function<void(std::exception_ptr)> on_done_;
+  std::exception_ptr exception_;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+ public:
+  Task<T> get_return_object() noexcept;
+  template <typename U>
+  void return_value(U &&value) {
+    value_.emplace(std::forward<U>(value));
+  }
+  T TakeResult() {
+    RethrowIfFailed();
+    return std::move(*value_);
+  }
+
+ private:
+  std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+ public:
+  Task<void> get_return_object() noexcept;
+  void return_void() noexcept {}
+  void TakeResult() { RethrowIfFailed(); }
+};
+
+}  // namespace detail
+
+// A lazily started coroutine producing a T. The coroutine does not run until
+// the task is awaited (by another coroutine) or Start()ed. Tasks are move
+// only and destroy their coroutine when they go out of scope, which must not
+// happen while it is suspended in an await other than of another task.
+//
+// Exceptions escaping the coroutine are rethrown to the awaiter.
+template <typename T>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = detail::TaskPromise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Task() noexcept = default;
+  explicit Task(Handle handle) noexcept : handle_(handle) {}
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      if (handle_) handle_.destroy();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+  ~Task() {
+    if (handle_) handle_.destroy();
+  }
+
+  explicit operator bool() const noexcept { return bool(handle_); }
+  bool is_done() const noexcept { return handle_ && handle_.done(); }
+
+  // Runs the coroutine until its first suspension on the current thread (which
+  // should be the thread of the worker it is meant to run on). `on_done` is
+  // called with its failure (or null) when it finishes, possibly before this
+  // returns. `on_done` may destroy the task.
+  void Start(std::function<void(std::exception_ptr)> on_done) {
+    if (!handle_ || handle_.done() || handle_.promise().continuation_) {
+      throw std::logic_error("Task can only be started once");
+    }
+    handle_.promise().on_done_ = std::move(on_done);
+    handle_.resume();
+  }
+
+  // Returns the result of a finished task, rethrowing its failure.
+  decltype(auto) result() {
+    if (!is_done()) throw std::logic_error("Task result is not available");
+    return handle_.promise().TakeResult();
+  }
+
+  auto operator co_await() && noexcept {
+    struct Awaiter {
+      Handle handle;
+      bool await_ready() noexcept { return !handle || handle.done(); }
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation_ = awaiting;
+        return handle;
+      }
+      T await_resume() {
+        if (!handle) throw std::logic_error("Cannot await an empty Task");
+        return handle.promise().TakeResult();
+      }
+    };
+    return Awaiter{handle_};
+  }
+
+ private:
+  Handle handle_;
+};
+
+template <typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+namespace detail {
+
+// Awaits a future by resuming from its callback, which is delivered on the
+// future's worker. The awaiter owns a reference to the future.
+template <typename FutureTy>
+class FutureAwaiter {
+ public:
+  FutureAwaiter(FutureTy future) : future_(std::move(future)) {}
+  bool await_ready() { return future_.is_done(); }
+  void await_suspend(std::coroutine_handle<> handle) {
+    future_.AddCallback([handle](Future &) { handle.resume(); });
+  }
+
+ protected:
+  FutureTy future_;
+};
+
+// Resumes from a callback on the loop of the current worker.
+class SHORTFIN_API LoopAwaiter {
+ public:
+  bool await_ready() noexcept { return false; }
+  void await_resume() { SHORTFIN_THROW_IF_ERROR(status_); }
+
+ protected:
+  static Worker &GetRequiredWorker();
+  static iree_status_t Resume(void *self_vp, iree_loop_t loop,
+                              iree_status_t status) noexcept;
+
+  std::coroutine_handle<> handle_;
+  iree_status_t status_ = iree_ok_status();
+};
+
+class SHORTFIN_API CompletionEventAwaiter : public LoopAwaiter {
+ public:
+  CompletionEventAwaiter(CompletionEvent event) : event_(std::move(event)) {}
+  bool await_ready() { return event_.is_ready(); }
+  void await_suspend(std::coroutine_handle<> handle);
+
+ private:
+  CompletionEvent event_;
+};
+
+class SHORTFIN_API YieldAwaiter : public LoopAwaiter {
+ public:
+  void await_suspend(std::coroutine_handle<> handle);
+};
+
+class SHORTFIN_API SleepAwaiter : public LoopAwaiter {
+ public:
+  SleepAwaiter(iree_timeout_t timeout) : timeout_(timeout) {}
+  void await_suspend(std::coroutine_handle<> handle);
+
+ private:
+  iree_timeout_t timeout_;
+};
+
+}  // namespace detail
+
+inline auto operator co_await(VoidFuture future) {
+  struct Awaiter : detail::FutureAwaiter<VoidFuture> {
+    using FutureAwaiter::FutureAwaiter;
+    void await_resume() { future_.ThrowFailure(); }
+  };
+  return Awaiter(std::move(future));
+}
+
+// Resumes with the result of the future. Results that cannot be copied (i.e.
+// ProgramInvocation::Ptr) are moved out of the future, so only one awaiter of
+// a given future may take them.
+template <typename ResultTy>
+auto operator co_await(TypedFuture<ResultTy> future) {
+  struct Awaiter : detail::FutureAwaiter<TypedFuture<ResultTy>> {
+    using detail::FutureAwaiter<TypedFuture<ResultTy>>::FutureAwaiter;
+    ResultTy await_resume() {
+      if constexpr (std::is_copy_constructible_v<ResultTy>) {
+        return this->future_.result();
+      } else {
+        return std::move(this->future_.result());
+      }
+    }
+  };
+  return Awaiter(std::move(future));
+}
+
+inline detail::CompletionEventAwaiter operator co_await(
+    CompletionEvent event) {
+  return detail::CompletionEventAwaiter(std::move(event));
+}
+
+// Resumes on a later turn of the current worker's loop, after callbacks that
+// are already due.
+inline detail::YieldAwaiter Yield() { return {}; }
+
+// Resumes once the timeout has elapsed.
+inline detail::SleepAwaiter Sleep(iree_timeout_t timeout) {
+  return detail::SleepAwaiter(timeout);
+}
+
+// A Process whose body is a coroutine. Run() is started on the worker of the
+// process's fiber when it is launched, and the process terminates when it
+// finishes. An exception escaping Run() is logged and terminates the process.
+//
+// As with any Process, the instance must outlive its termination.
+class SHORTFIN_API CoroutineProcess : public Process {
+ public:
+  using Process::Process;
+
+  void Launch() { Process::Launch(); }
+
+ protected:
+  virtual Task<> Run() = 0;
+  void ScheduleOnWorker() override;
+
+ private:
+  void StartOnWorker();
+
+  Task<> task_;
+};
+
+}  // namespace shortfin::local
+
+#endif  // SHORTFIN_LOCAL_CORO_H
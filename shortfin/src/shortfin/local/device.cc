@@ -6,12 +6,82 @@
 
 #include "shortfin/local/device.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 #include <fmt/xchar.h>
 
 namespace shortfin::local {
 
+// -------------------------------------------------------------------------- //
+// IpcMemoryHandle
+// -------------------------------------------------------------------------- //
+
+namespace {
+constexpr std::string_view kIpcMemoryHandleMagic = "SFIPCMEM1";
+
+void AppendU64(std::string &out, uint64_t value) {
+  for (int i = 0; i < 8; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+void AppendString(std::string &out, std::string_view value) {
+  AppendU64(out, value.size());
+  out.append(value);
+}
+
+// Little endian readers which throw on truncated input.
+uint64_t ReadU64(std::string_view &in) {
+  if (in.size() < 8) {
+    throw std::invalid_argument("Truncated IPC memory handle");
+  }
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+  }
+  in.remove_prefix(8);
+  return value;
+}
+
+std::string ReadString(std::string_view &in) {
+  uint64_t size = ReadU64(in);
+  if (in.size() < size) {
+    throw std::invalid_argument("Truncated IPC memory handle");
+  }
+  std::string value(in.substr(0, size));
+  in.remove_prefix(size);
+  return value;
+}
+}  // namespace
+
+std::string IpcMemoryHandle::Serialize() const {
+  std::string out(kIpcMemoryHandleMagic);
+  AppendString(out, pci_address);
+  AppendString(out, opaque);
+  AppendU64(out, offset);
+  AppendU64(out, length);
+  return out;
+}
+
+IpcMemoryHandle IpcMemoryHandle::Parse(std::string_view bytes) {
+  if (!bytes.starts_with(kIpcMemoryHandleMagic)) {
+    throw std::invalid_argument("Not a serialized IPC memory handle");
+  }
+  bytes.remove_prefix(kIpcMemoryHandleMagic.size());
+  IpcMemoryHandle handle;
+  handle.pci_address = ReadString(bytes);
+  handle.opaque = ReadString(bytes);
+  handle.offset = ReadU64(bytes);
+  handle.length = ReadU64(bytes);
+  if (!bytes.empty()) {
+    throw std::invalid_argument("Trailing bytes in IPC memory handle");
+  }
+  return handle;
+}
+
 // -------------------------------------------------------------------------- //
 // DeviceAddress
 // -------------------------------------------------------------------------- //
@@ -51,6 +121,34 @@ std::string DeviceAffinity::to_s() const {
   }
 }
 
+// -------------------------------------------------------------------------- //
+// DeviceMemoryStats
+// -------------------------------------------------------------------------- //
+
+std::string DeviceMemoryStats::to_s() const {
+  std::string allocator =
+      allocator_statistics
+          ? fmt::format("device_bytes_allocated={}, device_bytes_peak={}, "
+                        "host_bytes_allocated={}, host_bytes_peak={}, ",
+                        device_bytes_allocated, device_bytes_peak,
+                        host_bytes_allocated, host_bytes_peak)
+          : std::string();
+  return fmt::format(
+      "DeviceMemoryStats({}cached_bytes={}, staging_bytes={}, "
+      "total_bytes={}, used_bytes={})",
+      allocator, cached_bytes, staging_bytes, total_bytes, used_bytes);
+}
+
+std::string DeviceTelemetry::to_s() const {
+  return fmt::format(
+      "DeviceTelemetry(busy_percent={}, memory_busy_percent={}, "
+      "shader_clock_mhz={}, max_shader_clock_mhz={}, memory_clock_mhz={}, "
+      "max_memory_clock_mhz={}, temperature_mc={}, power_uw={})",
+      busy_percent, memory_busy_percent, shader_clock_mhz,
+      max_shader_clock_mhz, memory_clock_mhz, max_memory_clock_mhz,
+      temperature_mc, power_uw);
+}
+
 // -------------------------------------------------------------------------- //
 // Device
 // -------------------------------------------------------------------------- //
@@ -66,11 +164,61 @@ Device::Device(DeviceAddress address, iree::hal_device_ptr hal_device,
 
 Device::~Device() = default;
 
+bool Device::CanAccessPeer(const Device &other) const {
+  return hal_device() == other.hal_device();
+}
+
+IpcMemoryHandle Device::ExportIpcMemory(iree_hal_buffer_t *buffer) {
+  throw std::invalid_argument(fmt::format(
+      "Device {} does not support sharing memory with other processes",
+      name()));
+}
+
+iree::hal_buffer_ptr Device::ImportIpcMemory(const IpcMemoryHandle &handle) {
+  throw std::invalid_argument(fmt::format(
+      "Device {} does not support sharing memory with other processes",
+      name()));
+}
+
+DeviceMemoryStats Device::QueryMemoryStats() const {
+  DeviceMemoryStats stats;
+#if IREE_STATISTICS_ENABLE
+  iree_hal_allocator_statistics_t allocator_stats;
+  iree_hal_allocator_query_statistics(
+      iree_hal_device_allocator(hal_device()), &allocator_stats);
+  stats.allocator_statistics = true;
+  stats.device_bytes_allocated = allocator_stats.device_bytes_allocated -
+                                 allocator_stats.device_bytes_freed;
+  stats.device_bytes_peak = allocator_stats.device_bytes_peak;
+  stats.host_bytes_allocated = allocator_stats.host_bytes_allocated -
+                               allocator_stats.host_bytes_freed;
+  stats.host_bytes_peak = allocator_stats.host_bytes_peak;
+#endif  // IREE_STATISTICS_ENABLE
+  stats.cached_bytes =
+      std::max<int64_t>(0, cached_bytes_.load(std::memory_order_relaxed));
+  stats.staging_bytes =
+      std::max<int64_t>(0, staging_bytes_.load(std::memory_order_relaxed));
+  if (!QueryPhysicalMemory(stats.total_bytes, stats.used_bytes)) {
+    stats.total_bytes = 0;
+    stats.used_bytes = 0;
+  }
+  return stats;
+}
+
 std::string Device::to_s() const {
+  std::string host_numa_node =
+      host_numa_node_ >= 0 ? fmt::format(", host_numa_node={}", host_numa_node_)
+                           : std::string();
+  if (host_huge_pages_ != sysconfig::HugePages::kNone) {
+    host_numa_node += fmt::format(", host_huge_pages={}",
+                                  sysconfig::to_string_view(host_huge_pages_));
+  }
+  if (unified_memory_) host_numa_node += ", unified_memory";
   return fmt::format(
-      "Device(name='{}', ordinal={}:{}, node_affinity={}, capabilities=0x{:x})",
+      "Device(name='{}', ordinal={}:{}, node_affinity={}{}, "
+      "capabilities=0x{:x})",
       name(), address().instance_ordinal, address().queue_ordinal,
-      node_affinity(), capabilities_);
+      node_affinity(), host_numa_node, capabilities_);
 }
 
 }  // namespace shortfin::local
@@ -7,7 +7,9 @@
 #ifndef SHORTFIN_LOCAL_DEVICE_H
 #define SHORTFIN_LOCAL_DEVICE_H
 
+#include <atomic>
 #include <bit>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -15,6 +17,7 @@
 #include "iree/hal/api.h"
 #include "shortfin/support/api.h"
 #include "shortfin/support/iree_helpers.h"
+#include "shortfin/support/sysconfig.h"
 
 namespace shortfin::local {
 
@@ -120,6 +123,72 @@ struct SHORTFIN_API DeviceAddress {
   }
 };
 
+// Memory usage of a device. See Device::QueryMemoryStats().
+struct SHORTFIN_API DeviceMemoryStats {
+  // Whether the HAL allocator statistics below were collected. This requires
+  // IREE to be built with IREE_STATISTICS_ENABLE.
+  bool allocator_statistics = false;
+  // Bytes currently allocated through the HAL allocator and their high water
+  // mark, for device local and host local memory.
+  uint64_t device_bytes_allocated = 0;
+  uint64_t device_bytes_peak = 0;
+  uint64_t host_bytes_allocated = 0;
+  uint64_t host_bytes_peak = 0;
+  // Bytes which are allocated but held for reuse by the device buffer caches
+  // and host staging rings of all fibers (see detail::Scheduler).
+  uint64_t cached_bytes = 0;
+  uint64_t staging_bytes = 0;
+  // Physical memory of the device and how much of it is in use by all
+  // processes, as reported by the driver. 0 if not known.
+  uint64_t total_bytes = 0;
+  uint64_t used_bytes = 0;
+
+  uint64_t free_bytes() const {
+    return total_bytes > used_bytes ? total_bytes - used_bytes : 0;
+  }
+  std::string to_s() const;
+};
+
+// Point in time health and throughput counters of a device, as reported by
+// the driver. See Device::QueryTelemetry(). Counters which are not known are
+// -1.
+struct SHORTFIN_API DeviceTelemetry {
+  // Percent of time the device (and its memory controller) was busy over the
+  // driver's sampling window.
+  int busy_percent = -1;
+  int memory_busy_percent = -1;
+  // Current and maximum shader (graphics) and memory clocks. A shader clock
+  // below the maximum while busy indicates power or thermal throttling.
+  int shader_clock_mhz = -1;
+  int max_shader_clock_mhz = -1;
+  int memory_clock_mhz = -1;
+  int max_memory_clock_mhz = -1;
+  // Temperature in millidegrees Celsius and average power in microwatts.
+  int64_t temperature_mc = -1;
+  int64_t power_uw = -1;
+
+  std::string to_s() const;
+};
+
+// Handle to device memory exported for use by other processes on the same host
+// (i.e. a HIP IPC memory handle). See Device::ExportIpcMemory(). Handles are
+// plain data which can be sent to another process by any means.
+struct SHORTFIN_API IpcMemoryHandle {
+  // PCI address of the physical device owning the memory (if known), so that
+  // the importer can check that it is importing on the same device.
+  std::string pci_address;
+  // Driver specific handle of the underlying allocation.
+  std::string opaque;
+  // Range of the exported buffer within the allocation.
+  uint64_t offset = 0;
+  uint64_t length = 0;
+
+  // Serializes to/from bytes. Parse throws std::invalid_argument if the bytes
+  // are not a serialized handle.
+  std::string Serialize() const;
+  static IpcMemoryHandle Parse(std::string_view bytes);
+};
+
 // A device attached to the LocalSystem.
 class SHORTFIN_API Device {
  public:
@@ -139,8 +208,65 @@ class SHORTFIN_API Device {
   const DeviceAddress &address() const { return address_; }
   std::string_view name() const { return address_.device_name; }
   int node_affinity() const { return node_affinity_; }
+
+  // NUMA node that host allocations for this device (i.e.
+  // storage::allocate_host and staging buffers) are bound to, or -1 if they
+  // are left to the allocating thread's policy. Set by the SystemBuilder
+  // before the device is added to the system.
+  int host_numa_node() const { return host_numa_node_; }
+  void set_host_numa_node(int node_id) { host_numa_node_ = node_id; }
+
+  // Page backing of host allocations for this device which span at least one
+  // huge page. Explicit huge pages fall back to regular allocations when
+  // none are free. Set by the SystemBuilder.
+  sysconfig::HugePages host_huge_pages() const { return host_huge_pages_; }
+  void set_host_huge_pages(sysconfig::HugePages pages) {
+    host_huge_pages_ = pages;
+  }
+
+  // Whether device allocations are in memory shared with the host, which it
+  // maps in place (see storage::allocate_unified), for devices without
+  // memory of their own (i.e. APUs). Set by the SystemBuilder.
+  bool unified_memory() const { return unified_memory_; }
+  void set_unified_memory(bool unified) { unified_memory_ = unified; }
   iree_hal_device_t *hal_device() const { return hal_device_.get(); }
 
+  // Whether work on this device can directly access device local memory
+  // allocated by `other` (i.e. peer to peer over XGMI). Devices sharing a HAL
+  // device always can. Otherwise transfers must be staged through host memory.
+  virtual bool CanAccessPeer(const Device &other) const;
+
+  // Shares device memory with other processes. ExportIpcMemory creates a
+  // handle to the memory of a buffer allocated by this device, which remains
+  // valid while the buffer is alive. ImportIpcMemory maps such a handle,
+  // exported by another process on the same physical device, as a read only
+  // buffer. The exporter must keep its buffer alive (and not write to it)
+  // while importers use it. Both throw std::invalid_argument if the device
+  // does not support sharing memory.
+  virtual IpcMemoryHandle ExportIpcMemory(iree_hal_buffer_t *buffer);
+  virtual iree::hal_buffer_ptr ImportIpcMemory(const IpcMemoryHandle &handle);
+
+  // Memory usage of the device. Allocator statistics and physical memory are
+  // of the HAL device, which is shared by devices for each of its queues.
+  // Pooled bytes are of this device only.
+  DeviceMemoryStats QueryMemoryStats() const;
+
+  // Samples the health and throughput counters of the device. Returns false
+  // if the device does not report any. Logical devices of the same physical
+  // device report the same counters. This reads driver state and may be slow
+  // relative to a dispatch: it is meant for periodic sampling (see
+  // TelemetrySampler), not for the hot path.
+  virtual bool QueryTelemetry(DeviceTelemetry &telemetry) const {
+    return false;
+  }
+
+  // Called by shortfin level pools as they take and release buffers of this
+  // device. Thread safe.
+  void AdjustPooledBytes(int64_t cached_delta, int64_t staging_delta) {
+    cached_bytes_.fetch_add(cached_delta, std::memory_order_relaxed);
+    staging_bytes_.fetch_add(staging_delta, std::memory_order_relaxed);
+  }
+
   std::string to_s() const;
 
   bool operator==(const Device &other) const {
@@ -148,11 +274,24 @@ class SHORTFIN_API Device {
     return this == &other;
   }
 
+ protected:
+  // Gets the physical memory of the device and how much of it is in use.
+  // Returns false if not supported.
+  virtual bool QueryPhysicalMemory(uint64_t &total_bytes,
+                                   uint64_t &used_bytes) const {
+    return false;
+  }
+
  private:
   DeviceAddress address_;
   iree::hal_device_ptr hal_device_;
   int node_affinity_;
+  int host_numa_node_ = -1;
+  sysconfig::HugePages host_huge_pages_ = sysconfig::HugePages::kNone;
+  bool unified_memory_ = false;
   uint32_t capabilities_ = 0;
+  std::atomic<int64_t> cached_bytes_ = 0;
+  std::atomic<int64_t> staging_bytes_ = 0;
 };
 
 // Holds a reference to a Device* and a bitmask of queues that are being
@@ -47,6 +47,11 @@ Fiber::Fiber(std::shared_ptr<System> system, Worker &worker,
 
 Fiber::~Fiber() { logging::destruct("Fiber", this); }
 
+Fiber::IsolateStats Fiber::isolate_stats() {
+  iree::slim_mutex_lock_guard lock(program_isolate_mu_);
+  return isolate_stats_;
+}
+
 std::string Fiber::to_s() const {
   return fmt::format("Fiber(worker='{}', devices=[{}])", worker_.name(),
                      fmt::join(device_names(), ", "));
@@ -94,10 +99,9 @@ std::vector<std::string_view> Fiber::device_names() const {
 
 VoidFuture ScopedDevice::OnSync(bool flush) {
   if (flush) {
-    fiber().scheduler().Flush();
+    fiber().scheduler().Flush(detail::FlushReason::SYNC);
   }
-  auto &default_account = fiber().scheduler().GetDefaultAccount(*this);
-  return default_account.OnSync();
+  return fiber().scheduler().OnSync(*this);
 }
 
 }  // namespace shortfin::local
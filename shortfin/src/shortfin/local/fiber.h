@@ -127,6 +127,16 @@ class SHORTFIN_API Fiber : public std::enable_shared_from_this<Fiber> {
     return ScopedDevice(*this, DeviceAffinity(d));
   }
   detail::Scheduler &scheduler() { return scheduler_; }
+
+  // Accounting of the program context forks made for isolated invocations
+  // on this fiber (see Program::PrepareIsolates to take them at init time).
+  struct IsolateStats {
+    uint64_t fork_count = 0;
+    iree_duration_t total_fork_ns = 0;
+    iree_duration_t max_fork_ns = 0;
+  };
+  IsolateStats isolate_stats();
+
   detail::TimelineResource::Ref NewTimelineResource(
       detail::TimelineResourceDestructor destructor = nullptr) {
     return scheduler().NewTimelineResource(shared_ptr(), std::move(destructor));
@@ -163,6 +173,7 @@ class SHORTFIN_API Fiber : public std::enable_shared_from_this<Fiber> {
   std::unordered_map<iree_vm_context_t *,
                      std::unique_ptr<detail::ProgramIsolate>>
       program_isolates_;
+  IsolateStats isolate_stats_ SHORTFIN_GUARDED_BY(program_isolate_mu_);
   friend struct detail::ProgramIsolate;
 };
 
@@ -6,6 +6,8 @@
 
 #include "shortfin/local/messaging.h"
 
+#include <algorithm>
+
 #include "shortfin/support/logging.h"
 
 namespace shortfin::local {
@@ -14,6 +16,70 @@ namespace shortfin::local {
 // Message
 // -------------------------------------------------------------------------- //
 
+// -------------------------------------------------------------------------- //
+// MessagePool
+// -------------------------------------------------------------------------- //
+
+namespace {
+
+struct MessagePoolCreator : public MessagePool {
+  MessagePoolCreator(size_t block_size, size_t max_free_blocks)
+      : MessagePool(block_size, max_free_blocks) {}
+};
+
+}  // namespace
+
+MessagePool::MessagePool(size_t block_size, size_t max_free_blocks)
+    : block_size_(std::max(block_size, kHeaderSize + sizeof(Message))),
+      max_free_blocks_(max_free_blocks) {}
+
+MessagePool::~MessagePool() {
+  // Blocks in use hold a reference to the pool, so only free blocks remain.
+  for (void *block : free_blocks_) {
+    ::operator delete(block);
+  }
+}
+
+std::shared_ptr<MessagePool> MessagePool::Create(size_t block_size,
+                                                 size_t max_free_blocks) {
+  return std::make_shared<MessagePoolCreator>(block_size, max_free_blocks);
+}
+
+void *MessagePool::AcquireBlock() {
+  void *block = nullptr;
+  {
+    iree::slim_mutex_lock_guard g(lock_);
+    if (!free_blocks_.empty()) {
+      block = free_blocks_.back();
+      free_blocks_.pop_back();
+    }
+  }
+  if (block) {
+    reuse_count_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    block = ::operator new(block_size_);
+    heap_allocation_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  new (block) BlockHeader{shared_from_this()};
+  return block;
+}
+
+void MessagePool::RecycleBlock(void *block) noexcept {
+  auto *header = static_cast<BlockHeader *>(block);
+  // Take the pool reference out of the block: if it is the last one, the pool
+  // (and its free blocks, which may include this one) are freed on return.
+  std::shared_ptr<MessagePool> pool = std::move(header->pool);
+  header->~BlockHeader();
+  {
+    iree::slim_mutex_lock_guard g(pool->lock_);
+    if (pool->free_blocks_.size() < pool->max_free_blocks_) {
+      pool->free_blocks_.push_back(block);
+      return;
+    }
+  }
+  ::operator delete(block);
+}
+
 // -------------------------------------------------------------------------- //
 // Queue
 // -------------------------------------------------------------------------- //
@@ -26,13 +92,34 @@ struct QueueCreator : public Queue {
 
 }  // namespace
 
-Queue::Queue(Options options) : options_(std::move(options)) {}
+Queue::Queue(Options options) : options_(std::move(options)) {
+  if (options_.capacity > 0) {
+    if (options_.lock_free) {
+      ring_ = std::make_unique<mpsc_ring<Message::Ref>>(options_.capacity);
+      options_.capacity = ring_->capacity();
+    }
+    space_event_ = iree::shared_event::create(true);
+  } else if (options_.lock_free) {
+    throw std::invalid_argument(
+        "A lock-free queue must be created with a capacity");
+  }
+  if (options_.message_pool_blocks > 0) {
+    message_pool_ = MessagePool::Create(options_.message_pool_block_size,
+                                        options_.message_pool_blocks);
+  }
+}
+
+Queue::~Queue() = default;
 
 std::shared_ptr<Queue> Queue::Create(Options options) {
   return std::make_shared<QueueCreator>(std::move(options));
 }
 
 std::string Queue::to_s() const {
+  if (is_bounded()) {
+    return fmt::format("Queue(name={}, capacity={}{})", options().name,
+                       options().capacity, is_lock_free() ? ", lock_free" : "");
+  }
   return fmt::format("Queue(name={})", options().name);
 }
 
@@ -42,56 +129,200 @@ bool Queue::is_closed() {
 }
 
 void Queue::WriteNoDelay(Message::Ref mr) {
-  std::optional<MessageFuture> future;
+  if (is_lock_free() && TryWriteRing(mr)) return;
+  WriteLocked(mr, /*overflow=*/true);
+}
+
+bool Queue::TryWrite(Message::Ref &mr) {
+  if (is_lock_free() && TryWriteRing(mr)) return true;
+  return WriteLocked(mr, /*overflow=*/false);
+}
+
+bool Queue::TryWriteRing(Message::Ref &mr) {
+  // Stay off the ring while there is an overflow so that messages written
+  // after it are not read before it.
+  if (overflowing_.load(std::memory_order_acquire)) return false;
+  if (!ring_->TryPush(mr)) return false;
+  // Pairs with the fence in QueueReader::Read: either the reader sees this
+  // message when it re-checks the ring or we see that it is waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (reader_waiting_.load(std::memory_order_relaxed)) {
+    // The message is already queued, so this only hands it (or a message
+    // written concurrently) to the reader if one is still pending.
+    Message::Ref none;
+    WriteLocked(none, /*overflow=*/false);
+  }
+  return true;
+}
+
+bool Queue::WriteLocked(Message::Ref &mr, bool overflow) {
+  ReadCompletion completion;
+  std::optional<Message::Ref> delivered;
   {
     iree::slim_mutex_lock_guard g(lock_);
-    if (pending_readers_.empty()) {
+    if (is_lock_free()) {
+      if (mr) {
+        if (overflowing_.load(std::memory_order_relaxed) ||
+            !ring_->TryPush(mr)) {
+          if (!overflow) return false;
+          // Over capacity. Writers awaiting a write are held back until the
+          // reader has drained the backlog.
+          backlog_.push_back(std::move(mr));
+          if (!overflowing_.load(std::memory_order_relaxed)) {
+            overflowing_.store(true, std::memory_order_release);
+            if (!closed_) space_event_->reset();
+          }
+        }
+      }
+      if (pending_readers_.empty()) return true;
+      delivered = PopNext();
+      if (!delivered) return true;
+      reader_waiting_.store(false, std::memory_order_relaxed);
+    } else if (pending_readers_.empty()) {
       // No readers. Just add to the backlog.
+      if (is_bounded() && backlog_.size() >= options_.capacity) {
+        if (!overflow) return false;
+        // Going over capacity: hold back writers awaiting a write until
+        // readers have made room again.
+        if (backlog_.size() == options_.capacity && !closed_) {
+          space_event_->reset();
+        }
+      }
       backlog_.push_back(std::move(mr));
-      return;
+      return true;
     } else {
-      // Signal a reader. We must do this within the queue lock to avoid
-      // a QueueReader lifetime hazard. But we defer actually setting the
-      // future until out of the lock.
-      QueueReader *reader = pending_readers_.front();
-      pending_readers_.pop_front();
-      future = *reader->read_result_future_;
-      // Reset the worker for a new read.
-      reader->worker_ = nullptr;
-      reader->read_result_future_.reset();
+      delivered = std::move(mr);
     }
+
+    // Signal a reader. We must do this within the queue lock to avoid
+    // a QueueReader lifetime hazard. But we defer actually setting the
+    // future until out of the lock.
+    QueueReader *reader = pending_readers_.front();
+    pending_readers_.pop_front();
+    completion = CompleteReadLocked(reader, std::move(delivered));
   }
 
   // Signal the future outside of our lock.
-  future->set_result(std::move(mr));
+  completion.Complete();
+  return true;
+}
+
+Message::Ref Queue::PopBacklog() {
+  Message::Ref mr(std::move(backlog_.front()));
+  backlog_.pop_front();
+  if (is_lock_free()) {
+    // The ring is the capacity, so anything in the backlog is over it.
+    if (backlog_.empty()) {
+      overflowing_.store(false, std::memory_order_release);
+      space_event_->set();
+    }
+  } else if (is_bounded() && backlog_.size() == options_.capacity) {
+    space_event_->set();
+  }
+  return mr;
+}
+
+std::optional<Message::Ref> Queue::PopNext() {
+  if (ring_) {
+    if (auto mr = ring_->TryPop()) return mr;
+  }
+  if (backlog_.empty()) return std::nullopt;
+  return PopBacklog();
+}
+
+Queue::ReadCompletion Queue::CompleteReadLocked(
+    QueueReader *reader, std::optional<Message::Ref> first) {
+  ReadCompletion completion;
+  if (first) completion.messages.push_back(std::move(*first));
+  if (reader->batch_result_future_) {
+    // Fill the rest of the batch from what is already queued.
+    while (completion.messages.size() < reader->batch_max_count_) {
+      std::optional<Message::Ref> mr = PopNext();
+      if (!mr) break;
+      completion.messages.push_back(std::move(*mr));
+    }
+    completion.batch_future = std::move(reader->batch_result_future_);
+    reader->batch_result_future_.reset();
+  } else {
+    completion.future = std::move(reader->read_result_future_);
+    reader->read_result_future_.reset();
+  }
+  // Reset the worker for a new read.
+  reader->worker_ = nullptr;
+  reader->read_id_ = 0;
+  return completion;
+}
+
+void Queue::ReadCompletion::Complete() {
+  if (future) {
+    future->set_result(messages.empty() ? Message::Ref()
+                                        : std::move(messages.front()));
+  } else if (batch_future) {
+    batch_future->set_result(std::move(messages));
+  }
 }
 
+iree_status_t Queue::OnReadTimeout(void *state_vp, iree_loop_t loop,
+                                   iree_status_t status) noexcept {
+  std::unique_ptr<QueueReader::TimeoutState> state(
+      static_cast<QueueReader::TimeoutState *>(state_vp));
+  IREE_RETURN_IF_ERROR(status);
+  Queue &queue = *state->queue;
+  ReadCompletion completion;
+  {
+    iree::slim_mutex_lock_guard g(queue.lock_);
+    // The read may have completed since, but pending readers are alive.
+    auto it = std::find_if(queue.pending_readers_.begin(),
+                           queue.pending_readers_.end(),
+                           [&](QueueReader *reader) {
+                             return reader->read_id_ == state->read_id;
+                           });
+    if (it == queue.pending_readers_.end()) return iree_ok_status();
+    QueueReader *reader = *it;
+    queue.pending_readers_.erase(it);
+    queue.reader_waiting_.store(false, std::memory_order_relaxed);
+    completion = queue.CompleteReadLocked(reader, std::nullopt);
+  }
+  completion.Complete();
+  return iree_ok_status();
+}
+
+CompletionEvent Queue::SpaceEvent() { return CompletionEvent(space_event_); }
+
 void Queue::Close() {
-  std::vector<QueueReader *> async_close_readers;
+  std::vector<ReadCompletion> completions;
   {
     iree::slim_mutex_lock_guard g(lock_);
     if (closed_) return;
     closed_ = true;
 
-    // If there is a backlog then the queue readers will handle any close action
-    // on their own.
-    if (!backlog_.empty()) {
+    // Writers held back by backpressure must not wait on readers that may
+    // have stopped reading.
+    if (is_bounded()) space_event_->set();
+
+    if (is_lock_free()) {
+      reader_waiting_.store(false, std::memory_order_relaxed);
+    } else if (!backlog_.empty()) {
+      // If there is a backlog then the queue readers will handle any close
+      // action on their own.
       assert(pending_readers_.empty() &&
              "Attempt to close queue with backlog and pending readers");
       return;
     }
 
-    async_close_readers.insert(async_close_readers.end(),
-                               pending_readers_.begin(),
-                               pending_readers_.end());
+    // A pending reader of a lock-free queue found it empty, but writes may
+    // have raced in since. Those are delivered first and it sees the close
+    // on its next read.
+    for (QueueReader *reader : pending_readers_) {
+      completions.push_back(CompleteReadLocked(reader, PopNext()));
+    }
     pending_readers_.clear();
   }
 
-  // Asynchronously resolve any pending readers with a null message.
-  for (QueueReader *reader : async_close_readers) {
-    reader->read_result_future_->set_result(Message::Ref());
-    reader->worker_ = nullptr;
-    reader->read_result_future_.reset();
+  // Resolve pending readers outside of the lock, with a null message (or an
+  // empty batch) if there was nothing left.
+  for (ReadCompletion &completion : completions) {
+    completion.Complete();
   }
 }
 
@@ -101,16 +332,37 @@ QueueWriter::QueueWriter(Queue &queue, Options options)
 QueueWriter::~QueueWriter() = default;
 
 CompletionEvent QueueWriter::Write(Message::Ref mr) {
-  queue().WriteNoDelay(std::move(mr));
-  return CompletionEvent();
+  if (!queue().is_bounded()) {
+    queue().WriteNoDelay(std::move(mr));
+    return CompletionEvent();
+  }
+  if (queue().is_lock_free() && queue().TryWriteRing(mr)) {
+    return CompletionEvent();
+  }
+  queue().WriteLocked(mr, /*overflow=*/true);
+  return queue().SpaceEvent();
 }
 
 QueueReader::QueueReader(Queue &queue, Options options)
-    : queue_(queue.shared_from_this()), options_(std::move(options)) {}
+    : queue_(queue.shared_from_this()), options_(std::move(options)) {
+  if (queue_->is_lock_free()) {
+    iree::slim_mutex_lock_guard g(queue_->lock_);
+    if (queue_->has_reader_) {
+      throw std::logic_error(fmt::format(
+          "{} is lock-free and only supports a single reader",
+          queue_->to_s()));
+    }
+    queue_->has_reader_ = true;
+  }
+}
 
 QueueReader::~QueueReader() {
   iree::slim_mutex_lock_guard g(queue().lock_);
-  if (read_result_future_) {
+  if (queue().is_lock_free()) {
+    queue().has_reader_ = false;
+    queue().reader_waiting_.store(false, std::memory_order_relaxed);
+  }
+  if (read_result_future_ || batch_result_future_) {
     logging::warn("QueueReader destroyed while pending");
     // Reader is in progress: Cancel it from the queue.
     auto it = std::find(queue().pending_readers_.begin(),
@@ -122,6 +374,8 @@ QueueReader::~QueueReader() {
 }
 
 MessageFuture QueueReader::Read() {
+  if (queue().is_lock_free()) return ReadLockFree();
+
   // TODO: It should be possible to further constrain the scope of this lock,
   // but it is set here to be conservatively safe pending a full analysis.
   iree::slim_mutex_lock_guard g(queue().lock_);
@@ -140,8 +394,7 @@ MessageFuture QueueReader::Read() {
   if (!queue().backlog_.empty()) {
     // Service from the backlog.
     MessageFuture imm_future(worker_);
-    imm_future.set_result(std::move(queue().backlog_.front()));
-    queue().backlog_.pop_front();
+    imm_future.set_result(queue().PopBacklog());
     worker_ = nullptr;
     return imm_future;
   }
@@ -156,8 +409,119 @@ MessageFuture QueueReader::Read() {
 
   // Settle in for a wait.
   queue().pending_readers_.push_back(this);
+  read_id_ = ++queue().last_read_id_;
+  read_result_future_ = MessageFuture(worker_);
+  return *read_result_future_;
+}
+
+void QueueReader::BeginRead() {
+  if (worker_) {
+    throw std::logic_error(
+        "Cannot read concurrently from a single QueueReader");
+  }
+  worker_ = Worker::GetCurrent();
+  if (!worker_) {
+    throw std::logic_error("Cannot wait on QueueReader outside of worker");
+  }
+}
+
+MessageFuture QueueReader::ReadLockFree() {
+  BeginRead();
+
+  // Service from the ring without the lock when there is no overflow to keep
+  // in order behind it. This reader is the only consumer: writers only pop
+  // on its behalf under the lock while it is pending.
+  if (!queue().overflowing_.load(std::memory_order_acquire)) {
+    if (auto mr = queue().ring_->TryPop()) {
+      MessageFuture imm_future(worker_);
+      imm_future.set_result(std::move(*mr));
+      worker_ = nullptr;
+      return imm_future;
+    }
+  }
+
+  iree::slim_mutex_lock_guard g(queue().lock_);
+  // Announce the wait before the final check of the ring. Pairs with the
+  // fence in Queue::TryWriteRing.
+  queue().reader_waiting_.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::optional<Message::Ref> mr = queue().PopNext();
+  if (mr || queue().closed_) {
+    queue().reader_waiting_.store(false, std::memory_order_relaxed);
+    MessageFuture imm_future(worker_);
+    imm_future.set_result(mr ? std::move(*mr) : Message::Ref());
+    worker_ = nullptr;
+    return imm_future;
+  }
+
+  // Settle in for a wait.
+  queue().pending_readers_.push_back(this);
+  read_id_ = ++queue().last_read_id_;
   read_result_future_ = MessageFuture(worker_);
   return *read_result_future_;
 }
 
+MessageBatchFuture QueueReader::ReadBatch(size_t max_count,
+                                          iree_timeout_t timeout) {
+  if (max_count == 0) {
+    throw std::invalid_argument("ReadBatch requires a max_count > 0");
+  }
+  BeginRead();
+  MessageBatchFuture batch_future(worker_);
+  std::vector<Message::Ref> messages;
+  auto complete_now = [&]() {
+    worker_ = nullptr;
+    batch_future.set_result(std::move(messages));
+    return batch_future;
+  };
+
+  // As with ReadLockFree, the ring can be drained without the lock.
+  if (queue().is_lock_free() &&
+      !queue().overflowing_.load(std::memory_order_acquire)) {
+    while (messages.size() < max_count) {
+      std::optional<Message::Ref> mr = queue().ring_->TryPop();
+      if (!mr) break;
+      messages.push_back(std::move(*mr));
+    }
+    if (!messages.empty()) return complete_now();
+  }
+
+  iree::slim_mutex_lock_guard g(queue().lock_);
+  if (queue().is_lock_free()) {
+    queue().reader_waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+  while (messages.size() < max_count) {
+    std::optional<Message::Ref> mr = queue().PopNext();
+    if (!mr) break;
+    messages.push_back(std::move(*mr));
+  }
+  if (!messages.empty() || queue().closed_ ||
+      iree_timeout_is_immediate(timeout)) {
+    queue().reader_waiting_.store(false, std::memory_order_relaxed);
+    return complete_now();
+  }
+
+  // Settle in for a wait, arranging for it to be resolved empty on timeout.
+  // The timer is not cancelled if the read completes first, so it matches
+  // on the id of this read.
+  uint64_t read_id = ++queue().last_read_id_;
+  if (!iree_timeout_is_infinite(timeout)) {
+    auto *state = new TimeoutState{queue_, read_id};
+    iree_status_t status =
+        worker_->WaitUntilLowLevel(timeout, &Queue::OnReadTimeout, state);
+    if (!iree_status_is_ok(status)) {
+      delete state;
+      queue().reader_waiting_.store(false, std::memory_order_relaxed);
+      worker_ = nullptr;
+      SHORTFIN_THROW_IF_ERROR(status);
+    }
+  }
+  queue().pending_readers_.push_back(this);
+  read_id_ = read_id;
+  batch_max_count_ = max_count;
+  batch_result_future_ = batch_future;
+  return batch_future;
+}
+
 }  // namespace shortfin::local
@@ -7,15 +7,21 @@
 #ifndef SHORTFIN_LOCAL_MESSAGING_H
 #define SHORTFIN_LOCAL_MESSAGING_H
 
+#include <atomic>
+#include <cstddef>
 #include <deque>
 #include <memory>
+#include <new>
 #include <optional>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "shortfin/local/async.h"
 #include "shortfin/local/worker.h"
 #include "shortfin/support/api.h"
 #include "shortfin/support/iree_concurrency.h"
+#include "shortfin/support/mpsc_ring.h"
 
 namespace shortfin::local {
 
@@ -24,6 +30,7 @@ namespace shortfin::local {
 // -------------------------------------------------------------------------- //
 
 class Message;
+class MessagePool;
 namespace detail {
 
 // Message lifetime by default is managed by an internal reference count
@@ -80,6 +87,12 @@ class SHORTFIN_API Message {
    public:
     explicit Ref(Message &msg) : msg_(&msg) { msg.Retain(); }
     Ref() : msg_(nullptr) {}
+    // Takes over the reference that a newly constructed Message starts with.
+    static Ref Adopt(Message *msg) {
+      Ref ref;
+      ref.msg_ = msg;
+      return ref;
+    }
     ~Ref() {
       if (msg_) {
         msg_->Release();
@@ -88,7 +101,7 @@ class SHORTFIN_API Message {
     Ref(const Ref &other) : msg_(other.msg_) {
       if (msg_) msg_->Retain();
     }
-    Ref(Ref &&other) : msg_(other.msg_) { other.msg_ = nullptr; }
+    Ref(Ref &&other) noexcept : msg_(other.msg_) { other.msg_ = nullptr; }
     Ref &operator=(const Ref &other) {
       if (other.msg_) other.msg_->Retain();
       reset();
@@ -118,6 +131,9 @@ class SHORTFIN_API Message {
     Message *msg_ = nullptr;
   };
 
+  // Whether the storage of this message is recycled by a MessagePool.
+  bool is_pooled() const { return pool_block_ != nullptr; }
+
  protected:
   mutable iree::slim_mutex lock_;
   // Manual retain and release. Callers must assume that the Message is no
@@ -136,12 +152,82 @@ class SHORTFIN_API Message {
   mutable intptr_t ref_data_ SHORTFIN_GUARDED_BY(lock_) = 1;
   mutable detail::MessageLifetimeController lifetime_controller_
       SHORTFIN_GUARDED_BY(lock_);
+  // Storage block when allocated by a MessagePool. Set once on construction.
+  void *pool_block_ = nullptr;
   friend struct detail::MessageLifetimeController;
+  friend class MessagePool;
+};
+
+// Recycles the storage of the Messages it allocates, so that hot paths which
+// create a message per item (i.e. streaming responses) do not go through the
+// heap each time. Any Message subclass can be allocated from a pool: those
+// that fit in the block size reuse storage, larger ones fall back to the heap.
+//
+// Pooled messages keep their pool alive, so a pool can be dropped (or its
+// queue destroyed) while messages are in flight. Blocks are freed back to the
+// heap beyond `max_free_blocks`. Pooled messages are released to the pool
+// rather than deleted and so cannot have their lifetime transferred (i.e. to
+// Python).
+class SHORTFIN_API MessagePool
+    : public std::enable_shared_from_this<MessagePool> {
+ public:
+  static constexpr size_t kDefaultBlockSize = 256;
+  static constexpr size_t kDefaultMaxFreeBlocks = 1024;
+
+  static std::shared_ptr<MessagePool> Create(
+      size_t block_size = kDefaultBlockSize,
+      size_t max_free_blocks = kDefaultMaxFreeBlocks);
+  MessagePool(const MessagePool &) = delete;
+  MessagePool &operator=(const MessagePool &) = delete;
+  ~MessagePool();
+
+  // Largest message (in bytes) that is pooled.
+  size_t max_message_size() const { return block_size_ - kHeaderSize; }
+
+  // Constructs a T and returns the only reference to it.
+  template <typename T, typename... Args>
+  Message::Ref New(Args &&...args);
+
+  // Number of blocks allocated from the heap and number of allocations that
+  // reused a free block, over the lifetime of the pool.
+  uint64_t heap_allocation_count() const {
+    return heap_allocation_count_.load(std::memory_order_relaxed);
+  }
+  uint64_t reuse_count() const {
+    return reuse_count_.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  MessagePool(size_t block_size, size_t max_free_blocks);
+
+ private:
+  // Each block starts with a header holding the pool reference of the
+  // message that occupies it.
+  struct BlockHeader {
+    std::shared_ptr<MessagePool> pool;
+  };
+  static constexpr size_t kHeaderSize =
+      (sizeof(BlockHeader) + alignof(std::max_align_t) - 1) /
+      alignof(std::max_align_t) * alignof(std::max_align_t);
+
+  void *AcquireBlock();
+  // Returns a block whose message has been destroyed.
+  static void RecycleBlock(void *block) noexcept;
+
+  const size_t block_size_;
+  const size_t max_free_blocks_;
+  iree::slim_mutex lock_;
+  std::vector<void *> free_blocks_ SHORTFIN_GUARDED_BY(lock_);
+  std::atomic<uint64_t> heap_allocation_count_{0};
+  std::atomic<uint64_t> reuse_count_{0};
+  friend class Message;
 };
 
 // Future specialization for Message::Ref.
 template class TypedFuture<Message::Ref>;
 using MessageFuture = TypedFuture<Message::Ref>;
+template class TypedFuture<std::vector<Message::Ref>>;
+using MessageBatchFuture = TypedFuture<std::vector<Message::Ref>>;
 
 // -------------------------------------------------------------------------- //
 // Queue
@@ -160,17 +246,36 @@ using QueuePtr = std::shared_ptr<Queue>;
 // Queues are the primary form of communication in shortfin for exchanging
 // messages. They are inherently thread safe and coupled with the async/worker
 // system for enqueue/dequeue operations.
+//
+// By default a queue is unbounded and every operation takes the queue lock.
+// A queue with a capacity applies backpressure to writers once that many
+// messages are buffered (see QueueWriter::Write). A bounded queue can also be
+// made lock-free, in which case writes go into a ring and only take the lock
+// to wake a waiting reader or when the ring is full. Such a queue supports any
+// number of writers but only a single QueueReader.
 class SHORTFIN_API Queue : public std::enable_shared_from_this<Queue> {
  public:
   struct Options {
     // Queues are generally managed by the system with a global name. The
     // the name is empty, then this is an anonymous queue.
     std::string name;
+    // If non-zero, the number of messages that can be buffered before writes
+    // are subject to backpressure. Writes beyond the capacity are still held
+    // by the queue, but the events returned by QueueWriter::Write do not
+    // complete until readers have brought it back within capacity.
+    size_t capacity = 0;
+    // Whether a bounded queue buffers in a lock-free ring. The capacity is
+    // rounded up to a power of two.
+    bool lock_free = false;
+    // If non-zero, the queue has a MessagePool keeping up to this many free
+    // blocks of `message_pool_block_size` bytes, used by NewMessage.
+    size_t message_pool_blocks = 0;
+    size_t message_pool_block_size = MessagePool::kDefaultBlockSize;
   };
   Queue(const Queue &) = delete;
   Queue &operator=(const Queue &) = delete;
   Queue(Queue &&) = delete;
-  ~Queue() = default;
+  ~Queue();
 
   operator QueuePtr() { return shared_from_this(); }
 
@@ -184,26 +289,95 @@ class SHORTFIN_API Queue : public std::enable_shared_from_this<Queue> {
   // overriding capacity and throttling policy.
   void WriteNoDelay(Message::Ref mr);
 
+  // Writes a message to the queue if it is under capacity, returning false
+  // (and leaving `mr` untouched) if not. Always succeeds for unbounded queues.
+  bool TryWrite(Message::Ref &mr);
+
   // Closes the queue. All readers will return with a null message from here
   // on. Writers that attempt to write to the queue will throw an exception.
   void Close();
 
+  // The pool of messages for this queue, or nullptr if it has none.
+  MessagePool *message_pool() { return message_pool_.get(); }
+
+  // Creates a message to be written to this queue, recycling storage from
+  // its message pool if it has one.
+  template <typename T, typename... Args>
+  Message::Ref NewMessage(Args &&...args) {
+    if (message_pool_) {
+      return message_pool_->New<T>(std::forward<Args>(args)...);
+    }
+    return Message::Ref::Adopt(new T(std::forward<Args>(args)...));
+  }
+
  protected:
  private:
   // Queues can only be created as shared by the System.
   static QueuePtr Create(Options options);
   Queue(Options options);
+  bool is_bounded() const { return options_.capacity > 0; }
+  bool is_lock_free() const { return ring_ != nullptr; }
+  // Lock-free write into the ring of a lock-free queue. Returns false if the
+  // message must take the locked path instead.
+  bool TryWriteRing(Message::Ref &mr);
+  // Locked write path. `overflow` is true if the message may be held beyond
+  // the capacity of a bounded queue. Returns false if a bounded queue is at
+  // capacity and `overflow` is false.
+  bool WriteLocked(Message::Ref &mr, bool overflow);
+  // Pops the front of the backlog, lifting backpressure if that brings a
+  // bounded queue back within capacity.
+  Message::Ref PopBacklog() SHORTFIN_REQUIRES_LOCK(lock_);
+  // Pops the next message for a reader, if any. For lock-free queues, the
+  // ring is drained before the overflow backlog.
+  std::optional<Message::Ref> PopNext() SHORTFIN_REQUIRES_LOCK(lock_);
+  // The result of a pending read, taken under the lock and set on the
+  // reader's future outside of it.
+  struct ReadCompletion {
+    std::optional<MessageFuture> future;
+    std::optional<MessageBatchFuture> batch_future;
+    std::vector<Message::Ref> messages;
+    void Complete();
+  };
+  // Takes the outstanding read of a reader that has been removed from
+  // pending_readers_, resolving it with `first` (if any) and, for batch
+  // reads, whatever else is queued.
+  ReadCompletion CompleteReadLocked(QueueReader *reader,
+                                    std::optional<Message::Ref> first)
+      SHORTFIN_REQUIRES_LOCK(lock_);
+  static iree_status_t OnReadTimeout(void *state, iree_loop_t loop,
+                                     iree_status_t status) noexcept;
+  // Event returned to writers of a bounded queue. Completes once the queue is
+  // within capacity.
+  CompletionEvent SpaceEvent();
+
   mutable iree::slim_mutex lock_;
   Options options_;
+  std::shared_ptr<MessagePool> message_pool_;
   // Backlog of messages not yet sent to a reader. Messages are pushed on the
-  // back and popped from the front.
+  // back and popped from the front. For lock-free queues, this only holds the
+  // overflow of the ring.
   std::deque<Message::Ref> backlog_;
+  // Ring of lock-free queues.
+  std::unique_ptr<mpsc_ring<Message::Ref>> ring_;
+  // Whether a reader of a lock-free queue is (or is about to be) waiting. Writes
+  // into the ring check this after publishing and take the locked path to
+  // wake it.
+  std::atomic<bool> reader_waiting_{false};
+  // Whether the backlog of a lock-free queue is non-empty. While set, writers
+  // bypass the ring so that each writer's messages stay in order.
+  std::atomic<bool> overflowing_{false};
+  // Set while a bounded queue is within capacity.
+  iree::shared_event::ref space_event_;
+  // Whether a QueueReader is attached to a lock-free queue.
+  bool has_reader_ = false;
   // Deque of all readers that are waiting for messages. An attempt is made
   // to dispatch to readers in FIFO order of having entered a wait state.
   // Readers are pushed on the back and popped from the front.
   std::deque<QueueReader *> pending_readers_;
   // Whether the queue has been closed.
   bool closed_ = false;
+  // Identifies each read that enters a wait.
+  uint64_t last_read_id_ = 0;
 
   friend class QueueReader;
   friend class QueueWriter;
@@ -225,7 +399,10 @@ class SHORTFIN_API QueueWriter {
   Queue &queue() { return *queue_; }
 
   // Writes a message to the queue.
-  // The write must be awaited as it can produce backpressure and failures.
+  // The write must be awaited as it can produce backpressure and failures:
+  // when the queue is over capacity, the message is accepted but the returned
+  // event only completes once readers have drained the queue back within
+  // capacity (or it is closed).
   // TODO: This should be a Future<void> so that exceptions can propagate.
   CompletionEvent Write(Message::Ref mr);
 
@@ -248,7 +425,25 @@ class SHORTFIN_API QueueReader {
   // Reads a message from the queue.
   MessageFuture Read();
 
+  // Reads up to `max_count` messages from the queue with a single wake-up.
+  // If messages are queued, all of them (up to the limit) are returned
+  // immediately. Otherwise, resolves as soon as at least one arrives. The
+  // result is empty if the queue is closed or nothing arrived within
+  // `timeout`.
+  MessageBatchFuture ReadBatch(
+      size_t max_count, iree_timeout_t timeout = iree_infinite_timeout());
+
  private:
+  MessageFuture ReadLockFree();
+  // Makes the current worker the reader's, raising if there is an
+  // outstanding read or no worker.
+  void BeginRead();
+  // Owned by the timer of a ReadBatch with a timeout.
+  struct TimeoutState {
+    std::shared_ptr<Queue> queue;
+    uint64_t read_id;
+  };
+
   std::shared_ptr<Queue> queue_;
   Options options_;
 
@@ -256,6 +451,11 @@ class SHORTFIN_API QueueReader {
   // read_result_future_ of the current outstanding read.
   Worker *worker_ = nullptr;
   std::optional<MessageFuture> read_result_future_;
+  // Set instead of read_result_future_ for an outstanding ReadBatch.
+  std::optional<MessageBatchFuture> batch_result_future_;
+  size_t batch_max_count_ = 0;
+  // The Queue::last_read_id_ of the outstanding read.
+  uint64_t read_id_ = 0;
 
   friend class Queue;
   friend class QueueWriter;
@@ -304,7 +504,12 @@ inline void Message::Release() const {
     return;
   } else if (--ref_data_ == 0) {
     lock_.Unlock();
-    delete this;
+    if (void *block = pool_block_) {
+      this->~Message();
+      MessagePool::RecycleBlock(block);
+    } else {
+      delete this;
+    }
     return;
   } else {
     lock_.Unlock();
@@ -312,6 +517,30 @@ inline void Message::Release() const {
   }
 }
 
+template <typename T, typename... Args>
+Message::Ref MessagePool::New(Args &&...args) {
+  static_assert(std::is_base_of_v<Message, T>,
+                "MessagePool only allocates Messages");
+  if constexpr (alignof(T) > alignof(std::max_align_t)) {
+    return Message::Ref::Adopt(new T(std::forward<Args>(args)...));
+  } else {
+    if (sizeof(T) > max_message_size()) {
+      return Message::Ref::Adopt(new T(std::forward<Args>(args)...));
+    }
+    void *block = AcquireBlock();
+    T *msg;
+    try {
+      msg = new (static_cast<char *>(block) + kHeaderSize)
+          T(std::forward<Args>(args)...);
+    } catch (...) {
+      RecycleBlock(block);
+      throw;
+    }
+    static_cast<Message *>(msg)->pool_block_ = block;
+    return Message::Ref::Adopt(msg);
+  }
+}
+
 }  // namespace shortfin::local
 
 #endif  // SHORTFIN_LOCAL_MESSAGING_H
@@ -0,0 +1,53 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include "shortfin/local/benchmark_helpers.h"
+#include "shortfin/local/messaging.h"
+
+namespace shortfin::local {
+namespace {
+
+// A write followed by a read of a new message, on the worker: the read is
+// served from the buffered message without waiting.
+void BenchmarkWriteRead(benchmark::State &state, Queue::Options options) {
+  BenchmarkSystem sys;
+  QueuePtr queue = sys.system().CreateQueue(std::move(options));
+  sys.RunOnWorker([&]() {
+    QueueWriter writer(*queue);
+    QueueReader reader(*queue);
+    for (auto _ : state) {
+      writer.Write(queue->NewMessage<Message>());
+      MessageFuture read = reader.Read();
+      benchmark::DoNotOptimize(read.result());
+    }
+  });
+}
+
+void BM_QueueWriteRead(benchmark::State &state) {
+  BenchmarkWriteRead(state, Queue::Options());
+}
+BENCHMARK(BM_QueueWriteRead)->UseRealTime();
+
+void BM_QueueWriteReadBounded(benchmark::State &state) {
+  Queue::Options options;
+  options.capacity = 64;
+  options.lock_free = state.range(0);
+  BenchmarkWriteRead(state, std::move(options));
+}
+BENCHMARK(BM_QueueWriteReadBounded)->Arg(0)->Arg(1)->UseRealTime();
+
+// Same with messages recycled by the queue's message pool.
+void BM_QueueWriteReadPooled(benchmark::State &state) {
+  Queue::Options options;
+  options.message_pool_blocks = 64;
+  BenchmarkWriteRead(state, std::move(options));
+}
+BENCHMARK(BM_QueueWriteReadPooled)->UseRealTime();
+
+}  // namespace
+}  // namespace shortfin::local
@@ -6,6 +6,15 @@
 
 #include "shortfin/local/program.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <optional>
+
 #include "fmt/core.h"
 #include "fmt/std.h"
 #include "fmt/xchar.h"
@@ -16,6 +25,7 @@
 #include "shortfin/local/fiber.h"
 #include "shortfin/local/system.h"
 #include "shortfin/support/logging.h"
+#include "shortfin/support/sysconfig.h"
 
 namespace shortfin::local {
 
@@ -30,6 +40,16 @@ void GetVmModuleExports(iree_vm_module_t *vm_module,
     exports.emplace_back(to_string_view(iree_vm_function_name(&f)));
   }
 }
+
+// Buffer of a buffer or buffer view ref (or null).
+iree_hal_buffer_t *GetRefBuffer(iree_vm_ref_t *ref) {
+  if (ref->type == iree_hal_buffer_type()) {
+    return iree_hal_buffer_deref(*ref);
+  } else if (ref->type == iree_hal_buffer_view_type()) {
+    return iree_hal_buffer_view_buffer(iree_hal_buffer_view_deref(*ref));
+  }
+  return nullptr;
+}
 }  // namespace
 
 // -------------------------------------------------------------------------- //
@@ -39,13 +59,15 @@ void GetVmModuleExports(iree_vm_module_t *vm_module,
 ProgramFunction::ProgramFunction(
     iree::vm_context_ptr vm_context, iree_vm_function_t vm_function,
     ProgramIsolation isolation,
+    std::shared_ptr<ProgramInvocationProfile> profile,
     std::optional<ProgramInvocationModel> invocation_model)
     : vm_context_(std::move(vm_context)),
       vm_function_(vm_function),
       isolation_(isolation),
       invocation_model_(invocation_model
                             ? *invocation_model
-                            : GetInvocationModelFromFunction(vm_function)) {}
+                            : GetInvocationModelFromFunction(vm_function)),
+      profile_(std::move(profile)) {}
 
 ProgramInvocationModel ProgramFunction::GetInvocationModelFromFunction(
     iree_vm_function_t &f) {
@@ -81,14 +103,16 @@ ProgramInvocation::Ptr ProgramFunction::CreateInvocation(
   // Low-overhead NONE isolation handling (saves some ref-count twiddling).
   if (actual_isolation == ProgramIsolation::NONE) {
     return ProgramInvocation::New(std::move(fiber), vm_context_, vm_function_,
-                                  invocation_model_, /*isolate=*/nullptr);
+                                  invocation_model_, /*isolate=*/nullptr,
+                                  vm_context_, actual_isolation, profile_);
   }
 
   // Create an isolated invocation.
   auto [isolated_context, isolate] = detail::ProgramIsolate::AcquireIsolate(
       *fiber, vm_context_, actual_isolation);
   return ProgramInvocation::New(std::move(fiber), std::move(isolated_context),
-                                vm_function_, invocation_model_, isolate);
+                                vm_function_, invocation_model_, isolate,
+                                vm_context_, actual_isolation, profile_);
 }
 
 std::string ProgramFunction::to_s() const {
@@ -104,6 +128,7 @@ ProgramModule ProgramModule::Load(System &system,
                                   const std::filesystem::path &path,
                                   bool mmap) {
   SHORTFIN_TRACE_SCOPE_NAMED("ProgramModule::Load");
+  iree_time_t start_ns = iree_time_now();
   iree::file_contents_ptr contents;
   if (mmap) {
     SHORTFIN_THROW_IF_ERROR(iree_io_file_contents_map(
@@ -125,7 +150,78 @@ ProgramModule ProgramModule::Load(System &system,
       system.vm_instance(), contents.const_buffer(), contents.deallocator(),
       system.host_allocator(), module.for_output()));
   contents.release();  // Must be invoked on success path only.
-  return ProgramModule(system.shared_from_this(), std::move(module));
+  ProgramModule program_module(system.shared_from_this(), std::move(module));
+  program_module.load_duration_ns_ = iree_time_now() - start_ns;
+  logging::debug("Loaded module '{}' from {} in {:.1f}ms",
+                 program_module.name(), path.string(),
+                 program_module.load_duration_ns_ / 1e6);
+  return program_module;
+}
+
+std::vector<ProgramModule> ProgramModule::LoadAll(
+    System &system, std::span<const std::filesystem::path> paths, bool mmap) {
+  SHORTFIN_TRACE_SCOPE_NAMED("ProgramModule::LoadAll");
+  // Shared with the executor tasks, which may outlive this call if they only
+  // start once every path has been claimed.
+  struct State {
+    State(System &system, std::span<const std::filesystem::path> paths,
+          bool mmap)
+        : system(system),
+          paths(paths.begin(), paths.end()),
+          mmap(mmap),
+          modules(paths.size()),
+          failures(paths.size()),
+          remaining(paths.size()) {}
+
+    // Loads unclaimed paths until there are none left.
+    void Work() {
+      for (;;) {
+        size_t i = next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= paths.size()) return;
+        try {
+          modules[i].emplace(Load(system, paths[i], mmap));
+        } catch (...) {
+          failures[i] = std::current_exception();
+        }
+        iree::slim_mutex_lock_guard g(mu);
+        if (--remaining == 0) done.set();
+      }
+    }
+
+    System &system;
+    std::vector<std::filesystem::path> paths;
+    bool mmap;
+    std::vector<std::optional<ProgramModule>> modules;
+    std::vector<std::exception_ptr> failures;
+    std::atomic<size_t> next{0};
+    iree::slim_mutex mu;
+    size_t remaining SHORTFIN_GUARDED_BY(mu);
+    iree::event done{false};
+  };
+  if (paths.empty()) return {};
+  auto state = std::make_shared<State>(system, paths, mmap);
+
+  // The caller loads too, so one helper per remaining path suffices. If the
+  // executor is bounded and full, the caller loads what the helpers do not.
+  for (size_t i = 1; i < paths.size(); ++i) {
+    BlockingExecutor::Task task([state]() { state->Work(); });
+    if (!system.blocking_executor().TrySchedule(task)) break;
+  }
+  state->Work();
+  SHORTFIN_THROW_IF_ERROR(
+      iree_wait_source_wait_one(state->done.await(), iree_infinite_timeout()));
+
+  std::vector<ProgramModule> modules;
+  modules.reserve(paths.size());
+  iree_duration_t total_ns = 0;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (state->failures[i]) std::rethrow_exception(state->failures[i]);
+    modules.push_back(std::move(*state->modules[i]));
+    total_ns += modules.back().load_duration_ns();
+  }
+  logging::info("Loaded {} modules ({:.1f}ms of load time)", modules.size(),
+                total_ns / 1e6);
+  return modules;
 }
 
 ProgramModule ProgramModule::ParameterProvider(
@@ -238,7 +334,11 @@ Program Program::Load(std::span<const ProgramModule> modules,
       system->vm_instance(), flags, all_modules.size(), all_modules.data(),
       system->host_allocator(), context.for_output()));
 
-  return Program(std::move(context), options.isolation);
+  std::shared_ptr<ProgramInvocationProfile> profile;
+  if (options.profile_invocations) {
+    profile = std::make_shared<ProgramInvocationProfile>();
+  }
+  return Program(std::move(context), options.isolation, std::move(profile));
 }
 
 std::optional<ProgramFunction> Program::LookupFunction(std::string_view name) {
@@ -257,7 +357,7 @@ std::optional<ProgramFunction> Program::LookupFunction(std::string_view name) {
       // TODO: Torch import is not setting the coarse-fences abi.model on
       // its functions. Get it from there instead of just assuming based on
       // name.
-      return ProgramFunction(vm_context_, f, isolation_,
+      return ProgramFunction(vm_context_, f, isolation_, profile_,
                              ProgramInvocationModel::COARSE_FENCES);
     } else if (!iree_status_is_not_found(status)) {
       SHORTFIN_THROW_IF_ERROR(status);
@@ -269,7 +369,7 @@ std::optional<ProgramFunction> Program::LookupFunction(std::string_view name) {
       vm_context_, to_iree_string_view(name), &f);
   if (iree_status_is_not_found(status)) return {};
   SHORTFIN_THROW_IF_ERROR(status);
-  return ProgramFunction(vm_context_, f, isolation_);
+  return ProgramFunction(vm_context_, f, isolation_, profile_);
 }
 
 ProgramFunction Program::LookupRequiredFunction(std::string_view name) {
@@ -309,6 +409,175 @@ void Program::PrepareIsolate(Fiber &fiber) {
   }
 }
 
+void Program::PrepareIsolates(std::span<Fiber *const> fibers,
+                              size_t contexts_per_fiber) {
+  SHORTFIN_TRACE_SCOPE_NAMED("Program::PrepareIsolates");
+  if (isolation_ == ProgramIsolation::NONE) return;
+  if (isolation_ == ProgramIsolation::PER_FIBER) contexts_per_fiber = 1;
+  for (Fiber *fiber : fibers) {
+    // Hold all of the contexts at once so that each acquire past the cached
+    // ones forks a new context.
+    std::vector<std::pair<iree::vm_context_ptr, detail::ProgramIsolate *>>
+        acquired;
+    acquired.reserve(contexts_per_fiber);
+    auto release_all = [&]() {
+      for (auto &[context, isolate] : acquired) {
+        detail::ProgramIsolate::ReleaseIsolate(*fiber, std::move(context),
+                                               isolate);
+      }
+    };
+    try {
+      for (size_t i = 0; i < contexts_per_fiber; ++i) {
+        acquired.push_back(detail::ProgramIsolate::AcquireIsolate(
+            *fiber, vm_context_, isolation_));
+      }
+    } catch (...) {
+      release_all();
+      throw;
+    }
+    release_all();
+  }
+}
+
+// -------------------------------------------------------------------------- //
+// ProgramInvocationProfile
+// -------------------------------------------------------------------------- //
+
+void ProgramInvocationProfile::Record(std::string_view function_name,
+                                      const Sample &sample) {
+  SHORTFIN_TRACE_PLOT_VALUE_I64("shortfin.invoke.enqueue_ns",
+                                sample.enqueue_ns);
+  SHORTFIN_TRACE_PLOT_VALUE_I64("shortfin.invoke.execute_ns",
+                                sample.execute_ns);
+  SHORTFIN_TRACE_PLOT_VALUE_I64("shortfin.invoke.wait_ns", sample.wait_ns);
+  SHORTFIN_TRACE_PLOT_VALUE_I64("shortfin.invoke.signal_ns", sample.signal_ns);
+  iree::slim_mutex_lock_guard guard(mu_);
+  auto it = stats_.find(function_name);
+  if (it == stats_.end()) {
+    it = stats_.emplace(std::string(function_name), FunctionStats()).first;
+  }
+  FunctionStats &stats = it->second;
+  stats.count += 1;
+  if (sample.failed) stats.failed_count += 1;
+  stats.enqueue.Add(sample.enqueue_ns);
+  stats.execute.Add(sample.execute_ns);
+  stats.wait.Add(sample.wait_ns);
+  stats.signal.Add(sample.signal_ns);
+}
+
+std::vector<std::pair<std::string, ProgramInvocationProfile::FunctionStats>>
+ProgramInvocationProfile::Snapshot() {
+  iree::slim_mutex_lock_guard guard(mu_);
+  return {stats_.begin(), stats_.end()};
+}
+
+void ProgramInvocationProfile::Reset() {
+  iree::slim_mutex_lock_guard guard(mu_);
+  stats_.clear();
+}
+
+// Timestamps of one profiled invocation. It is created on the worker just
+// before the VM starts and deletes itself (recording into the profile) once
+// the invocation has completed and the waits on its wait fence and coarse
+// signal have resolved. Those all happen on the worker, so the pending count
+// needs no synchronization.
+struct detail::InvocationProfileRecord {
+  InvocationProfileRecord(std::shared_ptr<ProgramInvocationProfile> profile,
+                          std::string_view function_name, Worker &worker,
+                          iree_time_t invoke_start_ns)
+      : profile(std::move(profile)),
+        function_name(function_name),
+        worker(worker),
+        invoke_start_ns(invoke_start_ns),
+        vm_start_ns(iree_time_now()) {}
+
+  // Marks the end of VM execution and releases the reference held for it.
+  void Complete(bool ok, iree_hal_semaphore_t *signal_sem,
+                uint64_t signal_timepoint) {
+    vm_end_ns = iree_time_now();
+    failed = !ok;
+    if (ok && signal_sem) WaitForSignal(signal_sem, signal_timepoint);
+    Release();
+  }
+
+  void WaitForFence(iree_hal_fence_t *fence) {
+    iree_status_t status = iree_hal_fence_query(fence);
+    if (!iree_status_is_deferred(status)) {
+      // Resolved (or failed, which the invocation reports).
+      iree_status_ignore(status);
+      return;
+    }
+    wait_fence = iree::hal_fence_ptr::borrow_reference(fence);
+    Wait(iree_hal_fence_await(fence), &wait_resolved_ns);
+  }
+
+  void WaitForSignal(iree_hal_semaphore_t *sem, uint64_t timepoint) {
+    uint64_t value = 0;
+    iree_status_t status = iree_hal_semaphore_query(sem, &value);
+    if (!iree_status_is_ok(status) || value >= timepoint) {
+      iree_status_ignore(status);
+      return;
+    }
+    signal_sem = iree::hal_semaphore_ptr::borrow_reference(sem);
+    Wait(iree_hal_semaphore_await(sem, timepoint), &signaled_ns);
+  }
+
+ private:
+  struct PendingWait {
+    InvocationProfileRecord *record;
+    iree_time_t *resolved_ns;
+  };
+
+  void Wait(iree_wait_source_t wait_source, iree_time_t *resolved_ns) {
+    auto *pending_wait = new PendingWait{this, resolved_ns};
+    iree_status_t status = worker.WaitOneLowLevel(
+        wait_source, iree_infinite_timeout(), &OnResolved, pending_wait);
+    if (!iree_status_is_ok(status)) {
+      // Not timed: the phase reports 0.
+      iree_status_ignore(status);
+      delete pending_wait;
+      return;
+    }
+    pending += 1;
+  }
+
+  static iree_status_t OnResolved(void *user_data, iree_loop_t loop,
+                                  iree_status_t status) noexcept {
+    std::unique_ptr<PendingWait> pending_wait(
+        static_cast<PendingWait *>(user_data));
+    iree_status_ignore(status);
+    *pending_wait->resolved_ns = iree_time_now();
+    pending_wait->record->Release();
+    return iree_ok_status();
+  }
+
+  void Release() {
+    if (--pending > 0) return;
+    ProgramInvocationProfile::Sample sample;
+    sample.enqueue_ns = vm_start_ns - invoke_start_ns;
+    sample.execute_ns = vm_end_ns - vm_start_ns;
+    if (wait_resolved_ns) sample.wait_ns = wait_resolved_ns - vm_start_ns;
+    if (signaled_ns) sample.signal_ns = signaled_ns - vm_end_ns;
+    sample.failed = failed;
+    profile->Record(function_name, sample);
+    delete this;
+  }
+
+  std::shared_ptr<ProgramInvocationProfile> profile;
+  std::string function_name;
+  Worker &worker;
+  iree::hal_fence_ptr wait_fence;
+  iree::hal_semaphore_ptr signal_sem;
+  iree_time_t invoke_start_ns;
+  iree_time_t vm_start_ns;
+  iree_time_t vm_end_ns = 0;
+  iree_time_t wait_resolved_ns = 0;
+  iree_time_t signaled_ns = 0;
+  // References held by completion and by each outstanding wait.
+  int pending = 1;
+  bool failed = false;
+};
+
 // -------------------------------------------------------------------------- //
 // ProgramInvocation
 // -------------------------------------------------------------------------- //
@@ -336,7 +605,9 @@ void ProgramInvocation::Deleter::operator()(ProgramInvocation *inst) {
 
   // Release any arg resource references.
   for (iree_host_size_t i = 0; i < arg_size; ++i) {
-    if (inst->arg_resources_[i]) inst->arg_resources_[i]->Release();
+    if (inst->arg_resources_[i].resource) {
+      inst->arg_resources_[i].resource->Release();
+    }
   }
 
   // Was allocated in New as a uint8_t[] so delete it by whence it came.
@@ -360,7 +631,9 @@ void ProgramInvocation::ReleaseContext() {
 ProgramInvocation::Ptr ProgramInvocation::New(
     std::shared_ptr<Fiber> fiber, iree::vm_context_ptr vm_context,
     iree_vm_function_t &vm_function, ProgramInvocationModel invocation_model,
-    detail::ProgramIsolate *isolate) {
+    detail::ProgramIsolate *isolate, iree::vm_context_ptr root_context,
+    ProgramIsolation isolation,
+    std::shared_ptr<ProgramInvocationProfile> profile) {
   auto sig = iree_vm_function_signature(&vm_function);
   iree_host_size_t arg_count;
   iree_host_size_t result_count;
@@ -373,8 +646,7 @@ ProgramInvocation::Ptr ProgramInvocation::New(
       iree_vm_list_storage_size(&variant_type_def, arg_count);
   iree_host_size_t result_storage_size =
       iree_vm_list_storage_size(&variant_type_def, result_count);
-  iree_host_size_t arg_resource_size =
-      sizeof(detail::TimelineResource *) * arg_count;
+  iree_host_size_t arg_resource_size = sizeof(ArgResource) * arg_count;
 
   // Allocate storage for the ProgramInvocation, arg, result list and placement
   // new the ProgramInvocation into the storage area.
@@ -406,11 +678,14 @@ ProgramInvocation::Ptr ProgramInvocation::New(
   inst->fiber_ = std::move(fiber);
   inst->vm_context_ = std::move(vm_context);
   inst->isolate_ = isolate;
-  inst->state.params.function = vm_function;
-  inst->state.params.invocation_model = invocation_model;
+  inst->root_context_ = std::move(root_context);
+  inst->isolation_ = isolation;
+  inst->profile_ = std::move(profile);
+  inst->params_.function = vm_function;
+  inst->params_.invocation_model = invocation_model;
   inst->result_list_ = result_list;
-  inst->arg_resources_ = static_cast<detail::TimelineResource **>(
-      static_cast<void *>(arg_resource_ptr));
+  inst->arg_resources_ =
+      static_cast<ArgResource *>(static_cast<void *>(arg_resource_ptr));
   return inst;
 }
 
@@ -420,28 +695,157 @@ void ProgramInvocation::CheckNotScheduled() {
   }
 }
 
+void ProgramInvocation::Reset() {
+  SHORTFIN_TRACE_SCOPE_NAMED("ProgramInvocation::Reset");
+  // Ownership of an in-flight invocation is held by its completion callback,
+  // so a caller with access to it has either completed it or never scheduled
+  // it. The future is dropped at completion.
+  assert(!future_ && "Reset of an in-flight invocation");
+
+  // Clearing releases the arg refs, including any fences appended when the
+  // calling convention was finalized.
+  iree_host_size_t arg_size = iree_vm_list_size(arg_list());
+  iree_vm_list_clear(arg_list());
+  iree_vm_list_clear(result_list_);
+  for (iree_host_size_t i = 0; i < arg_size; ++i) {
+    if (arg_resources_[i].resource) {
+      arg_resources_[i].resource->Release();
+    }
+  }
+  std::memset(arg_resources_, 0, sizeof(ArgResource) * arg_size);
+
+  // The wait fence is kept: the timepoints it still holds were reached before
+  // the prior call completed and timeline semaphores are monotonic, so they
+  // are satisfied. New waits on the same semaphores replace them.
+  signal_sem_ = nullptr;
+  signal_timepoint_ = 0;
+  device_selection_ = DeviceAffinity();
+
+  if (!vm_context_) {
+    if (isolation_ == ProgramIsolation::NONE) {
+      vm_context_ = root_context_;
+      isolate_ = nullptr;
+    } else {
+      auto [isolated_context, isolate] = detail::ProgramIsolate::AcquireIsolate(
+          *fiber_, root_context_, isolation_);
+      vm_context_ = std::move(isolated_context);
+      isolate_ = isolate;
+    }
+  }
+  scheduled_ = false;
+}
+
 void ProgramInvocation::AddArg(iree::vm_opaque_ref ref,
-                               detail::TimelineResource *resource) {
+                               detail::TimelineResource *resource,
+                               detail::TimelineResourceRange range,
+                               bool write) {
   CheckNotScheduled();
   iree_host_size_t arg_index = iree_vm_list_size(arg_list());
   SHORTFIN_THROW_IF_ERROR(iree_vm_list_push_ref_move(arg_list(), &ref));
   if (resource) {
-    arg_resources_[arg_index] = resource;
+    arg_resources_[arg_index] = ArgResource{resource, range, write, false};
     resource->Retain();
   }
 }
 
 void ProgramInvocation::AddArg(iree_vm_ref_t *ref,
-                               detail::TimelineResource *resource) {
+                               detail::TimelineResource *resource,
+                               detail::TimelineResourceRange range,
+                               bool write) {
   CheckNotScheduled();
   iree_host_size_t arg_index = iree_vm_list_size(arg_list());
   SHORTFIN_THROW_IF_ERROR(iree_vm_list_push_ref_retain(arg_list(), ref));
   if (resource) {
-    arg_resources_[arg_index] = resource;
+    arg_resources_[arg_index] = ArgResource{resource, range, write, false};
     resource->Retain();
   }
 }
 
+iree_host_size_t ProgramInvocation::AddOutputArg(
+    ProgramInvocationMarshalable &output) {
+  CheckNotScheduled();
+  iree_host_size_t arg_index = iree_vm_list_size(arg_list());
+  output.AddAsInvocationArgument(this, ProgramResourceBarrier::WRITE);
+  MarkOutputArg(arg_index);
+  return arg_index;
+}
+
+void ProgramInvocation::MarkOutputArg(iree_host_size_t arg_index) {
+  CheckNotScheduled();
+  if (arg_index >= iree_vm_list_size(arg_list())) {
+    throw std::invalid_argument(
+        fmt::format("Output argument index {} out of range", arg_index));
+  }
+  iree::vm_opaque_ref ref;
+  SHORTFIN_THROW_IF_ERROR(
+      iree_vm_list_get_ref_retain(arg_list(), arg_index, &ref));
+  if (!GetRefBuffer(ref.get())) {
+    throw std::invalid_argument(
+        "Donated outputs must be buffers or buffer views");
+  }
+  arg_resources_[arg_index].output = true;
+}
+
+std::optional<iree_host_size_t> ProgramInvocation::donated_output_for_result(
+    iree_host_size_t i) {
+  iree::vm_opaque_ref result = result_ref(i);
+  if (!result) return {};
+  iree_hal_buffer_t *result_buffer = GetRefBuffer(result.get());
+  if (!result_buffer) return {};
+  // The fences appended by the calling convention are never outputs.
+  iree_host_size_t arg_count = iree_vm_list_size(arg_list());
+  for (iree_host_size_t arg_index = 0; arg_index < arg_count; ++arg_index) {
+    if (!arg_resources_[arg_index].output) continue;
+    iree::vm_opaque_ref arg;
+    SHORTFIN_THROW_IF_ERROR(
+        iree_vm_list_get_ref_retain(arg_list(), arg_index, &arg));
+    iree_hal_buffer_t *arg_buffer = GetRefBuffer(arg.get());
+    if (arg_buffer == result_buffer ||
+        (iree_hal_buffer_allocated_buffer(arg_buffer) ==
+             iree_hal_buffer_allocated_buffer(result_buffer) &&
+         iree_hal_buffer_byte_offset(arg_buffer) ==
+             iree_hal_buffer_byte_offset(result_buffer) &&
+         iree_hal_buffer_byte_length(arg_buffer) ==
+             iree_hal_buffer_byte_length(result_buffer))) {
+      return arg_index;
+    }
+  }
+  return {};
+}
+
+void ProgramInvocation::WaitAfter(ProgramInvocation &producer) {
+  CheckNotScheduled();
+  auto [signal_sem, signal_timepoint] = producer.coarse_signal();
+  if (!signal_sem) {
+    throw std::invalid_argument(
+        "Can only wait after a scheduled invocation with coarse signaling");
+  }
+  SHORTFIN_SCHED_LOG("Invocation {}: Wait after invocation {}",
+                     static_cast<void *>(this),
+                     static_cast<void *>(&producer));
+  wait_insert({.count = 1,
+               .semaphores = &signal_sem,
+               .payload_values = &signal_timepoint});
+}
+
+void ProgramInvocation::AddResultArg(ProgramInvocation &producer,
+                                     iree_host_size_t i) {
+  CheckNotScheduled();
+  if (i >= producer.results_size()) {
+    throw std::invalid_argument(
+        fmt::format("Result index {} out of range ({} results)", i,
+                    producer.results_size()));
+  }
+  iree::vm_opaque_ref ref = producer.result_ref(i);
+  if (!ref) {
+    throw std::invalid_argument(
+        fmt::format("Result {} is not a reference and cannot be forwarded", i));
+  }
+  WaitAfter(producer);
+  DeviceSelect(producer.device_selection());
+  AddArg(std::move(ref), /*resource=*/nullptr);
+}
+
 iree_status_t ProgramInvocation::FinalizeCallingConvention(
     iree_vm_list_t *arg_list, iree_vm_function_t &function,
     ProgramInvocationModel invocation_model) {
@@ -451,8 +855,7 @@ iree_status_t ProgramInvocation::FinalizeCallingConvention(
     iree_hal_fence_t *maybe_wait_fence = nullptr;
     if (device_selection_) {
       ScopedDevice scoped_device(*fiber(), device_selection_);
-      auto &sched_account =
-          fiber()->scheduler().GetDefaultAccount(scoped_device);
+      auto &sched_account = fiber()->scheduler().SelectAccount(scoped_device);
       maybe_wait_fence = this->wait_fence();
       iree_hal_semaphore_t *timeline_sem = sched_account.timeline_sem();
       uint64_t timeline_now = sched_account.timeline_idle_timepoint();
@@ -467,8 +870,13 @@ iree_status_t ProgramInvocation::FinalizeCallingConvention(
       // Extend any arg resources to our signal timepoint.
       iree_host_size_t arg_count = iree_vm_list_size(arg_list);
       for (iree_host_size_t i = 0; i < arg_count; ++i) {
-        detail::TimelineResource *resource = arg_resources_[i];
-        if (resource) {
+        ArgResource &arg_resource = arg_resources_[i];
+        detail::TimelineResource *resource = arg_resource.resource;
+        if (!resource) continue;
+        if (resource->range_tracking()) {
+          resource->range_insert(arg_resource.range, arg_resource.write,
+                                 signal_sem_, signal_timepoint_);
+        } else {
           resource->use_barrier_insert(signal_sem_, signal_timepoint_);
         }
       }
@@ -506,11 +914,12 @@ ProgramInvocation::Future ProgramInvocation::Invoke(
     ProgramInvocation::Ptr invocation) {
   SHORTFIN_TRACE_SCOPE_NAMED("ProgramInvocation::Invoke");
   invocation->CheckNotScheduled();
+  if (invocation->profile_) invocation->invoke_start_ns_ = iree_time_now();
 
   Worker &worker = invocation->fiber_->worker();
-  // We're about to overwrite the instance level storage for params, so move
-  // it to the stack and access there.
-  Params params = invocation->state.params;
+  // Copy the params to the stack since the invocation is released to the
+  // schedule callback.
+  Params params = invocation->params_;
 
   auto schedule = [](ProgramInvocation *raw_invocation, Worker *worker,
                      iree_vm_function_t function,
@@ -533,6 +942,11 @@ ProgramInvocation::Future ProgramInvocation::Invoke(
       ProgramInvocation::Ptr invocation(
           static_cast<ProgramInvocation *>(user_data));
       ProgramInvocation *raw_invocation = invocation.get();
+      if (raw_invocation->profile_record_) {
+        std::exchange(raw_invocation->profile_record_, nullptr)
+            ->Complete(iree_status_is_ok(status), raw_invocation->signal_sem_,
+                       raw_invocation->signal_timepoint_);
+      }
       raw_invocation->ReleaseContext();
       if (iree_status_is_ok(status)) {
         raw_invocation->future_->set_result(std::move(invocation));
@@ -560,9 +974,19 @@ ProgramInvocation::Future ProgramInvocation::Invoke(
       status = invocation->FinalizeCallingConvention(
           invocation->arg_list(), function, invocation_model);
     }
+    if (iree_status_is_ok(status) && invocation->profile_) {
+      invocation->profile_record_ = new detail::InvocationProfileRecord(
+          invocation->profile_,
+          to_string_view(iree_vm_function_name(&function)), *worker,
+          invocation->invoke_start_ns_);
+      if (invocation->wait_fence_) {
+        invocation->profile_record_->WaitForFence(
+            invocation->wait_fence_.get());
+      }
+    }
     if (iree_status_is_ok(status)) {
       status = iree_vm_async_invoke(worker->loop(),
-                                    &invocation->state.async_invoke_state,
+                                    &invocation->async_invoke_state_,
                                     invocation->vm_context_.get(), function,
                                     /*flags=*/IREE_VM_INVOCATION_FLAG_NONE,
                                     /*policy=*/nullptr,
@@ -578,7 +1002,13 @@ ProgramInvocation::Future ProgramInvocation::Invoke(
     // async invocation may have finished already.
     if (iree_status_is_ok(status)) {
       invocation.release();
-    } else if (failure_future) {
+      return;
+    }
+    if (invocation->profile_record_) {
+      std::exchange(invocation->profile_record_, nullptr)
+          ->Complete(/*ok=*/false, nullptr, 0);
+    }
+    if (failure_future) {
       // Requested to set any failure on the future.
       invocation->ReleaseContext();
       failure_future->set_failure(status);
@@ -609,6 +1039,10 @@ ProgramInvocation::Future ProgramInvocation::Invoke(
   return fork_future;
 }
 
+iree_host_size_t ProgramInvocation::args_size() {
+  return iree_vm_list_size(arg_list());
+}
+
 iree_host_size_t ProgramInvocation::results_size() {
   return iree_vm_list_size(result_list_);
 }
@@ -666,7 +1100,8 @@ BaseProgramParameters::~BaseProgramParameters() = default;
 StaticProgramParameters::StaticProgramParameters(
     System &system, std::string_view parameter_scope,
     iree_host_size_t max_concurrent_operations)
-    : host_allocator_(system.host_allocator()) {
+    : system_(system.shared_from_this()),
+      host_allocator_(system.host_allocator()) {
   SHORTFIN_THROW_IF_ERROR(
       iree_io_parameter_index_create(host_allocator_, index_.for_output()));
   SHORTFIN_THROW_IF_ERROR(iree_io_parameter_index_provider_create(
@@ -682,6 +1117,10 @@ void StaticProgramParameters::Load(std::filesystem::path file_path,
     options.format = file_path.extension().string();
   }
 
+  if (options.direct_io) {
+    this->LoadDirect(file_path, options);
+    return;
+  }
   if (options.mmap) {
     this->LoadMmap(file_path, options);
     return;
@@ -693,11 +1132,15 @@ void StaticProgramParameters::Load(std::filesystem::path file_path,
   iree_io_file_handle_t *file_handle = NULL;
   SHORTFIN_THROW_IF_ERROR(iree_io_file_handle_open(
       IREE_IO_FILE_MODE_READ, path, host_allocator_, &file_handle));
+  if (options.lazy) {
+    auto primitive = iree_io_file_handle_primitive(file_handle);
+    if (primitive.type == IREE_IO_FILE_HANDLE_TYPE_FD) {
+      sysconfig::AdviseFile(primitive.value.fd, 0, 0,
+                            sysconfig::AccessHint::kRandom);
+    }
+  }
 
-  // Parse.
-  SHORTFIN_THROW_IF_ERROR(
-      iree_io_parse_file_index(to_iree_string_view(options.format), file_handle,
-                               index_.get(), host_allocator_));
+  ParseIndex(file_path, file_handle, options);
 }
 
 void StaticProgramParameters::LoadMmap(std::filesystem::path file_path,
@@ -718,6 +1161,19 @@ void StaticProgramParameters::LoadMmap(std::filesystem::path file_path,
       file_contents,
   };
 
+  if (options.lazy) {
+    sysconfig::AdviseMemory(file_contents->buffer.data,
+                            file_contents->buffer.data_length,
+                            sysconfig::AccessHint::kRandom);
+  }
+  // Page cache backed mappings can only use transparent huge pages (which
+  // needs file THP support in the kernel).
+  if (options.huge_pages != sysconfig::HugePages::kNone) {
+    sysconfig::AdviseMemory(file_contents->buffer.data,
+                            file_contents->buffer.data_length,
+                            sysconfig::AccessHint::kHugePages);
+  }
+
   // Wrap contents.
   iree::io_file_handle_ptr file_handle;
   iree_status_t status = iree_io_file_handle_wrap_host_allocation(
@@ -728,10 +1184,570 @@ void StaticProgramParameters::LoadMmap(std::filesystem::path file_path,
     SHORTFIN_THROW_IF_ERROR(status);
   }
 
-  // Parse.
+  ParseIndex(file_path, file_handle.get(), options);
+}
+
+void StaticProgramParameters::LoadDirect(std::filesystem::path file_path,
+                                         LoadOptions options) {
+  SHORTFIN_TRACE_SCOPE_NAMED("StaticProgramParameters::LoadDirect");
+  constexpr size_t kAlignment = sysconfig::kDirectReadAlignment;
+  if (options.direct_io_chunk_size == 0 ||
+      options.direct_io_chunk_size % kAlignment != 0) {
+    throw std::invalid_argument(
+        fmt::format("direct_io_chunk_size must be a non-zero multiple of {}",
+                    kAlignment));
+  }
+  if (options.direct_io_queue_depth < 1) {
+    throw std::invalid_argument("direct_io_queue_depth must be >= 1");
+  }
+
+  auto file_path_string = file_path.string();
+  bool direct = false;
+  int fd = sysconfig::OpenFileForDirectRead(file_path_string.c_str(), direct);
+  if (fd < 0) {
+    throw std::invalid_argument(fmt::format(
+        "Could not open parameter file {} for direct reads", file_path_string));
+  }
+  int64_t file_size = sysconfig::GetFileSize(fd);
+  if (file_size < 0) {
+    sysconfig::CloseFile(fd);
+    throw std::runtime_error(
+        fmt::format("Could not stat parameter file {}", file_path_string));
+  }
+
+  // Direct reads land in place, so the destination must be aligned and
+  // extend to a whole number of aligned blocks.
+  size_t alloc_size =
+      std::max<size_t>(kAlignment, (file_size + kAlignment - 1) &
+                                       ~static_cast<size_t>(kAlignment - 1));
+  // Explicit huge pages are aligned beyond kAlignment. Transparent huge pages
+  // (or the fallback when none are free) must be advised before the reads
+  // populate the memory.
+  sysconfig::HugePages huge_pages = sysconfig::HugePages::kNone;
+  uint8_t *data = nullptr;
+  if (sysconfig::GetHugePageSize(options.huge_pages)) {
+    data = static_cast<uint8_t *>(
+        sysconfig::MapHugePageMemory(alloc_size, options.huge_pages));
+    if (data) {
+      huge_pages = options.huge_pages;
+    } else {
+      logging::warn(
+          "No free {} huge pages for parameters from {}: Using transparent "
+          "huge pages",
+          sysconfig::to_string_view(options.huge_pages), file_path_string);
+    }
+  }
+  if (!data) {
+    data = static_cast<uint8_t *>(std::aligned_alloc(kAlignment, alloc_size));
+    if (!data) {
+      sysconfig::CloseFile(fd);
+      throw std::bad_alloc();
+    }
+    if (options.huge_pages != sysconfig::HugePages::kNone) {
+      sysconfig::AdviseMemory(data, alloc_size,
+                              sysconfig::AccessHint::kHugePages);
+    }
+  }
+  struct Contents {
+    uint8_t *data;
+    size_t size;
+    sysconfig::HugePages huge_pages;
+    ~Contents() {
+      if (huge_pages != sysconfig::HugePages::kNone) {
+        sysconfig::UnmapHugePageMemory(data, size, huge_pages);
+      } else {
+        std::free(data);
+      }
+    }
+  };
+  auto contents = std::make_unique<Contents>(
+      Contents{data, alloc_size, huge_pages});
+
+  // Chunks are claimed by the calling thread and up to queue_depth - 1
+  // executor tasks, which keeps that many reads in flight.
+  struct State {
+    int fd;
+    uint8_t *data;
+    uint64_t file_size;
+    size_t chunk_size;
+    size_t chunk_count;
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<bool> failed{false};
+    iree::slim_mutex mu;
+    size_t remaining SHORTFIN_GUARDED_BY(mu);
+    iree::event done{false};
+
+    void Work() {
+      for (;;) {
+        size_t i = next_chunk.fetch_add(1, std::memory_order_relaxed);
+        if (i >= chunk_count) return;
+        uint64_t offset = static_cast<uint64_t>(i) * chunk_size;
+        if (!failed.load(std::memory_order_relaxed)) {
+          uint64_t expected =
+              std::min<uint64_t>(chunk_size, file_size - offset);
+          // Read whole aligned blocks: the last is short at end of file.
+          uint64_t length = (expected + sysconfig::kDirectReadAlignment - 1) &
+                            ~(sysconfig::kDirectReadAlignment - 1);
+          int64_t n = sysconfig::ReadFileAt(fd, data + offset, length, offset);
+          if (n < 0 || static_cast<uint64_t>(n) < expected) {
+            failed.store(true, std::memory_order_relaxed);
+          }
+        }
+        iree::slim_mutex_lock_guard g(mu);
+        if (--remaining == 0) done.set();
+      }
+    }
+  };
+  auto state = std::make_shared<State>();
+  state->fd = fd;
+  state->data = data;
+  state->file_size = file_size;
+  state->chunk_size = options.direct_io_chunk_size;
+  state->chunk_count = (file_size + options.direct_io_chunk_size - 1) /
+                       options.direct_io_chunk_size;
+  {
+    iree::slim_mutex_lock_guard g(state->mu);
+    state->remaining = state->chunk_count;
+  }
+  iree_time_t start_ns = iree_time_now();
+  if (state->chunk_count > 0) {
+    size_t helpers = std::min<size_t>(options.direct_io_queue_depth - 1,
+                                      state->chunk_count - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+      BlockingExecutor::Task task([state]() { state->Work(); });
+      if (!system_->blocking_executor().TrySchedule(task)) break;
+    }
+    state->Work();
+    SHORTFIN_THROW_IF_ERROR(iree_wait_source_wait_one(
+        state->done.await(), iree_infinite_timeout()));
+  }
+  // Late helpers only claim past the end, so the fd is no longer read.
+  sysconfig::CloseFile(fd);
+  if (state->failed.load()) {
+    throw std::runtime_error(
+        fmt::format("Failed reading parameter file {}", file_path_string));
+  }
+  iree_duration_t read_ns = iree_time_now() - start_ns;
+  logging::info(
+      "Read {} bytes of parameters from {} in {:.1f}ms ({}{:.2f}GB/s)",
+      file_size, file_path_string, read_ns / 1e6, direct ? "direct, " : "",
+      read_ns > 0 ? file_size / (read_ns / 1e9) / 1e9 : 0.0);
+
+  iree_io_file_handle_release_callback_t release_callback = {
+      +[](void *user_data, iree_io_file_handle_primitive_t handle_primitive) {
+        delete static_cast<Contents *>(user_data);
+      },
+      contents.get(),
+  };
+  iree::io_file_handle_ptr file_handle;
+  SHORTFIN_THROW_IF_ERROR(iree_io_file_handle_wrap_host_allocation(
+      IREE_IO_FILE_ACCESS_READ,
+      iree_make_byte_span(data, static_cast<iree_host_size_t>(file_size)),
+      release_callback, host_allocator_, file_handle.for_output()));
+  contents.release();
+
+  ParseIndex(file_path, file_handle.get(), options);
+}
+
+namespace {
+
+// Whether a parameter key belongs to a shard: sharded parameters are named
+// "<name>.shard.<index>", all others are replicated to every shard.
+bool IsKeyInShard(std::string_view key, int shard_index) {
+  constexpr std::string_view kShardInfix = ".shard.";
+  size_t pos = key.rfind(kShardInfix);
+  if (pos == std::string_view::npos) return true;
+  std::string_view index_sv = key.substr(pos + kShardInfix.size());
+  if (index_sv.empty() ||
+      !std::all_of(index_sv.begin(), index_sv.end(),
+                   [](char c) { return c >= '0' && c <= '9'; })) {
+    return true;
+  }
+  return index_sv == std::to_string(shard_index);
+}
+
+// Identifies the contents of a parameter file that an index cache was made
+// from.
+struct IndexCacheKey {
+  uint64_t file_size = 0;
+  int64_t mtime_ns = 0;
+  uint64_t header_hash = 0;
+  std::string format;
+};
+
+// A file backed index entry, as stored in the cache. Splat entries keep their
+// pattern instead of an offset.
+struct CachedIndexEntry {
+  std::string key;
+  std::string metadata;
+  uint64_t length = 0;
+  iree_io_parameter_index_entry_storage_type_t type =
+      IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE;
+  uint64_t offset = 0;
+  uint8_t pattern_length = 0;
+  uint8_t pattern[16] = {0};
+};
+
+constexpr char kIndexCacheMagic[8] = {'S', 'F', 'P', 'I', 'D', 'X', 0, 0};
+constexpr uint32_t kIndexCacheVersion = 1;
+// Amount of the file (from the start, where all supported formats keep
+// their headers) that is hashed into the key.
+constexpr size_t kIndexCacheHashedBytes = 64 * 1024;
+
+std::optional<IndexCacheKey> ComputeIndexCacheKey(
+    const std::filesystem::path &file_path, std::string_view format) {
+  std::error_code ec;
+  IndexCacheKey key;
+  key.file_size = std::filesystem::file_size(file_path, ec);
+  if (ec) return {};
+  auto mtime = std::filesystem::last_write_time(file_path, ec);
+  if (ec) return {};
+  key.mtime_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     mtime.time_since_epoch())
+                     .count();
+  key.format = format;
+
+  std::ifstream in(file_path, std::ios::binary);
+  if (!in) return {};
+  std::string header(std::min<uint64_t>(key.file_size, kIndexCacheHashedBytes),
+                     '\0');
+  if (!in.read(header.data(), header.size())) return {};
+  // FNV-1a.
+  uint64_t hash = 14695981039346656037ull;
+  for (unsigned char c : header) {
+    hash = (hash ^ c) * 1099511628211ull;
+  }
+  key.header_hash = hash;
+  return key;
+}
+
+template <typename T>
+void AppendPod(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void AppendBytes(std::string &out, std::string_view bytes) {
+  AppendPod(out, static_cast<uint32_t>(bytes.size()));
+  out.append(bytes);
+}
+
+// Reads fields from a cache file in memory, failing (rather than reading out
+// of bounds) on truncated or corrupt contents.
+class IndexCacheReader {
+ public:
+  explicit IndexCacheReader(std::string_view contents) : contents_(contents) {}
+
+  template <typename T>
+  bool ReadPod(T &value) {
+    if (contents_.size() < sizeof(value)) return false;
+    std::memcpy(&value, contents_.data(), sizeof(value));
+    contents_.remove_prefix(sizeof(value));
+    return true;
+  }
+
+  bool ReadBytes(std::string &value) {
+    uint32_t size;
+    if (!ReadPod(size) || contents_.size() < size) return false;
+    value.assign(contents_.data(), size);
+    contents_.remove_prefix(size);
+    return true;
+  }
+
+  bool at_end() const { return contents_.empty(); }
+
+ private:
+  std::string_view contents_;
+};
+
+std::optional<std::vector<CachedIndexEntry>> ReadIndexCache(
+    const std::filesystem::path &cache_path, const IndexCacheKey &key) {
+  std::ifstream in(cache_path, std::ios::binary);
+  if (!in) return {};
+  std::string contents((std::istreambuf_iterator<char>(in)),
+                       std::istreambuf_iterator<char>());
+  IndexCacheReader reader(contents);
+
+  char magic[sizeof(kIndexCacheMagic)];
+  uint32_t version;
+  IndexCacheKey cached_key;
+  uint32_t entry_count;
+  if (!reader.ReadPod(magic) ||
+      std::memcmp(magic, kIndexCacheMagic, sizeof(magic)) != 0 ||
+      !reader.ReadPod(version) || version != kIndexCacheVersion ||
+      !reader.ReadPod(cached_key.file_size) ||
+      !reader.ReadPod(cached_key.mtime_ns) ||
+      !reader.ReadPod(cached_key.header_hash) ||
+      !reader.ReadBytes(cached_key.format) || !reader.ReadPod(entry_count)) {
+    return {};
+  }
+  if (cached_key.file_size != key.file_size ||
+      cached_key.mtime_ns != key.mtime_ns ||
+      cached_key.header_hash != key.header_hash ||
+      cached_key.format != key.format) {
+    return {};
+  }
+
+  std::vector<CachedIndexEntry> entries(entry_count);
+  for (CachedIndexEntry &entry : entries) {
+    uint32_t type;
+    if (!reader.ReadBytes(entry.key) || !reader.ReadBytes(entry.metadata) ||
+        !reader.ReadPod(entry.length) || !reader.ReadPod(type) ||
+        !reader.ReadPod(entry.offset) ||
+        !reader.ReadPod(entry.pattern_length) ||
+        !reader.ReadPod(entry.pattern) ||
+        entry.pattern_length > sizeof(entry.pattern)) {
+      return {};
+    }
+    entry.type =
+        static_cast<iree_io_parameter_index_entry_storage_type_t>(type);
+    if (entry.type != IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE &&
+        entry.type != IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_SPLAT) {
+      return {};
+    }
+    if (entry.type == IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE &&
+        (entry.offset > key.file_size ||
+         entry.length > key.file_size - entry.offset)) {
+      return {};
+    }
+  }
+  if (!reader.at_end()) return {};
+  return entries;
+}
+
+// Writes the cache next to its final path and renames it into place, so
+// that concurrent loads never see a partial cache.
+bool WriteIndexCache(const std::filesystem::path &cache_path,
+                     const IndexCacheKey &key,
+                     iree_io_parameter_index_t *index) {
+  std::string contents;
+  contents.append(kIndexCacheMagic, sizeof(kIndexCacheMagic));
+  AppendPod(contents, kIndexCacheVersion);
+  AppendPod(contents, key.file_size);
+  AppendPod(contents, key.mtime_ns);
+  AppendPod(contents, key.header_hash);
+  AppendBytes(contents, key.format);
+  iree_host_size_t count = iree_io_parameter_index_count(index);
+  AppendPod(contents, static_cast<uint32_t>(count));
+  for (iree_host_size_t i = 0; i < count; ++i) {
+    const iree_io_parameter_index_entry_t *entry = nullptr;
+    iree_status_t status = iree_io_parameter_index_get(index, i, &entry);
+    if (!iree_status_is_ok(status)) {
+      iree_status_ignore(status);
+      return false;
+    }
+    AppendBytes(contents, to_string_view(entry->key));
+    AppendBytes(contents,
+                std::string_view(
+                    reinterpret_cast<const char *>(entry->metadata.data),
+                    entry->metadata.data_length));
+    AppendPod(contents, entry->length);
+    AppendPod(contents, static_cast<uint32_t>(entry->type));
+    uint64_t offset = 0;
+    uint8_t pattern_length = 0;
+    uint8_t pattern[16] = {0};
+    if (entry->type == IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE) {
+      offset = entry->storage.file.offset;
+    } else {
+      pattern_length = entry->storage.splat.pattern_length;
+      std::memcpy(pattern, entry->storage.splat.pattern, sizeof(pattern));
+    }
+    AppendPod(contents, offset);
+    AppendPod(contents, pattern_length);
+    AppendPod(contents, pattern);
+  }
+
+  auto temp_path = cache_path;
+  temp_path += fmt::format(".tmp{}", iree_time_now());
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out || !out.write(contents.data(), contents.size()) || !out.flush()) {
+      std::error_code ec;
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, cache_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+void StaticProgramParameters::ParseIndex(
+    const std::filesystem::path &file_path, iree_io_file_handle_t *file_handle,
+    const LoadOptions &options) {
+  const bool use_cache = !options.index_cache_path.empty();
+  if (!use_cache && options.shard_index < 0) {
+    SHORTFIN_THROW_IF_ERROR(iree_io_parse_file_index(
+        to_iree_string_view(options.format), file_handle, index_.get(),
+        host_allocator_));
+    return;
+  }
+
+  iree_host_size_t count = 0;
+  iree_host_size_t kept = 0;
+  auto add_entry = [&](const iree_io_parameter_index_entry_t &entry) {
+    ++count;
+    if (options.shard_index >= 0 &&
+        !IsKeyInShard(to_string_view(entry.key), options.shard_index)) {
+      return;
+    }
+    SHORTFIN_THROW_IF_ERROR(iree_io_parameter_index_add(index_.get(), &entry));
+    ++kept;
+  };
+
+  std::optional<IndexCacheKey> cache_key;
+  if (use_cache) {
+    cache_key = ComputeIndexCacheKey(file_path, options.format);
+    std::optional<std::vector<CachedIndexEntry>> cached;
+    if (cache_key) {
+      cached = ReadIndexCache(options.index_cache_path, *cache_key);
+    }
+    if (cached) {
+      for (const CachedIndexEntry &cached_entry : *cached) {
+        iree_io_parameter_index_entry_t entry = {};
+        entry.key = to_iree_string_view(cached_entry.key);
+        entry.metadata = iree_make_const_byte_span(
+            cached_entry.metadata.data(), cached_entry.metadata.size());
+        entry.length = cached_entry.length;
+        entry.type = cached_entry.type;
+        if (entry.type == IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE) {
+          entry.storage.file.handle = file_handle;
+          entry.storage.file.offset = cached_entry.offset;
+        } else {
+          entry.storage.splat.pattern_length = cached_entry.pattern_length;
+          std::memcpy(entry.storage.splat.pattern, cached_entry.pattern,
+                      sizeof(cached_entry.pattern));
+        }
+        add_entry(entry);
+      }
+      logging::debug("Loaded {} of {} parameters of {} from index cache {}",
+                     kept, count, file_path.string(),
+                     options.index_cache_path.string());
+      return;
+    }
+  }
+
+  // Parse into a scratch index and keep the selected entries. The entries
+  // retain the file handle, so the scratch index can go.
+  iree::io_parameter_index_ptr file_index;
+  SHORTFIN_THROW_IF_ERROR(
+      iree_io_parameter_index_create(host_allocator_, file_index.for_output()));
   SHORTFIN_THROW_IF_ERROR(iree_io_parse_file_index(
-      to_iree_string_view(options.format), file_handle.get(), index_.get(),
+      to_iree_string_view(options.format), file_handle, file_index.get(),
       host_allocator_));
+  if (cache_key && !WriteIndexCache(options.index_cache_path, *cache_key,
+                                    file_index.get())) {
+    logging::warn("Could not write parameter index cache {}",
+                  options.index_cache_path.string());
+  }
+  iree_host_size_t file_count = iree_io_parameter_index_count(file_index.get());
+  for (iree_host_size_t i = 0; i < file_count; ++i) {
+    const iree_io_parameter_index_entry_t *entry = nullptr;
+    SHORTFIN_THROW_IF_ERROR(
+        iree_io_parameter_index_get(file_index.get(), i, &entry));
+    add_entry(*entry);
+  }
+  if (options.shard_index >= 0) {
+    logging::debug("Loaded {} of {} parameters for shard {}", kept, count,
+                   options.shard_index);
+  }
+}
+
+uint64_t StaticProgramParameters::Prefetch(
+    std::span<const std::string_view> names) {
+  SHORTFIN_TRACE_SCOPE_NAMED("StaticProgramParameters::Prefetch");
+  uint64_t hinted = 0;
+  for (std::string_view name : names) {
+    const iree_io_parameter_index_entry_t *entry = nullptr;
+    iree_status_t status = iree_io_parameter_index_lookup(
+        index_.get(), to_iree_string_view(name), &entry);
+    if (iree_status_is_not_found(status)) {
+      iree_status_ignore(status);
+      throw std::invalid_argument(
+          fmt::format("Cannot prefetch unknown parameter '{}'", name));
+    }
+    SHORTFIN_THROW_IF_ERROR(status);
+    // Splats have no storage.
+    if (entry->type != IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE) {
+      continue;
+    }
+    auto primitive = iree_io_file_handle_primitive(entry->storage.file.handle);
+    bool advised = false;
+    if (primitive.type == IREE_IO_FILE_HANDLE_TYPE_HOST_ALLOCATION) {
+      advised = sysconfig::AdviseMemory(
+          primitive.value.host_allocation.data + entry->storage.file.offset,
+          entry->length, sysconfig::AccessHint::kWillNeed);
+    } else if (primitive.type == IREE_IO_FILE_HANDLE_TYPE_FD) {
+      advised = sysconfig::AdviseFile(
+          primitive.value.fd, entry->storage.file.offset, entry->length,
+          sysconfig::AccessHint::kWillNeed);
+    }
+    if (advised) hinted += entry->length;
+  }
+  return hinted;
+}
+
+// -------------------------------------------------------------------------- //
+// ShardedProgramParameters
+// -------------------------------------------------------------------------- //
+
+ShardedProgramParameters::ShardedProgramParameters(
+    System &system, std::string_view parameter_scope,
+    std::vector<Device *> devices, iree_host_size_t max_concurrent_operations)
+    : devices_(std::move(devices)) {
+  if (devices_.empty()) {
+    throw std::invalid_argument(
+        "ShardedProgramParameters requires at least one device");
+  }
+  shards_.reserve(devices_.size());
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    shards_.push_back(std::make_unique<StaticProgramParameters>(
+        system, parameter_scope, max_concurrent_operations));
+  }
+}
+
+void ShardedProgramParameters::Load(
+    std::filesystem::path file_path,
+    StaticProgramParameters::LoadOptions options) {
+  SHORTFIN_TRACE_SCOPE_NAMED("ShardedProgramParameters::Load");
+  if (options.direct_io) {
+    throw std::invalid_argument(
+        "direct_io is not supported when sharding a single parameter file: "
+        "load per-shard files with LoadShard instead");
+  }
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    options.shard_index = static_cast<int>(i);
+    shards_[i]->Load(file_path, options);
+  }
+}
+
+void ShardedProgramParameters::LoadShard(
+    size_t shard_index, std::filesystem::path file_path,
+    StaticProgramParameters::LoadOptions options) {
+  shard(shard_index).Load(std::move(file_path), std::move(options));
+}
+
+StaticProgramParameters &ShardedProgramParameters::shard(size_t shard_index) {
+  if (shard_index >= shards_.size()) {
+    throw std::out_of_range(fmt::format(
+        "Shard index {} out of range ({} shards)", shard_index,
+        shards_.size()));
+  }
+  return *shards_[shard_index];
+}
+
+StaticProgramParameters &ShardedProgramParameters::for_device(
+    Device *device) {
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    if (devices_[i] == device) return *shards_[i];
+  }
+  throw std::invalid_argument(fmt::format(
+      "Device {} has no parameter shard", device ? device->to_s() : "null"));
 }
 
 // -------------------------------------------------------------------------- //
@@ -745,6 +1761,9 @@ CoarseInvocationTimelineImporter::CoarseInvocationTimelineImporter(
   auto buffer_type = iree_hal_buffer_type();
   auto buffer_view_type = iree_hal_buffer_view_type();
   for (iree_host_size_t i = 0; i < inv->results_size(); ++i) {
+    // Donated outputs belong to (and keep the timeline of) the caller's
+    // object, so must not be set up for deallocation here.
+    if (inv->donated_output_for_result(i)) continue;
     auto ref = inv->result_ref(i);
     auto type = ref.get()->type;
     if (type == buffer_type) {
@@ -925,9 +1944,19 @@ detail::ProgramIsolate::AcquireIsolate(Fiber &fiber,
   }
 
   // Slow-path: fork needed (and possibly new isolate registration needed).
+  SHORTFIN_TRACE_SCOPE_NAMED("ProgramIsolate::Fork");
+  iree_time_t start_ns = iree_time_now();
   iree::vm_context_ptr new_context;
   SHORTFIN_THROW_IF_ERROR(iree_vm_context_fork(
       root_context.get(), fiber.host_allocator(), new_context.for_output()));
+  iree_duration_t fork_ns = iree_time_now() - start_ns;
+  {
+    iree::slim_mutex_lock_guard lock(fiber.program_isolate_mu_);
+    auto &stats = fiber.isolate_stats_;
+    stats.fork_count += 1;
+    stats.total_fork_ns += fork_ns;
+    stats.max_fork_ns = std::max(stats.max_fork_ns, fork_ns);
+  }
   return std::make_pair(std::move(new_context), isolate);
 }
 
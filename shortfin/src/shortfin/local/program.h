@@ -8,8 +8,11 @@
 #define SHORTFIN_LOCAL_PROGRAM_H
 
 #include <filesystem>
+#include <map>
+#include <memory>
 #include <optional>
 #include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -19,7 +22,9 @@
 #include "shortfin/local/scheduler.h"
 #include "shortfin/local/worker.h"
 #include "shortfin/support/api.h"
+#include "shortfin/support/iree_concurrency.h"
 #include "shortfin/support/iree_helpers.h"
+#include "shortfin/support/sysconfig.h"
 
 namespace shortfin::local {
 
@@ -28,6 +33,7 @@ class Fiber;
 class System;
 
 namespace detail {
+struct InvocationProfileRecord;
 struct ProgramIsolate;
 }  // namespace detail
 
@@ -60,6 +66,57 @@ enum class ProgramIsolation {
   PER_CALL = 2,
 };
 
+// Opt-in breakdown of where the time of invocations goes, aggregated per
+// function name (see Program::Options::profile_invocations). For each
+// invocation, it records:
+//   * enqueue: from Invoke() until the VM starts the function, including the
+//     hop to the fiber's worker and the scheduler flush.
+//   * execute: host side VM execution, until the function returns.
+//   * wait: from the VM starting until the wait fence (the dependencies of
+//     the arguments) resolves. 0 if already resolved.
+//   * signal: from the function returning until its coarse_signal() is
+//     reached, which is the device work still outstanding once the host is
+//     done. 0 without coarse signaling.
+// The latest sample of each is also plotted in Tracy. Thread safe.
+class SHORTFIN_API ProgramInvocationProfile {
+ public:
+  struct Phase {
+    iree_duration_t total_ns = 0;
+    iree_duration_t max_ns = 0;
+    void Add(iree_duration_t ns) {
+      total_ns += ns;
+      if (ns > max_ns) max_ns = ns;
+    }
+  };
+  struct FunctionStats {
+    uint64_t count = 0;
+    // Invocations that failed to schedule or execute (still timed).
+    uint64_t failed_count = 0;
+    Phase enqueue;
+    Phase execute;
+    Phase wait;
+    Phase signal;
+  };
+  struct Sample {
+    iree_duration_t enqueue_ns = 0;
+    iree_duration_t execute_ns = 0;
+    iree_duration_t wait_ns = 0;
+    iree_duration_t signal_ns = 0;
+    bool failed = false;
+  };
+
+  void Record(std::string_view function_name, const Sample &sample);
+  // Stats of every function invoked since creation or the last Reset(),
+  // ordered by name.
+  std::vector<std::pair<std::string, FunctionStats>> Snapshot();
+  void Reset();
+
+ private:
+  iree::slim_mutex mu_;
+  std::map<std::string, FunctionStats, std::less<>> stats_
+      SHORTFIN_GUARDED_BY(mu_);
+};
+
 // State related to making an invocation of a function on a program.
 //
 // Since ownership of this object is transferred to the loop/callback and
@@ -91,7 +148,10 @@ class SHORTFIN_API ProgramInvocation {
   static Ptr New(std::shared_ptr<Fiber> fiber, iree::vm_context_ptr vm_context,
                  iree_vm_function_t &vm_function,
                  ProgramInvocationModel invocation_model,
-                 detail::ProgramIsolate *isolate);
+                 detail::ProgramIsolate *isolate,
+                 iree::vm_context_ptr root_context,
+                 ProgramIsolation isolation,
+                 std::shared_ptr<ProgramInvocationProfile> profile = nullptr);
   ProgramInvocation(const ProgramInvocation &) = delete;
   ProgramInvocation &operator=(const ProgramInvocation &) = delete;
   ProgramInvocation &operator=(ProgramInvocation &&) = delete;
@@ -112,16 +172,65 @@ class SHORTFIN_API ProgramInvocation {
   void wait_insert(iree_hal_semaphore_list_t sem_list);
 
   // Adds a ref object argument. This low level interface directly adds a
-  // reference object and does not manipulate any execution barriers.
-  void AddArg(iree::vm_opaque_ref ref,
-              detail::TimelineResource *resource);  // Moves a reference in.
-  void AddArg(iree_vm_ref_t *ref,
-              detail::TimelineResource *resource);  // Borrows the reference.
+  // reference object and does not manipulate any execution barriers. If the
+  // resource has range tracking enabled, the invocation is recorded as an
+  // access to |range| (a write if |write|) once scheduled.
+  void AddArg(iree::vm_opaque_ref ref, detail::TimelineResource *resource,
+              detail::TimelineResourceRange range = {},
+              bool write = false);  // Moves a reference in.
+  void AddArg(iree_vm_ref_t *ref, detail::TimelineResource *resource,
+              detail::TimelineResourceRange range = {},
+              bool write = false);  // Borrows the reference.
+
+  // Adds a preallocated output (i.e. a pooled device_array) for functions
+  // compiled to write a result into an argument (iree.abi.output), so that
+  // the result lands in it instead of a new allocation. It is added with a
+  // WRITE barrier. Returns the argument index.
+  iree_host_size_t AddOutputArg(ProgramInvocationMarshalable &output);
+  // Marks an argument that was already added with a WRITE barrier as a
+  // donated output (for bindings that marshal arguments themselves).
+  void MarkOutputArg(iree_host_size_t arg_index);
+
+  // If the i'th result is a donated output argument (the same buffer and
+  // range), returns the index of that argument. Such results are not
+  // imported with a timeline of their own: they are the donated object.
+  std::optional<iree_host_size_t> donated_output_for_result(
+      iree_host_size_t i);
+
+  // Orders this invocation after the device work of `producer` (a scheduled
+  // COARSE_FENCES invocation) by adding its coarse_signal() to the wait
+  // fence. Nothing waits on the host, so dependent invocations run back to
+  // back on the device. The wait only applies if this invocation selects a
+  // device (from its arguments or DeviceSelect). Must be called before the
+  // producer is Reset().
+  void WaitAfter(ProgramInvocation &producer);
+
+  // Adds the i'th result of a completed `producer` directly as the next
+  // argument and waits after it. The result is passed on by reference,
+  // without being imported (i.e. as a device_array with its own timeline),
+  // which makes this the hand off between the stages of an on device
+  // pipeline (i.e. text encoder -> unet -> vae). Selects the producer's
+  // device.
+  void AddResultArg(ProgramInvocation &producer, iree_host_size_t i);
 
   // Transfers ownership of an invocation and schedules it on worker, returning
   // a future that will resolve to the owned invocation upon completion.
   static ProgramInvocation::Future Invoke(ProgramInvocation::Ptr invocation);
 
+  // Returns a completed (or not yet scheduled) invocation to the unscheduled
+  // state so that arguments can be added again and it can be re-Invoke()d.
+  // Arguments, results and the device selection are cleared, but the
+  // argument/result storage and the wait fence are kept, saving their
+  // allocation on repeated calls of the same function (i.e. per token
+  // decode). Result refs previously obtained remain valid.
+  //
+  // The context is re-acquired with the isolation the invocation was created
+  // with (for PER_CALL, this forks a new one).
+  void Reset();
+
+  // Gets the number of arguments added so far.
+  iree_host_size_t args_size();
+
   // Gets the number of outputs.
   iree_host_size_t results_size();
 
@@ -175,34 +284,46 @@ class SHORTFIN_API ProgramInvocation {
       iree_vm_list_t *arg_list, iree_vm_function_t &function,
       ProgramInvocationModel invocation_model);
 
-  // Parameters needed to make the async call are stored at construction time
-  // up until the point the call is made in the params union. When invoking,
-  // these will be copied to the stack and passed to the async invocation,
-  // which initializes the async_invoke_state. Phasing it like this saves
-  // memory that would otherwise be retained for the life of the invocation.
+  // Parameters needed to make the async call. When invoking, these are copied
+  // to the stack and passed to the async invocation, which initializes the
+  // async_invoke_state. They are retained for the life of the invocation so
+  // that it can be Reset() and invoked again.
   // This must not contain entities that require destruction or cannot be
   // trivially copied.
   struct Params {
     iree_vm_function_t function;
     ProgramInvocationModel invocation_model;
   };
-  union State {
-    State() { new (&params) Params(); }
-    ~State() {}
-    Params params;
-    iree_vm_async_invoke_state_t async_invoke_state;
-  } state;
+  Params params_;
+  iree_vm_async_invoke_state_t async_invoke_state_;
 
   std::shared_ptr<Fiber> fiber_;
   iree::vm_context_ptr vm_context_;
   detail::ProgramIsolate *isolate_;
+  // Root context (and isolation) that vm_context_ is re-acquired from on
+  // Reset().
+  iree::vm_context_ptr root_context_;
+  ProgramIsolation isolation_ = ProgramIsolation::NONE;
   iree_vm_list_t *result_list_ = nullptr;
-  detail::TimelineResource **arg_resources_ = nullptr;
+  // Trailing per-argument resource records (null resource if none).
+  struct ArgResource {
+    detail::TimelineResource *resource;
+    detail::TimelineResourceRange range;
+    bool write;
+    // Donated output (see AddOutputArg).
+    bool output;
+  };
+  ArgResource *arg_resources_ = nullptr;
   std::optional<Future> future_;
   iree::hal_fence_ptr wait_fence_;
   iree_hal_semaphore_t *signal_sem_ = nullptr;
   uint64_t signal_timepoint_ = 0;
   DeviceAffinity device_selection_;
+  // Set if the program is profiled. The record is owned by the invocation
+  // from the VM starting until completion.
+  std::shared_ptr<ProgramInvocationProfile> profile_;
+  detail::InvocationProfileRecord *profile_record_ = nullptr;
+  iree_time_t invoke_start_ns_ = 0;
   bool scheduled_ = false;
 };
 
@@ -228,6 +349,7 @@ class SHORTFIN_API ProgramFunction {
  private:
   ProgramFunction(iree::vm_context_ptr vm_context,
                   iree_vm_function_t vm_function, ProgramIsolation isolation,
+                  std::shared_ptr<ProgramInvocationProfile> profile,
                   std::optional<ProgramInvocationModel> invocation_model = {});
 
   static ProgramInvocationModel GetInvocationModelFromFunction(
@@ -237,6 +359,7 @@ class SHORTFIN_API ProgramFunction {
   iree_vm_function_t vm_function_;
   ProgramIsolation isolation_;
   ProgramInvocationModel invocation_model_;
+  std::shared_ptr<ProgramInvocationProfile> profile_;
   friend class Program;
 };
 
@@ -267,6 +390,18 @@ class SHORTFIN_API ProgramModule {
   static ProgramModule Load(System &system, const std::filesystem::path &path,
                             bool mmap = false);
 
+  // Loads several modules concurrently, reading/mapping and validating each
+  // on the system's BlockingExecutor (the calling thread takes part as well).
+  // Returns the modules in the order of `paths`. If any fails to load, the
+  // first failure (in path order) is rethrown once all have finished.
+  static std::vector<ProgramModule> LoadAll(
+      System &system, std::span<const std::filesystem::path> paths,
+      bool mmap = false);
+
+  // Wall time that Load() took for this module (0 if not loaded from a
+  // file).
+  iree_duration_t load_duration_ns() const { return load_duration_ns_; }
+
   // Creates a ProgramModule that will provide the given list of parameters
   // to modules loaded after it. In IREE parlance, this produces an
   // 'io_parameters' VM module.
@@ -284,6 +419,7 @@ class SHORTFIN_API ProgramModule {
  private:
   std::shared_ptr<System> system_;
   iree::vm_module_ptr vm_module_;
+  iree_duration_t load_duration_ns_ = 0;
 };
 
 // Programs consist of ProgramModules instantiated together and capable of
@@ -310,6 +446,11 @@ class SHORTFIN_API Program {
 
     // Enables program-wide execution tracing (to stderr).
     bool trace_execution = false;
+
+    // Records the host/device time breakdown of every invocation into
+    // invocation_profile(). This adds a couple of loop waits per invocation
+    // (on its wait fence and coarse signal) so it is off by default.
+    bool profile_invocations = false;
   };
 
   // Load a program from a list of modules and options.
@@ -334,12 +475,31 @@ class SHORTFIN_API Program {
   // convenient point (usually init time) to avoid first-invocation overhead.
   void PrepareIsolate(Fiber &fiber);
 
+  // PrepareIsolate for each fiber that will invoke the program, so that no
+  // first request on any of them pays for a context fork. For PER_CALL
+  // isolation, `contexts_per_fiber` forks are cached per fiber (the expected
+  // peak of concurrent calls); PER_FIBER only ever uses one. Must not race
+  // with invocations on the fibers. Does nothing for NONE isolation, where
+  // all fibers share the program context.
+  void PrepareIsolates(std::span<Fiber *const> fibers,
+                       size_t contexts_per_fiber = 1);
+
+  // Profile of invocations of the program's functions, or null if the
+  // program was not loaded with profile_invocations.
+  ProgramInvocationProfile *invocation_profile() const {
+    return profile_.get();
+  }
+
  private:
-  explicit Program(iree::vm_context_ptr vm_context, ProgramIsolation isolation)
-      : vm_context_(std::move(vm_context)), isolation_(isolation) {}
+  explicit Program(iree::vm_context_ptr vm_context, ProgramIsolation isolation,
+                   std::shared_ptr<ProgramInvocationProfile> profile)
+      : vm_context_(std::move(vm_context)),
+        isolation_(isolation),
+        profile_(std::move(profile)) {}
 
   iree::vm_context_ptr vm_context_;
   ProgramIsolation isolation_;
+  std::shared_ptr<ProgramInvocationProfile> profile_;
   friend class Fiber;
 };
 
@@ -387,17 +547,91 @@ class SHORTFIN_API StaticProgramParameters : public BaseProgramParameters {
     bool writable = false;
     // Whether to mmap the file.
     bool mmap = false;
+    // Only pages in parameter storage on first access (or Prefetch) instead
+    // of letting the OS read ahead through the file. Only the index is read
+    // at load time, so serving can start before very large files are
+    // resident, with the parameters of the first layers prefetched.
+    bool lazy = false;
+    // Reads the whole file into host memory up front, bypassing the page
+    // cache (O_DIRECT) where supported, with `direct_io_queue_depth` chunked
+    // reads in flight on the system's BlockingExecutor. Devices then upload
+    // parameters from that memory instead of through file reads. Ignores
+    // mmap and lazy.
+    bool direct_io = false;
+    size_t direct_io_chunk_size = 8 * 1024 * 1024;
+    int direct_io_queue_depth = 4;
+    // Backs the host memory holding parameters with huge pages, which reduces
+    // TLB misses while uploading them. With direct_io, the file is read into
+    // explicit huge pages (k2MB or k1GB, falling back to transparent ones
+    // when none are free). Mapped files can only use transparent huge pages,
+    // which any value other than kNone requests. Ignored for files which are
+    // neither mapped nor read with direct_io.
+    sysconfig::HugePages huge_pages = sysconfig::HugePages::kNone;
+    // Loads only one shard of a tensor parallel model: parameters with keys
+    // ending in ".shard.<shard_index>", plus unsharded (replicated) ones. -1
+    // loads all parameters.
+    int shard_index = -1;
+    // When set, the parsed index of the file is saved to this sidecar file
+    // and reused by later loads of the same (unchanged) file instead of
+    // parsing it again. The cache is keyed on the size, modification time
+    // and a hash of the leading bytes of the file, and is rewritten when
+    // stale.
+    std::filesystem::path index_cache_path;
   };
   // Load parameters from a supported file format, applying no name
   // transformation.
   void Load(std::filesystem::path file_path, LoadOptions options);
   void Load(std::filesystem::path file_path) { Load(file_path, LoadOptions()); }
 
+  // Begins paging in the storage of the named parameters in the background,
+  // typically ahead of their first use by lazily loaded files. Returns the
+  // number of bytes hinted. Throws std::invalid_argument for unknown names.
+  uint64_t Prefetch(std::span<const std::string_view> names);
+
  private:
+  std::shared_ptr<System> system_;
   iree_allocator_t host_allocator_;
   iree::io_parameter_index_ptr index_;
 
   void LoadMmap(std::filesystem::path file_path, LoadOptions options);
+  void LoadDirect(std::filesystem::path file_path, LoadOptions options);
+  // Parses the index of a file (or reads it from the index cache), adding
+  // the entries selected by `options`.
+  void ParseIndex(const std::filesystem::path &file_path,
+                  iree_io_file_handle_t *file_handle,
+                  const LoadOptions &options);
+};
+
+// Parameters of a tensor parallel model, split per device so that each only
+// sees (and loads) its shard. Each shard is a StaticProgramParameters to be
+// passed as the parameter provider of the program bound to its device.
+class SHORTFIN_API ShardedProgramParameters {
+ public:
+  // Shard i belongs to devices[i].
+  ShardedProgramParameters(
+      System &system, std::string_view parameter_scope,
+      std::vector<Device *> devices,
+      iree_host_size_t max_concurrent_operations =
+          IREE_IO_PARAMETER_INDEX_PROVIDER_DEFAULT_MAX_CONCURRENT_OPERATIONS);
+
+  // Loads a file containing all shards, giving each shard its own
+  // parameters (and the replicated ones). Cannot be combined with direct_io,
+  // which would read the whole file per shard: use per-shard files instead.
+  void Load(std::filesystem::path file_path,
+            StaticProgramParameters::LoadOptions options = {});
+  // Loads a file holding only the parameters of one shard.
+  void LoadShard(size_t shard_index, std::filesystem::path file_path,
+                 StaticProgramParameters::LoadOptions options = {});
+
+  size_t size() const { return shards_.size(); }
+  // Throws std::out_of_range if there is no such shard.
+  StaticProgramParameters &shard(size_t shard_index);
+  // Throws std::invalid_argument if the device has no shard.
+  StaticProgramParameters &for_device(Device *device);
+
+ private:
+  std::vector<Device *> devices_;
+  std::vector<std::unique_ptr<StaticProgramParameters>> shards_;
 };
 
 // Handles importing a batch of VM reference types and creating a
@@ -0,0 +1,115 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <exception>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "shortfin/local/benchmark_helpers.h"
+#include "shortfin/local/program.h"
+
+namespace shortfin::local {
+namespace {
+
+// Invocations of `hal.devices.count`, exported by the HAL module every
+// program is loaded with: this measures the invocation machinery (context
+// acquisition, scheduling and completion on the worker) without needing a
+// compiled module.
+class ProgramBenchmark {
+ public:
+  explicit ProgramBenchmark(ProgramIsolation isolation) {
+    for (Device *device : sys.system().devices()) devices.push_back(device);
+    ProgramModule parameters =
+        ProgramModule::ParameterProvider(sys.system(), {});
+    Program::Options options;
+    options.devices = devices;
+    options.isolation = isolation;
+    program.emplace(
+        Program::Load(std::span<const ProgramModule>(&parameters, 1),
+                      std::move(options)));
+    function.emplace(program->LookupRequiredFunction("hal.devices.count"));
+  }
+
+  // Invokes the invocation returned by `make` (called on the worker, which
+  // owns the fiber) and blocks until it completes, returning it.
+  ProgramInvocation::Ptr InvokeAndWait(
+      const std::function<ProgramInvocation::Ptr()> &make) {
+    ProgramInvocation::Ptr completed;
+    std::exception_ptr error;
+    sys.RunAsyncOnWorker([&](std::function<void()> done) {
+      ProgramInvocation::Invoke(make()).AddCallback(
+          [&completed, &error, done](Future &future) {
+            try {
+              completed = std::move(
+                  static_cast<ProgramInvocation::Future &>(future).result());
+            } catch (...) {
+              error = std::current_exception();
+            }
+            done();
+          });
+    });
+    if (error) std::rethrow_exception(error);
+    return completed;
+  }
+
+  BenchmarkSystem sys;
+  std::vector<const Device *> devices;
+  std::optional<Program> program;
+  std::optional<ProgramFunction> function;
+};
+
+void BM_InvocationCreate(benchmark::State &state) {
+  ProgramBenchmark bench(static_cast<ProgramIsolation>(state.range(0)));
+  bench.sys.RunOnWorker([&]() {
+    for (auto _ : state) {
+      ProgramInvocation::Ptr invocation =
+          bench.function->CreateInvocation(bench.sys.fiber());
+      benchmark::DoNotOptimize(invocation.get());
+    }
+  });
+}
+BENCHMARK(BM_InvocationCreate)
+    ->Arg(static_cast<int>(ProgramIsolation::NONE))
+    ->Arg(static_cast<int>(ProgramIsolation::PER_FIBER))
+    ->Arg(static_cast<int>(ProgramIsolation::PER_CALL))
+    ->UseRealTime();
+
+void BM_InvocationCreateAndInvoke(benchmark::State &state) {
+  ProgramBenchmark bench(static_cast<ProgramIsolation>(state.range(0)));
+  for (auto _ : state) {
+    ProgramInvocation::Ptr completed = bench.InvokeAndWait([&bench]() {
+      return bench.function->CreateInvocation(bench.sys.fiber());
+    });
+    benchmark::DoNotOptimize(completed.get());
+  }
+}
+BENCHMARK(BM_InvocationCreateAndInvoke)
+    ->Arg(static_cast<int>(ProgramIsolation::NONE))
+    ->Arg(static_cast<int>(ProgramIsolation::PER_FIBER))
+    ->UseRealTime();
+
+// Reuses one invocation (see ProgramInvocation::Reset), as per token decode
+// loops do.
+void BM_InvocationResetAndInvoke(benchmark::State &state) {
+  ProgramBenchmark bench(ProgramIsolation::PER_FIBER);
+  ProgramInvocation::Ptr invocation = bench.InvokeAndWait([&bench]() {
+    return bench.function->CreateInvocation(bench.sys.fiber());
+  });
+  for (auto _ : state) {
+    invocation = bench.InvokeAndWait([&invocation]() {
+      invocation->Reset();
+      return std::move(invocation);
+    });
+  }
+}
+BENCHMARK(BM_InvocationResetAndInvoke)->UseRealTime();
+
+}  // namespace
+}  // namespace shortfin::local
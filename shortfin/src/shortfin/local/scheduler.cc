@@ -6,31 +6,195 @@
 
 #include "shortfin/local/scheduler.h"
 
+#include <algorithm>
+#include <bit>
+
+#include "fmt/ranges.h"
 #include "shortfin/local/fiber.h"
 #include "shortfin/local/system.h"
 #include "shortfin/support/logging.h"
 
 namespace shortfin::local::detail {
 
-namespace {
+// -------------------------------------------------------------------------- //
+// SemaphoreJoin
+// -------------------------------------------------------------------------- //
+
+SemaphoreJoin::SemaphoreJoin(SemaphoreJoin &&other) { *this = std::move(other); }
+
+SemaphoreJoin &SemaphoreJoin::operator=(SemaphoreJoin &&other) {
+  if (this == &other) return *this;
+  clear();
+  count_ = other.count_;
+  spilled_ = other.spilled_;
+  if (!spilled_) {
+    std::copy_n(other.inline_sems_, count_, inline_sems_);
+    std::copy_n(other.inline_timepoints_, count_, inline_timepoints_);
+  }
+  spilled_sems_ = std::move(other.spilled_sems_);
+  spilled_timepoints_ = std::move(other.spilled_timepoints_);
+  other.count_ = 0;
+  other.spilled_ = false;
+  other.spilled_sems_.clear();
+  other.spilled_timepoints_.clear();
+  return *this;
+}
 
-[[maybe_unused]] std::string SummarizeFence(iree_hal_fence_t *fence) {
-  if (!SHORTFIN_SCHED_LOG_ENABLED) {
-    return std::string();
+void SemaphoreJoin::insert(iree_hal_semaphore_t *sem, uint64_t timepoint) {
+  iree_hal_semaphore_t **current_sems = sems();
+  uint64_t *current_timepoints = timepoints();
+  for (size_t i = 0; i < count_; ++i) {
+    if (current_sems[i] == sem) {
+      current_timepoints[i] = std::max(current_timepoints[i], timepoint);
+      return;
+    }
   }
-  std::string result("fence(");
-  iree_hal_semaphore_list_t list = iree_hal_fence_semaphore_list(fence);
-  for (iree_host_size_t i = 0; i < list.count; ++i) {
+  iree_hal_semaphore_retain(sem);
+  if (!spilled_ && count_ < kInlineCapacity) {
+    inline_sems_[count_] = sem;
+    inline_timepoints_[count_] = timepoint;
+  } else {
+    if (!spilled_) {
+      spilled_sems_.assign(inline_sems_, inline_sems_ + count_);
+      spilled_timepoints_.assign(inline_timepoints_,
+                                 inline_timepoints_ + count_);
+      spilled_ = true;
+    }
+    spilled_sems_.push_back(sem);
+    spilled_timepoints_.push_back(timepoint);
+  }
+  count_ += 1;
+}
+
+void SemaphoreJoin::insert(iree_hal_semaphore_list_t sem_list) {
+  for (iree_host_size_t i = 0; i < sem_list.count; ++i) {
+    insert(sem_list.semaphores[i], sem_list.payload_values[i]);
+  }
+}
+
+void SemaphoreJoin::clear() {
+  iree_hal_semaphore_t **current_sems = sems();
+  for (size_t i = 0; i < count_; ++i) {
+    iree_hal_semaphore_release(current_sems[i]);
+  }
+  count_ = 0;
+  spilled_ = false;
+  spilled_sems_.clear();
+  spilled_timepoints_.clear();
+}
+
+std::string SemaphoreJoin::to_s() const {
+  const iree_hal_semaphore_t *const *current_sems =
+      spilled_ ? spilled_sems_.data() : inline_sems_;
+  const uint64_t *current_timepoints =
+      spilled_ ? spilled_timepoints_.data() : inline_timepoints_;
+  std::string result("join(");
+  for (size_t i = 0; i < count_; ++i) {
     if (i > 0) result.append(", ");
     result.append(fmt::format("[{}@{}]",
-                              static_cast<void *>(list.semaphores[i]),
-                              list.payload_values[i]));
+                              static_cast<const void *>(current_sems[i]),
+                              current_timepoints[i]));
   }
   result.append(")");
   return result;
 }
 
-}  // namespace
+iree_device_size_t RoundToSizeClass(iree_device_size_t size,
+                                    iree_device_size_t min_block_size) {
+  iree_device_size_t size_class = std::max(size, min_block_size);
+  iree_device_size_t step =
+      std::max<iree_device_size_t>(std::bit_floor(size_class) / 4, 1);
+  return (size_class + step - 1) / step * step;
+}
+
+// -------------------------------------------------------------------------- //
+// ExportedBarrier
+// -------------------------------------------------------------------------- //
+
+ExportedBarrier::ExportedBarrier(iree_hal_semaphore_list_t sem_list) {
+  retained_.reserve(sem_list.count);
+  sems_.reserve(sem_list.count);
+  timepoints_.reserve(sem_list.count);
+  for (iree_host_size_t i = 0; i < sem_list.count; ++i) {
+    retained_.push_back(
+        iree::hal_semaphore_ptr::borrow_reference(sem_list.semaphores[i]));
+    sems_.push_back(sem_list.semaphores[i]);
+    timepoints_.push_back(sem_list.payload_values[i]);
+  }
+}
+
+std::string ExportedBarrier::to_s() const {
+  std::string result("ExportedBarrier(");
+  for (size_t i = 0; i < sems_.size(); ++i) {
+    if (i > 0) result.append(", ");
+    result.append(fmt::format("[{}@{}]", static_cast<void *>(sems_[i]),
+                              timepoints_[i]));
+  }
+  result.append(")");
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+// TimelineResourcePoolStats
+// -------------------------------------------------------------------------- //
+
+std::string TimelineResourcePoolStats::to_s() const {
+  return fmt::format(
+      "TimelineResourcePoolStats(allocations={}, reuses={}, recycles={}, "
+      "discards={}, pooled={})",
+      allocations, reuses, recycles, discards, pooled);
+}
+
+// -------------------------------------------------------------------------- //
+// SchedulerStats
+// -------------------------------------------------------------------------- //
+
+void SchedulerStats::RecordSubmission(uint32_t transaction_count,
+                                      size_t dep_count, uint64_t pending_ns) {
+  submissions += 1;
+  transactions += transaction_count;
+  size_t bucket = 0;
+  while (bucket < kDepsBucketBounds.size() &&
+         dep_count >= kDepsBucketBounds[bucket]) {
+    ++bucket;
+  }
+  deps_histogram[bucket] += 1;
+  pending_ns_total += pending_ns;
+  pending_ns_max = std::max(pending_ns_max, pending_ns);
+}
+
+void SchedulerStats::Accumulate(const SchedulerStats &other) {
+  submissions += other.submissions;
+  transactions += other.transactions;
+  for (size_t i = 0; i < flushes.size(); ++i) flushes[i] += other.flushes[i];
+  replays += other.replays;
+  deallocas += other.deallocas;
+  dealloca_batches += other.dealloca_batches;
+  cache_hits += other.cache_hits;
+  cache_misses += other.cache_misses;
+  cache_returns += other.cache_returns;
+  cache_evictions += other.cache_evictions;
+  staging_hits += other.staging_hits;
+  staging_misses += other.staging_misses;
+  for (size_t i = 0; i < deps_histogram.size(); ++i) {
+    deps_histogram[i] += other.deps_histogram[i];
+  }
+  pending_ns_total += other.pending_ns_total;
+  pending_ns_max = std::max(pending_ns_max, other.pending_ns_max);
+}
+
+std::string SchedulerStats::to_s() const {
+  return fmt::format(
+      "SchedulerStats(submissions={}, transactions={}, flushes=[{}], "
+      "replays={}, deallocas={}, dealloca_batches={}, cache_hits={}, "
+      "cache_misses={}, cache_returns={}, cache_evictions={}, "
+      "staging_hits={}, staging_misses={}, deps_histogram=[{}], "
+      "pending_ns_total={}, pending_ns_max={})",
+      submissions, transactions, fmt::join(flushes, ", "), replays, deallocas,
+      dealloca_batches, cache_hits, cache_misses, cache_returns,
+      cache_evictions, staging_hits, staging_misses,
+      fmt::join(deps_histogram, ", "), pending_ns_total, pending_ns_max);
+}
 
 // -------------------------------------------------------------------------- //
 // Account
@@ -51,14 +215,276 @@ void Account::Initialize() {
 
 void Account::Reset() {
   active_tx_type_ = TransactionType::NONE;
+  active_deps_.clear();
   active_command_buffer_.reset();
+  active_op_count_ = 0;
+  active_begin_time_ns_ = 0;
+  active_barrier_op_ = UINT32_MAX;
 }
 
 void Account::active_deps_extend(iree_hal_semaphore_list_t sem_list) {
   for (iree_host_size_t i = 0; i < sem_list.count; ++i) {
-    SHORTFIN_THROW_IF_ERROR(iree_hal_fence_insert(
-        active_deps_, sem_list.semaphores[i], sem_list.payload_values[i]));
+    if (active_command_buffer_ && sem_list.semaphores[i] == sem_.get() &&
+        sem_list.payload_values[i] >= idle_timepoint_) {
+      // Depends on a prior transaction in the active command buffer. Waiting
+      // on our own signal timepoint would never resolve, so order it within
+      // the command buffer instead.
+      if (active_barrier_op_ != active_op_count_) {
+        SHORTFIN_SCHED_LOG("  : Intra-command buffer barrier (op={})",
+                           active_op_count_);
+        SHORTFIN_THROW_IF_ERROR(iree_hal_command_buffer_execution_barrier(
+            active_command_buffer_, IREE_HAL_EXECUTION_STAGE_COMMAND_RETIRE,
+            IREE_HAL_EXECUTION_STAGE_COMMAND_ISSUE,
+            IREE_HAL_EXECUTION_BARRIER_FLAG_NONE,
+            /*memory_barrier_count=*/0, /*memory_barriers=*/nullptr,
+            /*buffer_barrier_count=*/0, /*buffer_barriers=*/nullptr));
+        active_barrier_op_ = active_op_count_;
+      }
+      continue;
+    }
+    active_deps_.insert(sem_list.semaphores[i], sem_list.payload_values[i]);
+  }
+}
+
+uint64_t Account::timeline_acquire_timepoint() {
+  if (capture_) [[unlikely]] {
+    throw std::logic_error(
+        "Cannot schedule out-of-band queue operations (allocations, "
+        "invocations, etc) on a device while capturing commands");
   }
+  if (active_command_buffer_) [[unlikely]] {
+    scheduler_.Flush(FlushReason::TIMEPOINT_ACQUIRE);
+  } else if (!pending_deallocas_.empty()) {
+    SHORTFIN_THROW_IF_ERROR(FlushDeallocas());
+  }
+  return ++idle_timepoint_;
+}
+
+void Account::DeferDealloca(iree::hal_buffer_ptr buffer,
+                            iree_hal_queue_affinity_t queue_affinity,
+                            iree_hal_semaphore_list_t wait_list) {
+  if (pending_deallocas_.empty()) {
+    pending_dealloca_begin_ns_ = iree_time_now();
+  }
+  pending_deallocas_.push_back(PendingDealloca{
+      .buffer = std::move(buffer), .queue_affinity = queue_affinity});
+  pending_dealloca_waits_.insert(wait_list);
+
+  // A pending command buffer will flush the batch when it is submitted.
+  if (active_command_buffer_) return;
+  auto &batch = scheduler_.dealloca_batch();
+  if (pending_deallocas_.size() >= batch.max_buffers ||
+      (batch.max_latency_us &&
+       iree_time_now() - pending_dealloca_begin_ns_ >=
+           static_cast<iree_time_t>(batch.max_latency_us) * 1000)) {
+    SHORTFIN_THROW_IF_ERROR(FlushDeallocas());
+  }
+}
+
+bool Account::TakeCachedBuffer(iree_hal_queue_affinity_t queue_affinity,
+                               iree_device_size_t size_class,
+                               iree::hal_buffer_ptr &buffer,
+                               iree::hal_semaphore_ptr &ready_sem,
+                               uint64_t &ready_timepoint) {
+  // Prefer the least recently returned match, whose barrier is the most
+  // likely to have been reached already.
+  auto it = std::find_if(
+      cached_buffers_.begin(), cached_buffers_.end(), [&](CachedBuffer &c) {
+        return c.size == size_class && c.queue_affinity == queue_affinity;
+      });
+  if (it == cached_buffers_.end()) {
+    stats_.cache_misses += 1;
+    return false;
+  }
+  buffer = std::move(it->buffer);
+  ready_sem = std::move(it->ready_sem);
+  ready_timepoint = it->ready_timepoint;
+  cached_bytes_ -= it->size;
+  device_->AdjustPooledBytes(-static_cast<int64_t>(it->size), 0);
+  cached_buffers_.erase(it);
+  stats_.cache_hits += 1;
+  return true;
+}
+
+bool Account::CacheBuffer(iree::hal_buffer_ptr &buffer,
+                          iree_hal_queue_affinity_t queue_affinity,
+                          iree_hal_semaphore_list_t use_barrier) {
+  auto &options = scheduler_.buffer_cache();
+  iree_device_size_t size = iree_hal_buffer_byte_length(buffer);
+  // Only a single ready semaphore is tracked per buffer, which covers the
+  // common case of all uses having been on one queue.
+  if (size > options.max_bytes || use_barrier.count > 1) return false;
+  CachedBuffer cached{
+      .buffer = std::move(buffer),
+      .queue_affinity = queue_affinity,
+      .size = size,
+      .ready_timepoint = 0,
+  };
+  if (use_barrier.count == 1) {
+    cached.ready_sem =
+        iree::hal_semaphore_ptr::borrow_reference(use_barrier.semaphores[0]);
+    cached.ready_timepoint = use_barrier.payload_values[0];
+  }
+  cached_buffers_.push_back(std::move(cached));
+  cached_bytes_ += size;
+  device_->AdjustPooledBytes(size, 0);
+  stats_.cache_returns += 1;
+  TrimBufferCache(options.max_bytes);
+  return true;
+}
+
+void Account::TrimBufferCache(iree_device_size_t max_bytes) {
+  size_t evict_count = 0;
+  while (cached_bytes_ > max_bytes) {
+    CachedBuffer &cached = cached_buffers_[evict_count++];
+    cached_bytes_ -= cached.size;
+    device_->AdjustPooledBytes(-static_cast<int64_t>(cached.size), 0);
+    iree_hal_semaphore_t *ready_sem = cached.ready_sem.get();
+    DeferDealloca(std::move(cached.buffer), cached.queue_affinity,
+                  iree_hal_semaphore_list_t{
+                      .count = ready_sem ? 1u : 0u,
+                      .semaphores = &ready_sem,
+                      .payload_values = &cached.ready_timepoint,
+                  });
+  }
+  if (evict_count == 0) return;
+  SHORTFIN_SCHED_LOG("Evict {} cached buffers (account=0x{:x})", evict_count,
+                     id());
+  stats_.cache_evictions += evict_count;
+  cached_buffers_.erase(cached_buffers_.begin(),
+                        cached_buffers_.begin() + evict_count);
+}
+
+bool Account::TakeStagingBuffer(iree_hal_queue_affinity_t queue_affinity,
+                                iree_device_size_t size_class,
+                                iree::hal_buffer_ptr &buffer) {
+  for (auto it = staging_buffers_.begin(); it != staging_buffers_.end();
+       ++it) {
+    if (it->size != size_class || it->queue_affinity != queue_affinity) {
+      continue;
+    }
+    if (it->ready_sem) {
+      uint64_t current_value = 0;
+      iree_status_t status =
+          iree_hal_semaphore_query(it->ready_sem, &current_value);
+      if (!iree_status_is_ok(status)) {
+        // A failed timeline leaves the buffer to be released by trimming.
+        iree_status_ignore(status);
+        continue;
+      }
+      if (current_value < it->ready_timepoint) continue;
+    }
+    buffer = std::move(it->buffer);
+    staging_bytes_ -= it->size;
+    device_->AdjustPooledBytes(0, -static_cast<int64_t>(it->size));
+    staging_buffers_.erase(it);
+    stats_.staging_hits += 1;
+    return true;
+  }
+  stats_.staging_misses += 1;
+  return false;
+}
+
+void Account::ReturnStagingBuffer(iree::hal_buffer_ptr &buffer,
+                                  iree_hal_queue_affinity_t queue_affinity,
+                                  iree_hal_semaphore_list_t use_barrier) {
+  auto &ring = scheduler_.staging_ring();
+  iree_device_size_t size = iree_hal_buffer_byte_length(buffer);
+  // Host buffers are released synchronously (any pending device use retains
+  // them), so buffers that are not kept are simply dropped.
+  if (ring.max_buffers == 0 || size > ring.max_bytes ||
+      use_barrier.count > 1) {
+    return;
+  }
+  CachedBuffer returned{
+      .buffer = std::move(buffer),
+      .queue_affinity = queue_affinity,
+      .size = size,
+      .ready_timepoint = 0,
+  };
+  if (use_barrier.count == 1) {
+    returned.ready_sem =
+        iree::hal_semaphore_ptr::borrow_reference(use_barrier.semaphores[0]);
+    returned.ready_timepoint = use_barrier.payload_values[0];
+  }
+  staging_buffers_.push_back(std::move(returned));
+  staging_bytes_ += size;
+  device_->AdjustPooledBytes(0, size);
+  TrimStagingRing(ring.max_buffers, ring.max_bytes);
+}
+
+void Account::TrimStagingRing(uint32_t max_buffers,
+                              iree_device_size_t max_bytes) {
+  size_t drop_count = 0;
+  while (staging_buffers_.size() - drop_count > max_buffers ||
+         staging_bytes_ > max_bytes) {
+    iree_device_size_t size = staging_buffers_[drop_count++].size;
+    staging_bytes_ -= size;
+    device_->AdjustPooledBytes(0, -static_cast<int64_t>(size));
+  }
+  staging_buffers_.erase(staging_buffers_.begin(),
+                         staging_buffers_.begin() + drop_count);
+}
+
+iree_status_t Account::FlushDeallocas() noexcept {
+  if (pending_deallocas_.empty()) return iree_ok_status();
+  SHORTFIN_TRACE_SCOPE_NAMED("Account::FlushDeallocas");
+  SHORTFIN_SCHED_LOG("Flush deallocas (account=0x{:x}, count={}, wait={})",
+                     id(), pending_deallocas_.size(),
+                     pending_dealloca_waits_.to_s());
+  // Each dealloca waits on the joined wait list. Nothing waits on a
+  // deallocation, so none of them signal (which would otherwise require a
+  // chain of strictly increasing timepoints, serializing the batch).
+  iree_hal_semaphore_list_t wait_list =
+      pending_dealloca_waits_.semaphore_list();
+  iree_status_t status = iree_ok_status();
+  for (auto &pending : pending_deallocas_) {
+    status = iree_hal_device_queue_dealloca(
+        hal_device(), pending.queue_affinity, wait_list,
+        iree_hal_semaphore_list_empty(), pending.buffer,
+        IREE_HAL_DEALLOCA_FLAG_NONE);
+    if (!iree_status_is_ok(status)) break;
+  }
+  stats_.deallocas += pending_deallocas_.size();
+  stats_.dealloca_batches += 1;
+  SHORTFIN_TRACE_PLOT_VALUE_I64("shortfin.sched.dealloca_batch",
+                                pending_deallocas_.size());
+  pending_deallocas_.clear();
+  pending_dealloca_waits_.clear();
+  return status;
+}
+
+iree_hal_buffer_ref_t Account::record_buffer_ref(iree_hal_buffer_t *buffer,
+                                                iree_device_size_t offset,
+                                                iree_device_size_t length,
+                                                bool write) {
+  if (!capture_) {
+    return iree_hal_make_buffer_ref(buffer, offset, length);
+  }
+  auto &slots = capture_->slots_;
+  size_t slot = 0;
+  while (slot < slots.size() && slots[slot].capture_buffer.get() != buffer) {
+    ++slot;
+  }
+  if (slot == slots.size()) {
+    if (slot >= capture_->binding_capacity_) {
+      throw std::invalid_argument(fmt::format(
+          "Command capture exceeded its binding capacity of {} buffers",
+          capture_->binding_capacity_));
+    }
+    slots.push_back(CommandCapture::Slot{
+        .capture_buffer = iree::hal_buffer_ptr::borrow_reference(buffer)});
+  }
+  slots[slot].write |= write;
+  return iree_hal_make_indirect_buffer_ref(static_cast<uint32_t>(slot), offset,
+                                           length);
+}
+
+uint64_t Account::outstanding_timepoints() {
+  uint64_t current_value = 0;
+  SHORTFIN_THROW_IF_ERROR(iree_hal_semaphore_query(sem_, &current_value));
+  return current_value >= idle_timepoint_ ? 0
+                                          : idle_timepoint_ - current_value;
 }
 
 VoidFuture Account::OnSync() {
@@ -95,13 +521,9 @@ VoidFuture Account::OnSync() {
 // -------------------------------------------------------------------------- //
 
 TimelineResource::TimelineResource(std::shared_ptr<Fiber> fiber,
-                                   size_t semaphore_capacity,
                                    TimelineResourceDestructor destructor)
     : fiber_(std::move(fiber)), destructor_(std::move(destructor)) {
   logging::construct("TimelineResource", this);
-  SHORTFIN_THROW_IF_ERROR(
-      iree_hal_fence_create(semaphore_capacity, fiber_->host_allocator(),
-                            use_barrier_fence_.for_output()));
 }
 
 TimelineResource::~TimelineResource() {
@@ -109,58 +531,230 @@ TimelineResource::~TimelineResource() {
   if (destructor_) {
     destructor_(*this);
   }
+  ResetBarriers();
+}
+
+void TimelineResource::Recycle() {
+  SHORTFIN_TRACE_SCOPE_NAMED("TimelineResource::Recycle");
+  if (destructor_) {
+    // Move the destructor out so that anything it captures (i.e. buffers) is
+    // released before the resource becomes available for reuse.
+    TimelineResourceDestructor destructor = std::move(destructor_);
+    destructor_ = nullptr;
+    destructor(*this);
+  }
+  ResetBarriers();
+
+  // The scheduler is owned by the fiber, so we must keep the fiber alive
+  // until the resource has been handed back. Dropping the last fiber
+  // reference may destroy the scheduler (and with it, this instance), so
+  // |this| must not be accessed after the hand-off.
+  std::shared_ptr<Fiber> fiber = std::move(fiber_);
+  fiber->scheduler().RecycleTimelineResource(this);
+}
+
+void TimelineResource::ResetBarriers() {
+  mutation_barrier_sem_ = nullptr;
+  mutation_barrier_timepoint_ = 0;
+  range_tracking_ = false;
+  range_accesses_.clear();
+  use_barrier_.clear();
 }
 
 TimelineResourceDestructor TimelineResource::CreateAsyncBufferDestructor(
-    ScopedDevice &scoped_device, iree::hal_buffer_ptr buffer) {
+    ScopedDevice &scoped_device, iree::hal_buffer_ptr buffer, bool cacheable) {
   // The ScopedDevice doesn't lifetime extend the underlying hal device, so
   // we must do that manually across the callback (and then release at the end).
   iree_hal_device_retain(scoped_device.raw_device()->hal_device());
   return [device_affinity = scoped_device.affinity(),
-          buffer = std::move(buffer)](TimelineResource &res) {
+          buffer = std::move(buffer), cacheable](TimelineResource &res) mutable {
     ScopedDevice scoped_device(*res.fiber(), device_affinity);
     iree_hal_device_t *hal_device = scoped_device.raw_device()->hal_device();
     auto queue_affinity = scoped_device.affinity().queue_affinity();
     SHORTFIN_TRACE_SCOPE_NAMED("TimelineResource::AsyncBufferDestructor");
 
-    // The dealloca needs to wait on the current timepoint+all uses, and it
-    // needs to signal the next timepoint. Since this is a destructor, we
-    // now have exclusive control of the TimelineResource and simply record
-    // the current timepoint in its uses as a (small) optimization for merging
-    // the wait semaphore list, prior to acquiring a new timepoint
-    // (to signal).
+    // The dealloca needs to wait on all uses. Since this is a destructor, we
+    // now have exclusive control of the TimelineResource and hand its use
+    // barrier to the account, which batches deallocations.
     auto fiber = res.fiber();
     auto &account = fiber->scheduler().GetDefaultAccount(scoped_device);
-    iree_hal_semaphore_t *timeline_sem = account.timeline_sem();
-    res.use_barrier_insert(timeline_sem, account.timeline_idle_timepoint());
-    uint64_t signal_timepoint = account.timeline_acquire_timepoint();
     iree_hal_semaphore_list_t wait_semaphore_list = res.use_barrier();
-    iree_hal_semaphore_list_t signal_semaphore_list{
-        .count = 1,
-        .semaphores = &timeline_sem,
-        .payload_values = &signal_timepoint,
-    };
-
+    if (cacheable &&
+        account.CacheBuffer(buffer, queue_affinity, wait_semaphore_list)) {
+      iree_hal_device_release(hal_device);
+      return;
+    }
     if (SHORTFIN_SCHED_LOG_ENABLED) {
       auto wait_sum = iree::DebugPrintSemaphoreList(wait_semaphore_list);
-      auto signal_sum = iree::DebugPrintSemaphoreList(signal_semaphore_list);
       SHORTFIN_SCHED_LOG(
-          "async dealloca(device={}, affinity={:x}, buffer={}):[Wait:{}, "
-          "Signal:{}]",
+          "async dealloca(device={}, affinity={:x}, buffer={}):[Wait:{}]",
           static_cast<void *>(hal_device), queue_affinity,
-          static_cast<void *>(buffer.get()), wait_sum, signal_sum);
+          static_cast<void *>(buffer.get()), wait_sum);
     }
-    SHORTFIN_THROW_IF_ERROR(iree_hal_device_queue_dealloca(
-        hal_device, queue_affinity, wait_semaphore_list, signal_semaphore_list,
-        buffer, IREE_HAL_DEALLOCA_FLAG_NONE));
+    account.DeferDealloca(std::move(buffer), queue_affinity,
+                          wait_semaphore_list);
     iree_hal_device_release(hal_device);
   };
 }
 
+TimelineResourceDestructor TimelineResource::CreateStagingBufferDestructor(
+    ScopedDevice &scoped_device, iree::hal_buffer_ptr buffer) {
+  return [device_affinity = scoped_device.affinity(),
+          buffer = std::move(buffer)](TimelineResource &res) mutable {
+    ScopedDevice scoped_device(*res.fiber(), device_affinity);
+    auto queue_affinity = scoped_device.affinity().queue_affinity();
+    auto &account = res.fiber()->scheduler().GetDefaultAccount(scoped_device);
+    account.ReturnStagingBuffer(buffer, queue_affinity, res.use_barrier());
+  };
+}
+
+void TimelineResource::enable_range_tracking() {
+  if (range_tracking_) return;
+  range_tracking_ = true;
+  // Seed from the coarse barriers: the last mutation covers everything and
+  // every existing use is treated as a whole-range read.
+  if (mutation_barrier_sem_) {
+    range_accesses_.push_back(RangeAccess{
+        .range = TimelineResourceRange(),
+        .write = true,
+        .sem = mutation_barrier_sem_,
+        .timepoint = mutation_barrier_timepoint_,
+    });
+  }
+  iree_hal_semaphore_list_t uses = use_barrier_.semaphore_list();
+  for (iree_host_size_t i = 0; i < uses.count; ++i) {
+    range_accesses_.push_back(RangeAccess{
+        .range = TimelineResourceRange(),
+        .write = false,
+        .sem = uses.semaphores[i],
+        .timepoint = uses.payload_values[i],
+    });
+  }
+}
+
+iree_hal_semaphore_list_t TimelineResource::range_barrier(
+    TimelineResourceRange range, bool write) {
+  assert(range_tracking_ && "range tracking not enabled");
+  range_barrier_sems_.clear();
+  range_barrier_timepoints_.clear();
+  for (auto &access : range_accesses_) {
+    if (!write && !access.write) continue;
+    if (!access.range.overlaps(range)) continue;
+    bool merged = false;
+    for (size_t i = 0; i < range_barrier_sems_.size(); ++i) {
+      if (range_barrier_sems_[i] == access.sem) {
+        range_barrier_timepoints_[i] =
+            std::max(range_barrier_timepoints_[i], access.timepoint);
+        merged = true;
+        break;
+      }
+    }
+    if (!merged) {
+      range_barrier_sems_.push_back(access.sem);
+      range_barrier_timepoints_.push_back(access.timepoint);
+    }
+  }
+  return iree_hal_semaphore_list_t{
+      .count = range_barrier_sems_.size(),
+      .semaphores = range_barrier_sems_.data(),
+      .payload_values = range_barrier_timepoints_.data()};
+}
+
+void TimelineResource::range_insert(TimelineResourceRange range, bool write,
+                                    iree_hal_semaphore_t *sem,
+                                    uint64_t timepoint) {
+  assert(range_tracking_ && "range tracking not enabled");
+  // Since the new access was ordered after everything it conflicts with,
+  // any access it fully covers is redundant: a write supersedes all covered
+  // accesses, and a read supersedes covered reads on the same timeline.
+  std::erase_if(range_accesses_, [&](const RangeAccess &existing) {
+    if (!range.contains(existing.range)) return false;
+    if (write) return true;
+    return !existing.write && existing.sem == sem &&
+           existing.timepoint <= timepoint;
+  });
+  range_accesses_.push_back(RangeAccess{
+      .range = range,
+      .write = write,
+      .sem = sem,
+      .timepoint = timepoint,
+  });
+  if (range_accesses_.size() > kMaxRangeAccesses) {
+    CollapseRangeAccesses();
+  }
+  use_barrier_insert(sem, timepoint);
+}
+
+ExportedBarrier TimelineResource::ExportBarrier(bool include_uses) {
+  return ExportedBarrier(include_uses ? use_barrier() : mutation_barrier());
+}
+
+void TimelineResource::ImportBarrier(iree_hal_semaphore_list_t sem_list,
+                                     bool write) {
+  if (sem_list.count == 0) return;
+  SHORTFIN_SCHED_LOG("TimelineResource {}: Import {} barrier (count={})",
+                     static_cast<void *>(this), write ? "write" : "read",
+                     sem_list.count);
+  if (!write && !range_tracking_) {
+    for (iree_host_size_t i = 0; i < sem_list.count; ++i) {
+      use_barrier_insert(sem_list.semaphores[i], sem_list.payload_values[i]);
+    }
+    return;
+  }
+  if (write && !range_tracking_ && sem_list.count == 1 &&
+      (!mutation_barrier_sem_ ||
+       mutation_barrier_sem_ == sem_list.semaphores[0])) {
+    // Imported semaphores are kept retained by the use barrier.
+    use_barrier_insert(sem_list.semaphores[0], sem_list.payload_values[0]);
+    set_mutation_barrier(sem_list.semaphores[0],
+                         std::max(mutation_barrier_timepoint_,
+                                  sem_list.payload_values[0]));
+    return;
+  }
+
+  // The imported accesses are not ordered after existing local accesses (nor
+  // each other), so unlike range_insert, nothing is superseded.
+  enable_range_tracking();
+  for (iree_host_size_t i = 0; i < sem_list.count; ++i) {
+    range_accesses_.push_back(RangeAccess{
+        .range = TimelineResourceRange(),
+        .write = write,
+        .sem = sem_list.semaphores[i],
+        .timepoint = sem_list.payload_values[i],
+    });
+    use_barrier_insert(sem_list.semaphores[i], sem_list.payload_values[i]);
+  }
+  if (range_accesses_.size() > kMaxRangeAccesses) {
+    CollapseRangeAccesses();
+  }
+}
+
+void TimelineResource::CollapseRangeAccesses() {
+  SHORTFIN_SCHED_LOG("TimelineResource {}: Collapse {} range accesses",
+                     static_cast<void *>(this), range_accesses_.size());
+  std::vector<RangeAccess> collapsed;
+  for (auto &access : range_accesses_) {
+    auto it = std::find_if(
+        collapsed.begin(), collapsed.end(), [&](const RangeAccess &c) {
+          return c.sem == access.sem && c.write == access.write;
+        });
+    if (it == collapsed.end()) {
+      collapsed.push_back(RangeAccess{
+          .range = TimelineResourceRange(),
+          .write = access.write,
+          .sem = access.sem,
+          .timepoint = access.timepoint,
+      });
+    } else {
+      it->timepoint = std::max(it->timepoint, access.timepoint);
+    }
+  }
+  range_accesses_ = std::move(collapsed);
+}
+
 void TimelineResource::use_barrier_insert(iree_hal_semaphore_t *sem,
                                           uint64_t timepoint) {
-  SHORTFIN_THROW_IF_ERROR(
-      iree_hal_fence_insert(use_barrier_fence_, sem, timepoint));
+  use_barrier_.insert(sem, timepoint);
 }
 
 iree_allocator_t TimelineResource::host_allocator() {
@@ -178,10 +772,21 @@ Scheduler::Scheduler(System &system) : system_(system) {
 Scheduler::~Scheduler() {
   logging::destruct("Scheduler", this);
 
-  // Explicitly reset account state prior to implicit destruction.
+  // Explicitly reset account state prior to implicit destruction. Cached
+  // buffers and pending deallocations must still be submitted so that the
+  // buffers are not released while in use.
   for (auto &account : accounts_) {
     account.Reset();
+    account.TrimBufferCache();
+    account.TrimStagingRing();
+    iree_status_ignore(account.FlushDeallocas());
   }
+
+  // Pooled resources have already been reset and hold no fiber reference.
+  for (TimelineResource *resource : timeline_resource_pool_) {
+    delete resource;
+  }
+  timeline_resource_pool_.clear();
 }
 
 void Scheduler::Initialize(
@@ -216,19 +821,208 @@ Account &Scheduler::GetDefaultAccount(ScopedDevice &device) {
   return *it->second;
 }
 
+Account &Scheduler::SelectAccount(ScopedDevice &device) {
+  iree_hal_queue_affinity_t queue_bits = device.affinity().queue_affinity();
+  if (std::popcount(queue_bits) <= 1 ||
+      (account_placement_ == AccountPlacement::LOWEST_QUEUE &&
+       priority_ == TransactionPriority::THROUGHPUT)) {
+    return GetDefaultAccount(device);
+  }
+
+  Device *raw_device = device.raw_device();
+  auto lookup = [&](int queue_ordinal) -> Account * {
+    auto it = accounts_by_device_id_.find(
+        raw_device->address().device_id_for_queue(queue_ordinal));
+    return it == accounts_by_device_id_.end() ? nullptr : it->second;
+  };
+
+  // Latency work gets the highest queue in the affinity to itself.
+  if (priority_ == TransactionPriority::LATENCY) {
+    Account *lane = lookup(63 - std::countl_zero(queue_bits));
+    if (lane) {
+      latency_lane_elected_ = true;
+      return *lane;
+    }
+    if (account_placement_ == AccountPlacement::LOWEST_QUEUE) {
+      return GetDefaultAccount(device);
+    }
+  }
+
+  // Continue any pending command buffer within the affinity.
+  for (auto bits = queue_bits; bits; bits &= bits - 1) {
+    Account *account = lookup(std::countr_zero(bits));
+    if (account && account->active_command_buffer_) return *account;
+  }
+
+  Account *elected = nullptr;
+  switch (account_placement_) {
+    case AccountPlacement::ROUND_ROBIN: {
+      int skip = placement_counter_++ % std::popcount(queue_bits);
+      auto bits = queue_bits;
+      while (skip-- > 0) bits &= bits - 1;
+      elected = lookup(std::countr_zero(bits));
+      break;
+    }
+    case AccountPlacement::LEAST_OUTSTANDING: {
+      uint64_t best_outstanding = UINT64_MAX;
+      for (auto bits = queue_bits; bits; bits &= bits - 1) {
+        Account *account = lookup(std::countr_zero(bits));
+        if (!account) continue;
+        uint64_t outstanding = account->outstanding_timepoints();
+        if (outstanding < best_outstanding) {
+          best_outstanding = outstanding;
+          elected = account;
+          if (outstanding == 0) break;
+        }
+      }
+      break;
+    }
+    case AccountPlacement::LOWEST_QUEUE:
+      break;
+  }
+  if (!elected) [[unlikely]] {
+    return GetDefaultAccount(device);
+  }
+  SHORTFIN_SCHED_LOG("SelectAccount(policy={}, queue_affinity={:x}) -> 0x{:x}",
+                     static_cast<int>(account_placement_), queue_bits,
+                     elected->id());
+  return *elected;
+}
+
+VoidFuture Scheduler::OnSync(ScopedDevice &device) {
+  if (active_capture_) [[unlikely]] {
+    // The captured work does not execute until EndCapture.
+    throw std::logic_error("Cannot wait on a device while capturing commands");
+  }
+  iree_hal_queue_affinity_t queue_bits = device.affinity().queue_affinity();
+  if (!spreads_queues() || std::popcount(queue_bits) <= 1) {
+    return GetDefaultAccount(device).OnSync();
+  }
+
+  // Work may have been placed on any account in the affinity, so join over
+  // all of them.
+  SHORTFIN_TRACE_SCOPE_NAMED("Scheduler::OnSync");
+  std::vector<iree::hal_semaphore_ptr> sems;
+  std::vector<uint64_t> timepoints;
+  for (auto bits = queue_bits; bits; bits &= bits - 1) {
+    auto it = accounts_by_device_id_.find(
+        device.raw_device()->address().device_id_for_queue(
+            std::countr_zero(bits)));
+    if (it == accounts_by_device_id_.end()) continue;
+    sems.push_back(it->second->sem_);
+    timepoints.push_back(it->second->idle_timepoint_);
+  }
+  VoidFuture future;
+  system_.blocking_executor().Schedule([sems = std::move(sems),
+                                        timepoints = std::move(timepoints),
+                                        future]() {
+    iree_status_t status = iree_ok_status();
+    for (size_t i = 0; i < sems.size() && iree_status_is_ok(status); ++i) {
+      status = iree_hal_semaphore_wait(sems[i], timepoints[i],
+                                       iree_infinite_timeout(),
+                                       IREE_HAL_WAIT_FLAG_DEFAULT);
+    }
+    if (!iree_status_is_ok(status)) {
+      const_cast<VoidFuture &>(future).set_failure(status);
+    } else {
+      const_cast<VoidFuture &>(future).set_success();
+    }
+  });
+  return future;
+}
+
+VoidFuture Scheduler::OnBarrier(iree_hal_semaphore_list_t barrier) {
+  if (active_capture_) [[unlikely]] {
+    throw std::logic_error("Cannot wait on a barrier while capturing commands");
+  }
+  SHORTFIN_TRACE_SCOPE_NAMED("Scheduler::OnBarrier");
+  // Only semaphores not already at their timepoint need a wait, which in the
+  // steady state (host consuming results a step behind the device) is none.
+  std::vector<iree::hal_semaphore_ptr> sems;
+  std::vector<uint64_t> timepoints;
+  for (iree_host_size_t i = 0; i < barrier.count; ++i) {
+    uint64_t current_value = 0;
+    SHORTFIN_THROW_IF_ERROR(
+        iree_hal_semaphore_query(barrier.semaphores[i], &current_value));
+    if (current_value >= barrier.payload_values[i]) continue;
+    sems.push_back(iree::hal_semaphore_ptr::borrow_reference(
+        barrier.semaphores[i]));
+    timepoints.push_back(barrier.payload_values[i]);
+  }
+  VoidFuture future;
+  if (sems.empty()) {
+    future.set_success();
+    return future;
+  }
+
+  // The timepoints may belong to a command buffer that has not been submitted
+  // yet.
+  Flush(FlushReason::SYNC);
+  // See the note on Account::OnSync: this should become a loop wait on
+  // iree_hal_semaphore_await once supported.
+  system_.blocking_executor().Schedule([sems = std::move(sems),
+                                        timepoints = std::move(timepoints),
+                                        future]() {
+    iree_status_t status = iree_ok_status();
+    for (size_t i = 0; i < sems.size() && iree_status_is_ok(status); ++i) {
+      status = iree_hal_semaphore_wait(sems[i], timepoints[i],
+                                       iree_infinite_timeout(),
+                                       IREE_HAL_WAIT_FLAG_DEFAULT);
+    }
+    if (!iree_status_is_ok(status)) {
+      const_cast<VoidFuture &>(future).set_failure(status);
+    } else {
+      const_cast<VoidFuture &>(future).set_success();
+    }
+  });
+  return future;
+}
+
 void Scheduler::AppendCommandBuffer(ScopedDevice &device,
                                     TransactionType tx_type,
                                     std::function<void(Account &)> callback) {
   SHORTFIN_TRACE_SCOPE_NAMED("Scheduler::AppendCommandBuffer");
-  Account &account = GetDefaultAccount(device);
-  auto needed_affinity_bits = device.affinity().queue_affinity();
+  CommandCapture *capture = active_capture_.get();
+  Account &account = capture ? capture->account_ : SelectAccount(device);
+  if (capture && device.raw_device()->hal_device() != account.hal_device())
+      [[unlikely]] {
+    throw std::logic_error(
+        fmt::format("Cannot record commands for device {} while capturing "
+                    "commands for device {}",
+                    device.to_s(), account.device()->name()));
+  }
+  // When placement may spread work across queues, pin the submission to the
+  // queue of the elected account so that its timeline reflects the hardware
+  // queue doing the work.
+  auto needed_affinity_bits = spreads_queues()
+                                  ? account.queue_affinity_bit()
+                                  : device.affinity().queue_affinity();
   SHORTFIN_SCHED_LOG(
       "AppendCommandBuffer(account=0x{:x}, tx_type={}, queue_affinity={}):",
       account.id(), static_cast<int>(tx_type), needed_affinity_bits);
 
+  // In batched mode, a sequential dispatch must stand alone and so breaks
+  // any batch in progress on either side of it.
+  if (tx_mode_ == TransactionMode::BATCHED && !capture &&
+      account.active_command_buffer_ &&
+      (tx_type == TransactionType::SEQUENTIAL_DISPATCH ||
+       account.active_tx_type_ == TransactionType::SEQUENTIAL_DISPATCH)) {
+    SHORTFIN_SCHED_LOG("  : Flush batch on transaction type change");
+    Flush(FlushReason::TX_TYPE_CHANGE);
+  }
+
+  // Latency work must not wait behind a pending throughput batch, so submit
+  // the batch ahead of it rather than joining it.
+  if (priority_ == TransactionPriority::LATENCY && !capture &&
+      account.active_command_buffer_) {
+    SHORTFIN_SCHED_LOG("  : Flush pending work ahead of latency transaction");
+    Flush(FlushReason::PRIORITY);
+  }
+
   // Initialize a fresh command buffer if needed.
   if (!account.active_command_buffer_) {
-    // Map to a command buffer category.
+    // Map to a command buffer category. Batches may mix transfers and
+    // dispatches, so they are always created with both categories.
     iree_hal_command_category_t category;
     switch (tx_type) {
       case TransactionType::TRANSFER:
@@ -242,27 +1036,30 @@ void Scheduler::AppendCommandBuffer(ScopedDevice &device,
         throw std::logic_error(fmt::format("Unsupported transaction type {}",
                                            static_cast<int>(tx_type)));
     }
+    if (tx_mode_ == TransactionMode::BATCHED || capture) {
+      category |= IREE_HAL_COMMAND_CATEGORY_TRANSFER |
+                  IREE_HAL_COMMAND_CATEGORY_DISPATCH;
+    }
 
     // Set up the command buffer.
     iree::hal_command_buffer_ptr new_cb;
-    iree::hal_fence_ptr new_active_deps;
-    SHORTFIN_THROW_IF_ERROR(
-        iree_hal_fence_create(semaphore_count_, system_.host_allocator(),
-                              new_active_deps.for_output()));
+    // Captured command buffers are reusable and reference buffers
+    // indirectly. Otherwise, never indirect so no bindings needed.
     SHORTFIN_THROW_IF_ERROR(iree_hal_command_buffer_create(
         account.hal_device(),
-        /*mode=*/IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
+        /*mode=*/capture ? IREE_HAL_COMMAND_BUFFER_MODE_DEFAULT
+                         : IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
         /*command_categories=*/category,
         /*queue_affinity=*/IREE_HAL_QUEUE_AFFINITY_ANY,
-        /*binding_capacity=*/0,  // Never indirect so no bindings needed.
+        /*binding_capacity=*/capture ? capture->binding_capacity_ : 0,
         new_cb.for_output()));
     SHORTFIN_THROW_IF_ERROR(iree_hal_command_buffer_begin(new_cb));
 
     // Memoize what mode we are in now.
     account.active_tx_type_ = tx_type;
     account.active_queue_affinity_bits_ = needed_affinity_bits;
-    account.active_deps_ = std::move(new_active_deps);
     account.active_command_buffer_ = std::move(new_cb);
+    account.active_begin_time_ns_ = iree_time_now();
 
     // Sence the command buffer will be submitted to signal the next
     // timepoint on the main timeline, we must depend on its current value
@@ -284,59 +1081,359 @@ void Scheduler::AppendCommandBuffer(ScopedDevice &device,
         "  : New command buffer (category={}, idle_timepoint={})", category,
         account.idle_timepoint_);
   } else {
-    SHORTFIN_SCHED_LOG("  : Continue active command buffer");
+    SHORTFIN_SCHED_LOG("  : Continue active command buffer (op={})",
+                       account.active_op_count_);
+    if (tx_type != TransactionType::TRANSFER) {
+      account.active_tx_type_ = tx_type;
+    }
+    account.active_queue_affinity_bits_ |= needed_affinity_bits;
   }
 
   // Perform the mutation.
   callback(account);
+  account.active_op_count_ += 1;
+  if (capture) {
+    // Captured work is only submitted by EndCapture.
+    capture->transaction_count_ += 1;
+    return;
+  }
 
   // Flush.
-  if (tx_mode_ == TransactionMode::EAGER) {
-    Flush();
+  if (priority_ == TransactionPriority::LATENCY) {
+    Flush(FlushReason::PRIORITY);
+    return;
   }
+  switch (tx_mode_) {
+    case TransactionMode::EAGER:
+      Flush(FlushReason::EAGER);
+      break;
+    case TransactionMode::BATCHED:
+      if (account.active_tx_type_ == TransactionType::SEQUENTIAL_DISPATCH ||
+          (batch_window_.max_ops &&
+           account.active_op_count_ >= batch_window_.max_ops) ||
+          (batch_window_.max_latency_us &&
+           iree_time_now() - account.active_begin_time_ns_ >=
+               static_cast<iree_time_t>(batch_window_.max_latency_us) *
+                   1000)) {
+        SHORTFIN_SCHED_LOG("  : Flush batch at window (ops={})",
+                           account.active_op_count_);
+        Flush(account.active_tx_type_ == TransactionType::SEQUENTIAL_DISPATCH
+                  ? FlushReason::TX_TYPE_CHANGE
+                  : FlushReason::BATCH_WINDOW);
+      }
+      break;
+    case TransactionMode::EXPLICIT:
+      break;
+  }
+}
+
+void Scheduler::set_transaction_mode(TransactionMode mode) {
+  if (mode == tx_mode_) return;
+  Flush(FlushReason::MODE_CHANGE);
+  tx_mode_ = mode;
 }
 
-iree_status_t Scheduler::FlushWithStatus() noexcept {
+iree_status_t Scheduler::FlushWithStatus(FlushReason reason) noexcept {
   SHORTFIN_TRACE_SCOPE_NAMED("Scheduler::FlushWithStatus");
   // This loop is optimized for a small number of accounts, where it is
   // fine to just linearly probe. If this ever becomes cumbersome, we can
   // maintain a dirty list which is appended to when an account transitions
   // from idle to active.
   for (Account &account : accounts_) {
-    if (!account.active_command_buffer_) continue;
-    iree_hal_semaphore_t *signal_sem = account.sem_;
-    uint64_t signal_timepoint = account.idle_timepoint_;
-    iree_hal_command_buffer_t *active_command_buffer =
-        account.active_command_buffer_;
-    iree_hal_buffer_binding_table_t binding_tables =
-        iree_hal_buffer_binding_table_empty();
+    // A capturing command buffer is only ever submitted by EndCapture.
+    if (account.capture_) continue;
+    if (account.active_command_buffer_) {
+      IREE_RETURN_IF_ERROR(SubmitActiveCommandBuffer(
+          account, iree_hal_buffer_binding_table_empty()));
+      account.stats_.flushes[static_cast<size_t>(reason)] += 1;
+      account.Reset();
+    }
+    IREE_RETURN_IF_ERROR(account.FlushDeallocas());
+  }
+  return iree_ok_status();
+}
 
-    SHORTFIN_SCHED_LOG(
-        "Flush command buffer (account=0x{:x}, queue_affinity={}, "
-        "signal_timepoint={}, deps={})",
-        account.id(), account.active_queue_affinity_bits_, signal_timepoint,
-        SummarizeFence(account.active_deps_));
-
-    // End recording and submit.
-    IREE_RETURN_IF_ERROR(iree_hal_command_buffer_end(active_command_buffer));
-    IREE_RETURN_IF_ERROR(iree_hal_device_queue_execute(
-        account.hal_device(),
-        /*queue_affinity=*/account.active_queue_affinity_bits_,
-        /*wait_sempahore_list=*/account.active_deps_
-            ? iree_hal_fence_semaphore_list(account.active_deps_)
-            : iree_hal_semaphore_list_empty(),
-        /*signal_semaphore_list=*/
-        iree_hal_semaphore_list_t{
-            .count = 1,
-            .semaphores = &signal_sem,
-            .payload_values = &signal_timepoint,
-        },
-        /*command_buffers=*/active_command_buffer,
-        /*binding_tables=*/binding_tables,
-        /*execute_flags=*/IREE_HAL_EXECUTE_FLAG_NONE));
+iree_status_t Scheduler::SubmitActiveCommandBuffer(
+    Account &account, iree_hal_buffer_binding_table_t binding_table) {
+  iree_hal_semaphore_t *signal_sem = account.sem_;
+  uint64_t signal_timepoint = account.idle_timepoint_;
+  iree_hal_command_buffer_t *active_command_buffer =
+      account.active_command_buffer_;
+
+  SHORTFIN_SCHED_LOG(
+      "Flush command buffer (account=0x{:x}, queue_affinity={}, "
+      "signal_timepoint={}, deps={})",
+      account.id(), account.active_queue_affinity_bits_, signal_timepoint,
+      account.active_deps_.to_s());
+
+  // End recording and submit.
+  IREE_RETURN_IF_ERROR(iree_hal_command_buffer_end(active_command_buffer));
+  IREE_RETURN_IF_ERROR(iree_hal_device_queue_execute(
+      account.hal_device(),
+      /*queue_affinity=*/account.active_queue_affinity_bits_,
+      /*wait_sempahore_list=*/account.active_deps_.semaphore_list(),
+      /*signal_semaphore_list=*/
+      iree_hal_semaphore_list_t{
+          .count = 1,
+          .semaphores = &signal_sem,
+          .payload_values = &signal_timepoint,
+      },
+      /*command_buffers=*/active_command_buffer,
+      /*binding_tables=*/binding_table,
+      /*execute_flags=*/IREE_HAL_EXECUTE_FLAG_NONE));
+
+  size_t dep_count = account.active_deps_.size();
+  iree_time_t pending_ns = iree_time_now() - account.active_begin_time_ns_;
+  account.stats_.RecordSubmission(account.active_op_count_, dep_count,
+                                  pending_ns);
+  SHORTFIN_TRACE_PLOT_VALUE_I64("shortfin.sched.submit_deps", dep_count);
+  SHORTFIN_TRACE_PLOT_VALUE_I64("shortfin.sched.submit_ops",
+                                account.active_op_count_);
+  SHORTFIN_TRACE_PLOT_VALUE_I64("shortfin.sched.submit_pending_ns",
+                                pending_ns);
+  return iree_ok_status();
+}
+
+void Scheduler::BeginCapture(ScopedDevice &device,
+                             iree_host_size_t binding_capacity) {
+  SHORTFIN_TRACE_SCOPE_NAMED("Scheduler::BeginCapture");
+  if (active_capture_) {
+    throw std::logic_error("A command capture is already in progress");
+  }
+  // Captured work starts from a clean command buffer.
+  Flush(FlushReason::SYNC);
+  Account &account = SelectAccount(device);
+  active_capture_.reset(new CommandCapture(account, binding_capacity));
+  account.capture_ = active_capture_.get();
+  SHORTFIN_SCHED_LOG("BeginCapture(account=0x{:x}, binding_capacity={})",
+                     account.id(), binding_capacity);
+}
+
+std::unique_ptr<CommandCapture> Scheduler::EndCapture() {
+  SHORTFIN_TRACE_SCOPE_NAMED("Scheduler::EndCapture");
+  if (!active_capture_) {
+    throw std::logic_error("No command capture is in progress");
+  }
+  std::unique_ptr<CommandCapture> capture = std::move(active_capture_);
+  Account &account = capture->account_;
+  account.capture_ = nullptr;
+  if (account.active_command_buffer_) {
+    // Execute once against the captured buffers, which satisfies the
+    // barriers that were advanced while recording.
+    std::vector<iree_hal_buffer_binding_t> bindings;
+    bindings.reserve(capture->slots_.size());
+    for (auto &slot : capture->slots_) {
+      bindings.push_back(iree_hal_buffer_binding_t{
+          .buffer = slot.capture_buffer.get(),
+          .offset = 0,
+          .length = IREE_HAL_WHOLE_BUFFER,
+      });
+    }
+    iree_status_t status = SubmitActiveCommandBuffer(
+        account,
+        iree_hal_buffer_binding_table_t{.count = bindings.size(),
+                                        .bindings = bindings.data()});
+    if (iree_status_is_ok(status)) {
+      account.stats_.replays += 1;
+      capture->command_buffer_ = std::move(account.active_command_buffer_);
+    }
     account.Reset();
+    SHORTFIN_THROW_IF_ERROR(status);
+    SHORTFIN_THROW_IF_ERROR(account.FlushDeallocas());
   }
-  return iree_ok_status();
+  for (auto &slot : capture->slots_) {
+    slot.capture_buffer.reset();
+  }
+  capture->finalized_ = true;
+  return capture;
+}
+
+void Scheduler::Replay(CommandCapture &capture,
+                       std::span<const CaptureBinding> bindings) {
+  SHORTFIN_TRACE_SCOPE_NAMED("Scheduler::Replay");
+  if (!capture.finalized_) {
+    throw std::logic_error("Cannot replay a command capture in progress");
+  }
+  if (bindings.size() != capture.slots_.size()) {
+    throw std::invalid_argument(
+        fmt::format("Command capture replay expected {} bindings but got {}",
+                    capture.slots_.size(), bindings.size()));
+  }
+  Account &account = capture.account_;
+  if (std::none_of(accounts_.begin(), accounts_.end(),
+                   [&](Account &candidate) { return &candidate == &account; })) {
+    throw std::invalid_argument(
+        "Command capture was recorded by a different fiber");
+  }
+  if (!capture.command_buffer_) return;  // Nothing was captured.
+
+  // Acquiring the signal timepoint flushes anything pending on the account,
+  // so the wait on the current idle timepoint below orders after it.
+  uint64_t signal_timepoint = account.timeline_acquire_timepoint();
+  uint64_t wait_timepoint = signal_timepoint - 1;
+  iree_hal_semaphore_t *timeline_sem = account.sem_;
+
+  SemaphoreJoin wait_join;
+  wait_join.insert(timeline_sem, wait_timepoint);
+  std::vector<iree_hal_buffer_binding_t> binding_list;
+  binding_list.reserve(bindings.size());
+  for (size_t i = 0; i < bindings.size(); ++i) {
+    auto &binding = bindings[i];
+    if (binding.resource) {
+      bool write = capture.slots_[i].write;
+      iree_hal_semaphore_list_t barrier =
+          binding.resource->range_tracking()
+              ? binding.resource->range_barrier(binding.range, write)
+          : write ? binding.resource->use_barrier()
+                  : binding.resource->mutation_barrier();
+      wait_join.insert(barrier);
+    }
+    binding_list.push_back(iree_hal_buffer_binding_t{
+        .buffer = binding.buffer,
+        .offset = 0,
+        .length = IREE_HAL_WHOLE_BUFFER,
+    });
+  }
+
+  iree_hal_semaphore_list_t wait_list = wait_join.semaphore_list();
+  SHORTFIN_SCHED_LOG("Replay(account=0x{:x}, signal_timepoint={}, deps={})",
+                     account.id(), signal_timepoint,
+                     wait_join.to_s());
+  SHORTFIN_THROW_IF_ERROR(iree_hal_device_queue_execute(
+      account.hal_device(), account.queue_affinity_bit(), wait_list,
+      iree_hal_semaphore_list_t{
+          .count = 1,
+          .semaphores = &timeline_sem,
+          .payload_values = &signal_timepoint,
+      },
+      capture.command_buffer_.get(),
+      iree_hal_buffer_binding_table_t{.count = binding_list.size(),
+                                      .bindings = binding_list.data()},
+      IREE_HAL_EXECUTE_FLAG_NONE));
+  account.stats_.RecordSubmission(capture.transaction_count_, wait_list.count,
+                                  /*pending_ns=*/0);
+  account.stats_.replays += 1;
+
+  // Advance the barriers of every bound resource to the replay.
+  for (size_t i = 0; i < bindings.size(); ++i) {
+    TimelineResource *resource = bindings[i].resource;
+    if (!resource) continue;
+    bool write = capture.slots_[i].write;
+    if (resource->range_tracking()) {
+      resource->range_insert(bindings[i].range, write, timeline_sem,
+                             signal_timepoint);
+    } else {
+      if (write) resource->set_mutation_barrier(timeline_sem, signal_timepoint);
+      resource->use_barrier_insert(timeline_sem, signal_timepoint);
+    }
+  }
+}
+
+std::string CommandCapture::to_s() const {
+  return fmt::format(
+      "CommandCapture(device={}, transactions={}, slots={}, finalized={})",
+      account_.device()->name(), transaction_count_, slots_.size(),
+      finalized_);
+}
+
+TimelineResource::Ref Scheduler::NewTimelineResource(
+    std::shared_ptr<Fiber> fiber, TimelineResourceDestructor destructor) {
+  if (timeline_resource_pool_.empty()) {
+    timeline_resource_pool_stats_.allocations += 1;
+    return TimelineResource::Ref(new TimelineResource(
+        std::move(fiber), std::move(destructor)));
+  }
+
+  TimelineResource *resource = timeline_resource_pool_.back();
+  timeline_resource_pool_.pop_back();
+  timeline_resource_pool_stats_.reuses += 1;
+  resource->fiber_ = std::move(fiber);
+  resource->destructor_ = std::move(destructor);
+  return TimelineResource::Ref(resource);
+}
+
+void Scheduler::RecycleTimelineResource(TimelineResource *resource) {
+  if (timeline_resource_pool_.size() >= timeline_resource_pool_capacity_) {
+    timeline_resource_pool_stats_.discards += 1;
+    delete resource;
+    return;
+  }
+  timeline_resource_pool_stats_.recycles += 1;
+  timeline_resource_pool_.push_back(resource);
+}
+
+void Scheduler::set_timeline_resource_pool_capacity(size_t capacity) {
+  timeline_resource_pool_capacity_ = capacity;
+  while (timeline_resource_pool_.size() > capacity) {
+    delete timeline_resource_pool_.back();
+    timeline_resource_pool_.pop_back();
+  }
+}
+
+SchedulerStats Scheduler::stats() const {
+  SchedulerStats stats;
+  for (const Account &account : accounts_) {
+    stats.Accumulate(account.stats_);
+  }
+  return stats;
+}
+
+std::vector<std::pair<std::string_view, SchedulerStats>>
+Scheduler::account_stats() const {
+  std::vector<std::pair<std::string_view, SchedulerStats>> results;
+  results.reserve(accounts_.size());
+  for (const Account &account : accounts_) {
+    results.emplace_back(account.device()->name(), account.stats_);
+  }
+  return results;
+}
+
+void Scheduler::ResetStats() {
+  for (Account &account : accounts_) {
+    account.stats_ = SchedulerStats();
+  }
+}
+
+void Scheduler::set_buffer_cache(BufferCache cache) {
+  buffer_cache_ = cache;
+  for (auto &account : accounts_) {
+    account.TrimBufferCache(cache.max_bytes);
+  }
+}
+
+iree_device_size_t Scheduler::BufferCacheSizeClass(
+    iree_device_size_t size) const {
+  return RoundToSizeClass(size, buffer_cache_.min_block_size);
+}
+
+void Scheduler::TrimBufferCaches() {
+  SHORTFIN_TRACE_SCOPE_NAMED("Scheduler::TrimBufferCaches");
+  for (auto &account : accounts_) {
+    account.TrimBufferCache();
+  }
+}
+
+iree_device_size_t Scheduler::buffer_cache_bytes() const {
+  iree_device_size_t total = 0;
+  for (auto &account : accounts_) {
+    total += account.cached_bytes();
+  }
+  return total;
+}
+
+void Scheduler::set_staging_ring(StagingRing ring) {
+  staging_ring_ = ring;
+  for (auto &account : accounts_) {
+    account.TrimStagingRing(ring.max_buffers, ring.max_bytes);
+  }
+}
+
+iree_device_size_t Scheduler::staging_ring_bytes() const {
+  iree_device_size_t total = 0;
+  for (auto &account : accounts_) {
+    total += account.staging_bytes();
+  }
+  return total;
 }
 
 iree::hal_fence_ptr Scheduler::NewFence() {
@@ -7,8 +7,12 @@
 #ifndef SHORTFIN_LOCAL_SCHEDULER_H
 #define SHORTFIN_LOCAL_SCHEDULER_H
 
+#include <array>
 #include <functional>
+#include <memory>
 #include <span>
+#include <string>
+#include <vector>
 
 #include "shortfin/local/async.h"
 #include "shortfin/local/device.h"
@@ -23,6 +27,7 @@ class System;
 namespace detail {
 
 class Account;
+class CommandCapture;
 class Scheduler;
 class TimelineResource;
 
@@ -52,8 +57,140 @@ enum class TransactionMode {
   EAGER = 0,
   // Pending command buffers are not flushed until explicitly set to do so.
   EXPLICIT = 1,
+  // Transactions are accumulated into a shared command buffer per account
+  // and flushed once the batch window (see Scheduler::BatchWindow) is
+  // exceeded, when a SEQUENTIAL_DISPATCH is encountered or when a sync point
+  // (i.e. an invocation or device sync) requires it. TRANSFER and
+  // PARALLEL_DISPATCH work may share a command buffer. Dependencies on work
+  // pending in the same command buffer are satisfied with an execution
+  // barrier instead of a semaphore wait.
+  BATCHED = 2,
 };
 
+// Policy for electing an Account when a ScopedDevice spans multiple queues.
+enum class AccountPlacement {
+  // Always elect the account of the lowest numbered queue. Fully
+  // deterministic and the default.
+  LOWEST_QUEUE = 0,
+  // Rotate through the queues in the affinity on each election.
+  ROUND_ROBIN = 1,
+  // Elect the queue with the fewest outstanding timepoints (the distance
+  // between its idle timepoint and the current semaphore value).
+  LEAST_OUTSTANDING = 2,
+};
+
+// Join over semaphore timepoints with the semantics of iree_hal_fence_insert
+// (each semaphore appears once, at the maximum timepoint inserted for it),
+// retaining each semaphore. The first kInlineCapacity entries are stored
+// inline, so that the common case of depending on one or two prior
+// timepoints neither allocates nor creates a fence. Clearing retains any
+// spilled capacity for reuse.
+class SHORTFIN_API SemaphoreJoin {
+ public:
+  static constexpr size_t kInlineCapacity = 2;
+
+  SemaphoreJoin() = default;
+  SemaphoreJoin(const SemaphoreJoin &) = delete;
+  SemaphoreJoin &operator=(const SemaphoreJoin &) = delete;
+  SemaphoreJoin(SemaphoreJoin &&other);
+  SemaphoreJoin &operator=(SemaphoreJoin &&other);
+  ~SemaphoreJoin() { clear(); }
+
+  void insert(iree_hal_semaphore_t *sem, uint64_t timepoint);
+  void insert(iree_hal_semaphore_list_t sem_list);
+  void clear();
+
+  size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  // The list is valid until the next mutation.
+  iree_hal_semaphore_list_t semaphore_list() {
+    return iree_hal_semaphore_list_t{
+        .count = count_, .semaphores = sems(), .payload_values = timepoints()};
+  }
+
+  std::string to_s() const;
+
+ private:
+  iree_hal_semaphore_t **sems() {
+    return spilled_ ? spilled_sems_.data() : inline_sems_;
+  }
+  uint64_t *timepoints() {
+    return spilled_ ? spilled_timepoints_.data() : inline_timepoints_;
+  }
+
+  size_t count_ = 0;
+  bool spilled_ = false;
+  iree_hal_semaphore_t *inline_sems_[kInlineCapacity];
+  uint64_t inline_timepoints_[kInlineCapacity];
+  std::vector<iree_hal_semaphore_t *> spilled_sems_;
+  std::vector<uint64_t> spilled_timepoints_;
+};
+
+// Priority class of transactions scheduled on a fiber. See
+// Scheduler::set_priority().
+enum class TransactionPriority {
+  // Default. Transactions are submitted per the TransactionMode.
+  THROUGHPUT = 0,
+  // Latency critical work (i.e. interactive decode steps). When the device
+  // affinity spans multiple queues, latency work is placed on the highest
+  // numbered queue so that it does not serialize behind throughput work on
+  // the others. On any queue, a pending throughput command buffer is
+  // submitted ahead of the latency transaction rather than joined, and
+  // latency transactions are always submitted eagerly.
+  LATENCY = 1,
+};
+
+// A byte range within the allocation tracked by a TimelineResource. The
+// default range covers the whole allocation.
+struct SHORTFIN_API TimelineResourceRange {
+  iree_device_size_t offset = 0;
+  iree_device_size_t length = IREE_HAL_WHOLE_BUFFER;
+
+  iree_device_size_t end() const {
+    return length == IREE_HAL_WHOLE_BUFFER ? IREE_HAL_WHOLE_BUFFER
+                                           : offset + length;
+  }
+  bool overlaps(const TimelineResourceRange &other) const {
+    return offset < other.end() && other.offset < end();
+  }
+  bool contains(const TimelineResourceRange &other) const {
+    return offset <= other.offset && other.end() <= end();
+  }
+};
+
+// Immutable snapshot of a barrier (semaphore timepoints) taken from a
+// TimelineResource so that it can be waited on device-side by a different
+// fiber. Unlike the TimelineResource it came from, it may be handed across
+// threads: it only holds retained semaphores (whose reference counting is
+// atomic) and is never mutated after construction.
+class SHORTFIN_API ExportedBarrier {
+ public:
+  ExportedBarrier() = default;
+  explicit ExportedBarrier(iree_hal_semaphore_list_t sem_list);
+
+  size_t size() const { return sems_.size(); }
+  bool empty() const { return sems_.empty(); }
+  iree_hal_semaphore_list_t semaphore_list() const {
+    return iree_hal_semaphore_list_t{
+        .count = sems_.size(),
+        .semaphores = const_cast<iree_hal_semaphore_t **>(sems_.data()),
+        .payload_values = const_cast<uint64_t *>(timepoints_.data())};
+  }
+
+  std::string to_s() const;
+
+ private:
+  std::vector<iree::hal_semaphore_ptr> retained_;
+  std::vector<iree_hal_semaphore_t *> sems_;
+  std::vector<uint64_t> timepoints_;
+};
+
+// Rounds |size| up to an allocation size class: a multiple of a quarter of
+// the next lower power of two, and at least |min_block_size|. Used by the
+// buffer caches so that nearby sizes share buffers.
+SHORTFIN_API iree_device_size_t RoundToSizeClass(
+    iree_device_size_t size, iree_device_size_t min_block_size);
+
 // Destructor callback to be invoked just before the timeline resource is
 // destroyed.
 using TimelineResourceDestructor = std::function<void(TimelineResource &)>;
@@ -130,8 +267,14 @@ class SHORTFIN_API TimelineResource {
 
   // Creates an asynchronous buffer destructor for this resource. When the
   // resource is about to be destroyed, an async dealloca will be issued at
-  // the use barrier.
+  // the use barrier. If |cacheable|, the buffer is instead offered to the
+  // account's buffer cache (see Account::CacheBuffer) for reuse.
   static TimelineResourceDestructor CreateAsyncBufferDestructor(
+      ScopedDevice &scoped_device, iree::hal_buffer_ptr buffer,
+      bool cacheable = false);
+  // Creates a destructor that returns a host staging buffer to the account's
+  // staging ring (see Account::ReturnStagingBuffer).
+  static TimelineResourceDestructor CreateStagingBufferDestructor(
       ScopedDevice &scoped_device, iree::hal_buffer_ptr buffer);
 
   // Sets the mutation barrier. The mutation barrier is the point on a timeline
@@ -139,10 +282,17 @@ class SHORTFIN_API TimelineResource {
   // Note that the semaphore set in this way is not retained as it is
   // assumed to be part of the local scheduler.
   void set_mutation_barrier(iree_hal_semaphore_t *sem, uint64_t timepoint) {
+    if (range_tracking_) [[unlikely]] {
+      range_insert(TimelineResourceRange(), /*write=*/true, sem, timepoint);
+      return;
+    }
     mutation_barrier_sem_ = sem;
     mutation_barrier_timepoint_ = timepoint;
   }
   iree_hal_semaphore_list_t mutation_barrier() {
+    if (range_tracking_) [[unlikely]] {
+      return range_barrier(TimelineResourceRange(), /*write=*/false);
+    }
     if (!mutation_barrier_sem_) {
       return iree_hal_semaphore_list_empty();
     } else {
@@ -159,22 +309,67 @@ class SHORTFIN_API TimelineResource {
   // semaphore list.
   void use_barrier_insert(iree_hal_semaphore_t *sem, uint64_t timepoint);
   iree_hal_semaphore_list_t use_barrier() {
-    return iree_hal_fence_semaphore_list(use_barrier_fence_);
+    return use_barrier_.semaphore_list();
   }
 
+  // Opt-in subrange tracking. By default, the resource behaves as a coarse
+  // reader/writer lock: one mutation barrier and one use barrier for the
+  // whole allocation. With range tracking enabled, accesses are recorded
+  // against byte ranges with their own semaphore/timepoint, so:
+  //   * Readers only wait on overlapping writes (from any number of sources).
+  //   * Writers wait on overlapping reads and writes.
+  //   * Accesses to disjoint ranges do not order against each other.
+  // The coarse mutation_barrier() and use_barrier() remain valid (joining
+  // over all ranges) for consumers that are not range aware. Enabling
+  // tracking seeds it from any existing coarse barriers and cannot be undone
+  // for the life of the resource.
+  void enable_range_tracking();
+  bool range_tracking() const { return range_tracking_; }
+
+  // Returns the semaphores that an access to |range| must wait on before
+  // proceeding. The returned list is only valid until the next call.
+  // Requires range tracking.
+  iree_hal_semaphore_list_t range_barrier(TimelineResourceRange range,
+                                          bool write);
+  // Records an access to |range| which completes at |sem|@|timepoint|. The
+  // caller must have ordered the access after range_barrier(range, write).
+  // Requires range tracking.
+  void range_insert(TimelineResourceRange range, bool write,
+                    iree_hal_semaphore_t *sem, uint64_t timepoint);
+
+  // Cross fiber sharing. ExportBarrier() snapshots the barrier that another
+  // fiber must wait on before reading the resource (the mutation barrier) or,
+  // if |include_uses|, before writing it (the use barrier).
+  // ImportBarrier() records an access to the resource made by another fiber
+  // which completes at |sem_list|, so that subsequent local accesses order
+  // after it: a |write| import is waited on by all accesses, a read import
+  // only by writers (including the eventual deallocation). Importing writes
+  // from multiple semaphores enables range tracking, since the coarse
+  // mutation barrier only holds one.
+  ExportedBarrier ExportBarrier(bool include_uses = false);
+  void ImportBarrier(iree_hal_semaphore_list_t sem_list, bool write);
+
   iree_allocator_t host_allocator();
 
   void Retain() { refcnt_++; }
   void Release() {
-    if (--refcnt_ == 0) delete this;
+    if (--refcnt_ == 0) Recycle();
   }
 
   Fiber *fiber() { return fiber_.get(); }
 
  private:
-  TimelineResource(std::shared_ptr<Fiber> fiber, size_t semaphore_capacity,
+  TimelineResource(std::shared_ptr<Fiber> fiber,
                    TimelineResourceDestructor destructor);
   ~TimelineResource();
+
+  // Invoked when the last reference is released. Runs the destructor callback,
+  // clears all barriers and returns the instance to the owning scheduler's
+  // pool (which may elect to delete it).
+  void Recycle();
+  // Clears the mutation and use barriers, releasing any retained semaphores.
+  void ResetBarriers();
+
   int refcnt_ = 0;
 
   // Back reference to the owning fiber.
@@ -186,15 +381,121 @@ class SHORTFIN_API TimelineResource {
   iree_hal_semaphore_t *mutation_barrier_sem_ = nullptr;
   uint64_t mutation_barrier_timepoint_ = 0;
 
-  // Use barrier fence. The fact that this is a fence object with a fixed
-  // capacity is an implementation detail.
-  iree::hal_fence_ptr use_barrier_fence_;
+  // Use barrier. This is functionally a fence but is kept inline so that its
+  // storage survives recycling without reallocation.
+  SemaphoreJoin use_barrier_;
+
+  // Range tracking state. Semaphores referenced by range accesses are always
+  // also part of the use barrier, which keeps them retained.
+  struct RangeAccess {
+    TimelineResourceRange range;
+    bool write;
+    iree_hal_semaphore_t *sem;
+    uint64_t timepoint;
+  };
+  // Beyond this many live range accesses, tracking collapses to whole-range
+  // accesses per semaphore (conservative but bounded).
+  static constexpr size_t kMaxRangeAccesses = 64;
+  void CollapseRangeAccesses();
+  bool range_tracking_ = false;
+  std::vector<RangeAccess> range_accesses_;
+  // Scratch storage backing the list returned from range_barrier().
+  std::vector<iree_hal_semaphore_t *> range_barrier_sems_;
+  std::vector<uint64_t> range_barrier_timepoints_;
 
   // Destructor to be called just prior to the TimelineResource being destroyed.
   TimelineResourceDestructor destructor_;
   friend class Scheduler;
 };
 
+// Counters for the per-fiber TimelineResource pool. Every call to
+// Scheduler::NewTimelineResource is counted as either an allocation or a
+// reuse, so the hit rate is `reuses / (allocations + reuses)`.
+struct SHORTFIN_API TimelineResourcePoolStats {
+  // Number of resources that had to be freshly heap allocated.
+  uint64_t allocations = 0;
+  // Number of resources that were satisfied from the pool.
+  uint64_t reuses = 0;
+  // Number of released resources that were returned to the pool.
+  uint64_t recycles = 0;
+  // Number of released resources that were deleted because the pool was at
+  // capacity.
+  uint64_t discards = 0;
+  // Number of resources currently idle in the pool.
+  size_t pooled = 0;
+
+  std::string to_s() const;
+};
+
+// Why a pending command buffer was flushed.
+enum class FlushReason {
+  // TransactionMode::EAGER flushes after every transaction.
+  EAGER = 0,
+  // TransactionMode::BATCHED window was exceeded.
+  BATCH_WINDOW = 1,
+  // A transaction type change required a standalone command buffer.
+  TX_TYPE_CHANGE = 2,
+  // An out-of-band timepoint was acquired on an account.
+  TIMEPOINT_ACQUIRE = 3,
+  // A sync point (device sync, program invocation).
+  SYNC = 4,
+  // The transaction mode was changed.
+  MODE_CHANGE = 5,
+  // Explicitly requested by the user.
+  EXPLICIT = 6,
+  // A TransactionPriority::LATENCY transaction was scheduled.
+  PRIORITY = 7,
+  COUNT = 8,
+};
+
+// Submission statistics gathered per Account and aggregated per Scheduler.
+// These are always collected (the cost is a handful of integer updates per
+// submission) so that batching can be tuned on production builds.
+struct SHORTFIN_API SchedulerStats {
+  // Buckets of the deps-per-submit histogram. Bucket i counts submissions
+  // whose wait list had a semaphore count in [kDepsBucketBounds[i-1],
+  // kDepsBucketBounds[i]), with the last bucket unbounded.
+  static constexpr size_t kDepsBucketCount = 6;
+  static constexpr std::array<uint32_t, kDepsBucketCount - 1>
+      kDepsBucketBounds = {1, 2, 3, 5, 9};
+
+  // Command buffers submitted.
+  uint64_t submissions = 0;
+  // Transactions recorded into submitted command buffers.
+  uint64_t transactions = 0;
+  // Command buffers submitted by flushes, by FlushReason.
+  std::array<uint64_t, static_cast<size_t>(FlushReason::COUNT)> flushes = {};
+  // Command buffers submitted on behalf of a CommandCapture (its initial
+  // execution and each replay).
+  uint64_t replays = 0;
+  // Buffers deallocated and the batches they were submitted in.
+  uint64_t deallocas = 0;
+  uint64_t dealloca_batches = 0;
+  // Device buffer cache activity (see Scheduler::BufferCache): allocations
+  // satisfied from the cache or not, buffers returned to it and buffers
+  // evicted from it to stay within budget (or trim).
+  uint64_t cache_hits = 0;
+  uint64_t cache_misses = 0;
+  uint64_t cache_returns = 0;
+  uint64_t cache_evictions = 0;
+  // Host staging ring activity (see Scheduler::StagingRing).
+  uint64_t staging_hits = 0;
+  uint64_t staging_misses = 0;
+  // Histogram of wait semaphore counts per submission.
+  std::array<uint64_t, kDepsBucketCount> deps_histogram = {};
+  // Host time between a command buffer acquiring its signal timepoint and
+  // being submitted to signal it.
+  uint64_t pending_ns_total = 0;
+  uint64_t pending_ns_max = 0;
+
+  // Records a submission. The caller separately counts it as a flush or
+  // replay.
+  void RecordSubmission(uint32_t transaction_count, size_t dep_count,
+                        uint64_t pending_ns);
+  void Accumulate(const SchedulerStats &other);
+  std::string to_s() const;
+};
+
 // Accounting structure for a single logical device (Device*), which
 // means that each addressable queue gets its own Account.
 class SHORTFIN_API Account {
@@ -202,6 +503,15 @@ class SHORTFIN_API Account {
   Account(Scheduler &scheduler, Device *device);
   Device *device() const { return device_; }
   iree_hal_device_t *hal_device() { return hal_device_; }
+  // The single queue affinity bit that this account schedules against.
+  iree_hal_queue_affinity_t queue_affinity_bit() const {
+    return static_cast<iree_hal_queue_affinity_t>(1)
+           << device_->address().queue_ordinal;
+  }
+
+  // Number of timepoints that have been handed out on this account's timeline
+  // but not yet reached. This queries the semaphore and is not free.
+  uint64_t outstanding_timepoints();
 
   size_t semaphore_count() const { return 1; }
   // Gets a unique integer id for this account. Currently just the address of
@@ -215,30 +525,105 @@ class SHORTFIN_API Account {
   }
 
   // Extend the current command buffer active deps to join over sem_list.
+  // Any dependency on the pending timepoint of this account (i.e. on work
+  // already recorded into the active command buffer) cannot be expressed as
+  // a wait and is instead satisfied by recording an execution barrier.
   void active_deps_extend(iree_hal_semaphore_list_t sem_list);
 
+  // Number of transactions recorded into the active command buffer.
+  uint32_t active_op_count() const { return active_op_count_; }
+
+  // Makes a buffer reference for recording a command against |buffer| into
+  // the active command buffer. When a command capture is in progress, the
+  // buffer is assigned a binding slot of the capture (|write| records whether
+  // the captured sequence mutates it) and an indirect reference is returned.
+  iree_hal_buffer_ref_t record_buffer_ref(iree_hal_buffer_t *buffer,
+                                          iree_device_size_t offset,
+                                          iree_device_size_t length,
+                                          bool write);
+
   // Queue timeline.
   iree_hal_semaphore_t *timeline_sem() { return sem_; }
   uint64_t timeline_idle_timepoint() { return idle_timepoint_; }
-  uint64_t timeline_acquire_timepoint() { return ++idle_timepoint_; }
+  // Acquires a new timepoint for out-of-band signaling (i.e. queue
+  // operations that are not part of a command buffer). Any pending command
+  // buffer is flushed first, since it will signal the current idle timepoint.
+  uint64_t timeline_acquire_timepoint();
 
   // Returns a future that is satisfied when the timeline of this account
   // reaches its current idle timepoint (i.e. all currently pending work
   // is complete).
   VoidFuture OnSync();
 
+  // Defers a queue deallocation of |buffer| until |wait_list| is reached.
+  // Pending deallocations are batched per account (see
+  // Scheduler::DeallocaBatch) and submitted waiting on the join of all of
+  // their wait lists, after the next command buffer submission, out-of-band
+  // timepoint acquisition or sync, or once the batch is full or stale.
+  void DeferDealloca(iree::hal_buffer_ptr buffer,
+                     iree_hal_queue_affinity_t queue_affinity,
+                     iree_hal_semaphore_list_t wait_list);
+  size_t pending_dealloca_count() const { return pending_deallocas_.size(); }
+
+  // Device buffer cache. Buffers are cached by size class and queue
+  // affinity along with the barrier at which their last use completes, so a
+  // cached buffer can be handed out immediately and the new owner orders
+  // after that barrier device-side.
+  // Takes a cached buffer, returning false if none matches. On success,
+  // |ready_sem|@|ready_timepoint| is the barrier to order after (|ready_sem|
+  // is null if there is none).
+  bool TakeCachedBuffer(iree_hal_queue_affinity_t queue_affinity,
+                        iree_device_size_t size_class,
+                        iree::hal_buffer_ptr &buffer,
+                        iree::hal_semaphore_ptr &ready_sem,
+                        uint64_t &ready_timepoint);
+  // Offers a buffer whose uses complete at |use_barrier| to the cache,
+  // evicting the least recently returned buffers to stay within budget.
+  // Returns false if it was not cached, in which case the caller must
+  // deallocate it.
+  bool CacheBuffer(iree::hal_buffer_ptr &buffer,
+                   iree_hal_queue_affinity_t queue_affinity,
+                   iree_hal_semaphore_list_t use_barrier);
+  // Evicts cached buffers until at most |max_bytes| remain cached.
+  void TrimBufferCache(iree_device_size_t max_bytes = 0);
+  iree_device_size_t cached_bytes() const { return cached_bytes_; }
+
+  // Host staging ring. Unlike device buffers, staging buffers are accessed
+  // directly by the host through mappings, so a returned buffer is only
+  // handed out again once its last use has been reached on the device (as
+  // observed by a non-blocking semaphore query).
+  bool TakeStagingBuffer(iree_hal_queue_affinity_t queue_affinity,
+                         iree_device_size_t size_class,
+                         iree::hal_buffer_ptr &buffer);
+  void ReturnStagingBuffer(iree::hal_buffer_ptr &buffer,
+                           iree_hal_queue_affinity_t queue_affinity,
+                           iree_hal_semaphore_list_t use_barrier);
+  // Releases the oldest staging buffers until within the given limits.
+  void TrimStagingRing(uint32_t max_buffers = 0,
+                       iree_device_size_t max_bytes = 0);
+  iree_device_size_t staging_bytes() const { return staging_bytes_; }
+
+  // Submission statistics for this account.
+  const SchedulerStats &stats() const { return stats_; }
+
  private:
   void Initialize();
   void Reset();
   Scheduler &scheduler_;
   iree::hal_semaphore_ptr sem_;
-  iree::hal_fence_ptr active_deps_;
+  SemaphoreJoin active_deps_;
   iree::hal_command_buffer_ptr active_command_buffer_;
 
   Device *device_;
   iree_hal_device_t *hal_device_;
   TransactionType active_tx_type_ = TransactionType::NONE;
   iree_hal_queue_affinity_t active_queue_affinity_bits_;
+  // Batch window accounting for the active command buffer.
+  uint32_t active_op_count_ = 0;
+  iree_time_t active_begin_time_ns_ = 0;
+  // Op count at which the last intra-command buffer barrier was recorded, so
+  // that multiple hazards detected for one transaction emit one barrier.
+  uint32_t active_barrier_op_ = UINT32_MAX;
 
   // Timepoint at which this device is considered idle, inclusive of any
   // active_command_buffer that has not yet been submitted. This means
@@ -255,6 +640,79 @@ class SHORTFIN_API Account {
   // an eventual submission would submit a duplicate timepoint). This
   // timepoint is only valid for the local sem_.
   uint64_t idle_timepoint_ = 0;
+  SchedulerStats stats_;
+  // Non-null while a command capture is recording on this account.
+  CommandCapture *capture_ = nullptr;
+
+  // Submits all pending deallocations. Must not be called with an active
+  // command buffer, since the joined wait list may include its timepoint.
+  iree_status_t FlushDeallocas() noexcept;
+  struct PendingDealloca {
+    iree::hal_buffer_ptr buffer;
+    iree_hal_queue_affinity_t queue_affinity;
+  };
+  std::vector<PendingDealloca> pending_deallocas_;
+  SemaphoreJoin pending_dealloca_waits_;
+  iree_time_t pending_dealloca_begin_ns_ = 0;
+
+  // Cached buffers in the order they were returned.
+  struct CachedBuffer {
+    iree::hal_buffer_ptr buffer;
+    iree_hal_queue_affinity_t queue_affinity;
+    iree_device_size_t size;
+    iree::hal_semaphore_ptr ready_sem;
+    uint64_t ready_timepoint;
+  };
+  std::vector<CachedBuffer> cached_buffers_;
+  iree_device_size_t cached_bytes_ = 0;
+  std::vector<CachedBuffer> staging_buffers_;
+  iree_device_size_t staging_bytes_ = 0;
+  friend class Scheduler;
+};
+
+// A buffer bound to a binding slot of a CommandCapture when replaying it.
+struct SHORTFIN_API CaptureBinding {
+  iree_hal_buffer_t *buffer;
+  TimelineResource *resource;
+  // Range of |resource| covered by |buffer| when it is range tracked.
+  TimelineResourceRange range;
+};
+
+// A sequence of transactions recorded once into a reusable command buffer
+// with indirect buffer bindings, which can be replayed against different
+// buffers without re-recording. See Scheduler::BeginCapture.
+class SHORTFIN_API CommandCapture {
+ public:
+  CommandCapture(const CommandCapture &) = delete;
+  CommandCapture &operator=(const CommandCapture &) = delete;
+
+  // Number of binding slots. Buffers are assigned slots in the order they
+  // were first referenced while capturing.
+  size_t slot_count() const { return slots_.size(); }
+  // Whether the captured sequence writes to the buffer in |slot|.
+  bool slot_writable(size_t slot) const { return slots_[slot].write; }
+  // Number of transactions recorded.
+  uint32_t transaction_count() const { return transaction_count_; }
+  // Whether capture has completed and the sequence can be replayed.
+  bool finalized() const { return finalized_; }
+
+  std::string to_s() const;
+
+ private:
+  CommandCapture(Account &account, iree_host_size_t binding_capacity)
+      : account_(account), binding_capacity_(binding_capacity) {}
+  struct Slot {
+    // Only retained while capturing, for the initial execution.
+    iree::hal_buffer_ptr capture_buffer;
+    bool write = false;
+  };
+  Account &account_;
+  iree_host_size_t binding_capacity_;
+  iree::hal_command_buffer_ptr command_buffer_;
+  std::vector<Slot> slots_;
+  uint32_t transaction_count_ = 0;
+  bool finalized_ = false;
+  friend class Account;
   friend class Scheduler;
 };
 
@@ -265,12 +723,96 @@ class SHORTFIN_API Scheduler {
   ~Scheduler();
 
   TransactionMode transaction_mode() const { return tx_mode_; }
+  // Changes the transaction mode, flushing any pending work first.
+  void set_transaction_mode(TransactionMode mode);
+
+  // Limits on how much work TransactionMode::BATCHED will accumulate into a
+  // single command buffer before flushing. A limit of zero is unbounded.
+  // The latency limit is evaluated as transactions are appended (there is no
+  // background timer), so it bounds how stale a batch can get while work is
+  // still arriving. Sync points always flush regardless of the window.
+  struct BatchWindow {
+    uint32_t max_ops = 64;
+    uint64_t max_latency_us = 100;
+  };
+  const BatchWindow &batch_window() const { return batch_window_; }
+  void set_batch_window(BatchWindow window) { batch_window_ = window; }
+
+  // Limits for batching async buffer deallocations (see
+  // Account::DeferDealloca). A batch is submitted once it holds |max_buffers|
+  // or its oldest entry is older than |max_latency_us| when another is
+  // added. As with BatchWindow, there is no background timer. A
+  // |max_buffers| of 1 submits every deallocation immediately.
+  struct DeallocaBatch {
+    uint32_t max_buffers = 64;
+    uint64_t max_latency_us = 1000;
+  };
+  const DeallocaBatch &dealloca_batch() const { return dealloca_batch_; }
+  void set_dealloca_batch(DeallocaBatch batch) { dealloca_batch_ = batch; }
+
+  // Device buffer cache used by storage::allocate_device. Disabled when
+  // |max_bytes| (the budget per account) is 0, which is the default.
+  // Requests are rounded up to a size class (see RoundToSizeClass).
+  struct BufferCache {
+    iree_device_size_t max_bytes = 0;
+    iree_device_size_t min_block_size = 256;
+  };
+  const BufferCache &buffer_cache() const { return buffer_cache_; }
+  // Changes the budget, trimming accounts that exceed it.
+  void set_buffer_cache(BufferCache cache);
+  iree_device_size_t BufferCacheSizeClass(iree_device_size_t size) const;
+  // Evicts all cached buffers (i.e. under memory pressure).
+  void TrimBufferCaches();
+  // Total bytes cached across all accounts.
+  iree_device_size_t buffer_cache_bytes() const;
+
+  // Ring of pinned host staging buffers per account, drawn from by
+  // storage::allocate_staging (and so device_array::for_transfer). Buffers
+  // are recycled once their last transfer has completed. Disabled when
+  // |max_buffers| is 0.
+  struct StagingRing {
+    uint32_t max_buffers = 16;
+    iree_device_size_t max_bytes = 64 * 1024 * 1024;
+    iree_device_size_t min_block_size = 4096;
+  };
+  const StagingRing &staging_ring() const { return staging_ring_; }
+  // Changes the limits, trimming accounts that exceed them.
+  void set_staging_ring(StagingRing ring);
+  iree_device_size_t staging_ring_bytes() const;
 
   // Given a ScopedDevice (which may logically bind to multiple queues),
   // returns a deterministic Account associated with the device that can be
   // used for accounting and scheduling.
   Account &GetDefaultAccount(ScopedDevice &device);
 
+  // Elects an Account for scheduling new work against |device| according to
+  // the placement policy. If an account within the affinity already has
+  // a pending command buffer, it is preferred so that batching is retained.
+  // Under the default LOWEST_QUEUE policy this is the same as
+  // GetDefaultAccount. Work placed on different accounts remains correctly
+  // ordered since TimelineResource barriers record the semaphore they were
+  // signaled on.
+  Account &SelectAccount(ScopedDevice &device);
+
+  AccountPlacement account_placement() const { return account_placement_; }
+  void set_account_placement(AccountPlacement placement) {
+    account_placement_ = placement;
+  }
+
+  // Priority class applied to subsequently scheduled transactions and
+  // program invocations (which elect their account via SelectAccount).
+  TransactionPriority priority() const { return priority_; }
+  void set_priority(TransactionPriority priority) { priority_ = priority; }
+
+  // Returns a future that is satisfied when all work currently scheduled on
+  // any account that |device| may have been placed on is complete.
+  VoidFuture OnSync(ScopedDevice &device);
+  // Returns a future that is satisfied once every semaphore in |barrier| has
+  // reached its timepoint, without blocking the worker. Pending command
+  // buffers are flushed if the barrier is not already satisfied. The
+  // semaphores are retained for the duration of the wait.
+  VoidFuture OnBarrier(iree_hal_semaphore_list_t barrier);
+
   // Sets up |device| for appending commands to a command buffer, invoking
   // callback to complete the mutation. Depending on the current transaction
   // mode and tx_type, this may involve flushing the current command buffer.
@@ -281,28 +823,73 @@ class SHORTFIN_API Scheduler {
                            std::function<void(Account &)> callback);
 
   // Flushes any pending accounts that have accumulated commands.
-  iree_status_t FlushWithStatus() noexcept;
-  void Flush() { SHORTFIN_THROW_IF_ERROR(FlushWithStatus()); }
+  iree_status_t FlushWithStatus(
+      FlushReason reason = FlushReason::SYNC) noexcept;
+  void Flush(FlushReason reason = FlushReason::SYNC) {
+    SHORTFIN_THROW_IF_ERROR(FlushWithStatus(reason));
+  }
+
+  // Submission statistics aggregated over all accounts.
+  SchedulerStats stats() const;
+  // Per-account statistics, in account order.
+  std::vector<std::pair<std::string_view, SchedulerStats>> account_stats()
+      const;
+  void ResetStats();
 
   // Gets a fresh TimelineResource which can be used for tracking resource
-  // read/write and setting barriers. Note that these are all allocated fresh
-  // on each call today but may be pooled in the future.
+  // read/write and setting barriers. Released resources are recycled into a
+  // per-scheduler free-list and handed out again here with their barriers
+  // reset, avoiding heap traffic on hot allocation paths.
   TimelineResource::Ref NewTimelineResource(
       std::shared_ptr<Fiber> fiber,
-      TimelineResourceDestructor destructor = nullptr) {
-    return TimelineResource::Ref(new TimelineResource(
-        std::move(fiber), semaphore_count_, std::move(destructor)));
+      TimelineResourceDestructor destructor = nullptr);
+
+  // Maximum number of idle TimelineResources retained for reuse. Lowering
+  // the capacity trims the pool immediately.
+  size_t timeline_resource_pool_capacity() const {
+    return timeline_resource_pool_capacity_;
+  }
+  void set_timeline_resource_pool_capacity(size_t capacity);
+  TimelineResourcePoolStats timeline_resource_pool_stats() const {
+    TimelineResourcePoolStats stats = timeline_resource_pool_stats_;
+    stats.pooled = timeline_resource_pool_.size();
+    return stats;
   }
 
   // Creates a new fence with capacity for all semaphores that are extant at
   // the point of the call.
   iree::hal_fence_ptr NewFence();
 
+  // Command capture. While capturing, transactions appended for |device| are
+  // recorded into a reusable command buffer (with up to |binding_capacity|
+  // distinct buffers bound indirectly) instead of being flushed according to
+  // the transaction mode. EndCapture() submits the sequence once so that the
+  // barriers recorded while capturing are satisfied, and returns it for
+  // replay. Only one capture can be active per scheduler and transactions
+  // targeting other accounts while capturing are errors.
+  void BeginCapture(ScopedDevice &device, iree_host_size_t binding_capacity);
+  std::unique_ptr<CommandCapture> EndCapture();
+  bool capturing() const { return active_capture_ != nullptr; }
+
+  // Submits a previously captured sequence with |bindings| (one per slot)
+  // substituted for the buffers it was captured against. Each binding waits
+  // on its resource's barriers per the slot's access and then has its
+  // barriers advanced to the replay's signal timepoint. The capture must not
+  // outlive the fiber that created it.
+  void Replay(CommandCapture &capture, std::span<const CaptureBinding> bindings);
+
   System &system() { return system_; }
 
  private:
   void Initialize(
       std::span<const std::pair<std::string_view, Device *>> devices);
+  // Accepts a TimelineResource whose last reference has been released,
+  // either retaining it for reuse or deleting it.
+  void RecycleTimelineResource(TimelineResource *resource);
+  // Ends and submits the active command buffer of |account|, signaling its
+  // idle timepoint, and records statistics. Does not reset the account.
+  iree_status_t SubmitActiveCommandBuffer(
+      Account &account, iree_hal_buffer_binding_table_t binding_table);
   System &system_;
 
   // Each distinct hal device gets an account.
@@ -314,8 +901,37 @@ class SHORTFIN_API Scheduler {
   // Transaction management.
   TransactionMode tx_mode_ = TransactionMode::EAGER;
   TransactionType current_tx_type_ = TransactionType::NONE;
+  BatchWindow batch_window_;
+  DeallocaBatch dealloca_batch_;
+  BufferCache buffer_cache_;
+  StagingRing staging_ring_;
+
+  // Account placement.
+  AccountPlacement account_placement_ = AccountPlacement::LOWEST_QUEUE;
+  uint64_t placement_counter_ = 0;
+
+  // Priority lanes.
+  TransactionPriority priority_ = TransactionPriority::THROUGHPUT;
+  // Set once a latency lane has been elected on a queue other than the
+  // default, after which work may be spread across queues regardless of the
+  // placement policy.
+  bool latency_lane_elected_ = false;
+  bool spreads_queues() const {
+    return account_placement_ != AccountPlacement::LOWEST_QUEUE ||
+           latency_lane_elected_;
+  }
+
+  // Capture in progress (owned until EndCapture).
+  std::unique_ptr<CommandCapture> active_capture_;
+
+  // Free-list of idle TimelineResources. Pooled resources hold no fiber
+  // reference (which would otherwise be a cycle back to this scheduler).
+  std::vector<TimelineResource *> timeline_resource_pool_;
+  size_t timeline_resource_pool_capacity_ = 256;
+  TimelineResourcePoolStats timeline_resource_pool_stats_;
 
   friend class local::Fiber;
+  friend class TimelineResource;
 };
 
 }  // namespace detail
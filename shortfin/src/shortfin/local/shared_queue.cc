@@ -0,0 +1,475 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/local/shared_queue.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#include "shortfin/local/worker.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace shortfin::local {
+
+namespace detail {
+
+// Layout of the shared memory: the header, then `capacity` slots of
+// `slot_bytes` each. Everything in it must be address free, since every
+// process maps it at its own address.
+struct SharedQueueHeader {
+  static constexpr uint64_t kMagic = 0x4555455551465353;  // "SSFQUEUE"
+  static constexpr uint32_t kVersion = 1;
+
+  uint64_t magic;
+  uint32_t version;
+  uint32_t capacity;
+  uint32_t max_tokens;
+  uint32_t slot_bytes;
+  // As in mpsc_ring, writers and the reader are kept on separate cache lines.
+  alignas(64) std::atomic<uint64_t> enqueue_pos;
+  alignas(64) std::atomic<uint64_t> dequeue_pos;
+  std::atomic<uint32_t> reader_waiting;
+  std::atomic<uint32_t> reader_attached;
+  std::atomic<uint32_t> closed;
+};
+
+struct SharedQueueSlot {
+  static constexpr uint32_t kAbandoned = 1;
+
+  // mpsc_ring sequence: pos when free for the writer of ticket pos, pos + 1
+  // once published.
+  std::atomic<uint64_t> seq;
+  uint64_t tag;
+  uint32_t token_count;
+  uint32_t flags;
+
+  int32_t *tokens() { return reinterpret_cast<int32_t *>(this + 1); }
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "SharedQueue needs address free atomics");
+
+}  // namespace detail
+
+using detail::SharedQueueHeader;
+using detail::SharedQueueSlot;
+
+namespace {
+
+constexpr size_t kHeaderBytes = (sizeof(SharedQueueHeader) + 63) / 64 * 64;
+
+[[noreturn]] void ThrowErrno(const char *what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------- //
+// SharedQueue
+// -------------------------------------------------------------------------- //
+
+#ifdef __linux__
+
+std::shared_ptr<SharedQueue> SharedQueue::Create(Options options) {
+  if (options.max_tokens == 0 || options.max_tokens > UINT32_MAX) {
+    throw std::invalid_argument("SharedQueue max_tokens must be positive");
+  }
+  size_t capacity = std::bit_ceil(std::max<size_t>(options.capacity, 2));
+  if (capacity > UINT32_MAX) {
+    throw std::invalid_argument("SharedQueue capacity is too large");
+  }
+  size_t slot_bytes =
+      (sizeof(SharedQueueSlot) + options.max_tokens * sizeof(int32_t) + 63) /
+      64 * 64;
+  size_t memory_size = kHeaderBytes + capacity * slot_bytes;
+
+  int memory_fd = memfd_create("shortfin-queue", MFD_CLOEXEC);
+  if (memory_fd < 0) ThrowErrno("memfd_create");
+  if (ftruncate(memory_fd, memory_size) != 0) {
+    close(memory_fd);
+    ThrowErrno("ftruncate");
+  }
+  int event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (event_fd < 0) {
+    close(memory_fd);
+    ThrowErrno("eventfd");
+  }
+  void *memory = mmap(nullptr, memory_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, memory_fd, 0);
+  if (memory == MAP_FAILED) {
+    close(memory_fd);
+    close(event_fd);
+    ThrowErrno("mmap");
+  }
+
+  auto *header = new (memory) SharedQueueHeader{};
+  header->capacity = capacity;
+  header->max_tokens = options.max_tokens;
+  header->slot_bytes = slot_bytes;
+  std::shared_ptr<SharedQueue> queue(
+      new SharedQueue(memory_fd, event_fd, memory, memory_size));
+  for (uint64_t i = 0; i < capacity; ++i) {
+    auto *slot = new (&queue->slot(i)) SharedQueueSlot{};
+    slot->seq.store(i, std::memory_order_relaxed);
+  }
+  // Publishes the layout to processes that open the queue.
+  header->version = SharedQueueHeader::kVersion;
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = SharedQueueHeader::kMagic;
+  return queue;
+}
+
+std::shared_ptr<SharedQueue> SharedQueue::Open(int memory_fd, int event_fd) {
+  struct stat st;
+  if (fstat(memory_fd, &st) != 0) ThrowErrno("fstat");
+  size_t memory_size = st.st_size;
+  if (memory_size < kHeaderBytes) {
+    throw std::invalid_argument("Not a SharedQueue memory fd");
+  }
+  int owned_memory_fd = fcntl(memory_fd, F_DUPFD_CLOEXEC, 0);
+  if (owned_memory_fd < 0) ThrowErrno("dup");
+  int owned_event_fd = fcntl(event_fd, F_DUPFD_CLOEXEC, 0);
+  if (owned_event_fd < 0) {
+    close(owned_memory_fd);
+    ThrowErrno("dup");
+  }
+  void *memory = mmap(nullptr, memory_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, owned_memory_fd, 0);
+  if (memory == MAP_FAILED) {
+    close(owned_memory_fd);
+    close(owned_event_fd);
+    ThrowErrno("mmap");
+  }
+  std::shared_ptr<SharedQueue> queue(
+      new SharedQueue(owned_memory_fd, owned_event_fd, memory, memory_size));
+  SharedQueueHeader &header = queue->header();
+  if (header.magic != SharedQueueHeader::kMagic ||
+      header.version != SharedQueueHeader::kVersion ||
+      memory_size <
+          kHeaderBytes + static_cast<size_t>(header.capacity) *
+                             header.slot_bytes) {
+    throw std::invalid_argument("Not a SharedQueue memory fd");
+  }
+  return queue;
+}
+
+SharedQueue::SharedQueue(int memory_fd, int event_fd, void *memory,
+                         size_t memory_size)
+    : memory_fd_(memory_fd),
+      event_fd_(event_fd),
+      memory_(memory),
+      memory_size_(memory_size) {
+  iree_wait_primitive_value_t value;
+  std::memset(&value, 0, sizeof(value));
+  value.event.fd = event_fd;
+  SHORTFIN_THROW_IF_ERROR(iree_wait_handle_wrap_primitive(
+      IREE_WAIT_PRIMITIVE_TYPE_EVENT_FD, value, &event_handle_));
+}
+
+SharedQueue::~SharedQueue() {
+  munmap(memory_, memory_size_);
+  close(memory_fd_);
+  close(event_fd_);
+}
+
+void SharedQueue::Signal() {
+  uint64_t one = 1;
+  // The only failure of a nonblocking eventfd write is a saturated counter,
+  // which already wakes the reader.
+  [[maybe_unused]] ssize_t written = write(event_fd_, &one, sizeof(one));
+}
+
+void SharedQueue::ResetEvent() {
+  uint64_t count;
+  [[maybe_unused]] ssize_t consumed = read(event_fd_, &count, sizeof(count));
+}
+
+#else
+
+std::shared_ptr<SharedQueue> SharedQueue::Create(Options options) {
+  throw std::logic_error("SharedQueue is only supported on Linux");
+}
+
+std::shared_ptr<SharedQueue> SharedQueue::Open(int memory_fd, int event_fd) {
+  throw std::logic_error("SharedQueue is only supported on Linux");
+}
+
+SharedQueue::~SharedQueue() = default;
+void SharedQueue::Signal() {}
+void SharedQueue::ResetEvent() {}
+
+#endif  // __linux__
+
+SharedQueueHeader &SharedQueue::header() const {
+  return *static_cast<SharedQueueHeader *>(memory_);
+}
+
+SharedQueueSlot &SharedQueue::slot(uint64_t pos) const {
+  SharedQueueHeader &h = header();
+  char *slots = static_cast<char *>(memory_) + kHeaderBytes;
+  return *reinterpret_cast<SharedQueueSlot *>(
+      slots + (pos & (h.capacity - 1)) * h.slot_bytes);
+}
+
+size_t SharedQueue::capacity() const { return header().capacity; }
+
+size_t SharedQueue::max_tokens() const { return header().max_tokens; }
+
+std::string SharedQueue::to_s() const {
+  return fmt::format("SharedQueue(capacity={}, max_tokens={}, memory_fd={})",
+                     capacity(), max_tokens(), memory_fd_);
+}
+
+void SharedQueue::Close() {
+  header().closed.store(1, std::memory_order_release);
+  Signal();
+}
+
+bool SharedQueue::is_closed() const {
+  return header().closed.load(std::memory_order_acquire) != 0;
+}
+
+Message::Ref SharedQueue::TryPop() {
+  SharedQueueHeader &h = header();
+  for (;;) {
+    uint64_t pos = h.dequeue_pos.load(std::memory_order_relaxed);
+    SharedQueueSlot &s = slot(pos);
+    if (s.seq.load(std::memory_order_acquire) != pos + 1) {
+      return Message::Ref();
+    }
+    h.dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+    if (s.flags & SharedQueueSlot::kAbandoned) {
+      s.seq.store(pos + h.capacity, std::memory_order_release);
+      continue;
+    }
+    return Message::Ref::Adopt(new SharedQueueMessage(shared_from_this(), pos));
+  }
+}
+
+namespace {
+
+// Owned by the wait of a SharedQueueReader::Read.
+struct SharedQueueWaitState {
+  std::shared_ptr<SharedQueue> queue;
+  Worker *worker;
+  MessageFuture future;
+};
+
+}  // namespace
+
+iree_status_t SharedQueue::OnWake(void *state_vp, iree_loop_t loop,
+                                  iree_status_t status) noexcept {
+  std::unique_ptr<SharedQueueWaitState> state(
+      static_cast<SharedQueueWaitState *>(state_vp));
+  if (!iree_status_is_ok(status)) {
+    state->queue->header().reader_waiting.store(0, std::memory_order_relaxed);
+    state->future.set_failure(status);
+    return iree_ok_status();
+  }
+  SharedQueue &queue = *state->queue;
+  // Consume the signal before checking the ring, so that one for a message
+  // published after the check is not lost.
+  queue.ResetEvent();
+  Message::Ref message = queue.TryPop();
+  if (message || queue.is_closed()) {
+    queue.header().reader_waiting.store(0, std::memory_order_relaxed);
+    state->future.set_result(std::move(message));
+    return iree_ok_status();
+  }
+  // The signal was for a message read since, or a writer that claimed the
+  // head slot has not published it yet: wait again.
+  SharedQueueWaitState *raw_state = state.get();
+  iree_status_t wait_status = state->worker->WaitOneLowLevel(
+      iree_event_await(&queue.event_handle_), iree_infinite_timeout(),
+      &SharedQueue::OnWake, raw_state);
+  if (!iree_status_is_ok(wait_status)) {
+    queue.header().reader_waiting.store(0, std::memory_order_relaxed);
+    state->future.set_failure(wait_status);
+    return iree_ok_status();
+  }
+  state.release();
+  return iree_ok_status();
+}
+
+// -------------------------------------------------------------------------- //
+// SharedQueueMessage
+// -------------------------------------------------------------------------- //
+
+SharedQueueMessage::SharedQueueMessage(std::shared_ptr<SharedQueue> queue,
+                                       uint64_t pos)
+    : queue_(std::move(queue)), pos_(pos) {
+  SharedQueueSlot &s = queue_->slot(pos);
+  tag_ = s.tag;
+  tokens_ = std::span<const int32_t>(
+      s.tokens(), std::min<size_t>(s.token_count, queue_->max_tokens()));
+}
+
+SharedQueueMessage::~SharedQueueMessage() {
+  queue_->slot(pos_).seq.store(pos_ + queue_->capacity(),
+                               std::memory_order_release);
+}
+
+// -------------------------------------------------------------------------- //
+// SharedQueueWriter
+// -------------------------------------------------------------------------- //
+
+SharedQueueWriter::Slot::Slot(Slot &&other) noexcept
+    : queue_(other.queue_), pos_(other.pos_) {
+  other.queue_ = nullptr;
+}
+
+SharedQueueWriter::Slot::~Slot() {
+  if (queue_) PublishSlot(0, 0, /*abandoned=*/true);
+}
+
+std::span<int32_t> SharedQueueWriter::Slot::tokens() {
+  if (!queue_) throw std::logic_error("SharedQueue slot already published");
+  return std::span<int32_t>(queue_->slot(pos_).tokens(),
+                            queue_->max_tokens());
+}
+
+void SharedQueueWriter::Slot::Publish(uint64_t tag, size_t token_count) {
+  if (!queue_) throw std::logic_error("SharedQueue slot already published");
+  if (token_count > queue_->max_tokens()) {
+    throw std::invalid_argument(
+        fmt::format("SharedQueue messages hold at most {} tokens (got {})",
+                    queue_->max_tokens(), token_count));
+  }
+  PublishSlot(tag, token_count, /*abandoned=*/false);
+}
+
+void SharedQueueWriter::Slot::PublishSlot(uint64_t tag, size_t token_count,
+                                          bool abandoned) {
+  SharedQueue &queue = *queue_;
+  queue_ = nullptr;
+  SharedQueueSlot &s = queue.slot(pos_);
+  s.tag = tag;
+  s.token_count = token_count;
+  s.flags = abandoned ? SharedQueueSlot::kAbandoned : 0;
+  s.seq.store(pos_ + 1, std::memory_order_release);
+  // Pairs with the fence of a reader announcing its wait.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (queue.header().reader_waiting.load(std::memory_order_relaxed)) {
+    queue.Signal();
+  }
+}
+
+SharedQueueWriter::SharedQueueWriter(SharedQueue &queue)
+    : queue_(queue.shared_from_this()) {}
+
+std::optional<SharedQueueWriter::Slot> SharedQueueWriter::TryClaim() {
+  if (queue_->is_closed()) {
+    throw std::logic_error("Cannot write to a closed SharedQueue");
+  }
+  SharedQueueHeader &h = queue_->header();
+  uint64_t pos = h.enqueue_pos.load(std::memory_order_relaxed);
+  for (;;) {
+    SharedQueueSlot &s = queue_->slot(pos);
+    uint64_t seq = s.seq.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+    if (diff == 0) {
+      if (h.enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+        return Slot(*queue_, pos);
+      }
+    } else if (diff < 0) {
+      // The reader has not yet released the slot from the previous lap.
+      return std::nullopt;
+    } else {
+      pos = h.enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool SharedQueueWriter::TryWrite(uint64_t tag,
+                                 std::span<const int32_t> tokens) {
+  if (tokens.size() > queue_->max_tokens()) {
+    throw std::invalid_argument(
+        fmt::format("SharedQueue messages hold at most {} tokens (got {})",
+                    queue_->max_tokens(), tokens.size()));
+  }
+  std::optional<Slot> slot = TryClaim();
+  if (!slot) return false;
+  std::copy(tokens.begin(), tokens.end(), slot->tokens().begin());
+  slot->Publish(tag, tokens.size());
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+// SharedQueueReader
+// -------------------------------------------------------------------------- //
+
+SharedQueueReader::SharedQueueReader(SharedQueue &queue)
+    : queue_(queue.shared_from_this()) {
+  uint32_t expected = 0;
+  if (!queue_->header().reader_attached.compare_exchange_strong(expected, 1)) {
+    throw std::logic_error("A SharedQueue can only have one reader");
+  }
+}
+
+SharedQueueReader::~SharedQueueReader() {
+  queue_->header().reader_attached.store(0, std::memory_order_release);
+}
+
+MessageFuture SharedQueueReader::Read() {
+  if (pending_ && !pending_->is_done()) {
+    throw std::logic_error(
+        "Cannot read concurrently from a single SharedQueueReader");
+  }
+  pending_.reset();
+  Worker *worker = Worker::GetCurrent();
+  if (!worker) {
+    throw std::logic_error(
+        "Cannot wait on SharedQueueReader outside of worker");
+  }
+  MessageFuture future(worker);
+  if (Message::Ref message = queue_->TryPop()) {
+    future.set_result(std::move(message));
+    return future;
+  }
+
+  // Announce the wait before the final check of the ring. Pairs with the
+  // fence in Slot::PublishSlot.
+  SharedQueueHeader &h = queue_->header();
+  h.reader_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  Message::Ref message = queue_->TryPop();
+  if (message || queue_->is_closed()) {
+    h.reader_waiting.store(0, std::memory_order_relaxed);
+    future.set_result(std::move(message));
+    return future;
+  }
+
+  auto *state = new SharedQueueWaitState{queue_, worker, future};
+  iree_status_t status = worker->WaitOneLowLevel(
+      iree_event_await(&queue_->event_handle_), iree_infinite_timeout(),
+      &SharedQueue::OnWake, state);
+  if (!iree_status_is_ok(status)) {
+    delete state;
+    h.reader_waiting.store(0, std::memory_order_relaxed);
+    SHORTFIN_THROW_IF_ERROR(status);
+  }
+  pending_ = future;
+  return future;
+}
+
+}  // namespace shortfin::local
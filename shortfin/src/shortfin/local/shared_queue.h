@@ -0,0 +1,189 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_LOCAL_SHARED_QUEUE_H
+#define SHORTFIN_LOCAL_SHARED_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "shortfin/local/messaging.h"
+#include "shortfin/support/api.h"
+#include "shortfin/support/iree_concurrency.h"
+
+namespace shortfin::local {
+
+class SharedQueueReader;
+class SharedQueueWriter;
+
+namespace detail {
+struct SharedQueueHeader;
+struct SharedQueueSlot;
+}  // namespace detail
+
+// Queue of token id messages in shared memory, for exchanging them between
+// processes (i.e. a tokenizing front end and a serving process) without
+// serializing them.
+//
+// The queue is a bounded ring of fixed size slots in a memfd, following the
+// lock-free scheme of mpsc_ring: any number of writers in any number of
+// processes claim and publish slots with atomics in the shared memory, and a
+// single reader consumes them. Writers fill the tokens of a slot in place and
+// the reader's messages view them in place, so a message is never copied
+// between processes. The slot returns to writers when the message holding it
+// is released. A reader waiting on an empty queue is woken through an eventfd,
+// which writers only signal while it waits.
+//
+// One process creates the queue and passes memory_fd() and event_fd() to the
+// others (i.e. by inheritance or over a unix socket), which Open it. Only
+// available on Linux.
+class SHORTFIN_API SharedQueue
+    : public std::enable_shared_from_this<SharedQueue> {
+ public:
+  struct Options {
+    // Number of slots, rounded up to a power of two.
+    size_t capacity = 1024;
+    // Largest number of tokens of a message.
+    size_t max_tokens = 8192;
+  };
+
+  // Creates a queue in new shared memory.
+  static std::shared_ptr<SharedQueue> Create(Options options);
+  // Opens a queue created by another process from its file descriptors, which
+  // are duplicated (the caller keeps ownership of `memory_fd` and `event_fd`).
+  static std::shared_ptr<SharedQueue> Open(int memory_fd, int event_fd);
+  SharedQueue(const SharedQueue &) = delete;
+  SharedQueue &operator=(const SharedQueue &) = delete;
+  ~SharedQueue();
+
+  int memory_fd() const { return memory_fd_; }
+  int event_fd() const { return event_fd_; }
+  size_t capacity() const;
+  size_t max_tokens() const;
+  std::string to_s() const;
+
+  // Closes the queue in every process. Readers get a null message once it is
+  // drained, and writers raise.
+  void Close();
+  bool is_closed() const;
+
+ private:
+  SharedQueue(int memory_fd, int event_fd, void *memory, size_t memory_size);
+  detail::SharedQueueHeader &header() const;
+  detail::SharedQueueSlot &slot(uint64_t pos) const;
+  // Pops the oldest published message, if any. Reader only.
+  Message::Ref TryPop();
+  void Signal();
+  // Consumes pending signals of the eventfd.
+  void ResetEvent();
+  static iree_status_t OnWake(void *state, iree_loop_t loop,
+                              iree_status_t status) noexcept;
+
+  int memory_fd_;
+  int event_fd_;
+  void *memory_;
+  size_t memory_size_;
+  // Wraps event_fd_ (without owning it) for waits of the worker loop.
+  iree_wait_handle_t event_handle_;
+
+  friend class SharedQueueMessage;
+  friend class SharedQueueReader;
+  friend class SharedQueueWriter;
+};
+
+// Message read from a SharedQueue, viewing its slot of the shared memory. The
+// slot is reused by writers once the message is destroyed.
+class SHORTFIN_API SharedQueueMessage : public Message {
+ public:
+  ~SharedQueueMessage() override;
+
+  uint64_t tag() const { return tag_; }
+  std::span<const int32_t> tokens() const { return tokens_; }
+
+ private:
+  SharedQueueMessage(std::shared_ptr<SharedQueue> queue, uint64_t pos);
+
+  std::shared_ptr<SharedQueue> queue_;
+  uint64_t pos_;
+  uint64_t tag_;
+  std::span<const int32_t> tokens_;
+  friend class SharedQueue;
+};
+
+// Writes messages to a SharedQueue. Like QueueWriter, a writer belongs to one
+// logical thread of execution; create one per thread.
+class SHORTFIN_API SharedQueueWriter {
+ public:
+  // A slot claimed by a writer: the tokens are filled in place, then
+  // published. A slot destroyed without being published is skipped by the
+  // reader.
+  class SHORTFIN_API Slot {
+   public:
+    Slot(Slot &&other) noexcept;
+    Slot(const Slot &) = delete;
+    Slot &operator=(const Slot &) = delete;
+    ~Slot();
+
+    // Room for SharedQueue::max_tokens() tokens.
+    std::span<int32_t> tokens();
+    // Makes the first `token_count` tokens visible to the reader as a message
+    // with `tag`.
+    void Publish(uint64_t tag, size_t token_count);
+
+   private:
+    Slot(SharedQueue &queue, uint64_t pos) : queue_(&queue), pos_(pos) {}
+    void PublishSlot(uint64_t tag, size_t token_count, bool abandoned);
+
+    SharedQueue *queue_;
+    uint64_t pos_;
+    friend class SharedQueueWriter;
+  };
+
+  SharedQueueWriter(SharedQueue &queue);
+
+  SharedQueue &queue() { return *queue_; }
+
+  // Claims a slot, or returns nullopt if every slot holds a message that has
+  // not yet been released by the reader. Raises if the queue is closed.
+  std::optional<Slot> TryClaim();
+  // Claims a slot and publishes a copy of `tokens` into it, returning false if
+  // the queue is full.
+  bool TryWrite(uint64_t tag, std::span<const int32_t> tokens);
+
+  // Calls Close() on the backing queue.
+  void Close() { queue_->Close(); }
+
+ private:
+  std::shared_ptr<SharedQueue> queue_;
+};
+
+// The reader of a SharedQueue. There can only be one across all processes at
+// a time.
+class SHORTFIN_API SharedQueueReader {
+ public:
+  SharedQueueReader(SharedQueue &queue);
+  SharedQueueReader(const SharedQueueReader &) = delete;
+  SharedQueueReader &operator=(const SharedQueueReader &) = delete;
+  ~SharedQueueReader();
+
+  SharedQueue &queue() { return *queue_; }
+
+  // Reads a SharedQueueMessage from the queue, or a null message once it is
+  // closed and drained. Must be called on a worker.
+  MessageFuture Read();
+
+ private:
+  std::shared_ptr<SharedQueue> queue_;
+  std::optional<MessageFuture> pending_;
+};
+
+}  // namespace shortfin::local
+
+#endif  // SHORTFIN_LOCAL_SHARED_QUEUE_H
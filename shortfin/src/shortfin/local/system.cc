@@ -20,7 +20,9 @@ namespace shortfin::local {
 // -------------------------------------------------------------------------- //
 
 System::System(iree_allocator_t host_allocator)
-    : host_allocator_(host_allocator) {
+    : host_allocator_(host_allocator),
+      host_thread_pool_(host_allocator),
+      telemetry_(host_allocator) {
   SHORTFIN_TRACE_SCOPE_NAMED("System::System");
   logging::construct("System", this);
   SHORTFIN_THROW_IF_ERROR(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
@@ -67,6 +69,7 @@ void System::Shutdown() {
   SHORTFIN_TRACE_SCOPE_NAMED("System::Shutdown");
   // Stop workers.
   std::vector<Worker *> local_workers;
+  std::vector<WorkerGroup *> local_worker_groups;
   {
     iree::slim_mutex_lock_guard guard(lock_);
     if (!initialized_ || shutdown_) return;
@@ -74,6 +77,16 @@ void System::Shutdown() {
     for (auto &w : workers_) {
       local_workers.push_back(w.get());
     }
+    for (auto &g : worker_groups_) {
+      local_worker_groups.push_back(g.get());
+    }
+  }
+
+  telemetry_.Stop();
+
+  // Groups stop handing out thunks before their workers stop.
+  for (auto &worker_group : local_worker_groups) {
+    worker_group->Kill();
   }
 
   // Worker drain and shutdown.
@@ -85,6 +98,7 @@ void System::Shutdown() {
       worker->WaitForShutdown();
     }
   }
+  host_thread_pool_.Kill();
   blocking_executor_.Kill();
 }
 
@@ -174,6 +188,35 @@ Worker &System::CreateWorker(Worker::Options options) {
   return *unowned_worker;
 }
 
+WorkerGroup &System::CreateWorkerGroup(std::string name, size_t worker_count) {
+  if (worker_count == 0) {
+    throw std::invalid_argument("Cannot create a worker group with no workers");
+  }
+  if (FindWorkerGroupByName(name)) {
+    throw std::invalid_argument(fmt::format(
+        "Cannot create worker group with duplicate name '{}'", name));
+  }
+  std::vector<Worker *> workers;
+  workers.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers.push_back(&CreateWorker(
+        Worker::Options(host_allocator(), fmt::format("{}:{}", name, i))));
+  }
+  iree::slim_mutex_lock_guard guard(lock_);
+  AssertRunning();
+  worker_groups_.push_back(
+      std::make_unique<WorkerGroup>(std::move(name), std::move(workers)));
+  return *worker_groups_.back();
+}
+
+WorkerGroup *System::FindWorkerGroupByName(std::string_view name) {
+  iree::slim_mutex_lock_guard guard(lock_);
+  for (auto &worker_group : worker_groups_) {
+    if (worker_group->name() == name) return worker_group.get();
+  }
+  return nullptr;
+}
+
 Worker &System::init_worker() {
   iree::slim_mutex_lock_guard guard(lock_);
   AssertRunning();
@@ -282,4 +325,58 @@ std::vector<std::string> SystemBuilder::GetConfigAllocatorSpecs(
   return std::vector<std::string>(split_views.begin(), split_views.end());
 }
 
+void SystemBuilder::InitializeBlockingExecutorDefaults() {
+  BlockingExecutor::Options &options = blocking_executor_options_;
+  if (auto v = config_options().GetInt("blocking_executor_min_threads",
+                                       /*non_negative=*/true)) {
+    options.min_threads = *v;
+  }
+  if (auto v = config_options().GetInt("blocking_executor_max_threads",
+                                       /*non_negative=*/true)) {
+    options.max_threads = *v;
+  }
+  if (auto v = config_options().GetInt("blocking_executor_idle_timeout_ms",
+                                       /*non_negative=*/true)) {
+    options.idle_timeout_ns = *v * 1000000;
+  }
+  if (auto v = config_options().GetInt("blocking_executor_max_queued_tasks",
+                                       /*non_negative=*/true)) {
+    options.max_queued_tasks = *v;
+  }
+}
+
+void SystemBuilder::ConfigureBlockingExecutor(System &lsys) {
+  lsys.blocking_executor().SetOptions(blocking_executor_options_);
+}
+
+void SystemBuilder::InitializeTelemetryDefaults() {
+  if (auto v = config_options().GetInt("telemetry_interval_ms",
+                                       /*non_negative=*/true)) {
+    telemetry_options_.interval_ns = *v * 1000000;
+  }
+  if (auto v = config_options().GetInt("telemetry_history",
+                                       /*non_negative=*/true)) {
+    telemetry_options_.history_size = *v;
+  }
+}
+
+void SystemBuilder::ConfigureTelemetry(System &lsys) {
+  lsys.telemetry().Start(lsys.devices(), telemetry_options_);
+}
+
+void SystemBuilder::InitializeProcessTuningDefaults() {
+  tune_process_settings_ = config_options().GetBool("sysconfig_tune", true);
+  tune_options_.raise_limits =
+      config_options().GetBool("sysconfig_raise_limits", false);
+  if (auto v = config_options().GetInt("sysconfig_min_memlock_mb",
+                                       /*non_negative=*/true)) {
+    tune_options_.min_memlock_bytes = static_cast<uint64_t>(*v) << 20;
+  }
+}
+
+void SystemBuilder::TuneProcessSettings() {
+  if (!tune_process_settings_) return;
+  process_settings_ = sysconfig::TuneProcessSettings(tune_options_);
+}
+
 }  // namespace shortfin::local
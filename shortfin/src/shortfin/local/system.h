@@ -8,6 +8,7 @@
 #define SHORTFIN_LOCAL_SYSTEM_H
 
 #include <memory>
+#include <optional>
 #include <span>
 #include <stdexcept>
 #include <string>
@@ -16,13 +17,17 @@
 
 #include "shortfin/local/device.h"
 #include "shortfin/local/messaging.h"
+#include "shortfin/local/telemetry.h"
 #include "shortfin/local/worker.h"
+#include "shortfin/local/worker_group.h"
 #include "shortfin/support/api.h"
 #include "shortfin/support/blocking_executor.h"
 #include "shortfin/support/config.h"
+#include "shortfin/support/host_thread_pool.h"
 #include "shortfin/support/iree_concurrency.h"
 #include "shortfin/support/iree_helpers.h"
 #include "shortfin/support/stl_extras.h"
+#include "shortfin/support/sysconfig.h"
 
 namespace shortfin::local {
 
@@ -120,6 +125,16 @@ class SHORTFIN_API System : public std::enable_shared_from_this<System> {
   // to bridge APIs that cannot be used in a non-blocking context.
   BlockingExecutor &blocking_executor() { return blocking_executor_; }
 
+  // Access the system wide pool for splitting compute bound host work (i.e.
+  // batched host array ops) off of the worker threads. Work scheduled here
+  // must not block.
+  HostThreadPool &host_thread_pool() { return host_thread_pool_; }
+
+  // Access the sampler of device health and throughput counters (clocks,
+  // utilization, temperature, power). Background sampling is configured by
+  // the SystemBuilder and stopped on Shutdown().
+  TelemetrySampler &telemetry() { return telemetry_; }
+
   // Scopes.
   // Creates a new Fiber bound to this System (it will internally
   // hold a reference to this instance). All devices in system order will be
@@ -130,6 +145,11 @@ class SHORTFIN_API System : public std::enable_shared_from_this<System> {
   // Creates and starts a worker (if it is configured to run in a thread).
   Worker &CreateWorker(Worker::Options options);
 
+  // Creates `worker_count` workers named "{name}:{index}" and a group that
+  // shares non-affine thunks across them (see WorkerGroup).
+  WorkerGroup &CreateWorkerGroup(std::string name, size_t worker_count);
+  WorkerGroup *FindWorkerGroupByName(std::string_view name);
+
   // Accesses the initialization worker that is intended to be run on the main
   // or adopted thread to perform any async interactions with the system.
   // Internally, this worker is called "__init__". It will be created on
@@ -202,6 +222,12 @@ class SHORTFIN_API System : public std::enable_shared_from_this<System> {
   // Global blocking executor.
   BlockingExecutor blocking_executor_;
 
+  // Global host compute pool.
+  HostThreadPool host_thread_pool_;
+
+  // Device telemetry.
+  TelemetrySampler telemetry_;
+
   // Queues.
   std::vector<std::shared_ptr<Queue>> queues_ SHORTFIN_GUARDED_BY(lock_);
   std::unordered_map<std::string_view, Queue *> queues_by_name_
@@ -212,6 +238,8 @@ class SHORTFIN_API System : public std::enable_shared_from_this<System> {
   std::vector<std::function<void(Worker &)>> worker_initializers_;
   std::unordered_map<std::string_view, Worker *> workers_by_name_
       SHORTFIN_GUARDED_BY(lock_);
+  std::vector<std::unique_ptr<WorkerGroup>> worker_groups_
+      SHORTFIN_GUARDED_BY(lock_);
 
   // Process management.
   int next_pid_ SHORTFIN_GUARDED_BY(lock_) = 1;
@@ -233,7 +261,11 @@ class SHORTFIN_API SystemBuilder {
   SystemBuilder(iree_allocator_t host_allocator,
                 ConfigOptions config_options = {})
       : host_allocator_(host_allocator),
-        config_options_(std::move(config_options)) {}
+        config_options_(std::move(config_options)) {
+    InitializeBlockingExecutorDefaults();
+    InitializeProcessTuningDefaults();
+    InitializeTelemetryDefaults();
+  }
   SystemBuilder() : SystemBuilder(iree_allocator_system()) {}
   virtual ~SystemBuilder() = default;
 
@@ -249,6 +281,12 @@ class SHORTFIN_API SystemBuilder {
   // Construct a System
   virtual SystemPtr CreateSystem() = 0;
 
+  // Process limits and kernel settings found by the last CreateSystem(), or
+  // empty if it has not been called or tuning is disabled.
+  const std::optional<sysconfig::ProcessSettings> &process_settings() const {
+    return process_settings_;
+  }
+
  protected:
   // Uses the iree_hal_configure_allocator_from_specs() API to configure
   // allocators for a device. The specs are parsed from the given config_key
@@ -270,9 +308,44 @@ class SHORTFIN_API SystemBuilder {
   std::vector<std::string> GetConfigAllocatorSpecs(
       std::optional<std::string_view> specific_config_key);
 
+  // Applies the blocking executor bounds from the config to the system. They
+  // are read when the builder is constructed, from:
+  //   blocking_executor_min_threads
+  //   blocking_executor_max_threads (0 = unbounded)
+  //   blocking_executor_idle_timeout_ms
+  //   blocking_executor_max_queued_tasks (0 = unbounded)
+  // By default, the pool is unbounded and never reaps threads.
+  void ConfigureBlockingExecutor(System &lsys);
+
+  // Starts background sampling of device telemetry (see TelemetrySampler)
+  // if enabled, once all devices have been added. Read when the builder is
+  // constructed from:
+  //   telemetry_interval_ms: Time between samples (default 0 = disabled)
+  //   telemetry_history: Number of samples kept (default 600)
+  void ConfigureTelemetry(System &lsys);
+
+  // Inspects (and optionally raises) process limits and kernel settings
+  // before devices are created, logging recommendations for those likely to
+  // hurt performance. Configured when the builder is constructed from:
+  //   sysconfig_tune (default true)
+  //   sysconfig_raise_limits: Raise the soft thread and locked memory limits
+  //     to the hard limits (default false)
+  //   sysconfig_min_memlock_mb: Locked memory below which to recommend
+  //     raising the limit (default 1024)
+  void TuneProcessSettings();
+
  private:
+  void InitializeBlockingExecutorDefaults();
+  void InitializeProcessTuningDefaults();
+  void InitializeTelemetryDefaults();
+
   const iree_allocator_t host_allocator_;
   ConfigOptions config_options_;
+  BlockingExecutor::Options blocking_executor_options_;
+  bool tune_process_settings_ = true;
+  sysconfig::TuneOptions tune_options_;
+  std::optional<sysconfig::ProcessSettings> process_settings_;
+  TelemetrySampler::Options telemetry_options_;
 };
 
 }  // namespace shortfin::local
@@ -8,17 +8,540 @@
 
 #include <fmt/xchar.h>
 
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <type_traits>
+
+#include "shortfin/support/host_thread_pool.h"
 #include "shortfin/support/logging.h"
 #include "shortfin/support/sysconfig.h"
 
+#ifdef __linux__
+#include <dlfcn.h>
+#endif
+
 namespace shortfin::local::systems {
 
 namespace {
 const std::string_view SYSTEM_DEVICE_CLASS = "amdgpu";
 const std::string_view LOGICAL_DEVICE_CLASS = "gpu";
 const std::string_view HAL_DRIVER_PREFIX = "hip";
+
+#ifdef __linux__
+// A GPU node of the KFD topology
+// (https://docs.kernel.org/gpu/amdgpu/driver-core.html).
+struct KfdGpuNode {
+  struct IoLink {
+    uint32_t type;
+    uint32_t node_to;
+    uint32_t weight;
+  };
+  uint32_t node_id;
+  std::string pci_address;
+  int numa_node = -1;
+  std::vector<IoLink> links;
+};
+
+// KFD io_link types.
+constexpr uint32_t KFD_IOLINK_TYPE_PCIEXPRESS = 2;
+constexpr uint32_t KFD_IOLINK_TYPE_XGMI = 11;
+
+// Reads the "<key> <value>" lines of a KFD properties file.
+std::unordered_map<std::string, uint64_t> ReadKfdProperties(
+    const std::filesystem::path &path) {
+  std::unordered_map<std::string, uint64_t> properties;
+  std::ifstream in(path);
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    std::string key;
+    uint64_t value;
+    if (fields >> key >> value) properties[key] = value;
+  }
+  return properties;
+}
+
+// Formats the PCI address of a device given its KFD domain and location
+// (bus << 8 | device << 3 | function).
+std::string FormatPciAddress(uint64_t domain, uint64_t location_id) {
+  return fmt::format("{:04x}:{:02x}:{:02x}.{:x}", domain,
+                     (location_id >> 8) & 0xff, (location_id >> 3) & 0x1f,
+                     location_id & 0x7);
+}
+
+// Reads an integer sysfs attribute of a PCI device.
+std::optional<int64_t> ReadPciAttribute(std::string_view pci_address,
+                                        std::string_view name) {
+  std::ifstream in(
+      fmt::format("/sys/bus/pci/devices/{}/{}", pci_address, name));
+  int64_t value;
+  if (!(in >> value)) return {};
+  return value;
+}
+
+// Enumerates the GPU nodes of the KFD topology, keyed by unique id (which is
+// what the HIP device UUID is formed from). Empty if not available.
+std::unordered_map<uint64_t, KfdGpuNode> EnumerateKfdGpuNodes() {
+  namespace fs = std::filesystem;
+  std::unordered_map<uint64_t, KfdGpuNode> nodes;
+  std::error_code ec;
+  fs::path nodes_dir("/sys/class/kfd/kfd/topology/nodes");
+  for (auto &node_entry : fs::directory_iterator(nodes_dir, ec)) {
+    uint32_t node_id;
+    try {
+      node_id = std::stoul(node_entry.path().filename().string());
+    } catch (std::exception &) {
+      continue;
+    }
+    auto properties = ReadKfdProperties(node_entry.path() / "properties");
+    // CPU nodes have no SIMDs.
+    if (!properties["simd_count"] || !properties.contains("unique_id")) {
+      continue;
+    }
+    KfdGpuNode &node = nodes[properties["unique_id"]];
+    node.node_id = node_id;
+    node.pci_address =
+        FormatPciAddress(properties["domain"], properties["location_id"]);
+    node.numa_node =
+        ReadPciAttribute(node.pci_address, "numa_node").value_or(-1);
+    // Links are in io_links and (on newer kernels, for indirect peer links)
+    // p2p_links.
+    for (const char *links_dir : {"io_links", "p2p_links"}) {
+      for (auto &link_entry :
+           fs::directory_iterator(node_entry.path() / links_dir, ec)) {
+        auto link = ReadKfdProperties(link_entry.path() / "properties");
+        if (!link.contains("node_to")) continue;
+        node.links.push_back(KfdGpuNode::IoLink{
+            .type = static_cast<uint32_t>(link["type"]),
+            .node_to = static_cast<uint32_t>(link["node_to"]),
+            .weight = static_cast<uint32_t>(link["weight"]),
+        });
+      }
+    }
+  }
+  return nodes;
+}
+
+// The device path reported by the HIP driver is the device UUID, which for
+// AMD GPUs is formed from the KFD unique id as "GPU-<16 hex digits>".
+std::optional<uint64_t> ParseUniqueIdFromDevicePath(std::string_view path) {
+  constexpr std::string_view PREFIX = "GPU-";
+  if (!path.starts_with(PREFIX)) return {};
+  path.remove_prefix(PREFIX.size());
+  if (path.empty() || path.size() > 16) return {};
+  uint64_t unique_id = 0;
+  for (char c : path) {
+    int digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      return {};
+    }
+    unique_id = unique_id << 4 | digit;
+  }
+  return unique_id;
+}
+
+// Reads the current and maximum clocks from a DPM level table of a PCI device
+// (i.e. pp_dpm_sclk), whose lines are "{level}: {clock}Mhz" with the current
+// level marked by a trailing '*'.
+void ReadPciClockLevels(std::string_view pci_address, std::string_view name,
+                        int &current_mhz, int &max_mhz) {
+  std::ifstream in(
+      fmt::format("/sys/bus/pci/devices/{}/{}", pci_address, name));
+  std::string line;
+  while (std::getline(in, line)) {
+    auto colon = line.find(':');
+    if (colon == std::string::npos) continue;
+    int mhz;
+    try {
+      mhz = std::stoi(line.substr(colon + 1));
+    } catch (std::exception &) {
+      continue;
+    }
+    max_mhz = std::max(max_mhz, mhz);
+    if (line.find('*') != std::string::npos) current_mhz = mhz;
+  }
+}
+
+// Reads an integer attribute of the hwmon device of a PCI device.
+std::optional<int64_t> ReadPciHwmonAttribute(std::string_view pci_address,
+                                             std::string_view name) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  for (auto &entry : fs::directory_iterator(
+           fmt::format("/sys/bus/pci/devices/{}/hwmon", pci_address), ec)) {
+    std::ifstream in(entry.path() / name);
+    int64_t value;
+    if (in >> value) return value;
+  }
+  return {};
+}
+#endif  // __linux__
+
 }  // namespace
 
+// -------------------------------------------------------------------------- //
+// detail::HipRuntime
+// -------------------------------------------------------------------------- //
+
+// HIP entry points resolved from the runtime library which the HAL driver has
+// already loaded (from the same search paths). The HAL driver does not expose
+// peer access or IPC, so they are used directly: both are properties of a
+// device's primary context, which the HAL devices share.
+class detail::HipRuntime {
+ public:
+  static constexpr int kSuccess = 0;
+  static constexpr int kErrorPeerAccessAlreadyEnabled = 704;
+  static constexpr unsigned kIpcMemLazyEnablePeerAccess = 1;
+  // hipIpcMemHandle_t.
+  struct IpcMemHandle {
+    char reserved[64];
+  };
+
+  // Returns null if the library or any of the entry points is not found.
+  static std::shared_ptr<HipRuntime> Load(
+      std::span<const std::string> search_paths);
+  ~HipRuntime();
+
+  std::string ErrorName(int err) const {
+    const char *name = GetErrorName ? GetErrorName(err) : nullptr;
+    return name ? std::string(name) : fmt::format("HIP error {}", err);
+  }
+
+  int (*SetDevice)(int device) = nullptr;
+  int (*DeviceCanAccessPeer)(int *can_access, int device, int peer) = nullptr;
+  int (*DeviceEnablePeerAccess)(int peer, unsigned flags) = nullptr;
+  int (*MemGetAddressRange)(void **base, size_t *size, void *ptr) = nullptr;
+  int (*IpcGetMemHandle)(IpcMemHandle *handle, void *ptr) = nullptr;
+  int (*IpcOpenMemHandle)(void **ptr, IpcMemHandle handle,
+                          unsigned flags) = nullptr;
+  int (*IpcCloseMemHandle)(void *ptr) = nullptr;
+  const char *(*GetErrorName)(int err) = nullptr;
+
+ private:
+  void *lib_ = nullptr;
+};
+
+std::shared_ptr<detail::HipRuntime> detail::HipRuntime::Load(
+    std::span<const std::string> search_paths) {
+#ifdef __linux__
+  void *lib = nullptr;
+  for (auto &search_path : search_paths) {
+    std::string lib_path =
+        search_path.starts_with("file:")
+            ? search_path.substr(5)
+            : (std::filesystem::path(search_path) / "libamdhip64.so").string();
+    lib = dlopen(lib_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (lib) break;
+  }
+  if (!lib) lib = dlopen("libamdhip64.so", RTLD_NOW | RTLD_LOCAL);
+  if (!lib) {
+    logging::debug("Could not load the HIP runtime: {}", dlerror());
+    return nullptr;
+  }
+  auto hip = std::make_shared<HipRuntime>();
+  hip->lib_ = lib;
+  bool found = true;
+  auto resolve = [&](auto &fn, const char *symbol) {
+    fn = reinterpret_cast<std::remove_reference_t<decltype(fn)>>(
+        dlsym(lib, symbol));
+    if (!fn) {
+      logging::debug("HIP runtime is missing {}", symbol);
+      found = false;
+    }
+  };
+  resolve(hip->SetDevice, "hipSetDevice");
+  resolve(hip->DeviceCanAccessPeer, "hipDeviceCanAccessPeer");
+  resolve(hip->DeviceEnablePeerAccess, "hipDeviceEnablePeerAccess");
+  resolve(hip->MemGetAddressRange, "hipMemGetAddressRange");
+  resolve(hip->IpcGetMemHandle, "hipIpcGetMemHandle");
+  resolve(hip->IpcOpenMemHandle, "hipIpcOpenMemHandle");
+  resolve(hip->IpcCloseMemHandle, "hipIpcCloseMemHandle");
+  resolve(hip->GetErrorName, "hipGetErrorName");
+  if (!found) return nullptr;
+  return hip;
+#else
+  return nullptr;
+#endif  // __linux__
+}
+
+detail::HipRuntime::~HipRuntime() {
+#ifdef __linux__
+  // The runtime stays loaded by the HAL driver.
+  if (lib_) dlclose(lib_);
+#endif  // __linux__
+}
+
+// -------------------------------------------------------------------------- //
+// AMDGPUDevice
+// -------------------------------------------------------------------------- //
+
+detail::HipRuntime &AMDGPUDevice::hip_runtime() {
+  if (!hip_runtime_) {
+    throw std::invalid_argument(fmt::format(
+        "Device {} cannot share memory: The HIP runtime is not available",
+        name()));
+  }
+  return *hip_runtime_;
+}
+
+IpcMemoryHandle AMDGPUDevice::ExportIpcMemory(iree_hal_buffer_t *buffer) {
+  SHORTFIN_TRACE_SCOPE_NAMED("AMDGPUDevice::ExportIpcMemory");
+  detail::HipRuntime &hip = hip_runtime();
+  iree_hal_external_buffer_t external;
+  SHORTFIN_THROW_IF_ERROR(iree_hal_allocator_export_buffer(
+      iree_hal_device_allocator(hal_device()),
+      iree_hal_buffer_allocated_buffer(buffer),
+      IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION,
+      IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE, &external));
+  uintptr_t allocation_ptr = external.handle.device_allocation.ptr;
+  auto *ptr = reinterpret_cast<uint8_t *>(allocation_ptr) +
+              iree_hal_buffer_byte_offset(buffer);
+
+  // IPC handles are of whole allocations, which the buffer may be part of.
+  void *base = nullptr;
+  size_t size = 0;
+  detail::HipRuntime::IpcMemHandle ipc_handle;
+  int err = hip.MemGetAddressRange(&base, &size, ptr);
+  if (err == detail::HipRuntime::kSuccess) {
+    err = hip.IpcGetMemHandle(&ipc_handle, base);
+  }
+  if (err != detail::HipRuntime::kSuccess) {
+    throw std::invalid_argument(fmt::format(
+        "Could not export memory of device {} to other processes ({}): "
+        "Shared buffers must not be allocated asynchronously (see "
+        "amdgpu_async_allocations)",
+        name(), hip.ErrorName(err)));
+  }
+
+  IpcMemoryHandle handle;
+  handle.pci_address = topology_->pci_address(address().instance_ordinal);
+  handle.opaque.assign(ipc_handle.reserved, sizeof(ipc_handle.reserved));
+  handle.offset = ptr - static_cast<uint8_t *>(base);
+  handle.length = iree_hal_buffer_byte_length(buffer);
+  return handle;
+}
+
+iree::hal_buffer_ptr AMDGPUDevice::ImportIpcMemory(
+    const IpcMemoryHandle &handle) {
+  SHORTFIN_TRACE_SCOPE_NAMED("AMDGPUDevice::ImportIpcMemory");
+  detail::HipRuntime &hip = hip_runtime();
+  detail::HipRuntime::IpcMemHandle ipc_handle;
+  if (handle.opaque.size() != sizeof(ipc_handle.reserved)) {
+    throw std::invalid_argument("Not a HIP IPC memory handle");
+  }
+  const std::string &pci_address =
+      topology_->pci_address(address().instance_ordinal);
+  if (!handle.pci_address.empty() && !pci_address.empty() &&
+      handle.pci_address != pci_address) {
+    throw std::invalid_argument(fmt::format(
+        "IPC memory handle of the device at {} cannot be imported on device "
+        "{} (at {})",
+        handle.pci_address, name(), pci_address));
+  }
+  std::copy(handle.opaque.begin(), handle.opaque.end(), ipc_handle.reserved);
+
+  void *base = nullptr;
+  int err = hip.SetDevice(topology_->hip_ordinal(address().instance_ordinal));
+  if (err == detail::HipRuntime::kSuccess) {
+    err = hip.IpcOpenMemHandle(
+        &base, ipc_handle, detail::HipRuntime::kIpcMemLazyEnablePeerAccess);
+  }
+  if (err != detail::HipRuntime::kSuccess) {
+    throw std::invalid_argument(fmt::format(
+        "Could not import IPC memory handle on device {} ({})", name(),
+        hip.ErrorName(err)));
+  }
+
+  // The mapping is closed when the buffer is destroyed.
+  struct Mapping {
+    std::shared_ptr<detail::HipRuntime> hip;
+    void *base;
+  };
+  auto mapping = std::make_unique<Mapping>(Mapping{hip_runtime_, base});
+  iree_hal_buffer_release_callback_t release_callback = {
+      .fn =
+          +[](void *user_data, iree_hal_buffer_t *buffer) {
+            std::unique_ptr<Mapping> mapping(static_cast<Mapping *>(user_data));
+            mapping->hip->IpcCloseMemHandle(mapping->base);
+          },
+      .user_data = mapping.get(),
+  };
+  iree_hal_buffer_params_t params = {
+      .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
+      .access = IREE_HAL_MEMORY_ACCESS_READ,
+      .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
+  };
+  iree_hal_external_buffer_t external = {
+      .type = IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION,
+      .flags = IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE,
+      .size = static_cast<iree_device_size_t>(handle.length),
+  };
+  external.handle.device_allocation.ptr = static_cast<uint64_t>(
+      reinterpret_cast<uintptr_t>(static_cast<uint8_t *>(base) +
+                                  handle.offset));
+  iree::hal_buffer_ptr buffer;
+  iree_status_t status = iree_hal_allocator_import_buffer(
+      iree_hal_device_allocator(hal_device()), params, &external,
+      release_callback, buffer.for_output());
+  if (!iree_status_is_ok(status)) {
+    hip.IpcCloseMemHandle(base);
+    SHORTFIN_THROW_IF_ERROR(status);
+  }
+  mapping.release();
+  return buffer;
+}
+
+bool AMDGPUDevice::CanAccessPeer(const Device &other) const {
+  if (Device::CanAccessPeer(other)) return true;
+  auto *peer = dynamic_cast<const AMDGPUDevice *>(&other);
+  return peer && peer->topology_ == topology_ && link(*peer).peer_access;
+}
+
+bool AMDGPUDevice::QueryPhysicalMemory(uint64_t &total_bytes,
+                                       uint64_t &used_bytes) const {
+#ifdef __linux__
+  const std::string &pci_address =
+      topology_->pci_address(address().instance_ordinal);
+  if (pci_address.empty()) return false;
+  auto total = ReadPciAttribute(pci_address, "mem_info_vram_total");
+  auto used = ReadPciAttribute(pci_address, "mem_info_vram_used");
+  if (!total || !used) return false;
+  total_bytes = *total;
+  used_bytes = *used;
+  return true;
+#else
+  return false;
+#endif  // __linux__
+}
+
+bool AMDGPUDevice::QueryTelemetry(DeviceTelemetry &telemetry) const {
+#ifdef __linux__
+  const std::string &pci_address =
+      topology_->pci_address(address().instance_ordinal);
+  if (pci_address.empty()) return false;
+  auto busy = ReadPciAttribute(pci_address, "gpu_busy_percent");
+  if (!busy) return false;
+  telemetry.busy_percent = *busy;
+  telemetry.memory_busy_percent =
+      ReadPciAttribute(pci_address, "mem_busy_percent").value_or(-1);
+  ReadPciClockLevels(pci_address, "pp_dpm_sclk", telemetry.shader_clock_mhz,
+                     telemetry.max_shader_clock_mhz);
+  ReadPciClockLevels(pci_address, "pp_dpm_mclk", telemetry.memory_clock_mhz,
+                     telemetry.max_memory_clock_mhz);
+  telemetry.temperature_mc =
+      ReadPciHwmonAttribute(pci_address, "temp1_input").value_or(-1);
+  // Newer kernels only report instantaneous power.
+  telemetry.power_uw =
+      ReadPciHwmonAttribute(pci_address, "power1_average")
+          .value_or(
+              ReadPciHwmonAttribute(pci_address, "power1_input").value_or(-1));
+  return true;
+#else
+  return false;
+#endif  // __linux__
+}
+
+std::vector<AMDGPUDevice *> AMDGPUDevice::ClosestPeers(
+    std::span<Device *const> devices) const {
+  std::vector<AMDGPUDevice *> peers;
+  for (Device *device : devices) {
+    auto *peer = dynamic_cast<AMDGPUDevice *>(device);
+    if (peer && peer != this && peer->topology_ == topology_) {
+      peers.push_back(peer);
+    }
+  }
+  std::stable_sort(peers.begin(), peers.end(),
+                   [this](AMDGPUDevice *a, AMDGPUDevice *b) {
+                     return link_weight(*a) < link_weight(*b);
+                   });
+  return peers;
+}
+
+AMDGPUQueuePriority ParseAMDGPUQueuePriority(std::string_view value) {
+  if (value == "low") return AMDGPUQueuePriority::LOW;
+  if (value == "normal") return AMDGPUQueuePriority::NORMAL;
+  if (value == "high") return AMDGPUQueuePriority::HIGH;
+  throw std::invalid_argument(fmt::format(
+      "Illegal AMDGPU queue priority '{}' (expected one of low, normal, high)",
+      value));
+}
+
+std::vector<AMDGPUDevice *> SelectClosestAMDGPUDevices(
+    std::span<Device *const> devices, size_t count) {
+  std::vector<AMDGPUDevice *> candidates;
+  for (Device *device : devices) {
+    if (auto *candidate = dynamic_cast<AMDGPUDevice *>(device)) {
+      if (!candidates.empty() &&
+          candidates.front()->topology() != candidate->topology()) {
+        throw std::invalid_argument(
+            "Cannot select closest devices across systems");
+      }
+      candidates.push_back(candidate);
+    }
+  }
+  if (candidates.size() < count) {
+    throw std::invalid_argument(
+        fmt::format("Requested {} closest AMDGPU devices but only {} available",
+                    count, candidates.size()));
+  }
+  if (count == 0) return {};
+
+  // Greedily grow a set from each device in turn, adding the device with the
+  // lowest total weight to those already chosen, and keep the cheapest set.
+  // This is exact for the common cases (fully connected XGMI hives and
+  // groups of them joined by PCIe) and cheap enough for any device count.
+  std::vector<size_t> best;
+  uint64_t best_cost = UINT64_MAX;
+  for (size_t seed = 0; seed < candidates.size(); ++seed) {
+    std::vector<size_t> chosen = {seed};
+    std::vector<bool> used(candidates.size());
+    used[seed] = true;
+    uint64_t cost = 0;
+    while (chosen.size() < count) {
+      size_t next = 0;
+      uint64_t next_cost = UINT64_MAX;
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        if (used[i]) continue;
+        uint64_t added = 0;
+        for (size_t j : chosen) {
+          added += candidates[j]->link_weight(*candidates[i]);
+        }
+        if (added < next_cost) {
+          next = i;
+          next_cost = added;
+        }
+      }
+      chosen.push_back(next);
+      used[next] = true;
+      cost += next_cost;
+    }
+    if (cost < best_cost) {
+      best = std::move(chosen);
+      best_cost = cost;
+    }
+  }
+
+  std::sort(best.begin(), best.end());
+  std::vector<AMDGPUDevice *> selected;
+  selected.reserve(best.size());
+  for (size_t i : best) selected.push_back(candidates[i]);
+  return selected;
+}
+
+// -------------------------------------------------------------------------- //
+// AMDGPUSystemBuilder
+// -------------------------------------------------------------------------- //
+
 AMDGPUSystemBuilder::AMDGPUSystemBuilder(iree_allocator_t host_allocator,
                                          ConfigOptions options)
     : HostCPUSystemBuilder(host_allocator, std::move(options)),
@@ -78,6 +601,21 @@ void AMDGPUSystemBuilder::InitializeDefaultSettings() {
     logical_devices_per_physical_device_ = *logical_devices_per_physical_device;
   }
 
+  if (auto priorities = config_options().GetOption("amdgpu_queue_priorities")) {
+    for (auto priority : config_options().Split(*priorities, ',')) {
+      queue_priorities_.push_back(ParseAMDGPUQueuePriority(priority));
+    }
+  }
+  if (auto hw_queues = config_options().GetInt("amdgpu_hw_queues",
+                                               /*non_negative=*/true)) {
+    hw_queue_count_ = *hw_queues;
+  }
+
+  peer_access_ = config_options().GetBool("amdgpu_peer_access", true);
+  parallel_device_creation_ =
+      config_options().GetBool("amdgpu_parallel_device_creation", true);
+  unified_memory_ = config_options().GetBool("amdgpu_unified_memory", false);
+
   // CPU devices.
   cpu_devices_enabled_ = config_options().GetBool("amdgpu_cpu_devices_enabled");
 
@@ -97,6 +635,21 @@ void AMDGPUSystemBuilder::Enumerate() {
   if (hip_hal_driver_) return;
   SHORTFIN_TRACE_SCOPE_NAMED("AMDGPUSystemBuilder::Enumerate");
 
+  // The HIP runtime reads this when it is initialized by the driver.
+  if (hw_queue_count_ > 0) {
+    const char *existing = std::getenv("GPU_MAX_HW_QUEUES");
+    if (existing) {
+      logging::warn("Not setting {} AMDGPU hardware queues: GPU_MAX_HW_QUEUES "
+                    "is already set to {}",
+                    hw_queue_count_, existing);
+    } else {
+#ifdef __linux__
+      setenv("GPU_MAX_HW_QUEUES", std::to_string(hw_queue_count_).c_str(),
+             /*overwrite=*/0);
+#endif  // __linux__
+    }
+  }
+
   iree_hal_hip_driver_options_t driver_options;
   iree_hal_hip_driver_options_initialize(&driver_options);
 
@@ -135,13 +688,181 @@ std::vector<std::string> AMDGPUSystemBuilder::GetAvailableDeviceIds() {
   return results;
 }
 
+std::shared_ptr<AMDGPUTopology> AMDGPUSystemBuilder::DiscoverTopology(
+    std::span<const iree_hal_device_id_t> used_device_ids,
+    std::vector<int> &numa_nodes) {
+  SHORTFIN_TRACE_SCOPE_NAMED("AMDGPUSystemBuilder::DiscoverTopology");
+  auto topology = std::make_shared<AMDGPUTopology>(used_device_ids.size());
+  numa_nodes.assign(used_device_ids.size(), -1);
+  // See IREE_HIP_DEVICE_ID_TO_HIPDEVICE: HAL device ids are HIP ordinals + 1.
+  for (size_t i = 0; i < used_device_ids.size(); ++i) {
+    topology->hip_ordinal(i) = static_cast<int>(used_device_ids[i]) - 1;
+  }
+#ifdef __linux__
+  auto kfd_nodes = EnumerateKfdGpuNodes();
+  if (kfd_nodes.empty()) {
+    logging::debug("AMDGPU topology not available: Assuming unconnected");
+    return topology;
+  }
+
+  // Match each used device to its KFD node by unique id.
+  std::vector<const KfdGpuNode *> used_nodes(used_device_ids.size());
+  for (size_t i = 0; i < used_device_ids.size(); ++i) {
+    for (iree_host_size_t j = 0; j < available_devices_count_; ++j) {
+      iree_hal_device_info_t *info = &available_devices_.get()[j];
+      if (info->device_id != used_device_ids[i]) continue;
+      auto unique_id = ParseUniqueIdFromDevicePath(to_string_view(info->path));
+      auto found_it = unique_id ? kfd_nodes.find(*unique_id) : kfd_nodes.end();
+      if (found_it == kfd_nodes.end()) {
+        logging::warn("AMDGPU device {} not found in the KFD topology",
+                      to_string_view(info->path));
+      } else {
+        used_nodes[i] = &found_it->second;
+        numa_nodes[i] = found_it->second.numa_node;
+        topology->pci_address(i) = found_it->second.pci_address;
+      }
+      break;
+    }
+  }
+
+  for (size_t i = 0; i < used_nodes.size(); ++i) {
+    if (!used_nodes[i]) continue;
+    for (size_t j = 0; j < used_nodes.size(); ++j) {
+      if (i == j || !used_nodes[j]) continue;
+      if (used_nodes[i] == used_nodes[j]) {
+        // The same physical device made visible more than once.
+        topology->link(i, j) = {AMDGPULinkType::SELF, 0, true};
+        continue;
+      }
+      for (auto &io_link : used_nodes[i]->links) {
+        if (io_link.node_to != used_nodes[j]->node_id) continue;
+        AMDGPUTopology::Link &link = topology->link(i, j);
+        if (io_link.type == KFD_IOLINK_TYPE_XGMI) {
+          link.type = AMDGPULinkType::XGMI;
+        } else if (io_link.type == KFD_IOLINK_TYPE_PCIEXPRESS) {
+          link.type = AMDGPULinkType::PCIE;
+        } else {
+          continue;
+        }
+        link.weight = io_link.weight;
+        break;
+      }
+    }
+  }
+#endif  // __linux__
+  return topology;
+}
+
+void AMDGPUSystemBuilder::EnablePeerAccess(detail::HipRuntime &hip,
+                                           AMDGPUTopology &topology) {
+  SHORTFIN_TRACE_SCOPE_NAMED("AMDGPUSystemBuilder::EnablePeerAccess");
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t i = 0; i < topology.instance_count(); ++i) {
+    for (size_t j = 0; j < topology.instance_count(); ++j) {
+      if (topology.link(i, j).type == AMDGPULinkType::XGMI) {
+        pairs.emplace_back(i, j);
+      }
+    }
+  }
+  if (pairs.empty()) return;
+
+  int enabled_count = 0;
+  for (auto [i, j] : pairs) {
+    int device = topology.hip_ordinal(i);
+    int peer = topology.hip_ordinal(j);
+    int can_access = 0;
+    if (hip.DeviceCanAccessPeer(&can_access, device, peer) !=
+            detail::HipRuntime::kSuccess ||
+        !can_access) {
+      continue;
+    }
+    int err = hip.SetDevice(device);
+    if (err == detail::HipRuntime::kSuccess) {
+      err = hip.DeviceEnablePeerAccess(peer, 0);
+    }
+    if (err == detail::HipRuntime::kSuccess ||
+        err == detail::HipRuntime::kErrorPeerAccessAlreadyEnabled) {
+      topology.link(i, j).peer_access = true;
+      enabled_count += 1;
+    } else {
+      logging::warn("Could not enable peer access from HIP device {} to {} "
+                    "({})",
+                    device, peer, hip.ErrorName(err));
+    }
+  }
+  logging::debug("Enabled AMDGPU peer access for {} of {} linked pairs",
+                 enabled_count, pairs.size());
+}
+
+std::shared_ptr<detail::HipRuntime> AMDGPUSystemBuilder::LoadHipRuntime() {
+  auto hip = detail::HipRuntime::Load(hip_lib_search_paths_);
+  if (!hip) {
+    logging::warn("Could not load the HIP runtime: AMDGPU peer access and "
+                  "memory sharing are not available");
+  }
+  return hip;
+}
+
+void AMDGPUSystemBuilder::CreateHalDevices(
+    std::span<const iree_hal_device_id_t> used_device_ids,
+    std::span<const DeviceAddress> addresses,
+    std::vector<iree::hal_device_ptr> &hal_devices) {
+  SHORTFIN_TRACE_SCOPE_NAMED("AMDGPUSystemBuilder::CreateHalDevices");
+  hal_devices.resize(addresses.size());
+  std::vector<std::exception_ptr> failures(used_device_ids.size());
+  // Creates the logical devices of physical devices [begin, end).
+  auto create_devices = [&](size_t begin, size_t end) {
+    for (size_t instance_ordinal = begin; instance_ordinal < end;
+         ++instance_ordinal) {
+      try {
+        for (size_t logical_index = 0;
+             logical_index < logical_devices_per_physical_device_;
+             ++logical_index) {
+          size_t i =
+              instance_ordinal * logical_devices_per_physical_device_ +
+              logical_index;
+          SHORTFIN_THROW_IF_ERROR(iree_hal_driver_create_device_by_id(
+              hip_hal_driver_, used_device_ids[instance_ordinal], 0, nullptr,
+              host_allocator(), hal_devices[i].for_output()));
+          ConfigureAllocators(amdgpu_allocator_specs_, hal_devices[i],
+                              addresses[i].device_name);
+        }
+      } catch (...) {
+        failures[instance_ordinal] = std::current_exception();
+      }
+    }
+  };
+
+  // Most of the time to create a device is spent in the driver initializing
+  // it, independently of the others, so physical devices are created
+  // concurrently. Logical devices of one physical device are created in turn.
+  if (parallel_device_creation_ && used_device_ids.size() > 1) {
+    HostThreadPool pool(host_allocator(), used_device_ids.size() - 1);
+    pool.ParallelFor(used_device_ids.size(), /*min_chunk=*/1, create_devices);
+  } else {
+    create_devices(0, used_device_ids.size());
+  }
+  for (auto &failure : failures) {
+    if (failure) std::rethrow_exception(failure);
+  }
+}
+
 SystemPtr AMDGPUSystemBuilder::CreateSystem() {
   SHORTFIN_TRACE_SCOPE_NAMED("AMDGPUSystemBuilder::CreateSystem");
+  TuneProcessSettings();
+  startup_timings_.clear();
+  iree_time_t phase_start_ns = iree_time_now();
+  iree_time_t create_start_ns = phase_start_ns;
+  auto end_phase = [&](std::string_view name) {
+    iree_time_t now_ns = iree_time_now();
+    startup_timings_.emplace_back(std::string(name), now_ns - phase_start_ns);
+    phase_start_ns = now_ns;
+  };
+
   auto lsys = std::make_shared<System>(host_allocator());
   Enumerate();
+  end_phase("enumerate");
 
-  // TODO: Real NUMA awareness.
-  lsys->InitializeNodes(1);
   lsys->InitializeHalDriver(SYSTEM_DEVICE_CLASS, hip_hal_driver_);
 
   // Must have some device visible.
@@ -203,6 +924,24 @@ SystemPtr AMDGPUSystemBuilder::CreateSystem() {
     }
   }
 
+  // Devices are given the affinity of the NUMA node they are attached to, so
+  // there must be a system node for each.
+  std::vector<int> numa_nodes;
+  auto topology = DiscoverTopology(used_device_ids, numa_nodes);
+  end_phase("topology");
+  int node_count = std::max<int>(1, iree_task_topology_query_node_count());
+  for (int numa_node : numa_nodes) {
+    node_count = std::max(node_count, numa_node + 1);
+  }
+  lsys->InitializeNodes(node_count);
+
+  if (!queue_priorities_.empty() &&
+      queue_priorities_.size() != logical_devices_per_physical_device_) {
+    throw std::invalid_argument(fmt::format(
+        "Expected one AMDGPU queue priority per logical device ({}) but got {}",
+        logical_devices_per_physical_device_, queue_priorities_.size()));
+  }
+
   // Estimate the resource requirements for the requested number of devices.
   // As of 2024-11-08, the number of file handles required to open 64 device
   // partitions was 31 times the number to open one device. Because it is not
@@ -220,31 +959,49 @@ SystemPtr AMDGPUSystemBuilder::CreateSystem() {
   }
 
   // Initialize all used GPU devices.
+  std::vector<DeviceAddress> addresses;
+  addresses.reserve(expected_device_count);
   for (size_t instance_ordinal = 0; instance_ordinal < used_device_ids.size();
        ++instance_ordinal) {
-    iree_hal_device_id_t device_id = used_device_ids[instance_ordinal];
     for (size_t logical_index = 0;
          logical_index < logical_devices_per_physical_device_;
          ++logical_index) {
-      iree::hal_device_ptr device;
-      SHORTFIN_THROW_IF_ERROR(iree_hal_driver_create_device_by_id(
-          hip_hal_driver_, device_id, 0, nullptr, host_allocator(),
-          device.for_output()));
-      DeviceAddress address(
+      addresses.emplace_back(
           /*system_device_class=*/SYSTEM_DEVICE_CLASS,
           /*logical_device_class=*/LOGICAL_DEVICE_CLASS,
           /*hal_driver_prefix=*/HAL_DRIVER_PREFIX,
           /*instance_ordinal=*/instance_ordinal,
           /*queue_ordinal=*/0,
-          /*instance_topology_address=*/{logical_index});
-      ConfigureAllocators(amdgpu_allocator_specs_, device, address.device_name);
-      lsys->InitializeHalDevice(std::make_unique<AMDGPUDevice>(
-          address,
-          /*hal_device=*/device,
-          /*node_affinity=*/0,
-          /*capabilities=*/static_cast<uint32_t>(Device::Capabilities::NONE)));
+          /*instance_topology_address=*/
+          std::vector<iree_host_size_t>{logical_index});
     }
   }
+  std::vector<iree::hal_device_ptr> hal_devices;
+  CreateHalDevices(used_device_ids, addresses, hal_devices);
+  auto hip_runtime = LoadHipRuntime();
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    int numa_node = numa_nodes[addresses[i].instance_ordinal];
+    auto device = std::make_unique<AMDGPUDevice>(
+        addresses[i],
+        /*hal_device=*/hal_devices[i],
+        /*node_affinity=*/std::max(numa_node, 0),
+        /*capabilities=*/static_cast<uint32_t>(Device::Capabilities::NONE),
+        /*topology=*/topology, /*hip_runtime=*/hip_runtime);
+    // Staging buffers are placed next to the GPU they transfer to/from.
+    if (numa_host_allocations()) device->set_host_numa_node(numa_node);
+    device->set_host_huge_pages(host_huge_pages());
+    device->set_unified_memory(unified_memory_);
+    if (!queue_priorities_.empty()) {
+      device->set_queue_priority(
+          queue_priorities_[addresses[i].instance_topology_address[0]]);
+    }
+    lsys->InitializeHalDevice(std::move(device));
+  }
+  end_phase("create_devices");
+  if (peer_access_ && hip_runtime) {
+    EnablePeerAccess(*hip_runtime, *topology);
+    end_phase("peer_access");
+  }
 
   // Initialize CPU devices if requested.
   if (cpu_devices_enabled_) {
@@ -254,9 +1011,20 @@ SystemPtr AMDGPUSystemBuilder::CreateSystem() {
     InitializeHostCPUDefaults();
     auto *driver = InitializeHostCPUDriver(*lsys);
     InitializeHostCPUDevices(*lsys, driver);
+    end_phase("hostcpu");
   }
 
+  ConfigureBlockingExecutor(*lsys);
   lsys->FinishInitialization();
+  ConfigureTelemetry(*lsys);
+  end_phase("finish");
+  std::vector<std::string> phases;
+  for (auto &[name, duration_ns] : startup_timings_) {
+    phases.push_back(fmt::format("{}={:.1f}ms", name, duration_ns / 1e6));
+  }
+  logging::info("Created AMDGPU system with {} devices in {:.1f}ms ({})",
+                addresses.size(), (phase_start_ns - create_start_ns) / 1e6,
+                fmt::join(phases, ", "));
   return lsys;
 }
 
@@ -7,6 +7,10 @@
 #ifndef SHORTFIN_LOCAL_SYSTEMS_AMDGPU_H
 #define SHORTFIN_LOCAL_SYSTEMS_AMDGPU_H
 
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "iree/hal/drivers/hip/api.h"
@@ -17,12 +21,156 @@
 
 namespace shortfin::local::systems {
 
+// How two physical AMD GPUs are connected.
+enum class AMDGPULinkType {
+  // Not connected (or the connection could not be discovered).
+  NONE,
+  // The same physical device (i.e. logical devices for one physical device).
+  SELF,
+  PCIE,
+  XGMI,
+};
+
+// Scheduling priority of the work of a logical device (see
+// AMDGPUSystemBuilder::queue_priorities()).
+enum class AMDGPUQueuePriority {
+  LOW,
+  NORMAL,
+  HIGH,
+};
+
+// Interconnect between the physical devices used by a system, as reported by
+// the kernel driver (on Linux, the KFD topology in sysfs). Indexed by device
+// instance ordinal. Weights are the driver's relative link costs: lower is
+// closer, 0 is the same device.
+class SHORTFIN_API AMDGPUTopology {
+ public:
+  struct Link {
+    AMDGPULinkType type = AMDGPULinkType::NONE;
+    uint32_t weight = kUnconnectedWeight;
+    // Whether peer access from the first to the second device is enabled.
+    bool peer_access = false;
+  };
+  static constexpr uint32_t kUnconnectedWeight = UINT32_MAX;
+
+  explicit AMDGPUTopology(size_t instance_count)
+      : instance_count_(instance_count),
+        links_(instance_count * instance_count),
+        pci_addresses_(instance_count),
+        hip_ordinals_(instance_count, -1) {
+    for (size_t i = 0; i < instance_count; ++i) {
+      link(i, i) = Link{AMDGPULinkType::SELF, 0, true};
+    }
+  }
+
+  size_t instance_count() const { return instance_count_; }
+  Link &link(size_t from, size_t to) {
+    return links_[from * instance_count_ + to];
+  }
+  const Link &link(size_t from, size_t to) const {
+    return links_[from * instance_count_ + to];
+  }
+  // PCI address ("dddd:bb:dd.f") of a device, empty if not discovered.
+  std::string &pci_address(size_t instance) {
+    return pci_addresses_[instance];
+  }
+  const std::string &pci_address(size_t instance) const {
+    return pci_addresses_[instance];
+  }
+  // HIP runtime ordinal of a device.
+  int &hip_ordinal(size_t instance) { return hip_ordinals_[instance]; }
+  int hip_ordinal(size_t instance) const { return hip_ordinals_[instance]; }
+
+ private:
+  size_t instance_count_;
+  std::vector<Link> links_;
+  std::vector<std::string> pci_addresses_;
+  std::vector<int> hip_ordinals_;
+};
+
+namespace detail {
+// The subset of the HIP runtime used outside of the HAL driver.
+class HipRuntime;
+}  // namespace detail
+
 // AMD GPU device subclass.
 class SHORTFIN_API AMDGPUDevice : public Device {
  public:
-  using Device::Device;
+  AMDGPUDevice(DeviceAddress address, iree::hal_device_ptr hal_device,
+               int node_affinity, uint32_t capabilities,
+               std::shared_ptr<const AMDGPUTopology> topology,
+               std::shared_ptr<detail::HipRuntime> hip_runtime = nullptr)
+      : Device(std::move(address), std::move(hal_device), node_affinity,
+               capabilities),
+        topology_(std::move(topology)),
+        hip_runtime_(std::move(hip_runtime)) {}
+
+  // Shared by all AMDGPU devices of a system.
+  const std::shared_ptr<const AMDGPUTopology> &topology() const {
+    return topology_;
+  }
+
+  // Connection to another device of the same system.
+  const AMDGPUTopology::Link &link(const AMDGPUDevice &other) const {
+    return topology_->link(address().instance_ordinal,
+                           other.address().instance_ordinal);
+  }
+  AMDGPULinkType link_type(const AMDGPUDevice &other) const {
+    return link(other).type;
+  }
+  uint32_t link_weight(const AMDGPUDevice &other) const {
+    return link(other).weight;
+  }
+
+  bool CanAccessPeer(const Device &other) const override;
+
+  // Priority this logical device was configured with. Set by the
+  // SystemBuilder.
+  AMDGPUQueuePriority queue_priority() const { return queue_priority_; }
+  void set_queue_priority(AMDGPUQueuePriority priority) {
+    queue_priority_ = priority;
+  }
+
+  // Shares device memory with HIP IPC memory handles. Exported buffers must
+  // have been allocated synchronously (i.e. not from a stream ordered pool,
+  // which is the case with async_allocations).
+  IpcMemoryHandle ExportIpcMemory(iree_hal_buffer_t *buffer) override;
+  iree::hal_buffer_ptr ImportIpcMemory(const IpcMemoryHandle &handle) override;
+
+  // Reads utilization, clocks, temperature and power of the physical device
+  // from the amdgpu driver (the sysfs attributes which AMD SMI reports).
+  bool QueryTelemetry(DeviceTelemetry &telemetry) const override;
+
+  // Other AMDGPU devices among `devices`, closest first (ties in the given
+  // order). Devices without a discovered connection are last.
+  std::vector<AMDGPUDevice *> ClosestPeers(
+      std::span<Device *const> devices) const;
+
+ protected:
+  // Reads the VRAM usage of the physical device from the driver.
+  bool QueryPhysicalMemory(uint64_t &total_bytes,
+                           uint64_t &used_bytes) const override;
+
+ private:
+  // Throws if the HIP runtime could not be loaded.
+  detail::HipRuntime &hip_runtime();
+
+  std::shared_ptr<const AMDGPUTopology> topology_;
+  std::shared_ptr<detail::HipRuntime> hip_runtime_;
+  AMDGPUQueuePriority queue_priority_ = AMDGPUQueuePriority::NORMAL;
 };
 
+// Selects `count` AMDGPU devices among `devices` which are most tightly
+// connected to each other (by total link weight), so that a multi device
+// fiber can be created from them. Returned in the order of `devices`. Throws
+// std::invalid_argument if there are fewer than `count` AMDGPU devices.
+SHORTFIN_API std::vector<AMDGPUDevice *> SelectClosestAMDGPUDevices(
+    std::span<Device *const> devices, size_t count);
+
+// Parses "low", "normal" or "high". Throws std::invalid_argument otherwise.
+SHORTFIN_API AMDGPUQueuePriority
+ParseAMDGPUQueuePriority(std::string_view value);
+
 // System configuration for some subset of AMD GPUs connected to the local
 // system. Note that this inherits from HostCPUSystemBuilder, amdgpu_allowing
 // joint configuration of a heterogenous CPU/GPU system. Depending on the
@@ -83,6 +231,50 @@ class SHORTFIN_API AMDGPUSystemBuilder : public HostCPUSystemBuilder {
     return logical_devices_per_physical_device_;
   }
 
+  // "amdgpu_queue_priorities": Priority of each logical device of a physical
+  // device, by logical index (i.e. "high,normal" for two logical devices).
+  // Empty (default) is normal for all, otherwise there must be one per
+  // logical device. The HAL driver submits the work of each logical device on
+  // its own HIP stream: priorities let latency sensitive fibers (i.e. decode)
+  // be bound to the high priority logical devices, which get their own
+  // hardware queues when hw_queue_count() is at least the number of logical
+  // devices, so they do not queue behind throughput work.
+  std::vector<AMDGPUQueuePriority> &queue_priorities() {
+    return queue_priorities_;
+  }
+
+  // "amdgpu_hw_queues": Number of hardware queues the HIP runtime spreads the
+  // streams of each device over (GPU_MAX_HW_QUEUES), or 0 (default) for the
+  // runtime default. Only takes effect if set before the HIP runtime is
+  // initialized in the process (i.e. before the first enumeration) and if
+  // GPU_MAX_HW_QUEUES is not already set in the environment.
+  int &hw_queue_count() { return hw_queue_count_; }
+
+  // "amdgpu_peer_access": Whether to enable peer to peer access between
+  // visible devices connected by XGMI (default true) when the system is
+  // created, so that they can directly access each other's memory. Failure
+  // to do so is logged and otherwise ignored.
+  bool &peer_access() { return peer_access_; }
+
+  // "amdgpu_parallel_device_creation": Whether to create the HAL devices of
+  // each physical device concurrently (default true), which dominates system
+  // startup time on multi GPU machines.
+  bool &parallel_device_creation() { return parallel_device_creation_; }
+
+  // "amdgpu_unified_memory": Whether device allocations are host visible
+  // device local memory, mapped in place by the host rather than staged
+  // through separate transfer buffers (default false). For APUs (i.e.
+  // MI300A) whose host and device share memory. See Device::unified_memory().
+  bool &unified_memory() { return unified_memory_; }
+
+  // Wall time of each phase of the last CreateSystem() call, in order:
+  // "enumerate", "topology", "create_devices", "peer_access" (if enabled),
+  // "hostcpu" (if enabled) and "finish".
+  const std::vector<std::pair<std::string, iree_duration_t>> &
+  startup_timings() const {
+    return startup_timings_;
+  }
+
   // Gets all enumerated available device ids. This triggers enumeration, so
   // any settings required for that must already be set. This does no filtering
   // and will return all device ids.
@@ -93,6 +285,20 @@ class SHORTFIN_API AMDGPUSystemBuilder : public HostCPUSystemBuilder {
   // Triggers driver setup and initial device enumeration. No-op if already
   // done.
   void Enumerate();
+  // Discovers how the used physical devices are connected and which NUMA
+  // node each is attached to (-1 if unknown).
+  std::shared_ptr<AMDGPUTopology> DiscoverTopology(
+      std::span<const iree_hal_device_id_t> used_device_ids,
+      std::vector<int> &numa_nodes);
+  // Creates the HAL device (with configured allocators) for each address,
+  // whose instance ordinal indexes `used_device_ids`.
+  void CreateHalDevices(std::span<const iree_hal_device_id_t> used_device_ids,
+                        std::span<const DeviceAddress> addresses,
+                        std::vector<iree::hal_device_ptr> &hal_devices);
+  void EnablePeerAccess(detail::HipRuntime &hip, AMDGPUTopology &topology);
+  // Loads the HIP runtime from the search paths, or returns null (with a
+  // warning) if it is not available.
+  std::shared_ptr<detail::HipRuntime> LoadHipRuntime();
 
   // Valid at construction time.
   iree_hal_hip_device_params_t default_device_params_;
@@ -103,6 +309,12 @@ class SHORTFIN_API AMDGPUSystemBuilder : public HostCPUSystemBuilder {
   std::vector<std::string> hip_lib_search_paths_;
   std::optional<std::vector<std::string>> visible_devices_;
   size_t logical_devices_per_physical_device_ = 1;
+  bool peer_access_ = true;
+  bool parallel_device_creation_ = true;
+  bool unified_memory_ = false;
+  std::vector<AMDGPUQueuePriority> queue_priorities_;
+  int hw_queue_count_ = 0;
+  std::vector<std::pair<std::string, iree_duration_t>> startup_timings_;
   std::vector<std::string> amdgpu_allocator_specs_;
 
   // Valid post enumeration.
@@ -66,6 +66,18 @@ HostCPUSystemBuilder::HostCPUSystemBuilder(iree_allocator_t host_allocator,
     : HostSystemBuilder(host_allocator, std::move(config_options)),
       host_cpu_deps_(host_allocator) {
   hostcpu_allocator_specs_ = GetConfigAllocatorSpecs("hostcpu_allocators");
+  numa_host_allocations_ =
+      config_options().GetBool("numa_host_allocations", false);
+  if (auto value = config_options().GetOption("host_huge_pages")) {
+    auto pages = sysconfig::ParseHugePages(*value);
+    if (!pages) {
+      throw std::invalid_argument(fmt::format(
+          "Illegal value for 'host_huge_pages': '{}' (expected one of none, "
+          "thp, 2mb, 1gb)",
+          *value));
+    }
+    host_huge_pages_ = *pages;
+  }
 }
 
 HostCPUSystemBuilder::~HostCPUSystemBuilder() = default;
@@ -127,13 +139,16 @@ HostCPUSystemBuilder::SelectHostCPUNodesFromOptions() {
 
 SystemPtr HostCPUSystemBuilder::CreateSystem() {
   SHORTFIN_TRACE_SCOPE_NAMED("HostCPUSystemBuilder::CreateSystem");
+  TuneProcessSettings();
   auto lsys = std::make_shared<System>(host_allocator());
   // TODO: Real NUMA awareness.
   lsys->InitializeNodes(1);
   InitializeHostCPUDefaults();
   auto *driver = InitializeHostCPUDriver(*lsys);
   InitializeHostCPUDevices(*lsys, driver);
+  ConfigureBlockingExecutor(*lsys);
   lsys->FinishInitialization();
+  ConfigureTelemetry(*lsys);
   return lsys;
 }
 
@@ -240,13 +255,16 @@ void HostCPUSystemBuilder::InitializeHostCPUDevices(System &lsys,
         /*instance_ordinal=*/0,
         /*queue_ordinal=*/queue_index,
         /*instance_topology_address=*/{queue_index});
-    lsys.InitializeHalDevice(std::make_unique<HostCPUDevice>(
+    auto cpu_device = std::make_unique<HostCPUDevice>(
         address,
         /*hal_device=*/device,
         /*node_affinity=*/node_id,
         /*capabilities=*/
         static_cast<int32_t>(
-            Device::Capabilities::PREFER_HOST_UNIFIED_MEMORY)));
+            Device::Capabilities::PREFER_HOST_UNIFIED_MEMORY));
+    if (numa_host_allocations_) cpu_device->set_host_numa_node(node_id);
+    cpu_device->set_host_huge_pages(host_huge_pages_);
+    lsys.InitializeHalDevice(std::move(cpu_device));
     queue_index += 1;
   }
 }
@@ -47,6 +47,19 @@ class SHORTFIN_API HostCPUSystemBuilder : public HostSystemBuilder {
     return hostcpu_allocator_specs_;
   }
 
+  // "numa_host_allocations": Whether to bind host allocations for each device
+  // (i.e. storage::allocate_host and staging buffers) to the NUMA node the
+  // device is attached to (default false). See Device::host_numa_node().
+  // Applies to devices of derived builders as well.
+  bool& numa_host_allocations() { return numa_host_allocations_; }
+
+  // "host_huge_pages": Page backing of large host allocations for each device
+  // (i.e. staging buffers): one of "none" (default), "thp" (transparent huge
+  // pages), "2mb" or "1gb" (reserved huge pages, falling back to regular
+  // pages when none are free). See Device::host_huge_pages(). Applies to
+  // devices of derived builders as well.
+  sysconfig::HugePages& host_huge_pages() { return host_huge_pages_; }
+
  protected:
   // Initializes any host-cpu defaults that have not been configured yet.
   void InitializeHostCPUDefaults();
@@ -70,6 +83,8 @@ class SHORTFIN_API HostCPUSystemBuilder : public HostSystemBuilder {
   } host_cpu_deps_;
 
   std::vector<std::string> hostcpu_allocator_specs_;
+  bool numa_host_allocations_ = false;
+  sysconfig::HugePages host_huge_pages_ = sysconfig::HugePages::kNone;
 
  private:
   std::vector<iree_host_size_t> queue_node_ids_;
@@ -0,0 +1,129 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/local/telemetry.h"
+
+#include "shortfin/support/logging.h"
+
+namespace shortfin::local {
+
+TelemetrySampler::TelemetrySampler(iree_allocator_t allocator)
+    : allocator_(allocator) {}
+
+TelemetrySampler::~TelemetrySampler() { Stop(); }
+
+void TelemetrySampler::Start(std::span<Device *const> devices,
+                             Options options) {
+  Stop();
+  {
+    iree::slim_mutex_lock_guard g(mu_);
+    devices_.assign(devices.begin(), devices.end());
+    options_ = options;
+    while (history_.size() > options_.history_size) history_.pop_front();
+    stop_ = false;
+  }
+  if (options.interval_ns <= 0) return;
+  stop_signal_.reset();
+  iree_thread_create_params_t params = {
+      .name = iree_make_cstring_view("telemetry"),
+  };
+  auto EntryFunction = +[](void *self) noexcept {
+    return static_cast<TelemetrySampler *>(self)->RunOnThread();
+  };
+  SHORTFIN_THROW_IF_ERROR(iree_thread_create(EntryFunction, this, params,
+                                             allocator_, thread_.for_output()));
+}
+
+void TelemetrySampler::Stop() {
+  {
+    iree::slim_mutex_lock_guard g(mu_);
+    stop_ = true;
+  }
+  stop_signal_.set();
+  // Releasing the last reference joins the thread.
+  thread_.reset();
+}
+
+bool TelemetrySampler::running() { return bool(thread_); }
+
+TelemetrySampler::Options TelemetrySampler::options() {
+  iree::slim_mutex_lock_guard g(mu_);
+  return options_;
+}
+
+TelemetrySample TelemetrySampler::SampleNow() {
+  TelemetrySample sample = Sample();
+  iree::slim_mutex_lock_guard g(mu_);
+  RecordLocked(sample);
+  return sample;
+}
+
+TelemetrySample TelemetrySampler::latest() {
+  iree::slim_mutex_lock_guard g(mu_);
+  if (history_.empty()) return {};
+  return history_.back();
+}
+
+std::vector<TelemetrySample> TelemetrySampler::history() {
+  iree::slim_mutex_lock_guard g(mu_);
+  return std::vector<TelemetrySample>(history_.begin(), history_.end());
+}
+
+TelemetrySample TelemetrySampler::Sample() {
+  std::vector<Device *> devices;
+  {
+    iree::slim_mutex_lock_guard g(mu_);
+    devices = devices_;
+  }
+  TelemetrySample sample;
+  sample.time_ns = iree_time_now();
+  for (Device *device : devices) {
+    DeviceTelemetry telemetry;
+    if (device->QueryTelemetry(telemetry)) {
+      sample.devices.emplace_back(device, telemetry);
+    }
+  }
+  return sample;
+}
+
+void TelemetrySampler::RecordLocked(TelemetrySample sample) {
+  if (options_.history_size == 0) return;
+  if (history_.size() >= options_.history_size) history_.pop_front();
+  history_.push_back(std::move(sample));
+}
+
+int TelemetrySampler::RunOnThread() noexcept {
+  iree_duration_t interval_ns;
+  {
+    iree::slim_mutex_lock_guard g(mu_);
+    interval_ns = options_.interval_ns;
+  }
+  iree_time_t next_ns = iree_time_now();
+  for (;;) {
+    {
+      iree::slim_mutex_lock_guard g(mu_);
+      if (stop_) break;
+    }
+    try {
+      SampleNow();
+    } catch (std::exception &e) {
+      logging::warn("Stopping telemetry sampling after error: {}", e.what());
+      break;
+    }
+    // Samples stay on the interval grid, skipping any that were missed.
+    next_ns += interval_ns;
+    iree_time_t now_ns = iree_time_now();
+    if (next_ns < now_ns) {
+      iree_duration_t behind_ns = now_ns - next_ns;
+      next_ns += (behind_ns + interval_ns - 1) / interval_ns * interval_ns;
+    }
+    iree_status_ignore(iree_wait_source_wait_one(
+        stop_signal_.await(), iree_make_deadline(next_ns)));
+  }
+  return 0;
+}
+
+}  // namespace shortfin::local
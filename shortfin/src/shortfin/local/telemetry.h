@@ -0,0 +1,83 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_LOCAL_TELEMETRY_H
+#define SHORTFIN_LOCAL_TELEMETRY_H
+
+#include <deque>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "shortfin/local/device.h"
+#include "shortfin/support/api.h"
+#include "shortfin/support/iree_concurrency.h"
+
+namespace shortfin::local {
+
+// Counters of all devices which report them (see Device::QueryTelemetry()),
+// sampled at one point in time.
+struct SHORTFIN_API TelemetrySample {
+  iree_time_t time_ns = 0;
+  std::vector<std::pair<Device *, DeviceTelemetry>> devices;
+};
+
+// Periodically samples the telemetry of the devices of a System on a
+// dedicated background thread, keeping a bounded history of samples so that
+// tail latency can be correlated with clocks, utilization and throttling
+// after the fact. Owned by the System and configured by the SystemBuilder.
+//
+// Sampling can also be done on demand with SampleNow(), whether or not the
+// background thread is running.
+class SHORTFIN_API TelemetrySampler {
+ public:
+  struct Options {
+    // Time between samples. 0 disables background sampling.
+    iree_duration_t interval_ns = 0;
+    // Number of most recent samples kept.
+    size_t history_size = 600;
+  };
+
+  TelemetrySampler(iree_allocator_t allocator);
+  TelemetrySampler(const TelemetrySampler &) = delete;
+  ~TelemetrySampler();
+
+  // Starts sampling `devices` (which must outlive the sampler) with the given
+  // options, replacing any previous configuration. Does not start a thread if
+  // background sampling is disabled.
+  void Start(std::span<Device *const> devices, Options options);
+  // Stops the background thread (if running) and waits for it to exit.
+  void Stop();
+
+  bool running();
+  Options options();
+
+  // Samples all devices now, recording the sample in the history.
+  TelemetrySample SampleNow();
+
+  // The most recent sample, or an empty one if none has been taken.
+  TelemetrySample latest();
+  // Recorded samples, oldest first.
+  std::vector<TelemetrySample> history();
+
+ private:
+  int RunOnThread() noexcept;
+  TelemetrySample Sample();
+  void RecordLocked(TelemetrySample sample) SHORTFIN_REQUIRES_LOCK(mu_);
+
+  iree_allocator_t allocator_;
+  iree::slim_mutex mu_;
+  std::vector<Device *> devices_ SHORTFIN_GUARDED_BY(mu_);
+  Options options_ SHORTFIN_GUARDED_BY(mu_);
+  std::deque<TelemetrySample> history_ SHORTFIN_GUARDED_BY(mu_);
+  bool stop_ SHORTFIN_GUARDED_BY(mu_) = false;
+  iree::event stop_signal_{false};
+  iree::thread_ptr thread_;
+};
+
+}  // namespace shortfin::local
+
+#endif  // SHORTFIN_LOCAL_TELEMETRY_H
@@ -6,7 +6,10 @@
 
 #include "shortfin/local/worker.h"
 
+#include <algorithm>
+
 #include "shortfin/support/logging.h"
+#include "shortfin/support/sysconfig.h"
 
 namespace shortfin::local {
 
@@ -38,7 +41,13 @@ void Worker::Extension::OnAfterShutdownWait() noexcept {}
 Worker::Worker(const Options options)
     : options_(std::move(options)),
       signal_transact_(false),
-      signal_ended_(false) {
+      signal_ended_(false),
+      thunk_ring_(options_.thunk_ring_capacity) {
+  if (options_.adaptive_quantum && options_.min_quantum_ns <= 0) {
+    throw std::invalid_argument(fmt::format(
+        "Worker '{}': adaptive_quantum requires a positive min_quantum_ns",
+        options_.name));
+  }
   // Set up loop.
   auto OnError = +[](void* self, iree_status_t status) {
     // TODO: FIX ME.
@@ -63,9 +72,32 @@ Worker::~Worker() {
 Worker* Worker::GetCurrent() noexcept { return current_thread_worker; }
 
 std::string Worker::to_s() {
+  if (options_.numa_node >= 0) {
+    return fmt::format("<Worker '{}' numa_node={}>", options_.name,
+                       options_.numa_node);
+  }
   return fmt::format("<Worker '{}'>", options_.name);
 }
 
+void Worker::ApplyThreadPlacement() {
+  // Adopted threads belong to the caller, so only owned threads are moved.
+  if (!options_.owned_thread) return;
+  if (options_.numa_node >= 0) {
+    sysconfig::SetCurrentThreadPreferredNumaNode(options_.numa_node);
+  }
+  std::vector<int> cpus = options_.cpus;
+  if (cpus.empty() && options_.numa_node >= 0) {
+    cpus = sysconfig::GetNumaNodeCpus(options_.numa_node);
+    if (cpus.empty()) {
+      logging::warn("Worker '{}': no CPUs found for NUMA node {}",
+                    options_.name, options_.numa_node);
+    }
+  }
+  if (!cpus.empty()) {
+    sysconfig::SetCurrentThreadCpuAffinity(cpus);
+  }
+}
+
 void Worker::OnThreadStart() {
   // It is not necessary to initialize extensions since their OnThreadStart
   // is called when they are constructed (which necessarily comes after
@@ -92,9 +124,9 @@ iree_status_t Worker::TransactLoop(iree_status_t signal_status) {
   }
 
   {
-    // An outside thread cannot change the state we are managing without
-    // entering this critical section, so it is safe to reset the event
-    // here (it is not possible for it to be spurious reset).
+    // Submitters only set the event when they are the first to flip
+    // transact_signaled_ after the exchange below, so resetting it first
+    // cannot lose a wakeup.
     iree::slim_mutex_lock_guard guard(mu_);
     signal_transact_.reset();
     if (kill_) {
@@ -102,8 +134,22 @@ iree_status_t Worker::TransactLoop(iree_status_t signal_status) {
       // just stopping submission of new work)?
       return iree_ok_status();
     }
-    next_thunks_.swap(pending_thunks_);
+    // Submitters after this point signal again. Pairs with the exchange in
+    // CallThreadsafe so that their thunks are visible below.
+    transact_signaled_.exchange(false, std::memory_order_acq_rel);
+    // Thunks on the ring were queued before any that overflowed.
+    while (std::optional<Thunk> thunk = thunk_ring_.TryPop()) {
+      next_thunks_.push_back(std::move(*thunk));
+    }
+    if (thunks_overflowing_.load(std::memory_order_relaxed)) {
+      for (auto &thunk : pending_thunks_) {
+        next_thunks_.push_back(std::move(thunk));
+      }
+      pending_thunks_.clear();
+      thunks_overflowing_.store(false, std::memory_order_release);
+    }
   }
+  if (!next_thunks_.empty()) ++activity_count_;
 
   // Handle all callbacks.
   for (auto& next_thunk : next_thunks_) {
@@ -112,6 +158,7 @@ iree_status_t Worker::TransactLoop(iree_status_t signal_status) {
     SHORTFIN_TRACE_SCOPE_NAMED("Worker::ThreadsafeCallback");
     next_thunk();
   }
+  thunk_count_.fetch_add(next_thunks_.size(), std::memory_order_relaxed);
   next_thunks_.clear();
   return ScheduleExternalTransactEvent();
 }
@@ -125,19 +172,56 @@ iree_status_t Worker::ScheduleExternalTransactEvent() {
       this);
 }
 
+iree_status_t Worker::DrainTrip() {
+  if (options_.busy_poll_ns <= 0 && !options_.adaptive_quantum) {
+    return iree_loop_drain(loop_, options_.quantum);
+  }
+
+  iree_time_t now_ns = iree_time_now();
+  if (activity_count_ != last_activity_count_) {
+    last_activity_count_ = activity_count_;
+    last_activity_ns_ = now_ns;
+    current_quantum_ns_ = 0;
+  }
+
+  if (options_.busy_poll_ns > 0 &&
+      now_ns - last_activity_ns_ < options_.busy_poll_ns) {
+    // Poll: run whatever is ready and check waits without sleeping. Running
+    // out of time on a poll is expected, not an error.
+    iree_status_t status = iree_loop_drain(loop_, iree_immediate_timeout());
+    if (iree_status_is_deadline_exceeded(status)) {
+      iree_status_ignore(status);
+      return iree_ok_status();
+    }
+    return status;
+  }
+
+  iree_timeout_t quantum = options_.quantum;
+  if (options_.adaptive_quantum && quantum.type == IREE_TIMEOUT_RELATIVE) {
+    current_quantum_ns_ =
+        current_quantum_ns_ == 0
+            ? std::min(options_.min_quantum_ns, quantum.nanos)
+            : std::min(current_quantum_ns_ * 2, quantum.nanos);
+    quantum = iree_make_timeout_ns(current_quantum_ns_);
+  }
+  return iree_loop_drain(loop_, quantum);
+}
+
 int Worker::RunOnThread() {
   auto RunLoop = [&]() -> iree_status_t {
     IREE_RETURN_IF_ERROR(ScheduleExternalTransactEvent());
+    last_activity_ns_ = iree_time_now();
     for (;;) {
       {
         iree::slim_mutex_lock_guard guard(mu_);
         if (kill_) break;
       }
-      IREE_RETURN_IF_ERROR(iree_loop_drain(loop_, options_.quantum));
+      IREE_RETURN_IF_ERROR(DrainTrip());
     }
     return iree_ok_status();
   };
 
+  ApplyThreadPlacement();
   OnThreadStart();
   {
     auto loop_status = RunLoop();
@@ -236,18 +320,28 @@ void Worker::RunOnCurrentThread() {
   RunOnThread();
 }
 
-void Worker::CallThreadsafe(std::function<void()> callback) {
-  {
+void Worker::CallThreadsafe(Thunk callback) {
+  // Stay off the ring while there is an overflow so that thunks from this
+  // thread run in order.
+  if (thunks_overflowing_.load(std::memory_order_acquire) ||
+      !thunk_ring_.TryPush(callback)) {
     iree::slim_mutex_lock_guard guard(mu_);
-    pending_thunks_.push_back(std::move(callback));
+    if (thunks_overflowing_.load(std::memory_order_relaxed) ||
+        !thunk_ring_.TryPush(callback)) {
+      pending_thunks_.push_back(std::move(callback));
+      thunks_overflowing_.store(true, std::memory_order_relaxed);
+    }
+  }
+  if (!transact_signaled_.exchange(true, std::memory_order_acq_rel)) {
+    signal_transact_.set();
   }
-  signal_transact_.set();
 }
 
 iree_status_t Worker::CallLowLevel(
     iree_status_t (*callback)(void* user_data, iree_loop_t loop,
                               iree_status_t status) noexcept,
     void* user_data, iree_loop_priority_e priority) noexcept {
+  ++activity_count_;
   return iree_loop_call(loop_, priority, callback, user_data);
 }
 
@@ -256,6 +350,7 @@ iree_status_t Worker::WaitUntilLowLevel(
     iree_status_t (*callback)(void* user_data, iree_loop_t loop,
                               iree_status_t status) noexcept,
     void* user_data) {
+  ++activity_count_;
   return iree_loop_wait_until(loop_, timeout, callback, user_data);
 }
 
@@ -264,6 +359,7 @@ iree_status_t Worker::WaitOneLowLevel(
     iree_status_t (*callback)(void* user_data, iree_loop_t loop,
                               iree_status_t status) noexcept,
     void* user_data) {
+  ++activity_count_;
   return iree_loop_wait_one(loop_, wait_source, timeout, callback, user_data);
 }
 
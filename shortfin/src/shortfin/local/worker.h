@@ -17,13 +17,19 @@
 #include "iree/base/loop_sync.h"
 #include "shortfin/local/async.h"
 #include "shortfin/support/api.h"
+#include "shortfin/support/inline_function.h"
 #include "shortfin/support/iree_concurrency.h"
+#include "shortfin/support/mpsc_ring.h"
 
 namespace shortfin::local {
 
 // Cooperative worker.
 class SHORTFIN_API Worker {
  public:
+  // Callback for CallThreadsafe. Small callables (up to six pointers, which
+  // covers a std::function) are stored without allocating.
+  using Thunk = inline_function<void()>;
+
   struct Options {
     iree_allocator_t allocator;
     std::string name;
@@ -34,6 +40,35 @@ class SHORTFIN_API Worker {
     // an infinite/long async wait or something.
     iree_timeout_t quantum = iree_make_timeout_ms(500);
 
+    // Latency tuning for workers on the critical path (i.e. decode). Both
+    // trade host CPU for a lower delay between a completion (device or cross
+    // thread) and the callback that acts on it.
+    //
+    // When non zero, the worker polls its loop without sleeping until this
+    // long has passed since it last had work, and only then goes back to
+    // blocking waits. This keeps a core busy while the worker is active.
+    iree_duration_t busy_poll_ns = 0;
+
+    // When true, a worker going idle blocks for `min_quantum_ns` at first and
+    // doubles that on each idle trip up to `quantum` (which must be relative).
+    // Work seen on a trip resets it. With busy polling, this bounds how long a
+    // new burst runs on blocking waits before the worker resumes polling.
+    bool adaptive_quantum = false;
+    iree_duration_t min_quantum_ns = 1000000;  // 1ms
+
+    // Number of CallThreadsafe thunks that can be pending without taking a
+    // lock. Beyond that, submissions fall back to a locked list.
+    size_t thunk_ring_capacity = 1024;
+
+    // Placement of an owned worker thread. When `cpus` is set, the thread is
+    // restricted to those CPUs. When `numa_node` is set (>= 0), the thread
+    // prefers allocating memory from that node and, if `cpus` is empty, runs
+    // on the CPUs of that node. Typically this is the node of the device the
+    // worker drives (Device::node_affinity()). Best effort: failures are
+    // logged and the worker runs unpinned.
+    std::vector<int> cpus;
+    int numa_node = -1;
+
     // Whether to create the worker on an owned thread. If false, then the
     // worker is set up to be adopted and a thread will not be created.
     bool owned_thread = true;
@@ -107,8 +142,16 @@ class SHORTFIN_API Worker {
   // owned_thread is false.
   void RunOnCurrentThread();
 
-  // Enqueues a callback to the worker from another thread.
-  void CallThreadsafe(std::function<void()> callback);
+  // Enqueues a callback to the worker from another thread. Callbacks from a
+  // given thread run in the order they were enqueued. Lock free unless the
+  // worker has fallen more than `thunk_ring_capacity` callbacks behind.
+  void CallThreadsafe(Thunk callback);
+
+  // Total number of CallThreadsafe callbacks run by the worker. Sampling it
+  // over time gives the thunk rate.
+  uint64_t thunk_count() const {
+    return thunk_count_.load(std::memory_order_relaxed);
+  }
 
   // Operations that can be done from on the worker.
   // Callback to execute user code on the loop "soon". This variant must not
@@ -146,8 +189,13 @@ class SHORTFIN_API Worker {
 
  private:
   int RunOnThread();
+  // Applies the cpus/numa_node options to the current (worker) thread.
+  void ApplyThreadPlacement();
   iree_status_t ScheduleExternalTransactEvent();
   iree_status_t TransactLoop(iree_status_t signal_status);
+  // Drains the loop for one trip of RunOnThread, polling or blocking as the
+  // latency options dictate.
+  iree_status_t DrainTrip();
 
   const Options options_;
   iree::slim_mutex mu_;
@@ -157,7 +205,15 @@ class SHORTFIN_API Worker {
 
   // State management. These are all manipulated both on and off the worker
   // thread.
-  std::vector<std::function<void()>> pending_thunks_;
+  mpsc_ring<Thunk> thunk_ring_;
+  // Set while thunks are in pending_thunks_, so that later thunks queue
+  // behind them rather than on the ring.
+  std::atomic<bool> thunks_overflowing_{false};
+  // Set by the first submitter after the worker last took its thunks. Only
+  // that submitter signals signal_transact_.
+  std::atomic<bool> transact_signaled_{false};
+  std::atomic<uint64_t> thunk_count_{0};
+  std::vector<Thunk> pending_thunks_;
   bool kill_ = false;
   bool has_run_ = false;
 
@@ -165,7 +221,13 @@ class SHORTFIN_API Worker {
   iree_loop_sync_scope_t loop_scope_;
   iree_loop_sync_t *loop_sync_;
   iree_loop_t loop_;
-  std::vector<std::function<void()>> next_thunks_;
+  std::vector<Thunk> next_thunks_;
+  // Bumped whenever work is scheduled on the loop from the worker thread. Used
+  // to tell an active worker from an idle one when adapting the drain.
+  uint64_t activity_count_ = 0;
+  uint64_t last_activity_count_ = 0;
+  iree_time_t last_activity_ns_ = 0;
+  iree_duration_t current_quantum_ns_ = 0;
   std::unordered_map<std::type_index, std::unique_ptr<Extension>> extensions_;
 };
 
@@ -0,0 +1,63 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "shortfin/local/benchmark_helpers.h"
+#include "shortfin/local/worker.h"
+
+namespace shortfin::local {
+namespace {
+
+// Waits for `flag` to be set by the worker, spinning on the benchmark thread
+// so that the wake-up latency measured is the worker's.
+void SpinUntil(std::atomic<bool> &flag) {
+  while (!flag.load(std::memory_order_acquire)) {
+  }
+  flag.store(false, std::memory_order_relaxed);
+}
+
+// Latency of one thunk posted from another thread until it ran, with the
+// worker blocking (0) or busy polling (in ns) when idle.
+void BM_CallThreadsafeRoundTrip(benchmark::State &state) {
+  BenchmarkSystem sys(state.range(0));
+  std::atomic<bool> ran = false;
+  for (auto _ : state) {
+    sys.worker().CallThreadsafe(
+        [&ran]() { ran.store(true, std::memory_order_release); });
+    SpinUntil(ran);
+  }
+}
+BENCHMARK(BM_CallThreadsafeRoundTrip)->Arg(0)->Arg(100000)->UseRealTime();
+
+// Throughput of batches of `state.range(0)` thunks, which exceed the
+// lock-free thunk ring (see Worker::Options::thunk_ring_capacity) for the
+// largest batch size.
+void BM_CallThreadsafeBatch(benchmark::State &state) {
+  BenchmarkSystem sys;
+  int64_t batch_size = state.range(0);
+  std::atomic<bool> ran = false;
+  int64_t count = 0;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < batch_size - 1; ++i) {
+      sys.worker().CallThreadsafe([&count]() { ++count; });
+    }
+    sys.worker().CallThreadsafe([&count, &ran]() {
+      ++count;
+      ran.store(true, std::memory_order_release);
+    });
+    SpinUntil(ran);
+  }
+  benchmark::DoNotOptimize(count);
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(BM_CallThreadsafeBatch)->Arg(64)->Arg(4096)->UseRealTime();
+
+}  // namespace
+}  // namespace shortfin::local
@@ -0,0 +1,158 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/local/worker_group.h"
+
+#include "fmt/core.h"
+#include "shortfin/support/logging.h"
+
+namespace shortfin::local {
+
+namespace {
+
+// Thunks run per loop turn of a worker before it yields to its other
+// callbacks.
+constexpr int kMaxThunksPerTurn = 16;
+
+}  // namespace
+
+WorkerGroup::WorkerGroup(std::string name, std::vector<Worker *> workers)
+    : name_(std::move(name)), workers_(std::move(workers)) {
+  if (workers_.empty()) {
+    throw std::invalid_argument(
+        fmt::format("WorkerGroup '{}' requires at least one worker", name_));
+  }
+  members_.reserve(workers_.size());
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    auto member = std::make_unique<Member>();
+    member->group = this;
+    member->index = i;
+    members_.push_back(std::move(member));
+  }
+}
+
+WorkerGroup::~WorkerGroup() = default;
+
+std::string WorkerGroup::to_s() const {
+  return fmt::format("<WorkerGroup '{}' workers={}>", name_, workers_.size());
+}
+
+void WorkerGroup::Submit(Thunk thunk) {
+  if (killed_.load(std::memory_order_acquire)) {
+    throw std::logic_error(
+        fmt::format("Cannot submit to killed WorkerGroup '{}'", name_));
+  }
+  size_t target = workers_.size();
+  Worker *current = Worker::GetCurrent();
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    if (workers_[i] == current) {
+      target = i;
+      break;
+    }
+  }
+  if (target == workers_.size()) {
+    target = next_submit_.fetch_add(1, std::memory_order_relaxed) %
+             workers_.size();
+  }
+
+  Member &member = *members_[target];
+  {
+    iree::slim_mutex_lock_guard g(member.lock);
+    member.run_queue.push_back(std::move(thunk));
+  }
+  // Pairs with the re-check in Drain: either a member going idle sees this
+  // thunk or we see that it is idle.
+  queued_count_.fetch_add(1, std::memory_order_seq_cst);
+  WakeIdleMember(target);
+}
+
+void WorkerGroup::Kill() {
+  killed_.store(true, std::memory_order_release);
+  for (auto &member : members_) {
+    std::deque<Thunk> dropped;
+    {
+      iree::slim_mutex_lock_guard g(member->lock);
+      dropped.swap(member->run_queue);
+      queued_count_.fetch_sub(dropped.size(), std::memory_order_relaxed);
+    }
+  }
+}
+
+void WorkerGroup::WakeIdleMember(size_t start) {
+  for (size_t i = 0; i < members_.size(); ++i) {
+    Member &member = *members_[(start + i) % members_.size()];
+    bool expected = false;
+    if (member.scheduled.compare_exchange_strong(expected, true,
+                                                 std::memory_order_seq_cst)) {
+      workers_[member.index]->CallThreadsafe(
+          [&member]() { member.group->Drain(member); });
+      return;
+    }
+  }
+  // Every member is busy. The thunk is taken when one finishes its turn.
+}
+
+void WorkerGroup::ScheduleDrain(Member &member) {
+  // Continue on a later turn of the loop so that its other callbacks run.
+  iree_status_t status = workers_[member.index]->CallLowLevel(
+      +[](void *member_vp, iree_loop_t loop, iree_status_t status) noexcept {
+        IREE_RETURN_IF_ERROR(status);
+        auto &member = *static_cast<Member *>(member_vp);
+        member.group->Drain(member);
+        return iree_ok_status();
+      },
+      &member);
+  if (!iree_status_is_ok(status)) {
+    // The loop queue is full: go through the thread safe path instead.
+    iree_status_ignore(status);
+    workers_[member.index]->CallThreadsafe(
+        [&member]() { member.group->Drain(member); });
+  }
+}
+
+bool WorkerGroup::TakeThunk(Member &member, Thunk &thunk) {
+  for (size_t i = 0; i < members_.size(); ++i) {
+    Member &victim = *members_[(member.index + i) % members_.size()];
+    iree::slim_mutex_lock_guard g(victim.lock);
+    if (victim.run_queue.empty()) continue;
+    thunk = std::move(victim.run_queue.front());
+    victim.run_queue.pop_front();
+    queued_count_.fetch_sub(1, std::memory_order_relaxed);
+    if (i != 0) steal_count_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+void WorkerGroup::Drain(Member &member) {
+  SHORTFIN_TRACE_SCOPE_NAMED("WorkerGroup::Drain");
+  for (int i = 0; i < kMaxThunksPerTurn; ++i) {
+    if (killed_.load(std::memory_order_acquire)) return;
+    Thunk thunk;
+    if (!TakeThunk(member, thunk)) {
+      member.scheduled.store(false, std::memory_order_seq_cst);
+      // A thunk may have been queued after the scan but before this member
+      // went idle, while every other member was busy.
+      if (queued_count_.load(std::memory_order_seq_cst) == 0) return;
+      bool expected = false;
+      if (!member.scheduled.compare_exchange_strong(
+              expected, true, std::memory_order_seq_cst)) {
+        // Already rescheduled by a submitter.
+        return;
+      }
+      continue;
+    }
+    try {
+      thunk();
+    } catch (std::exception &e) {
+      logging::error("Unhandled exception in WorkerGroup '{}' thunk: {}",
+                     name_, e.what());
+    }
+  }
+  ScheduleDrain(member);
+}
+
+}  // namespace shortfin::local
@@ -0,0 +1,98 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_LOCAL_WORKER_GROUP_H
+#define SHORTFIN_LOCAL_WORKER_GROUP_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "shortfin/local/worker.h"
+#include "shortfin/support/api.h"
+#include "shortfin/support/iree_concurrency.h"
+
+namespace shortfin::local {
+
+// A set of workers sharing thunks that have no affinity to a particular
+// worker or device (i.e. host side request preparation and response
+// formatting). Each worker of the group has its own FIFO run queue and, when
+// that runs dry, steals the oldest thunk queued on another, so that a burst
+// of work submitted from one busy worker spreads across the group.
+//
+// Thunks run on the event loops of the workers, a bounded number per loop
+// turn so that the other work of a worker is not starved. Like any worker
+// callback, they must not block.
+//
+// Processes and their fibers remain bound to a single worker: their state
+// (and that of the devices they use) is not safe to migrate. Work that should
+// spread is submitted here instead.
+class SHORTFIN_API WorkerGroup {
+ public:
+  using Thunk = std::function<void()>;
+
+  // The workers must outlive the group (or at least its use).
+  WorkerGroup(std::string name, std::vector<Worker *> workers);
+  WorkerGroup(const WorkerGroup &) = delete;
+  WorkerGroup &operator=(const WorkerGroup &) = delete;
+  ~WorkerGroup();
+
+  std::string_view name() const { return name_; }
+  std::span<Worker *const> workers() const { return workers_; }
+  std::string to_s() const;
+
+  // Queues a thunk to run on some worker of the group. When called from one
+  // of its workers, the thunk is queued there first, else the group's queues
+  // are used round robin. Threadsafe.
+  void Submit(Thunk thunk);
+
+  // Stops running thunks and rejects further submissions. Thunks that are
+  // still queued are dropped.
+  void Kill();
+
+  // Number of thunks that ran on a worker other than the one they were
+  // queued on.
+  uint64_t steal_count() const {
+    return steal_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Member {
+    WorkerGroup *group;
+    size_t index;
+    iree::slim_mutex lock;
+    std::deque<Thunk> run_queue SHORTFIN_GUARDED_BY(lock);
+    // Whether a drain of this member is scheduled on (or running on) its
+    // worker. Only the thread that sets it schedules the drain.
+    std::atomic<bool> scheduled{false};
+  };
+
+  // Schedules a drain on the first idle member, starting from `start`.
+  void WakeIdleMember(size_t start);
+  void ScheduleDrain(Member &member);
+  // Takes the next thunk for a member: its own oldest, else the oldest of
+  // another member.
+  bool TakeThunk(Member &member, Thunk &thunk);
+  // Runs on the member's worker.
+  void Drain(Member &member);
+
+  std::string name_;
+  std::vector<Worker *> workers_;
+  std::vector<std::unique_ptr<Member>> members_;
+  // Thunks queued but not yet taken across all members.
+  std::atomic<size_t> queued_count_{0};
+  std::atomic<size_t> next_submit_{0};
+  std::atomic<uint64_t> steal_count_{0};
+  std::atomic<bool> killed_{false};
+};
+
+}  // namespace shortfin::local
+
+#endif  // SHORTFIN_LOCAL_WORKER_GROUP_H
@@ -0,0 +1,98 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/support/async_log_sink.h"
+
+#include "fmt/core.h"
+#include "spdlog/details/log_msg.h"
+#include "spdlog/formatter.h"
+
+namespace shortfin::logging {
+
+AsyncLogSink::AsyncLogSink(std::vector<spdlog::sink_ptr> sinks,
+                           size_t capacity,
+                           std::chrono::milliseconds flush_interval)
+    : sinks_(std::move(sinks)),
+      ring_(capacity),
+      flush_interval_(flush_interval),
+      flusher_([this]() { Run(); }) {}
+
+AsyncLogSink::~AsyncLogSink() {
+  stop_.store(true, std::memory_order_release);
+  wake_.notify_one();
+  flusher_.join();
+  Drain();
+}
+
+void AsyncLogSink::log(const spdlog::details::log_msg &msg) {
+  Record record{msg.level,
+                msg.time,
+                msg.thread_id,
+                msg.source,
+                std::string(msg.logger_name.data(), msg.logger_name.size()),
+                std::string(msg.payload.data(), msg.payload.size())};
+  if (!ring_.TryPush(record)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    dropped_total_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (msg.level >= spdlog::level::err) wake_.notify_one();
+}
+
+void AsyncLogSink::flush() {
+  Drain();
+  for (auto &sink : sinks_) sink->flush();
+}
+
+void AsyncLogSink::set_pattern(const std::string &pattern) {
+  std::lock_guard<std::mutex> lock(drain_mutex_);
+  for (auto &sink : sinks_) sink->set_pattern(pattern);
+}
+
+void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+  std::lock_guard<std::mutex> lock(drain_mutex_);
+  for (auto &sink : sinks_) sink->set_formatter(formatter->clone());
+}
+
+void AsyncLogSink::Run() {
+  while (!stop_.load(std::memory_order_acquire)) {
+    {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_.wait_for(lock, flush_interval_);
+    }
+    Drain();
+  }
+}
+
+void AsyncLogSink::Drain() {
+  std::lock_guard<std::mutex> lock(drain_mutex_);
+  bool wrote = false;
+  auto write = [&](const spdlog::details::log_msg &msg) {
+    for (auto &sink : sinks_) {
+      if (sink->should_log(msg.level)) sink->log(msg);
+    }
+    wrote = true;
+  };
+  while (auto record = ring_.TryPop()) {
+    spdlog::details::log_msg msg(record->time, record->source,
+                                 record->logger_name, record->level,
+                                 record->payload);
+    msg.thread_id = record->thread_id;
+    write(msg);
+  }
+  if (uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed)) {
+    std::string payload = fmt::format(
+        "Dropped {} log messages: the async log ring (capacity {}) was full",
+        dropped, ring_.capacity());
+    write(spdlog::details::log_msg(spdlog::source_loc{}, "",
+                                   spdlog::level::warn, payload));
+  }
+  if (wrote) {
+    for (auto &sink : sinks_) sink->flush();
+  }
+}
+
+}  // namespace shortfin::logging
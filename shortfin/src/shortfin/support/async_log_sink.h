@@ -0,0 +1,91 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_SUPPORT_ASYNC_LOG_SINK_H
+#define SHORTFIN_SUPPORT_ASYNC_LOG_SINK_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "shortfin/support/api.h"
+#include "shortfin/support/mpsc_ring.h"
+#include "spdlog/sinks/sink.h"
+
+namespace shortfin::logging {
+
+// spdlog sink which hands messages to a background flusher thread, which
+// writes them to the wrapped sinks. Logging threads only copy the formatted
+// payload into a bounded, lock-free ring (see mpsc_ring): they never take a
+// lock, do I/O or wait on the flusher. Messages logged while the ring is full
+// are dropped and counted, and the flusher reports the count with the next
+// messages it writes.
+//
+// The flusher drains the ring every `flush_interval`, and as soon as an error
+// or critical message is logged. Flush() drains it on the calling thread.
+class SHORTFIN_API AsyncLogSink final : public spdlog::sinks::sink {
+ public:
+  AsyncLogSink(std::vector<spdlog::sink_ptr> sinks, size_t capacity,
+               std::chrono::milliseconds flush_interval =
+                   std::chrono::milliseconds(10));
+  AsyncLogSink(const AsyncLogSink &) = delete;
+  AsyncLogSink &operator=(const AsyncLogSink &) = delete;
+  // Stops the flusher and writes the remaining messages.
+  ~AsyncLogSink() override;
+
+  void log(const spdlog::details::log_msg &msg) override;
+  // Writes all messages logged so far to the wrapped sinks and flushes them.
+  void flush() override;
+  void set_pattern(const std::string &pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+  size_t capacity() const { return ring_.capacity(); }
+  // Messages dropped because the ring was full, over the sink's lifetime.
+  uint64_t dropped_count() const {
+    return dropped_total_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // A log_msg with owned strings.
+  struct Record {
+    spdlog::level::level_enum level;
+    spdlog::log_clock::time_point time;
+    size_t thread_id;
+    spdlog::source_loc source;
+    std::string logger_name;
+    std::string payload;
+  };
+
+  void Run();
+  // Writes the published messages to the sinks. Takes the consumer role.
+  void Drain();
+
+  std::vector<spdlog::sink_ptr> sinks_;
+  mpsc_ring<Record> ring_;
+  std::chrono::milliseconds flush_interval_;
+  // Dropped since the flusher last reported them, and in total.
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> dropped_total_{0};
+
+  // Serializes the consumers of the ring (the flusher and flush()).
+  std::mutex drain_mutex_;
+  // Wakes the flusher early. Notified without holding the mutex, as a missed
+  // wake only delays the messages until the next interval.
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<bool> stop_{false};
+  std::thread flusher_;
+};
+
+}  // namespace shortfin::logging
+
+#endif  // SHORTFIN_SUPPORT_ASYNC_LOG_SINK_H
@@ -0,0 +1,96 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/support/async_log_sink.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spdlog/sinks/ostream_sink.h"
+#include "spdlog/spdlog.h"
+
+namespace shortfin::logging {
+
+namespace {
+
+size_t CountLines(const std::string &text, const std::string &needle) {
+  size_t count = 0;
+  std::istringstream lines(text);
+  for (std::string line; std::getline(lines, line);) {
+    if (line.find(needle) != std::string::npos) ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(AsyncLogSinkTest, writes_all_messages_on_flush) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 200;
+  std::ostringstream out;
+  auto target = std::make_shared<spdlog::sinks::ostream_sink_mt>(out);
+  target->set_pattern("%l %v");
+  auto sink = std::make_shared<AsyncLogSink>(
+      std::vector<spdlog::sink_ptr>{target}, kThreads * kPerThread,
+      std::chrono::milliseconds(1));
+  spdlog::logger logger("async_test", sink);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&logger, t]() {
+      for (int i = 0; i < kPerThread; ++i) logger.info("msg {} {}", t, i);
+    });
+  }
+  for (auto &t : threads) t.join();
+  logger.flush();
+
+  EXPECT_EQ(CountLines(out.str(), "info msg"), kThreads * kPerThread);
+  EXPECT_EQ(sink->dropped_count(), 0u);
+}
+
+TEST(AsyncLogSinkTest, drops_and_reports_when_full) {
+  std::ostringstream out;
+  auto target = std::make_shared<spdlog::sinks::ostream_sink_mt>(out);
+  target->set_pattern("%l %v");
+  // The flusher does not run within the test, so the ring fills up.
+  auto sink = std::make_shared<AsyncLogSink>(
+      std::vector<spdlog::sink_ptr>{target}, 4, std::chrono::hours(1));
+  spdlog::logger logger("async_test", sink);
+  for (int i = 0; i < 10; ++i) logger.info("msg {}", i);
+  EXPECT_EQ(sink->dropped_count(), 6u);
+  logger.flush();
+
+  std::string text = out.str();
+  EXPECT_EQ(CountLines(text, "info msg"), 4u);
+  EXPECT_THAT(text, testing::HasSubstr("warning Dropped 6 log messages"));
+  // The count is only reported once.
+  logger.flush();
+  EXPECT_EQ(CountLines(out.str(), "Dropped"), 1u);
+}
+
+TEST(AsyncLogSinkTest, respects_sink_levels) {
+  std::ostringstream out;
+  auto target = std::make_shared<spdlog::sinks::ostream_sink_mt>(out);
+  target->set_pattern("%v");
+  target->set_level(spdlog::level::warn);
+  auto sink = std::make_shared<AsyncLogSink>(
+      std::vector<spdlog::sink_ptr>{target}, 16);
+  spdlog::logger logger("async_test", sink);
+  logger.info("quiet");
+  logger.error("loud");
+  logger.flush();
+  EXPECT_EQ(out.str().find("quiet"), std::string::npos);
+  EXPECT_THAT(out.str(), testing::HasSubstr("loud"));
+}
+
+}  // namespace shortfin::logging
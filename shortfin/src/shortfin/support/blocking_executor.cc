@@ -6,13 +6,19 @@
 
 #include "shortfin/support/blocking_executor.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "fmt/core.h"
 #include "shortfin/support/logging.h"
 
 namespace shortfin {
 
+BlockingExecutor::BlockingExecutor(iree_allocator_t allocator,
+                                   Options options)
+    : allocator_(allocator), options_(options) {}
 BlockingExecutor::BlockingExecutor(iree_allocator_t allocator)
-    : allocator_(allocator) {}
+    : BlockingExecutor(allocator, Options()) {}
 BlockingExecutor::~BlockingExecutor() { Kill(/*wait=*/true); }
 
 bool BlockingExecutor::has_free_threads() {
@@ -20,6 +26,73 @@ bool BlockingExecutor::has_free_threads() {
   return free_threads_ != nullptr;
 }
 
+BlockingExecutor::Options BlockingExecutor::options() {
+  iree::slim_mutex_lock_guard g(control_mu_);
+  return options_;
+}
+
+void BlockingExecutor::SetOptions(Options options) {
+  if (options.min_threads < 0 || options.max_threads < 0 ||
+      (options.max_threads > 0 && options.min_threads > options.max_threads)) {
+    throw std::invalid_argument(fmt::format(
+        "Illegal BlockingExecutor thread bounds: min_threads={}, "
+        "max_threads={}",
+        options.min_threads, options.max_threads));
+  }
+  std::vector<ThreadInstance *> started;
+  {
+    iree::slim_mutex_lock_guard g(control_mu_);
+    options_ = options;
+    // A raised max_threads can take over tasks that were queued against the
+    // old bound.
+    while (!queued_tasks_.empty() && !inhibit_ &&
+           (options_.max_threads == 0 ||
+            live_thread_count_ < options_.max_threads)) {
+      QueuedTask &front = queued_tasks_.front();
+      started.push_back(
+          CreateThreadLocked(std::move(front.task), front.schedule_time_ns));
+      queued_tasks_.pop_front();
+    }
+  }
+  for (ThreadInstance *inst : started) {
+    inst->signal_transact.set();
+    iree_thread_resume(inst->thread);
+  }
+}
+
+BlockingExecutor::Metrics BlockingExecutor::metrics() {
+  Metrics m;
+  std::vector<iree_duration_t> latencies;
+  {
+    iree::slim_mutex_lock_guard g(control_mu_);
+    m.live_threads = live_thread_count_;
+    m.free_threads = free_thread_count_;
+    m.active_threads = live_thread_count_ - free_thread_count_;
+    m.queued_tasks = queued_tasks_.size();
+    m.completed_tasks = completed_task_count_;
+    m.rejected_tasks = rejected_task_count_;
+    m.reaped_threads = reaped_thread_count_;
+    latencies.assign(
+        latencies_ns_.begin(),
+        latencies_ns_.begin() + std::min(latency_count_, kLatencyWindow));
+  }
+  if (!latencies.empty()) {
+    auto percentile = [&](size_t pct) {
+      auto nth = latencies.begin() + (latencies.size() - 1) * pct / 100;
+      std::nth_element(latencies.begin(), nth, latencies.end());
+      return *nth;
+    };
+    m.p50_task_latency_ns = percentile(50);
+    m.p99_task_latency_ns = percentile(99);
+  }
+  return m;
+}
+
+void BlockingExecutor::RecordLatencyLocked(iree_duration_t latency_ns) {
+  latencies_ns_[latency_count_ % kLatencyWindow] = latency_ns;
+  latency_count_ += 1;
+}
+
 void BlockingExecutor::Kill(bool wait, iree_timeout_t warn_timeout) {
   {
     iree::slim_mutex_lock_guard g(control_mu_);
@@ -44,6 +117,8 @@ void BlockingExecutor::Kill(bool wait, iree_timeout_t warn_timeout) {
         current->signal_transact.set();
         free_threads_ = current->next;
         current->next = nullptr;
+        current->is_free = false;
+        free_thread_count_ -= 1;
       }
     }
 
@@ -91,8 +166,40 @@ void BlockingExecutor::Kill(bool wait, iree_timeout_t warn_timeout) {
 }
 
 void BlockingExecutor::Schedule(Task task) {
+  if (!TrySchedule(task)) {
+    throw std::runtime_error(
+        fmt::format("BlockingExecutor task queue is full ({} tasks queued)",
+                    options().max_queued_tasks));
+  }
+}
+
+BlockingExecutor::ThreadInstance *BlockingExecutor::CreateThreadLocked(
+    Task task, iree_time_t schedule_time_ns) {
+  std::string name = fmt::format("blocking-{}", created_thread_count_++);
+  iree_thread_create_params_t params = {
+      .name = {name.data(), name.size()},
+      .create_suspended = true,
+  };
+  auto *target = new ThreadInstance(this);
+  auto EntryFunction = +[](void *self) noexcept {
+    return static_cast<ThreadInstance *>(self)->RunOnThread();
+  };
+  auto status = iree_thread_create(EntryFunction, target, params, allocator_,
+                                   target->thread.for_output());
+  if (!iree_status_is_ok(status)) {
+    delete target;
+    SHORTFIN_THROW_IF_ERROR(status);
+  }
+  live_thread_count_ += 1;
+  target->current_task = std::move(task);
+  target->current_schedule_time_ns = schedule_time_ns;
+  return target;
+}
+
+bool BlockingExecutor::TrySchedule(Task &task) {
   ThreadInstance *target;
   bool target_is_new = false;
+  iree_time_t now_ns = iree_time_now();
   {
     iree::slim_mutex_lock_guard g(control_mu_);
     if (inhibit_) {
@@ -104,27 +211,25 @@ void BlockingExecutor::Schedule(Task task) {
       // Edit out of free list.
       free_threads_ = target->next;
       target->next = nullptr;
+      target->is_free = false;
+      free_thread_count_ -= 1;
+      target->current_task = std::move(task);
+      target->current_schedule_time_ns = now_ns;
+    } else if (options_.max_threads > 0 &&
+               live_thread_count_ >= options_.max_threads) {
+      // At the bound: queue for the next thread to finish.
+      if (options_.max_queued_tasks > 0 &&
+          queued_tasks_.size() >= options_.max_queued_tasks) {
+        rejected_task_count_ += 1;
+        return false;
+      }
+      queued_tasks_.push_back(QueuedTask{std::move(task), now_ns});
+      return true;
     } else {
       // Create new.
-      std::string name = fmt::format("blocking-{}", created_thread_count_++);
-      iree_thread_create_params_t params = {
-          .name = {name.data(), name.size()},
-          .create_suspended = true,
-      };
-      target = new ThreadInstance(this);
-      auto EntryFunction = +[](void *self) noexcept {
-        return static_cast<ThreadInstance *>(self)->RunOnThread();
-      };
-      auto status = iree_thread_create(EntryFunction, target, params,
-                                       allocator_, target->thread.for_output());
-      if (!iree_status_is_ok(status)) {
-        delete target;
-        SHORTFIN_THROW_IF_ERROR(status);
-      }
+      target = CreateThreadLocked(std::move(task), now_ns);
       target_is_new = true;
-      live_thread_count_ += 1;
     }
-    target->current_task = std::move(task);
   }
 
   // Out of lock, continue dispatch.
@@ -132,21 +237,59 @@ void BlockingExecutor::Schedule(Task task) {
   if (target_is_new) {
     iree_thread_resume(target->thread);
   }
+  return true;
 }
 
-bool BlockingExecutor::LockAndMoveToFreeList(ThreadInstance *inst) {
+BlockingExecutor::NextStep BlockingExecutor::LockAndFinishTask(
+    ThreadInstance *inst, bool ran_task) {
+  iree_time_t now_ns = ran_task ? iree_time_now() : 0;
   iree::slim_mutex_lock_guard g(control_mu_);
-  // If still running, add to free list. Else delete.
-  if (kill_) {
+  if (ran_task) {
+    completed_task_count_ += 1;
+    RecordLatencyLocked(now_ns - inst->current_schedule_time_ns);
+  }
+  // Queued tasks are run even when killed so that none are lost.
+  if (!queued_tasks_.empty()) {
+    QueuedTask &front = queued_tasks_.front();
+    inst->current_task = std::move(front.task);
+    inst->current_schedule_time_ns = front.schedule_time_ns;
+    queued_tasks_.pop_front();
+    return NextStep::kRun;
+  }
+  // If still running (and within bounds), add to free list. Else delete.
+  if (kill_ || (options_.max_threads > 0 &&
+                live_thread_count_ > options_.max_threads)) {
     inst->executor = nullptr;
     live_thread_count_ -= 1;
-    return false;
+    return NextStep::kExit;
   } else {
     inst->next = free_threads_;
+    inst->is_free = true;
     free_threads_ = inst;
+    free_thread_count_ += 1;
     inst->signal_transact.reset();
-    return true;
+    return NextStep::kWait;
+  }
+}
+
+bool BlockingExecutor::LockAndMaybeReap(ThreadInstance *inst) {
+  iree::slim_mutex_lock_guard g(control_mu_);
+  // Claimed by Schedule (or woken by Kill) since the wait timed out.
+  if (!inst->is_free) return false;
+  if (live_thread_count_ <= options_.min_threads) return false;
+  for (ThreadInstance **link = &free_threads_; *link; link = &(*link)->next) {
+    if (*link == inst) {
+      *link = inst->next;
+      break;
+    }
   }
+  inst->next = nullptr;
+  inst->is_free = false;
+  inst->executor = nullptr;
+  free_thread_count_ -= 1;
+  live_thread_count_ -= 1;
+  reaped_thread_count_ += 1;
+  return true;
 }
 
 BlockingExecutor::ThreadInstance::ThreadInstance(BlockingExecutor *executor)
@@ -154,20 +297,38 @@ BlockingExecutor::ThreadInstance::ThreadInstance(BlockingExecutor *executor)
 
 int BlockingExecutor::ThreadInstance::RunOnThread() noexcept {
   for (;;) {
-    auto status = iree_wait_source_wait_one(signal_transact.await(),
-                                            iree_infinite_timeout());
+    iree_timeout_t timeout = iree_infinite_timeout();
+    {
+      iree::slim_mutex_lock_guard g(executor->control_mu_);
+      if (executor->options_.idle_timeout_ns != IREE_DURATION_INFINITE) {
+        timeout = iree_make_timeout_ns(executor->options_.idle_timeout_ns);
+      }
+    }
+    auto status = iree_wait_source_wait_one(signal_transact.await(), timeout);
+    if (iree_status_is_deadline_exceeded(status)) {
+      iree_status_ignore(status);
+      if (executor->LockAndMaybeReap(this)) break;
+      continue;
+    }
     IREE_CHECK_OK(status);
     Task exec_task;
     {
       iree::slim_mutex_lock_guard g(executor->control_mu_);
       exec_task = std::move(current_task);
     }
-    if (exec_task) {
-      exec_task();
-    }
-    if (!executor->LockAndMoveToFreeList(this)) {
-      break;
+    NextStep next_step;
+    for (;;) {
+      bool ran_task = static_cast<bool>(exec_task);
+      if (ran_task) {
+        exec_task();
+        exec_task = nullptr;
+      }
+      next_step = executor->LockAndFinishTask(this, ran_task);
+      if (next_step != NextStep::kRun) break;
+      // Only this thread touches current_task while it is not free.
+      exec_task = std::move(current_task);
     }
+    if (next_step == NextStep::kExit) break;
   }
 
   delete this;
@@ -7,6 +7,9 @@
 #ifndef SHORTFIN_SUPPORT_BLOCKING_EXECUTOR_H
 #define SHORTFIN_SUPPORT_BLOCKING_EXECUTOR_H
 
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <functional>
 
 #include "shortfin/support/iree_concurrency.h"
@@ -18,22 +21,71 @@ namespace shortfin {
 // creating a new one whenever starvation would occur. Since it is explicitly
 // meant for offloading blocking operations, we can make no further assumptions
 // about it being legal to run with a more limited number of threads.
+//
+// Deployments that know their blocking work does not depend on other blocking
+// work completing (i.e. file loading, tokenization) can bound the pool with
+// Options: beyond max_threads, tasks queue for the next free thread, and idle
+// threads beyond min_threads are reaped.
 class SHORTFIN_API BlockingExecutor {
  public:
   using Task = std::function<void()>;
+
+  struct Options {
+    // Idle threads are not reaped below this count.
+    int min_threads = 0;
+    // Maximum number of threads. Once reached, tasks queue until a thread is
+    // free. 0 is unbounded (a thread is created whenever none is free).
+    int max_threads = 0;
+    // Threads above min_threads exit after being idle this long. Infinite
+    // keeps idle threads forever.
+    iree_duration_t idle_timeout_ns = IREE_DURATION_INFINITE;
+    // Maximum number of queued tasks (only tasks waiting for a thread are
+    // counted). 0 is unbounded.
+    size_t max_queued_tasks = 0;
+  };
+
+  struct Metrics {
+    // Threads currently alive.
+    int live_threads = 0;
+    // Threads running a task.
+    int active_threads = 0;
+    // Threads waiting for a task.
+    int free_threads = 0;
+    // Tasks waiting for a thread.
+    size_t queued_tasks = 0;
+    uint64_t completed_tasks = 0;
+    uint64_t rejected_tasks = 0;
+    uint64_t reaped_threads = 0;
+    // Percentiles of the time from Schedule to task completion, over the
+    // most recently completed tasks. 0 if none have completed.
+    iree_duration_t p50_task_latency_ns = 0;
+    iree_duration_t p99_task_latency_ns = 0;
+  };
+
+  BlockingExecutor(iree_allocator_t allocator, Options options);
   BlockingExecutor(iree_allocator_t allocator);
   BlockingExecutor() : BlockingExecutor(iree_allocator_system()) {}
   ~BlockingExecutor();
 
+  // Replaces the options. Applies to subsequent scheduling and reaping:
+  // threads beyond a lowered max_threads exit as they become free.
+  void SetOptions(Options options);
+  Options options();
+
   // Send a kill signal, optionally waiting indefinitely for shutdown.
   void Kill(bool wait = true,
             iree_timeout_t warn_timeout = iree_make_timeout_ms(5000));
 
   // Schedule task to run at some point in the future (which may be before
   // this function returns). The task must not throw any exceptions (or the
-  // program will terminate).
+  // program will terminate). Throws std::runtime_error if the task queue is
+  // bounded and full.
   void Schedule(Task task);
 
+  // Like Schedule, but returns false (without taking the task) if the task
+  // queue is bounded and full.
+  bool TrySchedule(Task &task);
+
   // Total number of threads created over the lifetime of this instance.
   // This may not be the same as the count of those currently alive.
   int created_thread_count() const { return created_thread_count_; }
@@ -42,7 +94,14 @@ class SHORTFIN_API BlockingExecutor {
   // used for testing.
   bool has_free_threads();
 
+  Metrics metrics();
+
  private:
+  struct QueuedTask {
+    Task task;
+    iree_time_t schedule_time_ns;
+  };
+
   // Free thread instances are managed in a simple linked list.
   struct ThreadInstance {
     ThreadInstance(BlockingExecutor *executor);
@@ -50,19 +109,42 @@ class SHORTFIN_API BlockingExecutor {
     iree::thread_ptr thread;
     iree::event signal_transact;
     Task current_task;
+    iree_time_t current_schedule_time_ns = 0;
     ThreadInstance *next = nullptr;
+    bool is_free = false;
 
     int RunOnThread() noexcept;
   };
-  // Returns whether the thread should keep running. If false, the caller
-  // must immediately deallocate and exit. It must not assume that
-  // inst->executor is valid.
-  bool LockAndMoveToFreeList(ThreadInstance *inst);
+  // What a thread does after finishing a task.
+  enum class NextStep { kRun, kWait, kExit };
+
+  // Creates a suspended thread that will run `task` once resumed.
+  ThreadInstance *CreateThreadLocked(Task task, iree_time_t schedule_time_ns);
+  // Called when a thread finishes a task (or wakes without one). Hands it
+  // the next queued task (kRun) if there is one, else moves it to the free
+  // list (kWait). On kExit, the caller must immediately deallocate and exit.
+  // It must not assume that inst->executor is valid.
+  NextStep LockAndFinishTask(ThreadInstance *inst, bool ran_task);
+  // Called when a free thread has been idle for idle_timeout_ns. Returns
+  // whether it should exit (with the same contract as kExit above).
+  bool LockAndMaybeReap(ThreadInstance *inst);
+  void RecordLatencyLocked(iree_duration_t latency_ns);
+
   iree_allocator_t allocator_;
   iree::slim_mutex control_mu_;
+  Options options_ SHORTFIN_GUARDED_BY(control_mu_);
   ThreadInstance *free_threads_ = nullptr;
+  std::deque<QueuedTask> queued_tasks_ SHORTFIN_GUARDED_BY(control_mu_);
   int created_thread_count_ = 0;
   int live_thread_count_ = 0;
+  int free_thread_count_ = 0;
+  uint64_t completed_task_count_ = 0;
+  uint64_t rejected_task_count_ = 0;
+  uint64_t reaped_thread_count_ = 0;
+  // Ring of the most recent task latencies.
+  static constexpr size_t kLatencyWindow = 1024;
+  std::array<iree_duration_t, kLatencyWindow> latencies_ns_;
+  size_t latency_count_ = 0;
   bool kill_ = false;
   bool inhibit_ = false;
 };
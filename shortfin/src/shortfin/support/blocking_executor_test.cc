@@ -107,4 +107,100 @@ TEST_F(BlockingExecutorTest, threads_recycle) {
   }
 }
 
+TEST_F(BlockingExecutorTest, bounded_threads_queue) {
+  std::atomic<int> tasks_run{0};
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  iree::event release(false);
+
+  BlockingExecutor executor(iree_allocator_system(),
+                            {.max_threads = 2, .max_queued_tasks = 3});
+  auto task = [&]() {
+    int now_running = running.fetch_add(1) + 1;
+    int prev = max_running.load();
+    while (prev < now_running &&
+           !max_running.compare_exchange_weak(prev, now_running)) {
+    }
+    IREE_CHECK_OK(iree_wait_source_wait_one(release.await(),
+                                            iree_infinite_timeout()));
+    running.fetch_sub(1);
+    tasks_run.fetch_add(1);
+  };
+  for (int i = 0; i < 5; ++i) {
+    executor.Schedule(task);
+  }
+  // Two running, three queued: the next one is rejected.
+  BlockingExecutor::Task rejected = task;
+  EXPECT_FALSE(executor.TrySchedule(rejected));
+  EXPECT_TRUE(rejected);
+  EXPECT_THROW(executor.Schedule(task), std::runtime_error);
+  auto metrics = executor.metrics();
+  EXPECT_EQ(metrics.live_threads, 2);
+  EXPECT_EQ(metrics.queued_tasks, 3u);
+  EXPECT_EQ(metrics.rejected_tasks, 2u);
+
+  release.set();
+  executor.Kill(/*wait=*/true);
+  EXPECT_EQ(tasks_run.load(), 5);
+  EXPECT_LE(max_running.load(), 2);
+  EXPECT_EQ(executor.created_thread_count(), 2);
+  metrics = executor.metrics();
+  EXPECT_EQ(metrics.completed_tasks, 5u);
+  EXPECT_GT(metrics.p99_task_latency_ns, 0);
+  EXPECT_GE(metrics.p99_task_latency_ns, metrics.p50_task_latency_ns);
+}
+
+TEST_F(BlockingExecutorTest, raise_max_threads_starts_queued) {
+  std::atomic<int> tasks_run{0};
+  iree::event release(false);
+
+  BlockingExecutor executor(iree_allocator_system(), {.max_threads = 1});
+  executor.Schedule([&]() {
+    IREE_CHECK_OK(iree_wait_source_wait_one(release.await(),
+                                            iree_infinite_timeout()));
+    tasks_run.fetch_add(1);
+  });
+  executor.Schedule([&]() { tasks_run.fetch_add(1); });
+  EXPECT_EQ(executor.metrics().queued_tasks, 1u);
+
+  // The queued task no longer waits on the blocked one.
+  executor.SetOptions({.max_threads = 2});
+  while (tasks_run.load() == 0) {
+    iree_wait_until(iree_timeout_as_deadline_ns(iree_make_timeout_ms(10)));
+  }
+  release.set();
+  executor.Kill(/*wait=*/true);
+  EXPECT_EQ(tasks_run.load(), 2);
+  EXPECT_THROW(executor.SetOptions({.min_threads = 3, .max_threads = 2}),
+               std::invalid_argument);
+}
+
+TEST_F(BlockingExecutorTest, reap_idle_threads) {
+  std::atomic<int> tasks_run{0};
+
+  BlockingExecutor executor(
+      iree_allocator_system(),
+      {.min_threads = 1, .idle_timeout_ns = 20 * 1000 * 1000});
+  for (int i = 0; i < 4; ++i) {
+    executor.Schedule([&tasks_run]() {
+      iree_wait_until(iree_timeout_as_deadline_ns(iree_make_timeout_ms(50)));
+      tasks_run.fetch_add(1);
+    });
+  }
+  // Threads beyond min_threads exit once idle.
+  for (int i = 0; i < 200 && executor.metrics().reaped_threads < 3; ++i) {
+    iree_wait_until(iree_timeout_as_deadline_ns(iree_make_timeout_ms(10)));
+  }
+  auto metrics = executor.metrics();
+  EXPECT_EQ(metrics.reaped_threads, 3u);
+  EXPECT_EQ(metrics.live_threads, 1);
+  EXPECT_EQ(metrics.free_threads, 1);
+
+  // The remaining thread is reused.
+  executor.Schedule([&tasks_run]() { tasks_run.fetch_add(1); });
+  executor.Kill(/*wait=*/true);
+  EXPECT_EQ(tasks_run.load(), 5);
+  EXPECT_EQ(executor.created_thread_count(), 4);
+}
+
 }  // namespace shortfin
@@ -0,0 +1,191 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/support/host_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "fmt/core.h"
+
+namespace shortfin {
+
+namespace {
+
+// The bandwidth bound host ops stop scaling well before the core count on
+// large machines, so by default the pool is kept modest.
+constexpr size_t kMaxDefaultThreads = 8;
+
+size_t DefaultThreadCount() {
+  // Leave one for the calling thread, which participates in every job.
+  size_t hardware = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+  return std::min(hardware - 1, kMaxDefaultThreads);
+}
+
+}  // namespace
+
+struct HostThreadPool::Job {
+  const ChunkFunction *fn;
+  size_t count;
+  size_t chunk_size;
+  size_t chunk_count;
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<size_t> pending_chunks;
+  // Pool threads that have picked up this job and not yet let go of it.
+  // Guarded by the pool's control_mu_.
+  int participants = 0;
+
+  void RunChunks() noexcept {
+    for (;;) {
+      size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= chunk_count) break;
+      size_t begin = chunk * chunk_size;
+      (*fn)(begin, std::min(count, begin + chunk_size));
+      pending_chunks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+  }
+};
+
+HostThreadPool::HostThreadPool(iree_allocator_t allocator, size_t thread_count)
+    : allocator_(allocator),
+      thread_count_(thread_count ? thread_count : DefaultThreadCount()) {
+  iree_notification_initialize(&work_notification_);
+  iree_notification_initialize(&done_notification_);
+}
+
+HostThreadPool::~HostThreadPool() {
+  Kill();
+  iree_notification_deinitialize(&work_notification_);
+  iree_notification_deinitialize(&done_notification_);
+}
+
+void HostThreadPool::Kill() {
+  std::vector<iree::thread_ptr> threads;
+  {
+    iree::slim_mutex_lock_guard g(control_mu_);
+    kill_ = true;
+    threads.swap(threads_);
+  }
+  iree_notification_post(&work_notification_, IREE_ALL_WAITERS);
+  // Releasing the last reference joins each thread.
+  threads.clear();
+}
+
+void HostThreadPool::EnsureStarted() {
+  if (!threads_.empty()) return;
+  threads_.reserve(thread_count_);
+  for (size_t i = 0; i < thread_count_; ++i) {
+    std::string name = fmt::format("host-pool-{}", i);
+    iree_thread_create_params_t params = {
+        .name = {name.data(), name.size()},
+    };
+    auto EntryFunction = +[](void *self) noexcept {
+      return static_cast<HostThreadPool *>(self)->RunOnThread();
+    };
+    iree::thread_ptr thread;
+    SHORTFIN_THROW_IF_ERROR(iree_thread_create(
+        EntryFunction, this, params, allocator_, thread.for_output()));
+    threads_.push_back(std::move(thread));
+  }
+}
+
+void HostThreadPool::ParallelFor(size_t count, size_t min_chunk,
+                                 const ChunkFunction &fn) {
+  if (count == 0) return;
+  min_chunk = std::max<size_t>(min_chunk, 1);
+  size_t chunk_count =
+      std::min(thread_count_ + 1, (count + min_chunk - 1) / min_chunk);
+  if (chunk_count <= 1 || !iree_slim_mutex_try_lock(submit_mu_)) {
+    fn(0, count);
+    return;
+  }
+  struct SubmitUnlock {
+    iree::slim_mutex &mu;
+    ~SubmitUnlock() { mu.Unlock(); }
+  } submit_unlock{submit_mu_};
+
+  Job job;
+  job.fn = &fn;
+  job.count = count;
+  job.chunk_size = (count + chunk_count - 1) / chunk_count;
+  job.chunk_count = (count + job.chunk_size - 1) / job.chunk_size;
+  job.pending_chunks.store(job.chunk_count, std::memory_order_relaxed);
+  bool killed;
+  {
+    iree::slim_mutex_lock_guard g(control_mu_);
+    killed = kill_;
+    if (!killed) {
+      EnsureStarted();
+      job_ = &job;
+      generation_ += 1;
+    }
+  }
+  if (killed) {
+    fn(0, count);
+    return;
+  }
+  iree_notification_post(&work_notification_, IREE_ALL_WAITERS);
+
+  job.RunChunks();
+
+  // Wait until every chunk has run and no pool thread still references the
+  // job. The job is unpublished under the same lock that checks for
+  // participants, so no thread can pick it up once it is found complete.
+  struct WaitState {
+    HostThreadPool *self;
+    Job *job;
+  } wait_state{this, &job};
+  iree_notification_await(
+      &done_notification_,
+      +[](void *arg) -> bool {
+        auto *state = static_cast<WaitState *>(arg);
+        iree::slim_mutex_lock_guard g(state->self->control_mu_);
+        if (state->job->pending_chunks.load(std::memory_order_acquire) != 0 ||
+            state->job->participants != 0) {
+          return false;
+        }
+        state->self->job_ = nullptr;
+        return true;
+      },
+      &wait_state, iree_infinite_timeout());
+}
+
+int HostThreadPool::RunOnThread() noexcept {
+  struct WaitState {
+    HostThreadPool *self;
+    uint64_t seen_generation;
+  } wait_state{this, 0};
+  for (;;) {
+    iree_notification_await(
+        &work_notification_,
+        +[](void *arg) -> bool {
+          auto *state = static_cast<WaitState *>(arg);
+          iree::slim_mutex_lock_guard g(state->self->control_mu_);
+          return state->self->kill_ ||
+                 state->self->generation_ != state->seen_generation;
+        },
+        &wait_state, iree_infinite_timeout());
+
+    Job *job;
+    {
+      iree::slim_mutex_lock_guard g(control_mu_);
+      if (kill_) return 0;
+      wait_state.seen_generation = generation_;
+      job = job_;
+      if (!job) continue;
+      job->participants += 1;
+    }
+    job->RunChunks();
+    {
+      iree::slim_mutex_lock_guard g(control_mu_);
+      job->participants -= 1;
+    }
+    iree_notification_post(&done_notification_, IREE_ALL_WAITERS);
+  }
+}
+
+}  // namespace shortfin
@@ -0,0 +1,71 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_SUPPORT_HOST_THREAD_POOL_H
+#define SHORTFIN_SUPPORT_HOST_THREAD_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "shortfin/support/iree_concurrency.h"
+
+namespace shortfin {
+
+// A fixed size pool of threads for splitting compute bound host work (i.e.
+// host array ops over a batch axis) away from the worker loops. Unlike the
+// BlockingExecutor, work run here must not block: ParallelFor partitions a
+// range across the pool and the calling thread and returns once every chunk
+// has run. Threads are started on first use.
+//
+// Only one ParallelFor occupies the pool at a time. A call made while the
+// pool is busy (i.e. from another worker) runs inline on its calling thread
+// rather than queuing behind the first.
+class SHORTFIN_API HostThreadPool {
+ public:
+  using ChunkFunction = std::function<void(size_t begin, size_t end)>;
+
+  // A thread_count of 0 sizes the pool from the hardware concurrency.
+  HostThreadPool(iree_allocator_t allocator, size_t thread_count = 0);
+  HostThreadPool() : HostThreadPool(iree_allocator_system()) {}
+  ~HostThreadPool();
+
+  // Stops and joins the pool threads. Subsequent work runs inline.
+  void Kill();
+
+  // Number of pool threads. The calling thread of ParallelFor also executes
+  // chunks, so up to thread_count() + 1 chunks run concurrently.
+  size_t thread_count() const { return thread_count_; }
+
+  // Invokes `fn` over a partition of [0, count) into contiguous chunks of at
+  // least `min_chunk` items and blocks until all have completed. The chunks
+  // may run concurrently and `fn` must not throw.
+  void ParallelFor(size_t count, size_t min_chunk, const ChunkFunction &fn);
+
+ private:
+  struct Job;
+  void EnsureStarted() SHORTFIN_REQUIRES_LOCK(control_mu_);
+  int RunOnThread() noexcept;
+
+  iree_allocator_t allocator_;
+  size_t thread_count_;
+  // Held for the duration of a ParallelFor that is using the pool.
+  iree::slim_mutex submit_mu_;
+  iree::slim_mutex control_mu_;
+  // Posted when a job is published or the pool is killed.
+  iree_notification_t work_notification_;
+  // Posted each time a pool thread finishes its share of a job.
+  iree_notification_t done_notification_;
+  std::vector<iree::thread_ptr> threads_ SHORTFIN_GUARDED_BY(control_mu_);
+  Job *job_ SHORTFIN_GUARDED_BY(control_mu_) = nullptr;
+  uint64_t generation_ SHORTFIN_GUARDED_BY(control_mu_) = 0;
+  bool kill_ SHORTFIN_GUARDED_BY(control_mu_) = false;
+};
+
+}  // namespace shortfin
+
+#endif  // SHORTFIN_SUPPORT_HOST_THREAD_POOL_H
@@ -0,0 +1,70 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/support/host_thread_pool.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "shortfin/support/blocking_executor.h"
+
+namespace shortfin {
+
+TEST(HostThreadPoolTest, covers_range_once) {
+  HostThreadPool pool(iree_allocator_system(), /*thread_count=*/3);
+  for (size_t count : {1, 2, 7, 100, 1001}) {
+    std::vector<std::atomic<int>> hits(count);
+    pool.ParallelFor(count, /*min_chunk=*/4, [&](size_t begin, size_t end) {
+      EXPECT_LT(begin, end);
+      for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+    });
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(hits[i].load(), 1) << "count=" << count << " i=" << i;
+    }
+  }
+}
+
+TEST(HostThreadPoolTest, small_ranges_run_inline) {
+  HostThreadPool pool(iree_allocator_system(), /*thread_count=*/3);
+  int calls = 0;
+  pool.ParallelFor(10, /*min_chunk=*/10, [&](size_t begin, size_t end) {
+    EXPECT_EQ(begin, 0u);
+    EXPECT_EQ(end, 10u);
+    calls += 1;
+  });
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(HostThreadPoolTest, concurrent_submitters) {
+  HostThreadPool pool(iree_allocator_system(), /*thread_count=*/2);
+  std::atomic<size_t> total{0};
+  BlockingExecutor executor;
+  for (int t = 0; t < 4; ++t) {
+    executor.Schedule([&]() {
+      for (int i = 0; i < 100; ++i) {
+        pool.ParallelFor(50, /*min_chunk=*/1, [&](size_t begin, size_t end) {
+          total.fetch_add(end - begin);
+        });
+      }
+    });
+  }
+  executor.Kill(/*wait=*/true);
+  EXPECT_EQ(total.load(), 4u * 100 * 50);
+}
+
+TEST(HostThreadPoolTest, runs_inline_after_kill) {
+  HostThreadPool pool(iree_allocator_system(), /*thread_count=*/2);
+  pool.Kill();
+  size_t total = 0;
+  pool.ParallelFor(100, /*min_chunk=*/1,
+                   [&](size_t begin, size_t end) { total += end - begin; });
+  EXPECT_EQ(total, 100u);
+}
+
+}  // namespace shortfin
@@ -0,0 +1,154 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_SUPPORT_INLINE_FUNCTION_H
+#define SHORTFIN_SUPPORT_INLINE_FUNCTION_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace shortfin {
+
+template <typename Signature, size_t InlineSize = 48>
+class inline_function;
+
+// Move-only, type erased callable that stores callables of up to InlineSize
+// bytes in place, without allocating. Larger callables (or ones that may throw
+// when moved) are kept on the heap, as std::function would. Moving is always
+// noexcept, which lets these be stored in lock free containers (i.e.
+// mpsc_ring).
+//
+// Unlike std::function, this does not require the callable to be copyable,
+// so lambdas can capture move-only state.
+template <typename R, typename... Args, size_t InlineSize>
+class inline_function<R(Args...), InlineSize> {
+  static_assert(InlineSize >= sizeof(void *),
+                "inline_function must be able to hold a heap pointer");
+
+ public:
+  inline_function() noexcept = default;
+  inline_function(std::nullptr_t) noexcept {}
+
+  template <typename F, typename Fn = std::decay_t<F>,
+            typename = std::enable_if_t<
+                !std::is_same_v<Fn, inline_function> &&
+                std::is_invocable_r_v<R, Fn &, Args...>>>
+  inline_function(F &&f) {
+    if constexpr (std::is_pointer_v<Fn> ||
+                  std::is_member_pointer_v<Fn> ||
+                  std::is_same_v<Fn, std::function<R(Args...)>>) {
+      // Empty targets behave as empty functions.
+      if (!f) return;
+    }
+    if constexpr (kFitsInline<Fn>) {
+      new (storage_) Fn(std::forward<F>(f));
+      ops_ = &kInlineOps<Fn>;
+    } else {
+      *reinterpret_cast<Fn **>(storage_) = new Fn(std::forward<F>(f));
+      ops_ = &kHeapOps<Fn>;
+    }
+  }
+
+  inline_function(inline_function &&other) noexcept { MoveFrom(other); }
+  inline_function &operator=(inline_function &&other) noexcept {
+    if (this != &other) {
+      reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  inline_function(const inline_function &) = delete;
+  inline_function &operator=(const inline_function &) = delete;
+  ~inline_function() { reset(); }
+
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+  // Whether the target is stored in place (vs on the heap).
+  bool is_inline() const noexcept { return ops_ && ops_->is_inline; }
+
+  R operator()(Args... args) {
+    if (!ops_) throw std::bad_function_call();
+    return ops_->invoke(storage_, std::forward<Args>(args)...);
+  }
+
+  void reset() noexcept {
+    if (ops_) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+ private:
+  struct Ops {
+    R (*invoke)(void *storage, Args &&...args);
+    // Move constructs into `to` and destroys `from`.
+    void (*relocate)(void *from, void *to) noexcept;
+    void (*destroy)(void *storage) noexcept;
+    bool is_inline;
+  };
+
+  template <typename Fn>
+  static constexpr bool kFitsInline =
+      sizeof(Fn) <= InlineSize &&
+      alignof(Fn) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<Fn>;
+
+  template <typename Fn>
+  static constexpr Ops kInlineOps = {
+      .invoke =
+          [](void *storage, Args &&...args) -> R {
+        return std::invoke(*std::launder(reinterpret_cast<Fn *>(storage)),
+                           std::forward<Args>(args)...);
+      },
+      .relocate =
+          [](void *from, void *to) noexcept {
+            Fn *f = std::launder(reinterpret_cast<Fn *>(from));
+            new (to) Fn(std::move(*f));
+            f->~Fn();
+          },
+      .destroy =
+          [](void *storage) noexcept {
+            std::launder(reinterpret_cast<Fn *>(storage))->~Fn();
+          },
+      .is_inline = true,
+  };
+
+  template <typename Fn>
+  static constexpr Ops kHeapOps = {
+      .invoke =
+          [](void *storage, Args &&...args) -> R {
+        return std::invoke(**reinterpret_cast<Fn **>(storage),
+                           std::forward<Args>(args)...);
+      },
+      .relocate =
+          [](void *from, void *to) noexcept {
+            *reinterpret_cast<Fn **>(to) = *reinterpret_cast<Fn **>(from);
+          },
+      .destroy =
+          [](void *storage) noexcept {
+            delete *reinterpret_cast<Fn **>(storage);
+          },
+      .is_inline = false,
+  };
+
+  void MoveFrom(inline_function &other) noexcept {
+    if (other.ops_) {
+      other.ops_->relocate(other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  const Ops *ops_ = nullptr;
+  alignas(std::max_align_t) unsigned char storage_[InlineSize];
+};
+
+}  // namespace shortfin
+
+#endif  // SHORTFIN_SUPPORT_INLINE_FUNCTION_H
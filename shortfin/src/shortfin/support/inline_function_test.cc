@@ -0,0 +1,78 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/support/inline_function.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+namespace shortfin {
+
+TEST(InlineFunctionTest, inline_and_heap) {
+  int calls = 0;
+  inline_function<void()> small([&calls]() { calls += 1; });
+  EXPECT_TRUE(small.is_inline());
+  small();
+  EXPECT_EQ(calls, 1);
+
+  std::array<int, 32> big{};
+  big[31] = 5;
+  inline_function<int(int)> large([big](int x) { return big[31] + x; });
+  EXPECT_FALSE(large.is_inline());
+  EXPECT_EQ(large(2), 7);
+
+  // std::function fits in place.
+  inline_function<void()> wrapped(std::function<void()>([&calls]() {
+    calls += 1;
+  }));
+  EXPECT_TRUE(wrapped.is_inline());
+  wrapped();
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(InlineFunctionTest, move_only_capture) {
+  auto value = std::make_unique<int>(3);
+  inline_function<int()> f([value = std::move(value)]() { return *value; });
+  inline_function<int()> moved(std::move(f));
+  EXPECT_FALSE(f);
+  ASSERT_TRUE(moved);
+  EXPECT_EQ(moved(), 3);
+
+  inline_function<int()> assigned;
+  assigned = std::move(moved);
+  EXPECT_FALSE(moved);
+  EXPECT_EQ(assigned(), 3);
+}
+
+TEST(InlineFunctionTest, destroys_target) {
+  auto tracked = std::make_shared<int>(0);
+  {
+    inline_function<void()> small([tracked]() {});
+    std::array<std::shared_ptr<int>, 8> many;
+    many.fill(tracked);
+    inline_function<void()> large([many = std::move(many)]() {});
+    EXPECT_FALSE(large.is_inline());
+    EXPECT_EQ(tracked.use_count(), 10);
+    small.reset();
+    EXPECT_EQ(tracked.use_count(), 9);
+  }
+  EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(InlineFunctionTest, empty) {
+  inline_function<void()> f;
+  EXPECT_FALSE(f);
+  EXPECT_THROW(f(), std::bad_function_call);
+  inline_function<void()> from_empty{std::function<void()>()};
+  EXPECT_FALSE(from_empty);
+  void (*null_fn)() = nullptr;
+  EXPECT_FALSE(inline_function<void()>(null_fn));
+}
+
+}  // namespace shortfin
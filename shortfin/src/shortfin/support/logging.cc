@@ -6,13 +6,57 @@
 
 #include "shortfin/support/logging.h"
 
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include "shortfin/support/async_log_sink.h"
 #include "spdlog/cfg/env.h"
 
 namespace shortfin::logging {
 
+namespace {
+
+std::mutex async_mutex;
+bool async_enabled = false;
+
+// Returns the value of `name`, or nullptr if unset or empty.
+const char *GetEnv(const char *name) {
+  const char *value = std::getenv(name);
+  return value && std::strlen(value) > 0 ? value : nullptr;
+}
+
+}  // namespace
+
 void InitializeFromEnv() {
-  // TODO: Also support our own env vars.
   spdlog::cfg::load_env_levels();
+  const char *async = GetEnv("SHORTFIN_LOG_ASYNC");
+  if (async && std::strcmp(async, "0") != 0) {
+    size_t capacity = 8192;
+    if (const char *value = GetEnv("SHORTFIN_LOG_ASYNC_CAPACITY")) {
+      capacity = std::strtoull(value, nullptr, 10);
+      if (capacity == 0) {
+        warn("Ignoring invalid SHORTFIN_LOG_ASYNC_CAPACITY={}", value);
+        capacity = 8192;
+      }
+    }
+    EnableAsync(capacity);
+  }
+}
+
+void EnableAsync(size_t capacity) {
+  std::lock_guard<std::mutex> lock(async_mutex);
+  if (async_enabled) return;
+  auto existing = spdlog::default_logger();
+  auto sink = std::make_shared<AsyncLogSink>(existing->sinks(), capacity);
+  auto logger = std::make_shared<spdlog::logger>(existing->name(), sink);
+  logger->set_level(existing->level());
+  logger->flush_on(existing->flush_level());
+  spdlog::set_default_logger(std::move(logger));
+  async_enabled = true;
 }
 
+void Flush() { spdlog::default_logger_raw()->flush(); }
+
 }  // namespace shortfin::logging
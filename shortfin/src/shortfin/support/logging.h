@@ -15,8 +15,27 @@
 #define SHORTFIN_LOG_LIFETIMES 0
 #endif
 
-// Scheduler logging.
+// Minimum level of the SHORTFIN_LOG_* macros that is compiled in, as an
+// SPDLOG_LEVEL_* value. Calls below it are elided along with the evaluation of
+// their arguments. Trace logging is compiled out unless enabled at build time.
+#if !defined(SHORTFIN_LOG_ACTIVE_LEVEL)
+#define SHORTFIN_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_DEBUG
+#endif
+#if SHORTFIN_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define SHORTFIN_LOG_TRACE(...) shortfin::logging::trace(__VA_ARGS__)
+#else
+#define SHORTFIN_LOG_TRACE(...) (void)0
+#endif
+#if SHORTFIN_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define SHORTFIN_LOG_DEBUG(...) shortfin::logging::debug(__VA_ARGS__)
+#else
+#define SHORTFIN_LOG_DEBUG(...) (void)0
+#endif
+
+// Scheduler logging. Compiled out unless enabled at build time.
+#if !defined(SHORTFIN_SCHED_LOG_ENABLED)
 #define SHORTFIN_SCHED_LOG_ENABLED 0
+#endif
 #if SHORTFIN_SCHED_LOG_ENABLED
 #define SHORTFIN_SCHED_LOG(...) shortfin::logging::info("SCHED: " __VA_ARGS__)
 #else
@@ -30,16 +49,42 @@
 #define SHORTFIN_TRACE_SCOPE_NAMED(name_literal) \
   IREE_TRACE_SCOPE_NAMED(name_literal)
 #define SHORTFIN_TRACE_SCOPE_ID IREE_TRACE_SCOPE_ID
+#define SHORTFIN_TRACE_PLOT_VALUE_I64(name_literal, value) \
+  IREE_TRACE_PLOT_VALUE_I64(name_literal, value)
+
+// Memory events of named pools. The name must outlive the trace (i.e. be a
+// literal or interned).
+#if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_ALLOCATION_TRACKING
+#define SHORTFIN_TRACE_ALLOCATIONS 1
+#else
+#define SHORTFIN_TRACE_ALLOCATIONS 0
+#endif
+#define SHORTFIN_TRACE_ALLOC_NAMED(name, ptr, size) \
+  IREE_TRACE_ALLOC_NAMED(name, ptr, size)
+#define SHORTFIN_TRACE_FREE_NAMED(name, ptr) IREE_TRACE_FREE_NAMED(name, ptr)
 
 namespace shortfin::logging {
 
+// Loads the log levels from SPDLOG_LEVEL and, if SHORTFIN_LOG_ASYNC is set
+// to a non-zero value, enables async logging with a ring capacity of
+// SHORTFIN_LOG_ASYNC_CAPACITY messages (default 8192).
 SHORTFIN_API void InitializeFromEnv();
 
+// Routes the default logger through an AsyncLogSink wrapping its sinks, so
+// that logging threads only push to a ring and a background thread does the
+// I/O. Messages logged while the ring is full are dropped. No-op if already
+// enabled.
+SHORTFIN_API void EnableAsync(size_t capacity = 8192);
+
+// Writes out all messages logged so far, whether or not logging is async.
+SHORTFIN_API void Flush();
+
 // TODO: Re-export doesn't really work like this. Need to define API
 // exported trampolines for cross library use.
 using spdlog::debug;
 using spdlog::error;
 using spdlog::info;
+using spdlog::trace;
 using spdlog::warn;
 
 #if SHORTFIN_LOG_LIFETIMES
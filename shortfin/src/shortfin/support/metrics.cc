@@ -0,0 +1,240 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/support/metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+#include "fmt/core.h"
+
+namespace shortfin {
+
+namespace {
+
+bool IsValidMetricName(std::string_view name) {
+  if (name.empty()) return false;
+  for (size_t i = 0; i < name.size(); ++i) {
+    char c = name[i];
+    bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                 c == '_' || c == ':' || (i > 0 && c >= '0' && c <= '9');
+    if (!valid) return false;
+  }
+  return true;
+}
+
+void AppendEscapedHelp(std::string &out, std::string_view help) {
+  for (char c : help) {
+    if (c == '\\') {
+      out += "\\\\";
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out += c;
+    }
+  }
+}
+
+// `name{labels}`, with `extra` appended to the labels.
+std::string Series(std::string_view name, std::string_view labels,
+                   std::string_view extra = {}) {
+  if (labels.empty() && extra.empty()) return std::string(name);
+  std::string sep = !labels.empty() && !extra.empty() ? "," : "";
+  return fmt::format("{}{{{}{}{}}}", name, labels, sep, extra);
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------- //
+// MetricHistogram
+// -------------------------------------------------------------------------- //
+
+MetricHistogram::MetricHistogram(double unit)
+    : unit_(unit), buckets_(new std::atomic<uint64_t>[kBucketCount]) {
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t MetricHistogram::BucketIndex(uint64_t value) {
+  if (value < kSubBuckets) return value;
+  int exponent = 63 - std::countl_zero(value);
+  int shift = exponent - kSubBucketBits;
+  size_t group = shift + 1;
+  return group * kSubBuckets + ((value >> shift) - kSubBuckets);
+}
+
+uint64_t MetricHistogram::BucketUpperBound(size_t index) {
+  size_t group = index / kSubBuckets;
+  uint64_t sub_bucket = index % kSubBuckets;
+  if (group == 0) return sub_bucket;
+  int shift = group - 1;
+  // Ordered so as not to overflow the last bucket.
+  return ((kSubBuckets + sub_bucket) << shift) + ((uint64_t{1} << shift) - 1);
+}
+
+MetricHistogram::Snapshot MetricHistogram::snapshot() const {
+  Snapshot snapshot;
+  snapshot.buckets.resize(kBucketCount);
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    snapshot.count += snapshot.buckets[i];
+  }
+  snapshot.sum = sum_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+uint64_t MetricHistogram::Snapshot::Quantile(double q) const {
+  if (count == 0) return 0;
+  uint64_t rank = std::clamp<uint64_t>(
+      static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count)), 1,
+      count);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank) return BucketUpperBound(i);
+  }
+  return BucketUpperBound(buckets.size() - 1);
+}
+
+// -------------------------------------------------------------------------- //
+// MetricsRegistry
+// -------------------------------------------------------------------------- //
+
+MetricsRegistry &MetricsRegistry::global() {
+  static MetricsRegistry *registry = new MetricsRegistry();
+  return *registry;
+}
+
+MetricsRegistry::Family &MetricsRegistry::GetFamily(std::string_view name,
+                                                    std::string_view help,
+                                                    Type type, double unit) {
+  if (!IsValidMetricName(name)) {
+    throw std::invalid_argument(
+        fmt::format("Invalid metric name '{}'", name));
+  }
+  auto it = families_.find(name);
+  if (it == families_.end()) {
+    it = families_
+             .emplace(std::string(name),
+                      Family{.type = type, .help = std::string(help),
+                             .unit = unit})
+             .first;
+  } else if (it->second.type != type || it->second.unit != unit) {
+    throw std::invalid_argument(fmt::format(
+        "Metric '{}' is already registered with another type or unit", name));
+  }
+  return it->second;
+}
+
+MetricCounter &MetricsRegistry::counter(std::string_view name,
+                                        std::string_view help,
+                                        std::string_view labels) {
+  iree::slim_mutex_lock_guard lock(mu_);
+  auto &metrics = GetFamily(name, help, Type::COUNTER, 1.0).counters;
+  auto it = metrics.find(labels);
+  if (it == metrics.end()) {
+    it = metrics
+             .emplace(std::string(labels), std::make_unique<MetricCounter>())
+             .first;
+  }
+  return *it->second;
+}
+
+MetricGauge &MetricsRegistry::gauge(std::string_view name,
+                                    std::string_view help,
+                                    std::string_view labels) {
+  iree::slim_mutex_lock_guard lock(mu_);
+  auto &metrics = GetFamily(name, help, Type::GAUGE, 1.0).gauges;
+  auto it = metrics.find(labels);
+  if (it == metrics.end()) {
+    it = metrics.emplace(std::string(labels), std::make_unique<MetricGauge>())
+             .first;
+  }
+  return *it->second;
+}
+
+MetricHistogram &MetricsRegistry::histogram(std::string_view name,
+                                            std::string_view help,
+                                            std::string_view labels,
+                                            double unit) {
+  iree::slim_mutex_lock_guard lock(mu_);
+  auto &metrics = GetFamily(name, help, Type::HISTOGRAM, unit).histograms;
+  auto it = metrics.find(labels);
+  if (it == metrics.end()) {
+    it = metrics
+             .emplace(std::string(labels),
+                      std::make_unique<MetricHistogram>(unit))
+             .first;
+  }
+  return *it->second;
+}
+
+std::string MetricsRegistry::ExportPrometheus() {
+  iree::slim_mutex_lock_guard lock(mu_);
+  std::string out;
+  for (auto &[name, family] : families_) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    AppendEscapedHelp(out, family.help);
+    switch (family.type) {
+      case Type::COUNTER:
+        out += fmt::format("\n# TYPE {} counter\n", name);
+        for (auto &[labels, counter] : family.counters) {
+          out += fmt::format("{} {}\n", Series(name, labels), counter->value());
+        }
+        break;
+      case Type::GAUGE:
+        out += fmt::format("\n# TYPE {} gauge\n", name);
+        for (auto &[labels, gauge] : family.gauges) {
+          out += fmt::format("{} {}\n", Series(name, labels), gauge->value());
+        }
+        break;
+      case Type::HISTOGRAM:
+        out += fmt::format("\n# TYPE {} histogram\n", name);
+        for (auto &[labels, histogram] : family.histograms) {
+          auto snapshot = histogram->snapshot();
+          auto last = std::find_if(snapshot.buckets.rbegin(),
+                                   snapshot.buckets.rend(),
+                                   [](uint64_t n) { return n != 0; });
+          size_t groups = 0;
+          if (last != snapshot.buckets.rend()) {
+            size_t index = snapshot.buckets.rend() - last - 1;
+            groups = index / MetricHistogram::kSubBuckets + 1;
+          }
+          std::string bucket_name = name + "_bucket";
+          uint64_t cumulative = 0;
+          for (size_t group = 0; group < groups; ++group) {
+            size_t begin = group * MetricHistogram::kSubBuckets;
+            size_t end = begin + MetricHistogram::kSubBuckets;
+            for (size_t i = begin; i < end; ++i) {
+              cumulative += snapshot.buckets[i];
+            }
+            double le = MetricHistogram::BucketUpperBound(end - 1) *
+                        family.unit;
+            out += fmt::format(
+                "{} {}\n",
+                Series(bucket_name, labels, fmt::format("le=\"{}\"", le)),
+                cumulative);
+          }
+          out += fmt::format("{} {}\n",
+                             Series(bucket_name, labels, "le=\"+Inf\""),
+                             snapshot.count);
+          out += fmt::format("{} {}\n", Series(name + "_sum", labels),
+                             snapshot.sum * family.unit);
+          out += fmt::format("{} {}\n", Series(name + "_count", labels),
+                             snapshot.count);
+        }
+        break;
+    }
+  }
+  return out;
+}
+
+}  // namespace shortfin
@@ -0,0 +1,146 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_SUPPORT_METRICS_H
+#define SHORTFIN_SUPPORT_METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "shortfin/support/api.h"
+#include "shortfin/support/iree_concurrency.h"
+
+namespace shortfin {
+
+// Monotonic count of events. Lock-free.
+class SHORTFIN_API MetricCounter {
+ public:
+  void Increment(uint64_t n = 1) {
+    value_.fetch_add(n, std::memory_order_relaxed);
+  }
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+// Value that goes up and down (i.e. the number of active requests).
+// Lock-free.
+class SHORTFIN_API MetricGauge {
+ public:
+  void Set(int64_t value) { value_.store(value, std::memory_order_relaxed); }
+  void Add(int64_t n) { value_.fetch_add(n, std::memory_order_relaxed); }
+  int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+// Distribution of integer values (i.e. latencies in microseconds), recorded
+// lock-free into HDR-style log-linear buckets: each power of two range
+// [2^e, 2^(e+1)) is split into kSubBuckets linear buckets, so that a bucket
+// bounds its values within 1 / kSubBuckets of their magnitude, over the whole
+// 64-bit range. Values below kSubBuckets are exact.
+//
+// `unit` scales recorded values to the exported (i.e. Prometheus) unit: a
+// histogram of microseconds exported in seconds has a unit of 1e-6.
+class SHORTFIN_API MetricHistogram {
+ public:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  static constexpr size_t kBucketCount =
+      (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  // Counters read at one point (not atomically across buckets, as recording
+  // continues).
+  struct Snapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    std::vector<uint64_t> buckets;
+
+    // Upper bound of the bucket holding the value at quantile `q` in [0, 1],
+    // or 0 if empty.
+    uint64_t Quantile(double q) const;
+  };
+
+  explicit MetricHistogram(double unit = 1.0);
+  MetricHistogram(const MetricHistogram &) = delete;
+
+  double unit() const { return unit_; }
+
+  void Record(uint64_t value) {
+    buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+  }
+  Snapshot snapshot() const;
+
+  static size_t BucketIndex(uint64_t value);
+  // Largest value of bucket `index`.
+  static uint64_t BucketUpperBound(size_t index);
+
+ private:
+  double unit_;
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<uint64_t> sum_{0};
+};
+
+// Named metrics, exported in the Prometheus text format. Metrics of a family
+// (a name, with its help and type) are distinguished by their labels, given
+// formatted (i.e. `lane="prefill"`). The metrics are created on first use and
+// live as long as the registry, so that recording sites can keep references
+// to them; only their creation takes a lock.
+class SHORTFIN_API MetricsRegistry {
+ public:
+  MetricsRegistry() = default;
+  MetricsRegistry(const MetricsRegistry &) = delete;
+
+  // The registry of the process.
+  static MetricsRegistry &global();
+
+  // Returns the metric of `name` and `labels`, creating it if needed. Throws
+  // std::invalid_argument if `name` is not a valid metric name or is already
+  // a family of another type (or for a histogram, another unit).
+  MetricCounter &counter(std::string_view name, std::string_view help,
+                         std::string_view labels = {});
+  MetricGauge &gauge(std::string_view name, std::string_view help,
+                     std::string_view labels = {});
+  MetricHistogram &histogram(std::string_view name, std::string_view help,
+                             std::string_view labels = {}, double unit = 1.0);
+
+  // Exports all metrics in the Prometheus text exposition format. Histograms
+  // export cumulative buckets at each power of two of their values, up to
+  // the highest one holding values.
+  std::string ExportPrometheus();
+
+ private:
+  enum class Type { COUNTER, GAUGE, HISTOGRAM };
+  struct Family {
+    Type type;
+    std::string help;
+    double unit = 1.0;
+    std::map<std::string, std::unique_ptr<MetricCounter>, std::less<>>
+        counters;
+    std::map<std::string, std::unique_ptr<MetricGauge>, std::less<>> gauges;
+    std::map<std::string, std::unique_ptr<MetricHistogram>, std::less<>>
+        histograms;
+  };
+
+  Family &GetFamily(std::string_view name, std::string_view help, Type type,
+                    double unit) SHORTFIN_REQUIRES_LOCK(mu_);
+
+  iree::slim_mutex mu_;
+  std::map<std::string, Family, std::less<>> families_ SHORTFIN_GUARDED_BY(mu_);
+};
+
+}  // namespace shortfin
+
+#endif  // SHORTFIN_SUPPORT_METRICS_H
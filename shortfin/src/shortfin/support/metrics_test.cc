@@ -0,0 +1,97 @@
+// Copyright 2025 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/support/metrics.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace shortfin;
+using ::testing::HasSubstr;
+
+TEST(MetricsTest, HistogramBuckets) {
+  for (uint64_t value : {0ull, 1ull, 31ull, 32ull, 33ull, 1000ull, 123456789ull,
+                         ~0ull >> 1, ~0ull}) {
+    size_t index = MetricHistogram::BucketIndex(value);
+    ASSERT_LT(index, MetricHistogram::kBucketCount);
+    EXPECT_LE(value, MetricHistogram::BucketUpperBound(index)) << value;
+    if (index > 0) {
+      EXPECT_GT(value, MetricHistogram::BucketUpperBound(index - 1)) << value;
+    }
+  }
+  size_t last = MetricHistogram::kBucketCount - 1;
+  EXPECT_EQ(MetricHistogram::BucketUpperBound(last), ~0ull);
+  // Bucket widths stay within 1 / kSubBuckets of their values.
+  size_t index = MetricHistogram::BucketIndex(1000000);
+  uint64_t width = MetricHistogram::BucketUpperBound(index) -
+                   MetricHistogram::BucketUpperBound(index - 1);
+  EXPECT_LE(width * MetricHistogram::kSubBuckets, 1000000);
+}
+
+TEST(MetricsTest, HistogramQuantiles) {
+  MetricHistogram histogram;
+  for (uint64_t i = 1; i <= 1000; ++i) histogram.Record(i);
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 1000);
+  EXPECT_EQ(snapshot.sum, 500500);
+  uint64_t p50 = snapshot.Quantile(0.5);
+  EXPECT_GE(p50, 500);
+  EXPECT_LE(p50, 500 + 500 / MetricHistogram::kSubBuckets);
+  EXPECT_GE(snapshot.Quantile(1.0), 1000);
+  EXPECT_EQ(MetricHistogram().snapshot().Quantile(0.5), 0);
+}
+
+TEST(MetricsTest, ConcurrentRecording) {
+  MetricsRegistry registry;
+  auto &counter = registry.counter("events_total", "Events");
+  auto &histogram = registry.histogram("latency", "Latency");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 10000; ++i) {
+        counter.Increment();
+        histogram.Record(i);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_EQ(counter.value(), 40000);
+  EXPECT_EQ(histogram.snapshot().count, 40000);
+}
+
+TEST(MetricsTest, ExportPrometheus) {
+  MetricsRegistry registry;
+  registry.counter("requests_total", "Requests.\nAll of them").Increment(3);
+  EXPECT_EQ(&registry.counter("requests_total", ""),
+            &registry.counter("requests_total", ""));
+  registry.gauge("active", "Active requests", "lane=\"decode\"").Set(-2);
+  auto &histogram =
+      registry.histogram("queue_seconds", "Queueing", "lane=\"prefill\"", 0.25);
+  histogram.Record(10);
+  histogram.Record(40);
+
+  std::string text = registry.ExportPrometheus();
+  EXPECT_THAT(text, HasSubstr("# HELP requests_total Requests.\\nAll of them\n"
+                              "# TYPE requests_total counter\n"
+                              "requests_total 3\n"));
+  EXPECT_THAT(text, HasSubstr("active{lane=\"decode\"} -2\n"));
+  EXPECT_THAT(text, HasSubstr("# TYPE queue_seconds histogram\n"));
+  EXPECT_THAT(text,
+              HasSubstr("queue_seconds_bucket{lane=\"prefill\",le=\"7.75\"} "
+                        "1\n"));
+  EXPECT_THAT(text,
+              HasSubstr("queue_seconds_bucket{lane=\"prefill\",le=\"15.75\"} "
+                        "2\n"));
+  EXPECT_THAT(text, HasSubstr("queue_seconds_bucket{lane=\"prefill\","
+                              "le=\"+Inf\"} 2\n"));
+  EXPECT_THAT(text, HasSubstr("queue_seconds_sum{lane=\"prefill\"} 12.5\n"));
+  EXPECT_THAT(text, HasSubstr("queue_seconds_count{lane=\"prefill\"} 2\n"));
+
+  EXPECT_THROW(registry.gauge("requests_total", ""), std::invalid_argument);
+  EXPECT_THROW(registry.counter("0bad", ""), std::invalid_argument);
+}
@@ -0,0 +1,117 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef SHORTFIN_SUPPORT_MPSC_RING_H
+#define SHORTFIN_SUPPORT_MPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+namespace shortfin {
+
+// Bounded, lock-free ring of values for many producers and a single consumer.
+// Each slot carries a sequence number which tells a producer whether the slot
+// is free for its ticket and the consumer whether the slot has been published
+// (see D. Vyukov's bounded MPMC queue, specialized here for one consumer).
+//
+// Producers may call TryPush concurrently from any thread. TryPop and
+// approx_size must only be called by one consumer at a time; callers that
+// move the consumer role between threads must order those calls (i.e. with a
+// lock or a handoff).
+template <typename T>
+class mpsc_ring {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "mpsc_ring values must be nothrow movable");
+
+ public:
+  // The capacity is rounded up to a power of two.
+  explicit mpsc_ring(size_t capacity)
+      : mask_(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        slots_(new Slot[mask_ + 1]) {
+    for (size_t i = 0; i <= mask_; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  mpsc_ring(const mpsc_ring &) = delete;
+  mpsc_ring &operator=(const mpsc_ring &) = delete;
+  ~mpsc_ring() {
+    while (TryPop()) {
+    }
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+  // Moves `value` into the ring and returns true, or returns false leaving
+  // `value` untouched if the ring is full.
+  bool TryPush(T &value) noexcept {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = slots_[pos & mask_];
+      size_t seq = slot.seq.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          new (slot.storage) T(std::move(value));
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // The consumer has not yet released the slot from the previous lap.
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Pops the oldest published value. A producer that has claimed the head
+  // slot but not yet published it makes the ring appear empty until it does.
+  std::optional<T> TryPop() noexcept {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot &slot = slots_[pos & mask_];
+    if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+      return std::nullopt;
+    }
+    T *stored = std::launder(reinterpret_cast<T *>(slot.storage));
+    std::optional<T> value(std::move(*stored));
+    stored->~T();
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    slot.seq.store(pos + mask_ + 1, std::memory_order_release);
+    return value;
+  }
+
+  // Number of claimed slots as seen by the consumer. Includes values that
+  // are still being published.
+  size_t approx_size() const {
+    return enqueue_pos_.load(std::memory_order_relaxed) -
+           dequeue_pos_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  // Producers and the consumer are kept on separate cache lines so that the
+  // consumer does not bounce the line producers are contending on.
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+}  // namespace shortfin
+
+#endif  // SHORTFIN_SUPPORT_MPSC_RING_H
@@ -0,0 +1,87 @@
+// Copyright 2024 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "shortfin/support/mpsc_ring.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace shortfin {
+
+TEST(MpscRingTest, fifo_and_full) {
+  mpsc_ring<int> ring(3);
+  EXPECT_EQ(ring.capacity(), 4u);
+  for (int i = 0; i < 4; ++i) {
+    int v = i;
+    EXPECT_TRUE(ring.TryPush(v));
+  }
+  int extra = 99;
+  EXPECT_FALSE(ring.TryPush(extra));
+  EXPECT_EQ(extra, 99);
+  EXPECT_EQ(ring.approx_size(), 4u);
+  for (int lap = 0; lap < 3; ++lap) {
+    for (int i = 0; i < 4; ++i) {
+      auto v = ring.TryPop();
+      ASSERT_TRUE(v);
+      EXPECT_EQ(*v, lap * 4 + i);
+      int next = (lap + 1) * 4 + i;
+      EXPECT_TRUE(ring.TryPush(next));
+    }
+  }
+}
+
+TEST(MpscRingTest, destroys_remaining_values) {
+  auto tracked = std::make_shared<int>(0);
+  {
+    mpsc_ring<std::shared_ptr<int>> ring(8);
+    for (int i = 0; i < 5; ++i) {
+      auto copy = tracked;
+      ASSERT_TRUE(ring.TryPush(copy));
+      EXPECT_FALSE(copy);
+    }
+    EXPECT_EQ(tracked.use_count(), 6);
+    ring.TryPop();
+    EXPECT_EQ(tracked.use_count(), 5);
+  }
+  EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(MpscRingTest, concurrent_producers) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 20000;
+  mpsc_ring<int> ring(64);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&ring, p]() {
+      for (int i = 0; i < kPerProducer; ++i) {
+        int v = p * kPerProducer + i;
+        while (!ring.TryPush(v)) std::this_thread::yield();
+      }
+    });
+  }
+
+  // Each producer's values must arrive in the order it pushed them.
+  std::vector<int> next(kProducers, 0);
+  for (int received = 0; received < kProducers * kPerProducer;) {
+    auto v = ring.TryPop();
+    if (!v) {
+      std::this_thread::yield();
+      continue;
+    }
+    int p = *v / kPerProducer;
+    ASSERT_EQ(*v % kPerProducer, next[p]);
+    next[p] += 1;
+    received += 1;
+  }
+  for (auto &t : producers) t.join();
+  EXPECT_FALSE(ring.TryPop());
+}
+
+}  // namespace shortfin
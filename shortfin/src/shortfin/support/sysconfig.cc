@@ -6,10 +6,25 @@
 
 #include "shortfin/support/sysconfig.h"
 
+#include <fmt/core.h>
+
 #include "shortfin/support/logging.h"
 
 #ifdef __linux__
+#include <fcntl.h>
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#include <string>
 #endif
 
 namespace shortfin::sysconfig {
@@ -60,4 +75,450 @@ bool EnsureFileLimit(unsigned needed_limit) {
 bool EnsureFileLimit(unsigned needed_limit) { return true; }
 #endif
 
+// -----------------------------------------------------------------------------
+// Startup tuning
+// -----------------------------------------------------------------------------
+
+namespace {
+std::string FormatLimit(uint64_t value, bool bytes) {
+  if (value == ProcessSettings::kUnlimited) return "unlimited";
+  if (!bytes) return std::to_string(value);
+  return fmt::format("{:.1f}MiB", value / (1024.0 * 1024.0));
+}
+}  // namespace
+
+#ifdef __linux__
+
+namespace {
+// Reads a soft and hard limit, raising the soft limit to the hard limit if
+// `raise`. Leaves them 0 if they cannot be read.
+void ReadLimit(int resource, const char *name, bool raise, uint64_t &current,
+               uint64_t &max) {
+  struct rlimit limit;
+  if (getrlimit(resource, &limit) != 0) return;
+  if (raise && limit.rlim_cur != limit.rlim_max) {
+    struct rlimit raised = limit;
+    raised.rlim_cur = limit.rlim_max;
+    if (setrlimit(resource, &raised) == 0) {
+      logging::debug("Raised {} limit to its hard limit", name);
+      limit = raised;
+    } else {
+      logging::warn("Could not raise {} limit to its hard limit", name);
+    }
+  }
+  auto to_u64 = [](rlim_t value) {
+    return value == RLIM_INFINITY ? ProcessSettings::kUnlimited
+                                  : static_cast<uint64_t>(value);
+  };
+  current = to_u64(limit.rlim_cur);
+  max = to_u64(limit.rlim_max);
+}
+
+// Reads the selected mode of a sysfs setting listing them as "a [b] c".
+std::string ReadSelectedMode(const char *path) {
+  std::ifstream in(path);
+  std::string line;
+  if (!std::getline(in, line)) return {};
+  size_t begin = line.find('[');
+  size_t end = line.find(']', begin);
+  if (begin == std::string::npos || end == std::string::npos) return {};
+  return line.substr(begin + 1, end - begin - 1);
+}
+}  // namespace
+
+ProcessSettings TuneProcessSettings(const TuneOptions &options) {
+  ProcessSettings settings;
+  ReadLimit(RLIMIT_NOFILE, "open file", /*raise=*/false, settings.file_limit,
+            settings.file_limit_max);
+  ReadLimit(RLIMIT_NPROC, "thread", options.raise_limits,
+            settings.thread_limit, settings.thread_limit_max);
+  ReadLimit(RLIMIT_MEMLOCK, "locked memory", options.raise_limits,
+            settings.memlock_limit, settings.memlock_limit_max);
+  settings.thp_enabled =
+      ReadSelectedMode("/sys/kernel/mm/transparent_hugepage/enabled");
+  settings.thp_defrag =
+      ReadSelectedMode("/sys/kernel/mm/transparent_hugepage/defrag");
+
+  auto &recommendations = settings.recommendations;
+  if (settings.memlock_limit &&
+      settings.memlock_limit < options.min_memlock_bytes) {
+    recommendations.push_back(fmt::format(
+        "Locked memory limit ({}) is below {}: pinned host staging buffers "
+        "may fail to allocate, which reduces host to device bandwidth. Raise "
+        "it with `ulimit -l unlimited` (or memlock in "
+        "/etc/security/limits.conf){}",
+        FormatLimit(settings.memlock_limit, /*bytes=*/true),
+        FormatLimit(options.min_memlock_bytes, /*bytes=*/true),
+        settings.memlock_limit_max > settings.memlock_limit
+            ? " or set sysconfig_raise_limits"
+            : ""));
+  }
+  if (settings.thread_limit &&
+      settings.thread_limit < options.min_thread_limit) {
+    recommendations.push_back(fmt::format(
+        "Thread limit ({}) is below {}: creating workers and executor threads "
+        "for many devices may fail. Raise it with `ulimit -u`",
+        settings.thread_limit, options.min_thread_limit));
+  }
+  if (settings.thp_enabled == "never") {
+    recommendations.push_back(
+        "Transparent huge pages are disabled: large host buffers are mapped "
+        "with small pages. Set /sys/kernel/mm/transparent_hugepage/enabled "
+        "to madvise or always");
+  }
+  if (settings.thp_defrag == "always") {
+    recommendations.push_back(
+        "Transparent huge page defrag is 'always': host allocations may stall "
+        "on memory compaction. Set /sys/kernel/mm/transparent_hugepage/defrag "
+        "to defer+madvise or madvise");
+  }
+
+  logging::info(
+      "Process settings: open files {}/{}, threads {}/{}, locked memory "
+      "{}/{}, transparent huge pages {} (defrag {})",
+      FormatLimit(settings.file_limit, /*bytes=*/false),
+      FormatLimit(settings.file_limit_max, /*bytes=*/false),
+      FormatLimit(settings.thread_limit, /*bytes=*/false),
+      FormatLimit(settings.thread_limit_max, /*bytes=*/false),
+      FormatLimit(settings.memlock_limit, /*bytes=*/true),
+      FormatLimit(settings.memlock_limit_max, /*bytes=*/true),
+      settings.thp_enabled.empty() ? "unknown" : settings.thp_enabled,
+      settings.thp_defrag.empty() ? "unknown" : settings.thp_defrag);
+  for (auto &recommendation : recommendations) {
+    logging::warn("{}", recommendation);
+  }
+  return settings;
+}
+
+#else
+// Fallback implementation.
+ProcessSettings TuneProcessSettings(const TuneOptions &options) { return {}; }
+#endif
+
+// -----------------------------------------------------------------------------
+// CPU and NUMA affinity
+// -----------------------------------------------------------------------------
+
+#ifdef __linux__
+
+std::vector<int> GetNumaNodeCpus(int node_id) {
+  std::vector<int> cpus;
+  if (node_id < 0) return cpus;
+  std::ifstream in(
+      fmt::format("/sys/devices/system/node/node{}/cpulist", node_id));
+  std::string cpulist;
+  if (!in || !std::getline(in, cpulist)) return cpus;
+
+  // The list is comma separated ranges, i.e. "0-3,8-11,16".
+  std::stringstream ranges(cpulist);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    if (range.empty()) continue;
+    int first = 0, last = 0;
+    size_t dash = range.find('-');
+    try {
+      first = std::stoi(range.substr(0, dash));
+      last = dash == std::string::npos ? first
+                                       : std::stoi(range.substr(dash + 1));
+    } catch (std::exception &) {
+      logging::warn("Could not parse cpulist '{}' of NUMA node {}", cpulist,
+                    node_id);
+      return {};
+    }
+    for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+bool SetCurrentThreadCpuAffinity(std::span<const int> cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      logging::warn("Ignoring out of range CPU {} in affinity", cpu);
+      continue;
+    }
+    CPU_SET(cpu, &set);
+  }
+  if (CPU_COUNT(&set) == 0) {
+    logging::warn("Not setting thread affinity: no usable CPUs");
+    return false;
+  }
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    logging::warn("Could not set thread CPU affinity (errno {})", errno);
+    return false;
+  }
+  return true;
+}
+
+bool SetCurrentThreadPreferredNumaNode(int node_id) {
+  constexpr int kMaxNodes = sizeof(unsigned long) * 8;
+  if (node_id < 0 || node_id >= kMaxNodes) {
+    logging::warn("Not setting memory policy: NUMA node {} out of range",
+                  node_id);
+    return false;
+  }
+  unsigned long node_mask = 1ul << node_id;
+  // The kernel reads one bit less than maxnode.
+  if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, &node_mask, kMaxNodes + 1) !=
+      0) {
+    logging::warn("Could not prefer NUMA node {} for allocations (errno {})",
+                  node_id, errno);
+    return false;
+  }
+  return true;
+}
+
+namespace {
+constexpr int kMaxPolicyNodes = sizeof(unsigned long) * 8;
+}  // namespace
+
+ScopedPreferredNumaNode::ScopedPreferredNumaNode(int node_id) {
+  if (node_id < 0 || node_id >= kMaxPolicyNodes) return;
+  if (syscall(SYS_get_mempolicy, &prior_mode_, &prior_node_mask_,
+              kMaxPolicyNodes + 1, nullptr, 0) != 0) {
+    logging::debug("Could not get the thread memory policy (errno {})", errno);
+    return;
+  }
+  unsigned long node_mask = 1ul << node_id;
+  if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, &node_mask,
+              kMaxPolicyNodes + 1) != 0) {
+    logging::debug("Could not prefer NUMA node {} for allocations (errno {})",
+                   node_id, errno);
+    return;
+  }
+  active_ = true;
+}
+
+ScopedPreferredNumaNode::~ScopedPreferredNumaNode() {
+  if (!active_) return;
+  if (syscall(SYS_set_mempolicy, prior_mode_, &prior_node_mask_,
+              kMaxPolicyNodes + 1) != 0) {
+    logging::warn("Could not restore the thread memory policy (errno {})",
+                  errno);
+  }
+}
+
+bool PreferNumaNodeForMemory(const void *data, size_t length, int node_id) {
+  if (node_id < 0 || node_id >= kMaxPolicyNodes) return false;
+  // mbind requires a page aligned range.
+  static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t start = (reinterpret_cast<uintptr_t>(data) + page_size - 1) &
+                    ~(page_size - 1);
+  uintptr_t end =
+      (reinterpret_cast<uintptr_t>(data) + length) & ~(page_size - 1);
+  if (end <= start) return true;
+  unsigned long node_mask = 1ul << node_id;
+  if (syscall(SYS_mbind, start, end - start, MPOL_PREFERRED, &node_mask,
+              kMaxPolicyNodes + 1, 0) != 0) {
+    logging::debug("mbind of {} bytes to NUMA node {} failed (errno {})",
+                   end - start, node_id, errno);
+    return false;
+  }
+  return true;
+}
+
+#else
+// Fallback implementation.
+std::vector<int> GetNumaNodeCpus(int node_id) { return {}; }
+
+bool SetCurrentThreadCpuAffinity(std::span<const int> cpus) {
+  logging::warn("Thread CPU affinity is not supported on this platform");
+  return false;
+}
+
+bool SetCurrentThreadPreferredNumaNode(int node_id) {
+  logging::warn("NUMA memory policy is not supported on this platform");
+  return false;
+}
+
+ScopedPreferredNumaNode::ScopedPreferredNumaNode(int node_id) {}
+ScopedPreferredNumaNode::~ScopedPreferredNumaNode() = default;
+
+bool PreferNumaNodeForMemory(const void *data, size_t length, int node_id) {
+  return false;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// Access hints
+// -----------------------------------------------------------------------------
+
+#ifdef __linux__
+
+bool AdviseMemory(const void *data, size_t length, AccessHint hint) {
+  if (length == 0) return true;
+  // madvise requires a page aligned start.
+  static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t start = reinterpret_cast<uintptr_t>(data) & ~(page_size - 1);
+  uintptr_t end = reinterpret_cast<uintptr_t>(data) + length;
+  int advice = MADV_WILLNEED;
+  if (hint == AccessHint::kRandom) {
+    advice = MADV_RANDOM;
+  } else if (hint == AccessHint::kHugePages) {
+    advice = MADV_HUGEPAGE;
+  }
+  if (madvise(reinterpret_cast<void *>(start), end - start, advice) != 0) {
+    logging::debug("madvise({}) of {} bytes failed (errno {})", advice,
+                   end - start, errno);
+    return false;
+  }
+  return true;
+}
+
+bool AdviseFile(int fd, uint64_t offset, uint64_t length, AccessHint hint) {
+  // Huge pages are a property of mappings, not files.
+  if (hint == AccessHint::kHugePages) return false;
+  int advice =
+      hint == AccessHint::kRandom ? POSIX_FADV_RANDOM : POSIX_FADV_WILLNEED;
+  int rc = posix_fadvise(fd, offset, length, advice);
+  if (rc != 0) {
+    logging::debug("posix_fadvise({}) of fd {} failed (errno {})", advice, fd,
+                   rc);
+    return false;
+  }
+  return true;
+}
+
+#else
+// Fallback implementation.
+bool AdviseMemory(const void *data, size_t length, AccessHint hint) {
+  return false;
+}
+
+bool AdviseFile(int fd, uint64_t offset, uint64_t length, AccessHint hint) {
+  return false;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// Huge pages
+// -----------------------------------------------------------------------------
+
+std::optional<HugePages> ParseHugePages(std::string_view value) {
+  if (value == "none") return HugePages::kNone;
+  if (value == "thp") return HugePages::kTransparent;
+  if (value == "2mb") return HugePages::k2MB;
+  if (value == "1gb") return HugePages::k1GB;
+  return std::nullopt;
+}
+
+std::string_view to_string_view(HugePages pages) {
+  switch (pages) {
+    case HugePages::kNone:
+      return "none";
+    case HugePages::kTransparent:
+      return "thp";
+    case HugePages::k2MB:
+      return "2mb";
+    case HugePages::k1GB:
+      return "1gb";
+  }
+  return "none";
+}
+
+size_t GetHugePageSize(HugePages pages) {
+  switch (pages) {
+    case HugePages::k2MB:
+      return size_t(2) << 20;
+    case HugePages::k1GB:
+      return size_t(1) << 30;
+    default:
+      return 0;
+  }
+}
+
+#ifdef __linux__
+
+namespace {
+size_t RoundToHugePages(size_t length, HugePages pages) {
+  size_t page_size = GetHugePageSize(pages);
+  return (length + page_size - 1) & ~(page_size - 1);
+}
+}  // namespace
+
+void *MapHugePageMemory(size_t length, HugePages pages) {
+  size_t page_size = GetHugePageSize(pages);
+  if (page_size == 0 || length == 0) return nullptr;
+  // The page size is encoded as log2 in the MAP_HUGE_SHIFT bits.
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+              (std::countr_zero(page_size) << MAP_HUGE_SHIFT);
+  void *data = mmap(nullptr, RoundToHugePages(length, pages),
+                    PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (data == MAP_FAILED) {
+    logging::debug("Could not map {} bytes of {} huge pages (errno {})",
+                   length, to_string_view(pages), errno);
+    return nullptr;
+  }
+  return data;
+}
+
+void UnmapHugePageMemory(void *data, size_t length, HugePages pages) {
+  if (data) munmap(data, RoundToHugePages(length, pages));
+}
+
+#else
+// Fallback implementation.
+void *MapHugePageMemory(size_t length, HugePages pages) { return nullptr; }
+void UnmapHugePageMemory(void *data, size_t length, HugePages pages) {}
+#endif
+
+// -----------------------------------------------------------------------------
+// Direct file reads
+// -----------------------------------------------------------------------------
+
+#ifdef __linux__
+
+int OpenFileForDirectRead(const char *path, bool &direct) {
+  direct = true;
+  int fd = open(path, O_RDONLY | O_DIRECT | O_CLOEXEC);
+  if (fd < 0 && errno == EINVAL) {
+    // The file system does not support direct I/O (i.e. tmpfs).
+    logging::debug("O_DIRECT not supported for {}: using buffered reads",
+                   path);
+    direct = false;
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+  }
+  return fd;
+}
+
+int64_t GetFileSize(int fd) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) return -1;
+  return st.st_size;
+}
+
+int64_t ReadFileAt(int fd, void *data, uint64_t length, uint64_t offset) {
+  uint64_t total = 0;
+  while (total < length) {
+    ssize_t n = pread(fd, static_cast<uint8_t *>(data) + total,
+                      length - total, offset + total);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    if (n == 0) break;  // End of file.
+    total += n;
+  }
+  return total;
+}
+
+void CloseFile(int fd) { close(fd); }
+
+#else
+// Fallback implementation.
+int OpenFileForDirectRead(const char *path, bool &direct) {
+  direct = false;
+  return -1;
+}
+
+int64_t GetFileSize(int fd) { return -1; }
+
+int64_t ReadFileAt(int fd, void *data, uint64_t length, uint64_t offset) {
+  return -1;
+}
+
+void CloseFile(int fd) {}
+#endif
+
 }  // namespace shortfin::sysconfig
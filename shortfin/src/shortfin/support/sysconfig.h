@@ -7,8 +7,14 @@
 #ifndef SHORTFIN_SUPPORT_SYSCONFIG_H
 #define SHORTFIN_SUPPORT_SYSCONFIG_H
 
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 namespace shortfin::sysconfig {
 
@@ -20,6 +26,149 @@ namespace shortfin::sysconfig {
 // This is a best effort attempt.
 bool EnsureFileLimit(unsigned needed_limit);
 
+// Process limits and kernel settings which affect performance, as found (and
+// possibly raised) at startup by TuneProcessSettings().
+struct ProcessSettings {
+  static constexpr uint64_t kUnlimited = UINT64_MAX;
+  // Soft and hard resource limits: open files (RLIMIT_NOFILE), threads
+  // (RLIMIT_NPROC) and locked memory in bytes (RLIMIT_MEMLOCK). kUnlimited if
+  // unlimited, 0 if unknown.
+  uint64_t file_limit = 0;
+  uint64_t file_limit_max = 0;
+  uint64_t thread_limit = 0;
+  uint64_t thread_limit_max = 0;
+  uint64_t memlock_limit = 0;
+  uint64_t memlock_limit_max = 0;
+  // Selected transparent huge page modes (i.e. "always", "madvise", "never")
+  // of the kernel. Empty if unknown.
+  std::string thp_enabled;
+  std::string thp_defrag;
+  // Settings which are likely to hurt performance and how to change them.
+  std::vector<std::string> recommendations;
+};
+
+struct TuneOptions {
+  // Raise the soft thread and locked memory limits to their hard limits
+  // (open file limits are raised on demand by EnsureFileLimit).
+  bool raise_limits = false;
+  // Locked memory below which pinned host allocations (i.e. staging buffers)
+  // are likely to fail or fall back to pageable memory.
+  uint64_t min_memlock_bytes = 1ull << 30;
+  // Thread limit below which creating workers and executors may fail.
+  uint64_t min_thread_limit = 4096;
+};
+
+// Reads the process limits and kernel settings relevant to serving, raises
+// limits as permitted by `options` and logs the settings, with a warning for
+// each recommendation. Best effort: anything that cannot be read is left
+// unknown.
+ProcessSettings TuneProcessSettings(const TuneOptions &options);
+
+// Gets the ids of the CPUs that belong to a NUMA node. Returns an empty list
+// if the node does not exist or the system does not report it.
+std::vector<int> GetNumaNodeCpus(int node_id);
+
+// Restricts the calling thread to the given CPUs. Returns false (after
+// logging a warning) if this is not supported or fails. Best effort.
+bool SetCurrentThreadCpuAffinity(std::span<const int> cpus);
+
+// Asks that memory subsequently allocated by the calling thread come from the
+// given NUMA node, falling back to other nodes when it is exhausted. Returns
+// false (after logging a warning) if this is not supported or fails. Best
+// effort.
+bool SetCurrentThreadPreferredNumaNode(int node_id);
+
+// Prefers the given NUMA node for memory allocated by the calling thread
+// while in scope, and restores the thread's previous memory policy when it
+// goes out of scope. Does nothing for a negative node or if not supported.
+// Best effort: failures are logged at debug level.
+class ScopedPreferredNumaNode {
+ public:
+  explicit ScopedPreferredNumaNode(int node_id);
+  ScopedPreferredNumaNode(const ScopedPreferredNumaNode &) = delete;
+  ScopedPreferredNumaNode &operator=(const ScopedPreferredNumaNode &) = delete;
+  ~ScopedPreferredNumaNode();
+
+  // Whether the preference was applied.
+  bool active() const { return active_; }
+
+ private:
+  bool active_ = false;
+  int prior_mode_ = 0;
+  unsigned long prior_node_mask_ = 0;
+};
+
+// Prefers the given NUMA node for the pages of a range of mapped memory
+// which have not been populated yet (pages already backed are not moved).
+// Only whole pages within the range are affected. Returns false if this is
+// not supported or fails. Best effort.
+bool PreferNumaNodeForMemory(const void *data, size_t length, int node_id);
+
+// Hints about how file backed data will be accessed.
+enum class AccessHint {
+  // Pages are accessed in no particular order: do not read ahead of them.
+  kRandom,
+  // The range will be accessed soon: start paging it in.
+  kWillNeed,
+  // Back the range with transparent huge pages where possible.
+  kHugePages,
+};
+
+// Hints the access pattern of a range of mapped memory. Returns false if this
+// is not supported or fails. Best effort.
+bool AdviseMemory(const void *data, size_t length, AccessHint hint);
+
+// How large host buffers are backed by pages.
+enum class HugePages {
+  // Regular pages.
+  kNone,
+  // Transparent huge pages, requested with AdviseMemory(kHugePages). Pages
+  // which are already populated (i.e. pinned by a driver) are unaffected.
+  kTransparent,
+  // Explicitly reserved (hugetlbfs) huge pages of the given size: see
+  // /sys/kernel/mm/hugepages.
+  k2MB,
+  k1GB,
+};
+
+// Parses "none", "thp", "2mb" or "1gb". Returns nullopt for other values.
+std::optional<HugePages> ParseHugePages(std::string_view value);
+std::string_view to_string_view(HugePages pages);
+
+// Size of an explicit huge page, or 0 for kNone and kTransparent.
+size_t GetHugePageSize(HugePages pages);
+
+// Maps `length` bytes (rounded up to the huge page size) of anonymous memory
+// backed by explicit huge pages, which are only populated when touched.
+// Returns null (after logging at debug level) if not supported or if there
+// are not enough free reserved pages. Free with UnmapHugePageMemory.
+void *MapHugePageMemory(size_t length, HugePages pages);
+void UnmapHugePageMemory(void *data, size_t length, HugePages pages);
+
+// Hints the access pattern of a range of an open file (a length of 0 extends
+// to the end of the file). Returns false if this is not supported or fails.
+// Best effort.
+bool AdviseFile(int fd, uint64_t offset, uint64_t length, AccessHint hint);
+
+// Alignment of the buffers, offsets and lengths of reads from a file opened
+// for direct reads (when the page cache is bypassed).
+constexpr size_t kDirectReadAlignment = 4096;
+
+// Opens a file for reading, bypassing the page cache (O_DIRECT) if the file
+// system supports it, which `direct` reports. Returns -1 on failure or if
+// not supported on this platform.
+int OpenFileForDirectRead(const char *path, bool &direct);
+
+// Size of an open file, or -1 on failure.
+int64_t GetFileSize(int fd);
+
+// Reads up to `length` bytes at `offset`, retrying short reads. Returns the
+// number of bytes read (less than `length` only at the end of the file) or
+// -1 on failure.
+int64_t ReadFileAt(int fd, void *data, uint64_t length, uint64_t offset);
+
+void CloseFile(int fd);
+
 }  // namespace shortfin::sysconfig
 
 #endif  // SHORTFIN_SUPPORT_SYSCONFIG_H
@@ -116,3 +116,187 @@ def test_create_amd_gpu_system_visible_unknown():
 def test_system_ctor():
     with sf.System("amdgpu") as ls:
         assert "amdgpu:0:0@0" in ls.device_names
+
+
+@pytest.mark.system("amdgpu")
+def test_amd_gpu_topology():
+    sc = sf.amdgpu.SystemBuilder(amdgpu_logical_devices_per_physical_device=2)
+    assert sc.peer_access == True
+    with sc.create_system() as ls:
+        devices = ls.devices
+        first = devices[0]
+        assert first.link_type(first) == sf.amdgpu.LinkType.SELF
+        assert first.link_weight(first) == 0
+        # The other logical device of the same physical device is closest.
+        peers = first.closest_peers(devices)
+        assert len(peers) == len(devices) - 1
+        assert peers[0].name == "amdgpu:0:0@1"
+        weights = [first.link_weight(peer) for peer in peers]
+        assert weights == sorted(weights)
+        assert first.node_affinity >= 0
+
+        selected = sf.amdgpu.select_closest_devices(devices, 2)
+        # Logical devices of one physical device are connected at no cost.
+        assert len(selected) == 2
+        assert selected[0].link_weight(selected[1]) == 0
+        with pytest.raises(ValueError, match="closest AMDGPU devices"):
+            sf.amdgpu.select_closest_devices(devices, len(devices) + 1)
+
+    sc = sf.amdgpu.SystemBuilder(amdgpu_peer_access=False)
+    assert sc.peer_access == False
+    with sc.create_system() as ls:
+        pass
+
+
+@pytest.mark.system("amdgpu")
+@pytest.mark.parametrize("peer_access", [True, False])
+def test_amd_gpu_cross_device_copy(peer_access):
+    import shortfin.array as sfnp
+
+    sc = sf.amdgpu.SystemBuilder(amdgpu_peer_access=peer_access)
+    if len(sc.available_devices) < 2:
+        pytest.skip("Requires two AMDGPU devices")
+    sc.visible_devices = sc.available_devices[0:2]
+    with sc.create_system() as ls:
+        d0, d1 = ls.devices[0:2]
+        if not peer_access:
+            assert not d1.can_access_peer(d0)
+
+        async def main():
+            fiber = ls.create_fiber(devices=[d0, d1])
+            src_device = fiber.device(0)
+            dst_device = fiber.device(1)
+            host = sfnp.device_array.for_host(src_device, [64], sfnp.uint32)
+            host.items = list(range(64))
+            src = sfnp.device_array.for_device(src_device, [64], sfnp.uint32)
+            src.copy_from(host)
+            dst = sfnp.device_array.for_device(dst_device, [64], sfnp.uint32)
+            dst.copy_from(src)
+            result = dst.for_transfer()
+            result.copy_from(dst)
+            await dst_device
+            return list(result.items)
+
+        assert ls.run(main()) == list(range(64))
+
+
+@pytest.mark.system("amdgpu")
+def test_amd_gpu_memory_stats():
+    sc = sf.amdgpu.SystemBuilder()
+    with sc.create_system() as ls:
+        stats = ls.devices[0].memory_stats
+        print("MEMORY:", stats)
+        if stats.total_bytes:
+            assert stats.used_bytes <= stats.total_bytes
+            assert stats.free_bytes == stats.total_bytes - stats.used_bytes
+
+
+@pytest.mark.system("amdgpu")
+@pytest.mark.parametrize("parallel", [True, False])
+def test_amd_gpu_parallel_device_creation(parallel):
+    sc = sf.amdgpu.SystemBuilder(
+        amdgpu_parallel_device_creation=parallel,
+        amdgpu_logical_devices_per_physical_device=2,
+    )
+    assert sc.parallel_device_creation == parallel
+    assert sc.startup_timings == {}
+    with sc.create_system() as ls:
+        # Devices are added in order regardless of creation order.
+        names = [d.name for d in ls.devices]
+        assert names[0:2] == ["amdgpu:0:0@0", "amdgpu:0:0@1"]
+        assert len(names) == 2 * len(sc.available_devices)
+    timings = sc.startup_timings
+    assert list(timings.keys())[0:3] == ["enumerate", "topology", "create_devices"]
+    assert list(timings.keys())[-1] == "finish"
+    assert all(t >= 0 for t in timings.values())
+
+
+@pytest.mark.system("amdgpu")
+def test_amd_gpu_queue_priorities():
+    sc = sf.amdgpu.SystemBuilder(
+        amdgpu_logical_devices_per_physical_device=2,
+        amdgpu_queue_priorities="high,low",
+        amdgpu_hw_queues=4,
+    )
+    assert sc.queue_priorities == [
+        sf.amdgpu.QueuePriority.HIGH,
+        sf.amdgpu.QueuePriority.LOW,
+    ]
+    assert sc.hw_queue_count == 4
+    with sc.create_system() as ls:
+        priorities = [d.queue_priority for d in ls.devices]
+        assert priorities[0:2] == [
+            sf.amdgpu.QueuePriority.HIGH,
+            sf.amdgpu.QueuePriority.LOW,
+        ]
+
+    sc = sf.amdgpu.SystemBuilder(amdgpu_queue_priorities="high")
+    sc.logical_devices_per_physical_device = 2
+    with pytest.raises(ValueError, match="one AMDGPU queue priority"):
+        sc.create_system()
+    with pytest.raises(ValueError, match="Illegal AMDGPU queue priority"):
+        sf.amdgpu.SystemBuilder(amdgpu_queue_priorities="urgent")
+
+
+@pytest.mark.system("amdgpu")
+def test_amd_gpu_telemetry():
+    sc = sf.amdgpu.SystemBuilder(telemetry_interval_ms=10)
+    with sc.create_system() as ls:
+        sample = ls.sample_telemetry()
+        print("TELEMETRY:", sample)
+        for name, telemetry in sample["devices"].items():
+            assert name.startswith("amdgpu:")
+            assert 0 <= telemetry.busy_percent <= 100
+            assert telemetry.shader_clock_mhz <= telemetry.max_shader_clock_mhz
+
+
+def _import_ipc_and_read(handle, conn):
+    import shortfin.array as sfnp
+
+    sc = sf.amdgpu.SystemBuilder()
+    with sc.create_system() as ls:
+
+        async def main():
+            device = ls.create_fiber().device(0)
+            shared = sfnp.storage.import_ipc_handle(device, handle)
+            src = sfnp.device_array(shared, [64], sfnp.uint32)
+            result = src.for_transfer()
+            result.copy_from(src)
+            await device
+            return list(result.items)
+
+        conn.send(ls.run(main()))
+
+
+@pytest.mark.system("amdgpu")
+def test_amd_gpu_ipc_memory():
+    import multiprocessing
+
+    import shortfin.array as sfnp
+
+    # Memory from stream ordered pools cannot be shared.
+    sc = sf.amdgpu.SystemBuilder(amdgpu_async_allocations=False)
+    with sc.create_system() as ls:
+
+        async def main():
+            device = ls.create_fiber().device(0)
+            host = sfnp.device_array.for_host(device, [64], sfnp.uint32)
+            host.items = list(range(64))
+            weights = sfnp.device_array.for_device(device, [64], sfnp.uint32)
+            weights.copy_from(host)
+            await device
+            handle = weights.storage.export_ipc_handle()
+
+            # HIP cannot import memory in the process that exported it.
+            ctx = multiprocessing.get_context("spawn")
+            parent_conn, child_conn = ctx.Pipe()
+            child = ctx.Process(
+                target=_import_ipc_and_read, args=(handle, child_conn)
+            )
+            child.start()
+            items = parent_conn.recv()
+            child.join()
+            assert child.exitcode == 0
+            return items
+
+        assert ls.run(main()) == list(range(64))
@@ -7,6 +7,7 @@
 import math
 import pytest
 import random
+import threading
 
 from typing import Any, List
 
@@ -430,6 +431,7 @@ def test_log_softmax_out_variant(device):
     "dtype",
     [
         sfnp.float16,
+        sfnp.bfloat16,
         sfnp.float32,
     ],
 )
@@ -438,6 +440,57 @@ def test_log_softmax_dtype(device, dtype):
     sfnp.log_softmax(src)
 
 
+def test_parallel_host_ops(device):
+    src = sfnp.device_array(device, [8, 4096], dtype=sfnp.float32)
+    src.items = [float((i * 7919) % 1000) / 100.0 for i in range(8 * 4096)]
+
+    def run_ops():
+        return [
+            sfnp.argmax(src).items.tolist(),
+            sfnp.softmax(src).items.tolist(),
+            sfnp.exp(src).items.tolist(),
+            sfnp.add(src, 1.0).items.tolist(),
+        ]
+
+    serial = run_ops()
+    sfnp.set_parallel_host_ops(True, min_elements=1)
+    try:
+        parallel = run_ops()
+    finally:
+        sfnp.set_parallel_host_ops(False)
+    assert parallel == serial
+
+
+def test_host_ops_from_threads(device):
+    # Large enough for the ops to release the GIL.
+    src = sfnp.device_array(device, [8, 4096], dtype=sfnp.float32)
+    src.items = [float((i * 7919) % 1000) / 100.0 for i in range(8 * 4096)]
+
+    def run_ops():
+        noise = sfnp.device_array(device, [8, 4096], dtype=sfnp.float32)
+        sfnp.fill_randn(noise, generator=sfnp.RandomGenerator(42))
+        return [
+            sfnp.argmax(src).items.tolist(),
+            sfnp.softmax(src).items.tolist(),
+            sfnp.transpose(src, [1, 0]).items.tolist(),
+            sfnp.add(src, 1.0).items.tolist(),
+            noise.items.tolist(),
+        ]
+
+    serial = run_ops()
+    results = [None] * 4
+
+    def worker(i):
+        results[i] = run_ops()
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert results == [serial] * 4
+
+
 def test_log_softmax_error_cases(device):
     # Invalid `input` dtype
     with pytest.raises(
@@ -568,6 +621,28 @@ def test_convert(device, dtype):
     assert list(input_array.items) == 6 * [16]
 
 
+@pytest.mark.parametrize(
+    "dtype",
+    [
+        sfnp.float8_e4m3fnuz,
+        sfnp.float8_e4m3fn,
+        sfnp.float8_e5m2,
+        sfnp.bfloat16,
+        sfnp.float16,
+    ],
+)
+def test_convert_into(device, dtype):
+    values = [0.0, 0.5, -1.5, 2.0, 16.0, -0.25] * 5
+    input_array = sfnp.device_array.for_host(device, [5, 6], sfnp.float32)
+    input_array.items = values
+    intermediate = sfnp.device_array.for_host(device, [5, 6], dtype)
+    result = sfnp.convert_into(input_array, intermediate)
+    assert result.dtype == dtype
+    output = sfnp.device_array.for_host(device, [5, 6], sfnp.float32)
+    sfnp.convert_into(intermediate, output)
+    assert list(output.items) == values
+
+
 def round_half_up(n):
     return math.floor(n + 0.5)
 
@@ -825,3 +900,32 @@ def test_transpose(device, dtype):
     sfnp.transpose(input, [1, 0], out=out)
     items = list(sfnp.convert(permuted, dtype=sfnp.int32).items)
     assert items == [0, 2, 4, 1, 3, 5]
+
+
+def test_out_checked(device):
+    src = sfnp.device_array.for_host(device, [2, 8], sfnp.float32)
+    src.items = [float(i) for i in range(16)]
+    bad_shape = sfnp.device_array.for_host(device, [3, 8], sfnp.float32)
+    for op in [sfnp.exp, sfnp.log, sfnp.softmax, sfnp.log_softmax, sfnp.convert]:
+        with pytest.raises(ValueError, match="out array must have shape"):
+            op(src, out=bad_shape)
+    with pytest.raises(ValueError, match="out array must have shape"):
+        sfnp.add(src, src, out=bad_shape)
+    with pytest.raises(ValueError, match="out array must have shape"):
+        sfnp.transpose(src, [1, 0], out=bad_shape)
+    with pytest.raises(ValueError, match="out array must have dtype"):
+        sfnp.argmax(src, out=sfnp.device_array.for_host(device, [2], sfnp.int32))
+
+
+def test_out_reuse(device):
+    src = sfnp.device_array.for_host(device, [2, 8], sfnp.float32)
+    src.items = [float(i % 8) for i in range(16)]
+    indices = sfnp.device_array.for_host(device, [2, 1], sfnp.int64)
+    probs = sfnp.device_array.for_host(device, [2, 8], sfnp.float32)
+    for _ in range(3):
+        result = sfnp.argmax(src, keepdims=True, out=indices)
+        assert result.shape == [2, 1]
+        sfnp.softmax(src, out=probs)
+        sfnp.multiply(probs, 2.0, out=probs)
+    assert indices.items.tolist() == [7, 7]
+    assert sum(probs.items.tolist()) == pytest.approx(4.0)
@@ -230,16 +230,59 @@ def test_view_nd(device):
         assert v_items[-1] == 8191
 
 
-def test_view_unsupported(lsys, device):
+def test_view_strided(lsys, device):
     async def main():
-        src = sfnp.device_array(device, [4, 4], sfnp.uint8)
-        src.fill(b"\0\1\2\3")
+        src = sfnp.device_array.for_host(device, [2, 3, 4], sfnp.uint32)
+        src.items = list(range(24))
+
+        # A non-leading slice (i.e. one beam out of [bs, beams, vocab]).
+        beam = src.view(slice(None), 1)
+        assert beam.shape == [2, 1, 4]
+        assert not beam.is_dense
+        assert beam.strides == [12, 4, 1]
+        with pytest.raises(ValueError, match="requires a dense array"):
+            beam.items
+        dense = beam.contiguous()
+        await device
+        assert dense.is_dense
+        assert list(dense.items) == [4, 5, 6, 7, 16, 17, 18, 19]
+
+        # Stepped slices, copied into as a destination.
+        stepped = src.view(slice(None), slice(None), slice(0, 4, 2))
+        assert stepped.shape == [2, 3, 2]
+        assert stepped.strides == [12, 4, 2]
+        fill = sfnp.device_array.for_host(device, [2, 3, 2], sfnp.uint32)
+        fill.items = [100] * 12
+        stepped.copy_from(fill)
+        await device
+        assert list(src.items) == [100 if i % 2 == 0 else i for i in range(24)]
+
+    lsys.run(main())
+
 
-        with pytest.raises(
-            ValueError,
-            match="Cannot create a view with dimensions following a spanning dim",
-        ):
-            view = src.view(slice(0, 2), 1)
-            await device
+def test_copy_rows_from(lsys, device):
+    async def main():
+        table = sfnp.device_array.for_host(device, [4, 3], sfnp.uint32)
+        table.items = list(range(12))
+        host = sfnp.device_array.for_host(device, [2, 3], sfnp.uint32)
+        host.items = [0] * 6
+
+        # Within one array (i.e. forking KV cache pages) and across arrays.
+        table.copy_rows_from(table, [0, 1], [3, 2])
+        host.copy_rows_from(table, [1], [0])
+        await device
+        assert list(table.items) == [0, 1, 2, 3, 4, 5, 3, 4, 5, 0, 1, 2]
+        assert list(host.items) == [3, 4, 5, 0, 0, 0]
+
+        with pytest.raises(ValueError, match="more than once"):
+            table.copy_rows_from(table, [0, 1], [2, 2])
+        with pytest.raises(ValueError, match="both reads and writes"):
+            table.copy_rows_from(table, [0, 1], [1, 2])
+        with pytest.raises(ValueError, match="out of range"):
+            table.copy_rows_from(table, [4], [0])
+        with pytest.raises(ValueError, match="matching rows"):
+            table.copy_rows_from(
+                sfnp.device_array.for_host(device, [2, 4], sfnp.uint32), [0], [0]
+            )
 
     lsys.run(main())
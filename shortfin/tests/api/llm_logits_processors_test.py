@@ -0,0 +1,77 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import math
+
+import numpy as np
+import pytest
+
+from _shortfin import lib as sfl
+
+
+LOGITS = np.array([2.0, -2.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0], dtype=np.float32)
+
+
+def test_penalties_and_bias():
+    chain = (
+        sfl.llm.LogitsProcessorChain()
+        .add_repetition_penalty(2.0)
+        .add_presence_penalty(0.5, frequency_penalty=0.25)
+        .add_logit_bias({3: 5.0, 100: 1.0})
+    )
+    assert len(chain) == 3
+    chain.accept_tokens([0, 1, 1])
+    logits = LOGITS.copy().reshape(1, -1)
+    chain.apply(logits)
+
+    expected = LOGITS.copy()
+    expected[0] = 2.0 / 2.0 - 0.75
+    expected[1] = -2.0 * 2.0 - 1.0
+    expected[3] += 5.0
+    np.testing.assert_array_equal(logits[0], expected)
+
+    chain.reset_tokens()
+    logits = LOGITS.copy().reshape(1, -1)
+    chain.apply(logits)
+    expected = LOGITS.copy()
+    expected[3] += 5.0
+    np.testing.assert_array_equal(logits[0], expected)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float16])
+def test_token_mask(dtype):
+    chain = sfl.llm.LogitsProcessorChain().add_token_mask()
+    logits = np.ones((1, 40), dtype=dtype)
+    chain.apply(logits)
+    np.testing.assert_array_equal(logits, 1.0)
+
+    # Allows tokens 0-31 and 33. Tokens past the mask are not allowed.
+    chain.set_allowed_tokens(np.array([0xFFFFFFFF, 0b10], dtype=np.uint32))
+    chain.apply(logits)
+    allowed = [t < 32 or t == 33 for t in range(40)]
+    np.testing.assert_array_equal(logits[0], np.where(allowed, 1.0, -math.inf))
+
+    chain.clear_allowed_tokens()
+    logits = np.ones((1, 40), dtype=dtype)
+    chain.apply(logits)
+    np.testing.assert_array_equal(logits, 1.0)
+
+
+def test_apply_logits_processors_rows():
+    chain = sfl.llm.LogitsProcessorChain().add_logit_bias({0: 1.0})
+    logits = np.zeros((3, 4), dtype=np.float32)
+    sfl.llm.apply_logits_processors(logits, [chain, None, chain])
+    np.testing.assert_array_equal(logits[:, 0], [1.0, 0.0, 1.0])
+
+    with pytest.raises(ValueError):
+        sfl.llm.apply_logits_processors(logits, [chain])
+    with pytest.raises(ValueError):
+        chain.apply(logits, row=3)
+
+
+def test_invalid_repetition_penalty():
+    with pytest.raises(ValueError):
+        sfl.llm.LogitsProcessorChain().add_repetition_penalty(0.0)
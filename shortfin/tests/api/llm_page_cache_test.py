@@ -0,0 +1,91 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+
+from _shortfin import lib as sfl
+
+
+def test_page_pool_refcounts():
+    pool = sfl.llm.PagePool(4)
+    assert pool.acquire(2) == [3, 2]
+    assert pool.acquire(3) is None
+    assert pool.available_pages == [1, 0]
+    pool.retain([3])
+    pool.release([3, 2])
+    assert pool.ref_count(3) == 1
+    assert pool.available_count == 3
+    pool.release([3])
+    # Releasing a free page is a no-op.
+    pool.release([3])
+    assert pool.available_count == 4
+    with pytest.raises(ValueError):
+        pool.release([4])
+
+
+def test_prefix_trie_match():
+    trie = sfl.llm.PrefixTrie(2)
+    a = trie.create_child(trie.ROOT, [1, 2], 10)
+    b = trie.create_child(a, [3, 4], 11)
+    trie.create_child(b, [5], 12)
+    # Existing children keep their page.
+    assert trie.create_child(a, [3, 4], 99) == b
+    assert trie.page(b) == 11
+
+    assert trie.match([1, 2, 3, 4, 5]) == (b, [10, 11])
+    assert trie.match([1, 2, 9, 9]) == (a, [10])
+    assert trie.match([7, 8]) == (trie.ROOT, [])
+    assert trie.node_count == 3
+    assert trie.leaf_count == 1
+
+
+def test_prefix_trie_eviction():
+    trie = sfl.llm.PrefixTrie(1)
+    nodes = [trie.create_child(trie.ROOT, [t], t) for t in range(4)]
+    trie.retain(nodes[0])
+    trie.match([1])
+    # Least recently used unreferenced leaves go first.
+    assert trie.evict(2) == [2, 3]
+    assert not trie.contains(nodes[2])
+    assert trie.evict(10) == [1]
+    trie.release(nodes[0])
+    assert trie.evict(10) == [0]
+    assert trie.node_count == 0
+    # Handles of evicted nodes stay stale when their slots are reused.
+    node = trie.create_child(trie.ROOT, [0], 5)
+    assert node != nodes[0]
+    assert trie.page(nodes[0]) == -1
+    trie.release(nodes[0])
+
+
+def test_prefix_trie_lfu_eviction():
+    trie = sfl.llm.PrefixTrie(1, eviction_policy=sfl.llm.PrefixTrie.LFU)
+    assert trie.eviction_policy == sfl.llm.PrefixTrie.LFU
+    trie.create_child(trie.ROOT, [1], 10)
+    trie.create_child(trie.ROOT, [2], 20)
+    for _ in range(3):
+        trie.match([1])
+    trie.match([2])
+    # The most recently matched leaf is evicted, as it was matched less often.
+    assert trie.evictable_count == 2
+    assert trie.evict(1) == [20]
+
+
+def test_prefix_trie_stats():
+    trie = sfl.llm.PrefixTrie(1)
+    trie.create_child(trie.ROOT, [1], 10)
+    trie.match([1, 2])
+    trie.match([3])
+    trie.evict(1)
+    stats = trie.stats()
+    assert stats.lookups == 2
+    assert stats.lookup_blocks == 3
+    assert stats.hit_blocks == 1
+    assert stats.hit_rate == pytest.approx(1 / 3)
+    assert stats.evictions == 1
+    assert stats.evictions_per_second > 0
+    trie.reset_stats()
+    assert trie.stats().lookups == 0
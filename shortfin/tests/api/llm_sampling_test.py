@@ -0,0 +1,257 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import math
+
+import numpy as np
+import pytest
+
+from _shortfin import lib as sfl
+
+
+def _config(**kwargs):
+    config = sfl.llm.DecodeConfig()
+    for key, value in kwargs.items():
+        setattr(config, key, value)
+    return config
+
+
+LOGITS = np.array([1.0, 3.0, 2.0, 0.0, 3.0, -math.inf, 2.5], dtype=np.float32)
+
+
+def test_sample_tokens_greedy():
+    logits = np.stack([LOGITS, LOGITS[::-1].copy()])
+    tokens, scores = sfl.llm.sample_tokens(logits, _config(temperature=0.0))
+    assert tokens == [1, 2]
+    assert scores == [3.0, 3.0]
+
+
+@pytest.mark.parametrize(
+    "top_k,top_p,allowed",
+    [
+        (3, -1.0, {1, 4, 6}),
+        (-1, 0.6, {1, 4}),
+        (3, 0.6, {1, 4}),
+    ],
+)
+def test_sample_tokens_filters(top_k, top_p, allowed):
+    logits = np.tile(LOGITS, (256, 1))
+    config = _config(temperature=1.0, top_k=top_k, top_p=top_p)
+    tokens, _ = sfl.llm.sample_tokens(logits, config, seed=1)
+    assert len(tokens) == 256
+    assert set(tokens) == allowed
+
+
+def test_sample_tokens_scores():
+    config = _config(
+        temperature=0.5,
+        logits_normalization=sfl.llm.LogitsNormalization.LOG_SOFTMAX,
+    )
+    tokens, scores = sfl.llm.sample_tokens(LOGITS, config, seed=7)
+    scaled = LOGITS.astype(np.float64) / 0.5
+    expected = scaled - np.log(np.sum(np.exp(scaled - scaled.max()))) - scaled.max()
+    assert scores[0] == pytest.approx(expected[tokens[0]], rel=1e-5)
+
+
+def test_sample_tokens_seeded():
+    logits = np.tile(LOGITS, (64, 1))
+    config = _config(temperature=1.0)
+    first, _ = sfl.llm.sample_tokens(logits, config, seed=3)
+    second, _ = sfl.llm.sample_tokens(logits, config, seed=3)
+    assert first == second
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float16])
+def test_select_tokens_batch(dtype):
+    # Rows are a strided view of a wider buffer.
+    buffer = np.zeros((3, 8), dtype=dtype)
+    buffer[0, :7] = LOGITS
+    buffer[1, :7] = LOGITS[::-1]
+    buffer[2, :7] = [0.0, 5.0, 1.0, 7.0, 7.0, 0.0, 0.0]
+    logits = buffer[:, :7]
+    beams = _config(use_beam_search=True, num_beams=3)
+    configs = [_config(), _config(), beams]
+    tokens = np.empty((3, 3), dtype=np.int32)
+    scores = np.empty((3, 3), dtype=np.float32)
+    sfl.llm.select_tokens_batch(logits, configs, tokens, scores)
+    assert tokens.tolist() == [[1, -1, -1], [2, -1, -1], [3, 4, 1]]
+    assert scores[:, 0].tolist() == [3.0, 3.0, 7.0]
+    assert scores[2].tolist() == [7.0, 7.0, 5.0]
+    assert np.all(np.isneginf(scores[0:2, 1:]))
+
+    # One config applies to all rows.
+    sfl.llm.select_tokens_batch(logits, beams, tokens, scores)
+    assert tokens[0].tolist() == [1, 4, 6]
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float16])
+def test_select_tokens_batch_greedy_large_vocab(dtype):
+    rng = np.random.default_rng(0)
+    logits = rng.standard_normal((4, 130_001)).astype(dtype)
+    logits[0, 17] = math.nan
+    logits[1, 129_999] = 10.0
+    logits[2] = math.nan
+    logits[3] = -math.inf
+    logits[3, 5] = math.nan
+    tokens = np.empty((4, 1), dtype=np.int32)
+    scores = np.empty((4, 1), dtype=np.float32)
+    sfl.llm.select_tokens_batch(logits, _config(), tokens, scores)
+    expected = np.argmax(np.nan_to_num(logits[:2], nan=-math.inf), axis=-1)
+    assert tokens[:2, 0].tolist() == expected.tolist()
+    assert scores[:2, 0].tolist() == logits[[0, 1], expected].tolist()
+    # Rows of only NaNs select nothing, and masked rows their first token.
+    assert tokens[2:, 0].tolist() == [-1, 0]
+    assert np.all(np.isneginf(scores[2:, 0]))
+
+
+def test_select_tokens_batch_errors():
+    logits = np.stack([LOGITS, LOGITS])
+    tokens = np.empty((2, 1), dtype=np.int32)
+    scores = np.empty((2, 1), dtype=np.float32)
+    with pytest.raises(ValueError, match="decode configs"):
+        sfl.llm.select_tokens_batch(logits, [_config()] * 3, tokens, scores)
+    with pytest.raises(ValueError, match="shape"):
+        sfl.llm.select_tokens_batch(
+            logits, _config(), np.empty((1, 1), dtype=np.int32), scores
+        )
+    with pytest.raises(ValueError, match="float32, float16 or bfloat16"):
+        sfl.llm.select_tokens_batch(
+            logits.astype(np.float64), _config(), tokens, scores
+        )
+
+
+def test_select_tokens_beam_search_large_vocab():
+    rng = np.random.default_rng(0)
+    logits = rng.standard_normal(130_000).astype(np.float32)
+    logits[17] = math.nan
+    config = _config(use_beam_search=True, num_beams=8)
+    tokens, scores = sfl.llm.select_tokens(logits, config)
+    expected = np.argsort(np.nan_to_num(logits, nan=-math.inf))[::-1][:8]
+    assert tokens == expected.tolist()
+    assert scores == logits[expected].tolist()
+
+
+def test_select_tokens_batch_sampling():
+    logits = np.tile(LOGITS, (256, 1))
+    sampled = _config(temperature=1.0, top_k=3)
+    assert sfl.llm.uses_sampling(sampled)
+    assert not sfl.llm.uses_sampling(_config(temperature=1.0))
+    tokens = np.empty((256, 2), dtype=np.int32)
+    scores = np.empty((256, 2), dtype=np.float32)
+    with pytest.raises(ValueError, match="RNG state"):
+        sfl.llm.select_tokens_batch(logits, sampled, tokens, scores)
+
+    states = np.arange(256, dtype=np.uint64)
+    sfl.llm.select_tokens_batch(logits, sampled, tokens, scores, rng_states=states)
+    assert set(tokens[:, 0]) == {1, 4, 6}
+    assert np.all(tokens[:, 1] == -1)
+    # States advance, and the same states reproduce the same tokens.
+    assert not np.array_equal(states, np.arange(256, dtype=np.uint64))
+    replay = np.empty_like(tokens)
+    sfl.llm.select_tokens_batch(
+        logits,
+        sampled,
+        replay,
+        np.empty_like(scores),
+        rng_states=np.arange(256, dtype=np.uint64),
+    )
+    assert np.array_equal(replay, tokens)
+
+
+def test_beam_search():
+    search = sfl.llm.BeamSearch(
+        _config(
+            num_beams=2,
+            eos_token_id=0,
+            logits_normalization=sfl.llm.LogitsNormalization.LOG_SOFTMAX,
+        ),
+        position=5,
+        tokens_per_page=4,
+    )
+    assert search.live_beam_count == 1
+    search.step(np.log(np.array([[1e-4, 0.5, 0.3, 0.2]], dtype=np.float32)))
+    assert search.tokens == [1, 2]
+    assert search.parents == [0, 0]
+    np.testing.assert_allclose(search.scores, np.log([0.5, 0.3]), rtol=1e-5)
+    # Both beams continue the partially filled page of the prompt.
+    assert search.copy_last_page == [1]
+    assert search.released == []
+
+    logits = np.log(
+        np.array([[0.9, 0.05, 1e-4, 0.05], [0.1, 1e-4, 0.2, 0.7]], dtype=np.float32)
+    )
+    search.step(logits)
+    # The first beam completes with EOS and the second is extended.
+    assert search.step_count == 2
+    assert search.live_beam_count == 1
+    assert search.tokens == [3]
+    assert search.parents == [1]
+    assert search.released == [0]
+    assert not search.done
+    results = search.results()
+    assert [tokens for tokens, _ in results] == [[1, 0], [2, 3]]
+    np.testing.assert_allclose(
+        [score for _, score in results], np.log([0.45, 0.21]), rtol=1e-5
+    )
+
+    with pytest.raises(ValueError):
+        search.step(logits)
+
+
+def test_beam_search_indices():
+    search = sfl.llm.BeamSearch(_config(num_beams=2, temperature=1.0))
+    logits = np.array([[0.0, 2.0, 1.0]], dtype=np.float16)
+    indices = np.array([[7, 42, 9]], dtype=np.int32)
+    search.step(logits, indices)
+    assert search.tokens == [42, 9]
+    lse = np.log(np.exp([0.0, 2.0, 1.0]).sum())
+    np.testing.assert_allclose(search.scores, [2.0 - lse, 1.0 - lse], rtol=1e-3)
+
+
+def test_verify_draft_tokens_greedy():
+    target = np.zeros([6, 5], dtype=np.float32)
+    # Request 0 matches both draft tokens and gets a bonus token.
+    target[0, 4] = target[1, 2] = target[2, 1] = 5.0
+    # Request 1 mismatches at its second draft token.
+    target[3, 3] = target[4, 0] = target[5, 2] = 5.0
+    draft_tokens = np.array([[4, 2], [3, 1]], dtype=np.int32)
+    accepted, tokens = sfl.llm.verify_draft_tokens(
+        target, draft_tokens, _config(temperature=0.0)
+    )
+    assert accepted == [2, 1]
+    assert tokens == [1, 0]
+
+
+def test_verify_draft_tokens_sampling():
+    # With one draft token, the first emitted token must follow the target
+    # distribution whichever draft distribution proposed it.
+    target = np.array(
+        [[1.0, 2.0, 0.5, -1.0, 3.0], [0.0, 0.0, 0.0, 9.0, 0.0]], dtype=np.float32
+    )
+    draft = np.array([[3.0, 0.0, 1.0, 2.0, -1.0]], dtype=np.float32)
+    p = np.exp(target[0]) / np.exp(target[0]).sum()
+    q = np.exp(draft[0]) / np.exp(draft[0]).sum()
+    config = _config(temperature=1.0, top_k=5)
+    rng = np.random.default_rng(0)
+    rng_states = np.array([7], dtype=np.uint64)
+    counts = np.zeros(5)
+    samples = 20000
+    for _ in range(samples):
+        draft_token = rng.choice(5, p=q)
+        accepted, tokens = sfl.llm.verify_draft_tokens(
+            target,
+            np.array([[draft_token]], dtype=np.int32),
+            config,
+            draft_logits=draft,
+            rng_states=rng_states,
+        )
+        counts[draft_token if accepted[0] else tokens[0]] += 1
+    np.testing.assert_allclose(counts / samples, p, atol=0.02)
+
+    with pytest.raises(ValueError):
+        sfl.llm.verify_draft_tokens(
+            target, np.array([[0]], dtype=np.int32), config, rng_states=rng_states
+        )
@@ -0,0 +1,49 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+
+from _shortfin import lib as sfl
+
+
+def test_counter_and_gauge():
+    counter = sfl.metrics.counter("test_api_events_total", "Events")
+    counter.increment()
+    counter.increment(2)
+    assert sfl.metrics.counter("test_api_events_total").value == 3
+
+    gauge = sfl.metrics.gauge("test_api_active", "Active", 'lane="a"')
+    gauge.set(5)
+    gauge.add(-7)
+    assert gauge.value == -2
+
+    text = sfl.metrics.export_prometheus()
+    assert "# TYPE test_api_events_total counter\ntest_api_events_total 3\n" in text
+    assert 'test_api_active{lane="a"} -2\n' in text
+
+
+def test_histogram():
+    histogram = sfl.metrics.histogram(
+        "test_api_latency_seconds", "Latency", unit=1e-6
+    )
+    for i in range(1, 101):
+        histogram.observe(i * 1e-3)
+    assert histogram.count == 100
+    assert histogram.quantile(0.5) == pytest.approx(50e-3, rel=1 / 32)
+    assert histogram.quantile(1.0) == pytest.approx(100e-3, rel=1 / 32)
+
+    text = sfl.metrics.export_prometheus()
+    assert "# TYPE test_api_latency_seconds histogram\n" in text
+    assert 'test_api_latency_seconds_bucket{le="+Inf"} 100\n' in text
+    assert "test_api_latency_seconds_count 100\n" in text
+
+
+def test_invalid_metrics():
+    sfl.metrics.counter("test_api_typed_total")
+    with pytest.raises(ValueError):
+        sfl.metrics.histogram("test_api_typed_total")
+    with pytest.raises(ValueError):
+        sfl.metrics.counter("not a name")
@@ -272,3 +272,32 @@ def test_log_tensor_stats_multi_dim(device, lsys, caplog):
         assert log_messages[5] == "Mode (excluding NaN): 5.0"
         assert log_messages[6] == "First 10 elements: [1. 3. 4. 5. 5. 7.]"
         assert log_messages[7] == "Last 10 elements: [1. 3. 4. 5. 5. 7.]"
+
+
+def test_dlpack_round_trip(device):
+    src = np.arange(12, dtype=np.float32).reshape(3, 4)
+    ary = sfnp.device_array.from_dlpack(device, src)
+    assert ary.shape == [3, 4]
+    assert ary.dtype == sfnp.float32
+    # Both directions alias the same memory.
+    src[0, 0] = 42.0
+    assert ary.items[0] == 42.0
+    exported = np.from_dlpack(ary)
+    assert np.shares_memory(exported, src)
+    del ary
+    np.testing.assert_array_equal(exported, src)
+
+
+def test_dlpack_strided_view(device):
+    src = np.arange(24, dtype=np.float32).reshape(2, 3, 4)
+    ary = sfnp.device_array.from_dlpack(device, src)
+    view = ary.view(slice(None), 1, slice(0, 4, 2))
+    assert not view.is_dense
+    exported = np.from_dlpack(view)
+    np.testing.assert_array_equal(exported, src[:, 1:2, 0:4:2])
+    assert np.shares_memory(exported, src)
+
+
+def test_dlpack_rejects_unsupported(device):
+    with pytest.raises(ValueError, match="no DLPack equivalent"):
+        np.from_dlpack(sfnp.device_array.for_host(device, [2], sfnp.opaque8))
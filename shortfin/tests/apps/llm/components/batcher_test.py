@@ -32,6 +32,7 @@ from shortfin_apps.llm.components.messages import (
     InferencePhase,
 )
 from shortfin_apps.llm.components.scheduler import Scheduler
+from shortfin_apps.utils import CancellationToken
 
 
 @pytest.fixture
@@ -209,6 +210,44 @@ class TestPrefillBatcherProcess:
             prefill_batcher_process_chunked.handle_inference_request(req)
             assert mock_schedule_job.call_count == 2
 
+    def test_cancelled_request_is_not_scheduled(
+        self, prefill_batcher_process: PrefillBatcherProcess, exec_req_list
+    ):
+        req = exec_req_list[0]
+        req.cancellation = CancellationToken()
+        req.cancellation.cancel()
+        with patch.object(
+            prefill_batcher_process.scheduler,
+            "schedule_job",
+        ) as mock_schedule_job:
+            prefill_batcher_process.handle_inference_request(req)
+            assert mock_schedule_job.call_count == 0
+        assert req.done._event.is_set()
+
+    def test_drop_cancelled(
+        self, prefill_batcher_process_chunked: PrefillBatcherProcess, exec_req_list
+    ):
+        batcher = prefill_batcher_process_chunked
+        cancelled, kept = exec_req_list[:2]
+        cancelled.cancellation = CancellationToken()
+        for req in (cancelled, kept):
+            batcher.handle_inference_request(req)
+        cancelled.cancellation.cancel()
+
+        # The first chunk of each request is ready, the second is pending.
+        scheduler = batcher.scheduler
+        to_schedule = scheduler._ready
+        scheduler._ready = []
+        remaining = batcher.drop_cancelled(to_schedule)
+
+        assert [task.instance_id for task in remaining] == [kept.instance_id]
+        assert cancelled.done._event.is_set()
+        assert cancelled.result_logits is None
+        assert not kept.done._event.is_set()
+        assert cancelled.orig_instance_id not in scheduler._pending
+        assert kept.orig_instance_id in scheduler._pending
+        assert batcher._llm_task_responder.get_request(cancelled.instance_id) is None
+
     def test_make_task_inputs_no_chunking(
         self, prefill_batcher_process: PrefillBatcherProcess, exec_req_list
     ):
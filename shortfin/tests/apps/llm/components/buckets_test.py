@@ -0,0 +1,63 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+
+from shortfin_apps.llm.components.buckets import BucketSelector, ShapeBucket
+
+
+@pytest.fixture
+def selector():
+    functions = {bs: f"prefill_bs{bs}" for bs in [1, 4, 8]}
+    seq_len_functions = {
+        (bs, sl): f"prefill_bs{bs}_sl{sl}" for bs in [1, 4, 8] for sl in [32, 128]
+    }
+    return BucketSelector.from_functions(functions, seq_len_functions)
+
+
+def _shape(bucket: ShapeBucket):
+    return bucket.batch_size, bucket.seq_len
+
+
+def test_selects_fewest_padded_tokens(selector):
+    assert _shape(selector.select(1, 16)) == (1, None)
+    assert _shape(selector.select(3, 16)) == (4, None)
+    assert _shape(selector.select(5, 64)) == (8, None)
+    # Static sequence lengths are selected only if they pad as little.
+    assert _shape(selector.select(2, 32)) == (4, 32)
+    assert selector.select(2, 32).function == "prefill_bs4_sl32"
+
+
+def test_selects_by_measured_latency(selector):
+    dynamic = selector.select(3, 96)
+    assert _shape(dynamic) == (4, None)
+    # The dynamic function is slow for a batch of 4, so that one of 8 of its
+    # static sequence length pads more but is faster.
+    selector.record(dynamic, 96, 4 * 96 * 1e-3)
+    static = ShapeBucket(8, 128, None)
+    selector.record(static, 96, 8 * 128 * 1e-5)
+    assert _shape(selector.select(3, 96)) == (8, 128)
+
+    # Unmeasured buckets are expected to run at the mean rate.
+    assert selector.expected_latency(ShapeBucket(1, None, None), 16) == (
+        pytest.approx(16 * (1e-3 + 1e-5) / 2)
+    )
+
+
+def test_smooths_measured_latency(selector):
+    bucket = selector.select(1, 32)
+    selector.record(bucket, 32, 32.0)
+    selector.record(bucket, 32, 64.0)
+    assert selector.expected_latency(bucket, 32) == pytest.approx(32 * 1.25)
+
+
+def test_raises_if_no_bucket_fits(selector):
+    with pytest.raises(RuntimeError, match="No available entry point for bs 9"):
+        selector.select(9, 16)
+
+    static = BucketSelector.from_functions({}, {(4, 32): "prefill_bs4_sl32"})
+    with pytest.raises(RuntimeError, match="seq_len 64"):
+        static.select(1, 64)
@@ -0,0 +1,113 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+
+from shortfin_apps.llm.components.chunk_planner import ChunkPlanner, chunk_costs
+from shortfin_apps.llm.components.invocation import LlmTaskInput
+
+
+def run_step(planner, available_pages):
+    """Plans a step and completes its chunks."""
+    step = planner.plan(available_pages)
+    for rid, _ in step:
+        planner.complete(rid)
+    return step
+
+
+def test_chunk_costs():
+    task_inputs = [
+        LlmTaskInput(
+            rid="a",
+            instance_id="a",
+            block_count=block_count,
+            seq_len=0,
+            input_tokens=tuple(range(tokens)),
+        )
+        for block_count, tokens in [(2, 32), (4, 32), (5, 10)]
+    ]
+    assert chunk_costs(task_inputs) == ([32, 32, 10], [2, 2, 1])
+
+
+def test_reserves_remaining_chunks():
+    planner = ChunkPlanner(max_batch_size=4)
+    planner.add_request("a", [32, 32, 32], [2, 2, 2])
+    planner.add_request("b", [32, 32], [2, 2])
+
+    # Only "a" fits in full: "b" must wait rather than run out midway.
+    assert planner.plan(available_pages=7) == [("a", 0)]
+    assert planner.reserved_pages == 4
+    planner.complete("a")
+
+    # Two of the 7 free pages are now used by "a".
+    assert planner.plan(available_pages=5) == [("a", 1)]
+    planner.complete("a")
+    assert planner.plan(available_pages=3) == [("a", 2)]
+    assert planner.complete("a")
+    assert not planner.has_request("a")
+
+    assert planner.plan(available_pages=7) == [("b", 0)]
+
+
+def test_started_requests_come_first():
+    planner = ChunkPlanner(max_batch_size=2)
+    planner.add_request("a", [16, 16], [1, 1])
+    assert run_step(planner, available_pages=10) == [("a", 0)]
+
+    planner.add_request("b", [64], [4])
+    planner.add_request("c", [64], [4])
+    assert planner.plan(available_pages=9) == [("a", 1), ("b", 0)]
+
+
+def test_maximizes_tokens_in_lookahead():
+    planner = ChunkPlanner(max_batch_size=2, token_budget=96)
+    planner.add_request("a", [64, 64], [4, 4])
+    planner.add_request("b", [48], [3])
+    planner.add_request("c", [48], [3])
+
+    # "a" with either would exceed the token budget.
+    assert planner.plan(available_pages=16) == [("b", 0), ("c", 0)]
+
+
+def test_lookahead_bounds_passing_over():
+    planner = ChunkPlanner(max_batch_size=4, lookahead=1)
+    planner.add_request("a", [64], [8])
+    planner.add_request("b", [16], [1])
+
+    assert planner.plan(available_pages=4) == []
+    assert planner.plan(available_pages=8) == [("a", 0)]
+
+
+def test_single_chunk_over_token_budget():
+    planner = ChunkPlanner(max_batch_size=2, token_budget=32)
+    planner.add_request("a", [64], [4])
+    planner.add_request("b", [64], [4])
+    assert planner.plan(available_pages=8) == [("a", 0)]
+
+
+def test_remove_request_releases_pages():
+    planner = ChunkPlanner(max_batch_size=2)
+    planner.add_request("a", [16, 16], [1, 1])
+    run_step(planner, available_pages=2)
+    assert planner.reserved_pages == 1
+    planner.remove_request("a")
+    assert planner.reserved_pages == 0
+
+
+def test_invalid():
+    with pytest.raises(ValueError):
+        ChunkPlanner(max_batch_size=0)
+    with pytest.raises(ValueError):
+        ChunkPlanner(max_batch_size=1, lookahead=0)
+
+    planner = ChunkPlanner(max_batch_size=1)
+    with pytest.raises(ValueError):
+        planner.add_request("a", [16], [1, 1])
+    planner.add_request("a", [16], [1])
+    with pytest.raises(ValueError):
+        planner.add_request("a", [16], [1])
+    with pytest.raises(ValueError):
+        planner.complete("a")
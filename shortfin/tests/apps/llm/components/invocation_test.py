@@ -26,6 +26,7 @@ from shortfin_apps.llm.components.invocation import (
     LlmTaskResponder,
     PrefillTask,
     DecodeTask,
+    MultiStepDecodeTask,
     _pad_list,
 )
 from shortfin_apps.llm.components.kvcache.attention_cache_abstract import (
@@ -907,6 +908,55 @@ class TestDecodeTask:
         lsys.run(_test())
 
 
+class TestMultiStepDecodeTask:
+    def test_process_results(
+        self,
+        fiber,
+        lsys,
+        device_array_cache,
+        page_pool,
+        decode_task_responder,
+        staggered_exec_req_list,
+    ):
+        async def _test():
+            decode_steps = 3
+            for req in staggered_exec_req_list:
+                req.phase = InferencePhase.DECODE
+                req.start_position = len(req.input_token_ids) - 1
+                decode_task_responder.add_request(req)
+            task = MultiStepDecodeTask(
+                task_inputs=_get_task_inputs(staggered_exec_req_list),
+                array_cache=device_array_cache,
+                page_tables=page_pool.acquire_free_pages(1),
+                seq_stride=2,
+                decode_steps=decode_steps,
+            )
+            batch_size = task.req_count
+            args = await task.prepare_args(batch_size=batch_size)
+            _validate_decode_args(exec_reqs=staggered_exec_req_list, args=args)
+
+            # The steps return their tokens, [bs, decode_steps].
+            tokens = sfnp.device_array(
+                fiber.device(0), [batch_size, decode_steps], dtype=sfnp.int64
+            )
+            with tokens.map(discard=True) as m:
+                m.items = [
+                    100 * i + step
+                    for i in range(batch_size)
+                    for step in range(decode_steps)
+                ]
+            tokens, _ = await task.process_results(
+                args=args, logits=tokens, indices=None, device0=fiber.device(0)
+            )
+            decode_task_responder.set_success(task, tokens, None)
+
+            for i, req in enumerate(staggered_exec_req_list):
+                assert req.result_tokens == [100 * i, 100 * i + 1, 100 * i + 2]
+                assert req.result_logits is None
+
+        lsys.run(_test())
+
+
 class TestLlmInvocationProcess:
     def test_run_none_indices(
         self,
@@ -942,3 +992,43 @@ class TestLlmInvocationProcess:
                 assert results == expected
 
         lsys.run(_test())
+
+    def test_run_device_sampling(
+        self,
+        lsys,
+        llm_invoker: LlmInvocationProcess,
+        prefill_task,
+        prefill_task_responder: PrefillTaskResponder,
+        result_logits_none_indices,
+        result_logits_w_indices,
+        staggered_exec_req_list,
+    ):
+        async def _test():
+            async def entrypoint(*args, fiber=None):
+                return result_logits_none_indices
+
+            sampled = []
+
+            async def sample(logits, fiber=None):
+                sampled.append(logits)
+                return result_logits_w_indices
+
+            for req in staggered_exec_req_list:
+                prefill_task_responder.add_request(req)
+
+            llm_invoker._functions = {prefill_task.req_count: entrypoint}
+            llm_invoker._sample_functions = {prefill_task.req_count: sample}
+            llm_invoker._responder = prefill_task_responder
+            await llm_invoker.run()
+
+            # The full logits are sampled on device, and only the top-k are
+            # returned.
+            assert len(sampled) == 1
+            assert sampled[0] is result_logits_none_indices[0]
+            for i, req in enumerate(staggered_exec_req_list):
+                assert req.result_logits.items.tolist() == [i + v for v in range(4)]
+                assert req.result_indices.items.tolist() == [
+                    10 + i + v for v in range(4)
+                ]
+
+        lsys.run(_test())
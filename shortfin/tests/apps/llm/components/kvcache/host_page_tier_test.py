@@ -0,0 +1,143 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+Host tier tests of the native trie attention cache, with page tables faked by
+numpy arrays so that page contents can be followed through swaps.
+"""
+
+import numpy as np
+import pytest
+import shortfin as sf
+import shortfin.array as sfnp
+
+from shortfin_apps.llm.components.kvcache.host_page_tier import HostPageTier
+from shortfin_apps.llm.components.kvcache.native_trie_attention_cache import (
+    NativeTriePagedAttentionCache,
+)
+from shortfin_apps.llm.components.kvcache.page_pool import PagePool, PagePoolConfig
+
+TOKENS_PER_PAGE = 2
+DEVICE_PAGES = 2
+HOST_PAGES = 2
+
+
+class FakeView:
+    def __init__(self, table, index):
+        self.table = table
+        self.index = index
+
+    def copy_from(self, src):
+        self.table.data[self.index] = src.table.data[src.index]
+
+
+class FakeMapping:
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        pass
+
+    def fill(self, value):
+        pass
+
+
+class FakeTable:
+    def __init__(self, shape, dtype):
+        self.shape = shape
+        self.dtype = dtype
+        self.data = np.zeros(shape, dtype=np.float32)
+
+    def view(self, index):
+        return FakeView(self, index)
+
+    def for_transfer(self):
+        return self
+
+    def map(self, **kwargs):
+        return FakeMapping()
+
+    def copy_to(self, dst):
+        pass
+
+
+@pytest.fixture(params=[False, True], ids=["unquantized", "quantized"])
+def cache(monkeypatch, request):
+    monkeypatch.setattr(
+        sf.array.device_array,
+        "for_device",
+        lambda device, shape, dtype: FakeTable(shape, dtype),
+    )
+    monkeypatch.setattr(
+        sf.array.device_array,
+        "for_host",
+        lambda device, shape, dtype: FakeTable(shape, dtype),
+    )
+    quantized = request.param
+    pool = PagePool(
+        devices=[object()],
+        config=PagePoolConfig(
+            dtype=sfnp.int8 if quantized else sfnp.float32,
+            alloc_page_count=DEVICE_PAGES,
+            paged_kv_block_size_elements_per_device=[4],
+            scale_dtype=sfnp.float32 if quantized else None,
+            scales_per_page_per_device=[2] if quantized else None,
+        ),
+    )
+    return NativeTriePagedAttentionCache(
+        page_pool=pool,
+        tokens_per_page=TOKENS_PER_PAGE,
+        host_tier=HostPageTier(pool, HOST_PAGES),
+    )
+
+
+def _prefill(cache, tokens, value):
+    """Caches `tokens`, writing `value` to the new pages, and releases them."""
+    info = cache.lookup(tokens)
+    info = cache.allocate(tokens[info.num_tokens :], info)
+    for page in info.pages[info.number_of_published_pages :]:
+        # Scales travel with their page.
+        for table in cache.page_pool.tables:
+            table.data[page.index] = value
+    info = cache.publish_pages_for_tokens(info)
+    cache.release_pages(info)
+    return info
+
+
+def test_evicted_prefix_is_swapped_back_in(cache):
+    system_prompt = [1, 2, 3, 4]
+    _prefill(cache, system_prompt, 7.0)
+    # Evicts the system prompt to the host tier.
+    _prefill(cache, [5, 6, 7, 8], 9.0)
+    assert len(cache.host_tier) == 2
+    assert cache.host_tier.swap_out_count == 2
+
+    info = cache.lookup(system_prompt + [10])
+    assert info.num_tokens == 4
+    assert cache.host_tier.swap_in_count == 2
+    assert len(info.pages) == 2
+    for page in info.pages:
+        for table in cache.page_pool.tables:
+            np.testing.assert_array_equal(table.data[page.index], 7.0)
+    # Making room offloaded the pages of the other prompt, except for the
+    # first one evicted, as the host slots were all taken by the swap in.
+    assert len(cache.host_tier) == 1
+    assert cache.host_tier.drop_count == 1
+
+    cache.shutdown()
+
+
+def test_host_tier_drops_least_recently_offloaded(cache):
+    _prefill(cache, [1, 2, 3, 4], 1.0)
+    _prefill(cache, [5, 6, 7, 8], 2.0)
+    _prefill(cache, [9, 10, 11, 12], 3.0)
+    assert cache.host_tier.drop_count == 2
+    assert cache.lookup([1, 2, 3, 4]).num_tokens == 0
+    info = cache.lookup([5, 6, 7, 8])
+    assert info.num_tokens == 4
+    for page in info.pages:
+        for table in cache.page_pool.tables:
+            np.testing.assert_array_equal(table.data[page.index], 2.0)
@@ -46,6 +46,49 @@ def test_page_copy(setup_pool):
     logger.info(f"Successfully copied page on system")
 
 
+def test_page_copy_batch(setup_pool):
+    pool = setup_pool
+    src_pages = pool.acquire_free_pages(4)
+    dst_pages = pool.copy_pages(src_pages)
+    assert dst_pages is not None, f"Failed to copy pages on system"
+    assert len(dst_pages) == len(src_pages)
+    assert not {p.index for p in src_pages} & {p.index for p in dst_pages}
+    assert pool.available_page_count() == 256 - 8
+
+
+def test_quantized_page_copy(generic_device):
+    pool = PagePool(
+        devices=[generic_device],
+        config=PagePoolConfig(
+            alloc_page_count=16,
+            dtype=sfnp.int8,
+            paged_kv_block_size_elements_per_device=[64],
+            scale_dtype=sfnp.float32,
+            scales_per_page_per_device=[4],
+        ),
+    )
+    assert len(pool.scale_tables) == 1
+    assert pool.tables == pool.page_tables + pool.scale_tables
+    scale_table = pool.scale_tables[0]
+    assert scale_table.shape == [16, 4]
+    assert scale_table.dtype == sfnp.float32
+
+    (page0,) = pool.acquire_free_pages(1)
+    page1 = pool.copy_page(page0)
+    assert page1 is not None
+    assert pool.copy_pages([page0, page1]) is not None
+
+
+def test_quantized_config_needs_scale_counts():
+    with pytest.raises(ValueError):
+        PagePoolConfig(
+            alloc_page_count=16,
+            dtype=sfnp.int8,
+            paged_kv_block_size_elements_per_device=[64],
+            scale_dtype=sfnp.float32,
+        )
+
+
 @pytest.fixture(autouse=True)
 def setup_logging():
     """Set up logging format to include timestamp and level"""
@@ -0,0 +1,109 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import asyncio
+import socket
+
+import pytest
+import shortfin.array as sfnp
+
+from shortfin_apps.llm.components.kvcache.page_pool import PagePool, PagePoolConfig
+from shortfin_apps.llm.components.kvcache.page_transfer import (
+    PageReceiver,
+    PageSender,
+    PageTransferError,
+)
+
+PAGE_ELEMENTS = 8
+PAGE_COUNT = 8
+
+
+def _make_pool(device, page_elements=PAGE_ELEMENTS):
+    return PagePool(
+        devices=[device],
+        config=PagePoolConfig(
+            dtype=sfnp.float32,
+            alloc_page_count=PAGE_COUNT,
+            paged_kv_block_size_elements_per_device=[page_elements],
+        ),
+    )
+
+
+async def _write_pages(device, pool, values):
+    table = pool.page_tables[0]
+    host = table.for_transfer()
+    with host.map(discard=True) as m:
+        m.items = [
+            values.get(page, 0.0)
+            for page in range(PAGE_COUNT)
+            for _ in range(PAGE_ELEMENTS)
+        ]
+    table.copy_from(host)
+    await device
+
+
+async def _read_page(device, pool, page):
+    host = pool.page_tables[0].view(page).for_transfer()
+    host.copy_from(pool.page_tables[0].view(page))
+    await device
+    return host.items.tolist()
+
+
+def test_pages_are_transferred_in_order(lsys, device):
+    src_pool = _make_pool(device)
+    dst_pool = _make_pool(device)
+    # Acquire some pages so that the received ones land elsewhere.
+    taken = {page.index for page in dst_pool.acquire_free_pages(2)}
+    sender = PageSender(src_pool, chunk_pages=2)
+    receiver = PageReceiver(dst_pool, chunk_pages=2)
+    src_sock, dst_sock = socket.socketpair()
+
+    async def main():
+        values = {0: 9.0, 1: 1.0, 4: 4.0, 5: 5.0, 6: 6.0}
+        await _write_pages(device, src_pool, values)
+        _, (request_id, pages) = await asyncio.gather(
+            sender.send(src_sock, "req-0", [4, 1, 6, 5, 0]),
+            receiver.receive(dst_sock),
+        )
+        return request_id, pages, [
+            await _read_page(device, dst_pool, page.index) for page in pages
+        ]
+
+    try:
+        request_id, pages, contents = lsys.run(main())
+    finally:
+        src_sock.close()
+        dst_sock.close()
+        sender.close()
+        receiver.close()
+    assert request_id == "req-0"
+    assert not {page.index for page in pages} & taken
+    assert dst_pool.available_page_count() == PAGE_COUNT - 2 - len(pages)
+    assert [row[0] for row in contents] == [4.0, 1.0, 6.0, 5.0, 9.0]
+    assert all(len(set(row)) == 1 for row in contents)
+
+
+def test_mismatched_pools_are_rejected(lsys, device):
+    src_pool = _make_pool(device)
+    dst_pool = _make_pool(device, page_elements=2 * PAGE_ELEMENTS)
+    sender = PageSender(src_pool)
+    receiver = PageReceiver(dst_pool)
+    src_sock, dst_sock = socket.socketpair()
+
+    async def main():
+        await sender.send(src_sock, "req-0", [0, 1])
+        with pytest.raises(PageTransferError):
+            await receiver.receive(dst_sock)
+
+    try:
+        lsys.run(main())
+    finally:
+        src_sock.close()
+        dst_sock.close()
+        sender.close()
+        receiver.close()
+    # No pages are taken by a rejected transfer.
+    assert dst_pool.available_page_count() == PAGE_COUNT
@@ -23,6 +23,9 @@ import math
 from shortfin_apps.llm.components.kvcache.trie_attention_cache import (
     TriePagedAttentionCache,
 )
+from shortfin_apps.llm.components.kvcache.native_trie_attention_cache import (
+    NativeTriePagedAttentionCache,
+)
 from shortfin_apps.llm.components.kvcache.base_attention_cache import (
     CacheAllocationFailure,
 )
@@ -144,10 +147,18 @@ def page_pool(mock_device, mock_device_array):
         sf.array.device_array.for_device = original_for_device
 
 
-@pytest.fixture
-def trie_cache(page_pool):
-    """Create TriePagedAttentionCache instance"""
-    return TriePagedAttentionCache(page_pool=page_pool, tokens_per_page=TEST_PAGE_SIZE)
+@pytest.fixture(params=["python", "native_lru", "native_lfu"])
+def trie_cache(request, page_pool):
+    """Create a TriePagedAttentionCache or its native drop-in replacement"""
+    if request.param == "python":
+        return TriePagedAttentionCache(
+            page_pool=page_pool, tokens_per_page=TEST_PAGE_SIZE
+        )
+    return NativeTriePagedAttentionCache(
+        page_pool=page_pool,
+        tokens_per_page=TEST_PAGE_SIZE,
+        eviction_policy=request.param.removeprefix("native_"),
+    )
 
 
 @pytest.fixture
@@ -286,6 +297,19 @@ def test_page_reuse(trie_cache, published_sequence, test_sequences):
     trie_cache.release_pages(allocation_updated)
 
 
+def test_cached_prefix_length(trie_cache, published_sequence):
+    """Test probing the cached prefix of tokens without looking them up"""
+    tokens = list(range(TEST_PAGE_SIZE * 2))
+    assert trie_cache.cached_prefix_length(tokens) == 0
+    published_sequence(tokens)
+
+    assert trie_cache.cached_prefix_length(tokens) == TEST_PAGE_SIZE * 2
+    assert trie_cache.cached_prefix_length(tokens + [100]) == TEST_PAGE_SIZE * 2
+    diverging = tokens[:TEST_PAGE_SIZE] + [100] * TEST_PAGE_SIZE
+    assert trie_cache.cached_prefix_length(diverging) == TEST_PAGE_SIZE
+    assert trie_cache.cached_prefix_length(tokens[: TEST_PAGE_SIZE - 1]) == 0
+
+
 @pytest.fixture
 def filled_cache(trie_cache, published_sequence):
     """Fixture that fills cache with numbered sequences"""
@@ -0,0 +1,186 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+import logging
+
+import pytest
+
+from shortfin_apps.llm.components.scheduler import NativeScheduler
+
+
+logger = logging.getLogger(__name__)
+
+
+class FakeBatcher:
+    def __init__(self):
+        self.msgs = []
+
+    def submit(self, x):
+        self.msgs.append(x)
+
+    def pop(self):
+        msgs = self.msgs
+        self.msgs = []
+        return msgs
+
+
+class FakeTask:
+    def __init__(self, rid, instance_id, token_count=1):
+        self.rid = rid
+        self.instance_id = instance_id
+        self.input_tokens = (0,) * token_count
+
+    def __eq__(self, other) -> bool:
+        return self.rid == other.rid and self.instance_id == other.instance_id
+
+    def __hash__(self):
+        return hash((self.rid, self.instance_id))
+
+    def __repr__(self):
+        return f"FakeTask({self.rid}, {self.instance_id})"
+
+
+def reserve_helper(scheduler, *, rid, count):
+    batcher = FakeBatcher()
+    scheduler.reserve_workload(rid=rid, count=count, batcher=batcher)
+    assert scheduler.handle_scheduler(batcher.pop()[0]) == True
+
+
+def make_workload(rids, running=0):
+    workload = {}
+    for rid in rids:
+        count = rids[rid]
+        workload[rid] = [
+            FakeTask(rid=rid, instance_id=i + running) for i in range(count)
+        ]
+        running = running + count
+
+    return workload
+
+
+def schedule_workload(scheduler, workload):
+    for rid in workload:
+        for task in workload[rid]:
+            scheduler.schedule_job(task)
+
+
+def test_unreserved_strobed():
+    scheduler = NativeScheduler(ideal_batch_size=32)
+    workload = make_workload({"a": 4})
+    schedule_workload(scheduler, workload)
+
+    assert scheduler.should_execute(strobe=0) == []
+    assert scheduler.should_execute(strobe=1) == []
+    assert scheduler.should_execute(strobe=2) == [workload["a"]]
+    assert scheduler.should_execute(strobe=3) == []
+
+
+def test_unreserved_overfull():
+    scheduler = NativeScheduler(ideal_batch_size=3)
+    workload = make_workload({"a": 10})
+    schedule_workload(scheduler, workload)
+
+    to_schedule = scheduler.should_execute(strobe=0)
+    assert to_schedule == [
+        workload["a"][:3],
+        workload["a"][3:6],
+        workload["a"][6:9],
+    ]
+    assert scheduler.should_execute(strobe=2) == [workload["a"][9:]]
+
+
+def test_reserved_waits_for_all():
+    scheduler = NativeScheduler(ideal_batch_size=7)
+    reserve_helper(scheduler, rid="a", count=5)
+
+    workload = make_workload({"a": 4})
+    schedule_workload(scheduler, workload)
+    assert scheduler.should_execute(strobe=2) == []
+
+    # The last reserved task launches the workgroup, with unreserved tasks
+    # filling the space left.
+    extra = make_workload({"a": 1, "b": 3}, running=4)
+    schedule_workload(scheduler, extra)
+    to_schedule = scheduler.should_execute(strobe=2)
+    assert to_schedule == [workload["a"] + extra["a"] + extra["b"][:2]]
+
+    reserve_helper(scheduler, rid="a", count=0)
+    assert scheduler.should_execute(strobe=4) == [extra["b"][2:]]
+
+
+def test_reserved_too_big():
+    scheduler = NativeScheduler(ideal_batch_size=5)
+    reserve_helper(scheduler, rid="a", count=7)
+    workload = make_workload({"a": 7})
+    schedule_workload(scheduler, workload)
+
+    to_schedule = scheduler.should_execute(strobe=2)
+    assert to_schedule == [workload["a"][:5], workload["a"][5:]]
+
+
+def test_token_budget():
+    scheduler = NativeScheduler(ideal_batch_size=4, token_budget=10)
+    tasks = [
+        FakeTask(rid=str(i), instance_id=i, token_count=count)
+        for i, count in enumerate([6, 6, 3, 12, 1])
+    ]
+    for task in tasks:
+        scheduler.schedule_job(task)
+
+    # A task over the budget is batched on its own, and small tasks fill the
+    # batches with room left.
+    to_schedule = scheduler.should_execute(strobe=0)
+    assert sorted(to_schedule, key=len) == [
+        [tasks[3]],
+        [tasks[0], tasks[4]],
+        [tasks[1], tasks[2]],
+    ]
+
+
+def test_chunked():
+    scheduler = NativeScheduler(ideal_batch_size=4, chunked=True)
+    chunks = [FakeTask(rid="a", instance_id=i) for i in range(3)]
+    other = FakeTask(rid="b", instance_id=3)
+    for task in chunks + [other]:
+        scheduler.schedule_job(task)
+
+    # One chunk of each request at a time.
+    assert scheduler.should_execute(strobe=0) == []
+    assert scheduler.should_execute(strobe=2) == [[chunks[0], other]]
+    assert scheduler.handle_completed("b")
+    assert not scheduler.handle_completed("a")
+    assert scheduler.should_execute(strobe=2) == []
+    assert scheduler.should_execute(strobe=4) == [[chunks[1]]]
+    assert not scheduler.handle_completed("a")
+    assert scheduler.should_execute(strobe=6) == []
+    assert scheduler.should_execute(strobe=8) == [[chunks[2]]]
+    assert scheduler.handle_completed("a")
+
+    # All state of the requests is dropped.
+    assert scheduler._rids == {}
+    assert scheduler._tasks == {}
+
+
+def test_cancel():
+    scheduler = NativeScheduler(ideal_batch_size=4, chunked=True)
+    chunks = [FakeTask(rid="a", instance_id=i) for i in range(3)]
+    other = FakeTask(rid="b", instance_id=3)
+    for task in chunks + [other]:
+        scheduler.schedule_job(task)
+    reserve_helper(scheduler, rid="a", count=1)
+
+    # The ready and waiting chunks of "a" are dropped with its reservation.
+    assert set(scheduler.cancel("a")) == set(chunks)
+    assert scheduler.cancel("a") == []
+    assert scheduler.should_execute(strobe=0) == []
+    assert scheduler.should_execute(strobe=2) == [[other]]
+    assert scheduler.handle_completed("b")
+    assert scheduler._rids == {}
+    assert scheduler._tasks == {}
+
+
+def test_invalid_batch_size():
+    with pytest.raises(ValueError):
+        NativeScheduler(ideal_batch_size=0)
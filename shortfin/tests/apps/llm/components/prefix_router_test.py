@@ -0,0 +1,63 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+
+from shortfin_apps.llm.components.prefix_router import PrefixRouter
+
+
+class FakeCache:
+    """Caches the prefixes in `prefixes`, as tuples of tokens."""
+
+    def __init__(self, *prefixes):
+        self.prefixes = prefixes
+        self.probes = 0
+
+    def cached_prefix_length(self, tokens):
+        self.probes += 1
+        tokens = tuple(tokens)
+        return max(
+            [len(p) for p in self.prefixes if tokens[: len(p)] == p], default=0
+        )
+
+
+def test_routes_to_longest_prefix():
+    caches = [FakeCache((1, 2)), FakeCache((1, 2, 3, 4)), FakeCache()]
+    router = PrefixRouter(caches)
+    assert router.route([1, 2, 3, 4, 5]) == 1
+    assert router.route([1, 2, 7]) == 0
+    # Without any cached prefix, the least loaded replica wins.
+    assert router.route([9]) == 2
+    assert router.loads == [1, 1, 1]
+
+
+def test_balances_load():
+    caches = [FakeCache((1, 2)), FakeCache()]
+    router = PrefixRouter(caches, balance_threshold=2)
+    assert [router.route([1, 2]) for _ in range(5)] == [0, 0, 0, 1, 0]
+    # The overloaded replica is not probed.
+    probes = caches[0].probes
+    assert router.route([1, 2]) == 1
+    assert caches[0].probes == probes
+    assert router.loads == [4, 2]
+
+    router.release(0)
+    assert router.route([1, 2]) == 0
+    assert router.loads == [4, 2]
+
+
+def test_zero_threshold_prefers_least_loaded():
+    router = PrefixRouter([FakeCache((1,)), FakeCache()], balance_threshold=0)
+    assert [router.route([1]) for _ in range(4)] == [0, 1, 0, 1]
+
+
+def test_invalid():
+    with pytest.raises(ValueError):
+        PrefixRouter([])
+    with pytest.raises(ValueError):
+        PrefixRouter([FakeCache()], balance_threshold=-1)
+    with pytest.raises(ValueError):
+        PrefixRouter([FakeCache()]).release(0)
@@ -76,9 +76,6 @@ class MockPagePool(PagePool):
             self._queue.put(page)
             self.attn_page_entries.append(page)
 
-        self.available_pages = []
-        for page in self.attn_page_entries:
-            self.available_pages.append(page)
         self.page_tables = []
 
         # Set up a basic page table with shape [num_pages, 16].
@@ -101,6 +98,9 @@ class MockPagePool(PagePool):
             paged_kv_block_size_elements_per_device=[TEST_PAGE_SIZE],
         )
 
+    def available_page_count(self):
+        return self._queue.qsize()
+
     def acquire_free_pages(self, count: int) -> List[PageInfo]:
         try:
             return [self._queue.get_nowait() for _ in range(count)]
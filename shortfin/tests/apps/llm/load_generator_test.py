@@ -0,0 +1,98 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import math
+import random
+
+import pytest
+
+from shortfin_apps.llm.load_generator import (
+    LengthDistribution,
+    RequestResult,
+    generate_workload,
+    summarize_run,
+)
+
+
+def test_length_distribution_parse():
+    assert LengthDistribution.parse("fixed:16").sample(random.Random(0)) == 16
+    rng = random.Random(0)
+    uniform = LengthDistribution.parse("uniform:4:8")
+    assert all(4 <= uniform.sample(rng) <= 8 for _ in range(100))
+    # Negative samples are clamped.
+    assert LengthDistribution.parse("normal:-100:1").sample(rng) == 1
+    with pytest.raises(ValueError):
+        LengthDistribution.parse("uniform:4")
+    with pytest.raises(ValueError):
+        LengthDistribution.parse("zipf:2")
+
+
+def test_generate_workload_poisson_arrivals():
+    requests = generate_workload(
+        num_requests=2000,
+        request_rate=10.0,
+        input_lengths=LengthDistribution.parse("fixed:8"),
+        output_lengths=LengthDistribution.parse("uniform:1:4"),
+    )
+    arrivals = [r.arrival_time for r in requests]
+    assert arrivals == sorted(arrivals)
+    # The mean inter-arrival time is 1 / rate.
+    assert math.isclose(arrivals[-1] / (len(arrivals) - 1), 0.1, rel_tol=0.1)
+    assert all(len(r.input_ids) == 8 for r in requests)
+    assert all(1 <= r.max_completion_tokens <= 4 for r in requests)
+
+    burst = generate_workload(
+        num_requests=4,
+        request_rate=float("inf"),
+        input_lengths=LengthDistribution.parse("fixed:8"),
+        output_lengths=LengthDistribution.parse("fixed:8"),
+    )
+    assert all(r.arrival_time == 0.0 for r in burst)
+
+
+def test_generate_workload_shared_prefixes():
+    requests = generate_workload(
+        num_requests=32,
+        request_rate=1.0,
+        input_lengths=LengthDistribution.parse("uniform:16:32"),
+        output_lengths=LengthDistribution.parse("fixed:8"),
+        prefix_ratio=0.5,
+        num_prefixes=2,
+    )
+    prefixes = {}
+    for request in requests:
+        assert request.prefix_index in (0, 1)
+        prefix_length = len(request.input_ids) // 2
+        prefix = request.input_ids[:prefix_length]
+        longest = prefixes.setdefault(request.prefix_index, prefix)
+        # Prompts of a prefix share its tokens, up to the shortest of them.
+        shared = min(len(longest), prefix_length)
+        assert longest[:shared] == prefix[:shared]
+        if prefix_length > len(longest):
+            prefixes[request.prefix_index] = prefix
+    assert prefixes[0] != prefixes[1]
+
+
+def test_summarize_run():
+    results = [
+        # TTFT of 0.1s and TPOT of 0.01s.
+        RequestResult(0.0, 8, end_time=0.12, token_times=[0.1, 0.11, 0.12]),
+        # TTFT of 0.5s, which misses the SLO.
+        RequestResult(1.0, 8, end_time=1.52, token_times=[1.5, 1.51, 1.52]),
+        RequestResult(2.0, 8, error="HTTP 500"),
+    ]
+    summary = summarize_run(results, request_rate=1.0, duration=2.0, slo_ttft=0.2)
+    assert summary["num_completed"] == 2
+    assert summary["num_errors"] == 1
+    assert summary["request_throughput"] == 1.0
+    assert summary["output_token_throughput"] == 3.0
+    assert summary["goodput"] == 0.5
+    assert math.isclose(summary["slo_attainment"], 1 / 3)
+    assert math.isclose(summary["ttft_mean"], 0.3)
+    assert math.isclose(summary["ttft_p50"], 0.3)
+    assert math.isclose(summary["itl_p50"], 0.01)
+    assert math.isclose(summary["tpot_mean"], 0.01)
+    assert math.isclose(summary["latency_p50"], 0.32)
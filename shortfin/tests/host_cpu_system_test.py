@@ -8,6 +8,7 @@ import os
 import pytest
 import re
 import sys
+import time
 
 import shortfin as sf
 
@@ -65,6 +66,112 @@ def test_create_host_cpu_system_allocators():
         pass
 
 
+def test_create_host_cpu_system_blocking_executor_bounds():
+    sc = sf.host.CPUSystemBuilder(
+        blocking_executor_max_threads="2",
+        blocking_executor_idle_timeout_ms="100",
+        blocking_executor_max_queued_tasks="64",
+    )
+    with sc.create_system() as ls:
+        metrics = ls.blocking_executor_metrics
+        assert metrics["live_threads"] <= 2
+        assert metrics["queued_tasks"] == 0
+        assert metrics["rejected_tasks"] == 0
+
+
+@pytest.mark.parametrize("huge_pages", ["thp", "2mb"])
+def test_create_host_cpu_system_host_huge_pages(huge_pages):
+    import shortfin.array as sfnp
+
+    sc = sf.host.CPUSystemBuilder(host_huge_pages=huge_pages)
+    assert sc.host_huge_pages == huge_pages
+    with sc.create_system() as ls:
+        device = ls.devices[0]
+        assert device.host_huge_pages == huge_pages
+        assert f"host_huge_pages={huge_pages}" in repr(device)
+
+        async def main():
+            fiber = ls.create_fiber()
+            # Large enough to be backed by huge pages (if any are free).
+            h = sfnp.storage.allocate_host(fiber.device(0), 4 << 20)
+            h.fill(b"7")
+            await fiber.device(0)
+            return bytes(h.map(read=True))[-1:]
+
+        assert ls.run(main()) == b"7"
+
+    with pytest.raises(ValueError, match="host_huge_pages"):
+        sf.host.CPUSystemBuilder(host_huge_pages="4k")
+
+
+def test_create_host_cpu_system_process_settings():
+    sc = sf.host.CPUSystemBuilder(sysconfig_min_memlock_mb="0")
+    assert sc.process_settings is None
+    with sc.create_system() as ls:
+        pass
+    settings = sc.process_settings
+    assert settings["file_limit"] != 0
+    assert settings["memlock_limit"] != 0
+    # The threshold is 0, so the locked memory limit is never recommended.
+    assert not any("Locked memory" in r for r in settings["recommendations"])
+
+    sc = sf.host.CPUSystemBuilder(
+        sysconfig_raise_limits=True, sysconfig_min_memlock_mb=str(1 << 40)
+    )
+    with sc.create_system() as ls:
+        pass
+    settings = sc.process_settings
+    assert settings["memlock_limit"] == settings["memlock_limit_max"]
+    if settings["memlock_limit"] != -1:
+        assert any("Locked memory" in r for r in settings["recommendations"])
+
+    sc = sf.host.CPUSystemBuilder(sysconfig_tune=False)
+    with sc.create_system() as ls:
+        pass
+    assert sc.process_settings is None
+
+
+def test_create_host_cpu_system_numa_host_allocations():
+    import shortfin.array as sfnp
+
+    sc = sf.host.CPUSystemBuilder()
+    assert sc.numa_host_allocations == False
+    with sc.create_system() as ls:
+        assert ls.devices[0].host_numa_node == -1
+        assert "host_numa_node" not in repr(ls.devices[0])
+
+    sc = sf.host.CPUSystemBuilder(numa_host_allocations=True)
+    assert sc.numa_host_allocations == True
+    with sc.create_system() as ls:
+        device = ls.devices[0]
+        assert device.host_numa_node == device.node_affinity
+        assert f"host_numa_node={device.node_affinity}" in repr(device)
+
+        async def main():
+            fiber = ls.create_fiber()
+            h = sfnp.storage.allocate_host(fiber.device(0), 1 << 16)
+            h.fill(b"7")
+            await fiber.device(0)
+            assert bytes(h.map(read=True))[0:4] == b"7777"
+
+        ls.run(main())
+
+
+def test_create_host_cpu_system_telemetry():
+    sc = sf.host.CPUSystemBuilder(telemetry_interval_ms=5, telemetry_history=3)
+    with sc.create_system() as ls:
+        # CPU devices report no counters, but samples are still taken.
+        sample = ls.sample_telemetry()
+        assert sample["devices"] == {}
+        assert sample["time"] > 0
+        deadline = time.monotonic() + 10
+        while len(ls.telemetry_history) < 3 and time.monotonic() < deadline:
+            time.sleep(0.01)
+        history = ls.telemetry_history
+        assert len(history) == 3
+        assert [s["time"] for s in history] == sorted(s["time"] for s in history)
+
+
 def test_create_host_cpu_system_unsupported_option():
     sc = sf.host.CPUSystemBuilder(unsupported="foobar")
     with pytest.raises(
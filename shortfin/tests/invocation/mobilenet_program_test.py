@@ -12,6 +12,7 @@ import pytest
 
 import shortfin as sf
 import shortfin.array as sfnp
+from _shortfin import lib as _sfl
 
 
 @pytest.fixture
@@ -54,6 +55,16 @@ def mobilenet_program_function_per_call(
     return main_function
 
 
+def test_load_modules_parallel(lsys, mobilenet_compiled_path):
+    modules = lsys.load_modules([mobilenet_compiled_path] * 4, mmap=True)
+    assert len(modules) == 4
+    for m in modules:
+        assert "torch-jit-export" in m.exports
+        assert m.load_duration > 0.0
+    with pytest.raises(Exception):
+        lsys.load_modules([mobilenet_compiled_path, "/does/not/exist.vmfb"])
+
+
 def get_mobilenet_ref_input(device) -> sfnp.device_array:
     dummy_data = array.array(
         "f", ([0.2] * (224 * 224)) + ([0.4] * (224 * 224)) + ([-0.2] * (224 * 224))
@@ -137,6 +148,133 @@ def test_invoke_mobilenet_chained_per_fiber(lsys, fiber0, mobilenet_program_func
     lsys.run(main())
 
 
+# Tests that a completed invocation can be reset, rebound and invoked again.
+@pytest.mark.parametrize("per_call", [False, True])
+def test_invoke_mobilenet_reset_and_reinvoke(
+    lsys,
+    fiber0,
+    mobilenet_program_function,
+    mobilenet_program_function_per_call,
+    per_call,
+):
+    function = (
+        mobilenet_program_function_per_call if per_call else mobilenet_program_function
+    )
+    device = fiber0.device(0)
+
+    async def main():
+        device_input = get_mobilenet_ref_input(device)
+        inv = await function(device_input, fiber=fiber0)
+        for _ in range(3):
+            (device_output,) = inv
+            await assert_mobilenet_ref_output(device, device_output)
+            del device_output
+            inv.reset()
+            assert len(inv) == 0
+            inv.add_arg(device_input)
+            inv = await inv.invoke()
+        assert len(inv) == 1
+
+    lsys.run(main())
+
+
+def test_invoke_mobilenet_chained_on_device(lsys, fiber0, mobilenet_program_function):
+    fiber1 = lsys.create_fiber()
+
+    async def main():
+        first = await mobilenet_program_function(
+            get_mobilenet_ref_input(fiber0.device(0)), fiber=fiber0
+        )
+        # Ordered after the first on the device, from another fiber's timeline.
+        device = fiber1.device(0)
+        second = mobilenet_program_function.invocation(fiber1)
+        second.add_arg(get_mobilenet_ref_input(device))
+        second.wait_after(first)
+        second = await second.invoke()
+        (device_output,) = second
+        await assert_mobilenet_ref_output(device, device_output)
+
+        unscheduled = mobilenet_program_function.invocation(fiber1)
+        with pytest.raises(ValueError, match="coarse signaling"):
+            mobilenet_program_function.invocation(fiber0).wait_after(unscheduled)
+        with pytest.raises(ValueError, match="out of range"):
+            unscheduled.add_result_arg(first, 1)
+
+    lsys.run(main())
+
+
+def test_denoise_loop(lsys, fiber0, mobilenet_program_function):
+    Arg = _sfl.diffusion.DenoiseArg
+    Stage = _sfl.diffusion.DenoiseStage
+
+    async def main():
+        device = fiber0.device(0)
+        # Two steps of two stages, the second taking its input by step.
+        step_inputs = sfnp.device_array(device, [2, 3, 224, 224], sfnp.float32)
+        for i in range(2):
+            step_inputs.view(i).copy_from(get_mobilenet_ref_input(device))
+        loop = _sfl.diffusion.DenoiseLoop(
+            [
+                Stage(mobilenet_program_function, [Arg.input(0)]),
+                Stage(mobilenet_program_function, [Arg.step_input(1)]),
+            ]
+        )
+        inputs = [get_mobilenet_ref_input(device), step_inputs]
+        (device_output,) = await loop.run(inputs, 2, fiber=fiber0)
+        await assert_mobilenet_ref_output(device, device_output)
+
+        with pytest.raises(ValueError, match="at least one step"):
+            loop.run(inputs, 0, fiber=fiber0)
+        with pytest.raises(ValueError, match="at least 3 steps"):
+            loop.run(inputs, 3, fiber=fiber0)
+        with pytest.raises(ValueError, match="out of range"):
+            loop.run(inputs[:1], 2, fiber=fiber0)
+        with pytest.raises(ValueError, match="not an earlier stage"):
+            _sfl.diffusion.DenoiseLoop(
+                [Stage(mobilenet_program_function, [Arg.stage_result(0, 0)])]
+            )
+
+    lsys.run(main())
+
+
+def test_invoke_with(lsys, fiber0, mobilenet_program_function):
+    device = fiber0.device(0)
+
+    async def main():
+        device_input = get_mobilenet_ref_input(device)
+        inv = mobilenet_program_function.invocation(fiber0)
+        inv = await inv.invoke_with((device_input,))
+        (device_output,) = inv
+        await assert_mobilenet_ref_output(device, device_output)
+
+        # Barrier wrappers go through the marshaling protocol.
+        inv.reset()
+        inv = await inv.invoke_with((sfnp.read_barrier(device_input),))
+        (device_output,) = inv
+        await assert_mobilenet_ref_output(device, device_output)
+
+        with pytest.raises(ValueError, match="Unsupported argument type"):
+            mobilenet_program_function.invocation(fiber0).invoke_with((object(),))
+
+    lsys.run(main())
+
+
+def test_add_output_arg(lsys, fiber0, mobilenet_program_function):
+    device = fiber0.device(0)
+    inv = mobilenet_program_function.invocation(fiber0)
+    inv.add_arg(get_mobilenet_ref_input(device))
+    with pytest.raises(ValueError, match="Unsupported output argument type"):
+        inv.add_output_arg(object())
+
+    async def main():
+        # Results not written into an output argument are imported as usual.
+        result = await inv.invoke()
+        (device_output,) = result
+        await assert_mobilenet_ref_output(device, device_output)
+
+    lsys.run(main())
+
+
 # Tests that parallel invocations on a single fiber with a program in PER_CALL
 # isolation functions properly. Note that in this variant, the await is done
 # on all invocations vs serially per invocation (as in
@@ -207,6 +345,63 @@ def test_invoke_mobilenet_parallel_per_call_explicit(
     lsys.run(main())
 
 
+def test_prepare_isolates(lsys, mobilenet_compiled_path):
+    fibers = [lsys.create_fiber() for _ in range(3)]
+    program_module = lsys.load_module(mobilenet_compiled_path)
+    program = sf.Program([program_module], devices=lsys.devices)
+    program.prepare_isolates(fibers)
+    for f in fibers:
+        stats = f.isolate_stats
+        assert stats["fork_count"] == 1
+        assert stats["total_fork_time"] >= stats["max_fork_time"] > 0.0
+    # Already prepared: no further forks, including on first invocation.
+    program.prepare_isolates(fibers)
+    main_function = program["module.torch-jit-export"]
+
+    async def main():
+        device = fibers[0].device(0)
+        device_input = get_mobilenet_ref_input(device)
+        (device_output,) = await main_function(device_input, fiber=fibers[0])
+        await assert_mobilenet_ref_output(device, device_output)
+
+    lsys.run(main())
+    assert [f.isolate_stats["fork_count"] for f in fibers] == [1, 1, 1]
+
+    per_call = sf.Program(
+        [program_module], devices=lsys.devices, isolation=sf.ProgramIsolation.PER_CALL
+    )
+    per_call.prepare_isolates(fibers[:1], contexts_per_fiber=4)
+    assert fibers[0].isolate_stats["fork_count"] == 5
+
+
+def test_invocation_profile(lsys, fiber0, mobilenet_compiled_path):
+    program_module = lsys.load_module(mobilenet_compiled_path)
+    assert sf.Program([program_module], devices=lsys.devices).invocation_profile is None
+    program = sf.Program(
+        [program_module], devices=lsys.devices, profile_invocations=True
+    )
+    main_function = program["module.torch-jit-export"]
+    assert program.invocation_profile == {}
+
+    async def main():
+        device = fiber0.device(0)
+        for _ in range(3):
+            device_input = get_mobilenet_ref_input(device)
+            (device_output,) = await main_function(device_input, fiber=fiber0)
+            await assert_mobilenet_ref_output(device, device_output)
+
+    lsys.run(main())
+    ((name, stats),) = program.invocation_profile.items()
+    assert name.startswith("torch-jit-export")
+    assert stats["count"] == 3
+    assert stats["failed_count"] == 0
+    for phase in ["enqueue", "execute", "wait", "signal"]:
+        assert stats[f"{phase}_time"] >= stats[f"max_{phase}_time"] >= 0.0
+    assert stats["execute_time"] > 0.0
+    program.reset_invocation_profile()
+    assert program.invocation_profile == {}
+
+
 # Tests that independent executions on multiple fibers all run concurrently.
 # All fibers share the same host thread but schedule concurrently. Since
 # each fiber has its own timeline, device side graphs have no dependency on
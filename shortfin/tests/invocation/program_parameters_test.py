@@ -0,0 +1,150 @@
+# Copyright 2024 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+
+import shortfin as sf
+
+
+@pytest.fixture
+def lsys():
+    sc = sf.host.CPUSystemBuilder()
+    lsys = sc.create_system()
+    yield lsys
+    lsys.shutdown()
+
+
+@pytest.fixture
+def irpa_path(tmp_path):
+    try:
+        import iree.runtime as rt
+    except ModuleNotFoundError:
+        raise pytest.skip("iree.runtime python package not available")
+    index = rt.ParameterIndex()
+    index.add_buffer("weight0", b"\x01" * 65536)
+    index.add_buffer("weight1", b"\x02" * 4096)
+    path = tmp_path / "params.irpa"
+    index.create_archive_file(str(path))
+    return path
+
+
+@pytest.mark.parametrize("mmap", [False, True])
+def test_lazy_load_and_prefetch(lsys, irpa_path, mmap):
+    params = sf.StaticProgramParameters(lsys, "model")
+    params.load(irpa_path, mmap=mmap, lazy=True)
+    assert params.prefetch(["weight0", "weight1"]) == 65536 + 4096
+    assert params.prefetch([]) == 0
+    with pytest.raises(ValueError, match="unknown parameter 'nope'"):
+        params.prefetch(["weight0", "nope"])
+
+
+@pytest.mark.parametrize("chunk_size,queue_depth", [(4096, 1), (8192, 4)])
+def test_direct_io_load(lsys, irpa_path, chunk_size, queue_depth):
+    params = sf.StaticProgramParameters(lsys, "model")
+    params.load(
+        irpa_path,
+        direct_io=True,
+        direct_io_chunk_size=chunk_size,
+        direct_io_queue_depth=queue_depth,
+    )
+    # Entries point into the host copy of the file.
+    assert params.prefetch(["weight0"]) == 65536
+    with pytest.raises(ValueError, match="multiple of 4096"):
+        params.load(irpa_path, direct_io=True, direct_io_chunk_size=1000)
+
+
+@pytest.mark.parametrize(
+    "direct_io,huge_pages", [(True, "2mb"), (True, "thp"), (False, "thp")]
+)
+def test_huge_page_load(lsys, irpa_path, direct_io, huge_pages):
+    params = sf.StaticProgramParameters(lsys, "model")
+    # Explicit huge pages fall back to transparent ones when none are free.
+    params.load(irpa_path, mmap=True, direct_io=direct_io, huge_pages=huge_pages)
+    assert params.prefetch(["weight0"]) == 65536
+    with pytest.raises(ValueError, match="Illegal huge pages"):
+        params.load(irpa_path, mmap=True, huge_pages="4k")
+
+
+@pytest.fixture
+def sharded_irpa_path(tmp_path):
+    try:
+        import iree.runtime as rt
+    except ModuleNotFoundError:
+        raise pytest.skip("iree.runtime python package not available")
+    index = rt.ParameterIndex()
+    index.add_buffer("w.shard.0", b"\x01" * 4096)
+    index.add_buffer("w.shard.1", b"\x02" * 8192)
+    index.add_buffer("replicated", b"\x03" * 1024)
+    path = tmp_path / "sharded.irpa"
+    index.create_archive_file(str(path))
+    return path
+
+
+def test_sharded_load(lsys, sharded_irpa_path):
+    device = lsys.devices[0]
+    sharded = sf.ShardedProgramParameters(lsys, "model", [device, device])
+    assert len(sharded) == 2
+    sharded.load(sharded_irpa_path)
+    assert sharded[0].prefetch(["w.shard.0", "replicated"]) == 4096 + 1024
+    assert sharded[1].prefetch(["w.shard.1", "replicated"]) == 8192 + 1024
+    with pytest.raises(ValueError, match="unknown parameter 'w.shard.1'"):
+        sharded[0].prefetch(["w.shard.1"])
+    assert sharded.for_device(device).prefetch(["w.shard.0"]) == 4096
+    with pytest.raises(IndexError):
+        sharded[2]
+
+    # A single shard of the same file can also be loaded directly.
+    params = sf.StaticProgramParameters(lsys, "model")
+    params.load(sharded_irpa_path, shard_index=1)
+    assert params.prefetch(["w.shard.1", "replicated"]) == 8192 + 1024
+    with pytest.raises(ValueError, match="unknown parameter 'w.shard.0'"):
+        params.prefetch(["w.shard.0"])
+
+
+@pytest.mark.parametrize("mmap", [False, True])
+def test_index_cache(lsys, irpa_path, tmp_path, mmap):
+    cache_path = tmp_path / "params.irpa.sfidx"
+    first = sf.StaticProgramParameters(lsys, "model")
+    first.load(irpa_path, mmap=mmap, index_cache_path=cache_path)
+    assert cache_path.exists()
+    cache_mtime = cache_path.stat().st_mtime_ns
+
+    # An up to date cache is reused as is.
+    second = sf.StaticProgramParameters(lsys, "model")
+    second.load(irpa_path, mmap=mmap, index_cache_path=cache_path)
+    assert second.prefetch(["weight0", "weight1"]) == 65536 + 4096
+    assert cache_path.stat().st_mtime_ns == cache_mtime
+
+    # A corrupt cache is ignored and rewritten.
+    cache_path.write_bytes(b"garbage")
+    third = sf.StaticProgramParameters(lsys, "model")
+    third.load(irpa_path, mmap=mmap, index_cache_path=cache_path)
+    assert third.prefetch(["weight0"]) == 65536
+    assert cache_path.read_bytes() != b"garbage"
+
+
+def test_index_cache_invalidated(lsys, tmp_path):
+    try:
+        import iree.runtime as rt
+    except ModuleNotFoundError:
+        raise pytest.skip("iree.runtime python package not available")
+    path = tmp_path / "params.irpa"
+    cache_path = tmp_path / "params.irpa.sfidx"
+    index = rt.ParameterIndex()
+    index.add_buffer("old", b"\x01" * 4096)
+    index.create_archive_file(str(path))
+    sf.StaticProgramParameters(lsys, "model").load(
+        path, index_cache_path=cache_path
+    )
+
+    index = rt.ParameterIndex()
+    index.add_buffer("new", b"\x02" * 8192)
+    index.create_archive_file(str(path))
+    params = sf.StaticProgramParameters(lsys, "model")
+    params.load(path, index_cache_path=cache_path)
+    assert params.prefetch(["new"]) == 8192
+    with pytest.raises(ValueError, match="unknown parameter 'old'"):
+        params.prefetch(["old"])
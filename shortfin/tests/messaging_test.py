@@ -0,0 +1,252 @@
+# Copyright 2024 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import asyncio
+import threading
+
+import pytest
+
+import shortfin as sf
+
+
+class Message(sf.Message):
+    def __init__(self, payload):
+        super().__init__()
+        self.payload = payload
+
+
+@pytest.fixture
+def lsys():
+    ls = sf.host.CPUSystemBuilder().create_system()
+    yield ls
+    ls.shutdown()
+
+
+@pytest.mark.parametrize(
+    "capacity,lock_free", [(0, False), (4, False), (4, True), (256, True)]
+)
+def test_threaded_writers(lsys, capacity, lock_free):
+    queue = lsys.create_queue(capacity=capacity, lock_free=lock_free)
+    thread_count = 4
+    per_thread = 200
+
+    def write(index):
+        for i in range(per_thread):
+            queue.write_nodelay(Message((index, i)))
+
+    async def main():
+        threads = [
+            threading.Thread(target=write, args=(index,))
+            for index in range(thread_count)
+        ]
+        for t in threads:
+            t.start()
+        reader = queue.reader()
+        received = []
+        for _ in range(thread_count * per_thread):
+            received.append((await reader()).payload)
+        for t in threads:
+            t.join()
+        return received
+
+    received = lsys.run(main())
+    # Each writer's messages arrive in order.
+    for index in range(thread_count):
+        assert [i for w, i in received if w == index] == list(range(per_thread))
+
+
+@pytest.mark.parametrize("lock_free", [False, True])
+def test_bounded_try_write(lsys, lock_free):
+    queue = lsys.create_queue(capacity=2, lock_free=lock_free)
+    assert "capacity=2" in repr(queue)
+    assert queue.try_write(Message(0))
+    assert queue.try_write(Message(1))
+    assert not queue.try_write(Message(2))
+    # Writes without delay go beyond the capacity.
+    queue.write_nodelay(Message(3))
+    queue.close()
+
+    async def main():
+        reader = queue.reader()
+        payloads = []
+        while message := await reader():
+            payloads.append(message.payload)
+        return payloads
+
+    assert lsys.run(main()) == [0, 1, 3]
+
+
+def test_lock_free_single_reader(lsys):
+    queue = lsys.create_queue(capacity=8, lock_free=True)
+    assert "lock_free" in repr(queue)
+    reader = queue.reader()
+    with pytest.raises(RuntimeError, match="single reader"):
+        queue.reader()
+    del reader
+    queue.reader()
+    with pytest.raises(ValueError, match="capacity"):
+        lsys.create_queue(lock_free=True)
+
+
+@pytest.mark.parametrize("lock_free", [False, True])
+def test_bounded_writer_backpressure(lsys, lock_free):
+    queue = lsys.create_queue(capacity=2, lock_free=lock_free)
+
+    async def write():
+        writer = queue.writer()
+        for i in range(10):
+            await writer(Message(i))
+        writer.close()
+
+    async def read():
+        reader = queue.reader()
+        payloads = []
+        while message := await reader():
+            payloads.append(message.payload)
+        return payloads
+
+    async def main():
+        fiber = lsys.create_fiber()
+        w1 = lsys.create_worker("w1")
+        w1_fiber = lsys.create_fiber(w1)
+
+        class Writer(sf.Process):
+            async def run(self):
+                await write()
+
+        class Reader(sf.Process):
+            async def run(self):
+                self.payloads = await read()
+
+        reader = Reader(fiber=w1_fiber)
+        await asyncio.gather(Writer(fiber=fiber).launch(), reader.launch())
+        return reader.payloads
+
+    assert lsys.run(main()) == list(range(10))
+
+
+def test_bounded_multiple_readers(lsys):
+    queue = lsys.create_queue(capacity=2)
+    received = []
+
+    class Writer(sf.Process):
+        async def run(self):
+            writer = queue.writer()
+            for i in range(50):
+                await writer(Message(i))
+            writer.close()
+
+    class Reader(sf.Process):
+        async def run(self):
+            reader = queue.reader()
+            while message := await reader():
+                received.append(message.payload)
+
+    async def main():
+        fiber = lsys.create_fiber()
+        w1_fiber = lsys.create_fiber(lsys.create_worker("w1"))
+        await asyncio.gather(
+            Writer(fiber=fiber).launch(),
+            Reader(fiber=fiber).launch(),
+            Reader(fiber=w1_fiber).launch(),
+        )
+
+    lsys.run(main())
+    assert sorted(received) == list(range(50))
+
+
+@pytest.mark.parametrize("lock_free", [False, True])
+def test_read_batch(lsys, lock_free):
+    queue = lsys.create_queue(capacity=16, lock_free=lock_free)
+
+    async def main():
+        reader = queue.reader()
+        for i in range(5):
+            queue.write_nodelay(Message(i))
+        first = [m.payload for m in await reader.read_batch(3)]
+        rest = [m.payload for m in await reader.read_batch(10)]
+        timed_out = await reader.read_batch(10, timeout=0.01)
+
+        pending = reader.read_batch(10, timeout=10.0)
+        queue.write_nodelay(Message(5))
+        woken = [m.payload for m in await pending]
+        # The timer of the completed read must not resolve later reads.
+        await asyncio.sleep(0.05)
+        queue.write_nodelay(Message(6))
+        single = (await reader()).payload
+
+        closing = reader.read_batch(4)
+        queue.close()
+        closed = await closing
+        return first, rest, timed_out, woken, single, closed
+
+    first, rest, timed_out, woken, single, closed = lsys.run(main())
+    assert first == [0, 1, 2]
+    assert rest == [3, 4]
+    assert timed_out == []
+    assert woken == [5]
+    assert single == 6
+    assert closed == []
+
+
+@pytest.mark.parametrize(
+    "worker_kwargs",
+    [
+        {},
+        {"busy_poll": 0.001},
+        {"adaptive_quantum": True, "quantum": 0.05},
+        {"busy_poll": 0.001, "adaptive_quantum": True, "min_quantum": 0.0005},
+    ],
+)
+def test_latency_tuned_worker(lsys, worker_kwargs):
+    queue = lsys.create_queue()
+    worker = lsys.create_worker("tuned", **worker_kwargs)
+
+    class Echo(sf.Process):
+        async def run(self):
+            reader = queue.reader()
+            self.payloads = []
+            while message := await reader():
+                self.payloads.append(message.payload)
+
+    async def main():
+        echo = Echo(fiber=lsys.create_fiber(worker))
+        launched = echo.launch()
+        # Idle gaps let the worker fall back from polling to blocking waits.
+        for i in range(5):
+            queue.write_nodelay(Message(i))
+            await asyncio.sleep(0.01)
+        queue.close()
+        await launched
+        return echo.payloads
+
+    assert lsys.run(main()) == list(range(5))
+    with pytest.raises(ValueError, match="min_quantum"):
+        lsys.create_worker("bad", adaptive_quantum=True, min_quantum=0.0)
+
+
+def test_call_threadsafe_order_and_count(lsys):
+    worker = lsys.create_worker("callee")
+    thread_count = 4
+    per_thread = 500
+    received = []
+    done = threading.Event()
+
+    def call(index):
+        for i in range(per_thread):
+            worker.call_threadsafe(lambda i=i: received.append((index, i)))
+        worker.call_threadsafe(done.set)
+
+    start_count = worker.thunk_count
+    threads = [threading.Thread(target=call, args=(i,)) for i in range(thread_count)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    while worker.thunk_count - start_count < thread_count * (per_thread + 1):
+        done.wait(0.01)
+    for index in range(thread_count):
+        assert [i for w, i in received if w == index] == list(range(per_thread))
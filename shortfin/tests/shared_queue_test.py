@@ -0,0 +1,106 @@
+# Copyright 2025 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import subprocess
+import sys
+import textwrap
+
+import numpy as np
+import pytest
+
+import shortfin as sf
+
+pytestmark = pytest.mark.skipif(
+    not sys.platform.startswith("linux"), reason="SharedQueue needs Linux"
+)
+
+
+@pytest.fixture
+def lsys():
+    ls = sf.host.CPUSystemBuilder().create_system()
+    yield ls
+    ls.shutdown()
+
+
+def test_write_and_read(lsys):
+    queue = sf.SharedQueue.create(capacity=4, max_tokens=16)
+    assert queue.capacity == 4
+    writer = queue.writer()
+    assert writer.try_write(1, [1, 2, 3])
+    assert writer.try_write(2, np.arange(16, dtype=np.int32))
+    assert writer.try_write(3, [])
+    with pytest.raises(ValueError, match="at most 16 tokens"):
+        writer.try_write(4, list(range(17)))
+    queue.close()
+    with pytest.raises(RuntimeError, match="closed"):
+        writer.try_write(4, [1])
+
+    async def main():
+        reader = queue.reader()
+        received = []
+        while message := await reader():
+            received.append((message.tag, message.tokens.tolist()))
+        return received
+
+    assert lsys.run(main()) == [(1, [1, 2, 3]), (2, list(range(16))), (3, [])]
+
+
+def test_slots_are_reused_once_released(lsys):
+    queue = sf.SharedQueue.create(capacity=2, max_tokens=4)
+    writer = queue.writer()
+    assert writer.try_write(0, [0])
+    assert writer.try_write(1, [1])
+    assert not writer.try_write(2, [2])
+    reader = queue.reader()
+    with pytest.raises(RuntimeError, match="one reader"):
+        queue.reader()
+
+    async def read():
+        return await reader()
+
+    message = lsys.run(read())
+    tokens = message.tokens
+    del message
+    # The view of the tokens keeps the slot.
+    assert not writer.try_write(2, [2])
+    assert tokens.tolist() == [0]
+    del tokens
+    assert writer.try_write(2, [2])
+
+
+def test_cross_process(lsys):
+    queue = sf.SharedQueue.create(capacity=8, max_tokens=32)
+    script = textwrap.dedent(
+        f"""
+        import time
+        import shortfin as sf
+
+        queue = sf.SharedQueue.open({queue.memory_fd}, {queue.event_fd})
+        writer = queue.writer()
+        for i in range(64):
+            while not writer.try_write(i, list(range(i % 32))):
+                time.sleep(0.001)
+        queue.close()
+        """
+    )
+    child = subprocess.Popen(
+        [sys.executable, "-c", script],
+        pass_fds=(queue.memory_fd, queue.event_fd),
+    )
+
+    async def main():
+        reader = queue.reader()
+        received = []
+        while message := await reader():
+            assert message.tokens.tolist() == list(range(message.tag % 32))
+            received.append(message.tag)
+        return received
+
+    try:
+        received = lsys.run(main())
+    finally:
+        assert child.wait(timeout=60) == 0
+    assert received == list(range(64))
@@ -0,0 +1,60 @@
+# Copyright 2024 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import asyncio
+import threading
+import time
+
+import pytest
+
+import shortfin as sf
+
+
+@pytest.fixture
+def lsys():
+    ls = sf.host.CPUSystemBuilder().create_system()
+    yield ls
+    ls.shutdown()
+
+
+def test_create(lsys):
+    group = lsys.create_worker_group("pre", 3)
+    assert group.name == "pre"
+    assert [w.name for w in group.workers] == ["pre:0", "pre:1", "pre:2"]
+    assert "pre" in repr(group)
+    with pytest.raises(ValueError):
+        lsys.create_worker_group("pre", 2)
+    with pytest.raises(ValueError):
+        lsys.create_worker_group("empty", 0)
+
+
+def test_submit_spreads(lsys):
+    group = lsys.create_worker_group("pre", 3)
+    threads = set()
+
+    def work():
+        # Sleeping releases the GIL so that the group workers overlap.
+        time.sleep(0.005)
+        threads.add(threading.get_ident())
+
+    async def main():
+        await asyncio.gather(*[group.submit(work) for _ in range(60)])
+
+    lsys.run(main())
+    assert len(threads) > 1
+
+
+def test_submit_failure(lsys):
+    group = lsys.create_worker_group("pre", 2)
+
+    def fail():
+        raise ValueError("bad thunk")
+
+    async def main():
+        with pytest.raises(Exception, match="bad thunk"):
+            await group.submit(fail)
+
+    lsys.run(main())
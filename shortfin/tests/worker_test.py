@@ -0,0 +1,56 @@
+# Copyright 2024 Advanced Micro Devices, Inc.
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import os
+import sys
+
+import pytest
+
+import shortfin as sf
+
+
+@pytest.fixture
+def lsys():
+    ls = sf.host.CPUSystemBuilder().create_system()
+    yield ls
+    ls.shutdown()
+
+
+def _worker_affinity(lsys, worker):
+    class Probe(sf.Process):
+        async def run(self):
+            self.affinity = os.sched_getaffinity(0)
+
+    async def main():
+        probe = Probe(fiber=lsys.create_fiber(worker))
+        await probe.launch()
+        return probe.affinity
+
+    return lsys.run(main())
+
+
+@pytest.mark.skipif(sys.platform != "linux", reason="Linux thread affinity")
+def test_worker_cpus(lsys):
+    cpu = min(os.sched_getaffinity(0))
+    worker = lsys.create_worker("pinned", cpus=[cpu])
+    assert _worker_affinity(lsys, worker) == {cpu}
+
+
+@pytest.mark.skipif(sys.platform != "linux", reason="Linux thread affinity")
+@pytest.mark.skipif(
+    not os.path.exists("/sys/devices/system/node/node0/cpulist"),
+    reason="NUMA topology not reported",
+)
+def test_worker_numa_node(lsys):
+    worker = lsys.create_worker("node0", numa_node=0)
+    assert "numa_node=0" in repr(worker)
+    with open("/sys/devices/system/node/node0/cpulist") as f:
+        cpus = set()
+        for part in f.read().strip().split(","):
+            first, _, last = part.partition("-")
+            cpus.update(range(int(first), int(last or first) + 1))
+    # Restricted to the node's CPUs (the process may already be narrower).
+    assert _worker_affinity(lsys, worker) <= cpus